@@ -73,7 +73,7 @@ public:
             if (! appDataDir.exists())
                 appDataDir.createDirectory();
 
-            savedEventsFile = appDataDir.getChildFile ("analytics_events.xml");
+            savedEvents.reset (new AnalyticsEventSpool (appDataDir.getChildFile ("analytics_events.dat")));
         }
 
         {
@@ -86,6 +86,9 @@ public:
             apiKey = "UA-XXXXXXXXX-1";
         }
 
+        // If we fail to connect, wait for longer and longer before trying again.
+        setMaximumRetryPeriod (maximumRetryPeriodMs);
+
         startAnalyticsThread (initialPeriodMs);
     }
 
@@ -180,17 +183,7 @@ public:
             webStream.reset (new WebInputStream (url, true));
         }
 
-        auto success = webStream->connect (nullptr);
-
-        // Do an exponential backoff if we failed to connect.
-        if (success)
-            periodMs = initialPeriodMs;
-        else
-            periodMs *= 2;
-
-        setBatchPeriod (periodMs);
-
-        return success;
+        return webStream->connect (nullptr);
     }
 
     void stopLoggingEvents() override
@@ -206,91 +199,21 @@ public:
 private:
     void saveUnloggedEvents (const std::deque<AnalyticsEvent>& eventsToSave) override
     {
-        // Save unsent events to disk. Here we use XML as a serialisation format, but
-        // you can use anything else as long as the restoreUnloggedEvents method can
-        // restore events from disk. If you're saving very large numbers of events then
-        // a binary format may be more suitable if it is faster - remember that this
-        // method is called on app shutdown so it needs to complete quickly!
-
-        XmlDocument previouslySavedEvents (savedEventsFile);
-        std::unique_ptr<XmlElement> xml (previouslySavedEvents.getDocumentElement());
-
-        if (xml.get() == nullptr || xml->getTagName() != "events")
-            xml.reset (new XmlElement ("events"));
-
-        for (auto& event : eventsToSave)
-        {
-            auto* xmlEvent = new XmlElement ("google_analytics_event");
-            xmlEvent->setAttribute ("name", event.name);
-            xmlEvent->setAttribute ("type", event.eventType);
-            xmlEvent->setAttribute ("timestamp", (int) event.timestamp);
-            xmlEvent->setAttribute ("user_id", event.userID);
-
-            auto* parameters = new XmlElement ("parameters");
-
-            for (auto& key : event.parameters.getAllKeys())
-                parameters->setAttribute (key, event.parameters[key]);
-
-            xmlEvent->addChildElement (parameters);
+        // Save unsent events to disk. The AnalyticsEventSpool appends them to a file
+        // in a compact binary format, which is quick enough to do on app shutdown,
+        // and discards the oldest events if the file would grow too large.
 
-            auto* userProperties = new XmlElement ("user_properties");
-
-            for (auto& key : event.userProperties.getAllKeys())
-                userProperties->setAttribute (key, event.userProperties[key]);
-
-            xmlEvent->addChildElement (userProperties);
-
-            xml->addChildElement (xmlEvent);
-        }
-
-        xml->writeToFile (savedEventsFile, {});
+        savedEvents->addEvents (eventsToSave);
     }
 
     void restoreUnloggedEvents (std::deque<AnalyticsEvent>& restoredEventQueue) override
     {
-        XmlDocument savedEvents (savedEventsFile);
-        std::unique_ptr<XmlElement> xml (savedEvents.getDocumentElement());
-
-        if (xml.get() == nullptr || xml->getTagName() != "events")
-            return;
-
-        auto numEvents = xml->getNumChildElements();
-
-        for (auto iEvent = 0; iEvent < numEvents; ++iEvent)
-        {
-            auto* xmlEvent = xml->getChildElement (iEvent);
-
-            StringPairArray parameters;
-            auto* xmlParameters = xmlEvent->getChildByName ("parameters");
-            auto numParameters = xmlParameters->getNumAttributes();
-
-            for (auto iParam = 0; iParam < numParameters; ++iParam)
-                parameters.set (xmlParameters->getAttributeName (iParam),
-                                xmlParameters->getAttributeValue (iParam));
-
-            StringPairArray userProperties;
-            auto* xmlUserProperties = xmlEvent->getChildByName ("user_properties");
-            auto numUserProperties = xmlUserProperties->getNumAttributes();
-
-            for (auto iProp = 0; iProp < numUserProperties; ++iProp)
-                userProperties.set (xmlUserProperties->getAttributeName (iProp),
-                                    xmlUserProperties->getAttributeValue (iProp));
-
-            restoredEventQueue.push_back ({
-                xmlEvent->getStringAttribute ("name"),
-                xmlEvent->getIntAttribute ("type"),
-                static_cast<uint32> (xmlEvent->getIntAttribute ("timestamp")),
-                parameters,
-                xmlEvent->getStringAttribute ("user_id"),
-                userProperties
-            });
-        }
-
-        savedEventsFile.deleteFile();
+        savedEvents->readEvents (restoredEventQueue);
+        savedEvents->clear();
     }
 
     const int initialPeriodMs = 1000;
-    int periodMs = initialPeriodMs;
+    const int maximumRetryPeriodMs = 5 * 60 * 1000;
 
     CriticalSection webStreamCreation;
     bool shouldExit = false;
@@ -298,7 +221,7 @@ private:
 
     String apiKey;
 
-    File savedEventsFile;
+    std::unique_ptr<AnalyticsEventSpool> savedEvents;
 };
 
 //==============================================================================
@@ -168,6 +168,7 @@ static String getAllSystemInfo()
       << "CPU has AVX512VBMI:      " << (SystemStats::hasAVX512VBMI()      ? "yes" : "no") << newLine
       << "CPU has AVX512VL:        " << (SystemStats::hasAVX512VL()        ? "yes" : "no") << newLine
       << "CPU has AVX512VPOPCNTDQ: " << (SystemStats::hasAVX512VPOPCNTDQ() ? "yes" : "no") << newLine
+      << "CPU has SHA:             " << (SystemStats::hasSHA()             ? "yes" : "no") << newLine
       << "CPU has Neon:            " << (SystemStats::hasNeon()            ? "yes" : "no") << newLine
       << newLine;
 
@@ -376,7 +376,7 @@ static XmlElement* createNodeXml (AudioProcessorGraph::Node* const node) noexcep
     return nullptr;
 }
 
-void FilterGraph::createNodeFromXml (const XmlElement& xml)
+void FilterGraph::createNodeFromXml (const XmlElement& xml, bool reopenPluginWindows)
 {
     PluginDescription pd;
 
@@ -424,7 +424,7 @@ void FilterGraph::createNodeFromXml (const XmlElement& xml)
                     node->properties.set (PluginWindow::getLastYProp (type), xml.getIntAttribute (PluginWindow::getLastYProp (type)));
                     node->properties.set (PluginWindow::getOpenProp  (type), xml.getIntAttribute (PluginWindow::getOpenProp (type)));
 
-                    if (node->properties[PluginWindow::getOpenProp (type)])
+                    if (reopenPluginWindows && node->properties[PluginWindow::getOpenProp (type)])
                     {
                         jassert (node->getProcessor() != nullptr);
 
@@ -457,13 +457,13 @@ XmlElement* FilterGraph::createXml() const
     return xml;
 }
 
-void FilterGraph::restoreFromXml (const XmlElement& xml)
+void FilterGraph::restoreFromXml (const XmlElement& xml, bool reopenPluginWindows)
 {
     clear();
 
     forEachXmlChildElementWithTagName (xml, e, "FILTER")
     {
-        createNodeFromXml (*e);
+        createNodeFromXml (*e, reopenPluginWindows);
         changed();
     }
 
@@ -65,7 +65,7 @@ public:
 
     //==============================================================================
     XmlElement* createXml() const;
-    void restoreFromXml (const XmlElement& xml);
+    void restoreFromXml (const XmlElement& xml, bool reopenPluginWindows = true);
 
     static const char* getFilenameSuffix()      { return ".filtergraph"; }
     static const char* getFilenameWildcard()    { return "*.filtergraph"; }
@@ -91,7 +91,7 @@ private:
     NodeID lastUID;
     NodeID getNextUID() noexcept;
 
-    void createNodeFromXml (const XmlElement& xml);
+    void createNodeFromXml (const XmlElement& xml, bool reopenPluginWindows);
     void addFilterCallback (AudioPluginInstance*, const String& error, Point<double>);
     void changeListenerCallback (ChangeBroadcaster*) override;
 
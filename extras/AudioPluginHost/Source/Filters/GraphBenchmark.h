@@ -0,0 +1,310 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "FilterGraph.h"
+#include "InternalFilters.h"
+
+
+//==============================================================================
+/**
+    Renders a saved filter graph without an audio device, as fast as it will go,
+    and reports how long the graph and each of its nodes took to process a block.
+
+    This is run instead of the normal UI when the host is launched with something like:
+
+        AudioPluginHost --benchmark chain.filtergraph --seconds 30 --block-sizes 64,512
+                        --sample-rates 44100,96000 --threads 2 --output results.json
+
+    Each combination of sample rate and block size is rendered in turn, and the results
+    are written as JSON to the output file, or to stdout if no file is given.
+*/
+class GraphBenchmark
+{
+public:
+    GraphBenchmark (const StringArray& commandLineArgs)
+        : args (commandLineArgs)
+    {
+        formatManager.addDefaultFormats();
+        formatManager.addFormat (new InternalPluginFormat());
+
+        // (the graph is created here rather than in run(), as it posts some messages to
+        // itself which need to be delivered before it's deleted)
+        filterGraph.reset (new FilterGraph (formatManager));
+    }
+
+    /** Returns true if the command line asks for a benchmark rather than the normal UI. */
+    static bool isBenchmarkCommandLine (const StringArray& args)
+    {
+        return args.contains ("--benchmark");
+    }
+
+    /** Runs the benchmark described by the command line, and returns the process exit code. */
+    int run()
+    {
+        Options options;
+        auto error = options.parse (args);
+
+        if (error.isNotEmpty())
+        {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+
+        std::unique_ptr<XmlElement> xml (XmlDocument::parse (options.graphFile));
+
+        if (xml == nullptr || ! xml->hasTagName ("FILTERGRAPH"))
+        {
+            std::cerr << "Not a valid filter graph file: " << options.graphFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        filterGraph->restoreFromXml (*xml, false);
+
+        auto& graph = filterGraph->graph;
+        graph.setNonRealtime (true);
+        graph.setNodeTimingEnabled (true);
+        graph.setNumRenderThreads (options.numRenderThreads);
+
+        DynamicObject::Ptr result (new DynamicObject());
+        result->setProperty ("graph", options.graphFile.getFullPathName());
+        result->setProperty ("seconds", options.seconds);
+        result->setProperty ("renderThreads", graph.getNumRenderThreads());
+
+        Array<var> runs;
+
+        for (auto sampleRate : options.sampleRates)
+            for (auto blockSize : options.blockSizes)
+                runs.add (renderGraph (graph, sampleRate, blockSize, options.seconds));
+
+        result->setProperty ("runs", runs);
+
+        auto json = JSON::toString (var (result.get()));
+
+        if (options.outputFile == File())
+        {
+            std::cout << json << std::endl;
+        }
+        else if (! options.outputFile.replaceWithText (json))
+        {
+            std::cerr << "Couldn't write to " << options.outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+private:
+    //==============================================================================
+    StringArray args;
+    AudioPluginFormatManager formatManager;
+    std::unique_ptr<FilterGraph> filterGraph;
+
+    struct Options
+    {
+        File graphFile, outputFile;
+        double seconds = 10.0;
+        Array<double> sampleRates { 44100.0 };
+        Array<int> blockSizes { 512 };
+        int numRenderThreads = 0;
+
+        String parse (const StringArray& args)
+        {
+            auto getValue = [&args] (const char* name)
+            {
+                auto index = args.indexOf (name);
+                return index >= 0 ? args[index + 1] : String();
+            };
+
+            auto graphPath = getValue ("--benchmark");
+
+            if (graphPath.isEmpty())
+                return "Usage: --benchmark <file.filtergraph> [--seconds N] [--block-sizes 64,512] "
+                       "[--sample-rates 44100,48000] [--threads N] [--output results.json]";
+
+            graphFile = File::getCurrentWorkingDirectory().getChildFile (graphPath.unquoted());
+
+            if (! graphFile.existsAsFile())
+                return "No such file: " + graphFile.getFullPathName();
+
+            auto outputPath = getValue ("--output");
+
+            if (outputPath.isNotEmpty())
+                outputFile = File::getCurrentWorkingDirectory().getChildFile (outputPath.unquoted());
+
+            auto secondsString = getValue ("--seconds");
+
+            if (secondsString.isNotEmpty())
+                seconds = secondsString.getDoubleValue();
+
+            auto ratesString = getValue ("--sample-rates");
+
+            if (ratesString.isNotEmpty())
+            {
+                sampleRates.clearQuick();
+
+                for (auto& r : StringArray::fromTokens (ratesString, ",", {}))
+                    sampleRates.add (r.getDoubleValue());
+            }
+
+            auto sizesString = getValue ("--block-sizes");
+
+            if (sizesString.isNotEmpty())
+            {
+                blockSizes.clearQuick();
+
+                for (auto& s : StringArray::fromTokens (sizesString, ",", {}))
+                    blockSizes.add (s.getIntValue());
+            }
+
+            numRenderThreads = jmax (0, getValue ("--threads").getIntValue());
+
+            if (seconds <= 0 || sampleRates.isEmpty() || blockSizes.isEmpty())
+                return "The length, sample rates and block sizes must all be given";
+
+            for (auto r : sampleRates)
+                if (r <= 0)
+                    return "Invalid sample rate";
+
+            for (auto s : blockSizes)
+                if (s <= 0)
+                    return "Invalid block size";
+
+            return {};
+        }
+    };
+
+    //==============================================================================
+    static var renderGraph (AudioProcessorGraph& graph, double sampleRate, int blockSize, double seconds)
+    {
+        const int numChannels = 2;
+
+        graph.releaseResources();
+        graph.setPlayConfigDetails (numChannels, numChannels, sampleRate, blockSize);
+        graph.prepareToPlay (sampleRate, blockSize);
+
+        AudioBuffer<float> buffer (numChannels, blockSize);
+        MidiBuffer midi;
+        Random random (1);
+
+        auto renderBlock = [&]
+        {
+            // (a quiet noise signal is used rather than silence, which some plug-ins skip processing)
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample (ch, i, (random.nextFloat() - 0.5f) * 0.1f);
+
+            midi.clear();
+
+            auto start = Time::getHighResolutionTicks();
+            graph.processBlock (buffer, midi);
+            return (float) (Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0);
+        };
+
+        // the first few blocks are thrown away, as they tend to include one-off costs
+        for (int i = 0; i < 16; ++i)
+            renderBlock();
+
+        auto nodes = graph.getNodes();
+        OwnedArray<Array<float>> nodeTimes;
+
+        for (auto* node : nodes)
+        {
+            node->resetTimingStatistics();
+            nodeTimes.add (new Array<float>());
+        }
+
+        auto collectNodeTimes = [&]
+        {
+            for (int i = 0; i < nodes.size(); ++i)
+            {
+                nodeTimes.getUnchecked (i)->addArray (nodes.getUnchecked (i)->getRecentBlockTimes());
+                nodes.getUnchecked (i)->resetTimingStatistics();
+            }
+        };
+
+        auto numBlocks = jmax (1, roundToInt (seconds * sampleRate / blockSize));
+        Array<float> totalTimes;
+        totalTimes.ensureStorageAllocated (numBlocks);
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            totalTimes.add (renderBlock());
+
+            // (the nodes only remember their last few hundred blocks)
+            if ((i + 1) % 256 == 0)
+                collectNodeTimes();
+        }
+
+        collectNodeTimes();
+        graph.releaseResources();
+
+        auto blockDurationMs = 1000.0 * blockSize / sampleRate;
+
+        DynamicObject::Ptr run (new DynamicObject());
+        run->setProperty ("sampleRate", sampleRate);
+        run->setProperty ("blockSize", blockSize);
+        run->setProperty ("numBlocks", numBlocks);
+        run->setProperty ("blockDurationMs", blockDurationMs);
+        run->setProperty ("total", createStatistics (totalTimes, blockDurationMs));
+
+        Array<var> nodeResults;
+
+        for (int i = 0; i < nodes.size(); ++i)
+        {
+            auto node = nodes.getUnchecked (i);
+            auto nodeResult = createStatistics (*nodeTimes.getUnchecked (i), blockDurationMs);
+
+            if (auto* obj = nodeResult.getDynamicObject())
+            {
+                obj->setProperty ("id", (int) node->nodeID.uid);
+                obj->setProperty ("name", node->getProcessor()->getName());
+            }
+
+            nodeResults.add (nodeResult);
+        }
+
+        run->setProperty ("nodes", nodeResults);
+        return var (run.get());
+    }
+
+    static var createStatistics (const Array<float>& times, double blockDurationMs)
+    {
+        auto stats = AudioProcessorGraph::Node::TimingStatistics::fromBlockTimes (times);
+
+        DynamicObject::Ptr obj (new DynamicObject());
+        obj->setProperty ("numBlocks", stats.numBlocks);
+        obj->setProperty ("meanMs", stats.averageMs);
+        obj->setProperty ("medianMs", stats.medianMs);
+        obj->setProperty ("p99Ms", stats.percentile99Ms);
+        obj->setProperty ("maxMs", stats.maximumMs);
+        obj->setProperty ("meanLoad", stats.averageMs / blockDurationMs);
+        return var (obj.get());
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (GraphBenchmark)
+};
@@ -27,6 +27,7 @@
 #include "../JuceLibraryCode/JuceHeader.h"
 #include "UI/MainHostWindow.h"
 #include "Filters/InternalFilters.h"
+#include "Filters/GraphBenchmark.h"
 
 #if ! (JUCE_PLUGINHOST_VST || JUCE_PLUGINHOST_VST3 || JUCE_PLUGINHOST_AU)
  #error "If you're building the audio plugin host, you probably want to enable VST and/or AU support"
@@ -52,6 +53,17 @@ public:
         appProperties.reset (new ApplicationProperties());
         appProperties->setStorageParameters (options);
 
+       #if ! (JUCE_ANDROID || JUCE_IOS)
+        // In benchmark mode, no window is created, and the app quits when it's finished. It's
+        // run asynchronously for the same reason as loading a graph is (see below).
+        if (GraphBenchmark::isBenchmarkCommandLine (getCommandLineParameterArray()))
+        {
+            benchmark.reset (new GraphBenchmark (getCommandLineParameterArray()));
+            triggerAsyncUpdate();
+            return;
+        }
+       #endif
+
         mainWindow.reset (new MainHostWindow());
         mainWindow->setUsingNativeTitleBar (true);
 
@@ -73,6 +85,13 @@ public:
 
     void handleAsyncUpdate() override
     {
+        if (benchmark != nullptr)
+        {
+            setApplicationReturnValue (benchmark->run());
+            quit();
+            return;
+        }
+
         File fileToOpen;
 
        #if JUCE_ANDROID || JUCE_IOS
@@ -104,6 +123,7 @@ public:
 
     void shutdown() override
     {
+        benchmark = nullptr;
         mainWindow = nullptr;
         appProperties = nullptr;
         LookAndFeel::setDefaultLookAndFeel (nullptr);
@@ -141,6 +161,7 @@ public:
 
 private:
     std::unique_ptr<MainHostWindow> mainWindow;
+    std::unique_ptr<GraphBenchmark> benchmark;
 };
 
 static PluginHostApp& getApp()                    { return *dynamic_cast<PluginHostApp*>(JUCEApplication::getInstance()); }
@@ -39,6 +39,7 @@ namespace
     static const String canvasStateOSCAddress = "/juce/nfd/canvasState";
     static const String newClientOSCAddress   = "/juce/nfd/newClient";
     static const String userInputOSCAddress   = "/juce/nfd/userInput";
+    static const String canvasAckOSCAddress   = "/juce/nfd/canvasAck";
 };
 
 #include "SharedCanvas.h"
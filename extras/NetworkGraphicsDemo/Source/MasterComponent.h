@@ -68,6 +68,7 @@ struct MasterContentComponent  : public Component,
         float widthInches, heightInches;
         Point<float> centre; // in inches
         float scaleFactor;
+        int lastAcknowledgedFrame, lastKeyframeSent;
     };
 
     Array<Client> clients;
@@ -87,7 +88,7 @@ struct MasterContentComponent  : public Component,
         DBG (name + "   "  + ipAddress);
 
         removeClient (name);
-        clients.add ({ name, ipAddress, area.getWidth(), area.getHeight(), {}, 1.0f });
+        clients.add ({ name, ipAddress, area.getWidth(), area.getHeight(), {}, 1.0f, -1, -1 });
 
         String lastX = properties.getValue ("lastX_" + name);
         String lastY = properties.getValue ("lastY_" + name);
@@ -330,14 +331,48 @@ private:
     }
 
     //==============================================================================
-    void broadcastNewCanvasState (const MemoryBlock& canvasData)
+    void broadcastNewCanvasState()
     {
-        BlockPacketiser packetiser;
-        packetiser.createBlocksFromData (canvasData, 1000);
+        auto frameNumber = encoder.addFrame (currentCanvas);
 
-        for (const auto& client : clients)
-            for (auto& b : packetiser.blocks)
+        // clients that have acknowledged the same frame can all be sent the same message
+        struct EncodedFrame
+        {
+            int baseFrame;
+            BlockPacketiser packetiser;
+        };
+
+        OwnedArray<EncodedFrame> encodedFrames;
+
+        for (auto& client : clients)
+        {
+            // Each client is sent the changes since the last frame it told us it received,
+            // with a keyframe every so often so that one that's missed lots can catch up.
+            auto needsKeyframe = client.lastKeyframeSent < 0
+                                  || frameNumber - client.lastKeyframeSent >= CanvasDeltaFormat::keyframeInterval
+                                  || ! encoder.hasFrame (client.lastAcknowledgedFrame);
+
+            auto baseFrame = needsKeyframe ? -1 : client.lastAcknowledgedFrame;
+
+            if (needsKeyframe)
+                client.lastKeyframeSent = frameNumber;
+
+            EncodedFrame* encoded = nullptr;
+
+            for (auto* e : encodedFrames)
+                if (e->baseFrame == baseFrame)
+                    encoded = e;
+
+            if (encoded == nullptr)
+            {
+                encoded = encodedFrames.add (new EncodedFrame());
+                encoded->baseFrame = baseFrame;
+                encoded->packetiser.createBlocksFromData (encoder.encodeLatestFrame (baseFrame), 1000);
+            }
+
+            for (auto& b : encoded->packetiser.blocks)
                 sendToIPAddress (client.ipAddress, masterPortNumber, canvasStateOSCAddress, b);
+        }
     }
 
     void timerCallback() override
@@ -355,7 +390,7 @@ private:
                 content->generateCanvas (g, currentCanvas, getActiveCanvasArea());
         }
 
-        broadcastNewCanvasState (currentCanvas.toMemoryBlock());
+        broadcastNewCanvasState();
 
         updateDeviceComponents();
         repaint();
@@ -390,6 +425,7 @@ private:
 
         if (address.matches (newClientOSCAddress))       newClientOSCMessageReceived (message);
         else if (address.matches (userInputOSCAddress))  userInputOSCMessageReceived (message);
+        else if (address.matches (canvasAckOSCAddress))  canvasAckOSCMessageReceived (message);
     }
 
     void newClientOSCMessageReceived (const OSCMessage& message)
@@ -401,6 +437,13 @@ private:
         addClient (tokens[0], tokens[1], tokens[2]);
     }
 
+    void canvasAckOSCMessageReceived (const OSCMessage& message)
+    {
+        if (message.size() == 2 && message[0].isString() && message[1].isInt32())
+            if (auto c = getClient (message[0].getString()))
+                c->lastAcknowledgedFrame = jmax (c->lastAcknowledgedFrame, (int) message[1].getInt32());
+    }
+
     void userInputOSCMessageReceived (const OSCMessage& message)
     {
         if (message.size() == 3 && message[0].isString() && message[1].isFloat32() && message[2].isFloat32())
@@ -415,6 +458,7 @@ private:
     PropertiesFile& properties;
     OwnedArray<DeviceComponent> devices;
     SharedCanvasDescription currentCanvas;
+    CanvasDeltaEncoder encoder;
     String error;
 
     OwnedArray<AnimatedContent> demos;
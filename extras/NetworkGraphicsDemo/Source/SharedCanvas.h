@@ -126,24 +126,12 @@ struct SharedCanvasDescription
     void save (OutputStream& out) const
     {
         out.writeInt (magic);
-        out.writeInt ((int) backgroundColour.getARGB());
-
-        out.writeInt (clients.size());
-
-        for (const auto& c : clients)
-        {
-            out.writeString (c.name);
-            writePoint (out, c.centre);
-            out.writeFloat (c.scaleFactor);
-        }
+        saveProperties (out);
 
         out.writeInt (paths.size());
 
         for (const auto& p : paths)
-        {
-            writeFill (out, p.fill);
-            p.path.writePathToStream (out);
-        }
+            writePath (out, p);
     }
 
     void load (InputStream& in)
@@ -151,37 +139,64 @@ struct SharedCanvasDescription
         if (in.readInt() != magic)
             return;
 
-        backgroundColour = Colour ((uint32) in.readInt());
+        loadProperties (in);
 
         {
-            const int numClients = in.readInt();
-            clients.clearQuick();
+            const int numPaths = in.readInt();
+            paths.clearQuick();
 
-            for (int i = 0; i < numClients; ++i)
-            {
-                ClientArea c;
-                c.name = in.readString();
-                c.centre = readPoint (in);
-                c.scaleFactor = in.readFloat();
-                clients.add (c);
-            }
+            for (int i = 0; i < numPaths; ++i)
+                paths.add (readPath (in));
         }
+    }
+
+    // These write and read everything apart from the paths, and the paths on their own,
+    // so that the delta encoding can send only the parts that have changed
+    void saveProperties (OutputStream& out) const
+    {
+        out.writeInt ((int) backgroundColour.getARGB());
 
+        out.writeInt (clients.size());
+
+        for (const auto& c : clients)
         {
-            const int numPaths = in.readInt();
-            paths.clearQuick();
+            out.writeString (c.name);
+            writePoint (out, c.centre);
+            out.writeFloat (c.scaleFactor);
+        }
+    }
 
-            for (int i = 0; i < numPaths; ++i)
-            {
-                ColouredPath p;
-                p.fill = readFill (in);
-                p.path.loadPathFromStream (in);
+    void loadProperties (InputStream& in)
+    {
+        backgroundColour = Colour ((uint32) in.readInt());
 
-                paths.add (std::move (p));
-            }
+        const int numClients = in.readInt();
+        clients.clearQuick();
+
+        for (int i = 0; i < numClients; ++i)
+        {
+            ClientArea c;
+            c.name = in.readString();
+            c.centre = readPoint (in);
+            c.scaleFactor = in.readFloat();
+            clients.add (c);
         }
     }
 
+    static void writePath (OutputStream& out, const ColouredPath& p)
+    {
+        writeFill (out, p.fill);
+        p.path.writePathToStream (out);
+    }
+
+    static ColouredPath readPath (InputStream& in)
+    {
+        ColouredPath p;
+        p.fill = readFill (in);
+        p.path.loadPathFromStream (in);
+        return p;
+    }
+
     MemoryBlock toMemoryBlock() const
     {
         MemoryOutputStream o;
@@ -289,6 +304,285 @@ private:
     JUCE_DECLARE_NON_COPYABLE (SharedCanvasDescription)
 };
 
+//==============================================================================
+/** The format used to send each canvas state as the differences from an earlier one.
+
+    A message starts with the number of the frame it contains, and the number of the
+    frame it's based on (or -1 for a keyframe, which doesn't depend on anything). The
+    background colour and client list are only included if they've changed, and each
+    path is either sent in full, or as part of a run of paths that were also in the
+    base frame. Paths are found in the base frame by their content rather than their
+    position, so ones that have just moved up or down the list don't need to be resent.
+*/
+struct CanvasDeltaFormat
+{
+    enum
+    {
+        magic = 0x2381239b,
+        literalPath = 0,
+        copiedPaths = 1,
+
+        numFramesToKeep = 30,       // how many earlier frames each end keeps to use as bases
+        keyframeInterval = 60       // how many frames a client can go between keyframes
+    };
+};
+
+//==============================================================================
+/** Used by the master to remember the frames it has sent, and to encode the latest
+    one relative to whichever of those a client says it has received.
+*/
+struct CanvasDeltaEncoder  : private CanvasDeltaFormat
+{
+    /** Stores a new frame and returns its number. */
+    int addFrame (const SharedCanvasDescription& canvas)
+    {
+        auto* frame = frames.add (new Frame());
+        frame->number = nextFrameNumber++;
+
+        {
+            MemoryOutputStream out (frame->properties, false);
+            canvas.saveProperties (out);
+        }
+
+        for (const auto& p : canvas.paths)
+        {
+            MemoryBlock data;
+
+            {
+                MemoryOutputStream out (data, false);
+                SharedCanvasDescription::writePath (out, p);
+            }
+
+            auto hash = getHash (data);
+
+            if (! frame->pathIndexes.contains (hash))
+                frame->pathIndexes.set (hash, frame->paths.size());
+
+            frame->paths.add (std::move (data));
+        }
+
+        while (frames.size() > numFramesToKeep)
+            frames.remove (0);
+
+        return frame->number;
+    }
+
+    bool hasFrame (int frameNumber) const
+    {
+        return findFrame (frameNumber) != nullptr;
+    }
+
+    /** Encodes the most recent frame relative to an earlier one. If the base frame number
+        is -1, or that frame has been forgotten, this produces a keyframe.
+    */
+    MemoryBlock encodeLatestFrame (int baseFrameNumber) const
+    {
+        auto* frame = frames.getLast();
+        jassert (frame != nullptr);
+
+        auto* base = findFrame (baseFrameNumber);
+
+        MemoryOutputStream out;
+        out.writeInt (magic);
+        out.writeInt (frame->number);
+        out.writeInt (base != nullptr ? base->number : -1);
+
+        auto propertiesChanged = (base == nullptr || base->properties != frame->properties);
+        out.writeBool (propertiesChanged);
+
+        if (propertiesChanged)
+            out << frame->properties;
+
+        auto numPaths = frame->paths.size();
+        out.writeCompressedInt (numPaths);
+
+        for (int i = 0; i < numPaths;)
+        {
+            auto& path = frame->paths.getReference (i);
+            auto baseIndex = base != nullptr ? base->findPath (path) : -1;
+
+            if (baseIndex < 0)
+            {
+                out.writeByte (literalPath);
+                out << path;
+                ++i;
+                continue;
+            }
+
+            int runLength = 1;
+
+            while (i + runLength < numPaths
+                    && baseIndex + runLength < base->paths.size()
+                    && base->paths.getReference (baseIndex + runLength) == frame->paths.getReference (i + runLength))
+                ++runLength;
+
+            out.writeByte (copiedPaths);
+            out.writeCompressedInt (baseIndex);
+            out.writeCompressedInt (runLength);
+            i += runLength;
+        }
+
+        return out.getMemoryBlock();
+    }
+
+private:
+    struct Frame
+    {
+        int number;
+        MemoryBlock properties;
+        Array<MemoryBlock> paths;
+        HashMap<int64, int> pathIndexes; // the first path with each hash
+
+        int findPath (const MemoryBlock& data) const
+        {
+            auto hash = getHash (data);
+
+            if (pathIndexes.contains (hash))
+            {
+                auto index = pathIndexes[hash];
+
+                if (paths.getReference (index) == data)
+                    return index;
+            }
+
+            return -1;
+        }
+    };
+
+    static int64 getHash (const MemoryBlock& data) noexcept
+    {
+        // (FNV-1a)
+        auto hash = (uint64) 0xcbf29ce484222325ull;
+
+        for (size_t i = 0; i < data.getSize(); ++i)
+            hash = (hash ^ (uint8) data[i]) * 0x100000001b3ull;
+
+        return (int64) hash;
+    }
+
+    const Frame* findFrame (int frameNumber) const
+    {
+        for (auto* f : frames)
+            if (f->number == frameNumber)
+                return f;
+
+        return nullptr;
+    }
+
+    OwnedArray<Frame> frames;
+    int nextFrameNumber = 0;
+};
+
+//==============================================================================
+/** Used by the clients to rebuild each canvas state from the messages that the
+    CanvasDeltaEncoder creates, remembering the frames that later messages may refer to.
+*/
+struct CanvasDeltaDecoder  : private CanvasDeltaFormat
+{
+    /** Returns the number of the frame that was decoded, or -1 if the data was invalid or
+        depends on a frame that isn't available (in which case the result is left incomplete).
+    */
+    int decode (InputStream& in, SharedCanvasDescription& result)
+    {
+        if (in.readInt() != magic)
+            return -1;
+
+        auto frameNumber = in.readInt();
+        auto baseFrameNumber = in.readInt();
+
+        const SharedCanvasDescription* base = nullptr;
+
+        if (baseFrameNumber >= 0)
+        {
+            base = findFrame (baseFrameNumber);
+
+            if (base == nullptr)
+                return -1;
+        }
+
+        if (in.readBool())
+        {
+            result.loadProperties (in);
+        }
+        else
+        {
+            if (base == nullptr)
+                return -1;
+
+            result.backgroundColour = base->backgroundColour;
+            result.clients = base->clients;
+        }
+
+        auto numPaths = in.readCompressedInt();
+        result.paths.clearQuick();
+        result.paths.ensureStorageAllocated (numPaths);
+
+        while (result.paths.size() < numPaths)
+        {
+            if (in.isExhausted())
+                return -1;
+
+            auto op = in.readByte();
+
+            if (op == literalPath)
+            {
+                result.paths.add (SharedCanvasDescription::readPath (in));
+            }
+            else if (op == copiedPaths && base != nullptr)
+            {
+                auto start = in.readCompressedInt();
+                auto num = in.readCompressedInt();
+
+                if (start < 0 || num <= 0 || start + num > base->paths.size()
+                     || result.paths.size() + num > numPaths)
+                    return -1;
+
+                for (int i = 0; i < num; ++i)
+                    result.paths.add (base->paths.getReference (start + i));
+            }
+            else
+            {
+                return -1;
+            }
+        }
+
+        // (frame numbers only go backwards if the master has been restarted, in which case
+        // none of the frames from before then can be used any more)
+        for (int i = frames.size(); --i >= 0;)
+            if (frames.getUnchecked (i)->number >= frameNumber)
+                frames.remove (i);
+
+        auto* frame = frames.add (new Frame());
+        frame->number = frameNumber;
+        frame->canvas.backgroundColour = result.backgroundColour;
+        frame->canvas.clients = result.clients;
+        frame->canvas.paths = result.paths;
+
+        while (frames.size() > numFramesToKeep)
+            frames.remove (0);
+
+        return frameNumber;
+    }
+
+private:
+    struct Frame
+    {
+        int number;
+        SharedCanvasDescription canvas;
+    };
+
+    const SharedCanvasDescription* findFrame (int frameNumber) const
+    {
+        for (auto* f : frames)
+            if (f->number == frameNumber)
+                return &(f->canvas);
+
+        return nullptr;
+    }
+
+    OwnedArray<Frame> frames;
+};
+
 //==============================================================================
 class CanvasGeneratingContext    : public LowLevelGraphicsContext
 {
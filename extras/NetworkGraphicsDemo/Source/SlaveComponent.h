@@ -110,15 +110,26 @@ private:
 
         if (packetiser.appendIncomingBlock (message[0].getBlob()))
         {
-            const ScopedLock sl (canvasLock);
-
             MemoryBlock newCanvasData;
 
             if (packetiser.reassemble (newCanvasData))
             {
                 MemoryInputStream i (newCanvasData.getData(), newCanvasData.getSize(), false);
-                canvas2.load (i);
-                triggerAsyncUpdate();
+                SharedCanvasDescription newCanvas;
+                auto frameNumber = decoder.decode (i, newCanvas);
+
+                // (if this was based on a frame we don't have, it's ignored, and the master
+                // carries on sending changes since the last one we acknowledged)
+                if (frameNumber >= 0)
+                {
+                    {
+                        const ScopedLock sl (canvasLock);
+                        canvas2.swapWith (newCanvas);
+                    }
+
+                    triggerAsyncUpdate();
+                    send (canvasAckOSCAddress, clientName, (int32) frameNumber);
+                }
             }
         }
     }
@@ -218,6 +229,7 @@ private:
 
     CriticalSection canvasLock;
     BlockPacketiser packetiser;
+    CanvasDeltaDecoder decoder;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SlaveCanvasComponent)
 };
@@ -49,6 +49,30 @@ class ConsoleUnitTestRunner : public UnitTestRunner
 };
 
 
+//==============================================================================
+static int runBenchmarks (const ArgumentList& args)
+{
+    BenchmarkRunner benchmarkRunner;
+
+    if (args.containsOption ("--category"))
+        benchmarkRunner.runBenchmarksInCategory (args.getValueForOption ("--category"));
+    else
+        benchmarkRunner.runAllBenchmarks();
+
+    if (args.containsOption ("--json"))
+    {
+        auto jsonFile = args.getFileForOption ("--json");
+
+        if (! jsonFile.replaceWithText (benchmarkRunner.toJSON()))
+        {
+            std::cout << "Couldn't write the results to " << jsonFile.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 //==============================================================================
 int main (int argc, char **argv)
 {
@@ -67,10 +91,26 @@ int main (int argc, char **argv)
     {
         if (args.containsOption ("--help|-h"))
         {
-            std::cout << argv[0] << " [--help|-h] [--category category] [--list-categories]" << std::endl;
+            std::cout << argv[0] << " [--help|-h] [--category category] [--list-categories]" << std::endl
+                      << argv[0] << " --benchmark [--category=category] [--list-categories] [--json=file]" << std::endl;
             return 0;
         }
 
+        if (args.containsOption ("--benchmark"))
+        {
+            if (args.containsOption ("--list-categories"))
+            {
+                for (auto& category : Benchmark::getAllCategories())
+                    std::cout << category << std::endl;
+
+                return 0;
+            }
+
+            auto result = runBenchmarks (args);
+            Logger::setCurrentLogger (nullptr);
+            return result;
+        }
+
         if (args.containsOption ("--list-categories"))
         {
             for (auto& category : UnitTest::getAllCategories())
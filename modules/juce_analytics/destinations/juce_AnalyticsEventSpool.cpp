@@ -0,0 +1,325 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace AnalyticsEventSpoolHelpers
+{
+    // Each event is stored as a record containing this magic number, the size of the
+    // event's data and then the data itself.
+    static const uint32 recordMagic = 0x4a414553;
+    static const size_t recordHeaderSize = 8;
+
+    static void writeStringPairs (OutputStream& out, const StringPairArray& pairs)
+    {
+        auto& keys = pairs.getAllKeys();
+        auto& values = pairs.getAllValues();
+
+        out.writeCompressedInt (keys.size());
+
+        for (int i = 0; i < keys.size(); ++i)
+        {
+            out.writeString (keys[i]);
+            out.writeString (values[i]);
+        }
+    }
+
+    static StringPairArray readStringPairs (InputStream& in)
+    {
+        StringPairArray pairs;
+
+        for (auto i = in.readCompressedInt(); --i >= 0 && ! in.isExhausted();)
+        {
+            auto key = in.readString();
+            pairs.set (key, in.readString());
+        }
+
+        return pairs;
+    }
+
+    static void writeRecord (OutputStream& out, const AnalyticsDestination::AnalyticsEvent& event)
+    {
+        MemoryOutputStream data;
+        data.writeString (event.name);
+        data.writeInt (event.eventType);
+        data.writeInt ((int) event.timestamp);
+        writeStringPairs (data, event.parameters);
+        data.writeString (event.userID);
+        writeStringPairs (data, event.userProperties);
+
+        out.writeInt ((int) recordMagic);
+        out.writeInt ((int) data.getDataSize());
+        out << data;
+    }
+
+    static AnalyticsDestination::AnalyticsEvent readRecord (const void* data, size_t size)
+    {
+        MemoryInputStream in (data, size, false);
+        AnalyticsDestination::AnalyticsEvent event;
+
+        event.name           = in.readString();
+        event.eventType      = in.readInt();
+        event.timestamp      = (uint32) in.readInt();
+        event.parameters     = readStringPairs (in);
+        event.userID         = in.readString();
+        event.userProperties = readStringPairs (in);
+
+        return event;
+    }
+
+    // Calls the callback with the start and size of each complete record, and returns
+    // the number of bytes that these take up - anything after that is a record that
+    // was only partly written.
+    template <typename Callback>
+    static size_t forEachRecord (const void* data, size_t size, Callback&& callback)
+    {
+        auto* bytes = static_cast<const char*> (data);
+        size_t pos = 0;
+
+        while (pos + recordHeaderSize <= size)
+        {
+            auto magic = ByteOrder::littleEndianInt (bytes + pos);
+            auto dataSize = (size_t) ByteOrder::littleEndianInt (bytes + pos + 4);
+            auto recordSize = recordHeaderSize + dataSize;
+
+            if (magic != recordMagic || recordSize > size - pos)
+                break;
+
+            callback (bytes + pos, recordSize);
+            pos += recordSize;
+        }
+
+        return pos;
+    }
+}
+
+//==============================================================================
+AnalyticsEventSpool::AnalyticsEventSpool (const File& fileToUse, int64 maximumFileSizeInBytes)
+    : file (fileToUse), maximumSize (maximumFileSizeInBytes)
+{
+}
+
+AnalyticsEventSpool::~AnalyticsEventSpool() {}
+
+bool AnalyticsEventSpool::addEvents (const std::deque<AnalyticsEvent>& events)
+{
+    using namespace AnalyticsEventSpoolHelpers;
+
+    if (events.empty())
+        return true;
+
+    MemoryOutputStream newRecords;
+
+    for (auto& event : events)
+        writeRecord (newRecords, event);
+
+    Array<MemoryBlock> records;
+    size_t validSize = 0;
+    bool needsTrimming = false;
+
+    {
+        MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+        needsTrimming = (int64) (mappedFile.getSize() + newRecords.getDataSize()) > maximumSize;
+
+        validSize = forEachRecord (mappedFile.getData(), mappedFile.getSize(), [&] (const char* record, size_t size)
+        {
+            if (needsTrimming)
+                records.add (MemoryBlock (record, size));
+        });
+    }
+
+    if (! needsTrimming)
+    {
+        FileOutputStream out (file);
+
+        if (out.failedToOpen())
+            return false;
+
+        // if a previous write was interrupted, this gets rid of the partly-written record
+        if (out.getPosition() != (int64) validSize)
+        {
+            out.setPosition ((int64) validSize);
+            out.truncate();
+        }
+
+        out << newRecords;
+        out.flush();
+
+        return out.getStatus().wasOk();
+    }
+
+    forEachRecord (newRecords.getData(), newRecords.getDataSize(), [&] (const char* record, size_t size)
+    {
+        records.add (MemoryBlock (record, size));
+    });
+
+    // keep as many of the newest events as will fit..
+    auto firstToKeep = records.size();
+    int64 totalSize = 0;
+
+    while (firstToKeep > 0 && totalSize + (int64) records.getReference (firstToKeep - 1).getSize() <= maximumSize)
+        totalSize += (int64) records.getReference (--firstToKeep).getSize();
+
+    MemoryOutputStream trimmedRecords ((size_t) totalSize);
+
+    for (int i = firstToKeep; i < records.size(); ++i)
+        trimmedRecords << records.getReference (i);
+
+    return file.replaceWithData (trimmedRecords.getData(), trimmedRecords.getDataSize());
+}
+
+void AnalyticsEventSpool::readEvents (std::deque<AnalyticsEvent>& destination) const
+{
+    using namespace AnalyticsEventSpoolHelpers;
+
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    forEachRecord (mappedFile.getData(), mappedFile.getSize(), [&] (const char* record, size_t size)
+    {
+        destination.push_back (readRecord (record + recordHeaderSize, size - recordHeaderSize));
+    });
+}
+
+void AnalyticsEventSpool::clear()
+{
+    file.deleteFile();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AnalyticsEventSpoolTests   : public UnitTest
+{
+    AnalyticsEventSpoolTests()
+        : UnitTest ("AnalyticsEventSpool")
+    {}
+
+    static std::deque<AnalyticsDestination::AnalyticsEvent> createEvents (int first, int num)
+    {
+        std::deque<AnalyticsDestination::AnalyticsEvent> events;
+
+        for (int i = first; i < first + num; ++i)
+        {
+            StringPairArray parameters, userProperties;
+            parameters.set ("id", "button" + String (i));
+            userProperties.set ("os", "test");
+
+            events.push_back ({ "event" + String (i), i % 3, (uint32) (1000 + i), parameters, "TestUser", userProperties });
+        }
+
+        return events;
+    }
+
+    void compareEvents (const std::deque<AnalyticsDestination::AnalyticsEvent>& a,
+                        const std::deque<AnalyticsDestination::AnalyticsEvent>& b)
+    {
+        expectEquals ((int) a.size(), (int) b.size());
+
+        for (size_t i = 0; i < jmin (a.size(), b.size()); ++i)
+        {
+            expectEquals (a[i].name, b[i].name);
+            expectEquals (a[i].eventType, b[i].eventType);
+            expect (a[i].timestamp == b[i].timestamp);
+            expect (a[i].parameters == b[i].parameters);
+            expectEquals (a[i].userID, b[i].userID);
+            expect (a[i].userProperties == b[i].userProperties);
+        }
+    }
+
+    void runTest() override
+    {
+        TemporaryFile tempFile;
+
+        beginTest ("Saving and restoring");
+        {
+            AnalyticsEventSpool spool (tempFile.getFile());
+            expect (spool.addEvents (createEvents (0, 5)));
+            expect (spool.addEvents (createEvents (5, 3)));
+
+            std::deque<AnalyticsDestination::AnalyticsEvent> restored;
+            spool.readEvents (restored);
+            compareEvents (restored, createEvents (0, 8));
+
+            spool.clear();
+            restored.clear();
+            spool.readEvents (restored);
+            expect (restored.empty());
+        }
+
+        beginTest ("Size limit");
+        {
+            int64 recordSize;
+
+            {
+                AnalyticsEventSpool spool (tempFile.getFile());
+                spool.addEvents (createEvents (0, 1));
+                recordSize = tempFile.getFile().getSize();
+                spool.clear();
+            }
+
+            // (the events all have names of the same length, so their records are all the same size)
+            AnalyticsEventSpool spool (tempFile.getFile(), recordSize * 4);
+            expect (spool.addEvents (createEvents (0, 3)));
+            expect (spool.addEvents (createEvents (3, 3)));
+            expectEquals (tempFile.getFile().getSize(), recordSize * 4);
+
+            std::deque<AnalyticsDestination::AnalyticsEvent> restored;
+            spool.readEvents (restored);
+            compareEvents (restored, createEvents (2, 4));
+            spool.clear();
+        }
+
+        beginTest ("Partly-written events");
+        {
+            AnalyticsEventSpool spool (tempFile.getFile());
+            spool.addEvents (createEvents (0, 2));
+
+            {
+                FileOutputStream out (tempFile.getFile());
+                out.writeInt ((int) AnalyticsEventSpoolHelpers::recordMagic);
+                out.writeInt (100);
+                out.writeString ("unfinished");
+            }
+
+            std::deque<AnalyticsDestination::AnalyticsEvent> restored;
+            spool.readEvents (restored);
+            compareEvents (restored, createEvents (0, 2));
+
+            spool.addEvents (createEvents (2, 2));
+            restored.clear();
+            spool.readEvents (restored);
+            compareEvents (restored, createEvents (0, 4));
+            spool.clear();
+        }
+    }
+};
+
+static AnalyticsEventSpoolTests analyticsEventSpoolTests;
+
+#endif
+
+} // namespace juce
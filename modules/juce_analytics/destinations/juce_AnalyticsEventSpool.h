@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Stores analytics events in a file, so that they can be kept until they've
+    been logged.
+
+    This is intended to be used by a ThreadedAnalyticsDestination subclass to
+    implement its saveUnloggedEvents and restoreUnloggedEvents methods. Events
+    are appended to the file in a compact binary format, which is much quicker to
+    write than re-serialising all the events that were saved previously, and the
+    file is memory-mapped when it's read back.
+
+    The size of the file is limited: if adding some events would take it over
+    the maximum size, the oldest events are discarded to make room. If the app
+    was killed while events were being written, the partly-written event is also
+    discarded rather than corrupting the rest of the file.
+
+    @see ThreadedAnalyticsDestination
+
+    @tags{Analytics}
+*/
+class JUCE_API  AnalyticsEventSpool
+{
+public:
+    //==============================================================================
+    using AnalyticsEvent = AnalyticsDestination::AnalyticsEvent;
+
+    /**
+        Creates an AnalyticsEventSpool that uses the given file.
+
+        @param fileToUse                the file to store events in - this will be
+                                        created if it doesn't already exist
+        @param maximumFileSizeInBytes   the largest size that the file is allowed
+                                        to grow to
+    */
+    AnalyticsEventSpool (const File& fileToUse, int64 maximumFileSizeInBytes = 1024 * 1024);
+
+    /** Destructor. */
+    ~AnalyticsEventSpool();
+
+    //==============================================================================
+    /**
+        Adds some events to the end of the file.
+
+        If this would make the file larger than its maximum size, the oldest
+        events in the file are removed first.
+
+        @returns   true if the events were written successfully
+    */
+    bool addEvents (const std::deque<AnalyticsEvent>& events);
+
+    /** Reads all the events in the file, adding them to the end of a queue. */
+    void readEvents (std::deque<AnalyticsEvent>& destination) const;
+
+    /** Deletes all the events in the file. */
+    void clear();
+
+    /** Returns the file that's being used. */
+    const File& getFile() const noexcept        { return file; }
+
+private:
+    //==============================================================================
+    File file;
+    int64 maximumSize;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalyticsEventSpool)
+};
+
+} // namespace juce
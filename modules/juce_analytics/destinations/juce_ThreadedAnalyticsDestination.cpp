@@ -43,6 +43,11 @@ void ThreadedAnalyticsDestination::setBatchPeriod (int newBatchPeriodMillisecond
     dispatcher.batchPeriodMilliseconds = newBatchPeriodMilliseconds;
 }
 
+void ThreadedAnalyticsDestination::setMaximumRetryPeriod (int maximumRetryPeriodMilliseconds)
+{
+    dispatcher.maximumRetryPeriodMilliseconds = maximumRetryPeriodMilliseconds;
+}
+
 void ThreadedAnalyticsDestination::logEvent (const AnalyticsEvent& event)
 {
     dispatcher.addToQueue (event);
@@ -85,28 +90,27 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
             eventQueue.push_front (*rit);
     }
 
-    const int maxBatchSize = parent.getMaximumBatchSize();
+    const int batchSize = parent.getMaximumBatchSize();
+    maxBatchSize = batchSize;
+
+    int numFailures = 0;
 
     while (! threadShouldExit())
     {
         {
+            const ScopedLock lock (queueAccess);
+
             const auto numEventsInBatch = eventsToSend.size();
-            const auto freeBatchCapacity = maxBatchSize - numEventsInBatch;
+            const auto freeBatchCapacity = batchSize - numEventsInBatch;
+            const auto numNewEvents = (int) eventQueue.size() - numEventsInBatch;
 
-            if (freeBatchCapacity > 0)
+            if (freeBatchCapacity > 0 && numNewEvents > 0)
             {
-                const auto numNewEvents = (int) eventQueue.size() - numEventsInBatch;
-
-                if (numNewEvents > 0)
-                {
-                    const ScopedLock lock (queueAccess);
+                const auto numEventsToAdd = jmin (numNewEvents, freeBatchCapacity);
+                const auto newBatchSize = numEventsInBatch + numEventsToAdd;
 
-                    const auto numEventsToAdd = jmin (numNewEvents, freeBatchCapacity);
-                    const auto newBatchSize = numEventsInBatch + numEventsToAdd;
-
-                    for (auto i = numEventsInBatch; i < newBatchSize; ++i)
-                        eventsToSend.add (eventQueue[(size_t) i]);
-                }
+                for (auto i = numEventsInBatch; i < newBatchSize; ++i)
+                    eventsToSend.add (eventQueue[(size_t) i]);
             }
         }
 
@@ -122,23 +126,67 @@ void ThreadedAnalyticsDestination::EventDispatcher::run()
                     eventQueue.pop_front();
 
                 eventsToSend.clearQuick();
+                numFailures = 0;
+            }
+            else
+            {
+                ++numFailures;
             }
         }
 
-        while (Time::getMillisecondCounter() - submissionTime < (uint32) batchPeriodMilliseconds.get())
+        // After a failure, this waits for the whole retry period. Otherwise, the next
+        // batch is sent as soon as there are enough events queued to fill it.
+        for (;;)
         {
             if (threadShouldExit())
                 return;
 
-            Thread::sleep (100);
+            if (numFailures == 0)
+            {
+                const ScopedLock lock (queueAccess);
+
+                if (batchSize > 0 && (int) eventQueue.size() >= batchSize)
+                    break;
+            }
+
+            const auto period = (uint32) (numFailures > 0 ? getRetryPeriod (numFailures)
+                                                          : batchPeriodMilliseconds.get());
+            const auto elapsed = Time::getMillisecondCounter() - submissionTime;
+
+            if (elapsed >= period)
+                break;
+
+            wait ((int) (period - elapsed));
         }
     }
 }
 
+int ThreadedAnalyticsDestination::EventDispatcher::getRetryPeriod (int numFailures) const noexcept
+{
+    const auto batchPeriod = batchPeriodMilliseconds.get();
+    const auto maximumPeriod = jmax (batchPeriod, maximumRetryPeriodMilliseconds.get());
+    auto period = batchPeriod;
+
+    for (int i = 0; i < numFailures && period < maximumPeriod; ++i)
+        period = (int) jmin ((int64) maximumPeriod, (int64) period * 2);
+
+    return period;
+}
+
 void ThreadedAnalyticsDestination::EventDispatcher::addToQueue (const AnalyticsEvent& event)
 {
-    const ScopedLock lock (queueAccess);
-    eventQueue.push_back (event);
+    bool batchIsFull;
+
+    {
+        const ScopedLock lock (queueAccess);
+        eventQueue.push_back (event);
+
+        const auto batchSize = maxBatchSize.get();
+        batchIsFull = batchSize > 0 && (int) eventQueue.size() >= batchSize;
+    }
+
+    if (batchIsFull)
+        notify();
 }
 
 //==============================================================================
@@ -150,12 +198,13 @@ namespace DestinationTestHelpers
     struct BasicDestination   : public ThreadedAnalyticsDestination
     {
         BasicDestination (std::deque<AnalyticsEvent>& loggedEvents,
-                          std::deque<AnalyticsEvent>& unloggedEvents)
+                          std::deque<AnalyticsEvent>& unloggedEvents,
+                          int batchPeriodMilliseconds = 20)
             : ThreadedAnalyticsDestination ("ThreadedAnalyticsDestinationTest"),
               loggedEventQueue (loggedEvents),
               unloggedEventStore (unloggedEvents)
         {
-            startAnalyticsThread (20);
+            startAnalyticsThread (batchPeriodMilliseconds);
         }
 
         ~BasicDestination()
@@ -182,6 +231,8 @@ namespace DestinationTestHelpers
         {
             jassert (events.size() <= getMaximumBatchSize());
 
+            ++numCalls;
+
             if (loggingIsEnabled)
             {
                 const ScopedLock lock (eventQueueChanging);
@@ -204,7 +255,8 @@ namespace DestinationTestHelpers
 
         std::deque<AnalyticsEvent>& loggedEventQueue;
         std::deque<AnalyticsEvent>& unloggedEventStore;
-        bool loggingIsEnabled = true;
+        std::atomic<bool> loggingIsEnabled { true };
+        std::atomic<int> numCalls { 0 };
         CriticalSection eventQueueChanging;
     };
 }
@@ -280,6 +332,52 @@ struct ThreadedAnalyticsDestinationTests   : public UnitTest
 
         compareEventQueues (unloggedEvents, testEvents);
         expect (loggedEvents.size() == 0);
+
+        unloggedEvents.clear();
+
+        beginTest ("Full batches");
+        {
+            // the batch period is long enough that the events will only be logged in time
+            // if full batches are sent straight away (there are enough events here for at
+            // least one full batch, even if the first batch is sent while they're being added)
+            DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents, 60000);
+
+            for (auto i = 0; i < 10; ++i)
+                destination.logEvent (testEvents[(size_t) i % testEvents.size()]);
+
+            for (auto waitTime = 0; waitTime < 4000; waitTime += 20)
+            {
+                Thread::sleep (20);
+
+                const ScopedLock lock (destination.eventQueueChanging);
+
+                if (loggedEvents.size() >= 5)
+                    break;
+            }
+
+            const ScopedLock lock (destination.eventQueueChanging);
+            expect (loggedEvents.size() >= 5);
+        }
+
+        expectEquals ((int) (loggedEvents.size() + unloggedEvents.size()), 10);
+
+        loggedEvents.clear();
+        unloggedEvents.clear();
+
+        beginTest ("Retry backoff");
+        {
+            DestinationTestHelpers::BasicDestination destination (loggedEvents, unloggedEvents);
+            destination.setMaximumRetryPeriod (100000);
+            destination.setLoggingEnabled (false);
+            destination.logEvent (testEvents[0]);
+
+            // without the backoff, there'd be around 25 attempts to log the event
+            Thread::sleep (500);
+            expect (destination.numCalls.load() <= 6);
+        }
+
+        expect (loggedEvents.size() == 0);
+        expectEquals ((int) unloggedEvents.size(), 1);
     }
 };
 
@@ -39,7 +39,14 @@ namespace juce
     Once startAnalyticsThread is called the logBatchedEvents method is
     periodically invoked on an analytics thread, with the period determined by
     calls to setBatchPeriod. Here events are grouped together into batches, with
-    the maximum batch size set by the implementation of getMaximumBatchSize.
+    the maximum batch size set by the implementation of getMaximumBatchSize. If
+    enough events are queued to fill a whole batch then it's sent straight away,
+    rather than waiting for the rest of the period.
+
+    When a batch can't be logged, the delay before it's retried can be made to
+    back off exponentially by calling setMaximumRetryPeriod. To keep unlogged
+    events between runs of your app, an AnalyticsEventSpool provides a compact
+    way to implement saveUnloggedEvents and restoreUnloggedEvents.
 
     It's important to call stopAnalyticsThread in the destructor of your
     subclass (or before then) to give the analytics thread time to shut down.
@@ -111,14 +118,34 @@ public:
     /**
         Call this to set the period between logBatchedEvents invocations.
 
-        This method is thread safe and can be used to implements things like
-        exponential backoff in logBatchedEvents calls.
+        This is the longest time that an event will wait before being passed to
+        logBatchedEvents, unless a previous batch failed to be logged (see
+        setMaximumRetryPeriod). A batch is sent sooner than this if enough events
+        are queued to fill it.
+
+        This method is thread safe.
 
         @param newSubmissionPeriodMilliseconds     the new submission period to
                                                    use in milliseconds
     */
     void setBatchPeriod (int newSubmissionPeriodMilliseconds);
 
+    /**
+        Enables an exponential backoff when logBatchedEvents fails.
+
+        After each consecutive failure the delay before the batch is retried is
+        doubled, starting from the batch period, until it reaches this limit. The
+        delay goes back to the batch period as soon as a batch is logged
+        successfully. By default the limit is zero, which means that failed
+        batches are retried after the normal batch period.
+
+        This method is thread safe.
+
+        @param maximumRetryPeriodMilliseconds      the longest delay to wait between
+                                                   retries, in milliseconds
+    */
+    void setMaximumRetryPeriod (int maximumRetryPeriodMilliseconds);
+
     /**
         Adds an event to the queue, which will ultimately be submitted to
         logBatchedEvents.
@@ -198,13 +225,15 @@ private:
 
         void run() override;
         void addToQueue (const AnalyticsEvent&);
+        int getRetryPeriod (int numFailures) const noexcept;
 
         ThreadedAnalyticsDestination& parent;
 
         std::deque<AnalyticsEvent> eventQueue;
         CriticalSection queueAccess;
 
-        Atomic<int> batchPeriodMilliseconds { 1000 };
+        Atomic<int> batchPeriodMilliseconds { 1000 }, maximumRetryPeriodMilliseconds { 0 };
+        Atomic<int> maxBatchSize { 0 };
 
         Array<AnalyticsEvent> eventsToSend;
     };
@@ -36,5 +36,6 @@
 #include "juce_analytics.h"
 
 #include "destinations/juce_ThreadedAnalyticsDestination.cpp"
+#include "destinations/juce_AnalyticsEventSpool.cpp"
 #include "analytics/juce_Analytics.cpp"
 #include "analytics/juce_ButtonTracker.cpp"
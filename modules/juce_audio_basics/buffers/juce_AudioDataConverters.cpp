@@ -461,6 +461,186 @@ void AudioDataConverters::deinterleaveSamples (const float* source, float** dest
 
 
 //==============================================================================
+//==============================================================================
+#if JUCE_USE_SSE_INTRINSICS
+namespace AudioDataConversionHelpers
+{
+    struct Int16Samples
+    {
+        enum { bytesPerSample = 2, shift = 16 };
+        static constexpr float scale = 1.0f / 0x8000;
+
+        static int32 read (const char* p) noexcept           { return (int16) *reinterpret_cast<const uint16*> (p); }
+        static void write (char* p, int32 value) noexcept    { *reinterpret_cast<uint16*> (p) = (uint16) value; }
+
+        static __m128i readFour (const char* p, int stride) noexcept
+        {
+            if (stride == bytesPerSample)
+            {
+                auto v = _mm_loadl_epi64 (reinterpret_cast<const __m128i*> (p));
+                return _mm_srai_epi32 (_mm_unpacklo_epi16 (v, v), 16);
+            }
+
+            return _mm_setr_epi32 (read (p), read (p + stride), read (p + 2 * stride), read (p + 3 * stride));
+        }
+
+        static void writeFour (char* p, int stride, __m128i values) noexcept
+        {
+            if (stride == bytesPerSample)
+            {
+                _mm_storel_epi64 (reinterpret_cast<__m128i*> (p), _mm_packs_epi32 (values, values));
+                return;
+            }
+
+            int32 v[4];
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (v), values);
+
+            for (int i = 0; i < 4; ++i)
+                write (p + i * stride, v[i]);
+        }
+    };
+
+    struct Int24Samples
+    {
+        enum { bytesPerSample = 3, shift = 8 };
+        static constexpr float scale = 1.0f / 0x800000;
+
+        static int32 read (const char* p) noexcept           { return ByteOrder::littleEndian24Bit (p); }
+        static void write (char* p, int32 value) noexcept    { ByteOrder::littleEndian24BitToChars (value, p); }
+
+        static __m128i readFour (const char* p, int stride) noexcept
+        {
+            return _mm_setr_epi32 (read (p), read (p + stride), read (p + 2 * stride), read (p + 3 * stride));
+        }
+
+        static void writeFour (char* p, int stride, __m128i values) noexcept
+        {
+            int32 v[4];
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (v), values);
+
+            for (int i = 0; i < 4; ++i)
+                write (p + i * stride, v[i]);
+        }
+    };
+
+    struct Int32Samples
+    {
+        enum { bytesPerSample = 4, shift = 0 };
+        static constexpr float scale = 1.0f / 0x80000000u;
+
+        static int32 read (const char* p) noexcept           { return *reinterpret_cast<const int32*> (p); }
+        static void write (char* p, int32 value) noexcept    { *reinterpret_cast<int32*> (p) = value; }
+
+        static __m128i readFour (const char* p, int stride) noexcept
+        {
+            if (stride == bytesPerSample)
+                return _mm_loadu_si128 (reinterpret_cast<const __m128i*> (p));
+
+            return _mm_setr_epi32 (read (p), read (p + stride), read (p + 2 * stride), read (p + 3 * stride));
+        }
+
+        static void writeFour (char* p, int stride, __m128i values) noexcept
+        {
+            if (stride == bytesPerSample)
+            {
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (p), values);
+                return;
+            }
+
+            int32 v[4];
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (v), values);
+
+            for (int i = 0; i < 4; ++i)
+                write (p + i * stride, v[i]);
+        }
+    };
+
+    // Integer samples are scaled by a power of two, so converting them to float first
+    // gives the same rounding as the double arithmetic used by AudioData::Pointer.
+    template <class Format>
+    static bool convertToFloat (void* destData, int destStride, const void* sourceData, int sourceStride, int numSamples) noexcept
+    {
+        if (destStride != (int) sizeof (float))
+            return false;
+
+        auto* dest = static_cast<float*> (destData);
+        auto* source = static_cast<const char*> (sourceData);
+        const auto scale = _mm_set1_ps (Format::scale);
+
+        for (; numSamples >= 4; numSamples -= 4)
+        {
+            _mm_storeu_ps (dest, _mm_mul_ps (_mm_cvtepi32_ps (Format::readFour (source, sourceStride)), scale));
+            dest += 4;
+            source += 4 * sourceStride;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = (float) Format::read (source + i * sourceStride) * Format::scale;
+
+        return true;
+    }
+
+    // Floats are converted to 32-bit integers in double precision, rounding to nearest,
+    // and then shifted down to the destination's width, just like Pointer::convertSamples().
+    static forcedinline __m128i floatToInt32 (__m128 v) noexcept
+    {
+        const auto one = _mm_set1_pd (1.0), minusOne = _mm_set1_pd (-1.0), maxValue = _mm_set1_pd ((double) 0x7fffffff);
+
+        auto lo = _mm_cvtps_pd (v);
+        auto hi = _mm_cvtps_pd (_mm_movehl_ps (v, v));
+        lo = _mm_mul_pd (_mm_min_pd (_mm_max_pd (lo, minusOne), one), maxValue);
+        hi = _mm_mul_pd (_mm_min_pd (_mm_max_pd (hi, minusOne), one), maxValue);
+
+        return _mm_unpacklo_epi64 (_mm_cvtpd_epi32 (lo), _mm_cvtpd_epi32 (hi));
+    }
+
+    template <class Format>
+    static bool convertFromFloat (void* destData, int destStride, const void* sourceData, int sourceStride, int numSamples) noexcept
+    {
+        if (sourceStride != (int) sizeof (float))
+            return false;
+
+        auto* dest = static_cast<char*> (destData);
+        auto* source = static_cast<const float*> (sourceData);
+
+        for (; numSamples >= 4; numSamples -= 4)
+        {
+            Format::writeFour (dest, destStride, _mm_srai_epi32 (floatToInt32 (_mm_loadu_ps (source)), Format::shift));
+            dest += 4 * destStride;
+            source += 4;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            Format::write (dest + i * destStride, roundToInt (jlimit (-1.0, 1.0, (double) source[i]) * (double) 0x7fffffff) >> Format::shift);
+
+        return true;
+    }
+}
+
+#define JUCE_FAST_AUDIO_DATA_CONVERSION(destFormat, sourceFormat, function, Samples) \
+    bool AudioData::FastConversions::convertLittleEndian (destFormat*, sourceFormat*, void* dest, int destStride, \
+                                                          const void* source, int sourceStride, int numSamples) noexcept \
+    { \
+        return AudioDataConversionHelpers::function<AudioDataConversionHelpers::Samples> (dest, destStride, source, sourceStride, numSamples); \
+    }
+#else
+#define JUCE_FAST_AUDIO_DATA_CONVERSION(destFormat, sourceFormat, function, Samples) \
+    bool AudioData::FastConversions::convertLittleEndian (destFormat*, sourceFormat*, void*, int, const void*, int, int) noexcept \
+    { \
+        return false; \
+    }
+#endif
+
+JUCE_FAST_AUDIO_DATA_CONVERSION (Float32, Int16, convertToFloat, Int16Samples)
+JUCE_FAST_AUDIO_DATA_CONVERSION (Float32, Int24, convertToFloat, Int24Samples)
+JUCE_FAST_AUDIO_DATA_CONVERSION (Float32, Int32, convertToFloat, Int32Samples)
+JUCE_FAST_AUDIO_DATA_CONVERSION (Int16, Float32, convertFromFloat, Int16Samples)
+JUCE_FAST_AUDIO_DATA_CONVERSION (Int24, Float32, convertFromFloat, Int24Samples)
+JUCE_FAST_AUDIO_DATA_CONVERSION (Int32, Float32, convertFromFloat, Int32Samples)
+
+#undef JUCE_FAST_AUDIO_DATA_CONVERSION
+
+
 #if JUCE_UNIT_TESTS
 
 class AudioConversionTests  : public UnitTest
@@ -568,6 +748,71 @@ public:
         }
     };
 
+    template <class IntegerFormat>
+    struct InterleavedFloatTest
+    {
+        using IntegerType      = AudioData::Pointer<IntegerFormat, AudioData::LittleEndian, AudioData::Interleaved, AudioData::NonConst>;
+        using ConstIntegerType = AudioData::Pointer<IntegerFormat, AudioData::LittleEndian, AudioData::Interleaved, AudioData::Const>;
+        using FloatType        = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+        using ConstFloatType   = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+
+        static void test (UnitTest& unitTest, Random& r)
+        {
+            test (unitTest, 1, r);
+            test (unitTest, 3, r);
+        }
+
+        // Checks that converting each channel matches converting one sample at a time
+        static void test (UnitTest& unitTest, int numChannels, Random& r)
+        {
+            const int numSamples = 1000 + r.nextInt (8);
+            const int numBytes = numChannels * numSamples * IntegerFormat::bytesPerSample;
+            HeapBlock<char> original (numBytes), converted (numBytes, true);
+            HeapBlock<float> floats (numSamples);
+
+            {
+                IntegerType d (original, 1);
+
+                for (int i = 0; i < numChannels * numSamples; ++i, ++d)
+                    d.setAsInt32 (r.nextInt());
+            }
+
+            AudioData::ConverterInstance<ConstIntegerType, FloatType> toFloat (numChannels, 1);
+            AudioData::ConverterInstance<ConstFloatType, IntegerType> fromFloat (1, numChannels);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                toFloat.convertSamples (floats, 0, original, channel, numSamples);
+
+                bool floatsMatch = true;
+                ConstIntegerType s (original + channel * IntegerFormat::bytesPerSample, numChannels);
+
+                for (int i = 0; i < numSamples; ++i, ++s)
+                    floatsMatch = floatsMatch && floats[i] == s.getAsFloat();
+
+                unitTest.expect (floatsMatch);
+
+                floats[r.nextInt (numSamples)] = 1.5f;
+                floats[r.nextInt (numSamples)] = -2.0f;
+                fromFloat.convertSamples (converted, channel, floats, 0, numSamples);
+
+                bool integersMatch = true;
+                ConstFloatType f (floats.get());
+                ConstIntegerType d (converted + channel * IntegerFormat::bytesPerSample, numChannels);
+
+                for (int i = 0; i < numSamples; ++i, ++f, ++d)
+                {
+                    int32 expected = 0;
+                    AudioData::Pointer<IntegerFormat, AudioData::LittleEndian, AudioData::NonInterleaved, AudioData::NonConst> e (&expected);
+                    e.setAsInt32 (f.getAsInt32());
+                    integersMatch = integersMatch && d.getAsInt32() == e.getAsInt32();
+                }
+
+                unitTest.expect (integersMatch);
+            }
+        }
+    };
+
     void runTest() override
     {
         auto r = getRandom();
@@ -581,6 +826,11 @@ public:
         Test1 <AudioData::Int32>::test (*this, r);
         beginTest ("Round-trip conversion: Float32");
         Test1 <AudioData::Float32>::test (*this, r);
+
+        beginTest ("Interleaved conversion to and from Float32");
+        InterleavedFloatTest <AudioData::Int16>::test (*this, r);
+        InterleavedFloatTest <AudioData::Int24>::test (*this, r);
+        InterleavedFloatTest <AudioData::Int32>::test (*this, r);
     }
 };
 
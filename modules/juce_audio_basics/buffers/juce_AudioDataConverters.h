@@ -320,6 +320,38 @@ public:
         static inline void* toVoidPtr (VoidType* v) noexcept { return const_cast<void*> (v); }
         enum { isConst = 1 };
     };
+
+    //==============================================================================
+    /*  Vectorised conversions between native 32-bit floats and little-endian integer samples,
+        which Pointer::convertSamples() tries before falling back to its per-sample loop.
+        They give exactly the same results as the loop, and return false for any combination
+        of formats and layouts that they can't handle.
+    */
+    struct JUCE_API FastConversions
+    {
+        template <class DestFormat, class DestEndianness, class SourceFormat, class SourceEndianness>
+        static bool convert (void* dest, int destStride, const void* source, int sourceStride, int numSamples) noexcept
+        {
+           #if JUCE_LITTLE_ENDIAN
+            if (std::is_base_of<LittleEndian, DestEndianness>::value && std::is_base_of<LittleEndian, SourceEndianness>::value)
+                return convertLittleEndian (static_cast<DestFormat*> (nullptr), static_cast<SourceFormat*> (nullptr),
+                                            dest, destStride, source, sourceStride, numSamples);
+           #endif
+
+            ignoreUnused (dest, destStride, source, sourceStride, numSamples);
+            return false;
+        }
+
+        template <class DestFormat, class SourceFormat>
+        static bool convertLittleEndian (DestFormat*, SourceFormat*, void*, int, const void*, int, int) noexcept  { return false; }
+
+        static bool convertLittleEndian (Float32*, Int16*, void*, int, const void*, int, int) noexcept;
+        static bool convertLittleEndian (Float32*, Int24*, void*, int, const void*, int, int) noexcept;
+        static bool convertLittleEndian (Float32*, Int32*, void*, int, const void*, int, int) noexcept;
+        static bool convertLittleEndian (Int16*, Float32*, void*, int, const void*, int, int) noexcept;
+        static bool convertLittleEndian (Int24*, Float32*, void*, int, const void*, int, int) noexcept;
+        static bool convertLittleEndian (Int32*, Float32*, void*, int, const void*, int, int) noexcept;
+    };
   #endif
 
     //==============================================================================
@@ -354,6 +386,9 @@ public:
     class Pointer  : private InterleavingType  // (inherited for EBCO)
     {
     public:
+        using SampleFormatType = SampleFormat;
+        using EndiannessType = Endianness;
+
         //==============================================================================
         /** Creates a non-interleaved pointer from some raw data in the appropriate format.
             This constructor is only used if you've specified the AudioData::NonInterleaved option -
@@ -461,6 +496,11 @@ public:
             // trying to write to a const pointer! For a writeable one, use AudioData::NonConst instead!
             static_assert (Constness::isConst == 0, "Attempt to write to a const pointer");
 
+            if (source.getRawData() != getRawData()
+                 && FastConversions::convert<SampleFormat, Endianness, typename OtherPointerType::SampleFormatType, typename OtherPointerType::EndiannessType>
+                        (data.data, getNumBytesBetweenSamples(), source.getRawData(), source.getNumBytesBetweenSamples(), numSamples))
+                return;
+
             Pointer dest (*this);
 
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
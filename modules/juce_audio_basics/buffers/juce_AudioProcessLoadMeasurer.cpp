@@ -27,7 +27,11 @@
 namespace juce
 {
 
-AudioProcessLoadMeasurer::AudioProcessLoadMeasurer() {}
+AudioProcessLoadMeasurer::AudioProcessLoadMeasurer()
+{
+    reset();
+}
+
 AudioProcessLoadMeasurer::~AudioProcessLoadMeasurer() {}
 
 void AudioProcessLoadMeasurer::reset()
@@ -39,6 +43,21 @@ void AudioProcessLoadMeasurer::reset (double sampleRate, int blockSize)
 {
     cpuUsageMs = 0;
     xruns = 0;
+    numBlocks = 0;
+    maxBlockTime = 0;
+    numOverruns = 0;
+
+    for (auto& bin : histogram)
+        bin = 0;
+
+    for (auto& t : recentBlockTimes)
+        t = 0;
+
+    for (int i = 0; i < maxRecentOverruns; ++i)
+    {
+        overrunTimes[i] = 0;
+        overrunDurations[i] = 0;
+    }
 
     if (sampleRate > 0.0 && blockSize > 0)
     {
@@ -55,10 +74,38 @@ void AudioProcessLoadMeasurer::reset (double sampleRate, int blockSize)
 void AudioProcessLoadMeasurer::registerBlockRenderTime (double milliseconds)
 {
     const double filterAmount = 0.2;
-    cpuUsageMs += filterAmount * (milliseconds - cpuUsageMs);
+    auto usage = cpuUsageMs.load (std::memory_order_relaxed);
+    cpuUsageMs.store (usage + filterAmount * (milliseconds - usage), std::memory_order_relaxed);
+
+    // this is the only thread that writes these, so they don't need to be updated atomically
+    auto blockIndex = numBlocks.load (std::memory_order_relaxed);
+    recentBlockTimes[blockIndex % recentHistorySize].store ((float) milliseconds, std::memory_order_relaxed);
+
+    if (milliseconds > maxBlockTime.load (std::memory_order_relaxed))
+        maxBlockTime.store (milliseconds, std::memory_order_relaxed);
+
+    auto blockLength = msPerBlock.load (std::memory_order_relaxed);
+
+    if (blockLength > 0)
+    {
+        auto bin = jmin ((int) numHistogramBins - 1, (int) (milliseconds * histogramBinsPerBlock / blockLength));
+        histogram[bin].fetch_add (1, std::memory_order_relaxed);
+    }
 
-    if (milliseconds > msPerBlock)
+    if (milliseconds > blockLength)
+    {
         ++xruns;
+
+        auto overrunIndex = numOverruns.load (std::memory_order_relaxed) % maxRecentOverruns;
+
+        overrunSequence.fetch_add (1, std::memory_order_acq_rel);
+        overrunTimes[overrunIndex].store (Time::getMillisecondCounterHiRes(), std::memory_order_relaxed);
+        overrunDurations[overrunIndex].store (milliseconds, std::memory_order_relaxed);
+        numOverruns.fetch_add (1, std::memory_order_relaxed);
+        overrunSequence.fetch_add (1, std::memory_order_release);
+    }
+
+    numBlocks.store (blockIndex + 1, std::memory_order_release);
 }
 
 double AudioProcessLoadMeasurer::getLoadAsProportion() const   { return jlimit (0.0, 1.0, timeToCpuScale * cpuUsageMs); }
@@ -66,6 +113,111 @@ double AudioProcessLoadMeasurer::getLoadAsPercentage() const   { return 100.0 *
 
 int AudioProcessLoadMeasurer::getXRunCount() const             { return xruns; }
 
+//==============================================================================
+int AudioProcessLoadMeasurer::getNumBlocksRecorded() const     { return numBlocks; }
+double AudioProcessLoadMeasurer::getMaximumBlockTime() const    { return maxBlockTime; }
+double AudioProcessLoadMeasurer::getHistogramBinWidth() const   { return msPerBlock / histogramBinsPerBlock; }
+
+Array<int> AudioProcessLoadMeasurer::getHistogram() const
+{
+    Array<int> result;
+    result.ensureStorageAllocated (numHistogramBins);
+
+    for (auto& bin : histogram)
+        result.add (bin.load (std::memory_order_relaxed));
+
+    return result;
+}
+
+double AudioProcessLoadMeasurer::getBlockTimePercentile (double proportion) const
+{
+    jassert (proportion >= 0.0 && proportion <= 1.0);
+
+    auto bins = getHistogram();
+    int64 total = 0;
+
+    for (auto count : bins)
+        total += count;
+
+    if (total == 0)
+        return 0;
+
+    auto threshold = jmax ((int64) 1, (int64) std::ceil (proportion * (double) total));
+    int64 sum = 0;
+
+    for (int i = 0; i < bins.size(); ++i)
+    {
+        sum += bins.getUnchecked (i);
+
+        if (sum >= threshold)
+            return (i + 1) * getHistogramBinWidth();
+    }
+
+    return getMaximumBlockTime();
+}
+
+Array<float> AudioProcessLoadMeasurer::getRecentBlockTimes() const
+{
+    auto num = jmin ((int) recentHistorySize, numBlocks.load (std::memory_order_acquire));
+
+    Array<float> times;
+    times.ensureStorageAllocated (num);
+
+    for (int i = 0; i < num; ++i)
+        times.add (recentBlockTimes[i].load (std::memory_order_relaxed));
+
+    return times;
+}
+
+double AudioProcessLoadMeasurer::getRecentBlockTimePercentile (double proportion) const
+{
+    jassert (proportion >= 0.0 && proportion <= 1.0);
+
+    auto times = getRecentBlockTimes();
+
+    if (times.isEmpty())
+        return 0;
+
+    auto index = jlimit (0, times.size() - 1, (int) std::ceil (proportion * times.size()) - 1);
+    std::nth_element (times.begin(), times.begin() + index, times.end());
+    return times.getUnchecked (index);
+}
+
+double AudioProcessLoadMeasurer::getRecentMaximumBlockTime() const
+{
+    auto times = getRecentBlockTimes();
+    return times.isEmpty() ? 0.0 : (double) *std::max_element (times.begin(), times.end());
+}
+
+Array<AudioProcessLoadMeasurer::Overrun> AudioProcessLoadMeasurer::getRecentOverruns() const
+{
+    Array<Overrun> result;
+
+    for (;;)
+    {
+        auto sequence = overrunSequence.load (std::memory_order_acquire);
+
+        if ((sequence & 1) == 0)
+        {
+            auto total = numOverruns.load (std::memory_order_relaxed);
+            auto num = jmin ((int) maxRecentOverruns, total);
+
+            result.clearQuick();
+
+            for (int i = total - num; i < total; ++i)
+                result.add ({ overrunTimes[i % maxRecentOverruns].load (std::memory_order_relaxed),
+                              overrunDurations[i % maxRecentOverruns].load (std::memory_order_relaxed) });
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (overrunSequence.load (std::memory_order_relaxed) == sequence)
+                return result;
+        }
+
+        Thread::yield();
+    }
+}
+
 AudioProcessLoadMeasurer::ScopedTimer::ScopedTimer (AudioProcessLoadMeasurer& p)
    : owner (p), startTime (Time::getMillisecondCounterHiRes())
 {
@@ -76,4 +228,102 @@ AudioProcessLoadMeasurer::ScopedTimer::~ScopedTimer()
     owner.registerBlockRenderTime (Time::getMillisecondCounterHiRes() - startTime);
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessLoadMeasurerTests  : public UnitTest
+{
+public:
+    AudioProcessLoadMeasurerTests()  : UnitTest ("AudioProcessLoadMeasurer", "Audio") {}
+
+    void runTest() override
+    {
+        beginTest ("Block time statistics");
+        {
+            // 10ms blocks
+            AudioProcessLoadMeasurer measurer;
+            measurer.reset (48000.0, 480);
+
+            // times of 0.01, 0.02 .. 10ms, shuffled
+            Array<double> times;
+
+            for (int i = 1; i <= 1000; ++i)
+                times.add (i * 0.01);
+
+            auto r = getRandom();
+
+            for (int i = times.size(); --i > 0;)
+                times.swap (i, r.nextInt (i + 1));
+
+            for (auto t : times)
+                measurer.registerBlockRenderTime (t);
+
+            expectEquals (measurer.getNumBlocksRecorded(), 1000);
+            expectEquals (measurer.getXRunCount(), 0);
+            expectWithinAbsoluteError (measurer.getMaximumBlockTime(), 10.0, 1.0e-9);
+            expectWithinAbsoluteError (measurer.getRecentMaximumBlockTime(), 10.0, 1.0e-5);
+            expectWithinAbsoluteError (measurer.getRecentBlockTimePercentile (0.5), 5.0, 1.0e-5);
+            expectWithinAbsoluteError (measurer.getRecentBlockTimePercentile (0.99), 9.9, 1.0e-5);
+            expectWithinAbsoluteError (measurer.getRecentBlockTimePercentile (0.999), 9.99, 1.0e-5);
+
+            auto binWidth = measurer.getHistogramBinWidth();
+            expectWithinAbsoluteError (binWidth, 10.0 / AudioProcessLoadMeasurer::histogramBinsPerBlock, 1.0e-9);
+
+            auto histogram = measurer.getHistogram();
+            expectEquals (histogram.size(), (int) AudioProcessLoadMeasurer::numHistogramBins);
+
+            int total = 0;
+
+            for (auto count : histogram)
+                total += count;
+
+            expectEquals (total, 1000);
+
+            // the estimate is rounded up to the end of a bin
+            auto p99 = measurer.getBlockTimePercentile (0.99);
+            expect (p99 >= 9.9 && p99 <= 9.9 + binWidth);
+        }
+
+        beginTest ("Recording overruns");
+        {
+            AudioProcessLoadMeasurer measurer;
+            measurer.reset (48000.0, 480);
+
+            for (int i = 0; i < 3000; ++i)
+                measurer.registerBlockRenderTime (i % 100 == 0 ? 50.0 + i : 1.0);
+
+            expectEquals (measurer.getXRunCount(), 30);
+            expectWithinAbsoluteError (measurer.getMaximumBlockTime(), 2950.0, 1.0e-9);
+
+            // only the last few callbacks are used for the recent statistics
+            expectWithinAbsoluteError (measurer.getRecentMaximumBlockTime(), 2950.0, 1.0e-3);
+            expectWithinAbsoluteError (measurer.getRecentBlockTimePercentile (0.9), 1.0, 1.0e-6);
+
+            auto overruns = measurer.getRecentOverruns();
+            expectEquals (overruns.size(), (int) AudioProcessLoadMeasurer::maxRecentOverruns);
+
+            for (int i = 0; i < overruns.size(); ++i)
+            {
+                expectWithinAbsoluteError (overruns[i].duration, 50.0 + (14 + i) * 100, 1.0e-9);
+
+                if (i > 0)
+                    expect (overruns[i].time >= overruns[i - 1].time);
+            }
+
+            // anything beyond the end of the histogram goes into the last bin
+            expectEquals (measurer.getHistogram().getLast(), 30);
+
+            measurer.reset();
+            expectEquals (measurer.getNumBlocksRecorded(), 0);
+            expect (measurer.getRecentOverruns().isEmpty());
+            expectEquals (measurer.getRecentMaximumBlockTime(), 0.0);
+        }
+    }
+};
+
+static AudioProcessLoadMeasurerTests audioProcessLoadMeasurerTests;
+
+#endif
+
 } // namespace juce
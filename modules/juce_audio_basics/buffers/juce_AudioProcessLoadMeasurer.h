@@ -31,6 +31,12 @@ namespace juce
 /**
     Maintains an ongoing measurement of the proportion of time which is being
     spent inside an audio callback.
+
+    As well as the smoothed load, it keeps some statistics about the time taken by
+    each callback: a histogram of all the callbacks since it was reset, the times of
+    the most recent callbacks, from which percentiles can be calculated, and a list
+    of the most recent overruns. These are all recorded without locking on the audio
+    thread, and can be read from any other thread.
 */
 class JUCE_API  AudioProcessLoadMeasurer
 {
@@ -57,6 +63,58 @@ public:
     /** Returns the number of over- (or under-) runs recorded since the state was reset. */
     int getXRunCount() const;
 
+    //==============================================================================
+    enum
+    {
+        numHistogramBins        = 128,  /**< The number of bins in the histogram returned by getHistogram(). */
+        histogramBinsPerBlock   = 32,   /**< The number of histogram bins covering the time of one block. */
+        recentHistorySize       = 2048, /**< The number of callbacks used by the getRecent...() methods. */
+        maxRecentOverruns       = 16    /**< The number of overruns that getRecentOverruns() remembers. */
+    };
+
+    /** Returns the number of callbacks that have been recorded since the state was reset. */
+    int getNumBlocksRecorded() const;
+
+    /** Returns the longest time, in milliseconds, that a callback has taken since the state was reset. */
+    double getMaximumBlockTime() const;
+
+    /** Returns a histogram of the time taken by all the callbacks since the state was reset.
+
+        Bin i counts the callbacks that took between i and i + 1 times getHistogramBinWidth(),
+        and the last bin also counts any that took longer than that. The histogram is only
+        collected once the measurer has been given a sample rate and block size.
+    */
+    Array<int> getHistogram() const;
+
+    /** Returns the width of each bin of the histogram, in milliseconds. */
+    double getHistogramBinWidth() const;
+
+    /** Uses the histogram to estimate the time, in milliseconds, within which the given
+        proportion of all the callbacks since the last reset have finished. This is rounded
+        up to the end of a histogram bin.
+    */
+    double getBlockTimePercentile (double proportion) const;
+
+    /** Returns the time, in milliseconds, within which the given proportion (e.g. 0.99)
+        of the last recentHistorySize callbacks have finished.
+    */
+    double getRecentBlockTimePercentile (double proportion) const;
+
+    /** Returns the longest time, in milliseconds, taken by one of the last
+        recentHistorySize callbacks.
+    */
+    double getRecentMaximumBlockTime() const;
+
+    /** Describes a callback that took longer than the time available for it. */
+    struct Overrun
+    {
+        double time;        /**< When the callback finished, as a Time::getMillisecondCounterHiRes() value. */
+        double duration;    /**< How long the callback took, in milliseconds. */
+    };
+
+    /** Returns the last few overruns, up to maxRecentOverruns of them, in the order they happened. */
+    Array<Overrun> getRecentOverruns() const;
+
     //==============================================================================
     /** This class measures the time between its construction and destruction and
         adds it to an AudioProcessLoadMeasurer.
@@ -88,8 +146,21 @@ public:
     void registerBlockRenderTime (double millisecondsTaken);
 
 private:
-    double cpuUsageMs = 0, timeToCpuScale = 0, msPerBlock = 0;
-    int xruns = 0;
+    std::atomic<double> cpuUsageMs { 0 }, timeToCpuScale { 0 }, msPerBlock { 0 }, maxBlockTime { 0 };
+    std::atomic<int> xruns { 0 }, numBlocks { 0 };
+
+    std::atomic<int> histogram[numHistogramBins];
+    std::atomic<float> recentBlockTimes[recentHistorySize];
+
+    // The overruns are written under a sequence lock, so that a reader can tell if one of
+    // the entries was changed while it was copying them. The writer never has to wait.
+    std::atomic<double> overrunTimes[maxRecentOverruns], overrunDurations[maxRecentOverruns];
+    std::atomic<uint32> overrunSequence { 0 };
+    std::atomic<int> numOverruns { 0 };
+
+    Array<float> getRecentBlockTimes() const;
+
+    JUCE_DECLARE_NON_COPYABLE (AudioProcessLoadMeasurer)
 };
 
 
@@ -485,6 +485,482 @@ namespace FloatVectorHelpers
         }
     };
    #endif
+
+    //==============================================================================
+    /*  Each ramped gain is worked out as startGain + gainIncrement * index rather than by
+        accumulating the increment, so that long ramps don't drift and the vectorised
+        values agree with the ones computed for the remainder.
+    */
+   #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON || JUCE_USE_AVX_INTRINSICS
+    #define JUCE_PERFORM_RAMP_OP(normalOp, vecOp, increment) \
+        int rampIndex = 0; \
+        if (Mode::numParallel > 1) \
+        { \
+            Type indices[Mode::numParallel]; \
+            for (int i = 0; i < (int) Mode::numParallel; ++i) indices[i] = (Type) i; \
+            auto index = Mode::loadU (indices); \
+            const auto indexStep = Mode::load1 ((Type) Mode::numParallel); \
+            const auto start = Mode::load1 (startGain), inc = Mode::load1 (gainIncrement); \
+            for (int numLongOps = num / Mode::numParallel; --numLongOps >= 0;) \
+            { \
+                const auto gain = Mode::add (start, Mode::mul (inc, index)); \
+                vecOp; \
+                index = Mode::add (index, indexStep); \
+                increment; \
+            } \
+            rampIndex = num & ~(Mode::numParallel - 1); \
+            num &= (Mode::numParallel - 1); \
+        } \
+        for (int i = 0; i < num; ++i, ++rampIndex) normalOp;
+
+    /*  The equal-power gains are the cosine and sine of the fade position mapped onto a
+        quarter turn. They're rotated from one block to the next rather than evaluated for
+        every value, the remainder being computed directly.
+    */
+    #define JUCE_PERFORM_EQUAL_POWER_CROSSFADE(increment) \
+        int fadeIndex = 0; \
+        if (Mode::numParallel > 1) \
+        { \
+            Type cosines[Mode::numParallel], sines[Mode::numParallel]; \
+            for (int i = 0; i < (int) Mode::numParallel; ++i) \
+            { \
+                const auto angle = (startPosition + positionIncrement * (Type) i) * MathConstants<Type>::halfPi; \
+                cosines[i] = std::cos (angle); \
+                sines[i] = std::sin (angle); \
+            } \
+            auto fadeOutGain = Mode::loadU (cosines), fadeInGain = Mode::loadU (sines); \
+            const auto rotation = positionIncrement * (Type) Mode::numParallel * MathConstants<Type>::halfPi; \
+            const auto rotationCos = Mode::load1 (std::cos (rotation)), rotationSin = Mode::load1 (std::sin (rotation)); \
+            for (int numLongOps = num / Mode::numParallel; --numLongOps >= 0;) \
+            { \
+                Mode::storeU (dest, Mode::add (Mode::mul (Mode::loadU (src1), fadeOutGain), Mode::mul (Mode::loadU (src2), fadeInGain))); \
+                const auto nextFadeOutGain = Mode::sub (Mode::mul (fadeOutGain, rotationCos), Mode::mul (fadeInGain, rotationSin)); \
+                fadeInGain = Mode::add (Mode::mul (fadeInGain, rotationCos), Mode::mul (fadeOutGain, rotationSin)); \
+                fadeOutGain = nextFadeOutGain; \
+                increment; \
+            } \
+            fadeIndex = num & ~(Mode::numParallel - 1); \
+            num &= (Mode::numParallel - 1); \
+        } \
+        for (int i = 0; i < num; ++i, ++fadeIndex) \
+        { \
+            const auto angle = (startPosition + positionIncrement * (Type) fadeIndex) * MathConstants<Type>::halfPi; \
+            dest[i] = src1[i] * std::cos (angle) + src2[i] * std::sin (angle); \
+        }
+   #endif
+
+    #define JUCE_RAMP_GAIN  (startGain + gainIncrement * (Type) rampIndex)
+
+    template <typename Type>
+    static Type getRampIncrement (Type startValue, Type endValue, int num) noexcept
+    {
+        return (endValue - startValue) / (Type) jmax (1, num);
+    }
+
+    struct Ramps
+    {
+        template <typename Type>
+        static void copyWithRamp (Type* dest, const Type* src, Type startGain, Type gainIncrement, int num) noexcept
+        {
+           #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+            using Mode = typename ModeType<sizeof (Type)>::Mode;
+            JUCE_PERFORM_RAMP_OP (dest[i] = src[i] * JUCE_RAMP_GAIN, Mode::storeU (dest, Mode::mul (Mode::loadU (src), gain)),
+                                  JUCE_INCREMENT_SRC_DEST)
+           #else
+            for (int rampIndex = 0; rampIndex < num; ++rampIndex)
+                dest[rampIndex] = src[rampIndex] * JUCE_RAMP_GAIN;
+           #endif
+        }
+
+        template <typename Type>
+        static void addWithRamp (Type* dest, const Type* src, Type startGain, Type gainIncrement, int num) noexcept
+        {
+           #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+            using Mode = typename ModeType<sizeof (Type)>::Mode;
+            JUCE_PERFORM_RAMP_OP (dest[i] += src[i] * JUCE_RAMP_GAIN,
+                                  Mode::storeU (dest, Mode::add (Mode::loadU (dest), Mode::mul (Mode::loadU (src), gain))),
+                                  JUCE_INCREMENT_SRC_DEST)
+           #else
+            for (int rampIndex = 0; rampIndex < num; ++rampIndex)
+                dest[rampIndex] += src[rampIndex] * JUCE_RAMP_GAIN;
+           #endif
+        }
+
+        template <typename Type>
+        static void copyWithEqualPowerCrossfade (Type* dest, const Type* src1, const Type* src2,
+                                                 Type startPosition, Type positionIncrement, int num) noexcept
+        {
+           #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+            using Mode = typename ModeType<sizeof (Type)>::Mode;
+            JUCE_PERFORM_EQUAL_POWER_CROSSFADE (JUCE_INCREMENT_SRC1_SRC2_DEST)
+           #else
+            for (int i = 0; i < num; ++i)
+            {
+                const auto angle = (startPosition + positionIncrement * (Type) i) * MathConstants<Type>::halfPi;
+                dest[i] = src1[i] * std::cos (angle) + src2[i] * std::sin (angle);
+            }
+           #endif
+        }
+    };
+
+    //==============================================================================
+   #if JUCE_USE_AVX_INTRINSICS
+    /*  These kernels are compiled for AVX2 regardless of the compiler's target flags,
+        and the public functions only call them once SystemStats has confirmed that the
+        CPU supports it. They don't use FMA, so their results match the SSE ones exactly.
+    */
+    #if JUCE_MSVC
+     #define JUCE_AVX_TARGET
+    #else
+     #define JUCE_AVX_TARGET __attribute__ ((target ("avx2")))
+    #endif
+
+    struct AVXOps32
+    {
+        using Type = float;
+        using ParallelType = __m256;
+        enum { numParallel = 8 };
+
+        static forcedinline JUCE_AVX_TARGET ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+        static forcedinline JUCE_AVX_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm256_and_ps (a, b); }
+    };
+
+    struct AVXOps64
+    {
+        using Type = double;
+        using ParallelType = __m256d;
+        enum { numParallel = 4 };
+
+        static forcedinline JUCE_AVX_TARGET ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+        static forcedinline JUCE_AVX_TARGET ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+        static forcedinline JUCE_AVX_TARGET void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+        static forcedinline JUCE_AVX_TARGET ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+        static forcedinline JUCE_AVX_TARGET ParallelType bit_and (ParallelType a, ParallelType b) noexcept  { return _mm256_and_pd (a, b); }
+    };
+
+    template <int typeSize> struct AVXModeType    { using Mode = AVXOps32; };
+    template <>             struct AVXModeType<8> { using Mode = AVXOps64; };
+
+    #define JUCE_AVX_VEC_OP(normalOp, vecOp, setupOp, increment) \
+        using Mode = typename AVXModeType<sizeof (*dest)>::Mode; \
+        setupOp \
+        for (int numLongOps = num / Mode::numParallel; --numLongOps >= 0;) \
+        { \
+            vecOp; \
+            increment; \
+        } \
+        _mm256_zeroupper(); \
+        num &= (Mode::numParallel - 1); \
+        for (int i = 0; i < num; ++i) normalOp;
+
+    #define JUCE_AVX_INCREMENT_DEST             dest += Mode::numParallel;
+    #define JUCE_AVX_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+    #define JUCE_AVX_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+
+    struct AVX
+    {
+        template <typename Type>
+        static JUCE_AVX_TARGET void fill (Type* dest, Type valueToFill, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = valueToFill, Mode::storeU (dest, val),
+                             const auto val = Mode::load1 (valueToFill);, JUCE_AVX_INCREMENT_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void copyWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = src[i] * multiplier, Mode::storeU (dest, Mode::mul (mult, Mode::loadU (src))),
+                             const auto mult = Mode::load1 (multiplier);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void add (Type* dest, Type amount, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] += amount, Mode::storeU (dest, Mode::add (Mode::loadU (dest), amountToAdd)),
+                             const auto amountToAdd = Mode::load1 (amount);, JUCE_AVX_INCREMENT_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void add (Type* dest, const Type* src, Type amount, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = src[i] + amount, Mode::storeU (dest, Mode::add (am, Mode::loadU (src))),
+                             const auto am = Mode::load1 (amount);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void add (Type* dest, const Type* src, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] += src[i], Mode::storeU (dest, Mode::add (Mode::loadU (dest), Mode::loadU (src))),
+                             , JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void add (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = src1[i] + src2[i], Mode::storeU (dest, Mode::add (Mode::loadU (src1), Mode::loadU (src2))),
+                             , JUCE_AVX_INCREMENT_SRC1_SRC2_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void subtract (Type* dest, const Type* src, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] -= src[i], Mode::storeU (dest, Mode::sub (Mode::loadU (dest), Mode::loadU (src))),
+                             , JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void subtract (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = src1[i] - src2[i], Mode::storeU (dest, Mode::sub (Mode::loadU (src1), Mode::loadU (src2))),
+                             , JUCE_AVX_INCREMENT_SRC1_SRC2_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void addWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] += src[i] * multiplier, Mode::storeU (dest, Mode::add (Mode::loadU (dest), Mode::mul (mult, Mode::loadU (src)))),
+                             const auto mult = Mode::load1 (multiplier);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void addWithMultiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] += src1[i] * src2[i], Mode::storeU (dest, Mode::add (Mode::loadU (dest), Mode::mul (Mode::loadU (src1), Mode::loadU (src2)))),
+                             , JUCE_AVX_INCREMENT_SRC1_SRC2_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void subtractWithMultiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] -= src[i] * multiplier, Mode::storeU (dest, Mode::sub (Mode::loadU (dest), Mode::mul (mult, Mode::loadU (src)))),
+                             const auto mult = Mode::load1 (multiplier);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void subtractWithMultiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] -= src1[i] * src2[i], Mode::storeU (dest, Mode::sub (Mode::loadU (dest), Mode::mul (Mode::loadU (src1), Mode::loadU (src2)))),
+                             , JUCE_AVX_INCREMENT_SRC1_SRC2_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void multiply (Type* dest, const Type* src, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] *= src[i], Mode::storeU (dest, Mode::mul (Mode::loadU (dest), Mode::loadU (src))),
+                             , JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void multiply (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = src1[i] * src2[i], Mode::storeU (dest, Mode::mul (Mode::loadU (src1), Mode::loadU (src2))),
+                             , JUCE_AVX_INCREMENT_SRC1_SRC2_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void multiply (Type* dest, Type multiplier, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] *= multiplier, Mode::storeU (dest, Mode::mul (Mode::loadU (dest), mult)),
+                             const auto mult = Mode::load1 (multiplier);, JUCE_AVX_INCREMENT_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void multiply (Type* dest, const Type* src, Type multiplier, int num) noexcept
+        {
+            copyWithMultiply (dest, src, multiplier, num);
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void abs (Type* dest, const Type* src, int num) noexcept
+        {
+            // clears the sign bit, which is the top bit of the matching unsigned integer type
+            using MaskType = typename std::conditional<sizeof (Type) == 4, uint32, uint64>::type;
+            union { MaskType i; Type f; } signMask;
+            signMask.i = ~((MaskType) 1 << (sizeof (Type) * 8 - 1));
+
+            JUCE_AVX_VEC_OP (dest[i] = std::abs (src[i]), Mode::storeU (dest, Mode::bit_and (Mode::loadU (src), mask)),
+                             const auto mask = Mode::load1 (signMask.f);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void min (Type* dest, const Type* src, Type comp, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = jmin (src[i], comp), Mode::storeU (dest, Mode::min (Mode::loadU (src), cmp)),
+                             const auto cmp = Mode::load1 (comp);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void min (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = jmin (src1[i], src2[i]), Mode::storeU (dest, Mode::min (Mode::loadU (src1), Mode::loadU (src2))),
+                             , JUCE_AVX_INCREMENT_SRC1_SRC2_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void max (Type* dest, const Type* src, Type comp, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = jmax (src[i], comp), Mode::storeU (dest, Mode::max (Mode::loadU (src), cmp)),
+                             const auto cmp = Mode::load1 (comp);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void max (Type* dest, const Type* src1, const Type* src2, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = jmax (src1[i], src2[i]), Mode::storeU (dest, Mode::max (Mode::loadU (src1), Mode::loadU (src2))),
+                             , JUCE_AVX_INCREMENT_SRC1_SRC2_DEST)
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void clip (Type* dest, const Type* src, Type low, Type high, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = jmax (jmin (src[i], high), low), Mode::storeU (dest, Mode::max (Mode::min (Mode::loadU (src), hi), lo)),
+                             const auto lo = Mode::load1 (low); const auto hi = Mode::load1 (high);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        static JUCE_AVX_TARGET void convertFixedToFloat (float* dest, const int* src, float multiplier, int num) noexcept
+        {
+            JUCE_AVX_VEC_OP (dest[i] = (float) src[i] * multiplier,
+                             Mode::storeU (dest, Mode::mul (mult, _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src))))),
+                             const auto mult = Mode::load1 (multiplier);, JUCE_AVX_INCREMENT_SRC_DEST)
+        }
+
+        static JUCE_AVX_TARGET void convertFloatToDouble (double* dest, const float* src, int num) noexcept
+        {
+            for (int i = num / 8; --i >= 0;)
+            {
+                const __m256 s = _mm256_loadu_ps (src);
+                _mm256_storeu_pd (dest,     _mm256_cvtps_pd (_mm256_castps256_ps128 (s)));
+                _mm256_storeu_pd (dest + 4, _mm256_cvtps_pd (_mm256_extractf128_ps (s, 1)));
+                src += 8;
+                dest += 8;
+            }
+
+            _mm256_zeroupper();
+            num &= 7;
+
+            for (int i = 0; i < num; ++i)
+                dest[i] = (double) src[i];
+        }
+
+        static JUCE_AVX_TARGET void convertDoubleToFloat (float* dest, const double* src, int num) noexcept
+        {
+            for (int i = num / 8; --i >= 0;)
+            {
+                const __m128 lo = _mm256_cvtpd_ps (_mm256_loadu_pd (src));
+                const __m128 hi = _mm256_cvtpd_ps (_mm256_loadu_pd (src + 4));
+                _mm256_storeu_ps (dest, _mm256_insertf128_ps (_mm256_castps128_ps256 (lo), hi, 1));
+                src += 8;
+                dest += 8;
+            }
+
+            _mm256_zeroupper();
+            num &= 7;
+
+            for (int i = 0; i < num; ++i)
+                dest[i] = (float) src[i];
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET Type findMinimum (const Type* src, int num) noexcept    { return findMinOrMax (src, num, true); }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET Type findMaximum (const Type* src, int num) noexcept    { return findMinOrMax (src, num, false); }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET Type findMinOrMax (const Type* src, int num, bool isMinimum) noexcept
+        {
+            auto range = findMinAndMax (src, num);
+            return isMinimum ? range.getStart() : range.getEnd();
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET Range<Type> findMinAndMax (const Type* src, int num) noexcept
+        {
+            using Mode = typename AVXModeType<sizeof (Type)>::Mode;
+            int numLongOps = num / Mode::numParallel;
+
+            if (numLongOps <= 1)
+                return Range<Type>::findMinAndMax (src, num);
+
+            auto mn = Mode::loadU (src);
+            auto mx = mn;
+
+            while (--numLongOps > 0)
+            {
+                src += Mode::numParallel;
+                const auto v = Mode::loadU (src);
+                mn = Mode::min (mn, v);
+                mx = Mode::max (mx, v);
+            }
+
+            Type mins[Mode::numParallel], maxs[Mode::numParallel];
+            Mode::storeU (mins, mn);
+            Mode::storeU (maxs, mx);
+            _mm256_zeroupper();
+
+            Range<Type> result (juce::findMinimum (mins, (int) Mode::numParallel),
+                                juce::findMaximum (maxs, (int) Mode::numParallel));
+
+            num &= (Mode::numParallel - 1);
+            src += Mode::numParallel;
+
+            for (int i = 0; i < num; ++i)
+                result = result.getUnionWith (src[i]);
+
+            return result;
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void copyWithRamp (Type* dest, const Type* src, Type startGain, Type gainIncrement, int num) noexcept
+        {
+            using Mode = typename AVXModeType<sizeof (Type)>::Mode;
+            JUCE_PERFORM_RAMP_OP (dest[i] = src[i] * JUCE_RAMP_GAIN, Mode::storeU (dest, Mode::mul (Mode::loadU (src), gain)),
+                                  JUCE_AVX_INCREMENT_SRC_DEST)
+            _mm256_zeroupper();
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void addWithRamp (Type* dest, const Type* src, Type startGain, Type gainIncrement, int num) noexcept
+        {
+            using Mode = typename AVXModeType<sizeof (Type)>::Mode;
+            JUCE_PERFORM_RAMP_OP (dest[i] += src[i] * JUCE_RAMP_GAIN,
+                                  Mode::storeU (dest, Mode::add (Mode::loadU (dest), Mode::mul (Mode::loadU (src), gain))),
+                                  JUCE_AVX_INCREMENT_SRC_DEST)
+            _mm256_zeroupper();
+        }
+
+        template <typename Type>
+        static JUCE_AVX_TARGET void copyWithEqualPowerCrossfade (Type* dest, const Type* src1, const Type* src2,
+                                                                 Type startPosition, Type positionIncrement, int num) noexcept
+        {
+            using Mode = typename AVXModeType<sizeof (Type)>::Mode;
+            JUCE_PERFORM_EQUAL_POWER_CROSSFADE (JUCE_AVX_INCREMENT_SRC1_SRC2_DEST)
+            _mm256_zeroupper();
+        }
+    };
+
+    // anything called before this has been initialised will simply use the SSE code
+    static const bool isAVXAvailable = SystemStats::hasAVX2();
+
+    #define JUCE_DISPATCH_TO_AVX(call)   if (FloatVectorHelpers::isAVXAvailable) return FloatVectorHelpers::AVX::call;
+   #else
+    #define JUCE_DISPATCH_TO_AVX(call)
+   #endif
 }
 
 //==============================================================================
@@ -519,6 +995,8 @@ void JUCE_CALLTYPE FloatVectorOperations::clear (double* dest, int num) noexcept
 
 void JUCE_CALLTYPE FloatVectorOperations::fill (float* dest, float valueToFill, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (fill (dest, valueToFill, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vfill (&valueToFill, dest, 1, (size_t) num);
    #else
@@ -529,6 +1007,8 @@ void JUCE_CALLTYPE FloatVectorOperations::fill (float* dest, float valueToFill,
 
 void JUCE_CALLTYPE FloatVectorOperations::fill (double* dest, double valueToFill, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (fill (dest, valueToFill, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vfillD (&valueToFill, dest, 1, (size_t) num);
    #else
@@ -549,6 +1029,8 @@ void JUCE_CALLTYPE FloatVectorOperations::copy (double* dest, const double* src,
 
 void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (copyWithMultiply (dest, src, multiplier, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
@@ -560,6 +1042,8 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (float* dest, const f
 
 void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (copyWithMultiply (dest, src, multiplier, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
@@ -571,6 +1055,8 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (double* dest, const
 
 void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (add (dest, amount, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
    #else
@@ -581,12 +1067,15 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, double amount, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (add (dest, amount, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
 }
 
 void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, float amount, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (add (dest, src, amount, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (osx108sdkCompatibilityCast (src), 1, &amount, dest, 1, (vDSP_Length) num);
    #else
@@ -598,6 +1087,8 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, fl
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src, double amount, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (add (dest, src, amount, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsaddD (osx108sdkCompatibilityCast (src), 1, &amount, dest, 1, (vDSP_Length) num);
    #else
@@ -609,6 +1100,8 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
 
 void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (add (dest, src, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -618,6 +1111,8 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, in
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (add (dest, src, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -627,6 +1122,8 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
 
 void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (add (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -636,6 +1133,8 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src1, c
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (add (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -645,6 +1144,8 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src1,
 
 void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (subtract (dest, src, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -654,6 +1155,8 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (subtract (dest, src, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -663,6 +1166,8 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double*
 
 void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (subtract (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsub (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -672,6 +1177,8 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (subtract (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsubD (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -681,6 +1188,8 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double*
 
 void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (addWithMultiply (dest, src, multiplier, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -692,6 +1201,8 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
 
 void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (addWithMultiply (dest, src, multiplier, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -703,6 +1214,8 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
 
 void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (addWithMultiply (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -714,6 +1227,8 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
 
 void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (addWithMultiply (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -725,6 +1240,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (subtractWithMultiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -732,6 +1248,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, con
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (subtractWithMultiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -739,6 +1256,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, co
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (subtractWithMultiply (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -746,13 +1264,80 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, con
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (subtractWithMultiply (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
 }
 
+void JUCE_CALLTYPE FloatVectorOperations::copyWithRamp (float* dest, const float* src, float startGain, float endGain, int num) noexcept
+{
+    auto gainIncrement = FloatVectorHelpers::getRampIncrement (startGain, endGain, num);
+
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmul (src, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_TO_AVX (copyWithRamp (dest, src, startGain, gainIncrement, num))
+    FloatVectorHelpers::Ramps::copyWithRamp (dest, src, startGain, gainIncrement, num);
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithRamp (double* dest, const double* src, double startGain, double endGain, int num) noexcept
+{
+    auto gainIncrement = FloatVectorHelpers::getRampIncrement (startGain, endGain, num);
+
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmulD (src, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_TO_AVX (copyWithRamp (dest, src, startGain, gainIncrement, num))
+    FloatVectorHelpers::Ramps::copyWithRamp (dest, src, startGain, gainIncrement, num);
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamp (float* dest, const float* src, float startGain, float endGain, int num) noexcept
+{
+    auto gainIncrement = FloatVectorHelpers::getRampIncrement (startGain, endGain, num);
+
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmuladd (src, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_TO_AVX (addWithRamp (dest, src, startGain, gainIncrement, num))
+    FloatVectorHelpers::Ramps::addWithRamp (dest, src, startGain, gainIncrement, num);
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::addWithRamp (double* dest, const double* src, double startGain, double endGain, int num) noexcept
+{
+    auto gainIncrement = FloatVectorHelpers::getRampIncrement (startGain, endGain, num);
+
+   #if JUCE_USE_VDSP_FRAMEWORK
+    vDSP_vrampmuladdD (src, 1, &startGain, &gainIncrement, dest, 1, (vDSP_Length) num);
+   #else
+    JUCE_DISPATCH_TO_AVX (addWithRamp (dest, src, startGain, gainIncrement, num))
+    FloatVectorHelpers::Ramps::addWithRamp (dest, src, startGain, gainIncrement, num);
+   #endif
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithEqualPowerCrossfade (float* dest, const float* fadingOutSrc, const float* fadingInSrc,
+                                                                      float startPosition, float endPosition, int num) noexcept
+{
+    auto positionIncrement = FloatVectorHelpers::getRampIncrement (startPosition, endPosition, num);
+    JUCE_DISPATCH_TO_AVX (copyWithEqualPowerCrossfade (dest, fadingOutSrc, fadingInSrc, startPosition, positionIncrement, num))
+    FloatVectorHelpers::Ramps::copyWithEqualPowerCrossfade (dest, fadingOutSrc, fadingInSrc, startPosition, positionIncrement, num);
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::copyWithEqualPowerCrossfade (double* dest, const double* fadingOutSrc, const double* fadingInSrc,
+                                                                      double startPosition, double endPosition, int num) noexcept
+{
+    auto positionIncrement = FloatVectorHelpers::getRampIncrement (startPosition, endPosition, num);
+    JUCE_DISPATCH_TO_AVX (copyWithEqualPowerCrossfade (dest, fadingOutSrc, fadingInSrc, startPosition, positionIncrement, num))
+    FloatVectorHelpers::Ramps::copyWithEqualPowerCrossfade (dest, fadingOutSrc, fadingInSrc, startPosition, positionIncrement, num);
+}
+
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (multiply (dest, src, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -762,6 +1347,8 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (multiply (dest, src, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -771,6 +1358,8 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (multiply (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -780,6 +1369,8 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (multiply (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -789,6 +1380,8 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (multiply (dest, multiplier, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
@@ -799,6 +1392,8 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, float multiplie
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (multiply (dest, multiplier, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
@@ -809,6 +1404,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (multiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -816,6 +1412,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (multiply (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -841,6 +1438,8 @@ void FloatVectorOperations::negate (double* dest, const double* src, int num) no
 
 void FloatVectorOperations::abs (float* dest, const float* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (abs (dest, src, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vabs ((float*) src, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -856,6 +1455,8 @@ void FloatVectorOperations::abs (float* dest, const float* src, int num) noexcep
 
 void FloatVectorOperations::abs (double* dest, const double* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (abs (dest, src, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vabsD ((double*) src, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -872,6 +1473,8 @@ void FloatVectorOperations::abs (double* dest, const double* src, int num) noexc
 
 void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, const int* src, float multiplier, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (convertFixedToFloat (dest, src, multiplier, num))
+
    #if JUCE_USE_ARM_NEON
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                   vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src)), multiplier),
@@ -884,8 +1487,72 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
    #endif
 }
 
+void JUCE_CALLTYPE FloatVectorOperations::convertFloatToDouble (double* dest, const float* src, int num) noexcept
+{
+    JUCE_DISPATCH_TO_AVX (convertFloatToDouble (dest, src, num))
+
+   #if JUCE_USE_SSE_INTRINSICS
+    for (int i = num / 4; --i >= 0;)
+    {
+        const __m128 s = _mm_loadu_ps (src);
+        _mm_storeu_pd (dest,     _mm_cvtps_pd (s));
+        _mm_storeu_pd (dest + 2, _mm_cvtps_pd (_mm_movehl_ps (s, s)));
+        src += 4;
+        dest += 4;
+    }
+
+    num &= 3;
+   #elif JUCE_USE_ARM_NEON && (defined (__arm64__) || defined (__aarch64__))
+    for (int i = num / 4; --i >= 0;)
+    {
+        const float32x4_t s = vld1q_f32 (src);
+        vst1q_f64 (dest,     vcvt_f64_f32 (vget_low_f32 (s)));
+        vst1q_f64 (dest + 2, vcvt_high_f64_f32 (s));
+        src += 4;
+        dest += 4;
+    }
+
+    num &= 3;
+   #endif
+
+    for (int i = 0; i < num; ++i)
+        dest[i] = (double) src[i];
+}
+
+void JUCE_CALLTYPE FloatVectorOperations::convertDoubleToFloat (float* dest, const double* src, int num) noexcept
+{
+    JUCE_DISPATCH_TO_AVX (convertDoubleToFloat (dest, src, num))
+
+   #if JUCE_USE_SSE_INTRINSICS
+    for (int i = num / 4; --i >= 0;)
+    {
+        const __m128 lo = _mm_cvtpd_ps (_mm_loadu_pd (src));
+        const __m128 hi = _mm_cvtpd_ps (_mm_loadu_pd (src + 2));
+        _mm_storeu_ps (dest, _mm_movelh_ps (lo, hi));
+        src += 4;
+        dest += 4;
+    }
+
+    num &= 3;
+   #elif JUCE_USE_ARM_NEON && (defined (__arm64__) || defined (__aarch64__))
+    for (int i = num / 4; --i >= 0;)
+    {
+        const float32x2_t lo = vcvt_f32_f64 (vld1q_f64 (src));
+        vst1q_f32 (dest, vcvt_high_f32_f64 (lo, vld1q_f64 (src + 2)));
+        src += 4;
+        dest += 4;
+    }
+
+    num &= 3;
+   #endif
+
+    for (int i = 0; i < num; ++i)
+        dest[i] = (float) src[i];
+}
+
 void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src, float comp, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (min (dest, src, comp, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -893,6 +1560,7 @@ void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src, fl
 
 void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src, double comp, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (min (dest, src, comp, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmin (src[i], comp), Mode::min (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -900,6 +1568,8 @@ void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src,
 
 void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (min (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmin ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -909,6 +1579,8 @@ void JUCE_CALLTYPE FloatVectorOperations::min (float* dest, const float* src1, c
 
 void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (min (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vminD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -918,6 +1590,7 @@ void JUCE_CALLTYPE FloatVectorOperations::min (double* dest, const double* src1,
 
 void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src, float comp, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (max (dest, src, comp, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -925,6 +1598,7 @@ void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src, fl
 
 void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src, double comp, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (max (dest, src, comp, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (src[i], comp), Mode::max (s, cmp),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType cmp = Mode::load1 (comp);)
@@ -932,6 +1606,8 @@ void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src,
 
 void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (max (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmax ((float*) src1, 1, (float*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -941,6 +1617,8 @@ void JUCE_CALLTYPE FloatVectorOperations::max (float* dest, const float* src1, c
 
 void JUCE_CALLTYPE FloatVectorOperations::max (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (max (dest, src1, src2, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaxD ((double*) src1, 1, (double*) src2, 1, dest, 1, (vDSP_Length) num);
    #else
@@ -952,6 +1630,8 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (float* dest, const float* src, f
 {
     jassert(high >= low);
 
+    JUCE_DISPATCH_TO_AVX (clip (dest, src, low, high, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
    #else
@@ -965,6 +1645,8 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
 {
     jassert(high >= low);
 
+    JUCE_DISPATCH_TO_AVX (clip (dest, src, low, high, num))
+
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
    #else
@@ -976,6 +1658,8 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
 
 Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (findMinAndMax (src, num))
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
    #else
@@ -985,6 +1669,8 @@ Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* sr
 
 Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (findMinAndMax (src, num))
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
    #else
@@ -994,6 +1680,8 @@ Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double*
 
 float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (findMinimum (src, num))
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, true);
    #else
@@ -1003,6 +1691,8 @@ float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int nu
 
 double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (findMinimum (src, num))
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, true);
    #else
@@ -1012,6 +1702,8 @@ double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int
 
 float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (findMaximum (src, num))
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, false);
    #else
@@ -1021,6 +1713,8 @@ float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int nu
 
 double JUCE_CALLTYPE FloatVectorOperations::findMaximum (const double* src, int num) noexcept
 {
+    JUCE_DISPATCH_TO_AVX (findMaximum (src, num))
+
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, false);
    #else
@@ -1230,6 +1924,69 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            FloatVectorOperations::subtractWithMultiply (data1, data2, (ValueType) 2, num);
+            u.expect (areAllValuesEqual (data1, num, (ValueType) 2));
+
+            FloatVectorOperations::multiply (data1, data1, data2, num);
+            u.expect (areAllValuesEqual (data1, num, (ValueType) 6));
+
+            FloatVectorOperations::subtract (data1, data1, data2, num);
+            u.expect (areAllValuesEqual (data1, num, (ValueType) 3));
+
+            FloatVectorOperations::subtractWithMultiply (data1, data1, data2, num);
+            u.expect (areAllValuesEqual (data1, num, (ValueType) -6));
+
+            FloatVectorOperations::max (data2, data1, data2, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) 3));
+
+            FloatVectorOperations::min (data2, data1, (ValueType) -7, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) -7));
+
+            FloatVectorOperations::clip (data2, data1, (ValueType) -4, (ValueType) 4, num);
+            u.expect (areAllValuesEqual (data2, num, (ValueType) -4));
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+            doRampTests (u, data1, data2, (ValueType) random.nextFloat(), (ValueType) (2 * random.nextFloat() - 1), num);
+        }
+
+        static void doRampTests (UnitTest& u, ValueType* data1, const ValueType* data2,
+                                 ValueType startGain, ValueType endGain, int num)
+        {
+            HeapBlock<ValueType> expected (num), original (num);
+            FloatVectorOperations::copy (original, data1, num);
+
+            auto increment = (endGain - startGain) / (ValueType) num;
+
+            for (int i = 0; i < num; ++i)
+                expected[i] = data2[i] * (startGain + increment * (ValueType) i);
+
+            // the source values go up to 1000, and the reference may have been contracted into FMAs
+            auto tolerance = std::numeric_limits<ValueType>::epsilon() * (ValueType) 4000;
+
+            FloatVectorOperations::copyWithRamp (data1, data2, startGain, endGain, num);
+            u.expect (buffersMatchWithin (data1, expected, num, tolerance));
+
+            FloatVectorOperations::copyWithRamp (data1, data1, (ValueType) 1, (ValueType) 1, num);
+            u.expect (buffersMatchWithin (data1, expected, num, tolerance));
+
+            FloatVectorOperations::copy (data1, original, num);
+
+            for (int i = 0; i < num; ++i)
+                expected[i] = original[i] + data2[i] * (startGain + increment * (ValueType) i);
+
+            FloatVectorOperations::addWithRamp (data1, data2, startGain, endGain, num);
+            u.expect (buffersMatchWithin (data1, expected, num, tolerance));
+
+            for (int i = 0; i < num; ++i)
+            {
+                auto angle = (startGain + increment * (ValueType) i) * MathConstants<ValueType>::halfPi;
+                expected[i] = original[i] * std::cos (angle) + data2[i] * std::sin (angle);
+            }
+
+            // the vectorised gains are rotated from block to block, so they drift slightly
+            FloatVectorOperations::copyWithEqualPowerCrossfade (data1, original, data2, startGain, endGain, num);
+            u.expect (buffersMatchWithin (data1, expected, num, tolerance * (ValueType) num));
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1237,9 +1994,34 @@ public:
             FloatVectorOperations::convertFixedToFloat (data1, int1, 2.0f, num);
             convertFixed (data2, int1, 2.0f, num);
             u.expect (buffersMatch (data1, data2, num));
+
+            HeapBlock<double> doubles (num + 1);
+            auto* misalignedDoubles = doubles.get() + (num & 1);
+
+            FloatVectorOperations::convertFloatToDouble (misalignedDoubles, data1, num);
+
+            for (int i = 0; i < num; ++i)
+                u.expect (misalignedDoubles[i] == (double) data1[i]);
+
+            FloatVectorOperations::convertDoubleToFloat (data2, misalignedDoubles, num);
+            u.expect (buffersMatch (data1, data2, num));
         }
 
-        static void doConversionTest (UnitTest&, double*, double*, int*, int) {}
+        static void doConversionTest (UnitTest& u, double* data1, double* data2, int*, int num)
+        {
+            HeapBlock<float> floats (num + 1);
+            auto* misalignedFloats = floats.get() + (num & 1);
+
+            FloatVectorOperations::convertDoubleToFloat (misalignedFloats, data1, num);
+
+            for (int i = 0; i < num; ++i)
+                u.expect (misalignedFloats[i] == (float) data1[i]);
+
+            FloatVectorOperations::convertFloatToDouble (data2, misalignedFloats, num);
+
+            for (int i = 0; i < num; ++i)
+                u.expect (data2[i] == (double) misalignedFloats[i]);
+        }
 
         static void fillRandomly (Random& random, ValueType* d, int num)
         {
@@ -1277,6 +2059,15 @@ public:
             return true;
         }
 
+        static bool buffersMatchWithin (const ValueType* d1, const ValueType* d2, int num, ValueType tolerance)
+        {
+            while (--num >= 0)
+                if (std::abs (*d1++ - *d2++) > tolerance)
+                    return false;
+
+            return true;
+        }
+
         static bool valuesMatch (ValueType v1, ValueType v2)
         {
             return std::abs (v1 - v2) < std::numeric_limits<ValueType>::epsilon();
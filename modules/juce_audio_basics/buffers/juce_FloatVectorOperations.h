@@ -127,6 +127,48 @@ public:
     /** Multiplies each source1 value by the corresponding source2 value, then subtracts it to the destination value. */
     static void JUCE_CALLTYPE subtractWithMultiply (double* dest, const double* src1, const double* src2, int num) noexcept;
 
+    /** Copies each source value to the destination, multiplied by a gain that moves linearly from
+        startGain towards endGain. The gain applied to value i is startGain + (endGain - startGain) * i / num.
+        The source and destination may be the same array.
+    */
+    static void JUCE_CALLTYPE copyWithRamp (float* dest, const float* src, float startGain, float endGain, int num) noexcept;
+
+    /** Copies each source value to the destination, multiplied by a gain that moves linearly from
+        startGain towards endGain. The gain applied to value i is startGain + (endGain - startGain) * i / num.
+        The source and destination may be the same array.
+    */
+    static void JUCE_CALLTYPE copyWithRamp (double* dest, const double* src, double startGain, double endGain, int num) noexcept;
+
+    /** Multiplies each source value by a gain that moves linearly from startGain towards endGain, then
+        adds it to the destination value.
+        @see copyWithRamp
+    */
+    static void JUCE_CALLTYPE addWithRamp (float* dest, const float* src, float startGain, float endGain, int num) noexcept;
+
+    /** Multiplies each source value by a gain that moves linearly from startGain towards endGain, then
+        adds it to the destination value.
+        @see copyWithRamp
+    */
+    static void JUCE_CALLTYPE addWithRamp (double* dest, const double* src, double startGain, double endGain, int num) noexcept;
+
+    /** Writes an equal-power crossfade between two sources to the destination.
+
+        The fade position moves linearly from startPosition towards endPosition in the same way as
+        the gain in copyWithRamp, and a position p mixes the sources with the gains cos (p * pi / 2)
+        and sin (p * pi / 2), so 0 is entirely fadingOutSrc and 1 is entirely fadingInSrc.
+    */
+    static void JUCE_CALLTYPE copyWithEqualPowerCrossfade (float* dest, const float* fadingOutSrc, const float* fadingInSrc,
+                                                           float startPosition, float endPosition, int num) noexcept;
+
+    /** Writes an equal-power crossfade between two sources to the destination.
+
+        The fade position moves linearly from startPosition towards endPosition in the same way as
+        the gain in copyWithRamp, and a position p mixes the sources with the gains cos (p * pi / 2)
+        and sin (p * pi / 2), so 0 is entirely fadingOutSrc and 1 is entirely fadingInSrc.
+    */
+    static void JUCE_CALLTYPE copyWithEqualPowerCrossfade (double* dest, const double* fadingOutSrc, const double* fadingInSrc,
+                                                           double startPosition, double endPosition, int num) noexcept;
+
     /** Multiplies the destination values by the source values. */
     static void JUCE_CALLTYPE multiply (float* dest, const float* src, int numValues) noexcept;
 
@@ -166,6 +208,12 @@ public:
     /** Converts a stream of integers to floats, multiplying each one by the given multiplier. */
     static void JUCE_CALLTYPE convertFixedToFloat (float* dest, const int* src, float multiplier, int numValues) noexcept;
 
+    /** Converts a vector of floats to doubles. */
+    static void JUCE_CALLTYPE convertFloatToDouble (double* dest, const float* src, int numValues) noexcept;
+
+    /** Converts a vector of doubles to floats. */
+    static void JUCE_CALLTYPE convertDoubleToFloat (float* dest, const double* src, int numValues) noexcept;
+
     /** Each element of dest will be the minimum of the corresponding element of the source array and the given comp value. */
     static void JUCE_CALLTYPE min (float* dest, const float* src, float comp, int num) noexcept;
 
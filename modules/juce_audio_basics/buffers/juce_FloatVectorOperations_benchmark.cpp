@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FloatVectorOperationsBenchmarks  : public Benchmark
+{
+public:
+    FloatVectorOperationsBenchmarks()  : Benchmark ("FloatVectorOperations", "Audio") {}
+
+    void initialise() override
+    {
+        Random r (1);
+
+        for (auto* buffer : { &source, &dest })
+        {
+            buffer->allocate (numSamples, true);
+
+            for (int i = 0; i < numSamples; ++i)
+                (*buffer)[i] = r.nextFloat() * 2.0f - 1.0f;
+        }
+    }
+
+    void shutdown() override
+    {
+        source.free();
+        dest.free();
+    }
+
+    void runBenchmark() override
+    {
+        measure ("copy",            [this] { FloatVectorOperations::copy (dest, source, numSamples);                 doNotOptimiseAway (dest[0]); });
+        measure ("add",             [this] { FloatVectorOperations::add (dest, source, numSamples);                  doNotOptimiseAway (dest[0]); });
+        measure ("multiply",        [this] { FloatVectorOperations::multiply (dest, 0.999f, numSamples);             doNotOptimiseAway (dest[0]); });
+        measure ("addWithMultiply", [this] { FloatVectorOperations::addWithMultiply (dest, source, 0.5f, numSamples); doNotOptimiseAway (dest[0]); });
+        measure ("clip",            [this] { FloatVectorOperations::clip (dest, source, -0.5f, 0.5f, numSamples);    doNotOptimiseAway (dest[0]); });
+        measure ("findMinAndMax",   [this] { doNotOptimiseAway (FloatVectorOperations::findMinAndMax (source, numSamples)); });
+    }
+
+private:
+    enum { numSamples = 4096 };
+    HeapBlock<float> source, dest;
+};
+
+static FloatVectorOperationsBenchmarks floatVectorOperationsBenchmarks;
+
+} // namespace juce
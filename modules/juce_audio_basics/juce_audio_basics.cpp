@@ -49,24 +49,47 @@
  #undef JUCE_USE_VDSP_FRAMEWORK
 #endif
 
+#if JUCE_AUDIO_WORKGROUP_TYPES_AVAILABLE
+ #include <os/workgroup.h>
+#endif
+
 #if JUCE_USE_ARM_NEON
  #include <arm_neon.h>
 #endif
 
+// the AVX2 versions of the FloatVectorOperations are selected at runtime
+#if JUCE_USE_SSE_INTRINSICS && ! defined (JUCE_USE_VDSP_FRAMEWORK) && (JUCE_MSVC || JUCE_CLANG || (JUCE_GCC && __GNUC__ >= 5))
+ #ifndef JUCE_USE_AVX_INTRINSICS
+  #define JUCE_USE_AVX_INTRINSICS 1
+ #endif
+#else
+ #undef JUCE_USE_AVX_INTRINSICS
+#endif
+
+#if JUCE_USE_AVX_INTRINSICS
+ #include <immintrin.h>
+#endif
+
 #include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_FloatVectorOperations.cpp"
 #include "buffers/juce_AudioChannelSet.cpp"
 #include "buffers/juce_AudioProcessLoadMeasurer.cpp"
 #include "utilities/juce_IIRFilter.cpp"
+#include "utilities/juce_IIRFilterCascade.cpp"
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_CatmullRomInterpolator.cpp"
+#include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
+#include "utilities/juce_ADSR.cpp"
+#include "utilities/juce_Reverb.cpp"
+#include "utilities/juce_AudioWorkgroup.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
 #include "midi/juce_MidiMessage.cpp"
 #include "midi/juce_MidiMessageSequence.cpp"
 #include "midi/juce_MidiRPN.cpp"
+#include "synthesisers/juce_SynthesiserRenderThreadPool.h"
 #include "mpe/juce_MPEValue.cpp"
 #include "mpe/juce_MPENote.cpp"
 #include "mpe/juce_MPEZoneLayout.cpp"
@@ -85,3 +108,7 @@
 #include "sources/juce_ReverbAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
 #include "synthesisers/juce_Synthesiser.cpp"
+
+#if JUCE_UNIT_TESTS
+ #include "buffers/juce_FloatVectorOperations_benchmark.cpp"
+#endif
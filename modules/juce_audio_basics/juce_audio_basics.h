@@ -79,6 +79,16 @@
  #define JUCE_USE_ARM_NEON 0
 #endif
 
+#if (JUCE_MAC || JUCE_IOS) && defined (__has_include)
+ #if __has_include (<os/workgroup.h>)
+  #define JUCE_AUDIO_WORKGROUP_TYPES_AVAILABLE 1
+ #endif
+#endif
+
+#ifndef JUCE_AUDIO_WORKGROUP_TYPES_AVAILABLE
+ #define JUCE_AUDIO_WORKGROUP_TYPES_AVAILABLE 0
+#endif
+
 //==============================================================================
 #include "buffers/juce_AudioDataConverters.h"
 #include "buffers/juce_FloatVectorOperations.h"
@@ -87,11 +97,14 @@
 #include "buffers/juce_AudioProcessLoadMeasurer.h"
 #include "utilities/juce_Decibels.h"
 #include "utilities/juce_IIRFilter.h"
+#include "utilities/juce_IIRFilterCascade.h"
 #include "utilities/juce_LagrangeInterpolator.h"
 #include "utilities/juce_CatmullRomInterpolator.h"
+#include "utilities/juce_WindowedSincInterpolator.h"
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
+#include "utilities/juce_AudioWorkgroup.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
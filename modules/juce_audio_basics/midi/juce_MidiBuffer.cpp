@@ -89,11 +89,18 @@ namespace MidiBufferHelpers
 MidiBuffer::MidiBuffer() noexcept {}
 MidiBuffer::~MidiBuffer() {}
 
-MidiBuffer::MidiBuffer (const MidiBuffer& other) noexcept  : data (other.data) {}
+MidiBuffer::MidiBuffer (const MidiBuffer& other) noexcept
+    : data (other.data),
+      lastEventTime (other.lastEventTime),
+      lastEventTimeDataSize (other.lastEventTimeDataSize)
+{
+}
 
 MidiBuffer& MidiBuffer::operator= (const MidiBuffer& other) noexcept
 {
     data = other.data;
+    lastEventTime = other.lastEventTime;
+    lastEventTimeDataSize = other.lastEventTimeDataSize;
     return *this;
 }
 
@@ -102,7 +109,13 @@ MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept
     addEvent (message, 0);
 }
 
-void MidiBuffer::swapWith (MidiBuffer& other) noexcept      { data.swapWith (other.data); }
+void MidiBuffer::swapWith (MidiBuffer& other) noexcept
+{
+    data.swapWith (other.data);
+    std::swap (lastEventTime, other.lastEventTime);
+    std::swap (lastEventTimeDataSize, other.lastEventTimeDataSize);
+}
+
 void MidiBuffer::clear() noexcept                           { data.clearQuick(); }
 void MidiBuffer::ensureSize (size_t minimumNumBytes)        { data.ensureStorageAllocated ((int) minimumNumBytes); }
 bool MidiBuffer::isEmpty() const noexcept                   { return data.size() == 0; }
@@ -127,7 +140,13 @@ void MidiBuffer::addEvent (const void* const newData, const int maxBytes, const
     if (numBytes > 0)
     {
         const size_t newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
-        const int offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
+        const int oldSize = data.size();
+        const bool wasLastEventTimeKnown = isLastEventTimeKnown();
+
+        // events arriving in time order can go straight on the end
+        const int offset = (oldSize == 0 || (wasLastEventTimeKnown && sampleNumber >= lastEventTime))
+                              ? oldSize
+                              : (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
 
         data.insertMultiple (offset, 0, (int) newItemSize);
 
@@ -135,6 +154,11 @@ void MidiBuffer::addEvent (const void* const newData, const int maxBytes, const
         writeUnaligned<int32>  (d, sampleNumber);
         writeUnaligned<uint16> (d + 4, static_cast<uint16> (numBytes));
         memcpy (d + 6, newData, (size_t) numBytes);
+
+        if (offset == oldSize)
+            setLastEventTime (sampleNumber);
+        else if (wasLastEventTimeKnown)
+            setLastEventTime (lastEventTime);
     }
 }
 
@@ -143,17 +167,67 @@ void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
                             const int numSamples,
                             const int sampleDeltaToAdd)
 {
-    Iterator i (otherBuffer);
-    i.setNextSamplePosition (startSample);
+    if (&otherBuffer == this)
+    {
+        const MidiBuffer copy (otherBuffer);
+        addEvents (copy, startSample, numSamples, sampleDeltaToAdd);
+        return;
+    }
+
+    auto* sourceStart = MidiBufferHelpers::findEventAfter (otherBuffer.data.begin(), otherBuffer.data.end(), startSample - 1);
+    auto* sourceEnd = numSamples < 0 ? otherBuffer.data.end()
+                                     : MidiBufferHelpers::findEventAfter (sourceStart, otherBuffer.data.end(), startSample + numSamples - 1);
 
-    const uint8* eventData;
-    int eventSize, position;
+    if (sourceStart >= sourceEnd)
+        return;
 
-    while (i.getNextEvent (eventData, eventSize, position)
-            && (position < startSample + numSamples || numSamples < 0))
+    const int numSourceBytes = (int) (sourceEnd - sourceStart);
+    const int oldSize = data.size();
+    const bool wasLastEventTimeKnown = isLastEventTimeKnown();
+    const int firstTime = MidiBufferHelpers::getEventTime (sourceStart) + sampleDeltaToAdd;
+
+    // Only our events that come after the first new one need to be merged: these are
+    // moved up to the end of the enlarged buffer, and then merged with the new events
+    // back into the gap that this leaves.
+    const int mergeStart = (oldSize == 0 || (wasLastEventTimeKnown && firstTime >= lastEventTime))
+                              ? oldSize
+                              : (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), firstTime) - data.begin());
+
+    data.insertMultiple (oldSize, 0, numSourceBytes);
+
+    auto* dest = data.begin() + mergeStart;
+    auto* existing = dest + numSourceBytes;
+    auto* const end = data.end();
+    memmove (existing, dest, (size_t) (oldSize - mergeStart));
+
+    int time = 0;
+
+    for (auto* source = sourceStart; source < sourceEnd;)
     {
-        addEvent (eventData, eventSize, position + sampleDeltaToAdd);
+        time = MidiBufferHelpers::getEventTime (source) + sampleDeltaToAdd;
+
+        while (existing < end && MidiBufferHelpers::getEventTime (existing) <= time)
+        {
+            auto size = MidiBufferHelpers::getEventTotalSize (existing);
+            memmove (dest, existing, size);
+            dest += size;
+            existing += size;
+        }
+
+        auto size = MidiBufferHelpers::getEventTotalSize (source);
+        memcpy (dest, source, size);
+        writeUnaligned<int32> (dest, time);
+        dest += size;
+        source += size;
     }
+
+    // any of our events that are left over are already in the right place
+    jassert (dest == existing);
+
+    if (mergeStart == oldSize)
+        setLastEventTime (time);
+    else if (wasLastEventTimeKnown)
+        setLastEventTime (jmax (time, lastEventTime));
 }
 
 int MidiBuffer::getNumEvents() const noexcept
@@ -177,6 +251,9 @@ int MidiBuffer::getLastEventTime() const noexcept
     if (data.size() == 0)
         return 0;
 
+    if (isLastEventTimeKnown())
+        return lastEventTime;
+
     const uint8* const endData = data.end();
 
     for (const uint8* d = data.begin();;)
@@ -234,4 +311,136 @@ bool MidiBuffer::Iterator::getNextEvent (MidiMessage& result, int& samplePositio
     return true;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiBufferTest  : public UnitTest
+{
+    MidiBufferTest()  : UnitTest ("MidiBuffer", "MIDI/MPE") {}
+
+    static Array<std::pair<int, int>> getEvents (const MidiBuffer& buffer)
+    {
+        Array<std::pair<int, int>> events;
+        MidiBuffer::Iterator i (buffer);
+        MidiMessage message;
+        int time;
+
+        while (i.getNextEvent (message, time))
+            events.add ({ time, message.getNoteNumber() * 1000 + message.getVelocity() });
+
+        return events;
+    }
+
+    // Adds the events one at a time, searching from the start of the buffer every time
+    static void addEventsSlowly (MidiBuffer& dest, const MidiBuffer& source, int delta)
+    {
+        for (auto& e : getEvents (source))
+        {
+            MidiBuffer copy;
+            MidiBuffer::Iterator i (dest);
+            MidiMessage message;
+            int time;
+            bool added = false;
+
+            while (i.getNextEvent (message, time))
+            {
+                if (! added && time > e.first + delta)
+                {
+                    copy.addEvent (MidiMessage::noteOn (1, e.second / 1000, (uint8) (e.second % 1000)), e.first + delta);
+                    added = true;
+                }
+
+                copy.addEvent (message, time);
+            }
+
+            if (! added)
+                copy.addEvent (MidiMessage::noteOn (1, e.second / 1000, (uint8) (e.second % 1000)), e.first + delta);
+
+            dest.swapWith (copy);
+        }
+    }
+
+    static MidiBuffer createRandomBuffer (Random& r, int numEvents, bool inOrder)
+    {
+        MidiBuffer buffer;
+
+        for (int i = 0, time = 0; i < numEvents; ++i)
+        {
+            time = inOrder ? time + r.nextInt (3) : r.nextInt (200);
+            buffer.addEvent (MidiMessage::noteOn (1, r.nextInt (128), (uint8) (1 + r.nextInt (127))), time);
+        }
+
+        return buffer;
+    }
+
+    static bool isSorted (const Array<std::pair<int, int>>& events)
+    {
+        for (int i = 1; i < events.size(); ++i)
+            if (events.getReference (i).first < events.getReference (i - 1).first)
+                return false;
+
+        return true;
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Adding events");
+        {
+            for (auto inOrder : { true, false })
+            {
+                auto buffer = createRandomBuffer (r, 500, inOrder);
+                auto events = getEvents (buffer);
+
+                expectEquals (events.size(), 500);
+                expect (isSorted (events));
+                expectEquals (buffer.getLastEventTime(), events.getLast().first);
+            }
+        }
+
+        beginTest ("Adding events within the reserved size");
+        {
+            MidiBuffer buffer;
+            buffer.ensureSize (2000);
+            auto* storage = buffer.data.begin();
+
+            for (int i = 0; i < 200; ++i)
+                buffer.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), r.nextInt (100));
+
+            buffer.clear();
+            buffer.addEvents (createRandomBuffer (r, 200, false), 0, -1, 0);
+
+            expect (buffer.data.begin() == storage);
+        }
+
+        beginTest ("Merging buffers");
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                auto dest = createRandomBuffer (r, r.nextInt (100), r.nextBool());
+                auto source = createRandomBuffer (r, r.nextInt (100), r.nextBool());
+                auto delta = r.nextInt (200) - 100;
+
+                MidiBuffer expected (dest);
+                addEventsSlowly (expected, source, delta);
+
+                dest.addEvents (source, 0, -1, delta);
+                expect (getEvents (dest) == getEvents (expected));
+                expectEquals (dest.getLastEventTime(), expected.getLastEventTime());
+
+                MidiBuffer range;
+                range.addEvents (source, 50, 100, 0);
+
+                for (auto& e : getEvents (range))
+                    expect (e.first >= 50 && e.first < 150);
+            }
+        }
+    }
+};
+
+static MidiBufferTest midiBufferTest;
+
+#endif
+
 } // namespace juce
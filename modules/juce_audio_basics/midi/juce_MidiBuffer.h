@@ -90,6 +90,8 @@ public:
 
         If an event is added whose sample position is the same as one or more events
         already in the buffer, the new event will be placed after the existing ones.
+        Adding events in time order is quick, as they can simply be appended to the
+        end of the buffer.
 
         To retrieve events, use a MidiBuffer::Iterator object
     */
@@ -128,6 +130,9 @@ public:
                                     startSample will be taken.
         @param sampleDeltaToAdd     a value which will be added to the source timestamps of the events
                                     that are added to this buffer
+
+        The events are merged into this buffer in a single pass, and any that have the same
+        sample position as events already in the buffer are placed after the existing ones.
     */
     void addEvents (const MidiBuffer& otherBuffer,
                     int startSample,
@@ -153,8 +158,12 @@ public:
     void swapWith (MidiBuffer&) noexcept;
 
     /** Preallocates some memory for the buffer to use.
+
         This helps to avoid needing to reallocate space when the buffer has messages
-        added to it.
+        added to it: as long as the total size of the events stays within this many bytes,
+        neither adding events nor calling clear() will allocate or free any memory, so
+        you can call this before starting playback and then use the buffer on the audio
+        thread. Each event takes up the size of its midi data plus 6 bytes.
     */
     void ensureSize (size_t minimumNumBytes);
 
@@ -231,6 +240,13 @@ public:
     Array<uint8> data;
 
 private:
+    //==============================================================================
+    // The time of the last event, which is only known while data.size() == lastEventTimeDataSize
+    int lastEventTime = 0, lastEventTimeDataSize = -1;
+
+    bool isLastEventTimeKnown() const noexcept      { return data.size() > 0 && data.size() == lastEventTimeDataSize; }
+    void setLastEventTime (int time) noexcept       { lastEventTime = time; lastEventTimeDataSize = data.size(); }
+
     JUCE_LEAK_DETECTOR (MidiBuffer)
 };
 
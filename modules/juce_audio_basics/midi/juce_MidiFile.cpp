@@ -88,48 +88,63 @@ namespace MidiFileHelpers
         return true;
     }
 
-    static double convertTicksToSeconds (double time,
-                                         const MidiMessageSequence& tempoEvents,
-                                         int timeFormat)
-    {
-        if (timeFormat < 0)
-            return time / (-(timeFormat >> 8) * (timeFormat & 0xff));
-
-        double lastTime = 0, correctedTime = 0;
-        auto tickLen = 1.0 / (timeFormat & 0x7fff);
-        auto secsPerTick = 0.5 * tickLen;
-        auto numEvents = tempoEvents.getNumEvents();
+    /*  Converts tick times to seconds using a list of tempo events.
 
-        for (int i = 0; i < numEvents; ++i)
+        As long as it's given the times in ascending order, this only has to step through
+        the tempo events once, rather than searching them from the start for each time.
+    */
+    struct TicksToSecondsConverter
+    {
+        TicksToSecondsConverter (const MidiMessageSequence& tempoEventsToUse, int format) noexcept
+            : tempoEvents (tempoEventsToUse), timeFormat (format),
+              tickLen (1.0 / (format & 0x7fff))
         {
-            auto& m = tempoEvents.getEventPointer(i)->message;
-            auto eventTime = m.getTimeStamp();
+            reset();
+        }
 
-            if (eventTime >= time)
-                break;
+        double convert (double time) noexcept
+        {
+            if (timeFormat < 0)
+                return time / (-(timeFormat >> 8) * (timeFormat & 0xff));
 
-            correctedTime += (eventTime - lastTime) * secsPerTick;
-            lastTime = eventTime;
+            if (time < lastTimeConverted)
+                reset();
 
-            if (m.isTempoMetaEvent())
-                secsPerTick = tickLen * m.getTempoSecondsPerQuarterNote();
+            lastTimeConverted = time;
+            auto numEvents = tempoEvents.getNumEvents();
 
-            while (i + 1 < numEvents)
+            for (; nextEvent < numEvents; ++nextEvent)
             {
-                auto& m2 = tempoEvents.getEventPointer(i + 1)->message;
+                auto& m = tempoEvents.getEventPointer (nextEvent)->message;
+                auto eventTime = m.getTimeStamp();
 
-                if (m2.getTimeStamp() != eventTime)
+                if (eventTime >= time)
                     break;
 
-                if (m2.isTempoMetaEvent())
-                    secsPerTick = tickLen * m2.getTempoSecondsPerQuarterNote();
+                correctedTime += (eventTime - lastTime) * secsPerTick;
+                lastTime = eventTime;
 
-                ++i;
+                if (m.isTempoMetaEvent())
+                    secsPerTick = tickLen * m.getTempoSecondsPerQuarterNote();
             }
+
+            return correctedTime + (time - lastTime) * secsPerTick;
         }
 
-        return correctedTime + (time - lastTime) * secsPerTick;
-    }
+    private:
+        void reset() noexcept
+        {
+            nextEvent = 0;
+            lastTime = correctedTime = lastTimeConverted = 0;
+            secsPerTick = 0.5 * tickLen;
+        }
+
+        const MidiMessageSequence& tempoEvents;
+        const int timeFormat;
+        const double tickLen;
+        int nextEvent;
+        double lastTime, correctedTime, lastTimeConverted, secsPerTick;
+    };
 
     template <typename MethodType>
     static void findAllMatchingEvents (const OwnedArray<MidiMessageSequence>& tracks,
@@ -138,6 +153,7 @@ namespace MidiFileHelpers
     {
         for (auto* track : tracks)
         {
+            jassert (track != nullptr); // any lazily-read tracks should have been parsed first
             auto numEvents = track->getNumEvents();
 
             for (int j = 0; j < numEvents; ++j)
@@ -151,18 +167,32 @@ namespace MidiFileHelpers
     }
 }
 
+//==============================================================================
+/*  The data and chunk positions for a file that was read with readFromLazily(). Any
+    entry in the tracks array that's still nullptr is parsed from here when it's needed.
+*/
+struct MidiFile::UnparsedTracks
+{
+    MemoryBlock data;
+    Array<Range<int>> chunks;
+    bool createMatchingNoteOffs = true;
+    CriticalSection lock;
+};
+
 //==============================================================================
 MidiFile::MidiFile()  : timeFormat ((short) (unsigned short) 0xe728) {}
 MidiFile::~MidiFile() {}
 
 MidiFile::MidiFile (const MidiFile& other)  : timeFormat (other.timeFormat)
 {
+    other.parseAllTracks();
     tracks.addCopiesOf (other.tracks);
 }
 
 MidiFile& MidiFile::operator= (const MidiFile& other)
 {
-    tracks.clear();
+    other.parseAllTracks();
+    clear();
     tracks.addCopiesOf (other.tracks);
     timeFormat = other.timeFormat;
     return *this;
@@ -170,6 +200,7 @@ MidiFile& MidiFile::operator= (const MidiFile& other)
 
 MidiFile::MidiFile (MidiFile&& other)
     : tracks (std::move (other.tracks)),
+      unparsedTracks (std::move (other.unparsedTracks)),
       timeFormat (other.timeFormat)
 {
 }
@@ -177,6 +208,7 @@ MidiFile::MidiFile (MidiFile&& other)
 MidiFile& MidiFile::operator= (MidiFile&& other)
 {
     tracks = std::move (other.tracks);
+    unparsedTracks = std::move (other.unparsedTracks);
     timeFormat = other.timeFormat;
     return *this;
 }
@@ -184,6 +216,7 @@ MidiFile& MidiFile::operator= (MidiFile&& other)
 void MidiFile::clear()
 {
     tracks.clear();
+    unparsedTracks.reset();
 }
 
 //==============================================================================
@@ -194,7 +227,35 @@ int MidiFile::getNumTracks() const noexcept
 
 const MidiMessageSequence* MidiFile::getTrack (int index) const noexcept
 {
-    return tracks[index];
+    if (unparsedTracks == nullptr || ! isPositiveAndBelow (index, unparsedTracks->chunks.size()))
+        return tracks[index];
+
+    {
+        const ScopedLock sl (unparsedTracks->lock);
+
+        if (auto* track = tracks.getUnchecked (index))
+            return track;
+    }
+
+    // parse it without holding the lock, so that other threads can parse other tracks
+    // at the same time. If two threads want the same one, the second result is discarded.
+    auto chunk = unparsedTracks->chunks.getReference (index);
+    std::unique_ptr<MidiMessageSequence> parsed (parseTrack (static_cast<const uint8*> (unparsedTracks->data.getData()) + chunk.getStart(),
+                                                             chunk.getLength(), unparsedTracks->createMatchingNoteOffs));
+
+    const ScopedLock sl (unparsedTracks->lock);
+
+    if (tracks.getUnchecked (index) == nullptr)
+        tracks.set (index, parsed.release(), false);
+
+    return tracks.getUnchecked (index);
+}
+
+void MidiFile::parseAllTracks() const
+{
+    if (unparsedTracks != nullptr)
+        for (int i = 0; i < unparsedTracks->chunks.size(); ++i)
+            getTrack (i);
 }
 
 void MidiFile::addTrack (const MidiMessageSequence& trackSequence)
@@ -221,21 +282,25 @@ void MidiFile::setSmpteTimeFormat (int framesPerSecond, int subframeResolution)
 //==============================================================================
 void MidiFile::findAllTempoEvents (MidiMessageSequence& results) const
 {
+    parseAllTracks();
     MidiFileHelpers::findAllMatchingEvents (tracks, results, &MidiMessage::isTempoMetaEvent);
 }
 
 void MidiFile::findAllTimeSigEvents (MidiMessageSequence& results) const
 {
+    parseAllTracks();
     MidiFileHelpers::findAllMatchingEvents (tracks, results, &MidiMessage::isTimeSignatureMetaEvent);
 }
 
 void MidiFile::findAllKeySigEvents (MidiMessageSequence& results) const
 {
+    parseAllTracks();
     MidiFileHelpers::findAllMatchingEvents (tracks, results, &MidiMessage::isKeySignatureMetaEvent);
 }
 
 double MidiFile::getLastTimestamp() const
 {
+    parseAllTracks();
     double t = 0.0;
 
     for (auto* ms : tracks)
@@ -245,10 +310,9 @@ double MidiFile::getLastTimestamp() const
 }
 
 //==============================================================================
-bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs)
+bool MidiFile::readTrackChunks (InputStream& sourceStream, MemoryBlock& data, Array<Range<int>>& chunks)
 {
     clear();
-    MemoryBlock data;
 
     const int maxSensibleMidiFileSize = 200 * 1024 * 1024;
 
@@ -256,29 +320,35 @@ bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs)
     if (sourceStream.readIntoMemoryBlock (data, maxSensibleMidiFileSize))
     {
         auto size = data.getSize();
-        auto d = static_cast<const uint8*> (data.getData());
+        auto start = static_cast<const uint8*> (data.getData());
+        auto d = start;
         short fileType, expectedTracks;
 
-        if (size > 16 && MidiFileHelpers::parseMidiHeader (d, timeFormat, fileType, expectedTracks))
+        if (size > 16 && MidiFileHelpers::parseMidiHeader (d, timeFormat, fileType, expectedTracks)
+             && (size_t) (d - start) <= size)
         {
-            size -= (size_t) (d - static_cast<const uint8*> (data.getData()));
+            size -= (size_t) (d - start);
 
             int track = 0;
 
-            while (size > 0 && track < expectedTracks)
+            while (size >= 8 && track < expectedTracks)
             {
                 auto chunkType = (int) ByteOrder::bigEndianInt (d);
                 d += 4;
                 auto chunkSize = (int) ByteOrder::bigEndianInt (d);
                 d += 4;
+                size -= 8;
 
                 if (chunkSize <= 0)
                     break;
 
+                // (don't trust the size of the last chunk in a truncated file)
+                chunkSize = (int) jmin ((size_t) chunkSize, size);
+
                 if (chunkType == (int) ByteOrder::bigEndianInt ("MTrk"))
-                    readNextTrack (d, chunkSize, createMatchingNoteOffs);
+                    chunks.add (Range<int>::withStartAndLength ((int) (d - start), chunkSize));
 
-                size -= (size_t) chunkSize + 8;
+                size -= (size_t) chunkSize;
                 d += chunkSize;
                 ++track;
             }
@@ -290,12 +360,87 @@ bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs)
     return false;
 }
 
-void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNoteOffs)
+bool MidiFile::readFrom (InputStream& sourceStream, bool createMatchingNoteOffs, ThreadPool* pool)
+{
+    MemoryBlock data;
+    Array<Range<int>> chunks;
+
+    if (! readTrackChunks (sourceStream, data, chunks))
+        return false;
+
+    auto numChunks = chunks.size();
+    auto* d = static_cast<const uint8*> (data.getData());
+
+    tracks.ensureStorageAllocated (numChunks);
+
+    for (int i = 0; i < numChunks; ++i)
+        tracks.add (nullptr);
+
+    std::atomic<int> nextChunk { 0 };
+
+    auto parseRemainingChunks = [&]
+    {
+        for (int i; (i = nextChunk++) < numChunks;)
+            tracks.set (i, parseTrack (d + chunks.getReference (i).getStart(),
+                                       chunks.getReference (i).getLength(),
+                                       createMatchingNoteOffs), false);
+    };
+
+    auto numJobs = pool != nullptr ? jmin (pool->getNumThreads(), numChunks - 1) : 0;
+
+    if (numJobs > 0)
+    {
+        std::atomic<int> numJobsRemaining { numJobs };
+        WaitableEvent finished;
+
+        for (int i = 0; i < numJobs; ++i)
+        {
+            pool->addJob ([&]
+            {
+                parseRemainingChunks();
+
+                if (--numJobsRemaining == 0)
+                    finished.signal();
+            });
+        }
+
+        parseRemainingChunks();
+        finished.wait();
+    }
+    else
+    {
+        parseRemainingChunks();
+    }
+
+    return true;
+}
+
+bool MidiFile::readFromLazily (InputStream& sourceStream, bool createMatchingNoteOffs)
+{
+    std::unique_ptr<UnparsedTracks> unparsed (new UnparsedTracks());
+
+    if (! readTrackChunks (sourceStream, unparsed->data, unparsed->chunks))
+        return false;
+
+    unparsed->createMatchingNoteOffs = createMatchingNoteOffs;
+    tracks.ensureStorageAllocated (unparsed->chunks.size());
+
+    for (int i = 0; i < unparsed->chunks.size(); ++i)
+        tracks.add (nullptr);
+
+    unparsedTracks = std::move (unparsed);
+    return true;
+}
+
+MidiMessageSequence* MidiFile::parseTrack (const uint8* data, int size, bool createMatchingNoteOffs)
 {
     double time = 0;
     uint8 lastStatusByte = 0;
 
-    MidiMessageSequence result;
+    std::unique_ptr<MidiMessageSequence> result (new MidiMessageSequence());
+
+    // most events take 3 or 4 bytes, so this avoids having to keep growing the list
+    result->list.ensureStorageAllocated (size / 3);
 
     while (size > 0)
     {
@@ -306,7 +451,7 @@ void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNo
         time += delay;
 
         int messSize = 0;
-        const MidiMessage mm (data, size, messSize, lastStatusByte, time);
+        MidiMessage mm (data, size, messSize, lastStatusByte, time);
 
         if (messSize <= 0)
             break;
@@ -314,18 +459,18 @@ void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNo
         size -= messSize;
         data += messSize;
 
-        result.addEvent (mm);
-
         auto firstByte = *(mm.getRawData());
 
         if ((firstByte & 0xf0) != 0xf0)
             lastStatusByte = firstByte;
+
+        // the times never go backwards, so this just appends the event
+        result->addEvent (std::move (mm));
     }
 
     // sort so that we put all the note-offs before note-ons that have the same time
-    std::stable_sort (result.list.begin(), result.list.end(),
-                      [] (const MidiMessageSequence::MidiEventHolder* a,
-                          const MidiMessageSequence::MidiEventHolder* b)
+    auto isEarlier = [] (const MidiMessageSequence::MidiEventHolder* a,
+                         const MidiMessageSequence::MidiEventHolder* b)
     {
         auto t1 = a->message.getTimeStamp();
         auto t2 = b->message.getTimeStamp();
@@ -334,12 +479,16 @@ void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNo
         if (t2 < t1)  return false;
 
         return a->message.isNoteOff() && b->message.isNoteOn();
-    });
+    };
 
-    addTrack (result);
+    // (the events are usually in the right order already, which is much quicker to check)
+    if (! std::is_sorted (result->list.begin(), result->list.end(), isEarlier))
+        std::stable_sort (result->list.begin(), result->list.end(), isEarlier);
 
     if (createMatchingNoteOffs)
-        tracks.getLast()->updateMatchedPairs();
+        result->updateMatchedPairs();
+
+    return result.release();
 }
 
 //==============================================================================
@@ -353,10 +502,13 @@ void MidiFile::convertTimestampTicksToSeconds()
     {
         for (auto* ms : tracks)
         {
-            for (int j = ms->getNumEvents(); --j >= 0;)
+            MidiFileHelpers::TicksToSecondsConverter converter (tempoEvents, timeFormat);
+            auto numEvents = ms->getNumEvents();
+
+            for (int j = 0; j < numEvents; ++j)
             {
                 auto& m = ms->getEventPointer(j)->message;
-                m.setTimeStamp (MidiFileHelpers::convertTicksToSeconds (m.getTimeStamp(), tempoEvents, timeFormat));
+                m.setTimeStamp (converter.convert (m.getTimeStamp()));
             }
         }
     }
@@ -366,6 +518,7 @@ void MidiFile::convertTimestampTicksToSeconds()
 bool MidiFile::writeTo (OutputStream& out, int midiFileType) const
 {
     jassert (midiFileType >= 0 && midiFileType <= 2);
+    parseAllTracks();
 
     if (! out.writeIntBigEndian ((int) ByteOrder::bigEndianInt ("MThd"))) return false;
     if (! out.writeIntBigEndian (6))                                      return false;
@@ -442,4 +595,128 @@ bool MidiFile::writeTrack (OutputStream& mainOut, const MidiMessageSequence& ms)
     return true;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiFileTest  : public juce::UnitTest
+{
+    MidiFileTest() : juce::UnitTest ("MidiFile") {}
+
+    void runTest() override
+    {
+        MidiFile original;
+        original.setTicksPerQuarterNote (480);
+
+        MidiMessageSequence tempoTrack;
+        tempoTrack.addEvent (MidiMessage::tempoMetaEvent (500000).withTimeStamp (0.0));
+        tempoTrack.addEvent (MidiMessage::tempoMetaEvent (250000).withTimeStamp (960.0));
+        original.addTrack (tempoTrack);
+
+        auto random = getRandom();
+
+        for (int track = 0; track < 6; ++track)
+        {
+            MidiMessageSequence s;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto note = random.nextInt (128);
+                auto time = (double) (i * 30);
+                s.addEvent (MidiMessage::noteOn  (1 + track, note, (uint8) 100).withTimeStamp (time));
+                s.addEvent (MidiMessage::noteOff (1 + track, note).withTimeStamp (time + 30.0));
+            }
+
+            s.updateMatchedPairs();
+            original.addTrack (s);
+        }
+
+        MemoryOutputStream out;
+        expect (original.writeTo (out));
+
+        auto readFile = [&] (int mode)
+        {
+            MemoryInputStream in (out.getData(), out.getDataSize(), false);
+            ThreadPool pool (3);
+            MidiFile result;
+
+            if (mode == 0)       expect (result.readFrom (in));
+            else if (mode == 1)  expect (result.readFrom (in, true, &pool));
+            else                 expect (result.readFromLazily (in));
+
+            return result;
+        };
+
+        auto tracksMatch = [] (const MidiMessageSequence& a, const MidiMessageSequence& b)
+        {
+            if (a.getNumEvents() != b.getNumEvents())
+                return false;
+
+            for (int i = 0; i < a.getNumEvents(); ++i)
+            {
+                auto& m1 = a.getEventPointer (i)->message;
+                auto& m2 = b.getEventPointer (i)->message;
+
+                if (m1.getTimeStamp() != m2.getTimeStamp()
+                     || m1.getRawDataSize() != m2.getRawDataSize()
+                     || memcmp (m1.getRawData(), m2.getRawData(), (size_t) m1.getRawDataSize()) != 0
+                     || a.getIndexOfMatchingKeyUp (i) != b.getIndexOfMatchingKeyUp (i))
+                    return false;
+            }
+
+            return true;
+        };
+
+        auto reference = readFile (0);
+
+        beginTest ("Reading");
+        {
+            expectEquals (reference.getNumTracks(), original.getNumTracks());
+            expectEquals (reference.getTimeFormat(), (short) 480);
+
+            // the reader adds an end-of-track event to each track
+            expectEquals (reference.getTrack (1)->getNumEvents(), original.getTrack (1)->getNumEvents() + 1);
+            expectEquals (reference.getTrack (1)->getIndexOfMatchingKeyUp (0), 1);
+        }
+
+        beginTest ("Parallel reading");
+        {
+            auto parallel = readFile (1);
+            expectEquals (parallel.getNumTracks(), reference.getNumTracks());
+
+            for (int i = 0; i < reference.getNumTracks(); ++i)
+                expect (tracksMatch (*parallel.getTrack (i), *reference.getTrack (i)));
+        }
+
+        beginTest ("Lazy reading");
+        {
+            auto lazy = readFile (2);
+            expectEquals (lazy.getNumTracks(), reference.getNumTracks());
+            expect (tracksMatch (*lazy.getTrack (3), *reference.getTrack (3)));
+
+            MidiFile copy (lazy);
+
+            for (int i = 0; i < reference.getNumTracks(); ++i)
+                expect (tracksMatch (*copy.getTrack (i), *reference.getTrack (i)));
+
+            expectEquals (lazy.getLastTimestamp(), reference.getLastTimestamp());
+        }
+
+        beginTest ("Converting to seconds");
+        {
+            auto converted = readFile (2);
+            converted.convertTimestampTicksToSeconds();
+
+            // 120bpm for the first two beats, then 240bpm
+            auto& track = *converted.getTrack (1);
+            expectWithinAbsoluteError (track.getEventTime (2 * 32),  1.0, 1.0e-9);   // tick 960
+            expectWithinAbsoluteError (track.getEventTime (2 * 64),  1.5, 1.0e-9);   // tick 1920
+            expectWithinAbsoluteError (track.getEventTime (2 * 16),  0.5, 1.0e-9);   // tick 480
+        }
+    }
+};
+
+static MidiFileTest midiFileTests;
+
+#endif
+
 } // namespace juce
@@ -67,6 +67,10 @@ public:
     int getNumTracks() const noexcept;
 
     /** Returns a pointer to one of the tracks in the file.
+
+        If the file was read with readFromLazily() and this track hasn't been needed
+        yet, it'll be parsed now. This is safe to call from several threads at once.
+
         @returns a pointer to the track, or nullptr if the index is out-of-range
         @see getNumTracks, addTrack
     */
@@ -156,14 +160,38 @@ public:
         terms of midi ticks. To convert them to seconds, use the convertTimestampTicksToSeconds()
         method.
 
+        @param sourceStream              the source stream
+        If you supply a ThreadPool, the tracks are parsed in parallel by the pool's threads
+        and the calling thread, which is much quicker for large multi-track files. The pool
+        can be shared with other tasks, but don't call this from one of the pool's own
+        threads, as it has to wait for the pool's jobs to finish.
+
         @param sourceStream              the source stream
         @param createMatchingNoteOffs    if true, any missing note-offs for previous note-ons will
                                          be automatically added at the end of the file by calling
                                          MidiMessageSequence::updateMatchedPairs on each track.
+        @param poolForParallelParsing    an optional ThreadPool to use to parse the tracks
 
         @returns true if the stream was read successfully
+        @see readFromLazily
+    */
+    bool readFrom (InputStream& sourceStream, bool createMatchingNoteOffs = true,
+                   ThreadPool* poolForParallelParsing = nullptr);
+
+    /** Reads a midi file format stream, but doesn't parse its tracks until they're needed.
+
+        This just loads the data and finds where each track starts, which is very quick
+        even for huge files. Each track is then parsed the first time it's returned by
+        getTrack(), so if you only need to look at a few of the tracks, the others never
+        have to be parsed at all.
+
+        Methods which need to look at all the tracks, such as findAllTempoEvents(),
+        getLastTimestamp(), convertTimestampTicksToSeconds(), writeTo() or copying the
+        MidiFile, will parse any tracks that are still pending.
+
+        The parameters and return value are the same as for readFrom().
     */
-    bool readFrom (InputStream& sourceStream, bool createMatchingNoteOffs = true);
+    bool readFromLazily (InputStream& sourceStream, bool createMatchingNoteOffs = true);
 
     /** Writes the midi tracks as a standard midi file.
         The midiFileType value is written as the file's format type, which can be 0, 1
@@ -185,10 +213,16 @@ public:
 
 private:
     //==============================================================================
-    OwnedArray<MidiMessageSequence> tracks;
+    struct UnparsedTracks;
+
+    // (mutable so that tracks which were read lazily can be filled in by getTrack())
+    mutable OwnedArray<MidiMessageSequence> tracks;
+    std::unique_ptr<UnparsedTracks> unparsedTracks;
     short timeFormat;
 
-    void readNextTrack (const uint8*, int, bool);
+    bool readTrackChunks (InputStream&, MemoryBlock&, Array<Range<int>>&);
+    void parseAllTracks() const;
+    static MidiMessageSequence* parseTrack (const uint8*, int, bool);
     bool writeTrack (OutputStream&, const MidiMessageSequence&) const;
 
     JUCE_LEAK_DETECTOR (MidiFile)
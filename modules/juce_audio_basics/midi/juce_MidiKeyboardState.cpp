@@ -25,7 +25,8 @@ namespace juce
 
 MidiKeyboardState::MidiKeyboardState()
 {
-    zerostruct (noteStates);
+    for (auto& s : noteStates)
+        s = 0;
 }
 
 MidiKeyboardState::~MidiKeyboardState()
@@ -35,9 +36,13 @@ MidiKeyboardState::~MidiKeyboardState()
 //==============================================================================
 void MidiKeyboardState::reset()
 {
-    const ScopedLock sl (lock);
-    zerostruct (noteStates);
-    eventsToAdd.clear();
+    for (auto& s : noteStates)
+        s = 0;
+
+    // (the queue can only be emptied by the thread that reads from it, so this just
+    // marks everything that's in it at the moment as being out of date)
+    const SpinLock::ScopedLockType sl (pendingEventWriteLock);
+    firstValidSequenceNumber = nextSequenceNumber;
 }
 
 bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noexcept
@@ -45,13 +50,13 @@ bool MidiKeyboardState::isNoteOn (const int midiChannel, const int n) const noex
     jassert (midiChannel >= 0 && midiChannel <= 16);
 
     return isPositiveAndBelow (n, 128)
-            && (noteStates[n] & (1 << (midiChannel - 1))) != 0;
+            && (noteStates[n].load() & (1 << (midiChannel - 1))) != 0;
 }
 
 bool MidiKeyboardState::isNoteOnForChannels (const int midiChannelMask, const int n) const noexcept
 {
     return isPositiveAndBelow (n, 128)
-            && (noteStates[n] & midiChannelMask) != 0;
+            && (noteStates[n].load() & midiChannelMask) != 0;
 }
 
 void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber, const float velocity)
@@ -59,14 +64,9 @@ void MidiKeyboardState::noteOn (const int midiChannel, const int midiNoteNumber,
     jassert (midiChannel >= 0 && midiChannel <= 16);
     jassert (isPositiveAndBelow (midiNoteNumber, 128));
 
-    const ScopedLock sl (lock);
-
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOn (midiChannel, midiNoteNumber, velocity), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
-
+        addPendingEvent (midiChannel, midiNoteNumber, velocity, true);
         noteOnInternal (midiChannel, midiNoteNumber, velocity);
     }
 }
@@ -75,7 +75,10 @@ void MidiKeyboardState::noteOnInternal  (const int midiChannel, const int midiNo
 {
     if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        noteStates [midiNoteNumber] |= (1 << (midiChannel - 1));
+        noteStates[midiNoteNumber].fetch_or ((uint16) (1 << (midiChannel - 1)));
+        ++numStateChanges;
+
+        const ScopedLock sl (listenerLock);
 
         for (int i = listeners.size(); --i >= 0;)
             listeners.getUnchecked(i)->handleNoteOn (this, midiChannel, midiNoteNumber, velocity);
@@ -84,33 +87,34 @@ void MidiKeyboardState::noteOnInternal  (const int midiChannel, const int midiNo
 
 void MidiKeyboardState::noteOff (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
-    const ScopedLock sl (lock);
-
     if (isNoteOn (midiChannel, midiNoteNumber))
     {
-        const int timeNow = (int) Time::getMillisecondCounter();
-        eventsToAdd.addEvent (MidiMessage::noteOff (midiChannel, midiNoteNumber), timeNow);
-        eventsToAdd.clear (0, timeNow - 500);
-
+        addPendingEvent (midiChannel, midiNoteNumber, velocity, false);
         noteOffInternal (midiChannel, midiNoteNumber, velocity);
     }
 }
 
 void MidiKeyboardState::noteOffInternal  (const int midiChannel, const int midiNoteNumber, const float velocity)
 {
-    if (isNoteOn (midiChannel, midiNoteNumber))
+    if (isPositiveAndBelow (midiNoteNumber, 128))
     {
-        noteStates [midiNoteNumber] &= ~(1 << (midiChannel - 1));
+        auto bit = (uint16) (1 << (midiChannel - 1));
 
-        for (int i = listeners.size(); --i >= 0;)
-            listeners.getUnchecked(i)->handleNoteOff (this, midiChannel, midiNoteNumber, velocity);
+        // (only the thread that actually turns the note off tells the listeners about it)
+        if ((noteStates[midiNoteNumber].fetch_and ((uint16) ~bit) & bit) != 0)
+        {
+            ++numStateChanges;
+
+            const ScopedLock sl (listenerLock);
+
+            for (int i = listeners.size(); --i >= 0;)
+                listeners.getUnchecked(i)->handleNoteOff (this, midiChannel, midiNoteNumber, velocity);
+        }
     }
 }
 
 void MidiKeyboardState::allNotesOff (const int midiChannel)
 {
-    const ScopedLock sl (lock);
-
     if (midiChannel <= 0)
     {
         for (int i = 1; i <= 16; ++i)
@@ -149,38 +153,199 @@ void MidiKeyboardState::processNextMidiBuffer (MidiBuffer& buffer,
     MidiMessage message;
     int time;
 
-    const ScopedLock sl (lock);
-
     while (i.getNextEvent (message, time))
         processNextMidiEvent (message);
 
-    if (injectIndirectEvents)
+    addPendingEvents (buffer, startSample, numSamples, injectIndirectEvents);
+}
+
+//==============================================================================
+void MidiKeyboardState::addPendingEvent (int midiChannel, int midiNoteNumber, float velocity, bool isNoteOn)
+{
+    // This lock only stops two threads that are playing notes from writing at the same
+    // time - the audio thread reads the events without needing it.
+    const SpinLock::ScopedLockType sl (pendingEventWriteLock);
+
+    int start1, size1, start2, size2;
+    pendingEventFifo.prepareToWrite (1, start1, size1, start2, size2);
+
+    // if the queue's full, nothing can be reading it, so the event wouldn't be needed anyway
+    if (size1 > 0)
     {
-        MidiBuffer::Iterator i2 (eventsToAdd);
-        const int firstEventToAdd = eventsToAdd.getFirstEventTime();
-        const double scaleFactor = numSamples / (double) (eventsToAdd.getLastEventTime() + 1 - firstEventToAdd);
+        pendingEvents[start1] = { Time::getMillisecondCounter(), nextSequenceNumber++, velocity,
+                                  (uint8) midiChannel, (uint8) midiNoteNumber, isNoteOn };
+        pendingEventFifo.finishedWrite (1);
+    }
+}
+
+void MidiKeyboardState::addPendingEvents (MidiBuffer& buffer, int startSample, int numSamples, bool injectEvents)
+{
+    int start1, size1, start2, size2;
+    pendingEventFifo.prepareToRead (pendingEventFifo.getNumReady(), start1, size1, start2, size2);
+
+    auto numEvents = size1 + size2;
 
-        while (i2.getNextEvent (message, time))
+    if (numEvents == 0)
+        return;
+
+    if (injectEvents)
+    {
+        auto getEvent = [&] (int index) -> const PendingEvent&
+        {
+            return pendingEvents[index < size1 ? start1 + index : start2 + (index - size1)];
+        };
+
+        auto firstValid = firstValidSequenceNumber.load();
+        auto lastTime = getEvent (numEvents - 1).time;
+        auto isWanted = [=] (const PendingEvent& e)
         {
-            const int pos = jlimit (0, numSamples - 1, roundToInt ((time - firstEventToAdd) * scaleFactor));
-            buffer.addEvent (message, startSample + pos);
+            // skip anything from before the last reset, or more than half a second older
+            // than the newest event (which can build up if this isn't being called)
+            return (int32) (e.sequenceNumber - firstValid) >= 0
+                    && (int32) (lastTime - e.time) <= 500;
+        };
+
+        int firstWanted = 0;
+
+        while (firstWanted < numEvents && ! isWanted (getEvent (firstWanted)))
+            ++firstWanted;
+
+        if (firstWanted < numEvents)
+        {
+            auto firstTime = getEvent (firstWanted).time;
+            auto scaleFactor = numSamples / (double) (lastTime + 1 - firstTime);
+
+            for (int i = firstWanted; i < numEvents; ++i)
+            {
+                auto& e = getEvent (i);
+
+                if (isWanted (e))
+                {
+                    auto pos = jlimit (0, numSamples - 1, roundToInt ((e.time - firstTime) * scaleFactor));
+
+                    buffer.addEvent (e.isNoteOn ? MidiMessage::noteOn (e.channel, e.noteNumber, e.velocity)
+                                                : MidiMessage::noteOff (e.channel, e.noteNumber),
+                                     startSample + pos);
+                }
+            }
         }
     }
 
-    eventsToAdd.clear();
+    pendingEventFifo.finishedRead (numEvents);
 }
 
 //==============================================================================
 void MidiKeyboardState::addListener (MidiKeyboardStateListener* const listener)
 {
-    const ScopedLock sl (lock);
+    const ScopedLock sl (listenerLock);
     listeners.addIfNotAlreadyThere (listener);
 }
 
 void MidiKeyboardState::removeListener (MidiKeyboardStateListener* const listener)
 {
-    const ScopedLock sl (lock);
+    const ScopedLock sl (listenerLock);
     listeners.removeFirstMatchingValue (listener);
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiKeyboardStateTests  : public UnitTest
+{
+    MidiKeyboardStateTests()
+        : UnitTest ("MidiKeyboardState", "MIDI/MPE")
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Note states");
+        {
+            MidiKeyboardState state;
+            auto initialChanges = state.getNumStateChanges();
+
+            state.noteOn (1, 60, 1.0f);
+            state.noteOn (3, 60, 1.0f);
+            expect (state.isNoteOn (1, 60));
+            expect (! state.isNoteOn (2, 60));
+            expect (state.isNoteOnForChannels (4, 60));
+            expect (! state.isNoteOnForChannels (2, 60));
+
+            state.noteOff (1, 60, 0.0f);
+            state.noteOff (1, 60, 0.0f);
+            expect (! state.isNoteOn (1, 60));
+            expect (state.isNoteOn (3, 60));
+            expectEquals ((int) (state.getNumStateChanges() - initialChanges), 3);
+
+            state.allNotesOff (0);
+            expect (! state.isNoteOnForChannels (0xffff, 60));
+        }
+
+        beginTest ("Injected events");
+        {
+            MidiKeyboardState state;
+            state.noteOn (2, 64, 0.5f);
+            state.noteOff (2, 64, 0.0f);
+
+            MidiBuffer buffer;
+            state.processNextMidiBuffer (buffer, 100, 256, true);
+            expectEquals (buffer.getNumEvents(), 2);
+
+            MidiBuffer::Iterator i (buffer);
+            MidiMessage message;
+            int time;
+
+            expect (i.getNextEvent (message, time) && message.isNoteOn() && message.getNoteNumber() == 64
+                     && message.getChannel() == 2 && time >= 100 && time < 356);
+            expect (i.getNextEvent (message, time) && message.isNoteOff() && time >= 100 && time < 356);
+
+            buffer.clear();
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expect (buffer.isEmpty());
+
+            state.noteOn (1, 10, 1.0f);
+            state.processNextMidiBuffer (buffer, 0, 256, false);
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expect (buffer.isEmpty());
+
+            state.noteOn (1, 11, 1.0f);
+            state.reset();
+            expect (! state.isNoteOn (1, 11));
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            expect (buffer.isEmpty());
+        }
+
+        beginTest ("Listeners");
+        {
+            struct TestListener  : public MidiKeyboardStateListener
+            {
+                void handleNoteOn (MidiKeyboardState*, int, int note, float) override   { notesOn.add (note); }
+                void handleNoteOff (MidiKeyboardState*, int, int note, float) override  { notesOff.add (note); }
+
+                Array<int> notesOn, notesOff;
+            };
+
+            MidiKeyboardState state;
+            TestListener listener;
+            state.addListener (&listener);
+
+            MidiBuffer buffer;
+            buffer.addEvent (MidiMessage::noteOn (1, 40, 1.0f), 0);
+            buffer.addEvent (MidiMessage::noteOff (1, 40), 10);
+            buffer.addEvent (MidiMessage::noteOff (1, 41), 20);
+            state.processNextMidiBuffer (buffer, 0, 256, true);
+            state.noteOn (1, 50, 1.0f);
+
+            state.removeListener (&listener);
+            state.noteOff (1, 50, 0.0f);
+
+            expect (listener.notesOn == Array<int> (40, 50));
+            expect (listener.notesOff == Array<int> (40));
+        }
+    }
+};
+
+static MidiKeyboardStateTests midiKeyboardStateTests;
+
+#endif
+
 } // namespace juce
@@ -81,6 +81,14 @@ public:
     methods, and midi messages for these events will be merged into the
     midi stream that gets processed by processNextMidiBuffer().
 
+    The key states are stored atomically, so isNoteOn() can be called from any thread
+    without locking, and the events that noteOn() and noteOff() create are passed to
+    processNextMidiBuffer() through a lock-free queue, so the audio thread never has to
+    wait for another thread that's playing notes. The only lock that's shared with the
+    audio thread is the one that protects the list of listeners, so if you just need to
+    find out when the keys have changed (e.g. to update a display), it's better to poll
+    getNumStateChanges() than to add a listener.
+
     @tags{Audio}
 */
 class JUCE_API  MidiKeyboardState
@@ -117,6 +125,14 @@ public:
     */
     bool isNoteOnForChannels (int midiChannelMask, int midiNoteNumber) const noexcept;
 
+    /** Returns a counter that goes up each time a key goes up or down.
+
+        This is a cheap way to find out whether anything's changed since you last looked,
+        e.g. from a timer which then calls isNoteOn() to redraw the keys, without needing
+        a listener that gets called on the audio thread.
+    */
+    uint32 getNumStateChanges() const noexcept              { return numStateChanges.load(); }
+
     /** Turns a specified note on.
 
         This will cause a suitable midi note-on event to be injected into the midi buffer during the
@@ -192,11 +208,30 @@ public:
 
 private:
     //==============================================================================
-    CriticalSection lock;
-    uint16 noteStates [128];
-    MidiBuffer eventsToAdd;
-    Array <MidiKeyboardStateListener*> listeners;
-
+    // A note-on or note-off that's waiting to be added to the next buffer
+    struct PendingEvent
+    {
+        uint32 time, sequenceNumber;
+        float velocity;
+        uint8 channel, noteNumber;
+        bool isNoteOn;
+    };
+
+    enum { maxPendingEvents = 512 };
+
+    std::atomic<uint16> noteStates[128];
+    std::atomic<uint32> numStateChanges { 0 }, firstValidSequenceNumber { 0 };
+
+    AbstractFifo pendingEventFifo { maxPendingEvents };
+    PendingEvent pendingEvents[maxPendingEvents];
+    SpinLock pendingEventWriteLock;
+    uint32 nextSequenceNumber = 0;
+
+    CriticalSection listenerLock;
+    Array<MidiKeyboardStateListener*> listeners;
+
+    void addPendingEvent (int midiChannel, int midiNoteNumber, float velocity, bool isNoteOn);
+    void addPendingEvents (MidiBuffer&, int startSample, int numSamples, bool injectEvents);
     void noteOnInternal (int midiChannel, int midiNoteNumber, float velocity);
     void noteOffInternal (int midiChannel, int midiNoteNumber, float velocity);
 
@@ -36,6 +36,98 @@ namespace MidiHelpers
     }
 }
 
+//==============================================================================
+/*  Messages that are too long to fit in the packedData are held in reference-counted
+    blocks, so that copying them (e.g. in a MidiMessageSequence) doesn't allocate.
+    Freed blocks of the more common sizes are kept in a small lock-free cache, so that
+    creating long messages like sysex and meta-events doesn't usually hit malloc either.
+*/
+namespace MidiMessageStorage
+{
+    struct Header
+    {
+        std::atomic<int> refCount;
+        int sizeClass;
+    };
+
+    enum { numSizeClasses = 4, numCachedBlocksPerSize = 16 };
+
+    // This is zero-initialised and never destroyed, so blocks can be released at any time
+    static std::atomic<Header*> cachedBlocks[numSizeClasses][numCachedBlocksPerSize];
+
+    inline int getCapacity (int sizeClass) noexcept    { return 64 << (2 * sizeClass); }
+
+    inline int getSizeClass (int numBytes) noexcept
+    {
+        for (int i = 0; i < numSizeClasses; ++i)
+            if (numBytes <= getCapacity (i))
+                return i;
+
+        return -1;
+    }
+
+    inline Header* getHeader (const uint8* data) noexcept
+    {
+        return reinterpret_cast<Header*> (const_cast<uint8*> (data)) - 1;
+    }
+
+    static uint8* allocate (int numBytes) noexcept
+    {
+        auto sizeClass = getSizeClass (numBytes);
+        Header* header = nullptr;
+
+        if (sizeClass >= 0)
+            for (auto& slot : cachedBlocks[sizeClass])
+                if (slot.load (std::memory_order_relaxed) != nullptr
+                     && (header = slot.exchange (nullptr, std::memory_order_acquire)) != nullptr)
+                    break;
+
+        if (header == nullptr)
+        {
+            auto* block = std::malloc (sizeof (Header) + (size_t) (sizeClass >= 0 ? getCapacity (sizeClass) : numBytes));
+            jassert (block != nullptr);
+
+            header = new (block) Header();
+            header->sizeClass = sizeClass;
+        }
+
+        header->refCount.store (1, std::memory_order_relaxed);
+        return reinterpret_cast<uint8*> (header + 1);
+    }
+
+    static void addReference (const uint8* data) noexcept
+    {
+        getHeader (data)->refCount.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    static void release (const uint8* data) noexcept
+    {
+        auto* header = getHeader (data);
+
+        if (header->refCount.fetch_sub (1, std::memory_order_acq_rel) != 1)
+            return;
+
+        if (header->sizeClass >= 0)
+        {
+            for (auto& slot : cachedBlocks[header->sizeClass])
+            {
+                Header* empty = nullptr;
+
+                if (slot.compare_exchange_strong (empty, header, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+            }
+        }
+
+        header->~Header();
+        std::free (header);
+    }
+
+    static bool isShared (const uint8* data) noexcept
+    {
+        return getHeader (data)->refCount.load (std::memory_order_acquire) > 1;
+    }
+}
+
 //==============================================================================
 uint8 MidiMessage::floatValueToMidiByte (const float v) noexcept
 {
@@ -147,19 +239,19 @@ MidiMessage::MidiMessage (const int byte1, const int byte2, const int byte3, con
 MidiMessage::MidiMessage (const MidiMessage& other)
    : timeStamp (other.timeStamp), size (other.size)
 {
+    packedData.allocatedData = other.packedData.allocatedData;
+
     if (isHeapAllocated())
-        memcpy (allocateSpace (size), other.getData(), (size_t) size);
-    else
-        packedData.allocatedData = other.packedData.allocatedData;
+        MidiMessageStorage::addReference (packedData.allocatedData);
 }
 
 MidiMessage::MidiMessage (const MidiMessage& other, const double newTimeStamp)
    : timeStamp (newTimeStamp), size (other.size)
 {
+    packedData.allocatedData = other.packedData.allocatedData;
+
     if (isHeapAllocated())
-        memcpy (allocateSpace (size), other.getData(), (size_t) size);
-    else
-        packedData.allocatedData = other.packedData.allocatedData;
+        MidiMessageStorage::addReference (packedData.allocatedData);
 }
 
 MidiMessage::MidiMessage (const void* srcData, int sz, int& numBytesUsed, const uint8 lastStatusByte,
@@ -269,22 +361,12 @@ MidiMessage& MidiMessage::operator= (const MidiMessage& other)
     if (this != &other)
     {
         if (other.isHeapAllocated())
-        {
-            if (isHeapAllocated())
-                packedData.allocatedData = static_cast<uint8*> (std::realloc (packedData.allocatedData, (size_t) other.size));
-            else
-                packedData.allocatedData = static_cast<uint8*> (std::malloc ((size_t) other.size));
-
-            memcpy (packedData.allocatedData, other.packedData.allocatedData, (size_t) other.size);
-        }
-        else
-        {
-            if (isHeapAllocated())
-                std::free (packedData.allocatedData);
+            MidiMessageStorage::addReference (other.packedData.allocatedData);
 
-            packedData.allocatedData = other.packedData.allocatedData;
-        }
+        if (isHeapAllocated())
+            MidiMessageStorage::release (packedData.allocatedData);
 
+        packedData.allocatedData = other.packedData.allocatedData;
         timeStamp = other.timeStamp;
         size = other.size;
     }
@@ -301,6 +383,12 @@ MidiMessage::MidiMessage (MidiMessage&& other) noexcept
 
 MidiMessage& MidiMessage::operator= (MidiMessage&& other) noexcept
 {
+    if (this == &other)
+        return *this;
+
+    if (isHeapAllocated())
+        MidiMessageStorage::release (packedData.allocatedData);
+
     packedData.allocatedData = other.packedData.allocatedData;
     timeStamp = other.timeStamp;
     size = other.size;
@@ -311,14 +399,14 @@ MidiMessage& MidiMessage::operator= (MidiMessage&& other) noexcept
 MidiMessage::~MidiMessage() noexcept
 {
     if (isHeapAllocated())
-        std::free (packedData.allocatedData);
+        MidiMessageStorage::release (packedData.allocatedData);
 }
 
 uint8* MidiMessage::allocateSpace (int bytes)
 {
     if (bytes > (int) sizeof (packedData))
     {
-        auto d = static_cast<uint8*> (std::malloc ((size_t) bytes));
+        auto d = MidiMessageStorage::allocate (bytes);
         packedData.allocatedData = d;
         return d;
     }
@@ -326,6 +414,20 @@ uint8* MidiMessage::allocateSpace (int bytes)
     return packedData.asBytes;
 }
 
+uint8* MidiMessage::getWritableData() noexcept
+{
+    // other copies of this message may be sharing its data, so give it a copy of its own
+    if (isHeapAllocated() && MidiMessageStorage::isShared (packedData.allocatedData))
+    {
+        auto d = MidiMessageStorage::allocate (size);
+        memcpy (d, packedData.allocatedData, (size_t) size);
+        MidiMessageStorage::release (packedData.allocatedData);
+        packedData.allocatedData = d;
+    }
+
+    return getData();
+}
+
 String MidiMessage::getDescription() const
 {
     if (isNoteOn())           return "Note on "  + MidiMessage::getMidiNoteName (getNoteNumber(), true, true, 3) + " Velocity " + String (getVelocity()) + " Channel " + String (getChannel());
@@ -380,7 +482,7 @@ void MidiMessage::setChannel (const int channel) noexcept
 {
     jassert (channel > 0 && channel <= 16); // valid channels are numbered 1 to 16
 
-    auto data = getData();
+    auto data = getWritableData();
 
     if ((data[0] & 0xf0) != (uint8) 0xf0)
         data[0] = (uint8) ((data[0] & (uint8) 0xf0)
@@ -417,7 +519,7 @@ int MidiMessage::getNoteNumber() const noexcept
 void MidiMessage::setNoteNumber (const int newNoteNumber) noexcept
 {
     if (isNoteOnOrOff() || isAftertouch())
-        getData()[1] = (uint8) (newNoteNumber & 127);
+        getWritableData()[1] = (uint8) (newNoteNumber & 127);
 }
 
 uint8 MidiMessage::getVelocity() const noexcept
@@ -436,14 +538,14 @@ float MidiMessage::getFloatVelocity() const noexcept
 void MidiMessage::setVelocity (const float newVelocity) noexcept
 {
     if (isNoteOnOrOff())
-        getData()[2] = floatValueToMidiByte (newVelocity);
+        getWritableData()[2] = floatValueToMidiByte (newVelocity);
 }
 
 void MidiMessage::multiplyVelocity (const float scaleFactor) noexcept
 {
     if (isNoteOnOrOff())
     {
-        auto data = getData();
+        auto data = getWritableData();
         data[2] = MidiHelpers::validVelocity (roundToInt (scaleFactor * data[2]));
     }
 }
@@ -656,13 +758,15 @@ bool MidiMessage::isSysEx() const noexcept
 
 MidiMessage MidiMessage::createSysExMessage (const void* sysexData, const int dataSize)
 {
-    HeapBlock<uint8> m (dataSize + 2);
+    MidiMessage result;
+    auto m = result.allocateSpace (dataSize + 2);
+    result.size = dataSize + 2;
 
     m[0] = 0xf0;
     memcpy (m + 1, sysexData, (size_t) dataSize);
     m[dataSize + 1] = 0xf7;
 
-    return MidiMessage (m, dataSize + 2);
+    return result;
 }
 
 const uint8* MidiMessage::getSysExData() const noexcept
@@ -1141,4 +1245,110 @@ const char* MidiMessage::getControllerName (const int n)
     return isPositiveAndBelow (n, numElementsInArray (names)) ? names[n] : nullptr;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct MidiMessageTest  : public UnitTest
+{
+    MidiMessageTest()  : UnitTest ("MidiMessage", "MIDI/MPE") {}
+
+    static MidiMessage createSysEx (Random& r, int size)
+    {
+        HeapBlock<uint8> data ((size_t) size);
+
+        for (int i = 0; i < size; ++i)
+            data[i] = (uint8) r.nextInt (128);
+
+        return MidiMessage::createSysExMessage (data, size);
+    }
+
+    static bool haveSameData (const MidiMessage& a, const MidiMessage& b)
+    {
+        return a.getRawDataSize() == b.getRawDataSize()
+                && memcmp (a.getRawData(), b.getRawData(), (size_t) a.getRawDataSize()) == 0;
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Copying long messages");
+        {
+            for (auto size : { 5, 60, 100, 1000, 10000 })
+            {
+                auto original = createSysEx (r, size);
+                MidiMessage copy (original), copyWithTime (original, 2.0), assigned;
+                assigned = copy;
+
+                expect (copy.getRawData() == original.getRawData() || size + 2 <= (int) sizeof (void*));
+                expect (haveSameData (copy, original));
+                expect (haveSameData (copyWithTime, original));
+                expect (haveSameData (assigned, original));
+                expectEquals (copyWithTime.getTimeStamp(), 2.0);
+
+                original = MidiMessage::noteOn (1, 60, (uint8) 100);
+                copy = createSysEx (r, size);
+                expect (haveSameData (MidiMessage (copy), copy));
+                expect (haveSameData (assigned, copyWithTime));
+            }
+        }
+
+        beginTest ("Modifying a shared message");
+        {
+            const uint8 longNoteOn[] = { 0x90, 60, 100, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+            MidiMessage original (longNoteOn, (int) sizeof (longNoteOn)), copy (original);
+
+            copy.setVelocity (0.5f);
+            copy.setChannel (3);
+
+            expectEquals ((int) original.getVelocity(), 100);
+            expectEquals (original.getChannel(), 1);
+            expectEquals ((int) copy.getVelocity(), 64);
+            expectEquals (copy.getChannel(), 3);
+        }
+
+        beginTest ("Copying on several threads");
+        {
+            auto original = createSysEx (r, 200);
+            auto copy = original;
+            std::atomic<bool> failed { false };
+
+            struct CopyingThread  : public Thread
+            {
+                CopyingThread (const MidiMessage& m, std::atomic<bool>& f)  : Thread ("MidiMessage test"), message (m), failed (f) {}
+
+                void run() override
+                {
+                    for (int i = 0; i < 20000; ++i)
+                    {
+                        MidiMessage a (message), b;
+                        b = a;
+
+                        if (! haveSameData (b, message))
+                            failed = true;
+                    }
+                }
+
+                const MidiMessage& message;
+                std::atomic<bool>& failed;
+            };
+
+            OwnedArray<CopyingThread> threads;
+
+            for (int i = 0; i < 4; ++i)
+                threads.add (new CopyingThread (original, failed))->startThread();
+
+            for (auto* t : threads)
+                t->waitForThreadToExit (10000);
+
+            expect (! failed);
+            expect (haveSameData (copy, original));
+        }
+    }
+};
+
+static MidiMessageTest midiMessageTest;
+
+#endif
+
 } // namespace juce
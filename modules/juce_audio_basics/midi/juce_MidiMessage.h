@@ -108,7 +108,10 @@ public:
     */
     MidiMessage() noexcept;
 
-    /** Creates a copy of another midi message. */
+    /** Creates a copy of another midi message.
+        This doesn't allocate any memory: long messages such as sysex share their data
+        with the original until one of them is modified.
+    */
     MidiMessage (const MidiMessage&);
 
     /** Creates a copy of another midi message, with a different timestamp. */
@@ -947,6 +950,7 @@ private:
     inline bool isHeapAllocated() const noexcept  { return size > (int) sizeof (packedData); }
     inline uint8* getData() const noexcept        { return isHeapAllocated() ? packedData.allocatedData : (uint8*) packedData.asBytes; }
     uint8* allocateSpace (int);
+    uint8* getWritableData() noexcept;
 };
 
 } // namespace juce
@@ -23,6 +23,14 @@
 namespace juce
 {
 
+namespace MidiMessageSequenceHelpers
+{
+    static bool isEarlier (const MidiMessageSequence::MidiEventHolder* a, const MidiMessageSequence::MidiEventHolder* b) noexcept
+    {
+        return a->message.getTimeStamp() < b->message.getTimeStamp();
+    }
+}
+
 MidiMessageSequence::MidiEventHolder::MidiEventHolder (const MidiMessage& mm) : message (mm) {}
 MidiMessageSequence::MidiEventHolder::MidiEventHolder (MidiMessage&& mm) : message (std::move (mm)) {}
 MidiMessageSequence::MidiEventHolder::~MidiEventHolder() {}
@@ -38,10 +46,13 @@ MidiMessageSequence::MidiMessageSequence (const MidiMessageSequence& other)
 
     for (int i = 0; i < list.size(); ++i)
     {
-        auto noteOffIndex = other.getIndexOfMatchingKeyUp (i);
+        if (other.list.getUnchecked(i)->noteOffObject != nullptr)
+        {
+            auto noteOffIndex = other.getIndexOfMatchingKeyUp (i);
 
-        if (noteOffIndex >= 0)
-            list.getUnchecked(i)->noteOffObject = list.getUnchecked (noteOffIndex);
+            if (noteOffIndex >= 0)
+                list.getUnchecked(i)->noteOffObject = list.getUnchecked (noteOffIndex);
+        }
     }
 }
 
@@ -105,6 +116,12 @@ int MidiMessageSequence::getIndexOfMatchingKeyUp (int index) const noexcept
     {
         if (auto* noteOff = meh->noteOffObject)
         {
+            // the note-off can't be earlier than its note-on, so start looking at its timestamp
+            for (int i = jmax (index, getNextIndexAtTime (noteOff->message.getTimeStamp())); i < list.size(); ++i)
+                if (list.getUnchecked(i) == noteOff)
+                    return i;
+
+            // (the sequence may have been left unsorted, so fall back to the slow search)
             for (int i = index; i < list.size(); ++i)
                 if (list.getUnchecked(i) == noteOff)
                     return i;
@@ -123,14 +140,10 @@ int MidiMessageSequence::getIndexOf (const MidiEventHolder* event) const noexcep
 
 int MidiMessageSequence::getNextIndexAtTime (double timeStamp) const noexcept
 {
-    auto numEvents = list.size();
-    int i;
-
-    for (i = 0; i < numEvents; ++i)
-        if (list.getUnchecked(i)->message.getTimeStamp() >= timeStamp)
-            break;
+    auto* firstEvent = std::lower_bound (list.begin(), list.end(), timeStamp,
+                                         [] (const MidiEventHolder* e, double t) { return e->message.getTimeStamp() < t; });
 
-    return i;
+    return (int) (firstEvent - list.begin());
 }
 
 //==============================================================================
@@ -157,16 +170,37 @@ MidiMessageSequence::MidiEventHolder* MidiMessageSequence::addEvent (MidiEventHo
 {
     newEvent->message.addToTimeStamp (timeAdjustment);
     auto time = newEvent->message.getTimeStamp();
-    int i;
+    auto numEvents = list.size();
 
-    for (i = list.size(); --i >= 0;)
-        if (list.getUnchecked(i)->message.getTimeStamp() <= time)
-            break;
+    // appending to the end is by far the most common case, so check for that first
+    if (numEvents == 0 || list.getUnchecked (numEvents - 1)->message.getTimeStamp() <= time)
+    {
+        list.add (newEvent);
+        return newEvent;
+    }
+
+    auto* eventAfter = std::upper_bound (list.begin(), list.end(), time,
+                                         [] (double t, const MidiEventHolder* e) { return t < e->message.getTimeStamp(); });
 
-    list.insert (i + 1, newEvent);
+    list.insert ((int) (eventAfter - list.begin()), newEvent);
     return newEvent;
 }
 
+void MidiMessageSequence::addEvents (const Array<MidiMessage>& newMessages, double timeAdjustment)
+{
+    auto firstNewEvent = list.size();
+    list.ensureStorageAllocated (firstNewEvent + newMessages.size());
+
+    for (auto& m : newMessages)
+    {
+        auto newOne = new MidiEventHolder (m);
+        newOne->message.addToTimeStamp (timeAdjustment);
+        list.add (newOne);
+    }
+
+    mergeNewEvents (firstNewEvent);
+}
+
 MidiMessageSequence::MidiEventHolder* MidiMessageSequence::addEvent (const MidiMessage& newMessage, double timeAdjustment)
 {
     return addEvent (new MidiEventHolder (newMessage), timeAdjustment);
@@ -190,6 +224,9 @@ void MidiMessageSequence::deleteEvent (int index, bool deleteMatchingNoteUp)
 
 void MidiMessageSequence::addSequence (const MidiMessageSequence& other, double timeAdjustment)
 {
+    auto firstNewEvent = list.size();
+    list.ensureStorageAllocated (firstNewEvent + other.getNumEvents());
+
     for (auto* m : other)
     {
         auto newOne = new MidiEventHolder (m->message);
@@ -197,7 +234,7 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other, double
         list.add (newOne);
     }
 
-    sort();
+    mergeNewEvents (firstNewEvent);
 }
 
 void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
@@ -205,6 +242,8 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
                                        double firstAllowableTime,
                                        double endOfAllowableDestTimes)
 {
+    auto firstNewEvent = list.size();
+
     for (auto* m : other)
     {
         auto t = m->message.getTimeStamp() + timeAdjustment;
@@ -217,53 +256,90 @@ void MidiMessageSequence::addSequence (const MidiMessageSequence& other,
         }
     }
 
-    sort();
+    mergeNewEvents (firstNewEvent);
 }
 
 void MidiMessageSequence::sort() noexcept
 {
-    std::stable_sort (list.begin(), list.end(),
-                      [] (const MidiEventHolder* a, const MidiEventHolder* b) { return a->message.getTimeStamp() < b->message.getTimeStamp(); });
+    std::stable_sort (list.begin(), list.end(), MidiMessageSequenceHelpers::isEarlier);
+}
+
+void MidiMessageSequence::mergeNewEvents (int firstNewEvent) noexcept
+{
+    // The existing events are already in order, so the new ones only need sorting
+    // among themselves before being merged in. Both steps are stable, so events with
+    // equal timestamps end up in the same order that addEvent() would have put them.
+    auto* start = list.begin();
+    auto* middle = start + firstNewEvent;
+    auto* end = list.end();
+
+    if (! std::is_sorted (middle, end, MidiMessageSequenceHelpers::isEarlier))
+        std::stable_sort (middle, end, MidiMessageSequenceHelpers::isEarlier);
+
+    if (middle != start && middle != end && MidiMessageSequenceHelpers::isEarlier (*middle, *(middle - 1)))
+        std::inplace_merge (start, middle, end, MidiMessageSequenceHelpers::isEarlier);
 }
 
 void MidiMessageSequence::updateMatchedPairs() noexcept
 {
-    for (int i = 0; i < list.size(); ++i)
+    // A single pass through the list, remembering the note-on that's still waiting
+    // for its note-off on each channel and key. If a key gets a second note-on before
+    // the first one has been released, a note-off is added just before the new one.
+    MidiEventHolder* notesWaitingForNoteOff[16][128] = {};
+
+    // Only created if some note-offs need to be added, so that they can all be inserted
+    // while copying the list, rather than shuffling it along for each one.
+    OwnedArray<MidiEventHolder> newList;
+    auto numEvents = list.size();
+
+    for (int i = 0; i < numEvents; ++i)
     {
         auto* meh = list.getUnchecked(i);
-        auto& m1 = meh->message;
+        auto& m = meh->message;
 
-        if (m1.isNoteOn())
+        if (m.isNoteOn())
         {
-            meh->noteOffObject = nullptr;
-            auto note = m1.getNoteNumber();
-            auto chan = m1.getChannel();
-            auto len = list.size();
+            auto chan = m.getChannel();
+            auto note = m.getNoteNumber();
+            auto& waitingNote = notesWaitingForNoteOff[chan - 1][note];
 
-            for (int j = i + 1; j < len; ++j)
+            if (waitingNote != nullptr)
             {
-                auto* meh2 = list.getUnchecked(j);
-                auto& m = meh2->message;
-
-                if (m.getNoteNumber() == note && m.getChannel() == chan)
+                if (newList.isEmpty())
                 {
-                    if (m.isNoteOff())
-                    {
-                        meh->noteOffObject = meh2;
-                        break;
-                    }
-
-                    if (m.isNoteOn())
-                    {
-                        auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
-                        list.insert (j, newEvent);
-                        newEvent->message.setTimeStamp (m.getTimeStamp());
-                        meh->noteOffObject = newEvent;
-                        break;
-                    }
+                    newList.ensureStorageAllocated (numEvents + 16);
+                    newList.insertArray (0, list.begin(), i);
                 }
+
+                auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
+                newEvent->message.setTimeStamp (m.getTimeStamp());
+                newList.add (newEvent);
+                waitingNote->noteOffObject = newEvent;
+            }
+
+            meh->noteOffObject = nullptr;
+            waitingNote = meh;
+        }
+        else if (m.isNoteOff())
+        {
+            auto& waitingNote = notesWaitingForNoteOff[m.getChannel() - 1][m.getNoteNumber()];
+
+            if (waitingNote != nullptr)
+            {
+                waitingNote->noteOffObject = meh;
+                waitingNote = nullptr;
             }
         }
+
+        if (! newList.isEmpty())
+            newList.add (meh);
+    }
+
+    if (! newList.isEmpty())
+    {
+        // the events are all owned by the new list now
+        list.clear (false);
+        list.swapWith (newList);
     }
 }
 
@@ -395,6 +471,112 @@ struct MidiMessageSequenceTest  : public juce::UnitTest
         expectEquals (s.getNumEvents(), 7);
         expectEquals (s.getIndexOfMatchingKeyUp (0), -1); // Truncated note, should be no note off
         expectEquals (s.getTimeOfMatchingKeyUp (1), 5.0);
+
+        beginTest ("Overlapping notes");
+        {
+            MidiMessageSequence s3;
+            s3.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (0.0));
+            s3.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (1.0));
+            s3.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (2.0));
+            s3.updateMatchedPairs();
+
+            expectEquals (s3.getNumEvents(), 4);
+            expect (s3.getEventPointer (1)->message.isNoteOff());
+            expectEquals (s3.getEventTime (1), 1.0);
+            expectEquals (s3.getIndexOfMatchingKeyUp (0), 1);
+            expectEquals (s3.getIndexOfMatchingKeyUp (2), 3);
+        }
+
+        auto r = getRandom();
+        Array<MidiMessage> messages;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto channel = 1 + r.nextInt (2);
+            auto note = 60 + r.nextInt (4);
+            auto time = (double) r.nextInt (500);
+
+            messages.add (r.nextBool() ? MidiMessage::noteOn  (channel, note, 0.5f).withTimeStamp (time)
+                                       : MidiMessage::noteOff (channel, note, 0.5f).withTimeStamp (time));
+        }
+
+        MidiMessageSequence batch, single;
+        batch.addEvents (messages);
+
+        for (auto& m : messages)
+            single.addEvent (m);
+
+        beginTest ("Adding a batch of events");
+        {
+            expectEquals (batch.getNumEvents(), single.getNumEvents());
+
+            bool allMatch = true;
+
+            for (int i = 0; i < batch.getNumEvents(); ++i)
+                allMatch = allMatch && batch.getEventPointer (i)->message.getDescription() == single.getEventPointer (i)->message.getDescription()
+                                    && batch.getEventTime (i) == single.getEventTime (i);
+
+            expect (allMatch);
+        }
+
+        beginTest ("Finding events by time");
+        {
+            bool allMatch = true;
+
+            for (double time = -1.0; time < 502.0; time += 0.5)
+            {
+                int expectedIndex = 0;
+
+                while (expectedIndex < batch.getNumEvents() && batch.getEventTime (expectedIndex) < time)
+                    ++expectedIndex;
+
+                allMatch = allMatch && batch.getNextIndexAtTime (time) == expectedIndex;
+            }
+
+            expect (allMatch);
+        }
+
+        beginTest ("Matching lots of notes");
+        {
+            batch.updateMatchedPairs();
+
+            bool allMatch = true;
+
+            for (int i = 0; i < batch.getNumEvents(); ++i)
+            {
+                auto& m = batch.getEventPointer (i)->message;
+
+                if (! m.isNoteOn())
+                    continue;
+
+                // the matching note-off should be the next event on the same key,
+                // with one having been added if that would have been another note-on
+                int expectedIndex = -1;
+
+                for (int j = i + 1; j < batch.getNumEvents() && expectedIndex < 0; ++j)
+                {
+                    auto& m2 = batch.getEventPointer (j)->message;
+
+                    if ((m2.isNoteOn() || m2.isNoteOff()) && m2.getChannel() == m.getChannel() && m2.getNoteNumber() == m.getNoteNumber())
+                    {
+                        allMatch = allMatch && m2.isNoteOff();
+                        expectedIndex = j;
+                    }
+                }
+
+                allMatch = allMatch && batch.getIndexOfMatchingKeyUp (i) == expectedIndex;
+            }
+
+            expect (allMatch);
+
+            MidiMessageSequence copy (batch);
+            bool copyMatches = true;
+
+            for (int i = 0; i < batch.getNumEvents(); ++i)
+                copyMatches = copyMatches && copy.getIndexOfMatchingKeyUp (i) == batch.getIndexOfMatchingKeyUp (i);
+
+            expect (copyMatches);
+        }
     }
 };
 
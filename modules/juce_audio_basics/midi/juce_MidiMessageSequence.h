@@ -174,6 +174,22 @@ public:
     */
     MidiEventHolder* addEvent (MidiMessage&& newMessage, double timeAdjustment = 0);
 
+    /** Inserts a set of midi messages into the sequence.
+
+        This is much quicker than calling addEvent() for each message when you've got a lot
+        of them, because they all get added in one go and then merged into place. The array
+        doesn't need to be sorted, and messages with the same timestamp will keep the order
+        in which they appear in it.
+
+        Remember to call updateMatchedPairs() after adding note-on events.
+
+        @param newMessages      the messages to add (internal copies will be made)
+        @param timeAdjustment   an optional value to add to the timestamps of the messages
+                                that will be inserted
+        @see addEvent, updateMatchedPairs
+    */
+    void addEvents (const Array<MidiMessage>& newMessages, double timeAdjustment = 0);
+
     /** Deletes one of the events in the sequence.
 
         Remember to call updateMatchedPairs() after removing events.
@@ -293,6 +309,7 @@ private:
     OwnedArray<MidiEventHolder> list;
 
     MidiEventHolder* addEvent (MidiEventHolder*, double);
+    void mergeNewEvents (int firstNewEvent) noexcept;
 
     JUCE_LEAK_DETECTOR (MidiMessageSequence)
 };
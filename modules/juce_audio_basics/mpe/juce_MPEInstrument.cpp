@@ -27,6 +27,9 @@ namespace
 {
     const uint8 noLSBValueReceived = 0xff;
     const Range<int> allChannels { 1, 17 };
+
+    // each channel and note number can only be playing one note at a time
+    const int maxNumNotes = 16 * 128;
 }
 
 //==============================================================================
@@ -35,6 +38,10 @@ MPEInstrument::MPEInstrument() noexcept
     std::fill_n (lastPressureLowerBitReceivedOnChannel, 16, noLSBValueReceived);
     std::fill_n (lastTimbreLowerBitReceivedOnChannel, 16, noLSBValueReceived);
     std::fill_n (isMemberChannelSustained, 16, false);
+    std::fill_n (&noteIndexForChannelAndNote[0][0], maxNumNotes, (int16) -1);
+    std::fill_n (numNotesOnChannel, 16, (int16) 0);
+
+    notesSnapshot.reset (new MPENote[(size_t) maxNumNotes]);
 
     pitchbendDimension.value = &MPENote::pitchbend;
     pressureDimension.value = &MPENote::pressure;
@@ -217,6 +224,8 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
     // in MPE mode, "reset all controllers" is per-zone and expected on the master channel;
     // in legacy mode, it is per MIDI channel (within the channel range used).
 
+    const ScopedLock sl (lock);
+
     if (legacyMode.isEnabled && legacyMode.channelRange.contains (message.getChannel()))
     {
         for (auto i = notes.size(); --i >= 0;)
@@ -228,7 +237,7 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
         }
     }
@@ -246,10 +255,12 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
                 note.keyState = MPENote::off;
                 note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
         }
     }
+
+    publishNotesSnapshot();
 }
 
 //==============================================================================
@@ -304,11 +315,12 @@ void MPEInstrument::noteOn (int midiChannel,
         alreadyPlayingNote->keyState = MPENote::off;
         alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
         listeners.call ([=] (Listener& l) { l.noteReleased (*alreadyPlayingNote); });
-        notes.remove (alreadyPlayingNote);
+        removeNote ((int) (alreadyPlayingNote - notes.begin()));
     }
 
-    notes.add (newNote);
+    addNote (newNote);
     listeners.call ([&] (Listener& l) { l.noteAdded (newNote); });
+    publishNotesSnapshot();
 }
 
 //==============================================================================
@@ -335,12 +347,14 @@ void MPEInstrument::noteOff (int midiChannel,
         if (note->keyState == MPENote::off)
         {
             listeners.call ([=] (Listener& l) { l.noteReleased (*note); });
-            notes.remove (note);
+            removeNote ((int) (note - notes.begin()));
         }
         else
         {
             listeners.call ([=] (Listener& l) { l.noteKeyStateChanged (*note); });
         }
+
+        publishNotesSnapshot();
     }
 }
 
@@ -349,18 +363,21 @@ void MPEInstrument::pitchbend (int midiChannel, MPEValue value)
 {
     const ScopedLock sl (lock);
     updateDimension (midiChannel, pitchbendDimension, value);
+    publishNotesSnapshot();
 }
 
 void MPEInstrument::pressure (int midiChannel, MPEValue value)
 {
     const ScopedLock sl (lock);
     updateDimension (midiChannel, pressureDimension, value);
+    publishNotesSnapshot();
 }
 
 void MPEInstrument::timbre (int midiChannel, MPEValue value)
 {
     const ScopedLock sl (lock);
     updateDimension (midiChannel, timbreDimension, value);
+    publishNotesSnapshot();
 }
 
 MPEValue MPEInstrument::getInitialValueForNewNote (int midiChannel, MPEDimension& dimension) const
@@ -383,6 +400,9 @@ void MPEInstrument::updateDimension (int midiChannel, MPEDimension& dimension, M
     {
         if (dimension.trackingMode == allNotesOnChannel)
         {
+            if (numNotesOnChannel[midiChannel - 1] == 0)
+                return;
+
             for (auto i = notes.size(); --i >= 0;)
             {
                 auto& note = notes.getReference (i);
@@ -496,12 +516,14 @@ void MPEInstrument::sustainPedal (int midiChannel, bool isDown)
 {
     const ScopedLock sl (lock);
     handleSustainOrSostenuto (midiChannel, isDown, false);
+    publishNotesSnapshot();
 }
 
 void MPEInstrument::sostenutoPedal (int midiChannel, bool isDown)
 {
     const ScopedLock sl (lock);
     handleSustainOrSostenuto (midiChannel, isDown, true);
+    publishNotesSnapshot();
 }
 
 //==============================================================================
@@ -532,7 +554,7 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
             if (note.keyState == MPENote::off)
             {
                 listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                removeNote (i);
             }
             else
             {
@@ -617,15 +639,88 @@ MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) co
     return {};
 }
 
+Array<MPENote> MPEInstrument::getPlayingNotesSnapshot() const
+{
+    Array<MPENote> result;
+
+    for (;;)
+    {
+        // (an odd sequence number means that a new snapshot is being written)
+        auto sequenceNumber = snapshotSequenceNumber.load (std::memory_order_acquire);
+
+        if ((sequenceNumber & 1) == 0)
+        {
+            result.clearQuick();
+            result.addArray (notesSnapshot.get(), numNotesInSnapshot.load (std::memory_order_relaxed));
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (snapshotSequenceNumber.load (std::memory_order_relaxed) == sequenceNumber)
+                return result;
+        }
+
+        Thread::yield();
+    }
+}
+
+//==============================================================================
+void MPEInstrument::addNote (const MPENote& newNote)
+{
+    auto channelIndex = newNote.midiChannel - 1;
+    jassert (isPositiveAndBelow (channelIndex, 16) && newNote.initialNote < 128);
+    jassert (noteIndexForChannelAndNote[channelIndex][newNote.initialNote] < 0);
+
+    noteIndexForChannelAndNote[channelIndex][newNote.initialNote] = (int16) notes.size();
+    ++numNotesOnChannel[channelIndex];
+    notes.add (newNote);
+}
+
+void MPEInstrument::removeNote (int index)
+{
+    auto& note = notes.getReference (index);
+    noteIndexForChannelAndNote[note.midiChannel - 1][note.initialNote] = -1;
+    --numNotesOnChannel[note.midiChannel - 1];
+
+    notes.remove (index);
+
+    for (int i = index; i < notes.size(); ++i)
+    {
+        auto& movedNote = notes.getReference (i);
+        noteIndexForChannelAndNote[movedNote.midiChannel - 1][movedNote.initialNote] = (int16) i;
+    }
+}
+
+void MPEInstrument::removeAllNotes() noexcept
+{
+    for (auto& note : notes)
+        noteIndexForChannelAndNote[note.midiChannel - 1][note.initialNote] = -1;
+
+    std::fill_n (numNotesOnChannel, 16, (int16) 0);
+    notes.clear();
+}
+
+void MPEInstrument::publishNotesSnapshot() noexcept
+{
+    auto sequenceNumber = snapshotSequenceNumber.load (std::memory_order_relaxed);
+    snapshotSequenceNumber.store (sequenceNumber + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    auto numNotes = jmin (notes.size(), maxNumNotes);
+    std::copy (notes.begin(), notes.begin() + numNotes, notesSnapshot.get());
+    numNotesInSnapshot.store (numNotes, std::memory_order_relaxed);
+
+    snapshotSequenceNumber.store (sequenceNumber + 2, std::memory_order_release);
+}
+
 //==============================================================================
 const MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) const noexcept
 {
-    for (int i = 0; i < notes.size(); ++i)
+    if (isPositiveAndBelow (midiChannel - 1, 16) && isPositiveAndBelow (midiNoteNumber, 128))
     {
-        auto& note = notes.getReference (i);
+        auto index = noteIndexForChannelAndNote[midiChannel - 1][midiNoteNumber];
 
-        if (note.midiChannel == midiChannel && note.initialNote == midiNoteNumber)
-            return &note;
+        if (index >= 0)
+            return &(notes.getReference (index));
     }
 
     return nullptr;
@@ -658,6 +753,9 @@ MPENote* MPEInstrument::getNotePtr (int midiChannel, TrackingMode mode) noexcept
 //==============================================================================
 const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexcept
 {
+    if (! isPositiveAndBelow (midiChannel - 1, 16) || numNotesOnChannel[midiChannel - 1] == 0)
+        return nullptr;
+
     for (auto i = notes.size(); --i >= 0;)
     {
         auto& note = notes.getReference (i);
@@ -678,6 +776,9 @@ MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) noexcept
 //==============================================================================
 const MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
 {
+    if (! isPositiveAndBelow (midiChannel - 1, 16) || numNotesOnChannel[midiChannel - 1] == 0)
+        return nullptr;
+
     int initialNoteMax = -1;
     MPENote* result = nullptr;
 
@@ -704,6 +805,9 @@ MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) noexcept
 
 const MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
 {
+    if (! isPositiveAndBelow (midiChannel - 1, 16) || numNotesOnChannel[midiChannel - 1] == 0)
+        return nullptr;
+
     int initialNoteMin = 128;
     MPENote* result = nullptr;
 
@@ -741,7 +845,8 @@ void MPEInstrument::releaseAllNotes()
         listeners.call ([&] (Listener& l) { l.noteReleased (note); });
     }
 
-    notes.clear();
+    removeAllNotes();
+    publishNotesSnapshot();
 }
 
 //==============================================================================
@@ -2052,6 +2157,108 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("Looking up lots of notes");
+        {
+            MPEInstrument test;
+            test.enableLegacyMode();
+
+            auto r = getRandom();
+            bool allMatch = true;
+
+            for (int i = 0; i < 3000; ++i)
+            {
+                auto channel = 1 + r.nextInt (16);
+                auto noteNumber = r.nextInt (128);
+
+                if (r.nextInt (3) == 0)
+                    test.noteOff (channel, noteNumber, MPEValue::from7BitInt (64));
+                else if (r.nextInt (20) == 0)
+                    test.sustainPedal (channel, r.nextBool());
+                else
+                    test.noteOn (channel, noteNumber, MPEValue::from7BitInt (1 + r.nextInt (127)));
+
+                // the lookups must agree with a search through all the notes
+                for (auto lookupChannel : { channel, 1 + r.nextInt (16) })
+                {
+                    for (auto lookupNote : { noteNumber, r.nextInt (128) })
+                    {
+                        MPENote expected;
+
+                        for (int k = 0; k < test.getNumPlayingNotes(); ++k)
+                            if (test.getNote (k).midiChannel == lookupChannel && test.getNote (k).initialNote == lookupNote)
+                                expected = test.getNote (k);
+
+                        auto found = test.getNote (lookupChannel, lookupNote);
+
+                        allMatch = allMatch && found.isValid() == expected.isValid()
+                                            && (! found.isValid() || found == expected);
+                    }
+                }
+            }
+
+            expect (allMatch);
+            expect (test.getNumPlayingNotes() > 0);
+
+            auto snapshot = test.getPlayingNotesSnapshot();
+            expectEquals (snapshot.size(), test.getNumPlayingNotes());
+
+            for (int i = 0; i < snapshot.size(); ++i)
+                expect (snapshot.getReference (i) == test.getNote (i));
+
+            test.releaseAllNotes();
+            expectEquals (test.getPlayingNotesSnapshot().size(), 0);
+        }
+
+        beginTest ("Reading snapshots on another thread");
+        {
+            MPEInstrument test;
+            test.enableLegacyMode();
+
+            struct SnapshotReader  : public Thread
+            {
+                SnapshotReader (MPEInstrument& i) : Thread ("MPE snapshot reader"), instrument (i) {}
+
+                void run() override
+                {
+                    while (! threadShouldExit())
+                    {
+                        auto snapshot = instrument.getPlayingNotesSnapshot();
+                        ++numSnapshots;
+
+                        // every note in a consistent snapshot has the velocity matching its channel
+                        for (auto& note : snapshot)
+                            if (note.noteOnVelocity.as7BitInt() != note.midiChannel)
+                                ++numBadSnapshots;
+                    }
+                }
+
+                MPEInstrument& instrument;
+                std::atomic<int> numSnapshots { 0 }, numBadSnapshots { 0 };
+            };
+
+            SnapshotReader reader (test);
+            reader.startThread();
+
+            auto r = getRandom();
+
+            for (int i = 0; i < 20000 || reader.numSnapshots.load() < 100; ++i)
+            {
+                auto channel = 1 + r.nextInt (16);
+                auto noteNumber = r.nextInt (128);
+
+                if (r.nextBool())
+                    test.noteOn (channel, noteNumber, MPEValue::from7BitInt (channel));
+                else
+                    test.noteOff (channel, noteNumber, MPEValue::from7BitInt (64));
+            }
+
+            reader.signalThreadShouldExit();
+            reader.waitForThreadToExit (-1);
+
+            expect (reader.numSnapshots.load() > 0);
+            expectEquals (reader.numBadSnapshots.load(), 0);
+        }
     }
 
 private:
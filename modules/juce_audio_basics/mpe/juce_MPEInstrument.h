@@ -228,6 +228,17 @@ public:
     */
     MPENote getMostRecentNoteOtherThan (MPENote otherThanThisNote) const noexcept;
 
+    /** Returns a copy of all the MPE notes currently played by the instrument, in the
+        same order as getNote (int index) would return them.
+
+        The other methods which query the notes should only be used by the thread which
+        is feeding the instrument with midi (or from inside the listener callbacks). This
+        one can be called from any thread, e.g. to draw a visualiser, because it reads a
+        copy of the notes that gets published after each change, without taking a lock.
+        It never blocks the thread which is changing the notes.
+    */
+    Array<MPENote> getPlayingNotesSnapshot() const;
+
     //==============================================================================
     /** Derive from this class to be informed about any changes in the expressive
         MIDI notes played by this instrument.
@@ -343,6 +354,15 @@ private:
     uint8 lastTimbreLowerBitReceivedOnChannel[16];
     bool isMemberChannelSustained[16];
 
+    // the index in the notes array of the note playing on each channel and note number, or -1
+    int16 noteIndexForChannelAndNote[16][128];
+    int16 numNotesOnChannel[16];
+
+    // the copy of the notes which is read by getPlayingNotesSnapshot()
+    std::unique_ptr<MPENote[]> notesSnapshot;
+    std::atomic<int> numNotesInSnapshot { 0 };
+    std::atomic<uint32> snapshotSequenceNumber { 0 };
+
     struct LegacyMode
     {
         bool isEnabled;
@@ -379,6 +399,11 @@ private:
     void handleTimbreLSB (int midiChannel, int value) noexcept;
     void handleSustainOrSostenuto (int midiChannel, bool isDown, bool isSostenuto);
 
+    void addNote (const MPENote&);
+    void removeNote (int index);
+    void removeAllNotes() noexcept;
+    void publishNotesSnapshot() noexcept;
+
     const MPENote* getNotePtr (int midiChannel, int midiNoteNumber) const noexcept;
     MPENote* getNotePtr (int midiChannel, int midiNoteNumber) noexcept;
     const MPENote* getNotePtr (int midiChannel, TrackingMode) const noexcept;
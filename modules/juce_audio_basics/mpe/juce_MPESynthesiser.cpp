@@ -23,6 +23,12 @@
 namespace juce
 {
 
+struct MPESynthesiser::RenderThreadPool  : public SynthesiserRenderThreadPool
+{
+    using SynthesiserRenderThreadPool::SynthesiserRenderThreadPool;
+};
+
+//==============================================================================
 MPESynthesiser::MPESynthesiser()
 {
     MPEZoneLayout zoneLayout;
@@ -309,8 +315,38 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 }
 
 //==============================================================================
+void MPESynthesiser::setNumRenderThreads (int numThreads)
+{
+    jassert (numThreads >= 0);
+    numThreads = jmax (0, numThreads);
+
+    if (numThreads == getNumRenderThreads())
+        return;
+
+    std::unique_ptr<RenderThreadPool> newPool (numThreads > 0 ? new RenderThreadPool (numThreads) : nullptr);
+
+    {
+        const ScopedLock sl (voicesLock);
+        std::swap (renderThreadPool, newPool);
+    }
+}
+
+int MPESynthesiser::getNumRenderThreads() const noexcept
+{
+    return renderThreadPool != nullptr ? renderThreadPool->getNumThreads() : 0;
+}
+
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    const ScopedLock sl (voicesLock);
+
+    if (renderThreadPool != nullptr && voices.size() > 1)
+    {
+        renderThreadPool->renderVoices (voices, buffer, startSample, numSamples,
+                                        [] (MPESynthesiserVoice& v) { return v.isActive(); });
+        return;
+    }
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -320,6 +356,15 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSa
 
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    const ScopedLock sl (voicesLock);
+
+    if (renderThreadPool != nullptr && voices.size() > 1)
+    {
+        renderThreadPool->renderVoices (voices, buffer, startSample, numSamples,
+                                        [] (MPESynthesiserVoice& v) { return v.isActive(); });
+        return;
+    }
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -127,6 +127,29 @@ public:
     /** Returns true if note-stealing is enabled. */
     bool isVoiceStealingEnabled() const noexcept                { return shouldStealVoices; }
 
+    //==============================================================================
+    /** Sets the number of extra real-time threads that the synth may use to render
+        its active voices in parallel.
+
+        By default this is 0, and renderNextSubBlock() calls each active voice in turn.
+        When it's greater than 0, the active voices are shared out between the calling
+        thread and a pool of worker threads, which each render into their own scratch
+        buffer before the results are added to the output. The splitting of the audio
+        block around the incoming midi messages is unchanged.
+
+        Your voices must be happy to be rendered on other threads, at the same time as
+        each other. Because they get summed in a different order, the output may differ
+        from the serial version by rounding errors.
+
+        @see Synthesiser::setNumRenderThreads
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of extra render threads that the synth is using.
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept;
+
     //==============================================================================
     /** Tells the synthesiser what the sample rate is for the audio it's being used to render.
 
@@ -306,6 +329,9 @@ private:
     bool shouldStealVoices = false;
     uint32 lastNoteOnCounter = 0;
 
+    struct RenderThreadPool;
+    std::unique_ptr<RenderThreadPool> renderThreadPool;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
 
@@ -23,6 +23,163 @@
 namespace juce
 {
 
+//==============================================================================
+struct BufferingAudioSource::Scheduler::Worker  : public Thread
+{
+    Worker (Scheduler& s, const String& name)  : Thread (name), owner (s) {}
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            int msToWait = 100;
+
+            if (auto* source = owner.startReadingMostUrgentSource (msToWait))
+                owner.finishedReading (source, source->readNextBufferChunk());
+            else
+                wakeUp.wait (msToWait);
+        }
+    }
+
+    Scheduler& owner;
+    WaitableEvent wakeUp;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+BufferingAudioSource::Scheduler::Scheduler (int numThreads, const String& threadName, int threadPriority)
+{
+    jassert (numThreads > 0);
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+        workers.add (new Worker (*this, threadName));
+
+    for (auto* w : workers)
+        w->startThread (threadPriority);
+}
+
+BufferingAudioSource::Scheduler::~Scheduler()
+{
+    // all the sources that use this scheduler must be deleted before it is!
+    jassert (sources.isEmpty());
+
+    for (auto* w : workers)
+    {
+        w->signalThreadShouldExit();
+        w->wakeUp.signal();
+    }
+
+    for (auto* w : workers)
+        w->stopThread (2000);
+}
+
+int BufferingAudioSource::Scheduler::getNumSources() const
+{
+    const ScopedLock sl (lock);
+    return sources.size();
+}
+
+void BufferingAudioSource::Scheduler::wakeUpWorkers()
+{
+    for (auto* w : workers)
+        w->wakeUp.signal();
+}
+
+void BufferingAudioSource::Scheduler::addSource (BufferingAudioSource* s)
+{
+    {
+        const ScopedLock sl (lock);
+        s->nextReadTime = Time::getMillisecondCounter();
+        sources.addIfNotAlreadyThere (s);
+    }
+
+    wakeUpWorkers();
+}
+
+void BufferingAudioSource::Scheduler::removeSource (BufferingAudioSource* s)
+{
+    {
+        const ScopedLock sl (lock);
+        sources.removeFirstMatchingValue (s);
+    }
+
+    // if a thread is still reading ahead for this source, wait for it to finish
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (! s->isBeingRead)
+                return;
+        }
+
+        Thread::sleep (1);
+    }
+}
+
+void BufferingAudioSource::Scheduler::moveToFrontOfQueue (BufferingAudioSource* s)
+{
+    {
+        const ScopedLock sl (lock);
+
+        if (! sources.contains (s))
+            return;
+
+        s->nextReadTime = Time::getMillisecondCounter();
+    }
+
+    wakeUpWorkers();
+}
+
+BufferingAudioSource* BufferingAudioSource::Scheduler::startReadingMostUrgentSource (int& msToWait)
+{
+    const ScopedLock sl (lock);
+
+    auto now = Time::getMillisecondCounter();
+    BufferingAudioSource* mostUrgent = nullptr;
+    double shortestTimeRemaining = 0;
+
+    for (auto* s : sources)
+    {
+        if (s->isBeingRead)
+            continue;
+
+        auto msUntilReady = (int) (s->nextReadTime - now);
+
+        if (msUntilReady > 0)
+        {
+            msToWait = jmin (msToWait, msUntilReady);
+            continue;
+        }
+
+        auto timeRemaining = s->getBufferedTimeRemaining();
+
+        if (mostUrgent == nullptr || timeRemaining < shortestTimeRemaining)
+        {
+            mostUrgent = s;
+            shortestTimeRemaining = timeRemaining;
+        }
+    }
+
+    if (mostUrgent != nullptr)
+        mostUrgent->isBeingRead = true;
+
+    return mostUrgent;
+}
+
+void BufferingAudioSource::Scheduler::finishedReading (BufferingAudioSource* s, bool didRead)
+{
+    const ScopedLock sl (lock);
+
+    s->isBeingRead = false;
+
+    // if the buffer was already full, leave it alone until there's enough space
+    // for it to be worth reading another chunk
+    s->nextReadTime = Time::getMillisecondCounter()
+                        + (didRead ? 0 : (uint32) jlimit (1, 100, roundToInt (512 * 1000.0 / jmax (1.0, s->sampleRate))));
+}
+
+//==============================================================================
 BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
                                             TimeSliceThread& thread,
                                             bool deleteSourceWhenDeleted,
@@ -30,7 +187,25 @@ BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
                                             int numChannels,
                                             bool prefillBufferOnPrepareToPlay)
     : source (s, deleteSourceWhenDeleted),
-      backgroundThread (thread),
+      backgroundThread (&thread),
+      numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
+      numberOfChannels (numChannels),
+      prefillBuffer (prefillBufferOnPrepareToPlay)
+{
+    jassert (source != nullptr);
+
+    jassert (numberOfSamplesToBuffer > 1024); // not much point using this class if you're
+                                              //  not using a larger buffer..
+}
+
+BufferingAudioSource::BufferingAudioSource (PositionableAudioSource* s,
+                                            Scheduler& schedulerToUse,
+                                            bool deleteSourceWhenDeleted,
+                                            int bufferSizeSamples,
+                                            int numChannels,
+                                            bool prefillBufferOnPrepareToPlay)
+    : source (s, deleteSourceWhenDeleted),
+      scheduler (&schedulerToUse),
       numberOfSamplesToBuffer (jmax (1024, bufferSizeSamples)),
       numberOfChannels (numChannels),
       prefillBuffer (prefillBufferOnPrepareToPlay)
@@ -55,7 +230,7 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
          || bufferSizeNeeded != buffer.getNumSamples()
          || ! isPrepared)
     {
-        backgroundThread.removeTimeSliceClient (this);
+        stopBackgroundReading();
 
         isPrepared = true;
         sampleRate = newSampleRate;
@@ -68,11 +243,11 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
         bufferValidStart = 0;
         bufferValidEnd = 0;
 
-        backgroundThread.addTimeSliceClient (this);
+        startBackgroundReading();
 
         do
         {
-            backgroundThread.moveToFrontOfQueue (this);
+            moveToFrontOfQueue();
             Thread::sleep (5);
         }
         while (prefillBuffer
@@ -83,7 +258,7 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
 void BufferingAudioSource::releaseResources()
 {
     isPrepared = false;
-    backgroundThread.removeTimeSliceClient (this);
+    stopBackgroundReading();
 
     buffer.setSize (numberOfChannels, 0);
 
@@ -105,6 +280,9 @@ void BufferingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info
     auto validStart = (int) (jlimit (start, end, pos) - pos);
     auto validEnd   = (int) (jlimit (start, end, pos + info.numSamples) - pos);
 
+    if (info.numSamples > 0 && (validStart > 0 || validEnd < info.numSamples))
+        ++numUnderruns;
+
     if (validStart == validEnd)
     {
         // total cache miss
@@ -214,7 +392,43 @@ void BufferingAudioSource::setNextReadPosition (int64 newPosition)
     const ScopedLock sl (bufferStartPosLock);
 
     nextPlayPos = newPosition;
-    backgroundThread.moveToFrontOfQueue (this);
+    moveToFrontOfQueue();
+}
+
+double BufferingAudioSource::getBufferedTimeRemaining() const noexcept
+{
+    auto start = bufferValidStart.load();
+    auto end   = bufferValidEnd.load();
+    auto pos   = nextPlayPos.load();
+
+    if (pos < start || pos >= end || sampleRate <= 0)
+        return 0;
+
+    return (double) (end - pos) / sampleRate;
+}
+
+void BufferingAudioSource::startBackgroundReading()
+{
+    if (scheduler != nullptr)
+        scheduler->addSource (this);
+    else
+        backgroundThread->addTimeSliceClient (this);
+}
+
+void BufferingAudioSource::stopBackgroundReading()
+{
+    if (scheduler != nullptr)
+        scheduler->removeSource (this);
+    else
+        backgroundThread->removeTimeSliceClient (this);
+}
+
+void BufferingAudioSource::moveToFrontOfQueue()
+{
+    if (scheduler != nullptr)
+        scheduler->moveToFrontOfQueue (this);
+    else
+        backgroundThread->moveToFrontOfQueue (this);
 }
 
 bool BufferingAudioSource::readNextBufferChunk()
@@ -312,4 +526,111 @@ int BufferingAudioSource::useTimeSlice()
     return readNextBufferChunk() ? 1 : 100;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class BufferingAudioSourceTests  : public UnitTest
+{
+public:
+    BufferingAudioSourceTests()  : UnitTest ("BufferingAudioSource", "Audio") {}
+
+    /** A source whose samples hold their own position, so that it's easy to check. */
+    struct RampSource  : public PositionableAudioSource
+    {
+        void prepareToPlay (int, double) override   {}
+        void releaseResources() override            {}
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
+                for (int i = 0; i < info.numSamples; ++i)
+                    info.buffer->setSample (chan, info.startSample + i, getValueAt (position + i));
+
+            position += info.numSamples;
+        }
+
+        void setNextReadPosition (int64 newPosition) override   { position = newPosition; }
+        int64 getNextReadPosition() const override              { return position; }
+        int64 getTotalLength() const override                   { return 1 << 30; }
+        bool isLooping() const override                         { return false; }
+
+        static float getValueAt (int64 pos)     { return (float) (pos % 1000) / 1000.0f; }
+
+        int64 position = 0;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Reading ahead with a scheduler");
+        {
+            BufferingAudioSource::Scheduler scheduler (3);
+            OwnedArray<BufferingAudioSource> sources;
+
+            for (int i = 0; i < 16; ++i)
+                sources.add (new BufferingAudioSource (new RampSource(), scheduler, true, 32768, 2));
+
+            expectEquals (scheduler.getNumSources(), 0);
+
+            for (auto* s : sources)
+                s->prepareToPlay (512, 44100.0);
+
+            expectEquals (scheduler.getNumSources(), 16);
+            expectEquals (scheduler.getNumThreads(), 3);
+
+            AudioBuffer<float> block (2, 512);
+            auto allSamplesCorrect = true;
+
+            for (int blockNum = 0; blockNum < 100; ++blockNum)
+            {
+                for (auto* s : sources)
+                {
+                    AudioSourceChannelInfo info (&block, 0, block.getNumSamples());
+                    auto startPos = s->getNextReadPosition();
+
+                    expect (s->waitForNextAudioBlockReady (info, 5000));
+                    s->getNextAudioBlock (info);
+
+                    for (int i = 0; i < block.getNumSamples(); ++i)
+                        allSamplesCorrect = allSamplesCorrect && block.getSample (1, i) == RampSource::getValueAt (startPos + i);
+                }
+            }
+
+            expect (allSamplesCorrect);
+
+            for (auto* s : sources)
+            {
+                expectEquals (s->getNumUnderruns(), 0);
+                expectGreaterThan (s->getBufferedTimeRemaining(), 0.0);
+            }
+
+            sources.getFirst()->releaseResources();
+            expectEquals (scheduler.getNumSources(), 15);
+        }
+
+        beginTest ("Counting underruns");
+        {
+            // this thread is never started, so nothing gets read ahead
+            TimeSliceThread thread ("Stopped thread");
+            BufferingAudioSource source (new RampSource(), thread, true, 32768, 2, false);
+            source.prepareToPlay (512, 44100.0);
+
+            AudioBuffer<float> block (2, 512);
+
+            for (int i = 0; i < 3; ++i)
+                source.getNextAudioBlock (AudioSourceChannelInfo (block));
+
+            expectEquals (source.getNumUnderruns(), 3);
+            expectEquals (source.getBufferedTimeRemaining(), 0.0);
+            expectEquals (block.getMagnitude (0, block.getNumSamples()), 0.0f);
+
+            source.resetNumUnderruns();
+            expectEquals (source.getNumUnderruns(), 0);
+        }
+    }
+};
+
+static BufferingAudioSourceTests bufferingAudioSourceTests;
+
+#endif
+
 } // namespace juce
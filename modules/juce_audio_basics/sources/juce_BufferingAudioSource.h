@@ -31,6 +31,11 @@ namespace juce
     a background thread to smooth out playback. You can either create one of these
     directly, or use it indirectly using an AudioTransportSource.
 
+    The reading can either be done by a TimeSliceThread, which gives each of its
+    clients a turn in order, or by a BufferingAudioSource::Scheduler, which always
+    reads ahead for whichever source has the least audio left in its buffer. If
+    you're streaming a lot of sources at once, the Scheduler is the better choice.
+
     @see PositionableAudioSource, AudioTransportSource
 
     @tags{Audio}
@@ -39,6 +44,59 @@ class JUCE_API  BufferingAudioSource  : public PositionableAudioSource,
                                         private TimeSliceClient
 {
 public:
+    //==============================================================================
+    /**
+        A set of background threads that can read ahead for many BufferingAudioSources.
+
+        Rather than visiting its sources in turn, each thread picks the source that has
+        the shortest time left before its buffer runs out, so that a source that's close
+        to running dry doesn't have to wait for lots of others that are already well
+        buffered.
+    */
+    class JUCE_API  Scheduler
+    {
+    public:
+        /** Creates a scheduler and starts its threads.
+
+            @param numThreads       the number of threads that will read ahead at the same time
+            @param threadName       the name to give the threads
+            @param threadPriority   the priority of the threads, as used by Thread::startThread()
+        */
+        Scheduler (int numThreads = 1,
+                   const String& threadName = "Read-ahead thread",
+                   int threadPriority = 5);
+
+        /** Destructor.
+
+            This will stop the threads, so all the BufferingAudioSources that are
+            using this scheduler must have been deleted first.
+        */
+        ~Scheduler();
+
+        /** Returns the number of threads that the scheduler is using. */
+        int getNumThreads() const noexcept          { return workers.size(); }
+
+        /** Returns the number of BufferingAudioSources that are currently being serviced. */
+        int getNumSources() const;
+
+    private:
+        friend class BufferingAudioSource;
+        struct Worker;
+
+        OwnedArray<Worker> workers;
+        CriticalSection lock;
+        Array<BufferingAudioSource*> sources;
+
+        void wakeUpWorkers();
+        void addSource (BufferingAudioSource*);
+        void removeSource (BufferingAudioSource*);
+        void moveToFrontOfQueue (BufferingAudioSource*);
+        BufferingAudioSource* startReadingMostUrgentSource (int& msToWait);
+        void finishedReading (BufferingAudioSource*, bool didRead);
+
+        JUCE_DECLARE_NON_COPYABLE (Scheduler)
+    };
+
     //==============================================================================
     /** Creates a BufferingAudioSource.
 
@@ -61,6 +119,26 @@ public:
                           int numberOfChannels = 2,
                           bool prefillBufferOnPrepareToPlay = true);
 
+    /** Creates a BufferingAudioSource which reads ahead using a Scheduler.
+
+        @param source                       the input source to read from
+        @param scheduler                    the scheduler whose threads will do the read-ahead.
+                                            This object must not be deleted until after any
+                                            BufferingAudioSources that are using it have been deleted!
+        @param deleteSourceWhenDeleted      if true, then the input source object will
+                                            be deleted when this object is deleted
+        @param numberOfSamplesToBuffer      the size of buffer to use for reading ahead
+        @param numberOfChannels             the number of channels that will be played
+        @param prefillBufferOnPrepareToPlay if true, then calling prepareToPlay on this object will
+                                            block until the buffer has been filled
+    */
+    BufferingAudioSource (PositionableAudioSource* source,
+                          Scheduler& scheduler,
+                          bool deleteSourceWhenDeleted,
+                          int numberOfSamplesToBuffer,
+                          int numberOfChannels = 2,
+                          bool prefillBufferOnPrepareToPlay = true);
+
     /** Destructor.
 
         The input source may be deleted depending on whether the deleteSourceWhenDeleted
@@ -97,10 +175,28 @@ public:
     */
     bool waitForNextAudioBlockReady (const AudioSourceChannelInfo& info, const uint32 timeout);
 
+    //==============================================================================
+    /** Returns the number of times that getNextAudioBlock() has been called when
+        the background thread hadn't read far enough ahead to fill the whole block,
+        so that some silence had to be played instead.
+
+        @see resetNumUnderruns
+    */
+    int getNumUnderruns() const noexcept        { return numUnderruns.load(); }
+
+    /** Sets the count returned by getNumUnderruns() back to zero. */
+    void resetNumUnderruns() noexcept           { numUnderruns = 0; }
+
+    /** Returns the length of audio, in seconds, that has been read ahead of the
+        current play position.
+    */
+    double getBufferedTimeRemaining() const noexcept;
+
 private:
     //==============================================================================
     OptionalScopedPointer<PositionableAudioSource> source;
-    TimeSliceThread& backgroundThread;
+    TimeSliceThread* backgroundThread = nullptr;
+    Scheduler* scheduler = nullptr;
     int numberOfSamplesToBuffer, numberOfChannels;
     AudioBuffer<float> buffer;
     CriticalSection bufferStartPosLock;
@@ -108,6 +204,15 @@ private:
     std::atomic<int64> bufferValidStart { 0 }, bufferValidEnd { 0 }, nextPlayPos { 0 };
     double sampleRate = 0;
     bool wasSourceLooping = false, isPrepared = false, prefillBuffer;
+    std::atomic<int> numUnderruns { 0 };
+
+    // these are only used by the Scheduler, while holding its lock
+    bool isBeingRead = false;
+    uint32 nextReadTime = 0;
+
+    void startBackgroundReading();
+    void stopBackgroundReading();
+    void moveToFrontOfQueue();
 
     bool readNextBufferChunk();
     void readBufferSection (int64 start, int length, int bufferOffset);
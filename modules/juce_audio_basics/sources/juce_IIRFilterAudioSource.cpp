@@ -25,12 +25,11 @@ namespace juce
 
 IIRFilterAudioSource::IIRFilterAudioSource (AudioSource* const inputSource,
                                             const bool deleteInputWhenDeleted)
-    : input (inputSource, deleteInputWhenDeleted)
+    : input (inputSource, deleteInputWhenDeleted),
+      filter (new IIRFilterCascade (2, 1)),
+      channels (2)
 {
     jassert (inputSource != nullptr);
-
-    for (int i = 2; --i >= 0;)
-        iirFilters.add (new IIRFilter());
 }
 
 IIRFilterAudioSource::~IIRFilterAudioSource()  {}
@@ -38,14 +37,12 @@ IIRFilterAudioSource::~IIRFilterAudioSource()  {}
 //==============================================================================
 void IIRFilterAudioSource::setCoefficients (const IIRCoefficients& newCoefficients)
 {
-    for (int i = iirFilters.size(); --i >= 0;)
-        iirFilters.getUnchecked(i)->setCoefficients (newCoefficients);
+    filter->setCoefficients (0, newCoefficients);
 }
 
 void IIRFilterAudioSource::makeInactive()
 {
-    for (int i = iirFilters.size(); --i >= 0;)
-        iirFilters.getUnchecked(i)->makeInactive();
+    filter->makeInactive (0);
 }
 
 //==============================================================================
@@ -53,8 +50,7 @@ void IIRFilterAudioSource::prepareToPlay (int samplesPerBlockExpected, double sa
 {
     input->prepareToPlay (samplesPerBlockExpected, sampleRate);
 
-    for (int i = iirFilters.size(); --i >= 0;)
-        iirFilters.getUnchecked(i)->reset();
+    filter->reset();
 }
 
 void IIRFilterAudioSource::releaseResources()
@@ -68,13 +64,18 @@ void IIRFilterAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& buff
 
     const int numChannels = bufferToFill.buffer->getNumChannels();
 
-    while (numChannels > iirFilters.size())
-        iirFilters.add (new IIRFilter (*iirFilters.getUnchecked (0)));
+    if (numChannels > filter->getNumChannels())
+    {
+        std::unique_ptr<IIRFilterCascade> newFilter (new IIRFilterCascade (numChannels, 1));
+        newFilter->setCoefficients (0, filter->getCoefficients (0));
+        filter = std::move (newFilter);
+        channels.malloc (numChannels);
+    }
 
     for (int i = 0; i < numChannels; ++i)
-        iirFilters.getUnchecked(i)
-            ->processSamples (bufferToFill.buffer->getWritePointer (i, bufferToFill.startSample),
-                              bufferToFill.numSamples);
+        channels[i] = bufferToFill.buffer->getWritePointer (i, bufferToFill.startSample);
+
+    filter->processSamples (channels, numChannels, bufferToFill.numSamples);
 }
 
 } // namespace juce
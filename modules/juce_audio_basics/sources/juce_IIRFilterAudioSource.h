@@ -27,6 +27,8 @@ namespace juce
 /**
     An AudioSource that performs an IIR filter on another source.
 
+    All the channels are filtered together by an IIRFilterCascade.
+
     @tags{Audio}
 */
 class JUCE_API  IIRFilterAudioSource  : public AudioSource
@@ -49,7 +51,7 @@ public:
     /** Changes the filter to use the same parameters as the one being passed in. */
     void setCoefficients (const IIRCoefficients& newCoefficients);
 
-    /** Calls IIRFilter::makeInactive() on all the filters being used internally. */
+    /** Makes the filter pass its input through unchanged. */
     void makeInactive();
 
     //==============================================================================
@@ -60,7 +62,8 @@ public:
 private:
     //==============================================================================
     OptionalScopedPointer<AudioSource> input;
-    OwnedArray<IIRFilter> iirFilters;
+    std::unique_ptr<IIRFilterCascade> filter;
+    HeapBlock<float*> channels;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IIRFilterAudioSource)
 };
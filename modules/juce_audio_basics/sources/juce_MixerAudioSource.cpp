@@ -23,6 +23,156 @@
 namespace juce
 {
 
+//==============================================================================
+struct MixerAudioSource::RenderThreadPool
+{
+    RenderThreadPool (int numThreads)
+    {
+        for (int i = 0; i < numThreads; ++i)
+            workers.add (new Worker (*this, i));
+
+        for (auto* w : workers)
+            w->startRealtimeThread (Thread::RealtimeOptions());
+    }
+
+    ~RenderThreadPool()
+    {
+        for (auto* w : workers)
+        {
+            w->signalThreadShouldExit();
+            w->wakeUp.signal();
+        }
+
+        for (auto* w : workers)
+            w->stopThread (2000);
+    }
+
+    int getNumThreads() const noexcept      { return workers.size(); }
+
+    /** Pre-allocates the workers' buffers for blocks of this size. */
+    void prepare (int numSamples)
+    {
+        for (auto* w : workers)
+        {
+            w->mixBuffer.setSize (2, numSamples);
+            w->tempBuffer.setSize (2, numSamples);
+        }
+    }
+
+    /** Fills the buffer with the sum of all the inputs. */
+    void render (const Array<AudioSource*>& inputsToRender, const AudioSourceChannelInfo& info, AudioBuffer<float>& temp)
+    {
+        currentInputs = &inputsToRender;
+        currentInfo = &info;
+        nextInput = 0;
+
+        for (auto* w : workers)
+            w->hasMixedInputs = false;
+
+        jobIsActive = true;
+
+        for (auto* w : workers)
+            w->wakeUp.signal();
+
+        bool hasMixedInputs = false;
+        mixAvailableInputs (*info.buffer, info.startSample, temp, hasMixedInputs);
+        jobIsActive = false;
+
+        // make sure no worker is still rendering before its buffer gets used
+        while (numActiveWorkers.load() > 0)
+            Thread::yield();
+
+        if (! hasMixedInputs)
+            info.clearActiveBufferRegion();
+
+        for (auto* w : workers)
+            if (w->hasMixedInputs)
+                for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
+                    info.buffer->addFrom (chan, info.startSample, w->mixBuffer, chan, 0, info.numSamples);
+    }
+
+private:
+    struct Worker  : public Thread
+    {
+        Worker (RenderThreadPool& p, int index)
+            : Thread ("Mixer render thread " + String (index + 1)), owner (p)
+        {
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wakeUp.wait (-1);
+
+                ++owner.numActiveWorkers;
+
+                if (owner.jobIsActive.load() && ! threadShouldExit())
+                {
+                    // the buffer only gets re-allocated if it's too small for this block
+                    mixBuffer.setSize (jmax (1, owner.currentInfo.load()->buffer->getNumChannels()),
+                                       owner.currentInfo.load()->numSamples, false, false, true);
+
+                    owner.mixAvailableInputs (mixBuffer, 0, tempBuffer, hasMixedInputs);
+                }
+
+                --owner.numActiveWorkers;
+            }
+        }
+
+        RenderThreadPool& owner;
+        WaitableEvent wakeUp;
+        AudioBuffer<float> mixBuffer, tempBuffer;
+        bool hasMixedInputs = false;
+
+        JUCE_DECLARE_NON_COPYABLE (Worker)
+    };
+
+    /** Renders inputs into the destination until there are none left. The first one
+        replaces the destination's contents, and the rest are added to it.
+    */
+    void mixAvailableInputs (AudioBuffer<float>& dest, int destStartSample,
+                             AudioBuffer<float>& temp, bool& hasMixedInputs)
+    {
+        auto& inputsToRender = *currentInputs.load();
+        auto& info = *currentInfo.load();
+
+        for (;;)
+        {
+            auto index = nextInput++;
+
+            if (index >= inputsToRender.size())
+                break;
+
+            auto* input = inputsToRender.getUnchecked (index);
+
+            if (! hasMixedInputs)
+            {
+                input->getNextAudioBlock (AudioSourceChannelInfo (&dest, destStartSample, info.numSamples));
+                hasMixedInputs = true;
+            }
+            else
+            {
+                temp.setSize (jmax (1, info.buffer->getNumChannels()), info.numSamples, false, false, true);
+                input->getNextAudioBlock (AudioSourceChannelInfo (&temp, 0, info.numSamples));
+
+                for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
+                    dest.addFrom (chan, destStartSample, temp, chan, 0, info.numSamples);
+            }
+        }
+    }
+
+    OwnedArray<Worker> workers;
+    std::atomic<const Array<AudioSource*>*> currentInputs { nullptr };
+    std::atomic<const AudioSourceChannelInfo*> currentInfo { nullptr };
+    std::atomic<int> nextInput { 0 };
+    std::atomic<bool> jobIsActive { false };
+    std::atomic<int> numActiveWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (RenderThreadPool)
+};
+
+//==============================================================================
 MixerAudioSource::MixerAudioSource()
    : currentSampleRate (0.0), bufferSizeExpected (0)
 {
@@ -31,9 +181,20 @@ MixerAudioSource::MixerAudioSource()
 MixerAudioSource::~MixerAudioSource()
 {
     removeAllInputs();
+    delete currentInputList.exchange (nullptr);
 }
 
 //==============================================================================
+void MixerAudioSource::publishInputList()
+{
+    std::unique_ptr<InputList> oldList (currentInputList.exchange (new InputList { inputs, renderThreadPool.get() }));
+
+    // The audio thread might still be using the old list (and the sources in it), so
+    // wait until it has moved on before letting the caller release anything.
+    while (oldList != nullptr && inputListInUse.load() == oldList.get())
+        Thread::sleep (1);
+}
+
 void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhenRemoved)
 {
     if (input != nullptr && ! inputs.contains (input))
@@ -54,6 +215,7 @@ void MixerAudioSource::addInputSource (AudioSource* input, const bool deleteWhen
 
         inputsToDelete.setBit (inputs.size(), deleteWhenRemoved);
         inputs.add (input);
+        publishInputList();
     }
 }
 
@@ -75,6 +237,7 @@ void MixerAudioSource::removeInputSource (AudioSource* const input)
 
             inputsToDelete.shiftBits (-1, index);
             inputs.remove (index);
+            publishInputList();
         }
 
         input->releaseResources();
@@ -93,12 +256,41 @@ void MixerAudioSource::removeAllInputs()
                 toDelete.add (inputs.getUnchecked(i));
 
         inputs.clear();
+        publishInputList();
     }
 
     for (int i = toDelete.size(); --i >= 0;)
         toDelete.getUnchecked(i)->releaseResources();
 }
 
+void MixerAudioSource::setNumRenderThreads (int numThreads)
+{
+    jassert (numThreads >= 0);
+    numThreads = jmax (0, numThreads);
+
+    if (numThreads == getNumRenderThreads())
+        return;
+
+    std::unique_ptr<RenderThreadPool> newPool (numThreads > 0 ? new RenderThreadPool (numThreads) : nullptr);
+
+    {
+        const ScopedLock sl (lock);
+
+        if (newPool != nullptr && bufferSizeExpected > 0)
+            newPool->prepare (bufferSizeExpected);
+
+        std::swap (renderThreadPool, newPool);
+        publishInputList();
+    }
+
+    // (the old threads get stopped here, once the audio thread has stopped using them)
+}
+
+int MixerAudioSource::getNumRenderThreads() const noexcept
+{
+    return renderThreadPool != nullptr ? renderThreadPool->getNumThreads() : 0;
+}
+
 void MixerAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
 {
     tempBuffer.setSize (2, samplesPerBlockExpected);
@@ -108,6 +300,9 @@ void MixerAudioSource::prepareToPlay (int samplesPerBlockExpected, double sample
     currentSampleRate = sampleRate;
     bufferSizeExpected = samplesPerBlockExpected;
 
+    if (renderThreadPool != nullptr)
+        renderThreadPool->prepare (samplesPerBlockExpected);
+
     for (int i = inputs.size(); --i >= 0;)
         inputs.getUnchecked(i)->prepareToPlay (samplesPerBlockExpected, sampleRate);
 }
@@ -127,32 +322,190 @@ void MixerAudioSource::releaseResources()
 
 void MixerAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
-    const ScopedLock sl (lock);
+    // Mark the list as being in use, checking that it hasn't been replaced in the
+    // meantime, as the thread that replaced it might not have seen our mark.
+    auto* list = currentInputList.load();
 
-    if (inputs.size() > 0)
+    for (;;)
     {
-        inputs.getUnchecked(0)->getNextAudioBlock (info);
+        inputListInUse = list;
+        auto* latest = currentInputList.load();
+
+        if (latest == list)
+            break;
 
-        if (inputs.size() > 1)
+        list = latest;
+    }
+
+    if (list == nullptr || list->inputs.isEmpty())
+    {
+        info.clearActiveBufferRegion();
+    }
+    else if (list->renderThreadPool != nullptr && list->inputs.size() > 1)
+    {
+        list->renderThreadPool->render (list->inputs, info, tempBuffer);
+    }
+    else
+    {
+        auto& inputsToRender = list->inputs;
+        inputsToRender.getUnchecked(0)->getNextAudioBlock (info);
+
+        if (inputsToRender.size() > 1)
         {
             tempBuffer.setSize (jmax (1, info.buffer->getNumChannels()),
                                 info.buffer->getNumSamples());
 
             AudioSourceChannelInfo info2 (&tempBuffer, 0, info.numSamples);
 
-            for (int i = 1; i < inputs.size(); ++i)
+            for (int i = 1; i < inputsToRender.size(); ++i)
             {
-                inputs.getUnchecked(i)->getNextAudioBlock (info2);
+                inputsToRender.getUnchecked(i)->getNextAudioBlock (info2);
 
                 for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
                     info.buffer->addFrom (chan, info.startSample, tempBuffer, chan, 0, info.numSamples);
             }
         }
     }
-    else
+
+    inputListInUse = nullptr;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MixerAudioSourceTests  : public UnitTest
+{
+public:
+    MixerAudioSourceTests()  : UnitTest ("MixerAudioSource", "Audio") {}
+
+    /** Fills its output with a constant, and flags any block it's asked for after being released. */
+    struct ConstantSource  : public AudioSource
     {
-        info.clearActiveBufferRegion();
+        ConstantSource (float v, std::atomic<int>& errors)  : value (v), numErrors (errors) {}
+
+        void prepareToPlay (int, double) override   { isReleased = false; }
+        void releaseResources() override            { isReleased = true; }
+
+        void getNextAudioBlock (const AudioSourceChannelInfo& info) override
+        {
+            if (isReleased)
+                ++numErrors;
+
+            for (int chan = 0; chan < info.buffer->getNumChannels(); ++chan)
+                FloatVectorOperations::fill (info.buffer->getWritePointer (chan, info.startSample), value, info.numSamples);
+        }
+
+        const float value;
+        std::atomic<int>& numErrors;
+        std::atomic<bool> isReleased { true };
+    };
+
+    void checkMix (MixerAudioSource& mixer, float expected)
+    {
+        AudioBuffer<float> buffer (2, 600);
+        buffer.clear();
+        mixer.getNextAudioBlock (AudioSourceChannelInfo (&buffer, 50, 512));
+
+        expectEquals (buffer.getSample (0, 49), 0.0f);
+        expectEquals (buffer.getSample (1, 562), 0.0f);
+        for (int chan = 0; chan < 2; ++chan)
+        {
+            auto range = buffer.findMinMax (chan, 50, 512);
+            expect (range.getStart() == expected && range.getEnd() == expected);
+        }
     }
-}
+
+    void runTest() override
+    {
+        std::atomic<int> numErrors { 0 };
+
+        beginTest ("Mixing inputs in parallel");
+        {
+            MixerAudioSource mixer;
+            mixer.prepareToPlay (512, 44100.0);
+
+            checkMix (mixer, 0.0f);
+
+            for (int i = 1; i <= 10; ++i)
+                mixer.addInputSource (new ConstantSource ((float) i, numErrors), true);
+
+            checkMix (mixer, 55.0f);
+
+            for (int numThreads : { 1, 3, 0, 2 })
+            {
+                mixer.setNumRenderThreads (numThreads);
+                expectEquals (mixer.getNumRenderThreads(), numThreads);
+
+                for (int i = 0; i < 20; ++i)
+                    checkMix (mixer, 55.0f);
+            }
+
+            mixer.releaseResources();
+        }
+
+        beginTest ("Adding and removing inputs while playing");
+        {
+            MixerAudioSource mixer;
+            mixer.setNumRenderThreads (2);
+            mixer.prepareToPlay (512, 44100.0);
+
+            std::atomic<bool> shouldStop { false };
+            std::atomic<int> numBlocks { 0 };
+
+            struct AudioThread  : public Thread
+            {
+                AudioThread (MixerAudioSource& m, std::atomic<bool>& stop, std::atomic<int>& blocks)
+                    : Thread ("Mixer test"), mixer (m), shouldStop (stop), numBlocks (blocks) {}
+
+                void run() override
+                {
+                    AudioBuffer<float> buffer (2, 256);
+
+                    while (! shouldStop)
+                    {
+                        mixer.getNextAudioBlock (AudioSourceChannelInfo (buffer));
+                        ++numBlocks;
+                    }
+                }
+
+                MixerAudioSource& mixer;
+                std::atomic<bool>& shouldStop;
+                std::atomic<int>& numBlocks;
+            };
+
+            AudioThread audioThread (mixer, shouldStop, numBlocks);
+            audioThread.startThread();
+
+            auto random = getRandom();
+            Array<AudioSource*> added;
+
+            for (int i = 0; i < 300; ++i)
+            {
+                if (added.isEmpty() || random.nextBool())
+                {
+                    auto* s = new ConstantSource (1.0f, numErrors);
+                    added.add (s);
+                    mixer.addInputSource (s, true);
+                }
+                else
+                {
+                    mixer.removeInputSource (added.removeAndReturn (random.nextInt (added.size())));
+                }
+            }
+
+            shouldStop = true;
+            audioThread.stopThread (5000);
+
+            expectGreaterThan (numBlocks.load(), 0);
+            mixer.removeAllInputs();
+        }
+
+        expectEquals (numErrors.load(), 0);
+    }
+};
+
+static MixerAudioSourceTests mixerAudioSourceTests;
+
+#endif
 
 } // namespace juce
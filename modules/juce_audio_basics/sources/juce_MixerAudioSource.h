@@ -31,6 +31,12 @@ namespace juce
     prepareToPlay() and releaseResources() methods are called before and after adding
     them to the mixer.
 
+    Doing this never blocks the audio thread: the list of inputs that it reads from is
+    replaced atomically, and a source that gets removed is only released and deleted
+    once the audio thread has finished with the list that contained it, which means
+    that the add and remove methods may have to wait for the current audio block to
+    be rendered.
+
     @tags{Audio}
 */
 class JUCE_API  MixerAudioSource  : public AudioSource
@@ -83,16 +89,50 @@ public:
     /** Implementation of the AudioSource method. */
     void getNextAudioBlock (const AudioSourceChannelInfo&) override;
 
+    //==============================================================================
+    /** Sets the number of extra threads that the mixer can use to pull its inputs.
+
+        By default this is 0, and the inputs are rendered one after another on the
+        thread that calls getNextAudioBlock(). If you give it some extra threads, the
+        inputs will be shared out between them and rendered at the same time. Each
+        thread mixes the inputs it renders into its own buffer, and these are then
+        added together.
+
+        Your input sources must be happy to have their getNextAudioBlock() methods
+        called from threads other than the one which is calling the mixer's, and at
+        the same time as each other. Because the inputs get summed in a different
+        order, the output may differ from the serial version by rounding errors.
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of extra render threads that the mixer is using.
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept;
 
 private:
     //==============================================================================
+    struct RenderThreadPool;
+
+    // A snapshot of the inputs for the audio thread to use. These are never
+    // modified once they've been published - any change creates a new one.
+    struct InputList
+    {
+        Array<AudioSource*> inputs;
+        RenderThreadPool* renderThreadPool;
+    };
+
     Array<AudioSource*> inputs;
     BigInteger inputsToDelete;
     CriticalSection lock;
+    std::unique_ptr<RenderThreadPool> renderThreadPool;
+    std::atomic<InputList*> currentInputList { nullptr }, inputListInUse { nullptr };
     AudioBuffer<float> tempBuffer;
     double currentSampleRate;
     int bufferSizeExpected;
 
+    void publishInputList();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MixerAudioSource)
 };
 
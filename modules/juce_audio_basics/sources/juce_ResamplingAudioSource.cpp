@@ -62,6 +62,11 @@ void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double s
     destBuffers.calloc (numChannels);
     createLowPass (ratio);
 
+    if (interpolationMode == InterpolationMode::windowedSinc)
+        sincInterpolator.reset (new WindowedSincInterpolator (numChannels));
+    else
+        sincInterpolator.reset();
+
     flushBuffers();
 }
 
@@ -72,6 +77,9 @@ void ResamplingAudioSource::flushBuffers()
     sampsInBuffer = 0;
     subSampleOffset = 0.0;
     resetFilters();
+
+    if (sincInterpolator != nullptr)
+        sincInterpolator->reset();
 }
 
 void ResamplingAudioSource::releaseResources()
@@ -89,6 +97,12 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
         localRatio = ratio;
     }
 
+    if (sincInterpolator != nullptr)
+    {
+        getNextSincBlock (info, localRatio);
+        return;
+    }
+
     if (lastRatio != localRatio)
     {
         createLowPass (localRatio);
@@ -196,6 +210,47 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     jassert (sampsInBuffer >= 0);
 }
 
+void ResamplingAudioSource::getNextSincBlock (const AudioSourceChannelInfo& info, double localRatio)
+{
+    // In this mode, the buffer holds the input samples that the interpolator hasn't
+    // used yet, starting from its first sample.
+    const int sampsNeeded = (int) std::ceil (info.numSamples * localRatio) + 2;
+
+    if (buffer.getNumSamples() < sampsNeeded)
+        buffer.setSize (buffer.getNumChannels(), sampsNeeded + 32, true, true);
+
+    if (sampsNeeded > sampsInBuffer)
+    {
+        AudioSourceChannelInfo readInfo (&buffer, sampsInBuffer, sampsNeeded - sampsInBuffer);
+        input->getNextAudioBlock (readInfo);
+        sampsInBuffer = sampsNeeded;
+    }
+
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+
+    for (int channel = 0; channel < channelsToProcess; ++channel)
+    {
+        destBuffers[channel] = info.buffer->getWritePointer (channel, info.startSample);
+        srcBuffers[channel] = buffer.getReadPointer (channel);
+    }
+
+    auto numUsed = sincInterpolator->process (localRatio, srcBuffers, destBuffers,
+                                              channelsToProcess, info.numSamples);
+
+    jassert (numUsed <= sampsInBuffer);
+    sampsInBuffer -= numUsed;
+
+    // move the remaining samples to the start of the buffer, ready for the next block
+    if (numUsed > 0 && sampsInBuffer > 0)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            auto* data = buffer.getWritePointer (channel);
+            memmove (data, data + numUsed, (size_t) sampsInBuffer * sizeof (float));
+        }
+    }
+}
+
 void ResamplingAudioSource::createLowPass (const double frequencyRatio)
 {
     const double proportionalRate = (frequencyRatio > 1.0) ? 0.5 / frequencyRatio
@@ -27,7 +27,7 @@ namespace juce
 /**
     A type of AudioSource that takes an input source and changes its sample rate.
 
-    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator
+    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator, WindowedSincInterpolator
 
     @tags{Audio}
 */
@@ -68,6 +68,25 @@ public:
     /** Clears any buffers and filters that the resampler is using. */
     void flushBuffers();
 
+    //==============================================================================
+    /** The algorithms that the resampler can use. */
+    enum class InterpolationMode
+    {
+        linear,         /**< Linear interpolation with an IIR anti-aliasing filter. This is the
+                             default, and is very cheap. */
+        windowedSinc    /**< Uses a WindowedSincInterpolator, which costs a lot more CPU but has
+                             a flat frequency response and far less aliasing. */
+    };
+
+    /** Selects the algorithm that the resampler uses.
+
+        The new mode takes effect the next time prepareToPlay() is called.
+    */
+    void setInterpolationMode (InterpolationMode newMode) noexcept      { interpolationMode = newMode; }
+
+    /** Returns the algorithm that was selected with setInterpolationMode(). */
+    InterpolationMode getInterpolationMode() const noexcept             { return interpolationMode; }
+
     //==============================================================================
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
     void releaseResources() override;
@@ -85,6 +104,10 @@ private:
     const int numChannels;
     HeapBlock<float*> destBuffers;
     HeapBlock<const float*> srcBuffers;
+    InterpolationMode interpolationMode = InterpolationMode::linear;
+    std::unique_ptr<WindowedSincInterpolator> sincInterpolator;
+
+    void getNextSincBlock (const AudioSourceChannelInfo&, double localRatio);
 
     void setFilterCoefficients (double c1, double c2, double c3, double c4, double c5, double c6);
     void createLowPass (double proportionalRate);
@@ -72,6 +72,12 @@ void SynthesiserVoice::renderNextBlock (AudioBuffer<double>& outputBuffer,
     subBuffer.makeCopyOf (tempBuffer, true);
 }
 
+//==============================================================================
+struct Synthesiser::RenderThreadPool  : public SynthesiserRenderThreadPool
+{
+    using SynthesiserRenderThreadPool::SynthesiserRenderThreadPool;
+};
+
 //==============================================================================
 Synthesiser::Synthesiser()
 {
@@ -94,19 +100,116 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    rebuildVoiceLookups();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (lock);
     newVoice->setCurrentPlaybackSampleRate (sampleRate);
-    return voices.add (newVoice);
+    voices.add (newVoice);
+    rebuildVoiceLookups();
+    return newVoice;
 }
 
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
     voices.remove (index);
+    rebuildVoiceLookups();
+}
+
+//==============================================================================
+void Synthesiser::addToNoteList (SynthesiserVoice* voice) noexcept
+{
+    jassert (voice->listedNote < 0);
+    auto note = voice->currentlyPlayingNote;
+
+    if (isPositiveAndBelow (note, numElementsInArray (voicesStartedForNote)))
+    {
+        auto& first = voicesStartedForNote[note];
+
+        voice->listedNote = note;
+        voice->previousVoiceOnNote = nullptr;
+        voice->nextVoiceOnNote = first;
+
+        if (first != nullptr)
+            first->previousVoiceOnNote = voice;
+
+        first = voice;
+    }
+}
+
+void Synthesiser::removeFromNoteList (SynthesiserVoice* voice) noexcept
+{
+    if (voice->listedNote >= 0)
+    {
+        if (voice->previousVoiceOnNote != nullptr)
+            voice->previousVoiceOnNote->nextVoiceOnNote = voice->nextVoiceOnNote;
+        else
+            voicesStartedForNote[voice->listedNote] = voice->nextVoiceOnNote;
+
+        if (voice->nextVoiceOnNote != nullptr)
+            voice->nextVoiceOnNote->previousVoiceOnNote = voice->previousVoiceOnNote;
+
+        voice->previousVoiceOnNote = nullptr;
+        voice->nextVoiceOnNote = nullptr;
+        voice->listedNote = -1;
+    }
+}
+
+void Synthesiser::rebuildVoiceLookups()
+{
+    for (auto& first : voicesStartedForNote)
+        first = nullptr;
+
+    for (auto* voice : voices)
+    {
+        voice->previousVoiceOnNote = nullptr;
+        voice->nextVoiceOnNote = nullptr;
+        voice->listedNote = -1;
+
+        if (voice->isVoiceActive())
+            addToNoteList (voice);
+    }
+
+    freeVoices.ensureStorageAllocated (voices.size());
+    refreshFreeVoices();
+}
+
+void Synthesiser::refreshFreeVoices() const noexcept
+{
+    freeVoices.clearQuick();
+
+    // reversed, so that the first free voice is the one that gets used first
+    for (int i = voices.size(); --i >= 0;)
+        if (! voices.getUnchecked (i)->isVoiceActive())
+            freeVoices.add (voices.getUnchecked (i));
+}
+
+template <typename Callback>
+void Synthesiser::forEachVoicePlayingNote (int midiNoteNumber, Callback&& callback)
+{
+    if (! isPositiveAndBelow (midiNoteNumber, numElementsInArray (voicesStartedForNote)))
+    {
+        for (auto* voice : voices)
+            if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+                callback (voice);
+
+        return;
+    }
+
+    for (auto* voice = voicesStartedForNote[midiNoteNumber]; voice != nullptr;)
+    {
+        auto* next = voice->nextVoiceOnNote;
+
+        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+            callback (voice);
+        else
+            removeFromNoteList (voice); // it has finished since it was started
+
+        voice = next;
+    }
 }
 
 void Synthesiser::clearSounds()
@@ -139,6 +242,29 @@ void Synthesiser::setMinimumRenderingSubdivisionSize (int numSamples, bool shoul
     subBlockSubdivisionIsStrict = shouldBeStrict;
 }
 
+void Synthesiser::setNumRenderThreads (int numThreads)
+{
+    jassert (numThreads >= 0);
+    numThreads = jmax (0, numThreads);
+
+    if (numThreads == getNumRenderThreads())
+        return;
+
+    std::unique_ptr<RenderThreadPool> newPool (numThreads > 0 ? new RenderThreadPool (numThreads) : nullptr);
+
+    {
+        const ScopedLock sl (lock);
+        std::swap (renderThreadPool, newPool);
+    }
+
+    // (the old threads get stopped here, outside the lock)
+}
+
+int Synthesiser::getNumRenderThreads() const noexcept
+{
+    return renderThreadPool != nullptr ? renderThreadPool->getNumThreads() : 0;
+}
+
 //==============================================================================
 void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 {
@@ -231,12 +357,24 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
+    if (renderThreadPool != nullptr && voices.size() > 1)
+    {
+        renderThreadPool->renderVoices (voices, buffer, startSample, numSamples, [] (SynthesiserVoice&) { return true; });
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (renderThreadPool != nullptr && voices.size() > 1)
+    {
+        renderThreadPool->renderVoices (voices, buffer, startSample, numSamples, [] (SynthesiserVoice&) { return true; });
+        return;
+    }
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
@@ -294,9 +432,11 @@ void Synthesiser::noteOn (const int midiChannel,
         {
             // If hitting a note that's still ringing, stop it first (it could be
             // still playing because of the sustain or sostenuto pedal).
-            for (auto* voice : voices)
-                if (voice->getCurrentlyPlayingNote() == midiNoteNumber && voice->isPlayingChannel (midiChannel))
+            forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
+            {
+                if (voice->isPlayingChannel (midiChannel))
                     stopVoice (voice, 1.0f, true);
+            });
 
             startVoice (findFreeVoice (sound, midiChannel, midiNoteNumber, shouldStealNotes),
                         sound, midiChannel, midiNoteNumber, velocity);
@@ -323,6 +463,18 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
         voice->setSostenutoPedalDown (false);
         voice->setSustainPedalDown (sustainPedalsDown[midiChannel]);
 
+        removeFromNoteList (voice);
+        addToNoteList (voice);
+
+        for (int i = freeVoices.size(); --i >= 0;)
+        {
+            if (freeVoices.getUnchecked (i) == voice)
+            {
+                freeVoices.remove (i);
+                break;
+            }
+        }
+
         voice->startNote (midiNoteNumber, velocity, sound,
                           lastPitchWheelValues [midiChannel - 1]);
     }
@@ -332,10 +484,14 @@ void Synthesiser::stopVoice (SynthesiserVoice* voice, float velocity, const bool
 {
     jassert (voice != nullptr);
 
+    auto wasActive = voice->isVoiceActive();
     voice->stopNote (velocity, allowTailOff);
 
     // the subclass MUST call clearCurrentNote() if it's not tailing off! RTFM for stopNote()!
     jassert (allowTailOff || (voice->getCurrentlyPlayingNote() < 0 && voice->getCurrentlyPlayingSound() == nullptr));
+
+    if (wasActive && ! voice->isVoiceActive())
+        freeVoices.add (voice);
 }
 
 void Synthesiser::noteOff (const int midiChannel,
@@ -345,10 +501,9 @@ void Synthesiser::noteOff (const int midiChannel,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
+    forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
     {
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && voice->isPlayingChannel (midiChannel))
+        if (voice->isPlayingChannel (midiChannel))
         {
             if (auto sound = voice->getCurrentlyPlayingSound())
             {
@@ -364,7 +519,7 @@ void Synthesiser::noteOff (const int midiChannel,
                 }
             }
         }
-    }
+    });
 }
 
 void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
@@ -376,6 +531,7 @@ void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
             voice->stopNote (1.0f, allowTailOff);
 
     sustainPedalsDown.clear();
+    refreshFreeVoices();
 }
 
 void Synthesiser::handlePitchWheel (const int midiChannel, const int wheelValue)
@@ -410,10 +566,11 @@ void Synthesiser::handleAftertouch (int midiChannel, int midiNoteNumber, int aft
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber
-              && (midiChannel <= 0 || voice->isPlayingChannel (midiChannel)))
+    forEachVoicePlayingNote (midiNoteNumber, [&] (SynthesiserVoice* voice)
+    {
+        if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
             voice->aftertouchChanged (aftertouchValue);
+    });
 }
 
 void Synthesiser::handleChannelPressure (int midiChannel, int channelPressureValue)
@@ -491,9 +648,22 @@ SynthesiserVoice* Synthesiser::findFreeVoice (SynthesiserSound* soundToPlay,
 {
     const ScopedLock sl (lock);
 
-    for (auto* voice : voices)
-        if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
-            return voice;
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        for (int i = freeVoices.size(); --i >= 0;)
+        {
+            auto* voice = freeVoices.getUnchecked (i);
+
+            if (voice->isVoiceActive())
+                freeVoices.remove (i);
+            else if (voice->canPlaySound (soundToPlay))
+                return voice;
+        }
+
+        // look for any voices that have finished on their own since the list was updated
+        if (attempt == 0)
+            refreshFreeVoices();
+    }
 
     if (stealIfNoneAvailable)
         return findVoiceToSteal (soundToPlay, midiChannel, midiNoteNumber);
@@ -515,27 +685,12 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     SynthesiserVoice* low = nullptr; // Lowest sounding note, might be sustained, but NOT in release phase
     SynthesiserVoice* top = nullptr; // Highest sounding note, might be sustained, but NOT in release phase
 
-    // this is a list of voices we can steal, sorted by how long they've been running
-    Array<SynthesiserVoice*> usableVoices;
-    usableVoices.ensureStorageAllocated (voices.size());
-
     for (auto* voice : voices)
     {
         if (voice->canPlaySound (soundToPlay))
         {
             jassert (voice->isVoiceActive()); // We wouldn't be here otherwise
 
-            usableVoices.add (voice);
-
-            // NB: Using a functor rather than a lambda here due to scare-stories about
-            // compilers generating code containing heap allocations..
-            struct Sorter
-            {
-                bool operator() (const SynthesiserVoice* a, const SynthesiserVoice* b) const noexcept { return a->wasStartedBefore (*b); }
-            };
-
-            std::sort (usableVoices.begin(), usableVoices.end(), Sorter());
-
             if (! voice->isPlayingButReleased()) // Don't protect released notes
             {
                 auto note = voice->getCurrentlyPlayingNote();
@@ -553,24 +708,41 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     if (top == low)
         top = nullptr;
 
-    // The oldest note that's playing with the target pitch is ideal..
-    for (auto* voice : usableVoices)
-        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
-            return voice;
+    // Rather than sorting the voices by how long they've been running, this just keeps
+    // track of the oldest one in each of the categories below, in order of preference
+    SynthesiserVoice* oldestWithSameNote = nullptr;   // The oldest note that's playing with the target pitch is ideal..
+    SynthesiserVoice* oldestReleased = nullptr;       // Oldest voice that has been released (no finger on it and not held by sustain pedal)
+    SynthesiserVoice* oldestWithoutKeyDown = nullptr; // Oldest voice that doesn't have a finger on it
+    SynthesiserVoice* oldestUnprotected = nullptr;    // Oldest voice that isn't protected
 
-    // Oldest voice that has been released (no finger on it and not held by sustain pedal)
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top && voice->isPlayingButReleased())
-            return voice;
+    auto updateOldest = [] (SynthesiserVoice*& oldest, SynthesiserVoice* voice)
+    {
+        if (oldest == nullptr || voice->wasStartedBefore (*oldest))
+            oldest = voice;
+    };
 
-    // Oldest voice that doesn't have a finger on it:
-    for (auto* voice : usableVoices)
-        if (voice != low && voice != top && ! voice->isKeyDown())
-            return voice;
+    for (auto* voice : voices)
+    {
+        if (! voice->canPlaySound (soundToPlay))
+            continue;
+
+        if (voice->getCurrentlyPlayingNote() == midiNoteNumber)
+            updateOldest (oldestWithSameNote, voice);
 
-    // Oldest voice that isn't protected
-    for (auto* voice : usableVoices)
         if (voice != low && voice != top)
+        {
+            if (voice->isPlayingButReleased())
+                updateOldest (oldestReleased, voice);
+
+            if (! voice->isKeyDown())
+                updateOldest (oldestWithoutKeyDown, voice);
+
+            updateOldest (oldestUnprotected, voice);
+        }
+    }
+
+    for (auto* voice : { oldestWithSameNote, oldestReleased, oldestWithoutKeyDown, oldestUnprotected })
+        if (voice != nullptr)
             return voice;
 
     // We've only got "protected" voices now: lowest note takes priority
@@ -583,4 +755,204 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     return low;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct SynthesiserTests  : public UnitTest
+{
+    SynthesiserTests() : UnitTest ("Synthesiser", "Audio") {}
+
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    // A voice rendering a note-dependent ramp that fades out after its note-off
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override      { return true; }
+        void pitchWheelMoved (int) override                 {}
+        void controllerMoved (int, int) override            {}
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            level = velocity;
+            increment = 0.001f * (float) note;
+            phase = 0;
+            fadeOut = 0;
+        }
+
+        void stopNote (float, bool allowTailOff) override
+        {
+            if (allowTailOff)
+                fadeOut = 0.99f;
+            else
+                clearCurrentNote();
+        }
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                phase = std::fmod (phase + increment, 1.0f);
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, level * phase * (float) (channel + 1));
+
+                if (fadeOut > 0 && (level *= fadeOut) < 0.001f)
+                {
+                    clearCurrentNote();
+                    break;
+                }
+            }
+        }
+
+        float level = 0, increment = 0, phase = 0, fadeOut = 0;
+    };
+
+    static void renderSynth (int numThreads, const MidiBuffer& midi, AudioBuffer<float>& output)
+    {
+        Synthesiser synth;
+        synth.addSound (new TestSound());
+
+        for (int i = 0; i < 24; ++i)
+            synth.addVoice (new TestVoice());
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+        synth.setNumRenderThreads (numThreads);
+
+        output.clear();
+        const int blockSize = 512;
+
+        for (int start = 0; start < output.getNumSamples(); start += blockSize)
+        {
+            MidiBuffer blockMidi;
+            blockMidi.addEvents (midi, start, blockSize, -start);
+
+            AudioBuffer<float> block (output.getArrayOfWritePointers(), output.getNumChannels(), start, blockSize);
+            synth.renderNextBlock (block, blockMidi, 0, blockSize);
+        }
+    }
+
+    void runTest() override
+    {
+        beginTest ("Rendering voices in parallel");
+        {
+            auto r = getRandom();
+            MidiBuffer midi;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                auto note = 30 + r.nextInt (60);
+                auto start = r.nextInt (30000);
+
+                midi.addEvent (MidiMessage::noteOn (1, note, 0.1f + 0.5f * r.nextFloat()), start);
+                midi.addEvent (MidiMessage::noteOff (1, note), start + 10 + r.nextInt (3000));
+            }
+
+            AudioBuffer<float> serial (2, 512 * 64), parallel (2, 512 * 64);
+            renderSynth (0, midi, serial);
+            renderSynth (3, midi, parallel);
+
+            auto maxDifference = 0.0f;
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < serial.getNumSamples(); ++i)
+                    maxDifference = jmax (maxDifference, std::abs (serial.getSample (channel, i) - parallel.getSample (channel, i)));
+
+            expect (serial.getMagnitude (0, serial.getNumSamples()) > 0.1f);
+            expectLessThan (maxDifference, 1.0e-4f);
+        }
+
+        beginTest ("Allocating and stealing voices");
+        {
+            Synthesiser synth;
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 4; ++i)
+                synth.addVoice (new TestVoice());
+
+            synth.setCurrentPlaybackSampleRate (44100.0);
+
+            auto findVoicePlaying = [&] (int note) -> SynthesiserVoice*
+            {
+                for (int i = 0; i < synth.getNumVoices(); ++i)
+                    if (synth.getVoice (i)->getCurrentlyPlayingNote() == note)
+                        return synth.getVoice (i);
+
+                return nullptr;
+            };
+
+            auto render = [&] (int numSamples)
+            {
+                AudioBuffer<float> buffer (1, numSamples);
+                buffer.clear();
+                synth.renderNextBlock (buffer, {}, 0, numSamples);
+            };
+
+            for (auto note : { 60, 62, 64, 65 })
+                synth.noteOn (1, note, 0.5f);
+
+            expect (synth.getVoice (0)->getCurrentlyPlayingNote() == 60);
+            expect (synth.getVoice (3)->getCurrentlyPlayingNote() == 65);
+
+            // the oldest voice that isn't the lowest or highest note
+            auto* voice = findVoicePlaying (62);
+            synth.noteOn (1, 67, 0.5f);
+            expect (voice->getCurrentlyPlayingNote() == 67);
+
+            // the oldest released voice is preferred
+            voice = findVoicePlaying (64);
+            synth.noteOff (1, 64, 0.0f, true);
+            synth.noteOn (1, 69, 0.5f);
+            expect (voice->getCurrentlyPlayingNote() == 69);
+
+            // a voice that was stopped immediately is free again
+            voice = findVoicePlaying (60);
+            synth.noteOff (1, 60, 0.0f, false);
+            expect (findVoicePlaying (60) == nullptr);
+            synth.noteOn (1, 71, 0.5f);
+            expect (voice->getCurrentlyPlayingNote() == 71);
+
+            // and so is one that finished its tail-off while rendering
+            voice = findVoicePlaying (65);
+            synth.noteOff (1, 65, 0.0f, true);
+            render (5000);
+            expect (! voice->isVoiceActive());
+            synth.noteOn (1, 72, 0.5f);
+            expect (voice->getCurrentlyPlayingNote() == 72);
+
+            for (auto note : { 67, 69, 71 })
+                expect (findVoicePlaying (note) != nullptr);
+
+            // note-offs must still find voices which were stolen from other notes
+            synth.noteOff (1, 69, 0.0f, false);
+            expect (findVoicePlaying (69) == nullptr);
+
+            synth.allNotesOff (0, false);
+
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+                expect (! synth.getVoice (i)->isVoiceActive());
+        }
+
+        beginTest ("Changing the number of threads");
+        {
+            Synthesiser synth;
+            expectEquals (synth.getNumRenderThreads(), 0);
+            synth.setNumRenderThreads (2);
+            expectEquals (synth.getNumRenderThreads(), 2);
+            synth.setNumRenderThreads (0);
+            expectEquals (synth.getNumRenderThreads(), 0);
+        }
+    }
+};
+
+static SynthesiserTests synthesiserUnitTests;
+
+#endif
+
 } // namespace juce
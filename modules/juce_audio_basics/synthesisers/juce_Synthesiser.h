@@ -272,6 +272,11 @@ private:
     SynthesiserSound::Ptr currentlyPlayingSound;
     bool keyIsDown = false, sustainPedalDown = false, sostenutoPedalDown = false;
 
+    // the links in the Synthesiser's lists of voices that were started for each note
+    SynthesiserVoice* previousVoiceOnNote = nullptr;
+    SynthesiserVoice* nextVoiceOnNote = nullptr;
+    int listedNote = -1;
+
     AudioBuffer<float> tempBuffer;
 
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
@@ -562,6 +567,36 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    //==============================================================================
+    /** Sets the number of extra real-time threads that the synth may use to render
+        its voices in parallel.
+
+        By default this is 0, and renderVoices() calls each voice in turn on the thread
+        which is calling renderNextBlock(). When it's greater than 0, the voices are
+        shared out between the calling thread and a pool of worker threads, which each
+        render into their own scratch buffer before the results are added to the output.
+        The audio block still gets split up around the incoming midi messages in exactly
+        the same way, so this only changes how each sub-block is rendered.
+
+        Your voices must be happy to have their renderNextBlock() methods called from
+        threads other than the one which is calling the synth's renderNextBlock(), and at
+        the same time as other voices are rendering. Because the voices get summed in a
+        different order, the output may differ from the serial version by rounding errors.
+
+        The workers' scratch buffers will be resized on the first block that needs more
+        space, so you may want to render a block of the largest expected size before
+        the audio starts to avoid doing this on the audio thread.
+
+        If you override renderVoices(), this setting will have no effect unless your
+        implementation calls the base class version.
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of extra render threads that the synth is using.
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept;
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -633,6 +668,25 @@ private:
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
 
+    struct RenderThreadPool;
+    std::unique_ptr<RenderThreadPool> renderThreadPool;
+
+    // The voices that have been started for each note, so that note events don't need to
+    // search through all the voices. Voices that have finished are removed lazily.
+    SynthesiserVoice* voicesStartedForNote[128] = {};
+
+    // Voices that are known to be free, with the ones to use first at the end. Voices
+    // that stop by themselves while rendering get picked up by refreshFreeVoices().
+    mutable Array<SynthesiserVoice*> freeVoices;
+
+    void addToNoteList (SynthesiserVoice*) noexcept;
+    void removeFromNoteList (SynthesiserVoice*) noexcept;
+    void rebuildVoiceLookups();
+    void refreshFreeVoices() const noexcept;
+
+    template <typename Callback>
+    void forEachVoicePlayingNote (int midiNoteNumber, Callback&&);
+
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  A set of real-time worker threads that the Synthesiser and MPESynthesiser classes
+    use to render their voices in parallel.
+
+    Each worker renders the voices that it picks up into its own scratch buffer, while
+    the thread calling renderVoices() renders its share straight into the output. Once
+    all the voices have been rendered, the workers' buffers are added to the output.
+*/
+struct SynthesiserRenderThreadPool
+{
+    SynthesiserRenderThreadPool (int numThreads)
+    {
+        for (int i = 0; i < numThreads; ++i)
+            workers.add (new Worker (*this, i));
+
+        for (auto* w : workers)
+            w->startRealtimeThread (Thread::RealtimeOptions());
+    }
+
+    ~SynthesiserRenderThreadPool()
+    {
+        for (auto* w : workers)
+        {
+            w->signalThreadShouldExit();
+            w->wakeUp.signal();
+        }
+
+        for (auto* w : workers)
+            w->stopThread (2000);
+    }
+
+    int getNumThreads() const noexcept      { return workers.size(); }
+
+    /** Calls renderNextBlock() on all the voices for which shouldRender returns true,
+        adding their output to the buffer.
+    */
+    template <typename VoiceType, typename FloatType, typename ShouldRenderFn>
+    void renderVoices (const OwnedArray<VoiceType>& voices, AudioBuffer<FloatType>& output,
+                       int startSample, int numSamples, ShouldRenderFn shouldRender)
+    {
+        VoiceRenderJob<VoiceType, FloatType, ShouldRenderFn> job (voices, output, startSample, numSamples, shouldRender);
+
+        for (auto* w : workers)
+            w->hasRenderedVoices = false;
+
+        run (job);
+
+        for (auto* w : workers)
+        {
+            if (w->hasRenderedVoices)
+            {
+                auto& scratch = w->getScratchBuffer ((FloatType) 0);
+
+                for (int i = 0; i < output.getNumChannels(); ++i)
+                    output.addFrom (i, startSample, scratch, i, 0, numSamples);
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Worker;
+
+    struct Job
+    {
+        virtual ~Job() {}
+
+        /** Called on the rendering thread with a nullptr, and on each worker that
+            wakes up in time. Must only return once there are no voices left to render. */
+        virtual void renderAvailableVoices (Worker*) = 0;
+    };
+
+    /** Runs a job on the calling thread and all the workers, returning once it has finished. */
+    void run (Job& job)
+    {
+        currentJob = &job;
+        jobIsActive = true;
+
+        for (auto* w : workers)
+            w->wakeUp.signal();
+
+        job.renderAvailableVoices (nullptr);
+        jobIsActive = false;
+
+        // make sure no worker is still rendering before its buffer gets used
+        while (numActiveWorkers.load() > 0)
+            Thread::yield();
+    }
+
+    struct Worker  : public Thread
+    {
+        Worker (SynthesiserRenderThreadPool& p, int index)
+            : Thread ("Synth render thread " + String (index + 1)), owner (p)
+        {
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wakeUp.wait (-1);
+
+                ++owner.numActiveWorkers;
+
+                if (owner.jobIsActive.load() && ! threadShouldExit())
+                    if (auto* job = owner.currentJob.load())
+                        job->renderAvailableVoices (this);
+
+                --owner.numActiveWorkers;
+            }
+        }
+
+        AudioBuffer<float>& getScratchBuffer (float) noexcept      { return floatScratch; }
+        AudioBuffer<double>& getScratchBuffer (double) noexcept    { return doubleScratch; }
+
+        SynthesiserRenderThreadPool& owner;
+        WaitableEvent wakeUp;
+        AudioBuffer<float> floatScratch;
+        AudioBuffer<double> doubleScratch;
+        bool hasRenderedVoices = false;
+
+        JUCE_DECLARE_NON_COPYABLE (Worker)
+    };
+
+    template <typename VoiceType, typename FloatType, typename ShouldRenderFn>
+    struct VoiceRenderJob  : public Job
+    {
+        VoiceRenderJob (const OwnedArray<VoiceType>& v, AudioBuffer<FloatType>& o, int start, int num, ShouldRenderFn& fn)
+            : voices (v), output (o), startSample (start), numSamples (num), shouldRender (fn)
+        {
+        }
+
+        void renderAvailableVoices (Worker* worker) override
+        {
+            AudioBuffer<FloatType>* dest = nullptr;
+            auto destStartSample = 0;
+
+            for (;;)
+            {
+                auto index = nextVoice++;
+
+                if (index >= voices.size())
+                    break;
+
+                auto* voice = voices.getUnchecked (index);
+
+                if (! shouldRender (*voice))
+                    continue;
+
+                if (dest == nullptr)
+                {
+                    if (worker == nullptr)
+                    {
+                        dest = &output;
+                        destStartSample = startSample;
+                    }
+                    else
+                    {
+                        // the buffer only gets re-allocated if it's too small for this block
+                        dest = &(worker->getScratchBuffer ((FloatType) 0));
+                        dest->setSize (output.getNumChannels(), numSamples, false, false, true);
+                        dest->clear();
+                        worker->hasRenderedVoices = true;
+                    }
+                }
+
+                voice->renderNextBlock (*dest, destStartSample, numSamples);
+            }
+        }
+
+        const OwnedArray<VoiceType>& voices;
+        AudioBuffer<FloatType>& output;
+        const int startSample, numSamples;
+        ShouldRenderFn& shouldRender;
+        std::atomic<int> nextVoice { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE (VoiceRenderJob)
+    };
+
+    OwnedArray<Worker> workers;
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<bool> jobIsActive { false };
+    std::atomic<int> numActiveWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (SynthesiserRenderThreadPool)
+};
+
+} // namespace juce
@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_UNIT_TESTS
+
+class ADSRTests  : public UnitTest
+{
+public:
+    ADSRTests()  : UnitTest ("ADSR", "Audio")  {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        ADSR::Parameters parameters;
+        parameters.attack  = 0.01f;
+        parameters.decay   = 0.02f;
+        parameters.sustain = 0.6f;
+        parameters.release = 0.015f;
+
+        auto createADSR = [&]
+        {
+            ADSR adsr;
+            adsr.setSampleRate (44100.0);
+            adsr.setParameters (parameters);
+            return adsr;
+        };
+
+        beginTest ("Blocks match single samples");
+        {
+            for (int run = 0; run < 20; ++run)
+            {
+                auto blockADSR = createADSR();
+                auto sampleADSR = createADSR();
+
+                blockADSR.noteOn();
+                sampleADSR.noteOn();
+
+                auto noteOffTime = random.nextInt (3000);
+                float block[200];
+
+                for (int pos = 0; pos < 5000;)
+                {
+                    if (pos >= noteOffTime && noteOffTime >= 0)
+                    {
+                        blockADSR.noteOff();
+                        sampleADSR.noteOff();
+                        noteOffTime = -1;
+                    }
+
+                    auto num = 1 + random.nextInt (numElementsInArray (block) - 1);
+
+                    if (noteOffTime >= 0)
+                        num = jmin (num, noteOffTime - pos);
+
+                    blockADSR.getNextBlock (block, num);
+
+                    for (int i = 0; i < num; ++i)
+                        expectWithinAbsoluteError (block[i], sampleADSR.getNextSample(), 1.0e-4f);
+
+                    pos += num;
+                }
+
+                expect (! blockADSR.isActive());
+                expect (! sampleADSR.isActive());
+            }
+        }
+
+        beginTest ("Zero-length stages");
+        {
+            parameters = { 0.0f, 0.0f, 0.5f, 0.0f };
+            auto adsr = createADSR();
+            float block[10];
+
+            adsr.noteOn();
+            adsr.getNextBlock (block, 10);
+
+            for (auto value : block)
+                expectEquals (value, 0.5f);
+
+            adsr.noteOff();
+            expect (! adsr.isActive());
+            adsr.getNextBlock (block, 10);
+
+            for (auto value : block)
+                expectEquals (value, 0.0f);
+        }
+
+        beginTest ("Applying to a buffer");
+        {
+            parameters = { 0.001f, 0.002f, 0.5f, 0.001f };
+            auto expected = createADSR();
+            auto floatADSR = createADSR();
+            auto doubleADSR = createADSR();
+
+            AudioBuffer<float> floatBuffer (2, 600);
+            AudioBuffer<double> doubleBuffer (1, 600);
+
+            for (int i = 0; i < 600; ++i)
+            {
+                floatBuffer.setSample (0, i, 1.0f);
+                floatBuffer.setSample (1, i, -2.0f);
+                doubleBuffer.setSample (0, i, 1.0);
+            }
+
+            expected.noteOn();
+            floatADSR.noteOn();
+            doubleADSR.noteOn();
+
+            floatADSR.applyEnvelopeToBuffer (floatBuffer, 0, 300);
+            doubleADSR.applyEnvelopeToBuffer (doubleBuffer, 0, 300);
+
+            floatADSR.noteOff();
+            doubleADSR.noteOff();
+
+            floatADSR.applyEnvelopeToBuffer (floatBuffer, 300, 300);
+            doubleADSR.applyEnvelopeToBuffer (doubleBuffer, 300, 300);
+
+            for (int i = 0; i < 600; ++i)
+            {
+                if (i == 300)
+                    expected.noteOff();
+
+                auto value = expected.getNextSample();
+                expectWithinAbsoluteError (floatBuffer.getSample (0, i), value, 1.0e-4f);
+                expectWithinAbsoluteError (floatBuffer.getSample (1, i), -2.0f * value, 2.0e-4f);
+                expectWithinAbsoluteError (doubleBuffer.getSample (0, i), (double) value, 1.0e-4);
+            }
+        }
+    }
+};
+
+static ADSRTests adsrTests;
+
+#endif
+
+} // namespace juce
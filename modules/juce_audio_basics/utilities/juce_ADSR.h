@@ -29,7 +29,8 @@ namespace juce
 
     To use it, call setSampleRate() with the current sample rate and give it some parameters
     with setParameters() then call getNextSample() to get the envelope value to be applied
-    to each audio sample or applyEnvelopeToBuffer() to apply the envelope to a whole buffer.
+    to each audio sample, getNextBlock() to get a block of values at once, or
+    applyEnvelopeToBuffer() to apply the envelope to a whole buffer.
 */
 class ADSR
 {
@@ -170,10 +171,76 @@ public:
         return envelopeVal;
     }
 
+    /** Fills an array with the next numSamples envelope values.
+
+        This produces the same values as calling getNextSample() numSamples times, but
+        works out each stage of the envelope as a whole ramp rather than one sample at
+        a time, which is much quicker.
+
+        @see getNextSample, applyEnvelopeToBuffer
+    */
+    void getNextBlock (float* destination, int numSamples) noexcept
+    {
+        while (numSamples > 0)
+        {
+            if (currentState == State::idle)
+            {
+                FloatVectorOperations::clear (destination, numSamples);
+                return;
+            }
+
+            if (currentState == State::sustain)
+            {
+                envelopeVal = sustainLevel;
+                FloatVectorOperations::fill (destination, sustainLevel, numSamples);
+                return;
+            }
+
+            auto isRising = currentState == State::attack;
+            auto target = isRising ? 1.0f : (currentState == State::decay ? sustainLevel : 0.0f);
+            auto rate   = isRising ? attackRate : (currentState == State::decay ? -decayRate : -releaseRate);
+
+            // the stage ends on the sample that reaches (or passes) its target
+            auto samplesToTarget = (target - envelopeVal) / rate;
+            auto numUntilTarget = samplesToTarget < (float) numSamples ? jmax (1, (int) std::ceil (samplesToTarget))
+                                                                       : numSamples + 1;
+            auto num = jmin (numSamples, numUntilTarget);
+            auto start = envelopeVal;
+
+            if (isRising)
+            {
+                for (int i = 0; i < num; ++i)
+                    destination[i] = jmin (target, start + rate * (float) (i + 1));
+            }
+            else
+            {
+                for (int i = 0; i < num; ++i)
+                    destination[i] = jmax (target, start + rate * (float) (i + 1));
+            }
+
+            envelopeVal = destination[num - 1];
+
+            if (num == numUntilTarget)
+            {
+                destination[num - 1] = envelopeVal = target;
+
+                if (currentState == State::attack)
+                    currentState = decayRate > 0.0f ? State::decay : State::sustain;
+                else if (currentState == State::decay)
+                    currentState = State::sustain;
+                else
+                    reset();
+            }
+
+            destination += num;
+            numSamples -= num;
+        }
+    }
+
     /** This method will conveniently apply the next numSamples number of envelope values
         to an AudioBuffer.
 
-        @see getNextSample
+        @see getNextSample, getNextBlock
     */
     template<typename FloatType>
     void applyEnvelopeToBuffer (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
@@ -181,20 +248,34 @@ public:
         jassert (startSample + numSamples <= buffer.getNumSamples());
 
         auto numChannels = buffer.getNumChannels();
+        float envelope[256];
 
-        while (--numSamples >= 0)
+        while (numSamples > 0)
         {
-            auto env = getNextSample();
+            auto num = jmin (numSamples, (int) numElementsInArray (envelope));
+            getNextBlock (envelope, num);
 
             for (int i = 0; i < numChannels; ++i)
-                buffer.getWritePointer (i)[startSample] *= env;
+                multiplyByEnvelope (buffer.getWritePointer (i, startSample), envelope, num);
 
-            ++startSample;
+            startSample += num;
+            numSamples -= num;
         }
     }
 
 private:
     //==============================================================================
+    static void multiplyByEnvelope (float* dest, const float* envelope, int num) noexcept
+    {
+        FloatVectorOperations::multiply (dest, envelope, num);
+    }
+
+    static void multiplyByEnvelope (double* dest, const float* envelope, int num) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+            dest[i] *= envelope[i];
+    }
+
     void calculateRates (const Parameters& parameters)
     {
         // need to call setSampleRate() first!
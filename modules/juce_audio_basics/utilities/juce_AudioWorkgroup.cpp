@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_AUDIO_WORKGROUP_TYPES_AVAILABLE
+
+struct AudioWorkgroup::Impl
+{
+    explicit Impl (os_workgroup_t wg) : workgroup (wg)   { os_retain (workgroup); }
+    ~Impl()                                             { os_release (workgroup); }
+
+    os_workgroup_t workgroup;
+};
+
+struct AudioWorkgroup::ScopedJoin::Token
+{
+    os_workgroup_join_token_s token;
+};
+
+AudioWorkgroup AudioWorkgroup::fromNativeHandle (void* nativeWorkgroup)
+{
+    AudioWorkgroup wg;
+
+    if (nativeWorkgroup != nullptr)
+        wg.impl = std::make_shared<Impl> ((os_workgroup_t) nativeWorkgroup);
+
+    return wg;
+}
+
+AudioWorkgroup::ScopedJoin::ScopedJoin (const AudioWorkgroup& workgroupToJoin)
+    : workgroup (workgroupToJoin)
+{
+    if (workgroup.isValid())
+    {
+        if (__builtin_available (macOS 11.0, iOS 14.0, *))
+        {
+            std::unique_ptr<Token> newToken (new Token());
+
+            if (os_workgroup_join (workgroup.impl->workgroup, &newToken->token) == 0)
+                token = std::move (newToken);
+        }
+    }
+}
+
+AudioWorkgroup::ScopedJoin::~ScopedJoin()
+{
+    if (token != nullptr)
+        if (__builtin_available (macOS 11.0, iOS 14.0, *))
+            os_workgroup_leave (workgroup.impl->workgroup, &token->token);
+}
+
+#else
+
+struct AudioWorkgroup::Impl {};
+struct AudioWorkgroup::ScopedJoin::Token {};
+
+AudioWorkgroup AudioWorkgroup::fromNativeHandle (void*)
+{
+    return {};
+}
+
+AudioWorkgroup::ScopedJoin::ScopedJoin (const AudioWorkgroup& workgroupToJoin)
+    : workgroup (workgroupToJoin)
+{
+}
+
+AudioWorkgroup::ScopedJoin::~ScopedJoin() {}
+
+#endif
+
+} // namespace juce
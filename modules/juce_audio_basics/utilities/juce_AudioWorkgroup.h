@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A handle to the group of threads that an audio device uses to render each block.
+
+    On macOS 11 and iOS 14 or later, CoreAudio gives each device an os_workgroup. Any
+    helper threads that do part of the device's work for a block should join it, so
+    that the scheduler knows they're working to the same deadline as the device's I/O
+    thread. See AudioIODevice::getWorkgroup().
+
+    On other platforms, and with older SDKs, workgroups are always invalid and joining
+    them does nothing, so code that uses them doesn't need any special cases.
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioWorkgroup
+{
+public:
+    /** Creates an invalid workgroup. */
+    AudioWorkgroup() = default;
+
+    AudioWorkgroup (const AudioWorkgroup&) = default;
+    AudioWorkgroup& operator= (const AudioWorkgroup&) = default;
+
+    /** Wraps a native workgroup, which on Apple platforms must be an os_workgroup_t.
+        The workgroup is retained, so the caller keeps its own reference.
+    */
+    static AudioWorkgroup fromNativeHandle (void* nativeWorkgroup);
+
+    /** Returns true if this refers to an actual workgroup. */
+    bool isValid() const noexcept              { return impl != nullptr; }
+
+    bool operator== (const AudioWorkgroup& other) const noexcept   { return impl == other.impl; }
+    bool operator!= (const AudioWorkgroup& other) const noexcept   { return impl != other.impl; }
+
+    class ScopedJoin;
+
+private:
+    struct Impl;
+    std::shared_ptr<Impl> impl;
+};
+
+//==============================================================================
+/**
+    Makes the calling thread a member of a workgroup for the lifetime of this object.
+
+    This must be created and destroyed on the same thread. Joining an invalid
+    workgroup does nothing.
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioWorkgroup::ScopedJoin
+{
+public:
+    explicit ScopedJoin (const AudioWorkgroup& workgroupToJoin);
+    ~ScopedJoin();
+
+    /** Returns true if the thread successfully joined the workgroup. */
+    bool isJoined() const noexcept         { return token != nullptr; }
+
+private:
+    struct Token;
+    AudioWorkgroup workgroup;
+    std::unique_ptr<Token> token;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedJoin)
+};
+
+} // namespace juce
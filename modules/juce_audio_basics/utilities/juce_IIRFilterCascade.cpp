@@ -0,0 +1,747 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace IIRFilterCascadeHelpers
+{
+    // A set of four floats, which the filters process in parallel. Each operation is a
+    // separate multiply or add, so that the results are the same as IIRFilter's.
+   #if JUCE_USE_SSE_INTRINSICS
+    struct Vec
+    {
+        __m128 value;
+
+        static Vec load (const float* src) noexcept         { return { _mm_loadu_ps (src) }; }
+        static Vec broadcast (float v) noexcept             { return { _mm_set1_ps (v) }; }
+        void store (float* dest) const noexcept             { _mm_storeu_ps (dest, value); }
+
+        Vec operator+ (Vec other) const noexcept            { return { _mm_add_ps (value, other.value) }; }
+        Vec operator- (Vec other) const noexcept            { return { _mm_sub_ps (value, other.value) }; }
+        Vec operator* (Vec other) const noexcept            { return { _mm_mul_ps (value, other.value) }; }
+
+        static Vec lessOrEqual (Vec a, Vec b) noexcept      { return { _mm_cmple_ps (a.value, b.value) }; }
+        static Vec greaterThan (Vec a, Vec b) noexcept      { return { _mm_cmpgt_ps (a.value, b.value) }; }
+        static Vec bitwiseAnd (Vec a, Vec b) noexcept       { return { _mm_and_ps (a.value, b.value) }; }
+
+        /** Returns a where the mask is set, and b elsewhere. */
+        static Vec select (Vec mask, Vec a, Vec b) noexcept
+        {
+            return { _mm_or_ps (_mm_and_ps (mask.value, a.value), _mm_andnot_ps (mask.value, b.value)) };
+        }
+
+        /** Moves each lane of v up by one, filling the first lane with the last lane of below. */
+        static Vec shiftUp (Vec below, Vec v) noexcept
+        {
+            return { _mm_castsi128_ps (_mm_or_si128 (_mm_slli_si128 (_mm_castps_si128 (v.value), 4),
+                                                     _mm_srli_si128 (_mm_castps_si128 (below.value), 12))) };
+        }
+    };
+   #elif JUCE_USE_ARM_NEON
+    struct Vec
+    {
+        float32x4_t value;
+
+        static Vec load (const float* src) noexcept         { return { vld1q_f32 (src) }; }
+        static Vec broadcast (float v) noexcept             { return { vdupq_n_f32 (v) }; }
+        void store (float* dest) const noexcept             { vst1q_f32 (dest, value); }
+
+        Vec operator+ (Vec other) const noexcept            { return { vaddq_f32 (value, other.value) }; }
+        Vec operator- (Vec other) const noexcept            { return { vsubq_f32 (value, other.value) }; }
+        Vec operator* (Vec other) const noexcept            { return { vmulq_f32 (value, other.value) }; }
+
+        static Vec lessOrEqual (Vec a, Vec b) noexcept      { return { vreinterpretq_f32_u32 (vcleq_f32 (a.value, b.value)) }; }
+        static Vec greaterThan (Vec a, Vec b) noexcept      { return { vreinterpretq_f32_u32 (vcgtq_f32 (a.value, b.value)) }; }
+
+        static Vec bitwiseAnd (Vec a, Vec b) noexcept
+        {
+            return { vreinterpretq_f32_u32 (vandq_u32 (vreinterpretq_u32_f32 (a.value), vreinterpretq_u32_f32 (b.value))) };
+        }
+
+        static Vec select (Vec mask, Vec a, Vec b) noexcept
+        {
+            return { vbslq_f32 (vreinterpretq_u32_f32 (mask.value), a.value, b.value) };
+        }
+
+        static Vec shiftUp (Vec below, Vec v) noexcept      { return { vextq_f32 (below.value, v.value, 3) }; }
+    };
+   #else
+    struct Vec
+    {
+        float value[4];
+
+        static Vec load (const float* src) noexcept         { return { { src[0], src[1], src[2], src[3] } }; }
+        static Vec broadcast (float v) noexcept             { return { { v, v, v, v } }; }
+        void store (float* dest) const noexcept             { for (int i = 0; i < 4; ++i) dest[i] = value[i]; }
+
+        template <typename Fn>
+        static Vec apply (Vec a, Vec b, Fn fn) noexcept
+        {
+            return { { fn (a.value[0], b.value[0]), fn (a.value[1], b.value[1]),
+                       fn (a.value[2], b.value[2]), fn (a.value[3], b.value[3]) } };
+        }
+
+        Vec operator+ (Vec other) const noexcept            { return apply (*this, other, [] (float a, float b) { return a + b; }); }
+        Vec operator- (Vec other) const noexcept            { return apply (*this, other, [] (float a, float b) { return a - b; }); }
+        Vec operator* (Vec other) const noexcept            { return apply (*this, other, [] (float a, float b) { return a * b; }); }
+
+        // (a mask lane is set when it's non-zero)
+        static Vec lessOrEqual (Vec a, Vec b) noexcept      { return apply (a, b, [] (float x, float y) { return x <= y ? 1.0f : 0.0f; }); }
+        static Vec greaterThan (Vec a, Vec b) noexcept      { return apply (a, b, [] (float x, float y) { return x > y ? 1.0f : 0.0f; }); }
+        static Vec bitwiseAnd (Vec a, Vec b) noexcept       { return apply (a, b, [] (float x, float y) { return x != 0 && y != 0 ? 1.0f : 0.0f; }); }
+
+        static Vec select (Vec mask, Vec a, Vec b) noexcept
+        {
+            Vec result;
+
+            for (int i = 0; i < 4; ++i)
+                result.value[i] = mask.value[i] != 0 ? a.value[i] : b.value[i];
+
+            return result;
+        }
+
+        static Vec shiftUp (Vec below, Vec v) noexcept      { return { { below.value[3], v.value[0], v.value[1], v.value[2] } }; }
+    };
+   #endif
+
+    static inline float getLane (Vec v, int lane) noexcept
+    {
+        float lanes[4];
+        v.store (lanes);
+        return lanes[lane];
+    }
+
+    enum { numCoefficients = 5, maxChunkSize = 32, maxParallelStages = 16 };
+
+    //==============================================================================
+    /** Runs an interleaved block of four channels through all the stages, one stage
+        at a time, with each channel's state in its own lane.
+    */
+    static void processInterleaved (float* data, int numSamples, const float* coefficients,
+                                    float* state, int numStages, int stateStride, int numLanesInUse) noexcept
+    {
+        float laneIndices[] = { 0, 1, 2, 3 };
+        auto inUseMask = Vec::greaterThan (Vec::broadcast ((float) numLanesInUse), Vec::load (laneIndices));
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            auto* c = coefficients + stage * numCoefficients;
+            auto b0 = Vec::broadcast (c[0]), b1 = Vec::broadcast (c[1]), b2 = Vec::broadcast (c[2]);
+            auto a1 = Vec::broadcast (c[3]), a2 = Vec::broadcast (c[4]);
+
+            auto* s = state + stage * stateStride;
+            auto oldV1 = Vec::load (s), oldV2 = Vec::load (s + 4);
+            auto v1 = oldV1, v2 = oldV2;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto in = Vec::load (data + i * 4);
+                auto out = b0 * in + v1;
+                out.store (data + i * 4);
+
+                v1 = b1 * in - a1 * out + v2;
+                v2 = b2 * in - a2 * out;
+            }
+
+            // the lanes of any channels that aren't being processed keep their old state
+            Vec::select (inUseMask, v1, oldV1).store (s);
+            Vec::select (inUseMask, v2, oldV2).store (s + 4);
+        }
+    }
+
+    /** Runs a single channel through all the stages at once, with each stage in its own
+        lane. On each step, the stage in lane k works on the sample that arrived k steps
+        earlier, and passes its output to the next lane. The first and last few steps
+        have some lanes without a sample to work on, so those are masked out.
+    */
+    template <int numRegisters>
+    static void processStagesInParallel (float* samples, int numSamples, const float* coefficients,
+                                         float* state, int numStages) noexcept
+    {
+        Vec b0[numRegisters], b1[numRegisters], b2[numRegisters], a1[numRegisters], a2[numRegisters];
+        Vec v1[numRegisters], v2[numRegisters], in[numRegisters], stageIndices[numRegisters];
+
+        for (int r = 0; r < numRegisters; ++r)
+        {
+            float c[numCoefficients][4], indices[4];
+
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                auto stage = r * 4 + lane;
+                indices[lane] = (float) stage;
+
+                // any unused lanes pass their input straight through
+                for (int k = 0; k < numCoefficients; ++k)
+                    c[k][lane] = stage < numStages ? coefficients[stage * numCoefficients + k]
+                                                   : (k == 0 ? 1.0f : 0.0f);
+            }
+
+            b0[r] = Vec::load (c[0]);
+            b1[r] = Vec::load (c[1]);
+            b2[r] = Vec::load (c[2]);
+            a1[r] = Vec::load (c[3]);
+            a2[r] = Vec::load (c[4]);
+            v1[r] = Vec::load (state + r * 8);
+            v2[r] = Vec::load (state + r * 8 + 4);
+            stageIndices[r] = Vec::load (indices);
+            in[r] = Vec::broadcast (0);
+        }
+
+        auto lastStage = numStages - 1;
+        auto lastRegister = lastStage / 4, lastLane = lastStage % 4;
+
+        in[0] = Vec::shiftUp (Vec::broadcast (samples[0]), in[0]);
+
+        for (int step = 0; step < numSamples + lastStage; ++step)
+        {
+            Vec out[numRegisters];
+
+            if (step >= lastStage && step < numSamples)
+            {
+                for (int r = 0; r < numRegisters; ++r)
+                {
+                    out[r] = b0[r] * in[r] + v1[r];
+                    v1[r] = b1[r] * in[r] - a1[r] * out[r] + v2[r];
+                    v2[r] = b2[r] * in[r] - a2[r] * out[r];
+                }
+            }
+            else
+            {
+                // the stage in lane k has a sample to work on if 0 <= step - k < numSamples
+                auto stepIndex = Vec::broadcast ((float) step);
+                auto firstStageIndex = Vec::broadcast ((float) (step - numSamples));
+
+                for (int r = 0; r < numRegisters; ++r)
+                {
+                    auto mask = Vec::bitwiseAnd (Vec::lessOrEqual (stageIndices[r], stepIndex),
+                                                 Vec::greaterThan (stageIndices[r], firstStageIndex));
+
+                    out[r] = b0[r] * in[r] + v1[r];
+                    auto newV1 = b1[r] * in[r] - a1[r] * out[r] + v2[r];
+                    auto newV2 = b2[r] * in[r] - a2[r] * out[r];
+                    v1[r] = Vec::select (mask, newV1, v1[r]);
+                    v2[r] = Vec::select (mask, newV2, v2[r]);
+                }
+            }
+
+            // (the output is written behind the read position, so this can work in place)
+            if (step >= lastStage)
+                samples[step - lastStage] = getLane (out[lastRegister], lastLane);
+
+            auto next = step + 1 < numSamples ? samples[step + 1] : 0.0f;
+            in[0] = Vec::shiftUp (Vec::broadcast (next), out[0]);
+
+            for (int r = 1; r < numRegisters; ++r)
+                in[r] = Vec::shiftUp (out[r - 1], out[r]);
+        }
+
+        for (int r = 0; r < numRegisters; ++r)
+        {
+            v1[r].store (state + r * 8);
+            v2[r].store (state + r * 8 + 4);
+        }
+    }
+}
+
+//==============================================================================
+IIRFilterCascade::IIRFilterCascade (int channels, int stages)
+    : numChannels (jmax (1, channels)),
+      numStages (jmax (1, stages)),
+      numChannelGroups ((numChannels + 3) / 4)
+{
+    jassert (channels > 0 && stages > 0);
+
+    auto numCoefficients = (size_t) (numStages * IIRFilterCascadeHelpers::numCoefficients);
+    currentCoefficients.calloc (numCoefficients);
+    targetCoefficients.calloc (numCoefficients);
+    coefficientSteps.calloc (numCoefficients);
+    state.calloc ((size_t) (numStages * numChannelGroups * 8));
+
+    for (int i = 0; i < numStages; ++i)
+        makeInactive (i);
+}
+
+IIRFilterCascade::~IIRFilterCascade() {}
+
+//==============================================================================
+void IIRFilterCascade::setCoefficients (int stageIndex, const IIRCoefficients& newCoefficients) noexcept
+{
+    jassert (isPositiveAndBelow (stageIndex, numStages));
+
+    if (isPositiveAndBelow (stageIndex, numStages))
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        memcpy (targetCoefficients + stageIndex * IIRFilterCascadeHelpers::numCoefficients,
+                newCoefficients.coefficients, sizeof (newCoefficients.coefficients));
+
+        updateNumActiveStages();
+        startSmoothing();
+    }
+}
+
+void IIRFilterCascade::makeInactive (int stageIndex) noexcept
+{
+    setCoefficients (stageIndex, IIRCoefficients (1.0, 0.0, 0.0, 1.0, 0.0, 0.0));
+}
+
+IIRCoefficients IIRFilterCascade::getCoefficients (int stageIndex) const noexcept
+{
+    jassert (isPositiveAndBelow (stageIndex, numStages));
+
+    if (! isPositiveAndBelow (stageIndex, numStages))
+        return {};
+
+    auto* c = targetCoefficients + stageIndex * IIRFilterCascadeHelpers::numCoefficients;
+    return IIRCoefficients (c[0], c[1], c[2], 1.0, c[3], c[4]);
+}
+
+void IIRFilterCascade::setSmoothingLength (int numSamples) noexcept
+{
+    jassert (numSamples >= 0);
+
+    const SpinLock::ScopedLockType sl (processLock);
+    smoothingLength = jmax (0, numSamples);
+}
+
+void IIRFilterCascade::reset() noexcept
+{
+    const SpinLock::ScopedLockType sl (processLock);
+
+    zeromem (state, sizeof (float) * (size_t) (numStages * numChannelGroups * 8));
+    hasProcessedSamples = false;
+    startSmoothing();
+}
+
+//==============================================================================
+void IIRFilterCascade::updateNumActiveStages() noexcept
+{
+    numActiveStages = 0;
+
+    for (int i = 0; i < numStages; ++i)
+    {
+        auto* c = targetCoefficients + i * IIRFilterCascadeHelpers::numCoefficients;
+
+        if (c[0] != 1.0f || c[1] != 0 || c[2] != 0 || c[3] != 0 || c[4] != 0)
+            ++numActiveStages;
+    }
+}
+
+void IIRFilterCascade::startSmoothing() noexcept
+{
+    auto numCoefficients = numStages * IIRFilterCascadeHelpers::numCoefficients;
+
+    if (smoothingLength == 0 || ! hasProcessedSamples)
+    {
+        memcpy (currentCoefficients, targetCoefficients, sizeof (float) * (size_t) numCoefficients);
+        numSmoothingStepsRemaining = 0;
+        return;
+    }
+
+    // The stable region of a biquad's (a1, a2) coefficients is a triangle, so moving in
+    // a straight line between two stable filters can never pass through an unstable one.
+    numSmoothingStepsRemaining = jmax (1, (smoothingLength + smoothingBlockSize - 1) / smoothingBlockSize);
+    samplesUntilNextStep = 0;
+
+    for (int i = 0; i < numCoefficients; ++i)
+        coefficientSteps[i] = (targetCoefficients[i] - currentCoefficients[i]) / (float) numSmoothingStepsRemaining;
+}
+
+void IIRFilterCascade::advanceSmoothing() noexcept
+{
+    auto numCoefficients = numStages * IIRFilterCascadeHelpers::numCoefficients;
+
+    if (--numSmoothingStepsRemaining > 0)
+    {
+        for (int i = 0; i < numCoefficients; ++i)
+            currentCoefficients[i] += coefficientSteps[i];
+
+        samplesUntilNextStep = smoothingBlockSize;
+    }
+    else
+    {
+        memcpy (currentCoefficients, targetCoefficients, sizeof (float) * (size_t) numCoefficients);
+    }
+}
+
+bool IIRFilterCascade::shouldProcessStagesInParallel() const noexcept
+{
+    return numChannels == 1 && numStages > 1 && numStages <= IIRFilterCascadeHelpers::maxParallelStages;
+}
+
+//==============================================================================
+void IIRFilterCascade::processSamples (float* samples, int numSamples) noexcept
+{
+    float* channels[] = { samples };
+    processSamples (channels, 1, numSamples);
+}
+
+void IIRFilterCascade::processSamples (float* const* channelData, int numChannelsToProcess, int numSamples) noexcept
+{
+    jassert (numChannelsToProcess <= numChannels);
+    numChannelsToProcess = jmin (numChannelsToProcess, numChannels);
+
+    const SpinLock::ScopedLockType sl (processLock);
+
+    hasProcessedSamples = true;
+
+    if (! isActive() || numChannelsToProcess <= 0)
+        return;
+
+    for (int start = 0; start < numSamples;)
+    {
+        auto num = numSamples - start;
+
+        if (numSmoothingStepsRemaining > 0)
+        {
+            if (samplesUntilNextStep == 0)
+                advanceSmoothing();
+
+            if (numSmoothingStepsRemaining > 0)
+            {
+                num = jmin (num, samplesUntilNextStep);
+                samplesUntilNextStep -= num;
+            }
+        }
+
+        processChunk (channelData, numChannelsToProcess, start, num);
+        start += num;
+    }
+
+    snapStateToZero (numChannelsToProcess);
+}
+
+void IIRFilterCascade::processChunk (float* const* channelData, int numChannelsToProcess,
+                                     int startSample, int numSamples) noexcept
+{
+    using namespace IIRFilterCascadeHelpers;
+
+    if (shouldProcessStagesInParallel())
+    {
+        auto* samples = channelData[0] + startSample;
+
+        switch ((numStages + 3) / 4)
+        {
+            case 1:   processStagesInParallel<1> (samples, numSamples, currentCoefficients, state, numStages); break;
+            case 2:   processStagesInParallel<2> (samples, numSamples, currentCoefficients, state, numStages); break;
+            case 3:   processStagesInParallel<3> (samples, numSamples, currentCoefficients, state, numStages); break;
+            default:  processStagesInParallel<4> (samples, numSamples, currentCoefficients, state, numStages); break;
+        }
+
+        return;
+    }
+
+    alignas (16) float interleaved[maxChunkSize * 4];
+
+    for (int start = 0; start < numSamples; start += maxChunkSize)
+    {
+        auto num = jmin ((int) maxChunkSize, numSamples - start);
+
+        for (int group = 0; group * 4 < numChannelsToProcess; ++group)
+        {
+            auto firstChannel = group * 4;
+            auto numLanes = jmin (4, numChannelsToProcess - firstChannel);
+
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                if (lane < numLanes)
+                {
+                    auto* src = channelData[firstChannel + lane] + startSample + start;
+
+                    for (int i = 0; i < num; ++i)
+                        interleaved[i * 4 + lane] = src[i];
+                }
+                else
+                {
+                    for (int i = 0; i < num; ++i)
+                        interleaved[i * 4 + lane] = 0;
+                }
+            }
+
+            processInterleaved (interleaved, num, currentCoefficients, state + group * 8,
+                                numStages, numChannelGroups * 8, numLanes);
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                auto* dest = channelData[firstChannel + lane] + startSample + start;
+
+                for (int i = 0; i < num; ++i)
+                    dest[i] = interleaved[i * 4 + lane];
+            }
+        }
+    }
+}
+
+void IIRFilterCascade::snapStateToZero (int numChannelsToProcess) noexcept
+{
+    if (shouldProcessStagesInParallel())
+    {
+        for (int i = 0; i < ((numStages + 3) / 4) * 8; ++i)
+        {
+            JUCE_SNAP_TO_ZERO (state[i]);
+        }
+
+        return;
+    }
+
+    for (int stage = 0; stage < numStages; ++stage)
+    {
+        for (int channel = 0; channel < numChannelsToProcess; ++channel)
+        {
+            auto* s = state + (stage * numChannelGroups + channel / 4) * 8 + (channel & 3);
+            JUCE_SNAP_TO_ZERO (s[0]);
+            JUCE_SNAP_TO_ZERO (s[4]);
+        }
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class IIRFilterCascadeTests  : public UnitTest
+{
+public:
+    IIRFilterCascadeTests()  : UnitTest ("IIRFilterCascade", "Audio") {}
+
+    static IIRCoefficients makeRandomCoefficients (Random& r)
+    {
+        auto frequency = 50.0 + r.nextDouble() * 15000.0;
+        auto q = 0.3 + r.nextDouble() * 4.0;
+
+        switch (r.nextInt (4))
+        {
+            case 0:   return IIRCoefficients::makeLowPass (44100.0, frequency, q);
+            case 1:   return IIRCoefficients::makeHighPass (44100.0, frequency, q);
+            case 2:   return IIRCoefficients::makeBandPass (44100.0, frequency, q);
+            default:  return IIRCoefficients::makePeakFilter (44100.0, frequency, q, (float) (0.25 + r.nextDouble() * 3.0));
+        }
+    }
+
+    static void fillRandom (Random& r, AudioBuffer<float>& buffer)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, r.nextFloat() * 2.0f - 1.0f);
+    }
+
+    /** A set of chained IIRFilters for each channel, to compare the cascade with. */
+    struct Reference
+    {
+        Reference (int channels, int stages)  : numStages (stages)
+        {
+            for (int i = 0; i < channels * stages; ++i)
+                filters.add (new IIRFilter());
+        }
+
+        void setCoefficients (int stage, const IIRCoefficients& c)
+        {
+            for (int i = stage; i < filters.size(); i += numStages)
+                filters[i]->setCoefficients (c);
+        }
+
+        void process (float* const* channels, int numChannels, int numSamples)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int stage = 0; stage < numStages; ++stage)
+                    filters[ch * numStages + stage]->processSamples (channels[ch], numSamples);
+        }
+
+        int numStages;
+        OwnedArray<IIRFilter> filters;
+    };
+
+    float getMaximumDifference (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        auto maximum = 0.0f;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maximum = jmax (maximum, std::abs (a.getSample (ch, i) - b.getSample (ch, i)));
+
+        return maximum;
+    }
+
+    void checkAgainstReference (int numChannels, int numStages, bool processSomeChannelsAlone)
+    {
+        auto r = getRandom();
+        IIRFilterCascade cascade (numChannels, numStages);
+        Reference reference (numChannels, numStages);
+
+        for (int stage = 0; stage < numStages; ++stage)
+        {
+            if (stage == 1)
+                continue;   // (leave one stage inactive)
+
+            auto c = makeRandomCoefficients (r);
+            cascade.setCoefficients (stage, c);
+            reference.setCoefficients (stage, c);
+        }
+
+        AudioBuffer<float> input (numChannels, 4000), expected (numChannels, 4000);
+        fillRandom (r, input);
+        expected.makeCopyOf (input);
+
+        for (int pos = 0; pos < input.getNumSamples();)
+        {
+            auto num = jmin (1 + r.nextInt (300), input.getNumSamples() - pos);
+            auto numToProcess = processSomeChannelsAlone ? 1 + r.nextInt (numChannels) : numChannels;
+
+            float* channels[16];
+            float* expectedChannels[16];
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                channels[ch] = input.getWritePointer (ch, pos);
+                expectedChannels[ch] = expected.getWritePointer (ch, pos);
+            }
+
+            if (numToProcess < numChannels)
+            {
+                // the channels that were skipped are left untouched, so clear them in both
+                for (int ch = numToProcess; ch < numChannels; ++ch)
+                {
+                    FloatVectorOperations::clear (channels[ch], num);
+                    FloatVectorOperations::clear (expectedChannels[ch], num);
+                }
+            }
+
+            cascade.processSamples (channels, numToProcess, num);
+            reference.process (expectedChannels, numToProcess, num);
+            pos += num;
+        }
+
+        expectLessThan (getMaximumDifference (input, expected), 1.0e-4f);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Matching chained IIRFilters on several channels");
+        {
+            checkAgainstReference (2, 1, false);
+            checkAgainstReference (3, 4, false);
+            checkAgainstReference (6, 5, false);
+            checkAgainstReference (6, 3, true);
+        }
+
+        beginTest ("Matching chained IIRFilters on one channel");
+        {
+            checkAgainstReference (1, 1, false);
+            checkAgainstReference (1, 2, false);
+            checkAgainstReference (1, 7, false);
+            checkAgainstReference (1, 16, false);
+            checkAgainstReference (1, 20, false);
+        }
+
+        beginTest ("Making stages inactive");
+        {
+            IIRFilterCascade cascade (1, 3);
+            expect (! cascade.isActive());
+
+            cascade.setCoefficients (2, IIRCoefficients::makeLowPass (44100.0, 1000.0));
+            expect (cascade.isActive());
+
+            cascade.makeInactive (2);
+            expect (! cascade.isActive());
+
+            AudioBuffer<float> buffer (1, 100), original (1, 100);
+            auto r = getRandom();
+            fillRandom (r, buffer);
+            original.makeCopyOf (buffer);
+
+            cascade.processSamples (buffer.getWritePointer (0), 100);
+            expectEquals (getMaximumDifference (buffer, original), 0.0f);
+        }
+
+        beginTest ("Smoothing coefficient changes");
+        {
+            auto r = getRandom();
+            const int numChannels = 3, smoothingLength = 300;
+            auto start = IIRCoefficients::makeLowPass (44100.0, 8000.0);
+            auto end = IIRCoefficients::makeHighPass (44100.0, 200.0);
+
+            IIRFilterCascade cascade (numChannels, 1);
+            cascade.setSmoothingLength (smoothingLength);
+            cascade.setCoefficients (0, start);
+
+            // nothing has been processed yet, so this ought to have jumped straight there
+            Reference reference (numChannels, 1);
+            reference.setCoefficients (0, start);
+
+            AudioBuffer<float> input (numChannels, 2000), expected (numChannels, 2000);
+            fillRandom (r, input);
+            expected.makeCopyOf (input);
+
+            cascade.processSamples (input.getArrayOfWritePointers(), numChannels, 100);
+            reference.process (expected.getArrayOfWritePointers(), numChannels, 100);
+
+            cascade.setCoefficients (0, end);
+            expect (cascade.getCoefficients (0).coefficients[0] == end.coefficients[0]);
+
+            // the reference moves its coefficients linearly, every smoothingBlockSize samples
+            const int numSteps = (smoothingLength + IIRFilterCascade::smoothingBlockSize - 1) / IIRFilterCascade::smoothingBlockSize;
+
+            for (int step = 1; step <= numSteps + 10; ++step)
+            {
+                auto proportion = jmin (1.0f, step / (float) numSteps);
+                IIRCoefficients c;
+
+                for (int i = 0; i < 5; ++i)
+                    c.coefficients[i] = start.coefficients[i] + proportion * (end.coefficients[i] - start.coefficients[i]);
+
+                reference.setCoefficients (0, c);
+
+                float* expectedChannels[numChannels];
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    expectedChannels[ch] = expected.getWritePointer (ch, 100 + (step - 1) * IIRFilterCascade::smoothingBlockSize);
+
+                reference.process (expectedChannels, numChannels, IIRFilterCascade::smoothingBlockSize);
+            }
+
+            // feed the cascade in irregular blocks, which mustn't affect when the steps happen
+            for (int pos = 100; pos < 100 + (numSteps + 10) * IIRFilterCascade::smoothingBlockSize;)
+            {
+                auto num = jmin (1 + r.nextInt (50), 100 + (numSteps + 10) * IIRFilterCascade::smoothingBlockSize - pos);
+
+                float* channels[numChannels];
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    channels[ch] = input.getWritePointer (ch, pos);
+
+                cascade.processSamples (channels, numChannels, num);
+                pos += num;
+            }
+
+            AudioBuffer<float> processed (input.getArrayOfWritePointers(), numChannels, 100 + (numSteps + 10) * IIRFilterCascade::smoothingBlockSize);
+            AudioBuffer<float> processedExpected (expected.getArrayOfWritePointers(), numChannels, processed.getNumSamples());
+            expectLessThan (getMaximumDifference (processed, processedExpected), 1.0e-4f);
+        }
+    }
+};
+
+static IIRFilterCascadeTests iirFilterCascadeTests;
+
+#endif
+
+} // namespace juce
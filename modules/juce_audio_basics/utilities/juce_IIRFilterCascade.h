@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A chain of biquad IIR filters which processes several channels at once.
+
+    Each stage of the cascade is a biquad defined by an IIRCoefficients object, and
+    every channel goes through all the stages in turn, so this does the same job as
+    chaining a set of IIRFilter objects on each channel, but much faster.
+
+    To make use of SIMD instructions, the channels are packed into the lanes of vector
+    registers, four at a time. When the cascade only has one channel, its stages are
+    packed into the lanes instead, with each stage working on an earlier sample than
+    the one before it, which is a good fit for high-order filters and multi-band EQs.
+
+    Changes to the coefficients can be smoothed. When a smoothing length has been set,
+    each stage's coefficients are moved towards their new values every
+    smoothingBlockSize samples, rather than jumping straight to them.
+
+    @see IIRFilter, IIRCoefficients, IIRFilterAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  IIRFilterCascade
+{
+public:
+    //==============================================================================
+    /** Creates a cascade in which all the stages are inactive, so it passes its
+        input through unchanged until some coefficients are set.
+    */
+    IIRFilterCascade (int numChannels = 2, int numStages = 1);
+
+    /** Destructor. */
+    ~IIRFilterCascade();
+
+    //==============================================================================
+    /** Returns the number of channels that this cascade was created with. */
+    int getNumChannels() const noexcept             { return numChannels; }
+
+    /** Returns the number of biquad stages in this cascade. */
+    int getNumStages() const noexcept               { return numStages; }
+
+    /** The number of samples between each update of the coefficients while they're
+        being smoothed.
+    */
+    enum { smoothingBlockSize = 32 };
+
+    //==============================================================================
+    /** Applies a set of coefficients to one of the stages, for all the channels.
+
+        If a smoothing length has been set, and the cascade has processed some samples
+        since it was created or reset, the stage will move gradually towards the new
+        coefficients.
+    */
+    void setCoefficients (int stageIndex, const IIRCoefficients& newCoefficients) noexcept;
+
+    /** Makes one of the stages pass its input through unchanged. */
+    void makeInactive (int stageIndex) noexcept;
+
+    /** Returns the coefficients that a stage is using, or moving towards if they're
+        being smoothed.
+    */
+    IIRCoefficients getCoefficients (int stageIndex) const noexcept;
+
+    /** Returns true if any of the stages currently alters the signal. */
+    bool isActive() const noexcept                  { return numActiveStages > 0 || numSmoothingStepsRemaining > 0; }
+
+    /** Sets the number of samples over which changes to the coefficients are smoothed.
+        A value of 0 (the default) makes the changes take effect immediately.
+    */
+    void setSmoothingLength (int numSamples) noexcept;
+
+    /** Clears the filters' state, and makes any smoothing jump to the end.
+        Call this when there's a break in the continuity of the input data stream.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Filters a set of channels in place.
+
+        The number of channels must not be greater than getNumChannels(). Any channels
+        above this number are left untouched, and so is their state.
+    */
+    void processSamples (float* const* channelData, int numChannelsToProcess, int numSamples) noexcept;
+
+    /** Filters a single channel in place, using the state of the first channel. */
+    void processSamples (float* samples, int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    const int numChannels, numStages, numChannelGroups;
+    SpinLock processLock;
+
+    // For each stage, the b0, b1, b2, a1, a2 coefficients, normalised by a0 in the same
+    // way as IIRCoefficients.
+    HeapBlock<float> currentCoefficients, targetCoefficients, coefficientSteps;
+
+    // Each stage's v1 and v2 for each group of four channels, or, when the stages are
+    // processed in parallel, for each group of four stages.
+    HeapBlock<float> state;
+
+    int numActiveStages = 0, smoothingLength = 0;
+    int numSmoothingStepsRemaining = 0, samplesUntilNextStep = 0;
+    bool hasProcessedSamples = false;
+
+    bool shouldProcessStagesInParallel() const noexcept;
+    void startSmoothing() noexcept;
+    void advanceSmoothing() noexcept;
+    void updateNumActiveStages() noexcept;
+    void processChunk (float* const*, int numChannelsToProcess, int startSample, int numSamples) noexcept;
+    void snapStateToZero (int numChannelsToProcess) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (IIRFilterCascade)
+};
+
+} // namespace juce
@@ -0,0 +1,411 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace ReverbHelpers
+{
+    /** Updates the low-pass state of a set of combs from their outputs, and works out
+        the values to write back into them. This does exactly the same arithmetic as a
+        single comb would, so that the results don't depend on the instruction set.
+    */
+    static inline void updateCombs (const float* outputs, float* last, float* toWrite, int num,
+                                    float input, float damp, float feedbackLevel) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        jassert (num % 4 == 0);
+
+        auto in    = _mm_set1_ps (input);
+        auto d     = _mm_set1_ps (damp);
+        auto oneMinusD = _mm_set1_ps (1.0f - damp);
+        auto fb    = _mm_set1_ps (feedbackLevel);
+        auto tiny  = _mm_set1_ps (0.1f);
+
+        for (int i = 0; i < num; i += 4)
+        {
+            auto l = _mm_add_ps (_mm_mul_ps (_mm_loadu_ps (outputs + i), oneMinusD),
+                                 _mm_mul_ps (_mm_loadu_ps (last + i), d));
+            l = _mm_sub_ps (_mm_add_ps (l, tiny), tiny);      // (the same as JUCE_UNDENORMALISE)
+            _mm_storeu_ps (last + i, l);
+
+            auto t = _mm_add_ps (in, _mm_mul_ps (l, fb));
+            t = _mm_sub_ps (_mm_add_ps (t, tiny), tiny);
+            _mm_storeu_ps (toWrite + i, t);
+        }
+       #elif JUCE_USE_ARM_NEON
+        jassert (num % 4 == 0);
+
+        auto in    = vdupq_n_f32 (input);
+        auto d     = vdupq_n_f32 (damp);
+        auto oneMinusD = vdupq_n_f32 (1.0f - damp);
+        auto fb    = vdupq_n_f32 (feedbackLevel);
+
+        for (int i = 0; i < num; i += 4)
+        {
+            // (separate multiplies and adds, rather than fused ones, to match the scalar version)
+            auto l = vaddq_f32 (vmulq_f32 (vld1q_f32 (outputs + i), oneMinusD),
+                                vmulq_f32 (vld1q_f32 (last + i), d));
+            vst1q_f32 (last + i, l);
+            vst1q_f32 (toWrite + i, vaddq_f32 (in, vmulq_f32 (l, fb)));
+        }
+       #else
+        for (int i = 0; i < num; ++i)
+        {
+            auto l = (outputs[i] * (1.0f - damp)) + (last[i] * damp);
+            JUCE_UNDENORMALISE (l);
+            last[i] = l;
+
+            auto t = input + (l * feedbackLevel);
+            JUCE_UNDENORMALISE (t);
+            toWrite[i] = t;
+        }
+       #endif
+    }
+}
+
+//==============================================================================
+float Reverb::CombFilterBank::process (float input, float damp, float feedbackLevel) noexcept
+{
+    auto* outputs = buffer + position * numCombs;
+    float toWrite[numCombs];
+
+    ReverbHelpers::updateCombs (outputs, last, toWrite, numCombs, input, damp, feedbackLevel);
+
+    // the outputs are summed in order, so that the result is the same as when
+    // each comb was processed on its own
+    float sum = 0;
+
+    for (int i = 0; i < numCombs; ++i)
+        sum += outputs[i];
+
+    // each new value goes into the frame that will be read when it's due to come out
+    for (int i = 0; i < numCombs; ++i)
+    {
+        auto frame = position + sizes[i];
+
+        if (frame >= numFrames)
+            frame -= numFrames;
+
+        buffer[frame * numCombs + i] = toWrite[i];
+    }
+
+    if (++position == numFrames)
+        position = 0;
+
+    return sum;
+}
+
+//==============================================================================
+void Reverb::processStereo (float* const left, float* const right, const int numSamples) noexcept
+{
+    jassert (left != nullptr && right != nullptr);
+
+    // when nothing is being smoothed, the parameters only need reading once per block
+    const bool isSmoothing = damping.isSmoothing() || feedback.isSmoothing() || dryGain.isSmoothing()
+                               || wetGain1.isSmoothing() || wetGain2.isSmoothing();
+
+    float damp = 0, feedbck = 0, dry = 0, wet1 = 0, wet2 = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (isSmoothing || i == 0)
+        {
+            damp    = damping.getNextValue();
+            feedbck = feedback.getNextValue();
+            dry     = dryGain.getNextValue();
+            wet1    = wetGain1.getNextValue();
+            wet2    = wetGain2.getNextValue();
+        }
+
+        const float input = (left[i] + right[i]) * gain;
+
+        // accumulate the comb filters in parallel
+        float outL = combs[0].process (input, damp, feedbck);
+        float outR = combs[1].process (input, damp, feedbck);
+
+        for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
+        {
+            outL = allPass[0][j].process (outL);
+            outR = allPass[1][j].process (outR);
+        }
+
+        left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
+        right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+    }
+}
+
+void Reverb::processMono (float* const samples, const int numSamples) noexcept
+{
+    jassert (samples != nullptr);
+
+    const bool isSmoothing = damping.isSmoothing() || feedback.isSmoothing()
+                               || dryGain.isSmoothing() || wetGain1.isSmoothing();
+
+    float damp = 0, feedbck = 0, dry = 0, wet1 = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        if (isSmoothing || i == 0)
+        {
+            damp    = damping.getNextValue();
+            feedbck = feedback.getNextValue();
+            dry     = dryGain.getNextValue();
+            wet1    = wetGain1.getNextValue();
+        }
+
+        const float input = samples[i] * gain;
+
+        // accumulate the comb filters in parallel
+        float output = combs[0].process (input, damp, feedbck);
+
+        for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
+            output = allPass[0][j].process (output);
+
+        samples[i] = output * wet1 + samples[i] * dry;
+    }
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ReverbTests  : public UnitTest
+{
+public:
+    ReverbTests()  : UnitTest ("Reverb", "Audio") {}
+
+    /** A straightforward version of the reverb, with one comb filter at a time. */
+    struct ReferenceReverb
+    {
+        struct Comb
+        {
+            void setSize (int size)     { buffer.assign ((size_t) size, 0.0f); index = 0; last = 0; }
+
+            float process (float input, float damp, float feedbackLevel)
+            {
+                const float output = buffer[index];
+                last = (output * (1.0f - damp)) + (last * damp);
+                JUCE_UNDENORMALISE (last);
+
+                float temp = input + (last * feedbackLevel);
+                JUCE_UNDENORMALISE (temp);
+                buffer[index] = temp;
+                index = (index + 1) % buffer.size();
+                return output;
+            }
+
+            std::vector<float> buffer;
+            size_t index = 0;
+            float last = 0;
+        };
+
+        struct AllPass
+        {
+            void setSize (int size)     { buffer.assign ((size_t) size, 0.0f); index = 0; }
+
+            float process (float input)
+            {
+                const float bufferedValue = buffer[index];
+                float temp = input + (bufferedValue * 0.5f);
+                JUCE_UNDENORMALISE (temp);
+                buffer[index] = temp;
+                index = (index + 1) % buffer.size();
+                return bufferedValue - input;
+            }
+
+            std::vector<float> buffer;
+            size_t index = 0;
+        };
+
+        ReferenceReverb (double sampleRate)
+        {
+            static const short combTunings[] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+            static const short allPassTunings[] = { 556, 441, 341, 225 };
+            const int intSampleRate = (int) sampleRate;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                combs[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
+                combs[1][i].setSize ((intSampleRate * (combTunings[i] + 23)) / 44100);
+            }
+
+            for (int i = 0; i < 4; ++i)
+            {
+                allPasses[0][i].setSize ((intSampleRate * allPassTunings[i]) / 44100);
+                allPasses[1][i].setSize ((intSampleRate * (allPassTunings[i] + 23)) / 44100);
+            }
+        }
+
+        void processStereo (float* left, float* right, int numSamples, float gain,
+                            float damp, float feedbackLevel, float dry, float wet1, float wet2)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float input = (left[i] + right[i]) * gain;
+                float outL = 0, outR = 0;
+
+                for (int j = 0; j < 8; ++j)
+                {
+                    outL += combs[0][j].process (input, damp, feedbackLevel);
+                    outR += combs[1][j].process (input, damp, feedbackLevel);
+                }
+
+                for (int j = 0; j < 4; ++j)
+                {
+                    outL = allPasses[0][j].process (outL);
+                    outR = allPasses[1][j].process (outR);
+                }
+
+                left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
+                right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
+            }
+        }
+
+        Comb combs[2][8];
+        AllPass allPasses[2][4];
+    };
+
+    static void fillRandom (Random& random, AudioBuffer<float>& buffer)
+    {
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (chan, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Matching the one-comb-at-a-time version");
+        {
+            for (auto sampleRate : { 44100.0, 48000.0, 96000.0 })
+            {
+                Reverb::Parameters params;
+                params.roomSize = 0.8f;
+                params.damping = 0.3f;
+                params.width = 0.7f;
+
+                // let the smoothed parameters settle before comparing, so that the
+                // reference can use constant values
+                Reverb reverb;
+                reverb.setSampleRate (sampleRate);
+                reverb.setParameters (params);
+
+                AudioBuffer<float> silence (2, (int) sampleRate / 10);
+                silence.clear();
+                reverb.processStereo (silence.getWritePointer (0), silence.getWritePointer (1), silence.getNumSamples());
+                reverb.reset();
+
+                ReferenceReverb reference (sampleRate);
+
+                AudioBuffer<float> input (2, 20000), output, expected;
+                fillRandom (random, input);
+                output.makeCopyOf (input);
+                expected.makeCopyOf (input);
+
+                for (int pos = 0; pos < input.getNumSamples();)
+                {
+                    auto num = jmin (1 + random.nextInt (1000), input.getNumSamples() - pos);
+                    reverb.processStereo (output.getWritePointer (0, pos), output.getWritePointer (1, pos), num);
+                    pos += num;
+                }
+
+                const float wet = params.wetLevel * 3.0f;
+
+                reference.processStereo (expected.getWritePointer (0), expected.getWritePointer (1),
+                                         expected.getNumSamples(), 0.015f,
+                                         params.damping * 0.4f, params.roomSize * 0.28f + 0.7f,
+                                         params.dryLevel * 2.0f,
+                                         0.5f * wet * (1.0f + params.width), 0.5f * wet * (1.0f - params.width));
+
+                auto maximumError = 0.0f;
+
+                for (int chan = 0; chan < 2; ++chan)
+                    for (int i = 0; i < input.getNumSamples(); ++i)
+                        maximumError = jmax (maximumError, std::abs (output.getSample (chan, i) - expected.getSample (chan, i)));
+
+                expectEquals (maximumError, 0.0f);
+            }
+        }
+
+        beginTest ("Mono processing uses the left channel's filters");
+        {
+            Reverb stereo, mono;
+            AudioBuffer<float> impulse (2, 8000);
+            impulse.clear();
+            impulse.setSample (0, 0, 0.5f);
+            impulse.setSample (1, 0, 0.5f);
+
+            AudioBuffer<float> monoImpulse (1, 8000);
+            monoImpulse.copyFrom (0, 0, impulse, 0, 0, 8000);
+            monoImpulse.applyGain (2.0f);
+
+            Reverb::Parameters params;
+            params.width = 1.0f;
+            stereo.setParameters (params);
+            mono.setParameters (params);
+
+            stereo.processStereo (impulse.getWritePointer (0), impulse.getWritePointer (1), 8000);
+            mono.processMono (monoImpulse.getWritePointer (0), 8000);
+
+            // at full width none of the right channel leaks into the left, so after the
+            // dry impulse, both outputs should be the left-hand filters' output
+            expectGreaterThan (monoImpulse.getMagnitude (0, 1000, 7000), 0.0f);
+
+            auto allEqual = true;
+
+            for (int i = 1; i < 8000; ++i)
+                allEqual = allEqual && monoImpulse.getSample (0, i) == impulse.getSample (0, i);
+
+            expect (allEqual);
+        }
+
+        beginTest ("Changing the parameters while processing");
+        {
+            Reverb reverb;
+            reverb.setSampleRate (48000.0);
+
+            AudioBuffer<float> buffer (2, 48000);
+            fillRandom (random, buffer);
+
+            for (int pos = 0; pos < buffer.getNumSamples(); pos += 480)
+            {
+                Reverb::Parameters params;
+                params.roomSize = random.nextFloat();
+                params.damping = random.nextFloat();
+                params.freezeMode = random.nextFloat() < 0.1f ? 1.0f : 0.0f;
+                reverb.setParameters (params);
+
+                reverb.processStereo (buffer.getWritePointer (0, pos), buffer.getWritePointer (1, pos), 480);
+            }
+
+            for (int chan = 0; chan < 2; ++chan)
+                expect (std::isfinite (buffer.getRMSLevel (chan, 0, buffer.getNumSamples())));
+        }
+    }
+};
+
+static ReverbTests reverbTests;
+
+#endif
+
+} // namespace juce
@@ -31,11 +31,14 @@ namespace juce
     Use setSampleRate() to prepare it, and then call processStereo() or processMono() to
     apply the reverb to your audio data.
 
+    The eight comb filters of each channel are run in parallel using SIMD instructions,
+    where available.
+
     @see ReverbAudioSource
 
     @tags{Audio}
 */
-class Reverb
+class JUCE_API  Reverb
 {
 public:
     //==============================================================================
@@ -94,12 +97,17 @@ public:
         const int stereoSpread = 23;
         const int intSampleRate = (int) sampleRate;
 
+        int combSizes[numChannels][numCombs];
+
         for (int i = 0; i < numCombs; ++i)
         {
-            comb[0][i].setSize ((intSampleRate * combTunings[i]) / 44100);
-            comb[1][i].setSize ((intSampleRate * (combTunings[i] + stereoSpread)) / 44100);
+            combSizes[0][i] = (intSampleRate * combTunings[i]) / 44100;
+            combSizes[1][i] = (intSampleRate * (combTunings[i] + stereoSpread)) / 44100;
         }
 
+        for (int j = 0; j < numChannels; ++j)
+            combs[j].setSizes (combSizes[j]);
+
         for (int i = 0; i < numAllPasses; ++i)
         {
             allPass[0][i].setSize ((intSampleRate * allPassTunings[i]) / 44100);
@@ -119,8 +127,7 @@ public:
     {
         for (int j = 0; j < numChannels; ++j)
         {
-            for (int i = 0; i < numCombs; ++i)
-                comb[j][i].clear();
+            combs[j].clear();
 
             for (int i = 0; i < numAllPasses; ++i)
                 allPass[j][i].clear();
@@ -129,64 +136,10 @@ public:
 
     //==============================================================================
     /** Applies the reverb to two stereo channels of audio data. */
-    void processStereo (float* const left, float* const right, const int numSamples) noexcept
-    {
-        jassert (left != nullptr && right != nullptr);
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float input = (left[i] + right[i]) * gain;
-            float outL = 0, outR = 0;
-
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
-
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-            {
-                outL += comb[0][j].process (input, damp, feedbck);
-                outR += comb[1][j].process (input, damp, feedbck);
-            }
-
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-            {
-                outL = allPass[0][j].process (outL);
-                outR = allPass[1][j].process (outR);
-            }
-
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
-            const float wet2 = wetGain2.getNextValue();
-
-            left[i]  = outL * wet1 + outR * wet2 + left[i]  * dry;
-            right[i] = outR * wet1 + outL * wet2 + right[i] * dry;
-        }
-    }
+    void processStereo (float* left, float* right, int numSamples) noexcept;
 
     /** Applies the reverb to a single mono channel of audio data. */
-    void processMono (float* const samples, const int numSamples) noexcept
-    {
-        jassert (samples != nullptr);
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float input = samples[i] * gain;
-            float output = 0;
-
-            const float damp    = damping.getNextValue();
-            const float feedbck = feedback.getNextValue();
-
-            for (int j = 0; j < numCombs; ++j)  // accumulate the comb filters in parallel
-                output += comb[0][j].process (input, damp, feedbck);
-
-            for (int j = 0; j < numAllPasses; ++j)  // run the allpass filters in series
-                output = allPass[0][j].process (output);
-
-            const float dry  = dryGain.getNextValue();
-            const float wet1 = wetGain1.getNextValue();
-
-            samples[i] = output * wet1 + samples[i] * dry;
-        }
-    }
+    void processMono (float* samples, int numSamples) noexcept;
 
 private:
     //==============================================================================
@@ -212,18 +165,39 @@ private:
     }
 
     //==============================================================================
-    class CombFilter
+    enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
+
+    /** The comb filters for one channel, stored so that they can all be processed at once.
+
+        The buffer holds a frame of numCombs values for each sample, and each comb writes
+        its new value into its own lane of the frame that will be read once its delay has
+        passed. This means that the outputs of all the combs can be read from one frame,
+        and the filters' arithmetic done with one set of vector operations.
+    */
+    class CombFilterBank
     {
     public:
-        CombFilter() noexcept {}
+        CombFilterBank() noexcept {}
 
-        void setSize (const int size)
+        void setSizes (const int* newSizes)
         {
-            if (size != bufferSize)
+            auto longest = 0;
+
+            for (int i = 0; i < numCombs; ++i)
+                longest = jmax (longest, newSizes[i]);
+
+            if (longest != numFrames)
             {
-                bufferIndex = 0;
-                buffer.malloc (size);
-                bufferSize = size;
+                buffer.malloc ((size_t) (longest * numCombs));
+                numFrames = longest;
+            }
+
+            position = 0;
+
+            for (int i = 0; i < numCombs; ++i)
+            {
+                jassert (newSizes[i] > 0);
+                sizes[i] = newSizes[i];
             }
 
             clear();
@@ -231,29 +205,22 @@ private:
 
         void clear() noexcept
         {
-            last = 0;
-            buffer.clear ((size_t) bufferSize);
-        }
+            for (auto& l : last)
+                l = 0;
 
-        float process (const float input, const float damp, const float feedbackLevel) noexcept
-        {
-            const float output = buffer[bufferIndex];
-            last = (output * (1.0f - damp)) + (last * damp);
-            JUCE_UNDENORMALISE (last);
-
-            float temp = input + (last * feedbackLevel);
-            JUCE_UNDENORMALISE (temp);
-            buffer[bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
-            return output;
+            buffer.clear ((size_t) (numFrames * numCombs));
         }
 
+        /** Feeds a sample into all the combs, returning the sum of their outputs. */
+        inline float process (float input, float damp, float feedbackLevel) noexcept;
+
     private:
         HeapBlock<float> buffer;
-        int bufferSize = 0, bufferIndex = 0;
-        float last = 0.0f;
+        int numFrames = 0, position = 0;
+        int sizes[numCombs] = {};
+        float last[numCombs] = {};
 
-        JUCE_DECLARE_NON_COPYABLE (CombFilter)
+        JUCE_DECLARE_NON_COPYABLE (CombFilterBank)
     };
 
     //==============================================================================
@@ -285,7 +252,10 @@ private:
             float temp = input + (bufferedValue * 0.5f);
             JUCE_UNDENORMALISE (temp);
             buffer [bufferIndex] = temp;
-            bufferIndex = (bufferIndex + 1) % bufferSize;
+
+            if (++bufferIndex == bufferSize)
+                bufferIndex = 0;
+
             return bufferedValue - input;
         }
 
@@ -297,12 +267,10 @@ private:
     };
 
     //==============================================================================
-    enum { numCombs = 8, numAllPasses = 4, numChannels = 2 };
-
     Parameters parameters;
     float gain;
 
-    CombFilter comb [numChannels][numCombs];
+    CombFilterBank combs [numChannels];
     AllPassFilter allPass [numChannels][numAllPasses];
 
     SmoothedValue<float> damping, feedback, dryGain, wetGain1, wetGain2;
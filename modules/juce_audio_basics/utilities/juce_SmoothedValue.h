@@ -81,6 +81,21 @@ public:
     }
 
     //==============================================================================
+    /** Fills an array with the next numSamples values of the ramp. This gives
+        the same values as calling getNextValue() numSamples times.
+    */
+    void fillNextValues (FloatType* dest, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0);
+
+        auto numSmoothed = processRamp (numSamples, [dest] (const FloatType* values, int offset, int num)
+        {
+            FloatVectorOperations::copy (dest + offset, values, num);
+        });
+
+        FloatVectorOperations::fill (dest + numSmoothed, target, numSamples - numSmoothed);
+    }
+
     /** Applies a smoothed gain to a stream of samples
         S[i] *= gain
         @param samples Pointer to a raw array of samples
@@ -90,15 +105,12 @@ public:
     {
         jassert (numSamples >= 0);
 
-        if (isSmoothing())
+        auto numSmoothed = processRamp (numSamples, [samples] (const FloatType* gains, int offset, int num)
         {
-            for (int i = 0; i < numSamples; ++i)
-                samples[i] *= getNextSmoothedValue();
-        }
-        else
-        {
-            FloatVectorOperations::multiply (samples, target, numSamples);
-        }
+            FloatVectorOperations::multiply (samples + offset, gains, num);
+        });
+
+        FloatVectorOperations::multiply (samples + numSmoothed, target, numSamples - numSmoothed);
     }
 
     /** Computes output as a smoothed gain applied to a stream of samples.
@@ -111,46 +123,66 @@ public:
     {
         jassert (numSamples >= 0);
 
-        if (isSmoothing())
-        {
-            for (int i = 0; i < numSamples; ++i)
-                samplesOut[i] = samplesIn[i] * getNextSmoothedValue();
-        }
-        else
+        auto numSmoothed = processRamp (numSamples, [samplesOut, samplesIn] (const FloatType* gains, int offset, int num)
         {
-            FloatVectorOperations::multiply (samplesOut, samplesIn, target, numSamples);
-        }
+            FloatVectorOperations::multiply (samplesOut + offset, samplesIn + offset, gains, num);
+        });
+
+        FloatVectorOperations::multiply (samplesOut + numSmoothed, samplesIn + numSmoothed, target, numSamples - numSmoothed);
     }
 
     /** Applies a smoothed gain to a buffer */
     void applyGain (AudioBuffer<FloatType>& buffer, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0 && numSamples <= buffer.getNumSamples());
+
+        auto numSmoothed = processRamp (numSamples, [&buffer] (const FloatType* gains, int offset, int num)
+        {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                FloatVectorOperations::multiply (buffer.getWritePointer (channel, offset), gains, num);
+        });
+
+        if (numSmoothed < numSamples)
+            buffer.applyGain (numSmoothed, numSamples - numSmoothed, target);
+    }
+
+    /** Adds a stream of samples to the output, multiplied by a smoothed gain.
+        Sout[i] += Sin[i] * gain
+        @param samplesOut A pointer to a raw array of output samples
+        @param samplesIn  A pointer to a raw array of input samples
+        @param numSamples The length of the array of samples
+    */
+    void addWithGain (FloatType* samplesOut, const FloatType* samplesIn, int numSamples) noexcept
     {
         jassert (numSamples >= 0);
 
-        if (isSmoothing())
+        auto numSmoothed = processRamp (numSamples, [samplesOut, samplesIn] (const FloatType* gains, int offset, int num)
         {
-            if (buffer.getNumChannels() == 1)
-            {
-                auto* samples = buffer.getWritePointer (0);
+            FloatVectorOperations::addWithMultiply (samplesOut + offset, samplesIn + offset, gains, num);
+        });
 
-                for (int i = 0; i < numSamples; ++i)
-                    samples[i] *= getNextSmoothedValue();
-            }
-            else
-            {
-                for (auto i = 0; i < numSamples; ++i)
-                {
-                    auto gain = getNextSmoothedValue();
+        FloatVectorOperations::addWithMultiply (samplesOut + numSmoothed, samplesIn + numSmoothed, target, numSamples - numSmoothed);
+    }
 
-                    for (int channel = 0; channel < buffer.getNumChannels(); channel++)
-                        buffer.setSample (channel, i, buffer.getSample (channel, i) * gain);
-                }
-            }
-        }
-        else
+    /** Adds the channels of one buffer to another, multiplied by a smoothed gain.
+        Only the channels that exist in both buffers are used.
+    */
+    void addWithGain (AudioBuffer<FloatType>& destBuffer, const AudioBuffer<FloatType>& sourceBuffer, int numSamples) noexcept
+    {
+        jassert (numSamples >= 0 && numSamples <= destBuffer.getNumSamples() && numSamples <= sourceBuffer.getNumSamples());
+
+        auto numChannels = jmin (destBuffer.getNumChannels(), sourceBuffer.getNumChannels());
+
+        auto numSmoothed = processRamp (numSamples, [&] (const FloatType* gains, int offset, int num)
         {
-            buffer.applyGain (0, numSamples, target);
-        }
+            for (int channel = 0; channel < numChannels; ++channel)
+                FloatVectorOperations::addWithMultiply (destBuffer.getWritePointer (channel, offset),
+                                                        sourceBuffer.getReadPointer (channel, offset), gains, num);
+        });
+
+        if (numSmoothed < numSamples)
+            for (int channel = 0; channel < numChannels; ++channel)
+                destBuffer.addFrom (channel, numSmoothed, sourceBuffer, channel, numSmoothed, numSamples - numSmoothed, target);
     }
 
 private:
@@ -160,6 +192,30 @@ private:
         return static_cast <SmoothedValueType*> (this)->getNextValue();
     }
 
+    /** Works out the values of the ramp in blocks, passing each one to the callback
+        along with its offset from the start, until the target has been reached or
+        numSamples values have been used. Returns the number of values that were used.
+    */
+    template <typename Callback>
+    int processRamp (int numSamples, Callback&& callback) noexcept
+    {
+        FloatType values[128];
+        int offset = 0;
+
+        while (offset < numSamples && isSmoothing())
+        {
+            auto num = jmin (numSamples - offset, countdown, (int) numElementsInArray (values));
+
+            for (int i = 0; i < num; ++i)
+                values[i] = getNextSmoothedValue();
+
+            callback (values, offset, num);
+            offset += num;
+        }
+
+        return offset;
+    }
+
 protected:
     //==============================================================================
     FloatType currentValue = 0;
@@ -544,6 +600,57 @@ public:
             sv.setTargetValue (2.0f);
             sv.applyGain (testData, numSamples);
             compareData (testData, referenceData);
+
+            testData = getUnitData (numSamples);
+            sv.setCurrentAndTargetValue (1.0f);
+            sv.setTargetValue (2.0f);
+            sv.fillNextValues (testData.getWritePointer (0), numSamples);
+            compareData (testData, referenceData);
+
+            testData = getUnitData (numSamples);
+            destData.clear();
+            sv.setCurrentAndTargetValue (1.0f);
+            sv.setTargetValue (2.0f);
+            sv.addWithGain (destData.getWritePointer (0), testData.getReadPointer (0), 4);
+            sv.addWithGain (destData.getWritePointer (0, 4), testData.getReadPointer (0, 4), numSamples - 4);
+            compareData (destData, referenceData);
+
+            sv.setCurrentAndTargetValue (1.0f);
+            sv.setTargetValue (2.0f);
+            sv.addWithGain (destData, testData, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (destData.getSample (0, i),
+                                           2.0f * referenceData.getSample (0, i),
+                                           2.0e-7f);
+        }
+
+        beginTest ("Block processing of several channels");
+        {
+            SmoothedValueType sv (1.0f);
+            sv.reset (300);
+            sv.setTargetValue (3.0f);
+
+            const auto numSamples = 400;
+            AudioBuffer<float> reference (1, numSamples), buffer (3, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                reference.setSample (0, i, sv.getNextValue());
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                FloatVectorOperations::fill (buffer.getWritePointer (channel), (float) (channel + 1), numSamples);
+
+            sv.setCurrentAndTargetValue (1.0f);
+            sv.setTargetValue (3.0f);
+            sv.applyGain (buffer, numSamples);
+
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (buffer.getSample (channel, i),
+                                               (float) (channel + 1) * reference.getSample (0, i),
+                                               1.0e-6f);
+
+            expect (! sv.isSmoothing());
         }
 
         beginTest ("Skip");
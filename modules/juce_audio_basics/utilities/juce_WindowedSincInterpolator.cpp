@@ -0,0 +1,441 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace WindowedSincHelpers
+{
+    // The number of sub-sample positions for which the kernel is tabulated. The
+    // kernel is linearly interpolated between the two nearest positions.
+    static const int numPhases = 128;
+
+    // The shape of the Kaiser window, which gives about 80dB of stop-band attenuation.
+    static const double kaiserBeta = 8.0;
+
+    static double besselI0 (double x) noexcept
+    {
+        auto sum = 1.0, term = 1.0;
+        auto halfX = x * 0.5;
+
+        for (int k = 1; k < 50 && term > sum * 1.0e-12; ++k)
+        {
+            auto t = halfX / k;
+            term *= t * t;
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    /** Computes two dot products of the history with the kernel row and its deltas,
+        which must all be multiples of 4 samples long.
+    */
+    static inline void dotProducts (const float* samples, const float* kernel, const float* deltas,
+                                    int num, float& kernelSum, float& deltaSum) noexcept
+    {
+        jassert (num % 4 == 0);
+
+       #if JUCE_USE_SSE_INTRINSICS
+        auto k = _mm_setzero_ps(), d = _mm_setzero_ps();
+
+        for (int i = 0; i < num; i += 4)
+        {
+            auto s = _mm_loadu_ps (samples + i);
+            k = _mm_add_ps (k, _mm_mul_ps (s, _mm_loadu_ps (kernel + i)));
+            d = _mm_add_ps (d, _mm_mul_ps (s, _mm_loadu_ps (deltas + i)));
+        }
+
+        // add the four lanes of each sum together
+        auto lo = _mm_unpacklo_ps (k, d), hi = _mm_unpackhi_ps (k, d);
+        auto sums = _mm_add_ps (lo, hi);
+        sums = _mm_add_ps (sums, _mm_movehl_ps (sums, sums));
+
+        float result[4];
+        _mm_storeu_ps (result, sums);
+        kernelSum = result[0];
+        deltaSum  = result[1];
+       #elif JUCE_USE_ARM_NEON
+        auto k = vdupq_n_f32 (0), d = vdupq_n_f32 (0);
+
+        for (int i = 0; i < num; i += 4)
+        {
+            auto s = vld1q_f32 (samples + i);
+            k = vmlaq_f32 (k, s, vld1q_f32 (kernel + i));
+            d = vmlaq_f32 (d, s, vld1q_f32 (deltas + i));
+        }
+
+        auto k2 = vadd_f32 (vget_low_f32 (k), vget_high_f32 (k));
+        auto d2 = vadd_f32 (vget_low_f32 (d), vget_high_f32 (d));
+        kernelSum = vget_lane_f32 (vpadd_f32 (k2, k2), 0);
+        deltaSum  = vget_lane_f32 (vpadd_f32 (d2, d2), 0);
+       #else
+        float k[4] = {}, d[4] = {};
+
+        for (int i = 0; i < num; i += 4)
+        {
+            for (int j = 0; j < 4; ++j)
+            {
+                k[j] += samples[i + j] * kernel[i + j];
+                d[j] += samples[i + j] * deltas[i + j];
+            }
+        }
+
+        kernelSum = (k[0] + k[1]) + (k[2] + k[3]);
+        deltaSum  = (d[0] + d[1]) + (d[2] + d[3]);
+       #endif
+    }
+}
+
+//==============================================================================
+WindowedSincInterpolator::WindowedSincInterpolator (int channels, int zeroCrossings)
+    : numChannels (jmax (1, channels)),
+      numZeroCrossings (jmax (2, zeroCrossings)),
+      numTaps ((2 * numZeroCrossings + 3) & ~3)
+{
+    jassert (channels > 0 && zeroCrossings > 1);
+
+    coefficients.malloc ((size_t) ((WindowedSincHelpers::numPhases + 1) * numTaps));
+    coefficientDeltas.malloc ((size_t) (WindowedSincHelpers::numPhases * numTaps));
+    history.malloc ((size_t) (2 * numTaps * numChannels));
+
+    updateCoefficients (1.0);
+    reset();
+}
+
+WindowedSincInterpolator::~WindowedSincInterpolator() {}
+
+void WindowedSincInterpolator::reset() noexcept
+{
+    FloatVectorOperations::clear (history, 2 * numTaps * numChannels);
+    historyPos = 0;
+    subSamplePos = 1.0;
+}
+
+void WindowedSincInterpolator::updateCoefficients (double speedRatio) noexcept
+{
+    using namespace WindowedSincHelpers;
+
+    // The cutoff is a proportion of the input's Nyquist frequency. It's set so that the
+    // transition band of the window ends at the output's Nyquist frequency, which is
+    // lower than the input's when down-sampling.
+    auto transitionWidth = 2.5 / numZeroCrossings;
+    auto nyquistRatio = jmin (1.0, 1.0 / speedRatio);
+    auto cutoff = jmax (nyquistRatio * 0.5, nyquistRatio - transitionWidth);
+
+    // small changes in the ratio aren't worth recalculating the table for
+    if (std::abs (cutoff - currentCutoff) <= currentCutoff * 0.01)
+        return;
+
+    currentCutoff = cutoff;
+
+    // the kernel is centred between the taps at (centre - 1) and centre, so any
+    // extra taps needed to round numTaps up to a multiple of 4 go at the oldest end
+    auto centre = numTaps - numZeroCrossings;
+    auto windowScale = 1.0 / besselI0 (kaiserBeta);
+
+    for (int phase = 0; phase <= numPhases; ++phase)
+    {
+        auto* row = coefficients + phase * numTaps;
+        auto offset = (centre - 1) + phase / (double) numPhases;
+        auto sum = 0.0;
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            auto x = i - offset;
+            auto windowPos = x / numZeroCrossings;
+            auto value = 0.0;
+
+            if (std::abs (windowPos) < 1.0)
+            {
+                auto t = MathConstants<double>::pi * cutoff * x;
+                auto sinc = std::abs (t) < 1.0e-9 ? 1.0 : std::sin (t) / t;
+                value = sinc * besselI0 (kaiserBeta * std::sqrt (1.0 - windowPos * windowPos)) * windowScale;
+            }
+
+            row[i] = (float) value;
+            sum += value;
+        }
+
+        // normalise each phase to unity gain at DC, which removes any ripple between them
+        FloatVectorOperations::multiply (row, (float) (1.0 / sum), numTaps);
+    }
+
+    for (int phase = 0; phase < numPhases; ++phase)
+        FloatVectorOperations::subtract (coefficientDeltas + phase * numTaps,
+                                         coefficients + (phase + 1) * numTaps,
+                                         coefficients + phase * numTaps, numTaps);
+}
+
+template <bool isAdding>
+int WindowedSincInterpolator::processChannels (double speedRatio, const float* const* in, float* const* out,
+                                               int numChannelsToProcess, int numOut, float gain) noexcept
+{
+    using namespace WindowedSincHelpers;
+
+    jassert (numChannelsToProcess <= numChannels);
+    numChannelsToProcess = jmin (numChannelsToProcess, numChannels);
+
+    updateCoefficients (speedRatio);
+
+    auto pos = subSamplePos;
+    int numUsed = 0;
+
+    for (int i = 0; i < numOut; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            for (int channel = 0; channel < numChannelsToProcess; ++channel)
+            {
+                auto* h = history + channel * 2 * numTaps;
+                h[historyPos] = h[historyPos + numTaps] = in[channel][numUsed];
+            }
+
+            if (++historyPos == numTaps)
+                historyPos = 0;
+
+            ++numUsed;
+            pos -= 1.0;
+        }
+
+        auto phase = pos * numPhases;
+        auto index = jmin ((int) phase, numPhases - 1);
+        auto alpha = (float) (phase - index);
+
+        auto* kernel = coefficients + index * numTaps;
+        auto* deltas = coefficientDeltas + index * numTaps;
+
+        for (int channel = 0; channel < numChannelsToProcess; ++channel)
+        {
+            float kernelSum, deltaSum;
+            dotProducts (history + channel * 2 * numTaps + historyPos, kernel, deltas, numTaps, kernelSum, deltaSum);
+
+            auto result = kernelSum + alpha * deltaSum;
+
+            if (isAdding)
+                out[channel][i] += gain * result;
+            else
+                out[channel][i] = result;
+        }
+
+        pos += speedRatio;
+    }
+
+    subSamplePos = pos;
+    return numUsed;
+}
+
+int WindowedSincInterpolator::process (double speedRatio, const float* const* in, float* const* out,
+                                       int numChannelsToProcess, int numOut) noexcept
+{
+    return processChannels<false> (speedRatio, in, out, numChannelsToProcess, numOut, 1.0f);
+}
+
+int WindowedSincInterpolator::processAdding (double speedRatio, const float* const* in, float* const* out,
+                                             int numChannelsToProcess, int numOut, float gain) noexcept
+{
+    return processChannels<true> (speedRatio, in, out, numChannelsToProcess, numOut, gain);
+}
+
+int WindowedSincInterpolator::process (double speedRatio, const float* in, float* out, int numOut) noexcept
+{
+    return processChannels<false> (speedRatio, &in, &out, 1, numOut, 1.0f);
+}
+
+int WindowedSincInterpolator::processAdding (double speedRatio, const float* in, float* out, int numOut, float gain) noexcept
+{
+    return processChannels<true> (speedRatio, &in, &out, 1, numOut, gain);
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class WindowedSincInterpolatorTests  : public UnitTest
+{
+public:
+    WindowedSincInterpolatorTests()  : UnitTest ("WindowedSincInterpolator", "Audio") {}
+
+    static float getSine (double frequency, double position)
+    {
+        return (float) std::sin (MathConstants<double>::twoPi * frequency * position);
+    }
+
+    /** Resamples a sine wave in irregular blocks, and returns the largest difference
+        between the result and the expected sine at the output rate.
+    */
+    float getMaximumError (double speedRatio, double frequency, int numChannels, Random& random)
+    {
+        WindowedSincInterpolator interpolator (numChannels, 32);
+
+        const int numOut = 4000;
+        const int numIn = (int) (numOut * speedRatio) + 64;
+
+        AudioBuffer<float> input (numChannels, numIn), output (numChannels, numOut);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numIn; ++i)
+                input.setSample (channel, i, getSine (frequency, i + 0.25 * channel));
+
+        int numUsed = 0;
+
+        for (int done = 0; done < numOut;)
+        {
+            auto num = jmin (1 + random.nextInt (300), numOut - done);
+
+            const float* in[8];
+            float* out[8];
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                in[channel] = input.getReadPointer (channel, numUsed);
+                out[channel] = output.getWritePointer (channel, done);
+            }
+
+            numUsed += interpolator.process (speedRatio, in, out, numChannels, num);
+            done += num;
+        }
+
+        auto latency = interpolator.getNumZeroCrossings();
+        auto maximumError = 0.0f;
+
+        // skip the samples that depend on the silence before the start of the input
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = (int) (2 * latency / speedRatio) + 1; i < numOut; ++i)
+                maximumError = jmax (maximumError, std::abs (output.getSample (channel, i)
+                                                               - getSine (frequency, i * speedRatio - latency + 0.25 * channel)));
+
+        return maximumError;
+    }
+
+    /** Returns the RMS level of a down-sampled sine wave above the output's Nyquist frequency. */
+    template <typename Resampler>
+    float getAliasLevel (Resampler& resampler, double speedRatio, double frequency)
+    {
+        const int numOut = 4000;
+        HeapBlock<float> input ((size_t) (numOut * speedRatio) + 64), output (numOut);
+
+        for (int i = 0; i < (int) (numOut * speedRatio) + 64; ++i)
+            input[i] = getSine (frequency, i);
+
+        resampler.process (speedRatio, input, output, numOut);
+
+        auto sum = 0.0;
+
+        for (int i = numOut / 2; i < numOut; ++i)
+            sum += output[i] * output[i];
+
+        return (float) std::sqrt (sum / (numOut / 2));
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Resampling sine waves");
+        {
+            expectLessThan (getMaximumError (1.0, 0.05, 1, random), 1.0e-3f);
+            expectLessThan (getMaximumError (0.37, 0.1, 1, random), 1.0e-3f);
+            expectLessThan (getMaximumError (1.6, 0.05, 1, random), 1.0e-3f);
+            expectLessThan (getMaximumError (0.8, 0.35, 1, random), 1.0e-3f);
+        }
+
+        beginTest ("Resampling several channels");
+        {
+            expectLessThan (getMaximumError (0.5, 0.1, 2, random), 1.0e-3f);
+            expectLessThan (getMaximumError (1.3, 0.12, 5, random), 1.0e-3f);
+        }
+
+        beginTest ("Rejecting aliases when down-sampling");
+        {
+            // a tone at 0.35 of the input rate is above the output's Nyquist
+            // frequency when it's down-sampled by a factor of 2
+            WindowedSincInterpolator sinc;
+            LagrangeInterpolator lagrange;
+
+            auto sincLevel = getAliasLevel (sinc, 2.0, 0.35);
+            auto lagrangeLevel = getAliasLevel (lagrange, 2.0, 0.35);
+
+            expectLessThan (sincLevel, 1.0e-3f);
+            expectGreaterThan (lagrangeLevel, 0.1f);
+        }
+
+        beginTest ("Adding to the output");
+        {
+            WindowedSincInterpolator a, b;
+            HeapBlock<float> input (1000), replaced (400), added (400);
+
+            for (int i = 0; i < 1000; ++i)
+                input[i] = random.nextFloat() - 0.5f;
+
+            for (int i = 0; i < 400; ++i)
+                added[i] = 1.0f;
+
+            expectEquals (a.process (1.5, input, replaced, 400), b.processAdding (1.5, input, added, 400, 0.5f));
+
+            auto maximumError = 0.0f;
+
+            for (int i = 0; i < 400; ++i)
+                maximumError = jmax (maximumError, std::abs (added[i] - (1.0f + 0.5f * replaced[i])));
+
+            expectLessThan (maximumError, 1.0e-6f);
+        }
+
+        beginTest ("Using it in a ResamplingAudioSource");
+        {
+            const double speedRatio = 0.75, frequency = 0.04;
+            const int numIn = 8000, numOut = 8000;
+
+            AudioBuffer<float> source (2, numIn), output (2, numOut);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < numIn; ++i)
+                    source.setSample (channel, i, getSine (frequency, i));
+
+            ResamplingAudioSource resampler (new MemoryAudioSource (source, false), true, 2);
+            resampler.setInterpolationMode (ResamplingAudioSource::InterpolationMode::windowedSinc);
+            resampler.setResamplingRatio (speedRatio);
+            resampler.prepareToPlay (512, 44100.0);
+
+            for (int done = 0; done < numOut;)
+            {
+                auto num = jmin (1 + random.nextInt (512), numOut - done);
+                resampler.getNextAudioBlock (AudioSourceChannelInfo (&output, done, num));
+                done += num;
+            }
+
+            auto maximumError = 0.0f;
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 100; i < numOut; ++i)
+                    maximumError = jmax (maximumError, std::abs (output.getSample (channel, i)
+                                                                   - getSine (frequency, i * speedRatio - 32)));
+
+            expectLessThan (maximumError, 1.0e-3f);
+        }
+    }
+};
+
+static WindowedSincInterpolatorTests windowedSincInterpolatorTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/**
+    Interpolator for resampling one or more streams of floats using a band-limited
+    windowed-sinc kernel.
+
+    This is much slower than the LagrangeInterpolator or CatmullRomInterpolator, but
+    it has a flat passband and a much better rejection of images and aliases, so it's
+    the one to use when the quality of the result matters more than the CPU cost.
+
+    The kernel is read from a table of pre-calculated polyphase coefficients, and all
+    the channels are processed together, sharing the same coefficients. When the
+    speed ratio is greater than 1, the cutoff of the kernel is lowered to stop the
+    input frequencies above the new Nyquist frequency from aliasing. This means that
+    the table has to be recalculated when the ratio changes, but no memory gets
+    allocated while processing.
+
+    The output is delayed by getNumZeroCrossings() input samples.
+
+    Note that the resampler is stateful, so when there's a break in the continuity
+    of the input stream you're feeding it, you should call reset() before feeding
+    it any new data.
+
+    @see LagrangeInterpolator, CatmullRomInterpolator, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  WindowedSincInterpolator
+{
+public:
+    /** Creates an interpolator.
+
+        @param numChannels          the number of channels that the multichannel versions
+                                    of process() and processAdding() will work on
+        @param numZeroCrossings     the number of zero crossings on each side of the kernel.
+                                    Higher values give a steeper filter, at the expense of
+                                    more CPU and latency
+    */
+    WindowedSincInterpolator (int numChannels = 1, int numZeroCrossings = 32);
+
+    /** Destructor. */
+    ~WindowedSincInterpolator();
+
+    /** Resets the state of the interpolator.
+        Call this when there's a break in the continuity of the input data stream.
+    */
+    void reset() noexcept;
+
+    /** Returns the number of channels that this interpolator was created with. */
+    int getNumChannels() const noexcept                 { return numChannels; }
+
+    /** Returns the number of zero crossings on each side of the kernel. This is
+        also the number of input samples by which the output is delayed.
+    */
+    int getNumZeroCrossings() const noexcept            { return numZeroCrossings; }
+
+    /** Resamples a set of channels.
+
+        @param speedRatio       the number of input samples to use for each output sample
+        @param inputChannelData the source data to read from, one pointer per channel. Each
+                                channel must contain at least (speedRatio * numOutputSamplesToProduce)
+                                samples, plus one
+        @param outputChannelData the buffers to write the results into, one per channel
+        @param numChannelsToProcess the number of channels to process, which must not be greater
+                                than getNumChannels(). Any channels above this number are left
+                                untouched, so their history will fall out of step with the others.
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+
+        @returns the actual number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* const* inputChannelData,
+                 float* const* outputChannelData,
+                 int numChannelsToProcess,
+                 int numOutputSamplesToProduce) noexcept;
+
+    /** Resamples a set of channels, adding the results to the output data with a gain.
+
+        @param speedRatio       the number of input samples to use for each output sample
+        @param inputChannelData the source data to read from, one pointer per channel. Each
+                                channel must contain at least (speedRatio * numOutputSamplesToProduce)
+                                samples, plus one
+        @param outputChannelData the buffers to add the results to, one per channel
+        @param numChannelsToProcess the number of channels to process, which must not be greater
+                                than getNumChannels()
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+        @param gain             a gain factor to multiply the resulting samples by before
+                                adding them to the destination buffers
+
+        @returns the actual number of input samples that were used
+    */
+    int processAdding (double speedRatio,
+                       const float* const* inputChannelData,
+                       float* const* outputChannelData,
+                       int numChannelsToProcess,
+                       int numOutputSamplesToProduce,
+                       float gain) noexcept;
+
+    /** Resamples a single stream of samples, using the first channel of the interpolator.
+
+        @param speedRatio       the number of input samples to use for each output sample
+        @param inputSamples     the source data to read from. This must contain at
+                                least (speedRatio * numOutputSamplesToProduce) samples, plus one.
+        @param outputSamples    the buffer to write the results into
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+
+        @returns the actual number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* inputSamples,
+                 float* outputSamples,
+                 int numOutputSamplesToProduce) noexcept;
+
+    /** Resamples a single stream of samples, using the first channel of the interpolator,
+        and adds the results to the output data with a gain.
+
+        @param speedRatio       the number of input samples to use for each output sample
+        @param inputSamples     the source data to read from. This must contain at
+                                least (speedRatio * numOutputSamplesToProduce) samples, plus one.
+        @param outputSamples    the buffer to write the results to - the result values will be added
+                                to any pre-existing data in this buffer after being multiplied by
+                                the gain factor
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+        @param gain             a gain factor to multiply the resulting samples by before
+                                adding them to the destination buffer
+
+        @returns the actual number of input samples that were used
+    */
+    int processAdding (double speedRatio,
+                       const float* inputSamples,
+                       float* outputSamples,
+                       int numOutputSamplesToProduce,
+                       float gain) noexcept;
+
+private:
+    //==============================================================================
+    const int numChannels, numZeroCrossings, numTaps;
+
+    // The table holds (numPhases + 1) rows of numTaps coefficients, followed by the
+    // differences between each row and the next one, so that the kernel can be
+    // interpolated between two phases.
+    HeapBlock<float> coefficients, coefficientDeltas;
+    double currentCutoff = 0;
+
+    // Each channel's history is written twice, numTaps apart, so that the most
+    // recent numTaps samples can always be read as one contiguous block.
+    HeapBlock<float> history;
+    int historyPos = 0;
+    double subSamplePos = 1.0;
+
+    void updateCoefficients (double speedRatio) noexcept;
+
+    template <bool isAdding>
+    int processChannels (double speedRatio, const float* const*, float* const*, int numChannelsToProcess, int numOut, float gain) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WindowedSincInterpolator)
+};
+
+} // namespace juce
@@ -0,0 +1,783 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  A single-producer, single-consumer FIFO that carries audio between two devices
+    running on different clocks.
+
+    The consumer resamples the audio as it reads it, adjusting the ratio around its
+    nominal value so that the amount of audio waiting in the FIFO stays close to a
+    target level; if one clock runs faster than the other, the fill level starts to move
+    away from the target and the correction pulls it back. The correction has an integral
+    term, so once the loop settles the level sits on the target rather than being offset
+    by however much the clocks differ.
+
+    Because the audio arrives in blocks, the number of samples in the FIFO jumps each time
+    the producer runs, and if the two devices' callbacks were simply compared, that would
+    show up as a slow sawtooth as their phases drifted past each other. So the consumer
+    measures the fill level as the samples that are ready plus the time since the last
+    push, converted into samples, which doesn't depend on where it is in the producer's cycle.
+*/
+struct DriftCompensatedAudioFifo
+{
+    void prepare (int channels, int targetFillLevel, double producerSampleRate,
+                  double consumerSampleRate, int maxSamplesPerPull)
+    {
+        numChannels = channels;
+        targetFill = jmax (1, targetFillLevel);
+        producerRate = producerSampleRate;
+        nominal = producerSampleRate / consumerSampleRate;
+        consumerRate = consumerSampleRate;
+
+        auto capacity = nextPowerOfTwo (targetFill * 4 + 1);
+        fifo.setTotalSize (capacity);
+        buffer.setSize (jmax (1, numChannels), capacity);
+        buffer.clear();
+        // devices don't always stick to the block size that they report, so leave some headroom
+        maxPullSize = maxSamplesPerPull * 2;
+        scratch.setSize (1, (int) std::ceil (maxPullSize * nominal * (1.0 + maxCorrection)) + 2);
+
+        interpolators.clear();
+
+        for (int i = 0; i < numChannels; ++i)
+            interpolators.add (new LagrangeInterpolator());
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        fifo.reset();
+        isPrimed = false;
+        smoothedFill = targetFill;
+        correction = 0;
+        integral = 0;
+        numUnderruns = 0;
+        lastPushSize = 0;
+
+        for (auto* interpolator : interpolators)
+            interpolator->reset();
+    }
+
+    // Called on the producer's thread.
+    void push (const float* const* source, int numSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            if (size1 > 0)  buffer.copyFrom (i, start1, source[i], size1);
+            if (size2 > 0)  buffer.copyFrom (i, start2, source[i] + size1, size2);
+        }
+
+        // if there's no room, the consumer has stopped, so any samples that
+        // don't fit are dropped until it starts pulling again
+        fifo.finishedWrite (size1 + size2);
+
+        lastPushSize = numSamples;
+        lastPushTicks = Time::getHighResolutionTicks();
+    }
+
+    // Called on the consumer's thread.
+    void pull (float* const* dest, int numSamples) noexcept
+    {
+        auto pushTicks = lastPushTicks.load();
+        auto pushSize = lastPushSize.load();
+        auto available = fifo.getNumReady();
+
+        if (numSamples > maxPullSize)
+        {
+            jassertfalse;
+            available = 0;
+        }
+
+        if (! isPrimed)
+        {
+            if (available < targetFill)
+            {
+                for (int i = 0; i < numChannels; ++i)
+                    FloatVectorOperations::clear (dest[i], numSamples);
+
+                return;
+            }
+
+            // start from the target level, discarding anything that
+            // built up while we were waiting
+            skip (available - targetFill);
+            available = targetFill;
+            smoothedFill = targetFill;
+            isPrimed = true;
+        }
+
+        auto samplesSincePush = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - pushTicks) * producerRate;
+        auto fill = available + jlimit (0.0, (double) pushSize, samplesSincePush);
+        smoothedFill += fillSmoothing * (fill - smoothedFill);
+
+        auto error = correctionGain * (smoothedFill - targetFill) / targetFill;
+        integral = jlimit (-maxCorrection, maxCorrection, integral + error * numSamples / (consumerRate * integralTimeSeconds));
+        auto newCorrection = jlimit (-maxCorrection, maxCorrection, error + integral);
+        correction = newCorrection;
+
+        auto ratio = nominal * (1.0 + newCorrection);
+        auto numNeeded = (int) std::ceil (numSamples * ratio) + 2;
+
+        if (available < numNeeded)
+        {
+            // the producer has fallen behind, so go back to waiting
+            // for the FIFO to fill up again
+            for (int i = 0; i < numChannels; ++i)
+                FloatVectorOperations::clear (dest[i], numSamples);
+
+            skip (available);
+            isPrimed = false;
+            ++numUnderruns;
+
+            for (auto* interpolator : interpolators)
+                interpolator->reset();
+
+            return;
+        }
+
+        int numUsed = 0;
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            read (scratch.getWritePointer (0), i, numNeeded);
+            numUsed = interpolators.getUnchecked (i)->process (ratio, scratch.getReadPointer (0), dest[i], numSamples);
+        }
+
+        jassert (numUsed <= numNeeded);
+        skip (numUsed);
+    }
+
+    double getCorrection() const noexcept   { return correction; }
+    int getNumUnderruns() const noexcept    { return numUnderruns; }
+    int getTargetFillLevel() const noexcept { return targetFill; }
+
+private:
+    void read (float* dest, int channel, int numSamples) const noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (numSamples, start1, size1, start2, size2);
+
+        if (size1 > 0)  FloatVectorOperations::copy (dest, buffer.getReadPointer (channel, start1), size1);
+        if (size2 > 0)  FloatVectorOperations::copy (dest + size1, buffer.getReadPointer (channel, start2), size2);
+    }
+
+    void skip (int numSamples) noexcept
+    {
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (numSamples, start1, size1, start2, size2);
+        fifo.finishedRead (size1 + size2);
+    }
+
+    static constexpr double fillSmoothing = 0.05, correctionGain = 0.01, integralTimeSeconds = 4.0, maxCorrection = 0.005;
+
+    AbstractFifo fifo { 1 };
+    AudioBuffer<float> buffer, scratch;
+    OwnedArray<LagrangeInterpolator> interpolators;
+    int numChannels = 0, targetFill = 1, maxPullSize = 0;
+    double producerRate = 44100.0, consumerRate = 44100.0, nominal = 1.0, smoothedFill = 0, integral = 0;
+    bool isPrimed = false;
+    std::atomic<double> correction { 0 };
+    std::atomic<int> numUnderruns { 0 }, lastPushSize { 0 };
+    std::atomic<int64> lastPushTicks { 0 };
+};
+
+//==============================================================================
+struct AggregateAudioIODevice::Member  : public AudioIODeviceCallback
+{
+    Member (AggregateAudioIODevice& o, AudioIODevice* d)  : owner (o), device (d) {}
+
+    void prepare (double masterRate, int masterBlockSize)
+    {
+        auto rate = device->getCurrentSampleRate();
+        auto blockSize = device->getCurrentBufferSizeSamples();
+
+        numActiveInputs  = device->getActiveInputChannels().countNumberOfSetBits();
+        numActiveOutputs = device->getActiveOutputChannels().countNumberOfSetBits();
+
+        inputFifo.prepare (numActiveInputs,
+                           blockSize + (int) std::ceil (masterBlockSize * rate / masterRate) + fifoSafetyMargin,
+                           rate, masterRate, masterBlockSize);
+
+        outputFifo.prepare (numActiveOutputs,
+                            masterBlockSize + (int) std::ceil (blockSize * masterRate / rate) + fifoSafetyMargin,
+                            masterRate, rate, blockSize);
+
+        inputs.setSize  (jmax (1, numActiveInputs),  masterBlockSize * 2);
+        outputs.setSize (jmax (1, numActiveOutputs), masterBlockSize * 2);
+        rateRatio = masterRate / rate;
+    }
+
+    int getInputLatency()
+    {
+        return roundToInt ((device->getInputLatencyInSamples() + inputFifo.getTargetFillLevel()) * rateRatio);
+    }
+
+    int getOutputLatency()
+    {
+        return outputFifo.getTargetFillLevel() + roundToInt (device->getOutputLatencyInSamples() * rateRatio);
+    }
+
+    // These are called on the member device's own audio thread.
+    void audioDeviceIOCallback (const float** inputChannelData, int numInputChannels,
+                                float** outputChannelData, int numOutputChannels,
+                                int numSamples) override
+    {
+        jassert (numInputChannels == numActiveInputs && numOutputChannels == numActiveOutputs);
+        ignoreUnused (numInputChannels, numOutputChannels);
+
+        if (numActiveInputs > 0)
+            inputFifo.push (inputChannelData, numSamples);
+
+        if (numActiveOutputs > 0)
+            outputFifo.pull (outputChannelData, numSamples);
+    }
+
+    void audioDeviceAboutToStart (AudioIODevice*) override
+    {
+        inputFifo.reset();
+        outputFifo.reset();
+    }
+
+    void audioDeviceStopped() override {}
+
+    void audioDeviceError (const String& errorMessage) override
+    {
+        owner.audioDeviceError (device->getName() + ": " + errorMessage);
+    }
+
+    // extra samples kept in each FIFO to absorb jitter in when the devices' callbacks run
+    static constexpr int fifoSafetyMargin = 128;
+
+    AggregateAudioIODevice& owner;
+    std::unique_ptr<AudioIODevice> device;
+    int firstInputChannel = 0, firstOutputChannel = 0;
+    int numActiveInputs = 0, numActiveOutputs = 0;
+    bool isMaster = false, isActive = false;
+    double rateRatio = 1.0;
+    DriftCompensatedAudioFifo inputFifo, outputFifo;
+    AudioBuffer<float> inputs, outputs;
+
+    JUCE_DECLARE_NON_COPYABLE (Member)
+};
+
+template <typename ValueType>
+static ValueType findNearest (const Array<ValueType>& values, ValueType target)
+{
+    auto nearest = target;
+
+    for (int i = 0; i < values.size(); ++i)
+        if (i == 0 || std::abs (values[i] - target) < std::abs (nearest - target))
+            nearest = values[i];
+
+    return nearest;
+}
+
+//==============================================================================
+AggregateAudioIODevice::AggregateAudioIODevice (const String& deviceName, OwnedArray<AudioIODevice>& devicesToUse)
+    : AudioIODevice (deviceName, "Aggregate")
+{
+    jassert (! devicesToUse.isEmpty());
+
+    int numInputs = 0, numOutputs = 0;
+
+    while (! devicesToUse.isEmpty())
+    {
+        auto* member = members.add (new Member (*this, devicesToUse.removeAndReturn (0)));
+        member->isMaster = (members.size() == 1);
+        member->firstInputChannel  = numInputs;
+        member->firstOutputChannel = numOutputs;
+
+        numInputs  += member->device->getInputChannelNames().size();
+        numOutputs += member->device->getOutputChannelNames().size();
+    }
+}
+
+AggregateAudioIODevice::~AggregateAudioIODevice()
+{
+    close();
+}
+
+int AggregateAudioIODevice::getNumMemberDevices() const noexcept
+{
+    return members.size();
+}
+
+AudioIODevice* AggregateAudioIODevice::getMemberDevice (int index) const noexcept
+{
+    if (auto* member = members[index])
+        return member->device.get();
+
+    return nullptr;
+}
+
+int AggregateAudioIODevice::getMemberInputLatencyInSamples (int index)
+{
+    if (auto* member = members[index])
+    {
+        if (member->isMaster)
+            return member->device->getInputLatencyInSamples();
+
+        if (member->isActive)
+            return member->getInputLatency();
+    }
+
+    return 0;
+}
+
+int AggregateAudioIODevice::getMemberOutputLatencyInSamples (int index)
+{
+    if (auto* member = members[index])
+    {
+        if (member->isMaster)
+            return member->device->getOutputLatencyInSamples();
+
+        if (member->isActive)
+            return member->getOutputLatency();
+    }
+
+    return 0;
+}
+
+double AggregateAudioIODevice::getMemberClockDrift (int index) const noexcept
+{
+    if (auto* member = members[index])
+    {
+        if (member->isMaster || ! deviceIsPlaying)
+            return 0.0;
+
+        // the input FIFO is filled by the member's clock, the output FIFO by the master's
+        if (member->numActiveInputs > 0)
+            return member->inputFifo.getCorrection();
+
+        return -member->outputFifo.getCorrection();
+    }
+
+    return 0.0;
+}
+
+//==============================================================================
+StringArray AggregateAudioIODevice::getOutputChannelNames()
+{
+    StringArray names;
+
+    for (auto* member : members)
+        for (auto& channelName : member->device->getOutputChannelNames())
+            names.add (member->device->getName() + ": " + channelName);
+
+    return names;
+}
+
+StringArray AggregateAudioIODevice::getInputChannelNames()
+{
+    StringArray names;
+
+    for (auto* member : members)
+        for (auto& channelName : member->device->getInputChannelNames())
+            names.add (member->device->getName() + ": " + channelName);
+
+    return names;
+}
+
+Array<double> AggregateAudioIODevice::getAvailableSampleRates()   { return members.getFirst()->device->getAvailableSampleRates(); }
+Array<int> AggregateAudioIODevice::getAvailableBufferSizes()      { return members.getFirst()->device->getAvailableBufferSizes(); }
+int AggregateAudioIODevice::getDefaultBufferSize()                { return members.getFirst()->device->getDefaultBufferSize(); }
+
+String AggregateAudioIODevice::open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                                     double sampleRate, int bufferSizeSamples)
+{
+    close();
+    lastError.clear();
+
+    double masterRate = 0;
+    int masterBlockSize = 0;
+
+    for (auto* member : members)
+    {
+        auto& device = *member->device;
+        auto ins  = inputChannels .getBitRange (member->firstInputChannel,  device.getInputChannelNames().size());
+        auto outs = outputChannels.getBitRange (member->firstOutputChannel, device.getOutputChannelNames().size());
+
+        if (member->isMaster)
+        {
+            // the master has to run even if none of its channels are wanted,
+            // because its callback is what drives all the others
+            if (ins.isZero() && outs.isZero())
+            {
+                masterChannelsAreHidden = true;
+
+                if (device.getOutputChannelNames().isEmpty())
+                    ins.setBit (0);
+                else
+                    outs.setBit (0);
+            }
+        }
+        else if (ins.isZero() && outs.isZero())
+        {
+            continue;
+        }
+
+        auto rate = sampleRate;
+        auto blockSize = bufferSizeSamples;
+
+        if (! member->isMaster)
+        {
+            // run the others as close as possible to the master's settings
+            rate = findNearest (device.getAvailableSampleRates(), masterRate);
+            blockSize = findNearest (device.getAvailableBufferSizes(), roundToInt (masterBlockSize * rate / masterRate));
+        }
+
+        auto error = device.open (ins, outs, rate, blockSize);
+
+        if (error.isNotEmpty())
+        {
+            lastError = device.getName() + ": " + error;
+            close();
+            return lastError;
+        }
+
+        member->isActive = true;
+
+        if (member->isMaster)
+        {
+            masterRate = device.getCurrentSampleRate();
+            masterBlockSize = device.getCurrentBufferSizeSamples();
+        }
+        else
+        {
+            member->prepare (masterRate, masterBlockSize);
+        }
+
+        if (! (member->isMaster && masterChannelsAreHidden))
+        {
+            auto activeIns  = device.getActiveInputChannels();
+            auto activeOuts = device.getActiveOutputChannels();
+
+            for (int i = activeIns.findNextSetBit (0); i >= 0; i = activeIns.findNextSetBit (i + 1))
+                activeInputs.setBit (member->firstInputChannel + i);
+
+            for (int i = activeOuts.findNextSetBit (0); i >= 0; i = activeOuts.findNextSetBit (i + 1))
+                activeOutputs.setBit (member->firstOutputChannel + i);
+        }
+    }
+
+    jassert (members.getFirst()->isActive);
+
+    callbackInputs.ensureStorageAllocated (activeInputs.countNumberOfSetBits());
+    callbackOutputs.ensureStorageAllocated (activeOutputs.countNumberOfSetBits());
+    deviceIsOpen = true;
+    return {};
+}
+
+void AggregateAudioIODevice::close()
+{
+    stop();
+
+    for (auto* member : members)
+    {
+        if (member->isActive)
+            member->device->close();
+
+        member->isActive = false;
+    }
+
+    activeInputs.clear();
+    activeOutputs.clear();
+    masterChannelsAreHidden = false;
+    deviceIsOpen = false;
+}
+
+bool AggregateAudioIODevice::isOpen()    { return deviceIsOpen; }
+
+void AggregateAudioIODevice::start (AudioIODeviceCallback* newCallback)
+{
+    if (deviceIsOpen && newCallback != nullptr && ! deviceIsPlaying)
+    {
+        newCallback->audioDeviceAboutToStart (this);
+
+        {
+            const ScopedLock sl (callbackLock);
+            callback = newCallback;
+        }
+
+        // start the others first so that their FIFOs begin filling
+        // before the master starts reading them
+        for (int i = members.size(); --i >= 0;)
+        {
+            auto* member = members.getUnchecked (i);
+
+            if (member->isActive)
+            {
+                if (member->isMaster)
+                    member->device->start (this);
+                else
+                    member->device->start (member);
+            }
+        }
+
+        deviceIsPlaying = true;
+    }
+}
+
+void AggregateAudioIODevice::stop()
+{
+    if (deviceIsPlaying)
+    {
+        for (auto* member : members)
+            if (member->isActive)
+                member->device->stop();
+
+        AudioIODeviceCallback* lastCallback = nullptr;
+
+        {
+            const ScopedLock sl (callbackLock);
+            std::swap (lastCallback, callback);
+        }
+
+        deviceIsPlaying = false;
+
+        if (lastCallback != nullptr)
+            lastCallback->audioDeviceStopped();
+    }
+}
+
+bool AggregateAudioIODevice::isPlaying()                         { return deviceIsPlaying && callback != nullptr; }
+String AggregateAudioIODevice::getLastError()                    { return lastError; }
+int AggregateAudioIODevice::getCurrentBufferSizeSamples()        { return members.getFirst()->device->getCurrentBufferSizeSamples(); }
+double AggregateAudioIODevice::getCurrentSampleRate()            { return members.getFirst()->device->getCurrentSampleRate(); }
+int AggregateAudioIODevice::getCurrentBitDepth()                 { return members.getFirst()->device->getCurrentBitDepth(); }
+BigInteger AggregateAudioIODevice::getActiveOutputChannels() const   { return activeOutputs; }
+BigInteger AggregateAudioIODevice::getActiveInputChannels() const    { return activeInputs; }
+AudioWorkgroup AggregateAudioIODevice::getWorkgroup() const      { return members.getFirst()->device->getWorkgroup(); }
+
+int AggregateAudioIODevice::getOutputLatencyInSamples()
+{
+    int latency = 0;
+
+    for (int i = 0; i < members.size(); ++i)
+        if (members.getUnchecked (i)->numActiveOutputs > 0 || members.getUnchecked (i)->isMaster)
+            latency = jmax (latency, getMemberOutputLatencyInSamples (i));
+
+    return latency;
+}
+
+int AggregateAudioIODevice::getInputLatencyInSamples()
+{
+    int latency = 0;
+
+    for (int i = 0; i < members.size(); ++i)
+        if (members.getUnchecked (i)->numActiveInputs > 0 || members.getUnchecked (i)->isMaster)
+            latency = jmax (latency, getMemberInputLatencyInSamples (i));
+
+    return latency;
+}
+
+int AggregateAudioIODevice::getXRunCount() const noexcept
+{
+    int total = 0;
+    bool isKnown = false;
+
+    for (auto* member : members)
+    {
+        if (! member->isActive)
+            continue;
+
+        auto count = member->device->getXRunCount();
+
+        if (count >= 0)
+        {
+            total += count;
+            isKnown = true;
+        }
+
+        if (! member->isMaster)
+        {
+            total += member->inputFifo.getNumUnderruns() + member->outputFifo.getNumUnderruns();
+            isKnown = true;
+        }
+    }
+
+    return isKnown ? total : -1;
+}
+
+//==============================================================================
+void AggregateAudioIODevice::audioDeviceIOCallback (const float** inputChannelData, int numInputChannels,
+                                                    float** outputChannelData, int numOutputChannels,
+                                                    int numSamples)
+{
+    const ScopedLock sl (callbackLock);
+
+    callbackInputs.clearQuick();
+    callbackOutputs.clearQuick();
+
+    if (masterChannelsAreHidden)
+    {
+        for (int i = 0; i < numOutputChannels; ++i)
+            FloatVectorOperations::clear (outputChannelData[i], numSamples);
+    }
+    else
+    {
+        callbackInputs.addArray (inputChannelData, numInputChannels);
+        callbackOutputs.addArray (outputChannelData, numOutputChannels);
+    }
+
+    for (auto* member : members)
+    {
+        if (member->isMaster || ! member->isActive)
+            continue;
+
+        // the master's block size can vary from one callback to the next
+        jassert (numSamples <= member->inputs.getNumSamples());
+        numSamples = jmin (numSamples, member->inputs.getNumSamples());
+
+        if (member->numActiveInputs > 0)
+        {
+            member->inputFifo.pull (member->inputs.getArrayOfWritePointers(), numSamples);
+
+            for (int i = 0; i < member->numActiveInputs; ++i)
+                callbackInputs.add (member->inputs.getReadPointer (i));
+        }
+
+        for (int i = 0; i < member->numActiveOutputs; ++i)
+            callbackOutputs.add (member->outputs.getWritePointer (i));
+    }
+
+    if (callback != nullptr)
+    {
+        callback->audioDeviceIOCallback (callbackInputs.getRawDataPointer(), callbackInputs.size(),
+                                         callbackOutputs.getRawDataPointer(), callbackOutputs.size(),
+                                         numSamples);
+    }
+    else
+    {
+        for (auto* output : callbackOutputs)
+            FloatVectorOperations::clear (output, numSamples);
+    }
+
+    for (auto* member : members)
+        if (! member->isMaster && member->numActiveOutputs > 0)
+            member->outputFifo.push (member->outputs.getArrayOfReadPointers(), numSamples);
+}
+
+void AggregateAudioIODevice::audioDeviceAboutToStart (AudioIODevice*) {}
+void AggregateAudioIODevice::audioDeviceStopped() {}
+
+void AggregateAudioIODevice::audioDeviceError (const String& errorMessage)
+{
+    const ScopedLock sl (callbackLock);
+
+    if (callback != nullptr)
+        callback->audioDeviceError (errorMessage);
+}
+
+//==============================================================================
+AggregateAudioIODeviceType::AggregateAudioIODeviceType (AudioDeviceManager& managerToUse)
+    : AudioIODeviceType ("Aggregate"), manager (managerToUse)
+{
+}
+
+AggregateAudioIODeviceType::~AggregateAudioIODeviceType() = default;
+
+void AggregateAudioIODeviceType::addAggregate (const String& aggregateName, const Array<MemberDevice>& memberDevices)
+{
+    jassert (! memberDevices.isEmpty());
+
+    removeAggregate (aggregateName);
+    aggregates.add ({ aggregateName, memberDevices });
+    callDeviceChangeListeners();
+}
+
+void AggregateAudioIODeviceType::removeAggregate (const String& aggregateName)
+{
+    for (int i = aggregates.size(); --i >= 0;)
+        if (aggregates.getReference (i).name == aggregateName)
+            aggregates.remove (i);
+}
+
+void AggregateAudioIODeviceType::scanForDevices() {}
+
+StringArray AggregateAudioIODeviceType::getDeviceNames (bool) const
+{
+    StringArray names;
+
+    for (auto& aggregate : aggregates)
+        names.add (aggregate.name);
+
+    return names;
+}
+
+int AggregateAudioIODeviceType::getDefaultDeviceIndex (bool) const
+{
+    return 0;
+}
+
+int AggregateAudioIODeviceType::getIndexOfDevice (AudioIODevice* device, bool asInput) const
+{
+    if (dynamic_cast<AggregateAudioIODevice*> (device) != nullptr)
+        return getDeviceNames (asInput).indexOf (device->getName());
+
+    return -1;
+}
+
+bool AggregateAudioIODeviceType::hasSeparateInputsAndOutputs() const
+{
+    return false;
+}
+
+AudioIODevice* AggregateAudioIODeviceType::createDevice (const String& outputDeviceName, const String& inputDeviceName)
+{
+    auto name = outputDeviceName.isNotEmpty() ? outputDeviceName : inputDeviceName;
+
+    for (auto& aggregate : aggregates)
+    {
+        if (aggregate.name != name)
+            continue;
+
+        OwnedArray<AudioIODevice> devices;
+
+        for (auto& memberDevice : aggregate.members)
+        {
+            AudioIODevice* device = nullptr;
+
+            for (auto* type : manager.getAvailableDeviceTypes())
+                if (type != this && type->getTypeName() == memberDevice.typeName)
+                    device = type->createDevice (memberDevice.outputDeviceName, memberDevice.inputDeviceName);
+
+            if (device == nullptr)
+                return nullptr;
+
+            devices.add (device);
+        }
+
+        return new AggregateAudioIODevice (name, devices);
+    }
+
+    return nullptr;
+}
+
+} // namespace juce
@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioIODevice that combines several other devices into one.
+
+    The first device is the clock master: the aggregate's callback runs on its audio
+    thread, at its sample rate and block size. Each of the other devices runs on its own
+    clock, and its audio is passed to and from the master through a FIFO and an adaptive
+    resampler. The resampler's ratio is continuously adjusted to keep the FIFO's fill level
+    steady, which compensates for any drift between the devices' clocks (and also lets the
+    devices run at different nominal rates).
+
+    The aggregate's channels are the channels of all its devices, in order, with each
+    name prefixed by its device's name. The latency that it reports is that of its slowest
+    channels, i.e. the member device's own latency plus the time that its audio spends in
+    the FIFO; use getMemberInputLatencyInSamples() and getMemberOutputLatencyInSamples()
+    for the latency of each device's channels.
+
+    @see AggregateAudioIODeviceType
+
+    @tags{Audio}
+*/
+class JUCE_API  AggregateAudioIODevice  : public AudioIODevice,
+                                          private AudioIODeviceCallback
+{
+public:
+    //==============================================================================
+    /** Creates an aggregate of some devices, taking ownership of them and leaving the
+        array empty. The first device in the array will be the clock master.
+    */
+    AggregateAudioIODevice (const String& deviceName,
+                            OwnedArray<AudioIODevice>& devicesToUse);
+
+    /** Destructor. */
+    ~AggregateAudioIODevice() override;
+
+    //==============================================================================
+    /** Returns the number of devices in the aggregate. */
+    int getNumMemberDevices() const noexcept;
+
+    /** Returns one of the devices in the aggregate. Device 0 is the clock master. */
+    AudioIODevice* getMemberDevice (int index) const noexcept;
+
+    /** Returns the input latency of one member device's channels, in samples at the
+        aggregate's sample rate.
+    */
+    int getMemberInputLatencyInSamples (int index);
+
+    /** Returns the output latency of one member device's channels, in samples at the
+        aggregate's sample rate.
+    */
+    int getMemberOutputLatencyInSamples (int index);
+
+    /** Returns the current resampling ratio correction applied to one of the non-master
+        devices, as a proportion (e.g. 0.0001 means that its clock is running 100ppm fast).
+        This always returns 0 for the master, or if the device isn't running.
+    */
+    double getMemberClockDrift (int index) const noexcept;
+
+    //==============================================================================
+    /** @internal */
+    StringArray getOutputChannelNames() override;
+    /** @internal */
+    StringArray getInputChannelNames() override;
+    /** @internal */
+    Array<double> getAvailableSampleRates() override;
+    /** @internal */
+    Array<int> getAvailableBufferSizes() override;
+    /** @internal */
+    int getDefaultBufferSize() override;
+    /** @internal */
+    String open (const BigInteger& inputChannels, const BigInteger& outputChannels,
+                 double sampleRate, int bufferSizeSamples) override;
+    /** @internal */
+    void close() override;
+    /** @internal */
+    bool isOpen() override;
+    /** @internal */
+    void start (AudioIODeviceCallback*) override;
+    /** @internal */
+    void stop() override;
+    /** @internal */
+    bool isPlaying() override;
+    /** @internal */
+    String getLastError() override;
+    /** @internal */
+    int getCurrentBufferSizeSamples() override;
+    /** @internal */
+    double getCurrentSampleRate() override;
+    /** @internal */
+    int getCurrentBitDepth() override;
+    /** @internal */
+    BigInteger getActiveOutputChannels() const override;
+    /** @internal */
+    BigInteger getActiveInputChannels() const override;
+    /** @internal */
+    int getOutputLatencyInSamples() override;
+    /** @internal */
+    int getInputLatencyInSamples() override;
+    /** @internal */
+    int getXRunCount() const noexcept override;
+    /** @internal */
+    AudioWorkgroup getWorkgroup() const override;
+
+private:
+    //==============================================================================
+    struct Member;
+    OwnedArray<Member> members;
+
+    CriticalSection callbackLock;
+    AudioIODeviceCallback* callback = nullptr;
+    Array<const float*> callbackInputs;
+    Array<float*> callbackOutputs;
+    BigInteger activeInputs, activeOutputs;
+    String lastError;
+    bool deviceIsOpen = false, deviceIsPlaying = false, masterChannelsAreHidden = false;
+
+    void audioDeviceIOCallback (const float**, int, float**, int, int) override;
+    void audioDeviceAboutToStart (AudioIODevice*) override;
+    void audioDeviceStopped() override;
+    void audioDeviceError (const String&) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODevice)
+};
+
+//==============================================================================
+/**
+    An AudioIODeviceType whose devices are aggregates of devices from the other
+    types that an AudioDeviceManager provides.
+
+    You define the aggregates by name, then add the type to the same AudioDeviceManager,
+    and they'll show up alongside that manager's other devices:
+
+    @code
+    auto* aggregates = new AggregateAudioIODeviceType (deviceManager);
+    aggregates->addAggregate ("Two interfaces", { { "ALSA", "hw:USB1", "hw:USB1" },
+                                                  { "ALSA", "hw:USB2", "hw:USB2" } });
+    deviceManager.addAudioDeviceType (aggregates);
+    @endcode
+
+    @see AggregateAudioIODevice
+
+    @tags{Audio}
+*/
+class JUCE_API  AggregateAudioIODeviceType  : public AudioIODeviceType
+{
+public:
+    //==============================================================================
+    /** Describes one of the devices in an aggregate. Either of the names can be empty
+        if the device should only be used for input or output.
+    */
+    struct MemberDevice
+    {
+        String typeName, inputDeviceName, outputDeviceName;
+    };
+
+    /** Creates the type. The member devices will be created by the types that this
+        AudioDeviceManager provides, so the manager must outlive this object (which
+        it will do if you add this type to it).
+    */
+    explicit AggregateAudioIODeviceType (AudioDeviceManager& managerToUseForDeviceTypes);
+
+    /** Destructor. */
+    ~AggregateAudioIODeviceType() override;
+
+    //==============================================================================
+    /** Defines an aggregate device, replacing any previous one with the same name.
+        The first member will be the clock master.
+    */
+    void addAggregate (const String& aggregateName, const Array<MemberDevice>& memberDevices);
+
+    /** Removes an aggregate that was added with addAggregate(). */
+    void removeAggregate (const String& aggregateName);
+
+    //==============================================================================
+    /** @internal */
+    void scanForDevices() override;
+    /** @internal */
+    StringArray getDeviceNames (bool wantInputNames = false) const override;
+    /** @internal */
+    int getDefaultDeviceIndex (bool forInput) const override;
+    /** @internal */
+    int getIndexOfDevice (AudioIODevice*, bool asInput) const override;
+    /** @internal */
+    bool hasSeparateInputsAndOutputs() const override;
+    /** @internal */
+    AudioIODevice* createDevice (const String& outputDeviceName, const String& inputDeviceName) override;
+
+private:
+    //==============================================================================
+    struct Aggregate
+    {
+        String name;
+        Array<MemberDevice> members;
+    };
+
+    AudioDeviceManager& manager;
+    Array<Aggregate> aggregates;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AggregateAudioIODeviceType)
+};
+
+} // namespace juce
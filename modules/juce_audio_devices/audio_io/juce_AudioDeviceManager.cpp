@@ -84,6 +84,180 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CallbackHandler)
 };
 
+//==============================================================================
+struct AudioDeviceManager::CallbackThreadPool
+{
+    CallbackThreadPool (int numThreads, const Thread::RealtimeOptions& options)
+    {
+        for (int i = 0; i < numThreads; ++i)
+            workers.add (new Worker (*this, i));
+
+        for (auto* w : workers)
+            w->startRealtimeThread (options);
+    }
+
+    ~CallbackThreadPool()
+    {
+        for (auto* w : workers)
+        {
+            w->signalThreadShouldExit();
+            w->wakeUp.signal();
+        }
+
+        for (auto* w : workers)
+            w->stopThread (2000);
+    }
+
+    int getNumThreads() const noexcept      { return workers.size(); }
+
+    /** Pre-allocates an output buffer for each callback after the first one. */
+    void prepare (int numCallbacks, int numChannels, int numSamples)
+    {
+        while (buffers.size() < numCallbacks - 1)
+            buffers.add (new AudioBuffer<float>());
+
+        for (auto* b : buffers)
+            b->setSize (jmax (1, numChannels), jmax (1, numSamples), false, false, true);
+    }
+
+    /** Sets the workgroup that the workers should belong to. Each worker re-joins the
+        next time it picks up a block.
+    */
+    void setWorkgroup (const AudioWorkgroup& newWorkgroup)
+    {
+        if (newWorkgroup != workgroup)
+        {
+            workgroup = newWorkgroup;
+            ++workgroupGeneration;
+        }
+    }
+
+    bool canProcess (int numCallbacks) const noexcept
+    {
+        return numCallbacks > 1 && buffers.size() >= numCallbacks - 1;
+    }
+
+    /** Runs all the callbacks, sharing them between the workers and the calling thread,
+        and returns once they've all finished, leaving their summed output in outs.
+    */
+    void process (const Array<AudioIODeviceCallback*>& callbacksToRun,
+                  const float** ins, int numIns, float** outs, int numOuts, int numSamples)
+    {
+        jassert (canProcess (callbacksToRun.size()));
+
+        // these were sized in prepare(), so this only re-allocates if the device's block size has grown
+        for (int i = 0; i < callbacksToRun.size() - 1; ++i)
+            buffers.getUnchecked (i)->setSize (jmax (1, numOuts), jmax (1, numSamples), false, false, true);
+
+        currentJob = { &callbacksToRun, ins, numIns, outs, numOuts, numSamples };
+        nextCallback = 0;
+        jobIsActive = true;
+
+        for (auto* w : workers)
+            w->wakeUp.signal();
+
+        runAvailableCallbacks();
+        jobIsActive = false;
+
+        // the calling thread has been doing its share of the work, so by now all that's
+        // left is to wait for whichever callbacks the workers are still in the middle of
+        while (numActiveWorkers.load() > 0)
+            Thread::yield();
+
+        // (summed in the same order as the serial path, so the results are identical)
+        for (int i = callbacksToRun.size() - 1; i > 0; --i)
+        {
+            auto** tempChans = buffers.getUnchecked (i - 1)->getArrayOfWritePointers();
+
+            for (int chan = 0; chan < numOuts; ++chan)
+                if (auto* dst = outs[chan])
+                    FloatVectorOperations::add (dst, tempChans[chan], numSamples);
+        }
+    }
+
+private:
+    struct Job
+    {
+        const Array<AudioIODeviceCallback*>* callbacks;
+        const float** ins;
+        int numIns;
+        float** outs;
+        int numOuts, numSamples;
+    };
+
+    struct Worker  : public Thread
+    {
+        Worker (CallbackThreadPool& p, int index)
+            : Thread ("Audio callback thread " + String (index + 1)), owner (p)
+        {
+        }
+
+        void run() override
+        {
+            std::unique_ptr<AudioWorkgroup::ScopedJoin> membership;
+            int joinedGeneration = 0;
+
+            while (! threadShouldExit())
+            {
+                wakeUp.wait (-1);
+
+                ++owner.numActiveWorkers;
+
+                if (owner.jobIsActive.load() && ! threadShouldExit())
+                {
+                    // the workgroup only changes while no job is active, so it's safe to read here
+                    if (joinedGeneration != owner.workgroupGeneration)
+                    {
+                        membership.reset();
+                        membership.reset (new AudioWorkgroup::ScopedJoin (owner.workgroup));
+                        joinedGeneration = owner.workgroupGeneration;
+                    }
+
+                    owner.runAvailableCallbacks();
+                }
+
+                --owner.numActiveWorkers;
+            }
+        }
+
+        CallbackThreadPool& owner;
+        WaitableEvent wakeUp;
+
+        JUCE_DECLARE_NON_COPYABLE (Worker)
+    };
+
+    void runAvailableCallbacks()
+    {
+        auto& job = currentJob;
+
+        for (;;)
+        {
+            auto index = nextCallback++;
+
+            if (index >= job.callbacks->size())
+                break;
+
+            // the first callback writes straight into the device's buffers, the others into their own
+            auto** outs = index == 0 ? job.outs
+                                     : buffers.getUnchecked (index - 1)->getArrayOfWritePointers();
+
+            job.callbacks->getUnchecked (index)->audioDeviceIOCallback (job.ins, job.numIns,
+                                                                        outs, job.numOuts, job.numSamples);
+        }
+    }
+
+    OwnedArray<Worker> workers;
+    OwnedArray<AudioBuffer<float>> buffers;
+    AudioWorkgroup workgroup;
+    int workgroupGeneration = 0;
+    Job currentJob {};
+    std::atomic<int> nextCallback { 0 };
+    std::atomic<bool> jobIsActive { false };
+    std::atomic<int> numActiveWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (CallbackThreadPool)
+};
+
 //==============================================================================
 AudioDeviceManager::AudioDeviceManager()
 {
@@ -168,8 +342,9 @@ static void addIfNotNull (OwnedArray<AudioIODeviceType>& list, AudioIODeviceType
 
 void AudioDeviceManager::createAudioDeviceTypes (OwnedArray<AudioIODeviceType>& list)
 {
-    addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_WASAPI (false));
-    addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_WASAPI (true));
+    addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_WASAPI (WASAPIDeviceMode::shared));
+    addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_WASAPI (WASAPIDeviceMode::exclusive));
+    addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_WASAPI (WASAPIDeviceMode::sharedLowLatency));
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_DirectSound());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_ASIO());
     addIfNotNull (list, AudioIODeviceType::createAudioIODeviceType_CoreAudio());
@@ -697,6 +872,7 @@ void AudioDeviceManager::addAudioCallback (AudioIODeviceCallback* newCallback)
 
     const ScopedLock sl (audioCallbackLock);
     callbacks.add (newCallback);
+    prepareCallbackThreadPool (currentAudioDevice.get());
 }
 
 void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToRemove)
@@ -717,6 +893,57 @@ void AudioDeviceManager::removeAudioCallback (AudioIODeviceCallback* callbackToR
     }
 }
 
+void AudioDeviceManager::setNumCallbackThreads (int numThreads)
+{
+    jassert (numThreads >= 0);
+    numThreads = jmax (0, numThreads);
+
+    if (numThreads == getNumCallbackThreads())
+        return;
+
+    auto options = Thread::RealtimeOptions();
+
+    if (auto* device = currentAudioDevice.get())
+        options = options.withPeriod (device->getCurrentBufferSizeSamples(), device->getCurrentSampleRate());
+
+    std::unique_ptr<CallbackThreadPool> newPool (numThreads > 0 ? new CallbackThreadPool (numThreads, options) : nullptr);
+
+    {
+        const ScopedLock sl (audioCallbackLock);
+        std::swap (callbackThreadPool, newPool);
+        prepareCallbackThreadPool (currentAudioDevice.get());
+    }
+
+    // (the old threads get stopped here, now that the audio thread can't be using them)
+}
+
+int AudioDeviceManager::getNumCallbackThreads() const noexcept
+{
+    return callbackThreadPool != nullptr ? callbackThreadPool->getNumThreads() : 0;
+}
+
+AudioWorkgroup AudioDeviceManager::getDeviceAudioWorkgroup() const
+{
+    return currentAudioDevice != nullptr ? currentAudioDevice->getWorkgroup() : AudioWorkgroup();
+}
+
+void AudioDeviceManager::prepareCallbackThreadPool (AudioIODevice* device)
+{
+    if (callbackThreadPool != nullptr)
+    {
+        int numChannels = 0, numSamples = 0;
+
+        if (device != nullptr)
+        {
+            numChannels = device->getActiveOutputChannels().countNumberOfSetBits();
+            numSamples = device->getCurrentBufferSizeSamples();
+        }
+
+        callbackThreadPool->prepare (callbacks.size(), numChannels, numSamples);
+        callbackThreadPool->setWorkgroup (device != nullptr ? device->getWorkgroup() : AudioWorkgroup());
+    }
+}
+
 void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelData,
                                                    int numInputChannels,
                                                    float** outputChannelData,
@@ -732,24 +959,32 @@ void AudioDeviceManager::audioDeviceIOCallbackInt (const float** inputChannelDat
     {
         AudioProcessLoadMeasurer::ScopedTimer timer (loadMeasurer);
 
-        tempBuffer.setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
-
-        callbacks.getUnchecked(0)->audioDeviceIOCallback (inputChannelData, numInputChannels,
-                                                          outputChannelData, numOutputChannels, numSamples);
+        if (callbackThreadPool != nullptr && callbackThreadPool->canProcess (callbacks.size()))
+        {
+            callbackThreadPool->process (callbacks, inputChannelData, numInputChannels,
+                                         outputChannelData, numOutputChannels, numSamples);
+        }
+        else
+        {
+            tempBuffer.setSize (jmax (1, numOutputChannels), jmax (1, numSamples), false, false, true);
 
-        auto** tempChans = tempBuffer.getArrayOfWritePointers();
+            callbacks.getUnchecked(0)->audioDeviceIOCallback (inputChannelData, numInputChannels,
+                                                              outputChannelData, numOutputChannels, numSamples);
 
-        for (int i = callbacks.size(); --i > 0;)
-        {
-            callbacks.getUnchecked(i)->audioDeviceIOCallback (inputChannelData, numInputChannels,
-                                                              tempChans, numOutputChannels, numSamples);
+            auto** tempChans = tempBuffer.getArrayOfWritePointers();
 
-            for (int chan = 0; chan < numOutputChannels; ++chan)
+            for (int i = callbacks.size(); --i > 0;)
             {
-                if (auto* src = tempChans [chan])
-                    if (auto* dst = outputChannelData [chan])
-                        for (int j = 0; j < numSamples; ++j)
-                            dst[j] += src[j];
+                callbacks.getUnchecked(i)->audioDeviceIOCallback (inputChannelData, numInputChannels,
+                                                                  tempChans, numOutputChannels, numSamples);
+
+                for (int chan = 0; chan < numOutputChannels; ++chan)
+                {
+                    if (auto* src = tempChans [chan])
+                        if (auto* dst = outputChannelData [chan])
+                            for (int j = 0; j < numSamples; ++j)
+                                dst[j] += src[j];
+                }
             }
         }
     }
@@ -785,6 +1020,8 @@ void AudioDeviceManager::audioDeviceAboutToStartInt (AudioIODevice* const device
 
         for (int i = callbacks.size(); --i >= 0;)
             callbacks.getUnchecked(i)->audioDeviceAboutToStart (device);
+
+        prepareCallbackThreadPool (device);
     }
 
     sendChangeMessage();
@@ -297,6 +297,35 @@ public:
     */
     void removeAudioCallback (AudioIODeviceCallback* callback);
 
+    /** Lets the registered audio callbacks run concurrently on a set of worker threads.
+
+        By default, all the callbacks are run one after the other on the device's audio
+        thread. If you've registered several independent callbacks whose combined cost is
+        too much for one core, this starts the given number of real-time priority threads
+        which share the callbacks between them. The device's audio thread takes part too,
+        and waits for them all to finish before returning, so the summed output is ready
+        by the time the device needs it, and is identical to the serial result.
+
+        Each callback after the first renders into its own pre-allocated buffer, so it must
+        be safe for your callbacks to run at the same time as each other.
+
+        Pass 0 to go back to running everything on the audio thread.
+    */
+    void setNumCallbackThreads (int numThreads);
+
+    /** Returns the number of worker threads set with setNumCallbackThreads(). */
+    int getNumCallbackThreads() const noexcept;
+
+    /** Returns the workgroup of the current device's audio thread, or an invalid one if
+        there's no device open or it doesn't provide one.
+
+        The threads started by setNumCallbackThreads() join this automatically. If you
+        run your own helper threads for the audio callback, they should join it too.
+
+        @see AudioIODevice::getWorkgroup, AudioWorkgroup::ScopedJoin
+    */
+    AudioWorkgroup getDeviceAudioWorkgroup() const;
+
     //==============================================================================
     /** Returns the average proportion of available CPU being spent inside the audio callbacks.
         @returns  A value between 0 and 1.0 to indicate the approximate proportion of CPU
@@ -461,6 +490,11 @@ public:
     */
     int getXRunCount() const noexcept;
 
+    /** Returns the object that measures the time spent in the audio callbacks, which
+        keeps some more detailed statistics about it.
+    */
+    const AudioProcessLoadMeasurer& getLoadMeasurer() const noexcept   { return loadMeasurer; }
+
 private:
     //==============================================================================
     OwnedArray<AudioIODeviceType> availableDeviceTypes;
@@ -498,6 +532,9 @@ private:
     LevelMeter::Ptr inputLevelGetter   { new LevelMeter() },
                     outputLevelGetter  { new LevelMeter() };
 
+    struct CallbackThreadPool;
+    std::unique_ptr<CallbackThreadPool> callbackThreadPool;
+
     //==============================================================================
     class CallbackHandler;
     std::unique_ptr<CallbackHandler> callbackHandler;
@@ -509,6 +546,7 @@ private:
     void audioDeviceErrorInt (const String&);
     void handleIncomingMidiMessageInt (MidiInput*, const MidiMessage&);
     void audioDeviceListChanged();
+    void prepareCallbackThreadPool (AudioIODevice*);
 
     String restartDevice (int blockSizeToUse, double sampleRateToUse,
                           const BigInteger& ins, const BigInteger& outs);
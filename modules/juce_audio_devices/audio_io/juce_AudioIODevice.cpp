@@ -32,8 +32,11 @@ AudioIODevice::~AudioIODevice() {}
 
 void AudioIODeviceCallback::audioDeviceError (const String&)    {}
 bool AudioIODevice::setAudioPreprocessingEnabled (bool)         { return false; }
+bool AudioIODevice::setFreewheelMode (bool)                     { return false; }
+bool AudioIODevice::isFreewheeling() const noexcept             { return false; }
 bool AudioIODevice::hasControlPanel() const                     { return false; }
 int  AudioIODevice::getXRunCount() const noexcept               { return -1; }
+AudioWorkgroup AudioIODevice::getWorkgroup() const              { return {}; }
 
 bool AudioIODevice::showControlPanel()
 {
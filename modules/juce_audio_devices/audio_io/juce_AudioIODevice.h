@@ -299,6 +299,23 @@ public:
     */
     virtual bool setAudioPreprocessingEnabled (bool shouldBeEnabled);
 
+    /** On devices which support it, this switches the device into a mode where it calls
+        the audio callback as fast as it can rather than in real time, which is useful for
+        rendering offline through the same processing chain that's used for playback.
+
+        While the device is freewheeling, its outputs usually aren't being heard, and the
+        callback timing statistics aren't updated. Currently only JACK devices support this;
+        for other types it does nothing and returns false.
+
+        @see isFreewheeling
+    */
+    virtual bool setFreewheelMode (bool shouldFreewheel);
+
+    /** Returns true if the device is currently freewheeling.
+        @see setFreewheelMode
+    */
+    virtual bool isFreewheeling() const noexcept;
+
     //==============================================================================
     /** Returns the number of under- or over runs reported by the OS since
         playback/recording has started.
@@ -312,6 +329,23 @@ public:
     */
     virtual int getXRunCount() const noexcept;
 
+    /** Returns the workgroup that the device's audio thread belongs to.
+
+        Any helper threads that you use to share the work of the audio callback should
+        join this (see AudioWorkgroup::ScopedJoin), so that the system schedules them
+        against the same deadline as the device. Only CoreAudio devices on macOS 11 or
+        later currently provide one; for everything else this returns an invalid workgroup.
+    */
+    virtual AudioWorkgroup getWorkgroup() const;
+
+    /** Returns the callback timing, xrun and latency statistics that the device has
+        collected since it was last started.
+
+        The ALSA, JACK, WASAPI, CoreAudio and ASIO devices fill these in; for other
+        types, the statistics just stay empty.
+    */
+    const AudioIODeviceDiagnostics& getDiagnostics() const noexcept  { return diagnostics; }
+
     //==============================================================================
 protected:
     /** Creates a device, setting its name and type member variables. */
@@ -320,6 +354,9 @@ protected:
 
     /** @internal */
     String name, typeName;
+
+    /** The statistics returned by getDiagnostics(), which subclasses update as they run. */
+    AudioIODeviceDiagnostics diagnostics;
 };
 
 } // namespace juce
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+int AudioIODeviceDiagnostics::Snapshot::getMeasuredRoundTripLatency() const noexcept
+{
+    if (measuredInputLatency < 0 || measuredOutputLatency < 0)
+        return -1;
+
+    return measuredInputLatency + measuredOutputLatency;
+}
+
+AudioIODeviceDiagnostics::Snapshot AudioIODeviceDiagnostics::getSnapshot() const noexcept
+{
+    auto ticksToMs = [] (int64 ticks) { return Time::highResolutionTicksToSeconds (ticks) * 1000.0; };
+
+    Snapshot s;
+    s.numCallbacks       = numCallbacks.load();
+    s.numLateCallbacks   = numLateCallbacks.load();
+    s.expectedIntervalMs = expectedIntervalSeconds.load() * 1000.0;
+    s.minIntervalMs      = ticksToMs (minIntervalTicks.load());
+    s.maxIntervalMs      = ticksToMs (maxIntervalTicks.load());
+
+    // the first callback has no interval before it
+    if (s.numCallbacks > 1)
+        s.meanIntervalMs = ticksToMs (totalIntervalTicks.load()) / (double) (s.numCallbacks - 1);
+
+    for (int i = 0; i < numHistogramBins; ++i)
+        s.intervalHistogram[i] = histogram[i].load();
+
+    s.numUnderruns          = numUnderruns.load();
+    s.numOverruns           = numOverruns.load();
+    s.measuredInputLatency  = inputLatency.load();
+    s.measuredOutputLatency = outputLatency.load();
+    s.outputBufferFill      = outputFill.load();
+    s.minOutputBufferFill   = minOutputFill.load();
+    return s;
+}
+
+void AudioIODeviceDiagnostics::reset() noexcept
+{
+    lastCallbackTicks = 0;
+    numCallbacks = 0;
+    numLateCallbacks = 0;
+    totalIntervalTicks = 0;
+    minIntervalTicks = 0;
+    maxIntervalTicks = 0;
+
+    for (auto& bin : histogram)
+        bin = 0;
+
+    expectedIntervalSeconds = 0;
+    numUnderruns = 0;
+    numOverruns = 0;
+    inputLatency = -1;
+    outputLatency = -1;
+    outputFill = -1;
+    minOutputFill = -1;
+}
+
+// Only the audio thread writes these values, so each update can be a plain load and store.
+void AudioIODeviceDiagnostics::callbackStarted (int numSamples, double sampleRate) noexcept
+{
+    auto now = Time::getHighResolutionTicks();
+    auto last = lastCallbackTicks.load (std::memory_order_relaxed);
+    lastCallbackTicks.store (now, std::memory_order_relaxed);
+    numCallbacks.store (numCallbacks.load (std::memory_order_relaxed) + 1);
+
+    if (last == 0 || sampleRate <= 0)
+        return;
+
+    auto interval = now - last;
+    auto expected = numSamples / sampleRate;
+    expectedIntervalSeconds.store (expected, std::memory_order_relaxed);
+
+    totalIntervalTicks.store (totalIntervalTicks.load (std::memory_order_relaxed) + interval, std::memory_order_relaxed);
+
+    auto minInterval = minIntervalTicks.load (std::memory_order_relaxed);
+
+    if (minInterval == 0 || interval < minInterval)
+        minIntervalTicks.store (interval, std::memory_order_relaxed);
+
+    if (interval > maxIntervalTicks.load (std::memory_order_relaxed))
+        maxIntervalTicks.store (interval, std::memory_order_relaxed);
+
+    auto proportion = Time::highResolutionTicksToSeconds (interval) / expected;
+    auto& bin = histogram[jlimit (0, numHistogramBins - 1, (int) (proportion * 8.0))];
+    bin.store (bin.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (proportion > 1.5)
+        numLateCallbacks.store (numLateCallbacks.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void AudioIODeviceDiagnostics::addUnderruns (int num) noexcept
+{
+    numUnderruns += num;
+}
+
+void AudioIODeviceDiagnostics::addOverruns (int num) noexcept
+{
+    numOverruns += num;
+}
+
+void AudioIODeviceDiagnostics::setMeasuredLatency (int inputSamples, int outputSamples) noexcept
+{
+    inputLatency.store (inputSamples, std::memory_order_relaxed);
+    outputLatency.store (outputSamples, std::memory_order_relaxed);
+}
+
+void AudioIODeviceDiagnostics::setOutputBufferFill (int numSamples) noexcept
+{
+    outputFill.store (numSamples, std::memory_order_relaxed);
+
+    auto minFill = minOutputFill.load (std::memory_order_relaxed);
+
+    if (minFill < 0 || numSamples < minFill)
+        minOutputFill.store (numSamples, std::memory_order_relaxed);
+}
+
+} // namespace juce
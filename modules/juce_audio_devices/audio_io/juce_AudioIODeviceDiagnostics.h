@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Collects timing and xrun statistics for an AudioIODevice while it's running.
+
+    Every AudioIODevice has one of these, which you can get with
+    AudioIODevice::getDiagnostics(). The device's audio thread records into it without
+    locking, and you can call getSnapshot() from any thread to see the results.
+
+    If you're writing an AudioIODevice, call reset() when the device starts, then
+    callbackStarted() at the start of each callback, plus any of the other methods
+    for the information that your driver provides. addUnderruns() and addOverruns()
+    can be called from any thread, but the other methods apart from reset() and
+    getSnapshot() must only be called from the device's audio thread.
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioIODeviceDiagnostics
+{
+public:
+    //==============================================================================
+    AudioIODeviceDiagnostics() = default;
+
+    /** The number of bins in the callback interval histogram. */
+    static constexpr int numHistogramBins = 16;
+
+    /** A copy of the statistics at a moment in time. */
+    struct Snapshot
+    {
+        /** The number of callbacks since the device started. */
+        int64 numCallbacks = 0;
+
+        /** The number of callbacks that started more than one and a half
+            buffer periods after the previous one.
+        */
+        int64 numLateCallbacks = 0;
+
+        /** The buffer period, i.e. the expected time between callbacks. */
+        double expectedIntervalMs = 0;
+
+        /** The shortest, longest and average time between callbacks. */
+        double minIntervalMs = 0, maxIntervalMs = 0, meanIntervalMs = 0;
+
+        /** The number of callbacks for each interval between them, measured relative
+            to the buffer period. Bin i counts intervals from i/8 up to (i+1)/8 of the
+            period, so a device running perfectly puts everything in bins 7 and 8; the
+            last bin also holds anything longer.
+        */
+        int64 intervalHistogram[numHistogramBins] = {};
+
+        /** The number of output underruns and input overruns that the driver has reported.
+            These are only counted by devices whose drivers report them, so check the device's
+            type if you need to tell the difference between none happening and none being reported.
+        */
+        int numUnderruns = 0, numOverruns = 0;
+
+        /** The input and output latency that the driver measured while the device was
+            running, in samples, or -1 if the device can't measure them.
+        */
+        int measuredInputLatency = -1, measuredOutputLatency = -1;
+
+        /** The number of samples that were waiting to be played in the driver's output buffer
+            when it was last checked, and the lowest fill level seen; both are -1 if the device
+            can't measure this.
+        */
+        int outputBufferFill = -1, minOutputBufferFill = -1;
+
+        /** Returns the sum of the measured input and output latencies, or -1 if either is unknown. */
+        int getMeasuredRoundTripLatency() const noexcept;
+    };
+
+    /** Returns a copy of the current statistics. This can be called from any thread;
+        as the audio thread may be updating them at the same time, the fields aren't
+        guaranteed to be exactly consistent with each other.
+    */
+    Snapshot getSnapshot() const noexcept;
+
+    //==============================================================================
+    /** Clears all the statistics. Devices call this before they start running. */
+    void reset() noexcept;
+
+    /** Records the start of a callback. */
+    void callbackStarted (int numSamples, double sampleRate) noexcept;
+
+    /** Records some output underruns reported by the driver. */
+    void addUnderruns (int numUnderruns) noexcept;
+
+    /** Records some input overruns reported by the driver. */
+    void addOverruns (int numOverruns) noexcept;
+
+    /** Records the driver's current measurement of the latency, in samples. Either value
+        can be -1 if it's not known.
+    */
+    void setMeasuredLatency (int inputSamples, int outputSamples) noexcept;
+
+    /** Records the number of samples waiting to be played in the driver's output buffer. */
+    void setOutputBufferFill (int numSamples) noexcept;
+
+private:
+    //==============================================================================
+    std::atomic<int64> lastCallbackTicks { 0 }, numCallbacks { 0 }, numLateCallbacks { 0 }, totalIntervalTicks { 0 };
+    std::atomic<int64> minIntervalTicks { 0 }, maxIntervalTicks { 0 };
+    std::atomic<int64> histogram[numHistogramBins] = {};
+    std::atomic<double> expectedIntervalSeconds { 0 };
+    std::atomic<int> numUnderruns { 0 }, numOverruns { 0 };
+    std::atomic<int> inputLatency { -1 }, outputLatency { -1 }, outputFill { -1 }, minOutputFill { -1 };
+
+    JUCE_DECLARE_NON_COPYABLE (AudioIODeviceDiagnostics)
+};
+
+} // namespace juce
@@ -51,9 +51,15 @@ AudioIODeviceType* AudioIODeviceType::createAudioIODeviceType_iOSAudio()
 #endif
 
 #if ! (JUCE_WINDOWS && JUCE_WASAPI)
-AudioIODeviceType* AudioIODeviceType::createAudioIODeviceType_WASAPI (bool)     { return nullptr; }
+AudioIODeviceType* AudioIODeviceType::createAudioIODeviceType_WASAPI (WASAPIDeviceMode)     { return nullptr; }
 #endif
 
+AudioIODeviceType* AudioIODeviceType::createAudioIODeviceType_WASAPI (bool exclusiveMode)
+{
+    return createAudioIODeviceType_WASAPI (exclusiveMode ? WASAPIDeviceMode::exclusive
+                                                         : WASAPIDeviceMode::shared);
+}
+
 #if ! (JUCE_WINDOWS && JUCE_DIRECTSOUND)
 AudioIODeviceType* AudioIODeviceType::createAudioIODeviceType_DirectSound()     { return nullptr; }
 #endif
@@ -23,6 +23,30 @@
 namespace juce
 {
 
+//==============================================================================
+/**
+    The different ways in which a WASAPI device type can use the audio endpoints.
+
+    - shared: the normal shared mode, which mixes with other applications and runs at
+      the audio engine's default period (usually 10ms).
+    - exclusive: takes exclusive control of the endpoint, so the buffer size can be
+      anything the driver supports, but no other application can use the device.
+    - sharedLowLatency: still mixes with other applications, but asks the audio engine
+      for one of the small periods that drivers can offer, using IAudioClient3. This is
+      only available on Windows 10 and later, and with drivers that don't offer any
+      periods below the default, it behaves like the shared mode.
+
+    @see AudioIODeviceType::createAudioIODeviceType_WASAPI
+
+    @tags{Audio}
+*/
+enum class WASAPIDeviceMode
+{
+    shared,
+    exclusive,
+    sharedLowLatency
+};
+
 //==============================================================================
 /**
     Represents a type of audio driver, such as DirectSound, ASIO, CoreAudio, etc.
@@ -150,6 +174,10 @@ public:
     /** Creates an iOS device type if it's available on this platform, or returns null. */
     static AudioIODeviceType* createAudioIODeviceType_iOSAudio();
     /** Creates a WASAPI device type if it's available on this platform, or returns null. */
+    static AudioIODeviceType* createAudioIODeviceType_WASAPI (WASAPIDeviceMode deviceMode);
+    /** Creates a WASAPI device type in either the shared or exclusive mode, if it's available
+        on this platform, or returns null.
+    */
     static AudioIODeviceType* createAudioIODeviceType_WASAPI (bool exclusiveMode);
     /** Creates a DirectSound device type if it's available on this platform, or returns null. */
     static AudioIODeviceType* createAudioIODeviceType_DirectSound();
@@ -55,6 +55,10 @@
  #undef Point
  #undef Component
 
+ #if JUCE_AUDIO_WORKGROUP_TYPES_AVAILABLE
+  #include <os/workgroup.h>
+ #endif
+
 #elif JUCE_IOS
  #import <AudioToolbox/AudioToolbox.h>
  #import <AVFoundation/AVFoundation.h>
@@ -177,7 +181,9 @@
 
 #include "audio_io/juce_AudioDeviceManager.cpp"
 #include "audio_io/juce_AudioIODevice.cpp"
+#include "audio_io/juce_AudioIODeviceDiagnostics.cpp"
 #include "audio_io/juce_AudioIODeviceType.cpp"
+#include "audio_io/juce_AggregateAudioIODevice.cpp"
 #include "midi_io/juce_MidiMessageCollector.cpp"
 #include "midi_io/juce_MidiOutput.cpp"
 #include "sources/juce_AudioSourcePlayer.cpp"
@@ -117,6 +117,24 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_MMAP
+    When enabled, ALSA devices that support it are driven through their memory-mapped
+    ring buffer, so that samples are converted directly to and from the device without
+    an intermediate copy. Devices that only offer read/write access are unaffected.
+*/
+#ifndef JUCE_ALSA_MMAP
+ #define JUCE_ALSA_MMAP 1
+#endif
+
+/** Config: JUCE_ALSA_TIMER_SCHEDULING
+    Enables a low-latency ALSA mode in which the device is configured with two periods,
+    period interrupts are disabled where the driver allows it, and the audio thread is
+    woken by a timer instead. This is mostly useful for USB interfaces.
+*/
+#ifndef JUCE_ALSA_TIMER_SCHEDULING
+ #define JUCE_ALSA_TIMER_SCHEDULING 0
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices (Linux only).
 */
@@ -174,12 +192,14 @@
 #include "midi_io/juce_MidiInput.h"
 #include "midi_io/juce_MidiMessageCollector.h"
 #include "midi_io/juce_MidiOutput.h"
+#include "audio_io/juce_AudioIODeviceDiagnostics.h"
 #include "audio_io/juce_AudioIODevice.h"
 #include "audio_io/juce_AudioIODeviceType.h"
 #include "audio_io/juce_SystemAudioVolume.h"
 #include "sources/juce_AudioSourcePlayer.h"
 #include "sources/juce_AudioTransportSource.h"
 #include "audio_io/juce_AudioDeviceManager.h"
+#include "audio_io/juce_AggregateAudioIODevice.h"
 
 #if JUCE_IOS
  #include "native/juce_ios_Audio.h"
@@ -23,8 +23,12 @@
 namespace juce
 {
 
-MidiMessageCollector::MidiMessageCollector()
+MidiMessageCollector::MidiMessageCollector (int queueSizeInBytes)
+    : fifo (jmax (256, queueSizeInBytes))
 {
+    fifoData.calloc ((size_t) fifo.getTotalSize());
+    messageScratch.malloc ((size_t) fifo.getTotalSize());
+    incomingMessages.ensureSize (2048);
 }
 
 MidiMessageCollector::~MidiMessageCollector()
@@ -36,11 +40,12 @@ void MidiMessageCollector::reset (const double newSampleRate)
 {
     jassert (newSampleRate > 0);
 
-    const ScopedLock sl (midiCallbackLock);
+    const SpinLock::ScopedLockType sl (producerLock);
    #if JUCE_DEBUG
     hasCalledReset = true;
    #endif
     sampleRate = newSampleRate;
+    fifo.reset();
     incomingMessages.clear();
     lastCallbackTime = Time::getMillisecondCounterHiRes();
 }
@@ -55,16 +60,79 @@ void MidiMessageCollector::addMessageToQueue (const MidiMessage& message)
     // for details of what the number should be.
     jassert (message.getTimeStamp() != 0);
 
-    const ScopedLock sl (midiCallbackLock);
+    QueuedMessageHeader header { message.getTimeStamp(), message.getRawDataSize() };
+    auto totalSize = (int) sizeof (header) + header.numBytes;
 
-    auto sampleNumber = (int) ((message.getTimeStamp() - 0.001 * lastCallbackTime) * sampleRate);
+    // (this lock only stops several producers from writing at once - the audio thread never takes it)
+    const SpinLock::ScopedLockType sl (producerLock);
 
-    incomingMessages.addEvent (message, sampleNumber);
+    // if the audio thread isn't keeping up, the message gets dropped rather than blocking
+    if (fifo.getFreeSpace() < totalSize)
+        return;
 
-    // if the messages don't get used for over a second, we'd better
-    // get rid of any old ones to avoid the queue getting too big
-    if (sampleNumber > sampleRate)
-        incomingMessages.clear (0, sampleNumber - (int) sampleRate);
+    writeToFifo (&header, (int) sizeof (header));
+    writeToFifo (message.getRawData(), header.numBytes);
+}
+
+void MidiMessageCollector::writeToFifo (const void* data, int numBytes) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite (numBytes, start1, size1, start2, size2);
+    jassert (size1 + size2 == numBytes);
+
+    memcpy (fifoData + start1, data, (size_t) size1);
+
+    if (size2 > 0)
+        memcpy (fifoData + start2, addBytesToPointer (data, size1), (size_t) size2);
+
+    fifo.finishedWrite (size1 + size2);
+}
+
+void MidiMessageCollector::readFromFifo (void* dest, int numBytes, bool shouldConsume) noexcept
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead (numBytes, start1, size1, start2, size2);
+    jassert (size1 + size2 == numBytes);
+
+    memcpy (dest, fifoData + start1, (size_t) size1);
+
+    if (size2 > 0)
+        memcpy (addBytesToPointer (dest, size1), fifoData + start2, (size_t) size2);
+
+    if (shouldConsume)
+        fifo.finishedRead (size1 + size2);
+}
+
+void MidiMessageCollector::collectQueuedMessages (double previousCallbackTime)
+{
+    incomingMessages.clear();
+
+    for (;;)
+    {
+        QueuedMessageHeader header;
+
+        if (fifo.getNumReady() < (int) sizeof (header))
+            break;
+
+        readFromFifo (&header, (int) sizeof (header), false);
+
+        // the header's written before the message data, so the rest might not have arrived yet
+        if (fifo.getNumReady() < (int) sizeof (header) + header.numBytes)
+            break;
+
+        fifo.finishedRead ((int) sizeof (header));
+        readFromFifo (messageScratch, header.numBytes, true);
+
+        auto sampleNumber = (int) ((header.timeStamp - 0.001 * previousCallbackTime) * sampleRate);
+        incomingMessages.addEvent (messageScratch, header.numBytes, sampleNumber);
+    }
+
+    // if the messages didn't get used for over a second, we'd better
+    // get rid of any old ones to avoid the block getting too big
+    auto lastSampleNumber = incomingMessages.getLastEventTime();
+
+    if (lastSampleNumber > sampleRate)
+        incomingMessages.clear (0, lastSampleNumber - (int) sampleRate);
 }
 
 void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
@@ -79,7 +147,7 @@ void MidiMessageCollector::removeNextBlockOfMessages (MidiBuffer& destBuffer,
     auto timeNow = Time::getMillisecondCounterHiRes();
     auto msElapsed = timeNow - lastCallbackTime;
 
-    const ScopedLock sl (midiCallbackLock);
+    collectQueuedMessages (lastCallbackTime);
     lastCallbackTime = timeNow;
 
     if (! incomingMessages.isEmpty())
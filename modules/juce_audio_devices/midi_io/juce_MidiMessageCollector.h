@@ -31,6 +31,10 @@ namespace juce
     The class can also be used as either a MidiKeyboardStateListener or a MidiInputCallback
     so it can easily use a midi input or keyboard component as its source.
 
+    Incoming messages are passed to the audio thread through a lock-free FIFO, so
+    removeNextBlockOfMessages() never blocks. If there are several threads adding
+    messages, they only contend with each other.
+
     @see MidiMessage, MidiInput
 
     @tags{Audio}
@@ -40,8 +44,12 @@ class JUCE_API  MidiMessageCollector    : public MidiKeyboardStateListener,
 {
 public:
     //==============================================================================
-    /** Creates a MidiMessageCollector. */
-    MidiMessageCollector();
+    /** Creates a MidiMessageCollector.
+
+        The queue can hold this many bytes of pending messages (including a small
+        overhead per message). Any messages that arrive while it's full are dropped.
+    */
+    explicit MidiMessageCollector (int queueSizeInBytes = 65536);
 
     /** Destructor. */
     ~MidiMessageCollector() override;
@@ -91,14 +99,26 @@ public:
 
 private:
     //==============================================================================
+    struct QueuedMessageHeader
+    {
+        double timeStamp;
+        int numBytes;
+    };
+
     double lastCallbackTime = 0;
-    CriticalSection midiCallbackLock;
+    SpinLock producerLock;
+    AbstractFifo fifo;
+    HeapBlock<uint8> fifoData, messageScratch;
     MidiBuffer incomingMessages;
     double sampleRate = 44100.0;
    #if JUCE_DEBUG
     bool hasCalledReset = false;
    #endif
 
+    void writeToFifo (const void* data, int numBytes) noexcept;
+    void readFromFifo (void* dest, int numBytes, bool shouldConsume) noexcept;
+    void collectQueuedMessages (double previousCallbackTime);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiMessageCollector)
 };
 
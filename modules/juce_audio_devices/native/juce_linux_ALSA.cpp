@@ -156,7 +156,10 @@ public:
           latency (0),
           deviceID (devID),
           isInput (forInput),
-          isInterleaved (true)
+          isInterleaved (true),
+          isUsingMmap (false),
+          isUsingTimerScheduling (false),
+          actualSampleRate (44100.0)
     {
         JUCE_ALSA_LOG ("snd_pcm_open (" << deviceID.toUTF8().getAddress() << ", forInput=" << (int) forInput << ")");
 
@@ -210,6 +213,24 @@ public:
             return false;
         }
 
+        isUsingMmap = false;
+        isUsingTimerScheduling = false;
+
+       #if JUCE_ALSA_MMAP
+        // Mapping the device's ring buffer lets the converter write straight into it,
+        // instead of going through the scratch buffer and a second copy in snd_pcm_writei.
+        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+        {
+            isInterleaved = true;
+            isUsingMmap = true;
+        }
+        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_NONINTERLEAVED) >= 0)
+        {
+            isInterleaved = false;
+            isUsingMmap = true;
+        }
+        else
+       #endif
         if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
             isInterleaved = true;
         else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
@@ -258,18 +279,35 @@ public:
         }
 
         int dir = 0;
+       #if JUCE_ALSA_TIMER_SCHEDULING
+        unsigned int periods = 2;
+       #else
         unsigned int periods = 4;
+       #endif
         snd_pcm_uframes_t samplesPerPeriod = (snd_pcm_uframes_t) bufferSize;
 
         if (JUCE_ALSA_FAILED (snd_pcm_hw_params_set_rate_near (handle, hwParams, &sampleRate, 0))
             || JUCE_ALSA_FAILED (snd_pcm_hw_params_set_channels (handle, hwParams, (unsigned int ) numChannels))
             || JUCE_ALSA_FAILED (snd_pcm_hw_params_set_periods_near (handle, hwParams, &periods, &dir))
-            || JUCE_ALSA_FAILED (snd_pcm_hw_params_set_period_size_near (handle, hwParams, &samplesPerPeriod, &dir))
-            || JUCE_ALSA_FAILED (snd_pcm_hw_params (handle, hwParams)))
+            || JUCE_ALSA_FAILED (snd_pcm_hw_params_set_period_size_near (handle, hwParams, &samplesPerPeriod, &dir)))
         {
             return false;
         }
 
+       #if JUCE_ALSA_TIMER_SCHEDULING
+        // With the period interrupts switched off, the device thread sleeps until the
+        // hardware pointer should have advanced by one block, rather than waiting for the
+        // driver to wake it. That lets USB interfaces run with a single period of latency.
+        if (snd_pcm_hw_params_can_disable_period_wakeup (hwParams)
+             && snd_pcm_hw_params_set_period_wakeup (handle, hwParams, 0) >= 0)
+            isUsingTimerScheduling = true;
+       #endif
+
+        if (JUCE_ALSA_FAILED (snd_pcm_hw_params (handle, hwParams)))
+            return false;
+
+        actualSampleRate = (double) sampleRate;
+
         snd_pcm_uframes_t frames = 0;
 
         if (JUCE_ALSA_FAILED (snd_pcm_hw_params_get_period_size (hwParams, &frames, &dir))
@@ -279,7 +317,8 @@ public:
             latency = (int) frames * ((int) periods - 1); // (this is the method JACK uses to guess the latency..)
 
         JUCE_ALSA_LOG ("frames: " << (int) frames << ", periods: " << (int) periods
-                          << ", samplesPerPeriod: " << (int) samplesPerPeriod);
+                          << ", samplesPerPeriod: " << (int) samplesPerPeriod
+                          << ", mmap: " << (int) isUsingMmap << ", timer scheduling: " << (int) isUsingTimerScheduling);
 
         snd_pcm_sw_params_t* swParams;
         snd_pcm_sw_params_alloca (&swParams);
@@ -314,6 +353,10 @@ public:
     {
         jassert (numChannelsRunning <= outputChannelBuffer.getNumChannels());
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
+
+        if (isUsingMmap)
+            return transferViaMmap (data, numSamples);
+
         snd_pcm_sframes_t numDone = 0;
 
         if (isInterleaved)
@@ -348,11 +391,21 @@ public:
         return true;
     }
 
+    // returns the number of frames between the hardware and the application, or -1 if unknown
+    int getDelay() const noexcept
+    {
+        snd_pcm_sframes_t delay = 0;
+        return snd_pcm_delay (handle, &delay) == 0 ? (int) delay : -1;
+    }
+
     bool readFromInputDevice (AudioBuffer<float>& inputChannelBuffer, const int numSamples)
     {
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
+        if (isUsingMmap)
+            return transferViaMmap (data, numSamples);
+
         if (isInterleaved)
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
@@ -399,6 +452,41 @@ public:
         return true;
     }
 
+    /** Blocks until at least numFrames can be transferred, the timeout expires, or an
+        error occurs. Returns the same values as snd_pcm_wait: 1 when ready, 0 on timeout,
+        or a negative error code.
+    */
+    int waitForFrames (snd_pcm_uframes_t numFrames, int timeoutMs)
+    {
+        if (! isUsingTimerScheduling)
+            return snd_pcm_wait (handle, timeoutMs);
+
+        auto deadline = Time::getMillisecondCounter() + (uint32) timeoutMs;
+
+        for (;;)
+        {
+            auto avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+                return (int) avail;
+
+            if ((snd_pcm_uframes_t) avail >= numFrames || snd_pcm_state (handle) != SND_PCM_STATE_RUNNING)
+                return 1;
+
+            if (Time::getMillisecondCounter() >= deadline)
+                return 0;
+
+            // sleep for roughly the time the hardware needs to reach the target, but
+            // never for less than 100us, so that a slow clock can't make us spin.
+            auto micros = jmax (100.0, (double) (numFrames - (snd_pcm_uframes_t) avail) * 1.0e6 / actualSampleRate);
+
+            struct timespec time;
+            time.tv_sec  = (time_t) (micros / 1.0e6);
+            time.tv_nsec = (long) (std::fmod (micros, 1.0e6) * 1000.0);
+            nanosleep (&time, nullptr);
+        }
+    }
+
     //==============================================================================
     snd_pcm_t* handle;
     String error;
@@ -409,10 +497,131 @@ private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isUsingMmap, isUsingTimerScheduling;
+    double actualSampleRate;
     MemoryBlock scratch;
     std::unique_ptr<AudioData::Converter> converter;
 
+    //==============================================================================
+    static char* getAreaAddress (const snd_pcm_channel_area_t& area, snd_pcm_uframes_t frameOffset) noexcept
+    {
+        return static_cast<char*> (area.addr) + (area.first + area.step * frameOffset) / 8;
+    }
+
+    bool handleXrun (snd_pcm_sframes_t err)
+    {
+        if (err == -(EPIPE))
+        {
+            if (isInput)
+                overrunCount++;
+            else
+                underrunCount++;
+        }
+
+        return ! JUCE_ALSA_FAILED (snd_pcm_recover (handle, (int) err, 1 /* silent */));
+    }
+
+    // Converts directly between the float channel buffers and the device's mapped ring
+    // buffer, committing as many chunks as the ring's wrap-around point requires.
+    bool transferViaMmap (float* const* data, const int numSamples)
+    {
+        int numDone = 0;
+        int retriesLeft = 8;
+
+        while (numDone < numSamples)
+        {
+            if (isInput && snd_pcm_state (handle) == SND_PCM_STATE_PREPARED
+                 && JUCE_ALSA_FAILED (snd_pcm_start (handle)))
+                return false;
+
+            auto avail = snd_pcm_avail_update (handle);
+
+            if (avail < 0)
+            {
+                if (! handleXrun (avail) || --retriesLeft < 0)
+                    return false;
+
+                continue;
+            }
+
+            auto numNeeded = (snd_pcm_uframes_t) (numSamples - numDone);
+
+            if ((snd_pcm_uframes_t) avail < numNeeded && (isInput || avail == 0))
+            {
+                auto result = waitForFrames (numNeeded, 1000);
+
+                if (result < 0)
+                {
+                    if (! handleXrun (result) || --retriesLeft < 0)
+                        return false;
+
+                    continue;
+                }
+
+                if (result == 0)
+                {
+                    JUCE_ALSA_LOG ("Timed out waiting for the device: numDone: " << numDone << ", numSamples: " << numSamples);
+                    break;
+                }
+
+                continue;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0, frames = numNeeded;
+
+            if (JUCE_ALSA_FAILED (snd_pcm_mmap_begin (handle, &areas, &offset, &frames)))
+                return false;
+
+            const int numFrames = (int) frames;
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+            {
+                if (isInterleaved)
+                {
+                    auto* frameStart = getAreaAddress (areas[0], offset);
+
+                    if (isInput)
+                        converter->convertSamples (data[i] + numDone, 0, frameStart, i, numFrames);
+                    else
+                        converter->convertSamples (frameStart, i, data[i] + numDone, 0, numFrames);
+                }
+                else
+                {
+                    auto* channelStart = getAreaAddress (areas[i], offset);
+
+                    if (isInput)
+                        converter->convertSamples (data[i] + numDone, channelStart, numFrames);
+                    else
+                        converter->convertSamples (channelStart, data[i] + numDone, numFrames);
+                }
+            }
+
+            auto committed = snd_pcm_mmap_commit (handle, offset, frames);
+
+            if (committed < 0 || (snd_pcm_uframes_t) committed != frames)
+            {
+                if (! handleXrun (committed >= 0 ? -(EPIPE) : committed) || --retriesLeft < 0)
+                    return false;
+
+                continue;
+            }
+
+            numDone += numFrames;
+        }
+
+        if (numDone < numSamples)
+        {
+            JUCE_ALSA_LOG ("Did not transfer all samples: numDone: " << numDone << ", numSamples: " << numSamples);
+
+            if (isInput)
+                for (int i = 0; i < numChannelsRunning; ++i)
+                    zeromem (data[i] + numDone, sizeof (float) * (size_t) (numSamples - numDone));
+        }
+
+        return true;
+    }
+
     //==============================================================================
     template <class SampleType>
     struct ConverterHelper
@@ -486,10 +695,12 @@ private:
 class ALSAThread  : public Thread
 {
 public:
-    ALSAThread (const String& inputDeviceID, const String& outputDeviceID)
+    ALSAThread (const String& inputDeviceID, const String& outputDeviceID,
+                AudioIODeviceDiagnostics& diagnosticsToUpdate)
         : Thread ("JUCE ALSA"),
           inputId (inputDeviceID),
-          outputId (outputDeviceID)
+          outputId (outputDeviceID),
+          diagnostics (diagnosticsToUpdate)
     {
         initialiseRatesAndChannels();
     }
@@ -666,6 +877,8 @@ public:
         outputChannelBuffer.setSize (1, 1);
 
         numCallbacks = 0;
+        numUnderrunsReported = 0;
+        numOverrunsReported = 0;
     }
 
     void setCallback (AudioIODeviceCallback* const newCallback) noexcept
@@ -678,11 +891,13 @@ public:
     {
         while (! threadShouldExit())
         {
+            int inputDelay = -1, outputDelay = -1;
+
             if (inputDevice != nullptr && inputDevice->handle != nullptr)
             {
                 if (outputDevice == nullptr || outputDevice->handle == nullptr)
                 {
-                    JUCE_ALSA_FAILED (snd_pcm_wait (inputDevice->handle, 2000));
+                    JUCE_ALSA_FAILED (inputDevice->waitForFrames ((snd_pcm_uframes_t) bufferSize, 2000));
 
                     if (threadShouldExit())
                         break;
@@ -693,6 +908,7 @@ public:
                         JUCE_ALSA_FAILED (snd_pcm_recover (inputDevice->handle, (int) avail, 0));
                 }
 
+                inputDelay = inputDevice->getDelay();
                 audioIoInProgress = true;
 
                 if (! inputDevice->readFromInputDevice (inputChannelBuffer, bufferSize))
@@ -713,6 +929,8 @@ public:
 
                 if (callback != nullptr)
                 {
+                    diagnostics.callbackStarted (bufferSize, sampleRate);
+
                     callback->audioDeviceIOCallback (inputChannelDataForCallback.getRawDataPointer(),
                                                      inputChannelDataForCallback.size(),
                                                      outputChannelDataForCallback.getRawDataPointer(),
@@ -728,7 +946,7 @@ public:
 
             if (outputDevice != nullptr && outputDevice->handle != nullptr)
             {
-                JUCE_ALSA_FAILED (snd_pcm_wait (outputDevice->handle, 2000));
+                JUCE_ALSA_FAILED (outputDevice->waitForFrames ((snd_pcm_uframes_t) bufferSize, 2000));
 
                 if (threadShouldExit())
                     break;
@@ -738,6 +956,7 @@ public:
                 if (avail < 0)
                     JUCE_ALSA_FAILED (snd_pcm_recover (outputDevice->handle, (int) avail, 0));
 
+                outputDelay = outputDevice->getDelay();
                 audioIoInProgress = true;
 
                 if (! outputDevice->writeToOutputDevice (outputChannelBuffer, bufferSize))
@@ -748,6 +967,8 @@ public:
 
                 audioIoInProgress = false;
             }
+
+            updateDiagnostics (inputDelay, outputDelay);
         }
 
         audioIoInProgress = false;
@@ -764,6 +985,26 @@ public:
         return 16;
     }
 
+    void updateDiagnostics (int inputDelay, int outputDelay) noexcept
+    {
+        if (outputDevice != nullptr)
+        {
+            diagnostics.addUnderruns (outputDevice->underrunCount - numUnderrunsReported);
+            numUnderrunsReported = outputDevice->underrunCount;
+
+            if (outputDelay >= 0)
+                diagnostics.setOutputBufferFill (outputDelay);
+        }
+
+        if (inputDevice != nullptr)
+        {
+            diagnostics.addOverruns (inputDevice->overrunCount - numOverrunsReported);
+            numOverrunsReported = inputDevice->overrunCount;
+        }
+
+        diagnostics.setMeasuredLatency (inputDelay, outputDelay);
+    }
+
     int getXRunCount() const noexcept
     {
         int result = 0;
@@ -791,8 +1032,9 @@ private:
     //==============================================================================
     const String inputId, outputId;
     std::unique_ptr<ALSADevice> outputDevice, inputDevice;
-    int numCallbacks = 0;
+    int numCallbacks = 0, numUnderrunsReported = 0, numOverrunsReported = 0;
     bool audioIoInProgress = false;
+    AudioIODeviceDiagnostics& diagnostics;
 
     CriticalSection callbackLock;
 
@@ -849,7 +1091,7 @@ public:
         : AudioIODevice (deviceName, deviceTypeName),
           inputId (inputDeviceID),
           outputId (outputDeviceID),
-          internal (inputDeviceID, outputDeviceID)
+          internal (inputDeviceID, outputDeviceID, diagnostics)
     {
     }
 
@@ -942,7 +1184,10 @@ public:
             callback = nullptr;
 
         if (callback != nullptr)
+        {
+            diagnostics.reset();
             callback->audioDeviceAboutToStart (this);
+        }
 
         internal.setCallback (callback);
 
@@ -70,6 +70,8 @@ JUCE_DECL_JACK_FUNCTION (jack_port_t* , jack_port_by_id, (jack_client_t* client,
 JUCE_DECL_JACK_FUNCTION (int, jack_port_connected, (const jack_port_t* port), (port));
 JUCE_DECL_JACK_FUNCTION (int, jack_port_connected_to, (const jack_port_t* port, const char* port_name), (port, port_name));
 JUCE_DECL_JACK_FUNCTION (int, jack_set_xrun_callback, (jack_client_t* client, JackXRunCallback xrun_callback, void* arg), (client, xrun_callback, arg));
+JUCE_DECL_JACK_FUNCTION (int, jack_set_freewheel_callback, (jack_client_t* client, JackFreewheelCallback freewheel_callback, void* arg), (client, freewheel_callback, arg));
+JUCE_DECL_JACK_FUNCTION (int, jack_set_freewheel, (jack_client_t* client, int onoff), (client, onoff));
 
 #if JUCE_DEBUG
  #define JACK_LOGGING_ENABLED 1
@@ -195,6 +197,9 @@ public:
 
             inChans.calloc (totalNumberOfInputChannels + 2);
             outChans.calloc (totalNumberOfOutputChannels + 2);
+
+            activeInputPorts.ensureStorageAllocated (totalNumberOfInputChannels);
+            activeOutputPorts.ensureStorageAllocated (totalNumberOfOutputChannels);
         }
     }
 
@@ -264,6 +269,7 @@ public:
         juce::jack_set_port_connect_callback (client, portConnectCallback, this);
         juce::jack_on_shutdown (client, shutdownCallback, this);
         juce::jack_set_xrun_callback (client, xrunCallback, this);
+        juce::jack_set_freewheel_callback (client, freewheelCallback, this);
         juce::jack_activate (client);
         deviceIsOpen = true;
 
@@ -304,15 +310,20 @@ public:
 
         if (client != nullptr)
         {
+            if (freewheeling)
+                juce::jack_set_freewheel (client, 0);
+
             juce::jack_deactivate (client);
 
             juce::jack_set_xrun_callback (client, xrunCallback, nullptr);
+            juce::jack_set_freewheel_callback (client, freewheelCallback, nullptr);
             juce::jack_set_process_callback (client, processCallback, nullptr);
             juce::jack_set_port_connect_callback (client, portConnectCallback, nullptr);
             juce::jack_on_shutdown (client, shutdownCallback, nullptr);
         }
 
         deviceIsOpen = false;
+        freewheeling = false;
     }
 
     void start (AudioIODeviceCallback* newCallback) override
@@ -320,7 +331,13 @@ public:
         if (deviceIsOpen && newCallback != callback)
         {
             if (newCallback != nullptr)
+            {
+                diagnostics.reset();
+
+                // JACK works out the latency of the graph, so this is as close to a measurement as we can get
+                diagnostics.setMeasuredLatency (getInputLatencyInSamples(), getOutputLatencyInSamples());
                 newCallback->audioDeviceAboutToStart (this);
+            }
 
             AudioIODeviceCallback* const oldCallback = callback;
 
@@ -344,6 +361,14 @@ public:
     int getCurrentBitDepth() override                { return 32; }
     String getLastError() override                   { return lastError; }
     int getXRunCount() const noexcept override       { return xruns; }
+    bool isFreewheeling() const noexcept override    { return freewheeling; }
+
+    bool setFreewheelMode (bool shouldFreewheel) override
+    {
+        // (JACK changes the mode asynchronously, and tells freewheelCallback() when it has)
+        return deviceIsOpen && client != nullptr
+                && juce::jack_set_freewheel (client, shouldFreewheel ? 1 : 0) == 0;
+    }
 
     BigInteger getActiveOutputChannels() const override  { return activeOutputChannels; }
     BigInteger getActiveInputChannels()  const override  { return activeInputChannels;  }
@@ -373,28 +398,25 @@ public:
 private:
     void process (const int numSamples)
     {
-        int numActiveInChans = 0, numActiveOutChans = 0;
+        const ScopedLock sl (callbackLock);
 
-        for (int i = 0; i < totalNumberOfInputChannels; ++i)
-        {
-            if (activeInputChannels[i])
-                if (jack_default_audio_sample_t* in
-                        = (jack_default_audio_sample_t*) juce::jack_port_get_buffer ((jack_port_t*) inputPorts.getUnchecked(i), numSamples))
-                    inChans [numActiveInChans++] = (float*) in;
-        }
+        // The ports that are connected are worked out by updateActivePorts(), so all this
+        // needs to do is fetch their buffers, which JACK may move between cycles.
+        auto numActiveInChans  = activeInputPorts.size();
+        auto numActiveOutChans = activeOutputPorts.size();
 
-        for (int i = 0; i < totalNumberOfOutputChannels; ++i)
-        {
-            if (activeOutputChannels[i])
-                if (jack_default_audio_sample_t* out
-                        = (jack_default_audio_sample_t*) juce::jack_port_get_buffer ((jack_port_t*) outputPorts.getUnchecked(i), numSamples))
-                    outChans [numActiveOutChans++] = (float*) out;
-        }
+        for (int i = 0; i < numActiveInChans; ++i)
+            inChans[i] = (float*) juce::jack_port_get_buffer (activeInputPorts.getUnchecked (i), (jack_nframes_t) numSamples);
 
-        const ScopedLock sl (callbackLock);
+        for (int i = 0; i < numActiveOutChans; ++i)
+            outChans[i] = (float*) juce::jack_port_get_buffer (activeOutputPorts.getUnchecked (i), (jack_nframes_t) numSamples);
 
         if (callback != nullptr)
         {
+            // (when freewheeling, the callbacks aren't running against a real-time deadline)
+            if (! freewheeling)
+                diagnostics.callbackStarted (numSamples, (double) juce::jack_get_sample_rate (client));
+
             if ((numActiveInChans + numActiveOutChans) > 0)
                 callback->audioDeviceIOCallback (const_cast<const float**> (inChans.getData()), numActiveInChans,
                                                  outChans, numActiveOutChans, numSamples);
@@ -402,7 +424,7 @@ private:
         else
         {
             for (int i = 0; i < numActiveOutChans; ++i)
-                zeromem (outChans[i], sizeof (float) * numSamples);
+                zeromem (outChans[i], sizeof (float) * (size_t) numSamples);
         }
     }
 
@@ -417,11 +439,21 @@ private:
     static int xrunCallback (void* callbackArgument)
     {
         if (callbackArgument != nullptr)
-            ((JackAudioIODevice*) callbackArgument)->xruns++;
+        {
+            auto* device = static_cast<JackAudioIODevice*> (callbackArgument);
+            device->xruns++;
+            device->diagnostics.addUnderruns (1);
+        }
 
         return 0;
     }
 
+    static void freewheelCallback (int starting, void* callbackArgument)
+    {
+        if (auto* device = static_cast<JackAudioIODevice*> (callbackArgument))
+            device->freewheeling = (starting != 0);
+    }
+
     void updateActivePorts()
     {
         BigInteger newOutputChannels, newInputChannels;
@@ -444,6 +476,21 @@ private:
             activeOutputChannels = newOutputChannels;
             activeInputChannels  = newInputChannels;
 
+            {
+                const ScopedLock sl (callbackLock);
+
+                activeInputPorts.clearQuick();
+                activeOutputPorts.clearQuick();
+
+                for (int i = 0; i < inputPorts.size(); ++i)
+                    if (activeInputChannels[i])
+                        activeInputPorts.add ((jack_port_t*) inputPorts.getUnchecked (i));
+
+                for (int i = 0; i < outputPorts.size(); ++i)
+                    if (activeOutputChannels[i])
+                        activeOutputPorts.add ((jack_port_t*) outputPorts.getUnchecked (i));
+            }
+
             if (oldCallback != nullptr)
                 start (oldCallback);
 
@@ -490,9 +537,11 @@ private:
     int totalNumberOfInputChannels;
     int totalNumberOfOutputChannels;
     Array<void*> inputPorts, outputPorts;
+    Array<jack_port_t*> activeInputPorts, activeOutputPorts;
     BigInteger activeInputChannels, activeOutputChannels;
 
     int xruns;
+    std::atomic<bool> freewheeling { false };
 };
 
 
@@ -47,6 +47,8 @@ public:
 
             // It's good idea to pre-allocate a good number of elements
             ports.ensureStorageAllocated (32);
+
+            startTimestampQueue();
         }
     }
 
@@ -56,7 +58,12 @@ public:
         instance = nullptr;
 
         if (handle != nullptr)
+        {
+            if (queueId >= 0)
+                snd_seq_free_queue (handle, queueId);
+
             snd_seq_close (handle);
+        }
 
         jassert (activeCallbacks.get() == 0);
 
@@ -201,6 +208,23 @@ public:
                 portId = snd_seq_create_simple_port (seqHandle, name.toUTF8(), caps,
                                                      SND_SEQ_PORT_TYPE_MIDI_GENERIC |
                                                      SND_SEQ_PORT_TYPE_APPLICATION);
+
+                if (isInput && portId >= 0 && client.queueId >= 0)
+                {
+                    // ask the sequencer to stamp each incoming event with the queue's real time
+                    // when it arrives in the kernel, which is far steadier than the time at which
+                    // our input thread gets around to reading it
+                    snd_seq_port_info_t* portInfo;
+                    snd_seq_port_info_alloca (&portInfo);
+
+                    if (snd_seq_get_port_info (seqHandle, portId, portInfo) >= 0)
+                    {
+                        snd_seq_port_info_set_timestamping (portInfo, 1);
+                        snd_seq_port_info_set_timestamp_real (portInfo, 1);
+                        snd_seq_port_info_set_timestamp_queue (portInfo, client.queueId);
+                        snd_seq_set_port_info (seqHandle, portId, portInfo);
+                    }
+                }
             }
         }
 
@@ -265,6 +289,19 @@ public:
     snd_seq_t* get() const noexcept     { return handle; }
     int getId() const noexcept          { return clientId; }
 
+    /** Returns an event's arrival time in seconds, on the same clock as Time::getMillisecondCounterHiRes(). */
+    double getEventTime (const snd_seq_event_t* event) const noexcept
+    {
+        auto now = Time::getMillisecondCounterHiRes();
+
+        if (queueId < 0 || (event->flags & SND_SEQ_TIME_STAMP_MASK) != SND_SEQ_TIME_STAMP_REAL)
+            return now * 0.001;
+
+        auto t = queueStartTime + event->time.time.tv_sec * 1000.0 + event->time.time.tv_nsec * 1.0e-6;
+
+        return jmin (t, now) * 0.001;
+    }
+
     Port* createPort (const String& name, bool forInput, bool enableSubscription)
     {
         auto port = new Port (*this, forInput);
@@ -283,12 +320,41 @@ public:
 private:
     snd_seq_t* handle = nullptr;
     int clientId = 0;
+    int queueId = -1;
+    double queueStartTime = 0;
     OwnedArray<Port> ports;
     Atomic<int> activeCallbacks;
     CriticalSection callbackLock;
 
     static AlsaClient* instance;
 
+    void startTimestampQueue()
+    {
+        queueId = snd_seq_alloc_queue (handle);
+
+        if (queueId < 0)
+            return;
+
+        snd_seq_start_queue (handle, queueId, nullptr);
+        snd_seq_drain_output (handle);
+
+        // the queue's clock starts from zero, so work out where that zero is on our own clock
+        snd_seq_queue_status_t* status;
+        snd_seq_queue_status_alloca (&status);
+
+        if (snd_seq_get_queue_status (handle, queueId, status) >= 0)
+        {
+            auto* queueTime = snd_seq_queue_status_get_real_time (status);
+            queueStartTime = Time::getMillisecondCounterHiRes()
+                               - (queueTime->tv_sec * 1000.0 + queueTime->tv_nsec * 1.0e-6);
+        }
+        else
+        {
+            snd_seq_free_queue (handle, queueId);
+            queueId = -1;
+        }
+    }
+
     //==============================================================================
     class MidiInputThread   : public Thread
     {
@@ -334,7 +400,7 @@ private:
                                 snd_midi_event_reset_decode (midiParser);
 
                                 concatenator.pushMidiData (buffer, (int) numBytes,
-                                                           Time::getMillisecondCounter() * 0.001,
+                                                           client.getEventTime (inputEvent),
                                                            inputEvent, client);
 
                                 snd_seq_free_event (inputEvent);
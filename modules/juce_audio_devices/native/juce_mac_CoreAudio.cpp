@@ -159,8 +159,10 @@ class CoreAudioIODevice;
 class CoreAudioInternal  : private Timer
 {
 public:
-    CoreAudioInternal (CoreAudioIODevice& d, AudioDeviceID id, bool input, bool output)
+    CoreAudioInternal (CoreAudioIODevice& d, AudioIODeviceDiagnostics& diagnosticsToUpdate,
+                       AudioDeviceID id, bool input, bool output)
        : owner (d),
+         diagnostics (diagnosticsToUpdate),
          deviceID (id),
          isInputDevice  (input),
          isOutputDevice (output)
@@ -749,13 +751,45 @@ public:
     double getSampleRate() const  { return sampleRate; }
     int getBufferSize() const     { return bufferSize; }
 
-    void audioCallback (const AudioBufferList* inInputData,
-                        AudioBufferList* outOutputData)
+    AudioWorkgroup getWorkgroup() const
+    {
+       #if JUCE_AUDIO_WORKGROUP_TYPES_AVAILABLE
+        if (__builtin_available (macOS 11.0, *))
+        {
+            AudioObjectPropertyAddress pa;
+            pa.mSelector = kAudioDevicePropertyIOThreadOSWorkgroup;
+            pa.mScope = kAudioObjectPropertyScopeGlobal;
+            pa.mElement = kAudioObjectPropertyElementMaster;
+
+            os_workgroup_t workgroup = nullptr;
+            UInt32 size = sizeof (workgroup);
+
+            if (deviceID != 0
+                 && OK (AudioObjectGetPropertyData (deviceID, &pa, 0, nullptr, &size, &workgroup))
+                 && workgroup != nullptr)
+            {
+                // (the property hands us a reference that we have to release)
+                auto result = AudioWorkgroup::fromNativeHandle (workgroup);
+                os_release (workgroup);
+                return result;
+            }
+        }
+       #endif
+
+        return {};
+    }
+
+    void audioCallback (const AudioTimeStamp* now,
+                        const AudioBufferList* inInputData, const AudioTimeStamp* inputTime,
+                        AudioBufferList* outOutputData, const AudioTimeStamp* outputTime)
     {
         const ScopedLock sl (callbackLock);
 
         if (callback != nullptr)
         {
+            diagnostics.callbackStarted (bufferSize, sampleRate);
+            updateMeasuredLatency (now, inputTime, outputTime);
+
             for (int i = numInputChans; --i >= 0;)
             {
                 auto& info = inputChannelInfo.getReference(i);
@@ -805,6 +839,28 @@ public:
     }
 
     // called by callbacks
+    // The HAL's timestamps show how far behind the input and ahead of the
+    // output the callback is actually running.
+    void updateMeasuredLatency (const AudioTimeStamp* now, const AudioTimeStamp* inputTime,
+                                const AudioTimeStamp* outputTime) noexcept
+    {
+        auto hasSampleTime = [] (const AudioTimeStamp* t)
+        {
+            return t != nullptr && (t->mFlags & kAudioTimeStampSampleTimeValid) != 0;
+        };
+
+        if (! hasSampleTime (now))
+            return;
+
+        auto inputDelay  = (isInputDevice  && hasSampleTime (inputTime))  ? roundToInt (now->mSampleTime - inputTime->mSampleTime)  : -1;
+        auto outputDelay = (isOutputDevice && hasSampleTime (outputTime)) ? roundToInt (outputTime->mSampleTime - now->mSampleTime) : -1;
+
+        diagnostics.setMeasuredLatency (inputDelay, outputDelay);
+
+        if (outputDelay >= 0)
+            diagnostics.setOutputBufferFill (outputDelay);
+    }
+
     void deviceDetailsChanged()
     {
         if (callbacksAllowed.get() == 1)
@@ -827,6 +883,7 @@ public:
 
     //==============================================================================
     CoreAudioIODevice& owner;
+    AudioIODeviceDiagnostics& diagnostics;
     int inputLatency  = 0;
     int outputLatency = 0;
     int bitDepth = 32;
@@ -855,14 +912,14 @@ private:
 
     //==============================================================================
     static OSStatus audioIOProc (AudioDeviceID /*inDevice*/,
-                                 const AudioTimeStamp* /*inNow*/,
+                                 const AudioTimeStamp* inNow,
                                  const AudioBufferList* inInputData,
-                                 const AudioTimeStamp* /*inInputTime*/,
+                                 const AudioTimeStamp* inInputTime,
                                  AudioBufferList* outOutputData,
-                                 const AudioTimeStamp* /*inOutputTime*/,
+                                 const AudioTimeStamp* inOutputTime,
                                  void* device)
     {
-        static_cast<CoreAudioInternal*> (device)->audioCallback (inInputData, outOutputData);
+        static_cast<CoreAudioInternal*> (device)->audioCallback (inNow, inInputData, inInputTime, outOutputData, inOutputTime);
         return noErr;
     }
 
@@ -874,6 +931,7 @@ private:
         {
             case kAudioDeviceProcessorOverload:
                 intern->xruns++;
+                intern->diagnostics.addUnderruns (1);
                 break;
             case kAudioDevicePropertyBufferSize:
             case kAudioDevicePropertyBufferFrameSize:
@@ -962,11 +1020,11 @@ public:
         if (outputDeviceId == 0 || outputDeviceId == inputDeviceId)
         {
             jassert (inputDeviceId != 0);
-            device = new CoreAudioInternal (*this, inputDeviceId, true, outputDeviceId != 0);
+            device = new CoreAudioInternal (*this, diagnostics, inputDeviceId, true, outputDeviceId != 0);
         }
         else
         {
-            device = new CoreAudioInternal (*this, outputDeviceId, false, true);
+            device = new CoreAudioInternal (*this, diagnostics, outputDeviceId, false, true);
         }
 
         jassert (device != nullptr);
@@ -1004,6 +1062,7 @@ public:
     int getCurrentBitDepth() override                   { return internal->bitDepth; }
     int getCurrentBufferSizeSamples() override          { return internal->getBufferSize(); }
     int getXRunCount() const noexcept override          { return internal->xruns; }
+    AudioWorkgroup getWorkgroup() const override        { return internal->getWorkgroup(); }
 
     int getDefaultBufferSize() override
     {
@@ -1067,6 +1126,8 @@ public:
     {
         if (! isStarted)
         {
+            diagnostics.reset();
+
             if (callback != nullptr)
                 callback->audioDeviceAboutToStart (this);
 
@@ -1543,6 +1604,7 @@ public:
         {
             stop();
             fifos.clear();
+            diagnostics.reset();
 
             for (auto* d : devices)
                 d->start();
@@ -1620,10 +1682,15 @@ private:
                 const ScopedLock sl (callbackLock);
 
                 if (callback != nullptr)
+                {
+                    diagnostics.callbackStarted (numSamples, currentSampleRate);
                     callback->audioDeviceIOCallback ((const float**) inputChans.getRawDataPointer(), numInputChans,
                                                      outputChans.getRawDataPointer(), numOutputChans, numSamples);
+                }
                 else
+                {
                     didCallback = false;
+                }
             }
 
             if (didCallback)
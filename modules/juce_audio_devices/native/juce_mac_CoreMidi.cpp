@@ -350,7 +350,14 @@ namespace CoreMidiHelpers
                 for (unsigned int i = 0; i < pktlist->numPackets; ++i)
                 {
                     auto len = readUnaligned<decltype (packet->length)> (&(packet->length));
-                    concatenator.pushMidiData (packet->data, (int) len, time, input, callback);
+
+                    // packets are stamped with the host time at which the driver received them, which
+                    // is in the same units as Time::getHighResolutionTicks() on this platform
+                    auto hostTime = readUnaligned<decltype (packet->timeStamp)> (&(packet->timeStamp));
+                    auto packetTime = hostTime != 0 ? jmin (time, Time::highResolutionTicksToSeconds ((int64) hostTime))
+                                                    : time;
+
+                    concatenator.pushMidiData (packet->data, (int) len, packetTime, input, callback);
 
                     packet = MIDIPacketNext (packet);
                 }
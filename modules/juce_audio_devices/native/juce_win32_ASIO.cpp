@@ -645,6 +645,10 @@ public:
     {
         if (callback != nullptr)
         {
+            // ASIO drivers report latencies measured for the current buffer configuration
+            diagnostics.reset();
+            diagnostics.setMeasuredLatency ((int) inputLatency, (int) outputLatency);
+
             callback->audioDeviceAboutToStart (this);
 
             const ScopedLock sl (callbackLock);
@@ -1293,6 +1297,8 @@ private:
 
             if (currentCallback != nullptr)
             {
+                diagnostics.callbackStarted (samps, currentSampleRate);
+
                 for (int i = 0; i < numActiveInputChans; ++i)
                 {
                     jassert (inBuffers[i] != nullptr);
@@ -1337,7 +1343,7 @@ private:
 
             case kAsioSupportsTimeInfo:
             case kAsioSupportsTimeCode:  return 0;
-            case kAsioOverload:          ++xruns; return 1;
+            case kAsioOverload:          ++xruns; diagnostics.addUnderruns (1); return 1;
         }
 
         return 0;
@@ -194,14 +194,6 @@ JUCE_COMCLASS (MMDeviceEnumerator, "BCDE0395-E52F-467C-8E3D-C4579291692E");
 
 using REFERENCE_TIME = LONGLONG;
 
-enum AVRT_PRIORITY
-{
-    AVRT_PRIORITY_LOW = -1,
-    AVRT_PRIORITY_NORMAL,
-    AVRT_PRIORITY_HIGH,
-    AVRT_PRIORITY_CRITICAL
-};
-
 enum AUDCLNT_SHAREMODE
 {
     AUDCLNT_SHAREMODE_SHARED,
@@ -224,6 +216,28 @@ JUCE_IUNKNOWNCLASS (IAudioClient, "1CB9AD4C-DBFA-4c32-B178-C2F568A703B2")
     JUCE_COMCALL GetService (REFIID, void**) = 0;
 };
 
+struct AudioClientProperties
+{
+    UINT32 cbSize;
+    BOOL bIsOffload;
+    int eCategory;
+    int Options;
+};
+
+JUCE_COMCLASS (IAudioClient2, "726778CD-F60A-4eda-82DE-E47610CD78AA")  : public IAudioClient
+{
+    JUCE_COMCALL IsOffloadCapable (int, BOOL*) = 0;
+    JUCE_COMCALL SetClientProperties (const AudioClientProperties*) = 0;
+    JUCE_COMCALL GetBufferSizeLimits (const WAVEFORMATEX*, BOOL, REFERENCE_TIME*, REFERENCE_TIME*) = 0;
+};
+
+JUCE_COMCLASS (IAudioClient3, "7ED4EE07-8E67-4CD4-8C1A-2B7A5987AD42")  : public IAudioClient2
+{
+    JUCE_COMCALL GetSharedModeEnginePeriod (const WAVEFORMATEX*, UINT32*, UINT32*, UINT32*, UINT32*) = 0;
+    JUCE_COMCALL GetCurrentSharedModeEnginePeriod (WAVEFORMATEX**, UINT32*) = 0;
+    JUCE_COMCALL InitializeSharedAudioStream (DWORD, UINT32, const WAVEFORMATEX*, LPCGUID) = 0;
+};
+
 JUCE_IUNKNOWNCLASS (IAudioCaptureClient, "C8ADBD64-E71E-48a0-A4DE-185C395CD317")
 {
     JUCE_COMCALL GetBuffer (BYTE**, UINT32*, DWORD*, UINT64*, UINT64*) = 0;
@@ -352,8 +366,11 @@ void copyWavFormat (WAVEFORMATEXTENSIBLE& dest, const WAVEFORMATEX* src) noexcep
 class WASAPIDeviceBase
 {
 public:
-    WASAPIDeviceBase (const ComSmartPtr<IMMDevice>& d, bool exclusiveMode, std::function<void()>&& cb)
-        : device (d), useExclusiveMode (exclusiveMode), reopenCallback (cb)
+    WASAPIDeviceBase (const ComSmartPtr<IMMDevice>& d, WASAPIDeviceMode mode, std::function<void()>&& cb)
+        : device (d),
+          useExclusiveMode (mode == WASAPIDeviceMode::exclusive),
+          useLowLatencyMode (mode == WASAPIDeviceMode::sharedLowLatency),
+          reopenCallback (cb)
     {
         clientEvent = CreateEvent (nullptr, false, false, nullptr);
 
@@ -379,6 +396,28 @@ public:
         defaultBufferSize = refTimeToSamples (defaultPeriod, defaultSampleRate);
         mixFormatChannelMask = format.dwChannelMask;
 
+        if (useLowLatencyMode)
+        {
+            // IAudioClient3 only exists on Windows 10 and later, and not every driver offers
+            // periods smaller than the default; without them this is just the shared mode
+            ComSmartPtr<IAudioClient3> client3;
+            UINT32 defaultFrames = 0, fundamentalFrames = 0, minFrames = 0, maxFrames = 0;
+
+            if (SUCCEEDED (tempClient.QueryInterface (client3))
+                 && check (client3->GetSharedModeEnginePeriod ((WAVEFORMATEX*) &format, &defaultFrames,
+                                                               &fundamentalFrames, &minFrames, &maxFrames))
+                 && fundamentalFrames > 0 && minFrames < defaultFrames)
+            {
+                minBufferSize = defaultBufferSize = (int) minFrames;
+                lowLatencyPeriodStep = (int) fundamentalFrames;
+                lowLatencyMaxPeriod = (int) maxFrames;
+            }
+            else
+            {
+                useLowLatencyMode = false;
+            }
+        }
+
         rates.addUsingDefaultSort (defaultSampleRate);
 
         if (useExclusiveMode
@@ -477,6 +516,8 @@ public:
     int minBufferSize = 0, defaultBufferSize = 0, latencySamples = 0;
     DWORD mixFormatChannelMask = 0;
     const bool useExclusiveMode;
+    bool useLowLatencyMode;
+    int lowLatencyPeriodStep = 0, lowLatencyMaxPeriod = 0, lowLatencyPeriod = 0;
     Array<double> rates;
     HANDLE clientEvent = {};
     BigInteger channels;
@@ -635,52 +676,130 @@ private:
     {
         WAVEFORMATEXTENSIBLE format;
 
-        if (findSupportedFormat (client, sampleRate, mixFormatChannelMask, format))
-        {
-            REFERENCE_TIME defaultPeriod = 0, minPeriod = 0;
+        if (! findSupportedFormat (client, sampleRate, mixFormatChannelMask, format))
+            return false;
 
-            check (client->GetDevicePeriod (&defaultPeriod, &minPeriod));
+        if (useLowLatencyMode)
+            return initialiseLowLatencyClient (format, bufferSizeSamples);
 
-            if (useExclusiveMode && bufferSizeSamples > 0)
-                defaultPeriod = jmax (minPeriod, samplesToRefTime (bufferSizeSamples, format.Format.nSamplesPerSec));
+        REFERENCE_TIME defaultPeriod = 0, minPeriod = 0;
+        check (client->GetDevicePeriod (&defaultPeriod, &minPeriod));
 
-            for (;;)
-            {
-                GUID session;
-                HRESULT hr = client->Initialize (useExclusiveMode ? AUDCLNT_SHAREMODE_EXCLUSIVE : AUDCLNT_SHAREMODE_SHARED,
-                                                 0x40000 /*AUDCLNT_STREAMFLAGS_EVENTCALLBACK*/,
-                                                 defaultPeriod, useExclusiveMode ? defaultPeriod : 0, (WAVEFORMATEX*) &format, &session);
+        if (! useExclusiveMode)
+            return check (initialiseClient (format, defaultPeriod));
 
-                if (check (hr))
-                {
-                    actualNumChannels  = format.Format.nChannels;
-                    const bool isFloat = format.Format.wFormatTag == WAVE_FORMAT_EXTENSIBLE && format.SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
-                    bytesPerSample     = format.Format.wBitsPerSample / 8;
-                    bytesPerFrame      = format.Format.nBlockAlign;
+        // In exclusive mode the period is the buffer size, so first ask for the size that was
+        // requested (within whatever limits the driver reports), then fall back to the device's
+        // own periods if the driver rejects it
+        Array<REFERENCE_TIME> periodsToTry;
 
-                    updateFormat (isFloat);
-                    return true;
-                }
+        if (bufferSizeSamples > 0)
+            periodsToTry.add (clampToExclusiveModeLimits (jmax (minPeriod, samplesToRefTime (bufferSizeSamples, format.Format.nSamplesPerSec)),
+                                                          format));
 
-                // Handle the "alignment dance" : http://msdn.microsoft.com/en-us/library/windows/desktop/dd370875(v=vs.85).aspx (see Remarks)
-                if (hr != MAKE_HRESULT (1, 0x889, 0x19)) // AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED
-                    break;
+        periodsToTry.addIfNotAlreadyThere (defaultPeriod);
+        periodsToTry.addIfNotAlreadyThere (minPeriod);
 
-                UINT32 numFrames = 0;
-                if (! check (client->GetBufferSize (&numFrames)))
-                    break;
+        for (auto period : periodsToTry)
+        {
+            auto hr = initialiseClient (format, period);
 
-                // Recreate client
-                client = nullptr;
-                client = createClient();
+            if (check (hr))
+                return true;
 
-                defaultPeriod = samplesToRefTime (numFrames, format.Format.nSamplesPerSec);
-            }
+            if (hr != MAKE_HRESULT (1, 0x889, 0x20)     // AUDCLNT_E_INVALID_DEVICE_PERIOD
+                 && hr != MAKE_HRESULT (1, 0x889, 0x16)) // AUDCLNT_E_BUFFER_SIZE_ERROR
+                break;
+
+            client = nullptr;
+            client = createClient();
+
+            if (client == nullptr)
+                break;
         }
 
         return false;
     }
 
+    HRESULT initialiseClient (WAVEFORMATEXTENSIBLE& format, REFERENCE_TIME period)
+    {
+        for (;;)
+        {
+            GUID session;
+            HRESULT hr = client->Initialize (useExclusiveMode ? AUDCLNT_SHAREMODE_EXCLUSIVE : AUDCLNT_SHAREMODE_SHARED,
+                                             0x40000 /*AUDCLNT_STREAMFLAGS_EVENTCALLBACK*/,
+                                             period, useExclusiveMode ? period : 0, (WAVEFORMATEX*) &format, &session);
+
+            if (check (hr))
+            {
+                clientInitialised (format);
+                return hr;
+            }
+
+            // Handle the "alignment dance" : http://msdn.microsoft.com/en-us/library/windows/desktop/dd370875(v=vs.85).aspx (see Remarks)
+            if (hr != MAKE_HRESULT (1, 0x889, 0x19)) // AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED
+                return hr;
+
+            UINT32 numFrames = 0;
+            if (! check (client->GetBufferSize (&numFrames)))
+                return hr;
+
+            // Recreate client
+            client = nullptr;
+            client = createClient();
+
+            if (client == nullptr)
+                return hr;
+
+            period = samplesToRefTime (numFrames, format.Format.nSamplesPerSec);
+        }
+    }
+
+    bool initialiseLowLatencyClient (WAVEFORMATEXTENSIBLE& format, int bufferSizeSamples)
+    {
+        ComSmartPtr<IAudioClient3> client3;
+
+        if (! check (client.QueryInterface (client3)))
+            return false;
+
+        // the period has to be the minimum plus a whole number of steps
+        auto numSteps = bufferSizeSamples > minBufferSize ? roundToInt ((bufferSizeSamples - minBufferSize) / (double) lowLatencyPeriodStep) : 0;
+        auto period = jmin (lowLatencyMaxPeriod, minBufferSize + numSteps * lowLatencyPeriodStep);
+
+        GUID session;
+
+        if (! check (client3->InitializeSharedAudioStream (0x40000 /*AUDCLNT_STREAMFLAGS_EVENTCALLBACK*/,
+                                                           (UINT32) period, (WAVEFORMATEX*) &format, &session)))
+            return false;
+
+        lowLatencyPeriod = period;
+        clientInitialised (format);
+        return true;
+    }
+
+    REFERENCE_TIME clampToExclusiveModeLimits (REFERENCE_TIME period, const WAVEFORMATEXTENSIBLE& format) const
+    {
+        ComSmartPtr<IAudioClient2> client2;
+        REFERENCE_TIME minDuration = 0, maxDuration = 0;
+
+        if (SUCCEEDED (client.QueryInterface (client2))
+             && SUCCEEDED (client2->GetBufferSizeLimits ((const WAVEFORMATEX*) &format, TRUE, &minDuration, &maxDuration))
+             && minDuration > 0 && maxDuration >= minDuration)
+            return jlimit (minDuration, maxDuration, period);
+
+        return period;
+    }
+
+    void clientInitialised (const WAVEFORMATEXTENSIBLE& format)
+    {
+        actualNumChannels  = format.Format.nChannels;
+        const bool isFloat = format.Format.wFormatTag == WAVE_FORMAT_EXTENSIBLE && format.SubFormat == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT;
+        bytesPerSample     = format.Format.wBitsPerSample / 8;
+        bytesPerFrame      = format.Format.nBlockAlign;
+
+        updateFormat (isFloat);
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WASAPIDeviceBase)
 };
 
@@ -688,8 +807,8 @@ private:
 class WASAPIInputDevice  : public WASAPIDeviceBase
 {
 public:
-    WASAPIInputDevice (const ComSmartPtr<IMMDevice>& d, bool exclusiveMode, std::function<void()>&& reopenCallback)
-        : WASAPIDeviceBase (d, exclusiveMode, std::move (reopenCallback))
+    WASAPIInputDevice (const ComSmartPtr<IMMDevice>& d, WASAPIDeviceMode mode, std::function<void()>&& reopenCallback)
+        : WASAPIDeviceBase (d, mode, std::move (reopenCallback))
     {
     }
 
@@ -849,8 +968,8 @@ private:
 class WASAPIOutputDevice  : public WASAPIDeviceBase
 {
 public:
-    WASAPIOutputDevice (const ComSmartPtr<IMMDevice>& d, bool exclusiveMode, std::function<void()>&& reopenCallback)
-        : WASAPIDeviceBase (d, exclusiveMode, std::move (reopenCallback))
+    WASAPIOutputDevice (const ComSmartPtr<IMMDevice>& d, WASAPIDeviceMode mode, std::function<void()>&& reopenCallback)
+        : WASAPIDeviceBase (d, mode, std::move (reopenCallback))
     {
     }
 
@@ -914,6 +1033,16 @@ public:
         return actualBufferSize;
     }
 
+    int getNumSamplesQueued() const
+    {
+        UINT32 padding = 0;
+
+        if (numChannels > 0 && check (client->GetCurrentPadding (&padding)))
+            return (int) padding;
+
+        return -1;
+    }
+
     void copyBuffers (const float** srcBuffers, int numSrcBuffers, int bufferSize,
                       WASAPIInputDevice* inputDevice, Thread& thread)
     {
@@ -974,12 +1103,13 @@ public:
                          const String& typeName,
                          const String& outputDeviceID,
                          const String& inputDeviceID,
-                         bool exclusiveMode)
+                         WASAPIDeviceMode mode)
         : AudioIODevice (deviceName, typeName),
           Thread ("JUCE WASAPI"),
           outputDeviceId (outputDeviceID),
           inputDeviceId (inputDeviceID),
-          useExclusiveMode (exclusiveMode)
+          deviceMode (mode),
+          useExclusiveMode (mode == WASAPIDeviceMode::exclusive)
     {
     }
 
@@ -1016,6 +1146,9 @@ public:
                 sampleRates = d->rates;
             }
 
+            if (addLowLatencyBufferSizes())
+                return true;
+
             bufferSizes.addUsingDefaultSort (defaultBufferSize);
             if (minBufferSize != defaultBufferSize)
                 bufferSizes.addUsingDefaultSort (minBufferSize);
@@ -1035,6 +1168,26 @@ public:
         return false;
     }
 
+    // In the low latency mode, the periods the engine allows are the minimum plus
+    // multiples of a fixed step, up to a maximum
+    bool addLowLatencyBufferSizes()
+    {
+        auto* d = outputDevice != nullptr ? static_cast<WASAPIDeviceBase*> (outputDevice.get())
+                                          : static_cast<WASAPIDeviceBase*> (inputDevice.get());
+
+        if (! d->useLowLatencyMode
+             || (inputDevice != nullptr && ! inputDevice->useLowLatencyMode)
+             || (outputDevice != nullptr && ! outputDevice->useLowLatencyMode))
+            return false;
+
+        minBufferSize = defaultBufferSize = d->minBufferSize;
+
+        for (int n = d->minBufferSize; n <= jmin (2048, d->lowLatencyMaxPeriod) && bufferSizes.size() < 64; n += d->lowLatencyPeriodStep)
+            bufferSizes.add (n);
+
+        return true;
+    }
+
     StringArray getOutputChannelNames() override
     {
         StringArray outChannels;
@@ -1114,13 +1267,25 @@ public:
             currentBufferSizeSamples = outputDevice != nullptr ? outputDevice->actualBufferSize
                                                                : inputDevice->actualBufferSize;
         }
+        else if (deviceMode == WASAPIDeviceMode::sharedLowLatency)
+        {
+            // the engine runs at the period that the client negotiated, so make the callback match it
+            auto* d = outputDevice != nullptr ? static_cast<WASAPIDeviceBase*> (outputDevice.get())
+                                              : static_cast<WASAPIDeviceBase*> (inputDevice.get());
+
+            if (d->lowLatencyPeriod > 0)
+                currentBufferSizeSamples = d->lowLatencyPeriod;
+        }
 
         if (inputDevice != nullptr)   ResetEvent (inputDevice->clientEvent);
         if (outputDevice != nullptr)  ResetEvent (outputDevice->clientEvent);
 
         deviceBecameInactive = false;
 
-        startThread (8);
+        // this joins the thread to the MMCSS "Pro Audio" task, at the highest priority when
+        // the buffers are small enough that any scheduling delay will cause a glitch
+        startRealtimeThread (RealtimeOptions().withPriority (deviceMode == WASAPIDeviceMode::shared ? 8 : 10)
+                                              .withPeriod (currentBufferSizeSamples, currentSampleRate));
         Thread::sleep (5);
 
         if (inputDevice != nullptr && inputDevice->client != nullptr)
@@ -1181,6 +1346,7 @@ public:
                 return;
             }
 
+            diagnostics.reset();
             call->audioDeviceAboutToStart (this);
 
             const ScopedLock sl (startStopLock);
@@ -1205,29 +1371,13 @@ public:
         }
     }
 
-    void setMMThreadPriority()
-    {
-        DynamicLibrary dll ("avrt.dll");
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
-        JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadPriority, avSetMmThreadPriority, HANDLE, (HANDLE, AVRT_PRIORITY))
-
-        if (avSetMmThreadCharacteristics != 0 && avSetMmThreadPriority != 0)
-        {
-            DWORD dummy = 0;
-
-            if (auto h = avSetMmThreadCharacteristics (L"Pro Audio", &dummy))
-                avSetMmThreadPriority (h, AVRT_PRIORITY_NORMAL);
-        }
-    }
-
     void run() override
     {
-        setMMThreadPriority();
-
         auto bufferSize        = currentBufferSizeSamples;
         auto numInputBuffers   = getActiveInputChannels().countNumberOfSetBits();
         auto numOutputBuffers  = getActiveOutputChannels().countNumberOfSetBits();
         bool sampleRateHasChanged = false;
+        int numOverrunsReported = 0;
 
         AudioBuffer<float> ins  (jmax (1, numInputBuffers),  bufferSize + 32);
         AudioBuffer<float> outs (jmax (1, numOutputBuffers), bufferSize + 32);
@@ -1238,6 +1388,8 @@ public:
 
         while (! threadShouldExit())
         {
+            int inputDelay = -1, outputDelay = -1;
+
             if (outputDevice != nullptr && outputDevice->shouldClose)
                 deviceBecameInactive = true;
 
@@ -1262,8 +1414,12 @@ public:
                         inputDevice->handleDeviceBuffer();
                 }
 
+                inputDelay = inputDevice->latencySamples + inputDevice->getNumSamplesInReservoir();
                 inputDevice->copyBuffersFromReservoir (inputBuffers, numInputBuffers, bufferSize);
 
+                diagnostics.addOverruns (inputDevice->xruns - numOverrunsReported);
+                numOverrunsReported = inputDevice->xruns;
+
                 if (inputDevice->sampleRateHasChanged)
                 {
                     sampleRateHasChanged = true;
@@ -1276,14 +1432,27 @@ public:
                 const ScopedTryLock sl (startStopLock);
 
                 if (sl.isLocked() && isStarted)
+                {
+                    diagnostics.callbackStarted (bufferSize, currentSampleRate);
                     callback->audioDeviceIOCallback (const_cast<const float**> (inputBuffers), numInputBuffers,
                                                      outputBuffers, numOutputBuffers, bufferSize);
+                }
                 else
+                {
                     outs.clear();
+                }
             }
 
             if (outputDevice != nullptr && ! deviceBecameInactive)
             {
+                auto numQueued = outputDevice->getNumSamplesQueued();
+
+                if (numQueued >= 0)
+                {
+                    diagnostics.setOutputBufferFill (numQueued);
+                    outputDelay = outputDevice->latencySamples + numQueued;
+                }
+
                 // Note that this function is handed the input device so it can check for the event and make sure
                 // the input reservoir is filled up correctly even when bufferSize > device actualBufferSize
                 outputDevice->copyBuffers (const_cast<const float**> (outputBuffers), numOutputBuffers, bufferSize, inputDevice.get(), *this);
@@ -1295,6 +1464,8 @@ public:
                 }
             }
 
+            diagnostics.setMeasuredLatency (inputDelay, outputDelay);
+
             if (sampleRateHasChanged || deviceBecameInactive)
             {
                 triggerAsyncUpdate();
@@ -1311,6 +1482,7 @@ private:
     // Device stats...
     std::unique_ptr<WASAPIInputDevice> inputDevice;
     std::unique_ptr<WASAPIOutputDevice> outputDevice;
+    const WASAPIDeviceMode deviceMode;
     const bool useExclusiveMode;
     double defaultSampleRate = 0;
     int minBufferSize = 0, defaultBufferSize = 0;
@@ -1372,9 +1544,9 @@ private:
             };
 
             if (deviceId == inputDeviceId && flow == eCapture)
-                inputDevice.reset (new WASAPIInputDevice (device, useExclusiveMode, deviceReopenCallback));
+                inputDevice.reset (new WASAPIInputDevice (device, deviceMode, deviceReopenCallback));
             else if (deviceId == outputDeviceId && flow == eRender)
-                outputDevice.reset (new WASAPIOutputDevice (device, useExclusiveMode, deviceReopenCallback));
+                outputDevice.reset (new WASAPIOutputDevice (device, deviceMode, deviceReopenCallback));
         }
 
         return (outputDeviceId.isEmpty() || (outputDevice != nullptr && outputDevice->isOk()))
@@ -1425,10 +1597,10 @@ class WASAPIAudioIODeviceType  : public AudioIODeviceType,
                                  private DeviceChangeDetector
 {
 public:
-    WASAPIAudioIODeviceType (bool exclusive)
-        : AudioIODeviceType (exclusive ? "Windows Audio (Exclusive Mode)" : "Windows Audio"),
+    WASAPIAudioIODeviceType (WASAPIDeviceMode mode)
+        : AudioIODeviceType (getDeviceTypename (mode)),
           DeviceChangeDetector (L"Windows Audio"),
-          exclusiveMode (exclusive)
+          deviceMode (mode)
     {
     }
 
@@ -1496,7 +1668,7 @@ public:
                                                    getTypeName(),
                                                    outputDeviceIds [outputIndex],
                                                    inputDeviceIds [inputIndex],
-                                                   exclusiveMode));
+                                                   deviceMode));
 
             if (! device->initialise())
                 device = nullptr;
@@ -1510,7 +1682,19 @@ public:
     StringArray inputDeviceNames, inputDeviceIds;
 
 private:
-    const bool exclusiveMode;
+    static String getDeviceTypename (WASAPIDeviceMode mode)
+    {
+        switch (mode)
+        {
+            case WASAPIDeviceMode::exclusive:         return "Windows Audio (Exclusive Mode)";
+            case WASAPIDeviceMode::sharedLowLatency:  return "Windows Audio (Low Latency Mode)";
+            case WASAPIDeviceMode::shared:            break;
+        }
+
+        return "Windows Audio";
+    }
+
+    const WASAPIDeviceMode deviceMode;
     bool hasScanned = false;
     ComSmartPtr<IMMDeviceEnumerator> enumerator;
 
@@ -1724,15 +1908,20 @@ struct MMDeviceMasterVolume
 }
 
 //==============================================================================
-AudioIODeviceType* AudioIODeviceType::createAudioIODeviceType_WASAPI (bool exclusiveMode)
+AudioIODeviceType* AudioIODeviceType::createAudioIODeviceType_WASAPI (WASAPIDeviceMode deviceMode)
 {
    #if ! JUCE_WASAPI_EXCLUSIVE
-    if (exclusiveMode)
+    if (deviceMode == WASAPIDeviceMode::exclusive)
         return nullptr;
    #endif
 
+    // the low latency periods need IAudioClient3
+    if (deviceMode == WASAPIDeviceMode::sharedLowLatency
+         && SystemStats::getOperatingSystemType() < SystemStats::Windows10)
+        return nullptr;
+
     return SystemStats::getOperatingSystemType() >= SystemStats::WinVista
-                ? new WasapiClasses::WASAPIAudioIODeviceType (exclusiveMode)
+                ? new WasapiClasses::WASAPIAudioIODeviceType (deviceMode)
                 : nullptr;
 }
 
@@ -36,15 +36,15 @@ void AudioSourcePlayer::setSource (AudioSource* newSource)
 {
     if (source != newSource)
     {
-        auto* oldSource = source;
-
         if (newSource != nullptr && bufferSize > 0 && sampleRate > 0)
             newSource->prepareToPlay (bufferSize, sampleRate);
 
-        {
-            const ScopedLock sl (readLock);
-            source = newSource;
-        }
+        auto* oldSource = source.exchange (newSource);
+
+        // the audio thread never waits for this, so the old source only needs to be kept
+        // alive until a callback that might have picked it up has finished
+        while (isInCallback)
+            Thread::yield();
 
         if (oldSource != nullptr)
             oldSource->releaseResources();
@@ -65,9 +65,9 @@ void AudioSourcePlayer::audioDeviceIOCallback (const float** inputChannelData,
     // these should have been prepared by audioDeviceAboutToStart()...
     jassert (sampleRate > 0 && bufferSize > 0);
 
-    const ScopedLock sl (readLock);
+    isInCallback = true;
 
-    if (source != nullptr)
+    if (auto* currentSource = source.load())
     {
         int numActiveChans = 0, numInputs = 0, numOutputs = 0;
 
@@ -93,57 +93,52 @@ void AudioSourcePlayer::audioDeviceIOCallback (const float** inputChannelData,
             }
         }
 
+        // The source renders straight into the device's output channels, which need to
+        // start out holding the inputs (an AudioSource gets its input in the buffer it fills).
+        // Only the inputs that don't have an output of their own need temporary channels,
+        // and devices that pass the same buffer in both directions need no copying at all.
+        for (int i = 0; i < numOutputs; ++i)
+        {
+            auto* dest = outputChans[i];
+            channels[numActiveChans++] = dest;
+
+            if (i >= numInputs)
+                FloatVectorOperations::clear (dest, numSamples);
+            else if (dest != inputChans[i])
+                FloatVectorOperations::copy (dest, inputChans[i], numSamples);
+        }
+
         if (numInputs > numOutputs)
         {
-            // if there aren't enough output channels for the number of
-            // inputs, we need to create some temporary extra ones (can't
-            // use the input data in case it gets written to)
             tempBuffer.setSize (numInputs - numOutputs, numSamples,
                                 false, false, true);
 
-            for (int i = 0; i < numOutputs; ++i)
-            {
-                channels[numActiveChans] = outputChans[i];
-                memcpy (channels[numActiveChans], inputChans[i], sizeof (float) * (size_t) numSamples);
-                ++numActiveChans;
-            }
-
             for (int i = numOutputs; i < numInputs; ++i)
             {
-                channels[numActiveChans] = tempBuffer.getWritePointer (i - numOutputs);
-                memcpy (channels[numActiveChans], inputChans[i], sizeof (float) * (size_t) numSamples);
-                ++numActiveChans;
-            }
-        }
-        else
-        {
-            for (int i = 0; i < numInputs; ++i)
-            {
-                channels[numActiveChans] = outputChans[i];
-                memcpy (channels[numActiveChans], inputChans[i], sizeof (float) * (size_t) numSamples);
-                ++numActiveChans;
-            }
-
-            for (int i = numInputs; i < numOutputs; ++i)
-            {
-                channels[numActiveChans] = outputChans[i];
-                zeromem (channels[numActiveChans], sizeof (float) * (size_t) numSamples);
-                ++numActiveChans;
+                auto* dest = tempBuffer.getWritePointer (i - numOutputs);
+                channels[numActiveChans++] = dest;
+                FloatVectorOperations::copy (dest, inputChans[i], numSamples);
             }
         }
 
         AudioBuffer<float> buffer (channels, numActiveChans, numSamples);
 
         AudioSourceChannelInfo info (&buffer, 0, numSamples);
-        source->getNextAudioBlock (info);
+        currentSource->getNextAudioBlock (info);
+
+        isInCallback = false;
+
+        auto newGain = gain.load();
 
         for (int i = info.buffer->getNumChannels(); --i >= 0;)
-            buffer.applyGainRamp (i, info.startSample, info.numSamples, lastGain, gain);
+            buffer.applyGainRamp (i, info.startSample, info.numSamples, lastGain, newGain);
 
-        lastGain = gain;
+        lastGain = newGain;
     }
     else
     {
+        isInCallback = false;
+
         for (int i = 0; i < totalNumOutputChannels; ++i)
             if (outputChannelData[i] != nullptr)
                 zeromem (outputChannelData[i], sizeof (float) * (size_t) numSamples);
@@ -162,14 +157,14 @@ void AudioSourcePlayer::prepareToPlay (double newSampleRate, int newBufferSize)
     bufferSize = newBufferSize;
     zeromem (channels, sizeof (channels));
 
-    if (source != nullptr)
-        source->prepareToPlay (bufferSize, sampleRate);
+    if (auto* current = source.load())
+        current->prepareToPlay (bufferSize, sampleRate);
 }
 
 void AudioSourcePlayer::audioDeviceStopped()
 {
-    if (source != nullptr)
-        source->releaseResources();
+    if (auto* current = source.load())
+        current->releaseResources();
 
     sampleRate = 0.0;
     bufferSize = 0;
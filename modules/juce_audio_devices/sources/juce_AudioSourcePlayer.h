@@ -97,15 +97,16 @@ public:
 
 private:
     //==============================================================================
-    CriticalSection readLock;
-    AudioSource* source = nullptr;
+    std::atomic<AudioSource*> source { nullptr };
+    std::atomic<bool> isInCallback { false };
     double sampleRate = 0;
     int bufferSize = 0;
     float* channels[128];
     float* outputChans[128];
     const float* inputChans[128];
     AudioBuffer<float> tempBuffer;
-    float lastGain = 1.0f, gain = 1.0f;
+    float lastGain = 1.0f;
+    std::atomic<float> gain { 1.0f };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioSourcePlayer)
 };
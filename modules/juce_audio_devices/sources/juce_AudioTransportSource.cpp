@@ -92,14 +92,25 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
     {
         const ScopedLock sl (callbackLock);
 
+        // Keep the audio thread away from the sources while they're swapped over. It never
+        // waits for this - any block that starts in the meantime is just left silent - and
+        // this only has to wait for a block that's already in progress to finish.
+        isChangingSource = true;
+
+        while (isInCallback)
+            Thread::yield();
+
         source = newSource;
         resamplerSource = newResamplerSource;
         bufferingSource = newBufferingSource;
         masterSource = newMasterSource;
         positionableSource = newPositionableSource;
 
+        pendingReadPosition = noPendingPosition();
         inputStreamEOF = false;
         playing = false;
+
+        isChangingSource = false;
     }
 
     if (oldMasterSource != nullptr)
@@ -110,12 +121,9 @@ void AudioTransportSource::start()
 {
     if ((! playing) && masterSource != nullptr)
     {
-        {
-            const ScopedLock sl (callbackLock);
-            playing = true;
-            stopped = false;
-            inputStreamEOF = false;
-        }
+        inputStreamEOF = false;
+        stopped = false;
+        playing = true;
 
         sendChangeMessage();
     }
@@ -125,10 +133,7 @@ void AudioTransportSource::stop()
 {
     if (playing)
     {
-        {
-            const ScopedLock sl (callbackLock);
-            playing = false;
-        }
+        playing = false;
 
         int n = 500;
         while (--n >= 0 && ! stopped)
@@ -167,12 +172,26 @@ void AudioTransportSource::setNextReadPosition (int64 newPosition)
         if (sampleRate > 0 && sourceSampleRate > 0)
             newPosition = (int64) ((double) newPosition * sourceSampleRate / sampleRate);
 
+        pendingReadPosition = newPosition;
+        inputStreamEOF = false;
+
+        // while it's stopped, the audio thread isn't using the source, so this can go ahead
+        // and change its position rather than waiting for the next block
+        if (stopped)
+            applyPendingPosition();
+    }
+}
+
+void AudioTransportSource::applyPendingPosition()
+{
+    auto newPosition = pendingReadPosition.exchange (noPendingPosition());
+
+    if (newPosition != noPendingPosition() && positionableSource != nullptr)
+    {
         positionableSource->setNextReadPosition (newPosition);
 
         if (resamplerSource != nullptr)
             resamplerSource->flushBuffers();
-
-        inputStreamEOF = false;
     }
 }
 
@@ -180,8 +199,12 @@ int64 AudioTransportSource::getNextReadPosition() const
 {
     if (positionableSource != nullptr)
     {
+        auto pendingPosition = pendingReadPosition.load();
+        auto position = pendingPosition != noPendingPosition() ? pendingPosition
+                                                                : positionableSource->getNextReadPosition();
+
         const double ratio = (sampleRate > 0 && sourceSampleRate > 0) ? sampleRate / sourceSampleRate : 1.0;
-        return (int64) ((double) positionableSource->getNextReadPosition() * ratio);
+        return (int64) ((double) position * ratio);
     }
 
     return 0;
@@ -245,10 +268,20 @@ void AudioTransportSource::releaseResources()
 
 void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
 {
-    const ScopedLock sl (callbackLock);
+    isInCallback = true;
+
+    if (isChangingSource)
+    {
+        info.clearActiveBufferRegion();
+        isInCallback = false;
+        return;
+    }
+
+    auto currentGain = gain.load();
 
     if (masterSource != nullptr && ! stopped)
     {
+        applyPendingPosition();
         masterSource->getNextAudioBlock (info);
 
         if (! playing)
@@ -272,7 +305,7 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
         stopped = ! playing;
 
         for (int i = info.buffer->getNumChannels(); --i >= 0;)
-            info.buffer->applyGainRamp (i, info.startSample, info.numSamples, lastGain, gain);
+            info.buffer->applyGainRamp (i, info.startSample, info.numSamples, lastGain, currentGain);
     }
     else
     {
@@ -280,7 +313,8 @@ void AudioTransportSource::getNextAudioBlock (const AudioSourceChannelInfo& info
         stopped = true;
     }
 
-    lastGain = gain;
+    lastGain = currentGain;
+    isInCallback = false;
 }
 
 } // namespace juce
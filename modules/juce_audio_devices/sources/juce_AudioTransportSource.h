@@ -34,6 +34,11 @@ namespace juce
     You may want to use one of these along with an AudioSourcePlayer and AudioIODevice
     to control playback of an audio file.
 
+    The audio callback never has to wait for the thread that's controlling the transport.
+    Position changes are posted to it and applied at the start of the next block, and when
+    the source is changed, the new one is prepared beforehand, then swapped in between
+    blocks.
+
     @see AudioSource, AudioSourcePlayer
 
     @tags{Audio}
@@ -85,7 +90,8 @@ public:
     /** Changes the current playback position in the source stream.
 
         The next time the getNextAudioBlock() method is called, this
-        is the time from which it'll read data.
+        is the time from which it'll read data. If it's playing, the change
+        is made by the audio thread at the start of that block.
 
         @param newPosition    the new playback position in seconds
 
@@ -166,12 +172,18 @@ private:
     AudioSource* masterSource = nullptr;
 
     CriticalSection callbackLock;
-    float gain = 1.0f, lastGain = 1.0f;
-    bool playing = false, stopped = true;
+    std::atomic<float> gain { 1.0f };
+    float lastGain = 1.0f;
+    std::atomic<bool> playing { false }, stopped { true }, inputStreamEOF { false };
+    std::atomic<bool> isChangingSource { false }, isInCallback { false };
+    std::atomic<int64> pendingReadPosition { noPendingPosition() };
     double sampleRate = 44100.0, sourceSampleRate = 0;
     int blockSize = 128, readAheadBufferSize = 0;
-    bool isPrepared = false, inputStreamEOF = false;
+    bool isPrepared = false;
+
+    static constexpr int64 noPendingPosition() noexcept     { return std::numeric_limits<int64>::min(); }
 
+    void applyPendingPosition();
     void releaseMasterResources();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioTransportSource)
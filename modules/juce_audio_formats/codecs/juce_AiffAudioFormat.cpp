@@ -958,6 +958,15 @@ bool AiffAudioFormat::canHandleFile (const File& f)
 }
 #endif
 
+bool AiffAudioFormat::recognisesHeader (const void* headerData, size_t numBytes)
+{
+    auto* header = static_cast<const char*> (headerData);
+
+    return numBytes >= 12
+            && memcmp (header, "FORM", 4) == 0
+            && (memcmp (header + 8, "AIFF", 4) == 0 || memcmp (header + 8, "AIFC", 4) == 0);
+}
+
 AudioFormatReader* AiffAudioFormat::createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<AiffAudioFormatReader> w (new AiffAudioFormatReader (sourceStream));
@@ -68,6 +68,7 @@ public:
     Array<int> getPossibleBitDepths() override;
     bool canDoStereo() override;
     bool canDoMono() override;
+    bool recognisesHeader (const void* headerData, size_t numBytes) override;
 
    #if JUCE_MAC
     bool canHandleFile (const File& fileToTest) override;
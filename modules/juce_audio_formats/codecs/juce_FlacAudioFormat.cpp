@@ -376,6 +376,120 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
 };
 
+//==============================================================================
+/*  Decodes from a memory-mapped file, and can divide a long read between several
+    decoders, each reading from its own stream over the mapped data.
+*/
+class MemoryMappedFlacReader  : public FlacReader
+{
+public:
+    MemoryMappedFlacReader (std::unique_ptr<MemoryMappedFile> mappedFile, ThreadPool* pool)
+        : FlacReader (new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false)),
+          map (std::move (mappedFile)),
+          threadPool (pool)
+    {
+    }
+
+    bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        auto numRanges = threadPool != nullptr ? jmin (threadPool->getNumThreads() + 1, numSamples / minSamplesPerRange)
+                                               : 1;
+
+        if (numRanges < 2)
+            return FlacReader::readSamples (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                            startSampleInFile, numSamples);
+
+        while (helpers.size() < numRanges - 1)
+        {
+            auto* helper = helpers.add (new FlacReader (new MemoryInputStream (map->getData(), map->getSize(), false)));
+            helper->lengthInSamples = lengthInSamples;
+        }
+
+        auto samplesPerRange = numSamples / numRanges;
+        std::atomic<int> numRangesRemaining { numRanges - 1 };
+        std::atomic<bool> allSucceeded { true };
+        WaitableEvent finished;
+
+        for (int i = 1; i < numRanges; ++i)
+        {
+            auto offset = i * samplesPerRange;
+            auto num = (i == numRanges - 1) ? numSamples - offset : samplesPerRange;
+            auto* helper = helpers.getUnchecked (i - 1);
+
+            threadPool->addJob ([=, &numRangesRemaining, &allSucceeded, &finished]
+            {
+                if (! helper->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer + offset,
+                                           startSampleInFile + offset, num))
+                    allSucceeded = false;
+
+                if (--numRangesRemaining == 0)
+                    finished.signal();
+            });
+        }
+
+        auto firstRangeOk = FlacReader::readSamples (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                                     startSampleInFile, samplesPerRange);
+        finished.wait();
+
+        return firstRangeOk && allSucceeded;
+    }
+
+private:
+    // below this, the cost of seeking each decoder outweighs decoding in parallel
+    enum { minSamplesPerRange = 65536 };
+
+    std::unique_ptr<MemoryMappedFile> map;
+    ThreadPool* threadPool;
+    OwnedArray<FlacReader> helpers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedFlacReader)
+};
+
+
+//==============================================================================
+static void configureFlacEncoder (FlacNamespace::FLAC__StreamEncoder* encoder, uint32 numChannels,
+                                  uint32 bitsPerSample, double sampleRate, int qualityOptionIndex)
+{
+    if (qualityOptionIndex > 0)
+        FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
+
+    FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
+    FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
+    FLAC__stream_encoder_set_channels (encoder, numChannels);
+    FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
+    FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
+    FLAC__stream_encoder_set_blocksize (encoder, 0);
+    FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+}
+
+// Returns a set of channel pointers with the samples shifted down to the FLAC bit depth,
+// using the temp space provided
+static const int** shiftSamplesForFlac (const int** samplesToWrite, int numSamples, uint32 numChannels,
+                                        uint32 bitsPerSample, HeapBlock<int*>& channels, HeapBlock<int>& temp)
+{
+    auto bitsToShift = 32 - (int) bitsPerSample;
+
+    if (bitsToShift <= 0)
+        return samplesToWrite;
+
+    temp.malloc (numChannels * (size_t) numSamples);
+    channels.calloc (numChannels + 1);
+
+    for (unsigned int i = 0; i < numChannels; ++i)
+    {
+        if (samplesToWrite[i] == nullptr)
+            break;
+
+        auto* destData = temp.get() + i * (size_t) numSamples;
+        channels[i] = destData;
+
+        for (int j = 0; j < numSamples; ++j)
+            destData[j] = (samplesToWrite[i][j] >> bitsToShift);
+    }
+
+    return const_cast<const int**> (channels.get());
+}
 
 //==============================================================================
 class FlacWriter  : public AudioFormatWriter
@@ -386,17 +500,7 @@ public:
           streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
     {
         encoder = FlacNamespace::FLAC__stream_encoder_new();
-
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
-
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+        configureFlacEncoder (encoder, numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
 
         ok = FLAC__stream_encoder_init_stream (encoder,
                                                encodeWriteCallback, encodeSeekCallback,
@@ -428,27 +532,7 @@ public:
 
         HeapBlock<int*> channels;
         HeapBlock<int> temp;
-        auto bitsToShift = 32 - (int) bitsPerSample;
-
-        if (bitsToShift > 0)
-        {
-            temp.malloc (numChannels * (size_t) numSamples);
-            channels.calloc (numChannels + 1);
-
-            for (unsigned int i = 0; i < numChannels; ++i)
-            {
-                if (samplesToWrite[i] == nullptr)
-                    break;
-
-                auto* destData = temp.get() + i * (size_t) numSamples;
-                channels[i] = destData;
-
-                for (int j = 0; j < numSamples; ++j)
-                    destData[j] = (samplesToWrite[i][j] >> bitsToShift);
-            }
-
-            samplesToWrite = const_cast<const int**> (channels.get());
-        }
+        samplesToWrite = shiftSamplesForFlac (samplesToWrite, numSamples, numChannels, bitsPerSample, channels, temp);
 
         return FLAC__stream_encoder_process (encoder, (const FlacNamespace::FLAC__int32**) samplesToWrite, (unsigned) numSamples) != 0;
     }
@@ -469,12 +553,10 @@ public:
         }
     }
 
-    void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
+    static void packStreamInfo (const FlacNamespace::FLAC__StreamMetadata_StreamInfo& info,
+                                FlacNamespace::FLAC__byte* buffer)
     {
         using namespace FlacNamespace;
-        auto& info = metadata->data.stream_info;
-
-        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
         const unsigned int channelsMinus1 = info.channels - 1;
         const unsigned int bitsMinus1 = info.bits_per_sample - 1;
 
@@ -488,6 +570,14 @@ public:
         buffer[13] = (FLAC__byte) (((bitsMinus1 & 0x0f) << 4) | (unsigned int) ((info.total_samples >> 32) & 0x0f));
         packUint32 ((FLAC__uint32) info.total_samples, buffer + 14, 4);
         memcpy (buffer + 18, info.md5sum, 16);
+    }
+
+    void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
+    {
+        using namespace FlacNamespace;
+
+        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
+        packStreamInfo (metadata->data.stream_info, buffer);
 
         const bool seekOk = output->setPosition (streamStartPos + 4);
         ignoreUnused (seekOk);
@@ -541,6 +631,360 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
 
+//==============================================================================
+/*  Divides the stream into segments of a whole number of frames, and encodes each one
+    with its own encoder on a ThreadPool. FLAC frames don't depend on each other, so
+    when the segments are joined back together in order, the only things that need
+    fixing are the frame numbers in the frame headers, and the two CRCs that cover them.
+*/
+class ParallelFlacWriter  : public AudioFormatWriter
+{
+public:
+    ParallelFlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits,
+                        int quality, ThreadPool& pool)
+        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
+          threadPool (pool),
+          qualityOptionIndex (quality),
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll),
+          maxSegmentsInProgress (pool.getNumThreads() + 1)
+    {
+        // check that libFLAC is happy with the settings before using them on other threads
+        auto* encoder = FlacNamespace::FLAC__stream_encoder_new();
+        configureFlacEncoder (encoder, numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
+        ok = FLAC__stream_encoder_init_stream (encoder, discardWriteCallback, nullptr, nullptr, nullptr, nullptr)
+                == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+        FlacNamespace::FLAC__stream_encoder_delete (encoder);
+
+        if (ok)
+        {
+            // the STREAMINFO is filled in when the stream is finished
+            output->write ("fLaC", 4);
+            output->writeIntBigEndian ((int) (0x80000000u | FLAC__STREAM_METADATA_STREAMINFO_LENGTH));
+            output->writeRepeatedByte (0, FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+        }
+
+        FlacNamespace::FLAC__MD5Init (&md5);
+        startNewSegment();
+    }
+
+    ~ParallelFlacWriter() override
+    {
+        if (ok)
+        {
+            if (currentSegment->numSamples > 0)
+                launchCurrentSegment();
+
+            writeFinishedSegments (true);
+            writeStreamInfo();
+            output->flush();
+        }
+        else
+        {
+            output = nullptr; // to stop the base class deleting this, as it needs to be returned
+                              // to the caller of createWriter()
+
+            FlacNamespace::FLAC__MD5Final (streamInfo.md5sum, &md5);
+        }
+    }
+
+    //==============================================================================
+    bool write (const int** samplesToWrite, int numSamples) override
+    {
+        if (! ok || writeFailed)
+            return false;
+
+        HeapBlock<int*> channels;
+        HeapBlock<int> temp;
+        samplesToWrite = shiftSamplesForFlac (samplesToWrite, numSamples, numChannels, bitsPerSample, channels, temp);
+
+        for (int offset = 0; offset < numSamples;)
+        {
+            auto numToCopy = jmin (numSamples - offset, samplesPerSegment - currentSegment->numSamples);
+
+            for (unsigned int i = 0; i < numChannels; ++i)
+            {
+                auto* dest = currentSegment->getChannel ((int) i) + currentSegment->numSamples;
+
+                if (samplesToWrite[i] != nullptr)
+                    memcpy (dest, samplesToWrite[i] + offset, sizeof (int) * (size_t) numToCopy);
+                else
+                    zeromem (dest, sizeof (int) * (size_t) numToCopy);
+            }
+
+            currentSegment->numSamples += numToCopy;
+            offset += numToCopy;
+
+            if (currentSegment->numSamples == samplesPerSegment)
+            {
+                launchCurrentSegment();
+                startNewSegment();
+            }
+
+            if (! writeFinishedSegments (false))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool ok = false;
+
+private:
+    //==============================================================================
+    enum
+    {
+        samplesPerFrame = 4096,
+        samplesPerSegment = samplesPerFrame * 32
+    };
+
+    struct Segment
+    {
+        Segment (int channels, uint32 firstFrame)
+            : numChannels (channels), firstFrameNumber (firstFrame),
+              samples ((size_t) (channels * samplesPerSegment))
+        {
+        }
+
+        int* getChannel (int channel) const noexcept    { return samples.get() + channel * samplesPerSegment; }
+
+        void encode (uint32 bitsPerSample, double sampleRate, int qualityOptionIndex)
+        {
+            auto* encoder = FlacNamespace::FLAC__stream_encoder_new();
+            configureFlacEncoder (encoder, (uint32) numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
+            FLAC__stream_encoder_set_blocksize (encoder, samplesPerFrame);
+
+            if (FLAC__stream_encoder_init_stream (encoder, segmentWriteCallback, nullptr, nullptr, nullptr, this)
+                    == FlacNamespace::FLAC__STREAM_ENCODER_INIT_STATUS_OK)
+            {
+                HeapBlock<const int*> channels ((size_t) numChannels);
+
+                for (int i = 0; i < numChannels; ++i)
+                    channels[i] = getChannel (i);
+
+                succeeded = FLAC__stream_encoder_process (encoder, (const FlacNamespace::FLAC__int32**) channels.get(),
+                                                          (unsigned) numSamples) != 0
+                             && FLAC__stream_encoder_finish (encoder) != 0
+                             && succeeded;
+            }
+            else
+            {
+                succeeded = false;
+            }
+
+            FlacNamespace::FLAC__stream_encoder_delete (encoder);
+            samples.free();
+            finished.signal();
+        }
+
+        // Copies a frame, changing the frame number in its header to count from the start
+        // of the stream rather than the start of this segment.
+        bool addFrame (const uint8* frame, size_t size, uint32 frameNumber)
+        {
+            if (size < 8)
+                return false;
+
+            auto numberLength = jmax (1, countLeadingOnes (frame[4]));
+            auto headerEnd = (size_t) (4 + numberLength);
+            auto blockSizeCode = frame[2] >> 4;
+            auto sampleRateCode = frame[2] & 0x0f;
+
+            if (blockSizeCode == 6)  headerEnd += 1;
+            if (blockSizeCode == 7)  headerEnd += 2;
+            if (sampleRateCode == 12)  headerEnd += 1;
+            if (sampleRateCode == 13 || sampleRateCode == 14)  headerEnd += 2;
+
+            // the header is followed by its CRC-8, and the frame ends with a CRC-16
+            if (headerEnd + 3 > size)
+                return false;
+
+            uint8 header[32];
+            memcpy (header, frame, 4);
+            auto newNumberLength = writeFrameNumber (header + 4, frameNumber);
+            auto numExtraBytes = headerEnd - (size_t) (4 + numberLength);
+            memcpy (header + 4 + newNumberLength, frame + 4 + numberLength, numExtraBytes);
+
+            auto headerSize = (size_t) (4 + newNumberLength) + numExtraBytes;
+            header[headerSize] = FlacNamespace::FLAC__crc8 (header, (unsigned) headerSize);
+            ++headerSize;
+
+            auto frameStart = encodedData.getSize();
+            encodedData.append (header, headerSize);
+            encodedData.append (frame + headerEnd + 1, size - (headerEnd + 1) - 2);
+
+            auto newFrameSize = encodedData.getSize() - frameStart;
+            auto crc = FlacNamespace::FLAC__crc16 (static_cast<const uint8*> (encodedData.getData()) + frameStart, (unsigned) newFrameSize);
+            uint8 crcBytes[2] = { (uint8) (crc >> 8), (uint8) crc };
+            encodedData.append (crcBytes, 2);
+
+            minFrameSize = jmin (minFrameSize, (unsigned) newFrameSize + 2);
+            maxFrameSize = jmax (maxFrameSize, (unsigned) newFrameSize + 2);
+            return true;
+        }
+
+        static int countLeadingOnes (uint8 byte) noexcept
+        {
+            int n = 0;
+
+            while (n < 8 && (byte & (0x80 >> n)) != 0)
+                ++n;
+
+            return n;
+        }
+
+        // writes a frame number using FLAC's extended UTF-8 style coding
+        static int writeFrameNumber (uint8* dest, uint32 value) noexcept
+        {
+            if (value < 0x80)
+            {
+                dest[0] = (uint8) value;
+                return 1;
+            }
+
+            auto numBytes = value < 0x800 ? 2 : value < 0x10000 ? 3 : value < 0x200000 ? 4
+                                              : value < 0x4000000 ? 5 : 6;
+
+            for (int i = numBytes; --i > 0;)
+            {
+                dest[i] = (uint8) (0x80 | (value & 0x3f));
+                value >>= 6;
+            }
+
+            dest[0] = (uint8) (((0xff00 >> numBytes) & 0xff) | value);
+            return numBytes;
+        }
+
+        static FlacNamespace::FLAC__StreamEncoderWriteStatus segmentWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                                   const FlacNamespace::FLAC__byte buffer[],
+                                                                                   size_t bytes,
+                                                                                   unsigned int samples,
+                                                                                   unsigned int currentFrame,
+                                                                                   void* clientData)
+        {
+            auto& segment = *static_cast<Segment*> (clientData);
+
+            // each frame arrives in a single callback, and anything else is the
+            // segment's own header and metadata, which aren't needed
+            if (samples > 0 && ! segment.addFrame (buffer, bytes, segment.firstFrameNumber + currentFrame))
+                segment.succeeded = false;
+
+            return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+        }
+
+        const int numChannels;
+        const uint32 firstFrameNumber;
+        HeapBlock<int> samples;
+        int numSamples = 0;
+
+        MemoryBlock encodedData;
+        unsigned int minFrameSize = 0xffffff, maxFrameSize = 0;
+        bool succeeded = true;
+        WaitableEvent finished;
+
+        JUCE_DECLARE_NON_COPYABLE (Segment)
+    };
+
+    ThreadPool& threadPool;
+    const int qualityOptionIndex;
+    const int64 streamStartPos;
+    const int maxSegmentsInProgress;
+    uint32 nextFrameNumber = 0;
+    bool writeFailed = false;
+
+    std::unique_ptr<Segment> currentSegment;
+    OwnedArray<Segment> segmentsInProgress;
+
+    FlacNamespace::FLAC__MD5Context md5;
+    FlacNamespace::FLAC__StreamMetadata_StreamInfo streamInfo {};
+
+    void startNewSegment()
+    {
+        currentSegment.reset (new Segment ((int) numChannels, nextFrameNumber));
+        nextFrameNumber += samplesPerSegment / samplesPerFrame;
+    }
+
+    void launchCurrentSegment()
+    {
+        auto* segment = currentSegment.release();
+
+        // the checksum has to be calculated in order, so it's done here rather than on the pool
+        HeapBlock<const int*> channels (numChannels);
+
+        for (unsigned int i = 0; i < numChannels; ++i)
+            channels[i] = segment->getChannel ((int) i);
+
+        FlacNamespace::FLAC__MD5Accumulate (&md5, (const FlacNamespace::FLAC__int32* const*) channels.get(), numChannels,
+                                            (unsigned) segment->numSamples, (bitsPerSample + 7) / 8);
+
+        streamInfo.total_samples += (FlacNamespace::FLAC__uint64) segment->numSamples;
+        segmentsInProgress.add (segment);
+
+        auto bits = bitsPerSample;
+        auto rate = sampleRate;
+        auto quality = qualityOptionIndex;
+
+        threadPool.addJob ([segment, bits, rate, quality] { segment->encode (bits, rate, quality); });
+    }
+
+    // writes out any segments at the front of the queue that have finished, waiting for
+    // them if there are too many still in progress, or if everything has to be written
+    bool writeFinishedSegments (bool writeAll)
+    {
+        while (! segmentsInProgress.isEmpty())
+        {
+            auto* segment = segmentsInProgress.getFirst();
+
+            if (writeAll || segmentsInProgress.size() > maxSegmentsInProgress)
+                segment->finished.wait();
+            else if (! segment->finished.wait (0))
+                break;
+
+            if (! (segment->succeeded && output->write (segment->encodedData.getData(), segment->encodedData.getSize())))
+                writeFailed = true;
+
+            streamInfo.min_framesize = streamInfo.min_framesize == 0 ? segment->minFrameSize
+                                                                     : jmin (streamInfo.min_framesize, segment->minFrameSize);
+            streamInfo.max_framesize = jmax (streamInfo.max_framesize, segment->maxFrameSize);
+
+            segmentsInProgress.remove (0);
+        }
+
+        return ! writeFailed;
+    }
+
+    void writeStreamInfo()
+    {
+        using namespace FlacNamespace;
+
+        streamInfo.min_blocksize = samplesPerFrame;
+        streamInfo.max_blocksize = samplesPerFrame;
+        streamInfo.sample_rate = (unsigned int) sampleRate;
+        streamInfo.channels = numChannels;
+        streamInfo.bits_per_sample = jmin ((unsigned int) 24, bitsPerSample);
+        FLAC__MD5Final (streamInfo.md5sum, &md5);
+
+        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
+        FlacWriter::packStreamInfo (streamInfo, buffer);
+
+        const bool seekOk = output->setPosition (streamStartPos + 8);
+        ignoreUnused (seekOk);
+
+        // if this fails, you've given it an output stream that can't seek! It needs
+        // to be able to seek back to write the header
+        jassert (seekOk);
+
+        output->write (buffer, FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+    }
+
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus discardWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                               const FlacNamespace::FLAC__byte*, size_t,
+                                                                               unsigned int, unsigned int, void*)
+    {
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelFlacWriter)
+};
+
 
 //==============================================================================
 FlacAudioFormat::FlacAudioFormat()  : AudioFormat (flacFormatName, ".flac") {}
@@ -561,6 +1005,11 @@ bool FlacAudioFormat::canDoStereo()     { return true; }
 bool FlacAudioFormat::canDoMono()       { return true; }
 bool FlacAudioFormat::isCompressed()    { return true; }
 
+bool FlacAudioFormat::recognisesHeader (const void* headerData, size_t numBytes)
+{
+    return numBytes >= 4 && memcmp (headerData, "fLaC", 4) == 0;
+}
+
 AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<FlacReader> r (new FlacReader (in));
@@ -574,6 +1023,21 @@ AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool
     return nullptr;
 }
 
+AudioFormatReader* FlacAudioFormat::createReaderForMappedFile (const File& file, ThreadPool* poolForParallelDecoding)
+{
+    std::unique_ptr<MemoryMappedFile> map (new MemoryMappedFile (file, MemoryMappedFile::readOnly));
+
+    if (map->getData() == nullptr || map->getSize() == 0)
+        return nullptr;
+
+    std::unique_ptr<MemoryMappedFlacReader> r (new MemoryMappedFlacReader (std::move (map), poolForParallelDecoding));
+
+    if (r->sampleRate > 0)
+        return r.release();
+
+    return nullptr;
+}
+
 AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
                                                      double sampleRate,
                                                      unsigned int numberOfChannels,
@@ -592,6 +1056,28 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     return nullptr;
 }
 
+AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
+                                                     double sampleRate,
+                                                     unsigned int numberOfChannels,
+                                                     int bitsPerSample,
+                                                     const StringPairArray& metadataValues,
+                                                     int qualityOptionIndex,
+                                                     ThreadPool* poolForParallelEncoding)
+{
+    if (poolForParallelEncoding == nullptr)
+        return createWriterFor (out, sampleRate, numberOfChannels, bitsPerSample, metadataValues, qualityOptionIndex);
+
+    if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample))
+    {
+        std::unique_ptr<ParallelFlacWriter> w (new ParallelFlacWriter (out, sampleRate, numberOfChannels, (uint32) bitsPerSample,
+                                                                       qualityOptionIndex, *poolForParallelEncoding));
+        if (w->ok)
+            return w.release();
+    }
+
+    return nullptr;
+}
+
 StringArray FlacAudioFormat::getQualityOptions()
 {
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
@@ -53,17 +53,60 @@ public:
     bool canDoMono() override;
     bool isCompressed() override;
     StringArray getQualityOptions() override;
+    bool recognisesHeader (const void* headerData, size_t numBytes) override;
 
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader that decodes a FLAC file from a memory-mapped view of it.
+
+        This avoids the overhead of reading through a FileInputStream. If you also
+        supply a ThreadPool, any large read is split into separate ranges, and these
+        are decoded in parallel by the pool's threads and the calling thread. Each
+        range has its own FLAC decoder, which seeks straight to its start position
+        using the file's SEEKTABLE if it has one. This makes bulk loading and
+        thumbnail generation much quicker for long files.
+
+        The pool can be shared between many readers. Don't call read() on the reader
+        from one of the pool's own threads, as it has to wait for the pool's jobs to
+        finish.
+
+        Returns nullptr if the file can't be mapped or isn't a valid FLAC file. The
+        caller is responsible for deleting the reader that is returned.
+    */
+    AudioFormatReader* createReaderForMappedFile (const File& file,
+                                                  ThreadPool* poolForParallelDecoding = nullptr);
+
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
                                         unsigned int numberOfChannels,
                                         int bitsPerSample,
                                         const StringPairArray& metadataValues,
                                         int qualityOptionIndex) override;
+
+    /** Creates a writer that encodes the stream in parallel on a ThreadPool.
+
+        The incoming audio is divided into segments, each made up of a whole number of
+        FLAC frames, and these are encoded by separate encoders on the pool's threads.
+        The encoded segments are then written to the stream in order, so the result is
+        an ordinary FLAC file. The write() method will only block if the pool has fallen
+        behind, and deleting the writer waits for it to finish.
+
+        If the pool is nullptr, this is the same as the other createWriterFor() method.
+        The pool must not be deleted before the writer, and as with any FLAC writer, the
+        stream must be seekable so that the header can be filled in at the end.
+    */
+    AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
+                                        double sampleRateToUse,
+                                        unsigned int numberOfChannels,
+                                        int bitsPerSample,
+                                        const StringPairArray& metadataValues,
+                                        int qualityOptionIndex,
+                                        ThreadPool* poolForParallelEncoding);
+
+    using AudioFormat::createWriterFor;
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
@@ -1569,6 +1569,77 @@ struct MP3Stream
         return true;
     }
 
+    // Parses the rest of the frames after the furthest one that's been seen without
+    // decoding them, so that the index of frame positions covers the whole stream
+    void indexAllFrames()
+    {
+        if (! frameStreamPositions.isEmpty())
+            seek ((frameStreamPositions.size() - 1) * storedStartPosInterval);
+
+        for (int attempts = 0; attempts < 10 && ! stream.isExhausted();)
+        {
+            int dummy = 0;
+            auto result = decodeNextBlock (nullptr, nullptr, dummy);
+
+            if (result < 0)
+                break;
+
+            attempts = (result > 0) ? attempts + 1 : 0;
+        }
+    }
+
+    void writeIndex (OutputStream& out) const
+    {
+        out.writeCompressedInt (storedStartPosInterval);
+        out.writeCompressedInt (frameStreamPositions.size());
+
+        int64 lastPosition = 0;
+
+        for (auto position : frameStreamPositions)
+        {
+            out.writeCompressedInt ((int) (position - lastPosition));
+            lastPosition = position;
+        }
+    }
+
+    bool readIndex (InputStream& in)
+    {
+        if (in.readCompressedInt() != storedStartPosInterval)
+            return false;
+
+        auto numPositions = in.readCompressedInt();
+
+        if (numPositions <= 0 || numPositions > in.getNumBytesRemaining())
+            return false;
+
+        Array<int64> positions;
+        positions.ensureStorageAllocated (numPositions);
+        int64 lastPosition = 0;
+
+        for (int i = 0; i < numPositions; ++i)
+        {
+            if (in.isExhausted())
+                return false;
+
+            auto delta = in.readCompressedInt();
+
+            if (delta < 0)
+                return false;
+
+            lastPosition += delta;
+            positions.add (lastPosition);
+        }
+
+        // an index for a different file would be unlikely to start in the same place
+        if (! frameStreamPositions.isEmpty() && frameStreamPositions.getFirst() != positions.getFirst())
+            return false;
+
+        if (positions.size() > frameStreamPositions.size())
+            frameStreamPositions.swapWith (positions);
+
+        return true;
+    }
+
     MP3Frame frame;
     VBRTagData vbrTagData;
     BufferedInputStream stream;
@@ -3027,7 +3098,30 @@ public:
         return true;
     }
 
+    //==============================================================================
+    void buildSeekIndex()
+    {
+        stream.indexAllFrames();
+        currentPosition = -1; // makes the next read seek back to wherever it needs to be
+    }
+
+    void writeSeekIndex (OutputStream& out)
+    {
+        out.writeInt (seekIndexMagic);
+        out.writeInt64 (input->getTotalLength());
+        stream.writeIndex (out);
+    }
+
+    bool readSeekIndex (InputStream& in)
+    {
+        return in.readInt() == seekIndexMagic
+                && in.readInt64() == input->getTotalLength()
+                && stream.readIndex (in);
+    }
+
 private:
+    enum { seekIndexMagic = 0x3149334d }; // "M3I1"
+
     MP3Stream stream;
     int64 currentPosition;
     enum { decodedDataSize = 1152 };
@@ -3130,6 +3224,17 @@ bool MP3AudioFormat::canDoMono()                    { return true; }
 bool MP3AudioFormat::isCompressed()                 { return true; }
 StringArray MP3AudioFormat::getQualityOptions()     { return {}; }
 
+bool MP3AudioFormat::recognisesHeader (const void* headerData, size_t numBytes)
+{
+    auto* header = static_cast<const uint8*> (headerData);
+
+    if (numBytes >= 3 && memcmp (header, "ID3", 3) == 0)
+        return true;
+
+    // otherwise it should start with a frame sync, and a layer that isn't the reserved value
+    return numBytes >= 2 && header[0] == 0xff && (header[1] & 0xe0) == 0xe0 && (header[1] & 0x06) != 0;
+}
+
 AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, const bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream));
@@ -3143,6 +3248,41 @@ AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, c
     return nullptr;
 }
 
+bool MP3AudioFormat::buildSeekIndex (AudioFormatReader& reader)
+{
+    if (auto* r = dynamic_cast<MP3Decoder::MP3Reader*> (&reader))
+    {
+        r->buildSeekIndex();
+        return true;
+    }
+
+    return false;
+}
+
+bool MP3AudioFormat::saveSeekIndex (AudioFormatReader& reader, MemoryBlock& destData)
+{
+    if (auto* r = dynamic_cast<MP3Decoder::MP3Reader*> (&reader))
+    {
+        destData.reset();
+        MemoryOutputStream out (destData, false);
+        r->writeSeekIndex (out);
+        return true;
+    }
+
+    return false;
+}
+
+bool MP3AudioFormat::loadSeekIndex (AudioFormatReader& reader, const void* data, size_t numBytes)
+{
+    if (auto* r = dynamic_cast<MP3Decoder::MP3Reader*> (&reader))
+    {
+        MemoryInputStream in (data, numBytes, false);
+        return r->readSeekIndex (in);
+    }
+
+    return false;
+}
+
 AudioFormatWriter* MP3AudioFormat::createWriterFor (OutputStream*, double /*sampleRateToUse*/,
                                                     unsigned int /*numberOfChannels*/, int /*bitsPerSample*/,
                                                     const StringPairArray& /*metadataValues*/, int /*qualityOptionIndex*/)
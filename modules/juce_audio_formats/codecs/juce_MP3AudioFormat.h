@@ -59,10 +59,44 @@ public:
     bool canDoMono() override;
     bool isCompressed() override;
     StringArray getQualityOptions() override;
+    bool recognisesHeader (const void* headerData, size_t numBytes) override;
 
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream*, bool deleteStreamIfOpeningFails) override;
 
+    //==============================================================================
+    /** Makes a reader scan the frame headers of its whole stream.
+
+        An MP3 reader keeps an index of the positions of the frames that it has seen,
+        so seeking back to an earlier position is quick, but seeking forwards into an
+        area that hasn't been read yet means parsing every frame on the way. This
+        fills in the index for the whole stream without decoding any audio, so that
+        all later seeks take the same short time.
+
+        This can take a while for a long file, so you may want to do it on a background
+        thread with a separate reader, and then pass its index to the reader that you're
+        using with saveSeekIndex() and loadSeekIndex().
+
+        Returns false if the reader wasn't created by an MP3AudioFormat.
+    */
+    static bool buildSeekIndex (AudioFormatReader& reader);
+
+    /** Writes a reader's current seek index to a block of data.
+
+        This can be stored alongside the file, and given back to a new reader for the same
+        file with loadSeekIndex(). Returns false if the reader wasn't created by an
+        MP3AudioFormat.
+    */
+    static bool saveSeekIndex (AudioFormatReader& reader, MemoryBlock& destData);
+
+    /** Gives a reader a seek index that was created by saveSeekIndex().
+
+        Returns false if the reader wasn't created by an MP3AudioFormat, or the data is
+        invalid or was made from a different file, in which case the reader will carry on
+        building its own index as it goes.
+    */
+    static bool loadSeekIndex (AudioFormatReader& reader, const void* data, size_t numBytes);
+
     AudioFormatWriter* createWriterFor (OutputStream*, double sampleRateToUse,
                                         unsigned int numberOfChannels, int bitsPerSample,
                                         const StringPairArray& metadataValues, int qualityOptionIndex) override;
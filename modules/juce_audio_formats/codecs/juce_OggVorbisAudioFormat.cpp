@@ -196,7 +196,7 @@ public:
                 samplesInReservoir = reservoir.getNumSamples();
 
                 if (reservoirStart != (int) ov_pcm_tell (&ovFile))
-                    ov_pcm_seek (&ovFile, reservoirStart);
+                    seekTo (reservoirStart);
 
                 int bitStream = 0;
                 int offset = 0;
@@ -211,6 +211,7 @@ public:
                         break;
 
                     jassert (samps <= numToRead);
+                    addSeekPoint();
 
                     for (int i = jmin ((int) numChannels, reservoir.getNumChannels()); --i >= 0;)
                         memcpy (reservoir.getWritePointer (i, offset), dataIn[i], sizeof (float) * (size_t) samps);
@@ -234,6 +235,68 @@ public:
         return true;
     }
 
+    //==============================================================================
+    void buildSeekIndex()
+    {
+        // the next refill will see that the decoder has moved, and seek back
+        ov_pcm_seek (&ovFile, seekPoints.isEmpty() ? 0 : seekPoints.getLast().sample);
+
+        while (skipSamples (4096))
+        {}
+    }
+
+    void writeSeekIndex (OutputStream& out)
+    {
+        out.writeInt (seekIndexMagic);
+        out.writeInt64 (input->getTotalLength());
+        out.writeCompressedInt (seekPoints.size());
+
+        SeekPoint last;
+
+        for (auto& p : seekPoints)
+        {
+            out.writeCompressedInt ((int) (p.sample - last.sample));
+            out.writeCompressedInt ((int) (p.bytePosition - last.bytePosition));
+            last = p;
+        }
+    }
+
+    bool readSeekIndex (InputStream& in)
+    {
+        if (in.readInt() != seekIndexMagic || in.readInt64() != input->getTotalLength())
+            return false;
+
+        auto numPoints = in.readCompressedInt();
+
+        if (numPoints < 0 || numPoints > in.getNumBytesRemaining() / 2)
+            return false;
+
+        Array<SeekPoint> points;
+        points.ensureStorageAllocated (numPoints);
+        SeekPoint last;
+
+        for (int i = 0; i < numPoints; ++i)
+        {
+            if (in.isExhausted())
+                return false;
+
+            auto sampleDelta = in.readCompressedInt();
+            auto byteDelta = in.readCompressedInt();
+
+            if (sampleDelta < 0 || byteDelta < 0)
+                return false;
+
+            last.sample += sampleDelta;
+            last.bytePosition += byteDelta;
+            points.add (last);
+        }
+
+        if (points.size() > seekPoints.size())
+            seekPoints.swapWith (points);
+
+        return true;
+    }
+
     //==============================================================================
     static size_t oggReadCallback (void* ptr, size_t size, size_t nmemb, void* datasource)
     {
@@ -269,6 +332,101 @@ private:
     AudioBuffer<float> reservoir;
     int reservoirStart = 0, samplesInReservoir = 0;
 
+    //==============================================================================
+    /*  A pair of positions taken from the decoder at the same moment. Doing an ov_raw_seek()
+        to the byte position resumes decoding at or slightly after the sample position, and
+        the exact sample is known once it has.
+    */
+    struct SeekPoint
+    {
+        int64 sample = 0, bytePosition = 0;
+    };
+
+    Array<SeekPoint> seekPoints;
+
+    enum
+    {
+        seekPointInterval = 32768,
+        maxSamplesToSkip = 4 * seekPointInterval,
+        seekIndexMagic = 0x3149474f // "OGI1"
+    };
+
+    void addSeekPoint()
+    {
+        SeekPoint point { (int64) ov_pcm_tell (&ovFile), (int64) ov_raw_tell (&ovFile) };
+
+        if (point.sample < 0 || point.bytePosition < 0)
+            return;
+
+        // keep the points in order, and no closer together than the interval
+        auto index = findSeekPointBefore (point.sample);
+
+        if (index >= 0 && point.sample - seekPoints.getUnchecked (index).sample < seekPointInterval)
+            return;
+
+        if (index + 1 < seekPoints.size() && seekPoints.getUnchecked (index + 1).sample - point.sample < seekPointInterval)
+            return;
+
+        seekPoints.insert (index + 1, point);
+    }
+
+    // returns the index of the last point at or before the given sample, or -1
+    int findSeekPointBefore (int64 sample) const noexcept
+    {
+        int start = 0, end = seekPoints.size();
+
+        while (start < end)
+        {
+            auto mid = (start + end) / 2;
+
+            if (seekPoints.getUnchecked (mid).sample <= sample)
+                start = mid + 1;
+            else
+                end = mid;
+        }
+
+        return start - 1;
+    }
+
+    void seekTo (int64 targetSample)
+    {
+        auto index = findSeekPointBefore (targetSample);
+
+        if (index >= 0)
+        {
+            auto point = seekPoints.getUnchecked (index);
+
+            if (targetSample - point.sample <= maxSamplesToSkip
+                 && ov_raw_seek (&ovFile, point.bytePosition) == 0)
+            {
+                auto position = (int64) ov_pcm_tell (&ovFile);
+
+                if (position >= 0 && position <= targetSample && skipSamples (targetSample - position))
+                    return;
+            }
+        }
+
+        ov_pcm_seek (&ovFile, targetSample);
+    }
+
+    bool skipSamples (int64 numToSkip)
+    {
+        while (numToSkip > 0)
+        {
+            float** dataIn = nullptr;
+            int bitStream = 0;
+            auto samps = ov_read_float (&ovFile, &dataIn, (int) jmin (numToSkip, (int64) 4096), &bitStream);
+
+            if (samps <= 0)
+                return false;
+
+            addSeekPoint();
+            numToSkip -= samps;
+        }
+
+        return true;
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OggReader)
 };
 
@@ -449,6 +607,11 @@ bool OggVorbisAudioFormat::canDoStereo()    { return true; }
 bool OggVorbisAudioFormat::canDoMono()      { return true; }
 bool OggVorbisAudioFormat::isCompressed()   { return true; }
 
+bool OggVorbisAudioFormat::recognisesHeader (const void* headerData, size_t numBytes)
+{
+    return numBytes >= 4 && memcmp (headerData, "OggS", 4) == 0;
+}
+
 AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<OggReader> r (new OggReader (in));
@@ -462,6 +625,41 @@ AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool
     return nullptr;
 }
 
+bool OggVorbisAudioFormat::buildSeekIndex (AudioFormatReader& reader)
+{
+    if (auto* r = dynamic_cast<OggReader*> (&reader))
+    {
+        r->buildSeekIndex();
+        return true;
+    }
+
+    return false;
+}
+
+bool OggVorbisAudioFormat::saveSeekIndex (AudioFormatReader& reader, MemoryBlock& destData)
+{
+    if (auto* r = dynamic_cast<OggReader*> (&reader))
+    {
+        destData.reset();
+        MemoryOutputStream out (destData, false);
+        r->writeSeekIndex (out);
+        return true;
+    }
+
+    return false;
+}
+
+bool OggVorbisAudioFormat::loadSeekIndex (AudioFormatReader& reader, const void* data, size_t numBytes)
+{
+    if (auto* r = dynamic_cast<OggReader*> (&reader))
+    {
+        MemoryInputStream in (data, numBytes, false);
+        return r->readSeekIndex (in);
+    }
+
+    return false;
+}
+
 AudioFormatWriter* OggVorbisAudioFormat::createWriterFor (OutputStream* out,
                                                           double sampleRate,
                                                           unsigned int numChannels,
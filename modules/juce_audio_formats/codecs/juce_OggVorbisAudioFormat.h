@@ -53,6 +53,7 @@ public:
     bool canDoMono() override;
     bool isCompressed() override;
     StringArray getQualityOptions() override;
+    bool recognisesHeader (const void* headerData, size_t numBytes) override;
 
     //==============================================================================
     /** Tries to estimate the quality level of an ogg file based on its size.
@@ -65,6 +66,37 @@ public:
     */
     int estimateOggFileQuality (const File& source);
 
+    //==============================================================================
+    /** Makes a reader decode its whole stream to build an index of seek points.
+
+        An Ogg reader records a seek point every so often as it decodes, and uses these
+        to jump close to a requested position, rather than using the vorbis library's
+        bisection search through the file. This fills in the index for the whole
+        stream, so that all later seeks take the same short time.
+
+        This has to decode the whole file, so you may want to do it on a background
+        thread with a separate reader, and then pass its index to the reader that you're
+        using with saveSeekIndex() and loadSeekIndex().
+
+        Returns false if the reader wasn't created by an OggVorbisAudioFormat.
+    */
+    static bool buildSeekIndex (AudioFormatReader& reader);
+
+    /** Writes a reader's current seek index to a block of data.
+
+        This can be stored alongside the file, and given back to a new reader for the same
+        file with loadSeekIndex(). Returns false if the reader wasn't created by an
+        OggVorbisAudioFormat.
+    */
+    static bool saveSeekIndex (AudioFormatReader& reader, MemoryBlock& destData);
+
+    /** Gives a reader a seek index that was created by saveSeekIndex().
+
+        Returns false if the reader wasn't created by an OggVorbisAudioFormat, or the data
+        is invalid or was made from a different file.
+    */
+    static bool loadSeekIndex (AudioFormatReader& reader, const void* data, size_t numBytes);
+
     //==============================================================================
     /** Metadata property name used by the Ogg writer - if you set a string for this
         value, it will be written into the ogg file as the name of the encoder app.
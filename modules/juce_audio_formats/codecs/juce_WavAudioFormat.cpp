@@ -1671,6 +1671,15 @@ bool WavAudioFormat::isChannelLayoutSupported (const AudioChannelSet& channelSet
     return true;
 }
 
+bool WavAudioFormat::recognisesHeader (const void* headerData, size_t numBytes)
+{
+    auto* header = static_cast<const char*> (headerData);
+
+    return numBytes >= 12
+            && (memcmp (header, "RIFF", 4) == 0 || memcmp (header, "RF64", 4) == 0)
+            && memcmp (header + 8, "WAVE", 4) == 0;
+}
+
 AudioFormatReader* WavAudioFormat::createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<WavAudioFormatReader> r (new WavAudioFormatReader (sourceStream));
@@ -1861,6 +1870,14 @@ struct WaveAudioFormatTests : public UnitTest
             expect (reader != nullptr);
             expect (reader->metadataValues == metadataValues, "Somehow, the metadata is different!");
         }
+
+        {
+            beginTest ("Recognising a wave header");
+
+            expect (format.recognisesHeader (memoryBlock.getData(), memoryBlock.getSize()));
+            expect (! format.recognisesHeader ("FORM\0\0\0\0AIFF", 12));
+            expect (! format.recognisesHeader (memoryBlock.getData(), 8));
+        }
     }
 
 private:
@@ -189,6 +189,7 @@ public:
     bool canDoStereo() override;
     bool canDoMono() override;
     bool isChannelLayoutSupported (const AudioChannelSet& channelSet) override;
+    bool recognisesHeader (const void* headerData, size_t numBytes) override;
 
     //==============================================================================
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
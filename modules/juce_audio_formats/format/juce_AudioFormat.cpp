@@ -50,6 +50,11 @@ bool AudioFormat::canHandleFile (const File& f)
     return false;
 }
 
+bool AudioFormat::recognisesHeader (const void*, size_t)
+{
+    return false;
+}
+
 const String& AudioFormat::getFormatName() const                { return formatName; }
 StringArray AudioFormat::getFileExtensions() const              { return fileExtensions; }
 bool AudioFormat::isCompressed()                                { return false; }
@@ -64,6 +64,20 @@ public:
     */
     virtual bool canHandleFile (const File& fileToTest);
 
+    /** Returns true if the first few bytes of a stream look like the start of a file in
+        this format.
+
+        AudioFormatManager::createReaderFor() uses this to pick which format to try
+        first, so it should be a quick check of any magic numbers, and doesn't need
+        to be definitive: a false positive just means that another format gets tried
+        afterwards. The AudioFormatManager passes in at least the first 16 bytes of
+        the stream, unless the stream is shorter than that.
+
+        The base class implementation returns false, so formats that don't override it
+        are only tried after any formats that recognise the header.
+    */
+    virtual bool recognisesHeader (const void* headerData, size_t numBytes);
+
     /** Returns a set of sample rates that the format can read and write. */
     virtual Array<int> getPossibleSampleRates() = 0;
 
@@ -144,19 +144,31 @@ AudioFormatReader* AudioFormatManager::createReaderFor (InputStream* audioFileSt
         std::unique_ptr<InputStream> in (audioFileStream);
         auto originalStreamPos = in->getPosition();
 
-        for (auto* af : knownFormats)
+        char header[16] = {};
+        auto headerSize = (size_t) jmax (0, in->read (header, (int) sizeof (header)));
+        in->setPosition (originalStreamPos);
+
+        // The formats that recognise the header get the first go, so that a typical file
+        // only gets parsed once. The rest are only tried if none of those can open it.
+        for (auto recognised : { true, false })
         {
-            if (auto* r = af->createReaderFor (in.get(), false))
+            for (auto* af : knownFormats)
             {
-                in.release();
-                return r;
-            }
+                if (af->recognisesHeader (header, headerSize) != recognised)
+                    continue;
 
-            in->setPosition (originalStreamPos);
+                if (auto* r = af->createReaderFor (in.get(), false))
+                {
+                    in.release();
+                    return r;
+                }
+
+                in->setPosition (originalStreamPos);
 
-            // the stream that is passed-in must be capable of being repositioned so
-            // that all the formats can have a go at opening it.
-            jassert (in->getPosition() == originalStreamPos);
+                // the stream that is passed-in must be capable of being repositioned so
+                // that all the formats can have a go at opening it.
+                jassert (in->getPosition() == originalStreamPos);
+            }
         }
     }
 
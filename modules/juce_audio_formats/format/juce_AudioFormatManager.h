@@ -126,7 +126,9 @@ public:
         reader that is returned, so the caller should not keep any references to it.
 
         The stream that is passed-in must be capable of being repositioned so
-        that all the formats can have a go at opening it.
+        that all the formats can have a go at opening it. The first few bytes are
+        read before any format is tried, and formats whose
+        AudioFormat::recognisesHeader() method accepts them are tried first.
 
         If none of the registered formats can open the stream, it'll return nullptr.
         If it returns a reader, it's the caller's responsibility to delete the reader.
@@ -195,49 +195,101 @@ void AudioFormatReader::read (AudioBuffer<float>* buffer,
     }
 }
 
-void AudioFormatReader::readMaxLevels (int64 startSampleInFile, int64 numSamples,
-                                       Range<float>* const results, const int channelsToRead)
+//==============================================================================
+struct AudioFormatReader::PeakCache
 {
-    jassert (channelsToRead > 0 && channelsToRead <= (int) numChannels);
+    PeakCache (int blockSize, int channels)  : samplesPerBlock (blockSize), numChannels (channels) {}
 
-    if (numSamples <= 0)
+    int getNumBlocks() const noexcept
     {
-        for (int i = 0; i < channelsToRead; ++i)
-            results[i] = Range<float>();
+        return levels.isEmpty() ? 0 : levels.getReference (0).size() / numChannels;
+    }
 
-        return;
+    void addBlockLevels (Array<Range<float>>&& blockLevels)
+    {
+        levels.add (std::move (blockLevels));
+
+        // each level above the first one merges pairs of blocks from the one below it
+        while (levels.getLast().size() > numChannels)
+        {
+            auto& finer = levels.getReference (levels.size() - 1);
+            auto numFinerBlocks = finer.size() / numChannels;
+
+            Array<Range<float>> coarser;
+            coarser.ensureStorageAllocated ((numFinerBlocks + 1) / 2 * numChannels);
+
+            for (int block = 0; block < numFinerBlocks; block += 2)
+            {
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    auto r = finer.getUnchecked (block * numChannels + i);
+
+                    if (block + 1 < numFinerBlocks)
+                        r = r.getUnionWith (finer.getUnchecked ((block + 1) * numChannels + i));
+
+                    coarser.add (r);
+                }
+            }
+
+            levels.add (std::move (coarser));
+        }
     }
 
+    // Merges the levels of the blocks from startBlock up to (but not including) endBlock,
+    // climbing to a coarser level whenever the remaining range is aligned with it.
+    void getLevels (int startBlock, int endBlock, Range<float>* results, int numChannelsToRead) const
+    {
+        jassert (startBlock < endBlock && endBlock <= getNumBlocks());
+        bool isFirst = true;
+
+        auto addBlock = [&] (const Array<Range<float>>& level, int block)
+        {
+            for (int i = 0; i < numChannelsToRead; ++i)
+            {
+                auto r = level.getUnchecked (block * numChannels + i);
+                results[i] = isFirst ? r : results[i].getUnionWith (r);
+            }
+
+            isFirst = false;
+        };
+
+        for (int level = 0; startBlock < endBlock; ++level)
+        {
+            jassert (level < levels.size());
+            auto& data = levels.getReference (level);
+
+            if ((startBlock & 1) != 0)   addBlock (data, startBlock++);
+            if ((endBlock & 1) != 0)     addBlock (data, --endBlock);
+
+            startBlock >>= 1;
+            endBlock >>= 1;
+        }
+    }
+
+    const int samplesPerBlock, numChannels;
+    Array<Array<Range<float>>> levels;
+};
+
+static void scanMaxLevels (AudioFormatReader& reader, int64 startSampleInFile, int64 numSamples,
+                           Range<float>* results, int channelsToRead)
+{
     auto bufferSize = (int) jmin (numSamples, (int64) 4096);
     AudioBuffer<float> tempSampleBuffer ((int) channelsToRead, bufferSize);
 
     auto floatBuffer = tempSampleBuffer.getArrayOfWritePointers();
-    auto intBuffer = reinterpret_cast<int* const*> (floatBuffer);
     bool isFirstBlock = true;
 
     while (numSamples > 0)
     {
         auto numToDo = (int) jmin (numSamples, (int64) bufferSize);
 
-        if (! read (intBuffer, channelsToRead, startSampleInFile, numToDo, false))
+        // fixed-point data gets converted to float here, so all formats can use the vectorised search
+        if (! reader.read (floatBuffer, channelsToRead, startSampleInFile, numToDo))
             break;
 
         for (int i = 0; i < channelsToRead; ++i)
         {
-            Range<float> r;
-
-            if (usesFloatingPointData)
-            {
-                r = FloatVectorOperations::findMinAndMax (floatBuffer[i], numToDo);
-            }
-            else
-            {
-                auto intRange = Range<int>::findMinAndMax (intBuffer[i], numToDo);
-
-                r = Range<float> (intRange.getStart() / (float) std::numeric_limits<int>::max(),
-                                  intRange.getEnd()   / (float) std::numeric_limits<int>::max());
-            }
-
+            auto r = FloatVectorOperations::findMinAndMax (floatBuffer[i], numToDo);
             results[i] = isFirstBlock ? r : results[i].getUnionWith (r);
         }
 
@@ -247,6 +299,53 @@ void AudioFormatReader::readMaxLevels (int64 startSampleInFile, int64 numSamples
     }
 }
 
+void AudioFormatReader::readMaxLevels (int64 startSampleInFile, int64 numSamples,
+                                       Range<float>* const results, const int channelsToRead)
+{
+    jassert (channelsToRead > 0 && channelsToRead <= (int) numChannels);
+
+    if (numSamples <= 0)
+    {
+        for (int i = 0; i < channelsToRead; ++i)
+            results[i] = Range<float>();
+
+        return;
+    }
+
+    if (peakCache != nullptr)
+    {
+        auto blockSize = (int64) peakCache->samplesPerBlock;
+        auto endSample = startSampleInFile + numSamples;
+
+        auto firstBlock = jmax ((int64) 0, (startSampleInFile + blockSize - 1) / blockSize);
+        auto endBlock   = jmin ((int64) peakCache->getNumBlocks(), jmax ((int64) 0, endSample) / blockSize);
+
+        if (firstBlock < endBlock)
+        {
+            peakCache->getLevels ((int) firstBlock, (int) endBlock, results, channelsToRead);
+
+            HeapBlock<Range<float>> edgeLevels ((size_t) channelsToRead);
+
+            auto addEdge = [&] (int64 start, int64 end)
+            {
+                if (start < end)
+                {
+                    scanMaxLevels (*this, start, end - start, edgeLevels, channelsToRead);
+
+                    for (int i = 0; i < channelsToRead; ++i)
+                        results[i] = results[i].getUnionWith (edgeLevels[i]);
+                }
+            };
+
+            addEdge (startSampleInFile, firstBlock * blockSize);
+            addEdge (endBlock * blockSize, endSample);
+            return;
+        }
+    }
+
+    scanMaxLevels (*this, startSampleInFile, numSamples, results, channelsToRead);
+}
+
 void AudioFormatReader::readMaxLevels (int64 startSampleInFile, int64 numSamples,
                                        float& lowestLeft, float& highestLeft,
                                        float& lowestRight, float& highestRight)
@@ -269,6 +368,56 @@ void AudioFormatReader::readMaxLevels (int64 startSampleInFile, int64 numSamples
     highestRight = levels[1].getEnd();
 }
 
+bool AudioFormatReader::buildPeakCache (int samplesPerBlock)
+{
+    jassert (samplesPerBlock > 0);
+    peakCache.reset();
+
+    auto numBlocks = lengthInSamples / samplesPerBlock;
+
+    if (numChannels == 0 || numBlocks > std::numeric_limits<int>::max() / (int) numChannels)
+        return false;
+
+    std::unique_ptr<PeakCache> cache (new PeakCache (samplesPerBlock, (int) numChannels));
+
+    Array<Range<float>> blockLevels;
+    blockLevels.ensureStorageAllocated ((int) numBlocks * (int) numChannels);
+
+    auto blocksPerRead = jmax (1, 16384 / samplesPerBlock);
+    AudioBuffer<float> buffer ((int) numChannels, blocksPerRead * samplesPerBlock);
+
+    // only whole blocks are stored, so the cache never has to account for the zeros past the end
+    for (int64 block = 0; block < numBlocks; block += blocksPerRead)
+    {
+        auto numThisTime = (int) jmin ((int64) blocksPerRead, numBlocks - block);
+
+        if (! read (buffer.getArrayOfWritePointers(), (int) numChannels,
+                    block * samplesPerBlock, numThisTime * samplesPerBlock))
+            return false;
+
+        for (int i = 0; i < numThisTime; ++i)
+            for (int chan = 0; chan < (int) numChannels; ++chan)
+                blockLevels.add (FloatVectorOperations::findMinAndMax (buffer.getReadPointer (chan, i * samplesPerBlock),
+                                                                       samplesPerBlock));
+    }
+
+    if (! blockLevels.isEmpty())
+        cache->addBlockLevels (std::move (blockLevels));
+
+    peakCache = std::move (cache);
+    return true;
+}
+
+void AudioFormatReader::clearPeakCache()
+{
+    peakCache.reset();
+}
+
+bool AudioFormatReader::hasPeakCache() const noexcept
+{
+    return peakCache != nullptr;
+}
+
 int64 AudioFormatReader::searchForLevel (int64 startSample,
                                          int64 numSamplesToSearch,
                                          double magnitudeRangeMinimum,
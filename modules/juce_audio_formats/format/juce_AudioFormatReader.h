@@ -162,7 +162,11 @@ public:
         @param numChannelsToRead  the number of channels of data to scan. This must be
                             more than zero, but not more than the total number of channels
                             that the reader contains
-        @see read
+
+        If buildPeakCache() has been called, only the parts of the range that don't cover
+        a whole block of the cache will be read from the stream.
+
+        @see read, buildPeakCache
     */
     virtual void readMaxLevels (int64 startSample, int64 numSamples,
                                 Range<float>* results, int numChannelsToRead);
@@ -216,6 +220,27 @@ public:
                           double magnitudeRangeMaximum,
                           int minimumConsecutiveSamples);
 
+    //==============================================================================
+    /** Reads the whole stream and keeps a multi-resolution summary of its levels.
+
+        Once this has been done, readMaxLevels() can answer a query for any range from
+        the summary, only going back to the stream for any partial blocks at either end.
+        This makes it cheap to redraw a waveform at different zoom levels.
+
+        The summary holds one min/max pair per channel for every samplesPerBlock samples,
+        and roughly the same amount again for the coarser levels above that.
+
+        @returns false if the stream couldn't be read, in which case no cache is kept
+        @see clearPeakCache, readMaxLevels
+    */
+    bool buildPeakCache (int samplesPerBlock = 256);
+
+    /** Deletes any summary that was created by buildPeakCache(). */
+    void clearPeakCache();
+
+    /** Returns true if a summary has been created by buildPeakCache(). */
+    bool hasPeakCache() const noexcept;
+
 
     //==============================================================================
     /** The sample-rate of the stream. */
@@ -323,6 +348,9 @@ protected:
 private:
     String formatName;
 
+    struct PeakCache;
+    std::unique_ptr<PeakCache> peakCache;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatReader)
 };
 
@@ -229,6 +229,11 @@ public:
 
         while (writePendingData() == 0)
         {}
+
+        // releases any space that was reserved past the end of the data
+        if (preallocatedEnd > 0)
+            if (auto* fileStream = dynamic_cast<FileOutputStream*> (writer->output))
+                fileStream->truncate();
     }
 
     bool write (const float* const* data, int numSamples)
@@ -263,6 +268,17 @@ public:
     int writePendingData()
     {
         auto numToDo = fifo.getTotalSize() / 4;
+        auto batchSize = samplesPerBatch.load();
+
+        if (batchSize > 0 && isRunning)
+        {
+            numToDo = (fifo.getNumReady() / batchSize) * batchSize;
+
+            if (numToDo == 0)
+                return 10;
+        }
+
+        reserveSpaceIfNeeded();
 
         int start1, size1, start2, size2;
         fifo.prepareToRead (numToDo, start1, size1, start2, size2);
@@ -320,6 +336,17 @@ public:
         samplesPerFlush = numSamples;
     }
 
+    void setWriteBatchSize (int numSamples) noexcept
+    {
+        jassert (numSamples < fifo.getTotalSize()); // a batch has to fit in the buffer!
+        samplesPerBatch = jlimit (0, fifo.getTotalSize() - 1, numSamples);
+    }
+
+    void setPreallocationSize (int64 numBytes) noexcept
+    {
+        preallocationSize = jmax ((int64) 0, numBytes);
+    }
+
 private:
     AbstractFifo fifo;
     AudioBuffer<float> buffer;
@@ -329,8 +356,29 @@ private:
     IncomingDataReceiver* receiver = {};
     int64 samplesWritten = 0;
     int samplesPerFlush = 0, flushSampleCounter = 0;
+    std::atomic<int> samplesPerBatch { 0 };
+    std::atomic<int64> preallocationSize { 0 };
+    int64 preallocatedEnd = 0;
     std::atomic<bool> isRunning { true };
 
+    void reserveSpaceIfNeeded()
+    {
+        auto sizeAhead = preallocationSize.load();
+
+        if (sizeAhead <= 0)
+            return;
+
+        if (auto* fileStream = dynamic_cast<FileOutputStream*> (writer->output))
+        {
+            auto position = fileStream->getPosition();
+
+            // extend the reservation in big steps, once half of it has been used up
+            if (position + sizeAhead / 2 > preallocatedEnd
+                 && fileStream->preallocate (position + sizeAhead).wasOk())
+                preallocatedEnd = position + sizeAhead;
+        }
+    }
+
     JUCE_DECLARE_NON_COPYABLE (Buffer)
 };
 
@@ -358,4 +406,14 @@ void AudioFormatWriter::ThreadedWriter::setFlushInterval (int numSamplesPerFlush
     buffer->setFlushInterval (numSamplesPerFlush);
 }
 
+void AudioFormatWriter::ThreadedWriter::setWriteBatchSize (int numSamplesPerWrite) noexcept
+{
+    buffer->setWriteBatchSize (numSamplesPerWrite);
+}
+
+void AudioFormatWriter::ThreadedWriter::setPreallocationSize (int64 numBytesToReserveAhead) noexcept
+{
+    buffer->setPreallocationSize (numBytesToReserveAhead);
+}
+
 } // namespace juce
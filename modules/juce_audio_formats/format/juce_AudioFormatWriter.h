@@ -238,6 +238,26 @@ public:
         */
         void setFlushInterval (int numSamplesPerFlush) noexcept;
 
+        /** Makes the background thread wait until it has at least this many samples before
+            writing, and then write them in whole multiples of this size.
+
+            Fewer, larger writes are much kinder to the disk when many files are being recorded
+            at once. The batch size must be less than the number of samples being buffered,
+            and any partial batch that's left over is written when this object is deleted.
+            Set this to 0 to write whatever is available (this is the default).
+        */
+        void setWriteBatchSize (int numSamplesPerWrite) noexcept;
+
+        /** If the writer is writing to a FileOutputStream, this makes it ask the file system
+            to reserve space this many bytes ahead of the data that has been written, so that
+            the file is less likely to become fragmented as it grows.
+
+            Any unused space is released when this object is deleted.
+            Set this to 0 to disable preallocation (this is the default).
+            @see FileOutputStream::preallocate
+        */
+        void setPreallocationSize (int64 numBytesToReserveAhead) noexcept;
+
     private:
         class Buffer;
         std::unique_ptr<Buffer> buffer;
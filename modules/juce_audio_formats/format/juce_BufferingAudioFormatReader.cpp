@@ -27,11 +27,202 @@
 namespace juce
 {
 
+struct BufferingAudioReader::BlockCache::BufferedBlock  : public ReferenceCountedObject
+{
+    BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples);
+
+    size_t getSizeInBytes() const noexcept
+    {
+        return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof (float);
+    }
+
+    Range<int64> range;
+    AudioBuffer<float> buffer;
+
+    // these are used by the BlockCache to keep its blocks in the order they were used
+    int64 cacheKey = -1;
+    BufferedBlock* lessRecent = nullptr;
+    BufferedBlock* moreRecent = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (BufferedBlock)
+};
+
+//==============================================================================
+static int64 getBlockCacheKey (int sourceID, int64 blockIndex) noexcept
+{
+    jassert (blockIndex >= 0 && blockIndex < ((int64) 1 << 40));
+    return ((int64) sourceID << 40) | blockIndex;
+}
+
+BufferingAudioReader::BlockCache::BlockCache (size_t maxBytesToUse)  : maxSize (maxBytesToUse) {}
+
+BufferingAudioReader::BlockCache::~BlockCache()
+{
+    // the readers hold a pointer to their cache, so none of its blocks can still be in use
+    mostRecent = leastRecent = nullptr;
+    blocks.clear();
+}
+
+void BufferingAudioReader::BlockCache::setMaximumSize (size_t maxBytesToUse)
+{
+    const ScopedLock sl (lock);
+    maxSize = maxBytesToUse;
+    removeUnusedBlocks (maxSize, true);
+}
+
+size_t BufferingAudioReader::BlockCache::getMaximumSize() const noexcept
+{
+    const ScopedLock sl (lock);
+    return maxSize;
+}
+
+size_t BufferingAudioReader::BlockCache::getCurrentSize() const noexcept
+{
+    const ScopedLock sl (lock);
+    return currentSize;
+}
+
+void BufferingAudioReader::BlockCache::clear()
+{
+    const ScopedLock sl (lock);
+    removeUnusedBlocks (0, false);
+}
+
+BufferingAudioReader::BlockCache::Statistics BufferingAudioReader::BlockCache::getStatistics() const
+{
+    const ScopedLock sl (lock);
+    return statistics;
+}
+
+void BufferingAudioReader::BlockCache::resetStatistics()
+{
+    const ScopedLock sl (lock);
+    statistics = {};
+}
+
+int BufferingAudioReader::BlockCache::getSourceID (const String& sourceIdentifier)
+{
+    const ScopedLock sl (lock);
+
+    if (! sourceIDs.contains (sourceIdentifier))
+        sourceIDs.set (sourceIdentifier, sourceIDs.size());
+
+    return sourceIDs[sourceIdentifier];
+}
+
+ReferenceCountedObjectPtr<BufferingAudioReader::BufferedBlock>
+    BufferingAudioReader::BlockCache::findBlock (int sourceID, int64 blockIndex, bool isPrefetch)
+{
+    const ScopedLock sl (lock);
+    auto block = blocks[getBlockCacheKey (sourceID, blockIndex)];
+
+    if (block != nullptr)
+    {
+        markAsMostRecent (*block);
+
+        if (! isPrefetch)
+            ++statistics.hits;
+    }
+
+    return block;
+}
+
+ReferenceCountedObjectPtr<BufferingAudioReader::BufferedBlock>
+    BufferingAudioReader::BlockCache::addBlock (int sourceID, int64 blockIndex, BufferedBlock* newBlock, bool wasPrefetched)
+{
+    ReferenceCountedObjectPtr<BufferedBlock> block (newBlock);
+    auto key = getBlockCacheKey (sourceID, blockIndex);
+
+    const ScopedLock sl (lock);
+
+    // another reader may have loaded the same block while this one was being read
+    if (auto existing = blocks[key])
+        return existing;
+
+    if (wasPrefetched)
+        ++statistics.prefetches;
+    else
+        ++statistics.misses;
+
+    block->cacheKey = key;
+    blocks.set (key, block);
+    markAsMostRecent (*block);
+    currentSize += block->getSizeInBytes();
+
+    removeUnusedBlocks (maxSize, true);
+    return block;
+}
+
+void BufferingAudioReader::BlockCache::markAsMostRecent (BufferedBlock& block)
+{
+    if (mostRecent == &block)
+        return;
+
+    removeFromList (block);
+
+    block.lessRecent = mostRecent;
+
+    if (mostRecent != nullptr)
+        mostRecent->moreRecent = &block;
+
+    mostRecent = &block;
+
+    if (leastRecent == nullptr)
+        leastRecent = &block;
+}
+
+void BufferingAudioReader::BlockCache::removeFromList (BufferedBlock& block)
+{
+    if (block.lessRecent != nullptr)
+        block.lessRecent->moreRecent = block.moreRecent;
+    else if (leastRecent == &block)
+        leastRecent = block.moreRecent;
+
+    if (block.moreRecent != nullptr)
+        block.moreRecent->lessRecent = block.lessRecent;
+    else if (mostRecent == &block)
+        mostRecent = block.lessRecent;
+
+    block.lessRecent = block.moreRecent = nullptr;
+}
+
+void BufferingAudioReader::BlockCache::removeUnusedBlocks (size_t targetSize, bool isEviction)
+{
+    for (auto* block = leastRecent; block != nullptr && currentSize > targetSize;)
+    {
+        auto* next = block->moreRecent;
+
+        // if the cache holds the only reference, no reader is buffering this block
+        if (block->getReferenceCount() == 1)
+        {
+            removeFromList (*block);
+            currentSize -= block->getSizeInBytes();
+
+            if (isEviction)
+                ++statistics.evictions;
+
+            blocks.remove (block->cacheKey);
+        }
+
+        block = next;
+    }
+}
+
+//==============================================================================
 BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, timeSliceThread, samplesToBuffer, nullptr, {})
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            TimeSliceThread& timeSliceThread,
+                                            int samplesToBuffer,
+                                            BlockCache::Ptr sharedCache,
+                                            const String& sourceIdentifier)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
-      source (sourceReader), thread (timeSliceThread),
+      source (sourceReader), thread (timeSliceThread), cache (sharedCache),
       numBlocks (1 + (samplesToBuffer / samplesPerBlock))
 {
     sampleRate            = source->sampleRate;
@@ -41,6 +232,9 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
     bitsPerSample         = 32;
     usesFloatingPointData = true;
 
+    if (cache != nullptr)
+        sourceID = cache->getSourceID (sourceIdentifier);
+
     for (int i = 3; --i >= 0;)
         readNextBufferChunk();
 
@@ -57,6 +251,20 @@ void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
     timeoutMs = timeoutMilliseconds;
 }
 
+void BufferingAudioReader::prefetch (Range<int64> sampleRange)
+{
+    if (cache == nullptr)
+        return;
+
+    auto start = (jmax ((int64) 0, sampleRange.getStart()) / samplesPerBlock) * samplesPerBlock;
+    auto end = jmin (sampleRange.getEnd(), lengthInSamples);
+
+    const ScopedLock sl (lock);
+
+    for (auto p = start; p < end; p += samplesPerBlock)
+        blocksToPrefetch.addIfNotAlreadyThere (p);
+}
+
 bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
                                         int64 startSampleInFile, int numSamples)
 {
@@ -69,7 +277,16 @@ bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels,
 
     while (numSamples > 0)
     {
-        if (auto block = getBlockContaining (startSampleInFile))
+        ReferenceCountedObjectPtr<BufferedBlock> cachedBlock;
+        auto* block = getBlockContaining (startSampleInFile);
+
+        if (block == nullptr && cache != nullptr)
+        {
+            cachedBlock = cache->findBlock (sourceID, startSampleInFile / samplesPerBlock, false);
+            block = cachedBlock.get();
+        }
+
+        if (block != nullptr)
         {
             auto offset = (int) (startSampleInFile - block->range.getStart());
             auto numToDo = jmin (numSamples, (int) (block->range.getEnd() - startSampleInFile));
@@ -112,7 +329,7 @@ bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels,
     return true;
 }
 
-BufferingAudioReader::BufferedBlock::BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples)
+BufferingAudioReader::BlockCache::BufferedBlock::BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples)
     : range (pos, pos + numSamples),
       buffer ((int) reader.numChannels, numSamples)
 {
@@ -128,6 +345,19 @@ BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (i
     return nullptr;
 }
 
+ReferenceCountedObjectPtr<BufferingAudioReader::BufferedBlock> BufferingAudioReader::createBlock (int64 pos, bool isPrefetch)
+{
+    if (cache == nullptr)
+        return new BufferedBlock (*source, pos, samplesPerBlock);
+
+    auto blockIndex = pos / samplesPerBlock;
+
+    if (auto block = cache->findBlock (sourceID, blockIndex, isPrefetch))
+        return block;
+
+    return cache->addBlock (sourceID, blockIndex, new BufferedBlock (*source, pos, samplesPerBlock), isPrefetch);
+}
+
 int BufferingAudioReader::useTimeSlice()
 {
     return readNextBufferChunk() ? 1 : 100;
@@ -139,23 +369,20 @@ bool BufferingAudioReader::readNextBufferChunk()
     auto startPos = ((pos - 1024) / samplesPerBlock) * samplesPerBlock;
     auto endPos = startPos + numBlocks * samplesPerBlock;
 
-    OwnedArray<BufferedBlock> newBlocks;
+    ReferenceCountedArray<BufferedBlock> newBlocks;
 
     for (int i = blocks.size(); --i >= 0;)
         if (blocks.getUnchecked(i)->range.intersects (Range<int64> (startPos, endPos)))
             newBlocks.add (blocks.getUnchecked(i));
 
     if (newBlocks.size() == numBlocks)
-    {
-        newBlocks.clear (false);
-        return false;
-    }
+        return prefetchNextBlock();
 
     for (auto p = startPos; p < endPos; p += samplesPerBlock)
     {
         if (getBlockContaining (p) == nullptr)
         {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
+            newBlocks.add (createBlock (p, false));
             break; // just do one block
         }
     }
@@ -165,9 +392,28 @@ bool BufferingAudioReader::readNextBufferChunk()
         newBlocks.swapWith (blocks);
     }
 
-    for (int i = blocks.size(); --i >= 0;)
-        newBlocks.removeObject (blocks.getUnchecked(i), false);
+    // any blocks that have left the buffer get released here, outside the lock
+    return true;
+}
+
+bool BufferingAudioReader::prefetchNextBlock()
+{
+    if (cache == nullptr)
+        return false;
+
+    int64 pos;
+
+    {
+        const ScopedLock sl (lock);
+
+        if (blocksToPrefetch.isEmpty())
+            return false;
+
+        pos = blocksToPrefetch.removeAndReturn (0);
+    }
 
+    // the block isn't kept, so the cache is free to discard it again if it needs the space
+    createBlock (pos, true);
     return true;
 }
 
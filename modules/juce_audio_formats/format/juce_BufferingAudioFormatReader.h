@@ -40,6 +40,83 @@ class JUCE_API  BufferingAudioReader  : public AudioFormatReader,
                                         private TimeSliceClient
 {
 public:
+    //==============================================================================
+    /**
+        A pool of decoded blocks which can be shared by any number of BufferingAudioReaders.
+
+        Readers that are given the same cache and the same source identifier will share
+        the blocks they've loaded instead of each keeping their own copies, and the total
+        amount of memory used is kept within the cache's size limit by discarding the
+        least recently used blocks.
+
+        Blocks that a reader is currently buffering can't be discarded, so if the size
+        limit is smaller than the readers' combined buffering, the cache may go over it.
+
+        @see BufferingAudioReader
+    */
+    class JUCE_API  BlockCache  : public ReferenceCountedObject
+    {
+    public:
+        /** Creates a cache which will try to keep its size below the given number of bytes. */
+        explicit BlockCache (size_t maxBytesToUse);
+
+        /** Destructor. */
+        ~BlockCache() override;
+
+        using Ptr = ReferenceCountedObjectPtr<BlockCache>;
+
+        //==============================================================================
+        /** Changes the size limit, discarding blocks if the cache is now too big. */
+        void setMaximumSize (size_t maxBytesToUse);
+
+        /** Returns the size limit that was set. */
+        size_t getMaximumSize() const noexcept;
+
+        /** Returns the number of bytes of sample data that the cache currently holds. */
+        size_t getCurrentSize() const noexcept;
+
+        /** Discards all the blocks that aren't being used by a reader. */
+        void clear();
+
+        //==============================================================================
+        /** Counters describing how well the cache is working. */
+        struct Statistics
+        {
+            int64 hits = 0;         /**< The number of times a block was found in the cache. */
+            int64 misses = 0;       /**< The number of times a block had to be read from a source. */
+            int64 prefetches = 0;   /**< The number of blocks that were read because of a prefetch() call. */
+            int64 evictions = 0;    /**< The number of blocks discarded to stay within the size limit. */
+        };
+
+        /** Returns the current values of the counters. */
+        Statistics getStatistics() const;
+
+        /** Sets all the counters back to zero. */
+        void resetStatistics();
+
+    private:
+        friend class BufferingAudioReader;
+        struct BufferedBlock;
+
+        CriticalSection lock;
+        HashMap<int64, ReferenceCountedObjectPtr<BufferedBlock>> blocks;
+        HashMap<String, int> sourceIDs;
+        BufferedBlock* mostRecent = nullptr;
+        BufferedBlock* leastRecent = nullptr;
+        size_t maxSize, currentSize = 0;
+        Statistics statistics;
+
+        int getSourceID (const String&);
+        ReferenceCountedObjectPtr<BufferedBlock> findBlock (int sourceID, int64 blockIndex, bool isPrefetch);
+        ReferenceCountedObjectPtr<BufferedBlock> addBlock (int sourceID, int64 blockIndex, BufferedBlock*, bool wasPrefetched);
+        void markAsMostRecent (BufferedBlock&);
+        void removeFromList (BufferedBlock&);
+        void removeUnusedBlocks (size_t targetSize, bool isEviction);
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BlockCache)
+    };
+
+    //==============================================================================
     /** Creates a reader.
 
         @param sourceReader     the source reader to wrap. This BufferingAudioReader
@@ -54,6 +131,21 @@ public:
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader which keeps the blocks it reads in a shared BlockCache.
+
+        The sourceIdentifier is used to recognise readers of the same data, e.g. the full path
+        of the file that the source reader is reading, so every reader that's given the same
+        identifier and cache must be producing the same samples.
+
+        When the reader is asked for a block that's not in its own buffer, it'll use the copy
+        in the cache if there is one, rather than waiting for the background thread.
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          TimeSliceThread& timeSliceThread,
+                          int samplesToBuffer,
+                          BlockCache::Ptr sharedCache,
+                          const String& sourceIdentifier);
+
     ~BufferingAudioReader() override;
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -63,32 +155,38 @@ public:
     */
     void setReadTimeout (int timeoutMilliseconds) noexcept;
 
+    /** Asks the background thread to load a range of samples into the shared cache once it has
+        filled this reader's own buffer, so that a later read from that range won't have to wait.
+
+        This only has an effect if the reader was created with a BlockCache.
+    */
+    void prefetch (Range<int64> sampleRange);
+
     bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override;
 
 private:
+    using BufferedBlock = BlockCache::BufferedBlock;
+
     std::unique_ptr<AudioFormatReader> source;
     TimeSliceThread& thread;
+    BlockCache::Ptr cache;
     std::atomic<int64> nextReadPosition { 0 };
     const int numBlocks;
+    int sourceID = 0;
     int timeoutMs = 0;
 
     enum { samplesPerBlock = 32768 };
 
-    struct BufferedBlock
-    {
-        BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples);
-
-        Range<int64> range;
-        AudioBuffer<float> buffer;
-    };
-
     CriticalSection lock;
-    OwnedArray<BufferedBlock> blocks;
+    ReferenceCountedArray<BufferedBlock> blocks;
+    Array<int64> blocksToPrefetch;
 
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
+    ReferenceCountedObjectPtr<BufferedBlock> createBlock (int64 pos, bool isPrefetch);
     int useTimeSlice() override;
     bool readNextBufferChunk();
+    bool prefetchNextBlock();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioReader)
 };
@@ -115,8 +115,60 @@ void SamplerVoice::pitchWheelMoved (int /*newValue*/) {}
 void SamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
 
 //==============================================================================
+namespace SamplerVoiceHelpers
+{
+    // The voice is rendered in blocks of this many samples, so that the positions, the
+    // interpolation coefficients and the envelope can be worked out once for each block
+    // and shared between the channels.
+    enum { blockSize = 64 };
+
+    static void interpolateLinear (const float* source, const int* indices, const float* fractions,
+                                   float* dest, int num) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            auto* s = source + indices[i];
+            dest[i] = s[0] + fractions[i] * (s[1] - s[0]);
+        }
+    }
+
+    static void calculateLagrangeCoefficients (const float* fractions, float (&coefficients)[4][blockSize], int num) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            auto t = fractions[i];
+            auto tPlus1 = t + 1.0f, tMinus1 = t - 1.0f, tMinus2 = t - 2.0f;
+
+            coefficients[0][i] = t * tMinus1 * tMinus2 * (-1.0f / 6.0f);
+            coefficients[1][i] = tPlus1 * tMinus1 * tMinus2 * 0.5f;
+            coefficients[2][i] = tPlus1 * t * tMinus2 * -0.5f;
+            coefficients[3][i] = tPlus1 * t * tMinus1 * (1.0f / 6.0f);
+        }
+    }
+
+    static void interpolateLagrange (const float* source, const int* indices, const float (&coefficients)[4][blockSize],
+                                     float* dest, int num) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            auto index = indices[i];
+            auto* s = source + index;
+
+            // (there's nothing before the start of the sound, so that's treated as silence)
+            auto previous = index > 0 ? s[-1] : 0.0f;
+
+            dest[i] = coefficients[0][i] * previous
+                    + coefficients[1][i] * s[0]
+                    + coefficients[2][i] * s[1]
+                    + coefficients[3][i] * s[2];
+        }
+    }
+}
+
 void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
 {
+    using namespace SamplerVoiceHelpers;
+
     if (auto* playingSound = static_cast<SamplerSound*> (getCurrentlyPlayingSound().get()))
     {
         auto& data = *playingSound->data;
@@ -126,41 +178,276 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
         float* outL = outputBuffer.getWritePointer (0, startSample);
         float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
 
-        while (--numSamples >= 0)
+        int indices[blockSize];
+        float fractions[blockSize], coefficients[4][blockSize];
+        float envelope[blockSize], left[blockSize], right[blockSize];
+
+        while (numSamples > 0)
         {
-            auto pos = (int) sourceSamplePosition;
-            auto alpha = (float) (sourceSamplePosition - pos);
-            auto invAlpha = 1.0f - alpha;
+            // the note stops after the sample that moves the position past the end of the sound
+            auto numUntilEnd = std::floor ((playingSound->length - sourceSamplePosition) / pitchRatio) + 1.0;
+            auto num = (int) jmin ((double) jmin (numSamples, (int) blockSize), numUntilEnd);
+
+            if (num <= 0)
+            {
+                stopNote (0.0f, false);
+                break;
+            }
+
+            for (int i = 0; i < num; ++i)
+            {
+                auto pos = sourceSamplePosition + pitchRatio * i;
+                indices[i] = (int) pos;
+                fractions[i] = (float) (pos - indices[i]);
+            }
+
+            if (interpolationType == InterpolationType::lagrange)
+            {
+                calculateLagrangeCoefficients (fractions, coefficients, num);
+                interpolateLagrange (inL, indices, coefficients, left, num);
 
-            // just using a very simple linear interpolation here..
-            float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
-            float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
-                                       : l;
+                if (inR != nullptr)
+                    interpolateLagrange (inR, indices, coefficients, right, num);
+            }
+            else
+            {
+                interpolateLinear (inL, indices, fractions, left, num);
 
-            auto envelopeValue = adsr.getNextSample();
+                if (inR != nullptr)
+                    interpolateLinear (inR, indices, fractions, right, num);
+            }
 
-            l *= lgain * envelopeValue;
-            r *= rgain * envelopeValue;
+            adsr.getNextBlock (envelope, num);
+            FloatVectorOperations::multiply (left, envelope, num);
+
+            auto* r = left;
+
+            if (inR != nullptr)
+            {
+                FloatVectorOperations::multiply (right, envelope, num);
+                r = right;
+            }
 
             if (outR != nullptr)
             {
-                *outL++ += l;
-                *outR++ += r;
+                FloatVectorOperations::addWithMultiply (outL, left, lgain, num);
+                FloatVectorOperations::addWithMultiply (outR, r, rgain, num);
+                outR += num;
             }
             else
             {
-                *outL++ += (l + r) * 0.5f;
+                FloatVectorOperations::addWithMultiply (outL, left, lgain * 0.5f, num);
+                FloatVectorOperations::addWithMultiply (outL, r, rgain * 0.5f, num);
             }
 
-            sourceSamplePosition += pitchRatio;
+            outL += num;
+            numSamples -= num;
+            sourceSamplePosition += pitchRatio * num;
 
-            if (sourceSamplePosition > playingSound->length)
+            if (num >= numUntilEnd)
             {
                 stopNote (0.0f, false);
                 break;
             }
+
+            // once the release has finished there's nothing left to hear, so the voice can be freed
+            if (! adsr.isActive())
+            {
+                clearCurrentNote();
+                break;
+            }
         }
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct SamplerTests  : public UnitTest
+{
+    SamplerTests()
+        : UnitTest ("Sampler", "Audio")
+    {}
+
+    // reads the samples from an AudioBuffer, with silence after its end
+    struct BufferReader  : public AudioFormatReader
+    {
+        BufferReader (const AudioBuffer<float>& source)
+            : AudioFormatReader (nullptr, "Buffer"), buffer (source)
+        {
+            sampleRate = 44100.0;
+            bitsPerSample = 32;
+            usesFloatingPointData = true;
+            lengthInSamples = buffer.getNumSamples();
+            numChannels = (unsigned int) buffer.getNumChannels();
+        }
+
+        bool readSamples (int** destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            for (int channel = 0; channel < numDestChannels; ++channel)
+            {
+                if (auto* dest = reinterpret_cast<float*> (destChannels[channel]))
+                {
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        auto pos = startSampleInFile + i;
+
+                        dest[startOffsetInDestBuffer + i] = (pos < lengthInSamples && channel < (int) numChannels)
+                                                               ? buffer.getSample (channel, (int) pos) : 0.0f;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        const AudioBuffer<float>& buffer;
+    };
+
+    static AudioBuffer<float> createSine (int numChannels, int numSamples, double period)
+    {
+        AudioBuffer<float> sine (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                sine.setSample (channel, i, (float) std::sin ((i / period + channel * 0.25) * MathConstants<double>::twoPi));
+
+        return sine;
+    }
+
+    // plays a note on a synth with a single voice, rendering it in blocks of different sizes
+    AudioBuffer<float> render (const AudioBuffer<float>& source, SamplerVoice::InterpolationType type,
+                               int noteNumber, double attack, double release, int noteOffTime, int numSamples)
+    {
+        BufferReader reader (source);
+        BigInteger allNotes;
+        allNotes.setRange (0, 128, true);
+
+        Synthesiser synth;
+        auto* voice = new SamplerVoice();
+        voice->setInterpolationType (type);
+        synth.addVoice (voice);
+        synth.addSound (new SamplerSound ("test", reader, allNotes, 60, attack, release, 10.0));
+        synth.setCurrentPlaybackSampleRate (44100.0);
+
+        AudioBuffer<float> output (2, numSamples);
+        output.clear();
+
+        auto random = getRandom();
+
+        for (int pos = 0; pos < numSamples;)
+        {
+            // (the synth expects the events' times to be positions in the whole buffer)
+            MidiBuffer midi;
+
+            if (pos == 0)
+                midi.addEvent (MidiMessage::noteOn (1, noteNumber, (uint8) 100), 0);
+
+            auto num = jmin (numSamples - pos, 1 + random.nextInt (300));
+
+            if (noteOffTime >= pos && noteOffTime < pos + num)
+                midi.addEvent (MidiMessage::noteOff (1, noteNumber), noteOffTime);
+
+            synth.renderNextBlock (output, midi, pos, num);
+            pos += num;
+        }
+
+        expect (! voice->isVoiceActive());
+        return output;
+    }
+
+    void runTest() override
+    {
+        auto velocity = MidiMessage::noteOn (1, 60, (uint8) 100).getFloatVelocity();
+
+        beginTest ("Linear interpolation");
+        {
+            auto source = createSine (2, 3000, 37.0);
+            auto output = render (source, SamplerVoice::InterpolationType::linear, 67, 0.01, 0.01, 1500, 4000);
+
+            // this works out what the original per-sample loop would have produced
+            auto ratio = std::pow (2.0, 7 / 12.0);
+
+            ADSR adsr;
+            adsr.setSampleRate (44100.0);
+            adsr.setParameters ({ 0.01f, 0.1f, 1.0f, 0.01f });
+            adsr.noteOn();
+
+            double position = 0;
+            int i = 0;
+
+            for (; i < output.getNumSamples() && position <= 3000.0; ++i)
+            {
+                if (i == 1500)
+                    adsr.noteOff();
+
+                auto envelope = adsr.getNextSample() * velocity;
+                auto pos = (int) position;
+                auto alpha = (float) (position - pos);
+
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    auto* in = source.getReadPointer (channel);
+                    auto next = pos + 1 < 3000 ? in[pos + 1] : 0.0f;
+                    auto expected = (in[pos] * (1.0f - alpha) + next * alpha) * envelope;
+
+                    expectWithinAbsoluteError (output.getSample (channel, i), expected, 1.0e-4f);
+                }
+
+                position += ratio;
+
+                if (! adsr.isActive())
+                {
+                    ++i;
+                    break;
+                }
+            }
+
+            for (; i < output.getNumSamples(); ++i)
+                expectEquals (output.getSample (0, i) + output.getSample (1, i), 0.0f);
+        }
+
+        beginTest ("End of the sound");
+        {
+            auto source = createSine (1, 1000, 50.0);
+            auto output = render (source, SamplerVoice::InterpolationType::linear, 72, 0.0, 0.0, -1, 1000);
+
+            // an octave up, the sound should last for half as many samples
+            for (int i = 0; i < 1000; ++i)
+            {
+                expectEquals (output.getSample (0, i), output.getSample (1, i));
+
+                if (i > 501)
+                    expectEquals (output.getSample (0, i), 0.0f);
+            }
+
+            expect (std::abs (output.getSample (0, 490)) > 0.0f);
+        }
+
+        beginTest ("Lagrange interpolation");
+        {
+            auto source = createSine (1, 4000, 9.0);
+            auto linear   = render (source, SamplerVoice::InterpolationType::linear,   61, 0.0, 0.0, -1, 4000);
+            auto lagrange = render (source, SamplerVoice::InterpolationType::lagrange, 61, 0.0, 0.0, -1, 4000);
+
+            auto ratio = std::pow (2.0, 1 / 12.0);
+            double linearError = 0, lagrangeError = 0;
+
+            for (int i = 1; i < 3000; ++i)
+            {
+                auto expected = velocity * std::sin (i * ratio / 9.0 * MathConstants<double>::twoPi);
+                linearError   += std::abs (linear.getSample (0, i) - expected);
+                lagrangeError += std::abs (lagrange.getSample (0, i) - expected);
+            }
+
+            expect (lagrangeError < linearError * 0.25);
+        }
+    }
+};
+
+static SamplerTests samplerTests;
+
+#endif
+
 } // namespace juce
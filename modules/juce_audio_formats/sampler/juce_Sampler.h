@@ -139,11 +139,27 @@ public:
 
     void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
 
+    //==============================================================================
+    /** The kinds of interpolation that a SamplerVoice can use when it resamples a sound. */
+    enum class InterpolationType
+    {
+        linear,     /**< Interpolates between the two nearest samples. This is the cheapest option. */
+        lagrange    /**< Uses 3rd-order Lagrange interpolation between the four nearest samples,
+                         which loses less of the high frequencies and produces less aliasing. */
+    };
+
+    /** Changes the kind of interpolation that's used. The default is linear. */
+    void setInterpolationType (InterpolationType newType) noexcept      { interpolationType = newType; }
+
+    /** Returns the kind of interpolation that's being used. */
+    InterpolationType getInterpolationType() const noexcept             { return interpolationType; }
+
 private:
     //==============================================================================
     double pitchRatio = 0;
     double sourceSamplePosition = 0;
     float lgain = 0, rgain = 0;
+    InterpolationType interpolationType = InterpolationType::linear;
 
     ADSR adsr;
 
@@ -0,0 +1,368 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+SamplerStreamingThread::SamplerStreamingThread (int numSamplesPerRead)
+    : Thread ("Sampler streaming"), samplesPerRead (jmax (1, numSamplesPerRead))
+{
+    startThread (7);
+}
+
+SamplerStreamingThread::~SamplerStreamingThread()
+{
+    // all the voices using this thread should have been deleted first
+    jassert (voices.isEmpty());
+
+    stopThread (5000);
+}
+
+void SamplerStreamingThread::addVoice (StreamingSamplerVoice* voice)
+{
+    const ScopedLock sl (lock);
+    voices.add (voice);
+}
+
+void SamplerStreamingThread::removeVoice (StreamingSamplerVoice* voice)
+{
+    const ScopedLock sl (lock);
+    voices.removeFirstMatchingValue (voice);
+}
+
+void SamplerStreamingThread::run()
+{
+    while (! threadShouldExit())
+    {
+        bool didSomething = false;
+
+        {
+            const ScopedLock sl (lock);
+            StreamingSamplerVoice* mostUrgent = nullptr;
+            int lowestUrgency = 0;
+
+            for (auto* v : voices)
+            {
+                auto urgency = v->getStreamUrgency();
+
+                if (urgency >= 0 && (mostUrgent == nullptr || urgency < lowestUrgency))
+                {
+                    mostUrgent = v;
+                    lowestUrgency = urgency;
+                }
+            }
+
+            if (mostUrgent != nullptr)
+            {
+                mostUrgent->serviceStream (samplesPerRead);
+                didSomething = true;
+            }
+        }
+
+        if (! didSomething)
+            wait (5);
+    }
+}
+
+//==============================================================================
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              AudioFormatReader* source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              int samplesToPreload)
+    : name (soundName),
+      reader (source),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    jassert (reader != nullptr);
+
+    if (reader != nullptr && reader->sampleRate > 0 && reader->lengthInSamples > 0)
+    {
+        sourceSampleRate = reader->sampleRate;
+        length = reader->lengthInSamples;
+        preloadLength = (int) jmin (length, (int64) jmax (0, samplesToPreload));
+
+        preloaded.setSize (jmin (2, (int) reader->numChannels), preloadLength + 4);
+        reader->read (&preloaded, 0, preloadLength + 4, 0, true, true);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (SamplerStreamingThread& streamingThread, int bufferSize)
+    : thread (streamingThread),
+      ringBuffer (2, jmax (16, bufferSize)),
+      fifo (ringBuffer.getNumSamples())
+{
+    thread.addVoice (this);
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    thread.removeVoice (this);
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<const StreamingSamplerSound*> (s))
+    {
+        pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (sound->sourceSampleRate);
+        adsr.setParameters (sound->params);
+
+        adsr.noteOn();
+        requestStream (s);
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        adsr.noteOff();
+    }
+    else
+    {
+        clearCurrentNote();
+        adsr.reset();
+        requestStream (nullptr);
+    }
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+//==============================================================================
+void StreamingSamplerVoice::requestStream (SynthesiserSound* sound)
+{
+    {
+        const SpinLock::ScopedLockType sl (requestLock);
+        requestedSound = sound;
+    }
+
+    ++requestedGeneration;
+    isStreamReady = false;
+}
+
+int StreamingSamplerVoice::getStreamUrgency() const noexcept
+{
+    if (requestedGeneration.load() != acceptedGeneration.load())
+        return 0;
+
+    if (auto* sound = static_cast<StreamingSamplerSound*> (streamingSound.get()))
+        if (streamPosition < sound->length && fifo.getFreeSpace() > 0)
+            return 1 + fifo.getNumReady();
+
+    return -1;
+}
+
+void StreamingSamplerVoice::serviceStream (int maxSamplesToRead)
+{
+    auto generation = requestedGeneration.load();
+
+    if (generation != acceptedGeneration.load())
+    {
+        {
+            const SpinLock::ScopedLockType sl (requestLock);
+            streamingSound = requestedSound;
+        }
+
+        // the audio thread won't touch the fifo until the new generation has been accepted
+        fifo.reset();
+
+        auto* sound = static_cast<StreamingSamplerSound*> (streamingSound.get());
+        streamPosition = sound != nullptr ? sound->preloadLength : 0;
+        acceptedGeneration = generation;
+        return;
+    }
+
+    if (auto* sound = static_cast<StreamingSamplerSound*> (streamingSound.get()))
+    {
+        auto numToRead = (int) jmin ((int64) jmin (fifo.getFreeSpace(), maxSamplesToRead),
+                                     sound->length - streamPosition);
+
+        if (numToRead <= 0)
+            return;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+
+        {
+            const ScopedLock sl (sound->readerLock);
+
+            if (size1 > 0)  sound->reader->read (&ringBuffer, start1, size1, streamPosition, true, true);
+            if (size2 > 0)  sound->reader->read (&ringBuffer, start2, size2, streamPosition + size1, true, true);
+        }
+
+        fifo.finishedWrite (size1 + size2);
+        streamPosition += size1 + size2;
+    }
+}
+
+//==============================================================================
+void StreamingSamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (auto* playingSound = static_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        auto& head = playingSound->preloaded;
+        const float* const headL = head.getReadPointer (0);
+        const float* const headR = head.getNumChannels() > 1 ? head.getReadPointer (1) : nullptr;
+        const float* const ringL = ringBuffer.getReadPointer (0);
+        const float* const ringR = head.getNumChannels() > 1 ? ringBuffer.getReadPointer (1) : nullptr;
+
+        const auto headLength = (int64) playingSound->preloadLength;
+        const auto length = playingSound->length;
+
+        if (! isStreamReady && acceptedGeneration.load() == requestedGeneration.load())
+        {
+            isStreamReady = true;
+            ringStartPosition = headLength;
+        }
+
+        int start1 = 0, size1 = 0, start2 = 0, size2 = 0;
+
+        if (isStreamReady)
+            fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+
+        auto numReady = size1 + size2;
+
+        auto getSourceSample = [&] (int64 index, float& l, float& r) -> bool
+        {
+            if (index >= length)
+            {
+                l = r = 0;
+                return true;
+            }
+
+            if (index < headLength)
+            {
+                l = headL[index];
+                r = headR != nullptr ? headR[index] : l;
+                return true;
+            }
+
+            auto offset = (int) (index - ringStartPosition);
+
+            if (offset >= numReady)
+                return false;
+
+            auto i = offset < size1 ? start1 + offset : start2 + (offset - size1);
+            l = ringL[i];
+            r = ringR != nullptr ? ringR[i] : l;
+            return true;
+        };
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int64) sourceSamplePosition;
+            auto alpha = (float) (sourceSamplePosition - (double) pos);
+            auto invAlpha = 1.0f - alpha;
+
+            float l0, r0, l1, r1;
+
+            if (! (getSourceSample (pos, l0, r0) && getSourceSample (pos + 1, l1, r1)))
+            {
+                // the streaming thread hasn't caught up, so wait for it rather than skipping
+                ++numUnderruns;
+                break;
+            }
+
+            // just using a very simple linear interpolation here..
+            float l = l0 * invAlpha + l1 * alpha;
+            float r = r0 * invAlpha + r1 * alpha;
+
+            auto envelopeValue = adsr.getNextSample();
+
+            l *= lgain * envelopeValue;
+            r *= rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > length || ! adsr.isActive())
+            {
+                stopNote (0.0f, false);
+                return;
+            }
+        }
+
+        // let the streaming thread reuse the space for any samples that have been played
+        if (isStreamReady)
+        {
+            auto numFinished = (int) jlimit ((int64) 0, (int64) numReady, (int64) sourceSamplePosition - ringStartPosition);
+            fifo.finishedRead (numFinished);
+            ringStartPosition += numFinished;
+        }
+    }
+}
+
+} // namespace juce
@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class StreamingSamplerVoice;
+
+//==============================================================================
+/**
+    A background thread that reads the audio for a set of StreamingSamplerVoices.
+
+    Each time it runs, it tops up the voice that is closest to running out of data,
+    so that when there are more voices than the disk can keep up with, the ones that
+    are about to underrun get served first.
+
+    The thread starts when this object is created. It must outlive any voices that
+    use it.
+
+    @see StreamingSamplerVoice, StreamingSamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  SamplerStreamingThread  : private Thread
+{
+public:
+    //==============================================================================
+    /** Creates and starts the thread.
+
+        @param samplesPerRead   the largest number of samples that will be read in one go
+                                when topping up a voice's buffer
+    */
+    explicit SamplerStreamingThread (int samplesPerRead = 8192);
+
+    /** Destructor. */
+    ~SamplerStreamingThread() override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    const int samplesPerRead;
+    CriticalSection lock;
+    Array<StreamingSamplerVoice*> voices;
+
+    void addVoice (StreamingSamplerVoice*);
+    void removeVoice (StreamingSamplerVoice*);
+    void run() override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerStreamingThread)
+};
+
+//==============================================================================
+/**
+    A SynthesiserSound that plays a sample from disk without loading all of it.
+
+    Only the start of the sample is kept in memory. When a note begins, it plays
+    from that part while a SamplerStreamingThread starts reading the rest from
+    the source into the voice's own buffer.
+
+    @see StreamingSamplerVoice, SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound  : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streamed sound from an audio reader.
+
+        @param name         a name for the sample
+        @param source       the audio to play. This object takes ownership of the reader,
+                            and will keep reading from it while notes are playing
+        @param midiNotes    the set of midi keys that this sound should be played on. This
+                            is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param samplesToPreload the number of samples from the start of the source to keep
+                                in memory. This needs to cover the time it takes the streaming
+                                thread to start delivering data for a new note, at the highest
+                                pitch that the sound will be played
+    */
+    StreamingSamplerSound (const String& name,
+                           AudioFormatReader* source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           int samplesToPreload = 65536);
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the number of samples that are kept in memory. */
+    int getNumPreloadedSamples() const noexcept             { return preloadLength; }
+
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    String name;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    AudioBuffer<float> preloaded;
+    double sourceSampleRate = 0;
+    BigInteger midiNotes;
+    int64 length = 0;
+    int preloadLength = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+//==============================================================================
+/**
+    A SynthesiserVoice that can play a StreamingSamplerSound.
+
+    Each voice has its own buffer, which is filled by a SamplerStreamingThread and
+    emptied by the audio thread without either of them having to wait for the other.
+    If the buffer runs dry, the voice outputs silence until the data arrives, and
+    getNumUnderruns() is incremented.
+
+    @see StreamingSamplerSound, SamplerStreamingThread, SamplerVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerVoice  : public SynthesiserVoice
+{
+public:
+    //==============================================================================
+    /** Creates a voice that will stream its data using the given thread.
+
+        @param streamingThread  the thread that should fill this voice's buffer. This
+                                must not be deleted while the voice exists
+        @param bufferSize       the number of samples that the voice can buffer ahead
+    */
+    StreamingSamplerVoice (SamplerStreamingThread& streamingThread, int bufferSize = 65536);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice() override;
+
+    //==============================================================================
+    /** Returns the number of times that this voice has run out of data. */
+    int getNumUnderruns() const noexcept                    { return numUnderruns.load(); }
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
+
+private:
+    //==============================================================================
+    friend class SamplerStreamingThread;
+
+    SamplerStreamingThread& thread;
+
+    // Written by the streaming thread and read by the audio thread
+    AudioBuffer<float> ringBuffer;
+    AbstractFifo fifo;
+
+    // A new note is handed to the streaming thread by bumping requestedGeneration. The streaming
+    // thread then resets the fifo and sets acceptedGeneration to match, after which the audio
+    // thread can start reading from it.
+    SpinLock requestLock;
+    SynthesiserSound::Ptr requestedSound;
+    std::atomic<uint32> requestedGeneration { 0 }, acceptedGeneration { 0 };
+    std::atomic<int> numUnderruns { 0 };
+
+    // Only used by the streaming thread
+    SynthesiserSound::Ptr streamingSound;
+    int64 streamPosition = 0;
+
+    // Only used by the audio thread
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    int64 ringStartPosition = 0;
+    bool isStreamReady = false;
+    float lgain = 0, rgain = 0;
+
+    ADSR adsr;
+
+    void requestStream (SynthesiserSound*);
+    int getStreamUrgency() const noexcept;
+    void serviceStream (int maxSamplesToRead);
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
+} // namespace juce
@@ -219,6 +219,7 @@ public:
         MusicDeviceBase::Cleanup();
 
         pulledSucceeded.free();
+        inputChannelData.free();
         mapper.release();
 
         if (juceFilter != nullptr)
@@ -249,6 +250,7 @@ public:
             juceFilter->setRateAndBufferSizeDetails (getSampleRate(), (int) GetMaxFramesPerSlice());
 
             audioBuffer.prepare (totalInChannels, totalOutChannels, (int) GetMaxFramesPerSlice() + 32);
+            inputChannelData.calloc (static_cast<size_t> (jmax (1, totalInChannels)));
             juceFilter->prepareToPlay (getSampleRate(), (int) GetMaxFramesPerSlice());
 
             midiEvents.ensureSize (2048);
@@ -1277,6 +1279,23 @@ public:
             bool interleaved = false;
             AudioBufferList* buffer = nullptr;
 
+            // find out where each input channel lives, so that in-place buffers can be spotted
+            for (int busIdx = 0; busIdx < numInputBuses && chIdx < totalInChannels; ++busIdx)
+            {
+                const bool badData = ! pulledSucceeded[busIdx];
+
+                if (! badData)
+                    GetAudioBufferList (true, busIdx, buffer, interleaved, numChannels);
+
+                const int* inLayoutMap = mapper.get (true, busIdx);
+                const int n = juceFilter->getChannelCountOfBus (true, busIdx);
+
+                for (int ch = 0; ch < n && chIdx < totalInChannels; ++ch)
+                    inputChannelData[chIdx++] = interleaved || badData ? nullptr : static_cast<float*> (buffer->mBuffers[inLayoutMap[ch]].mData);
+            }
+
+            chIdx = 0;
+
             // use output pointers
             for (int busIdx = 0; busIdx < numOutputBuses; ++busIdx)
             {
@@ -1284,7 +1303,17 @@ public:
                 const int* outLayoutMap = mapper.get (false, busIdx);
 
                 for (int ch = 0; ch < numChannels; ++ch)
-                    audioBuffer.setBuffer (chIdx++, interleaved ? nullptr : static_cast<float*> (buffer->mBuffers[outLayoutMap[ch]].mData));
+                {
+                    auto* outputData = interleaved ? nullptr : static_cast<float*> (buffer->mBuffers[outLayoutMap[ch]].mData);
+
+                    // if the host has given this output the same memory as a different input
+                    // channel, writing the inputs into place would overwrite that input before
+                    // it's been read, so this channel has to be processed in the scratch buffer
+                    if (isDataForOtherInputChannel (outputData, chIdx))
+                        outputData = nullptr;
+
+                    audioBuffer.setBuffer (chIdx++, outputData);
+                }
             }
 
             // use input pointers on remaining channels
@@ -1742,6 +1771,7 @@ private:
     AudioTimeStamp lastTimeStamp;
     int totalInChannels, totalOutChannels;
     HeapBlock<bool> pulledSucceeded;
+    HeapBlock<float*> inputChannelData;
 
     ThreadLocalValue<bool> inParameterChangedCallback;
 
@@ -1778,6 +1808,16 @@ private:
         }
     }
 
+    bool isDataForOtherInputChannel (const float* data, int chIdx) const noexcept
+    {
+        if (data != nullptr)
+            for (int i = 0; i < totalInChannels; ++i)
+                if (i != chIdx && inputChannelData[i] == data)
+                    return true;
+
+        return false;
+    }
+
     void prepareOutputBuffers (const UInt32 nFrames) noexcept
     {
         const unsigned int numOutputBuses = GetScope (kAudioUnitScope_Output).GetNumberOfElements();
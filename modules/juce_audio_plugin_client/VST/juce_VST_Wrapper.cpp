@@ -532,9 +532,8 @@ public:
         if (! midiEvents.isEmpty())
         {
            #if JucePlugin_ProducesMidiOutput || JucePlugin_IsMidiEffect
-            auto numEvents = midiEvents.getNumEvents();
-
-            outgoingEvents.ensureSize (numEvents);
+            // The list was sized in resume(), so this won't allocate - anything
+            // beyond its capacity is dropped.
             outgoingEvents.clear();
 
             const uint8* midiEventData;
@@ -648,7 +647,7 @@ public:
             }
 
            #if JucePlugin_ProducesMidiOutput || JucePlugin_IsMidiEffect
-            outgoingEvents.ensureSize (512);
+            outgoingEvents.ensureSize (2048);
            #endif
         }
     }
@@ -1470,8 +1470,8 @@ public:
         {
             getPluginInstance().releaseResources();
 
-            deallocateChannelListAndBuffers (channelListFloat,  emptyBufferFloat);
-            deallocateChannelListAndBuffers (channelListDouble, emptyBufferDouble);
+            deallocateChannelListAndBuffers (channelListFloat,  inputChannelListFloat,  emptyBufferFloat);
+            deallocateChannelListAndBuffers (channelListDouble, inputChannelListDouble, emptyBufferDouble);
         }
         else
         {
@@ -1486,8 +1486,8 @@ public:
                             ? (int) processSetup.maxSamplesPerBlock
                             : bufferSize;
 
-            allocateChannelListAndBuffers (channelListFloat,  emptyBufferFloat);
-            allocateChannelListAndBuffers (channelListDouble, emptyBufferDouble);
+            allocateChannelListAndBuffers (channelListFloat,  inputChannelListFloat,  emptyBufferFloat);
+            allocateChannelListAndBuffers (channelListDouble, inputChannelListDouble, emptyBufferDouble);
 
             preparePlugin (sampleRate, bufferSize);
         }
@@ -2244,6 +2244,9 @@ public:
         jassert (pluginInstance != nullptr);
 
         auto numParamsChanged = paramChanges.getParameterCount();
+        auto splitBlocks = pluginInstance->getMinimumAutomationSubBlockSize() > 0;
+
+        automationQueues.clearQuick();
 
         for (Steinberg::int32 i = 0; i < numParamsChanged; ++i)
         {
@@ -2251,40 +2254,168 @@ public:
             {
                 auto numPoints = paramQueue->getPointCount();
 
+                // When splitting, the points are applied by processBlockFollowingAutomation()
+                if (splitBlocks)
+                {
+                    if (numPoints > 0)
+                        automationQueues.add ({ paramQueue, numPoints, 0 });
+
+                    continue;
+                }
+
                 Steinberg::int32 offsetSamples = 0;
                 double value = 0.0;
 
                 if (paramQueue->getPoint (numPoints - 1, offsetSamples, value) == kResultTrue)
+                    applyParameterChange (paramQueue->getParameterId(), offsetSamples, value);
+            }
+        }
+    }
+
+    void applyParameterChange (Vst::ParamID vstParamID, Steinberg::int32 offsetSamples, double value)
+    {
+        if (vstParamID == JuceVST3EditController::paramPreset)
+        {
+            auto numPrograms  = pluginInstance->getNumPrograms();
+            auto programValue = roundToInt (value * (jmax (0, numPrograms - 1)));
+
+            if (numPrograms > 1 && isPositiveAndBelow (programValue, numPrograms)
+                 && programValue != pluginInstance->getCurrentProgram())
+                pluginInstance->setCurrentProgram (programValue);
+        }
+       #if JUCE_VST3_EMULATE_MIDI_CC_WITH_PARAMETERS
+        else if (juceVST3EditController->isMidiControllerParamID (vstParamID))
+            addParameterChangeToMidiBuffer (offsetSamples, vstParamID, value);
+       #endif
+        else
+        {
+            ignoreUnused (offsetSamples);
+            auto floatValue = static_cast<float> (value);
+
+            if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+            {
+                param->setValue (floatValue);
+
+                inParameterChangedCallback = true;
+                param->sendValueChangedMessageToListeners (floatValue);
+            }
+        }
+    }
+
+    //==============================================================================
+    /** The points of one parameter's automation still to be applied in this block. */
+    struct AutomationQueue
+    {
+        Vst::IParamValueQueue* queue;
+        Steinberg::int32 numPoints, nextPoint;
+    };
+
+    /** Applies, for each automated parameter, the last of its points that come before endSample. */
+    void applyParameterChangesBefore (int endSample)
+    {
+        for (auto& q : automationQueues)
+        {
+            Steinberg::int32 offsetSamples = 0, lastOffset = 0;
+            double value = 0.0, lastValue = 0.0;
+            bool found = false;
+
+            while (q.nextPoint < q.numPoints
+                    && q.queue->getPoint (q.nextPoint, offsetSamples, value) == kResultTrue
+                    && offsetSamples < endSample)
+            {
+                lastOffset = offsetSamples;
+                lastValue = value;
+                found = true;
+                ++q.nextPoint;
+            }
+
+            if (found)
+                applyParameterChange (q.queue->getParameterId(), lastOffset, lastValue);
+        }
+    }
+
+    /** Returns where the sub-block starting at startSample should end. */
+    int getNextAutomationSplit (int startSample, int numSamples, int minimumSize) const
+    {
+        auto split = numSamples;
+
+        for (auto& q : automationQueues)
+        {
+            Steinberg::int32 offsetSamples = 0;
+            double value = 0.0;
+
+            for (auto i = q.nextPoint; i < q.numPoints; ++i)
+            {
+                if (q.queue->getPoint (i, offsetSamples, value) != kResultTrue)
+                    break;
+
+                if (offsetSamples >= startSample + minimumSize)
                 {
-                    auto vstParamID = paramQueue->getParameterId();
+                    split = jmin (split, (int) offsetSamples);
+                    break;
+                }
+            }
+        }
 
-                    if (vstParamID == JuceVST3EditController::paramPreset)
-                    {
-                        auto numPrograms  = pluginInstance->getNumPrograms();
-                        auto programValue = roundToInt (value * (jmax (0, numPrograms - 1)));
+        return numSamples - split < minimumSize ? numSamples : split;
+    }
 
-                        if (numPrograms > 1 && isPositiveAndBelow (programValue, numPrograms)
-                             && programValue != pluginInstance->getCurrentProgram())
-                            pluginInstance->setCurrentProgram (programValue);
-                    }
-                   #if JUCE_VST3_EMULATE_MIDI_CC_WITH_PARAMETERS
-                    else if (juceVST3EditController->isMidiControllerParamID (vstParamID))
-                        addParameterChangeToMidiBuffer (offsetSamples, vstParamID, value);
-                   #endif
-                    else
-                    {
-                        auto floatValue = static_cast<float> (value);
+    template <typename FloatType>
+    void callProcessBlock (AudioBuffer<FloatType>& buffer, MidiBuffer& midi)
+    {
+        if (isBypassed())
+            pluginInstance->processBlockBypassed (buffer, midi);
+        else
+            pluginInstance->processBlock (buffer, midi);
+    }
 
-                        if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
-                        {
-                            param->setValue (floatValue);
+    /** Calls processBlock() for the parts of the block between the automation points, when
+        the processor has asked for it with setMinimumAutomationSubBlockSize().
+    */
+    template <typename FloatType>
+    void processBlockFollowingAutomation (AudioBuffer<FloatType>& buffer)
+    {
+        auto minimumSize = pluginInstance->getMinimumAutomationSubBlockSize();
+        auto numSamples = buffer.getNumSamples();
 
-                            inParameterChangedCallback = true;
-                            param->sendValueChangedMessageToListeners (floatValue);
-                        }
-                    }
+        if (minimumSize <= 0 || automationQueues.isEmpty())
+        {
+            callProcessBlock (buffer, midiBuffer);
+            return;
+        }
+
+        auto split = getNextAutomationSplit (0, numSamples, minimumSize);
+        applyParameterChangesBefore (split);
+
+        if (split >= numSamples)
+        {
+            callProcessBlock (buffer, midiBuffer);
+        }
+        else
+        {
+            subBlockMidiOutput.clear();
+
+            for (int start = 0; start < numSamples;)
+            {
+                auto length = split - start;
+                AudioBuffer<FloatType> subBuffer (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, length);
+
+                subBlockMidiBuffer.clear();
+                subBlockMidiBuffer.addEvents (midiBuffer, start, length, -start);
+
+                callProcessBlock (subBuffer, subBlockMidiBuffer);
+                subBlockMidiOutput.addEvents (subBlockMidiBuffer, 0, -1, start);
+
+                start = split;
+
+                if (start < numSamples)
+                {
+                    split = getNextAutomationSplit (start, numSamples, minimumSize);
+                    applyParameterChangesBefore (split);
                 }
             }
+
+            midiBuffer.swapWith (subBlockMidiOutput);
         }
     }
 
@@ -2351,10 +2482,15 @@ public:
                 return kResultFalse;
         }
 
-        if      (processSetup.symbolicSampleSize == Vst::kSample32) processAudio<float>  (data, channelListFloat);
-        else if (processSetup.symbolicSampleSize == Vst::kSample64) processAudio<double> (data, channelListDouble);
+        if      (processSetup.symbolicSampleSize == Vst::kSample32) processAudio<float>  (data, channelListFloat,  inputChannelListFloat);
+        else if (processSetup.symbolicSampleSize == Vst::kSample64) processAudio<double> (data, channelListDouble, inputChannelListDouble);
         else jassertfalse;
 
+        // Applies whatever automation processAudio() didn't, e.g. points after the end of
+        // the block, or all of them if the block couldn't be processed
+        applyParameterChangesBefore (std::numeric_limits<int>::max());
+        automationQueues.clearQuick();
+
        #if JucePlugin_ProducesMidiOutput
         if (data.outputEvents != nullptr)
             MidiEventList::toEventList (*data.outputEvents, midiBuffer);
@@ -2366,10 +2502,10 @@ public:
 private:
     //==============================================================================
     template <typename FloatType>
-    void processAudio (Vst::ProcessData& data, Array<FloatType*>& channelList)
+    void processAudio (Vst::ProcessData& data, Array<FloatType*>& channelList, Array<FloatType*>& inputChannelList)
     {
         int totalInputChans = 0, totalOutputChans = 0;
-        bool tmpBufferNeedsClearing = false;
+        auto numSamples = (int) data.numSamples;
 
         auto plugInInputChannels  = pluginInstance->getTotalNumInputChannels();
         auto plugInOutputChannels = pluginInstance->getTotalNumOutputChannels();
@@ -2399,15 +2535,8 @@ private:
                         auto numChans = jmin ((int) data.outputs[bus].numChannels, plugInOutputChannels - totalOutputChans);
 
                         for (int i = 0; i < numChans; ++i)
-                        {
-                            if (auto dst = busChannels[i])
-                            {
-                                if (totalOutputChans >= plugInInputChannels)
-                                    FloatVectorOperations::clear (dst, (int) data.numSamples);
-
+                            if (busChannels[i] != nullptr)
                                 channelList.set (totalOutputChans++, busChannels[i]);
-                            }
-                        }
                     }
                 }
                 else
@@ -2416,9 +2545,9 @@ private:
 
                     for (int i = 0; i < numChans; ++i)
                     {
-                        if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (totalOutputChans, data.numSamples))\
+                        if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (totalOutputChans, numSamples))
                         {
-                            tmpBufferNeedsClearing = true;
+                            FloatVectorOperations::clear (tmpBuffer, numSamples);
                             channelList.set (totalOutputChans++, tmpBuffer);
                         }
                         else
@@ -2440,23 +2569,7 @@ private:
                         const int numChans = jmin ((int) data.inputs[bus].numChannels, plugInInputChannels - totalInputChans);
 
                         for (int i = 0; i < numChans; ++i)
-                        {
-                            if (busChannels[i] != nullptr)
-                            {
-                                if (totalInputChans >= totalOutputChans)
-                                    channelList.set (totalInputChans, busChannels[i]);
-                                else
-                                {
-                                    auto* dst = channelList.getReference (totalInputChans);
-                                    auto* src = busChannels[i];
-
-                                    if (dst != src)
-                                        FloatVectorOperations::copy (dst, src, (int) data.numSamples);
-                                }
-                            }
-
-                            ++totalInputChans;
-                        }
+                            inputChannelList.set (totalInputChans++, busChannels[i]);
                     }
                 }
                 else
@@ -2465,9 +2578,10 @@ private:
 
                     for (int i = 0; i < numChans; ++i)
                     {
-                        if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (totalInputChans, data.numSamples))
+                        if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (totalInputChans, numSamples))
                         {
-                            tmpBufferNeedsClearing = true;
+                            FloatVectorOperations::clear (tmpBuffer, numSamples);
+                            inputChannelList.set (totalInputChans, nullptr);
                             channelList.set (totalInputChans++, tmpBuffer);
                         }
                         else
@@ -2477,13 +2591,50 @@ private:
             }
         }
 
-        if (tmpBufferNeedsClearing)
-            ChooseBufferHelper<FloatType>::impl (emptyBufferFloat, emptyBufferDouble).clear();
+        // Hosts that process in place hand us the same memory for an input and an output.
+        // When that memory belongs to the output of a *different* channel, it would get
+        // overwritten before it's read, so only those inputs get moved out of the way.
+        for (int i = 0; i < totalInputChans; ++i)
+        {
+            if (auto* src = inputChannelList.getUnchecked (i))
+            {
+                for (int j = 0; j < totalOutputChans; ++j)
+                {
+                    if (j != i && channelList.getUnchecked (j) == src)
+                    {
+                        if (auto* tmpBuffer = getTmpBufferForChannel<FloatType> (i, numSamples))
+                        {
+                            FloatVectorOperations::copy (tmpBuffer, src, numSamples);
+                            inputChannelList.set (i, tmpBuffer);
+                        }
+                        else
+                            return;
+
+                        break;
+                    }
+                }
+            }
+        }
+
+        for (int i = plugInInputChannels; i < totalOutputChans; ++i)
+            FloatVectorOperations::clear (channelList.getUnchecked (i), numSamples);
+
+        // Everything else is either used where it is, or copied once into its output
+        for (int i = 0; i < totalInputChans; ++i)
+        {
+            if (auto* src = inputChannelList.getUnchecked (i))
+            {
+                if (i >= totalOutputChans)
+                    channelList.set (i, src);
+                else if (channelList.getUnchecked (i) != src)
+                    FloatVectorOperations::copy (channelList.getUnchecked (i), src, numSamples);
+            }
+        }
 
         AudioBuffer<FloatType> buffer;
 
         if (int totalChans = jmax (totalOutputChans, totalInputChans))
-            buffer.setDataToReferTo (channelList.getRawDataPointer(), totalChans, (int) data.numSamples);
+            buffer.setDataToReferTo (channelList.getRawDataPointer(), totalChans, numSamples);
 
         {
             const ScopedLock sl (pluginInstance->getCallbackLock());
@@ -2503,10 +2654,7 @@ private:
                 if (totalInputChans == pluginInstance->getTotalNumInputChannels()
                  && totalOutputChans == pluginInstance->getTotalNumOutputChannels())
                 {
-                    if (isBypassed())
-                        pluginInstance->processBlockBypassed (buffer, midiBuffer);
-                    else
-                        pluginInstance->processBlock (buffer, midiBuffer);
+                    processBlockFollowingAutomation (buffer);
                 }
             }
 
@@ -2532,21 +2680,30 @@ private:
 
     //==============================================================================
     template <typename FloatType>
-    void allocateChannelListAndBuffers (Array<FloatType*>& channelList, AudioBuffer<FloatType>& buffer)
+    void allocateChannelListAndBuffers (Array<FloatType*>& channelList, Array<FloatType*>& inputChannelList,
+                                        AudioBuffer<FloatType>& buffer)
     {
         channelList.clearQuick();
         channelList.insertMultiple (0, nullptr, 128);
 
+        inputChannelList.clearQuick();
+        inputChannelList.insertMultiple (0, nullptr, 128);
+
         auto& p = getPluginInstance();
         buffer.setSize (jmax (p.getTotalNumInputChannels(), p.getTotalNumOutputChannels()), p.getBlockSize() * 4);
         buffer.clear();
     }
 
     template <typename FloatType>
-    void deallocateChannelListAndBuffers (Array<FloatType*>& channelList, AudioBuffer<FloatType>& buffer)
+    void deallocateChannelListAndBuffers (Array<FloatType*>& channelList, Array<FloatType*>& inputChannelList,
+                                          AudioBuffer<FloatType>& buffer)
     {
         channelList.clearQuick();
         channelList.resize (0);
+
+        inputChannelList.clearQuick();
+        inputChannelList.resize (0);
+
         buffer.setSize (0, 0);
     }
 
@@ -2578,6 +2735,10 @@ private:
 
         midiBuffer.ensureSize (2048);
         midiBuffer.clear();
+
+        subBlockMidiBuffer.ensureSize (2048);
+        subBlockMidiOutput.ensureSize (2048);
+        automationQueues.ensureStorageAllocated (128);
     }
 
     //==============================================================================
@@ -2596,9 +2757,10 @@ private:
 
     Vst::ProcessSetup processSetup;
 
-    MidiBuffer midiBuffer;
-    Array<float*> channelListFloat;
-    Array<double*> channelListDouble;
+    MidiBuffer midiBuffer, subBlockMidiBuffer, subBlockMidiOutput;
+    Array<AutomationQueue> automationQueues;
+    Array<float*> channelListFloat, inputChannelListFloat;
+    Array<double*> channelListDouble, inputChannelListDouble;
 
     AudioBuffer<float>  emptyBufferFloat;
     AudioBuffer<double> emptyBufferDouble;
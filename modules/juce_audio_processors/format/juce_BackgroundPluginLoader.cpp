@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+struct BackgroundPluginLoader::PrepareJob  : public ThreadPoolJob
+{
+    PrepareJob (BackgroundPluginLoader& l, const Request& r)
+        : ThreadPoolJob ("Plug-in loader"), owner (&l), formatManager (l.formatManager),
+          request (r), generation (l.generation)
+    {}
+
+    JobStatus runJob() override
+    {
+       #if JUCE_PLUGINHOST_VST3 && (JUCE_MAC || JUCE_WINDOWS)
+        // Opening a VST3 bundle is the slow part of instantiating it, and doesn't need
+        // the message thread, so get it done here while the instance itself is created later.
+        if (request.description.pluginFormatName == "VST3")
+            VST3PluginFormat::preloadModule (request.description);
+       #endif
+
+        if (shouldExit())
+            return jobHasFinished;
+
+        auto weakOwner = owner;
+        auto req = request;
+        auto gen = generation;
+
+        formatManager.createPluginInstanceAsync (request.description, request.sampleRate, request.blockSize,
+                                                 [weakOwner, req, gen] (AudioPluginInstance* newInstance, const String& error)
+        {
+            std::unique_ptr<AudioPluginInstance> instance (newInstance);
+
+            if (auto* loader = weakOwner.get())
+                if (loader->generation == gen)
+                    loader->pluginCreated (req, std::move (instance), error, false);
+        });
+
+        return jobHasFinished;
+    }
+
+    WeakReference<BackgroundPluginLoader> owner;
+    AudioPluginFormatManager& formatManager;
+    const Request request;
+    const int generation;
+};
+
+//==============================================================================
+struct BackgroundPluginLoader::RestoreStateJob  : public ThreadPoolJob
+{
+    RestoreStateJob (BackgroundPluginLoader& l, const Request& r, std::unique_ptr<AudioPluginInstance> i)
+        : ThreadPoolJob ("Plug-in state loader"), owner (&l), request (r),
+          instance (std::move (i)), generation (l.generation)
+    {}
+
+    JobStatus runJob() override
+    {
+        instance->setStateInformation (request.state.getData(), (int) request.state.getSize());
+
+        // If the loader has gone by the time this arrives, the instance still needs
+        // to be deleted on the message thread, so it travels in a shared holder.
+        auto holder = std::make_shared<Holder>();
+        holder->instance = std::move (instance);
+        auto weakOwner = owner;
+        auto req = request;
+        auto gen = generation;
+
+        MessageManager::callAsync ([weakOwner, req, gen, holder]
+        {
+            if (auto* loader = weakOwner.get())
+                if (loader->generation == gen)
+                    loader->pluginCreated (req, std::move (holder->instance), {}, true);
+        });
+
+        return jobHasFinished;
+    }
+
+    struct Holder  { std::unique_ptr<AudioPluginInstance> instance; };
+
+    WeakReference<BackgroundPluginLoader> owner;
+    const Request request;
+    std::unique_ptr<AudioPluginInstance> instance;
+    const int generation;
+};
+
+//==============================================================================
+BackgroundPluginLoader::BackgroundPluginLoader (AudioPluginFormatManager& manager, int numThreads)
+    : formatManager (manager), pool (jmax (1, numThreads))
+{
+}
+
+BackgroundPluginLoader::~BackgroundPluginLoader()
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+    cancel();
+    pool.removeAllJobs (true, 10000);
+}
+
+void BackgroundPluginLoader::load (const Request& request)
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    ++numRequested;
+    pool.addJob (new PrepareJob (*this, request), true);
+}
+
+void BackgroundPluginLoader::cancel()
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    ++generation;
+    numRequested = 0;
+    numFinished = 0;
+
+    // Jobs which are already running are left to finish - anything they produce
+    // will be thrown away when it arrives because the generation has moved on.
+    pool.removeAllJobs (false, 0);
+}
+
+void BackgroundPluginLoader::pluginCreated (const Request& request, std::unique_ptr<AudioPluginInstance> instance,
+                                            const String& error, bool stateRestored)
+{
+    if (instance == nullptr)
+    {
+        if (onPluginFailed != nullptr)
+            onPluginFailed (request, error.isNotEmpty() ? error : NEEDS_TRANS ("The plug-in couldn't be created"));
+
+        requestFinished();
+        return;
+    }
+
+    if (! stateRestored && request.state.getSize() > 0)
+    {
+        if (restoreStateOnWorkers)
+        {
+            pool.addJob (new RestoreStateJob (*this, request, std::move (instance)), true);
+            return;
+        }
+
+        instance->setStateInformation (request.state.getData(), (int) request.state.getSize());
+    }
+
+    if (graph != nullptr)
+    {
+        if (auto node = graph->addNode (instance.get(), request.nodeID))
+        {
+            instance.release();
+
+            if (onNodeAdded != nullptr)
+                onNodeAdded (request, node);
+        }
+        else if (onPluginFailed != nullptr)
+        {
+            onPluginFailed (request, NEEDS_TRANS ("The plug-in couldn't be added to the graph"));
+        }
+    }
+    else if (onPluginLoaded != nullptr)
+    {
+        onPluginLoaded (request, std::move (instance));
+    }
+
+    requestFinished();
+}
+
+void BackgroundPluginLoader::requestFinished()
+{
+    ++numFinished;
+
+    if (onProgress != nullptr)
+        onProgress (numFinished, numRequested);
+}
+
+} // namespace juce
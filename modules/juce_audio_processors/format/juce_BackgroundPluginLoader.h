@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Instantiates plug-ins in the background, so that a host can restore a large
+    session without stalling its message thread for the whole time.
+
+    Each call to load() queues a Request on a small pool of worker threads. A
+    worker does the parts of loading which are safe to do off the message thread
+    - at the moment this means opening the plug-in's module, for formats which
+    support it - and then asks the AudioPluginFormatManager to create the
+    instance, which the formats finish on the message thread as they require.
+    Because the expensive module loading happens in parallel, the message thread
+    only pays for the actual instantiation of each plug-in.
+
+    The saved state in the request is restored on the message thread by default.
+    Most plug-ins also accept setStateInformation() on other threads, and if you
+    know yours do, setRestoresStateOnWorkerThreads() moves that work to the pool
+    too.
+
+    When setGraph() has been given an AudioProcessorGraph, each plug-in is added
+    to it as soon as it's ready, using the request's NodeID, so a session can start
+    being built before all its plug-ins have finished loading.
+
+    All the callbacks are made on the message thread, and load(), cancel() and
+    the destructor must be called on the message thread too.
+
+    @see AudioPluginFormatManager::createPluginInstanceAsync
+
+    @tags{Audio}
+*/
+class JUCE_API  BackgroundPluginLoader
+{
+public:
+    //==============================================================================
+    /** Creates a loader which uses the formats in the given manager.
+
+        The format manager must stay alive for as long as the loader does.
+        numThreads is the maximum number of plug-ins that will be prepared at once.
+    */
+    BackgroundPluginLoader (AudioPluginFormatManager& formatManager,
+                            int numThreads = jmax (1, SystemStats::getNumCpus() / 2));
+
+    /** Destructor.
+        This cancels anything that's still loading, and waits for the worker threads
+        to finish whatever they're in the middle of.
+    */
+    ~BackgroundPluginLoader();
+
+    //==============================================================================
+    /** Describes a plug-in to load. */
+    struct Request
+    {
+        /** The plug-in to instantiate. */
+        PluginDescription description;
+
+        /** The sample rate and block size to pass to the format when creating the instance. */
+        double sampleRate = 44100.0;
+        int blockSize = 512;
+
+        /** A block of data from getStateInformation() to restore, or an empty block
+            to leave the new instance in its default state.
+        */
+        MemoryBlock state;
+
+        /** If the loader has a graph, the ID to give the plug-in's node in it. If this
+            is left as zero, the graph will pick a new one.
+        */
+        AudioProcessorGraph::NodeID nodeID;
+    };
+
+    /** Queues a plug-in to be loaded. */
+    void load (const Request& request);
+
+    /** Cancels everything that's waiting to be loaded.
+
+        Requests that haven't started are dropped, and instances which are already
+        being created are deleted when they arrive, without any callbacks being
+        made for them.
+    */
+    void cancel();
+
+    /** Returns true if any of the requests passed to load() haven't finished yet. */
+    bool isLoading() const noexcept                         { return numFinished < numRequested; }
+
+    //==============================================================================
+    /** Gives the loader a graph to add the plug-ins to as they finish loading.
+
+        When a graph is set, the new instances are handed to the graph rather than
+        to onPluginLoaded, and onNodeAdded is called instead. Pass nullptr to stop
+        using a graph. The graph must outlive the loader, or be removed before it's
+        deleted.
+    */
+    void setGraph (AudioProcessorGraph* graphToAddNodesTo) noexcept     { graph = graphToAddNodesTo; }
+
+    /** Chooses whether saved states are restored on the worker threads rather than
+        on the message thread. This is off by default, because not every plug-in
+        can cope with it.
+    */
+    void setRestoresStateOnWorkerThreads (bool shouldRestoreOnWorkers) noexcept   { restoreStateOnWorkers = shouldRestoreOnWorkers; }
+
+    //==============================================================================
+    /** Called when a plug-in has been created and its state restored, if the loader
+        doesn't have a graph. The callback takes ownership of the new instance.
+    */
+    std::function<void (const Request&, std::unique_ptr<AudioPluginInstance>)> onPluginLoaded;
+
+    /** Called when a plug-in has been added to the graph given to setGraph(). */
+    std::function<void (const Request&, AudioProcessorGraph::Node::Ptr)> onNodeAdded;
+
+    /** Called when a plug-in couldn't be loaded, with an error message describing why. */
+    std::function<void (const Request&, const String& errorMessage)> onPluginFailed;
+
+    /** Called each time a request finishes, whether it worked or not. When
+        numFinished reaches numRequested, the loader has nothing left to do.
+    */
+    std::function<void (int numFinished, int numRequested)> onProgress;
+
+private:
+    //==============================================================================
+    struct PrepareJob;
+    struct RestoreStateJob;
+
+    void pluginCreated (const Request&, std::unique_ptr<AudioPluginInstance>, const String& error, bool stateRestored);
+    void requestFinished();
+
+    AudioPluginFormatManager& formatManager;
+    ThreadPool pool;
+    AudioProcessorGraph* graph = nullptr;
+    bool restoreStateOnWorkers = false;
+    int generation = 0, numRequested = 0, numFinished = 0;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (BackgroundPluginLoader)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundPluginLoader)
+};
+
+} // namespace juce
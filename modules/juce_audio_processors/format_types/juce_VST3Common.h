@@ -415,7 +415,7 @@ private:
 class MidiEventList  : public Steinberg::Vst::IEventList
 {
 public:
-    MidiEventList() {}
+    MidiEventList()                 { events.ensureStorageAllocated (maxNumEvents); }
     virtual ~MidiEventList() {}
 
     JUCE_DECLARE_VST3_COM_REF_METHODS
@@ -427,6 +427,9 @@ public:
         events.clearQuick();
     }
 
+    /** Returns the number of events that have been refused because the list was full. */
+    int getNumDroppedEvents() const noexcept    { return numEventsDropped.get(); }
+
     Steinberg::int32 PLUGIN_API getEventCount() override
     {
         return (Steinberg::int32) events.size();
@@ -444,8 +447,18 @@ public:
         return Steinberg::kResultFalse;
     }
 
+    // The storage is reserved up-front, and events beyond it are refused rather
+    // than making the list reallocate on the audio thread.
     Steinberg::tresult PLUGIN_API addEvent (Steinberg::Vst::Event& e) override
     {
+        const ScopedLock sl (events.getLock());
+
+        if (events.size() >= maxNumEvents)
+        {
+            ++numEventsDropped;
+            return Steinberg::kOutOfMemory;
+        }
+
         events.add (e);
         return Steinberg::kResultTrue;
     }
@@ -455,6 +468,10 @@ public:
     {
         const int32 numEvents = eventList.getEventCount();
 
+        // Reserve room for the short messages up-front. Events are written straight into
+        // the buffer from raw bytes, so no MidiMessage objects get created on the way.
+        result.ensureSize ((size_t) result.data.size() + (size_t) numEvents * (3 + sizeof (int32) + sizeof (uint16)));
+
         for (Steinberg::int32 i = 0; i < numEvents; ++i)
         {
             Steinberg::Vst::Event e;
@@ -464,28 +481,24 @@ public:
                 switch (e.type)
                 {
                     case Steinberg::Vst::Event::kNoteOnEvent:
-                        result.addEvent (MidiMessage::noteOn (createSafeChannel (e.noteOn.channel),
-                                                              createSafeNote (e.noteOn.pitch),
-                                                              (Steinberg::uint8) denormaliseToMidiValue (e.noteOn.velocity)),
-                                         e.sampleOffset);
+                        addShortMessage (result, 0x90, createSafeChannel (e.noteOn.channel),
+                                         createSafeNote (e.noteOn.pitch),
+                                         denormaliseToMidiValue (e.noteOn.velocity), e.sampleOffset);
                         break;
 
                     case Steinberg::Vst::Event::kNoteOffEvent:
-                        result.addEvent (MidiMessage::noteOff (createSafeChannel (e.noteOff.channel),
-                                                               createSafeNote (e.noteOff.pitch),
-                                                               (Steinberg::uint8) denormaliseToMidiValue (e.noteOff.velocity)),
-                                         e.sampleOffset);
+                        addShortMessage (result, 0x80, createSafeChannel (e.noteOff.channel),
+                                         createSafeNote (e.noteOff.pitch),
+                                         denormaliseToMidiValue (e.noteOff.velocity), e.sampleOffset);
                         break;
 
                     case Steinberg::Vst::Event::kPolyPressureEvent:
-                        result.addEvent (MidiMessage::channelPressureChange (createSafeChannel (e.polyPressure.channel),
-                                                                             denormaliseToMidiValue (e.polyPressure.pressure)),
-                                         e.sampleOffset);
+                        addShortMessage (result, 0xd0, createSafeChannel (e.polyPressure.channel),
+                                         denormaliseToMidiValue (e.polyPressure.pressure), -1, e.sampleOffset);
                         break;
 
                     case Steinberg::Vst::Event::kDataEvent:
-                        result.addEvent (MidiMessage::createSysExMessage (e.data.bytes, (int) e.data.size),
-                                         e.sampleOffset);
+                        addSysExMessage (result, e.data.bytes, (int) e.data.size, e.sampleOffset);
                         break;
 
                     default:
@@ -504,7 +517,6 @@ public:
         int midiEventSize = 0;
         int midiEventPosition = 0;
 
-        enum { maxNumEvents = 2048 }; // Steinberg's Host Checker states that no more than 2048 events are allowed at once
         int numEvents = 0;
 
         while (iterator.getNextEvent (midiEventData, midiEventSize, midiEventPosition))
@@ -512,17 +524,23 @@ public:
             if (++numEvents > maxNumEvents)
                 break;
 
-            MidiMessage msg (midiEventData, midiEventSize);
+            // The raw bytes are inspected directly rather than through a MidiMessage,
+            // which would have to allocate for any long sysex messages.
+            const auto status = midiEventData[0];
+            const auto type = (uint8) (status & 0xf0);
+            const int channel = (status & 0x0f) + 1;
+            const int data1 = midiEventSize > 1 ? midiEventData[1] : 0;
+            const int data2 = midiEventSize > 2 ? midiEventData[2] : 0;
 
             if (midiMapping != nullptr && parameterChanges != nullptr)
             {
                 Vst3MidiControlEvent controlEvent;
 
-                if (toVst3ControlEvent (msg, controlEvent))
+                if (toVst3ControlEvent (type, data1, data2, controlEvent))
                 {
                     Steinberg::Vst::ParamID controlParamID;
 
-                    if (midiMapping->getMidiControllerAssignment (0, createSafeChannel (msg.getChannel()),
+                    if (midiMapping->getMidiControllerAssignment (0, createSafeChannel (channel),
                                                                   controlEvent.controllerNumber,
                                                                   controlParamID) == Steinberg::kResultOk)
                     {
@@ -538,38 +556,38 @@ public:
 
             Steinberg::Vst::Event e = { 0 };
 
-            if (msg.isNoteOn())
+            if (type == 0x90 && data2 != 0)
             {
                 e.type              = Steinberg::Vst::Event::kNoteOnEvent;
-                e.noteOn.channel    = createSafeChannel (msg.getChannel());
-                e.noteOn.pitch      = createSafeNote (msg.getNoteNumber());
-                e.noteOn.velocity   = normaliseMidiValue (msg.getVelocity());
+                e.noteOn.channel    = createSafeChannel (channel);
+                e.noteOn.pitch      = createSafeNote (data1);
+                e.noteOn.velocity   = normaliseMidiValue (data2);
                 e.noteOn.length     = 0;
                 e.noteOn.tuning     = 0.0f;
                 e.noteOn.noteId     = -1;
             }
-            else if (msg.isNoteOff())
+            else if (type == 0x80 || type == 0x90)
             {
                 e.type              = Steinberg::Vst::Event::kNoteOffEvent;
-                e.noteOff.channel   = createSafeChannel (msg.getChannel());
-                e.noteOff.pitch     = createSafeNote (msg.getNoteNumber());
-                e.noteOff.velocity  = normaliseMidiValue (msg.getVelocity());
+                e.noteOff.channel   = createSafeChannel (channel);
+                e.noteOff.pitch     = createSafeNote (data1);
+                e.noteOff.velocity  = normaliseMidiValue (data2);
                 e.noteOff.tuning    = 0.0f;
                 e.noteOff.noteId    = -1;
             }
-            else if (msg.isSysEx())
+            else if (status == 0xf0)
             {
                 e.type          = Steinberg::Vst::Event::kDataEvent;
                 e.data.bytes    = midiEventData + 1;
-                e.data.size     = (uint32) msg.getSysExDataSize();
+                e.data.size     = (uint32) jmax (0, midiEventSize - 2);
                 e.data.type     = Steinberg::Vst::DataEvent::kMidiSysEx;
             }
-            else if (msg.isChannelPressure())
+            else if (type == 0xd0)
             {
                 e.type                   = Steinberg::Vst::Event::kPolyPressureEvent;
-                e.polyPressure.channel   = createSafeChannel (msg.getChannel());
-                e.polyPressure.pitch     = createSafeNote (msg.getNoteNumber());
-                e.polyPressure.pressure  = normaliseMidiValue (msg.getChannelPressureValue());
+                e.polyPressure.channel   = createSafeChannel (channel);
+                e.polyPressure.pitch     = createSafeNote (data1);
+                e.polyPressure.pressure  = normaliseMidiValue (data1);
             }
             else
             {
@@ -584,8 +602,10 @@ public:
     }
 
 private:
+    enum { maxNumEvents = 2048 }; // Steinberg's Host Checker states that no more than 2048 events are allowed at once
+
     Array<Steinberg::Vst::Event, CriticalSection> events;
-    Atomic<int> refCount;
+    Atomic<int> refCount, numEventsDropped;
 
     static Steinberg::int16 createSafeChannel (int channel) noexcept  { return (Steinberg::int16) jlimit (0, 15, channel - 1); }
     static int createSafeChannel (Steinberg::int16 channel) noexcept  { return (int) jlimit (1, 16, channel + 1); }
@@ -603,17 +623,44 @@ private:
         Steinberg::Vst::ParamValue paramValue;
     };
 
-    static bool toVst3ControlEvent (const MidiMessage& msg, Vst3MidiControlEvent& result)
+    static bool toVst3ControlEvent (uint8 type, int data1, int data2, Vst3MidiControlEvent& result)
     {
         result.controllerNumber = -1;
 
-        if      (msg.isController())        result = { (Steinberg::Vst::CtrlNumber) msg.getControllerNumber(), msg.getControllerValue() / 127.0};
-        else if (msg.isPitchWheel())        result = { Steinberg::Vst::kPitchBend, msg.getPitchWheelValue() / 16383.0};
-        else if (msg.isAftertouch())        result = { Steinberg::Vst::kAfterTouch, msg.getAfterTouchValue() / 127.0};
+        if      (type == 0xb0)      result = { (Steinberg::Vst::CtrlNumber) data1, data2 / 127.0 };
+        else if (type == 0xe0)      result = { Steinberg::Vst::kPitchBend, (data1 | (data2 << 7)) / 16383.0 };
+        else if (type == 0xa0)      result = { Steinberg::Vst::kAfterTouch, data2 / 127.0 };
 
         return (result.controllerNumber != -1);
     }
 
+    //==============================================================================
+    static void addShortMessage (MidiBuffer& result, int type, int channel, int data1, int data2, int sampleOffset)
+    {
+        const uint8 bytes[] = { (uint8) (type | (channel - 1)), (uint8) data1, (uint8) data2 };
+        result.addEvent (bytes, data2 < 0 ? 2 : 3, sampleOffset);
+    }
+
+    static void addSysExMessage (MidiBuffer& result, const uint8* data, int size, int sampleOffset)
+    {
+        // Small messages are framed on the stack - only unusually large ones need the heap.
+        uint8 stackSpace[256];
+        HeapBlock<uint8> heapSpace;
+        auto* bytes = stackSpace;
+
+        if (size + 2 > (int) sizeof (stackSpace))
+        {
+            heapSpace.malloc (size + 2);
+            bytes = heapSpace;
+        }
+
+        bytes[0] = 0xf0;
+        memcpy (bytes + 1, data, (size_t) size);
+        bytes[size + 1] = 0xf7;
+
+        result.addEvent (bytes, size + 2, sampleOffset);
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiEventList)
 };
 
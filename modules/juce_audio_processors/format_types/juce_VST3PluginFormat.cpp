@@ -783,29 +783,6 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DescriptionFactory)
 };
 
-struct MatchingDescriptionFinder  : public DescriptionFactory
-{
-    MatchingDescriptionFinder (VST3HostContext* h, IPluginFactory* f, const PluginDescription& desc)
-       : DescriptionFactory (h, f), description (desc)
-    {
-    }
-
-    static const char* getSuccessString() noexcept  { return "Found Description"; }
-
-    Result performOnDescription (PluginDescription& desc)
-    {
-        if (description.isDuplicateOf (desc))
-            return Result::fail (getSuccessString());
-
-        return Result::ok();
-    }
-
-private:
-    const PluginDescription& description;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MatchingDescriptionFinder)
-};
-
 struct DescriptionLister  : public DescriptionFactory
 {
     DescriptionLister (VST3HostContext* host, IPluginFactory* pluginFactory)
@@ -826,9 +803,11 @@ private:
 };
 
 //==============================================================================
-struct DLLHandle
+struct DLLHandle  : public ReferenceCountedObject
 {
-    DLLHandle (const String& modulePath)
+    using Ptr = ReferenceCountedObjectPtr<DLLHandle>;
+
+    DLLHandle (const String& modulePath)  : path (modulePath)
     {
         if (modulePath.trim().isNotEmpty())
             open (modulePath);
@@ -907,6 +886,8 @@ struct DLLHandle
        #endif
     }
 
+    const String path;
+
 private:
     IPluginFactory* factory = nullptr;
 
@@ -999,15 +980,7 @@ private:
 //==============================================================================
 struct VST3ModuleHandle  : public ReferenceCountedObject
 {
-    explicit VST3ModuleHandle (const File& pluginFile)  : file (pluginFile)
-    {
-        getActiveModules().add (this);
-    }
-
-    ~VST3ModuleHandle()
-    {
-        getActiveModules().removeFirstMatchingValue (this);
-    }
+    explicit VST3ModuleHandle (const File& pluginFile)  : file (pluginFile) {}
 
     /**
         Since there is no apparent indication if a VST3 plugin is a shell or not,
@@ -1015,87 +988,214 @@ struct VST3ModuleHandle  : public ReferenceCountedObject
         for every housed plugin.
     */
     static bool getAllDescriptionsForFile (OwnedArray<PluginDescription>& results,
-                                           const String& fileOrIdentifier)
+                                           const String& fileOrIdentifier);
+
+    //==============================================================================
+    using Ptr = ReferenceCountedObjectPtr<VST3ModuleHandle>;
+
+    static Ptr findOrCreateModule (const File& file, const PluginDescription& description);
+
+    /** Clears a pointer to a module, unloading it if nothing else is using it. */
+    static void release (Ptr& module);
+
+    //==============================================================================
+    IPluginFactory* getPluginFactory()      { return dllHandle->getPluginFactory(); }
+
+    File file;
+    String name;
+    int classIndex = -1;
+
+private:
+    friend struct VST3ModuleCache;
+    DLLHandle::Ptr dllHandle;
+
+    //==============================================================================
+    bool open (DLLHandle::Ptr library, const PluginDescription& description)
     {
-        DLLHandle tempModule (fileOrIdentifier);
+        dllHandle = library;
 
-        ComSmartPtr<IPluginFactory> pluginFactory (tempModule.getPluginFactory());
+        if (dllHandle == nullptr)
+            return false;
 
-        if (pluginFactory != nullptr)
+        ComSmartPtr<IPluginFactory> pluginFactory (dllHandle->getPluginFactory());
+
+        if (pluginFactory == nullptr || description.fileOrIdentifier != file.getFullPathName())
+            return false;
+
+        // This only needs the class infos, so unlike building a full description it doesn't
+        // have to create any components, and can be done on any thread
+        StringArray foundNames;
+        auto numClasses = pluginFactory->countClasses();
+
+        for (Steinberg::int32 i = 0; i < numClasses; ++i)
         {
-            ComSmartPtr<VST3HostContext> host (new VST3HostContext());
-            DescriptionLister lister (host, pluginFactory);
-            auto result = lister.findDescriptionsAndPerform (File (fileOrIdentifier));
+            PClassInfo info;
+
+            if (pluginFactory->getClassInfo (i, &info) != kResultOk
+                 || std::strcmp (info.category, kVstAudioEffectClass) != 0)
+                continue;
 
-            results.addCopiesOf (lister.list);
+            const String className (toString (info.name).trim());
+
+            if (foundNames.contains (className, true))
+                continue;
 
-            return result.wasOk();
+            foundNames.add (className);
+
+            if (getHashForTUID (info.cid) == description.uid)
+            {
+                name = description.name;
+                classIndex = (int) i;
+                return true;
+            }
         }
 
-        jassertfalse;
         return false;
     }
 
-    //==============================================================================
-    using Ptr = ReferenceCountedObjectPtr<VST3ModuleHandle>;
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VST3ModuleHandle)
+};
+
+//==============================================================================
+/*  Keeps hold of the VST3 libraries and modules which are in use, so that every instance of
+    a plugin shares a single loaded library, factory and class lookup. Entries are dropped
+    (and the libraries unloaded) as soon as nothing else refers to them.
+
+    Everything that adds or drops a reference to one of the cached objects does so while
+    holding the lock, which means that modules can be opened from any thread.
+*/
+struct VST3ModuleCache
+{
+    static VST3ModuleCache& getInstance()
+    {
+        static VST3ModuleCache cache;
+        return cache;
+    }
 
-    static VST3ModuleHandle::Ptr findOrCreateModule (const File& file, const PluginDescription& description)
+    DLLHandle::Ptr findOrOpenLibrary (const String& path)
     {
-        for (auto* module : getActiveModules())
+        const ScopedLock sl (lock);
+
+        for (auto* library : libraries)
+            if (library->path == path)
+                return library;
+
+        DLLHandle::Ptr library (new DLLHandle (path));
+
+        if (library->getPluginFactory() == nullptr)
+            return nullptr;
+
+        libraries.add (library);
+        return library;
+    }
+
+    VST3ModuleHandle::Ptr findOrCreateModule (const File& file, const PluginDescription& description)
+    {
+        const ScopedLock sl (lock);
+
+        for (auto* module : modules)
             // VST3s are basically shells, you must therefore check their name along with their file:
             if (module->file == file && module->name == description.name)
                 return module;
 
         VST3ModuleHandle::Ptr m (new VST3ModuleHandle (file));
 
-        if (! m->open (file, description))
+        if (! m->open (findOrOpenLibrary (file.getFullPathName()), description))
+        {
             m = nullptr;
+            purge();
+            return nullptr;
+        }
 
+        modules.add (m);
         return m;
     }
 
-    //==============================================================================
-    IPluginFactory* getPluginFactory()      { return dllHandle->getPluginFactory(); }
+    template <typename ObjectType>
+    void release (ReferenceCountedObjectPtr<ObjectType>& object)
+    {
+        const ScopedLock sl (lock);
+        object = nullptr;
+        purge();
+    }
 
-    File file;
-    String name;
+    bool preload (const File& file, const PluginDescription& description)
+    {
+        const ScopedLock sl (lock);
 
-private:
-    std::unique_ptr<DLLHandle> dllHandle;
+        if (auto module = findOrCreateModule (file, description))
+        {
+            preloadedModules.addIfNotAlreadyThere (module.get());
+            return true;
+        }
 
-    //==============================================================================
-    static Array<VST3ModuleHandle*>& getActiveModules()
+        return false;
+    }
+
+    void releasePreloadedModules()
     {
-        static Array<VST3ModuleHandle*> activeModules;
-        return activeModules;
+        const ScopedLock sl (lock);
+        preloadedModules.clear();
+        purge();
     }
 
-    //==============================================================================
-    bool open (const File& f, const PluginDescription& description)
+private:
+    VST3ModuleCache() = default;
+
+    void purge()
     {
-        dllHandle.reset (new DLLHandle (f.getFullPathName()));
+        // Modules hold references to their libraries, so these have to be done in this order
+        for (int i = modules.size(); --i >= 0;)
+            if (modules.getObjectPointerUnchecked (i)->getReferenceCount() == 1)
+                modules.remove (i);
 
-        ComSmartPtr<IPluginFactory> pluginFactory (dllHandle->getPluginFactory());
+        for (int i = libraries.size(); --i >= 0;)
+            if (libraries.getObjectPointerUnchecked (i)->getReferenceCount() == 1)
+                libraries.remove (i);
+    }
 
-        if (pluginFactory != nullptr)
-        {
-            ComSmartPtr<VST3HostContext> host (new VST3HostContext());
-            MatchingDescriptionFinder finder (host, pluginFactory, description);
+    ReferenceCountedArray<VST3ModuleHandle> modules, preloadedModules;
+    ReferenceCountedArray<DLLHandle> libraries;
+    CriticalSection lock;
 
-            auto result = finder.findDescriptionsAndPerform (f);
+    JUCE_DECLARE_NON_COPYABLE (VST3ModuleCache)
+};
 
-            if (result.getErrorMessage() == MatchingDescriptionFinder::getSuccessString())
-            {
-                name = description.name;
-                return true;
-            }
-        }
+bool VST3ModuleHandle::getAllDescriptionsForFile (OwnedArray<PluginDescription>& results,
+                                                  const String& fileOrIdentifier)
+{
+    auto& cache = VST3ModuleCache::getInstance();
+    auto library = cache.findOrOpenLibrary (fileOrIdentifier);
+    bool succeeded = false;
 
-        return false;
+    if (library != nullptr)
+    {
+        ComSmartPtr<IPluginFactory> pluginFactory (library->getPluginFactory());
+        ComSmartPtr<VST3HostContext> host (new VST3HostContext());
+        DescriptionLister lister (host, pluginFactory);
+        auto result = lister.findDescriptionsAndPerform (File (fileOrIdentifier));
+
+        results.addCopiesOf (lister.list);
+        succeeded = result.wasOk();
+    }
+    else
+    {
+        jassertfalse;
     }
 
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VST3ModuleHandle)
-};
+    cache.release (library);
+    return succeeded;
+}
+
+VST3ModuleHandle::Ptr VST3ModuleHandle::findOrCreateModule (const File& file, const PluginDescription& description)
+{
+    return VST3ModuleCache::getInstance().findOrCreateModule (file, description);
+}
+
+void VST3ModuleHandle::release (Ptr& module)
+{
+    VST3ModuleCache::getInstance().release (module);
+}
 
 //==============================================================================
 struct VST3PluginWindow : public AudioProcessorEditor,
@@ -1419,7 +1519,7 @@ struct VST3ComponentHolder
         component = nullptr;
         host = nullptr;
         factory = nullptr;
-        module = nullptr;
+        VST3ModuleHandle::release (module);
     }
 
     // transfers ownership to the plugin instance!
@@ -1465,7 +1565,7 @@ struct VST3ComponentHolder
         PFactoryInfo factoryInfo;
         factory->getFactoryInfo (&factoryInfo);
 
-        auto classIdx = getClassIndex (module->name);
+        auto classIdx = module->classIndex;
 
         if (classIdx >= 0)
         {
@@ -1540,8 +1640,9 @@ struct VST3ComponentHolder
 
         factory = ComSmartPtr<IPluginFactory> (module->getPluginFactory());
 
-        int classIdx;
-        if ((classIdx = getClassIndex (module->name)) < 0)
+        auto classIdx = module->classIndex;
+
+        if (classIdx < 0)
             return false;
 
         PClassInfo info;
@@ -1569,21 +1670,6 @@ struct VST3ComponentHolder
         isComponentInitialised = false;
     }
 
-    //==============================================================================
-    int getClassIndex (const String& className) const
-    {
-        PClassInfo info;
-        const Steinberg::int32 numClasses = factory->countClasses();
-
-        for (Steinberg::int32 j = 0; j < numClasses; ++j)
-            if (factory->getClassInfo (j, &info) == kResultOk
-                 && std::strcmp (info.category, kVstAudioEffectClass) == 0
-                 && toString (info.name).trim() == className)
-                return j;
-
-        return -1;
-    }
-
     //==============================================================================
     VST3ModuleHandle::Ptr module;
     ComSmartPtr<IPluginFactory> factory;
@@ -3079,6 +3165,19 @@ int VST3HostContext::getIndexOfParamID (Vst::ParamID paramID)
 VST3PluginFormat::VST3PluginFormat() {}
 VST3PluginFormat::~VST3PluginFormat() {}
 
+bool VST3PluginFormat::preloadModule (const PluginDescription& description)
+{
+    if (! fileMightContainThisPluginType (description.fileOrIdentifier))
+        return false;
+
+    return VST3ModuleCache::getInstance().preload (File (description.fileOrIdentifier), description);
+}
+
+void VST3PluginFormat::releasePreloadedModules()
+{
+    VST3ModuleCache::getInstance().releasePreloadedModules();
+}
+
 bool VST3PluginFormat::setStateFromVSTPresetFile (AudioPluginInstance* api, const MemoryBlock& rawData)
 {
     if (auto vst3 = dynamic_cast<VST3PluginInstance*> (api))
@@ -3105,7 +3204,9 @@ void VST3PluginFormat::createPluginInstance (const PluginDescription& descriptio
         auto previousWorkingDirectory = File::getCurrentWorkingDirectory();
         file.getParentDirectory().setAsCurrentWorkingDirectory();
 
-        if (const VST3ModuleHandle::Ptr module = VST3ModuleHandle::findOrCreateModule (file, description))
+        auto module = VST3ModuleHandle::findOrCreateModule (file, description);
+
+        if (module != nullptr)
         {
             std::unique_ptr<VST3ComponentHolder> holder (new VST3ComponentHolder (module));
 
@@ -3118,6 +3219,8 @@ void VST3PluginFormat::createPluginInstance (const PluginDescription& descriptio
             }
         }
 
+        VST3ModuleHandle::release (module);
+
         previousWorkingDirectory.setAsCurrentWorkingDirectory();
     }
 
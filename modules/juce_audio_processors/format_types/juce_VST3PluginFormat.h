@@ -50,6 +50,27 @@ public:
     */
     static bool setStateFromVSTPresetFile (AudioPluginInstance*, const MemoryBlock&);
 
+    //==============================================================================
+    /** Loads the module containing a plugin, ready for instances of it to be created.
+
+        The component of a VST3 has to be created and initialised on the message thread,
+        but loading its library and finding its class in the factory doesn't, so calling
+        this from a background thread for each plugin that's about to be instantiated
+        (e.g. while loading a session) leaves only the work that the SDK requires on the
+        message thread. Instances of the same plugin always share one loaded module.
+
+        This can be called from any thread. The modules stay loaded until
+        releasePreloadedModules() is called, even if no instances are using them.
+
+        Returns false if the plugin's module couldn't be loaded.
+    */
+    static bool preloadModule (const PluginDescription&);
+
+    /** Lets go of any modules loaded by preloadModule().
+        Modules that are still being used by plugin instances will stay loaded.
+    */
+    static void releasePreloadedModules();
+
     //==============================================================================
     String getName() const override             { return "VST3"; }
     void findAllTypesForFile (OwnedArray<PluginDescription>&, const String& fileOrIdentifier) override;
@@ -56,14 +56,29 @@ public:
     void clear()
     {
         numEventsUsed = 0;
+        numSysexBytesUsed = 0;
 
         if (events != nullptr)
             events->numEvents = 0;
     }
 
-    void addEvent (const void* const midiData, const int numBytes, const int frameOffset)
+    /** Adds an event, as long as there's room for it.
+
+        This never allocates: the list only holds as many events (and bytes of
+        sysex data) as ensureSize() has reserved, so that it's safe to use on the
+        audio thread. Anything that doesn't fit is dropped, counted by
+        getNumDroppedEvents(), and false is returned.
+    */
+    bool addEvent (const void* const midiData, const int numBytes, const int frameOffset)
     {
-        ensureSize (numEventsUsed + 1);
+        if (numEventsUsed >= numEventsAllocated
+             || (numBytes > 4 && (size_t) numBytes > numSysexBytesAllocated - numSysexBytesUsed))
+        {
+            // If you hit this, the list needs a bigger capacity passed to ensureSize().
+            jassertfalse;
+            ++numEventsDropped;
+            return false;
+        }
 
         Vst2::VstMidiEvent* const e = (Vst2::VstMidiEvent*) (events->events [numEventsUsed]);
         events->numEvents = ++numEventsUsed;
@@ -72,7 +87,6 @@ public:
         {
             if (e->type == Vst2::kVstSysExType)
             {
-                delete[] (((Vst2::VstMidiSysexEvent*) e)->sysexDump);
                 e->type = Vst2::kVstMidiType;
                 e->byteSize = sizeof (Vst2::VstMidiEvent);
                 e->noteLength = 0;
@@ -88,11 +102,9 @@ public:
         {
             Vst2::VstMidiSysexEvent* const se = (Vst2::VstMidiSysexEvent*) e;
 
-            if (se->type == Vst2::kVstSysExType)
-                delete[] se->sysexDump;
-
-            se->sysexDump = new char [(size_t) numBytes];
+            se->sysexDump = sysexData + numSysexBytesUsed;
             memcpy (se->sysexDump, midiData, (size_t) numBytes);
+            numSysexBytesUsed += (size_t) numBytes;
 
             se->type = Vst2::kVstSysExType;
             se->byteSize = sizeof (Vst2::VstMidiSysexEvent);
@@ -102,13 +114,38 @@ public:
             se->resvd1 = 0;
             se->resvd2 = 0;
         }
+
+        return true;
     }
 
+    /** Returns the number of events that addEvent() has had to drop because the
+        list was full.
+    */
+    int getNumDroppedEvents() const noexcept    { return numEventsDropped; }
+
     //==============================================================================
     // Handy method to pull the events out of an event buffer supplied by the host
     // or plugin.
     static void addEventsToMidiBuffer (const Vst2::VstEvents* events, MidiBuffer& dest)
     {
+        // Reserve the space for the whole lot first, so that the buffer doesn't have
+        // to keep growing as each event is appended. Hosts send their events in time
+        // order, which the MidiBuffer can append without searching.
+        size_t numBytesNeeded = 0;
+
+        for (int i = 0; i < events->numEvents; ++i)
+        {
+            if (auto* e = events->events[i])
+            {
+                if (e->type == Vst2::kVstMidiType)
+                    numBytesNeeded += 4 + sizeof (int32) + sizeof (uint16);
+                else if (e->type == Vst2::kVstSysExType)
+                    numBytesNeeded += (size_t) ((const Vst2::VstMidiSysexEvent*) e)->dumpBytes + sizeof (int32) + sizeof (uint16);
+            }
+        }
+
+        dest.ensureSize ((size_t) dest.data.size() + numBytesNeeded);
+
         for (int i = 0; i < events->numEvents; ++i)
         {
             const Vst2::VstEvent* const e = events->events[i];
@@ -131,7 +168,11 @@ public:
     }
 
     //==============================================================================
-    void ensureSize (int numEventsNeeded)
+    /** Reserves space for the given number of events, and for the sysex data that
+        they might carry. This allocates, so call it before processing starts, and
+        only while the list is empty.
+    */
+    void ensureSize (int numEventsNeeded, size_t numSysexBytesNeeded = defaultSysexCapacity)
     {
         if (numEventsNeeded > numEventsAllocated)
         {
@@ -149,6 +190,13 @@ public:
 
             numEventsAllocated = numEventsNeeded;
         }
+
+        if (numSysexBytesNeeded > numSysexBytesAllocated)
+        {
+            jassert (numSysexBytesUsed == 0);
+            sysexData.realloc (numSysexBytesNeeded);
+            numSysexBytesAllocated = numSysexBytesNeeded;
+        }
     }
 
     void freeEvents()
@@ -162,13 +210,22 @@ public:
             numEventsUsed = 0;
             numEventsAllocated = 0;
         }
+
+        sysexData.free();
+        numSysexBytesUsed = 0;
+        numSysexBytesAllocated = 0;
     }
 
     //==============================================================================
     HeapBlock<Vst2::VstEvents> events;
 
 private:
+    enum { defaultSysexCapacity = 16384 };
+
     int numEventsUsed, numEventsAllocated;
+    int numEventsDropped = 0;
+    HeapBlock<char> sysexData;
+    size_t numSysexBytesUsed = 0, numSysexBytesAllocated = 0;
 
     static Vst2::VstEvent* allocateVSTEvent()
     {
@@ -181,9 +238,7 @@ private:
 
     static void freeVSTEvent (Vst2::VstEvent* e)
     {
-        if (e->type == Vst2::kVstSysExType)
-            delete[] (((Vst2::VstMidiSysexEvent*) e)->sysexDump);
-
+        // Any sysex data lives in the list's shared block, not in the event itself.
         std::free (e);
     }
 };
@@ -1349,7 +1349,7 @@ struct VSTPluginInstance     : public AudioPluginInstance,
             wantsMidiMessages = wantsMidiMessages || (pluginCanDo ("receiveVstMidiEvent") > 0);
 
             if (wantsMidiMessages)
-                midiEventsToSend.ensureSize (256);
+                midiEventsToSend.ensureSize (2048);
             else
                 midiEventsToSend.freeEvents();
 
@@ -2388,7 +2388,6 @@ private:
             if (wantsMidiMessages)
             {
                 midiEventsToSend.clear();
-                midiEventsToSend.ensureSize (1);
 
                 MidiBuffer::Iterator iter (midiMessages);
                 const uint8* midiData;
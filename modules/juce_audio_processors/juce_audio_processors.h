@@ -108,6 +108,7 @@
 //==============================================================================
 #include "processors/juce_AudioProcessorEditor.h"
 #include "processors/juce_AudioProcessorListener.h"
+#include "processors/juce_LockFreeListenerArray.h"
 #include "processors/juce_AudioProcessorParameter.h"
 #include "processors/juce_AudioProcessorParameterGroup.h"
 #include "processors/juce_AudioProcessor.h"
@@ -117,7 +118,10 @@
 #include "processors/juce_GenericAudioProcessorEditor.h"
 #include "format/juce_AudioPluginFormat.h"
 #include "format/juce_AudioPluginFormatManager.h"
+#include "format/juce_BackgroundPluginLoader.h"
 #include "scanning/juce_KnownPluginList.h"
+#include "scanning/juce_PluginScanCache.h"
+#include "scanning/juce_OutOfProcessPluginScanner.h"
 #include "format_types/juce_AudioUnitPluginFormat.h"
 #include "format_types/juce_LADSPAPluginFormat.h"
 #include "format_types/juce_VSTMidiEventList.h"
@@ -331,14 +331,12 @@ void AudioProcessor::setPlayHead (AudioPlayHead* newPlayHead)
 
 void AudioProcessor::addListener (AudioProcessorListener* newListener)
 {
-    const ScopedLock sl (listenerLock);
-    listeners.addIfNotAlreadyThere (newListener);
+    listeners.add (newListener);
 }
 
 void AudioProcessor::removeListener (AudioProcessorListener* listenerToRemove)
 {
-    const ScopedLock sl (listenerLock);
-    listeners.removeFirstMatchingValue (listenerToRemove);
+    listeners.remove (listenerToRemove);
 }
 
 void AudioProcessor::setPlayConfigDetails (int newNumIns, int newNumOuts, double newSampleRate, int newBlockSize)
@@ -454,9 +452,7 @@ void AudioProcessor::sendParamChangeMessageToListeners (int parameterIndex, floa
     {
         if (isPositiveAndBelow (parameterIndex, getNumParameters()))
         {
-            for (int i = listeners.size(); --i >= 0;)
-                if (auto* l = getListenerLocked (i))
-                    l->audioProcessorParameterChanged (this, parameterIndex, newValue);
+            listeners.call ([&] (AudioProcessorListener& l) { l.audioProcessorParameterChanged (this, parameterIndex, newValue); });
         }
         else
         {
@@ -482,9 +478,7 @@ void AudioProcessor::beginParameterChangeGesture (int parameterIndex)
             changingParams.setBit (parameterIndex);
            #endif
 
-            for (int i = listeners.size(); --i >= 0;)
-                if (auto* l = getListenerLocked (i))
-                    l->audioProcessorParameterChangeGestureBegin (this, parameterIndex);
+            listeners.call ([&] (AudioProcessorListener& l) { l.audioProcessorParameterChangeGestureBegin (this, parameterIndex); });
         }
         else
         {
@@ -511,9 +505,7 @@ void AudioProcessor::endParameterChangeGesture (int parameterIndex)
             changingParams.clearBit (parameterIndex);
            #endif
 
-            for (int i = listeners.size(); --i >= 0;)
-                if (auto* l = getListenerLocked (i))
-                    l->audioProcessorParameterChangeGestureEnd (this, parameterIndex);
+            listeners.call ([&] (AudioProcessorListener& l) { l.audioProcessorParameterChangeGestureEnd (this, parameterIndex); });
         }
         else
         {
@@ -562,17 +554,9 @@ String AudioProcessor::getParameterText (int index, int maximumStringLength)
 #endif
 
 //==============================================================================
-AudioProcessorListener* AudioProcessor::getListenerLocked (int index) const noexcept
-{
-    const ScopedLock sl (listenerLock);
-    return listeners[index];
-}
-
 void AudioProcessor::updateHostDisplay()
 {
-    for (int i = listeners.size(); --i >= 0;)
-        if (auto* l = getListenerLocked (i))
-            l->audioProcessorChanged (this);
+    listeners.call ([this] (AudioProcessorListener& l) { l.audioProcessorChanged (this); });
 }
 
 const OwnedArray<AudioProcessorParameter>& AudioProcessor::getParameters() const noexcept
@@ -1451,19 +1435,13 @@ void AudioProcessorParameter::beginChangeGesture()
     isPerformingGesture = true;
    #endif
 
-    ScopedLock lock (listenerLock);
-
-    for (int i = listeners.size(); --i >= 0;)
-        if (auto* l = listeners[i])
-            l->parameterGestureChanged (getParameterIndex(), true);
+    listeners.call ([this] (Listener& l) { l.parameterGestureChanged (getParameterIndex(), true); });
 
     if (processor != nullptr && parameterIndex >= 0)
     {
         // audioProcessorParameterChangeGestureBegin callbacks will shortly be deprecated and
         // this code will be removed.
-        for (int i = processor->listeners.size(); --i >= 0;)
-            if (auto* l = processor->listeners[i])
-                l->audioProcessorParameterChangeGestureBegin (processor, getParameterIndex());
+        processor->listeners.call ([this] (AudioProcessorListener& l) { l.audioProcessorParameterChangeGestureBegin (processor, getParameterIndex()); });
     }
 }
 
@@ -1480,37 +1458,25 @@ void AudioProcessorParameter::endChangeGesture()
     isPerformingGesture = false;
    #endif
 
-    ScopedLock lock (listenerLock);
-
-    for (int i = listeners.size(); --i >= 0;)
-        if (auto* l = listeners[i])
-            l->parameterGestureChanged (getParameterIndex(), false);
+    listeners.call ([this] (Listener& l) { l.parameterGestureChanged (getParameterIndex(), false); });
 
     if (processor != nullptr && parameterIndex >= 0)
     {
         // audioProcessorParameterChangeGestureEnd callbacks will shortly be deprecated and
         // this code will be removed.
-        for (int i = processor->listeners.size(); --i >= 0;)
-            if (auto* l = processor->listeners[i])
-                l->audioProcessorParameterChangeGestureEnd (processor, getParameterIndex());
+        processor->listeners.call ([this] (AudioProcessorListener& l) { l.audioProcessorParameterChangeGestureEnd (processor, getParameterIndex()); });
     }
 }
 
 void AudioProcessorParameter::sendValueChangedMessageToListeners (float newValue)
 {
-    ScopedLock lock (listenerLock);
-
-    for (int i = listeners.size(); --i >= 0;)
-        if (auto* l = listeners [i])
-            l->parameterValueChanged (getParameterIndex(), newValue);
+    listeners.call ([&] (Listener& l) { l.parameterValueChanged (getParameterIndex(), newValue); });
 
     if (processor != nullptr && parameterIndex >= 0)
     {
         // audioProcessorParameterChanged callbacks will shortly be deprecated and
         // this code will be removed.
-        for (int i = processor->listeners.size(); --i >= 0;)
-            if (auto* l = processor->listeners[i])
-                l->audioProcessorParameterChanged (processor, getParameterIndex(), newValue);
+        processor->listeners.call ([&] (AudioProcessorListener& l) { l.audioProcessorParameterChanged (processor, getParameterIndex(), newValue); });
     }
 }
 
@@ -1547,14 +1513,12 @@ StringArray AudioProcessorParameter::getAllValueStrings() const
 
 void AudioProcessorParameter::addListener (AudioProcessorParameter::Listener* newListener)
 {
-    const ScopedLock sl (listenerLock);
-    listeners.addIfNotAlreadyThere (newListener);
+    listeners.add (newListener);
 }
 
 void AudioProcessorParameter::removeListener (AudioProcessorParameter::Listener* listenerToRemove)
 {
-    const ScopedLock sl (listenerLock);
-    listeners.removeFirstMatchingValue (listenerToRemove);
+    listeners.remove (listenerToRemove);
 }
 
 //==============================================================================
@@ -823,6 +823,32 @@ public:
     */
     void setLatencySamples (int newLatency);
 
+    //==============================================================================
+    /** Your processor subclass can call this to have the host's sample-accurate parameter
+        automation applied within each block, instead of only at its start.
+
+        When the plugin format supports it (currently VST3), the wrapper then splits each
+        block at the positions where automated parameters change, sets the new values and
+        calls processBlock() for each part in turn, along with the MIDI events falling in
+        that part. Apart from when the host's block is itself shorter, no part will be
+        shorter than minimumNumSamples: a change falling closer than that to the start of a
+        part is applied at the start of that part instead.
+
+        A value of 0, the default, turns the splitting off.
+    */
+    void setMinimumAutomationSubBlockSize (int minimumNumSamples) noexcept
+    {
+        jassert (minimumNumSamples >= 0);
+        minimumAutomationSubBlockSize = jmax (0, minimumNumSamples);
+    }
+
+    /** Returns the minimum size of the parts blocks are split into to follow the automation,
+        or 0 if they aren't split.
+
+        @see setMinimumAutomationSubBlockSize
+    */
+    int getMinimumAutomationSubBlockSize() const noexcept       { return minimumAutomationSubBlockSize; }
+
     /** Returns the length of the processor's tail, in seconds. */
     virtual double getTailLengthSeconds() const = 0;
 
@@ -1647,13 +1673,13 @@ private:
     void createBus (bool isInput, const BusProperties&);
 
     //==============================================================================
-    Array<AudioProcessorListener*> listeners;
+    LockFreeListenerArray<AudioProcessorListener> listeners;
     Component::SafePointer<AudioProcessorEditor> activeEditor;
     double currentSampleRate = 0;
-    int blockSize = 0, latencySamples = 0;
+    int blockSize = 0, latencySamples = 0, minimumAutomationSubBlockSize = 0;
     bool suspended = false, nonRealtime = false;
     ProcessingPrecision processingPrecision = singlePrecision;
-    CriticalSection callbackLock, listenerLock;
+    CriticalSection callbackLock;
 
     friend class Bus;
     mutable OwnedArray<Bus> inputBuses, outputBuses;
@@ -1676,7 +1702,6 @@ private:
     void checkForDupedParamIDs();
    #endif
 
-    AudioProcessorListener* getListenerLocked (int) const noexcept;
     void updateSpeakerFormatStrings();
     bool applyBusLayouts (const BusesLayout&);
     void audioIOChanged (bool busNumberChanged, bool channelNumChanged);
@@ -27,8 +27,102 @@
 namespace juce
 {
 
+//==============================================================================
+/*  A set of real-time worker threads that help the audio thread to get through
+    the independent parts of a render sequence.
+*/
+struct GraphRenderThreadPool
+{
+    struct Job
+    {
+        virtual ~Job() {}
+
+        /** Called on the audio thread and on each worker. Must only return once
+            there is no more work left to do for the current block. */
+        virtual void runAvailableTasks() = 0;
+    };
+
+    GraphRenderThreadPool (int numThreads)
+    {
+        for (int i = 0; i < numThreads; ++i)
+            workers.add (new Worker (*this, i));
+
+        for (auto* w : workers)
+            w->startRealtimeThread (Thread::RealtimeOptions());
+    }
+
+    ~GraphRenderThreadPool()
+    {
+        for (auto* w : workers)
+        {
+            w->signalThreadShouldExit();
+            w->wakeUp.signal();
+        }
+
+        for (auto* w : workers)
+            w->stopThread (2000);
+    }
+
+    int getNumThreads() const noexcept      { return workers.size(); }
+
+    /** Runs a job on the calling thread and all the workers, returning once it has finished. */
+    void run (Job& job)
+    {
+        currentJob = &job;
+        jobIsActive = true;
+
+        for (auto* w : workers)
+            w->wakeUp.signal();
+
+        job.runAvailableTasks();
+        jobIsActive = false;
+
+        // make sure no worker is still looking at this job before letting the caller continue
+        while (numActiveWorkers.load() > 0)
+            Thread::yield();
+    }
+
+private:
+    struct Worker  : public Thread
+    {
+        Worker (GraphRenderThreadPool& p, int index)
+            : Thread ("Graph render thread " + String (index + 1)), owner (p)
+        {
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wakeUp.wait (-1);
+
+                ++owner.numActiveWorkers;
+
+                if (owner.jobIsActive.load() && ! threadShouldExit())
+                    if (auto* job = owner.currentJob.load())
+                        job->runAvailableTasks();
+
+                --owner.numActiveWorkers;
+            }
+        }
+
+        GraphRenderThreadPool& owner;
+        WaitableEvent wakeUp;
+
+        JUCE_DECLARE_NON_COPYABLE (Worker)
+    };
+
+    OwnedArray<Worker> workers;
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<bool> jobIsActive { false };
+    std::atomic<int> numActiveWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (GraphRenderThreadPool)
+};
+
+//==============================================================================
 template <typename FloatType>
-struct GraphRenderSequence
+struct GraphRenderSequence  : private GraphRenderThreadPool::Job
 {
     GraphRenderSequence() {}
 
@@ -40,7 +134,8 @@ struct GraphRenderSequence
         int numSamples;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead,
+                  GraphRenderThreadPool* threadPool)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
@@ -54,14 +149,15 @@ struct GraphRenderSequence
             {
                 AudioBuffer<FloatType> startAudio (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), maxSamples);
                 midiMessages.clear (maxSamples, numSamples);
-                perform (startAudio, midiMessages, audioPlayHead);
+                perform (startAudio, midiMessages, audioPlayHead, threadPool);
             }
 
             AudioBuffer<FloatType> endAudio (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), maxSamples, numSamples - maxSamples);
-            perform (endAudio, tempMIDI, audioPlayHead);
+            perform (endAudio, tempMIDI, audioPlayHead, threadPool);
             return;
         }
 
+        JUCE_TRACE_SCOPE ("AudioProcessorGraph::render");
         currentAudioInputBuffer = &buffer;
         currentAudioOutputBuffer.setSize (jmax (1, buffer.getNumChannels()), numSamples);
         currentAudioOutputBuffer.clear();
@@ -71,8 +167,15 @@ struct GraphRenderSequence
         {
             const Context context { renderingBuffer.getArrayOfWritePointers(), midiBuffers.begin(), audioPlayHead, numSamples };
 
-            for (auto* op : renderOps)
-                op->perform (context);
+            if (threadPool != nullptr && threadPool->getNumThreads() > 0 && tasks.size() > 1)
+            {
+                performInParallel (context, *threadPool);
+            }
+            else
+            {
+                for (auto* op : renderOps)
+                    op->perform (context);
+            }
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -86,6 +189,7 @@ struct GraphRenderSequence
     void addClearChannelOp (int index)
     {
         createOp ([=] (const Context& c)    { FloatVectorOperations::clear (c.audioBuffers[index], c.numSamples); });
+        addWrite (audioResource (index));
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -93,6 +197,8 @@ struct GraphRenderSequence
         createOp ([=] (const Context& c)    { FloatVectorOperations::copy (c.audioBuffers[dstIndex],
                                                                            c.audioBuffers[srcIndex],
                                                                            c.numSamples); });
+        addRead  (audioResource (srcIndex));
+        addWrite (audioResource (dstIndex));
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -100,37 +206,126 @@ struct GraphRenderSequence
         createOp ([=] (const Context& c)    { FloatVectorOperations::add (c.audioBuffers[dstIndex],
                                                                           c.audioBuffers[srcIndex],
                                                                           c.numSamples); });
+        addRead  (audioResource (srcIndex));
+        addWrite (audioResource (dstIndex));
     }
 
     void addClearMidiBufferOp (int index)
     {
         createOp ([=] (const Context& c)    { c.midiBuffers[index].clear(); });
+        addWrite (midiResource (index));
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
     {
         createOp ([=] (const Context& c)    { c.midiBuffers[dstIndex] = c.midiBuffers[srcIndex]; });
+        addRead  (midiResource (srcIndex));
+        addWrite (midiResource (dstIndex));
     }
 
-    void addAddMidiBufferOp (int srcIndex, int dstIndex)
+    void addMergeMidiBuffersOp (const Array<int>& srcIndexes, int dstIndex)
     {
-        createOp ([=] (const Context& c)    { c.midiBuffers[dstIndex].addEvents (c.midiBuffers[srcIndex],
-                                                                                 0, c.numSamples, 0); });
+        renderOps.add (new MergeMidiBuffersOp (srcIndexes, dstIndex));
+
+        for (auto srcIndex : srcIndexes)
+            addRead (midiResource (srcIndex));
+
+        addWrite (midiResource (dstIndex));
     }
 
     void addDelayChannelOp (int chan, int delaySize)
     {
         renderOps.add (new DelayChannelOp (chan, delaySize));
+        addWrite (audioResource (chan));
     }
 
     void addProcessOp (const AudioProcessorGraph::Node::Ptr& node,
-                       const Array<int>& audioChannelsUsed, int totalNumChans, int midiBuffer)
+                       const Array<int>& audioChannelsUsed, int totalNumChans, int midiBuffer,
+                       bool measureTiming)
     {
-        renderOps.add (new ProcessOp (node, audioChannelsUsed, totalNumChans, midiBuffer));
+        if (measureTiming)
+            node->prepareTimingHistory();
+
+        renderOps.add (new ProcessOp (node, audioChannelsUsed, totalNumChans, midiBuffer, measureTiming));
+
+        // The first buffer is the shared read-only block of zeros, so reading it can't conflict with anything
+        for (auto index : audioChannelsUsed)
+        {
+            if (index == 0)
+                addRead (audioResource (index));
+            else
+                addWrite (audioResource (index));
+        }
+
+        // A negative index means the node doesn't use MIDI, and gets a private buffer
+        if (midiBuffer >= 0)
+        {
+            if (onlyReadsMidi (*node->getProcessor()))
+                addRead (midiResource (midiBuffer));
+            else
+                addWrite (midiResource (midiBuffer));
+        }
+
+        // I/O nodes all touch the sequence's own input and output buffers
+        if (dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()) != nullptr)
+            addWrite (graphIOResource);
+
+        endCurrentTask();
     }
 
-    void prepareBuffers (int blockSize)
+    /** Works out which of the tasks have to wait for each other, so that they can be
+        performed in parallel without changing the result of the serial rendering order.
+    */
+    void createTaskDependencies()
     {
+        endCurrentTask();
+
+        struct ResourceState
+        {
+            int lastWriter = -1;
+            Array<int> readersSinceLastWrite;
+        };
+
+        std::map<int, ResourceState> resources;
+
+        auto addDependency = [this] (int from, int to)
+        {
+            if (from >= 0 && from != to && tasks.getUnchecked (from)->dependents.addIfNotAlreadyThere (to))
+                ++(tasks.getUnchecked (to)->numDependencies);
+        };
+
+        for (int i = 0; i < tasks.size(); ++i)
+        {
+            auto& task = *tasks.getUnchecked (i);
+
+            for (auto r : task.reads)
+                addDependency (resources[r].lastWriter, i);
+
+            for (auto w : task.writes)
+            {
+                auto& state = resources[w];
+                addDependency (state.lastWriter, i);
+
+                for (auto reader : state.readersSinceLastWrite)
+                    addDependency (reader, i);
+
+                state.lastWriter = i;
+                state.readersSinceLastWrite.clearQuick();
+            }
+
+            for (auto r : task.reads)
+                if (! task.writes.contains (r))
+                    resources[r].readersSinceLastWrite.add (i);
+        }
+
+        readyQueue.calloc ((size_t) jmax (1, tasks.size()));
+    }
+
+    void prepareBuffers (int blockSize, AudioProcessor::ProcessingPrecision graphPrecision)
+    {
+        for (auto* op : renderOps)
+            op->prepareBuffers (blockSize, graphPrecision);
+
         renderingBuffer.setSize (numBuffersNeeded + 1, blockSize);
         renderingBuffer.clear();
         currentAudioOutputBuffer.setSize (numBuffersNeeded + 1, blockSize);
@@ -161,6 +356,15 @@ struct GraphRenderSequence
         midiBuffers.clear();
     }
 
+    /** The graph's MIDI output node only copies from the buffer it's given, so it can
+        safely share a buffer that other nodes still need.
+    */
+    static bool onlyReadsMidi (AudioProcessor& processor)
+    {
+        auto* io = dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (&processor);
+        return io != nullptr && io->getType() == AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode;
+    }
+
     int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
 
     AudioBuffer<FloatType> renderingBuffer, currentAudioOutputBuffer;
@@ -179,12 +383,131 @@ private:
         RenderingOp() noexcept {}
         virtual ~RenderingOp() {}
         virtual void perform (const Context&) = 0;
+        virtual void prepareBuffers (int /*blockSize*/, AudioProcessor::ProcessingPrecision) {}
 
         JUCE_LEAK_DETECTOR (RenderingOp)
     };
 
     OwnedArray<RenderingOp> renderOps;
 
+    //==============================================================================
+    /*  A run of consecutive ops (a node's input-preparation ops followed by its ProcessOp),
+        which is the unit of work that gets handed to the render threads.
+    */
+    struct RenderTask
+    {
+        int firstOp = 0, numOps = 0;
+        Array<int> reads, writes, dependents;
+        int numDependencies = 0;
+        std::atomic<int> numPendingDependencies { 0 };
+    };
+
+    OwnedArray<RenderTask> tasks;
+    Array<int> currentTaskReads, currentTaskWrites;
+    int currentTaskStart = 0;
+
+    // Each audio channel, midi buffer and the graph's I/O buffers get a unique resource number
+    static int audioResource (int index) noexcept   { return index * 2; }
+    static int midiResource (int index) noexcept    { return index * 2 + 1; }
+    enum { graphIOResource = -1 };
+
+    void addRead (int resource)     { currentTaskReads.addIfNotAlreadyThere (resource); }
+    void addWrite (int resource)    { currentTaskWrites.addIfNotAlreadyThere (resource); }
+
+    void endCurrentTask()
+    {
+        if (currentTaskStart < renderOps.size())
+        {
+            auto* task = tasks.add (new RenderTask());
+            task->firstOp = currentTaskStart;
+            task->numOps = renderOps.size() - currentTaskStart;
+            task->reads.swapWith (currentTaskReads);
+            task->writes.swapWith (currentTaskWrites);
+            currentTaskStart = renderOps.size();
+        }
+
+        currentTaskReads.clearQuick();
+        currentTaskWrites.clearQuick();
+    }
+
+    //==============================================================================
+    // A queue to which each task gets pushed exactly once per block, so it never needs to wrap
+    HeapBlock<std::atomic<int>> readyQueue;
+    std::atomic<int> readyQueueWritePos { 0 }, readyQueueReadPos { 0 }, numTasksRemaining { 0 };
+    const Context* currentContext = nullptr;
+
+    void pushReadyTask (int taskIndex) noexcept
+    {
+        readyQueue[readyQueueWritePos++].store (taskIndex + 1, std::memory_order_release);
+    }
+
+    int popReadyTask() noexcept
+    {
+        for (;;)
+        {
+            auto pos = readyQueueReadPos.load();
+
+            if (pos >= tasks.size())
+                return -1;
+
+            auto value = readyQueue[pos].load (std::memory_order_acquire);
+
+            if (value == 0)
+                return -1;
+
+            if (readyQueueReadPos.compare_exchange_weak (pos, pos + 1))
+                return value - 1;
+        }
+    }
+
+    void performInParallel (const Context& context, GraphRenderThreadPool& threadPool)
+    {
+        currentContext = &context;
+
+        for (int i = 0; i < tasks.size(); ++i)
+        {
+            readyQueue[i].store (0, std::memory_order_relaxed);
+            tasks.getUnchecked (i)->numPendingDependencies.store (tasks.getUnchecked (i)->numDependencies,
+                                                                  std::memory_order_relaxed);
+        }
+
+        readyQueueWritePos = 0;
+        readyQueueReadPos = 0;
+        numTasksRemaining = tasks.size();
+
+        for (int i = 0; i < tasks.size(); ++i)
+            if (tasks.getUnchecked (i)->numDependencies == 0)
+                pushReadyTask (i);
+
+        threadPool.run (*this);
+        currentContext = nullptr;
+    }
+
+    void runAvailableTasks() override
+    {
+        while (numTasksRemaining.load() > 0)
+        {
+            auto taskIndex = popReadyTask();
+
+            if (taskIndex < 0)
+            {
+                Thread::yield();
+                continue;
+            }
+
+            auto& task = *tasks.getUnchecked (taskIndex);
+
+            for (int i = 0; i < task.numOps; ++i)
+                renderOps.getUnchecked (task.firstOp + i)->perform (*currentContext);
+
+            for (auto dependent : task.dependents)
+                if (--(tasks.getUnchecked (dependent)->numPendingDependencies) == 0)
+                    pushReadyTask (dependent);
+
+            --numTasksRemaining;
+        }
+    }
+
     //==============================================================================
     template <typename LambdaType>
     void createOp (LambdaType&& fn)
@@ -232,19 +555,88 @@ private:
         JUCE_DECLARE_NON_COPYABLE (DelayChannelOp)
     };
 
+    //==============================================================================
+    /*  Merges any number of MIDI buffers in a single pass, rather than merging
+        them into the destination one at a time. The destination may also be one of
+        the sources.
+    */
+    struct MergeMidiBuffersOp   : public RenderingOp
+    {
+        MergeMidiBuffersOp (const Array<int>& sources, int dest)
+            : sourceIndexes (sources), destIndex (dest)
+        {
+            cursors.reserve ((size_t) sourceIndexes.size());
+        }
+
+        void perform (const Context& c) override
+        {
+            merged.clear();
+            cursors.clear();
+
+            for (auto index : sourceIndexes)
+            {
+                cursors.emplace_back (c.midiBuffers[index]);
+                cursors.back().advance();
+            }
+
+            for (;;)
+            {
+                Cursor* next = nullptr;
+
+                // on equal timestamps the earlier source wins, so events keep a stable order
+                for (auto& cursor : cursors)
+                    if (cursor.hasEvent && (next == nullptr || cursor.time < next->time))
+                        next = &cursor;
+
+                if (next == nullptr)
+                    break;
+
+                merged.addEvent (next->data, next->numBytes, next->time);
+                next->advance();
+            }
+
+            c.midiBuffers[destIndex].swapWith (merged);
+        }
+
+        void prepareBuffers (int, AudioProcessor::ProcessingPrecision) override
+        {
+            merged.ensureSize (512);
+        }
+
+        struct Cursor
+        {
+            Cursor (const MidiBuffer& b) noexcept : iterator (b) {}
+
+            void advance() noexcept     { hasEvent = iterator.getNextEvent (data, numBytes, time); }
+
+            MidiBuffer::Iterator iterator;
+            const uint8* data = nullptr;
+            int numBytes = 0, time = 0;
+            bool hasEvent = false;
+        };
+
+        const Array<int> sourceIndexes;
+        const int destIndex;
+        std::vector<Cursor> cursors;
+        MidiBuffer merged;
+
+        JUCE_DECLARE_NON_COPYABLE (MergeMidiBuffersOp)
+    };
+
     //==============================================================================
     struct ProcessOp   : public RenderingOp
     {
         ProcessOp (const AudioProcessorGraph::Node::Ptr& n,
                    const Array<int>& audioChannelsUsed,
-                   int totalNumChans, int midiBuffer)
+                   int totalNumChans, int midiBuffer, bool shouldMeasureTiming)
             : node (n),
               processor (*n->getProcessor()),
-              audioChannelsToUse (audioChannelsUsed),
               totalChans (jmax (1, totalNumChans)),
-              midiBufferToUse (midiBuffer)
+              midiBufferToUse (midiBuffer),
+              measureTiming (shouldMeasureTiming)
         {
             audioChannels.calloc ((size_t) totalChans);
+            audioChannelsToUse.addArray (audioChannelsUsed);
 
             while (audioChannelsToUse.size() < totalChans)
                 audioChannelsToUse.add (0);
@@ -252,6 +644,7 @@ private:
 
         void perform (const Context& c) override
         {
+            JUCE_TRACE_SCOPE ("AudioProcessorGraph::processNode");
             processor.setPlayHead (c.audioPlayHead);
 
             for (int i = 0; i < totalChans; ++i)
@@ -259,76 +652,308 @@ private:
 
             AudioBuffer<FloatType> buffer (audioChannels, totalChans, c.numSamples);
 
+            if (midiBufferToUse < 0)
+                privateMidiBuffer.clear();
+
+            auto& midiMessages = midiBufferToUse >= 0 ? c.midiBuffers[midiBufferToUse] : privateMidiBuffer;
+
             if (processor.isSuspended())
+            {
                 buffer.clear();
-            else
-                callProcess (buffer, c.midiBuffers[midiBufferToUse]);
-        }
-
-        void callProcess (AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
-        {
-            if (processor.isUsingDoublePrecision())
+            }
+            else if (measureTiming)
             {
-                tempBufferDouble.makeCopyOf (buffer, true);
-
-                if (node->isBypassed())
-                    processor.processBlockBypassed (tempBufferDouble, midiMessages);
-                else
-                    processor.processBlock (tempBufferDouble, midiMessages);
+                auto startTicks = Time::getHighResolutionTicks();
+                callProcess (buffer, midiMessages);
+                auto elapsedTicks = Time::getHighResolutionTicks() - startTicks;
 
-                buffer.makeCopyOf (tempBufferDouble, true);
+                node->recordProcessingTime ((float) (1000.0 * Time::highResolutionTicksToSeconds (elapsedTicks)));
             }
             else
             {
-                if (node->isBypassed())
-                    processor.processBlockBypassed (buffer, midiMessages);
-                else
-                    processor.processBlock (buffer, midiMessages);
+                callProcess (buffer, midiMessages);
             }
         }
 
-        void callProcess (AudioBuffer<double>& buffer, MidiBuffer& midiMessages)
+        void prepareBuffers (int blockSize, AudioProcessor::ProcessingPrecision graphPrecision) override
+        {
+            if (midiBufferToUse < 0)
+                privateMidiBuffer.ensureSize (512);
+
+            // The processor's precision is decided when its node gets prepared, which may not have
+            // happened yet, so this works out what it's going to be in the same way as Node::prepare()
+            auto processorPrecision = processor.supportsDoublePrecisionProcessing() ? graphPrecision
+                                                                                    : AudioProcessor::singlePrecision;
+
+            if (processorPrecision != sequencePrecision)
+                tempBuffer.setSize (totalChans, blockSize);
+        }
+
+        void callProcess (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages)
         {
-            if (processor.isUsingDoublePrecision())
+            if (processor.isUsingDoublePrecision() == (sequencePrecision == AudioProcessor::doublePrecision))
             {
-                if (node->isBypassed())
-                    processor.processBlockBypassed (buffer, midiMessages);
-                else
-                    processor.processBlock (buffer, midiMessages);
+                processWithPrecision (buffer, midiMessages);
+                return;
             }
-            else
-            {
-                tempBufferFloat.makeCopyOf (buffer, true);
 
-                if (node->isBypassed())
-                    processor.processBlockBypassed (tempBufferFloat, midiMessages);
-                else
-                    processor.processBlock (tempBufferFloat, midiMessages);
+            auto numChans = buffer.getNumChannels();
+            auto numSamples = buffer.getNumSamples();
 
-                buffer.makeCopyOf (tempBufferFloat, true);
-            }
+            // After prepareBuffers() this won't need to reallocate
+            tempBuffer.setSize (numChans, numSamples, false, false, true);
+
+            for (int i = 0; i < numChans; ++i)
+                convertSamples (tempBuffer.getWritePointer (i), buffer.getReadPointer (i), numSamples);
+
+            processWithPrecision (tempBuffer, midiMessages);
+
+            for (int i = 0; i < numChans; ++i)
+                convertSamples (buffer.getWritePointer (i), tempBuffer.getReadPointer (i), numSamples);
+        }
+
+        template <typename SampleType>
+        void processWithPrecision (AudioBuffer<SampleType>& buffer, MidiBuffer& midiMessages)
+        {
+            if (node->isBypassed())
+                processor.processBlockBypassed (buffer, midiMessages);
+            else
+                processor.processBlock (buffer, midiMessages);
         }
 
+        static void convertSamples (double* dest, const float* src, int num) noexcept   { FloatVectorOperations::convertFloatToDouble (dest, src, num); }
+        static void convertSamples (float* dest, const double* src, int num) noexcept   { FloatVectorOperations::convertDoubleToFloat (dest, src, num); }
+
+        using OtherFloatType = typename std::conditional<std::is_same<FloatType, float>::value, double, float>::type;
+
+        static constexpr AudioProcessor::ProcessingPrecision sequencePrecision
+            = std::is_same<FloatType, double>::value ? AudioProcessor::doublePrecision
+                                                     : AudioProcessor::singlePrecision;
+
         const AudioProcessorGraph::Node::Ptr node;
         AudioProcessor& processor;
 
-        Array<int> audioChannelsToUse;
+        SmallArray<int, 8> audioChannelsToUse;
         HeapBlock<FloatType*> audioChannels;
-        AudioBuffer<float> tempBufferFloat, tempBufferDouble;
+        AudioBuffer<OtherFloatType> tempBuffer;
+        MidiBuffer privateMidiBuffer;
         const int totalChans, midiBufferToUse;
+        const bool measureTiming;
 
         JUCE_DECLARE_NON_COPYABLE (ProcessOp)
     };
 };
 
 //==============================================================================
+//==============================================================================
+//==============================================================================
+/*  The nodes and connections that a RenderSequenceBuilder works from.
+
+    Normally these are just the graph's own, but when the graph is flattening nested
+    graphs, the nodes inside any AudioProcessorGraph that it contains are pulled up
+    into the same list (recursively) with new IDs, and every connection that goes
+    through a nested graph's I/O nodes is replaced by direct connections between the
+    nodes on either side of it.
+*/
+struct FlattenedGraph
+{
+    using Node = AudioProcessorGraph::Node;
+    using NodeID = AudioProcessorGraph::NodeID;
+    using NodeAndChannel = AudioProcessorGraph::NodeAndChannel;
+    using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+    explicit FlattenedGraph (AudioProcessorGraph& g)  : topLevelGraph (g)
+    {
+        if (! g.isFlatteningNestedGraphs())
+        {
+            for (auto* n : g.getNodes())
+                addEntry (*n, n->nodeID, g);
+
+            connections = g.getConnections();
+            return;
+        }
+
+        for (auto* n : g.getNodes())
+            nextNestedNodeID = jmax (nextNestedNodeID, n->nodeID.uid + 1);
+
+        addNodes (g, nullptr, nullptr);
+
+        for (auto& graph : graphs)
+        {
+            for (auto& c : graph.second.connections)
+            {
+                auto dest = entryIndexForNode.find (graph.first->getNodeForId (c.destination.nodeID));
+
+                if (dest != entryIndexForNode.end())
+                {
+                    Array<NodeAndChannel> sources;
+                    findSources (*graph.first, c.source, sources, 0);
+
+                    for (auto& source : sources)
+                        connections.push_back ({ source, { entries.getReference (dest->second).nodeID,
+                                                           c.destination.channelIndex } });
+                }
+            }
+        }
+
+        // keeps the order of mixing deterministic, whatever order the graphs were visited in
+        std::sort (connections.begin(), connections.end());
+    }
+
+    struct Entry
+    {
+        Node* node;
+        NodeID nodeID;
+        AudioProcessorGraph* owner;
+    };
+
+    NodeID getNodeID (Node& node) const
+    {
+        auto entry = entryIndexForNode.find (&node);
+        jassert (entry != entryIndexForNode.end());
+        return entry != entryIndexForNode.end() ? entries.getReference (entry->second).nodeID : NodeID();
+    }
+
+    bool isInTopLevelGraph (Node& node) const
+    {
+        auto entry = entryIndexForNode.find (&node);
+        return entry != entryIndexForNode.end() && entries.getReference (entry->second).owner == &topLevelGraph;
+    }
+
+    static int64 getChannelKey (NodeAndChannel nc) noexcept
+    {
+        return (int64) (((uint64) nc.nodeID.uid << 32) | (uint32) nc.channelIndex);
+    }
+
+    AudioProcessorGraph& topLevelGraph;
+    Array<Entry> entries;
+    std::vector<AudioProcessorGraph::Connection> connections;
+
+private:
+    struct GraphInfo
+    {
+        AudioProcessorGraph* parent = nullptr;
+        Node* nodeInParent = nullptr;
+        std::vector<AudioProcessorGraph::Connection> connections;
+        std::map<int64, Array<NodeAndChannel>> sourcesForInput;
+    };
+
+    std::map<AudioProcessorGraph*, GraphInfo> graphs;
+    std::map<const Node*, int> entryIndexForNode;
+    uint32 nextNestedNodeID = 1;
+
+    void addEntry (Node& node, NodeID nodeID, AudioProcessorGraph& owner)
+    {
+        entryIndexForNode[&node] = entries.size();
+        entries.add ({ &node, nodeID, &owner });
+    }
+
+    static AudioProcessorGraph* getGraphToInline (Node& node)
+    {
+        if (auto* nested = dynamic_cast<AudioProcessorGraph*> (node.getProcessor()))
+            if (! node.isBypassed())
+                return nested;
+
+        return nullptr;
+    }
+
+    void addNodes (AudioProcessorGraph& g, AudioProcessorGraph* parent, Node* nodeInParent)
+    {
+        auto& info = graphs[&g];
+        info.parent = parent;
+        info.nodeInParent = nodeInParent;
+        info.connections = g.getConnections();
+
+        for (auto& c : info.connections)
+            info.sourcesForInput[getChannelKey (c.destination)].add (c.source);
+
+        for (auto* n : g.getNodes())
+        {
+            if (auto* nested = getGraphToInline (*n))
+            {
+                addNodes (*nested, &g, n);
+                continue;
+            }
+
+            // a nested graph's I/O nodes disappear, because they're replaced by direct connections
+            if (parent != nullptr && dynamic_cast<IOProcessor*> (n->getProcessor()) != nullptr)
+                continue;
+
+            addEntry (*n, parent == nullptr ? n->nodeID : NodeID (nextNestedNodeID++), g);
+        }
+    }
+
+    void findSources (AudioProcessorGraph& g, NodeAndChannel source, Array<NodeAndChannel>& results, int depth)
+    {
+        auto* node = g.getNodeForId (source.nodeID);
+
+        if (node == nullptr || depth > 100)
+        {
+            jassert (node != nullptr);
+            return;
+        }
+
+        auto entry = entryIndexForNode.find (node);
+
+        if (entry != entryIndexForNode.end())
+        {
+            results.add ({ entries.getReference (entry->second).nodeID, source.channelIndex });
+            return;
+        }
+
+        auto& info = graphs[&g];
+
+        if (auto* nested = dynamic_cast<AudioProcessorGraph*> (node->getProcessor()))
+        {
+            // an output of a nested graph comes from whatever feeds its matching output node
+            auto nestedInfo = graphs.find (nested);
+
+            if (nestedInfo == graphs.end())
+                return;
+
+            auto outputType = source.isMIDI() ? IOProcessor::midiOutputNode : IOProcessor::audioOutputNode;
+
+            for (auto* n : nested->getNodes())
+            {
+                auto* io = dynamic_cast<IOProcessor*> (n->getProcessor());
+
+                if (io != nullptr && io->getType() == outputType)
+                {
+                    auto sources = nestedInfo->second.sourcesForInput.find (getChannelKey ({ n->nodeID, source.channelIndex }));
+
+                    if (sources != nestedInfo->second.sourcesForInput.end())
+                        for (auto& s : sources->second)
+                            findSources (*nested, s, results, depth + 1);
+                }
+            }
+        }
+        else if (auto* io = dynamic_cast<IOProcessor*> (node->getProcessor()))
+        {
+            // an input node of a nested graph passes on whatever feeds the graph's node in its parent
+            if (io->isInput() && info.parent != nullptr
+                 && (source.isMIDI() || source.channelIndex < g.getTotalNumInputChannels()))
+            {
+                auto& parentInfo = graphs[info.parent];
+                auto sources = parentInfo.sourcesForInput.find (getChannelKey ({ info.nodeInParent->nodeID, source.channelIndex }));
+
+                if (sources != parentInfo.sourcesForInput.end())
+                    for (auto& s : sources->second)
+                        findSources (*info.parent, s, results, depth + 1);
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (FlattenedGraph)
+};
+
 //==============================================================================
 template <typename RenderSequence>
 struct RenderSequenceBuilder
 {
-    RenderSequenceBuilder (AudioProcessorGraph& g, RenderSequence& s)
-        : graph (g), sequence (s)
+    RenderSequenceBuilder (AudioProcessorGraph& g, const FlattenedGraph& f, RenderSequence& s)
+        : graph (g), flattened (f), sequence (s)
     {
+        createConnectionLookups();
         createOrderedNodeList();
 
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
@@ -343,6 +968,7 @@ struct RenderSequenceBuilder
 
         graph.setLatencySamples (totalLatency);
 
+        s.createTaskDependencies();
         s.numBuffersNeeded = audioBuffers.size();
         s.numMidiBuffersNeeded = midiBuffers.size();
     }
@@ -351,6 +977,7 @@ struct RenderSequenceBuilder
     using NodeID = AudioProcessorGraph::NodeID;
 
     AudioProcessorGraph& graph;
+    const FlattenedGraph& flattened;
     RenderSequence& sequence;
 
     Array<AudioProcessorGraph::Node*> orderedNodes;
@@ -396,27 +1023,95 @@ struct RenderSequenceBuilder
     int getInputLatencyForNode (NodeID nodeID) const
     {
         int maxLatency = 0;
+        auto sourceNodes = sourceNodesForNode.find (nodeID.uid);
 
-        for (auto&& c : graph.getConnections())
-            if (c.destination.nodeID == nodeID)
-                maxLatency = jmax (maxLatency, getNodeDelay (c.source.nodeID));
+        if (sourceNodes != sourceNodesForNode.end())
+            for (auto source : sourceNodes->second)
+                maxLatency = jmax (maxLatency, getNodeDelay (source));
 
         return maxLatency;
     }
 
     //==============================================================================
+    // The graph's connections are indexed once up-front, so that building the sequence
+    // doesn't need to keep re-scanning the whole connection list for every channel.
+    using ChannelList = Array<AudioProcessorGraph::NodeAndChannel>;
+
+    // These lookups are thrown away along with the builder, so their nodes are taken from an arena
+    MemoryArena arena;
+
+    template <typename KeyType, typename ValueType>
+    using ArenaMap = std::map<KeyType, ValueType, std::less<KeyType>, ArenaAllocator<std::pair<const KeyType, ValueType>>>;
+
+    ArenaMap<int64, ChannelList> sourcesForInput { arena }, destinationsForOutput { arena };
+    ArenaMap<uint32, Array<NodeID>> sourceNodesForNode { arena };
+    ArenaMap<uint32, int> renderingIndexForNode { arena };
+
+    static int64 getChannelKey (AudioProcessorGraph::NodeAndChannel nc) noexcept
+    {
+        return FlattenedGraph::getChannelKey (nc);
+    }
+
+    NodeID getNodeID (AudioProcessorGraph::Node& node) const
+    {
+        return flattened.getNodeID (node);
+    }
+
+    void createConnectionLookups()
+    {
+        for (auto& c : flattened.connections)
+        {
+            sourcesForInput[getChannelKey (c.destination)].add (c.source);
+            destinationsForOutput[getChannelKey (c.source)].add (c.destination);
+            sourceNodesForNode[c.destination.nodeID.uid].add (c.source.nodeID);
+        }
+    }
+
     void createOrderedNodeList()
     {
-        for (auto* node : graph.getNodes())
+        // Finding everything upstream of each node once is much cheaper than calling
+        // graph.isAnInputTo() for every pair, and gives an identical ordering.
+        ArenaMap<uint32, SortedSet<uint32>> nodesFeedingNode { arena };
+
+        for (auto& entry : flattened.entries)
+        {
+            auto& upstream = nodesFeedingNode[entry.nodeID.uid];
+            Array<NodeID> nodesToVisit { entry.nodeID };
+
+            while (! nodesToVisit.isEmpty())
+            {
+                auto sourceNodes = sourceNodesForNode.find (nodesToVisit.removeAndReturn (nodesToVisit.size() - 1).uid);
+
+                if (sourceNodes != sourceNodesForNode.end())
+                {
+                    for (auto source : sourceNodes->second)
+                    {
+                        if (! upstream.contains (source.uid))
+                        {
+                            upstream.add (source.uid);
+                            nodesToVisit.add (source);
+                        }
+                    }
+                }
+            }
+        }
+
+        Array<NodeID> orderedNodeIDs;
+
+        for (auto& entry : flattened.entries)
         {
             int j = 0;
 
             for (; j < orderedNodes.size(); ++j)
-                if (graph.isAnInputTo (*node, *orderedNodes.getUnchecked(j)))
+                if (nodesFeedingNode[orderedNodeIDs.getUnchecked(j).uid].contains (entry.nodeID.uid))
                   break;
 
-            orderedNodes.insert (j, node);
+            orderedNodes.insert (j, entry.node);
+            orderedNodeIDs.insert (j, entry.nodeID);
         }
+
+        for (int i = 0; i < orderedNodeIDs.size(); ++i)
+            renderingIndexForNode[orderedNodeIDs.getUnchecked (i).uid] = i;
     }
 
     int findBufferForInputAudioChannel (AudioProcessorGraph::Node& node, const int inputChan,
@@ -559,11 +1254,13 @@ struct RenderSequenceBuilder
         // No midi inputs..
         if (sources.isEmpty())
         {
-            auto midiBufferToUse = getFreeBuffer (midiBuffers); // need to pick a buffer even if the processor doesn't use midi
-
-            if (processor.acceptsMidi() || processor.producesMidi())
-                sequence.addClearMidiBufferOp (midiBufferToUse);
+            // a node that doesn't use midi gets a private buffer, so that it doesn't need to
+            // wait for other nodes that are using a shared one
+            if (! (processor.acceptsMidi() || processor.producesMidi()))
+                return -1;
 
+            auto midiBufferToUse = getFreeBuffer (midiBuffers);
+            sequence.addClearMidiBufferOp (midiBufferToUse);
             return midiBufferToUse;
         }
 
@@ -575,7 +1272,8 @@ struct RenderSequenceBuilder
 
             if (midiBufferToUse >= 0)
             {
-                if (isBufferNeededLater (ourRenderingIndex, AudioProcessorGraph::midiChannelIndex, src))
+                if (isBufferNeededLater (ourRenderingIndex, AudioProcessorGraph::midiChannelIndex, src)
+                     && ! RenderSequence::onlyReadsMidi (processor))
                 {
                     // can't mess up this channel because it's needed later by another node, so we
                     // need to use a copy of it..
@@ -595,49 +1293,38 @@ struct RenderSequenceBuilder
 
         // Multiple midi inputs..
         int midiBufferToUse = -1;
-        int reusableInputIndex = -1;
+        Array<int> sourceBuffers;
 
-        for (int i = 0; i < sources.size(); ++i)
+        for (auto& src : sources)
         {
-            auto src = sources.getReference (i);
             auto sourceBufIndex = getBufferContaining (src);
 
-            if (sourceBufIndex >= 0
-                 && ! isBufferNeededLater (ourRenderingIndex, AudioProcessorGraph::midiChannelIndex, src))
+            if (sourceBufIndex >= 0)
             {
-                // we've found one of our input buffers that can be re-used..
-                reusableInputIndex = i;
-                midiBufferToUse = sourceBufIndex;
-                break;
+                sourceBuffers.add (sourceBufIndex);
+
+                // if one of our input buffers isn't needed later, it can be re-used..
+                if (midiBufferToUse < 0
+                     && ! isBufferNeededLater (ourRenderingIndex, AudioProcessorGraph::midiChannelIndex, src))
+                    midiBufferToUse = sourceBufIndex;
             }
         }
 
-        if (reusableInputIndex < 0)
+        if (midiBufferToUse < 0)
         {
-            // can't re-use any of our input buffers, so get a new one and copy everything into it..
             midiBufferToUse = getFreeBuffer (midiBuffers);
             jassert (midiBufferToUse >= 0);
-
-            auto srcIndex = getBufferContaining (sources.getUnchecked(0));
-
-            if (srcIndex >= 0)
-                sequence.addCopyMidiBufferOp (srcIndex, midiBufferToUse);
-            else
-                sequence.addClearMidiBufferOp (midiBufferToUse);
-
-            reusableInputIndex = 0;
         }
 
-        for (int i = 0; i < sources.size(); ++i)
+        if (sourceBuffers.isEmpty())
+            sequence.addClearMidiBufferOp (midiBufferToUse);
+        else if (sourceBuffers.size() == 1)
         {
-            if (i != reusableInputIndex)
-            {
-                auto srcIndex = getBufferContaining (sources.getUnchecked(i));
-
-                if (srcIndex >= 0)
-                    sequence.addAddMidiBufferOp (srcIndex, midiBufferToUse);
-            }
+            if (sourceBuffers.getFirst() != midiBufferToUse)
+                sequence.addCopyMidiBufferOp (sourceBuffers.getFirst(), midiBufferToUse);
         }
+        else
+            sequence.addMergeMidiBuffersOp (sourceBuffers, midiBufferToUse);
 
         return midiBufferToUse;
     }
@@ -649,8 +1336,10 @@ struct RenderSequenceBuilder
         auto numOuts = processor.getTotalNumOutputChannels();
         auto totalChans = jmax (numIns, numOuts);
 
+        auto nodeID = getNodeID (node);
+
         Array<int> audioChannelsToUse;
-        auto maxLatency = getInputLatencyForNode (node.nodeID);
+        auto maxLatency = getInputLatencyForNode (nodeID);
 
         for (int inputChan = 0; inputChan < numIns; ++inputChan)
         {
@@ -661,7 +1350,7 @@ struct RenderSequenceBuilder
             audioChannelsToUse.add (index);
 
             if (inputChan < numOuts)
-                audioBuffers.getReference (index).channel = { node.nodeID, inputChan };
+                audioBuffers.getReference (index).channel = { nodeID, inputChan };
         }
 
         for (int outputChan = numIns; outputChan < numOuts; ++outputChan)
@@ -670,33 +1359,31 @@ struct RenderSequenceBuilder
             jassert (index != 0);
             audioChannelsToUse.add (index);
 
-            audioBuffers.getReference (index).channel = { node.nodeID, outputChan };
+            audioBuffers.getReference (index).channel = { nodeID, outputChan };
         }
 
         auto midiBufferToUse = findBufferForInputMidiChannel (node, ourRenderingIndex);
 
         if (processor.producesMidi())
-            midiBuffers.getReference (midiBufferToUse).channel = { node.nodeID, AudioProcessorGraph::midiChannelIndex };
+            midiBuffers.getReference (midiBufferToUse).channel = { nodeID, AudioProcessorGraph::midiChannelIndex };
 
-        delays.set (node.nodeID.uid, maxLatency + processor.getLatencySamples());
+        delays.set (nodeID.uid, maxLatency + processor.getLatencySamples());
 
-        if (numOuts == 0)
+        if (numOuts == 0 && flattened.isInTopLevelGraph (node))
             totalLatency = maxLatency;
 
-        sequence.addProcessOp (node, audioChannelsToUse, totalChans, midiBufferToUse);
+        sequence.addProcessOp (node, audioChannelsToUse, totalChans, midiBufferToUse, graph.isNodeTimingEnabled());
     }
 
     //==============================================================================
-    Array<AudioProcessorGraph::NodeAndChannel> getSourcesForChannel (AudioProcessorGraph::Node& node, int inputChannelIndex)
+    ChannelList getSourcesForChannel (AudioProcessorGraph::Node& node, int inputChannelIndex)
     {
-        Array<AudioProcessorGraph::NodeAndChannel> results;
-        AudioProcessorGraph::NodeAndChannel nc { node.nodeID, inputChannelIndex };
+        auto sources = sourcesForInput.find (getChannelKey ({ getNodeID (node), inputChannelIndex }));
 
-        for (auto&& c : graph.getConnections())
-            if (c.destination == nc)
-                results.add (c.source);
+        if (sources != sourcesForInput.end())
+            return sources->second;
 
-        return results;
+        return {};
     }
 
     static int getFreeBuffer (Array<AssignedBuffer>& buffers)
@@ -735,26 +1422,33 @@ struct RenderSequenceBuilder
                               int inputChannelOfIndexToIgnore,
                               AudioProcessorGraph::NodeAndChannel output) const
     {
-        while (stepIndexToSearchFrom < orderedNodes.size())
+        auto destinations = destinationsForOutput.find (getChannelKey (output));
+
+        if (destinations == destinationsForOutput.end())
+            return false;
+
+        for (auto& dest : destinations->second)
         {
-            auto* node = orderedNodes.getUnchecked (stepIndexToSearchFrom);
+            auto renderingIndex = renderingIndexForNode.find (dest.nodeID.uid);
+
+            if (renderingIndex == renderingIndexForNode.end() || renderingIndex->second < stepIndexToSearchFrom)
+                continue;
+
+            if (renderingIndex->second == stepIndexToSearchFrom && dest.channelIndex == inputChannelOfIndexToIgnore)
+                continue;
 
             if (output.isMIDI())
             {
-                if (inputChannelOfIndexToIgnore != AudioProcessorGraph::midiChannelIndex
-                     && graph.isConnected ({ { output.nodeID, AudioProcessorGraph::midiChannelIndex },
-                                             { node->nodeID,  AudioProcessorGraph::midiChannelIndex } }))
+                if (dest.isMIDI())
                     return true;
             }
             else
             {
-                for (int i = 0; i < node->getProcessor()->getTotalNumInputChannels(); ++i)
-                    if (i != inputChannelOfIndexToIgnore && graph.isConnected ({ output, { node->nodeID, i } }))
-                        return true;
-            }
+                auto* node = orderedNodes.getUnchecked (renderingIndex->second);
 
-            inputChannelOfIndexToIgnore = -1;
-            ++stepIndexToSearchFrom;
+                if (isPositiveAndBelow (dest.channelIndex, node->getProcessor()->getTotalNumInputChannels()))
+                    return true;
+            }
         }
 
         return false;
@@ -830,6 +1524,8 @@ void AudioProcessorGraph::Node::setParentGraph (AudioProcessorGraph* const graph
 {
     if (auto* ioProc = dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (processor.get()))
         ioProc->setParentGraph (graph);
+    else if (auto* nestedGraph = dynamic_cast<AudioProcessorGraph*> (processor.get()))
+        nestedGraph->parentGraph = graph;
 }
 
 bool AudioProcessorGraph::Node::Connection::operator== (const Connection& other) const noexcept
@@ -862,10 +1558,96 @@ void AudioProcessorGraph::Node::setBypassed (bool shouldBeBypassed) noexcept
     bypassed = shouldBeBypassed;
 }
 
+//==============================================================================
+void AudioProcessorGraph::Node::prepareTimingHistory()
+{
+    if (timingHistory == nullptr)
+    {
+        timingHistory.reset (new std::atomic<float>[(size_t) timingHistorySize]);
+
+        for (int i = 0; i < timingHistorySize; ++i)
+            timingHistory[i] = 0.0f;
+    }
+}
+
+void AudioProcessorGraph::Node::recordProcessingTime (float milliseconds) noexcept
+{
+    // Only a single render thread ever processes a given node at a time, so there's only one writer
+    auto index = numTimingsRecorded.load (std::memory_order_relaxed);
+    timingHistory[index % (uint32) timingHistorySize].store (milliseconds, std::memory_order_relaxed);
+    numTimingsRecorded.store (index + 1, std::memory_order_release);
+}
+
+Array<float> AudioProcessorGraph::Node::getRecentBlockTimes() const
+{
+    Array<float> times;
+
+    if (timingHistory == nullptr)
+        return times;
+
+    auto numRecorded = numTimingsRecorded.load (std::memory_order_acquire);
+    auto numAvailable = (int) jmin (numRecorded - numTimingsAtLastReset, (uint32) timingHistorySize);
+
+    if (numAvailable <= 0)
+        return times;
+
+    times.ensureStorageAllocated (numAvailable);
+
+    for (auto i = numRecorded - (uint32) numAvailable; i != numRecorded; ++i)
+        times.add (timingHistory[i % (uint32) timingHistorySize].load (std::memory_order_relaxed));
+
+    return times;
+}
+
+AudioProcessorGraph::Node::TimingStatistics AudioProcessorGraph::Node::getTimingStatistics() const
+{
+    return TimingStatistics::fromBlockTimes (getRecentBlockTimes());
+}
+
+AudioProcessorGraph::Node::TimingStatistics AudioProcessorGraph::Node::TimingStatistics::fromBlockTimes (Array<float> times)
+{
+    TimingStatistics stats;
+
+    if (times.isEmpty())
+        return stats;
+
+    times.sort();
+
+    double total = 0;
+
+    for (auto t : times)
+        total += t;
+
+    auto getPercentile = [&times] (double proportion)
+    {
+        return (double) times.getUnchecked (jmin (times.size() - 1, (int) (proportion * times.size())));
+    };
+
+    stats.numBlocks      = times.size();
+    stats.minimumMs      = times.getFirst();
+    stats.maximumMs      = times.getLast();
+    stats.averageMs      = total / times.size();
+    stats.medianMs       = getPercentile (0.5);
+    stats.percentile95Ms = getPercentile (0.95);
+    stats.percentile99Ms = getPercentile (0.99);
+
+    return stats;
+}
+
+void AudioProcessorGraph::Node::resetTimingStatistics() noexcept
+{
+    numTimingsAtLastReset = numTimingsRecorded.load();
+}
+
 //==============================================================================
 struct AudioProcessorGraph::RenderSequenceFloat   : public GraphRenderSequence<float> {};
 struct AudioProcessorGraph::RenderSequenceDouble  : public GraphRenderSequence<double> {};
 
+struct AudioProcessorGraph::RenderThreadPool  : public GraphRenderThreadPool
+{
+    using GraphRenderThreadPool::GraphRenderThreadPool;
+};
+
 //==============================================================================
 AudioProcessorGraph::AudioProcessorGraph()
 {
@@ -885,10 +1667,43 @@ const String AudioProcessorGraph::getName() const
 //==============================================================================
 void AudioProcessorGraph::topologyChanged()
 {
+    if (changeBatchDepth > 0)
+    {
+        topologyChangedDuringBatch = true;
+        return;
+    }
+
     sendChangeMessage();
 
     if (isPrepared.get() != 0)
         triggerAsyncUpdate();
+
+    // if this graph is being rendered as part of its parent's sequence, that needs rebuilding too
+    if (isInlinedIntoParent())
+        parentGraph->topologyChanged();
+}
+
+bool AudioProcessorGraph::isInlinedIntoParent() const noexcept
+{
+    return parentGraph != nullptr
+            && (parentGraph->flattenNestedGraphs || parentGraph->isInlinedIntoParent());
+}
+
+AudioProcessorGraph::ScopedChangeBatch::ScopedChangeBatch (AudioProcessorGraph& g) noexcept
+    : graph (g)
+{
+    ++(graph.changeBatchDepth);
+}
+
+AudioProcessorGraph::ScopedChangeBatch::~ScopedChangeBatch()
+{
+    jassert (graph.changeBatchDepth > 0);
+
+    if (--(graph.changeBatchDepth) == 0 && graph.topologyChangedDuringBatch)
+    {
+        graph.topologyChangedDuringBatch = false;
+        graph.topologyChanged();
+    }
 }
 
 void AudioProcessorGraph::clear()
@@ -898,6 +1713,10 @@ void AudioProcessorGraph::clear()
     if (nodes.isEmpty())
         return;
 
+    for (auto* n : nodes)
+        if (auto* nestedGraph = dynamic_cast<AudioProcessorGraph*> (n->getProcessor()))
+            nestedGraph->parentGraph = nullptr;
+
     nodes.clear();
     topologyChanged();
 }
@@ -949,7 +1768,12 @@ bool AudioProcessorGraph::removeNode (NodeID nodeId)
     {
         if (nodes.getUnchecked(i)->nodeID == nodeId)
         {
+            const ScopedChangeBatch batch (*this);
             disconnectNode (nodeId);
+
+            if (auto* nestedGraph = dynamic_cast<AudioProcessorGraph*> (nodes.getUnchecked (i)->getProcessor()))
+                nestedGraph->parentGraph = nullptr;
+
             nodes.remove (i);
             topologyChanged();
             return true;
@@ -1132,6 +1956,8 @@ bool AudioProcessorGraph::disconnectNode (NodeID nodeID)
 
         if (! connections.empty())
         {
+            const ScopedChangeBatch batch (*this);
+
             for (auto c : connections)
                 removeConnection (c);
 
@@ -1161,6 +1987,7 @@ bool AudioProcessorGraph::isConnectionLegal (const Connection& c) const
 
 bool AudioProcessorGraph::removeIllegalConnections()
 {
+    const ScopedChangeBatch batch (*this);
     bool anyRemoved = false;
 
     for (auto* node : nodes)
@@ -1203,20 +2030,26 @@ void AudioProcessorGraph::buildRenderingSequence()
     std::unique_ptr<RenderSequenceFloat>  newSequenceF (new RenderSequenceFloat());
     std::unique_ptr<RenderSequenceDouble> newSequenceD (new RenderSequenceDouble());
 
+    std::unique_ptr<FlattenedGraph> flattened;
+
     {
         MessageManagerLock mml;
 
-        RenderSequenceBuilder<RenderSequenceFloat>  builderF (*this, *newSequenceF);
-        RenderSequenceBuilder<RenderSequenceDouble> builderD (*this, *newSequenceD);
+        flattened.reset (new FlattenedGraph (*this));
+        RenderSequenceBuilder<RenderSequenceFloat>  builderF (*this, *flattened, *newSequenceF);
+        RenderSequenceBuilder<RenderSequenceDouble> builderD (*this, *flattened, *newSequenceD);
     }
 
+    auto anyInlinedNodesNeedPreparing = std::any_of (flattened->entries.begin(), flattened->entries.end(),
+                                                     [this] (const FlattenedGraph::Entry& e) { return e.owner != this && ! e.node->isPrepared; });
+
     {
         const ScopedLock sl (getCallbackLock());
-        newSequenceF->prepareBuffers (getBlockSize());
-        newSequenceD->prepareBuffers (getBlockSize());
+        newSequenceF->prepareBuffers (getBlockSize(), getProcessingPrecision());
+        newSequenceD->prepareBuffers (getBlockSize(), getProcessingPrecision());
     }
 
-    if (anyNodesNeedPreparing())
+    if (anyNodesNeedPreparing() || anyInlinedNodesNeedPreparing)
     {
         {
             const ScopedLock sl (getCallbackLock());
@@ -1226,6 +2059,12 @@ void AudioProcessorGraph::buildRenderingSequence()
 
         for (auto* node : nodes)
             node->prepare (getSampleRate(), getBlockSize(), this, getProcessingPrecision());
+
+        // nodes from nested graphs are rendered by this graph's sequence, so they have to be
+        // ready before it's used, rather than whenever their own graph gets round to it
+        for (auto& e : flattened->entries)
+            if (e.owner != this)
+                e.node->prepare (getSampleRate(), getBlockSize(), e.owner, getProcessingPrecision());
     }
 
     const ScopedLock sl (getCallbackLock());
@@ -1273,6 +2112,52 @@ void AudioProcessorGraph::releaseResources()
         renderSequenceDouble->releaseBuffers();
 }
 
+void AudioProcessorGraph::setNumRenderThreads (int numThreads)
+{
+    numThreads = jmax (0, numThreads);
+
+    if (numThreads == getNumRenderThreads())
+        return;
+
+    std::unique_ptr<RenderThreadPool> newPool;
+
+    if (numThreads > 0)
+        newPool.reset (new RenderThreadPool (numThreads));
+
+    {
+        const ScopedLock sl (getCallbackLock());
+        std::swap (renderThreadPool, newPool);
+    }
+}
+
+int AudioProcessorGraph::getNumRenderThreads() const noexcept
+{
+    return renderThreadPool != nullptr ? renderThreadPool->getNumThreads() : 0;
+}
+
+void AudioProcessorGraph::setNodeTimingEnabled (bool shouldMeasureNodeTimes)
+{
+    if (nodeTimingEnabled != shouldMeasureNodeTimes)
+    {
+        nodeTimingEnabled = shouldMeasureNodeTimes;
+
+        // the measurement is built into the rendering sequence, so this needs a rebuild
+        if (isPrepared.get() != 0)
+            triggerAsyncUpdate();
+    }
+}
+
+void AudioProcessorGraph::setFlattensNestedGraphs (bool shouldFlatten)
+{
+    if (flattenNestedGraphs != shouldFlatten)
+    {
+        flattenNestedGraphs = shouldFlatten;
+
+        if (isPrepared.get() != 0)
+            triggerAsyncUpdate();
+    }
+}
+
 void AudioProcessorGraph::reset()
 {
     const ScopedLock sl (getCallbackLock());
@@ -1301,6 +2186,7 @@ template <typename FloatType, typename SequenceType>
 static void processBlockForBuffer (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages,
                                    AudioProcessorGraph& graph,
                                    std::unique_ptr<SequenceType>& renderSequence,
+                                   GraphRenderThreadPool* threadPool,
                                    Atomic<int>& isPrepared)
 {
     if (graph.isNonRealtime())
@@ -1311,7 +2197,7 @@ static void processBlockForBuffer (AudioBuffer<FloatType>& buffer, MidiBuffer& m
         const ScopedLock sl (graph.getCallbackLock());
 
         if (renderSequence != nullptr)
-            renderSequence->perform (buffer, midiMessages, graph.getPlayHead());
+            renderSequence->perform (buffer, midiMessages, graph.getPlayHead(), threadPool);
     }
     else
     {
@@ -1320,7 +2206,7 @@ static void processBlockForBuffer (AudioBuffer<FloatType>& buffer, MidiBuffer& m
         if (isPrepared.get() == 1)
         {
             if (renderSequence != nullptr)
-                renderSequence->perform (buffer, midiMessages, graph.getPlayHead());
+                renderSequence->perform (buffer, midiMessages, graph.getPlayHead(), threadPool);
         }
         else
         {
@@ -1335,7 +2221,7 @@ void AudioProcessorGraph::processBlock (AudioBuffer<float>& buffer, MidiBuffer&
     if (isPrepared.get() == 0 && MessageManager::getInstance()->isThisTheMessageThread())
         handleAsyncUpdate();
 
-    processBlockForBuffer<float> (buffer, midiMessages, *this, renderSequenceFloat, isPrepared);
+    processBlockForBuffer<float> (buffer, midiMessages, *this, renderSequenceFloat, renderThreadPool.get(), isPrepared);
 }
 
 void AudioProcessorGraph::processBlock (AudioBuffer<double>& buffer, MidiBuffer& midiMessages)
@@ -1343,7 +2229,7 @@ void AudioProcessorGraph::processBlock (AudioBuffer<double>& buffer, MidiBuffer&
     if (isPrepared.get() == 0 && MessageManager::getInstance()->isThisTheMessageThread())
         handleAsyncUpdate();
 
-    processBlockForBuffer<double> (buffer, midiMessages, *this, renderSequenceDouble, isPrepared);
+    processBlockForBuffer<double> (buffer, midiMessages, *this, renderSequenceDouble, renderThreadPool.get(), isPrepared);
 }
 
 //==============================================================================
@@ -1502,4 +2388,397 @@ void AudioProcessorGraph::AudioGraphIOProcessor::setParentGraph (AudioProcessorG
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorGraphTests  : public UnitTest
+{
+public:
+    AudioProcessorGraphTests() : UnitTest ("AudioProcessorGraph", "Audio Processors") {}
+
+    void runTest() override
+    {
+        beginTest ("Parallel rendering gives the same result as serial rendering");
+        {
+            auto serial   = renderTestGraph (0);
+            auto parallel = renderTestGraph (3);
+
+            expectEquals (parallel.getNumChannels(), serial.getNumChannels());
+
+            for (int ch = 0; ch < serial.getNumChannels(); ++ch)
+                for (int i = 0; i < serial.getNumSamples(); ++i)
+                    expectEquals (parallel.getSample (ch, i), serial.getSample (ch, i));
+        }
+
+        beginTest ("Batched topology changes give the same result");
+        {
+            auto unbatched = renderTestGraph (0);
+            auto batched   = renderTestGraph (0, true);
+
+            for (int ch = 0; ch < unbatched.getNumChannels(); ++ch)
+                for (int i = 0; i < unbatched.getNumSamples(); ++i)
+                    expectEquals (batched.getSample (ch, i), unbatched.getSample (ch, i));
+        }
+
+        beginTest ("Single-precision nodes in a double-precision graph");
+        {
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, 32);
+            graph.setProcessingPrecision (AudioProcessor::doublePrecision);
+
+            using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+            auto input  = graph.addNode (new IOProcessor (IOProcessor::audioInputNode));
+            auto gain   = graph.addNode (new GainProcessor (0.5f, 0));
+            auto output = graph.addNode (new IOProcessor (IOProcessor::audioOutputNode));
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                graph.addConnection ({ { input->nodeID, ch }, { gain->nodeID, ch } });
+                graph.addConnection ({ { gain->nodeID, ch },  { output->nodeID, ch } });
+            }
+
+            graph.setNonRealtime (true);
+            graph.prepareToPlay (44100.0, 32);
+
+            AudioBuffer<double> buffer (2, 32);
+            MidiBuffer midi;
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (ch, i, (double) (i + ch));
+
+            graph.processBlock (buffer, midi);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectEquals (buffer.getSample (ch, i), 0.5 * (double) (i + ch));
+
+            graph.releaseResources();
+        }
+
+        beginTest ("Node timing statistics");
+        {
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, 44100.0, 32);
+            graph.setNodeTimingEnabled (true);
+
+            auto gain = graph.addNode (new GainProcessor (0.5f, 0));
+            expectEquals (gain->getTimingStatistics().numBlocks, 0);
+
+            graph.setNonRealtime (true);
+            graph.prepareToPlay (44100.0, 32);
+
+            AudioBuffer<float> buffer (2, 32);
+            MidiBuffer midi;
+
+            for (int i = 0; i < 10; ++i)
+                graph.processBlock (buffer, midi);
+
+            auto stats = gain->getTimingStatistics();
+            expectEquals (stats.numBlocks, 10);
+            expect (stats.minimumMs >= 0.0);
+            expect (stats.minimumMs <= stats.medianMs && stats.medianMs <= stats.maximumMs);
+            expect (stats.averageMs <= stats.maximumMs);
+            expectEquals (gain->getRecentBlockTimes().size(), 10);
+
+            gain->resetTimingStatistics();
+            expectEquals (gain->getTimingStatistics().numBlocks, 0);
+            expect (gain->getRecentBlockTimes().isEmpty());
+
+            auto fromTimes = AudioProcessorGraph::Node::TimingStatistics::fromBlockTimes ({ 3.0f, 1.0f, 2.0f });
+            expectEquals (fromTimes.numBlocks, 3);
+            expectEquals (fromTimes.minimumMs, 1.0);
+            expectEquals (fromTimes.maximumMs, 3.0);
+            expectEquals (fromTimes.averageMs, 2.0);
+            expectEquals (fromTimes.medianMs, 2.0);
+
+            graph.releaseResources();
+        }
+
+        beginTest ("Flattened nested graphs give the same result");
+        {
+            for (auto withThruConnection : { true, false })
+            {
+                auto nested    = renderNestedTestGraph (false, withThruConnection);
+                auto flattened = renderNestedTestGraph (true, withThruConnection);
+                auto expectedGain = withThruConnection ? 1.9f : 1.4f;
+
+                for (int ch = 0; ch < nested.getNumChannels(); ++ch)
+                {
+                    for (int i = 0; i < nested.getNumSamples(); ++i)
+                    {
+                        expectWithinAbsoluteError (flattened.getSample (ch, i), nested.getSample (ch, i), 1.0e-6f);
+                        expectWithinAbsoluteError (flattened.getSample (ch, i), expectedGain * (float) (i + ch), 1.0e-4f);
+                    }
+                }
+            }
+        }
+
+        beginTest ("MIDI fan-out and merging");
+        {
+            for (int numThreads : { 0, 2 })
+            {
+                auto midi = renderMidiTestGraph (numThreads);
+
+                Array<int> notesAt0, notesAt10;
+                MidiBuffer::Iterator iter (midi);
+                MidiMessage message;
+                int position = 0, lastPosition = 0;
+
+                while (iter.getNextEvent (message, position))
+                {
+                    expect (position >= lastPosition);
+                    lastPosition = position;
+                    (position == 0 ? notesAt0 : notesAt10).add (message.getNoteNumber());
+                }
+
+                notesAt0.sort();
+                notesAt10.sort();
+                expect (notesAt0  == Array<int> (60, 61, 62));
+                expect (notesAt10 == Array<int> (64, 65, 66));
+            }
+        }
+
+        beginTest ("Number of render threads");
+        {
+            AudioProcessorGraph graph;
+            expectEquals (graph.getNumRenderThreads(), 0);
+            graph.setNumRenderThreads (2);
+            expectEquals (graph.getNumRenderThreads(), 2);
+            graph.setNumRenderThreads (-1);
+            expectEquals (graph.getNumRenderThreads(), 0);
+        }
+    }
+
+private:
+    struct GainProcessor  : public AudioProcessor
+    {
+        GainProcessor (float g, int latency)
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo())),
+              gain (g)
+        {
+            setLatencySamples (latency);
+        }
+
+        const String getName() const override                   { return "Gain"; }
+        void prepareToPlay (double, int) override               {}
+        void releaseResources() override                        {}
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override    { buffer.applyGain (gain); }
+        double getTailLengthSeconds() const override            { return 0; }
+        bool acceptsMidi() const override                       { return false; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+        const float gain;
+    };
+
+    // replaces the notes that it's given with transposed copies
+    struct TransposeProcessor  : public AudioProcessor
+    {
+        TransposeProcessor (int semitones)  : amount (semitones) {}
+
+        const String getName() const override                   { return "Transpose"; }
+        void prepareToPlay (double, int) override               {}
+        void releaseResources() override                        {}
+        double getTailLengthSeconds() const override            { return 0; }
+        bool acceptsMidi() const override                       { return true; }
+        bool producesMidi() const override                      { return true; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+        void processBlock (AudioBuffer<float>&, MidiBuffer& midi) override
+        {
+            MidiBuffer transposed;
+            MidiBuffer::Iterator iter (midi);
+            MidiMessage message;
+            int position;
+
+            while (iter.getNextEvent (message, position))
+                transposed.addEvent (MidiMessage::noteOn (1, message.getNoteNumber() + amount, (uint8) 100), position);
+
+            midi.swapWith (transposed);
+        }
+
+        const int amount;
+    };
+
+    // the MIDI input goes straight to the MIDI output, and also through two transposers
+    MidiBuffer renderMidiTestGraph (int numRenderThreads)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        AudioProcessorGraph graph;
+        graph.setNumRenderThreads (numRenderThreads);
+        graph.setPlayConfigDetails (0, 0, 44100.0, 32);
+
+        auto input  = graph.addNode (new IOProcessor (IOProcessor::midiInputNode));
+        auto up1    = graph.addNode (new TransposeProcessor (1));
+        auto up2    = graph.addNode (new TransposeProcessor (2));
+        auto output = graph.addNode (new IOProcessor (IOProcessor::midiOutputNode));
+
+        const auto midiChannel = AudioProcessorGraph::midiChannelIndex;
+
+        for (auto node : { up1, up2 })
+        {
+            graph.addConnection ({ { input->nodeID, midiChannel }, { node->nodeID,   midiChannel } });
+            graph.addConnection ({ { node->nodeID,  midiChannel }, { output->nodeID, midiChannel } });
+        }
+
+        graph.addConnection ({ { input->nodeID, midiChannel }, { output->nodeID, midiChannel } });
+
+        graph.setNonRealtime (true);
+        graph.prepareToPlay (44100.0, 32);
+
+        AudioBuffer<float> audio (1, 32);
+        MidiBuffer midi;
+        midi.addEvent (MidiMessage::noteOn (1, 60, (uint8) 100), 0);
+        midi.addEvent (MidiMessage::noteOn (1, 64, (uint8) 100), 10);
+
+        graph.processBlock (audio, midi);
+        graph.releaseResources();
+        return midi;
+    }
+
+    // the input goes straight to the output, and also through a gain and a nested graph
+    // which contains another gain, optionally with a connection straight through it
+    AudioBuffer<float> renderNestedTestGraph (bool flatten, bool withThruConnection)
+    {
+        const int blockSize = 32;
+
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        auto* nestedGraph = new AudioProcessorGraph();
+        nestedGraph->setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+        auto nestedInput  = nestedGraph->addNode (new IOProcessor (IOProcessor::audioInputNode));
+        auto nestedGain   = nestedGraph->addNode (new GainProcessor (0.8f, 0));
+        auto nestedOutput = nestedGraph->addNode (new IOProcessor (IOProcessor::audioOutputNode));
+
+        AudioProcessorGraph graph;
+        graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+        graph.setFlattensNestedGraphs (flatten);
+
+        auto input  = graph.addNode (new IOProcessor (IOProcessor::audioInputNode));
+        auto gain   = graph.addNode (new GainProcessor (0.5f, 0));
+        auto nested = graph.addNode (nestedGraph);
+        auto output = graph.addNode (new IOProcessor (IOProcessor::audioOutputNode));
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            nestedGraph->addConnection ({ { nestedInput->nodeID, ch }, { nestedGain->nodeID, ch } });
+            nestedGraph->addConnection ({ { nestedGain->nodeID, ch },  { nestedOutput->nodeID, ch } });
+
+            graph.addConnection ({ { input->nodeID, ch },  { gain->nodeID, ch } });
+            graph.addConnection ({ { gain->nodeID, ch },   { nested->nodeID, ch } });
+            graph.addConnection ({ { nested->nodeID, ch }, { output->nodeID, ch } });
+            graph.addConnection ({ { input->nodeID, ch },  { output->nodeID, ch } });
+        }
+
+        graph.setNonRealtime (true);
+        graph.prepareToPlay (44100.0, blockSize);
+
+        AudioBuffer<float> result (2, blockSize);
+        MidiBuffer midi;
+
+        // changing the nested graph after it's been prepared must be picked up by the parent
+        if (withThruConnection)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                nestedGraph->addConnection ({ { nestedInput->nodeID, ch }, { nestedOutput->nodeID, ch } });
+
+            graph.releaseResources();
+            graph.prepareToPlay (44100.0, blockSize);
+        }
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                result.setSample (ch, i, (float) (i + ch));
+
+        graph.processBlock (result, midi);
+        graph.releaseResources();
+        return result;
+    }
+
+    AudioBuffer<float> renderTestGraph (int numRenderThreads, bool batchChanges = false)
+    {
+        const int blockSize = 64;
+
+        AudioProcessorGraph graph;
+        graph.setNumRenderThreads (numRenderThreads);
+        graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+        std::unique_ptr<AudioProcessorGraph::ScopedChangeBatch> batch;
+
+        if (batchChanges)
+            batch.reset (new AudioProcessorGraph::ScopedChangeBatch (graph));
+
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+        auto input  = graph.addNode (new IOProcessor (IOProcessor::audioInputNode));
+        auto output = graph.addNode (new IOProcessor (IOProcessor::audioOutputNode));
+
+        // several independent chains of different lengths and latencies, all mixed into the output
+        for (int chain = 0; chain < 6; ++chain)
+        {
+            auto previous = input;
+
+            for (int i = 0; i <= chain % 3; ++i)
+            {
+                auto node = graph.addNode (new GainProcessor (0.5f + 0.1f * (float) (chain + i), (chain * 3 + i) % 5));
+
+                for (int ch = 0; ch < 2; ++ch)
+                    graph.addConnection ({ { previous->nodeID, ch }, { node->nodeID, ch } });
+
+                previous = node;
+            }
+
+            for (int ch = 0; ch < 2; ++ch)
+                graph.addConnection ({ { previous->nodeID, ch }, { output->nodeID, ch } });
+        }
+
+        batch.reset();
+
+        graph.setNonRealtime (true);
+        graph.prepareToPlay (44100.0, blockSize);
+
+        AudioBuffer<float> result (2, blockSize * 8);
+        Random random (1234);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < result.getNumSamples(); ++i)
+                result.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+        MidiBuffer midi;
+
+        for (int start = 0; start < result.getNumSamples(); start += blockSize)
+        {
+            AudioBuffer<float> block (result.getArrayOfWritePointers(), 2, start, blockSize);
+            graph.processBlock (block, midi);
+        }
+
+        graph.releaseResources();
+        return result;
+    }
+};
+
+static AudioProcessorGraphTests audioProcessorGraphTests;
+
+#endif
+
 } // namespace juce
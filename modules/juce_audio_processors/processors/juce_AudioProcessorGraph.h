@@ -125,6 +125,48 @@ public:
         /** Tell this node to bypass processing. */
         void setBypassed (bool shouldBeBypassed) noexcept;
 
+        //==============================================================================
+        /** Describes the time that a node's processor has been taking to render its blocks.
+            @see getTimingStatistics, AudioProcessorGraph::setNodeTimingEnabled
+        */
+        struct JUCE_API  TimingStatistics
+        {
+            int numBlocks = 0;          /**< The number of recent blocks that these figures were calculated from. */
+            double minimumMs = 0;       /**< The quickest block, in milliseconds. */
+            double averageMs = 0;       /**< The mean time per block, in milliseconds. */
+            double maximumMs = 0;       /**< The slowest block, in milliseconds. */
+            double medianMs = 0;        /**< The 50th percentile of the block times, in milliseconds. */
+            double percentile95Ms = 0;  /**< The 95th percentile of the block times, in milliseconds. */
+            double percentile99Ms = 0;  /**< The 99th percentile of the block times, in milliseconds. */
+
+            /** Calculates the statistics for a set of block times, in milliseconds. */
+            static TimingStatistics fromBlockTimes (Array<float> timesInMs);
+        };
+
+        /** Returns statistics about how long this node's processor took to render its
+            most recent blocks.
+
+            This only contains any data if the graph has had node timing turned on with
+            AudioProcessorGraph::setNodeTimingEnabled(). The measurements are collected
+            on the audio thread without locking, so this can safely be called from the
+            message thread while the graph is playing.
+        */
+        TimingStatistics getTimingStatistics() const;
+
+        /** Returns the times, in milliseconds, that this node's processor took to render
+            each of its most recent blocks, oldest first.
+
+            Only a limited number of recent blocks are remembered, so to measure a longer
+            run, call this and then resetTimingStatistics() every few hundred blocks.
+            @see getTimingStatistics
+        */
+        Array<float> getRecentBlockTimes() const;
+
+        /** Discards the timing measurements that have been taken so far.
+            @see getTimingStatistics
+        */
+        void resetTimingStatistics() noexcept;
+
         //==============================================================================
         /** A convenient typedef for referring to a pointer to a node object. */
         using Ptr = ReferenceCountedObjectPtr<Node>;
@@ -132,6 +174,7 @@ public:
     private:
         //==============================================================================
         friend class AudioProcessorGraph;
+        template <typename FloatType> friend struct GraphRenderSequence;
 
         struct Connection
         {
@@ -147,9 +190,16 @@ public:
 
         Node (NodeID, AudioProcessor*) noexcept;
 
+        enum { timingHistorySize = 512 };
+        std::unique_ptr<std::atomic<float>[]> timingHistory;
+        std::atomic<uint32> numTimingsRecorded { 0 };
+        uint32 numTimingsAtLastReset = 0;
+
         void setParentGraph (AudioProcessorGraph*) const;
         void prepare (double newSampleRate, int newBlockSize, AudioProcessorGraph*, ProcessingPrecision);
         void unprepare();
+        void prepareTimingHistory();
+        void recordProcessingTime (float milliseconds) noexcept;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Node)
     };
@@ -272,6 +322,99 @@ public:
     */
     bool removeIllegalConnections();
 
+    //==============================================================================
+    /** Groups together a set of changes to the graph's nodes and connections.
+
+        Normally, every node or connection that gets added or removed causes the graph
+        to rebuild its rendering sequence. While a ScopedChangeBatch exists, these
+        rebuilds are deferred, and the sequence is only rebuilt once, when the last
+        batch object for the graph is deleted. This makes it much quicker to make
+        large numbers of changes at once, e.g.
+
+        @code
+        {
+            AudioProcessorGraph::ScopedChangeBatch batch (graph);
+
+            for (auto& c : connectionsToAdd)
+                graph.addConnection (c);
+        }
+        @endcode
+
+        These objects must only be created and deleted on the message thread.
+    */
+    class JUCE_API  ScopedChangeBatch
+    {
+    public:
+        /** Starts a batch of changes to the given graph. */
+        explicit ScopedChangeBatch (AudioProcessorGraph&) noexcept;
+
+        /** Ends the batch, rebuilding the graph's rendering sequence if anything changed. */
+        ~ScopedChangeBatch();
+
+    private:
+        AudioProcessorGraph& graph;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedChangeBatch)
+    };
+
+    //==============================================================================
+    /** Sets the number of extra real-time threads that the graph may use to render
+        independent nodes in parallel.
+
+        By default this is 0, and the whole graph is rendered serially on the thread
+        that calls processBlock(). When it's greater than 0, nodes which don't depend
+        on each other's output are dispatched to a pool of worker threads, and the
+        calling thread also takes part in the work. The buffer assignments and latency
+        compensation are identical to the serial mode, so the output is the same.
+
+        The processors in the graph must be happy to have their processBlock() methods
+        called from threads other than the one which is calling the graph's processBlock().
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of extra render threads that the graph is using.
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept;
+
+    //==============================================================================
+    /** Turns on or off the measurement of how long each node's processor takes to render.
+
+        When enabled, the graph reads a high-resolution timestamp before and after each
+        node is processed, and the results can be retrieved using Node::getTimingStatistics().
+        When disabled (the default), no measurement code is run at all.
+    */
+    void setNodeTimingEnabled (bool shouldMeasureNodeTimes);
+
+    /** Returns true if node timing measurement has been turned on.
+        @see setNodeTimingEnabled
+    */
+    bool isNodeTimingEnabled() const noexcept                       { return nodeTimingEnabled; }
+
+    //==============================================================================
+    /** Makes the graph render the contents of any nested AudioProcessorGraphs itself.
+
+        Normally, a graph that's used as a node in another graph renders its own nodes
+        in its own sequence, with its own buffers, and its audio and MIDI is copied in
+        and out through its AudioGraphIOProcessors. When this is turned on, the nodes of
+        every nested graph (and the graphs nested inside those) are inlined into this
+        graph's rendering sequence: the connections through their I/O nodes become
+        direct connections, all the nodes share this graph's buffers, and latency is
+        compensated across the whole hierarchy. Changes to the nested graphs make this
+        graph rebuild its sequence.
+
+        While a nested graph is being inlined its own processBlock() isn't called, so
+        processors that are subclasses of AudioProcessorGraph and override it won't work
+        as expected. A nested graph's node is only inlined if it wasn't bypassed when the
+        sequence was built.
+    */
+    void setFlattensNestedGraphs (bool shouldFlatten);
+
+    /** Returns true if nested graphs are being inlined into this one.
+        @see setFlattensNestedGraphs
+    */
+    bool isFlatteningNestedGraphs() const noexcept                  { return flattenNestedGraphs; }
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -393,15 +536,25 @@ private:
     std::unique_ptr<RenderSequenceFloat> renderSequenceFloat;
     std::unique_ptr<RenderSequenceDouble> renderSequenceDouble;
 
+    struct RenderThreadPool;
+    std::unique_ptr<RenderThreadPool> renderThreadPool;
+
     friend class AudioGraphIOProcessor;
 
     Atomic<int> isPrepared { 0 };
 
+    int changeBatchDepth = 0;
+    bool topologyChangedDuringBatch = false, nodeTimingEnabled = false, flattenNestedGraphs = false;
+
+    // The graph that this one is a node of, if any
+    AudioProcessorGraph* parentGraph = nullptr;
+
     void topologyChanged();
     void handleAsyncUpdate() override;
     void clearRenderingSequence();
     void buildRenderingSequence();
     bool anyNodesNeedPreparing() const noexcept;
+    bool isInlinedIntoParent() const noexcept;
     bool isConnected (Node* src, int sourceChannel, Node* dest, int destChannel) const noexcept;
     bool isAnInputTo (Node& src, Node& dst, int recursionCheck) const noexcept;
     bool canConnect (Node* src, int sourceChannel, Node* dest, int destChannel) const noexcept;
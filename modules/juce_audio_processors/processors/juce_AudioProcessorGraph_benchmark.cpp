@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class AudioProcessorGraphBenchmarks  : public Benchmark
+{
+public:
+    AudioProcessorGraphBenchmarks()  : Benchmark ("AudioProcessorGraph", "Audio") {}
+
+    void runBenchmark() override
+    {
+        const double sampleRate = 48000.0;
+        const int blockSize = 256;
+
+        for (int numChains : { 1, 8 })
+        {
+            AudioProcessorGraph graph;
+            graph.setPlayConfigDetails (2, 2, sampleRate, blockSize);
+
+            auto input  = graph.addNode (new AudioProcessorGraph::AudioGraphIOProcessor (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode));
+            auto output = graph.addNode (new AudioProcessorGraph::AudioGraphIOProcessor (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode));
+
+            // Several parallel chains of processors, all summed into the output
+            for (int chain = 0; chain < numChains; ++chain)
+            {
+                auto previous = input;
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    auto gain = graph.addNode (new GainProcessor());
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        graph.addConnection ({ { previous->nodeID, ch }, { gain->nodeID, ch } });
+
+                    previous = gain;
+                }
+
+                for (int ch = 0; ch < 2; ++ch)
+                    graph.addConnection ({ { previous->nodeID, ch }, { output->nodeID, ch } });
+            }
+
+            graph.prepareToPlay (sampleRate, blockSize);
+
+            AudioBuffer<float> buffer (2, blockSize);
+            MidiBuffer midi;
+
+            measure (String (numChains) + (numChains == 1 ? " chain" : " chains") + " of 4 processors", [&]
+            {
+                buffer.clear();
+                graph.processBlock (buffer, midi);
+                doNotOptimiseAway (buffer.getSample (0, 0));
+            });
+
+            graph.releaseResources();
+        }
+    }
+
+private:
+    struct GainProcessor  : public AudioProcessor
+    {
+        GainProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo()))
+        {}
+
+        const String getName() const override                   { return "Gain"; }
+        void prepareToPlay (double, int) override               {}
+        void releaseResources() override                        {}
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override    { buffer.applyGain (0.5f); }
+        double getTailLengthSeconds() const override            { return 0; }
+        bool acceptsMidi() const override                       { return false; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+    };
+};
+
+static AudioProcessorGraphBenchmarks audioProcessorGraphBenchmarks;
+
+} // namespace juce
@@ -290,8 +290,7 @@ private:
     friend class LegacyAudioParameter;
     AudioProcessor* processor = nullptr;
     int parameterIndex = -1;
-    CriticalSection listenerLock;
-    Array<Listener*> listeners;
+    LockFreeListenerArray<Listener> listeners;
     mutable StringArray valueStrings;
 
    #if JUCE_DEBUG
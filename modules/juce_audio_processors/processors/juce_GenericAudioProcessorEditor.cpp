@@ -27,9 +27,40 @@
 namespace juce
 {
 
+class ParameterListener;
+
+//==============================================================================
+/*  A single timer which refreshes all the parameter components that currently
+    exist. Only the rows that are visible in an editor have components, so this
+    stays cheap however many parameters the processor has.
+*/
+class ParameterRefreshTimer   : private Timer
+{
+public:
+    void add (ParameterListener* listener)
+    {
+        listeners.add (listener);
+
+        if (! isTimerRunning())
+            startTimerHz (30);
+    }
+
+    void remove (ParameterListener* listener)
+    {
+        listeners.removeFirstMatchingValue (listener);
+
+        if (listeners.isEmpty())
+            stopTimer();
+    }
+
+private:
+    void timerCallback() override;
+
+    Array<ParameterListener*> listeners;
+};
+
 class ParameterListener   : private AudioProcessorParameter::Listener,
-                            private AudioProcessorListener,
-                            private Timer
+                            private AudioProcessorListener
 {
 public:
     ParameterListener (AudioProcessor& proc, AudioProcessorParameter& param)
@@ -40,11 +71,13 @@ public:
         else
             parameter.addListener (this);
 
-        startTimer (100);
+        refreshTimer->add (this);
     }
 
     ~ParameterListener() override
     {
+        refreshTimer->remove (this);
+
         if (LegacyAudioParameter::isLegacy (&parameter))
             processor.removeListener (this);
         else
@@ -58,6 +91,14 @@ public:
 
     virtual void handleNewParameterValue() = 0;
 
+    // Called by the shared timer, so that however quickly the value changes, the
+    // component only gets updated once per timer tick
+    void refreshIfValueHasChanged()
+    {
+        if (parameterValueHasChanged.compareAndSetBool (0, 1))
+            handleNewParameterValue();
+    }
+
 private:
     //==============================================================================
     void parameterValueChanged (int, float) override
@@ -77,26 +118,21 @@ private:
     void audioProcessorChanged (AudioProcessor*) override {}
 
     //==============================================================================
-    void timerCallback() override
-    {
-        if (parameterValueHasChanged.compareAndSetBool (0, 1))
-        {
-            handleNewParameterValue();
-            startTimerHz (50);
-        }
-        else
-        {
-            startTimer (jmin (250, getTimerInterval() + 10));
-        }
-    }
-
     AudioProcessor& processor;
     AudioProcessorParameter& parameter;
     Atomic<int> parameterValueHasChanged { 0 };
+    SharedResourcePointer<ParameterRefreshTimer> refreshTimer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterListener)
 };
 
+void ParameterRefreshTimer::timerCallback()
+{
+    for (int i = listeners.size(); --i >= 0;)
+        if (auto* listener = listeners[i])
+            listener->refreshIfValueHasChanged();
+}
+
 class BooleanParameterComponent final   : public Component,
                                           private ParameterListener
 {
@@ -411,8 +447,8 @@ private:
 class ParameterDisplayComponent   : public Component
 {
 public:
-    ParameterDisplayComponent (AudioProcessor& processor, AudioProcessorParameter& param)
-        : parameter (param)
+    ParameterDisplayComponent (AudioProcessor& processor, AudioProcessorParameter& param, int indentDepth)
+        : parameter (param), indent (indentDepth * indentPerGroup)
     {
         parameterName.setText (parameter.getName (128), dontSendNotification);
         parameterName.setJustificationType (Justification::centredRight);
@@ -457,52 +493,127 @@ public:
     void resized() override
     {
         auto area = getLocalBounds();
+        area.removeFromLeft (indent);
 
         parameterName.setBounds (area.removeFromLeft (100));
         parameterLabel.setBounds (area.removeFromRight (50));
         parameterComp->setBounds (area);
     }
 
+    AudioProcessorParameter& getParameter() const noexcept      { return parameter; }
+
+    enum { indentPerGroup = 12 };
+
 private:
     AudioProcessorParameter& parameter;
+    const int indent;
     Label parameterName, parameterLabel;
     std::unique_ptr<Component> parameterComp;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterDisplayComponent)
 };
 
-class ParametersPanel   : public Component
+//==============================================================================
+/*  Presents the parameters as rows of a ListBox, so that only the rows which are
+    on screen have components, and these get recreated as the list is scrolled.
+    When the processor's parameters are organised into groups, each group gets a
+    heading row and its parameters are indented beneath it.
+*/
+class ParameterListModel   : public ListBoxModel
 {
 public:
-    ParametersPanel (AudioProcessor& processor, const Array<AudioProcessorParameter*>& parameters)
+    ParameterListModel (AudioProcessor& p, const LegacyAudioParametersWrapper& parameters)
+        : processor (p)
     {
-        for (auto* param : parameters)
-            if (param->isAutomatable())
-                addAndMakeVisible (paramComponents.add (new ParameterDisplayComponent (processor, *param)));
-
-        if (auto* comp = paramComponents[0])
-            setSize (comp->getWidth(), comp->getHeight() * paramComponents.size());
+        if (parameters.isUsingManagedParameters())
+        {
+            addRows (processor.getParameterTree(), 0);
+        }
         else
-            setSize (400, 100);
+        {
+            for (auto* param : parameters.params)
+                if (param->isAutomatable())
+                    rows.add ({ param, {}, 0 });
+        }
     }
 
-    void paint (Graphics& g) override
+    int getNumRows() override
     {
-        g.fillAll (getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
+        return rows.size();
     }
 
-    void resized() override
+    void paintListBoxItem (int rowNumber, Graphics& g, int width, int height, bool) override
     {
-        auto area = getLocalBounds();
+        if (isPositiveAndBelow (rowNumber, rows.size()))
+        {
+            auto& row = rows.getReference (rowNumber);
+
+            if (row.parameter == nullptr)
+            {
+                auto indent = row.depth * (int) ParameterDisplayComponent::indentPerGroup;
+
+                g.setColour (LookAndFeel::getDefaultLookAndFeel().findColour (Label::textColourId));
+                g.setFont (Font ((float) height * 0.45f, Font::bold));
+                g.drawFittedText (row.groupName, indent + 8, 0, width - indent - 16, height, Justification::centredLeft, 1);
+            }
+        }
+    }
+
+    Component* refreshComponentForRow (int rowNumber, bool, Component* existingComponentToUpdate) override
+    {
+        std::unique_ptr<Component> existing (existingComponentToUpdate);
+
+        if (! isPositiveAndBelow (rowNumber, rows.size()))
+            return nullptr;
 
-        for (auto* comp : paramComponents)
-            comp->setBounds (area.removeFromTop (comp->getHeight()));
+        auto& row = rows.getReference (rowNumber);
+
+        if (row.parameter == nullptr)
+            return nullptr;
+
+        if (auto* display = dynamic_cast<ParameterDisplayComponent*> (existing.get()))
+            if (&display->getParameter() == row.parameter)
+                return existing.release();
+
+        existing.reset();
+        return new ParameterDisplayComponent (processor, *row.parameter, row.depth);
     }
 
 private:
-    OwnedArray<ParameterDisplayComponent> paramComponents;
+    struct Row
+    {
+        AudioProcessorParameter* parameter;
+        String groupName;
+        int depth;
+    };
+
+    void addRows (const AudioProcessorParameterGroup& group, int depth)
+    {
+        for (auto* node : group)
+        {
+            if (auto* param = node->getParameter())
+            {
+                if (param->isAutomatable())
+                    rows.add ({ param, {}, depth });
+            }
+            else if (auto* subgroup = node->getGroup())
+            {
+                auto headingIndex = rows.size();
+                rows.add ({ nullptr, subgroup->getName(), depth });
 
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParametersPanel)
+                addRows (*subgroup, depth + 1);
+
+                // don't leave a heading for a group with nothing visible in it
+                if (rows.size() == headingIndex + 1)
+                    rows.removeLast();
+            }
+        }
+    }
+
+    AudioProcessor& processor;
+    Array<Row> rows;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterListModel)
 };
 
 //==============================================================================
@@ -515,20 +626,30 @@ struct GenericAudioProcessorEditor::Pimpl
         jassert (p != nullptr);
 
         juceParameters.update (*p, false);
+        model.reset (new ParameterListModel (*p, juceParameters));
 
         owner.setOpaque (true);
 
-        view.setViewedComponent (new ParametersPanel (*p, juceParameters.params));
-        owner.addAndMakeVisible (view);
+        list.setModel (model.get());
+        list.setRowHeight (rowHeight);
+        list.setOutlineThickness (0);
+        list.setColour (ListBox::backgroundColourId, owner.getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
+        list.getViewport()->setScrollBarsShown (true, false);
+        owner.addAndMakeVisible (list);
+    }
 
-        view.setScrollBarsShown (true, false);
+    int getTotalHeight() const
+    {
+        return jmax (100, model->getNumRows() * rowHeight);
     }
 
+    enum { rowHeight = 40, rowWidth = 400 };
 
     //==============================================================================
     GenericAudioProcessorEditor& owner;
     LegacyAudioParametersWrapper juceParameters;
-    Viewport view;
+    std::unique_ptr<ParameterListModel> model;
+    ListBox list;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
@@ -538,8 +659,8 @@ struct GenericAudioProcessorEditor::Pimpl
 GenericAudioProcessorEditor::GenericAudioProcessorEditor (AudioProcessor* const p)
     : AudioProcessorEditor (p), pimpl (new Pimpl (*this))
 {
-    setSize (pimpl->view.getViewedComponent()->getWidth() + pimpl->view.getVerticalScrollBar().getWidth(),
-             jmin (pimpl->view.getViewedComponent()->getHeight(), 400));
+    setSize (Pimpl::rowWidth + pimpl->list.getViewport()->getScrollBarThickness(),
+             jmin (pimpl->getTotalHeight(), 400));
 }
 
 GenericAudioProcessorEditor::~GenericAudioProcessorEditor() {}
@@ -551,7 +672,7 @@ void GenericAudioProcessorEditor::paint (Graphics& g)
 
 void GenericAudioProcessorEditor::resized()
 {
-    pimpl->view.setBounds (getLocalBounds());
+    pimpl->list.setBounds (getLocalBounds());
 }
 
 } // namespace juce
@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A list of listener pointers which can be called from a realtime thread.
+
+    Calling the listeners never takes a lock or allocates: it iterates an immutable
+    snapshot of the list, and adding or removing a listener builds a new snapshot and
+    swaps it in atomically. Snapshots that have been replaced are only deleted once no
+    thread can still be iterating them.
+
+    remove() waits until any calls which are in progress on other threads have finished,
+    so once it returns the listener will not be called again and can safely be deleted.
+    It's fine to add or remove listeners from inside a callback.
+
+    This is used by AudioProcessor and AudioProcessorParameter so that automation can
+    notify listeners from the audio thread while the GUI is attaching and detaching them.
+
+    @tags{Audio}
+*/
+template <typename ListenerType>
+class LockFreeListenerArray
+{
+public:
+    //==============================================================================
+    LockFreeListenerArray() = default;
+
+    ~LockFreeListenerArray()
+    {
+        // The array is being deleted while a thread is still calling its listeners!
+        jassert (numReaders.load() == 0);
+
+        delete current.load();
+    }
+
+    //==============================================================================
+    /** Adds a listener, if it isn't already in the list. */
+    void add (ListenerType* listener)
+    {
+        const ScopedLock sl (writeLock);
+        auto* oldSnapshot = current.load();
+
+        if (listener == nullptr || (oldSnapshot != nullptr && oldSnapshot->contains (listener)))
+            return;
+
+        std::unique_ptr<Snapshot> newSnapshot (oldSnapshot != nullptr ? new Snapshot (*oldSnapshot)
+                                                                      : new Snapshot());
+        newSnapshot->add (listener);
+        swapSnapshot (newSnapshot.release());
+    }
+
+    /** Removes a listener, waiting for any calls on other threads to finish. */
+    void remove (ListenerType* listener)
+    {
+        const ScopedLock sl (writeLock);
+        auto* oldSnapshot = current.load();
+
+        if (oldSnapshot == nullptr || ! oldSnapshot->contains (listener))
+            return;
+
+        std::unique_ptr<Snapshot> newSnapshot (new Snapshot (*oldSnapshot));
+        newSnapshot->removeFirstMatchingValue (listener);
+        swapSnapshot (newSnapshot.release());
+
+        waitForReadersOnOtherThreads();
+        deleteRetiredSnapshotsIfUnused();
+    }
+
+    /** Returns the number of listeners. */
+    int size() const noexcept
+    {
+        const ScopedReader reader (*this);
+
+        if (auto* snapshot = current.load())
+            return snapshot->size();
+
+        return 0;
+    }
+
+    /** Calls a function for each listener, in the reverse of the order they were added.
+
+        This is wait-free. Listeners that are removed by another listener during the
+        iteration won't be called.
+    */
+    template <typename Callback>
+    void call (Callback&& callback) const
+    {
+        const ScopedReader reader (*this);
+
+        if (auto* snapshot = current.load())
+        {
+            for (int i = snapshot->size(); --i >= 0;)
+            {
+                auto* listener = snapshot->getUnchecked (i);
+                auto* latest = current.load();
+
+                if (latest == snapshot || (latest != nullptr && latest->contains (listener)))
+                    callback (*listener);
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    using Snapshot = Array<ListenerType*>;
+
+    struct ReaderSlot
+    {
+        std::atomic<Thread::ThreadID> thread { nullptr };
+        int depth = 0;
+    };
+
+    struct ScopedReader
+    {
+        explicit ScopedReader (const LockFreeListenerArray& ownerIn) noexcept  : owner (ownerIn)
+        {
+            ++owner.numReaders;
+
+            // Each thread records how deeply it's nested, so that a listener which removes
+            // itself from inside a callback doesn't end up waiting for its own thread
+            auto thisThread = Thread::getCurrentThreadId();
+
+            for (auto& s : owner.readerSlots)
+                if (s.thread.load() == thisThread)
+                    slot = &s;
+
+            for (auto& s : owner.readerSlots)
+            {
+                if (slot != nullptr)
+                    break;
+
+                Thread::ThreadID expected = nullptr;
+
+                if (s.thread.compare_exchange_strong (expected, thisThread))
+                    slot = &s;
+            }
+
+            // More threads are calling this array at once than there are slots, so
+            // removing a listener from inside a callback could deadlock
+            jassert (slot != nullptr);
+
+            if (slot != nullptr)
+                ++slot->depth;
+        }
+
+        ~ScopedReader() noexcept
+        {
+            if (slot != nullptr && --slot->depth == 0)
+                slot->thread = nullptr;
+
+            --owner.numReaders;
+        }
+
+        const LockFreeListenerArray& owner;
+        ReaderSlot* slot = nullptr;
+    };
+
+    void swapSnapshot (Snapshot* newSnapshot)
+    {
+        if (auto* oldSnapshot = current.exchange (newSnapshot))
+            retiredSnapshots.add (oldSnapshot);
+
+        deleteRetiredSnapshotsIfUnused();
+    }
+
+    void deleteRetiredSnapshotsIfUnused()
+    {
+        // A reader registers itself before loading the current snapshot, so if there are
+        // none now, nobody can be holding one of the retired ones
+        if (numReaders.load() == 0)
+            retiredSnapshots.clear();
+    }
+
+    void waitForReadersOnOtherThreads() const
+    {
+        auto thisThread = Thread::getCurrentThreadId();
+        int ownDepth = 0;
+
+        for (auto& s : readerSlots)
+            if (s.thread.load() == thisThread)
+                ownDepth = s.depth;
+
+        while (numReaders.load() > ownDepth)
+            Thread::yield();
+    }
+
+    //==============================================================================
+    enum { maxReaderThreads = 8 };
+
+    std::atomic<Snapshot*> current { nullptr };
+    mutable std::atomic<int> numReaders { 0 };
+    mutable ReaderSlot readerSlots[maxReaderThreads];
+    OwnedArray<Snapshot> retiredSnapshots;
+    CriticalSection writeLock;
+
+    JUCE_DECLARE_NON_COPYABLE (LockFreeListenerArray)
+};
+
+} // namespace juce
@@ -0,0 +1,343 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static MemoryBlock createMessageFromXml (const XmlElement& xml)
+{
+    auto text = xml.createDocument ({}, true, false);
+    return { text.toRawUTF8(), text.getNumBytesAsUTF8() };
+}
+
+//==============================================================================
+struct OutOfProcessPluginScanner::Worker  : public ChildProcessMaster
+{
+    Worker() = default;
+
+    ~Worker() override
+    {
+        // This has to happen before our members are deleted, as the connection
+        // may still be calling back into them
+        killSlaveProcess();
+    }
+
+    enum class Result { ok, crashed, timedOut, cancelled };
+
+    bool ensureRunning (const File& executable, const String& commandLineID)
+    {
+        if (! isRunning)
+            isRunning = launchSlaveProcess (executable, commandLineID, 0, 0);
+
+        return isRunning;
+    }
+
+    void stop()
+    {
+        killSlaveProcess();
+        isRunning = false;
+    }
+
+    Result scan (const String& formatName, const String& fileOrIdentifier,
+                 OwnedArray<PluginDescription>& results, int timeoutMs,
+                 const KnownPluginList::CustomScanner& owner)
+    {
+        {
+            const ScopedLock sl (replyLock);
+            reply.reset();
+            connectionLost = false;
+        }
+
+        replyReceived.reset();
+
+        XmlElement request ("SCAN");
+        request.setAttribute ("format", formatName);
+        request.setAttribute ("identifier", fileOrIdentifier);
+
+        if (! sendMessageToSlave (createMessageFromXml (request)))
+        {
+            stop();
+            return Result::crashed;
+        }
+
+        auto startTime = Time::getMillisecondCounter();
+
+        for (;;)
+        {
+            replyReceived.wait (100);
+
+            {
+                const ScopedLock sl (replyLock);
+
+                if (reply != nullptr)
+                {
+                    forEachXmlChildElement (*reply, e)
+                    {
+                        PluginDescription desc;
+
+                        if (desc.loadFromXml (*e))
+                            results.add (new PluginDescription (desc));
+                    }
+
+                    return Result::ok;
+                }
+
+                if (connectionLost)
+                {
+                    stop();
+                    return Result::crashed;
+                }
+            }
+
+            if (owner.shouldExit())
+            {
+                stop();
+                return Result::cancelled;
+            }
+
+            if (Time::getMillisecondCounter() - startTime > (uint32) timeoutMs)
+            {
+                stop();
+                return Result::timedOut;
+            }
+        }
+    }
+
+    void handleMessageFromSlave (const MemoryBlock& message) override
+    {
+        auto xml = parseXML (message.toString());
+
+        if (xml != nullptr && xml->hasTagName ("SCANRESULT"))
+        {
+            const ScopedLock sl (replyLock);
+            reply = std::move (xml);
+        }
+
+        replyReceived.signal();
+    }
+
+    void handleConnectionLost() override
+    {
+        {
+            const ScopedLock sl (replyLock);
+            connectionLost = true;
+        }
+
+        replyReceived.signal();
+    }
+
+    bool busy = false, isRunning = false;
+
+private:
+    std::unique_ptr<XmlElement> reply;
+    bool connectionLost = false;
+    CriticalSection replyLock;
+    WaitableEvent replyReceived;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (const File& workerExecutable,
+                                                      const String& commandLineUniqueID,
+                                                      int maxNumWorkers,
+                                                      int scanTimeoutMs)
+    : executable (workerExecutable),
+      commandLineID (commandLineUniqueID),
+      maxWorkers (jmax (1, maxNumWorkers)),
+      timeoutMs (scanTimeoutMs)
+{
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner()
+{
+    const ScopedLock sl (workerLock);
+
+    // The scanner is being deleted while a scan is still using it!
+    jassert (std::none_of (workers.begin(), workers.end(), [] (Worker* w) { return w->busy; }));
+
+    workers.clear();
+}
+
+OutOfProcessPluginScanner::Worker* OutOfProcessPluginScanner::acquireWorker()
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (workerLock);
+
+            for (auto* w : workers)
+            {
+                if (! w->busy)
+                {
+                    w->busy = true;
+                    return w;
+                }
+            }
+
+            if (workers.size() < maxWorkers)
+            {
+                auto* w = workers.add (new Worker());
+                w->busy = true;
+                return w;
+            }
+        }
+
+        if (shouldExit())
+            return nullptr;
+
+        workerReleased.wait (100);
+    }
+}
+
+void OutOfProcessPluginScanner::releaseWorker (Worker* w)
+{
+    {
+        const ScopedLock sl (workerLock);
+        w->busy = false;
+    }
+
+    workerReleased.signal();
+}
+
+bool OutOfProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& result,
+                                                    const String& fileOrIdentifier)
+{
+    auto* worker = acquireWorker();
+
+    if (worker == nullptr)
+        return true;
+
+    if (! worker->ensureRunning (executable, commandLineID))
+    {
+        // The worker executable couldn't be launched, or didn't call
+        // WorkerProcess::initialiseFromCommandLine() with the same ID
+        jassertfalse;
+        releaseWorker (worker);
+        return true;
+    }
+
+    auto outcome = worker->scan (format.getName(), fileOrIdentifier, result, timeoutMs, *this);
+    releaseWorker (worker);
+
+    // Only a plugin which actually crashed or hung should get blacklisted
+    return outcome == Worker::Result::ok || outcome == Worker::Result::cancelled;
+}
+
+void OutOfProcessPluginScanner::scanFinished()
+{
+    const ScopedLock sl (workerLock);
+
+    for (int i = workers.size(); --i >= 0;)
+        if (! workers.getUnchecked (i)->busy)
+            workers.remove (i);
+}
+
+//==============================================================================
+OutOfProcessPluginScanner::WorkerProcess::WorkerProcess (AudioPluginFormatManager& manager)
+    : formatManager (manager)
+{
+}
+
+OutOfProcessPluginScanner::WorkerProcess::~WorkerProcess()
+{
+    shuttingDown.signal();
+    cancelPendingUpdate();
+}
+
+bool OutOfProcessPluginScanner::WorkerProcess::initialiseFromCommandLine (const String& commandLine,
+                                                                          const String& commandLineUniqueID)
+{
+    return ChildProcessSlave::initialiseFromCommandLine (commandLine, commandLineUniqueID);
+}
+
+void OutOfProcessPluginScanner::WorkerProcess::handleMessageFromMaster (const MemoryBlock& message)
+{
+    auto xml = parseXML (message.toString());
+
+    if (xml != nullptr && xml->hasTagName ("SCAN"))
+    {
+        {
+            const ScopedLock sl (requestLock);
+            pendingRequests.add (xml.release());
+        }
+
+        // Plugins generally expect to be loaded on the message thread
+        triggerAsyncUpdate();
+    }
+}
+
+void OutOfProcessPluginScanner::WorkerProcess::handleAsyncUpdate()
+{
+    for (;;)
+    {
+        std::unique_ptr<XmlElement> request;
+
+        {
+            const ScopedLock sl (requestLock);
+
+            if (pendingRequests.isEmpty())
+                return;
+
+            request.reset (pendingRequests.removeAndReturn (0));
+        }
+
+        auto formatName = request->getStringAttribute ("format");
+        XmlElement result ("SCANRESULT");
+
+        for (int i = 0; i < formatManager.getNumFormats(); ++i)
+        {
+            auto* format = formatManager.getFormat (i);
+
+            if (format->getName() == formatName)
+            {
+                OwnedArray<PluginDescription> found;
+                format->findAllTypesForFile (found, request->getStringAttribute ("identifier"));
+
+                for (auto* desc : found)
+                    result.addChildElement (desc->createXml());
+
+                break;
+            }
+        }
+
+        sendMessageToMaster (createMessageFromXml (result));
+    }
+}
+
+void OutOfProcessPluginScanner::WorkerProcess::handleConnectionLost()
+{
+    if (JUCEApplicationBase::getInstance() != nullptr)
+        JUCEApplicationBase::quit();
+
+    // If the message thread is stuck inside a plugin that has hung, the app won't be able
+    // to quit normally, so give it a few seconds and then kill the process
+    if (! MessageManager::existsAndIsCurrentThread() && ! shuttingDown.wait (5000))
+        Process::terminate();
+}
+
+} // namespace juce
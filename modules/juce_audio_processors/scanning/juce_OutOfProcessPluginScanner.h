@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A KnownPluginList::CustomScanner which loads each plugin in a separate
+    worker process, so that a plugin which crashes or hangs during scanning can't
+    take the host down with it.
+
+    Up to maxNumWorkers child processes are launched as they're needed, and each
+    thread that asks for a scan is handed an idle one, so the scan runs in parallel
+    when it's driven from several threads - e.g. with
+    PluginListComponent::setNumberOfThreadsForScanning(). A worker which crashes
+    or doesn't answer within the timeout is killed and replaced, and the file it
+    was scanning gets blacklisted by the KnownPluginList.
+
+    The worker executable is normally your own app, launched with a special
+    command line. Its start-up code must check for this before doing anything
+    else, and if it's been launched as a worker, keep a WorkerProcess alive until
+    it quits, e.g.
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<OutOfProcessPluginScanner::WorkerProcess> (formatManager);
+
+        if (worker->initialiseFromCommandLine (commandLine, "myPluginScanner"))
+        {
+            scannerWorker = std::move (worker);
+            return;
+        }
+
+        ...normal start-up...
+        knownPluginList.setCustomScanner (new OutOfProcessPluginScanner (File::getSpecialLocation (File::currentExecutableFile),
+                                                                         "myPluginScanner"));
+    }
+    @endcode
+
+    @see KnownPluginList::setCustomScanner, PluginScanCache
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginScanner  : public KnownPluginList::CustomScanner
+{
+public:
+    //==============================================================================
+    /** Creates a scanner.
+
+        @param workerExecutable         the executable to launch for each worker process
+        @param commandLineUniqueID      an ID that the workers will look for on their command
+                                        line, which must match the one passed to
+                                        WorkerProcess::initialiseFromCommandLine()
+        @param maxNumWorkers            the maximum number of worker processes to run at once
+        @param scanTimeoutMs            how long a worker is given to scan a single file before
+                                        it's assumed to have hung
+    */
+    OutOfProcessPluginScanner (const File& workerExecutable,
+                               const String& commandLineUniqueID,
+                               int maxNumWorkers = SystemStats::getNumCpus(),
+                               int scanTimeoutMs = 60000);
+
+    /** Destructor. */
+    ~OutOfProcessPluginScanner() override;
+
+    //==============================================================================
+    /** @internal */
+    bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void scanFinished() override;
+
+    //==============================================================================
+    /**
+        The object that does the scanning inside a worker process.
+
+        Create one of these in the worker's start-up code and call
+        initialiseFromCommandLine(). It scans each file that it's asked to on
+        the message thread, using the formats in the AudioPluginFormatManager,
+        and quits the app when the scanner disconnects.
+    */
+    class JUCE_API  WorkerProcess  : private ChildProcessSlave,
+                                     private AsyncUpdater
+    {
+    public:
+        /** Creates a worker which will use the given formats to scan files. */
+        explicit WorkerProcess (AudioPluginFormatManager& formatManager);
+
+        /** Destructor. */
+        ~WorkerProcess() override;
+
+        /** Checks the command line to see whether this process was launched by an
+            OutOfProcessPluginScanner, and if so, connects to it.
+
+            Returns true if this process is a worker.
+        */
+        bool initialiseFromCommandLine (const String& commandLine, const String& commandLineUniqueID);
+
+    private:
+        void handleMessageFromMaster (const MemoryBlock&) override;
+        void handleConnectionLost() override;
+        void handleAsyncUpdate() override;
+
+        AudioPluginFormatManager& formatManager;
+        OwnedArray<XmlElement> pendingRequests;
+        CriticalSection requestLock;
+        WaitableEvent shuttingDown;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerProcess)
+    };
+
+private:
+    //==============================================================================
+    struct Worker;
+
+    Worker* acquireWorker();
+    void releaseWorker (Worker*);
+
+    const File executable;
+    const String commandLineID;
+    const int maxWorkers, timeoutMs;
+
+    OwnedArray<Worker> workers;
+    CriticalSection workerLock;
+    WaitableEvent workerReleased;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
+
+} // namespace juce
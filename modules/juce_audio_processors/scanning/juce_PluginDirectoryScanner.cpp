@@ -96,6 +96,19 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
 
             OwnedArray<PluginDescription> typesFound;
 
+            if (scanCache != nullptr && ! list.getBlacklistedFiles().contains (file)
+                 && scanCache->getCachedTypes (format, file, typesFound))
+            {
+                for (auto* desc : typesFound)
+                    list.addType (*desc);
+
+                if (typesFound.size() == 0)
+                    failedFiles.add (file);
+
+                updateProgress();
+                return index > 0;
+            }
+
             // Add this plugin to the end of the dead-man's pedal list in case it crashes...
             auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
             crashedPlugins.removeString (file);
@@ -108,8 +121,14 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
             crashedPlugins.removeString (file);
             setDeadMansPedalFile (crashedPlugins);
 
-            if (typesFound.size() == 0 && ! list.getBlacklistedFiles().contains (file))
-                failedFiles.add (file);
+            if (! list.getBlacklistedFiles().contains (file))
+            {
+                if (scanCache != nullptr)
+                    scanCache->addResult (format, file, typesFound);
+
+                if (typesFound.size() == 0)
+                    failedFiles.add (file);
+            }
         }
     }
 
@@ -80,6 +80,15 @@ public:
     */
     void setFilesOrIdentifiersToScan (const StringArray& filesOrIdentifiersToScan);
 
+    /** Gives the scanner a cache of earlier scan results to use.
+
+        Files which the cache has an up-to-date entry for will have their types
+        added to the list straight from the cache instead of being loaded, and
+        the results of files that do get scanned are added to it. The cache isn't
+        owned by the scanner, and must stay alive for as long as it's in use.
+    */
+    void setScanCache (PluginScanCache* cacheToUse) noexcept        { scanCache = cacheToUse; }
+
     /** Tries the next likely-looking file.
 
         If dontRescanIfAlreadyInList is true, then the file will only be loaded and
@@ -126,6 +135,7 @@ private:
     StringArray filesOrIdentifiersToScan;
     File deadMansPedalFile;
     StringArray failedFiles;
+    PluginScanCache* scanCache = nullptr;
     Atomic<int> nextIndex;
     float progress = 0;
     const bool allowAsync;
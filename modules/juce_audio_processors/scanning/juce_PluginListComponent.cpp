@@ -193,6 +193,11 @@ void PluginListComponent::setNumberOfThreadsForScanning (int num)
     numThreads = num;
 }
 
+void PluginListComponent::setScanCache (PluginScanCache* cacheToUse)
+{
+    scanCache = cacheToUse;
+}
+
 void PluginListComponent::resized()
 {
     auto r = getLocalBounds().reduced (2);
@@ -485,6 +490,8 @@ private:
         scanner.reset (new PluginDirectoryScanner (owner.list, formatToScan, pathList.getPath(),
                                                    true, owner.deadMansPedalFile, allowAsync));
 
+        scanner->setScanCache (owner.scanCache);
+
         if (! filesOrIdentifiersToScan.isEmpty())
         {
             scanner->setFilesOrIdentifiersToScan (filesOrIdentifiersToScan);
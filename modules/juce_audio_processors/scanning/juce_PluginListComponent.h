@@ -69,6 +69,12 @@ public:
      be zero (it is one by default). */
     void setNumberOfThreadsForScanning (int numThreads);
 
+    /** Sets a cache of earlier scan results for future scans to use.
+        The cache isn't owned by the component, and must outlive it.
+        @see PluginDirectoryScanner::setScanCache
+    */
+    void setScanCache (PluginScanCache* cacheToUse);
+
     /** Returns the last search path stored in a given properties file for the specified format. */
     static FileSearchPath getLastSearchPath (PropertiesFile&, AudioPluginFormat&);
 
@@ -108,6 +114,7 @@ private:
     String dialogTitle, dialogText;
     bool allowAsync;
     int numThreads;
+    PluginScanCache* scanCache = nullptr;
 
     class TableModel;
     std::unique_ptr<TableListBoxModel> tableModel;
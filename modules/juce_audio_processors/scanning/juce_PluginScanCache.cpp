@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+PluginScanCache::PluginScanCache()  {}
+PluginScanCache::~PluginScanCache() {}
+
+String PluginScanCache::createKey (const String& formatName, const String& fileOrIdentifier)
+{
+    return formatName + ":" + fileOrIdentifier;
+}
+
+bool PluginScanCache::getFileStamp (const String& fileOrIdentifier, int64& modificationTime, int64& fileSize)
+{
+    if (! File::isAbsolutePath (fileOrIdentifier))
+        return false;
+
+    const File file (fileOrIdentifier);
+
+    if (! file.exists())
+        return false;
+
+    modificationTime = file.getLastModificationTime().toMilliseconds();
+    fileSize = file.getSize();
+    return true;
+}
+
+//==============================================================================
+bool PluginScanCache::getCachedTypes (const AudioPluginFormat& format,
+                                      const String& fileOrIdentifier,
+                                      OwnedArray<PluginDescription>& results) const
+{
+    int64 modificationTime, fileSize;
+
+    if (! getFileStamp (fileOrIdentifier, modificationTime, fileSize))
+        return false;
+
+    const ScopedLock sl (lock);
+
+    auto it = entries.find (createKey (format.getName(), fileOrIdentifier));
+
+    if (it == entries.end())
+        return false;
+
+    auto& entry = *it->second;
+
+    if (entry.modificationTime != modificationTime || entry.fileSize != fileSize)
+        return false;
+
+    for (auto* type : entry.types)
+        results.add (new PluginDescription (*type));
+
+    return true;
+}
+
+void PluginScanCache::addResult (const AudioPluginFormat& format,
+                                 const String& fileOrIdentifier,
+                                 const OwnedArray<PluginDescription>& typesFound)
+{
+    std::unique_ptr<Entry> entry (new Entry());
+
+    if (! getFileStamp (fileOrIdentifier, entry->modificationTime, entry->fileSize))
+        return;
+
+    for (auto* type : typesFound)
+        entry->types.add (new PluginDescription (*type));
+
+    const ScopedLock sl (lock);
+    entries[createKey (format.getName(), fileOrIdentifier)] = std::move (entry);
+}
+
+void PluginScanCache::removeResult (const AudioPluginFormat& format, const String& fileOrIdentifier)
+{
+    const ScopedLock sl (lock);
+    entries.erase (createKey (format.getName(), fileOrIdentifier));
+}
+
+void PluginScanCache::clear()
+{
+    const ScopedLock sl (lock);
+    entries.clear();
+}
+
+int PluginScanCache::getNumEntries() const
+{
+    const ScopedLock sl (lock);
+    return (int) entries.size();
+}
+
+//==============================================================================
+XmlElement* PluginScanCache::createXml() const
+{
+    auto e = new XmlElement ("PLUGINSCANCACHE");
+
+    const ScopedLock sl (lock);
+
+    for (auto& item : entries)
+    {
+        auto* fileElement = e->createNewChildElement ("FILE");
+        fileElement->setAttribute ("key", item.first);
+        fileElement->setAttribute ("modified", String (item.second->modificationTime));
+        fileElement->setAttribute ("size", String (item.second->fileSize));
+
+        for (auto* type : item.second->types)
+            fileElement->addChildElement (type->createXml());
+    }
+
+    return e;
+}
+
+void PluginScanCache::restoreFromXml (const XmlElement& xml)
+{
+    const ScopedLock sl (lock);
+    entries.clear();
+
+    if (! xml.hasTagName ("PLUGINSCANCACHE"))
+        return;
+
+    forEachXmlChildElementWithTagName (xml, fileElement, "FILE")
+    {
+        std::unique_ptr<Entry> entry (new Entry());
+        entry->modificationTime = fileElement->getStringAttribute ("modified").getLargeIntValue();
+        entry->fileSize         = fileElement->getStringAttribute ("size").getLargeIntValue();
+
+        forEachXmlChildElement (*fileElement, typeElement)
+        {
+            PluginDescription type;
+
+            if (type.loadFromXml (*typeElement))
+                entry->types.add (new PluginDescription (type));
+        }
+
+        entries[fileElement->getStringAttribute ("key")] = std::move (entry);
+    }
+}
+
+} // namespace juce
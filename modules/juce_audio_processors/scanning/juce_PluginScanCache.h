@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Remembers which plugin types were found in each file that has been scanned.
+
+    Each entry is keyed on the plugin format and file path, and records the
+    file's size and modification time when it was scanned. An entry is only
+    returned while the file still matches, so changed or replaced files are
+    rescanned and everything else can be skipped.
+
+    Files that were scanned but turned out not to contain any plugins are also
+    remembered, which is where most of the time goes when rescanning a large
+    folder. Identifiers that aren't absolute file paths (e.g. AudioUnit IDs) are
+    never cached.
+
+    Give one of these to a PluginDirectoryScanner or PluginListComponent with
+    setScanCache(), and use createXml() and restoreFromXml() to keep it between
+    sessions. All the methods are thread-safe.
+
+    @see PluginDirectoryScanner
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScanCache
+{
+public:
+    //==============================================================================
+    /** Creates an empty cache. */
+    PluginScanCache();
+
+    /** Destructor. */
+    ~PluginScanCache();
+
+    //==============================================================================
+    /** Looks for an up-to-date entry for the given file.
+
+        If the file was scanned with this format and hasn't changed since, this
+        adds the types that were found to the results array (which may be none)
+        and returns true. Otherwise it returns false, and the file needs scanning.
+    */
+    bool getCachedTypes (const AudioPluginFormat& format,
+                         const String& fileOrIdentifier,
+                         OwnedArray<PluginDescription>& results) const;
+
+    /** Records the types that a scan of the given file found. */
+    void addResult (const AudioPluginFormat& format,
+                    const String& fileOrIdentifier,
+                    const OwnedArray<PluginDescription>& typesFound);
+
+    /** Removes any entry for the given file. */
+    void removeResult (const AudioPluginFormat& format, const String& fileOrIdentifier);
+
+    /** Removes all the entries. */
+    void clear();
+
+    /** Returns the number of files in the cache. */
+    int getNumEntries() const;
+
+    //==============================================================================
+    /** Creates some XML that can be used to store the state of the cache. */
+    XmlElement* createXml() const;
+
+    /** Replaces the contents of the cache with a state created by createXml(). */
+    void restoreFromXml (const XmlElement& xml);
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        int64 modificationTime = 0, fileSize = 0;
+        OwnedArray<PluginDescription> types;
+    };
+
+    static String createKey (const String& formatName, const String& fileOrIdentifier);
+    static bool getFileStamp (const String& fileOrIdentifier, int64& modificationTime, int64& fileSize);
+
+    std::map<String, std::unique_ptr<Entry>> entries;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanCache)
+};
+
+} // namespace juce
@@ -65,6 +65,64 @@ bool AudioProcessorValueTreeState::Parameter::isAutomatable() const     { return
 bool AudioProcessorValueTreeState::Parameter::isDiscrete() const        { return discrete; }
 bool AudioProcessorValueTreeState::Parameter::isBoolean() const         { return boolean; }
 
+//==============================================================================
+/*  Holds one bit per parameter adapter. The adapters set their bit from whichever thread
+    changes the parameter, and the message thread collects and clears the bits, so that it
+    only needs to visit the parameters that have actually changed.
+
+    Flags may only be added while the parameters are being created.
+*/
+class AudioProcessorValueTreeState::ChangeFlags
+{
+public:
+    struct Flag
+    {
+        void set() const noexcept   { word->fetch_or (mask); }
+
+        std::atomic<uint32>* word;
+        uint32 mask;
+    };
+
+    Flag addFlag()
+    {
+        if (numFlags % bitsPerWord == 0)
+            words.add (new std::atomic<uint32> (0));
+
+        return { words.getLast(), (uint32) 1 << (numFlags++ % bitsPerWord) };
+    }
+
+    /** Calls the function with the index of each flag that is set, clearing the flags. */
+    template <typename FunctionType>
+    bool collect (FunctionType&& function)
+    {
+        bool anySet = false;
+
+        for (int i = 0; i < words.size(); ++i)
+        {
+            auto& word = *words.getUnchecked (i);
+
+            if (word.load (std::memory_order_relaxed) == 0)
+                continue;
+
+            for (auto bits = word.exchange (0); bits != 0; bits &= bits - 1)
+            {
+                auto bit = findHighestSetBit (bits & (~bits + 1));
+                function (i * bitsPerWord + bit);
+            }
+
+            anySet = true;
+        }
+
+        return anySet;
+    }
+
+private:
+    enum { bitsPerWord = 32 };
+
+    OwnedArray<std::atomic<uint32>> words;
+    int numFlags = 0;
+};
+
 //==============================================================================
 class AudioProcessorValueTreeState::ParameterAdapter   : private AudioProcessorParameter::Listener
 {
@@ -72,11 +130,14 @@ private:
     using Listener = AudioProcessorValueTreeState::Listener;
 
 public:
-    explicit ParameterAdapter (RangedAudioParameter& parameterIn)
+    ParameterAdapter (RangedAudioParameter& parameterIn, ChangeFlags& treeChanges, ChangeFlags& asyncListenerChanges)
         : parameter (parameterIn),
           // For legacy reasons, the unnormalised value should *not* be snapped on construction
-          unnormalisedValue (getRange().convertFrom0to1 (parameter.getDefaultValue()))
+          unnormalisedValue (getRange().convertFrom0to1 (parameter.getDefaultValue())),
+          treeChangeFlag (treeChanges.addFlag()),
+          asyncListenerChangeFlag (asyncListenerChanges.addFlag())
     {
+        treeChangeFlag.set();
         parameter.addListener (this);
     }
 
@@ -85,6 +146,30 @@ public:
     void addListener (Listener* l)      { listeners.add (l); }
     void removeListener (Listener* l)   { listeners.remove (l); }
 
+    bool addAsyncListener (Listener* l)
+    {
+        if (asyncListeners.contains (l))
+            return false;
+
+        asyncListeners.add (l);
+        return true;
+    }
+
+    bool removeAsyncListener (Listener* l)
+    {
+        if (! asyncListeners.contains (l))
+            return false;
+
+        asyncListeners.remove (l);
+        return true;
+    }
+
+    void callAsyncListeners()
+    {
+        const auto value = unnormalisedValue;
+        asyncListeners.call ([&] (Listener& l) { l.parameterChanged (parameter.paramID, value); });
+    }
+
     RangedAudioParameter& getParameter()                { return parameter; }
     const RangedAudioParameter& getParameter() const    { return parameter; }
 
@@ -151,7 +236,12 @@ private:
         unnormalisedValue = newValue;
         listeners.call ([=](Listener& l) { l.parameterChanged (parameter.paramID, unnormalisedValue); });
         listenersNeedCalling = false;
+
+        // needsUpdate must be set before the flag, so that a flush which sees the flag
+        // can't miss the update
         needsUpdate = true;
+        treeChangeFlag.set();
+        asyncListenerChangeFlag.set();
     }
 
     float denormalise (float normalised) const
@@ -173,8 +263,9 @@ private:
     }
 
     RangedAudioParameter& parameter;
-    ListenerList<Listener> listeners;
+    ListenerList<Listener> listeners, asyncListeners;
     float unnormalisedValue{};
+    ChangeFlags::Flag treeChangeFlag, asyncListenerChangeFlag;
     std::atomic<bool> needsUpdate { true };
     bool listenersNeedCalling { true }, ignoreParameterChangedCallbacks { false };
 };
@@ -238,7 +329,9 @@ AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& proc
 }
 
 AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& p, UndoManager* um)
-    : processor (p), undoManager (um)
+    : processor (p), undoManager (um),
+      treeChanges (new ChangeFlags()),
+      asyncListenerChanges (new ChangeFlags())
 {
     startTimerHz (10);
     state.addListener (this);
@@ -292,7 +385,13 @@ RangedAudioParameter* AudioProcessorValueTreeState::createAndAddParameter (std::
 //==============================================================================
 void AudioProcessorValueTreeState::addParameterAdapter (RangedAudioParameter& param)
 {
-    adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+    auto adapter = std::make_unique<ParameterAdapter> (param, *treeChanges, *asyncListenerChanges);
+    auto* adapterPtr = adapter.get();
+
+    if (adapterTable.emplace (param.paramID, std::move (adapter)).second)
+        adapters.add (adapterPtr);
+    else
+        adapters.add (nullptr);
 }
 
 AudioProcessorValueTreeState::ParameterAdapter* AudioProcessorValueTreeState::getParameterAdapter (StringRef paramID) const
@@ -313,6 +412,22 @@ void AudioProcessorValueTreeState::removeParameterListener (StringRef paramID, L
         p->removeListener (listener);
 }
 
+void AudioProcessorValueTreeState::addAsyncParameterListener (StringRef paramID, Listener* listener)
+{
+    if (auto* p = getParameterAdapter (paramID))
+    {
+        if (p->addAsyncListener (listener) && ++numAsyncListeners == 1)
+            startTimer (1000 / 50);
+    }
+}
+
+void AudioProcessorValueTreeState::removeAsyncParameterListener (StringRef paramID, Listener* listener)
+{
+    if (auto* p = getParameterAdapter (paramID))
+        if (p->removeAsyncListener (listener))
+            --numAsyncListeners;
+}
+
 Value AudioProcessorValueTreeState::getParameterAsValue (StringRef paramID) const
 {
     if (auto* adapter = getParameterAdapter (paramID))
@@ -363,6 +478,146 @@ void AudioProcessorValueTreeState::replaceState (const ValueTree& newState)
         undoManager->clearUndoHistory();
 }
 
+//==============================================================================
+struct AudioProcessorValueTreeStateBinaryFormat
+{
+    enum { magicNumber = 0x53545641, currentVersion = 1 };
+    enum Flags { compressed = 1, parameterValuesOnly = 2 };
+
+    static void writeHeader (OutputStream& out, int flags)
+    {
+        out.writeInt (magicNumber);
+        out.writeInt (currentVersion);
+        out.writeInt (flags);
+    }
+
+    static bool readHeader (InputStream& in, int& flags)
+    {
+        if (in.getNumBytesRemaining() < 12 || in.readInt() != magicNumber)
+            return false;
+
+        auto version = in.readInt();
+        flags = in.readInt();
+
+        return version > 0 && version <= currentVersion;
+    }
+};
+
+void AudioProcessorValueTreeState::copyStateToBinary (MemoryBlock& destData, bool compressData)
+{
+    using Format = AudioProcessorValueTreeStateBinaryFormat;
+
+    destData.reset();
+    MemoryOutputStream out (destData, false);
+
+    ScopedLock lock (valueTreeChanging);
+    flushParameterValuesToValueTree();
+
+    Format::writeHeader (out, compressData ? Format::compressed : 0);
+
+    if (compressData)
+    {
+        GZIPCompressorOutputStream compressor (out);
+        state.writeToStream (compressor);
+    }
+    else
+    {
+        state.writeToStream (out);
+    }
+}
+
+void AudioProcessorValueTreeState::copyParameterValuesToBinary (MemoryBlock& destData)
+{
+    using Format = AudioProcessorValueTreeStateBinaryFormat;
+
+    destData.reset();
+    MemoryOutputStream out (destData, false);
+    Format::writeHeader (out, Format::parameterValuesOnly);
+
+    Array<ParameterAdapter*> nonDefault;
+
+    for (auto* adapter : adapters)
+        if (adapter->getDenormalisedValue() != adapter->getDenormalisedDefaultValue())
+            nonDefault.add (adapter);
+
+    out.writeCompressedInt (nonDefault.size());
+
+    for (auto* adapter : nonDefault)
+    {
+        out.writeString (adapter->getParameter().paramID);
+        out.writeFloat (adapter->getDenormalisedValue());
+    }
+}
+
+bool AudioProcessorValueTreeState::replaceStateFromBinary (const void* data, size_t sizeInBytes)
+{
+    using Format = AudioProcessorValueTreeStateBinaryFormat;
+
+    MemoryInputStream in (data, sizeInBytes, false);
+    int flags = 0;
+
+    if (! Format::readHeader (in, flags))
+        return false;
+
+    if ((flags & Format::parameterValuesOnly) != 0)
+        return setParameterValuesFromStream (in);
+
+    ValueTree newState;
+
+    if ((flags & Format::compressed) != 0)
+    {
+        GZIPDecompressorInputStream decompressor (in);
+        newState = ValueTree::readFromStream (decompressor);
+    }
+    else
+    {
+        newState = ValueTree::readFromStream (in);
+    }
+
+    if (! newState.isValid())
+        return false;
+
+    replaceState (newState);
+    return true;
+}
+
+bool AudioProcessorValueTreeState::setParameterValuesFromStream (InputStream& in)
+{
+    if (in.isExhausted())
+        return false;
+
+    auto numValues = in.readCompressedInt();
+
+    // each entry needs at least a terminated ID and a float
+    if (numValues < 0 || numValues > in.getNumBytesRemaining() / 5)
+        return false;
+
+    std::map<ParameterAdapter*, float> newValues;
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        auto paramID = in.readString();
+
+        if (in.getNumBytesRemaining() < (int64) sizeof (float))
+            return false;
+
+        auto value = in.readFloat();
+
+        // parameters that no longer exist are skipped, so that old data can still be loaded
+        if (auto* adapter = getParameterAdapter (paramID))
+            newValues[adapter] = value;
+    }
+
+    for (auto* adapter : adapters)
+    {
+        auto found = newValues.find (adapter);
+        adapter->setDenormalisedValue (found != newValues.end() ? found->second
+                                                                : adapter->getDenormalisedDefaultValue());
+    }
+
+    return true;
+}
+
 void AudioProcessorValueTreeState::setNewState (ValueTree vt)
 {
     jassert (vt.getParent() == state);
@@ -430,18 +685,33 @@ bool AudioProcessorValueTreeState::flushParameterValuesToValueTree()
 
     bool anyUpdated = false;
 
-    for (auto& p : adapterTable)
-        anyUpdated |= p.second->flushToTree (valuePropertyID, undoManager);
+    treeChanges->collect ([this, &anyUpdated] (int index)
+    {
+        if (auto* adapter = adapters.getUnchecked (index))
+            anyUpdated |= adapter->flushToTree (valuePropertyID, undoManager);
+    });
 
     return anyUpdated;
 }
 
+bool AudioProcessorValueTreeState::callAsyncParameterListeners()
+{
+    return asyncListenerChanges->collect ([this] (int index)
+    {
+        if (auto* adapter = adapters.getUnchecked (index))
+            adapter->callAsyncListeners();
+    });
+}
+
 void AudioProcessorValueTreeState::timerCallback()
 {
     auto anythingUpdated = flushParameterValuesToValueTree();
+    anythingUpdated |= callAsyncParameterListeners();
 
-    startTimer (anythingUpdated ? 1000 / 50
-                                : jlimit (50, 500, getTimerInterval() + 20));
+    // Asynchronous listeners should hear about changes promptly, so don't let the
+    // timer slow down while there are any
+    startTimer (anythingUpdated || numAsyncListeners > 0 ? 1000 / 50
+                                                         : jlimit (50, 500, getTimerInterval() + 20));
 }
 
 //==============================================================================
@@ -761,7 +1031,8 @@ static struct ParameterAdapterTests final   : public UnitTest
             {
                 AudioParameterFloat param ({}, {}, range, value, {});
 
-                AudioProcessorValueTreeState::ParameterAdapter adapter (param);
+                AudioProcessorValueTreeState::ChangeFlags changes;
+                AudioProcessorValueTreeState::ParameterAdapter adapter (param, changes, changes);
 
                 expectEquals (adapter.getDenormalisedDefaultValue(), value);
             };
@@ -775,7 +1046,8 @@ static struct ParameterAdapterTests final   : public UnitTest
             const auto test = [&](NormalisableRange<float> range, float value)
             {
                 AudioParameterFloat param ({}, {}, range, {}, {});
-                AudioProcessorValueTreeState::ParameterAdapter adapter (param);
+                AudioProcessorValueTreeState::ChangeFlags changes;
+                AudioProcessorValueTreeState::ParameterAdapter adapter (param, changes, changes);
 
                 adapter.setDenormalisedValue (value);
 
@@ -792,7 +1064,8 @@ static struct ParameterAdapterTests final   : public UnitTest
             const auto test = [&](NormalisableRange<float> range, float value, String expected)
             {
                 AudioParameterFloat param ({}, {}, range, {}, {});
-                AudioProcessorValueTreeState::ParameterAdapter adapter (param);
+                AudioProcessorValueTreeState::ChangeFlags changes;
+                AudioProcessorValueTreeState::ParameterAdapter adapter (param, changes, changes);
 
                 expectEquals (adapter.getTextForDenormalisedValue (value), expected);
             };
@@ -808,7 +1081,8 @@ static struct ParameterAdapterTests final   : public UnitTest
             const auto test = [&](NormalisableRange<float> range, String text, float expected)
             {
                 AudioParameterFloat param ({}, {}, range, {}, {});
-                AudioProcessorValueTreeState::ParameterAdapter adapter (param);
+                AudioProcessorValueTreeState::ChangeFlags changes;
+                AudioProcessorValueTreeState::ParameterAdapter adapter (param, changes, changes);
 
                 expectEquals (adapter.getDenormalisedValueForText (text), expected);
             };
@@ -1065,6 +1339,134 @@ public:
             expectEquals (listener.value, value);
         }
 
+        beginTest ("Only parameters which have changed are flushed to the state");
+        {
+            TestAudioProcessor proc;
+            const auto keyA = "a";
+            const auto keyB = "b";
+            const auto paramA = proc.state.createAndAddParameter (std::make_unique<Parameter> (keyA, String(), String(), NormalisableRange<float>(),
+                                                                                               0.0f, nullptr, nullptr));
+            proc.state.createAndAddParameter (std::make_unique<Parameter> (keyB, String(), String(), NormalisableRange<float>(),
+                                                                           0.0f, nullptr, nullptr));
+            proc.state.state = ValueTree { "state" };
+
+            expect (! proc.state.flushParameterValuesToValueTree());
+
+            const auto value = 0.25f;
+            paramA->setValueNotifyingHost (value);
+
+            expect (proc.state.flushParameterValuesToValueTree());
+            expect (! proc.state.flushParameterValuesToValueTree());
+
+            const auto copy = proc.state.copyState();
+            expectEquals ((float) copy.getChildWithProperty ("id", keyA).getProperty ("value"), value);
+            expectEquals ((float) copy.getChildWithProperty ("id", keyB).getProperty ("value"), 0.0f);
+        }
+
+        beginTest ("The state can be saved and restored in binary form");
+        {
+            for (auto compress : { false, true })
+            {
+                TestAudioProcessor proc;
+                const auto key = "id";
+                const auto param = proc.state.createAndAddParameter (std::make_unique<Parameter> (key, String(), String(), NormalisableRange<float>(),
+                                                                                                  0.0f, nullptr, nullptr));
+                proc.state.state = ValueTree { "state" };
+                proc.state.state.setProperty ("extra", "foo", nullptr);
+
+                param->setValueNotifyingHost (0.5f);
+
+                MemoryBlock data;
+                proc.state.copyStateToBinary (data, compress);
+
+                param->setValueNotifyingHost (0.25f);
+                proc.state.state.setProperty ("extra", "bar", nullptr);
+
+                expect (proc.state.replaceStateFromBinary (data.getData(), data.getSize()));
+                expectEquals (proc.state.state.getProperty ("extra").toString(), String ("foo"));
+                expectEquals (*proc.state.getRawParameterValue (key), 0.5f);
+            }
+        }
+
+        beginTest ("Parameter values can be saved and restored in binary form");
+        {
+            TestAudioProcessor proc;
+            const auto keyA = "a";
+            const auto keyB = "b";
+            const auto paramA = proc.state.createAndAddParameter (std::make_unique<Parameter> (keyA, String(), String(), NormalisableRange<float>(),
+                                                                                               0.0f, nullptr, nullptr));
+            const auto paramB = proc.state.createAndAddParameter (std::make_unique<Parameter> (keyB, String(), String(), NormalisableRange<float>(),
+                                                                                               0.0f, nullptr, nullptr));
+            proc.state.state = ValueTree { "state" };
+            proc.state.state.setProperty ("extra", "foo", nullptr);
+
+            paramA->setValueNotifyingHost (0.75f);
+
+            MemoryBlock data;
+            proc.state.copyParameterValuesToBinary (data);
+
+            paramA->setValueNotifyingHost (0.1f);
+            paramB->setValueNotifyingHost (0.2f);
+            proc.state.state.setProperty ("extra", "bar", nullptr);
+
+            expect (proc.state.replaceStateFromBinary (data.getData(), data.getSize()));
+            expectEquals (*proc.state.getRawParameterValue (keyA), 0.75f);
+            expectEquals (*proc.state.getRawParameterValue (keyB), 0.0f);
+            expectEquals (proc.state.state.getProperty ("extra").toString(), String ("bar"));
+        }
+
+        beginTest ("Data in another format is rejected by replaceStateFromBinary");
+        {
+            TestAudioProcessor proc;
+            const auto param = proc.state.createAndAddParameter (std::make_unique<Parameter> ("id", String(), String(), NormalisableRange<float>(),
+                                                                                              0.0f, nullptr, nullptr));
+            proc.state.state = ValueTree { "state" };
+
+            MemoryBlock xmlData;
+            AudioProcessor::copyXmlToBinary (XmlElement ("state"), xmlData);
+
+            expect (! proc.state.replaceStateFromBinary (xmlData.getData(), xmlData.getSize()));
+            expect (! proc.state.replaceStateFromBinary (nullptr, 0));
+
+            param->setValueNotifyingHost (0.5f);
+
+            MemoryBlock data;
+            proc.state.copyParameterValuesToBinary (data);
+            data.setSize (data.getSize() - 1);
+            expect (! proc.state.replaceStateFromBinary (data.getData(), data.getSize()));
+        }
+
+        beginTest ("Async listeners receive the latest value from the timer callback");
+        {
+            Listener listener;
+            TestAudioProcessor proc;
+            const auto key = "id";
+            const auto param = proc.state.createAndAddParameter (std::make_unique<Parameter> (key, String(), String(), NormalisableRange<float>(),
+                                                                                              0.0f, nullptr, nullptr));
+            proc.state.addAsyncParameterListener (key, &listener);
+
+            param->setValueNotifyingHost (0.25f);
+            param->setValueNotifyingHost (0.5f);
+
+            expectEquals (listener.id, String());
+
+            proc.state.timerCallback();
+
+            expectEquals (listener.id, String { key });
+            expectEquals (listener.value, 0.5f);
+
+            listener.id = String();
+            proc.state.timerCallback();
+
+            expectEquals (listener.id, String());
+
+            proc.state.removeAsyncParameterListener (key, &listener);
+            param->setValueNotifyingHost (0.75f);
+            proc.state.timerCallback();
+
+            expectEquals (listener.id, String());
+        }
+
         beginTest ("Bool parameters have a range of 0-1");
         {
             const auto key = "id";
@@ -310,6 +310,20 @@ public:
     /** Removes a callback that was previously added with addParameterCallback(). */
     void removeParameterListener (StringRef parameterID, Listener* listener);
 
+    /** Attaches a callback to one of the parameters, which will be called on the message
+        thread shortly after the parameter changes.
+
+        Unlike the listeners added with addParameterListener(), which are called synchronously
+        on whichever thread changed the parameter, the changing thread only sets a lock-free
+        flag here, so this is the safer choice when parameters are changed from the audio
+        thread and the listener does anything that could block. Several changes made in quick
+        succession are coalesced into a single callback with the latest value.
+    */
+    void addAsyncParameterListener (StringRef parameterID, Listener* listener);
+
+    /** Removes a callback that was previously added with addAsyncParameterListener(). */
+    void removeAsyncParameterListener (StringRef parameterID, Listener* listener);
+
     //==============================================================================
     /** Returns a Value object that can be used to control a particular parameter. */
     Value getParameterAsValue (StringRef parameterID) const;
@@ -345,6 +359,53 @@ public:
     */
     void replaceState (const ValueTree& newState);
 
+    //==============================================================================
+    /** Writes the whole state to a block of binary data.
+
+        This is a faster alternative to calling copyState(), converting the result to
+        XML and then using AudioProcessor::copyXmlToBinary(), which is worth having
+        when the state is large: the tree is written straight from the live state
+        using ValueTree::writeToStream(), without making a copy of it or building
+        any XML. The data can optionally be gzip-compressed.
+
+        The block begins with a small versioned header, and can be loaded again with
+        replaceStateFromBinary().
+
+        Like copyState(), this takes a lock, so don't call it on the audio thread.
+
+        @see copyParameterValuesToBinary, replaceStateFromBinary
+    */
+    void copyStateToBinary (MemoryBlock& destData, bool compressData = false);
+
+    /** Writes just the values of the parameters to a block of binary data.
+
+        This is cheaper again than copyStateToBinary(), as it reads the values directly
+        from the parameters and never touches the ValueTree. It's useful for frequent
+        saves such as autosaves, or when the rest of your state rarely changes.
+
+        Only the parameters whose values differ from their defaults are written, so
+        when the data is loaded with replaceStateFromBinary() any parameter that
+        isn't mentioned is reset to its default value. Any other properties or
+        children that you've added to the state aren't included.
+
+        @see copyStateToBinary, replaceStateFromBinary
+    */
+    void copyParameterValuesToBinary (MemoryBlock& destData);
+
+    /** Restores the state from a block of data that was created by copyStateToBinary()
+        or copyParameterValuesToBinary().
+
+        If the data holds a whole state, it replaces the current one as though it had
+        been passed to replaceState(). If it only holds parameter values, these are
+        applied to the parameters and the rest of the state is left alone.
+
+        Returns false and leaves the state untouched if the data wasn't written by one
+        of these methods, was written by a newer version of this class, or is corrupt.
+        This lets you fall back to loading data saved in an older format, e.g. with
+        AudioProcessor::getXmlFromBinary().
+    */
+    bool replaceStateFromBinary (const void* data, size_t sizeInBytes);
+
     //==============================================================================
     /** A reference to the processor with which this state is associated. */
     AudioProcessor& processor;
@@ -521,15 +582,19 @@ private:
 
     //==============================================================================
     class ParameterAdapter;
+    class ChangeFlags;
 
    #if JUCE_UNIT_TESTS
     friend struct ParameterAdapterTests;
+    friend class AudioProcessorValueTreeStateTests;
    #endif
 
     void addParameterAdapter (RangedAudioParameter&);
     ParameterAdapter* getParameterAdapter (StringRef) const;
 
     bool flushParameterValuesToValueTree();
+    bool callAsyncParameterListeners();
+    bool setParameterValuesFromStream (InputStream&);
     void setNewState (ValueTree);
     void timerCallback() override;
 
@@ -543,7 +608,10 @@ private:
 
     const Identifier valueType { "PARAM" }, valuePropertyID { "value" }, idPropertyID { "id" };
 
+    std::unique_ptr<ChangeFlags> treeChanges, asyncListenerChanges;
     std::map<String, std::unique_ptr<ParameterAdapter>> adapterTable;
+    Array<ParameterAdapter*> adapters;
+    int numAsyncListeners = 0;
 
     CriticalSection valueTreeChanging;
 
@@ -101,9 +101,10 @@ public:
     ~LevelDataSource() override
     {
         owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
+        stopRegionJobs();
     }
 
-    enum { timeBeforeDeletingReader = 3000 };
+    enum { timeBeforeDeletingReader = 3000, thumbSamplesPerRegion = 8192 };
 
     void initialise (int64 samplesFinished)
     {
@@ -120,9 +121,14 @@ public:
             sampleRate = reader->sampleRate;
 
             if (lengthInSamples <= 0 || isFullyLoaded())
+            {
                 reader.reset();
+            }
             else
+            {
+                startRegionJobs();
                 owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+            }
         }
     }
 
@@ -160,6 +166,28 @@ public:
 
     int useTimeSlice() override
     {
+        if (! regionJobs.isEmpty())
+        {
+            for (auto* job : regionJobs)
+                if (pool->contains (job))
+                    return 200;
+
+            regionJobs.clear();
+
+            {
+                // any region that couldn't be read leaves a gap, which the sequential
+                // reader below will then fill in
+                const ScopedLock sl (owner.lock);
+                numSamplesFinished = owner.numSamplesFinished;
+            }
+
+            if (isFullyLoaded())
+            {
+                owner.cache.storeThumb (owner, hashCode);
+                return 200;
+            }
+        }
+
         if (isFullyLoaded())
         {
             if (reader != nullptr && source != nullptr)
@@ -210,56 +238,147 @@ public:
     int64 hashCode = 0;
 
 private:
+    //==============================================================================
+    struct LevelBlock
+    {
+        LevelBlock (int channels, int numThumbSamps)
+            : data ((size_t) (channels * numThumbSamps)), levels ((size_t) channels), numThumbSamples (numThumbSamps)
+        {
+            for (int i = 0; i < channels; ++i)
+                levels[i] = data + i * numThumbSamps;
+        }
+
+        HeapBlock<MinMaxValue> data;
+        HeapBlock<MinMaxValue*> levels;
+        int numThumbSamples;
+    };
+
+    //==============================================================================
+    class RegionJob  : public ThreadPoolJob
+    {
+    public:
+        RegionJob (LevelDataSource& ds, int64 start, int64 end)
+            : ThreadPoolJob ("Thumbnail region"), dataSource (ds), startSample (start), endSample (end)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            // the reader used for drawing can't be shared between threads, so each
+            // region opens its own one
+            std::unique_ptr<AudioFormatReader> regionReader (dataSource.createNewReader());
+
+            if (regionReader != nullptr)
+            {
+                while (startSample < endSample && ! shouldExit())
+                {
+                    auto numToDo = (int) jmin (256 * (int64) dataSource.owner.samplesPerThumbSample, endSample - startSample);
+                    dataSource.readLevels (*regionReader, startSample, numToDo, nullptr);
+                    startSample += numToDo;
+                }
+            }
+
+            return jobHasFinished;
+        }
+
+    private:
+        LevelDataSource& dataSource;
+        int64 startSample, endSample;
+
+        JUCE_DECLARE_NON_COPYABLE (RegionJob)
+    };
+
+    //==============================================================================
     AudioThumbnail& owner;
     std::unique_ptr<InputSource> source;
     std::unique_ptr<AudioFormatReader> reader;
     CriticalSection readerLock;
     uint32 lastReaderUseTime = 0;
+    ThreadPool* pool = nullptr;
+    OwnedArray<RegionJob> regionJobs;
+
+    AudioFormatReader* createNewReader() const
+    {
+        if (auto* audioFileStream = source->createInputStream())
+            return owner.formatManagerToUse.createReaderFor (audioFileStream);
+
+        return nullptr;
+    }
 
     void createReader()
     {
         if (reader == nullptr && source != nullptr)
-            if (auto* audioFileStream = source->createInputStream())
-                reader.reset (owner.formatManagerToUse.createReaderFor (audioFileStream));
+            reader.reset (createNewReader());
     }
 
-    bool readNextBlock()
+    void startRegionJobs()
     {
-        jassert (reader != nullptr);
+        // Only an InputSource can open the extra readers that the regions need. A reader
+        // that was passed in directly is read sequentially by the time-slice thread.
+        if (owner.generationPool == nullptr || source == nullptr)
+            return;
 
-        if (! isFullyLoaded())
-        {
-            auto numToDo = (int) jmin (256 * (int64) owner.samplesPerThumbSample, lengthInSamples - numSamplesFinished);
+        auto regionLength = (int64) thumbSamplesPerRegion * owner.samplesPerThumbSample;
 
-            if (numToDo > 0)
-            {
-                auto startSample = numSamplesFinished;
+        if (lengthInSamples - numSamplesFinished <= regionLength)
+            return;
+
+        pool = owner.generationPool;
+
+        for (auto start = numSamplesFinished; start < lengthInSamples; start += regionLength)
+            regionJobs.add (new RegionJob (*this, start, jmin (start + regionLength, lengthInSamples)));
 
-                auto firstThumbIndex = sampleToThumbSample (startSample);
-                auto lastThumbIndex  = sampleToThumbSample (startSample + numToDo);
-                auto numThumbSamps = lastThumbIndex - firstThumbIndex;
+        for (auto* job : regionJobs)
+            pool->addJob (job, false);
+    }
 
-                HeapBlock<MinMaxValue> levelData ((unsigned int) numThumbSamps * numChannels);
-                HeapBlock<MinMaxValue*> levels (numChannels);
+    void stopRegionJobs()
+    {
+        for (auto* job : regionJobs)
+            pool->removeJob (job, true, -1);
 
-                for (int i = 0; i < (int) numChannels; ++i)
-                    levels[i] = levelData + i * numThumbSamps;
+        regionJobs.clear();
+    }
 
-                HeapBlock<Range<float>> levelsRead (numChannels);
+    void readLevels (AudioFormatReader& r, int64 startSample, int numToDo, CriticalSection* lockToRelease)
+    {
+        auto firstThumbIndex = sampleToThumbSample (startSample);
+        auto lastThumbIndex  = sampleToThumbSample (startSample + numToDo);
+        LevelBlock block ((int) numChannels, lastThumbIndex - firstThumbIndex);
 
-                for (int i = 0; i < numThumbSamps; ++i)
-                {
-                    reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
-                                           owner.samplesPerThumbSample, levelsRead, (int) numChannels);
+        HeapBlock<Range<float>> levelsRead (numChannels);
 
-                    for (int j = 0; j < (int) numChannels; ++j)
-                        levels[j][i].setFloat (levelsRead[j]);
-                }
+        for (int i = 0; i < block.numThumbSamples; ++i)
+        {
+            r.readMaxLevels ((firstThumbIndex + i) * (int64) owner.samplesPerThumbSample,
+                             owner.samplesPerThumbSample, levelsRead, (int) numChannels);
 
-                {
-                    const ScopedUnlock su (readerLock);
-                    owner.setLevels (levels, firstThumbIndex, (int) numChannels, numThumbSamps);
-                }
+            for (int j = 0; j < (int) numChannels; ++j)
+                block.levels[j][i].setFloat (levelsRead[j]);
+        }
+
+        if (lockToRelease != nullptr)
+        {
+            const ScopedUnlock su (*lockToRelease);
+            owner.setLevels (block.levels, firstThumbIndex, (int) numChannels, block.numThumbSamples);
+        }
+        else
+        {
+            owner.setLevels (block.levels, firstThumbIndex, (int) numChannels, block.numThumbSamples);
+        }
+    }
+
+    bool readNextBlock()
+    {
+        jassert (reader != nullptr);
+
+        if (! isFullyLoaded())
+        {
+            auto numToDo = (int) jmin (256 * (int64) owner.samplesPerThumbSample, lengthInSamples - numSamplesFinished);
+
+            if (numToDo > 0)
+            {
+                readLevels (*reader, numSamplesFinished, numToDo, &readerLock);
 
                 numSamplesFinished += numToDo;
                 lastReaderUseTime = Time::getMillisecondCounter();
@@ -279,6 +398,38 @@ public:
         ensureSize (numThumbSamples);
     }
 
+    /*  As well as the full resolution data, each channel keeps a set of progressively
+        decimated copies, so that drawing a zoomed-out view only has to look at roughly
+        one value per pixel.
+    */
+    enum { decimationPerLevel = 8, maxNumLevels = 8 };
+
+    static int getDecimationForLevel (int level) noexcept
+    {
+        int decimation = 1;
+
+        while (--level >= 0)
+            decimation *= decimationPerLevel;
+
+        return decimation;
+    }
+
+    int getNumLevels() const noexcept
+    {
+        return 1 + mipLevels.size();
+    }
+
+    /** Returns the coarsest level in which one value covers no more than the given number of thumb samples. */
+    int getLevelForSpan (double numThumbSamplesPerPixel) const noexcept
+    {
+        int level = 0;
+
+        while (level + 1 < getNumLevels() && getDecimationForLevel (level + 1) <= numThumbSamplesPerPixel)
+            ++level;
+
+        return level;
+    }
+
     inline MinMaxValue* getData (int thumbSampleIndex) noexcept
     {
         jassert (thumbSampleIndex < data.size());
@@ -292,16 +443,24 @@ public:
 
     void getMinMax (int startSample, int endSample, MinMaxValue& result) const noexcept
     {
+        getMinMax (0, startSample, endSample, result);
+    }
+
+    /** Like getMinMax(), but with the indexes measured in values of the given level. */
+    void getMinMax (int level, int startSample, int endSample, MinMaxValue& result) const noexcept
+    {
+        auto& levelData = getLevelData (level);
+
         if (startSample >= 0)
         {
-            endSample = jmin (endSample, data.size() - 1);
+            endSample = jmin (endSample, levelData.size() - 1);
 
             int8 mx = -128;
             int8 mn = 127;
 
             while (startSample <= endSample)
             {
-                auto& v = data.getReference (startSample);
+                auto& v = levelData.getReference (startSample);
 
                 if (v.getMinValue() < mn)  mn = v.getMinValue();
                 if (v.getMaxValue() > mx)  mx = v.getMaxValue();
@@ -330,6 +489,38 @@ public:
 
         for (int i = 0; i < numValues; ++i)
             dest[i] = values[i];
+
+        updateLevels (startIndex, startIndex + numValues);
+    }
+
+    /** Recalculates the decimated levels for a range of full resolution values. */
+    void updateLevels (int startIndex, int endIndex)
+    {
+        for (int level = 1; level < getNumLevels(); ++level)
+        {
+            auto& source = getLevelData (level - 1);
+            auto& dest = mipLevels.getReference (level - 1);
+
+            startIndex /= decimationPerLevel;
+            endIndex = jmin (dest.size(), (endIndex + decimationPerLevel - 1) / decimationPerLevel);
+
+            for (int i = startIndex; i < endIndex; ++i)
+            {
+                auto sourceStart = i * decimationPerLevel;
+                auto sourceEnd = jmin (sourceStart + decimationPerLevel, source.size());
+
+                int8 mn = 127, mx = -128;
+
+                for (int j = sourceStart; j < sourceEnd; ++j)
+                {
+                    auto& v = source.getReference (j);
+                    mn = jmin (mn, v.getMinValue());
+                    mx = jmax (mx, v.getMaxValue());
+                }
+
+                dest.getReference (i).set (mn, mx);
+            }
+        }
     }
 
     void resetPeak() noexcept
@@ -355,14 +546,36 @@ public:
 
 private:
     Array<MinMaxValue> data;
+    Array<Array<MinMaxValue>> mipLevels;
     int peakLevel = -1;
 
+    const Array<MinMaxValue>& getLevelData (int level) const noexcept
+    {
+        return level == 0 ? data : mipLevels.getReference (level - 1);
+    }
+
     void ensureSize (int thumbSamples)
     {
         auto extraNeeded = thumbSamples - data.size();
 
         if (extraNeeded > 0)
             data.insertMultiple (-1, MinMaxValue(), extraNeeded);
+
+        for (int level = 1; level < maxNumLevels; ++level)
+        {
+            auto levelSize = (data.size() + getDecimationForLevel (level) - 1) / getDecimationForLevel (level);
+
+            if (levelSize <= 1)
+                break;
+
+            if (mipLevels.size() < level)
+                mipLevels.add ({});
+
+            auto& levelData = mipLevels.getReference (level - 1);
+
+            if (levelSize > levelData.size())
+                levelData.insertMultiple (-1, MinMaxValue(), levelSize - levelData.size());
+        }
     }
 };
 
@@ -495,12 +708,15 @@ private:
         {
             jassert (chans.size() == numChannelsCached);
 
+            auto numThumbSamplesPerPixel = timePerPixel * rate / (double) sampsPerThumbSample;
+
             for (int channelNum = 0; channelNum < numChannelsCached; ++channelNum)
             {
                 ThumbData* channelData = chans.getUnchecked (channelNum);
                 MinMaxValue* cacheData = getData (channelNum, 0);
 
-                auto timeToThumbSampleFactor = rate / (double) sampsPerThumbSample;
+                auto level = channelData->getLevelForSpan (numThumbSamplesPerPixel);
+                auto timeToThumbSampleFactor = rate / ((double) sampsPerThumbSample * ThumbData::getDecimationForLevel (level));
 
                 startTime = cachedStart;
                 auto sample = roundToInt (startTime * timeToThumbSampleFactor);
@@ -509,7 +725,7 @@ private:
                 {
                     auto nextSample = roundToInt ((startTime + timePerPixel) * timeToThumbSampleFactor);
 
-                    channelData->getMinMax (sample, nextSample, *cacheData);
+                    channelData->getMinMax (level, sample, nextSample, *cacheData);
 
                     ++cacheData;
                     startTime += timePerPixel;
@@ -565,6 +781,7 @@ void AudioThumbnail::clearChannelData()
 {
     window->invalidate();
     channels.clear();
+    finishedRanges.clear();
     totalSamples = numSamplesFinished = 0;
     numChannels = 0;
     sampleRate = 0;
@@ -615,6 +832,9 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
         for (int chan = 0; chan < numChannels; ++chan)
             channels.getUnchecked(chan)->getData(i)->read (input);
 
+    for (auto* c : channels)
+        c->updateLevels (0, numThumbnailSamples);
+
     return true;
 }
 
@@ -672,6 +892,11 @@ bool AudioThumbnail::setDataSource (LevelDataSource* newSource)
     return sampleRate > 0 && totalSamples > 0;
 }
 
+void AudioThumbnail::setGenerationThreadPool (ThreadPool* poolToUse)
+{
+    generationPool = poolToUse;
+}
+
 bool AudioThumbnail::setSource (InputSource* const newSource)
 {
     clear();
@@ -737,8 +962,16 @@ void AudioThumbnail::setLevels (const MinMaxValue* const* values, int thumbIndex
     auto start = thumbIndex * (int64) samplesPerThumbSample;
     auto end   = (thumbIndex + numValues) * (int64) samplesPerThumbSample;
 
-    if (numSamplesFinished >= start && end > numSamplesFinished)
-        numSamplesFinished = end;
+    // Regions that are generated in parallel can arrive out of order, so these are
+    // held until the data in front of them has been filled in
+    finishedRanges.addRange ({ start, end });
+
+    auto firstRange = finishedRanges.getRange (0);
+
+    if (numSamplesFinished >= firstRange.getStart() && firstRange.getEnd() > numSamplesFinished)
+        numSamplesFinished = firstRange.getEnd();
+
+    finishedRanges.removeRange ({ 0, numSamplesFinished });
 
     totalSamples = jmax (numSamplesFinished, totalSamples);
     window->invalidate();
@@ -42,7 +42,10 @@ namespace juce
     listeners should repaint themselves.
 
     The thumbnail stores an internal low-res version of the wave data, and this can
-    be loaded and saved to avoid having to scan the file again.
+    be loaded and saved to avoid having to scan the file again. It also keeps several
+    further decimated copies of that data, so that zoomed-out views can be drawn
+    without having to examine every stored value. Scanning can optionally be spread
+    across a ThreadPool with setGenerationThreadPool().
 
     @see AudioThumbnailCache, AudioThumbnailBase
 
@@ -100,6 +103,18 @@ public:
     */
     void setReader (AudioFormatReader* newReader, int64 hashCode) override;
 
+    /** Lets the thumbnail split the scanning of a file across the threads of a ThreadPool.
+
+        When a pool is set, sources passed to setSource() are divided into regions that are
+        scanned in parallel, with each region opening its own stream from the InputSource (so
+        the source must be able to create streams from more than one thread at a time). Readers
+        passed to setReader() are still scanned sequentially by the cache's background thread.
+
+        This only affects sources that are set after calling it, and the pool must outlive
+        the thumbnail, or at least the source. Pass nullptr to go back to sequential scanning.
+    */
+    void setGenerationThreadPool (ThreadPool* poolToUse);
+
     /** Resets the thumbnail, ready for adding data with the specified format.
         If you're going to generate a thumbnail yourself, call this before using addBlock()
         to add the data.
@@ -204,6 +219,8 @@ private:
     std::unique_ptr<LevelDataSource> source;
     std::unique_ptr<CachedWindow> window;
     OwnedArray<ThumbData> channels;
+    ThreadPool* generationPool = nullptr;
+    SparseSet<int64> finishedRanges;
 
     int32 samplesPerThumbSample = 0;
     int64 totalSamples = 0, numSamplesFinished = 0;
@@ -41,29 +41,73 @@ struct AudioVisualiserComponent::ChannelInfo
         for (auto& l : levels)
             l = Range<float>();
 
-        value = {};
-        subSample = 0;
+        // anything still waiting in the fifo is older than the clear, so throw it away
+        fifo.read (fifo.getNumReady());
+        needsFullRedraw = true;
     }
 
+    //==============================================================================
+    // Called on the audio thread: each block of input samples is reduced to a single
+    // level here, so only the levels have to be handed over to the message thread.
     void pushSamples (const float* inputSamples, int num) noexcept
     {
-        for (int i = 0; i < num; ++i)
-            pushSample (inputSamples[i]);
+        while (num > 0)
+        {
+            auto samplesPerBlock = jmax (1, owner.getSamplesPerBlock());
+            auto numThisTime = jmin (num, samplesPerBlock - numInBlock);
+
+            if (numThisTime > 0)
+            {
+                auto range = FloatVectorOperations::findMinAndMax (inputSamples, numThisTime);
+                value = numInBlock == 0 ? range : value.getUnionWith (range);
+
+                numInBlock += numThisTime;
+                inputSamples += numThisTime;
+                num -= numThisTime;
+            }
+
+            if (numInBlock >= samplesPerBlock)
+            {
+                pushLevel (value);
+                numInBlock = 0;
+            }
+        }
     }
 
     void pushSample (float newSample) noexcept
     {
-        if (--subSample <= 0)
+        pushSamples (&newSample, 1);
+    }
+
+    void pushLevel (Range<float> level) noexcept
+    {
+        // if the message thread has fallen this far behind, the level is just dropped
+        fifo.write (1).forEach ([this, level] (int index) { fifoLevels.getReference (index) = level; });
+    }
+
+    //==============================================================================
+    // Called on the message thread: moves any new levels into the history, returning
+    // the number that were added.
+    int pullLevels() noexcept
+    {
+        auto numReady = fifo.getNumReady();
+
+        if (levels.isEmpty())
         {
-            nextSample %= levels.size();
-            levels.getReference (nextSample++) = value;
-            subSample = owner.getSamplesPerBlock();
-            value = Range<float> (newSample, newSample);
+            fifo.read (numReady);
+            return 0;
         }
-        else
+
+        fifo.read (numReady).forEach ([this] (int index)
         {
-            value = value.getUnionWith (newSample);
-        }
+            levels.getReference (nextSample) = fifoLevels.getReference (index);
+
+            if (++nextSample >= levels.size())
+                nextSample = 0;
+        });
+
+        numLevelsToRender += numReady;
+        return numReady;
     }
 
     void setBufferSize (int newSize)
@@ -73,12 +117,80 @@ struct AudioVisualiserComponent::ChannelInfo
 
         if (nextSample >= newSize)
             nextSample = 0;
+
+        fifoLevels.clearQuick();
+        fifoLevels.insertMultiple (0, {}, jmax (512, 2 * newSize));
+        fifo.setTotalSize (fifoLevels.size());
+        fifo.reset();
+
+        needsFullRedraw = true;
+    }
+
+    //==============================================================================
+    // For incremental rendering, the waveform is kept in an image with one column per
+    // level, which is scrolled along and only has the new columns drawn into it.
+    void updateImage (int height, Colour backgroundColour, Colour waveformColour)
+    {
+        auto width = levels.size();
+
+        if (width <= 0 || height <= 0)
+        {
+            image = {};
+            return;
+        }
+
+        auto numToRender = jmin (numLevelsToRender, width);
+
+        if (needsFullRedraw || image.getWidth() != width || image.getHeight() != height)
+        {
+            image = Image (Image::RGB, width, height, false);
+            numToRender = width;
+            needsFullRedraw = false;
+        }
+        else if (numToRender < width)
+        {
+            image.moveImageSection (0, 0, numToRender, 0, width - numToRender, height);
+        }
+
+        numLevelsToRender = 0;
+
+        if (numToRender == 0)
+            return;
+
+        Graphics g (image);
+        auto firstColumn = width - numToRender;
+
+        g.setColour (backgroundColour);
+        g.fillRect (firstColumn, 0, numToRender, height);
+        g.setColour (waveformColour);
+
+        auto halfHeight = (float) height * 0.5f;
+
+        for (int x = firstColumn; x < width; ++x)
+        {
+            auto level = levels.getReference ((nextSample + x) % width);
+            auto top    = halfHeight * (1.0f - jlimit (-1.0f, 1.0f, level.getEnd()));
+            auto bottom = halfHeight * (1.0f - jlimit (-1.0f, 1.0f, level.getStart()));
+
+            g.fillRect (Rectangle<float> ((float) x, top, 1.0f, jmax (1.0f, bottom - top)));
+        }
     }
 
     AudioVisualiserComponent& owner;
-    Array<Range<float>> levels;
+
+    // audio thread
     Range<float> value;
-    int nextSample = 0, subSample = 0;
+    int numInBlock = 0;
+
+    // shared
+    AbstractFifo fifo { 1 };
+    Array<Range<float>> fifoLevels;
+
+    // message thread
+    Array<Range<float>> levels;
+    int nextSample = 0, numLevelsToRender = 0;
+    Image image;
+    bool needsFullRedraw = true;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelInfo)
 };
@@ -163,25 +275,67 @@ void AudioVisualiserComponent::setRepaintRate (int frequencyInHz)
     startTimerHz (frequencyInHz);
 }
 
+void AudioVisualiserComponent::setUsesIncrementalRendering (bool shouldRenderIncrementally)
+{
+    if (rendersIncrementally != shouldRenderIncrementally)
+    {
+        rendersIncrementally = shouldRenderIncrementally;
+
+        for (auto* c : channels)
+        {
+            c->image = {};
+            c->needsFullRedraw = true;
+        }
+
+        repaint();
+    }
+}
+
 void AudioVisualiserComponent::timerCallback()
 {
-    repaint();
+    int numNewLevels = 0;
+
+    for (auto* c : channels)
+        numNewLevels += c->pullLevels();
+
+    if (numNewLevels > 0)
+        repaint();
 }
 
 void AudioVisualiserComponent::setColours (Colour bk, Colour fg) noexcept
 {
     backgroundColour = bk;
     waveformColour = fg;
+
+    for (auto* c : channels)
+        c->needsFullRedraw = true;
+
     repaint();
 }
 
 void AudioVisualiserComponent::paint (Graphics& g)
 {
-    g.fillAll (backgroundColour);
-
     auto r = getLocalBounds().toFloat();
     auto channelHeight = r.getHeight() / channels.size();
 
+    if (rendersIncrementally)
+    {
+        if (channels.isEmpty())
+            g.fillAll (backgroundColour);
+
+        for (auto* c : channels)
+        {
+            auto area = r.removeFromTop (channelHeight);
+            c->updateImage (roundToInt (area.getBottom()) - roundToInt (area.getY()), backgroundColour, waveformColour);
+
+            if (c->image.isValid())
+                g.drawImage (c->image, area, RectanglePlacement::stretchToFit);
+        }
+
+        return;
+    }
+
+    g.fillAll (backgroundColour);
     g.setColour (waveformColour);
 
     for (auto* c : channels)
@@ -192,20 +346,29 @@ void AudioVisualiserComponent::paint (Graphics& g)
 void AudioVisualiserComponent::getChannelAsPath (Path& path, const Range<float>* levels,
                                                  int numLevels, int nextSample)
 {
+    if (numLevels <= 0)
+        return;
+
     path.preallocateSpace (4 * numLevels + 8);
+    nextSample %= numLevels;
 
-    for (int i = 0; i < numLevels; ++i)
-    {
-        auto level = -(levels[(nextSample + i) % numLevels].getEnd());
+    // the levels are a circular buffer, so walk through them as two contiguous runs
+    // rather than wrapping every index
+    auto numBeforeWrap = numLevels - nextSample;
 
-        if (i == 0)
-            path.startNewSubPath (0.0f, level);
-        else
-            path.lineTo ((float) i, level);
-    }
+    path.startNewSubPath (0.0f, -(levels[nextSample].getEnd()));
+
+    for (int i = 1; i < numBeforeWrap; ++i)
+        path.lineTo ((float) i, -(levels[nextSample + i].getEnd()));
+
+    for (int i = numBeforeWrap; i < numLevels; ++i)
+        path.lineTo ((float) i, -(levels[i - numBeforeWrap].getEnd()));
+
+    for (int i = numLevels; --i >= numBeforeWrap;)
+        path.lineTo ((float) i, -(levels[i - numBeforeWrap].getStart()));
 
-    for (int i = numLevels; --i >= 0;)
-        path.lineTo ((float) i, -(levels[(nextSample + i) % numLevels].getStart()));
+    for (int i = numBeforeWrap; --i >= 0;)
+        path.lineTo ((float) i, -(levels[nextSample + i].getStart()));
 
     path.closeSubPath();
 }
@@ -35,6 +35,11 @@ namespace juce
     one of these, set its size and oversampling rate, and then feed it with incoming
     data by calling one of its pushBuffer() or pushSample() methods.
 
+    The push methods are safe to call from the audio thread: incoming samples are reduced
+    to one level per block there, and the levels are handed over to the message thread
+    through a lock-free fifo. Changing the number of channels or the buffer size isn't
+    lock-free though, so avoid doing that while data is being pushed.
+
     You can override its paint method for more customised views, but it's only designed
     as a quick-and-dirty class for simple tasks, so please don't send us feature requests
     for fancy additional features that you'd like it to support! If you're building a
@@ -99,9 +104,20 @@ public:
     /** Sets the colours used to paint the */
     void setColours (Colour backgroundColour, Colour waveformColour) noexcept;
 
-    /** Sets the frequency at which the component repaints itself. */
+    /** Sets the frequency at which the component checks for new data, and repaints
+        itself if there is any.
+    */
     void setRepaintRate (int frequencyInHz);
 
+    /** Enables a cheaper way of drawing the waveforms.
+
+        When this is enabled, each channel's waveform is kept in an image which is scrolled
+        along as new data comes in, so that only the newly arrived levels have to be drawn
+        on each repaint. This is much faster when showing lots of channels, but it means
+        that paintChannel() won't be called.
+    */
+    void setUsesIncrementalRendering (bool shouldRenderIncrementally);
+
     /** Draws a channel of audio data in the given bounds.
         The default implementation just calls getChannelAsPath() and fits this into the given
         area. You may want to override this to draw things differently.
@@ -123,8 +139,10 @@ private:
     struct ChannelInfo;
 
     OwnedArray<ChannelInfo> channels;
-    int numSamples, inputSamplesPerBlock;
+    int numSamples;
+    std::atomic<int> inputSamplesPerBlock;
     Colour backgroundColour, waveformColour;
+    bool rendersIncrementally = false;
 
     void timerCallback() override;
 
@@ -86,14 +86,15 @@ MidiKeyboardComponent::MidiKeyboardComponent (MidiKeyboardState& s, Orientation
     colourChanged();
     setWantsKeyboardFocus (true);
 
-    state.addListener (this);
+    // (rather than registering as a listener, which would be called on the audio thread,
+    // the timer polls the state to see whether any keys have changed)
+    lastStateChangeCount = state.getNumStateChanges();
 
     startTimerHz (20);
 }
 
 MidiKeyboardComponent::~MidiKeyboardComponent()
 {
-    state.removeListener (this);
 }
 
 //==============================================================================
@@ -815,6 +816,14 @@ void MidiKeyboardComponent::mouseWheelMove (const MouseEvent&, const MouseWheelD
 
 void MidiKeyboardComponent::timerCallback()
 {
+    auto stateChangeCount = state.getNumStateChanges();
+
+    if (stateChangeCount != lastStateChangeCount)
+    {
+        lastStateChangeCount = stateChangeCount;
+        shouldCheckState = true;
+    }
+
     if (shouldCheckState)
     {
         shouldCheckState = false;
@@ -411,6 +411,7 @@ private:
     Array<int> mouseOverNotes, mouseDownNotes;
     BigInteger keysPressed, keysCurrentlyDrawnDown;
     bool shouldCheckState = false;
+    uint32 lastStateChangeCount = 0;
 
     int rangeStart = 0, rangeEnd = 127;
     float firstKey = 12 * 4.0f;
@@ -0,0 +1,323 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static inline int getPersistentThumbnailStoreMagicHeader() noexcept
+{
+    return (int) ByteOrder::littleEndianInt ("ThmD");
+}
+
+enum
+{
+    persistentThumbnailStoreVersion = 1,
+    persistentThumbnailStoreHeaderSize = 8,     // magic number + version
+    persistentThumbnailRecordHeaderSize = 12    // hash code + data size
+};
+
+//==============================================================================
+PersistentAudioThumbnailCache::PersistentAudioThumbnailCache (const File& file,
+                                                              int maxNumThumbsInMemory,
+                                                              int64 maxBytes)
+    : AudioThumbnailCache (maxNumThumbsInMemory),
+      storeFile (file),
+      maxBytesOnDisk (maxBytes)
+{
+    jassert (maxBytesOnDisk > persistentThumbnailStoreHeaderSize);
+    readIndex();
+}
+
+PersistentAudioThumbnailCache::~PersistentAudioThumbnailCache()
+{
+}
+
+//==============================================================================
+int PersistentAudioThumbnailCache::getNumStoredThumbnails() const
+{
+    const ScopedLock sl (storeLock);
+    return index.size();
+}
+
+int64 PersistentAudioThumbnailCache::getStoreSize() const
+{
+    const ScopedLock sl (storeLock);
+    return storeSize;
+}
+
+bool PersistentAudioThumbnailCache::containsStoredThumbnail (int64 hashCode) const
+{
+    const ScopedLock sl (storeLock);
+    return index.contains (hashCode);
+}
+
+void PersistentAudioThumbnailCache::removeStoredThumbnail (int64 hashCode)
+{
+    const ScopedLock sl (storeLock);
+
+    // an empty record marks the thumbnail as removed for the next time the index is read
+    if (index.contains (hashCode))
+        appendThumbnail (hashCode, {});
+}
+
+void PersistentAudioThumbnailCache::clearStoredThumbnails()
+{
+    const ScopedLock sl (storeLock);
+
+    mappedFile.reset();
+    index.clear();
+    storeSize = 0;
+    storeFile.deleteFile();
+}
+
+void PersistentAudioThumbnailCache::compact()
+{
+    const ScopedLock sl (storeLock);
+    compactToSize (maxBytesOnDisk);
+}
+
+//==============================================================================
+void PersistentAudioThumbnailCache::saveNewlyFinishedThumbnail (const AudioThumbnailBase& thumb, int64 hashCode)
+{
+    MemoryBlock data;
+
+    {
+        MemoryOutputStream out (data, false);
+        thumb.saveTo (out);
+    }
+
+    const ScopedLock sl (storeLock);
+
+    // Compacting to a bit less than the budget means that this won't need to happen
+    // again for every new thumbnail that's added after the limit is first reached
+    if (appendThumbnail (hashCode, data) && storeSize > maxBytesOnDisk)
+        compactToSize (maxBytesOnDisk - maxBytesOnDisk / 4);
+}
+
+bool PersistentAudioThumbnailCache::loadNewThumb (AudioThumbnailBase& thumb, int64 hashCode)
+{
+    const ScopedLock sl (storeLock);
+
+    if (! index.contains (hashCode))
+        return false;
+
+    auto& stored = index.getReference (hashCode);
+
+    if (auto* data = getMappedData (stored))
+    {
+        stored.lastUsed = ++useCounter;
+
+        MemoryInputStream in (data, (size_t) stored.size, false);
+        return thumb.loadFrom (in);
+    }
+
+    return false;
+}
+
+//==============================================================================
+void PersistentAudioThumbnailCache::readIndex()
+{
+    index.clear();
+    storeSize = 0;
+
+    FileInputStream in (storeFile);
+
+    if (in.failedToOpen()
+         || in.readInt() != getPersistentThumbnailStoreMagicHeader()
+         || in.readInt() != persistentThumbnailStoreVersion)
+        return;
+
+    auto totalLength = in.getTotalLength();
+    auto position = (int64) persistentThumbnailStoreHeaderSize;
+
+    // Only the record headers are read here - the thumbnail data itself stays on disk
+    // until it's needed. Anything after the last complete record is left over from an
+    // interrupted write, and will be overwritten by the next one.
+    while (position + persistentThumbnailRecordHeaderSize <= totalLength)
+    {
+        auto hashCode = in.readInt64();
+        auto size = in.readInt();
+        auto dataStart = position + persistentThumbnailRecordHeaderSize;
+
+        if (size < 0 || dataStart + size > totalLength)
+            break;
+
+        if (size == 0)
+            index.remove (hashCode);
+        else
+            index.set (hashCode, { dataStart, size, ++useCounter });
+
+        position = dataStart + size;
+
+        if (! in.setPosition (position))
+            break;
+    }
+
+    storeSize = position;
+}
+
+bool PersistentAudioThumbnailCache::appendThumbnail (int64 hashCode, const MemoryBlock& data)
+{
+    // Not every platform allows writing to a file that's mapped, so this is released
+    // here and re-mapped the next time a thumbnail is loaded
+    mappedFile.reset();
+
+    FileOutputStream out (storeFile);
+
+    if (out.failedToOpen())
+        return false;
+
+    if (storeSize < persistentThumbnailStoreHeaderSize)
+    {
+        out.setPosition (0);
+        out.truncate();
+        out.writeInt (getPersistentThumbnailStoreMagicHeader());
+        out.writeInt (persistentThumbnailStoreVersion);
+        storeSize = persistentThumbnailStoreHeaderSize;
+    }
+    else
+    {
+        out.setPosition (storeSize);
+        out.truncate();
+    }
+
+    out.writeInt64 (hashCode);
+    out.writeInt ((int) data.getSize());
+    out << data;
+    out.flush();
+
+    if (out.getStatus().failed())
+        return false;
+
+    auto dataStart = storeSize + persistentThumbnailRecordHeaderSize;
+    storeSize = dataStart + (int64) data.getSize();
+
+    if (data.getSize() == 0)
+        index.remove (hashCode);
+    else
+        index.set (hashCode, { dataStart, (int32) data.getSize(), ++useCounter });
+
+    return true;
+}
+
+void PersistentAudioThumbnailCache::compactToSize (int64 maxSize)
+{
+    struct Entry
+    {
+        int64 hashCode;
+        StoredThumbnail stored;
+    };
+
+    Array<Entry> entries;
+
+    for (HashMap<int64, StoredThumbnail>::Iterator i (index); i.next();)
+        entries.add ({ i.getKey(), i.getValue() });
+
+    // keep the most recently used thumbnails that fit within the budget...
+    std::sort (entries.begin(), entries.end(),
+               [] (const Entry& a, const Entry& b) { return a.stored.lastUsed > b.stored.lastUsed; });
+
+    auto newSize = (int64) persistentThumbnailStoreHeaderSize;
+    int numToKeep = 0;
+
+    for (auto& e : entries)
+    {
+        auto recordSize = persistentThumbnailRecordHeaderSize + (int64) e.stored.size;
+
+        if (newSize + recordSize > maxSize)
+            break;
+
+        newSize += recordSize;
+        ++numToKeep;
+    }
+
+    entries.removeRange (numToKeep, entries.size());
+
+    // ...and write them oldest first, so that the order in the file still reflects
+    // their use when the index is next read
+    std::reverse (entries.begin(), entries.end());
+
+    mappedFile.reset();
+
+    HashMap<int64, StoredThumbnail> newIndex;
+    TemporaryFile temp (storeFile);
+
+    {
+        FileInputStream in (storeFile);
+        FileOutputStream out (temp.getFile());
+
+        if (in.failedToOpen() || out.failedToOpen())
+            return;
+
+        out.writeInt (getPersistentThumbnailStoreMagicHeader());
+        out.writeInt (persistentThumbnailStoreVersion);
+
+        auto position = (int64) persistentThumbnailStoreHeaderSize;
+        MemoryBlock data;
+
+        for (auto& e : entries)
+        {
+            data.setSize ((size_t) e.stored.size);
+
+            if (! in.setPosition (e.stored.offset)
+                 || in.read (data.getData(), e.stored.size) != e.stored.size)
+                return;
+
+            out.writeInt64 (e.hashCode);
+            out.writeInt (e.stored.size);
+            out << data;
+
+            newIndex.set (e.hashCode, { position + persistentThumbnailRecordHeaderSize, e.stored.size, e.stored.lastUsed });
+            position += persistentThumbnailRecordHeaderSize + e.stored.size;
+        }
+
+        out.flush();
+
+        if (out.getStatus().failed())
+            return;
+    }
+
+    if (temp.overwriteTargetFileWithTemporary())
+    {
+        index.swapWith (newIndex);
+        storeSize = newSize;
+    }
+}
+
+const void* PersistentAudioThumbnailCache::getMappedData (const StoredThumbnail& stored)
+{
+    auto end = stored.offset + stored.size;
+
+    if (mappedFile == nullptr || mappedFile->getRange().getEnd() < end)
+        mappedFile.reset (new MemoryMappedFile (storeFile, MemoryMappedFile::readOnly));
+
+    if (mappedFile->getData() == nullptr || mappedFile->getRange().getEnd() < end)
+        return nullptr;
+
+    return addBytesToPointer (mappedFile->getData(), stored.offset - mappedFile->getRange().getStart());
+}
+
+} // namespace juce
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An AudioThumbnailCache that also keeps every finished thumbnail in a single file
+    on disk, so that they can be reloaded instantly the next time the same audio is
+    opened, even in a later session.
+
+    The file holds the thumbnails one after another, prefixed by their hash codes.
+    When the cache is created, only this index is read. The file is memory-mapped
+    the first time a thumbnail is needed, and each thumbnail's data is only read
+    when a matching AudioThumbnail asks for it.
+
+    New thumbnails are appended to the file. When it grows beyond the byte budget,
+    the thumbnails that were least recently used are dropped, and the rest are
+    rewritten into a new, compacted file.
+
+    @see AudioThumbnailCache, AudioThumbnail
+
+    @tags{Audio}
+*/
+class JUCE_API  PersistentAudioThumbnailCache  : public AudioThumbnailCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache that stores its thumbnails in the given file.
+
+        @param storeFile              the file to use. It's created if it doesn't exist yet,
+                                      and if it exists but isn't a valid store, it will be
+                                      replaced when the first thumbnail is saved
+        @param maxNumThumbsInMemory   the number of thumbnails to keep in memory, as
+                                      for the AudioThumbnailCache constructor
+        @param maxBytesOnDisk         the largest size that the file may grow to before
+                                      the least recently used thumbnails are removed
+    */
+    PersistentAudioThumbnailCache (const File& storeFile,
+                                   int maxNumThumbsInMemory,
+                                   int64 maxBytesOnDisk);
+
+    /** Destructor. */
+    ~PersistentAudioThumbnailCache() override;
+
+    //==============================================================================
+    /** Returns the file that the thumbnails are stored in. */
+    const File& getStoreFile() const noexcept                { return storeFile; }
+
+    /** Returns the number of thumbnails currently held in the file. */
+    int getNumStoredThumbnails() const;
+
+    /** Returns the current size of the file, in bytes. */
+    int64 getStoreSize() const;
+
+    /** Returns true if the file contains a thumbnail with the given hash code. */
+    bool containsStoredThumbnail (int64 hashCode) const;
+
+    /** Removes a thumbnail from the file.
+        The space it used is recovered the next time the file is compacted.
+    */
+    void removeStoredThumbnail (int64 hashCode);
+
+    /** Deletes every thumbnail from the file. */
+    void clearStoredThumbnails();
+
+    /** Rewrites the file without any space that's used by removed or replaced
+        thumbnails, dropping the least recently used ones if that's needed to get
+        within the byte budget.
+    */
+    void compact();
+
+protected:
+    //==============================================================================
+    /** @internal */
+    void saveNewlyFinishedThumbnail (const AudioThumbnailBase&, int64 hashCode) override;
+    /** @internal */
+    bool loadNewThumb (AudioThumbnailBase&, int64 hashCode) override;
+
+private:
+    //==============================================================================
+    struct StoredThumbnail
+    {
+        int64 offset;
+        int32 size;
+        uint32 lastUsed;
+    };
+
+    File storeFile;
+    int64 maxBytesOnDisk, storeSize = 0;
+    HashMap<int64, StoredThumbnail> index;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    uint32 useCounter = 0;
+    CriticalSection storeLock;
+
+    void readIndex();
+    bool appendThumbnail (int64 hashCode, const MemoryBlock& data);
+    void compactToSize (int64 maxSize);
+    const void* getMappedData (const StoredThumbnail&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PersistentAudioThumbnailCache)
+};
+
+} // namespace juce
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+AudioProcessorOfflineRenderer::AudioProcessorOfflineRenderer (AudioProcessor& p)  : processor (p)
+{
+}
+
+AudioProcessorOfflineRenderer::~AudioProcessorOfflineRenderer()
+{
+}
+
+//==============================================================================
+AudioProcessorOfflineRenderer::Result AudioProcessorOfflineRenderer::render (AudioFormatWriter* writer,
+                                                                              int64 numSamplesToRender,
+                                                                              const Options& options,
+                                                                              const MidiMessageSequence* midiInput)
+{
+    jassert (writer != nullptr && options.blockSize > 0);
+
+    Result result;
+    std::unique_ptr<AudioFormatWriter> writerDeleter (writer);
+
+    if (writer == nullptr)
+        return result;
+
+    currentOptions = options;
+    currentPosition = 0;
+    shouldCancel = false;
+    progress = 0.0;
+    realtimeFactor = 0.0;
+
+    auto* graph = dynamic_cast<AudioProcessorGraph*> (&processor);
+    auto oldNumRenderThreads = graph != nullptr ? graph->getNumRenderThreads() : 0;
+    auto wasNonRealtime = processor.isNonRealtime();
+
+    if (graph != nullptr)
+        graph->setNumRenderThreads (options.numRenderThreads);
+
+    processor.setNonRealtime (true);
+    processor.setPlayHead (this);
+    processor.setRateAndBufferSizeDetails (options.sampleRate, options.blockSize);
+    processor.prepareToPlay (options.sampleRate, options.blockSize);
+
+    auto numWriterChannels = (int) writer->getNumChannels();
+    auto numProcessorChannels = jmax (processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+    AudioBuffer<float> buffer (jmax (1, numProcessorChannels, numWriterChannels), options.blockSize);
+    MidiBuffer midi;
+    int nextMidiEvent = 0;
+
+    auto startTime = Time::getMillisecondCounterHiRes();
+
+    {
+        TimeSliceThread writerThread ("Offline render writer");
+        writerThread.startThread();
+
+        AudioFormatWriter::ThreadedWriter threadedWriter (writerDeleter.release(), writerThread,
+                                                          jmax (options.numSamplesToBufferForWriting, options.blockSize));
+
+        while (currentPosition < numSamplesToRender && ! shouldCancel)
+        {
+            auto numSamples = (int) jmin ((int64) options.blockSize, numSamplesToRender - currentPosition);
+
+            buffer.clear();
+            midi.clear();
+
+            if (midiInput != nullptr)
+            {
+                for (; nextMidiEvent < midiInput->getNumEvents(); ++nextMidiEvent)
+                {
+                    auto& message = midiInput->getEventPointer (nextMidiEvent)->message;
+                    auto eventPosition = (int64) (message.getTimeStamp() * options.sampleRate) - currentPosition;
+
+                    if (eventPosition >= numSamples)
+                        break;
+
+                    midi.addEvent (message, (int) jmax ((int64) 0, eventPosition));
+                }
+            }
+
+            {
+                AudioBuffer<float> block (buffer.getArrayOfWritePointers(), numProcessorChannels, numSamples);
+
+                const ScopedLock sl (processor.getCallbackLock());
+
+                if (processor.isSuspended())
+                    block.clear();
+                else
+                    processor.processBlock (block, midi);
+            }
+
+            // If the disk can't keep up, wait for it rather than losing any audio
+            while (! threadedWriter.write (buffer.getArrayOfReadPointers(), numSamples))
+            {
+                if (shouldCancel)
+                    break;
+
+                Thread::sleep (1);
+            }
+
+            currentPosition += numSamples;
+
+            auto secondsElapsed = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+            progress = (double) currentPosition / (double) jmax ((int64) 1, numSamplesToRender);
+            realtimeFactor = secondsElapsed > 0 ? ((double) currentPosition / options.sampleRate) / secondsElapsed : 0.0;
+        }
+    }
+
+    result.numSamplesRendered = currentPosition;
+    result.secondsTaken = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    result.wasCancelled = shouldCancel;
+
+    processor.releaseResources();
+    processor.setPlayHead (nullptr);
+    processor.setNonRealtime (wasNonRealtime);
+
+    if (graph != nullptr)
+        graph->setNumRenderThreads (oldNumRenderThreads);
+
+    return result;
+}
+
+//==============================================================================
+bool AudioProcessorOfflineRenderer::getCurrentPosition (CurrentPositionInfo& info)
+{
+    info.resetToDefault();
+
+    info.bpm                = currentOptions.bpm;
+    info.timeSigNumerator   = currentOptions.timeSigNumerator;
+    info.timeSigDenominator = currentOptions.timeSigDenominator;
+    info.timeInSamples      = currentPosition;
+    info.timeInSeconds      = (double) currentPosition / currentOptions.sampleRate;
+    info.isPlaying          = true;
+
+    auto quarterNotesPerBar = info.timeSigNumerator * 4.0 / info.timeSigDenominator;
+    info.ppqPosition = info.timeInSeconds * info.bpm / 60.0;
+    info.ppqPositionOfLastBarStart = std::floor (info.ppqPosition / quarterNotesPerBar) * quarterNotesPerBar;
+
+    return true;
+}
+
+} // namespace juce
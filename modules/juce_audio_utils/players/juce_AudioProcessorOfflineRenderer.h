@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders an AudioProcessor to an audio file as fast as the machine allows.
+
+    This drives the processor directly rather than from an audio device, so it isn't
+    limited to realtime and it doesn't have to use the small blocks that a device
+    needs. The processor is put into non-realtime mode and prepared with the block
+    size from the Options, which is large by default to cut the per-block overhead
+    of every node. If the processor is an AudioProcessorGraph, it's given extra render
+    threads for the duration, so that independent branches of the graph are rendered
+    concurrently. The rendered audio is handed to an AudioFormatWriter::ThreadedWriter,
+    so the file is written on a background thread while the next blocks are being
+    rendered.
+
+    The processor gets an AudioPlayHead which reports a transport playing from zero
+    at the tempo given in the Options.
+
+    render() blocks until it's finished, so it's normally called on a background
+    thread, and cancel(), getProgress() and getRealtimeFactor() may be called from
+    any other thread while it's running. An AudioProcessorGraph builds its rendering
+    sequence on the message thread, so the message thread mustn't be blocked while a
+    graph is being rendered from another thread.
+
+    @see AudioProcessorPlayer, AudioProcessorGraph::setNumRenderThreads
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioProcessorOfflineRenderer  : private AudioPlayHead
+{
+public:
+    //==============================================================================
+    /** Creates a renderer for a processor.
+        The processor isn't owned, and must stay alive for as long as the renderer does.
+    */
+    explicit AudioProcessorOfflineRenderer (AudioProcessor& processorToRender);
+
+    /** Destructor. */
+    ~AudioProcessorOfflineRenderer() override;
+
+    //==============================================================================
+    /** The settings used for a render. */
+    struct Options
+    {
+        /** The sample rate to render at. */
+        double sampleRate = 44100.0;
+
+        /** The number of samples to pass to the processor in each block. Lower this if
+            any of the processors can't cope with large blocks.
+        */
+        int blockSize = 4096;
+
+        /** The number of extra threads to give an AudioProcessorGraph while it renders. */
+        int numRenderThreads = jmax (0, SystemStats::getNumCpus() - 1);
+
+        /** The number of samples that can be queued for the disk-writing thread. */
+        int numSamplesToBufferForWriting = 65536;
+
+        /** The transport details that the processor's AudioPlayHead reports. */
+        double bpm = 120.0;
+        int timeSigNumerator = 4, timeSigDenominator = 4;
+    };
+
+    /** Describes what happened during a render. */
+    struct Result
+    {
+        /** The number of samples that were rendered and written. */
+        int64 numSamplesRendered = 0;
+
+        /** The time taken by the render, including flushing the file at the end. */
+        double secondsTaken = 0;
+
+        /** True if the render was stopped by cancel(). */
+        bool wasCancelled = false;
+
+        /** Returns how many times faster than realtime the render was. */
+        double getRealtimeFactor (double sampleRate) const noexcept
+        {
+            return secondsTaken > 0 ? ((double) numSamplesRendered / sampleRate) / secondsTaken : 0.0;
+        }
+    };
+
+    /** Renders the given number of samples into a writer.
+
+        The writer is owned and deleted by this method, and the file is complete when
+        it returns. The processor's inputs are fed with silence, and if a MIDI sequence
+        is supplied, its events (with timestamps in seconds) are sent to the processor
+        at the right positions. The processor is released again at the end, and its
+        render threads and realtime mode are set back to how they were.
+    */
+    Result render (AudioFormatWriter* writer, int64 numSamplesToRender,
+                   const Options& options,
+                   const MidiMessageSequence* midiInput = nullptr);
+
+    /** Stops a render that's in progress. This can be called from any thread. */
+    void cancel() noexcept                                  { shouldCancel = true; }
+
+    /** Returns the proportion of the current render that's been done, from 0 to 1. */
+    double getProgress() const noexcept                     { return progress.load(); }
+
+    /** Returns how many times faster than realtime the current render is going. */
+    double getRealtimeFactor() const noexcept               { return realtimeFactor.load(); }
+
+private:
+    //==============================================================================
+    AudioProcessor& processor;
+    Options currentOptions;
+    int64 currentPosition = 0;
+    std::atomic<bool> shouldCancel { false };
+    std::atomic<double> progress { 0.0 }, realtimeFactor { 0.0 };
+
+    bool getCurrentPosition (CurrentPositionInfo&) override;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorOfflineRenderer)
+};
+
+} // namespace juce
@@ -57,11 +57,16 @@ void AudioProcessorPlayer::setProcessor (AudioProcessor* const processorToPlay)
 
         {
             const ScopedLock sl (lock);
-            oldOne = isPrepared ? processor : nullptr;
-            processor = processorToPlay;
+            oldOne = processor.exchange (processorToPlay);
+
+            if (! isPrepared)
+                oldOne = nullptr;
+
             isPrepared = true;
         }
 
+        waitForCallbackToFinish();
+
         if (oldOne != nullptr)
             oldOne->releaseResources();
     }
@@ -73,15 +78,19 @@ void AudioProcessorPlayer::setDoublePrecisionProcessing (bool doublePrecision)
     {
         const ScopedLock sl (lock);
 
-        if (processor != nullptr)
+        // (this takes the processor out of the callback while it's being re-prepared)
+        if (auto* current = processor.exchange (nullptr))
         {
-            processor->releaseResources();
+            waitForCallbackToFinish();
+            current->releaseResources();
 
-            bool supportsDouble = processor->supportsDoublePrecisionProcessing() && doublePrecision;
+            bool supportsDouble = current->supportsDoublePrecisionProcessing() && doublePrecision;
 
-            processor->setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
-                                                              : AudioProcessor::singlePrecision);
-            processor->prepareToPlay (sampleRate, blockSize);
+            current->setProcessingPrecision (supportsDouble ? AudioProcessor::doublePrecision
+                                                            : AudioProcessor::singlePrecision);
+            current->prepareToPlay (sampleRate, blockSize);
+
+            processor = current;
         }
 
         isDoublePrecision = doublePrecision;
@@ -92,11 +101,20 @@ void AudioProcessorPlayer::setMidiOutput (MidiOutput* midiOutputToUse)
 {
     if (midiOutput != midiOutputToUse)
     {
-        const ScopedLock sl (lock);
         midiOutput = midiOutputToUse;
+        waitForCallbackToFinish();
     }
 }
 
+void AudioProcessorPlayer::waitForCallbackToFinish() const noexcept
+{
+    // The audio thread never waits for this - each callback just uses whatever the
+    // processor and MIDI output are when it starts, so this only needs to wait for a
+    // callback that's already running to finish with the old ones.
+    while (isInCallback)
+        Thread::yield();
+}
+
 //==============================================================================
 void AudioProcessorPlayer::audioDeviceIOCallback (const float** const inputChannelData,
                                                   const int numInputChannels,
@@ -109,79 +127,96 @@ void AudioProcessorPlayer::audioDeviceIOCallback (const float** const inputChann
 
     incomingMidi.clear();
     messageCollector.removeNextBlockOfMessages (incomingMidi, numSamples);
-    int totalNumChans = 0;
 
-    if (numInputChannels > numOutputChannels)
+    isInCallback = true;
+
+    if (auto* currentProcessor = processor.load())
     {
-        // if there aren't enough output channels for the number of
-        // inputs, we need to create some temporary extra ones (can't
-        // use the input data in case it gets written to)
-        tempBuffer.setSize (numInputChannels - numOutputChannels, numSamples,
-                            false, false, true);
+        const ScopedLock sl (currentProcessor->getCallbackLock());
 
-        for (int i = 0; i < numOutputChannels; ++i)
+        if (! currentProcessor->isSuspended())
         {
-            channels[totalNumChans] = outputChannelData[i];
-            memcpy (channels[totalNumChans], inputChannelData[i], sizeof (float) * (size_t) numSamples);
-            ++totalNumChans;
-        }
+            // there's no need to copy any inputs that the processor isn't going to read
+            auto numInputsToUse = jmin (numInputChannels, currentProcessor->getTotalNumInputChannels());
 
-        for (int i = numOutputChannels; i < numInputChannels; ++i)
-        {
-            channels[totalNumChans] = tempBuffer.getWritePointer (i - numOutputChannels);
-            memcpy (channels[totalNumChans], inputChannelData[i], sizeof (float) * (size_t) numSamples);
-            ++totalNumChans;
+            if (currentProcessor->isUsingDoublePrecision())
+                processDoublePrecision (*currentProcessor, inputChannelData, numInputsToUse,
+                                        outputChannelData, numOutputChannels, numSamples);
+            else
+                processSinglePrecision (*currentProcessor, inputChannelData, numInputsToUse,
+                                        outputChannelData, numOutputChannels, numSamples);
+
+            if (auto* output = midiOutput.load())
+                output->sendBlockOfMessagesNow (incomingMidi);
+
+            isInCallback = false;
+            return;
         }
     }
-    else
+
+    isInCallback = false;
+
+    for (int i = 0; i < numOutputChannels; ++i)
+        FloatVectorOperations::clear (outputChannelData[i], numSamples);
+}
+
+void AudioProcessorPlayer::processSinglePrecision (AudioProcessor& processorToUse,
+                                                   const float** inputChannelData, int numInputs,
+                                                   float** outputChannelData, int numOutputs, int numSamples)
+{
+    // The processor works in-place on the device's output channels. The inputs still have
+    // to be copied into them, as they mustn't be written to, but if there are more inputs
+    // than outputs, only the extra ones need temporary channels of their own.
+    int totalNumChans = 0;
+
+    for (int i = 0; i < numOutputs; ++i)
+    {
+        auto* dest = outputChannelData[i];
+        channels[totalNumChans++] = dest;
+
+        if (i >= numInputs)
+            FloatVectorOperations::clear (dest, numSamples);
+        else if (dest != inputChannelData[i])
+            FloatVectorOperations::copy (dest, inputChannelData[i], numSamples);
+    }
+
+    if (numInputs > numOutputs)
     {
-        for (int i = 0; i < numInputChannels; ++i)
-        {
-            channels[totalNumChans] = outputChannelData[i];
-            memcpy (channels[totalNumChans], inputChannelData[i], sizeof (float) * (size_t) numSamples);
-            ++totalNumChans;
-        }
+        tempBuffer.setSize (numInputs - numOutputs, numSamples, false, false, true);
 
-        for (int i = numInputChannels; i < numOutputChannels; ++i)
+        for (int i = numOutputs; i < numInputs; ++i)
         {
-            channels[totalNumChans] = outputChannelData[i];
-            zeromem (channels[totalNumChans], sizeof (float) * (size_t) numSamples);
-            ++totalNumChans;
+            auto* dest = tempBuffer.getWritePointer (i - numOutputs);
+            channels[totalNumChans++] = dest;
+            FloatVectorOperations::copy (dest, inputChannelData[i], numSamples);
         }
     }
 
     AudioBuffer<float> buffer (channels, totalNumChans, numSamples);
+    processorToUse.processBlock (buffer, incomingMidi);
+}
 
-    {
-        const ScopedLock sl (lock);
+void AudioProcessorPlayer::processDoublePrecision (AudioProcessor& processorToUse,
+                                                   const float** inputChannelData, int numInputs,
+                                                   float** outputChannelData, int numOutputs, int numSamples)
+{
+    // the samples are converted straight from the device's inputs and back into its outputs,
+    // rather than going via a single-precision copy
+    auto totalNumChans = jmax (numInputs, numOutputs);
+    conversionBuffer.setSize (totalNumChans, numSamples, false, false, true);
 
-        if (processor != nullptr)
-        {
-            const ScopedLock sl2 (processor->getCallbackLock());
-
-            if (! processor->isSuspended())
-            {
-                if (processor->isUsingDoublePrecision())
-                {
-                    conversionBuffer.makeCopyOf (buffer, true);
-                    processor->processBlock (conversionBuffer, incomingMidi);
-                    buffer.makeCopyOf (conversionBuffer, true);
-                }
-                else
-                {
-                    processor->processBlock (buffer, incomingMidi);
-                }
-
-                if (midiOutput != nullptr)
-                    midiOutput->sendBlockOfMessagesNow (incomingMidi);
-
-                return;
-            }
-        }
+    for (int i = 0; i < totalNumChans; ++i)
+    {
+        if (i < numInputs)
+            FloatVectorOperations::convertFloatToDouble (conversionBuffer.getWritePointer (i), inputChannelData[i], numSamples);
+        else
+            conversionBuffer.clear (i, 0, numSamples);
     }
 
-    for (int i = 0; i < numOutputChannels; ++i)
-        FloatVectorOperations::clear (outputChannelData[i], numSamples);
+    processorToUse.processBlock (conversionBuffer, incomingMidi);
+
+    for (int i = 0; i < numOutputs; ++i)
+        FloatVectorOperations::convertDoubleToFloat (outputChannelData[i], conversionBuffer.getReadPointer (i), numSamples);
 }
 
 void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
@@ -201,12 +236,11 @@ void AudioProcessorPlayer::audioDeviceAboutToStart (AudioIODevice* const device)
     messageCollector.reset (sampleRate);
     channels.calloc (jmax (numChansIn, numChansOut) + 2);
 
-    if (processor != nullptr)
+    if (auto* oldProcessor = processor.load())
     {
         if (isPrepared)
-            processor->releaseResources();
+            oldProcessor->releaseResources();
 
-        auto* oldProcessor = processor;
         setProcessor (nullptr);
         setProcessor (oldProcessor);
     }
@@ -216,8 +250,9 @@ void AudioProcessorPlayer::audioDeviceStopped()
 {
     const ScopedLock sl (lock);
 
-    if (processor != nullptr && isPrepared)
-        processor->releaseResources();
+    if (auto* current = processor.load())
+        if (isPrepared)
+            current->releaseResources();
 
     sampleRate = 0.0;
     blockSize = 0;
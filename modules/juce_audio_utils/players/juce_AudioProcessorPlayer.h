@@ -38,6 +38,10 @@ namespace juce
     input to send both streams through the processor. To set a MidiOutput for the processor,
     use the setMidiOutput() method.
 
+    The audio callback doesn't share a lock with the other methods: changing the
+    processor or MIDI output swaps the pointer atomically, and then waits for any
+    callback that might still be using the old one to finish.
+
     @see AudioProcessor, AudioProcessorGraph
 
     @tags{Audio}
@@ -103,7 +107,8 @@ public:
 
 private:
     //==============================================================================
-    AudioProcessor* processor = nullptr;
+    std::atomic<AudioProcessor*> processor { nullptr };
+    std::atomic<bool> isInCallback { false };
     CriticalSection lock;
     double sampleRate = 0;
     int blockSize = 0;
@@ -116,7 +121,11 @@ private:
 
     MidiBuffer incomingMidi;
     MidiMessageCollector messageCollector;
-    MidiOutput* midiOutput = nullptr;
+    std::atomic<MidiOutput*> midiOutput { nullptr };
+
+    void waitForCallbackToFinish() const noexcept;
+    void processSinglePrecision (AudioProcessor&, const float**, int numInputs, float**, int numOutputs, int numSamples);
+    void processDoublePrecision (AudioProcessor&, const float**, int numInputs, float**, int numOutputs, int numSamples);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioProcessorPlayer)
 };
@@ -1092,6 +1092,7 @@ private:
             for (auto f : syntaxTree.functions)
                 f->emit (*this);
 
+            optimiseCode (codeStart);
             removeJumpsToNextInstruction (codeStart);
             resolveMarkers();
 
@@ -1184,6 +1185,253 @@ private:
             }
         }
 
+        //==============================================================================
+        // A peephole pass over the generated code. It only ever produces the existing
+        // opcodes, so that the optimised programs will still run on the interpreters
+        // in the firmware of devices that are already out there.
+        void optimiseCode (int codeStart)
+        {
+            for (int pass = 0; pass < 8; ++pass)
+            {
+                bool changed = threadJumps (codeStart);
+
+                for (int address = codeStart; address < outputCode.size();)
+                {
+                    if (simplifyInstructionsAt (address))
+                        changed = true;
+                    else
+                        address += getInstructionSize (address);
+                }
+
+                if (! changed)
+                    break;
+            }
+        }
+
+        OpCode getOpAt (int address) const noexcept         { return (OpCode) outputCode.getUnchecked (address); }
+        int getInstructionSize (int address) const noexcept { return 1 + Program::getNumExtraBytesForOpcode (getOpAt (address)); }
+
+        bool isJumpTarget (int address) const noexcept
+        {
+            for (auto m : resolvedMarkers)
+                if (m.address == address)
+                    return true;
+
+            return false;
+        }
+
+        int findMarkerIndexAtAddress (int address) const noexcept
+        {
+            for (int i = 0; i < markersToResolve.size(); ++i)
+                if (markersToResolve.getReference (i).address == address)
+                    return i;
+
+            return -1;
+        }
+
+        static bool isJump (OpCode op) noexcept
+        {
+            return op == OpCode::jump || op == OpCode::jumpIfTrue || op == OpCode::jumpIfFalse;
+        }
+
+        static bool isUnconditionalExit (OpCode op) noexcept
+        {
+            return op == OpCode::jump || op == OpCode::retVoid || op == OpCode::retValue || op == OpCode::halt;
+        }
+
+        static bool isPushWithoutSideEffects (OpCode op) noexcept
+        {
+            return (op >= OpCode::push0 && op <= OpCode::dupOffset16) || op == OpCode::dupFromGlobal;
+        }
+
+        bool getConstantPushedAt (int address, int32& value) const noexcept
+        {
+            auto* data = outputCode.begin() + address + 1;
+
+            switch (getOpAt (address))
+            {
+                case OpCode::push0:     value = 0; return true;
+                case OpCode::push1:     value = 1; return true;
+                case OpCode::push8:     value = (int8) *data; return true;
+                case OpCode::push16:    value = Program::readInt16 (data); return true;
+                case OpCode::push32:    value = Program::readInt32 (data); return true;
+                default:                return false;
+            }
+        }
+
+        // Makes any jumps which land on another jump go straight to its destination.
+        bool threadJumps (int codeStart)
+        {
+            bool changed = false;
+
+            for (int address = codeStart; address < outputCode.size(); address += getInstructionSize (address))
+            {
+                if (! isJump (getOpAt (address)))
+                    continue;
+
+                auto markerIndex = findMarkerIndexAtAddress (address + 1);
+
+                for (int hops = 0; markerIndex >= 0 && hops < 16; ++hops)
+                {
+                    auto& marker = markersToResolve.getReference (markerIndex).marker;
+                    auto destination = getResolvedMarkerAddress (marker);
+
+                    if (destination >= outputCode.size() || getOpAt (destination) != OpCode::jump)
+                        break;
+
+                    auto nextIndex = findMarkerIndexAtAddress (destination + 1);
+
+                    if (nextIndex < 0 || markersToResolve.getReference (nextIndex).marker.index == marker.index)
+                        break;
+
+                    marker = markersToResolve.getReference (nextIndex).marker;
+                    changed = true;
+                }
+            }
+
+            return changed;
+        }
+
+        // Overwrites a run of instructions with a shorter sequence of code that doesn't
+        // contain any jump addresses.
+        void replaceCode (int address, int oldSize, const uint8* newCode, int newSize)
+        {
+            jassert (newSize <= oldSize);
+
+            for (int i = 0; i < newSize; ++i)
+                outputCode.set (address + i, newCode[i]);
+
+            removeCode (address + newSize, oldSize - newSize);
+        }
+
+        static int createIntPush (uint8* dest, int32 v) noexcept
+        {
+            if (v == 0)                     { dest[0] = (uint8) OpCode::push0; return 1; }
+            if (v == 1)                     { dest[0] = (uint8) OpCode::push1; return 1; }
+            if (v > 0 && v < 128)           { dest[0] = (uint8) OpCode::push8;  dest[1] = (uint8) v; return 2; }
+            if (v > 0 && v < 32768)         { dest[0] = (uint8) OpCode::push16; Program::writeInt16 (dest + 1, (int16) v); return 3; }
+
+            dest[0] = (uint8) OpCode::push32;
+            Program::writeInt32 (dest + 1, v);
+            return 5;
+        }
+
+        // Looks for a wasteful sequence of instructions starting at the given address,
+        // and if one is found, replaces it and returns true.
+        bool simplifyInstructionsAt (int address)
+        {
+            auto op1 = getOpAt (address);
+            auto next = address + getInstructionSize (address);
+
+            if (isUnconditionalExit (op1))
+            {
+                // nothing can reach the code that follows until the next jump target
+                auto end = next;
+
+                while (end < outputCode.size() && ! isJumpTarget (end))
+                    end += getInstructionSize (end);
+
+                if (end == next)
+                    return false;
+
+                removeCode (next, end - next);
+                return true;
+            }
+
+            if (next >= outputCode.size() || isJumpTarget (next))
+                return false;
+
+            auto op2 = getOpAt (next);
+            auto afterOp2 = next + getInstructionSize (next);
+            int32 constant = 0;
+            auto pushesConstant = getConstantPushedAt (address, constant);
+
+            // pushing something and then dropping it again
+            if (op2 == OpCode::drop && isPushWithoutSideEffects (op1))
+            {
+                removeCode (address, afterOp2 - address);
+                return true;
+            }
+
+            // operations that have no effect, e.g. "x + 0" or "x * 1", which also come up
+            // when comparing a value against zero
+            if (pushesConstant
+                 && ((constant == 0 && (op2 == OpCode::add_int32 || op2 == OpCode::sub_int32 || op2 == OpCode::sub_float
+                                         || op2 == OpCode::bitwiseOr || op2 == OpCode::bitwiseXor
+                                         || op2 == OpCode::bitShiftLeft || op2 == OpCode::bitShiftRight))
+                  || (constant == 1 && (op2 == OpCode::mul_int32 || op2 == OpCode::div_int32))))
+            {
+                removeCode (address, afterOp2 - address);
+                return true;
+            }
+
+            // a boolean test which a conditional jump can do by itself
+            if (op2 == OpCode::jumpIfTrue || op2 == OpCode::jumpIfFalse)
+            {
+                if (op1 == OpCode::testNZ_int32)
+                {
+                    removeCode (address, 1);
+                    return true;
+                }
+
+                if (op1 == OpCode::testZE_int32 || op1 == OpCode::logicalNot)
+                {
+                    outputCode.set (next, (uint8) (op2 == OpCode::jumpIfTrue ? OpCode::jumpIfFalse : OpCode::jumpIfTrue));
+                    removeCode (address, 1);
+                    return true;
+                }
+            }
+
+            // storing a global and then reading it straight back
+            if (op1 == OpCode::dropToGlobal && op2 == OpCode::dupFromGlobal
+                 && Program::readInt16 (outputCode.begin() + address + 1) == Program::readInt16 (outputCode.begin() + next + 1))
+            {
+                uint8 newCode[] = { (uint8) OpCode::dup, (uint8) OpCode::dropToGlobal,
+                                    outputCode.getUnchecked (address + 1), outputCode.getUnchecked (address + 2) };
+                replaceCode (address, afterOp2 - address, newCode, (int) sizeof (newCode));
+                return true;
+            }
+
+            // adding or subtracting two constants in a row, e.g. "(x + 1) - 4"
+            if (pushesConstant && (op2 == OpCode::add_int32 || op2 == OpCode::sub_int32)
+                 && afterOp2 < outputCode.size() && ! isJumpTarget (afterOp2))
+            {
+                int32 constant2 = 0;
+                auto afterPush2 = afterOp2 + getInstructionSize (afterOp2);
+
+                if (getConstantPushedAt (afterOp2, constant2) && afterPush2 < outputCode.size() && ! isJumpTarget (afterPush2))
+                {
+                    auto op4 = getOpAt (afterPush2);
+
+                    if (op4 == OpCode::add_int32 || op4 == OpCode::sub_int32)
+                    {
+                        auto total = (op2 == OpCode::add_int32 ? (uint32) constant  : 0u - (uint32) constant)
+                                   + (op4 == OpCode::add_int32 ? (uint32) constant2 : 0u - (uint32) constant2);
+                        auto oldSize = afterPush2 + 1 - address;
+
+                        if (total == 0)
+                        {
+                            removeCode (address, oldSize);
+                            return true;
+                        }
+
+                        auto negate = (int32) total < 0 && total != 0x80000000u;
+                        uint8 newCode[6];
+                        auto newSize = createIntPush (newCode, negate ? -(int32) total : (int32) total);
+                        newCode[newSize++] = (uint8) (negate ? OpCode::sub_int32 : OpCode::add_int32);
+
+                        if (newSize <= oldSize)
+                        {
+                            replaceCode (address, oldSize, newCode, newSize);
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+
         Marker breakTarget, continueTarget;
 
         //==============================================================================
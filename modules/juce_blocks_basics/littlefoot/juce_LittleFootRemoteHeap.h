@@ -300,7 +300,10 @@ private:
             ranges.ensureStorageAllocated ((int) blockSize);
 
             for (int i = 0; i < (int) blockSize; ++i)
-                ranges.add ({ i, 1, newData[i] == current[i], false });
+            {
+                auto isSame = newData[i] == current[i];
+                ranges.add ({ i, 1, isSame ? 0 : 1, isSame, false, false });
+            }
 
             coalesceUniformRegions();
             coalesceSequences();
@@ -331,57 +334,85 @@ private:
             p.writePacketSysexHeaderBytes ((uint8) deviceIndex);
             p.beginDataChanges (nextPacketIndex);
 
+            auto anyRegionsDeferred = selectRegionsToSend (p.getRemainingDataChangeBits());
+
             uint8 lastValue = 0;
+            int numToSkip = 0;
             bool packetOverflow = false;
 
             for (auto& r : ranges)
             {
-                if (r.isSkipped)
+                if (r.isSkipped || r.isDeferred)
                 {
-                    packetOverflow = ! p.skipBytes (r.length);
+                    numToSkip += r.length;
+                    continue;
                 }
-                else if (r.isMixed)
+
+                packetOverflow = ! p.skipBytes (numToSkip);
+                numToSkip = 0;
+
+                if (packetOverflow)
+                    break;
+
+                auto numWritten = r.length;
+
+                if (r.isMixed)
                 {
                     jassert (r.length > 1);
                     packetOverflow = ! p.setMultipleBytes (newData + r.index, r.length);
 
-                    if (! packetOverflow)
-                        lastValue = newData[r.index + r.length - 1];
+                    if (packetOverflow)
+                    {
+                        // send as much of a long sequence as there's room for
+                        auto bitsPerByte = PacketBuilder::getSequenceOfBytesSize (1) - PacketBuilder::getSequenceOfBytesSize (0);
+                        numWritten = jmin (r.length, (p.getRemainingDataChangeBits() - PacketBuilder::getSequenceOfBytesSize (0)) / bitsPerByte);
+
+                        if (numWritten <= 0 || ! p.setMultipleBytes (newData + r.index, numWritten))
+                            break;
+                    }
+
+                    lastValue = newData[r.index + numWritten - 1];
                 }
                 else
                 {
                     auto value = newData[r.index];
                     packetOverflow = ! p.setMultipleBytes (value, lastValue, r.length);
 
-                    if (! packetOverflow)
-                        lastValue = value;
+                    if (packetOverflow)
+                        break;
+
+                    lastValue = value;
                 }
 
+                for (int i = r.index; i < r.index + numWritten; ++i)
+                    message.resultDataState[i] = newData[i];
+
                 if (packetOverflow)
                     break;
-
-                if (! r.isSkipped)
-                    for (int i = r.index; i < r.index + r.length; ++i)
-                        message.resultDataState[i] = newData[i];
             }
 
-            p.endDataChanges (! packetOverflow);
+            auto moreToSend = packetOverflow || anyRegionsDeferred;
+
+            p.endDataChanges (! moreToSend);
             p.writePacketSysexFooter();
 
-            return packetOverflow;
+            return moreToSend;
         }
 
     private:
         struct ByteSequence
         {
-            int index, length;
-            bool isSkipped, isMixed;
+            int index, length, numChanged;
+            bool isSkipped, isMixed, isDeferred;
         };
 
         const uint8* const newData;
         const size_t blockSize;
         Array<ByteSequence> ranges;
 
+        using PacketBuilder = typename ImplementationClass::PacketBuilder;
+
+        //==============================================================================
         void coalesceUniformRegions()
         {
             for (int i = ranges.size(); --i > 0;)
@@ -393,32 +424,108 @@ private:
                      && (r1.isSkipped || newData[r1.index] == newData[r2.index]))
                 {
                     r1.length += r2.length;
+                    r1.numChanged += r2.numChanged;
                     ranges.remove (i);
                     i = jmin (ranges.size() - 1, i + 1);
                 }
             }
         }
 
+        // Decides which of the uniform and unchanged runs would be cheaper to send
+        // as part of a longer sequence of bytes. For each run, this keeps track of the
+        // cheapest encoding that ends in a closed command, and the cheapest one that
+        // leaves a sequence open, and then walks back along whichever was best.
         void coalesceSequences()
         {
-            for (int i = ranges.size(); --i > 0;)
+            auto numRanges = ranges.size();
+
+            if (numRanges == 0)
+                return;
+
+            enum { closed = 0, inSequence = 1 };
+
+            struct Step
             {
-                auto& r1 = ranges.getReference (i - 1);
-                auto r2 = ranges.getReference (i);
+                int cost[2];
+                uint8 lastValue[2];
+                uint8 previous[2];
+            };
 
-                if (! (r1.isSkipped || r2.isSkipped)
-                     && (r1.isMixed || r1.length == 1)
-                     && (r2.isMixed || r2.length == 1))
+            HeapBlock<Step> steps ((size_t) numRanges + 1);
+            auto unreachable = std::numeric_limits<int>::max() / 2;
+
+            steps[0] = { { 0, unreachable }, { 0, 0 }, { closed, closed } };
+
+            for (int i = 0; i < numRanges; ++i)
+            {
+                auto& r = ranges.getReference (i);
+                auto& before = steps[i];
+                auto& after = steps[i + 1];
+                auto sequenceCost = PacketBuilder::getSequenceOfBytesSize (r.length) - PacketBuilder::getSequenceOfBytesSize (0);
+
+                if (r.isSkipped)
+                {
+                    auto from = before.cost[inSequence] < before.cost[closed] ? inSequence : closed;
+                    after.cost[closed] = before.cost[from] + PacketBuilder::getSkipBytesSize (r.length);
+                    after.lastValue[closed] = before.lastValue[from];
+                    after.previous[closed] = (uint8) from;
+
+                    after.cost[inSequence] = before.cost[inSequence] + sequenceCost;
+                    after.previous[inSequence] = inSequence;
+                }
+                else
+                {
+                    auto value = newData[r.index];
+                    auto costFromClosed   = before.cost[closed]     + PacketBuilder::getMultipleBytesSize (r.length, value == before.lastValue[closed]);
+                    auto costFromSequence = before.cost[inSequence] + PacketBuilder::getMultipleBytesSize (r.length, value == before.lastValue[inSequence]);
+
+                    after.previous[closed] = (uint8) (costFromSequence < costFromClosed ? inSequence : closed);
+                    after.cost[closed] = jmin (costFromClosed, costFromSequence);
+
+                    costFromClosed   = before.cost[closed] + PacketBuilder::getSequenceOfBytesSize (r.length);
+                    costFromSequence = before.cost[inSequence] + sequenceCost;
+
+                    after.previous[inSequence] = (uint8) (costFromSequence < costFromClosed ? inSequence : closed);
+                    after.cost[inSequence] = jmin (costFromClosed, costFromSequence);
+                }
+
+                after.lastValue[closed] = r.isSkipped ? after.lastValue[closed] : newData[r.index];
+                after.lastValue[inSequence] = newData[r.index + r.length - 1];
+            }
+
+            Array<bool> isInSequence;
+            isInSequence.insertMultiple (0, false, numRanges);
+
+            int state = steps[numRanges].cost[inSequence] < steps[numRanges].cost[closed] ? inSequence : closed;
+
+            for (int i = numRanges; --i >= 0;)
+            {
+                isInSequence.set (i, state == inSequence);
+                state = steps[i + 1].previous[state];
+            }
+
+            for (int i = numRanges; --i >= 0;)
+            {
+                if (isInSequence[i])
                 {
-                    if (r1.length + r2.length < 32)
+                    auto& r = ranges.getReference (i);
+                    r.isSkipped = false;
+                    r.isMixed = true;
+
+                    if (i + 1 < ranges.size() && isInSequence[i + 1])
                     {
-                        r1.length += r2.length;
-                        r1.isMixed = true;
-                        ranges.remove (i);
-                        i = jmin (ranges.size() - 1, i + 1);
+                        auto next = ranges.getReference (i + 1);
+                        r.length += next.length;
+                        r.numChanged += next.numChanged;
+                        ranges.remove (i + 1);
                     }
                 }
             }
+
+            // a sequence of one byte is just a uniform run
+            for (auto& r : ranges)
+                if (r.isMixed && r.length == 1)
+                    r.isMixed = false;
         }
 
         void trim()
@@ -426,6 +533,105 @@ private:
             while (ranges.size() > 0 && ranges.getLast().isSkipped)
                 ranges.removeLast();
         }
+
+        //==============================================================================
+        // If all the changes won't fit into one packet, this picks out the groups of
+        // changes that touch the most bytes and leaves the rest for a later packet, so
+        // that the most visible parts of an update (e.g. the pixels that changed in a
+        // redraw) reach the device first. Returns true if anything was left out.
+        bool selectRegionsToSend (int numBitsAvailable)
+        {
+            if (getNumBitsNeeded() <= numBitsAvailable)
+                return false;
+
+            struct Region
+            {
+                int firstRange, numRanges, numChanged;
+            };
+
+            Array<Region> regions;
+
+            for (int i = 0; i < ranges.size(); ++i)
+            {
+                auto& r = ranges.getReference (i);
+
+                if (r.isSkipped)
+                    continue;
+
+                if (i == 0 || ranges.getReference (i - 1).isSkipped)
+                    regions.add ({ i, 0, 0 });
+
+                auto& region = regions.getReference (regions.size() - 1);
+                region.numRanges++;
+                region.numChanged += r.numChanged;
+                r.isDeferred = true;
+            }
+
+            std::stable_sort (regions.begin(), regions.end(),
+                              [] (const Region& a, const Region& b) { return a.numChanged > b.numChanged; });
+
+            auto smallestChange = PacketBuilder::getSkipBytesSize (1) + PacketBuilder::getSequenceOfBytesSize (1);
+            bool anyDeferred = false;
+
+            for (int i = 0; i < regions.size(); ++i)
+            {
+                auto& region = regions.getReference (i);
+                setDeferred (region.firstRange, region.numRanges, false);
+
+                auto numBitsNeeded = getNumBitsNeeded();
+
+                // the first region always goes in, even if only part of it will fit
+                if (i > 0 && numBitsNeeded > numBitsAvailable)
+                {
+                    setDeferred (region.firstRange, region.numRanges, true);
+                    anyDeferred = true;
+                    continue;
+                }
+
+                if (numBitsAvailable - numBitsNeeded < smallestChange)
+                    return anyDeferred || i < regions.size() - 1;
+            }
+
+            return anyDeferred;
+        }
+
+        void setDeferred (int firstRange, int numRanges, bool shouldBeDeferred) noexcept
+        {
+            for (int i = firstRange; i < firstRange + numRanges; ++i)
+                ranges.getReference (i).isDeferred = shouldBeDeferred;
+        }
+
+        // Mirrors the way createChangeMessage writes the ranges that aren't deferred
+        int getNumBitsNeeded() const noexcept
+        {
+            int total = 0, numToSkip = 0;
+            uint8 lastValue = 0;
+
+            for (auto& r : ranges)
+            {
+                if (r.isSkipped || r.isDeferred)
+                {
+                    numToSkip += r.length;
+                    continue;
+                }
+
+                total += PacketBuilder::getSkipBytesSize (numToSkip);
+                numToSkip = 0;
+
+                if (r.isMixed)
+                {
+                    total += PacketBuilder::getSequenceOfBytesSize (r.length);
+                    lastValue = newData[r.index + r.length - 1];
+                }
+                else
+                {
+                    total += PacketBuilder::getMultipleBytesSize (r.length, newData[r.index] == lastValue);
+                    lastValue = newData[r.index];
+                }
+            }
+
+            return total;
+        }
     };
 };
 
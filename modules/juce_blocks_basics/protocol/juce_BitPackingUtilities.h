@@ -115,6 +115,11 @@ struct Packed7BitArrayBuilder
         return ((bytesWritten + 2) * 7 + bitsInCurrentByte + bitsNeeded) <= allocatedBytes * 7;
     }
 
+    int getRemainingBits() const noexcept
+    {
+        return jmax (0, allocatedBytes * 7 - ((bytesWritten + 2) * 7 + bitsInCurrentByte));
+    }
+
     void writeHeaderSysexBytes (uint8 deviceIndex) noexcept
     {
         jassert (bytesWritten + bitsInCurrentByte == 0);
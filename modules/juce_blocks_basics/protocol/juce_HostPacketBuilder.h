@@ -203,6 +203,54 @@ struct HostPacketBuilder
         return true;
     }
 
+    /** Returns the number of bits that a call to skipBytes() will add to the packet. */
+    static int getSkipBytesSize (int numToSkip) noexcept
+    {
+        int size = 0;
+
+        for (; numToSkip > ByteCountMany::maxValue; numToSkip -= ByteCountMany::maxValue)
+            size += DataChangeCommand::bits + ByteCountMany::bits;
+
+        if (numToSkip <= 0)
+            return size;
+
+        return size + DataChangeCommand::bits + (numToSkip > ByteCountFew::maxValue ? (int) ByteCountMany::bits
+                                                                                    : (int) ByteCountFew::bits);
+    }
+
+    /** Returns the number of bits that a call to setMultipleBytes() with a sequence of values will add to the packet. */
+    static int getSequenceOfBytesSize (int num) noexcept
+    {
+        return DataChangeCommand::bits + num * (ByteValue::bits + ByteSequenceContinues::bits);
+    }
+
+    /** Returns the number of bits that a call to setMultipleBytes() with a single repeated value will add to the packet. */
+    static int getMultipleBytesSize (int num, bool isSameAsLastValue) noexcept
+    {
+        if (num == 1)
+            return getSequenceOfBytesSize (1);
+
+        int size = 0;
+
+        for (; num > ByteCountMany::maxValue; num -= ByteCountMany::maxValue)
+            size += DataChangeCommand::bits + ByteCountMany::bits + ByteValue::bits;
+
+        if (num > ByteCountFew::maxValue)
+            return size + DataChangeCommand::bits + ByteCountMany::bits + ByteValue::bits;
+
+        if (num > 0)
+            return size + DataChangeCommand::bits + ByteCountFew::bits + (isSameAsLastValue ? 0 : ByteValue::bits);
+
+        return size;
+    }
+
+    /** Returns the number of bits left for data changes, keeping enough room for endDataChanges(). */
+    int getRemainingDataChangeBits() const noexcept
+    {
+        return jmax (0, data.getRemainingBits() - DataChangeCommand::bits);
+    }
+
+    //==============================================================================
     bool addProgramEventMessage (const int32* messageData)
     {
         if (! data.hasCapacity (BitSizes::programEventMessage))
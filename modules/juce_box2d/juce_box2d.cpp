@@ -104,6 +104,7 @@ using uint32 = juce::uint32;
 #include "box2d/Rope/b2Rope.cpp"
 
 #include "utils/juce_Box2DRenderer.cpp"
+#include "utils/juce_Box2DSimulation.cpp"
 
 #if defined (__clang__)
  #pragma clang diagnostic pop
@@ -73,6 +73,8 @@
  #pragma GCC diagnostic pop
 #endif
 
+#include "utils/juce_Box2DSimulation.h"
+
 #ifndef DOXYGEN // for some reason, Doxygen sees this as a re-definition of Box2DRenderer
  #include "utils/juce_Box2DRenderer.h"
 #endif // DOXYGEN
@@ -32,20 +32,93 @@ Box2DRenderer::Box2DRenderer() noexcept   : graphics (nullptr)
     SetFlags (e_shapeBit);
 }
 
+static void addWorldTransform (Graphics& g, float left, float top, float right, float bottom,
+                               const Rectangle<float>& target)
+{
+    g.addTransform (AffineTransform::fromTargetPoints (left,  top,    target.getX(),     target.getY(),
+                                                       right, top,    target.getRight(), target.getY(),
+                                                       left,  bottom, target.getX(),     target.getBottom()));
+}
+
 void Box2DRenderer::render (Graphics& g, b2World& world,
                             float left, float top, float right, float bottom,
                             const Rectangle<float>& target)
 {
     graphics = &g;
-
-    g.addTransform (AffineTransform::fromTargetPoints (left,  top,    target.getX(),     target.getY(),
-                                                       right, top,    target.getRight(), target.getY(),
-                                                       left,  bottom, target.getX(),     target.getBottom()));
+    addWorldTransform (g, left, top, right, bottom, target);
 
     world.SetDebugDraw (this);
     world.DrawDebugData();
 }
 
+void Box2DRenderer::render (Graphics& g, Box2DSimulation& simulation,
+                            float left, float top, float right, float bottom,
+                            const Rectangle<float>& target)
+{
+    graphics = &g;
+    addWorldTransform (g, left, top, right, bottom, target);
+
+    auto& snapshot = simulation.getLatestSnapshot();
+    auto timeSinceStep = (Time::getMillisecondCounterHiRes() - snapshot.timeOfStep) / 1000.0;
+    auto proportion = (float32) jlimit (0.0, 1.0, timeSinceStep / simulation.getStepInterval());
+
+    for (auto& shape : snapshot.shapes)
+    {
+        auto& body = snapshot.bodies.getReference (shape.bodyIndex);
+
+        b2Transform xf (body.previousPosition + proportion * (body.position - body.previousPosition),
+                        b2Rot (body.previousAngle + proportion * (body.angle - body.previousAngle)));
+
+        drawShape (shape, snapshot.vertices.begin() + shape.firstVertex, xf);
+    }
+}
+
+// (this draws the shapes in the same way as b2World::DrawShape())
+void Box2DRenderer::drawShape (const Box2DSimulation::Snapshot::Shape& shape,
+                               const b2Vec2* vertices, const b2Transform& xf)
+{
+    switch (shape.type)
+    {
+        case b2Shape::e_circle:
+            DrawSolidCircle (b2Mul (xf, vertices[0]), shape.radius, b2Mul (xf.q, b2Vec2 (1.0f, 0.0f)), shape.colour);
+            break;
+
+        case b2Shape::e_edge:
+            DrawSegment (b2Mul (xf, vertices[0]), b2Mul (xf, vertices[1]), shape.colour);
+            break;
+
+        case b2Shape::e_chain:
+        {
+            auto v1 = b2Mul (xf, vertices[0]);
+
+            for (int i = 1; i < shape.numVertices; ++i)
+            {
+                auto v2 = b2Mul (xf, vertices[i]);
+                DrawSegment (v1, v2, shape.colour);
+                DrawCircle (v1, 0.05f, shape.colour);
+                v1 = v2;
+            }
+
+            break;
+        }
+
+        case b2Shape::e_polygon:
+        {
+            b2Vec2 transformed[b2_maxPolygonVertices];
+            auto numVertices = jmin (shape.numVertices, (int) b2_maxPolygonVertices);
+
+            for (int i = 0; i < numVertices; ++i)
+                transformed[i] = b2Mul (xf, vertices[i]);
+
+            DrawSolidPolygon (transformed, numVertices, shape.colour);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
 Colour Box2DRenderer::getColour (const b2Color& c) const
 {
     return Colour::fromFloatRGBA (c.r, c.g, c.b, 1.0f);
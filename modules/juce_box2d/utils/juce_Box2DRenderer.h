@@ -31,7 +31,8 @@ namespace juce
 /** A simple implementation of the b2Draw class, used to draw a Box2D world.
 
     To use it, simply create an instance of this class in your paint() method,
-    and call its render() method.
+    and call its render() method. It can either draw a b2World directly, or draw
+    the latest state of a Box2DSimulation that's stepping a world on another thread.
 
     @tags{Box2D}
 */
@@ -58,6 +59,24 @@ public:
                  float box2DWorldRight, float box2DWorldBottom,
                  const Rectangle<float>& targetArea);
 
+    /** Renders the latest state of a simulation that's running on another thread.
+
+        The bodies are drawn part of the way between their positions before and after
+        the most recent step, according to how much time has passed since it happened,
+        so they'll move smoothly even though painting isn't in sync with the steps.
+        (This means that what gets drawn is up to one step behind the simulation).
+
+        This calls Box2DSimulation::getLatestSnapshot(), so it should always be called
+        from the same thread.
+
+        @see render
+    */
+    void render (Graphics& g,
+                 Box2DSimulation& simulation,
+                 float box2DWorldLeft, float box2DWorldTop,
+                 float box2DWorldRight, float box2DWorldBottom,
+                 const Rectangle<float>& targetArea);
+
     // b2Draw methods:
     void DrawPolygon (const b2Vec2*, int32, const b2Color&) override;
     void DrawSolidPolygon (const b2Vec2*, int32, const b2Color&) override;
@@ -74,6 +93,9 @@ public:
 protected:
     Graphics* graphics;
 
+private:
+    void drawShape (const Box2DSimulation::Snapshot::Shape&, const b2Vec2* vertices, const b2Transform&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DRenderer)
 };
 
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+Box2DSimulation::Box2DSimulation (b2World& w, double stepsPerSecond, int velocityIts, int positionIts)
+    : Thread ("Box2D simulation"),
+      world (w),
+      stepInterval (1.0 / stepsPerSecond),
+      velocityIterations (velocityIts),
+      positionIterations (positionIts)
+{
+    jassert (stepsPerSecond > 0);
+}
+
+Box2DSimulation::~Box2DSimulation()
+{
+    stop();
+}
+
+void Box2DSimulation::start()
+{
+    if (! isThreadRunning())
+    {
+        // (this gives the renderer something to draw before the first step has happened)
+        capturePreviousPositions();
+        writeSnapshot();
+
+        startThread();
+    }
+}
+
+void Box2DSimulation::stop()
+{
+    stopThread (2000);
+
+    // anything that was queued after the last step still needs to be applied
+    runPendingCalls();
+}
+
+void Box2DSimulation::callOnSimulationThread (std::function<void (b2World&)> function)
+{
+    if (isThreadRunning())
+    {
+        const ScopedLock sl (pendingCallLock);
+        pendingCalls.add (std::move (function));
+    }
+    else
+    {
+        function (world);
+    }
+}
+
+void Box2DSimulation::runPendingCalls()
+{
+    Array<std::function<void (b2World&)>> calls;
+
+    {
+        const ScopedLock sl (pendingCallLock);
+        calls.swapWith (pendingCalls);
+    }
+
+    for (auto& f : calls)
+        f (world);
+}
+
+//==============================================================================
+void Box2DSimulation::run()
+{
+    auto stepIntervalMs = stepInterval * 1000.0;
+    auto nextStepTime = Time::getMillisecondCounterHiRes();
+
+    while (! threadShouldExit())
+    {
+        auto now = Time::getMillisecondCounterHiRes();
+
+        if (now < nextStepTime)
+        {
+            wait (jmax (1, (int) (nextStepTime - now)));
+            continue;
+        }
+
+        runPendingCalls();
+        step();
+
+        nextStepTime += stepIntervalMs;
+
+        // if it's fallen a long way behind (e.g. because the machine was asleep), it's
+        // better to carry on from now than to run lots of steps trying to catch up
+        if (now - nextStepTime > stepIntervalMs * 5)
+            nextStepTime = now;
+    }
+}
+
+void Box2DSimulation::step()
+{
+    capturePreviousPositions();
+    world.Step ((float32) stepInterval, velocityIterations, positionIterations);
+    ++numSteps;
+    writeSnapshot();
+}
+
+void Box2DSimulation::capturePreviousPositions()
+{
+    previousPositions.clearQuick();
+    previousAngles.clearQuick();
+
+    for (auto* b = world.GetBodyList(); b != nullptr; b = b->GetNext())
+    {
+        previousPositions.add (b->GetPosition());
+        previousAngles.add (b->GetAngle());
+    }
+}
+
+//==============================================================================
+struct Box2DSimulationHelpers
+{
+    // (these are the same colours that b2World::DrawDebugData() uses)
+    static b2Color getColourForBody (const b2Body& b)
+    {
+        if (! b.IsActive())                     return b2Color (0.5f, 0.5f, 0.3f);
+        if (b.GetType() == b2_staticBody)       return b2Color (0.5f, 0.9f, 0.5f);
+        if (b.GetType() == b2_kinematicBody)    return b2Color (0.5f, 0.5f, 0.9f);
+        if (! b.IsAwake())                      return b2Color (0.6f, 0.6f, 0.6f);
+
+        return b2Color (0.9f, 0.7f, 0.7f);
+    }
+
+    static void addShape (Box2DSimulation::Snapshot& s, int bodyIndex, const b2Shape& shape, const b2Color& colour)
+    {
+        auto firstVertex = s.vertices.size();
+
+        switch (shape.GetType())
+        {
+            case b2Shape::e_circle:
+                s.vertices.add (static_cast<const b2CircleShape&> (shape).m_p);
+                break;
+
+            case b2Shape::e_edge:
+            {
+                auto& edge = static_cast<const b2EdgeShape&> (shape);
+                s.vertices.add (edge.m_vertex1, edge.m_vertex2);
+                break;
+            }
+
+            case b2Shape::e_chain:
+            {
+                auto& chain = static_cast<const b2ChainShape&> (shape);
+                s.vertices.addArray (chain.m_vertices, chain.m_count);
+                break;
+            }
+
+            case b2Shape::e_polygon:
+            {
+                auto& polygon = static_cast<const b2PolygonShape&> (shape);
+                s.vertices.addArray (polygon.m_vertices, polygon.m_vertexCount);
+                break;
+            }
+
+            default:
+                return;
+        }
+
+        s.shapes.add ({ bodyIndex, shape.GetType(), colour, firstVertex,
+                        s.vertices.size() - firstVertex, shape.m_radius });
+    }
+};
+
+void Box2DSimulation::writeSnapshot()
+{
+    auto& s = snapshots[writingSnapshot];
+
+    s.bodies.clearQuick();
+    s.shapes.clearQuick();
+    s.vertices.clearQuick();
+
+    int bodyIndex = 0;
+
+    for (auto* b = world.GetBodyList(); b != nullptr; b = b->GetNext())
+    {
+        s.bodies.add ({ previousPositions[bodyIndex], b->GetPosition(),
+                        previousAngles[bodyIndex], b->GetAngle() });
+
+        auto colour = Box2DSimulationHelpers::getColourForBody (*b);
+
+        for (auto* f = b->GetFixtureList(); f != nullptr; f = f->GetNext())
+            Box2DSimulationHelpers::addShape (s, bodyIndex, *f->GetShape(), colour);
+
+        ++bodyIndex;
+    }
+
+    s.timeOfStep = Time::getMillisecondCounterHiRes();
+    s.stepNumber = numSteps;
+
+    // The three snapshots rotate between the writer, the reader and the most recently
+    // finished one, so handing a new one over is just a matter of swapping indexes.
+    writingSnapshot = latestSnapshot.exchange (writingSnapshot | 4) & 3;
+}
+
+const Box2DSimulation::Snapshot& Box2DSimulation::getLatestSnapshot()
+{
+    if ((latestSnapshot.load() & 4) != 0)
+        readingSnapshot = latestSnapshot.exchange (readingSnapshot) & 3;
+
+    return snapshots[readingSnapshot];
+}
+
+} // namespace juce
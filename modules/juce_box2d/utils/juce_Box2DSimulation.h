@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Steps a Box2D world at a fixed rate on a background thread, and keeps a copy of
+    the state of its bodies that can be drawn from another thread.
+
+    Each time the world is stepped, the shapes of its fixtures are copied along with
+    the position of each body before and after the step. A Box2DRenderer can then
+    interpolate between those two positions, so that the motion looks smooth no matter
+    how the painting rate lines up with the step rate, and the physics doesn't slow
+    down when painting gets expensive. The copies are handed over without any locking,
+    so the painting and the stepping never hold each other up.
+
+    While the simulation is running, the world belongs to its thread. To add or remove
+    bodies, apply forces or make any other changes, use callOnSimulationThread().
+
+    @code
+    Box2DSimulation simulation (world);
+    simulation.start();
+
+    // in paint():
+    Box2DRenderer renderer;
+    renderer.render (g, simulation, -8.0f, -8.0f, 8.0f, 8.0f, getLocalBounds().toFloat());
+    @endcode
+
+    @see Box2DRenderer
+
+    @tags{Box2D}
+*/
+class Box2DSimulation   : private Thread
+{
+public:
+    /** Creates a simulation for a world.
+
+        The world must stay alive for as long as this object exists. The two iteration
+        counts are passed to b2World::Step().
+    */
+    Box2DSimulation (b2World& world,
+                     double stepsPerSecond = 60.0,
+                     int velocityIterations = 8,
+                     int positionIterations = 3);
+
+    /** Destructor. This stops the simulation if it's running. */
+    ~Box2DSimulation();
+
+    //==============================================================================
+    /** Starts stepping the world on the background thread. */
+    void start();
+
+    /** Stops the background thread, leaving the world in whatever state it's reached. */
+    void stop();
+
+    /** Returns true if the background thread is stepping the world. */
+    bool isRunning() const                      { return isThreadRunning(); }
+
+    /** Returns the length of each step, in seconds. */
+    double getStepInterval() const noexcept     { return stepInterval; }
+
+    /** Queues a function that will be called on the simulation thread, between steps,
+        where it can safely modify the world.
+
+        If the simulation isn't running, the function is called straight away.
+    */
+    void callOnSimulationThread (std::function<void (b2World&)> function);
+
+    //==============================================================================
+    /** The state of the world's bodies after a step. */
+    struct Snapshot
+    {
+        struct Body
+        {
+            b2Vec2 previousPosition, position;
+            float32 previousAngle, angle;
+        };
+
+        struct Shape
+        {
+            int bodyIndex;
+            b2Shape::Type type;
+            b2Color colour;
+            int firstVertex, numVertices;
+            float32 radius;
+        };
+
+        Array<Body> bodies;
+        Array<Shape> shapes;
+        Array<b2Vec2> vertices;        // the shapes' vertices, in body coordinates
+        double timeOfStep = 0;         // from Time::getMillisecondCounterHiRes()
+        uint32 stepNumber = 0;
+    };
+
+    /** Returns the state of the world after the most recent step.
+
+        This never blocks, and the snapshot that's returned isn't modified until the
+        next time it's called. That means it must only be called from one thread (such
+        as the message thread, when painting).
+    */
+    const Snapshot& getLatestSnapshot();
+
+private:
+    //==============================================================================
+    b2World& world;
+    const double stepInterval;
+    const int velocityIterations, positionIterations;
+
+    Snapshot snapshots[3];
+    std::atomic<int> latestSnapshot { 1 };      // (the 4 bit is set when it hasn't been read yet)
+    int readingSnapshot = 0, writingSnapshot = 2;
+
+    Array<std::function<void (b2World&)>> pendingCalls;
+    CriticalSection pendingCallLock;
+
+    Array<b2Vec2> previousPositions;
+    Array<float32> previousAngles;
+    uint32 numSteps = 0;
+
+    void run() override;
+    void step();
+    void runPendingCalls();
+    void capturePreviousPositions();
+    void writeSnapshot();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Box2DSimulation)
+};
+
+} // namespace juce
@@ -0,0 +1,288 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A list of listeners that can be called from any thread, including a realtime
+    audio thread, without locking or allocating.
+
+    The listeners are kept in an immutable snapshot. Each call to add(), remove()
+    or clear() copies the current snapshot, modifies the copy and then atomically
+    publishes it, so a call() never blocks and always iterates a consistent set of
+    listeners, even if other threads are changing the list at the same time.
+
+    Old snapshots can't be deleted while a call() might still be iterating them, so
+    they're put aside and deleted later by whichever thread next modifies the list
+    (or by the destructor). The threads that call the listeners therefore never
+    free any memory, which is what makes it suitable for broadcasting things like
+    parameter changes or meter levels from the audio thread.
+
+    The price of this is that a listener which is removed may still receive a
+    callback from a call() that had already started on another thread. If the
+    listener is about to be deleted, call waitForPendingCalls() after removing it.
+
+    It's fine to add or remove listeners from inside one of the callbacks, but the
+    change only affects calls that start afterwards - the call that's in progress
+    carries on iterating the snapshot it started with.
+
+    @code
+    ConcurrentListenerList<MeterListener> meterListeners;
+
+    // on the audio thread:
+    meterListeners.call ([level] (MeterListener& l) { l.levelChanged (level); });
+    @endcode
+
+    @see ListenerList
+
+    @tags{Core}
+*/
+template <class ListenerClass>
+class ConcurrentListenerList
+{
+public:
+    //==============================================================================
+    /** Creates an empty list. */
+    ConcurrentListenerList() = default;
+
+    /** Destructor.
+        No calls may be in progress on other threads when the list is deleted.
+    */
+    ~ConcurrentListenerList()
+    {
+        jassert (numCallsInProgress[0].load() == 0 && numCallsInProgress[1].load() == 0);
+
+        delete current.exchange (nullptr);
+        deleteSnapshots (retired);
+    }
+
+    //==============================================================================
+    /** Adds a listener to the list.
+        A listener can only be added once, so if the listener is already in the list,
+        this method has no effect.
+    */
+    void add (ListenerClass* listenerToAdd)
+    {
+        if (listenerToAdd == nullptr)
+        {
+            jassertfalse;  // Listeners can't be null pointers!
+            return;
+        }
+
+        const ScopedLock sl (writeLock);
+        auto* snapshot = current.load();
+
+        if (snapshot != nullptr && snapshot->listeners.contains (listenerToAdd))
+            return;
+
+        auto* newSnapshot = new Snapshot();
+
+        if (snapshot != nullptr)
+            newSnapshot->listeners = snapshot->listeners;
+
+        newSnapshot->listeners.add (listenerToAdd);
+        publish (newSnapshot);
+    }
+
+    /** Removes a listener from the list.
+        If the listener wasn't in the list, this has no effect.
+
+        This never waits for calls on other threads, so it can safely be used from
+        inside a callback, but a call that has already started may still reach the
+        listener. Use waitForPendingCalls() if that matters.
+    */
+    void remove (ListenerClass* listenerToRemove)
+    {
+        jassert (listenerToRemove != nullptr); // Listeners can't be null pointers!
+
+        const ScopedLock sl (writeLock);
+        auto* snapshot = current.load();
+
+        if (snapshot == nullptr || ! snapshot->listeners.contains (listenerToRemove))
+            return;
+
+        Snapshot* newSnapshot = nullptr;
+
+        if (snapshot->listeners.size() > 1)
+        {
+            newSnapshot = new Snapshot();
+            newSnapshot->listeners = snapshot->listeners;
+            newSnapshot->listeners.removeFirstMatchingValue (listenerToRemove);
+        }
+
+        publish (newSnapshot);
+    }
+
+    /** Removes all the listeners. */
+    void clear()
+    {
+        const ScopedLock sl (writeLock);
+
+        if (current.load() != nullptr)
+            publish (nullptr);
+    }
+
+    /** Returns the number of registered listeners. */
+    int size() const noexcept
+    {
+        const ScopedCall call (*this);
+        return call.snapshot != nullptr ? call.snapshot->listeners.size() : 0;
+    }
+
+    /** Returns true if no listeners are registered, false otherwise. */
+    bool isEmpty() const noexcept                   { return size() == 0; }
+
+    /** Returns true if the specified listener has been added to the list. */
+    bool contains (ListenerClass* listener) const noexcept
+    {
+        const ScopedCall call (*this);
+        return call.snapshot != nullptr && call.snapshot->listeners.contains (listener);
+    }
+
+    //==============================================================================
+    /** Calls a function on each listener in the list.
+        This is wait-free and doesn't allocate, so it can be used on the audio thread.
+    */
+    template <typename Callback>
+    void call (Callback&& callback) const
+    {
+        const ScopedCall call (*this);
+
+        if (call.snapshot != nullptr)
+            for (int i = call.snapshot->listeners.size(); --i >= 0;)
+                callback (*call.snapshot->listeners.getUnchecked (i));
+    }
+
+    /** Calls a function on each listener in the list, except the one specified. */
+    template <typename Callback>
+    void callExcluding (ListenerClass* listenerToExclude, Callback&& callback) const
+    {
+        const ScopedCall call (*this);
+
+        if (call.snapshot != nullptr)
+        {
+            for (int i = call.snapshot->listeners.size(); --i >= 0;)
+            {
+                auto* l = call.snapshot->listeners.getUnchecked (i);
+
+                if (l != listenerToExclude)
+                    callback (*l);
+            }
+        }
+    }
+
+    //==============================================================================
+    /** Blocks until every call() that was in progress when this method was invoked
+        has finished.
+
+        Calls that start while this is waiting never see a listener that was removed
+        beforehand, so they don't hold it up. This must not be used from inside one
+        of the list's own callbacks, as it would wait for itself forever.
+    */
+    void waitForPendingCalls() const
+    {
+        const ScopedLock sl (waitLock);
+
+        // Flipping the epoch twice means that every call which could have been
+        // counted under either slot before we started has now left it.
+        for (int i = 0; i < 2; ++i)
+        {
+            auto oldSlot = epoch.fetch_add (1) & 1;
+
+            while (numCallsInProgress[oldSlot].load() != 0)
+                Thread::yield();
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Snapshot
+    {
+        Array<ListenerClass*> listeners;
+        Snapshot* nextRetired = nullptr;
+    };
+
+    struct ScopedCall
+    {
+        ScopedCall (const ConcurrentListenerList& l) noexcept
+            : owner (l), slot (l.epoch.load() & 1)
+        {
+            // The count must be visible before the snapshot is loaded, so that a writer
+            // which retires this snapshot afterwards knows it's still in use.
+            owner.numCallsInProgress[slot].fetch_add (1);
+            snapshot = owner.current.load();
+        }
+
+        ~ScopedCall() noexcept
+        {
+            owner.numCallsInProgress[slot].fetch_sub (1);
+        }
+
+        const ConcurrentListenerList& owner;
+        const uint32 slot;
+        const Snapshot* snapshot;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedCall)
+    };
+
+    // Must be called with the writeLock held
+    void publish (Snapshot* newSnapshot)
+    {
+        if (auto* old = current.exchange (newSnapshot))
+        {
+            old->nextRetired = retired;
+            retired = old;
+        }
+
+        // A call that loaded one of the retired snapshots bumped its counter before
+        // doing so, so if both counters read zero after the new snapshot has been
+        // published, nobody can still be looking at the old ones.
+        if (retired != nullptr
+             && numCallsInProgress[0].load() == 0
+             && numCallsInProgress[1].load() == 0)
+        {
+            deleteSnapshots (retired);
+            retired = nullptr;
+        }
+    }
+
+    static void deleteSnapshots (Snapshot* s)
+    {
+        while (s != nullptr)
+        {
+            std::unique_ptr<Snapshot> toDelete (s);
+            s = s->nextRetired;
+        }
+    }
+
+    std::atomic<Snapshot*> current { nullptr };
+    mutable std::atomic<uint32> epoch { 0 };
+    mutable std::atomic<int> numCallsInProgress[2] { { 0 }, { 0 } };
+    Snapshot* retired = nullptr;
+    CriticalSection writeLock, waitLock;
+
+    JUCE_DECLARE_NON_COPYABLE (ConcurrentListenerList)
+};
+
+} // namespace juce
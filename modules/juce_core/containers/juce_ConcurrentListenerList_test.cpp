@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct ConcurrentListenerListTests  : public UnitTest
+{
+    ConcurrentListenerListTests() : UnitTest ("ConcurrentListenerList", "Containers") {}
+
+    struct TestListener
+    {
+        std::atomic<int> numCalls { 0 };
+        void callback()      { ++numCalls; }
+    };
+
+    void runTest() override
+    {
+        beginTest ("Adding and removing");
+        {
+            ConcurrentListenerList<TestListener> list;
+            TestListener a, b, c;
+
+            expect (list.isEmpty());
+
+            list.add (&a);
+            list.add (&b);
+            list.add (&a);
+            expectEquals (list.size(), 2);
+            expect (list.contains (&a) && list.contains (&b) && ! list.contains (&c));
+
+            list.call ([] (TestListener& l) { l.callback(); });
+            list.callExcluding (&b, [] (TestListener& l) { l.callback(); });
+            expectEquals (a.numCalls.load(), 2);
+            expectEquals (b.numCalls.load(), 1);
+
+            list.remove (&a);
+            list.remove (&c);
+            expectEquals (list.size(), 1);
+            expect (! list.contains (&a));
+
+            list.clear();
+            expect (list.isEmpty());
+            list.call ([] (TestListener& l) { l.callback(); });
+            expectEquals (b.numCalls.load(), 1);
+        }
+
+        beginTest ("Modifying the list from a callback");
+        {
+            ConcurrentListenerList<TestListener> list;
+            TestListener a, b;
+            list.add (&a);
+            list.add (&b);
+
+            // The call that's running keeps the snapshot it started with
+            list.call ([&] (TestListener& l)
+            {
+                l.callback();
+                list.remove (&a);
+                list.remove (&b);
+            });
+
+            expectEquals (a.numCalls.load(), 1);
+            expectEquals (b.numCalls.load(), 1);
+            expect (list.isEmpty());
+        }
+
+        beginTest ("Calling while other threads modify the list");
+        {
+            enum { numListeners = 16, numWriters = 3 };
+
+            ConcurrentListenerList<TestListener> list;
+            TestListener listeners[numListeners];
+            std::atomic<bool> finished { false };
+            std::atomic<int> numCallsMade { 0 };
+
+            struct TestThread  : public Thread
+            {
+                TestThread (std::function<void()> f) : Thread ("listener test"), fn (f) {}
+                void run() override    { fn(); }
+                std::function<void()> fn;
+            };
+
+            OwnedArray<Thread> threads;
+
+            for (int w = 0; w < numWriters; ++w)
+            {
+                threads.add (new TestThread ([&, w]
+                {
+                    Random r (w);
+
+                    for (int i = 0; i < 5000; ++i)
+                    {
+                        auto* l = listeners + r.nextInt (numListeners);
+
+                        if (r.nextBool())
+                            list.add (l);
+                        else
+                            list.remove (l);
+                    }
+                }));
+            }
+
+            threads.add (new TestThread ([&]
+            {
+                while (! finished.load())
+                    list.call ([&] (TestListener& l) { l.callback(); ++numCallsMade; });
+            }));
+
+            for (auto* t : threads)
+                t->startThread();
+
+            for (int w = 0; w < numWriters; ++w)
+                threads.getUnchecked (w)->waitForThreadToExit (-1);
+
+            list.clear();
+            list.waitForPendingCalls();
+
+            // Once the waiting is done, nothing can reach the removed listeners
+            const int numCallsAfterWaiting = numCallsMade.load();
+            Thread::sleep (5);
+            expectEquals (numCallsMade.load(), numCallsAfterWaiting);
+
+            finished = true;
+            threads.getLast()->waitForThreadToExit (-1);
+
+            int total = 0;
+
+            for (auto& l : listeners)
+                total += l.numCalls.load();
+
+            expectEquals (total, numCallsMade.load());
+        }
+    }
+};
+
+static ConcurrentListenerListTests concurrentListenerListTests;
+
+} // namespace juce
@@ -0,0 +1,588 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    The hash functions that FlatHashMap and FlatHashSet use by default.
+
+    Unlike the DefaultHashFunctions used by HashMap, these return a full 32-bit hash rather
+    than a slot index. Strings, StringRefs, Identifiers and string literals all hash to the
+    same value for the same text, which is what lets the flat containers look up String
+    keys without having to create a String first.
+
+    To use other key types, write a class with a similar set of static hash() functions
+    and pass it as the HashFunctionType template parameter.
+
+    @tags{Core}
+*/
+struct FlatHashFunctions
+{
+    /** Hashes an integer or enum value. */
+    template <typename IntegerType>
+    static typename std::enable_if<std::is_integral<IntegerType>::value || std::is_enum<IntegerType>::value, uint32>::type
+        hash (IntegerType key) noexcept
+    {
+        return mix ((uint64) (int64) key);
+    }
+
+    /** Hashes a pointer. */
+    static uint32 hash (const void* key) noexcept           { return mix ((uint64) (pointer_sized_uint) key); }
+
+    /** Hashes some text. */
+    static uint32 hash (StringRef key) noexcept
+    {
+        // FNV-1a over the characters, so the result doesn't depend on how the text is stored
+        uint32 result = 2166136261u;
+
+        for (auto t = key.text; ! t.isEmpty();)
+            result = (result ^ (uint32) t.getAndAdvance()) * 16777619u;
+
+        return mix (result);
+    }
+
+    /** Hashes some text. */
+    static uint32 hash (const String& key) noexcept         { return hash (StringRef (key)); }
+
+    /** Hashes some text. */
+    static uint32 hash (const char* key) noexcept           { return hash (StringRef (key)); }
+
+    /** Hashes an Identifier. */
+    static uint32 hash (const Identifier& key) noexcept     { return hash (StringRef (key.toString())); }
+
+    /** Hashes a Uuid. */
+    static uint32 hash (const Uuid& key) noexcept           { return mix (key.hash()); }
+
+private:
+    // The tables use the low bits of the hash, so make sure that every bit of the key
+    // affects them (this is the finaliser from SplitMix64)
+    static uint32 mix (uint64 h) noexcept
+    {
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+        return (uint32) (h ^ (h >> 31));
+    }
+};
+
+#ifndef DOXYGEN
+namespace FlatHashHelpers
+{
+    struct NoValue {};
+
+    /*  An open-addressing hash table using robin-hood insertion, where an element that's
+        further from its home slot than the one being inserted takes the slot. This keeps
+        probe sequences short, and lets removal shift the following elements back rather
+        than leaving tombstones. The elements live in one contiguous block, with a separate
+        byte per slot holding its distance from home (plus one, so that zero means empty).
+    */
+    template <typename KeyType, typename ValueType, typename HashFunctionType>
+    class Table
+    {
+    public:
+        struct Element
+        {
+            Element (const KeyType& k, ValueType v) : key (k), value (std::move (v)) {}
+
+            KeyType key;
+            ValueType value;
+        };
+
+        Table() = default;
+
+        Table (const Table& other)
+        {
+            reserve (other.numElements);
+
+            for (int i = 0; i < other.capacity; ++i)
+                if (other.distances[i] != 0)
+                    insertNew (other.elements()[i].key, other.elements()[i].value);
+        }
+
+        Table (Table&& other) noexcept
+        {
+            swapWith (other);
+        }
+
+        Table& operator= (const Table& other)
+        {
+            if (this != &other)
+            {
+                Table copy (other);
+                swapWith (copy);
+            }
+
+            return *this;
+        }
+
+        Table& operator= (Table&& other) noexcept
+        {
+            swapWith (other);
+            return *this;
+        }
+
+        ~Table()
+        {
+            clear();
+        }
+
+        //==============================================================================
+        int size() const noexcept               { return numElements; }
+        int getCapacity() const noexcept        { return capacity; }
+
+        void clear()
+        {
+            for (int i = 0; i < capacity; ++i)
+            {
+                if (distances[i] != 0)
+                {
+                    elements()[i].~Element();
+                    distances[i] = 0;
+                }
+            }
+
+            numElements = 0;
+        }
+
+        void reserve (int numElementsNeeded)
+        {
+            auto capacityNeeded = getCapacityForSize (numElementsNeeded);
+
+            if (capacityNeeded > capacity)
+                rehash (capacityNeeded);
+        }
+
+        void swapWith (Table& other) noexcept
+        {
+            std::swap (storage, other.storage);
+            std::swap (distances, other.distances);
+            std::swap (capacity, other.capacity);
+            std::swap (numElements, other.numElements);
+        }
+
+        //==============================================================================
+        template <typename LookupType>
+        int indexOf (const LookupType& key) const noexcept
+        {
+            if (numElements == 0)
+                return -1;
+
+            auto mask = capacity - 1;
+            auto index = (int) HashFunctionType::hash (key) & mask;
+
+            for (uint8 distance = 1;; ++distance)
+            {
+                auto d = distances[index];
+
+                // finding an element that's closer to its home than this one would be means
+                // that the key isn't in the table
+                if (d < distance)
+                    return -1;
+
+                if (d == distance && elements()[index].key == key)
+                    return index;
+
+                index = (index + 1) & mask;
+            }
+        }
+
+        Element& getElement (int index) const noexcept
+        {
+            jassert (isPositiveAndBelow (index, capacity) && distances[index] != 0);
+            return elements()[index];
+        }
+
+        int getNextOccupiedIndex (int index) const noexcept
+        {
+            while (++index < capacity)
+                if (distances[index] != 0)
+                    return index;
+
+            return capacity;
+        }
+
+        /** Returns the index of the key, adding it with a default value if it's not there. */
+        int findOrInsert (const KeyType& key)
+        {
+            auto index = indexOf (key);
+            return index >= 0 ? index : insertNew (key, ValueType());
+        }
+
+        bool removeAt (int index)
+        {
+            if (index < 0)
+                return false;
+
+            auto mask = capacity - 1;
+            elements()[index].~Element();
+
+            // shift back any following elements that aren't already in their home slots
+            for (auto next = (index + 1) & mask; distances[next] > 1; next = (next + 1) & mask)
+            {
+                new (elements() + index) Element (std::move (elements()[next]));
+                elements()[next].~Element();
+                distances[index] = (uint8) (distances[next] - 1);
+                index = next;
+            }
+
+            distances[index] = 0;
+            --numElements;
+            return true;
+        }
+
+    private:
+        //==============================================================================
+        using ElementStorage = typename std::aligned_storage<sizeof (Element), alignof (Element)>::type;
+
+        HeapBlock<ElementStorage> storage;
+        HeapBlock<uint8> distances;
+        int capacity = 0, numElements = 0;
+
+        enum { maxDistance = 255 };
+
+        Element* elements() const noexcept      { return reinterpret_cast<Element*> (storage.get()); }
+
+        // keeps the table no more than 7/8 full
+        static int getCapacityForSize (int numElementsNeeded) noexcept
+        {
+            return numElementsNeeded <= 0 ? 0 : nextPowerOfTwo (jmax (8, numElementsNeeded + numElementsNeeded / 7 + 1));
+        }
+
+        int insertNew (const KeyType& key, ValueType value)
+        {
+            if (getCapacityForSize (numElements + 1) > capacity)
+                rehash (getCapacityForSize (numElements + 1));
+
+            auto index = place (Element (key, std::move (value)));
+            return index >= 0 ? index : indexOf (key);
+        }
+
+        // Returns the slot that the element ended up in, or -1 if the table had to be
+        // rehashed, in which case it could be anywhere
+        int place (Element&& newElement)
+        {
+            auto mask = capacity - 1;
+            auto index = (int) HashFunctionType::hash (newElement.key) & mask;
+            int firstIndex = -1;
+            int distance = 1;
+
+            for (;;)
+            {
+                if (distance >= maxDistance)
+                {
+                    // A probe sequence this long means the hash function is doing a bad job,
+                    // but spreading the elements over a bigger table will still shorten it
+                    jassertfalse;
+                    rehash (capacity * 2);
+                    place (std::move (newElement));
+                    return -1;
+                }
+
+                auto d = distances[index];
+
+                if (d == 0)
+                {
+                    new (elements() + index) Element (std::move (newElement));
+                    distances[index] = (uint8) distance;
+                    ++numElements;
+                    return firstIndex >= 0 ? firstIndex : index;
+                }
+
+                if (d < distance)
+                {
+                    // this slot's element is closer to its home, so take its place and
+                    // carry on looking for somewhere to put it instead
+                    std::swap (newElement, elements()[index]);
+                    distances[index] = (uint8) distance;
+                    distance = d;
+
+                    if (firstIndex < 0)
+                        firstIndex = index;
+                }
+
+                index = (index + 1) & mask;
+                ++distance;
+            }
+        }
+
+        void rehash (int newCapacity)
+        {
+            jassert (isPowerOfTwo (newCapacity) && newCapacity >= getCapacityForSize (numElements));
+
+            Table newTable;
+            newTable.storage.malloc ((size_t) newCapacity);
+            newTable.distances.calloc ((size_t) newCapacity);
+            newTable.capacity = newCapacity;
+
+            for (int i = 0; i < capacity; ++i)
+                if (distances[i] != 0)
+                    newTable.place (std::move (elements()[i]));
+
+            swapWith (newTable);
+        }
+    };
+}
+#endif
+
+//==============================================================================
+/**
+    A hash map that keeps its elements in one contiguous block of memory.
+
+    This is an alternative to HashMap for lookup tables that are used on performance-critical
+    paths. HashMap allocates a separate object for every element and chains them together,
+    whereas this uses open addressing (with robin-hood insertion), so adding an element to a
+    map that has enough capacity doesn't allocate, and a lookup usually only touches one or
+    two neighbouring slots. Use reserve() to allocate space for all the elements up-front.
+
+    Heterogeneous lookup is supported: any type that can be compared with the key type and
+    hashed by the HashFunctionType can be used to look up an element. With the default
+    FlatHashFunctions, a map with String keys can be searched using a StringRef or a
+    string literal, without creating a temporary String.
+
+    @code
+    FlatHashMap<String, int> paramIndexes;
+    paramIndexes.reserve (numParams);
+    paramIndexes.set ("gain", 0);
+
+    if (auto* index = paramIndexes.find (StringRef ("gain")))
+        ...
+    @endcode
+
+    Adding or removing elements may move other elements around, so pointers to values and
+    iterators are only valid until the map is next modified. The map isn't thread-safe.
+
+    @see FlatHashSet, HashMap
+
+    @tags{Core}
+*/
+template <typename KeyType, typename ValueType, typename HashFunctionType = FlatHashFunctions>
+class FlatHashMap
+{
+    using TableType = FlatHashHelpers::Table<KeyType, ValueType, HashFunctionType>;
+
+public:
+    //==============================================================================
+    /** Creates an empty map. This doesn't allocate any memory. */
+    FlatHashMap() = default;
+
+    /** Creates an empty map with enough space for the given number of elements. */
+    explicit FlatHashMap (int numElementsToReserve)         { reserve (numElementsToReserve); }
+
+    //==============================================================================
+    /** Returns the number of elements in the map. */
+    int size() const noexcept                                { return table.size(); }
+
+    /** Returns true if the map is empty. */
+    bool isEmpty() const noexcept                            { return table.size() == 0; }
+
+    /** Returns the number of slots that have been allocated. */
+    int getCapacity() const noexcept                         { return table.getCapacity(); }
+
+    /** Removes all the elements, but keeps the memory that was allocated. */
+    void clear()                                             { table.clear(); }
+
+    /** Makes sure that the given number of elements can be added without reallocating. */
+    void reserve (int numElements)                           { table.reserve (numElements); }
+
+    /** Swaps the contents of this map with another one. */
+    void swapWith (FlatHashMap& other) noexcept              { table.swapWith (other.table); }
+
+    //==============================================================================
+    /** Returns a pointer to the value for a key, or nullptr if the key isn't in the map. */
+    template <typename LookupType>
+    ValueType* find (const LookupType& key) noexcept
+    {
+        auto index = table.indexOf (key);
+        return index >= 0 ? &(table.getElement (index).value) : nullptr;
+    }
+
+    /** Returns a pointer to the value for a key, or nullptr if the key isn't in the map. */
+    template <typename LookupType>
+    const ValueType* find (const LookupType& key) const noexcept
+    {
+        auto index = table.indexOf (key);
+        return index >= 0 ? &(table.getElement (index).value) : nullptr;
+    }
+
+    /** Returns true if the map contains the given key. */
+    template <typename LookupType>
+    bool contains (const LookupType& key) const noexcept     { return table.indexOf (key) >= 0; }
+
+    /** Returns a copy of the value for a key, or a default-constructed value if it's not there. */
+    template <typename LookupType>
+    ValueType operator[] (const LookupType& key) const
+    {
+        if (auto* v = find (key))
+            return *v;
+
+        return ValueType();
+    }
+
+    /** Returns a reference to the value for a key, adding it with a default value if
+        it's not already there.
+    */
+    ValueType& getReference (const KeyType& key)             { return table.getElement (table.findOrInsert (key)).value; }
+
+    /** Sets the value for a key, adding it if it's not already in the map. */
+    void set (const KeyType& key, ValueType newValue)        { getReference (key) = std::move (newValue); }
+
+    /** Removes a key from the map, returning true if it was there. */
+    template <typename LookupType>
+    bool remove (const LookupType& key)                      { return table.removeAt (table.indexOf (key)); }
+
+    //==============================================================================
+    /** Iterates the elements of a FlatHashMap, in no particular order.
+        Dereferencing the iterator gives you the value, and getKey() the key.
+    */
+    template <bool isConst>
+    struct IteratorBase
+    {
+        using MapType = typename std::conditional<isConst, const FlatHashMap, FlatHashMap>::type;
+        using ValueRef = typename std::conditional<isConst, const ValueType&, ValueType&>::type;
+
+        IteratorBase (MapType& m, int i) noexcept : map (&m), index (i) {}
+
+        const KeyType& getKey() const noexcept               { return map->table.getElement (index).key; }
+        ValueRef getValue() const noexcept                   { return map->table.getElement (index).value; }
+        ValueRef operator*() const noexcept                  { return getValue(); }
+
+        IteratorBase& operator++() noexcept                  { index = map->table.getNextOccupiedIndex (index); return *this; }
+        bool operator== (const IteratorBase& other) const noexcept  { return index == other.index; }
+        bool operator!= (const IteratorBase& other) const noexcept  { return index != other.index; }
+
+    private:
+        MapType* map;
+        int index;
+    };
+
+    using Iterator = IteratorBase<false>;
+    using ConstIterator = IteratorBase<true>;
+
+    Iterator begin() noexcept                    { return { *this, table.getNextOccupiedIndex (-1) }; }
+    Iterator end() noexcept                      { return { *this, table.getCapacity() }; }
+    ConstIterator begin() const noexcept         { return { *this, table.getNextOccupiedIndex (-1) }; }
+    ConstIterator end() const noexcept           { return { *this, table.getCapacity() }; }
+
+private:
+    //==============================================================================
+    TableType table;
+
+    JUCE_LEAK_DETECTOR (FlatHashMap)
+};
+
+//==============================================================================
+/**
+    A set of unique keys, stored in one contiguous block of memory.
+
+    This uses the same open-addressing table as FlatHashMap, and supports the same kind of
+    heterogeneous lookup.
+
+    @see FlatHashMap
+
+    @tags{Core}
+*/
+template <typename KeyType, typename HashFunctionType = FlatHashFunctions>
+class FlatHashSet
+{
+    using TableType = FlatHashHelpers::Table<KeyType, FlatHashHelpers::NoValue, HashFunctionType>;
+
+public:
+    //==============================================================================
+    /** Creates an empty set. This doesn't allocate any memory. */
+    FlatHashSet() = default;
+
+    /** Creates an empty set with enough space for the given number of keys. */
+    explicit FlatHashSet (int numElementsToReserve)          { reserve (numElementsToReserve); }
+
+    /** Returns the number of keys in the set. */
+    int size() const noexcept                                { return table.size(); }
+
+    /** Returns true if the set is empty. */
+    bool isEmpty() const noexcept                            { return table.size() == 0; }
+
+    /** Returns the number of slots that have been allocated. */
+    int getCapacity() const noexcept                         { return table.getCapacity(); }
+
+    /** Removes all the keys, but keeps the memory that was allocated. */
+    void clear()                                             { table.clear(); }
+
+    /** Makes sure that the given number of keys can be added without reallocating. */
+    void reserve (int numElements)                           { table.reserve (numElements); }
+
+    /** Swaps the contents of this set with another one. */
+    void swapWith (FlatHashSet& other) noexcept              { table.swapWith (other.table); }
+
+    /** Adds a key, returning true if it wasn't already in the set. */
+    bool add (const KeyType& key)
+    {
+        auto oldSize = table.size();
+        table.findOrInsert (key);
+        return table.size() > oldSize;
+    }
+
+    /** Returns true if the set contains the given key. */
+    template <typename LookupType>
+    bool contains (const LookupType& key) const noexcept     { return table.indexOf (key) >= 0; }
+
+    /** Returns a pointer to the stored key that matches the one given, or nullptr if
+        there isn't one.
+    */
+    template <typename LookupType>
+    const KeyType* find (const LookupType& key) const noexcept
+    {
+        auto index = table.indexOf (key);
+        return index >= 0 ? &(table.getElement (index).key) : nullptr;
+    }
+
+    /** Removes a key, returning true if it was there. */
+    template <typename LookupType>
+    bool remove (const LookupType& key)                      { return table.removeAt (table.indexOf (key)); }
+
+    //==============================================================================
+    /** Iterates the keys of a FlatHashSet, in no particular order. */
+    struct Iterator
+    {
+        Iterator (const FlatHashSet& s, int i) noexcept : set (&s), index (i) {}
+
+        const KeyType& operator*() const noexcept            { return set->table.getElement (index).key; }
+
+        Iterator& operator++() noexcept                      { index = set->table.getNextOccupiedIndex (index); return *this; }
+        bool operator== (const Iterator& other) const noexcept  { return index == other.index; }
+        bool operator!= (const Iterator& other) const noexcept  { return index != other.index; }
+
+    private:
+        const FlatHashSet* set;
+        int index;
+    };
+
+    Iterator begin() const noexcept              { return { *this, table.getNextOccupiedIndex (-1) }; }
+    Iterator end() const noexcept                { return { *this, table.getCapacity() }; }
+
+private:
+    //==============================================================================
+    TableType table;
+
+    JUCE_LEAK_DETECTOR (FlatHashSet)
+};
+
+} // namespace juce
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FlatHashMapTests  : public UnitTest
+{
+public:
+    FlatHashMapTests() : UnitTest ("FlatHashMap", "Containers") {}
+
+    void runTest() override
+    {
+        beginTest ("Random operations match std::map");
+        {
+            Random r (getRandom().nextInt64());
+            FlatHashMap<int, int> map;
+            std::map<int, int> groundTruth;
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                auto key = r.nextInt (2000);
+
+                if (r.nextInt (3) == 0)
+                {
+                    expectEquals ((int) map.remove (key), (int) groundTruth.erase (key));
+                }
+                else
+                {
+                    auto value = r.nextInt();
+                    map.set (key, value);
+                    groundTruth[key] = value;
+                }
+
+                expectEquals (map.size(), (int) groundTruth.size());
+            }
+
+            for (auto& pair : groundTruth)
+            {
+                auto* value = map.find (pair.first);
+                expect (value != nullptr && *value == pair.second);
+            }
+
+            int numIterated = 0;
+
+            for (auto it = map.begin(); it != map.end(); ++it)
+            {
+                auto found = groundTruth.find (it.getKey());
+                expect (found != groundTruth.end() && found->second == *it);
+                ++numIterated;
+            }
+
+            expectEquals (numIterated, map.size());
+
+            for (int key = 2000; key < 2100; ++key)
+                expect (! map.contains (key));
+        }
+
+        beginTest ("String keys can be looked up without creating a String");
+        {
+            FlatHashMap<String, int> map;
+
+            for (int i = 0; i < 100; ++i)
+                map.set ("key" + String (i), i);
+
+            expectEquals (map["key42"], 42);
+            expectEquals (map[StringRef ("key7")], 7);
+            expectEquals (map[String ("key99")], 99);
+            expect (map.contains (String ("key0")));
+            expect (! map.contains ("key100"));
+
+            expect (map.remove (StringRef ("key42")));
+            expect (! map.contains ("key42"));
+            expectEquals (map.size(), 99);
+
+            expect (FlatHashFunctions::hash (String ("abc")) == FlatHashFunctions::hash (StringRef ("abc")));
+            expect (FlatHashFunctions::hash (Identifier ("abc")) == FlatHashFunctions::hash ("abc"));
+        }
+
+        beginTest ("reserve() allocates space up-front");
+        {
+            FlatHashMap<int64, String> map;
+            expectEquals (map.getCapacity(), 0);
+
+            map.reserve (1000);
+            auto capacity = map.getCapacity();
+            expect (capacity >= 1000);
+
+            for (int i = 0; i < 1000; ++i)
+                map.set (i * 7919, String (i));
+
+            expectEquals (map.getCapacity(), capacity);
+            expectEquals (map[(int64) 7919 * 500], String (500));
+
+            map.clear();
+            expect (map.isEmpty());
+            expectEquals (map.getCapacity(), capacity);
+        }
+
+        beginTest ("Copying and moving");
+        {
+            FlatHashMap<String, String> map;
+
+            for (int i = 0; i < 50; ++i)
+                map.set (String (i), String (i * 2));
+
+            auto copy = map;
+            map.set ("0", "changed");
+            expectEquals (copy.size(), 50);
+            expectEquals (copy["0"], String ("0"));
+            expectEquals (copy["49"], String ("98"));
+
+            auto moved = std::move (copy);
+            expectEquals (moved.size(), 50);
+            expectEquals (moved["10"], String ("20"));
+
+            moved.getReference ("new") = "value";
+            expectEquals (moved["new"], String ("value"));
+            expectEquals (moved.size(), 51);
+        }
+
+        beginTest ("FlatHashSet");
+        {
+            FlatHashSet<String> set;
+
+            expect (set.add ("a"));
+            expect (set.add ("b"));
+            expect (! set.add ("a"));
+            expectEquals (set.size(), 2);
+            expect (set.contains (StringRef ("b")));
+
+            StringArray keys;
+
+            for (auto& key : set)
+                keys.add (key);
+
+            keys.sort (false);
+            expectEquals (keys.joinIntoString (","), String ("a,b"));
+
+            expect (set.remove ("a"));
+            expect (! set.contains ("a"));
+            expectEquals (set.size(), 1);
+        }
+    }
+};
+
+static FlatHashMapTests flatHashMapTests;
+
+} // namespace juce
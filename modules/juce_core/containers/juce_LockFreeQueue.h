@@ -0,0 +1,419 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#ifndef DOXYGEN
+namespace LockFreeQueueHelpers
+{
+    // Keeps the indexes that are written by different threads on separate cache lines
+    enum { cacheLineSize = 64 };
+
+    template <typename Type>
+    struct PaddedAtomic
+    {
+        std::atomic<Type> value { 0 };
+        char padding[cacheLineSize];
+    };
+
+    inline int getCapacityForSize (int requestedSize) noexcept
+    {
+        jassert (requestedSize > 0);
+        return nextPowerOfTwo (jmax (2, requestedSize));
+    }
+
+    /*  Repeatedly tries an operation until it succeeds or the timeout expires. This
+        polls rather than waiting on an event, so that the thread on the other end
+        of the queue never has to signal anything.
+    */
+    template <typename AttemptFn>
+    bool retryUntilTimeout (AttemptFn&& attempt, int timeOutMilliseconds)
+    {
+        if (attempt())
+            return true;
+
+        auto start = Time::getMillisecondCounter();
+
+        for (int numTries = 0;; ++numTries)
+        {
+            if (timeOutMilliseconds >= 0 && Time::getMillisecondCounter() - start >= (uint32) timeOutMilliseconds)
+                return false;
+
+            if (numTries < 64)
+                Thread::yield();
+            else
+                Thread::sleep (1);
+
+            if (attempt())
+                return true;
+        }
+    }
+}
+#endif
+
+//==============================================================================
+/**
+    A bounded, lock-free queue of objects, for one writer thread and one reader thread.
+
+    This does the same job as an AbstractFifo, but stores the items itself. All its storage
+    is allocated by the constructor, so push() and pop() are safe to use on the audio thread
+    (provided that assigning a ItemType object doesn't allocate either). As well as single
+    items, whole blocks of items can be added or removed at once with pushBatch() and
+    popBatch().
+
+    Only one thread may push items and only one thread may pop them at any time. If you need
+    more than one writer, use a LockFreeMPSCQueue or LockFreeMPMCQueue instead.
+
+    The pushWithTimeout() and popWithTimeout() methods wait for space or for an item to
+    become available. They poll the queue rather than blocking, so the thread at the other
+    end never has to wake them, but they mustn't be used on the audio thread.
+
+    @see LockFreeMPSCQueue, LockFreeMPMCQueue, AbstractFifo
+
+    @tags{Core}
+*/
+template <typename ItemType>
+class LockFreeSPSCQueue
+{
+public:
+    /** Creates a queue that can hold at least the given number of items.
+        The capacity is rounded up to a power of two.
+    */
+    explicit LockFreeSPSCQueue (int minimumCapacity)
+        : capacity (LockFreeQueueHelpers::getCapacityForSize (minimumCapacity)),
+          items (new ItemType[(size_t) capacity])
+    {
+    }
+
+    //==============================================================================
+    /** Returns the number of items the queue can hold. */
+    int getCapacity() const noexcept        { return capacity; }
+
+    /** Returns the number of items that are waiting to be popped. */
+    int getNumReady() const noexcept        { return (int) (writer.index.load (std::memory_order_acquire) - reader.index.load (std::memory_order_acquire)); }
+
+    /** Returns true if there are no items waiting. */
+    bool isEmpty() const noexcept           { return getNumReady() == 0; }
+
+    //==============================================================================
+    /** Adds an item to the queue, returning false if the queue is full. */
+    bool push (const ItemType& item)
+    {
+        return pushInternal ([&item] (ItemType& dest) { dest = item; });
+    }
+
+    /** Moves an item into the queue, returning false if the queue is full. */
+    bool push (ItemType&& item)
+    {
+        return pushInternal ([&item] (ItemType& dest) { dest = std::move (item); });
+    }
+
+    /** Adds as many of the given items as there's space for, returning the number added. */
+    int pushBatch (const ItemType* source, int numItems)
+    {
+        auto write = writer.index.load (std::memory_order_relaxed);
+        auto numToWrite = jmin (numItems, capacity - (int) (write - getReadIndexForWriter (numItems)));
+
+        for (int i = 0; i < numToWrite; ++i)
+            items[(write + (uint32) i) & (uint32) (capacity - 1)] = source[i];
+
+        writer.index.store (write + (uint32) jmax (0, numToWrite), std::memory_order_release);
+        return jmax (0, numToWrite);
+    }
+
+    /** Removes the oldest item, returning false if the queue is empty. */
+    bool pop (ItemType& result)
+    {
+        return popBatch (&result, 1) == 1;
+    }
+
+    /** Removes up to the given number of items, returning the number that were removed. */
+    int popBatch (ItemType* dest, int maxNumItems)
+    {
+        auto read = reader.index.load (std::memory_order_relaxed);
+        auto numToRead = jmin (maxNumItems, (int) (getWriteIndexForReader (maxNumItems) - read));
+
+        for (int i = 0; i < numToRead; ++i)
+            dest[i] = std::move (items[(read + (uint32) i) & (uint32) (capacity - 1)]);
+
+        reader.index.store (read + (uint32) jmax (0, numToRead), std::memory_order_release);
+        return jmax (0, numToRead);
+    }
+
+    //==============================================================================
+    /** Adds an item, waiting for space if the queue is full.
+        @returns false if the timeout expired first. A negative timeout waits forever.
+    */
+    bool pushWithTimeout (const ItemType& item, int timeOutMilliseconds)
+    {
+        return LockFreeQueueHelpers::retryUntilTimeout ([&] { return push (item); }, timeOutMilliseconds);
+    }
+
+    /** Removes the oldest item, waiting for one to arrive if the queue is empty.
+        @returns false if the timeout expired first. A negative timeout waits forever.
+    */
+    bool popWithTimeout (ItemType& result, int timeOutMilliseconds)
+    {
+        return LockFreeQueueHelpers::retryUntilTimeout ([&] { return pop (result); }, timeOutMilliseconds);
+    }
+
+private:
+    //==============================================================================
+    const int capacity;
+    std::unique_ptr<ItemType[]> items;
+
+    // Each side keeps a copy of the other side's index, and only reloads the shared one
+    // when the copy says there isn't enough room, which avoids bouncing the cache line
+    struct Side
+    {
+        std::atomic<uint32> index { 0 };
+        uint32 cachedOtherIndex = 0;
+        char padding[LockFreeQueueHelpers::cacheLineSize];
+    };
+
+    Side writer, reader;
+
+    uint32 getReadIndexForWriter (int numNeeded) noexcept
+    {
+        if ((int) (writer.index.load (std::memory_order_relaxed) - writer.cachedOtherIndex) > capacity - numNeeded)
+            writer.cachedOtherIndex = reader.index.load (std::memory_order_acquire);
+
+        return writer.cachedOtherIndex;
+    }
+
+    uint32 getWriteIndexForReader (int numNeeded) noexcept
+    {
+        if ((int) (reader.cachedOtherIndex - reader.index.load (std::memory_order_relaxed)) < numNeeded)
+            reader.cachedOtherIndex = writer.index.load (std::memory_order_acquire);
+
+        return reader.cachedOtherIndex;
+    }
+
+    template <typename AssignFn>
+    bool pushInternal (AssignFn&& assign)
+    {
+        auto write = writer.index.load (std::memory_order_relaxed);
+
+        if ((int) (write - getReadIndexForWriter (1)) >= capacity)
+            return false;
+
+        assign (items[write & (uint32) (capacity - 1)]);
+        writer.index.store (write + 1, std::memory_order_release);
+        return true;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LockFreeSPSCQueue)
+};
+
+//==============================================================================
+#ifndef DOXYGEN
+namespace LockFreeQueueHelpers
+{
+    /*  A bounded queue based on Dmitry Vyukov's MPMC design, where each slot has its own
+        sequence number, so that a writer or reader only has to claim an index with a
+        compare-and-swap, and never waits for another thread to finish with its slot.
+        When there's only one reader or writer, its side doesn't need the compare-and-swap.
+    */
+    template <typename ItemType, bool multipleProducers, bool multipleConsumers>
+    class SequencedQueue
+    {
+    public:
+        explicit SequencedQueue (int minimumCapacity)
+            : capacity (getCapacityForSize (minimumCapacity)),
+              slots (new Slot[(size_t) capacity])
+        {
+            for (int i = 0; i < capacity; ++i)
+                slots[i].sequence.store ((size_t) i, std::memory_order_relaxed);
+        }
+
+        int getCapacity() const noexcept        { return capacity; }
+
+        int getNumReady() const noexcept
+        {
+            auto numReady = (int) (writeIndex.value.load (std::memory_order_acquire) - readIndex.value.load (std::memory_order_acquire));
+            return jlimit (0, capacity, numReady);
+        }
+
+        bool isEmpty() const noexcept           { return getNumReady() == 0; }
+
+        bool push (const ItemType& item)        { return pushInternal ([&item] (ItemType& dest) { dest = item; }); }
+        bool push (ItemType&& item)             { return pushInternal ([&item] (ItemType& dest) { dest = std::move (item); }); }
+
+        bool pop (ItemType& result)
+        {
+            auto index = readIndex.value.load (std::memory_order_relaxed);
+            Slot* slot;
+
+            for (;;)
+            {
+                slot = &slots[index & (size_t) (capacity - 1)];
+                auto difference = (ssize_t) slot->sequence.load (std::memory_order_acquire) - (ssize_t) (index + 1);
+
+                if (difference == 0)
+                {
+                    if (! multipleConsumers)
+                    {
+                        readIndex.value.store (index + 1, std::memory_order_relaxed);
+                        break;
+                    }
+
+                    if (readIndex.value.compare_exchange_weak (index, index + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (difference < 0)
+                {
+                    return false; // empty
+                }
+                else
+                {
+                    index = readIndex.value.load (std::memory_order_relaxed);
+                }
+            }
+
+            result = std::move (slot->item);
+            slot->sequence.store (index + (size_t) capacity, std::memory_order_release);
+            return true;
+        }
+
+        bool pushWithTimeout (const ItemType& item, int timeOutMilliseconds)
+        {
+            return retryUntilTimeout ([&] { return push (item); }, timeOutMilliseconds);
+        }
+
+        bool popWithTimeout (ItemType& result, int timeOutMilliseconds)
+        {
+            return retryUntilTimeout ([&] { return pop (result); }, timeOutMilliseconds);
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<size_t> sequence;
+            ItemType item;
+        };
+
+        const int capacity;
+        std::unique_ptr<Slot[]> slots;
+        PaddedAtomic<size_t> writeIndex, readIndex;
+
+        template <typename AssignFn>
+        bool pushInternal (AssignFn&& assign)
+        {
+            auto index = writeIndex.value.load (std::memory_order_relaxed);
+            Slot* slot;
+
+            for (;;)
+            {
+                slot = &slots[index & (size_t) (capacity - 1)];
+                auto difference = (ssize_t) slot->sequence.load (std::memory_order_acquire) - (ssize_t) index;
+
+                if (difference == 0)
+                {
+                    if (! multipleProducers)
+                    {
+                        writeIndex.value.store (index + 1, std::memory_order_relaxed);
+                        break;
+                    }
+
+                    if (writeIndex.value.compare_exchange_weak (index, index + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (difference < 0)
+                {
+                    return false; // full
+                }
+                else
+                {
+                    index = writeIndex.value.load (std::memory_order_relaxed);
+                }
+            }
+
+            assign (slot->item);
+            slot->sequence.store (index + 1, std::memory_order_release);
+            return true;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (SequencedQueue)
+    };
+}
+#endif
+
+//==============================================================================
+/**
+    A bounded, lock-free queue of objects, for any number of writer threads and a single
+    reader thread.
+
+    This is useful for things like collecting results from worker threads, or merging
+    messages from several sources onto the audio thread. All its storage is allocated by the
+    constructor, so push() and pop() are safe to use on the audio thread (provided that
+    assigning a ItemType object doesn't allocate either).
+
+    The pushWithTimeout() and popWithTimeout() methods poll the queue until they succeed,
+    so they mustn't be used on the audio thread.
+
+    @see LockFreeSPSCQueue, LockFreeMPMCQueue
+
+    @tags{Core}
+*/
+template <typename ItemType>
+class LockFreeMPSCQueue  : public LockFreeQueueHelpers::SequencedQueue<ItemType, true, false>
+{
+public:
+    /** Creates a queue that can hold at least the given number of items.
+        The capacity is rounded up to a power of two.
+    */
+    explicit LockFreeMPSCQueue (int minimumCapacity)
+        : LockFreeQueueHelpers::SequencedQueue<ItemType, true, false> (minimumCapacity)
+    {
+    }
+};
+
+//==============================================================================
+/**
+    A bounded, lock-free queue of objects, for any number of writer and reader threads.
+
+    All its storage is allocated by the constructor, so push() and pop() are safe to use on
+    the audio thread (provided that assigning a ItemType object doesn't allocate either).
+    If there's only ever one reader, a LockFreeMPSCQueue is slightly cheaper.
+
+    The pushWithTimeout() and popWithTimeout() methods poll the queue until they succeed,
+    so they mustn't be used on the audio thread.
+
+    @see LockFreeSPSCQueue, LockFreeMPSCQueue
+
+    @tags{Core}
+*/
+template <typename ItemType>
+class LockFreeMPMCQueue  : public LockFreeQueueHelpers::SequencedQueue<ItemType, true, true>
+{
+public:
+    /** Creates a queue that can hold at least the given number of items.
+        The capacity is rounded up to a power of two.
+    */
+    explicit LockFreeMPMCQueue (int minimumCapacity)
+        : LockFreeQueueHelpers::SequencedQueue<ItemType, true, true> (minimumCapacity)
+    {
+    }
+};
+
+} // namespace juce
@@ -0,0 +1,167 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct LockFreeQueueTests  : public UnitTest
+{
+    LockFreeQueueTests() : UnitTest ("LockFreeQueue", "Containers") {}
+
+    void runTest() override
+    {
+        beginTest ("SPSC single items");
+        {
+            LockFreeSPSCQueue<String> queue (5);
+            expectEquals (queue.getCapacity(), 8);
+            expect (queue.isEmpty());
+
+            for (int i = 0; i < 8; ++i)
+                expect (queue.push (String (i)));
+
+            expect (! queue.push ("overflow"));
+            expectEquals (queue.getNumReady(), 8);
+
+            String s;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                expect (queue.pop (s));
+                expectEquals (s, String (i));
+            }
+
+            expect (! queue.pop (s));
+        }
+
+        beginTest ("SPSC batches");
+        {
+            LockFreeSPSCQueue<int> queue (16);
+            int source[20], dest[20];
+
+            for (int i = 0; i < 20; ++i)
+                source[i] = i;
+
+            expectEquals (queue.pushBatch (source, 10), 10);
+            expectEquals (queue.popBatch (dest, 4), 4);
+            expectEquals (queue.pushBatch (source + 10, 10), 10); // wraps around the end
+            expectEquals (queue.pushBatch (source, 5), 0);
+            expectEquals (queue.popBatch (dest + 4, 20), 16);
+
+            bool inOrder = true;
+
+            for (int i = 0; i < 20; ++i)
+                inOrder = inOrder && dest[i] == i;
+
+            expect (inOrder);
+        }
+
+        beginTest ("SPSC between threads");
+        {
+            LockFreeSPSCQueue<int> queue (64);
+            runProducersAndConsumers (queue, 1, 1);
+        }
+
+        beginTest ("MPSC between threads");
+        {
+            LockFreeMPSCQueue<int> queue (64);
+            runProducersAndConsumers (queue, 4, 1);
+        }
+
+        beginTest ("MPMC between threads");
+        {
+            LockFreeMPMCQueue<int> queue (64);
+            runProducersAndConsumers (queue, 4, 3);
+        }
+
+        beginTest ("Timeouts");
+        {
+            LockFreeMPMCQueue<int> queue (2);
+            int value = 0;
+
+            expect (! queue.popWithTimeout (value, 5));
+            expect (queue.pushWithTimeout (1, 5));
+            expect (queue.pushWithTimeout (2, 5));
+            expect (! queue.pushWithTimeout (3, 5));
+            expect (queue.popWithTimeout (value, 5));
+            expectEquals (value, 1);
+        }
+    }
+
+    template <typename QueueType>
+    void runProducersAndConsumers (QueueType& queue, int numProducers, int numConsumers)
+    {
+        enum { numItemsPerProducer = 20000 };
+
+        std::atomic<int64> total { 0 };
+        std::atomic<int> numReceived { 0 };
+        const int numExpected = numItemsPerProducer * numProducers;
+
+        OwnedArray<Thread> threads;
+
+        struct TestThread  : public Thread
+        {
+            TestThread (std::function<void()> f) : Thread ("queue test"), fn (f) {}
+            void run() override    { fn(); }
+            std::function<void()> fn;
+        };
+
+        for (int p = 0; p < numProducers; ++p)
+        {
+            threads.add (new TestThread ([&queue]
+            {
+                for (int i = 1; i <= numItemsPerProducer; ++i)
+                    while (! queue.pushWithTimeout (i, 1000)) {}
+            }));
+        }
+
+        for (int c = 0; c < numConsumers; ++c)
+        {
+            threads.add (new TestThread ([&]
+            {
+                int value = 0;
+
+                while (numReceived.load() < numExpected)
+                {
+                    if (queue.popWithTimeout (value, 1))
+                    {
+                        total += value;
+                        ++numReceived;
+                    }
+                }
+            }));
+        }
+
+        for (auto* t : threads)
+            t->startThread();
+
+        for (auto* t : threads)
+            t->waitForThreadToExit (-1);
+
+        expectEquals (numReceived.load(), numExpected);
+        expectEquals (total.load(), (int64) numProducers * numItemsPerProducer * (numItemsPerProducer + 1) / 2);
+        expect (queue.isEmpty());
+    }
+};
+
+static LockFreeQueueTests lockFreeQueueTests;
+
+} // namespace juce
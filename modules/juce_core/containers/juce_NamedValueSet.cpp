@@ -54,36 +54,93 @@ NamedValueSet::NamedValue& NamedValueSet::NamedValue::operator= (NamedValue&& ot
 bool NamedValueSet::NamedValue::operator== (const NamedValue& other) const noexcept   { return name == other.name && value == other.value; }
 bool NamedValueSet::NamedValue::operator!= (const NamedValue& other) const noexcept   { return ! operator== (other); }
 
+//==============================================================================
+/*  Maps the address of each pooled name to its position in the values array. Identifiers
+    are compared by pointer anyway, so that's all a lookup needs to hash.
+*/
+struct NamedValueSet::Index
+{
+    static const void* getKey (const Identifier& name) noexcept   { return name.getCharPointer().getAddress(); }
+
+    FlatHashMap<const void*, int> positions;
+};
+
+// Below this size, a linear search through the names is quicker than hashing them
+static constexpr int minNumValuesForIndex = 32;
+
+void NamedValueSet::rebuildIndex()
+{
+    if (values.size() < minNumValuesForIndex)
+    {
+        nameIndex.reset();
+        return;
+    }
+
+    if (nameIndex == nullptr)
+        nameIndex.reset (new Index());
+    else
+        nameIndex->positions.clear();
+
+    nameIndex->positions.reserve (values.size());
+
+    for (int i = 0; i < values.size(); ++i)
+        addToIndex (i);
+}
+
+void NamedValueSet::addToIndex (int position)
+{
+    auto key = Index::getKey (values.getReference (position).name);
+
+    // if a name appears more than once, lookups must keep finding the first one
+    if (! nameIndex->positions.contains (key))
+        nameIndex->positions.set (key, position);
+}
+
 //==============================================================================
 NamedValueSet::NamedValueSet() noexcept {}
 NamedValueSet::~NamedValueSet() noexcept {}
 
-NamedValueSet::NamedValueSet (const NamedValueSet& other)  : values (other.values) {}
+NamedValueSet::NamedValueSet (const NamedValueSet& other)
+    : values (other.values),
+      nameIndex (other.nameIndex != nullptr ? new Index (*other.nameIndex) : nullptr)
+{
+}
 
 NamedValueSet::NamedValueSet (NamedValueSet&& other) noexcept
-   : values (std::move (other.values)) {}
+   : values (std::move (other.values)),
+     nameIndex (std::move (other.nameIndex))
+{
+}
 
 NamedValueSet::NamedValueSet (std::initializer_list<NamedValue> list)
    : values (std::move (list))
 {
+    rebuildIndex();
 }
 
 NamedValueSet& NamedValueSet::operator= (const NamedValueSet& other)
 {
-    clear();
-    values = other.values;
+    if (this != &other)
+    {
+        clear();
+        values = other.values;
+        nameIndex.reset (other.nameIndex != nullptr ? new Index (*other.nameIndex) : nullptr);
+    }
+
     return *this;
 }
 
 NamedValueSet& NamedValueSet::operator= (NamedValueSet&& other) noexcept
 {
     other.values.swapWith (values);
+    std::swap (other.nameIndex, nameIndex);
     return *this;
 }
 
 void NamedValueSet::clear()
 {
     values.clear();
+    nameIndex.reset();
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const noexcept
@@ -149,6 +206,14 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        if (auto* position = nameIndex->positions.find (Index::getKey (name)))
+            return &(values.getReference (*position).value);
+
+        return {};
+    }
+
     for (auto& i : values)
         if (i.name == name)
             return &(i.value);
@@ -168,6 +233,12 @@ bool NamedValueSet::set (const Identifier& name, var&& newValue)
     }
 
     values.add ({ name, std::move (newValue) });
+
+    if (nameIndex != nullptr)
+        addToIndex (values.size() - 1);
+    else if (values.size() >= minNumValuesForIndex)
+        rebuildIndex();
+
     return true;
 }
 
@@ -183,6 +254,12 @@ bool NamedValueSet::set (const Identifier& name, const var& newValue)
     }
 
     values.add ({ name, newValue });
+
+    if (nameIndex != nullptr)
+        addToIndex (values.size() - 1);
+    else if (values.size() >= minNumValuesForIndex)
+        rebuildIndex();
+
     return true;
 }
 
@@ -193,6 +270,12 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        auto* position = nameIndex->positions.find (Index::getKey (name));
+        return position != nullptr ? *position : -1;
+    }
+
     auto numValues = values.size();
 
     for (int i = 0; i < numValues; ++i)
@@ -204,18 +287,42 @@ int NamedValueSet::indexOf (const Identifier& name) const noexcept
 
 bool NamedValueSet::remove (const Identifier& name)
 {
-    auto numValues = values.size();
+    auto position = indexOf (name);
 
-    for (int i = 0; i < numValues; ++i)
+    if (position < 0)
+        return false;
+
+    values.remove (position);
+
+    if (nameIndex != nullptr)
     {
-        if (values.getReference(i).name == name)
+        if (values.size() < minNumValuesForIndex / 2)
         {
-            values.remove (i);
-            return true;
+            nameIndex.reset();
+        }
+        else
+        {
+            // everything after the removed value has moved down a place
+            nameIndex->positions.remove (Index::getKey (name));
+
+            for (int i = position; i < values.size(); ++i)
+            {
+                auto key = Index::getKey (values.getReference (i).name);
+
+                if (auto* p = nameIndex->positions.find (key))
+                {
+                    if (*p == i + 1)
+                        *p = i;
+                }
+                else
+                {
+                    nameIndex->positions.set (key, i);
+                }
+            }
         }
     }
 
-    return false;
+    return true;
 }
 
 Identifier NamedValueSet::getName (const int index) const noexcept
@@ -247,6 +354,7 @@ var* NamedValueSet::getVarPointerAt (int index) const noexcept
 void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 {
     values.clearQuick();
+    nameIndex.reset();
 
     for (auto* att = xml.attributes.get(); att != nullptr; att = att->nextListItem)
     {
@@ -263,6 +371,8 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add ({ att->name, var (att->value) });
     }
+
+    rebuildIndex();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
@@ -286,4 +396,99 @@ void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class NamedValueSetTests  : public UnitTest
+{
+public:
+    NamedValueSetTests() : UnitTest ("NamedValueSet", "Containers") {}
+
+    void runTest() override
+    {
+        beginTest ("Small and large sets");
+        {
+            for (auto numValues : { 5, 100 })
+            {
+                NamedValueSet set;
+
+                for (int i = 0; i < numValues; ++i)
+                    expect (set.set ("v" + String (i), i));
+
+                expect (! set.set ("v0", 0));
+                expectEquals (set.size(), numValues);
+
+                for (int i = 0; i < numValues; ++i)
+                {
+                    expectEquals (set.indexOf ("v" + String (i)), i);
+                    expectEquals ((int) set["v" + String (i)], i);
+                }
+
+                expect (! set.contains ("missing"));
+                expectEquals (set.indexOf ("missing"), -1);
+            }
+        }
+
+        beginTest ("Removing keeps the order");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 100; ++i)
+                set.set ("v" + String (i), i);
+
+            for (int i = 0; i < 100; i += 3)
+                expect (set.remove ("v" + String (i)));
+
+            expect (! set.remove ("v0"));
+
+            int position = 0;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto valueName = "v" + String (i);
+
+                if (i % 3 == 0)
+                {
+                    expect (! set.contains (valueName));
+                }
+                else
+                {
+                    expectEquals (set.indexOf (valueName), position);
+                    expect (set.getName (position++) == Identifier (valueName));
+                }
+            }
+
+            while (set.size() > 0)
+                set.remove (set.getName (set.size() / 2));
+
+            set.set ("a", 1);
+            expectEquals (set.indexOf ("a"), 0);
+        }
+
+        beginTest ("Copying large sets");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 50; ++i)
+                set.set ("v" + String (i), i);
+
+            NamedValueSet copy (set), assigned;
+            assigned = set;
+            copy.set ("v10", "changed");
+
+            expect (copy != set);
+            expect (assigned == set);
+            expectEquals ((int) set["v10"], 10);
+            expectEquals (copy["v10"].toString(), String ("changed"));
+
+            NamedValueSet moved (std::move (copy));
+            expectEquals (moved.indexOf ("v49"), 49);
+        }
+    }
+};
+
+static NamedValueSetTests namedValueSetTests;
+
+#endif
+
 } // namespace juce
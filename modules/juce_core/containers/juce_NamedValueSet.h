@@ -29,6 +29,11 @@ namespace juce
     This can be used as a basic structure to hold a set of var object, which can
     be retrieved by using their identifier.
 
+    The values are kept in the order in which they were added. Small sets are simply
+    searched linearly, but once a set grows beyond a few dozen values it also keeps a
+    hash table of the names, so that lookups stay fast for large JSON objects and
+    ValueTree nodes.
+
     @tags{Core}
 */
 class JUCE_API  NamedValueSet
@@ -163,7 +168,13 @@ public:
 
 private:
     //==============================================================================
+    struct Index;
+
     Array<NamedValue> values;
+    std::unique_ptr<Index> nameIndex;
+
+    void rebuildIndex();
+    void addToIndex (int);
 };
 
 } // namespace juce
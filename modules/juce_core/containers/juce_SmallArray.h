@@ -0,0 +1,631 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An array with space for a fixed number of elements inside the object itself, which
+    only allocates memory on the heap if it grows larger than that.
+
+    Lots of arrays only ever hold a handful of items - a list of channel indexes, or the
+    listeners attached to a component - and an ordinary Array has to allocate a block
+    on the heap as soon as the first one is added. A SmallArray with numInlineElements
+    set to cover the typical size never allocates at all, and keeps its elements next to
+    the rest of the owning object's data.
+
+    The methods match those of Array, so a SmallArray can be used in its place, e.g. as
+    the array type of a ListenerList:
+    @code
+    ListenerList<MyListener, SmallArray<MyListener*, 4>> listeners;
+    @endcode
+
+    Unlike Array, moving a SmallArray that's using its inline storage has to move each
+    element, and the elements' addresses will change.
+
+    To make all the array's methods thread-safe, pass in "CriticalSection" as the templated
+    TypeOfCriticalSectionToUse parameter, instead of the default DummyCriticalSection.
+
+    @see Array
+
+    @tags{Core}
+*/
+template <typename ElementType,
+          int numInlineElements,
+          typename TypeOfCriticalSectionToUse = DummyCriticalSection>
+class SmallArray  : private TypeOfCriticalSectionToUse
+{
+private:
+    using ParameterType = typename TypeHelpers::ParameterType<ElementType>::type;
+
+    static_assert (numInlineElements > 0, "The inline storage must have space for at least one element");
+
+public:
+    //==============================================================================
+    /** Creates an empty array. */
+    SmallArray() noexcept = default;
+
+    /** Creates a copy of another array. */
+    SmallArray (const SmallArray& other)
+    {
+        const ScopedLockType lock (other.getLock());
+        addArray (other.begin(), other.size());
+    }
+
+    /** Move constructor. */
+    SmallArray (SmallArray&& other) noexcept
+    {
+        takeElementsFrom (other);
+    }
+
+    /** Initalises from a raw array of values. */
+    template <typename TypeToCreateFrom>
+    SmallArray (const TypeToCreateFrom* data, int numValues)
+    {
+        addArray (data, numValues);
+    }
+
+    /** Initalises from a list of items. */
+    template <typename TypeToCreateFrom>
+    SmallArray (const std::initializer_list<TypeToCreateFrom>& items)
+    {
+        addArray (items);
+    }
+
+    /** Destructor. */
+    ~SmallArray()
+    {
+        destroyElements();
+        freeHeapStorage();
+    }
+
+    /** Copies another array. */
+    SmallArray& operator= (const SmallArray& other)
+    {
+        if (this != &other)
+        {
+            const ScopedLockType lock1 (other.getLock());
+            const ScopedLockType lock2 (getLock());
+            clearQuick();
+            addArray (other.begin(), other.size());
+        }
+
+        return *this;
+    }
+
+    /** Moves another array into this one. */
+    SmallArray& operator= (SmallArray&& other) noexcept
+    {
+        if (this != &other)
+        {
+            const ScopedLockType lock (getLock());
+            destroyElements();
+            freeHeapStorage();
+            takeElementsFrom (other);
+        }
+
+        return *this;
+    }
+
+    //==============================================================================
+    /** Compares this array to another one.
+        Two arrays are considered equal if they both contain the same set of
+        elements, in the same order.
+    */
+    template <class OtherArrayType>
+    bool operator== (const OtherArrayType& other) const
+    {
+        const ScopedLockType lock (getLock());
+        const typename OtherArrayType::ScopedLockType lock2 (other.getLock());
+
+        if (numUsed != other.size())
+            return false;
+
+        auto* e = begin();
+
+        for (auto& o : other)
+            if (! (*e++ == o))
+                return false;
+
+        return true;
+    }
+
+    /** Compares this array to another one. */
+    template <class OtherArrayType>
+    bool operator!= (const OtherArrayType& other) const
+    {
+        return ! operator== (other);
+    }
+
+    //==============================================================================
+    /** Removes all elements from the array, and frees any heap storage that it was using.
+        @see clearQuick
+    */
+    void clear()
+    {
+        const ScopedLockType lock (getLock());
+        destroyElements();
+        freeHeapStorage();
+    }
+
+    /** Removes all elements from the array without freeing the array's allocated storage.
+        @see clear
+    */
+    void clearQuick()
+    {
+        const ScopedLockType lock (getLock());
+        destroyElements();
+    }
+
+    /** Fills the array with the provided value. */
+    void fill (const ParameterType& newValue) noexcept
+    {
+        const ScopedLockType lock (getLock());
+
+        for (auto& e : *this)
+            e = newValue;
+    }
+
+    //==============================================================================
+    /** Returns the current number of elements in the array. */
+    inline int size() const noexcept                        { return numUsed; }
+
+    /** Returns true if the array is empty, false otherwise. */
+    inline bool isEmpty() const noexcept                    { return numUsed == 0; }
+
+    /** Returns true if the elements are still being kept in the inline storage. */
+    inline bool isUsingInlineStorage() const noexcept       { return elements == getInlineElements(); }
+
+    /** Returns one of the elements in the array.
+        If the index passed in is beyond the range of valid elements, this
+        will return a default value.
+    */
+    ElementType operator[] (int index) const
+    {
+        const ScopedLockType lock (getLock());
+        return isPositiveAndBelow (index, numUsed) ? elements[index] : ElementType();
+    }
+
+    /** Returns one of the elements in the array, without checking the index passed in. */
+    inline ElementType getUnchecked (int index) const
+    {
+        const ScopedLockType lock (getLock());
+        jassert (isPositiveAndBelow (index, numUsed));
+        return elements[index];
+    }
+
+    /** Returns a direct reference to one of the elements in the array, without checking
+        the index passed in.
+    */
+    inline ElementType& getReference (int index) const noexcept
+    {
+        const ScopedLockType lock (getLock());
+        jassert (isPositiveAndBelow (index, numUsed));
+        return elements[index];
+    }
+
+    /** Returns the first element in the array, or a default value if the array is empty. */
+    inline ElementType getFirst() const noexcept
+    {
+        const ScopedLockType lock (getLock());
+        return numUsed > 0 ? elements[0] : ElementType();
+    }
+
+    /** Returns the last element in the array, or a default value if the array is empty. */
+    inline ElementType getLast() const noexcept
+    {
+        const ScopedLockType lock (getLock());
+        return numUsed > 0 ? elements[numUsed - 1] : ElementType();
+    }
+
+    /** Returns a pointer to the actual array data.
+        This pointer will only be valid until the next time a non-const method
+        is called on the array.
+    */
+    inline ElementType* getRawDataPointer() noexcept        { return elements; }
+
+    /** Returns a pointer to the first element in the array. */
+    inline ElementType* begin() const noexcept              { return elements; }
+
+    /** Returns a pointer to the element which follows the last element in the array. */
+    inline ElementType* end() const noexcept                { return elements + numUsed; }
+
+    /** Returns a pointer to the first element in the array. */
+    inline ElementType* data() const noexcept               { return elements; }
+
+    //==============================================================================
+    /** Finds the index of the first element which matches the value passed in.
+        @returns    the index of the first matching element, or -1 if it's not found
+    */
+    int indexOf (ParameterType elementToLookFor) const
+    {
+        const ScopedLockType lock (getLock());
+
+        for (int i = 0; i < numUsed; ++i)
+            if (elementToLookFor == elements[i])
+                return i;
+
+        return -1;
+    }
+
+    /** Returns true if the array contains at least one occurrence of an object. */
+    bool contains (ParameterType elementToLookFor) const
+    {
+        return indexOf (elementToLookFor) >= 0;
+    }
+
+    //==============================================================================
+    /** Appends a new element at the end of the array. */
+    void add (const ElementType& newElement)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (numUsed < numAllocated)
+        {
+            new (elements + numUsed) ElementType (newElement);
+        }
+        else
+        {
+            // (the new element might be one of ours, so copy it before reallocating)
+            ElementType copy (newElement);
+            ensureAllocatedSize (numUsed + 1);
+            new (elements + numUsed) ElementType (std::move (copy));
+        }
+
+        ++numUsed;
+    }
+
+    /** Appends a new element at the end of the array. */
+    void add (ElementType&& newElement)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (numUsed < numAllocated)
+        {
+            new (elements + numUsed) ElementType (std::move (newElement));
+        }
+        else
+        {
+            ElementType moved (std::move (newElement));
+            ensureAllocatedSize (numUsed + 1);
+            new (elements + numUsed) ElementType (std::move (moved));
+        }
+
+        ++numUsed;
+    }
+
+    /** Inserts a new element into the array at a given position.
+        If the index is less than 0 or greater than the size of the array, the
+        element will be added to the end of the array.
+    */
+    void insert (int indexToInsertAt, ParameterType newElement)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (! isPositiveAndBelow (indexToInsertAt, numUsed))
+        {
+            add (newElement);
+            return;
+        }
+
+        ElementType copy (newElement);
+        add (std::move (elements[numUsed - 1]));
+
+        for (int i = numUsed - 2; i > indexToInsertAt; --i)
+            elements[i] = std::move (elements[i - 1]);
+
+        elements[indexToInsertAt] = std::move (copy);
+    }
+
+    /** Appends a new element at the end of the array as long as the array doesn't
+        already contain it.
+        @returns true if the element was added
+    */
+    bool addIfNotAlreadyThere (ParameterType newElement)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (contains (newElement))
+            return false;
+
+        add (newElement);
+        return true;
+    }
+
+    /** Replaces an element with a new value.
+        If the index is less than zero, this method does nothing. If the index is beyond
+        the end of the array, the item is added to the end of the array.
+    */
+    void set (int indexToChange, ParameterType newValue)
+    {
+        if (indexToChange >= 0)
+        {
+            const ScopedLockType lock (getLock());
+
+            if (indexToChange < numUsed)
+                elements[indexToChange] = newValue;
+            else
+                add (newValue);
+        }
+        else
+        {
+            jassertfalse;
+        }
+    }
+
+    /** Adds elements from an array to the end of this array. */
+    template <typename Type>
+    void addArray (const Type* elementsToAdd, int numElementsToAdd)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (numElementsToAdd > 0)
+        {
+            ensureAllocatedSize (numUsed + numElementsToAdd);
+
+            while (--numElementsToAdd >= 0)
+                new (elements + numUsed++) ElementType (*elementsToAdd++);
+        }
+    }
+
+    /** Adds the elements of an initializer_list to the end of this array. */
+    template <typename TypeToCreateFrom>
+    void addArray (const std::initializer_list<TypeToCreateFrom>& items)
+    {
+        addArray (items.begin(), (int) items.size());
+    }
+
+    /** Adds elements from another array or container to the end of this array. */
+    template <class OtherArrayType>
+    void addArray (const OtherArrayType& arrayToAddFrom)
+    {
+        const typename OtherArrayType::ScopedLockType lock1 (arrayToAddFrom.getLock());
+        const ScopedLockType lock2 (getLock());
+
+        ensureAllocatedSize (numUsed + arrayToAddFrom.size());
+
+        for (auto& e : arrayToAddFrom)
+            add (e);
+    }
+
+    /** Adds or removes elements to make the array a given size.
+        New elements are default-constructed.
+    */
+    void resize (int targetNumItems)
+    {
+        jassert (targetNumItems >= 0);
+        const ScopedLockType lock (getLock());
+
+        if (targetNumItems > numUsed)
+        {
+            ensureAllocatedSize (targetNumItems);
+
+            while (numUsed < targetNumItems)
+                new (elements + numUsed++) ElementType();
+        }
+        else
+        {
+            removeLast (numUsed - targetNumItems);
+        }
+    }
+
+    //==============================================================================
+    /** Removes an element from the array.
+        If the index passed in is out-of-range, nothing will happen.
+    */
+    void remove (int indexToRemove)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (isPositiveAndBelow (indexToRemove, numUsed))
+            removeInternal (indexToRemove);
+    }
+
+    /** Removes an element from the array, returning it. */
+    ElementType removeAndReturn (int indexToRemove)
+    {
+        const ScopedLockType lock (getLock());
+
+        if (isPositiveAndBelow (indexToRemove, numUsed))
+        {
+            ElementType removed (std::move (elements[indexToRemove]));
+            removeInternal (indexToRemove);
+            return removed;
+        }
+
+        return ElementType();
+    }
+
+    /** Removes the first occurrence of the given element from the array. */
+    void removeFirstMatchingValue (ParameterType valueToRemove)
+    {
+        const ScopedLockType lock (getLock());
+
+        for (int i = 0; i < numUsed; ++i)
+        {
+            if (valueToRemove == elements[i])
+            {
+                removeInternal (i);
+                break;
+            }
+        }
+    }
+
+    /** Removes all occurrences of the given element from the array.
+        @returns the number of elements that were removed
+    */
+    int removeAllInstancesOf (ParameterType valueToRemove)
+    {
+        const ScopedLockType lock (getLock());
+        int numRemoved = 0;
+
+        for (int i = numUsed; --i >= 0;)
+        {
+            if (valueToRemove == elements[i])
+            {
+                removeInternal (i);
+                ++numRemoved;
+            }
+        }
+
+        return numRemoved;
+    }
+
+    /** Removes the last n elements from the array. */
+    void removeLast (int howManyToRemove = 1)
+    {
+        const ScopedLockType lock (getLock());
+
+        for (howManyToRemove = jmin (howManyToRemove, numUsed); --howManyToRemove >= 0;)
+            elements[--numUsed].~ElementType();
+    }
+
+    /** Swaps over two elements in the array.
+        If either of the indexes passed in is out-of-range, nothing will happen.
+    */
+    void swap (int index1, int index2) noexcept
+    {
+        const ScopedLockType lock (getLock());
+
+        if (isPositiveAndBelow (index1, numUsed)
+             && isPositiveAndBelow (index2, numUsed))
+            std::swap (elements[index1], elements[index2]);
+    }
+
+    //==============================================================================
+    /** Increases the array's storage to hold a minimum number of elements. */
+    void ensureStorageAllocated (int minNumElements)
+    {
+        const ScopedLockType lock (getLock());
+        ensureAllocatedSize (minNumElements);
+    }
+
+    /** Reduces the amount of storage being used by the array, moving the elements
+        back into the inline storage if they fit.
+    */
+    void minimiseStorageOverheads()
+    {
+        const ScopedLockType lock (getLock());
+
+        if (! isUsingInlineStorage() && numUsed < numAllocated)
+            reallocate (numUsed <= numInlineElements ? getInlineElements() : allocateElements (numUsed),
+                        jmax (numInlineElements, numUsed));
+    }
+
+    //==============================================================================
+    /** Returns the CriticalSection that locks this array. */
+    inline const TypeOfCriticalSectionToUse& getLock() const noexcept      { return *this; }
+
+    /** Returns the type of scoped lock to use for locking this array */
+    using ScopedLockType = typename TypeOfCriticalSectionToUse::ScopedLockType;
+
+private:
+    //==============================================================================
+    using ElementStorage = typename std::aligned_storage<sizeof (ElementType), alignof (ElementType)>::type;
+
+    ElementStorage inlineStorage[numInlineElements];
+    ElementType* elements = getInlineElements();
+    int numUsed = 0, numAllocated = numInlineElements;
+
+    ElementType* getInlineElements() const noexcept
+    {
+        return reinterpret_cast<ElementType*> (const_cast<ElementStorage*> (inlineStorage));
+    }
+
+    static ElementType* allocateElements (int num)
+    {
+        return reinterpret_cast<ElementType*> (new ElementStorage[(size_t) num]);
+    }
+
+    void ensureAllocatedSize (int minNumElements)
+    {
+        if (minNumElements > numAllocated)
+        {
+            auto newSize = (minNumElements + minNumElements / 2 + 8) & ~7;
+            reallocate (allocateElements (newSize), newSize);
+        }
+    }
+
+    void reallocate (ElementType* newElements, int newNumAllocated)
+    {
+        for (int i = 0; i < numUsed; ++i)
+        {
+            new (newElements + i) ElementType (std::move (elements[i]));
+            elements[i].~ElementType();
+        }
+
+        freeHeapStorage();
+        elements = newElements;
+        numAllocated = newNumAllocated;
+    }
+
+    void destroyElements() noexcept
+    {
+        for (int i = 0; i < numUsed; ++i)
+            elements[i].~ElementType();
+
+        numUsed = 0;
+    }
+
+    void freeHeapStorage() noexcept
+    {
+        if (! isUsingInlineStorage())
+        {
+            delete[] reinterpret_cast<ElementStorage*> (elements);
+            elements = getInlineElements();
+            numAllocated = numInlineElements;
+        }
+    }
+
+    void takeElementsFrom (SmallArray& other) noexcept
+    {
+        if (other.isUsingInlineStorage())
+        {
+            for (int i = 0; i < other.numUsed; ++i)
+            {
+                new (elements + i) ElementType (std::move (other.elements[i]));
+                other.elements[i].~ElementType();
+            }
+        }
+        else
+        {
+            elements = other.elements;
+            numAllocated = other.numAllocated;
+            other.elements = other.getInlineElements();
+            other.numAllocated = numInlineElements;
+        }
+
+        numUsed = other.numUsed;
+        other.numUsed = 0;
+    }
+
+    void removeInternal (int indexToRemove)
+    {
+        for (int i = indexToRemove + 1; i < numUsed; ++i)
+            elements[i - 1] = std::move (elements[i]);
+
+        elements[--numUsed].~ElementType();
+    }
+};
+
+} // namespace juce
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SmallArrayTests  : public UnitTest
+{
+public:
+    SmallArrayTests() : UnitTest ("SmallArray", "Containers") {}
+
+    void runTest() override
+    {
+        beginTest ("Stays inline until it outgrows its storage");
+        {
+            SmallArray<int, 4> a;
+            expect (a.isEmpty() && a.isUsingInlineStorage());
+
+            for (int i = 0; i < 4; ++i)
+                a.add (i);
+
+            expect (a.isUsingInlineStorage());
+            expectEquals (a.size(), 4);
+
+            a.add (4);
+            expect (! a.isUsingInlineStorage());
+            expect (a == Array<int> ({ 0, 1, 2, 3, 4 }));
+
+            a.removeLast (2);
+            a.minimiseStorageOverheads();
+            expect (a.isUsingInlineStorage());
+            expect (a == Array<int> ({ 0, 1, 2 }));
+
+            a.clear();
+            expect (a.isEmpty() && a.isUsingInlineStorage());
+        }
+
+        beginTest ("Matches Array");
+        {
+            Random r (getRandom().nextInt64());
+            SmallArray<String, 3> small;
+            Array<String> groundTruth;
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto value = String (r.nextInt (50));
+                auto index = r.nextInt (jmax (1, groundTruth.size()));
+
+                switch (r.nextInt (8))
+                {
+                    case 0:  small.add (value); groundTruth.add (value); break;
+                    case 1:  small.insert (index, value); groundTruth.insert (index, value); break;
+                    case 2:  small.remove (index); groundTruth.remove (index); break;
+                    case 3:  small.removeFirstMatchingValue (value); groundTruth.removeFirstMatchingValue (value); break;
+                    case 4:  expect (small.addIfNotAlreadyThere (value) == groundTruth.addIfNotAlreadyThere (value)); break;
+                    case 5:  small.set (index, value); groundTruth.set (index, value); break;
+                    case 6:  small.swap (index, 0); groundTruth.swap (index, 0); break;
+                    default: small.resize (r.nextInt (10)); groundTruth.resize (small.size()); break;
+                }
+
+                expect (small == groundTruth);
+                expectEquals (small.indexOf (value), groundTruth.indexOf (value));
+                expectEquals (small[index], groundTruth[index]);
+            }
+        }
+
+        beginTest ("Copying and moving");
+        {
+            SmallArray<String, 2> inlineArray ({ "a", "b" });
+            SmallArray<String, 2> heapArray ({ "a", "b", "c" });
+
+            auto inlineCopy = inlineArray;
+            auto heapCopy = heapArray;
+            expect (inlineCopy == inlineArray && heapCopy == heapArray);
+
+            auto* heapElements = heapArray.begin();
+            auto movedHeap = std::move (heapArray);
+            expect (movedHeap.begin() == heapElements);
+            expect (heapArray.isEmpty() && heapArray.isUsingInlineStorage());
+
+            auto movedInline = std::move (inlineArray);
+            expect (movedInline.isUsingInlineStorage());
+            expect (movedInline == Array<String> ({ "a", "b" }));
+            expect (inlineArray.isEmpty());
+
+            movedInline = movedHeap;
+            expect (movedInline == Array<String> ({ "a", "b", "c" }));
+
+            movedHeap = std::move (inlineCopy);
+            expect (movedHeap == Array<String> ({ "a", "b" }));
+            expect (movedHeap.isUsingInlineStorage());
+        }
+
+        beginTest ("Adding an element of the array to itself");
+        {
+            SmallArray<String, 2> a ({ "x", "y" });
+            a.add (a.getReference (0));
+            a.insert (0, a.getReference (2));
+            expect (a == Array<String> ({ "x", "x", "y", "x" }));
+        }
+
+        beginTest ("Works as the array type of a ListenerList");
+        {
+            struct Listener
+            {
+                int numCalls = 0;
+                void callback() { ++numCalls; }
+            };
+
+            Listener l1, l2;
+            ListenerList<Listener, SmallArray<Listener*, 2>> listeners;
+            listeners.add (&l1);
+            listeners.add (&l2);
+            listeners.add (&l1);
+            expectEquals (listeners.size(), 2);
+
+            listeners.call ([] (Listener& l) { l.callback(); });
+            listeners.remove (&l1);
+            listeners.call ([] (Listener& l) { l.callback(); });
+
+            expectEquals (l1.numCalls, 1);
+            expectEquals (l2.numCalls, 2);
+        }
+    }
+};
+
+static SmallArrayTests smallArrayTests;
+
+} // namespace juce
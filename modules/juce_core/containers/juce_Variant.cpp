@@ -68,6 +68,9 @@ public:
 
     virtual void cleanUp (ValueUnion&) const noexcept {}
     virtual void createCopy (ValueUnion& dest, const ValueUnion& source) const      { dest = source; }
+
+    // Moves a value into uninitialised storage, leaving the source uninitialised
+    virtual void relocate (ValueUnion& dest, ValueUnion& source) const noexcept     { dest = source; }
     virtual bool equals (const ValueUnion& data, const ValueUnion& otherData, const VariantType& otherType) const noexcept = 0;
     virtual void writeToStream (const ValueUnion& data, OutputStream& output) const = 0;
 };
@@ -175,7 +178,7 @@ public:
     int toInt (const ValueUnion& data) const noexcept override       { return (int) data.doubleValue; }
     int64 toInt64 (const ValueUnion& data) const noexcept override   { return (int64) data.doubleValue; }
     double toDouble (const ValueUnion& data) const noexcept override { return data.doubleValue; }
-    String toString (const ValueUnion& data) const override          { return minimiseLengthOfFloatString (String (data.doubleValue, 15, true)); }
+    String toString (const ValueUnion& data) const override          { return serialiseDouble (data.doubleValue, 16); }
     bool toBool (const ValueUnion& data) const noexcept override     { return data.doubleValue != 0.0; }
     bool isDouble() const noexcept override                          { return true; }
     bool isComparable() const noexcept override                      { return true; }
@@ -230,6 +233,13 @@ public:
     void cleanUp (ValueUnion& data) const noexcept override                       { getString (data)-> ~String(); }
     void createCopy (ValueUnion& dest, const ValueUnion& source) const override   { new (dest.stringValue) String (*getString (source)); }
 
+    // Short strings are stored inside the String object itself, so can't just be copied bytewise
+    void relocate (ValueUnion& dest, ValueUnion& source) const noexcept override
+    {
+        new (dest.stringValue) String (std::move (*getString (source)));
+        getString (source)->~String();
+    }
+
     bool isString() const noexcept override                          { return true; }
     int toInt (const ValueUnion& data) const noexcept override       { return getString (data)->getIntValue(); }
     int64 toInt64 (const ValueUnion& data) const noexcept override   { return getString (data)->getLargeIntValue(); }
@@ -511,8 +521,11 @@ DynamicObject* var::getDynamicObject() const noexcept   { return dynamic_cast<Dy
 //==============================================================================
 void var::swapWith (var& other) noexcept
 {
+    ValueUnion temp;
+    type->relocate (temp, value);
+    other.type->relocate (value, other.value);
+    type->relocate (other.value, temp);
     std::swap (type, other.type);
-    std::swap (value, other.value);
 }
 
 var& var::operator= (const var& v)               { type->cleanUp (value); type = v.type; type->createCopy (value, v.value); return *this; }
@@ -529,9 +542,9 @@ var& var::operator= (ReferenceCountedObject* v)  { var v2 (v); swapWith (v2); re
 var& var::operator= (NativeFunction v)           { var v2 (v); swapWith (v2); return *this; }
 
 var::var (var&& other) noexcept
-    : type (other.type),
-      value (other.value)
+    : type (other.type)
 {
+    type->relocate (value, other.value);
     other.type = &VariantType_Void::instance;
 }
 
@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct DirectoryScanner::ScanState
+{
+    ScanState (const Callback& cb)  : callback (cb) {}
+
+    bool getNextDirectory (String& directory)
+    {
+        for (;;)
+        {
+            {
+                const ScopedLock sl (lock);
+
+                if (shouldStop)
+                    return false;
+
+                if (! pendingDirectories.isEmpty())
+                {
+                    // taking the most recently added one keeps the list short when the tree is deep
+                    auto last = pendingDirectories.size() - 1;
+                    directory = pendingDirectories[last];
+                    pendingDirectories.remove (last);
+                    ++numBusy;
+                    return true;
+                }
+
+                if (numBusy == 0)
+                    return false;
+            }
+
+            // another thread is still reading a directory, which may contain more work
+            workAvailable.wait (5);
+        }
+    }
+
+    void addDirectory (const String& directory)
+    {
+        {
+            const ScopedLock sl (lock);
+            pendingDirectories.add (directory);
+        }
+
+        workAvailable.signal();
+    }
+
+    void finishedDirectory()
+    {
+        {
+            const ScopedLock sl (lock);
+            --numBusy;
+        }
+
+        workAvailable.signal();
+    }
+
+    const Callback& callback;
+    CriticalSection lock;
+    StringArray pendingDirectories;
+    int numBusy = 0;
+    WaitableEvent workAvailable;
+    std::atomic<bool> shouldStop { false };
+    std::atomic<int> numFound { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (ScanState)
+};
+
+//==============================================================================
+DirectoryScanner::DirectoryScanner (const File& directory, bool recursive,
+                                    const String& wildCard, int typesToFind)
+    : rootDirectory (directory),
+      whatToLookFor (typesToFind),
+      isRecursive (recursive)
+{
+    // you have to specify the type of files you're looking for!
+    jassert ((typesToFind & (File::findFiles | File::findDirectories)) != 0);
+    jassert (typesToFind > 0 && typesToFind <= 7);
+
+    wildCards.addTokens (wildCard, ";,", "\"'");
+    wildCards.trim();
+    wildCards.removeEmptyStrings();
+}
+
+DirectoryScanner::~DirectoryScanner() {}
+
+File DirectoryScanner::Entry::getFile() const
+{
+    return File::createFileWithoutCheckingPath (directory + filename);
+}
+
+int DirectoryScanner::scan (const Callback& callback)
+{
+    ScanState state (callback);
+    state.addDirectory (File::addTrailingSeparator (rootDirectory.getFullPathName()));
+    scanDirectories (state);
+    return state.numFound;
+}
+
+int DirectoryScanner::scan (ThreadPool& pool, const Callback& callback)
+{
+    if (! isRecursive)
+        return scan (callback);
+
+    ScanState state (callback);
+    state.addDirectory (File::addTrailingSeparator (rootDirectory.getFullPathName()));
+
+    struct ScanJob  : public ThreadPoolJob
+    {
+        ScanJob (std::function<void()> f)  : ThreadPoolJob ("DirectoryScanner"), work (f) {}
+        JobStatus runJob() override    { work(); return jobHasFinished; }
+
+        std::function<void()> work;
+    };
+
+    OwnedArray<ScanJob> jobs;
+
+    for (int i = pool.getNumThreads(); --i >= 0;)
+    {
+        jobs.add (new ScanJob ([this, &state] { scanDirectories (state); }));
+        pool.addJob (jobs.getLast(), false);
+    }
+
+    scanDirectories (state);
+
+    // any jobs that haven't started yet have nothing left to do, so can just be removed
+    for (auto* job : jobs)
+        pool.removeJob (job, false, -1);
+
+    return state.numFound;
+}
+
+void DirectoryScanner::scanDirectories (ScanState& state) const
+{
+    String directory;
+
+    while (state.getNextDirectory (directory))
+    {
+        readEntries (directory, fetchFileInfo, [&] (Entry& e, bool isLink)
+        {
+            if (state.shouldStop)
+                return false;
+
+            if (e.isDirectory && isRecursive && ! isLink
+                 && ((whatToLookFor & File::ignoreHiddenFiles) == 0 || ! e.isHidden))
+                state.addDirectory (directory + e.filename + File::getSeparatorChar());
+
+            if (wantsEntry (e))
+            {
+                ++state.numFound;
+
+                if (! state.callback (e))
+                {
+                    state.shouldStop = true;
+                    return false;
+                }
+            }
+
+            return true;
+        });
+
+        state.finishedDirectory();
+    }
+}
+
+bool DirectoryScanner::wantsEntry (const Entry& e) const
+{
+    if ((whatToLookFor & (e.isDirectory ? File::findDirectories : File::findFiles)) == 0)
+        return false;
+
+    if (e.isHidden && (whatToLookFor & File::ignoreHiddenFiles) != 0)
+        return false;
+
+    for (auto& w : wildCards)
+        if (e.filename.matchesWildcard (w, ! File::areFileNamesCaseSensitive()))
+            return true;
+
+    return false;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct DirectoryScannerTests  : public UnitTest
+{
+    DirectoryScannerTests()  : UnitTest ("DirectoryScanner", "Files") {}
+
+    void runTest() override
+    {
+        auto root = File::createTempFile ("scanner");
+        root.createDirectory();
+
+        createTree (root, 3);
+        root.getChildFile (".hidden.txt").replaceWithText ("x");
+
+        ThreadPool pool (3);
+
+        beginTest ("Matches DirectoryIterator");
+        {
+            for (auto recursive : { false, true })
+            {
+                for (auto types : { (int) File::findFiles, (int) File::findDirectories,
+                                    (int) File::findFilesAndDirectories,
+                                    File::findFiles | File::ignoreHiddenFiles })
+                {
+                    auto expected = root.findChildFiles (types, recursive, "*.txt;*.folder");
+                    expected.sort();
+
+                    DirectoryScanner scanner (root, recursive, "*.txt;*.folder", types);
+                    expect (getResults (scanner, nullptr) == expected);
+                    expect (getResults (scanner, &pool) == expected);
+                }
+            }
+        }
+
+        beginTest ("File info");
+        {
+            DirectoryScanner scanner (root, true, "*.txt");
+            scanner.setFetchFileInfo (true);
+
+            CriticalSection lock;
+            bool allCorrect = true;
+
+            auto numFound = scanner.scan (pool, [&] (const DirectoryScanner::Entry& e)
+            {
+                auto f = e.getFile();
+                const ScopedLock sl (lock);
+                allCorrect = allCorrect && ! e.isDirectory && e.fileSize == f.getSize()
+                                && e.modificationTime == f.getLastModificationTime();
+                return true;
+            });
+
+            expectEquals (numFound, root.findChildFiles (File::findFiles, true, "*.txt").size());
+            expect (allCorrect);
+        }
+
+        beginTest ("Stopping early");
+        {
+            DirectoryScanner scanner (root, true, "*", File::findFilesAndDirectories);
+            std::atomic<int> numCalls { 0 };
+
+            scanner.scan (pool, [&] (const DirectoryScanner::Entry&) { return ++numCalls < 5; });
+            expectEquals (numCalls.load(), 5);
+        }
+
+        root.deleteRecursively();
+    }
+
+    static void createTree (const File& dir, int depth)
+    {
+        dir.getChildFile ("a.txt").replaceWithText ("hello");
+        dir.getChildFile ("b.dat").replaceWithText ("hello world");
+
+        if (--depth > 0)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                auto sub = dir.getChildFile ("sub" + String (i) + (i == 0 ? ".folder" : ""));
+                sub.createDirectory();
+                sub.getChildFile ("c.txt").replaceWithText (String::repeatedString ("x", i * 10));
+                createTree (sub, depth);
+            }
+        }
+    }
+
+    static Array<File> getResults (DirectoryScanner& scanner, ThreadPool* pool)
+    {
+        CriticalSection lock;
+        Array<File> results;
+
+        auto callback = [&] (const DirectoryScanner::Entry& e)
+        {
+            const ScopedLock sl (lock);
+            results.add (e.getFile());
+            return true;
+        };
+
+        auto numFound = pool != nullptr ? scanner.scan (*pool, callback)
+                                        : scanner.scan (callback);
+        jassert (numFound == results.size());
+        ignoreUnused (numFound);
+
+        results.sort();
+        return results;
+    }
+};
+
+static DirectoryScannerTests directoryScannerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ThreadPool;
+
+//==============================================================================
+/**
+    Scans a directory tree as quickly as possible, optionally using several threads.
+
+    Unlike DirectoryIterator, this doesn't create a File object or stat each item
+    unless you ask it to. It hands each entry it finds to a callback, rather than
+    building up a list, so it can cope with trees containing millions of files.
+
+    When a ThreadPool is supplied, subdirectories are shared out between the pool's
+    threads and the calling thread, so the callback can be called from several
+    threads at once. As with DirectoryIterator, the order of the results is undefined.
+
+    Symbolic links to directories are reported, but never descended into, so a
+    scan can't get stuck in a loop.
+
+    e.g. @code
+    DirectoryScanner scanner (File ("/samples"), true, "*.wav");
+    std::atomic<int64> totalSize { 0 };
+
+    scanner.setFetchFileInfo (true);
+    scanner.scan (pool, [&] (const DirectoryScanner::Entry& e)
+    {
+        totalSize += e.fileSize;
+        return true;
+    });
+    @endcode
+
+    @see DirectoryIterator, File::findChildFiles
+
+    @tags{Core}
+*/
+class JUCE_API  DirectoryScanner  final
+{
+public:
+    //==============================================================================
+    /** Creates a scanner for a directory.
+
+        @param directory        the directory to search in
+        @param isRecursive      whether all the subdirectories should also be searched
+        @param wildCard         the file pattern to match. This may contain multiple patterns
+                                separated by a semi-colon or comma, e.g. "*.jpg;*.png"
+        @param whatToLookFor    a value from the File::TypesOfFileToFind enum, specifying
+                                whether to look for files, directories, or both.
+    */
+    DirectoryScanner (const File& directory,
+                      bool isRecursive,
+                      const String& wildCard = "*",
+                      int whatToLookFor = File::findFiles);
+
+    /** Destructor. */
+    ~DirectoryScanner();
+
+    //==============================================================================
+    /** Describes one of the items that was found. */
+    struct Entry
+    {
+        /** Returns the File that this entry refers to. */
+        File getFile() const;
+
+        String directory;           /**< The directory containing the item, with a trailing separator. */
+        String filename;            /**< The name of the item, without its directory. */
+        bool isDirectory = false;   /**< True if the item is a directory. */
+        bool isHidden = false;      /**< True if the item is hidden. */
+
+        /** These are only filled-in when setFetchFileInfo() has been enabled. */
+        int64 fileSize = 0;
+        Time modificationTime, creationTime;
+        bool isReadOnly = false;
+    };
+
+    /** A callback that is given each matching item. Return false to stop the scan. */
+    using Callback = std::function<bool (const Entry&)>;
+
+    //==============================================================================
+    /** Chooses whether the size, times and read-only flag of each item are found.
+
+        This is off by default, because on most systems it means making an extra
+        call for each item, which can be much slower than just reading the names.
+    */
+    void setFetchFileInfo (bool shouldFetchInfo) noexcept       { fetchFileInfo = shouldFetchInfo; }
+
+    /** Scans the directory on the calling thread.
+        @returns the number of matching items that were passed to the callback
+    */
+    int scan (const Callback& callback);
+
+    /** Scans the directory using the threads from a pool, as well as the calling thread.
+
+        This blocks until the scan has finished. The callback may be called from
+        several threads at once, so it must be thread-safe.
+
+        @returns the number of matching items that were passed to the callback
+    */
+    int scan (ThreadPool& pool, const Callback& callback);
+
+private:
+    //==============================================================================
+    struct ScanState;
+
+    File rootDirectory;
+    StringArray wildCards;
+    const int whatToLookFor;
+    const bool isRecursive;
+    bool fetchFileInfo = false;
+
+    void scanDirectories (ScanState&) const;
+    bool wantsEntry (const Entry&) const;
+
+    // Implemented natively: reads the entries in a directory, calling the function
+    // for each one (with a flag to say whether it's a symbolic link), and stopping
+    // if it returns false.
+    static void readEntries (const String& directoryWithSeparator, bool fetchInfo,
+                             const std::function<bool (Entry&, bool)>&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DirectoryScanner)
+};
+
+} // namespace juce
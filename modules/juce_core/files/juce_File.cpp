@@ -1003,6 +1003,84 @@ MemoryMappedFile::MemoryMappedFile (const File& file, const Range<int64>& fileRa
     openInternal (file, mode, exclusive);
 }
 
+struct MemoryMappedFile::TouchJob  : public ThreadPoolJob
+{
+    TouchJob (const MemoryMappedFile& f, Range<int64> r)  : ThreadPoolJob ("MemoryMappedFile::touchRange"), file (f), range (r) {}
+
+    JobStatus runJob() override
+    {
+        // do it in chunks, so that a deleted file doesn't have to wait for the whole range
+        const int64 chunkSize = 1024 * 1024;
+
+        for (auto start = range.getStart(); start < range.getEnd() && ! shouldExit(); start += chunkSize)
+            file.touchRange ({ start, jmin (start + chunkSize, range.getEnd()) });
+
+        return jobHasFinished;
+    }
+
+    const MemoryMappedFile& file;
+    const Range<int64> range;
+};
+
+bool MemoryMappedFile::getPageAlignedRegion (Range<int64> fileRange, int64 pageSize, void*& start, size_t& numBytes) const noexcept
+{
+    fileRange = fileRange.getIntersectionWith (range);
+
+    if (address == nullptr || fileRange.isEmpty())
+        return false;
+
+    auto offset = fileRange.getStart() - range.getStart();
+    auto alignedOffset = offset - ((pointer_sized_int) address + offset) % pageSize;
+
+    start = static_cast<char*> (address) + alignedOffset;
+    numBytes = (size_t) (fileRange.getEnd() - range.getStart() - alignedOffset);
+    return true;
+}
+
+void MemoryMappedFile::touchRange (Range<int64> fileRange) const
+{
+    fileRange = fileRange.getIntersectionWith (range);
+
+    if (address == nullptr || fileRange.isEmpty())
+        return;
+
+    auto* data = static_cast<const volatile char*> (address) - range.getStart();
+    char total = 0;
+
+    // 4K is the smallest page size on any of the supported platforms
+    for (auto pos = fileRange.getStart(); pos < fileRange.getEnd(); pos += 4096)
+        total = (char) (total + data[pos]);
+
+    total = (char) (total + data[fileRange.getEnd() - 1]);
+    ignoreUnused (total);
+}
+
+void MemoryMappedFile::touchRangeAsync (Range<int64> fileRange, ThreadPool& threadPool)
+{
+    // All the calls on a MemoryMappedFile must use the same pool!
+    jassert (touchJobPool == nullptr || touchJobPool == &threadPool);
+    touchJobPool = &threadPool;
+
+    for (int i = touchJobs.size(); --i >= 0;)
+        if (! threadPool.contains (touchJobs.getUnchecked (i)))
+            touchJobs.remove (i);
+
+    if (address != nullptr && ! fileRange.getIntersectionWith (range).isEmpty())
+    {
+        auto* job = touchJobs.add (new TouchJob (*this, fileRange.getIntersectionWith (range)));
+        threadPool.addJob (job, false);
+    }
+}
+
+void MemoryMappedFile::cancelTouchJobs()
+{
+    if (touchJobPool != nullptr)
+        for (auto* job : touchJobs)
+            touchJobPool->removeJob (job, true, -1);
+
+    touchJobs.clear();
+}
+
 
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -1154,6 +1232,41 @@ public:
             expect (memcmp (mmf.getData(), "0123456789", 10) == 0);
         }
 
+        {
+            const File tempFile2 (tempFile.getNonexistentSibling (false));
+            MemoryBlock block (300000);
+
+            for (size_t i = 0; i < block.getSize(); ++i)
+                block[(int) i] = (char) i;
+
+            expect (tempFile2.replaceWithData (block.getData(), block.getSize()));
+
+            {
+                ThreadPool pool (1);
+                MemoryMappedFile mmf (tempFile2, { 5000, 300000 }, MemoryMappedFile::readOnly);
+                expect (mmf.getData() != nullptr);
+                expect (memcmp (mmf.getData(), static_cast<const char*> (block.getData()) + mmf.getRange().getStart(), mmf.getSize()) == 0);
+
+               #if ! JUCE_WINDOWS
+                expect (mmf.setAccessPattern (MemoryMappedFile::randomAccess));
+                expect (mmf.prefetch ({ 0, 100000 }));
+               #endif
+
+                expect (! mmf.prefetch ({ 400000, 500000 }));
+
+                mmf.touchRange ({ 10000, 200000 });
+                mmf.touchRangeAsync ({ 0, 300000 }, pool);
+                mmf.touchRangeAsync ({ 100, 200 }, pool);
+
+                if (mmf.lockRange ({ 6000, 7000 }))
+                    expect (mmf.unlockRange ({ 6000, 7000 }));
+
+                mmf.requestHugePages();
+            }
+
+            expect (tempFile2.deleteFile());
+        }
+
         {
             const File tempFile2 (tempFile.getNonexistentSibling (false));
             expect (tempFile2.create());
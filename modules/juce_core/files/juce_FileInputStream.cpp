@@ -76,6 +76,45 @@ bool FileInputStream::setPosition (int64 pos)
     return currentPosition == pos;
 }
 
+bool FileInputStream::readRanges (ReadRange* ranges, int numRanges)
+{
+    // You should always check that a stream opened successfully before using it!
+    jassert (openedOk());
+
+    // reading in file order gives the OS's read-ahead the best chance of helping
+    Array<ReadRange*> sortedRanges;
+    sortedRanges.ensureStorageAllocated (numRanges);
+
+    for (int i = 0; i < numRanges; ++i)
+        sortedRanges.add (ranges + i);
+
+    std::sort (sortedRanges.begin(), sortedRanges.end(),
+               [] (const ReadRange* a, const ReadRange* b) { return a->filePosition < b->filePosition; });
+
+    bool allRead = true;
+
+    for (auto* r : sortedRanges)
+    {
+        jassert (r->destBuffer != nullptr && r->numBytes >= 0);
+        r->numBytesRead = 0;
+
+        while (r->numBytesRead < r->numBytes)
+        {
+            auto num = readInternalAt (static_cast<char*> (r->destBuffer) + r->numBytesRead,
+                                       (size_t) (r->numBytes - r->numBytesRead),
+                                       r->filePosition + r->numBytesRead);
+            if (num == 0)
+                break;
+
+            r->numBytesRead += (int) num;
+        }
+
+        allRead = allRead && r->numBytesRead == r->numBytes;
+    }
+
+    return allRead;
+}
+
 //==============================================================================
 #if JUCE_UNIT_TESTS
 
@@ -143,6 +182,28 @@ struct FileInputStreamTests   : public UnitTest
         expectEquals (stream.getNumBytesRemaining(), (int64) 0);
         expect (stream.isExhausted());
 
+        beginTest ("Read ranges");
+
+        stream.setPosition (4);
+        char a[3], b[5], c[4];
+        FileInputStream::ReadRange ranges[] = { { 20, a, 3, 0 }, { 1, b, 5, 0 }, { 24, c, 4, 0 } };
+
+        expect (! stream.readRanges (ranges, 3));
+        expect (memcmp (a, "uvw", 3) == 0 && ranges[0].numBytesRead == 3);
+        expect (memcmp (b, "bcdef", 5) == 0 && ranges[1].numBytesRead == 5);
+        expect (memcmp (c, "yz", 2) == 0 && ranges[2].numBytesRead == 2);
+        expectEquals (stream.getPosition(), (int64) 4);
+        expectEquals ((int) stream.readByte(), (int) 'e');
+
+        beginTest ("Access hints");
+
+        // these are only hints, so just make sure they don't disturb reading
+        stream.setAccessPattern (FileInputStream::randomAccess);
+        stream.prefetch ({ 0, 26 });
+        stream.setAccessPattern (FileInputStream::sequentialAccess);
+        stream.setPosition (10);
+        expectEquals ((int) stream.readByte(), (int) 'k');
+
         f.deleteFile();
     }
 };
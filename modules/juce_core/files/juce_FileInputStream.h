@@ -66,6 +66,48 @@ public:
     */
     bool openedOk() const noexcept                      { return status.wasOk(); }
 
+    //==============================================================================
+    /** Hints about the way that the file is going to be read.
+        @see setAccessPattern
+    */
+    enum AccessPattern
+    {
+        normalAccess,       /**< No particular pattern - the OS will use its default read-ahead. */
+        sequentialAccess,   /**< The file will be read in order, so the OS can read further ahead. */
+        randomAccess        /**< The file will be read in no particular order, so read-ahead won't help. */
+    };
+
+    /** Tells the OS how the file is going to be read, so that it can adjust its caching.
+        This is only a hint, and returns false if the platform doesn't support it (on Windows,
+        files are always opened for sequential reading).
+    */
+    bool setAccessPattern (AccessPattern pattern);
+
+    /** Asks the OS to start reading a section of the file into its cache in the background.
+        This returns immediately, and returns false if the platform doesn't support it.
+    */
+    bool prefetch (Range<int64> fileRange);
+
+    //==============================================================================
+    /** Describes one of the sections of the file to read with readRanges(). */
+    struct ReadRange
+    {
+        int64 filePosition;     /**< The position in the file at which to start reading. */
+        void* destBuffer;       /**< Where to put the data - this must have room for numBytes. */
+        int numBytes;           /**< The number of bytes to read. */
+        int numBytesRead;       /**< This is set by readRanges() to the number of bytes that were read. */
+    };
+
+    /** Reads a set of sections of the file in one go.
+
+        The sections can be in any order, and are read in file order using positional
+        reads, so this doesn't change the stream's position. This is much quicker than
+        seeking and reading each one in turn when there are many small sections.
+
+        Returns true if all the sections were read completely - if not, check each
+        range's numBytesRead to see which ones were short.
+    */
+    bool readRanges (ReadRange* ranges, int numRanges);
 
     //==============================================================================
     int64 getTotalLength() override;
@@ -83,6 +125,7 @@ private:
 
     void openHandle();
     size_t readInternal (void*, size_t);
+    size_t readInternalAt (void*, size_t, int64 filePosition);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FileInputStream)
 };
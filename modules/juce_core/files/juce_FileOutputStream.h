@@ -96,6 +96,17 @@ public:
     */
     Result truncate();
 
+    /** Asks the file system to reserve space for the file to grow to the given size.
+
+        This doesn't change the file's length or write position, but allocating the space
+        up-front lets the file system keep a large file in one piece when it's written
+        gradually, e.g. while recording. Any space that's left unused will be released
+        when truncate() is called, or when the file is closed on some platforms.
+
+        This isn't supported on all platforms, in which case it will return a failed result.
+    */
+    Result preallocate (int64 totalSizeInBytes);
+
     //==============================================================================
     void flush() override;
     int64 getPosition() override;
@@ -23,6 +23,8 @@
 namespace juce
 {
 
+class ThreadPool;
+
 //==============================================================================
 /**
     Maps a file into virtual memory for easy reading and/or writing.
@@ -96,11 +98,73 @@ public:
     /** Returns the section of the file at which the mapped memory represents. */
     Range<int64> getRange() const noexcept      { return range; }
 
+    //==============================================================================
+    /** Hints about the way that the mapped memory is going to be read.
+        @see setAccessPattern
+    */
+    enum AccessPattern
+    {
+        normalAccess,       /**< No particular pattern - the OS will use its default read-ahead. */
+        sequentialAccess,   /**< The data will be read in order, so it can be read well ahead and
+                                 discarded soon after use. This is what's used when the file is opened. */
+        randomAccess        /**< The data will be read in no particular order, so read-ahead won't help. */
+    };
+
+    /** Tells the OS how the mapped memory is going to be accessed.
+        This is only a hint, and returns false if the platform doesn't support it.
+    */
+    bool setAccessPattern (AccessPattern pattern);
+
+    /** Asks the OS to start reading a section of the file into memory in the background,
+        so that it's less likely to cause page faults when it's read later.
+
+        The range is in the same file positions as getRange(), and is clipped to the mapped
+        section. This returns immediately, and returns false if the platform doesn't support it.
+    */
+    bool prefetch (Range<int64> fileRange);
+
+    /** Reads a byte from each page of a section of the mapped file, forcing it to be loaded.
+
+        This blocks until all the pages are in memory, so call it from a background thread
+        rather than a realtime one. The range is in the same file positions as getRange().
+    */
+    void touchRange (Range<int64> fileRange) const;
+
+    /** Calls touchRange() on one of a ThreadPool's threads.
+
+        The job is cancelled if the MemoryMappedFile is deleted before it's done. All the
+        calls made on a MemoryMappedFile must use the same pool, which must outlive it.
+    */
+    void touchRangeAsync (Range<int64> fileRange, ThreadPool& threadPool);
+
+    /** Locks a section of the mapped file into physical memory, so that once loaded it can't
+        be paged out. This may fail if the process isn't allowed to lock that much memory.
+        The range is in the same file positions as getRange().
+        @see unlockRange
+    */
+    bool lockRange (Range<int64> fileRange);
+
+    /** Unlocks a section that was locked with lockRange(). */
+    bool unlockRange (Range<int64> fileRange);
+
+    /** Asks the OS to back the mapping with huge pages, which can reduce TLB misses when
+        a large file is read at random.
+
+        This is only a hint, and is currently only implemented on Linux (where it needs
+        the kernel's transparent huge page support for files). It returns false when the
+        request can't be made.
+    */
+    bool requestHugePages();
+
 private:
     //==============================================================================
     void* address = nullptr;
     Range<int64> range;
 
+    struct TouchJob;
+    OwnedArray<TouchJob> touchJobs;
+    ThreadPool* touchJobPool = nullptr;
+
    #if JUCE_WINDOWS
     void* fileHandle = nullptr;
    #else
@@ -108,6 +172,8 @@ private:
    #endif
 
     void openInternal (const File&, AccessMode, bool);
+    bool getPageAlignedRegion (Range<int64> fileRange, int64 pageSize, void*& start, size_t& numBytes) const noexcept;
+    void cancelTouchJobs();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedFile)
 };
@@ -352,8 +352,7 @@ struct JSONFormatter
 
             if (juce_isfinite (d))
             {
-                String doubleString (d, maximumDecimalPlaces, true);
-                out << minimiseLengthOfFloatString (doubleString);
+                out << serialiseDouble (d, maximumDecimalPlaces + 1);
             }
             else
             {
@@ -474,6 +473,633 @@ struct JSONFormatter
     enum { indentSize = 2 };
 };
 
+//==============================================================================
+/*  Parses JSON from a stream a chunk at a time, reporting what it finds to an
+    EventHandler. It accepts the same syntax as JSONParser.
+*/
+struct JSONStreamParser
+{
+    JSONStreamParser (InputStream& in, JSON::EventHandler& h)  : input (&in), handler (h) {}
+
+    Result parseObjectOrArray()
+    {
+        skipByteOrderMark();
+        skipWhitespace();
+
+        switch (next())
+        {
+            case endOfInput:    return Result::ok();
+            case '{':           return parseObject();
+            case '[':           return parseArray();
+            default:            break;
+        }
+
+        return createFail ("Expected '{' or '['");
+    }
+
+private:
+    enum { bufferSize = 32768, endOfInput = -1, maxNumberLength = 64 };
+
+    InputStream* input;
+    JSON::EventHandler& handler;
+    std::unique_ptr<InputStream> convertedInput;
+    String convertedText;
+    HeapBlock<char> buffer { (size_t) bufferSize };
+    int position = 0, numInBuffer = 0, lineNumber = 1;
+    MemoryOutputStream text;
+
+    //==============================================================================
+    bool fillBuffer()
+    {
+        position = 0;
+        numInBuffer = jmax (0, input->read (buffer, bufferSize));
+        return numInBuffer > 0;
+    }
+
+    int peek()
+    {
+        if (position >= numInBuffer && ! fillBuffer())
+            return endOfInput;
+
+        return (uint8) buffer[position];
+    }
+
+    int next()
+    {
+        auto c = peek();
+
+        if (c != endOfInput)
+            ++position;
+
+        return c;
+    }
+
+    void skipByteOrderMark()
+    {
+        if (! fillBuffer())
+            return;
+
+        auto* b = reinterpret_cast<const uint8*> (buffer.get());
+
+        if (numInBuffer >= 3 && b[0] == 0xef && b[1] == 0xbb && b[2] == 0xbf)
+        {
+            position = 3;
+        }
+        else if (numInBuffer >= 2 && ((b[0] == 0xff && b[1] == 0xfe) || (b[0] == 0xfe && b[1] == 0xff)))
+        {
+            // Only UTF-8 is parsed directly, so UTF-16 text has to be converted first
+            MemoryOutputStream mo;
+            mo.write (buffer, (size_t) numInBuffer);
+            mo << *input;
+
+            convertedText = mo.toString();
+            convertedInput.reset (new MemoryInputStream (convertedText.toRawUTF8(), convertedText.getNumBytesAsUTF8(), false));
+            input = convertedInput.get();
+            fillBuffer();
+        }
+    }
+
+    void skipWhitespace()
+    {
+        for (;;)
+        {
+            auto c = peek();
+
+            if (c == '\n')
+                ++lineNumber;
+            else if (c != ' ' && c != '\t' && c != '\r')
+                return;
+
+            ++position;
+        }
+    }
+
+    Result createFail (const char* message) const
+    {
+        return Result::fail (String (message) + " (line " + String (lineNumber) + ")");
+    }
+
+    //==============================================================================
+    Result parseAny()
+    {
+        skipWhitespace();
+
+        switch (next())
+        {
+            case '{':    return parseObject();
+            case '[':    return parseArray();
+
+            case '"':
+            case '\'':
+            {
+                auto r = parseString ((char) buffer[position - 1]);
+
+                if (r.wasOk())
+                    handler.stringValue (getText());
+
+                return r;
+            }
+
+            case '-':
+                skipWhitespace();
+
+                if (! CharacterFunctions::isDigit ((char) peek()))
+                    break;
+
+                return parseNumber (true);
+
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                --position;
+                return parseNumber (false);
+
+            case 't':
+                if (expectKeyword ("rue"))   { handler.boolValue (true);  return Result::ok(); }
+                break;
+
+            case 'f':
+                if (expectKeyword ("alse"))  { handler.boolValue (false); return Result::ok(); }
+                break;
+
+            case 'n':
+                if (expectKeyword ("ull"))   { handler.nullValue();       return Result::ok(); }
+                break;
+
+            default:
+                break;
+        }
+
+        return createFail ("Syntax error");
+    }
+
+    bool expectKeyword (const char* rest)
+    {
+        for (; *rest != 0; ++rest)
+            if (next() != *rest)
+                return false;
+
+        return true;
+    }
+
+    Result parseObject()
+    {
+        handler.beginObject();
+
+        for (;;)
+        {
+            skipWhitespace();
+            auto c = next();
+
+            if (c == '}')
+                break;
+
+            if (c == endOfInput)
+                return createFail ("Unexpected end-of-input in object declaration");
+
+            if (c != '"')
+                return createFail ("Expected object member declaration");
+
+            auto r = parseString ('"');
+
+            if (r.failed())
+                return r;
+
+            if (text.getDataSize() <= 1)
+                return createFail ("Expected object member declaration");
+
+            handler.propertyName (getText());
+            skipWhitespace();
+
+            if (next() != ':')
+                return createFail ("Expected ':'");
+
+            r = parseAny();
+
+            if (r.failed())
+                return r;
+
+            skipWhitespace();
+            auto nextChar = next();
+
+            if (nextChar == ',')
+                continue;
+
+            if (nextChar == '}')
+                break;
+
+            return createFail ("Expected ',' or '}' in object declaration");
+        }
+
+        handler.endObject();
+        return Result::ok();
+    }
+
+    Result parseArray()
+    {
+        handler.beginArray();
+
+        for (;;)
+        {
+            skipWhitespace();
+            auto c = peek();
+
+            if (c == ']')
+            {
+                ++position;
+                break;
+            }
+
+            if (c == endOfInput)
+                return createFail ("Unexpected end-of-input in array declaration");
+
+            auto r = parseAny();
+
+            if (r.failed())
+                return r;
+
+            skipWhitespace();
+            auto nextChar = next();
+
+            if (nextChar == ',')
+                continue;
+
+            if (nextChar == ']')
+                break;
+
+            return createFail ("Expected object array item");
+        }
+
+        handler.endArray();
+        return Result::ok();
+    }
+
+    //==============================================================================
+    // Leaves the un-escaped, null-terminated UTF-8 text of the string in the text stream
+    Result parseString (char quoteChar)
+    {
+        text.reset();
+
+        for (;;)
+        {
+            if (position >= numInBuffer && ! fillBuffer())
+                return createFail ("Unexpected end-of-input in string constant");
+
+            // Copy any run of plain characters straight into the output in one go
+            auto* start = buffer.get() + position;
+            auto* end = buffer.get() + numInBuffer;
+            auto* t = start;
+
+            while (t < end && *t != quoteChar && *t != '\\' && *t != 0 && *t != '\n')
+                ++t;
+
+            text.write (start, (size_t) (t - start));
+            position += (int) (t - start);
+
+            if (position >= numInBuffer)
+                continue;
+
+            auto c = next();
+
+            if (c == quoteChar)
+                break;
+
+            if (c == '\n')
+            {
+                ++lineNumber;
+                text.writeByte ('\n');
+                continue;
+            }
+
+            if (c == 0)
+                return createFail ("Unexpected end-of-input in string constant");
+
+            auto r = parseEscapeSequence();
+
+            if (r.failed())
+                return r;
+        }
+
+        text.writeByte (0);
+
+        if (! CharPointer_UTF8::isValidString (getText().text, (int) text.getDataSize()))
+            return createFail ("Invalid UTF-8 in string constant");
+
+        return Result::ok();
+    }
+
+    Result parseEscapeSequence()
+    {
+        auto c = (juce_wchar) next();
+
+        switch (c)
+        {
+            case 'a':  c = '\a'; break;
+            case 'b':  c = '\b'; break;
+            case 'f':  c = '\f'; break;
+            case 'n':  c = '\n'; break;
+            case 'r':  c = '\r'; break;
+            case 't':  c = '\t'; break;
+
+            case 'u':
+            {
+                if (! readHexDigits (c))
+                    return createFail ("Syntax error in unicode escape sequence");
+
+                // a pair of escaped UTF-16 surrogates represents a single character
+                if (c >= 0xd800 && c < 0xdc00 && peek() == '\\')
+                {
+                    ++position;
+                    juce_wchar low = 0;
+
+                    if (next() != 'u' || ! readHexDigits (low))
+                        return createFail ("Syntax error in unicode escape sequence");
+
+                    if (low >= 0xdc00 && low < 0xe000)
+                    {
+                        c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+                    }
+                    else
+                    {
+                        text.appendUTF8Char (c);
+                        c = low;
+                    }
+                }
+
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        if (c == 0 || c == (juce_wchar) endOfInput)
+            return createFail ("Unexpected end-of-input in string constant");
+
+        text.appendUTF8Char (c);
+        return Result::ok();
+    }
+
+    bool readHexDigits (juce_wchar& result)
+    {
+        result = 0;
+
+        for (int i = 4; --i >= 0;)
+        {
+            auto digitValue = CharacterFunctions::getHexDigitValue ((juce_wchar) jmax (0, next()));
+
+            if (digitValue < 0)
+                return false;
+
+            result = (juce_wchar) ((result << 4) + static_cast<juce_wchar> (digitValue));
+        }
+
+        return true;
+    }
+
+    StringRef getText() const noexcept
+    {
+        return String::CharPointerType (static_cast<const char*> (text.getData()));
+    }
+
+    //==============================================================================
+    Result parseNumber (bool isNegative)
+    {
+        char digits[maxNumberLength + 1];
+        int numDigits = 0;
+        int64 intValue = 0;
+        bool isDouble = false;
+
+        for (;;)
+        {
+            auto c = peek();
+
+            if (CharacterFunctions::isDigit ((char) c))
+            {
+                intValue = intValue * 10 + (c - '0');
+            }
+            else if (c == 'e' || c == 'E' || c == '.' || (isDouble && (c == '+' || c == '-')))
+            {
+                isDouble = true;
+            }
+            else
+            {
+                if (! isDouble && ! (c == ' ' || c == '\t' || c == '\r' || c == '\n'
+                                      || c == ',' || c == '}' || c == ']' || c == endOfInput))
+                    return createFail ("Syntax error in number");
+
+                break;
+            }
+
+            if (numDigits == maxNumberLength)
+                return createFail ("Syntax error in number");
+
+            digits[numDigits++] = (char) c;
+            ++position;
+        }
+
+        if (isDouble)
+        {
+            digits[numDigits] = 0;
+            CharPointer_ASCII t (digits);
+            auto asDouble = CharacterFunctions::readDoubleValue (t);
+            handler.doubleValue (isNegative ? -asDouble : asDouble);
+        }
+        else
+        {
+            handler.intValue (isNegative ? -intValue : intValue);
+        }
+
+        return Result::ok();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (JSONStreamParser)
+};
+
+//==============================================================================
+// Builds the same var structure as JSONParser from a stream of events
+struct JSONVarBuilder  : public JSON::EventHandler
+{
+    void beginObject() override      { push (new DynamicObject()); }
+    void endObject() override        { containers.removeLast(); }
+    void beginArray() override       { push (Array<var>()); }
+    void endArray() override         { containers.removeLast(); }
+
+    void propertyName (StringRef name) override
+    {
+        propertyNameForNextValue = Identifier (name.text, name.text.findTerminatingNull());
+    }
+
+    void stringValue (StringRef value) override   { add (String (value.text)); }
+    void doubleValue (double value) override      { add (value); }
+    void boolValue (bool value) override          { add (value); }
+    void nullValue() override                     { add ({}); }
+
+    void intValue (int64 value) override
+    {
+        if (value > -2147483648LL && value < 2147483648LL)
+            add ((int) value);
+        else
+            add (value);
+    }
+
+    var result;
+
+private:
+    Array<var> containers;
+    Identifier propertyNameForNextValue;
+
+    void add (const var& value)
+    {
+        if (containers.isEmpty())
+            result = value;
+        else if (auto* array = containers.getReference (containers.size() - 1).getArray())
+            array->add (value);
+        else if (auto* object = containers.getReference (containers.size() - 1).getDynamicObject())
+            object->setProperty (propertyNameForNextValue, value);
+    }
+
+    void push (const var& container)
+    {
+        add (container);
+        containers.add (container);
+    }
+};
+
+//==============================================================================
+JSON::Writer::Writer (OutputStream& output, bool oneLine, int decimalPlaces)
+    : out (output), allOnOneLine (oneLine), maximumDecimalPlaces (decimalPlaces)
+{
+}
+
+JSON::Writer::~Writer()
+{
+    jassert (levels.isEmpty()); // Every beginObject() or beginArray() needs a matching end!
+}
+
+int JSON::Writer::getIndent() const noexcept
+{
+    return levels.size() * JSONFormatter::indentSize;
+}
+
+void JSON::Writer::startItem()
+{
+    if (hasWrittenName)
+    {
+        hasWrittenName = false;
+        return;
+    }
+
+    if (levels.isEmpty())
+        return;
+
+    auto& level = levels.getReference (levels.size() - 1);
+
+    // Object members need a name, and array items mustn't have one
+    jassert (! level.isObject);
+
+    if (level.numItems++ > 0)
+    {
+        if (allOnOneLine)
+            out << ", ";
+        else
+            out << ',' << newLine;
+    }
+    else if (! allOnOneLine)
+    {
+        out << newLine;
+    }
+
+    if (! allOnOneLine)
+        JSONFormatter::writeSpaces (out, getIndent());
+}
+
+void JSON::Writer::beginObject()
+{
+    startItem();
+    out << '{';
+
+    if (! allOnOneLine)
+        out << newLine;
+
+    levels.add ({ true, 0 });
+}
+
+void JSON::Writer::endObject()
+{
+    jassert (levels.size() > 0 && levels.getLast().isObject && ! hasWrittenName);
+
+    auto numItems = levels.getLast().numItems;
+    levels.removeLast();
+
+    if (! allOnOneLine)
+    {
+        if (numItems > 0)
+            out << newLine;
+
+        JSONFormatter::writeSpaces (out, getIndent());
+    }
+
+    out << '}';
+}
+
+void JSON::Writer::beginArray()
+{
+    startItem();
+    out << '[';
+    levels.add ({ false, 0 });
+}
+
+void JSON::Writer::endArray()
+{
+    jassert (levels.size() > 0 && ! levels.getLast().isObject);
+
+    auto numItems = levels.getLast().numItems;
+    levels.removeLast();
+
+    if (numItems > 0 && ! allOnOneLine)
+    {
+        out << newLine;
+        JSONFormatter::writeSpaces (out, getIndent());
+    }
+
+    out << ']';
+}
+
+void JSON::Writer::writeName (StringRef name)
+{
+    jassert (levels.size() > 0 && levels.getLast().isObject && ! hasWrittenName);
+
+    auto& level = levels.getReference (levels.size() - 1);
+
+    if (level.numItems++ > 0)
+    {
+        if (allOnOneLine)
+            out << ", ";
+        else
+            out << ',' << newLine;
+    }
+
+    if (! allOnOneLine)
+        JSONFormatter::writeSpaces (out, getIndent());
+
+    out << '"';
+    JSONFormatter::writeString (out, name.text);
+    out << "\": ";
+    hasWrittenName = true;
+}
+
+void JSON::Writer::writeValue (const var& value)
+{
+    startItem();
+    JSONFormatter::write (out, value, getIndent(), allOnOneLine, maximumDecimalPlaces);
+}
+
+void JSON::Writer::writeProperty (StringRef name, const var& value)
+{
+    writeName (name);
+    writeValue (value);
+}
+
 //==============================================================================
 var JSON::parse (const String& text)
 {
@@ -497,12 +1123,35 @@ var JSON::fromString (StringRef text)
 
 var JSON::parse (InputStream& input)
 {
-    return parse (input.readEntireStreamAsString());
+    var result;
+
+    if (! parse (input, result))
+        result = var();
+
+    return result;
 }
 
 var JSON::parse (const File& file)
 {
-    return parse (file.loadFileAsString());
+    FileInputStream in (file);
+
+    if (in.openedOk())
+        return parse (in);
+
+    return {};
+}
+
+Result JSON::parse (InputStream& input, var& result)
+{
+    JSONVarBuilder builder;
+    auto r = parse (input, builder);
+    result = builder.result;
+    return r;
+}
+
+Result JSON::parse (InputStream& input, EventHandler& handler)
+{
+    return JSONStreamParser (input, handler).parseObjectOrArray();
 }
 
 Result JSON::parse (const String& text, var& result)
@@ -674,6 +1323,146 @@ public:
             for (auto& test : tests)
                 expectEquals (JSON::toString (test.first), test.second);
         }
+
+        {
+            beginTest ("Streaming parser");
+
+            Random r = getRandom();
+
+            for (int i = 50; --i >= 0;)
+            {
+                var v = Array<var>();
+
+                for (int j = 20; --j >= 0;)
+                    v.append (createRandomVar (r, 0));
+
+                const bool oneLine = r.nextBool();
+                auto asString = JSON::toString (v, oneLine);
+
+                MemoryInputStream in (asString.toRawUTF8(), asString.getNumBytesAsUTF8(), false);
+                var parsed;
+                expect (JSON::parse (in, parsed).wasOk());
+                expectEquals (JSON::toString (parsed, oneLine), asString);
+                expectEquals (JSON::toString (JSON::parse (asString), oneLine), asString);
+            }
+
+            auto parseStream = [] (const String& text)
+            {
+                MemoryInputStream in (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+                return JSON::parse (in);
+            };
+
+            expect (parseStream ({}) == var());
+            expect (parseStream ("[ 1234 ]")[0].isInt());
+            expect (parseStream ("[ 12345678901234 ]")[0].isInt64());
+            expect (parseStream ("[ -2147483648 ]")[0].isInt64());
+            expect (parseStream ("[-1.123e3]")[0].isDouble());
+            expect (parseStream ("[ - 5 ]")[0] == var (-5));
+            expect (parseStream ("{ 'a': 1 }") == var());
+            expectEquals (parseStream ("{ \"a\": 'b\\n\\u00e9' }")["a"].toString(), String (CharPointer_UTF8 ("b\n\xc3\xa9")));
+            expectEquals (parseStream ("[\"\\ud83d\\ude00\"]")[0].toString(), String (CharPointer_UTF8 ("\xf0\x9f\x98\x80")));
+
+            for (auto bad : { "[1,", "{\"a\" 1}", "[tru]", "[\"abc", "{\"\": 1}", "[12a]", "x" })
+                expect (parseStream (bad) == var(), bad);
+
+            MemoryOutputStream utf16;
+            utf16.writeShort ((short) 0xfeff);
+
+            const String source ("{\"x\": [true, null]}");
+
+            for (auto t = source.getCharPointer(); ! t.isEmpty();)
+                utf16.writeShort ((short) t.getAndAdvance());
+
+            MemoryInputStream utf16In (utf16.getData(), utf16.getDataSize(), false);
+            auto fromUTF16 = JSON::parse (utf16In);
+            expect (fromUTF16["x"][0] == var (true) && fromUTF16["x"][1].isVoid());
+        }
+
+        {
+            beginTest ("Event handler");
+
+            struct Counter  : public JSON::EventHandler
+            {
+                void beginObject() override                 { ++numObjects; }
+                void beginArray() override                  { ++numArrays; }
+                void propertyName (StringRef n) override    { names.add (n); }
+                void intValue (int64 v) override            { total += v; }
+
+                int numObjects = 0, numArrays = 0;
+                int64 total = 0;
+                StringArray names;
+            };
+
+            // large enough to span several of the parser's reads
+            MemoryOutputStream mo;
+            mo << "[";
+
+            for (int i = 0; i < 10000; ++i)
+                mo << (i > 0 ? "," : "") << "{\"value\": " << i << ", \"s\": \"abc\"}";
+
+            mo << "]";
+
+            Counter counter;
+            MemoryInputStream in (mo.getData(), mo.getDataSize(), false);
+            expect (JSON::parse (in, counter).wasOk());
+            expectEquals (counter.numObjects, 10000);
+            expectEquals (counter.numArrays, 1);
+            expectEquals (counter.names.size(), 20000);
+            expect (counter.total == (int64) 10000 * 9999 / 2);
+
+            Counter failing;
+            MemoryInputStream badIn ("[1,\n2,\n}", 9, false);
+            auto r = JSON::parse (badIn, failing);
+            expect (r.failed() && r.getErrorMessage().contains ("line 3"));
+            expect (failing.total == 3);
+        }
+
+        {
+            beginTest ("Writer");
+
+            Random r = getRandom();
+
+            for (int i = 20; --i >= 0;)
+            {
+                auto* object = new DynamicObject();
+                var v (object);
+                object->setProperty ("empty", new DynamicObject());
+                object->setProperty ("emptyArray", Array<var>());
+
+                var list = Array<var>();
+
+                for (int j = r.nextInt (10); --j >= 0;)
+                    list.append (createRandomVar (r, 0));
+
+                object->setProperty ("list", list);
+                object->setProperty ("value", createRandomVar (r, 0));
+
+                const bool oneLine = r.nextBool();
+                MemoryOutputStream mo;
+
+                {
+                    JSON::Writer writer (mo, oneLine);
+                    writer.beginObject();
+                    writer.writeName ("empty");
+                    writer.beginObject();
+                    writer.endObject();
+                    writer.writeName ("emptyArray");
+                    writer.beginArray();
+                    writer.endArray();
+                    writer.writeName ("list");
+                    writer.beginArray();
+
+                    for (auto& item : *list.getArray())
+                        writer.writeValue (item);
+
+                    writer.endArray();
+                    writer.writeProperty ("value", v["value"]);
+                    writer.endObject();
+                }
+
+                expectEquals (mo.toString(), JSON::toString (v, oneLine));
+            }
+        }
     }
 };
 
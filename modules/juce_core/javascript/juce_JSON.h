@@ -80,14 +80,82 @@ public:
     /** Attempts to parse some JSON-formatted text from a stream, and returns the result
         as a var object.
 
-        Note that this is just a short-cut for reading the entire stream into a string and
-        parsing the result.
+        The text is read and parsed in chunks, so the stream's content never needs to be
+        held in memory as a single string.
 
         If the parsing fails, this simply returns var() - if you need to find out more
         detail about the parse error, use the alternative parse() method which returns a Result.
     */
     static var parse (InputStream& input);
 
+    /** Parses some JSON-formatted text from a stream, and returns a result code containing
+        any parse errors.
+
+        The text is read and parsed in chunks, so the stream's content never needs to be
+        held in memory as a single string. Like the other parse() methods, the item in the
+        stream must be an object or array.
+    */
+    static Result parse (InputStream& input, var& parsedResult);
+
+    //==============================================================================
+    /**
+        Receives the contents of a JSON document as a sequence of events, without
+        building any var objects.
+
+        Pass one of these to parse (InputStream&, EventHandler&) to pick values out of
+        a large document, or to convert it into your own data structures. All the
+        methods have empty default implementations, so you only need to override the
+        ones you're interested in.
+
+        Any text passed to these callbacks only remains valid for the duration of
+        the call, so take a copy of it if you need to keep it.
+    */
+    class JUCE_API  EventHandler
+    {
+    public:
+        /** Destructor. */
+        virtual ~EventHandler() = default;
+
+        /** Called when a '{' is reached. */
+        virtual void beginObject() {}
+
+        /** Called when the '}' for the innermost open object is reached. */
+        virtual void endObject() {}
+
+        /** Called when a '[' is reached. */
+        virtual void beginArray() {}
+
+        /** Called when the ']' for the innermost open array is reached. */
+        virtual void endArray() {}
+
+        /** Called with the name of each member of an object, before its value. */
+        virtual void propertyName (StringRef /*name*/) {}
+
+        /** Called for a string value. */
+        virtual void stringValue (StringRef /*value*/) {}
+
+        /** Called for a number that has no fractional part or exponent. */
+        virtual void intValue (int64 /*value*/) {}
+
+        /** Called for any other number. */
+        virtual void doubleValue (double /*value*/) {}
+
+        /** Called for a true or false value. */
+        virtual void boolValue (bool /*value*/) {}
+
+        /** Called for a null value. */
+        virtual void nullValue() {}
+    };
+
+    /** Parses some JSON-formatted text from a stream, passing each item that it finds to
+        an EventHandler rather than building a var.
+
+        The text is read in chunks, so this uses very little memory however large the stream
+        is. If the text is malformed, the handler will have received the events for everything
+        before the error, and the Result will describe the problem.
+    */
+    static Result parse (InputStream& input, EventHandler& handler);
+
     //==============================================================================
     /** Returns a string which contains a JSON-formatted representation of the var object.
         If allOnOneLine is true, the result will be compacted into a single line of text
@@ -119,6 +187,82 @@ public:
                                bool allOnOneLine = false,
                                int maximumDecimalPlaces = 15);
 
+    //==============================================================================
+    /**
+        Writes JSON-formatted text directly to a stream, one item at a time.
+
+        This lets you write out a large document without first building it as a var.
+        The output is laid out in the same way as writeToStream(), e.g.
+
+        @code
+        JSON::Writer writer (stream);
+        writer.beginObject();
+        writer.writeProperty ("name", "foo");
+        writer.writeName ("values");
+        writer.beginArray();
+
+        for (auto v : values)
+            writer.writeValue (v);
+
+        writer.endArray();
+        writer.endObject();
+        @endcode
+    */
+    class JUCE_API  Writer
+    {
+    public:
+        /** Creates a writer for a stream, which must stay valid for the writer's lifetime.
+            The allOnOneLine and maximumDecimalPlaces parameters have the same meaning
+            as they do for writeToStream().
+        */
+        Writer (OutputStream& output, bool allOnOneLine = false, int maximumDecimalPlaces = 15);
+
+        /** Destructor. Every object and array should have been closed by now. */
+        ~Writer();
+
+        /** Starts an object. It must be closed with a matching endObject(). */
+        void beginObject();
+
+        /** Closes the innermost object. */
+        void endObject();
+
+        /** Starts an array. It must be closed with a matching endArray(). */
+        void beginArray();
+
+        /** Closes the innermost array. */
+        void endArray();
+
+        /** Writes the name of the next member of the current object. This must be
+            followed by a value, object or array.
+        */
+        void writeName (StringRef name);
+
+        /** Writes a value, which may itself contain arrays or DynamicObjects. */
+        void writeValue (const var& value);
+
+        /** Writes an object member, which is a shortcut for writeName() and writeValue(). */
+        void writeProperty (StringRef name, const var& value);
+
+    private:
+        struct Level
+        {
+            bool isObject;
+            int numItems;
+        };
+
+        OutputStream& out;
+        Array<Level> levels;
+        const bool allOnOneLine;
+        const int maximumDecimalPlaces;
+        bool hasWrittenName = false;
+
+        void startItem();
+        int getIndent() const noexcept;
+
+        JUCE_DECLARE_NON_COPYABLE (Writer)
+    };
+
+    //==============================================================================
     /** Returns a version of a string with any extended characters escaped. */
     static String escapeString (StringRef);
 
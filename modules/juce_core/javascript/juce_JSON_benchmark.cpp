@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ParsingBenchmarks  : public Benchmark
+{
+public:
+    ParsingBenchmarks()  : Benchmark ("JSON and XML", "Text") {}
+
+    void initialise() override
+    {
+        Array<var> items;
+        XmlElement root ("ITEMS");
+
+        for (int i = 0; i < 200; ++i)
+        {
+            DynamicObject::Ptr item (new DynamicObject());
+            item->setProperty ("id", i);
+            item->setProperty ("name", "Item number " + String (i));
+            item->setProperty ("value", i * 0.25);
+            item->setProperty ("enabled", (i & 1) != 0);
+            items.add (var (item.get()));
+
+            auto* e = root.createNewChildElement ("ITEM");
+            e->setAttribute ("id", i);
+            e->setAttribute ("name", "Item number " + String (i));
+            e->setAttribute ("value", i * 0.25);
+            e->addTextElement ("Some text content for item " + String (i));
+        }
+
+        parsedJSON = var (items);
+        jsonText = JSON::toString (parsedJSON);
+        xmlText = root.createDocument (String());
+    }
+
+    void shutdown() override
+    {
+        parsedJSON = var();
+        jsonText.clear();
+        xmlText.clear();
+    }
+
+    void runBenchmark() override
+    {
+        measure ("JSON parse", [this] { doNotOptimiseAway (JSON::parse (jsonText)); });
+        measure ("JSON write", [this] { doNotOptimiseAway (JSON::toString (parsedJSON)); });
+
+        measure ("XML parse", [this]
+        {
+            std::unique_ptr<XmlElement> xml (XmlDocument::parse (xmlText));
+            doNotOptimiseAway (xml.get());
+        });
+
+        std::unique_ptr<XmlElement> xml (XmlDocument::parse (xmlText));
+
+        measure ("XML write", [&] { doNotOptimiseAway (xml->createDocument (String())); });
+    }
+
+private:
+    var parsedJSON;
+    String jsonText, xmlText;
+};
+
+static ParsingBenchmarks parsingBenchmarks;
+
+} // namespace juce
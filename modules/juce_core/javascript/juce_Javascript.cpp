@@ -378,17 +378,43 @@ struct JavascriptEngine::RootObject   : public DynamicObject
     {
         UnqualifiedName (const CodeLocation& l, const Identifier& n) noexcept : Expression (l), name (n) {}
 
-        var getResult (const Scope& s) const override  { return s.findSymbolInParentScopes (name); }
+        var getResult (const Scope& s) const override
+        {
+            if (auto* v = findInLocalScope (s))
+                return *v;
+
+            return s.parent != nullptr ? s.parent->findSymbolInParentScopes (name)
+                                       : var::undefined();
+        }
 
         void assign (const Scope& s, const var& newValue) const override
         {
-            if (auto* v = getPropertyPointer (*s.scope, name))
+            if (auto* v = findInLocalScope (s))
                 *v = newValue;
             else
                 s.root->setProperty (name, newValue);
         }
 
+        // A name usually ends up at the same position in its scope's properties each time
+        // it's evaluated, so that slot is remembered and checked before searching for it
+        var* findInLocalScope (const Scope& s) const
+        {
+            auto& properties = s.scope->getProperties();
+
+            if (! (isPositiveAndBelow (cachedIndex, properties.size())
+                    && properties.begin()[cachedIndex].name == name))
+            {
+                cachedIndex = properties.indexOf (name);
+
+                if (cachedIndex < 0)
+                    return nullptr;
+            }
+
+            return properties.getVarPointerAt (cachedIndex);
+        }
+
         Identifier name;
+        mutable int cachedIndex = -1;
     };
 
     struct DotOperator  : public Expression
@@ -503,6 +529,16 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         {
             var a (lhs->getResult (s)), b (rhs->getResult (s));
 
+            // check for the common cases first, before the more general type-sniffing below
+            if (a.isDouble())
+            {
+                if (b.isDouble())                 return getWithDoubles (a, b);
+            }
+            else if (a.isInt() || a.isInt64())
+            {
+                if (b.isInt() || b.isInt64())     return getWithInts (a, b);
+            }
+
             if ((a.isUndefined() || a.isVoid()) && (b.isUndefined() || b.isVoid()))
                 return getWithUndefinedArg();
 
@@ -739,7 +775,7 @@ struct JavascriptEngine::RootObject   : public DynamicObject
         var invokeFunction (const Scope& s, const var& function, const var& thisObject) const
         {
             s.checkTimeOut (location);
-            Array<var> argVars;
+            SmallArray<var, 8> argVars;
 
             for (auto* a : arguments)
                 argVars.add (a->getResult (s));
@@ -1418,10 +1454,28 @@ struct JavascriptEngine::RootObject   : public DynamicObject
             return f.release();
         }
 
+        // If both sides of an operator are literals, this replaces it with its result
+        static Expression* foldConstants (BinaryOperator* op)
+        {
+            std::unique_ptr<BinaryOperator> e (op);
+
+            if (dynamic_cast<LiteralValue*> (e->lhs.get()) != nullptr
+                 && dynamic_cast<LiteralValue*> (e->rhs.get()) != nullptr)
+            {
+                try
+                {
+                    return new LiteralValue (e->location, e->getResult (Scope (nullptr, nullptr, nullptr)));
+                }
+                catch (String&) {} // leave it to fail at run-time, as it would have done anyway
+            }
+
+            return e.release();
+        }
+
         Expression* parseUnary()
         {
-            if (matchIf (TokenTypes::minus))       { ExpPtr a (new LiteralValue (location, (int) 0)), b (parseUnary()); return new SubtractionOp   (location, a, b); }
-            if (matchIf (TokenTypes::logicalNot))  { ExpPtr a (new LiteralValue (location, (int) 0)), b (parseUnary()); return new EqualsOp        (location, a, b); }
+            if (matchIf (TokenTypes::minus))       { ExpPtr a (new LiteralValue (location, (int) 0)), b (parseUnary()); return foldConstants (new SubtractionOp (location, a, b)); }
+            if (matchIf (TokenTypes::logicalNot))  { ExpPtr a (new LiteralValue (location, (int) 0)), b (parseUnary()); return foldConstants (new EqualsOp      (location, a, b)); }
             if (matchIf (TokenTypes::plusplus))    return parsePreIncDec<AdditionOp>();
             if (matchIf (TokenTypes::minusminus))  return parsePreIncDec<SubtractionOp>();
             if (matchIf (TokenTypes::typeof_))     return parseTypeof();
@@ -1435,9 +1489,9 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
             for (;;)
             {
-                if (matchIf (TokenTypes::times))        { ExpPtr b (parseUnary()); a.reset (new MultiplyOp (location, a, b)); }
-                else if (matchIf (TokenTypes::divide))  { ExpPtr b (parseUnary()); a.reset (new DivideOp   (location, a, b)); }
-                else if (matchIf (TokenTypes::modulo))  { ExpPtr b (parseUnary()); a.reset (new ModuloOp   (location, a, b)); }
+                if (matchIf (TokenTypes::times))        { ExpPtr b (parseUnary()); a.reset (foldConstants (new MultiplyOp (location, a, b))); }
+                else if (matchIf (TokenTypes::divide))  { ExpPtr b (parseUnary()); a.reset (foldConstants (new DivideOp   (location, a, b))); }
+                else if (matchIf (TokenTypes::modulo))  { ExpPtr b (parseUnary()); a.reset (foldConstants (new ModuloOp   (location, a, b))); }
                 else break;
             }
 
@@ -1450,8 +1504,8 @@ struct JavascriptEngine::RootObject   : public DynamicObject
 
             for (;;)
             {
-                if (matchIf (TokenTypes::plus))            { ExpPtr b (parseMultiplyDivide()); a.reset (new AdditionOp    (location, a, b)); }
-                else if (matchIf (TokenTypes::minus))      { ExpPtr b (parseMultiplyDivide()); a.reset (new SubtractionOp (location, a, b)); }
+                if (matchIf (TokenTypes::plus))            { ExpPtr b (parseMultiplyDivide()); a.reset (foldConstants (new AdditionOp    (location, a, b))); }
+                else if (matchIf (TokenTypes::minus))      { ExpPtr b (parseMultiplyDivide()); a.reset (foldConstants (new SubtractionOp (location, a, b))); }
                 else break;
             }
 
@@ -1911,6 +1965,71 @@ const NamedValueSet& JavascriptEngine::getRootObjectProperties() const noexcept
     return root->getProperties();
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JavascriptEngineTests  : public UnitTest
+{
+public:
+    JavascriptEngineTests() : UnitTest ("JavascriptEngine", "Javascript") {}
+
+    void runTest() override
+    {
+        beginTest ("Expressions");
+        {
+            JavascriptEngine engine;
+
+            expect (engine.evaluate ("-5") == var (-5));
+            expect (engine.evaluate ("2 * 3 + 1") == var (7));
+            expect (engine.evaluate ("7 / 2") == var (3.5));
+            expect (engine.evaluate ("-1.5 * 2") == var (-3.0));
+            expect (engine.evaluate ("!0") == var (true));
+            expectEquals (engine.evaluate ("'a' + 1 + 2").toString(), String ("a12"));
+            expect (engine.evaluate ("2147483647 + 1") == var ((int64) 2147483648LL));
+
+            Result r (Result::ok());
+            engine.evaluate ("'a' - 1", &r);
+            expect (r.failed());
+
+            // operators on literals that would fail are only reported if they're reached
+            expect (engine.execute ("var x = 1; if (x == 0) x = 'a' - 1;").wasOk());
+        }
+
+        beginTest ("Variables and functions");
+        {
+            JavascriptEngine engine;
+
+            expect (engine.execute ("function fib (n) { if (n < 2) return n; return fib (n - 1) + fib (n - 2); }"
+                                    "function sum (n) { var total = 0; for (var i = 0; i < n; ++i) total += i; return total; }"
+                                    "var counter = 0;"
+                                    "function bump() { counter = counter + 1; var local = counter; return local; }").wasOk());
+
+            expect (engine.evaluate ("fib (15)") == var (610));
+            expect (engine.evaluate ("sum (1000)") == var (499500));
+            expect (engine.evaluate ("bump() + bump()") == var (3));
+            expect (engine.evaluate ("counter") == var (2));
+
+            // names that are declared part-way through a function must still be found
+            expect (engine.execute ("function f() { var a = 1; for (var i = 0; i < 3; ++i) { if (i == 1) var b = 10; a += i; } return a + b; }").wasOk());
+            expect (engine.evaluate ("f()") == var (14));
+        }
+
+        beginTest ("Timeouts");
+        {
+            JavascriptEngine engine;
+            engine.maximumExecutionTime = RelativeTime::milliseconds (20);
+
+            auto r = engine.execute ("while (true) {}");
+            expect (r.failed() && r.getErrorMessage().contains ("timed-out"));
+        }
+    }
+};
+
+static JavascriptEngineTests javascriptEngineTests;
+
+#endif
+
 #if JUCE_MSVC
  #pragma warning (pop)
 #endif
@@ -39,6 +39,9 @@
 #include <locale>
 #include <cctype>
 #include <cstdarg>
+#include <deque>
+#include <condition_variable>
+#include <mutex>
 
 #if ! JUCE_ANDROID
  #include <sys/timeb.h>
@@ -72,6 +75,8 @@
   #include <sys/errno.h>
   #include <unistd.h>
   #include <netinet/in.h>
+  #include <sys/syscall.h>
+  #include <linux/futex.h>
  #endif
 
  #if JUCE_LINUX
@@ -102,6 +107,7 @@
 #if JUCE_MAC || JUCE_IOS
  #include <xlocale.h>
  #include <mach/mach.h>
+ #include <mach/thread_policy.h>
 #endif
 
 #if JUCE_ANDROID
@@ -111,6 +117,19 @@
 
 #undef check
 
+// the SSSE3 version of the Base64 functions is selected at runtime
+#if JUCE_INTEL && (JUCE_MSVC || JUCE_CLANG || (JUCE_GCC && __GNUC__ >= 5))
+ #ifndef JUCE_USE_BASE64_INTRINSICS
+  #define JUCE_USE_BASE64_INTRINSICS 1
+ #endif
+#else
+ #undef JUCE_USE_BASE64_INTRINSICS
+#endif
+
+#if JUCE_USE_BASE64_INTRINSICS
+ #include <immintrin.h>
+#endif
+
 //==============================================================================
 #ifndef    JUCE_STANDALONE_APPLICATION
  JUCE_COMPILER_WARNING ("Please re-save your project with the latest Projucer version to avoid this warning")
@@ -126,6 +145,7 @@
 #include "containers/juce_ReferenceCountedArray.cpp"
 #include "containers/juce_SparseSet.cpp"
 #include "files/juce_DirectoryIterator.cpp"
+#include "files/juce_DirectoryScanner.cpp"
 #include "files/juce_File.cpp"
 #include "files/juce_FileInputStream.cpp"
 #include "files/juce_FileOutputStream.cpp"
@@ -133,10 +153,14 @@
 #include "files/juce_TemporaryFile.cpp"
 #include "logging/juce_FileLogger.cpp"
 #include "logging/juce_Logger.cpp"
+#include "logging/juce_AsyncFileLogger.cpp"
 #include "maths/juce_BigInteger.cpp"
 #include "maths/juce_Expression.cpp"
 #include "maths/juce_Random.cpp"
+#include "maths/juce_FastRandom.cpp"
+#include "maths/juce_Histogram.cpp"
 #include "memory/juce_MemoryBlock.cpp"
+#include "memory/juce_MemoryArena.cpp"
 #include "misc/juce_RuntimePermissions.cpp"
 #include "misc/juce_Result.cpp"
 #include "misc/juce_Uuid.cpp"
@@ -145,8 +169,10 @@
 #include "network/juce_MACAddress.cpp"
 #include "network/juce_NamedPipe.cpp"
 #include "network/juce_Socket.cpp"
+#include "network/juce_SocketReactor.cpp"
 #include "network/juce_IPAddress.cpp"
 #include "streams/juce_BufferedInputStream.cpp"
+#include "streams/juce_ChunkedMemoryOutputStream.cpp"
 #include "streams/juce_FileInputSource.cpp"
 #include "streams/juce_InputStream.cpp"
 #include "streams/juce_MemoryInputStream.cpp"
@@ -163,20 +189,26 @@
 #include "text/juce_StringPool.cpp"
 #include "text/juce_TextDiff.cpp"
 #include "text/juce_Base64.cpp"
+#include "threads/juce_WaitableEvent.cpp"
 #include "threads/juce_ReadWriteLock.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
+#include "threads/juce_WorkStealingThreadPool.cpp"
+#include "threads/juce_TaskGroup.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
 #include "time/juce_PerformanceCounter.cpp"
+#include "time/juce_TraceRecorder.cpp"
 #include "time/juce_RelativeTime.cpp"
 #include "time/juce_Time.cpp"
 #include "unit_tests/juce_UnitTest.cpp"
+#include "unit_tests/juce_Benchmark.cpp"
 #include "containers/juce_Variant.cpp"
 #include "javascript/juce_JSON.cpp"
 #include "javascript/juce_Javascript.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlPullParser.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
@@ -242,6 +274,13 @@
 //==============================================================================
 #if JUCE_UNIT_TESTS
 #include "containers/juce_HashMap_test.cpp"
+#include "containers/juce_FlatHashMap_test.cpp"
+#include "containers/juce_LockFreeQueue_test.cpp"
+#include "containers/juce_SmallArray_test.cpp"
+#include "containers/juce_ConcurrentListenerList_test.cpp"
+#include "text/juce_String_benchmark.cpp"
+#include "javascript/juce_JSON_benchmark.cpp"
+#include "maths/juce_Random_benchmark.cpp"
 #endif
 
 //==============================================================================
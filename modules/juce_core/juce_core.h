@@ -182,6 +182,16 @@
  #define JUCE_STRICT_REFCOUNTEDPOINTER 0
 #endif
 
+/** Config: JUCE_ENABLE_TRACING
+    If enabled, the JUCE_TRACE_SCOPE macro records events with the TraceRecorder class, and
+    the events that JUCE itself has been instrumented with (message dispatch, audio graph
+    rendering, component painting, etc) are recorded too. When it's disabled, the macro
+    compiles to nothing.
+*/
+#ifndef JUCE_ENABLE_TRACING
+ #define JUCE_ENABLE_TRACING 0
+#endif
+
 
 #ifndef JUCE_STRING_UTF_TYPE
  #define JUCE_STRING_UTF_TYPE 8
@@ -243,6 +253,7 @@ namespace juce
 #include "memory/juce_ContainerDeletePolicy.h"
 #include "memory/juce_HeapBlock.h"
 #include "memory/juce_MemoryBlock.h"
+#include "memory/juce_MemoryArena.h"
 #include "memory/juce_ReferenceCountedObject.h"
 #include "memory/juce_ScopedPointer.h"
 #include "memory/juce_OptionalScopedPointer.h"
@@ -253,10 +264,12 @@ namespace juce
 #include "maths/juce_Range.h"
 #include "maths/juce_NormalisableRange.h"
 #include "maths/juce_StatisticsAccumulator.h"
+#include "maths/juce_Histogram.h"
 #include "containers/juce_ElementComparator.h"
 #include "containers/juce_ArrayAllocationBase.h"
 #include "containers/juce_ArrayBase.h"
 #include "containers/juce_Array.h"
+#include "containers/juce_SmallArray.h"
 #include "containers/juce_LinkedListPointer.h"
 #include "containers/juce_ListenerList.h"
 #include "containers/juce_OwnedArray.h"
@@ -280,6 +293,7 @@ namespace juce
 #include "containers/juce_NamedValueSet.h"
 #include "containers/juce_DynamicObject.h"
 #include "containers/juce_HashMap.h"
+#include "containers/juce_FlatHashMap.h"
 #include "system/juce_SystemStats.h"
 #include "memory/juce_HeavyweightLeakedObjectDetector.h"
 #include "time/juce_RelativeTime.h"
@@ -289,10 +303,12 @@ namespace juce
 #include "streams/juce_BufferedInputStream.h"
 #include "streams/juce_MemoryInputStream.h"
 #include "streams/juce_MemoryOutputStream.h"
+#include "streams/juce_ChunkedMemoryOutputStream.h"
 #include "streams/juce_SubregionStream.h"
 #include "streams/juce_InputSource.h"
 #include "files/juce_File.h"
 #include "files/juce_DirectoryIterator.h"
+#include "files/juce_DirectoryScanner.h"
 #include "files/juce_FileInputStream.h"
 #include "files/juce_FileOutputStream.h"
 #include "files/juce_FileSearchPath.h"
@@ -307,6 +323,7 @@ namespace juce
 #include "maths/juce_BigInteger.h"
 #include "maths/juce_Expression.h"
 #include "maths/juce_Random.h"
+#include "maths/juce_FastRandom.h"
 #include "misc/juce_RuntimePermissions.h"
 #include "misc/juce_WindowsRegistry.h"
 #include "threads/juce_ChildProcess.h"
@@ -319,6 +336,11 @@ namespace juce
 #include "threads/juce_Thread.h"
 #include "threads/juce_ThreadLocalValue.h"
 #include "threads/juce_ThreadPool.h"
+#include "threads/juce_WorkStealingThreadPool.h"
+#include "threads/juce_TaskGroup.h"
+#include "containers/juce_LockFreeQueue.h"
+#include "containers/juce_ConcurrentListenerList.h"
+#include "logging/juce_AsyncFileLogger.h"
 #include "threads/juce_TimeSliceThread.h"
 #include "threads/juce_ReadWriteLock.h"
 #include "threads/juce_ScopedReadLock.h"
@@ -327,13 +349,17 @@ namespace juce
 #include "network/juce_MACAddress.h"
 #include "network/juce_NamedPipe.h"
 #include "network/juce_Socket.h"
+#include "network/juce_SocketReactor.h"
 #include "network/juce_URL.h"
 #include "network/juce_WebInputStream.h"
 #include "streams/juce_URLInputSource.h"
 #include "time/juce_PerformanceCounter.h"
+#include "time/juce_TraceRecorder.h"
 #include "unit_tests/juce_UnitTest.h"
+#include "unit_tests/juce_Benchmark.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
+#include "xml/juce_XmlPullParser.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
@@ -0,0 +1,331 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AsyncFileLogger::WriterThread  : public Thread
+{
+    WriterThread (AsyncFileLogger& l)  : Thread ("JUCE async logger"), owner (l) {}
+
+    void run() override
+    {
+        // the realtime logging calls can't wake this thread, so it also checks the queue regularly
+        while (! threadShouldExit())
+        {
+            wait (20);
+            owner.writePendingMessages();
+        }
+    }
+
+    AsyncFileLogger& owner;
+};
+
+//==============================================================================
+AsyncFileLogger::AsyncFileLogger (const File& file, int64 maxFileSizeBytes, int maxNumOldFiles, int queueSize)
+    : logFile (file),
+      maxFileSize (maxFileSizeBytes),
+      maxOldFiles (jmax (0, maxNumOldFiles)),
+      queue (queueSize)
+{
+    if (! file.exists())
+        file.create();  // (to create the parent directories)
+
+    stream.reset (new FileOutputStream (logFile, 16384));
+
+    thread.reset (new WriterThread (*this));
+    thread->startThread();
+}
+
+AsyncFileLogger::~AsyncFileLogger()
+{
+    thread->stopThread (-1);
+    writePendingMessages();
+}
+
+//==============================================================================
+void AsyncFileLogger::logMessage (const String& message)
+{
+    Entry entry;
+    auto numBytes = message.getNumBytesAsUTF8();
+    entry.length = (uint32) numBytes;
+
+    if (numBytes <= (size_t) maxInlineMessageLength)
+    {
+        entry.longText = nullptr;
+        memcpy (entry.text, message.toRawUTF8(), numBytes);
+    }
+    else
+    {
+        entry.longText = new char[numBytes];
+        memcpy (entry.longText, message.toRawUTF8(), numBytes);
+    }
+
+    if (push (entry))
+        thread->notify();
+    else
+        delete[] entry.longText;
+}
+
+bool AsyncFileLogger::logMessageRealtime (const char* utf8Text) noexcept
+{
+    jassert (utf8Text != nullptr);
+
+    Entry entry;
+    entry.longText = nullptr;
+    entry.length = 0;
+
+    while (entry.length < (uint32) maxInlineMessageLength && utf8Text[entry.length] != 0)
+    {
+        entry.text[entry.length] = utf8Text[entry.length];
+        ++entry.length;
+    }
+
+    // don't leave half a character on the end if it had to be truncated
+    if (utf8Text[entry.length] != 0)
+        while (entry.length > 0 && (((uint8) utf8Text[entry.length]) & 0xc0) == 0x80)
+            --entry.length;
+
+    return push (entry);
+}
+
+bool AsyncFileLogger::push (const Entry& entry) noexcept
+{
+    if (queue.push (entry))
+        return true;
+
+    ++numMessagesDropped;
+    return false;
+}
+
+void AsyncFileLogger::flush()
+{
+    // taking the lock waits for any batch that the writer thread has already popped
+    writePendingMessages();
+}
+
+//==============================================================================
+void AsyncFileLogger::writePendingMessages()
+{
+    const ScopedLock sl (writeLock);
+
+    if (stream == nullptr || ! stream->openedOk())
+    {
+        // (if the file couldn't be opened, just discard the messages)
+        Entry entry;
+
+        while (queue.pop (entry))
+            delete[] entry.longText;
+
+        return;
+    }
+
+    Entry entry;
+    bool anyWritten = false;
+
+    while (queue.pop (entry))
+    {
+        if (entry.longText != nullptr)
+        {
+            stream->write (entry.longText, entry.length);
+            delete[] entry.longText;
+        }
+        else
+        {
+            stream->write (entry.text, entry.length);
+        }
+
+        *stream << newLine;
+        anyWritten = true;
+    }
+
+    auto numDropped = numMessagesDropped.load();
+
+    if (numDropped != numDropsReported)
+    {
+        *stream << "[" << String (numDropped - numDropsReported) << " log messages dropped]" << newLine;
+        numDropsReported = numDropped;
+        anyWritten = true;
+    }
+
+    if (anyWritten)
+    {
+        stream->flush();
+        rotateIfNeeded();
+    }
+}
+
+void AsyncFileLogger::rotateIfNeeded()
+{
+    if (maxFileSize < 0 || stream->getPosition() <= maxFileSize)
+        return;
+
+    stream.reset();
+
+    if (maxOldFiles == 0)
+    {
+        logFile.deleteFile();
+    }
+    else
+    {
+        getRotatedFile (maxOldFiles).deleteFile();
+
+        for (int i = maxOldFiles; --i > 0;)
+        {
+            auto f = getRotatedFile (i);
+
+            if (f.existsAsFile())
+                f.moveFileTo (getRotatedFile (i + 1));
+        }
+
+        logFile.moveFileTo (getRotatedFile (1));
+    }
+
+    stream.reset (new FileOutputStream (logFile, 16384));
+}
+
+File AsyncFileLogger::getRotatedFile (int index) const
+{
+    return logFile.getSiblingFile (logFile.getFileNameWithoutExtension() + "." + String (index) + logFile.getFileExtension());
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct AsyncFileLoggerTests  : public UnitTest
+{
+    AsyncFileLoggerTests()  : UnitTest ("AsyncFileLogger", "Logging") {}
+
+    void runTest() override
+    {
+        auto dir = File::createTempFile ("_logs");
+        dir.createDirectory();
+        auto file = dir.getChildFile ("test.log");
+
+        beginTest ("Writing messages");
+        {
+            {
+                AsyncFileLogger logger (file, -1);
+                logger.logMessage ("first");
+                logger.logMessageRealtime ("second");
+                logger.logMessage (String::repeatedString ("x", 1000));
+                logger.flush();
+
+                auto lines = StringArray::fromLines (file.loadFileAsString());
+                expectEquals (lines[0], String ("first"));
+                expectEquals (lines[1], String ("second"));
+                expectEquals (lines[2].length(), 1000);
+
+                logger.logMessage ("last");
+            }
+
+            // the destructor writes anything that's left
+            expect (file.loadFileAsString().contains ("last"));
+            file.deleteFile();
+        }
+
+        beginTest ("Many threads");
+        {
+            enum { numThreads = 4, numMessagesEach = 2000 };
+
+            {
+                AsyncFileLogger logger (file, -1, 0, 16384);
+
+                struct LoggingThread  : public Thread
+                {
+                    LoggingThread (AsyncFileLogger& l, int i)  : Thread ("log test"), logger (l), index (i) {}
+
+                    void run() override
+                    {
+                        for (int n = 0; n < numMessagesEach; ++n)
+                            if (! logger.logMessageRealtime (("thread " + String (index) + " message " + String (n)).toRawUTF8()))
+                                Thread::yield();
+                    }
+
+                    AsyncFileLogger& logger;
+                    const int index;
+                };
+
+                OwnedArray<LoggingThread> threads;
+
+                for (int i = 0; i < numThreads; ++i)
+                    threads.add (new LoggingThread (logger, i))->startThread();
+
+                for (auto* t : threads)
+                    t->waitForThreadToExit (-1);
+
+                logger.flush();
+
+                auto lines = StringArray::fromLines (file.loadFileAsString().trimEnd());
+                expectEquals (lines.size(), (int) (numThreads * numMessagesEach - logger.getNumMessagesDropped()));
+            }
+
+            file.deleteFile();
+        }
+
+        beginTest ("Dropped messages");
+        {
+            {
+                AsyncFileLogger logger (file, -1, 0, 4);
+
+                // the realtime calls don't wake the writer, so most of these won't fit
+                for (int i = 0; i < 10; ++i)
+                    logger.logMessageRealtime ("message");
+
+                auto numDropped = logger.getNumMessagesDropped();
+                expect (numDropped > 0);
+
+                logger.flush();
+                expect (file.loadFileAsString().contains ("[" + String (numDropped) + " log messages dropped]"));
+            }
+
+            file.deleteFile();
+        }
+
+        beginTest ("Rotation");
+        {
+            {
+                AsyncFileLogger logger (file, 100, 2);
+
+                for (int i = 0; i < 20; ++i)
+                {
+                    logger.logMessage (String::repeatedString (String (i % 10), 60));
+                    logger.flush();
+                }
+            }
+
+            expect (file.exists() && file.getSize() <= 200);
+            expect (dir.getChildFile ("test.1.log").exists());
+            expect (dir.getChildFile ("test.2.log").exists());
+            expect (! dir.getChildFile ("test.3.log").exists());
+            expect (dir.getChildFile ("test.1.log").loadFileAsString().contains (String::repeatedString ("9", 60)));
+        }
+
+        dir.deleteRecursively();
+    }
+};
+
+static AsyncFileLoggerTests asyncFileLoggerTests;
+
+#endif
+
+} // namespace juce
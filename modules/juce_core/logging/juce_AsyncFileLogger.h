@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A Logger that writes to a file from a background thread, so that logging never
+    has to wait for the disk.
+
+    Each call to logMessage() copies the text into a lock-free queue and returns
+    straight away; a thread then collects whatever has been queued and writes it out
+    in one go. Messages that fit in a queue slot (see maxInlineMessageLength) don't
+    allocate anything, and logMessageRealtime() lets you log from the audio thread.
+
+    When the file grows past a given size, it's renamed with a numbered suffix
+    (e.g. "MyApp.1.log") and a new one is started, keeping a limited number of old
+    files around.
+
+    If the queue fills up, new messages are dropped rather than waiting for room;
+    getNumMessagesDropped() tells you how many were lost, and a note of the count is
+    also written into the log.
+
+    @see FileLogger, Logger
+
+    @tags{Core}
+*/
+class JUCE_API  AsyncFileLogger  : public Logger
+{
+public:
+    //==============================================================================
+    /** Creates a logger that appends to the given file.
+
+        @param fileToWriteTo        the file to write to. If it doesn't exist, it will be created,
+                                    along with any parent directories that are needed
+        @param maxFileSizeBytes     when the file grows beyond this size, it gets rotated. If this
+                                    is less than zero, the file is never rotated
+        @param maxNumOldFiles       the number of rotated files to keep - older ones are deleted
+        @param queueSize            the number of messages that can be waiting to be written
+                                    before new ones start getting dropped
+    */
+    AsyncFileLogger (const File& fileToWriteTo,
+                     int64 maxFileSizeBytes = 4 * 1024 * 1024,
+                     int maxNumOldFiles = 3,
+                     int queueSize = 1024);
+
+    /** Destructor.
+        Any messages that are still waiting will be written before this returns.
+    */
+    ~AsyncFileLogger() override;
+
+    //==============================================================================
+    /** Returns the file that this logger is writing to. */
+    const File& getLogFile() const noexcept                 { return logFile; }
+
+    /** The longest message, in bytes of UTF-8, that can be queued without allocating. */
+    enum { maxInlineMessageLength = 244 };
+
+    // (implementation of the Logger virtual method)
+    void logMessage (const String&) override;
+
+    /** Queues a message without taking any locks, allocating, or waking the writer thread,
+        so this is safe to call on the audio thread.
+
+        Anything longer than maxInlineMessageLength bytes is truncated. The message will be
+        written when the writer thread next checks the queue, which it does every few
+        milliseconds.
+
+        @returns false if the queue was full and the message was dropped
+    */
+    bool logMessageRealtime (const char* utf8Text) noexcept;
+
+    /** Blocks until all the messages queued so far have been written to the file. */
+    void flush();
+
+    /** Returns the number of messages that have been dropped because the queue was full. */
+    int64 getNumMessagesDropped() const noexcept            { return numMessagesDropped.load(); }
+
+private:
+    //==============================================================================
+    struct Entry
+    {
+        char* longText;
+        uint32 length;
+        char text[maxInlineMessageLength];
+    };
+
+    struct WriterThread;
+
+    const File logFile;
+    const int64 maxFileSize;
+    const int maxOldFiles;
+    LockFreeMPSCQueue<Entry> queue;
+    std::atomic<int64> numMessagesDropped { 0 };
+    int64 numDropsReported = 0;
+    CriticalSection writeLock;
+    std::unique_ptr<FileOutputStream> stream;
+    std::unique_ptr<WriterThread> thread;
+
+    bool push (const Entry&) noexcept;
+    void writePendingMessages();
+    void rotateIfNeeded();
+    File getRotatedFile (int index) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncFileLogger)
+};
+
+} // namespace juce
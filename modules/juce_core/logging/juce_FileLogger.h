@@ -27,7 +27,11 @@ namespace juce
 /**
     A simple implementation of a Logger that writes to a file.
 
-    @see Logger
+    Each message is written before logMessage() returns, which means that the caller may
+    have to wait for the disk. If you're logging from threads where that matters, use an
+    AsyncFileLogger instead.
+
+    @see Logger, AsyncFileLogger
 
     @tags{Core}
 */
@@ -50,6 +50,217 @@ int findHighestSetBit (uint32 n) noexcept
   #endif
 }
 
+//==============================================================================
+namespace BigIntegerHelpers
+{
+    // Below this many ints, the overhead of Karatsuba's extra additions outweighs
+    // the multiplications that it saves
+    enum { karatsubaThreshold = 32 };
+
+    // Adds src to dest, returning any carry out of the top of dest
+    static uint32 addInPlace (uint32* dest, size_t numDest, const uint32* src, size_t numSrc) noexcept
+    {
+        jassert (numDest >= numSrc);
+        uint64 carry = 0;
+        size_t i = 0;
+
+        for (; i < numSrc; ++i)
+        {
+            carry += (uint64) dest[i] + src[i];
+            dest[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        for (; carry != 0 && i < numDest; ++i)
+        {
+            carry += dest[i];
+            dest[i] = (uint32) carry;
+            carry >>= 32;
+        }
+
+        return (uint32) carry;
+    }
+
+    // Subtracts src from dest, returning any borrow out of the top of dest
+    static uint32 subtractInPlace (uint32* dest, size_t numDest, const uint32* src, size_t numSrc) noexcept
+    {
+        jassert (numDest >= numSrc);
+        uint32 borrow = 0;
+        size_t i = 0;
+
+        for (; i < numSrc; ++i)
+        {
+            auto diff = (uint64) dest[i] - src[i] - borrow;
+            dest[i] = (uint32) diff;
+            borrow = (uint32) (diff >> 63);
+        }
+
+        for (; borrow != 0 && i < numDest; ++i)
+        {
+            auto diff = (uint64) dest[i] - borrow;
+            dest[i] = (uint32) diff;
+            borrow = (uint32) (diff >> 63);
+        }
+
+        return borrow;
+    }
+
+    static int compareValues (const uint32* a, const uint32* b, size_t num) noexcept
+    {
+        while (num > 0)
+        {
+            --num;
+
+            if (a[num] != b[num])
+                return a[num] > b[num] ? 1 : -1;
+        }
+
+        return 0;
+    }
+
+    static void multiplySchoolbook (const uint32* a, size_t numA, const uint32* b, size_t numB, uint32* result) noexcept
+    {
+        std::fill (result, result + numA + numB, 0u);
+
+        for (size_t i = 0; i < numB; ++i)
+        {
+            auto bi = (uint64) b[i];
+            uint64 carry = 0;
+
+            for (size_t j = 0; j < numA; ++j)
+            {
+                carry += (uint64) result[i + j] + (uint64) a[j] * bi;
+                result[i + j] = (uint32) carry;
+                carry >>= 32;
+            }
+
+            result[i + numA] = (uint32) carry;
+        }
+    }
+
+    // Writes numA + numB ints to the result, which mustn't overlap either of the inputs
+    static void multiply (const uint32* a, size_t numA, const uint32* b, size_t numB, uint32* result)
+    {
+        if (numA < numB)
+        {
+            std::swap (a, b);
+            std::swap (numA, numB);
+        }
+
+        if (numB < karatsubaThreshold)
+            return multiplySchoolbook (a, numA, b, numB, result);
+
+        auto half = (numA + 1) / 2;
+        auto numHighA = numA - half;
+
+        if (numB <= half)
+        {
+            // b is too short to split, so multiply it by each half of a in turn
+            multiply (a, half, b, numB, result);
+            std::fill (result + half + numB, result + numA + numB, 0u);
+
+            HeapBlock<uint32> high (numHighA + numB);
+            multiply (a + half, numHighA, b, numB, high);
+            addInPlace (result + half, numHighA + numB, high, numHighA + numB);
+            return;
+        }
+
+        auto numHighB = numB - half;
+
+        // a * b = low + (middle << half) + (high << 2 * half), where the middle term
+        // is found from (aLow + aHigh) * (bLow + bHigh) - low - high
+        multiply (a, half, b, half, result);
+        multiply (a + half, numHighA, b + half, numHighB, result + 2 * half);
+
+        HeapBlock<uint32> sums (2 * (half + 1)), middle (2 * (half + 1));
+        auto* sumA = sums.get();
+        auto* sumB = sumA + half + 1;
+
+        std::copy (a, a + half, sumA);
+        std::copy (b, b + half, sumB);
+        sumA[half] = addInPlace (sumA, half, a + half, numHighA);
+        sumB[half] = addInPlace (sumB, half, b + half, numHighB);
+
+        multiply (sumA, half + 1, sumB, half + 1, middle);
+        subtractInPlace (middle, 2 * (half + 1), result, 2 * half);
+        subtractInPlace (middle, 2 * (half + 1), result + 2 * half, numHighA + numHighB);
+
+        auto numMiddle = jmin (2 * (half + 1), numA + numB - half);
+        addInPlace (result + half, numA + numB - half, middle, numMiddle);
+    }
+
+    //==============================================================================
+    // Does Montgomery multiplication of fixed-size numbers, i.e. (a * b / R) % modulus,
+    // where R is 2 ^ (32 * numInts)
+    struct MontgomeryModulus
+    {
+        MontgomeryModulus (const uint32* modulusValues, size_t numModulusInts)
+            : modulus (modulusValues), numInts (numModulusInts), temp (numModulusInts + 2)
+        {
+            jassert ((modulus[0] & 1) != 0);
+
+            // Newton's iteration for the inverse of the lowest int: each step doubles
+            // the number of correct bits
+            uint32 inverse = modulus[0];
+
+            for (int i = 0; i < 4; ++i)
+                inverse *= 2u - modulus[0] * inverse;
+
+            negativeInverse = 0u - inverse;
+        }
+
+        // The inputs must both be less than the modulus, and the result may overlap them
+        void multiply (const uint32* a, const uint32* b, uint32* result) noexcept
+        {
+            auto* t = temp.get();
+            std::fill (t, t + numInts + 2, 0u);
+
+            for (size_t i = 0; i < numInts; ++i)
+            {
+                auto ai = (uint64) a[i];
+                uint64 carry = 0;
+
+                for (size_t j = 0; j < numInts; ++j)
+                {
+                    carry += (uint64) t[j] + ai * b[j];
+                    t[j] = (uint32) carry;
+                    carry >>= 32;
+                }
+
+                carry += t[numInts];
+                t[numInts] = (uint32) carry;
+                t[numInts + 1] = (uint32) (carry >> 32);
+
+                // add the multiple of the modulus that clears the lowest int, and shift down by an int
+                auto u = (uint64) (uint32) (t[0] * negativeInverse);
+                carry = ((uint64) t[0] + u * modulus[0]) >> 32;
+
+                for (size_t j = 1; j < numInts; ++j)
+                {
+                    carry += (uint64) t[j] + u * modulus[j];
+                    t[j - 1] = (uint32) carry;
+                    carry >>= 32;
+                }
+
+                carry += t[numInts];
+                t[numInts - 1] = (uint32) carry;
+                t[numInts] = t[numInts + 1] + (uint32) (carry >> 32);
+            }
+
+            // the result is now less than 2 * modulus
+            if (t[numInts] != 0 || compareValues (t, modulus, numInts) >= 0)
+                subtractInPlace (t, numInts + 1, modulus, numInts);
+
+            std::copy (t, t + numInts, result);
+        }
+
+        const uint32* modulus;
+        const size_t numInts;
+        uint32 negativeInverse;
+        HeapBlock<uint32> temp;
+    };
+}
+
 //==============================================================================
 BigInteger::BigInteger()
     : allocatedSize (numPreallocatedInts)
@@ -527,38 +738,23 @@ BigInteger& BigInteger::operator*= (const BigInteger& other)
     auto n = getHighestBit();
     auto t = other.getHighestBit();
 
-    auto wasNegative = isNegative();
-    setNegative (false);
+    if (n < 0 || t < 0)
+    {
+        clear();
+        return *this;
+    }
+
+    auto numInts = sizeNeededToHold (n);
+    auto numOtherInts = sizeNeededToHold (t);
 
     BigInteger total;
     total.highestBit = n + t + 1;
-    auto* totalValues = total.ensureSize (sizeNeededToHold (total.highestBit) + 1);
-
-    n >>= 5;
-    t >>= 5;
-
-    auto m = other;
-    m.setNegative (false);
-
-    auto* mValues = m.getValues();
-    auto* values = getValues();
-
-    for (int i = 0; i <= t; ++i)
-    {
-        uint32 c = 0;
-
-        for (int j = 0; j <= n; ++j)
-        {
-            auto uv = (uint64) totalValues[i + j] + (uint64) values[j] * (uint64) mValues[i] + (uint64) c;
-            totalValues[i + j] = (uint32) uv;
-            c = uv >> 32;
-        }
+    auto* totalValues = total.ensureSize (numInts + numOtherInts);
 
-        totalValues[i + n + 1] = c;
-    }
+    BigIntegerHelpers::multiply (getValues(), numInts, other.getValues(), numOtherInts, totalValues);
 
     total.highestBit = total.getHighestBit();
-    total.setNegative (wasNegative ^ other.isNegative());
+    total.setNegative (isNegative() ^ other.isNegative());
     swapWith (total);
 
     return *this;
@@ -927,45 +1123,72 @@ void BigInteger::exponentModulo (const BigInteger& exponent, const BigInteger& m
     }
     else
     {
-        auto Rfactor = modulus.getHighestBit() + 1;
-        BigInteger R (1);
-        R.shiftLeft (Rfactor, 0);
+        if (isNegative())
+            *this += modulus;
 
-        BigInteger R1, m1, g;
-        g.extendedEuclidean (modulus, R, m1, R1);
+        // Convert into Montgomery form, where each value x is held as (x * R) % modulus
+        auto numInts = sizeNeededToHold (modulus.getHighestBit());
+        BigIntegerHelpers::MontgomeryModulus mont (modulus.getValues(), numInts);
 
-        if (! g.isOne())
+        auto toMontgomeryForm = [&] (BigInteger value, uint32* dest)
         {
-            BigInteger a (*this);
+            value <<= (int) (numInts * 32);
+            value %= modulus;
+            std::fill (dest, dest + numInts, 0u);
+            std::copy (value.getValues(), value.getValues() + sizeNeededToHold (jmax (0, value.getHighestBit())), dest);
+        };
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                *this *= *this;
+        // Sliding-window exponentiation, using a table of the odd powers of this value
+        auto numExpBits = exp.getHighestBit() + 1;
+        auto windowSize = numExpBits > 671 ? 6 : (numExpBits > 239 ? 5 : (numExpBits > 79 ? 4 : (numExpBits > 23 ? 3 : 1)));
+        auto numOddPowers = (size_t) 1 << (windowSize - 1);
 
-                if (exp[i])
-                    *this *= a;
+        HeapBlock<uint32> oddPowers (numOddPowers * numInts), square (numInts), result (numInts);
+        toMontgomeryForm (*this, oddPowers);
 
-                if (compareAbsolute (modulus) >= 0)
-                    *this %= modulus;
-            }
-        }
-        else
+        if (numOddPowers > 1)
         {
-            auto am  = (*this * R) % modulus;
-            auto xm = am;
-            auto um = R % modulus;
+            mont.multiply (oddPowers, oddPowers, square);
 
-            for (int i = exp.getHighestBit(); --i >= 0;)
-            {
-                xm.montgomeryMultiplication (xm, modulus, m1, Rfactor);
+            for (size_t i = 1; i < numOddPowers; ++i)
+                mont.multiply (oddPowers + (i - 1) * numInts, square, oddPowers + i * numInts);
+        }
+
+        toMontgomeryForm (BigInteger (1), result);
 
-                if (exp[i])
-                    xm.montgomeryMultiplication (am, modulus, m1, Rfactor);
+        for (int i = numExpBits - 1; i >= 0;)
+        {
+            if (! exp[i])
+            {
+                mont.multiply (result, result, result);
+                --i;
+                continue;
             }
 
-            xm.montgomeryMultiplication (1, modulus, m1, Rfactor);
-            swapWith (xm);
+            // find the longest window ending in a set bit
+            auto lowestBit = jmax (0, i - windowSize + 1);
+
+            while (! exp[lowestBit])
+                ++lowestBit;
+
+            auto windowValue = exp.getBitRangeAsInt (lowestBit, i - lowestBit + 1);
+
+            for (int j = lowestBit; j <= i; ++j)
+                mont.multiply (result, result, result);
+
+            mont.multiply (result, oddPowers + (windowValue >> 1) * numInts, result);
+            i = lowestBit - 1;
         }
+
+        // multiplying by 1 takes the result back out of Montgomery form
+        std::fill (square.get(), square + numInts, 0u);
+        square[0] = 1;
+        mont.multiply (result, square, result);
+
+        clear();
+        std::copy (result.get(), result + numInts, ensureSize (numInts));
+        highestBit = (int) numInts * 32 - 1;
+        highestBit = getHighestBit();
     }
 }
 
@@ -1333,6 +1556,60 @@ public:
             }
         }
 
+        {
+            beginTest ("Large multiplication");
+
+            Random r = getRandom();
+
+            for (int j = 50; --j >= 0;)
+            {
+                BigInteger b1, b2;
+                r.fillBitsRandomly (b1, 0, r.nextInt (8000) + 1000);
+                r.fillBitsRandomly (b2, 0, r.nextInt (8000) + 1);
+
+                // build the product up from small multiplications, which don't use Karatsuba
+                BigInteger expected;
+
+                for (int bit = 0; bit <= b2.getHighestBit(); bit += 32)
+                    expected += (b1 * BigInteger ((int64) b2.getBitRangeAsInt (bit, 32))) << bit;
+
+                expect (b1 * b2 == expected);
+                expect (b2 * b1 == expected);
+                expect (b1 * b1 == b1 * BigInteger (b1));
+            }
+        }
+
+        {
+            beginTest ("Exponent modulo");
+
+            Random r = getRandom();
+
+            for (int j = 20; --j >= 0;)
+            {
+                BigInteger base, exponent, modulus;
+                auto numModulusBits = r.nextInt (1500) + 40;
+                r.fillBitsRandomly (base, 0, r.nextInt (1500) + 1);
+                r.fillBitsRandomly (exponent, 0, r.nextInt (numModulusBits - 1) + 1);
+                r.fillBitsRandomly (modulus, 0, numModulusBits);
+                modulus.setBit (numModulusBits - 1);
+                modulus.setBit (0);
+
+                BigInteger expected (1), power (base % modulus);
+
+                for (int bit = 0; bit <= exponent.getHighestBit(); ++bit)
+                {
+                    if (exponent[bit])
+                        expected = (expected * power) % modulus;
+
+                    power = (power * power) % modulus;
+                }
+
+                auto result = base;
+                result.exponentModulo (exponent, modulus);
+                expect (result == expected);
+            }
+        }
+
         {
             beginTest ("Bit setting");
 
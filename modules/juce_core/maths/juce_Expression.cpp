@@ -917,6 +917,199 @@ struct Expression::Helpers
 
         JUCE_DECLARE_NON_COPYABLE (Parser)
     };
+
+    //==============================================================================
+    class Compiler
+    {
+    public:
+        Compiler (const StringArray& names, Array<Compiled::Op>& output)
+            : symbolNames (names), ops (output)
+        {
+        }
+
+        void compile (const Term& t, const Scope& scope, const String& scopePrefix, int recursionDepth)
+        {
+            checkRecursionDepth (recursionDepth);
+
+            switch (t.getType())
+            {
+                case constantType:  addOp (Compiled::OpCode::pushConstant, 0, 0, t.toDouble()); break;
+                case symbolType:    compileSymbol (t.getName(), scope, scopePrefix, recursionDepth); break;
+                case functionType:  compileFunction (t, scope, scopePrefix, recursionDepth); break;
+                case operatorType:  compileOperator (t, scope, scopePrefix, recursionDepth); break;
+                default:            jassertfalse; break;
+            }
+        }
+
+    private:
+        const StringArray& symbolNames;
+        Array<Compiled::Op>& ops;
+        int depth = 0;
+
+        void compileSymbol (const String& symbol, const Scope& scope, const String& scopePrefix, int recursionDepth)
+        {
+            auto index = symbolNames.indexOf (scopePrefix + symbol);
+
+            if (index >= 0)
+                addOp (Compiled::OpCode::pushSymbol, 0, index);
+            else
+                compile (*scope.getSymbolValue (symbol).term, scope, scopePrefix, recursionDepth + 1);
+        }
+
+        void compileFunction (const Term& t, const Scope& scope, const String& scopePrefix, int recursionDepth)
+        {
+            auto name = t.getName();
+            auto numParams = t.getNumInputs();
+
+            for (int i = 0; i < numParams; ++i)
+                compile (*t.getInput (i), scope, scopePrefix, recursionDepth + 1);
+
+            if (lastOpsAreConstant (numParams))
+            {
+                Array<double> params;
+
+                for (int i = ops.size() - numParams; i < ops.size(); ++i)
+                    params.add (ops.getReference (i).value);
+
+                removeLastOps (numParams);
+                addOp (Compiled::OpCode::pushConstant, 0, 0, scope.evaluateFunction (name, params.getRawDataPointer(), numParams));
+                return;
+            }
+
+            if (name == "min" || name == "max")
+                return addOp (name == "min" ? Compiled::OpCode::min : Compiled::OpCode::max, numParams, numParams);
+
+            if (numParams == 1)
+            {
+                if (name == "sin")  return addOp (Compiled::OpCode::sin, 1);
+                if (name == "cos")  return addOp (Compiled::OpCode::cos, 1);
+                if (name == "tan")  return addOp (Compiled::OpCode::tan, 1);
+                if (name == "abs")  return addOp (Compiled::OpCode::abs, 1);
+            }
+
+            throw EvaluationError ("Can't compile a call to \"" + name + "\" with non-constant parameters");
+        }
+
+        void compileOperator (const Term& t, const Scope& scope, const String& scopePrefix, int recursionDepth)
+        {
+            auto name = t.getName();
+
+            if (name == ".")
+            {
+                auto index = symbolNames.indexOf (scopePrefix + getDottedName (t));
+
+                if (index >= 0)
+                    return addOp (Compiled::OpCode::pushSymbol, 0, index);
+
+                auto symbol = t.getInput (0)->getName();
+                RelativeScopeCompiler visitor (*this, *t.getInput (1), scopePrefix + symbol + ".", recursionDepth + 1);
+                scope.visitRelativeScope (symbol, visitor);
+
+                if (! visitor.wasVisited)
+                    throw EvaluationError ("Unknown symbol: " + symbol);
+
+                return;
+            }
+
+            for (int i = 0; i < t.getNumInputs(); ++i)
+                compile (*t.getInput (i), scope, scopePrefix, recursionDepth);
+
+            if (t.getNumInputs() == 1)
+            {
+                jassert (name == "-");
+                return addOp (Compiled::OpCode::negate, 1);
+            }
+
+            if (name == "+")  return addOp (Compiled::OpCode::add, 2);
+            if (name == "-")  return addOp (Compiled::OpCode::subtract, 2);
+            if (name == "*")  return addOp (Compiled::OpCode::multiply, 2);
+            if (name == "/")  return addOp (Compiled::OpCode::divide, 2);
+
+            throw EvaluationError ("Can't compile the operator \"" + name + "\"");
+        }
+
+        void addOp (Compiled::OpCode code, int numInputs, int index = 0, double value = 0)
+        {
+            // if all the inputs are constants, the result can be worked out now
+            if (numInputs > 0 && lastOpsAreConstant (numInputs))
+            {
+                Compiled folded;
+
+                for (int i = ops.size() - numInputs; i < ops.size(); ++i)
+                    folded.ops.add (ops.getReference (i));
+
+                folded.ops.add ({ code, index, value });
+                removeLastOps (numInputs);
+                return addOp (Compiled::OpCode::pushConstant, 0, 0, folded.evaluate (nullptr));
+            }
+
+            ops.add ({ code, index, value });
+            depth += 1 - numInputs;
+
+            if (depth > Compiled::maxStackSize)
+                throw EvaluationError ("Expression is too deeply nested to compile");
+        }
+
+        bool lastOpsAreConstant (int num) const noexcept
+        {
+            if (num > ops.size())
+                return false;
+
+            for (int i = ops.size() - num; i < ops.size(); ++i)
+                if (ops.getReference (i).code != Compiled::OpCode::pushConstant)
+                    return false;
+
+            return true;
+        }
+
+        void removeLastOps (int num)
+        {
+            ops.removeLast (num);
+            depth -= num;
+        }
+
+        static String getDottedName (const Term& t)
+        {
+            if (t.getType() == symbolType)
+                return t.getName();
+
+            if (t.getType() == operatorType && t.getName() == ".")
+            {
+                auto rhs = getDottedName (*t.getInput (1));
+
+                if (rhs.isNotEmpty())
+                    return t.getInput (0)->getName() + "." + rhs;
+            }
+
+            return {};
+        }
+
+        //==============================================================================
+        class RelativeScopeCompiler  : public Scope::Visitor
+        {
+        public:
+            RelativeScopeCompiler (Compiler& c, const Term& t, const String& prefix, int recursion)
+                : compiler (c), input (t), scopePrefix (prefix), recursionCount (recursion) {}
+
+            void visit (const Scope& scope)
+            {
+                compiler.compile (input, scope, scopePrefix, recursionCount);
+                wasVisited = true;
+            }
+
+            bool wasVisited = false;
+
+        private:
+            Compiler& compiler;
+            const Term& input;
+            const String scopePrefix;
+            const int recursionCount;
+
+            JUCE_DECLARE_NON_COPYABLE (RelativeScopeCompiler)
+        };
+
+        JUCE_DECLARE_NON_COPYABLE (Compiler)
+    };
 };
 
 //==============================================================================
@@ -1002,6 +1195,130 @@ double Expression::evaluate (const Scope& scope, String& evaluationError) const
     return 0;
 }
 
+//==============================================================================
+Expression::Compiled Expression::compile (const StringArray& symbolNames, const Scope& scope, String& compileError) const
+{
+    Compiled result;
+
+    try
+    {
+        Helpers::Compiler compiler (symbolNames, result.ops);
+        compiler.compile (*term, scope, {}, 0);
+        result.numSymbols = symbolNames.size();
+        return result;
+    }
+    catch (Helpers::EvaluationError& e)
+    {
+        compileError = e.description;
+    }
+
+    return {};
+}
+
+Expression::Compiled::Compiled() noexcept {}
+
+double Expression::Compiled::evaluate (const double* symbolValues) const noexcept
+{
+    double stack[maxStackSize];
+    int top = 0;
+
+    for (auto& op : ops)
+    {
+        switch (op.code)
+        {
+            case OpCode::pushConstant:  stack[top++] = op.value; break;
+            case OpCode::pushSymbol:    stack[top++] = symbolValues[op.index]; break;
+            case OpCode::add:           --top; stack[top - 1] += stack[top]; break;
+            case OpCode::subtract:      --top; stack[top - 1] -= stack[top]; break;
+            case OpCode::multiply:      --top; stack[top - 1] *= stack[top]; break;
+            case OpCode::divide:        --top; stack[top - 1] /= stack[top]; break;
+            case OpCode::negate:        stack[top - 1] = -stack[top - 1]; break;
+            case OpCode::sin:           stack[top - 1] = std::sin (stack[top - 1]); break;
+            case OpCode::cos:           stack[top - 1] = std::cos (stack[top - 1]); break;
+            case OpCode::tan:           stack[top - 1] = std::tan (stack[top - 1]); break;
+            case OpCode::abs:           stack[top - 1] = std::abs (stack[top - 1]); break;
+
+            case OpCode::min:
+            case OpCode::max:
+            {
+                top -= op.index - 1;
+                auto& v = stack[top - 1];
+
+                for (int i = 1; i < op.index; ++i)
+                    v = op.code == OpCode::min ? jmin (v, stack[top - 1 + i])
+                                               : jmax (v, stack[top - 1 + i]);
+                break;
+            }
+        }
+    }
+
+    return top > 0 ? stack[0] : 0.0;
+}
+
+template <typename FunctionType>
+static void applyToBlock (double* dest, const double* src, int num, FunctionType fn) noexcept
+{
+    for (int i = 0; i < num; ++i)
+        dest[i] = fn (dest[i], src[i]);
+}
+
+void Expression::Compiled::evaluate (const double* const* symbolValues, double* results, int numValues) const noexcept
+{
+    enum { blockSize = 16 };
+    double stack[maxStackSize][blockSize];
+
+    if (ops.isEmpty())
+    {
+        for (int i = 0; i < numValues; ++i)
+            results[i] = 0;
+
+        return;
+    }
+
+    for (int start = 0; start < numValues; start += blockSize)
+    {
+        auto num = jmin ((int) blockSize, numValues - start);
+        int top = 0;
+
+        for (auto& op : ops)
+        {
+            switch (op.code)
+            {
+                case OpCode::pushConstant:  std::fill (stack[top], stack[top] + num, op.value); ++top; break;
+                case OpCode::pushSymbol:    std::copy (symbolValues[op.index] + start, symbolValues[op.index] + start + num, stack[top]); ++top; break;
+                case OpCode::add:           --top; applyToBlock (stack[top - 1], stack[top], num, [] (double x, double y) { return x + y; }); break;
+                case OpCode::subtract:      --top; applyToBlock (stack[top - 1], stack[top], num, [] (double x, double y) { return x - y; }); break;
+                case OpCode::multiply:      --top; applyToBlock (stack[top - 1], stack[top], num, [] (double x, double y) { return x * y; }); break;
+                case OpCode::divide:        --top; applyToBlock (stack[top - 1], stack[top], num, [] (double x, double y) { return x / y; }); break;
+                case OpCode::negate:        applyToBlock (stack[top - 1], stack[top - 1], num, [] (double x, double) { return -x; }); break;
+                case OpCode::sin:           applyToBlock (stack[top - 1], stack[top - 1], num, [] (double x, double) { return std::sin (x); }); break;
+                case OpCode::cos:           applyToBlock (stack[top - 1], stack[top - 1], num, [] (double x, double) { return std::cos (x); }); break;
+                case OpCode::tan:           applyToBlock (stack[top - 1], stack[top - 1], num, [] (double x, double) { return std::tan (x); }); break;
+                case OpCode::abs:           applyToBlock (stack[top - 1], stack[top - 1], num, [] (double x, double) { return std::abs (x); }); break;
+
+                case OpCode::min:
+                case OpCode::max:
+                {
+                    top -= op.index - 1;
+
+                    for (int i = 1; i < op.index; ++i)
+                    {
+                        if (op.code == OpCode::min)
+                            applyToBlock (stack[top - 1], stack[top - 1 + i], num, [] (double x, double y) { return jmin (x, y); });
+                        else
+                            applyToBlock (stack[top - 1], stack[top - 1 + i], num, [] (double x, double y) { return jmax (x, y); });
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        for (int i = 0; i < num; ++i)
+            results[start + i] = stack[0][i];
+    }
+}
+
 Expression Expression::operator+ (const Expression& other) const  { return Expression (new Helpers::Add (term, other.term)); }
 Expression Expression::operator- (const Expression& other) const  { return Expression (new Helpers::Subtract (term, other.term)); }
 Expression Expression::operator* (const Expression& other) const  { return Expression (new Helpers::Multiply (term, other.term)); }
@@ -1168,4 +1485,103 @@ String Expression::Scope::getScopeUID() const
     return {};
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ExpressionTests  : public UnitTest
+{
+public:
+    ExpressionTests() : UnitTest ("Expression", "Maths") {}
+
+    struct TestScope  : public Expression::Scope
+    {
+        Expression getSymbolValue (const String& symbol) const override
+        {
+            if (symbol == "x")      return Expression (x);
+            if (symbol == "y")      return Expression (y);
+            if (symbol == "twoX")   return Expression (Expression::symbol ("x") * Expression (2.0));
+            if (symbol == "four")   return Expression (Expression (2.0) + Expression (2.0));
+
+            return Expression::Scope::getSymbolValue (symbol);
+        }
+
+        double evaluateFunction (const String& functionName, const double* parameters, int numParams) const override
+        {
+            if (functionName == "half" && numParams == 1)
+                return parameters[0] * 0.5;
+
+            return Expression::Scope::evaluateFunction (functionName, parameters, numParams);
+        }
+
+        double x = 0, y = 0;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Compiled evaluation");
+
+        const char* const expressions[] = { "1 + 2 * 3", "x", "-x", "x + y * 2", "(x - y) / (y + 10)",
+                                            "twoX * four", "half (8) + x", "min (x, y, 3) + max (x, -y)",
+                                            "sin (x) * cos (y) + tan (x * 0.1) - abs (y)", "-(x / -(y + 100))" };
+
+        TestScope scope;
+        StringArray symbolNames ("x", "y");
+        auto r = getRandom();
+
+        for (auto* text : expressions)
+        {
+            String error;
+            Expression e (text, error);
+            expect (error.isEmpty());
+
+            auto compiled = e.compile (symbolNames, scope, error);
+            expect (error.isEmpty());
+            expectEquals (compiled.getNumSymbols(), 2);
+
+            double xs[37], ys[37], results[37];
+            const double* values[] = { xs, ys };
+
+            for (int i = 0; i < 37; ++i)
+            {
+                xs[i] = r.nextDouble() * 20.0 - 10.0;
+                ys[i] = r.nextDouble() * 20.0 - 10.0;
+            }
+
+            compiled.evaluate (values, results, 37);
+
+            for (int i = 0; i < 37; ++i)
+            {
+                scope.x = xs[i];
+                scope.y = ys[i];
+                const double args[] = { xs[i], ys[i] };
+
+                auto expected = e.evaluate (scope);
+                expectWithinAbsoluteError (compiled.evaluate (args), expected, 1.0e-12);
+                expectWithinAbsoluteError (results[i], expected, 1.0e-12);
+            }
+        }
+
+        beginTest ("Compiling errors and constant folding");
+        {
+            String error;
+            auto compiled = Expression ("x + unknown", error).compile (symbolNames, scope, error);
+            expect (error.isNotEmpty());
+            expectEquals (compiled.evaluate (nullptr), 0.0);
+
+            error.clear();
+            Expression ("half (x)", error).compile (symbolNames, scope, error);
+            expect (error.isNotEmpty());
+
+            error.clear();
+            compiled = Expression ("four * half (3) - min (1, 2)", error).compile ({}, scope, error);
+            expect (error.isEmpty());
+            expectEquals (compiled.evaluate (nullptr), 5.0);
+        }
+    }
+};
+
+static ExpressionTests expressionTests;
+
+#endif
+
 } // namespace juce
@@ -170,6 +170,87 @@ public:
     */
     double evaluate (const Scope& scope, String& evaluationError) const;
 
+    //==============================================================================
+    /** A flattened version of an Expression, which can be evaluated very quickly.
+
+        Each time an Expression is evaluated, it has to walk its tree of terms and ask the
+        Scope for the value of every symbol by name. If you need to evaluate the same
+        expression over and over again with different values, use Expression::compile()
+        to create one of these instead. It binds each symbol to a position in an array of
+        values once, and then evaluates a flat list of operations without any allocation,
+        locking or string comparisons, so it's suitable for use on the audio thread.
+
+        @see Expression::compile
+    */
+    class JUCE_API  Compiled
+    {
+    public:
+        /** Creates an empty object, which evaluates to 0. */
+        Compiled() noexcept;
+
+        /** Evaluates the expression.
+
+            The array must contain a value for each of the symbol names that were passed to
+            Expression::compile(), in the same order.
+        */
+        double evaluate (const double* symbolValues) const noexcept;
+
+        /** Evaluates the expression for a whole block of different symbol values.
+
+            The symbolValues parameter must contain an array of numValues values for each of
+            the symbol names that were passed to Expression::compile(), in the same order, and
+            one result for each set of values will be written to the results array.
+
+            This works through many values at a time, which makes it much quicker than calling
+            the other evaluate() method in a loop, and lets the compiler vectorise most of
+            the arithmetic.
+        */
+        void evaluate (const double* const* symbolValues, double* results, int numValues) const noexcept;
+
+        /** Returns the number of symbol values that the evaluate() methods expect. */
+        int getNumSymbols() const noexcept          { return numSymbols; }
+
+        /** The deepest level of nesting that an expression can have and still be compiled. */
+        enum { maxStackSize = 32 };
+
+    private:
+        enum class OpCode : uint8
+        {
+            pushConstant, pushSymbol, add, subtract, multiply, divide, negate,
+            min, max, sin, cos, tan, abs
+        };
+
+        struct Op
+        {
+            OpCode code;
+            int index;      // the symbol index, or number of parameters for min/max
+            double value;
+        };
+
+        Array<Op> ops;
+        int numSymbols = 0;
+
+        friend class Expression;
+    };
+
+    /** Compiles this expression so that it can be evaluated quickly, many times over.
+
+        Each of the names in symbolNames is bound to the value at the same index in the array
+        that you give to Compiled::evaluate(). Dotted names such as "foo.bar" can also be bound
+        this way. Any other symbols are looked up in the scope once, now, so if they refer to
+        other expressions, these will be compiled in-line, and any parts of the expression
+        which only involve constants get reduced to a single value.
+
+        Calls to min, max, sin, cos, tan and abs are compiled to the built-in versions of these
+        functions (so if the scope overrides them, they'll only behave the same for constant
+        parameters). Any other functions are called on the scope now, so can only be used if
+        all of their parameters are constants.
+
+        If the expression can't be compiled, this sets the compileError string and returns
+        an empty Compiled object.
+    */
+    Compiled compile (const StringArray& symbolNames, const Scope& scope, String& compileError) const;
+
     /** Attempts to return an expression which is a copy of this one, but with a constant adjusted
         to make the expression resolve to a target value.
 
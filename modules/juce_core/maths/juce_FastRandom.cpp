@@ -0,0 +1,233 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+FastRandom::FastRandom (uint64 seedValue) noexcept
+{
+    setSeed (seedValue);
+}
+
+FastRandom::FastRandom() noexcept
+{
+    static std::atomic<uint64> counter { 0 };
+
+    setSeed ((uint64) Time::getHighResolutionTicks()
+               ^ ((uint64) (pointer_sized_int) Thread::getCurrentThreadId() << 16)
+               ^ (uint64) (pointer_sized_int) this
+               ^ (++counter * 0x9e3779b97f4a7c15ULL));
+}
+
+void FastRandom::setSeed (uint64 newSeed) noexcept
+{
+    // splitmix64 spreads the seed out over all of the state, as recommended by the
+    // authors of xoshiro
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        for (int i = 0; i < 4; i += 2)
+        {
+            auto z = (newSeed += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            z ^= (z >> 31);
+
+            state[i][lane]     = (uint32) z;
+            state[i + 1][lane] = (uint32) (z >> 32);
+        }
+
+        // an all-zero state would only ever produce zeros
+        if ((state[0][lane] | state[1][lane] | state[2][lane] | state[3][lane]) == 0)
+            state[0][lane] = 1;
+    }
+}
+
+void FastRandom::fillFloats (float* dest, int numValues, float minValue, float maxValue) noexcept
+{
+    jassert (dest != nullptr || numValues == 0);
+
+    auto scale = (maxValue - minValue) * (1.0f / 16777216.0f);
+
+    uint32 s0[numLanes], s1[numLanes], s2[numLanes], s3[numLanes];
+    std::copy (state[0], state[0] + numLanes, s0);
+    std::copy (state[1], state[1] + numLanes, s1);
+    std::copy (state[2], state[2] + numLanes, s2);
+    std::copy (state[3], state[3] + numLanes, s3);
+
+    // These loops over the lanes are simple enough for the compiler to turn into SIMD code
+    for (; numValues >= numLanes; numValues -= numLanes, dest += numLanes)
+    {
+        for (int i = 0; i < numLanes; ++i)
+        {
+            auto result = s0[i] + s3[i];
+            auto t = s1[i] << 9;
+
+            s2[i] ^= s0[i];
+            s3[i] ^= s1[i];
+            s1[i] ^= s2[i];
+            s0[i] ^= s3[i];
+            s2[i] ^= t;
+            s3[i] = (s3[i] << 11) | (s3[i] >> 21);
+
+            dest[i] = minValue + scale * (float) (result >> 8);
+        }
+    }
+
+    std::copy (s0, s0 + numLanes, state[0]);
+    std::copy (s1, s1 + numLanes, state[1]);
+    std::copy (s2, s2 + numLanes, state[2]);
+    std::copy (s3, s3 + numLanes, state[3]);
+
+    for (int i = 0; i < numValues; ++i)
+        dest[i] = minValue + scale * (float) (nextUint32() >> 8);
+}
+
+void FastRandom::fillGaussian (float* dest, int numValues, float mean, float standardDeviation) noexcept
+{
+    jassert (dest != nullptr || numValues == 0);
+
+    // The Box-Muller transform turns each pair of uniform values into a pair of normal ones
+    auto numPairs = numValues / 2;
+    fillFloats (dest, numPairs * 2);
+
+    for (int i = 0; i < numPairs; ++i)
+    {
+        auto* pair = dest + i * 2;
+        auto radius = standardDeviation * std::sqrt (-2.0f * std::log (1.0f - pair[0]));
+        auto angle = MathConstants<float>::twoPi * pair[1];
+
+        pair[0] = mean + radius * std::cos (angle);
+        pair[1] = mean + radius * std::sin (angle);
+    }
+
+    if ((numValues & 1) != 0)
+    {
+        auto radius = standardDeviation * std::sqrt (-2.0f * std::log (1.0f - nextFloat()));
+        dest[numValues - 1] = mean + radius * std::cos (MathConstants<float>::twoPi * nextFloat());
+    }
+}
+
+FastRandom& FastRandom::getForCurrentThread() noexcept
+{
+    static ThreadLocalValue<FastRandom> instances;
+    return instances.get();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FastRandomTests  : public UnitTest
+{
+public:
+    FastRandomTests() : UnitTest ("FastRandom", "Maths") {}
+
+    void runTest() override
+    {
+        beginTest ("Seeding");
+        {
+            FastRandom r1 (1234), r2 (1234), r3 (1235);
+            bool allSame = true, anyDifferent = false;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto v = r1.nextUint32();
+                allSame = allSame && v == r2.nextUint32();
+                anyDifferent = anyDifferent || v != r3.nextUint32();
+            }
+
+            expect (allSame);
+            expect (anyDifferent);
+        }
+
+        beginTest ("Uniform values");
+        {
+            FastRandom r (getRandom().nextInt64());
+            HeapBlock<float> values (10003);
+
+            for (auto range : { Range<float> (0.0f, 1.0f), Range<float> (-1.0f, 1.0f), Range<float> (10.0f, 20.0f) })
+            {
+                r.fillFloats (values, 10003, range.getStart(), range.getEnd());
+
+                StatisticsAccumulator<double> stats;
+                bool allInRange = true;
+
+                for (int i = 0; i < 10003; ++i)
+                {
+                    allInRange = allInRange && values[i] >= range.getStart() && values[i] < range.getEnd();
+                    stats.addValue (values[i]);
+                }
+
+                expect (allInRange);
+                expectWithinAbsoluteError (stats.getAverage(), (double) range.getStart() + range.getLength() * 0.5, range.getLength() * 0.02);
+                expectWithinAbsoluteError (stats.getStandardDeviation(), range.getLength() / std::sqrt (12.0), range.getLength() * 0.02);
+            }
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto v = r.nextFloat();
+                expect (v >= 0.0f && v < 1.0f);
+            }
+        }
+
+        beginTest ("Gaussian values");
+        {
+            FastRandom r (getRandom().nextInt64());
+            HeapBlock<float> values (20001);
+            r.fillGaussian (values, 20001, 3.0f, 2.0f);
+
+            StatisticsAccumulator<double> stats;
+
+            for (int i = 0; i < 20001; ++i)
+                stats.addValue (values[i]);
+
+            expectWithinAbsoluteError (stats.getAverage(), 3.0, 0.1);
+            expectWithinAbsoluteError (stats.getStandardDeviation(), 2.0, 0.1);
+        }
+
+        beginTest ("Per-thread instances");
+        {
+            auto& instance = FastRandom::getForCurrentThread();
+            expect (&instance == &FastRandom::getForCurrentThread());
+
+            FastRandom* otherInstance = nullptr;
+
+            struct TestThread  : public Thread
+            {
+                TestThread (FastRandom*& r) : Thread ("FastRandom test"), result (r) {}
+                void run() override    { result = &FastRandom::getForCurrentThread(); result->nextFloat(); }
+                FastRandom*& result;
+            };
+
+            TestThread thread (otherInstance);
+            thread.startThread();
+            thread.waitForThreadToExit (-1);
+
+            expect (otherInstance != nullptr && otherInstance != &instance);
+        }
+    }
+};
+
+static FastRandomTests fastRandomTests;
+
+#endif
+
+} // namespace juce
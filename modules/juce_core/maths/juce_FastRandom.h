@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast random number generator, for when large quantities of random values are needed.
+
+    This uses the xoshiro128+ algorithm, which is both quicker and statistically much
+    better than the linear congruential generator used by the Random class. Its bulk
+    methods, like fillFloats() and fillGaussian(), run several independent generators
+    side by side so that the compiler can vectorise them, which makes it suitable for
+    generating noise or dither one buffer at a time.
+
+    Random is still the class to use where a sequence needs to match one that has been
+    generated before, as its algorithm is relied on by existing code and data.
+
+    Like Random, a FastRandom object isn't thread-safe. Either give each thread its own
+    object, or use getForCurrentThread().
+
+    @see Random
+
+    @tags{Core}
+*/
+class JUCE_API  FastRandom  final
+{
+public:
+    //==============================================================================
+    /** Creates a FastRandom object based on a seed value.
+        For a given seed value, the subsequent numbers generated by this object will
+        always be the same.
+    */
+    explicit FastRandom (uint64 seedValue) noexcept;
+
+    /** Creates a FastRandom object using an unpredictable seed value. */
+    FastRandom() noexcept;
+
+    /** Resets this object to a given seed value. */
+    void setSeed (uint64 newSeed) noexcept;
+
+    //==============================================================================
+    /** Returns the next random 32-bit value. */
+    uint32 nextUint32() noexcept
+    {
+        auto result = state[0][0] + state[3][0];
+        auto t = state[1][0] << 9;
+
+        state[2][0] ^= state[0][0];
+        state[3][0] ^= state[1][0];
+        state[1][0] ^= state[2][0];
+        state[0][0] ^= state[3][0];
+        state[2][0] ^= t;
+        state[3][0] = (state[3][0] << 11) | (state[3][0] >> 21);
+
+        return result;
+    }
+
+    /** Returns the next random floating-point number.
+        @returns a random value in the range 0 (inclusive) to 1.0 (exclusive)
+    */
+    float nextFloat() noexcept                 { return (float) (nextUint32() >> 8) * (1.0f / 16777216.0f); }
+
+    /** Fills a buffer with random values, evenly distributed between minValue (inclusive)
+        and maxValue (exclusive).
+    */
+    void fillFloats (float* dest, int numValues, float minValue = 0.0f, float maxValue = 1.0f) noexcept;
+
+    /** Fills a buffer with random values that have a normal (Gaussian) distribution. */
+    void fillGaussian (float* dest, int numValues, float mean = 0.0f, float standardDeviation = 1.0f) noexcept;
+
+    //==============================================================================
+    /** Returns an object that belongs to the calling thread.
+        Each thread gets its own object, with its own unpredictable seed, so this can
+        safely be used from any thread without any locking.
+    */
+    static FastRandom& getForCurrentThread() noexcept;
+
+private:
+    //==============================================================================
+    enum { numLanes = 8 };
+
+    // Each of the independent generators used by the bulk methods is one lane of these
+    // arrays, and the single-value methods use the first one
+    uint32 state[4][numLanes];
+};
+
+} // namespace juce
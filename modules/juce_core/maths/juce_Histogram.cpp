@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+Histogram::Histogram (double lowestValue, double highestValue, int numSubBucketsPerOctave)
+    : lowest (lowestValue), highest (highestValue),
+      numSubBuckets (jmax (1, numSubBucketsPerOctave)),
+      minimum (std::numeric_limits<double>::infinity()),
+      maximum (-std::numeric_limits<double>::infinity())
+{
+    // The range must be positive, as the buckets are spaced logarithmically
+    jassert (lowestValue > 0 && highestValue > lowestValue);
+
+    // The top octave only needs enough sub-buckets to reach the highest value
+    numOctaves = jmax (1, (int) std::ceil (std::log2 (highest / lowest)));
+    auto topOctaveStart = std::ldexp (lowest, numOctaves - 1);
+    auto numTopSubBuckets = jlimit (1, numSubBuckets, (int) std::ceil ((highest / topOctaveStart - 1.0) * numSubBuckets));
+
+    numBuckets = (numOctaves - 1) * numSubBuckets + numTopSubBuckets + 2;
+    counts.reset (new std::atomic<uint64>[(size_t) numBuckets]);
+    reset();
+}
+
+Histogram::Histogram (const Histogram& other)
+    : Histogram (other.lowest, other.highest, other.numSubBuckets)
+{
+    merge (other);
+}
+
+Histogram& Histogram::operator= (const Histogram& other)
+{
+    if (this != &other)
+    {
+        reset();
+        merge (other);
+    }
+
+    return *this;
+}
+
+Histogram::~Histogram() {}
+
+//==============================================================================
+int Histogram::getBucketIndex (double value) const noexcept
+{
+    if (! (value >= lowest))  // (this also catches NaNs)
+        return 0;
+
+    // frexp splits the value into a mantissa in [0.5, 1) and an exponent, which give
+    // the position within the octave and the octave
+    int exponent;
+    auto mantissa = std::frexp (value / lowest, &exponent);
+    auto octave = exponent - 1;
+
+    if (octave >= numOctaves || value >= highest)
+        return numBuckets - 1;
+
+    auto subBucket = jmin (numSubBuckets - 1, (int) ((mantissa * 2.0 - 1.0) * numSubBuckets));
+    return jmin (numBuckets - 2, 1 + octave * numSubBuckets + subBucket);
+}
+
+Range<double> Histogram::getBucketRange (int bucketIndex) const noexcept
+{
+    if (bucketIndex <= 0)
+        return { 0.0, lowest };
+
+    if (bucketIndex >= numBuckets - 1)
+        return { highest, std::numeric_limits<double>::infinity() };
+
+    auto octave = (bucketIndex - 1) / numSubBuckets;
+    auto subBucket = (bucketIndex - 1) % numSubBuckets;
+    auto octaveStart = std::ldexp (lowest, octave);
+
+    return { octaveStart * (1.0 + subBucket / (double) numSubBuckets),
+             jmin (highest, octaveStart * (1.0 + (subBucket + 1) / (double) numSubBuckets)) };
+}
+
+uint64 Histogram::getBucketCount (int bucketIndex) const noexcept
+{
+    return isPositiveAndBelow (bucketIndex, numBuckets) ? counts[(size_t) bucketIndex].load (std::memory_order_relaxed) : 0;
+}
+
+//==============================================================================
+void Histogram::addValue (double value) noexcept
+{
+    counts[(size_t) getBucketIndex (value)].fetch_add (1, std::memory_order_relaxed);
+
+    for (auto current = minimum.load(); value < current && ! minimum.compare_exchange_weak (current, value);) {}
+    for (auto current = maximum.load(); value > current && ! maximum.compare_exchange_weak (current, value);) {}
+}
+
+void Histogram::merge (const Histogram& other) noexcept
+{
+    // The histograms must have the same layout to be merged!
+    jassert (other.numBuckets == numBuckets && other.lowest == lowest);
+
+    if (this == &other || other.numBuckets != numBuckets)
+        return;
+
+    for (int i = 0; i < numBuckets; ++i)
+        if (auto n = other.getBucketCount (i))
+            counts[(size_t) i].fetch_add (n, std::memory_order_relaxed);
+
+    auto otherMin = other.getMinValue(), otherMax = other.getMaxValue();
+
+    for (auto current = minimum.load(); otherMin < current && ! minimum.compare_exchange_weak (current, otherMin);) {}
+    for (auto current = maximum.load(); otherMax > current && ! maximum.compare_exchange_weak (current, otherMax);) {}
+}
+
+void Histogram::decay (double factor) noexcept
+{
+    jassert (factor >= 0.0 && factor <= 1.0);
+
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        auto& count = counts[(size_t) i];
+
+        for (auto current = count.load (std::memory_order_relaxed);
+             current != 0 && ! count.compare_exchange_weak (current, (uint64) ((double) current * factor), std::memory_order_relaxed);)
+        {}
+    }
+}
+
+void Histogram::reset() noexcept
+{
+    for (int i = 0; i < numBuckets; ++i)
+        counts[(size_t) i].store (0, std::memory_order_relaxed);
+
+    minimum = std::numeric_limits<double>::infinity();
+    maximum = -std::numeric_limits<double>::infinity();
+}
+
+//==============================================================================
+uint64 Histogram::getCount() const noexcept
+{
+    uint64 total = 0;
+
+    for (int i = 0; i < numBuckets; ++i)
+        total += getBucketCount (i);
+
+    return total;
+}
+
+double Histogram::getPercentile (double percentile) const noexcept
+{
+    jassert (percentile >= 0.0 && percentile <= 100.0);
+
+    // Take a snapshot of the counts, as other threads may still be adding to them
+    HeapBlock<uint64> snapshot ((size_t) numBuckets);
+    uint64 total = 0;
+
+    for (int i = 0; i < numBuckets; ++i)
+        total += (snapshot[i] = getBucketCount (i));
+
+    if (total == 0)
+        return 0.0;
+
+    auto targetRank = jlimit (0.0, 1.0, percentile / 100.0) * (double) total;
+    auto minValue = getMinValue(), maxValue = getMaxValue();
+    uint64 cumulative = 0;
+
+    for (int i = 0; i < numBuckets; ++i)
+    {
+        if (snapshot[i] == 0)
+            continue;
+
+        auto countBefore = cumulative;
+        cumulative += snapshot[i];
+
+        if ((double) cumulative >= targetRank)
+        {
+            if (i == 0)             return minValue;
+            if (i == numBuckets - 1) return maxValue;
+
+            // interpolate linearly across the bucket
+            auto range = getBucketRange (i);
+            auto proportion = (targetRank - (double) countBefore) / (double) snapshot[i];
+
+            return jlimit (minValue, maxValue, range.getStart() + range.getLength() * proportion);
+        }
+    }
+
+    return maxValue;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class HistogramTests  : public UnitTest
+{
+public:
+    HistogramTests() : UnitTest ("Histogram", "Maths") {}
+
+    void runTest() override
+    {
+        beginTest ("Percentiles");
+        {
+            Histogram h (1.0e-6, 10.0);
+            expectEquals (h.getPercentile (50), 0.0);
+
+            // a uniform distribution between 1ms and 2ms
+            for (int i = 0; i < 10000; ++i)
+                h.addValue (0.001 + i * 1.0e-7);
+
+            expect (h.getCount() == 10000);
+            expectEquals (h.getMinValue(), 0.001);
+            expectWithinAbsoluteError (h.getMaxValue(), 0.0019999, 1.0e-12);
+
+            for (auto p : { 1.0, 10.0, 50.0, 90.0, 99.0 })
+                expectWithinAbsoluteError (h.getPercentile (p), 0.001 + p * 1.0e-5, 0.001 * 0.04);
+
+            expectEquals (h.getPercentile (0), h.getMinValue());
+            expectEquals (h.getPercentile (100), h.getMaxValue());
+        }
+
+        beginTest ("Values out of range");
+        {
+            Histogram h (1.0, 100.0, 8);
+            h.addValue (0.5);
+            h.addValue (-3.0);
+            h.addValue (50.0);
+            h.addValue (1000.0);
+
+            expect (h.getBucketCount (0) == 2);
+            expect (h.getBucketCount (h.getNumBuckets() - 1) == 1);
+            expectEquals (h.getPercentile (0), -3.0);
+            expectEquals (h.getPercentile (100), 1000.0);
+
+            bool bucketsAreContiguous = true;
+
+            for (int i = 1; i < h.getNumBuckets(); ++i)
+                bucketsAreContiguous = bucketsAreContiguous && h.getBucketRange (i - 1).getEnd() == h.getBucketRange (i).getStart();
+
+            expect (bucketsAreContiguous);
+
+            for (int i = 1; i < h.getNumBuckets() - 1; ++i)
+            {
+                auto range = h.getBucketRange (i);
+                Histogram single (1.0, 100.0, 8);
+                single.addValue (range.getStart());
+                expect (single.getBucketCount (i) == 1);
+            }
+        }
+
+        beginTest ("Merging and decaying");
+        {
+            Histogram a (1.0, 1000.0), b (1.0, 1000.0);
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                a.addValue (10.0);
+                b.addValue (100.0);
+            }
+
+            a.merge (b);
+            expect (a.getCount() == 2000);
+            expectWithinAbsoluteError (a.getPercentile (25), 10.0, 0.5);
+            expectWithinAbsoluteError (a.getPercentile (75), 100.0, 5.0);
+
+            a.decay (0.5);
+            expect (a.getCount() == 1000);
+
+            Histogram copy (a);
+            expect (copy.getCount() == 1000);
+            expectEquals (copy.getMaxValue(), 100.0);
+
+            a.reset();
+            expect (a.getCount() == 0);
+            expect (copy.getCount() == 1000);
+        }
+
+        beginTest ("Adding from several threads");
+        {
+            Histogram h (1.0, 1.0e6);
+
+            struct TestThread  : public Thread
+            {
+                TestThread (Histogram& hist, int n) : Thread ("Histogram test"), histogram (hist), index (n) {}
+
+                void run() override
+                {
+                    for (int i = 1; i <= 10000; ++i)
+                        histogram.addValue (i * (index + 1));
+                }
+
+                Histogram& histogram;
+                int index;
+            };
+
+            OwnedArray<TestThread> threads;
+
+            for (int i = 0; i < 4; ++i)
+                threads.add (new TestThread (h, i))->startThread();
+
+            for (auto* t : threads)
+                t->waitForThreadToExit (-1);
+
+            expect (h.getCount() == 40000);
+            expectEquals (h.getMinValue(), 1.0);
+            expectEquals (h.getMaxValue(), 40000.0);
+        }
+    }
+};
+
+static HistogramTests histogramTests;
+
+#endif
+
+} // namespace juce
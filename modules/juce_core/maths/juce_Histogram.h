@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Counts how many values fall into a set of buckets, so that percentiles and
+    distributions can be measured from a stream of values without storing them.
+
+    The buckets are spaced logarithmically between the lowest and highest values
+    given to the constructor, with each octave split into a number of equal-sized
+    sub-buckets. That means the size of each bucket is always roughly proportional
+    to the values in it, so any percentile is accurate to within about
+    1 / numSubBucketsPerOctave of its value, whatever its magnitude. Values outside
+    the range are counted in an extra bucket at each end.
+
+    addValue() is wait-free and doesn't allocate, so it can be called from an audio
+    thread, and several threads can add values to the same Histogram at once. To keep
+    the threads completely separate you could also give each one its own Histogram
+    and use merge() to combine them.
+
+    @code
+    Histogram callbackTimes (1.0e-6, 1.0);   // from 1us to 1s
+
+    // on the audio thread...
+    callbackTimes.addValue (secondsTaken);
+
+    // on another thread...
+    DBG ("p50: " << callbackTimes.getPercentile (50) << ", p99: " << callbackTimes.getPercentile (99));
+    @endcode
+
+    @see StatisticsAccumulator
+
+    @tags{Core}
+*/
+class JUCE_API  Histogram
+{
+public:
+    //==============================================================================
+    /** Creates an empty histogram for positive values between lowestValue and highestValue.
+
+        More sub-buckets per octave make the results more accurate, at the expense of
+        memory and the time taken by the methods that scan all of the buckets.
+    */
+    Histogram (double lowestValue, double highestValue, int numSubBucketsPerOctave = 32);
+
+    /** Creates a copy of another histogram. */
+    Histogram (const Histogram&);
+
+    /** Copies the counts from another histogram, which must have the same range and number of buckets. */
+    Histogram& operator= (const Histogram&);
+
+    /** Destructor. */
+    ~Histogram();
+
+    //==============================================================================
+    /** Adds a value to the histogram.
+        This is wait-free, so it's safe to call from any thread, including the audio thread.
+    */
+    void addValue (double value) noexcept;
+
+    /** Adds all the counts from another histogram to this one.
+        The other histogram must have been created with the same range and number of
+        buckets. This doesn't need a lock, so values can be added to either histogram
+        while it's happening.
+    */
+    void merge (const Histogram& other) noexcept;
+
+    /** Scales all the counts by the given factor.
+
+        Calling this at regular intervals with a factor less than 1 gives an exponentially
+        decaying window, where older values gradually have less and less influence over
+        the percentiles. Because the counts are integers, buckets whose counts drop below 1
+        are emptied. The minimum and maximum values aren't affected.
+    */
+    void decay (double factor) noexcept;
+
+    /** Removes all the values from the histogram. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Returns the number of values that the histogram contains. */
+    uint64 getCount() const noexcept;
+
+    /** Returns the smallest value that has been added, or positive infinity if there aren't any. */
+    double getMinValue() const noexcept             { return minimum.load(); }
+
+    /** Returns the largest value that has been added, or negative infinity if there aren't any. */
+    double getMaxValue() const noexcept             { return maximum.load(); }
+
+    /** Returns an estimate of the value below which the given percentage of the values fall.
+        For example, getPercentile (50) returns the median and getPercentile (99) returns the
+        99th percentile. If the histogram is empty, this returns zero.
+    */
+    double getPercentile (double percentile) const noexcept;
+
+    //==============================================================================
+    /** Returns the total number of buckets, including the two that hold values outside
+        the histogram's range.
+    */
+    int getNumBuckets() const noexcept              { return numBuckets; }
+
+    /** Returns the range of values that fall into one of the buckets. */
+    Range<double> getBucketRange (int bucketIndex) const noexcept;
+
+    /** Returns the number of values in one of the buckets. */
+    uint64 getBucketCount (int bucketIndex) const noexcept;
+
+private:
+    //==============================================================================
+    double lowest, highest;
+    int numSubBuckets, numOctaves, numBuckets;
+    std::unique_ptr<std::atomic<uint64>[]> counts;
+    std::atomic<double> minimum, maximum;
+
+    int getBucketIndex (double value) const noexcept;
+
+    JUCE_LEAK_DETECTOR (Histogram)
+};
+
+} // namespace juce
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class RandomBenchmarks  : public Benchmark
+{
+public:
+    RandomBenchmarks()  : Benchmark ("Random", "Maths") {}
+
+    void runBenchmark() override
+    {
+        HeapBlock<float> buffer (numValues);
+        Random random (1);
+        FastRandom fastRandom (1);
+
+        measure ("Random::nextFloat, 1024 values", [&]
+        {
+            for (int i = 0; i < numValues; ++i)
+                buffer[i] = random.nextFloat();
+
+            doNotOptimiseAway (buffer[0]);
+        });
+
+        measure ("FastRandom::nextFloat, 1024 values", [&]
+        {
+            for (int i = 0; i < numValues; ++i)
+                buffer[i] = fastRandom.nextFloat();
+
+            doNotOptimiseAway (buffer[0]);
+        });
+
+        measure ("FastRandom::fillFloats, 1024 values", [&]
+        {
+            fastRandom.fillFloats (buffer, numValues, -1.0f, 1.0f);
+            doNotOptimiseAway (buffer[0]);
+        });
+
+        measure ("FastRandom::fillGaussian, 1024 values", [&]
+        {
+            fastRandom.fillGaussian (buffer, numValues);
+            doNotOptimiseAway (buffer[0]);
+        });
+    }
+
+private:
+    enum { numValues = 1024 };
+};
+
+static RandomBenchmarks randomBenchmarks;
+
+} // namespace juce
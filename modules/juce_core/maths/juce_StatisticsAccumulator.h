@@ -28,6 +28,11 @@ namespace juce
     A class that measures various statistics about a series of floating point
     values that it is given.
 
+    To measure percentiles or distributions without storing the values, use a
+    Histogram.
+
+    @see Histogram
+
     @tags{Core}
 */
 template <typename FloatType>
@@ -54,6 +59,20 @@ public:
         if (v < minimum) minimum = v;
     }
 
+    /** Adds all the values that another accumulator has been given to this one.
+        This lets separate threads each fill their own accumulator, with the results
+        being combined afterwards.
+    */
+    void merge (const StatisticsAccumulator& other) noexcept
+    {
+        sum += other.sum;
+        sumSquares += other.sumSquares;
+        count += other.count;
+
+        if (other.maximum > maximum) maximum = other.maximum;
+        if (other.minimum < minimum) minimum = other.minimum;
+    }
+
     /** Reset the accumulator.
         This will reset all currently saved statistcs.
     */
@@ -0,0 +1,324 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct MemoryArena::Block
+{
+    Block* previous;
+    size_t size, used;
+
+    char* getData() noexcept    { return reinterpret_cast<char*> (this + 1); }
+};
+
+struct MemoryArena::Destructor
+{
+    Destructor* previous;
+    void* object;
+    void (*destroy) (void*);
+};
+
+//==============================================================================
+MemoryArena::MemoryArena (size_t initialBlockSize)  : nextBlockSize (jmax ((size_t) 256, initialBlockSize))
+{
+}
+
+MemoryArena::~MemoryArena()
+{
+    destroyObjects();
+    freeBlocks();
+}
+
+void* MemoryArena::allocate (size_t numBytes, size_t alignment)
+{
+    jassert (isPowerOfTwo (alignment));
+
+    for (;;)
+    {
+        if (currentBlock != nullptr)
+        {
+            auto* data = currentBlock->getData();
+            auto address = (reinterpret_cast<pointer_sized_uint> (data + currentBlock->used) + (alignment - 1))
+                             & ~(pointer_sized_uint) (alignment - 1);
+            auto offset = (size_t) (address - reinterpret_cast<pointer_sized_uint> (data));
+
+            if (offset + numBytes <= currentBlock->size)
+            {
+                currentBlock->used = offset + numBytes;
+                return data + offset;
+            }
+        }
+
+        addBlock (numBytes + alignment);
+    }
+}
+
+void MemoryArena::reset()
+{
+    destroyObjects();
+
+    if (currentBlock == nullptr)
+        return;
+
+    if (currentBlock->previous != nullptr)
+    {
+        // Swap all the blocks for one that's big enough to hold everything, so that doing
+        // the same job again won't need any more allocations
+        auto totalSize = getNumBytesAllocated();
+        freeBlocks();
+        addBlock (totalSize);
+    }
+
+    currentBlock->used = 0;
+    bytesUsedInOlderBlocks = 0;
+}
+
+size_t MemoryArena::getNumBytesUsed() const noexcept
+{
+    return bytesUsedInOlderBlocks + (currentBlock != nullptr ? currentBlock->used : 0);
+}
+
+size_t MemoryArena::getNumBytesAllocated() const noexcept
+{
+    size_t total = 0;
+
+    for (auto* b = currentBlock; b != nullptr; b = b->previous)
+        total += b->size;
+
+    return total;
+}
+
+int MemoryArena::getNumBlocks() const noexcept
+{
+    int num = 0;
+
+    for (auto* b = currentBlock; b != nullptr; b = b->previous)
+        ++num;
+
+    return num;
+}
+
+void MemoryArena::addBlock (size_t minimumSize)
+{
+    auto size = jmax (nextBlockSize, minimumSize);
+    auto* block = reinterpret_cast<Block*> (new char [sizeof (Block) + size]);
+
+    block->previous = currentBlock;
+    block->size = size;
+    block->used = 0;
+
+    if (currentBlock != nullptr)
+        bytesUsedInOlderBlocks += currentBlock->used;
+
+    currentBlock = block;
+    nextBlockSize = size * 2;
+}
+
+void MemoryArena::addDestructor (void* object, void (*destroy) (void*))
+{
+    auto* d = allocateArray<Destructor> (1);
+    d->previous = lastDestructor;
+    d->object = object;
+    d->destroy = destroy;
+    lastDestructor = d;
+}
+
+void MemoryArena::destroyObjects() noexcept
+{
+    for (auto* d = lastDestructor; d != nullptr; d = d->previous)
+        d->destroy (d->object);
+
+    lastDestructor = nullptr;
+}
+
+void MemoryArena::freeBlocks() noexcept
+{
+    while (currentBlock != nullptr)
+    {
+        auto* previous = currentBlock->previous;
+        delete[] reinterpret_cast<char*> (currentBlock);
+        currentBlock = previous;
+    }
+
+    bytesUsedInOlderBlocks = 0;
+}
+
+//==============================================================================
+static ThreadLocalValue<MemoryArena*>& getCurrentArenasForThreads()
+{
+    static ThreadLocalValue<MemoryArena*> arenas;
+    return arenas;
+}
+
+MemoryArena::ScopedCurrentArena::ScopedCurrentArena (MemoryArena& arena) noexcept
+    : previous (getCurrentArena())
+{
+    getCurrentArenasForThreads().get() = &arena;
+}
+
+MemoryArena::ScopedCurrentArena::~ScopedCurrentArena() noexcept
+{
+    getCurrentArenasForThreads().get() = previous;
+}
+
+MemoryArena* MemoryArena::getCurrentArena() noexcept
+{
+    return getCurrentArenasForThreads().get();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MemoryArenaTests  : public UnitTest
+{
+public:
+    MemoryArenaTests() : UnitTest ("MemoryArena", "Containers") {}
+
+    void runTest() override
+    {
+        beginTest ("Allocations are aligned and don't overlap");
+        {
+            MemoryArena arena (1024);
+            Array<std::pair<char*, int>> blocks;
+            Random r (getRandom().nextInt64());
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto size = 1 + r.nextInt (100);
+                auto alignment = (size_t) 1 << r.nextInt (5);
+                auto* p = static_cast<char*> (arena.allocate ((size_t) size, alignment));
+
+                expect (((pointer_sized_uint) p & (alignment - 1)) == 0);
+                memset (p, i & 0xff, (size_t) size);
+                blocks.add ({ p, size });
+            }
+
+            bool allIntact = true;
+
+            for (int i = 0; i < blocks.size(); ++i)
+                for (int j = 0; j < blocks[i].second; ++j)
+                    allIntact = allIntact && blocks[i].first[j] == (char) (i & 0xff);
+
+            expect (allIntact);
+            expect (arena.getNumBlocks() > 1);
+        }
+
+        beginTest ("reset() merges the blocks");
+        {
+            MemoryArena arena (256);
+
+            for (int i = 0; i < 100; ++i)
+                arena.allocateArray<double> (10);
+
+            auto numBytesUsed = arena.getNumBytesUsed();
+            expect (numBytesUsed >= 100 * 10 * sizeof (double));
+            expect (arena.getNumBlocks() > 1);
+
+            arena.reset();
+            expectEquals (arena.getNumBlocks(), 1);
+            expectEquals ((int) arena.getNumBytesUsed(), 0);
+
+            for (int i = 0; i < 100; ++i)
+                arena.allocateArray<double> (10);
+
+            expectEquals (arena.getNumBlocks(), 1);
+        }
+
+        beginTest ("Objects are destroyed in reverse order");
+        {
+            Array<int> destroyed;
+
+            struct Tracker
+            {
+                Tracker (Array<int>& d, int i) : list (d), index (i) {}
+                ~Tracker()  { list.add (index); }
+
+                Array<int>& list;
+                int index;
+            };
+
+            {
+                MemoryArena arena;
+
+                for (int i = 0; i < 3; ++i)
+                    arena.create<Tracker> (destroyed, i);
+
+                arena.reset();
+                expect (destroyed == Array<int> ({ 2, 1, 0 }));
+
+                arena.create<String> ("a string that's long enough to be allocated");
+                arena.create<Tracker> (destroyed, 3);
+            }
+
+            expect (destroyed == Array<int> ({ 2, 1, 0, 3 }));
+        }
+
+        beginTest ("ArenaAllocator");
+        {
+            MemoryArena arena;
+
+            {
+                std::map<int, String, std::less<int>, ArenaAllocator<std::pair<const int, String>>> map { ArenaAllocator<int> (arena) };
+
+                for (int i = 0; i < 100; ++i)
+                    map[i] = String (i);
+
+                expectEquals (map[42], String ("42"));
+            }
+
+            expect (arena.getNumBytesUsed() > 0);
+            auto blocksBefore = arena.getNumBlocks();
+
+            std::vector<int, ArenaAllocator<int>> v { ArenaAllocator<int> (arena) };
+            v.reserve (10);
+            expectEquals (arena.getNumBlocks(), blocksBefore);
+        }
+
+        beginTest ("ScopedCurrentArena");
+        {
+            expect (MemoryArena::getCurrentArena() == nullptr);
+
+            MemoryArena a, b;
+
+            {
+                MemoryArena::ScopedCurrentArena s1 (a);
+                expect (MemoryArena::getCurrentArena() == &a);
+
+                {
+                    MemoryArena::ScopedCurrentArena s2 (b);
+                    expect (MemoryArena::getCurrentArena() == &b);
+                }
+
+                expect (MemoryArena::getCurrentArena() == &a);
+            }
+
+            expect (MemoryArena::getCurrentArena() == nullptr);
+        }
+    }
+};
+
+static MemoryArenaTests memoryArenaTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast allocator for objects that are all thrown away together.
+
+    Memory is handed out by bumping a pointer through large blocks, so each allocation
+    is just a few instructions and there's no per-object bookkeeping. Nothing is freed
+    individually: calling reset() (or deleting the arena) releases everything at once.
+
+    This suits code that builds up a temporary structure and then discards it, such as
+    a parser or the building of a render sequence. If the first block wasn't big enough,
+    reset() replaces all the blocks with a single one that would have held everything,
+    so when the same kind of work is repeated it only needs one allocation.
+
+    Objects made with create() will have their destructors called by reset(), in the
+    reverse order to that in which they were created. Raw memory from allocate() or
+    allocateArray() is never initialised or destroyed.
+
+    To use an arena with standard containers, see ArenaAllocator.
+
+    A MemoryArena isn't thread-safe: each thread that needs one should have its own. The
+    ScopedCurrentArena class lets a thread make an arena available to the code it calls.
+
+    @see ArenaAllocator, HeapBlock
+
+    @tags{Core}
+*/
+class JUCE_API  MemoryArena
+{
+public:
+    //==============================================================================
+    /** Creates an arena. No memory is allocated until the first allocation is made.
+        @param initialBlockSize     the size of the first block that will be allocated
+    */
+    explicit MemoryArena (size_t initialBlockSize = 16384);
+
+    /** Destructor. Destroys any objects that were made with create(), and frees all the memory. */
+    ~MemoryArena();
+
+    //==============================================================================
+    /** Returns a block of uninitialised memory, which stays valid until the arena is reset. */
+    void* allocate (size_t numBytes, size_t alignment = defaultAlignment);
+
+    /** Returns an uninitialised array of objects, like HeapBlock::malloc() would. */
+    template <typename ElementType>
+    ElementType* allocateArray (size_t numElements)
+    {
+        return static_cast<ElementType*> (allocate (numElements * sizeof (ElementType),
+                                                    jmax ((size_t) alignof (ElementType), (size_t) 1)));
+    }
+
+    /** Creates an object in the arena.
+        The object mustn't be deleted - its destructor will be called when the arena is reset.
+    */
+    template <typename ObjectType, typename... Args>
+    ObjectType* create (Args&&... args)
+    {
+        auto* object = new (allocateArray<ObjectType> (1)) ObjectType (std::forward<Args> (args)...);
+
+        if (! std::is_trivially_destructible<ObjectType>::value)
+            addDestructor (object, [] (void* o) { static_cast<ObjectType*> (o)->~ObjectType(); });
+
+        return object;
+    }
+
+    /** Destroys any objects made with create(), and makes all the memory available again.
+        Any pointers that the arena has returned become invalid.
+    */
+    void reset();
+
+    //==============================================================================
+    /** Returns the number of bytes that have been handed out since the last reset. */
+    size_t getNumBytesUsed() const noexcept;
+
+    /** Returns the total size of the blocks that the arena has allocated. */
+    size_t getNumBytesAllocated() const noexcept;
+
+    /** Returns the number of separate blocks that the arena is holding. */
+    int getNumBlocks() const noexcept;
+
+    //==============================================================================
+    /** Makes an arena the current one for this thread, for as long as this object exists.
+        Code that wants to use a temporary arena can call getCurrentArena() and fall back to
+        the normal allocator when it returns nullptr.
+    */
+    struct JUCE_API  ScopedCurrentArena
+    {
+        ScopedCurrentArena (MemoryArena&) noexcept;
+        ~ScopedCurrentArena() noexcept;
+
+    private:
+        MemoryArena* previous;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedCurrentArena)
+    };
+
+    /** Returns the arena that a ScopedCurrentArena made current on this thread, or nullptr. */
+    static MemoryArena* getCurrentArena() noexcept;
+
+    enum { defaultAlignment = 16 };
+
+private:
+    //==============================================================================
+    struct Block;
+    struct Destructor;
+
+    Block* currentBlock = nullptr;
+    Destructor* lastDestructor = nullptr;
+    size_t nextBlockSize, bytesUsedInOlderBlocks = 0;
+
+    void addBlock (size_t minimumSize);
+    void addDestructor (void* object, void (*destroy) (void*));
+    void destroyObjects() noexcept;
+    void freeBlocks() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (MemoryArena)
+};
+
+//==============================================================================
+/**
+    An allocator for the standard library containers, which takes its memory from a MemoryArena.
+
+    Deallocation does nothing, so the memory is only reclaimed when the arena is reset. This
+    is ideal when a container is filled and then thrown away, e.g.
+    @code
+    MemoryArena arena;
+    std::map<int, int, std::less<int>, ArenaAllocator<std::pair<const int, int>>> lookup { ArenaAllocator<int> (arena) };
+    @endcode
+
+    @see MemoryArena
+
+    @tags{Core}
+*/
+template <typename Type>
+struct ArenaAllocator
+{
+    using value_type = Type;
+
+    ArenaAllocator (MemoryArena& a) noexcept  : arena (&a) {}
+
+    template <typename OtherType>
+    ArenaAllocator (const ArenaAllocator<OtherType>& other) noexcept  : arena (other.arena) {}
+
+    template <typename OtherType>
+    struct rebind { using other = ArenaAllocator<OtherType>; };
+
+    Type* allocate (size_t num)                                     { return arena->allocateArray<Type> (num); }
+    void deallocate (Type*, size_t) noexcept                        {}
+
+    template <typename OtherType>
+    bool operator== (const ArenaAllocator<OtherType>& other) const noexcept    { return arena == other.arena; }
+
+    template <typename OtherType>
+    bool operator!= (const ArenaAllocator<OtherType>& other) const noexcept    { return arena != other.arena; }
+
+    MemoryArena* arena;
+};
+
+} // namespace juce
@@ -362,7 +362,20 @@ String MemoryBlock::toBase64Encoding() const
     d += initialLen;
     d.write ('.');
 
-    for (size_t i = 0; i < numChars; ++i)
+    // the bits are taken starting from the lowest bit of each byte, so each group of
+    // 3 bytes can be treated as a little-endian 24-bit value and turned into 4 characters
+    auto* source = static_cast<const uint8*> (getData());
+    size_t i = 0;
+
+    for (; i + 4 <= numChars; i += 4, source += 3)
+    {
+        auto bits = (uint32) source[0] | ((uint32) source[1] << 8) | ((uint32) source[2] << 16);
+
+        for (int j = 0; j < 4; ++j, bits >>= 6)
+            d.write ((juce_wchar) (uint8) base64EncodingTable[bits & 0x3f]);
+    }
+
+    for (; i < numChars; ++i)
         d.write ((juce_wchar) (uint8) base64EncodingTable[getBitRange (i * 6, 6)]);
 
     d.writeNull();
@@ -388,21 +401,40 @@ bool MemoryBlock::fromBase64Encoding (StringRef s)
     setSize ((size_t) numBytesNeeded, true);
 
     auto srcChars = dot + 1;
-    int pos = 0;
+    auto* dest = static_cast<uint8*> (getData());
+    auto* destEnd = dest + size;
+
+    // the block starts out cleared, so the bits can just be accumulated and written out a byte at a time
+    uint32 bits = 0;
+    int numBits = 0;
 
     for (;;)
     {
         auto c = (int) srcChars.getAndAdvance();
 
         if (c == 0)
+        {
+            if (numBits > 0 && dest < destEnd)
+                *dest = (uint8) bits;
+
             return true;
+        }
 
         c -= 43;
 
         if (isPositiveAndBelow (c, numElementsInArray (base64DecodingTable)))
         {
-            setBitRange ((size_t) pos, 6, base64DecodingTable[c]);
-            pos += 6;
+            bits |= (uint32) base64DecodingTable[c] << numBits;
+            numBits += 6;
+
+            if (numBits >= 8)
+            {
+                if (dest < destEnd)
+                    *dest++ = (uint8) bits;
+
+                bits >>= 8;
+                numBits -= 8;
+            }
         }
     }
 }
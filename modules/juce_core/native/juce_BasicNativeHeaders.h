@@ -82,6 +82,7 @@
  #include <sys/socket.h>
  #include <sys/sysctl.h>
  #include <sys/stat.h>
+ #include <sys/event.h>
  #include <sys/param.h>
  #include <sys/mount.h>
  #include <sys/utsname.h>
@@ -220,6 +221,8 @@
  #include <signal.h>
  #include <stddef.h>
  #include <sys/dir.h>
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
  #include <sys/file.h>
  #include <sys/ioctl.h>
  #include <sys/mman.h>
@@ -227,6 +230,7 @@
  #include <sys/ptrace.h>
  #include <sys/socket.h>
  #include <sys/stat.h>
+ #include <sys/syscall.h>
  #include <sys/sysinfo.h>
  #include <sys/time.h>
  #include <sys/types.h>
@@ -250,6 +254,7 @@
  #include <sched.h>
  #include <signal.h>
  #include <stddef.h>
+ #include <sys/event.h>
  #include <sys/file.h>
  #include <sys/ioctl.h>
  #include <sys/mman.h>
@@ -274,6 +279,8 @@
  #include <dlfcn.h>
  #include <sys/stat.h>
  #include <sys/statfs.h>
+ #include <sys/epoll.h>
+ #include <sys/eventfd.h>
  #include <sys/ptrace.h>
  #include <sys/sysinfo.h>
  #include <sys/mman.h>
@@ -41,6 +41,11 @@ struct CURLSymbols
     void (*curl_slist_free_all) (struct curl_slist *);
     curl_version_info_data* (*curl_version_info) (CURLversion);
 
+    // these are optional, and will be null if the library doesn't provide them
+    CURLSH* (*curl_share_init) (void) = nullptr;
+    CURLSHcode (*curl_share_setopt) (CURLSH*, CURLSHoption, ...) = nullptr;
+    CURLSHcode (*curl_share_cleanup) (CURLSH*) = nullptr;
+
     static std::unique_ptr<CURLSymbols> create()
     {
         std::unique_ptr<CURLSymbols> symbols (new CURLSymbols);
@@ -68,6 +73,16 @@ struct CURLSymbols
         JUCE_INIT_CURL_SYMBOL (curl_slist_free_all)
         JUCE_INIT_CURL_SYMBOL (curl_version_info)
 
+       #if JUCE_LOAD_CURL_SYMBOLS_LAZILY
+        symbols->loadSymbol (symbols->curl_share_init,    "curl_share_init");
+        symbols->loadSymbol (symbols->curl_share_setopt,  "curl_share_setopt");
+        symbols->loadSymbol (symbols->curl_share_cleanup, "curl_share_cleanup");
+       #else
+        symbols->curl_share_init    = ::curl_share_init;
+        symbols->curl_share_setopt  = ::curl_share_setopt;
+        symbols->curl_share_cleanup = ::curl_share_cleanup;
+       #endif
+
         return symbols;
     }
 
@@ -105,6 +120,73 @@ private:
    #endif
 };
 
+//==============================================================================
+/*  A share handle that all the requests use, so that open connections, DNS lookups
+    and TLS sessions are kept and reused by later requests to the same host, rather
+    than each request paying for a fresh handshake.
+*/
+struct CURLConnectionShare
+{
+    static CURLSH* get()
+    {
+        static CURLConnectionShare instance;
+        return instance.share;
+    }
+
+private:
+    CURLConnectionShare()
+    {
+        if (symbols == nullptr || symbols->curl_share_init == nullptr
+             || symbols->curl_share_setopt == nullptr || symbols->curl_share_cleanup == nullptr)
+            return;
+
+        {
+            const ScopedLock sl (CURLSymbols::getLibcurlLock());
+            share = symbols->curl_share_init();
+        }
+
+        if (share != nullptr)
+        {
+            symbols->curl_share_setopt (share, CURLSHOPT_LOCKFUNC, lockCallback);
+            symbols->curl_share_setopt (share, CURLSHOPT_UNLOCKFUNC, unlockCallback);
+            symbols->curl_share_setopt (share, CURLSHOPT_USERDATA, this);
+            symbols->curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            symbols->curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+           #if LIBCURL_VERSION_NUM >= 0x073900
+            // (an older library will refuse this, and just share its DNS and TLS session caches)
+            symbols->curl_share_setopt (share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+           #endif
+        }
+    }
+
+    ~CURLConnectionShare()
+    {
+        if (share != nullptr)
+            symbols->curl_share_cleanup (share);
+    }
+
+    static void lockCallback (CURL*, curl_lock_data data, curl_lock_access, void* userData)
+    {
+        static_cast<CURLConnectionShare*> (userData)->getLock (data).enter();
+    }
+
+    static void unlockCallback (CURL*, curl_lock_data data, void* userData)
+    {
+        static_cast<CURLConnectionShare*> (userData)->getLock (data).exit();
+    }
+
+    CriticalSection& getLock (curl_lock_data data) noexcept
+    {
+        return locks[jlimit (0, (int) numElementsInArray (locks) - 1, (int) data)];
+    }
+
+    std::unique_ptr<CURLSymbols> symbols { CURLSymbols::create() };
+    CURLSH* share = nullptr;
+    CriticalSection locks[CURL_LOCK_DATA_LAST];
+
+    JUCE_DECLARE_NON_COPYABLE (CURLConnectionShare)
+};
 
 //==============================================================================
 class WebInputStream::Pimpl
@@ -244,6 +326,15 @@ public:
             && symbols->curl_easy_setopt (curl, CURLOPT_USERAGENT, userAgent.toRawUTF8()) == CURLE_OK
             && symbols->curl_easy_setopt (curl, CURLOPT_FOLLOWLOCATION, (maxRedirects > 0 ? 1 : 0)) == CURLE_OK)
         {
+            if (auto* share = CURLConnectionShare::get())
+                symbols->curl_easy_setopt (curl, CURLOPT_SHARE, share);
+
+           #if LIBCURL_VERSION_NUM >= 0x072F00
+            // HTTP/2 lets a reused connection carry several requests at once. This is just a
+            // preference, so it's fine for a library built without HTTP/2 support to refuse it.
+            symbols->curl_easy_setopt (curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+           #endif
+
             if (isPost)
             {
                 if (symbols->curl_easy_setopt (curl, CURLOPT_READDATA, this) != CURLE_OK
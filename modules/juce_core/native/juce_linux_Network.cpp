@@ -66,6 +66,160 @@ bool JUCE_CALLTYPE Process::openEmailWithAttachments (const String& /* targetEma
 
 //==============================================================================
 #if ! JUCE_USE_CURL
+/*  Keeps hold of the sockets from finished keep-alive requests, so that later requests
+    to the same server can skip the connection handshake, and caches DNS lookups.
+*/
+struct HTTPConnectionPool
+{
+    static HTTPConnectionPool& getInstance()
+    {
+        static HTTPConnectionPool pool;
+        return pool;
+    }
+
+    struct Address
+    {
+        String key;
+        sockaddr_storage address;
+        socklen_t length;
+        int family;
+        uint32 timeFound;
+    };
+
+    // Returns a connected socket that was left idle by an earlier request, or -1 if there isn't one
+    int takeIdleSocket (const String& key)
+    {
+        const ScopedLock sl (lock);
+        auto now = Time::getMillisecondCounter();
+
+        for (int i = idleSockets.size(); --i >= 0;)
+        {
+            auto idle = idleSockets.getReference (i);
+
+            if (idle.key == key || now - idle.timeReleased > maxIdleTimeMs)
+            {
+                idleSockets.remove (i);
+
+                if (idle.key == key && now - idle.timeReleased <= maxIdleTimeMs && isStillOpen (idle.socketHandle))
+                    return idle.socketHandle;
+
+                closeSocket (idle.socketHandle);
+            }
+        }
+
+        return -1;
+    }
+
+    void releaseSocket (const String& key, int socketHandle)
+    {
+        const ScopedLock sl (lock);
+
+        if (idleSockets.size() >= maxIdleSockets)
+        {
+            closeSocket (idleSockets.getReference (0).socketHandle);
+            idleSockets.remove (0);
+        }
+
+        idleSockets.add ({ key, socketHandle, Time::getMillisecondCounter() });
+    }
+
+    bool lookUpAddress (const String& host, int port, Address& result)
+    {
+        auto key = host + ":" + String (port);
+        auto now = Time::getMillisecondCounter();
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto& a : addresses)
+            {
+                if (a.key == key && now - a.timeFound < addressCacheTimeMs)
+                {
+                    result = a;
+                    return true;
+                }
+            }
+        }
+
+        struct addrinfo hints;
+        zerostruct (hints);
+
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_NUMERICSERV;
+
+        struct addrinfo* info = nullptr;
+
+        if (getaddrinfo (host.toUTF8(), String (port).toUTF8(), &hints, &info) != 0 || info == nullptr)
+            return false;
+
+        result.key = key;
+        result.length = (socklen_t) jmin ((size_t) info->ai_addrlen, sizeof (result.address));
+        memcpy (&result.address, info->ai_addr, (size_t) result.length);
+        result.family = info->ai_family;
+        result.timeFound = now;
+        freeaddrinfo (info);
+
+        const ScopedLock sl (lock);
+        forgetAddressLocked (key);
+        addresses.add (result);
+        return true;
+    }
+
+    void forgetAddress (const String& key)
+    {
+        const ScopedLock sl (lock);
+        forgetAddressLocked (key);
+    }
+
+private:
+    HTTPConnectionPool() = default;
+
+    ~HTTPConnectionPool()
+    {
+        for (auto& idle : idleSockets)
+            closeSocket (idle.socketHandle);
+    }
+
+    void forgetAddressLocked (const String& key)
+    {
+        for (int i = addresses.size(); --i >= 0;)
+            if (addresses.getReference (i).key == key)
+                addresses.remove (i);
+    }
+
+    // An idle socket should have nothing to read - if it's readable, the server has closed it
+    static bool isStillOpen (int socketHandle)
+    {
+        char c;
+        auto result = recv (socketHandle, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+        return result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+    }
+
+    static void closeSocket (int socketHandle)
+    {
+        ::shutdown (socketHandle, SHUT_RDWR);
+        ::close (socketHandle);
+    }
+
+    struct IdleSocket
+    {
+        String key;
+        int socketHandle;
+        uint32 timeReleased;
+    };
+
+    static constexpr int maxIdleSockets = 16;
+    static constexpr uint32 maxIdleTimeMs = 30000, addressCacheTimeMs = 60000;
+
+    CriticalSection lock;
+    Array<IdleSocket> idleSockets;
+    Array<Address> addresses;
+
+    JUCE_DECLARE_NON_COPYABLE (HTTPConnectionPool)
+};
+
+//==============================================================================
 class WebInputStream::Pimpl
 {
 public:
@@ -194,6 +348,8 @@ public:
 
                 if (chunkSize == 0)
                 {
+                    // the trailers must be skipped to leave the connection ready for another request
+                    reachedEndOfBody = skipChunkTrailers();
                     finished = true;
                     return 0;
                 }
@@ -204,6 +360,17 @@ public:
             if (bytesToRead > chunkEnd - position)
                 bytesToRead = static_cast<int> (chunkEnd - position);
         }
+        else if (contentLength >= 0 && ! isChunked)
+        {
+            // on a kept-alive connection, reading past the body would just wait for the timeout
+            if (position >= contentLength)
+            {
+                finished = reachedEndOfBody = true;
+                return 0;
+            }
+
+            bytesToRead = (int) jmin ((int64) bytesToRead, contentLength - position);
+        }
 
         fd_set readbits;
         FD_ZERO (&readbits);
@@ -216,6 +383,13 @@ public:
         if (select (socketHandle + 1, &readbits, 0, 0, &tv) <= 0)
             return 0;   // (timeout)
 
+       #ifdef TCP_QUICKACK
+        // a kept-alive connection would otherwise delay its ACKs, which can stall a server
+        // that writes its headers and body separately (this setting doesn't stick, so it's renewed)
+        int quickAck = 1;
+        setsockopt (socketHandle, IPPROTO_TCP, TCP_QUICKACK, &quickAck, sizeof (quickAck));
+       #endif
+
         const int bytesRead = jmax (0, (int) recv (socketHandle, buffer, (size_t) bytesToRead, MSG_WAITALL));
         if (bytesRead == 0)
             finished = true;
@@ -223,6 +397,9 @@ public:
         if (! readingChunk)
             position += bytesRead;
 
+        if (contentLength >= 0 && ! isChunked && position >= contentLength)
+            finished = reachedEndOfBody = true;
+
         return bytesRead;
     }
 
@@ -269,6 +446,8 @@ private:
     bool isChunked = false, readingChunk = false;
     CriticalSection closeSocketLock, createSocketLock;
     bool hasBeenCancelled = false;
+    String connectionKey;
+    bool canReuseConnection = false, reachedEndOfBody = false;
 
     void closeSocket (bool resetLevelsOfRedirection = true)
     {
@@ -276,11 +455,20 @@ private:
 
         if (socketHandle >= 0)
         {
-            ::shutdown (socketHandle, SHUT_RDWR);
-            ::close (socketHandle);
+            // if the whole response has been read, the connection can be used again
+            if (canReuseConnection && reachedEndOfBody && ! hasBeenCancelled)
+            {
+                HTTPConnectionPool::getInstance().releaseSocket (connectionKey, socketHandle);
+            }
+            else
+            {
+                ::shutdown (socketHandle, SHUT_RDWR);
+                ::close (socketHandle);
+            }
         }
 
         socketHandle = -1;
+        canReuseConnection = reachedEndOfBody = false;
 
         if (resetLevelsOfRedirection)
             levelsOfRedirection = 0;
@@ -327,59 +515,40 @@ private:
             port = hostPort;
         }
 
-        struct addrinfo hints;
-        zerostruct (hints);
+        contentLength = -1;
+        chunkEnd = 0;
+        isChunked = false;
+        finished = false;
+        connectionKey = serverName + ":" + String (port);
 
-        hints.ai_family = AF_UNSPEC;
-        hints.ai_socktype = SOCK_STREAM;
-        hints.ai_flags = AI_NUMERICSERV;
+        const MemoryBlock requestHeader (createRequestHeader (hostName, hostPort, proxyName, proxyPort, hostPath,
+                                                              address, headers, postData, isPost, httpRequestCmd));
+        String responseHeader;
 
-        struct addrinfo* result = nullptr;
-        if (getaddrinfo (serverName.toUTF8(), String (port).toUTF8(), &hints, &result) != 0 || result == 0)
-            return 0;
-
-        {
-            const ScopedLock lock (createSocketLock);
-
-            socketHandle = hasBeenCancelled ? -1
-                                            : socket (result->ai_family, result->ai_socktype, 0);
-        }
-
-        if (socketHandle == -1)
+        for (;;)
         {
-            freeaddrinfo (result);
-            return 0;
-        }
+            bool isReusedSocket = false;
 
-        int receiveBufferSize = 16384;
-        setsockopt (socketHandle, SOL_SOCKET, SO_RCVBUF, (char*) &receiveBufferSize, sizeof (receiveBufferSize));
-        setsockopt (socketHandle, SOL_SOCKET, SO_KEEPALIVE, 0, 0);
-
-      #if JUCE_MAC
-        setsockopt (socketHandle, SOL_SOCKET, SO_NOSIGPIPE, 0, 0);
-      #endif
+            if (! openSocket (serverName, port, isReusedSocket))
+                return 0;
 
-        if (::connect (socketHandle, result->ai_addr, result->ai_addrlen) == -1)
-        {
-            closeSocket();
-            freeaddrinfo (result);
-            return 0;
-        }
+            if (sendHeader (socketHandle, requestHeader, timeOutTime, owner, listener))
+            {
+                responseHeader = readResponse (timeOutTime);
 
-        freeaddrinfo (result);
+                if (responseHeader.isNotEmpty())
+                    break;
+            }
 
-        {
-            const MemoryBlock requestHeader (createRequestHeader (hostName, hostPort, proxyName, proxyPort, hostPath,
-                                                                  address, headers, postData, isPost, httpRequestCmd));
+            closeSocket (false);
 
-            if (! sendHeader (socketHandle, requestHeader, timeOutTime, owner, listener))
-            {
-                closeSocket();
+            // a kept-alive connection may have been closed by the server, so try again with a new one
+            if (! isReusedSocket)
                 return 0;
-            }
+
+            finished = false;
         }
 
-        String responseHeader (readResponse (timeOutTime));
         position = 0;
 
         if (responseHeader.isNotEmpty())
@@ -417,6 +586,17 @@ private:
 
             isChunked = (findHeaderItem (headerLines, "Transfer-Encoding:") == "chunked");
 
+            // (we only ask for keep-alive when the caller hasn't set their own Connection header)
+            auto connectionHeader = findHeaderItem (headerLines, "Connection:");
+
+            canReuseConnection = ! headers.containsIgnoreCase ("Connection:")
+                                   && ! connectionHeader.equalsIgnoreCase ("close")
+                                   && (responseHeader.startsWithIgnoreCase ("HTTP/1.1")
+                                        || connectionHeader.equalsIgnoreCase ("keep-alive"));
+
+            if (httpRequestCmd == "HEAD" || status == 204 || status == 304)
+                finished = reachedEndOfBody = true;
+
             return status;
         }
 
@@ -424,6 +604,86 @@ private:
         return 0;
     }
 
+    bool openSocket (const String& serverName, int port, bool& isReusedSocket)
+    {
+        auto& pool = HTTPConnectionPool::getInstance();
+
+        {
+            const ScopedLock lock (createSocketLock);
+
+            if (hasBeenCancelled)
+                return false;
+
+            socketHandle = pool.takeIdleSocket (connectionKey);
+        }
+
+        isReusedSocket = (socketHandle >= 0);
+
+        if (isReusedSocket)
+            return true;
+
+        HTTPConnectionPool::Address serverAddress;
+
+        if (! pool.lookUpAddress (serverName, port, serverAddress))
+            return false;
+
+        {
+            const ScopedLock lock (createSocketLock);
+
+            socketHandle = hasBeenCancelled ? -1
+                                            : socket (serverAddress.family, SOCK_STREAM, 0);
+        }
+
+        if (socketHandle == -1)
+            return false;
+
+        int receiveBufferSize = 16384;
+        setsockopt (socketHandle, SOL_SOCKET, SO_RCVBUF, (char*) &receiveBufferSize, sizeof (receiveBufferSize));
+        setsockopt (socketHandle, SOL_SOCKET, SO_KEEPALIVE, 0, 0);
+
+        // the request is written in pieces, which mustn't wait for each other to be acknowledged
+        int noDelay = 1;
+        setsockopt (socketHandle, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof (noDelay));
+
+      #if JUCE_MAC
+        setsockopt (socketHandle, SOL_SOCKET, SO_NOSIGPIPE, 0, 0);
+      #endif
+
+        if (::connect (socketHandle, (const sockaddr*) &serverAddress.address, serverAddress.length) == -1)
+        {
+            closeSocket();
+            pool.forgetAddress (connectionKey);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool skipChunkTrailers()
+    {
+        int lineLength = 0;
+
+        for (;;)
+        {
+            char c = 0;
+
+            if (read (&c, 1) != 1)
+                return false;
+
+            if (c == '\n')
+            {
+                if (lineLength == 0)
+                    return true;
+
+                lineLength = 0;
+            }
+            else if (c != '\r')
+            {
+                ++lineLength;
+            }
+        }
+    }
+
     //==============================================================================
     String readResponse (const uint32 timeOutTime)
     {
@@ -487,7 +747,7 @@ private:
         writeValueIfNotPresent (header, userHeaders, "User-Agent:", "JUCE/" JUCE_STRINGIFY(JUCE_MAJOR_VERSION)
                                                                         "." JUCE_STRINGIFY(JUCE_MINOR_VERSION)
                                                                         "." JUCE_STRINGIFY(JUCE_BUILDNUMBER));
-        writeValueIfNotPresent (header, userHeaders, "Connection:", "close");
+        writeValueIfNotPresent (header, userHeaders, "Connection:", "keep-alive");
 
         if (isPost)
             writeValueIfNotPresent (header, userHeaders, "Content-Length:", String ((int) postData.getSize()));
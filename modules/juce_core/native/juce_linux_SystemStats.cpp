@@ -162,6 +162,7 @@ void CPUInformation::initialise() noexcept
     hasAVX512VBMI      = flags.contains ("avx512vbmi");
     hasAVX512VL        = flags.contains ("avx512vl");
     hasAVX512VPOPCNTDQ = flags.contains ("avx512_vpopcntdq");
+    hasSHA             = flags.contains ("sha_ni");
 
     numLogicalCPUs  = getCpuInfo ("processor").getIntValue() + 1;
 
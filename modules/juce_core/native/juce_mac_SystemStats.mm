@@ -93,6 +93,7 @@ void CPUInformation::initialise() noexcept
     hasAVX512PF        = (b & (1u << 26)) != 0;
     hasAVX512ER        = (b & (1u << 27)) != 0;
     hasAVX512CD        = (b & (1u << 28)) != 0;
+    hasSHA             = (b & (1u << 29)) != 0;
     hasAVX512BW        = (b & (1u << 30)) != 0;
     hasAVX512VL        = (b & (1u << 31)) != 0;
     hasAVX512VBMI      = (c & (1u <<  1)) != 0;
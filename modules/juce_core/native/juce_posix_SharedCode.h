@@ -40,95 +40,6 @@ void CriticalSection::enter() const noexcept        { pthread_mutex_lock (&lock)
 bool CriticalSection::tryEnter() const noexcept     { return pthread_mutex_trylock (&lock) == 0; }
 void CriticalSection::exit() const noexcept         { pthread_mutex_unlock (&lock); }
 
-//==============================================================================
-WaitableEvent::WaitableEvent (bool useManualReset) noexcept
-    : triggered (false), manualReset (useManualReset)
-{
-    pthread_cond_init (&condition, {});
-
-    pthread_mutexattr_t atts;
-    pthread_mutexattr_init (&atts);
-   #if ! JUCE_ANDROID
-    pthread_mutexattr_setprotocol (&atts, PTHREAD_PRIO_INHERIT);
-   #endif
-    pthread_mutex_init (&mutex, &atts);
-    pthread_mutexattr_destroy (&atts);
-}
-
-WaitableEvent::~WaitableEvent() noexcept
-{
-    pthread_cond_destroy (&condition);
-    pthread_mutex_destroy (&mutex);
-}
-
-bool WaitableEvent::wait (int timeOutMillisecs) const noexcept
-{
-    pthread_mutex_lock (&mutex);
-
-    if (! triggered)
-    {
-        if (timeOutMillisecs < 0)
-        {
-            do
-            {
-                pthread_cond_wait (&condition, &mutex);
-            }
-            while (! triggered);
-        }
-        else
-        {
-            struct timeval now;
-            gettimeofday (&now, nullptr);
-
-            struct timespec time;
-            time.tv_sec  = now.tv_sec  + (timeOutMillisecs / 1000);
-            time.tv_nsec = (now.tv_usec + ((timeOutMillisecs % 1000) * 1000)) * 1000;
-
-            if (time.tv_nsec >= 1000000000)
-            {
-                time.tv_nsec -= 1000000000;
-                time.tv_sec++;
-            }
-
-            do
-            {
-                if (pthread_cond_timedwait (&condition, &mutex, &time) == ETIMEDOUT)
-                {
-                    pthread_mutex_unlock (&mutex);
-                    return false;
-                }
-            }
-            while (! triggered);
-        }
-    }
-
-    if (! manualReset)
-        triggered = false;
-
-    pthread_mutex_unlock (&mutex);
-    return true;
-}
-
-void WaitableEvent::signal() const noexcept
-{
-    pthread_mutex_lock (&mutex);
-
-    if (! triggered)
-    {
-        triggered = true;
-        pthread_cond_broadcast (&condition);
-    }
-
-    pthread_mutex_unlock (&mutex);
-}
-
-void WaitableEvent::reset() const noexcept
-{
-    pthread_mutex_lock (&mutex);
-    triggered = false;
-    pthread_mutex_unlock (&mutex);
-}
-
 //==============================================================================
 void JUCE_CALLTYPE Thread::sleep (int millisecs)
 {
@@ -509,6 +420,61 @@ size_t FileInputStream::readInternal (void* buffer, size_t numBytes)
     return (size_t) result;
 }
 
+size_t FileInputStream::readInternalAt (void* buffer, size_t numBytes, int64 filePosition)
+{
+    ssize_t result = 0;
+
+    if (fileHandle != nullptr)
+    {
+        result = ::pread (getFD (fileHandle), buffer, numBytes, (off_t) filePosition);
+
+        if (result < 0)
+        {
+            status = getResultForErrno();
+            result = 0;
+        }
+    }
+
+    return (size_t) result;
+}
+
+bool FileInputStream::setAccessPattern (AccessPattern pattern)
+{
+    if (fileHandle == nullptr)
+        return false;
+
+   #if JUCE_LINUX
+    auto advice = pattern == sequentialAccess ? POSIX_FADV_SEQUENTIAL
+                                              : (pattern == randomAccess ? POSIX_FADV_RANDOM : POSIX_FADV_NORMAL);
+
+    return posix_fadvise (getFD (fileHandle), 0, 0, advice) == 0;
+   #elif JUCE_MAC || JUCE_IOS
+    return fcntl (getFD (fileHandle), F_RDAHEAD, pattern == randomAccess ? 0 : 1) != -1;
+   #else
+    ignoreUnused (pattern);
+    return false;
+   #endif
+}
+
+bool FileInputStream::prefetch (Range<int64> fileRange)
+{
+    if (fileHandle == nullptr || fileRange.isEmpty() || fileRange.getStart() < 0)
+        return false;
+
+   #if JUCE_LINUX
+    return posix_fadvise (getFD (fileHandle), (off_t) fileRange.getStart(),
+                          (off_t) fileRange.getLength(), POSIX_FADV_WILLNEED) == 0;
+   #elif JUCE_MAC || JUCE_IOS
+    radvisory advice;
+    advice.ra_offset = (off_t) fileRange.getStart();
+    advice.ra_count = (int) jmin (fileRange.getLength(), (int64) std::numeric_limits<int>::max());
+
+    return fcntl (getFD (fileHandle), F_RDADVISE, &advice) != -1;
+   #else
+    return false;
+   #endif
+}
+
 //==============================================================================
 void FileOutputStream::openHandle()
 {
@@ -585,6 +551,38 @@ Result FileOutputStream::truncate()
     return getResultForReturnValue (ftruncate (getFD (fileHandle), (off_t) currentPosition));
 }
 
+Result FileOutputStream::preallocate (int64 totalSizeInBytes)
+{
+    if (fileHandle == nullptr)
+        return status;
+
+   #if JUCE_LINUX
+    return getResultForReturnValue (fallocate (getFD (fileHandle), FALLOC_FL_KEEP_SIZE, 0, (off_t) totalSizeInBytes));
+   #elif JUCE_MAC || JUCE_IOS
+    struct stat info;
+
+    if (fstat (getFD (fileHandle), &info) != 0)
+        return getResultForErrno();
+
+    auto numBytesNeeded = totalSizeInBytes - (int64) info.st_blocks * 512;
+
+    if (numBytesNeeded <= 0)
+        return Result::ok();
+
+    // try for a contiguous block first, but settle for any space if that's not available
+    fstore_t store = { F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0, (off_t) numBytesNeeded, 0 };
+
+    if (fcntl (getFD (fileHandle), F_PREALLOCATE, &store) != -1)
+        return Result::ok();
+
+    store.fst_flags = F_ALLOCATEALL;
+    return getResultForReturnValue (fcntl (getFD (fileHandle), F_PREALLOCATE, &store));
+   #else
+    ignoreUnused (totalSizeInBytes);
+    return Result::fail ("Preallocation isn't supported on this platform");
+   #endif
+}
+
 //==============================================================================
 String SystemStats::getEnvironmentVariable (const String& name, const String& defaultValue)
 {
@@ -629,6 +627,8 @@ void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exc
 
 MemoryMappedFile::~MemoryMappedFile()
 {
+    cancelTouchJobs();
+
     if (address != nullptr)
         munmap (address, (size_t) range.getLength());
 
@@ -636,6 +636,179 @@ MemoryMappedFile::~MemoryMappedFile()
         close (fileHandle);
 }
 
+bool MemoryMappedFile::setAccessPattern (AccessPattern pattern)
+{
+    auto advice = pattern == sequentialAccess ? MADV_SEQUENTIAL
+                                              : (pattern == randomAccess ? MADV_RANDOM : MADV_NORMAL);
+
+    return address != nullptr && madvise (address, (size_t) range.getLength(), advice) == 0;
+}
+
+bool MemoryMappedFile::prefetch (Range<int64> fileRange)
+{
+    void* start;
+    size_t numBytes;
+
+    return getPageAlignedRegion (fileRange, (int64) sysconf (_SC_PAGE_SIZE), start, numBytes)
+             && madvise (start, numBytes, MADV_WILLNEED) == 0;
+}
+
+bool MemoryMappedFile::lockRange (Range<int64> fileRange)
+{
+    void* start;
+    size_t numBytes;
+
+    return getPageAlignedRegion (fileRange, (int64) sysconf (_SC_PAGE_SIZE), start, numBytes)
+             && mlock (start, numBytes) == 0;
+}
+
+bool MemoryMappedFile::unlockRange (Range<int64> fileRange)
+{
+    void* start;
+    size_t numBytes;
+
+    return getPageAlignedRegion (fileRange, (int64) sysconf (_SC_PAGE_SIZE), start, numBytes)
+             && munlock (start, numBytes) == 0;
+}
+
+bool MemoryMappedFile::requestHugePages()
+{
+   #if JUCE_LINUX && defined (MADV_HUGEPAGE)
+    return address != nullptr && madvise (address, (size_t) range.getLength(), MADV_HUGEPAGE) == 0;
+   #else
+    return false;
+   #endif
+}
+
+//==============================================================================
+namespace DirectoryScannerHelpers
+{
+    using EntryCallback = std::function<bool (DirectoryScanner::Entry&, bool)>;
+
+   #if JUCE_LINUX
+    using StatStruct = struct stat64;
+    static int statAt (int dirFD, const char* name, StatStruct& s, int flags)   { return fstatat64 (dirFD, name, &s, flags); }
+   #else
+    using StatStruct = struct stat;
+    static int statAt (int dirFD, const char* name, StatStruct& s, int flags)   { return fstatat (dirFD, name, &s, flags); }
+   #endif
+
+   #if JUCE_MAC || JUCE_IOS
+    static int64 getCreationTimeMs (const StatStruct& s) noexcept    { return (int64) s.st_birthtime * 1000; }
+   #else
+    static int64 getCreationTimeMs (const StatStruct& s) noexcept    { return (int64) s.st_ctime * 1000; }
+   #endif
+
+    static bool handleEntry (DirectoryScanner::Entry& e, int dirFD, const char* name, unsigned char type,
+                             bool fetchInfo, const EntryCallback& callback)
+    {
+        if (name[0] == '.' && (name[1] == 0 || (name[1] == '.' && name[2] == 0)))
+            return true;
+
+        bool isLink = (type == DT_LNK);
+        e.isDirectory = (type == DT_DIR);
+        e.isHidden = (name[0] == '.');
+
+        // some filesystems don't fill-in the type, so it has to be found the slow way
+        if (type == DT_UNKNOWN)
+        {
+            StatStruct info;
+
+            if (statAt (dirFD, name, info, AT_SYMLINK_NOFOLLOW) == 0)
+            {
+                isLink = S_ISLNK (info.st_mode);
+                e.isDirectory = S_ISDIR (info.st_mode);
+            }
+        }
+
+        if (fetchInfo || isLink)
+        {
+            StatStruct info;
+            const bool statOk = statAt (dirFD, name, info, 0) == 0;
+
+            e.isDirectory = statOk && S_ISDIR (info.st_mode);
+
+            if (fetchInfo)
+            {
+                e.fileSize         = statOk ? (int64) info.st_size : 0;
+                e.modificationTime = Time (statOk ? (int64) info.st_mtime * 1000 : 0);
+                e.creationTime     = Time (statOk ? getCreationTimeMs (info) : 0);
+                e.isReadOnly       = faccessat (dirFD, name, W_OK, 0) != 0;
+
+               #if JUCE_MAC || JUCE_IOS
+                e.isHidden = e.isHidden || (statOk && (info.st_flags & UF_HIDDEN) != 0);
+               #endif
+            }
+        }
+
+        e.filename = CharPointer_UTF8 (name);
+
+       #if JUCE_MAC || JUCE_IOS
+        e.filename = e.filename.convertToPrecomposedUnicode();
+       #endif
+
+        return callback (e, isLink);
+    }
+}
+
+void DirectoryScanner::readEntries (const String& directoryWithSeparator, bool fetchInfo,
+                                    const std::function<bool (Entry&, bool)>& callback)
+{
+    Entry e;
+    e.directory = directoryWithSeparator;
+
+   #if JUCE_LINUX
+    // getdents64 fetches a whole buffer of entries per call, rather than going through readdir()
+    struct LinuxDirEnt64
+    {
+        ino64_t d_ino;
+        off64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[1];
+    };
+
+    auto fd = open (directoryWithSeparator.toUTF8(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+    if (fd < 0)
+        return;
+
+    const int bufferSize = 32768;
+    HeapBlock<char> buffer (bufferSize);
+
+    for (;;)
+    {
+        auto numBytes = (int) syscall (SYS_getdents64, fd, buffer.get(), bufferSize);
+
+        if (numBytes <= 0)
+            break;
+
+        for (int pos = 0; pos < numBytes;)
+        {
+            auto* d = reinterpret_cast<const LinuxDirEnt64*> (buffer + pos);
+            pos += d->d_reclen;
+
+            if (! DirectoryScannerHelpers::handleEntry (e, fd, d->d_name, d->d_type, fetchInfo, callback))
+            {
+                close (fd);
+                return;
+            }
+        }
+    }
+
+    close (fd);
+   #else
+    if (auto* dir = opendir (directoryWithSeparator.toUTF8()))
+    {
+        while (auto* de = readdir (dir))
+            if (! DirectoryScannerHelpers::handleEntry (e, dirfd (dir), de->d_name, de->d_type, fetchInfo, callback))
+                break;
+
+        closedir (dir);
+    }
+   #endif
+}
+
 //==============================================================================
 File juce_getExecutableFile();
 File juce_getExecutableFile()
@@ -1018,6 +1191,43 @@ bool Thread::setThreadPriority (void* handle, int priority)
     return pthread_setschedparam ((pthread_t) handle, policy, &param) == 0;
 }
 
+bool Thread::setCurrentThreadRealtimeScheduling (const RealtimeOptions& options)
+{
+   #if JUCE_MAC || JUCE_IOS
+    if (options.periodMs > 0)
+    {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info (&timebase);
+
+        auto ticksPerMs = (1.0e6 * timebase.denom) / timebase.numer;
+
+        // the kernel rejects computation times outside 50us to 50ms
+        auto computationMs = jlimit (0.05, 50.0, options.periodMs * 0.5);
+
+        thread_time_constraint_policy_data_t policy;
+        policy.period      = (uint32_t) (options.periodMs * ticksPerMs);
+        policy.computation = (uint32_t) (computationMs * ticksPerMs);
+        policy.constraint  = policy.period;
+        policy.preemptible = true;
+
+        return thread_policy_set (pthread_mach_thread_np (pthread_self()), THREAD_TIME_CONSTRAINT_POLICY,
+                                  (thread_policy_t) &policy, THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
+    }
+   #endif
+
+    struct sched_param param;
+    const int minPriority = sched_get_priority_min (SCHED_FIFO);
+    const int maxPriority = sched_get_priority_max (SCHED_FIFO);
+
+    param.sched_priority = ((maxPriority - minPriority) * jlimit (0, 10, options.priority)) / 10 + minPriority;
+    return pthread_setschedparam (pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+bool Thread::lockProcessMemory()
+{
+    return mlockall (MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
 Thread::ThreadID JUCE_CALLTYPE Thread::getCurrentThreadId()
 {
     return (ThreadID) pthread_self();
@@ -1118,21 +1328,39 @@ public:
         jassert (File::getCurrentWorkingDirectory().getChildFile (exe).existsAsFile()
                   || ! exe.containsChar (File::getSeparatorChar()));
 
+        auto separateErrors = (streamFlags & (wantStdErr | separateStdErr)) == (wantStdErr | separateStdErr);
         int pipeHandles[2] = {};
+        int errorPipeHandles[2] = {};
 
         if (pipe (pipeHandles) == 0)
         {
+            if (separateErrors && pipe (errorPipeHandles) != 0)
+            {
+                close (pipeHandles[0]);
+                close (pipeHandles[1]);
+                return;
+            }
+
             auto result = fork();
 
             if (result < 0)
             {
                 close (pipeHandles[0]);
                 close (pipeHandles[1]);
+
+                if (separateErrors)
+                {
+                    close (errorPipeHandles[0]);
+                    close (errorPipeHandles[1]);
+                }
             }
             else if (result == 0)
             {
                 // we're the child process..
-                close (pipeHandles[0]);   // close the read handle
+                close (pipeHandles[0]);   // close the read handles
+
+                if (separateErrors)
+                    close (errorPipeHandles[0]);
 
                 if ((streamFlags & wantStdOut) != 0)
                     dup2 (pipeHandles[1], STDOUT_FILENO); // turns the pipe into stdout
@@ -1140,12 +1368,15 @@ public:
                     dup2 (open ("/dev/null", O_WRONLY), STDOUT_FILENO);
 
                 if ((streamFlags & wantStdErr) != 0)
-                    dup2 (pipeHandles[1], STDERR_FILENO);
+                    dup2 (separateErrors ? errorPipeHandles[1] : pipeHandles[1], STDERR_FILENO);
                 else
                     dup2 (open ("/dev/null", O_WRONLY), STDERR_FILENO);
 
                 close (pipeHandles[1]);
 
+                if (separateErrors)
+                    close (errorPipeHandles[1]);
+
                 Array<char*> argv;
 
                 for (auto& arg : arguments)
@@ -1162,18 +1393,30 @@ public:
                 // we're the parent process..
                 childPID = result;
                 pipeHandle = pipeHandles[0];
-                close (pipeHandles[1]); // close the write handle
+                close (pipeHandles[1]); // close the write handles
+
+                if (separateErrors)
+                {
+                    errorPipeHandle = errorPipeHandles[0];
+                    close (errorPipeHandles[1]);
+                }
             }
         }
     }
 
     ~ActiveProcess()
     {
-        if (readHandle != nullptr)
-            fclose (readHandle);
+        // (this waits for any callbacks that are in progress to finish)
+        if (reactor != nullptr)
+        {
+            reactor->removeHandle (pipeHandle);
+
+            if (errorPipeHandle != 0)
+                reactor->removeHandle (errorPipeHandle);
+        }
 
-        if (pipeHandle != 0)
-            close (pipeHandle);
+        closePipe (pipeHandle, readHandle);
+        closePipe (errorPipeHandle, errorReadHandle);
     }
 
     bool isRunning() const noexcept
@@ -1188,19 +1431,28 @@ public:
 
     int read (void* dest, int numBytes) noexcept
     {
-        jassert (dest != nullptr && numBytes > 0);
+        return readFromPipe (pipeHandle, readHandle, dest, numBytes);
+    }
 
-        #ifdef fdopen
-         #error // some crazy 3rd party headers (e.g. zlib) define this function as NULL!
-        #endif
+    int readError (void* dest, int numBytes) noexcept
+    {
+        return readFromPipe (errorPipeHandle, errorReadHandle, dest, numBytes);
+    }
+
+    bool startReadingAsync (SocketReactor& reactorToUse, OutputCallback callbackToUse)
+    {
+        if (reactor != nullptr || readHandle != nullptr || errorReadHandle != nullptr)
+            return false;
 
-        if (readHandle == nullptr && childPID != 0)
-            readHandle = fdopen (pipeHandle, "r");
+        reactor = &reactorToUse;
+        callback = std::move (callbackToUse);
 
-        if (readHandle != nullptr)
-            return (int) fread (dest, 1, (size_t) numBytes, readHandle);
+        auto ok = watchPipe (pipeHandle, wantStdOut);
 
-        return 0;
+        if (errorPipeHandle != 0)
+            ok = watchPipe (errorPipeHandle, wantStdErr) && ok;
+
+        return ok;
     }
 
     bool killProcess() const noexcept
@@ -1223,262 +1475,93 @@ public:
     }
 
     int childPID = 0;
-    int pipeHandle = 0;
-    FILE* readHandle = {};
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess)
-};
-
-bool ChildProcess::start (const String& command, int streamFlags)
-{
-    return start (StringArray::fromTokens (command, true), streamFlags);
-}
-
-bool ChildProcess::start (const StringArray& args, int streamFlags)
-{
-    if (args.size() == 0)
-        return false;
-
-    activeProcess.reset (new ActiveProcess (args, streamFlags));
-
-    if (activeProcess->childPID == 0)
-        activeProcess.reset();
 
-    return activeProcess != nullptr;
-}
-
-//==============================================================================
-struct HighResolutionTimer::Pimpl
-{
-    Pimpl (HighResolutionTimer& t)  : owner (t)
-    {
-        pthread_condattr_t attr;
-        pthread_condattr_init (&attr);
-
-       #if JUCE_LINUX || (JUCE_ANDROID && defined(__ANDROID_API__) && __ANDROID_API__ >= 21)
-        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
-       #endif
-
-        pthread_cond_init (&stopCond, &attr);
-        pthread_condattr_destroy (&attr);
-        pthread_mutex_init (&timerMutex, nullptr);
-    }
-
-    ~Pimpl()
-    {
-        jassert (! isRunning);
-        stop();
-    }
-
-    void start (int newPeriod)
-    {
-        if (periodMs != newPeriod)
-        {
-            if (thread != pthread_self())
-            {
-                stop();
-
-                periodMs = newPeriod;
-                destroyThread = false;
-                isRunning = true;
-
-                if (pthread_create (&thread, nullptr, timerThread, this) == 0)
-                    setThreadToRealtime (thread, (uint64) newPeriod);
-                else
-                    jassertfalse;
-            }
-            else
-            {
-                periodMs = newPeriod;
-                isRunning = true;
-                destroyThread = false;
-            }
-        }
-    }
+private:
+    int pipeHandle = 0, errorPipeHandle = 0;
+    FILE* readHandle = {};
+    FILE* errorReadHandle = {};
+    SocketReactor* reactor = nullptr;
+    OutputCallback callback;
+    CriticalSection callbackLock;
 
-    void stop()
+    int readFromPipe (int handle, FILE*& file, void* dest, int numBytes) noexcept
     {
-        isRunning = false;
-
-        if (thread == pthread_t())
-            return;
-
-        if (thread == pthread_self())
-        {
-            periodMs = 3600000;
-            return;
-        }
-
-        isRunning = false;
-        destroyThread = true;
-
-        pthread_mutex_lock (&timerMutex);
-        pthread_cond_signal (&stopCond);
-        pthread_mutex_unlock (&timerMutex);
+        jassert (dest != nullptr && numBytes > 0);
 
-        pthread_join (thread, nullptr);
-        thread = {};
-    }
+        // once the output is being delivered to a callback, it can't also be read directly
+        jassert (reactor == nullptr);
 
-    HighResolutionTimer& owner;
-    std::atomic<int> periodMs;
+        #ifdef fdopen
+         #error // some crazy 3rd party headers (e.g. zlib) define this function as NULL!
+        #endif
 
-private:
-    pthread_t thread = {};
-    pthread_cond_t stopCond;
-    pthread_mutex_t timerMutex;
-    std::atomic<bool> destroyThread { false }, isRunning { false };
+        if (file == nullptr && handle != 0 && childPID != 0 && reactor == nullptr)
+            file = fdopen (handle, "r");
 
-    static void* timerThread (void* param)
-    {
-       #if ! JUCE_ANDROID
-        int dummy;
-        pthread_setcancelstate (PTHREAD_CANCEL_ENABLE, &dummy);
-       #endif
+        if (file != nullptr)
+            return (int) fread (dest, 1, (size_t) numBytes, file);
 
-        reinterpret_cast<Pimpl*> (param)->timerThread();
-        return nullptr;
+        return 0;
     }
 
-    void timerThread()
+    static void closePipe (int handle, FILE* file) noexcept
     {
-        auto lastPeriod = periodMs.load();
-        Clock clock (lastPeriod);
-
-        pthread_mutex_lock (&timerMutex);
-
-        while (! destroyThread)
-        {
-            clock.next();
-            while (! destroyThread && clock.wait (stopCond, timerMutex));
-
-            if (destroyThread)
-                break;
-
-            if (isRunning)
-                owner.hiResTimerCallback();
-
-            auto newPeriod = periodMs.load();
-
-            if (lastPeriod != newPeriod)
-            {
-                lastPeriod = newPeriod;
-                clock = Clock (lastPeriod);
-            }
-        }
-
-        periodMs = 0;
-        pthread_mutex_unlock (&timerMutex);
-        pthread_exit (nullptr);
+        if (file != nullptr)
+            fclose (file);
+        else if (handle != 0)
+            close (handle);
     }
 
-    struct Clock
+    bool watchPipe (int handle, StreamFlags stream)
     {
-       #if JUCE_MAC || JUCE_IOS
-        Clock (double millis) noexcept
-        {
-            (void) mach_timebase_info (&timebase);
-            delta = (((uint64_t) (millis * 1000000.0)) * timebase.denom) / timebase.numer;
-            time = mach_absolute_time();
-        }
+        fcntl (handle, F_SETFL, fcntl (handle, F_GETFL) | O_NONBLOCK);
 
-        bool wait (pthread_cond_t& cond, pthread_mutex_t& mutex) noexcept
+        return reactor->addHandle (handle, SocketReactor::readyForReading, [this, handle, stream] (int)
         {
-            struct timespec left;
-
-            if (! hasExpired (left))
-                return (pthread_cond_timedwait_relative_np (&cond, &mutex, &left) != ETIMEDOUT);
-
-            return false;
-        }
+            char buffer[4096];
 
-        uint64_t time, delta;
-        mach_timebase_info_data_t timebase;
-
-        bool hasExpired (struct timespec& time_left) noexcept
-        {
-            uint64_t now = mach_absolute_time();
-
-            if (now < time)
+            // read a limited amount before returning, so that a process producing lots of
+            // output can't stop the reactor's thread getting round to anything else
+            for (int i = 0; i < 16; ++i)
             {
-                uint64_t left = time - now;
-                uint64_t nanos = (left * static_cast<uint64_t> (timebase.numer)) / static_cast<uint64_t> (timebase.denom);
-                time_left.tv_sec = static_cast<__darwin_time_t> (nanos / 1000000000ULL);
-                time_left.tv_nsec = static_cast<long> (nanos - (static_cast<uint64_t> (time_left.tv_sec) * 1000000000ULL));
-
-                return false;
-            }
-
-            return true;
-        }
-      #else
-        Clock (double millis) noexcept  : delta ((uint64) (millis * 1000000))
-        {
-            struct timespec t;
-            clock_gettime (CLOCK_MONOTONIC, &t);
-            time = (uint64) (1000000000 * (int64) t.tv_sec + (int64) t.tv_nsec);
-        }
-
-        bool wait (pthread_cond_t& cond, pthread_mutex_t& mutex) noexcept
-        {
-            struct timespec absExpire;
-
-            if (! hasExpired (absExpire))
-                return (pthread_cond_timedwait (&cond, &mutex, &absExpire) != ETIMEDOUT);
-
-            return false;
-        }
+                auto num = ::read (handle, buffer, sizeof (buffer));
 
-        uint64 time, delta;
+                if (num < 0 && errno == EINTR)
+                    continue;
 
-        bool hasExpired (struct timespec& expiryTime) noexcept
-        {
-            struct timespec t;
-            clock_gettime (CLOCK_MONOTONIC, &t);
-            auto now = (uint64) (1000000000 * (int64) t.tv_sec + (int64) t.tv_nsec);
+                if (num < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                    return true;
 
-            if (now < time)
-            {
-                expiryTime.tv_sec  = (time_t) (time / 1000000000);
-                expiryTime.tv_nsec = (long)   (time % 1000000000);
+                const ScopedLock sl (callbackLock);
+                callback (stream, num > 0 ? buffer : nullptr, num > 0 ? (int) num : 0);
 
-                return false;
+                if (num <= 0)
+                    return false;
             }
 
             return true;
-        }
-       #endif
+        });
+    }
 
-        void next() noexcept
-        {
-            time += delta;
-        }
-    };
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess)
+};
 
-    static bool setThreadToRealtime (pthread_t thread, uint64 periodMs)
-    {
-       #if JUCE_MAC || JUCE_IOS
-        thread_time_constraint_policy_data_t policy;
-        policy.period      = (uint32_t) (periodMs * 1000000);
-        policy.computation = 50000;
-        policy.constraint  = policy.period;
-        policy.preemptible = true;
+bool ChildProcess::start (const String& command, int streamFlags)
+{
+    return start (StringArray::fromTokens (command, true), streamFlags);
+}
 
-        return thread_policy_set (pthread_mach_thread_np (thread),
-                                  THREAD_TIME_CONSTRAINT_POLICY,
-                                  (thread_policy_t) &policy,
-                                  THREAD_TIME_CONSTRAINT_POLICY_COUNT) == KERN_SUCCESS;
+bool ChildProcess::start (const StringArray& args, int streamFlags)
+{
+    if (args.size() == 0)
+        return false;
 
-       #else
-        ignoreUnused (periodMs);
-        struct sched_param param;
-        param.sched_priority = sched_get_priority_max (SCHED_RR);
-        return pthread_setschedparam (thread, SCHED_RR, &param) == 0;
+    activeProcess.reset (new ActiveProcess (args, streamFlags));
 
-       #endif
-    }
+    if (activeProcess->childPID == 0)
+        activeProcess.reset();
 
-    JUCE_DECLARE_NON_COPYABLE (Pimpl)
-};
+    return activeProcess != nullptr;
+}
 
 } // namespace juce
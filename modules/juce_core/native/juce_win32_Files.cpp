@@ -316,6 +316,39 @@ size_t FileInputStream::readInternal (void* buffer, size_t numBytes)
     return 0;
 }
 
+size_t FileInputStream::readInternalAt (void* buffer, size_t numBytes, int64 filePosition)
+{
+    if (fileHandle != 0)
+    {
+        OVERLAPPED overlapped = {};
+        overlapped.Offset     = (DWORD) filePosition;
+        overlapped.OffsetHigh = (DWORD) (filePosition >> 32);
+
+        DWORD actualNum = 0;
+
+        if (! ReadFile ((HANDLE) fileHandle, buffer, (DWORD) numBytes, &actualNum, &overlapped)
+              && GetLastError() != ERROR_HANDLE_EOF)
+            status = WindowsFileHelpers::getResultForLastError();
+
+        // on a synchronous handle, this moves the file pointer, so put it back
+        juce_fileSetPosition (fileHandle, currentPosition);
+        return (size_t) actualNum;
+    }
+
+    return 0;
+}
+
+bool FileInputStream::setAccessPattern (AccessPattern)
+{
+    // the file is opened with FILE_FLAG_SEQUENTIAL_SCAN, and this can't be changed later
+    return false;
+}
+
+bool FileInputStream::prefetch (Range<int64>)
+{
+    return false;
+}
+
 //==============================================================================
 void FileOutputStream::openHandle()
 {
@@ -373,6 +406,23 @@ Result FileOutputStream::truncate()
                                               : WindowsFileHelpers::getResultForLastError();
 }
 
+Result FileOutputStream::preallocate (int64 totalSizeInBytes)
+{
+    if (fileHandle == nullptr)
+        return status;
+
+   #if JUCE_MINGW
+    ignoreUnused (totalSizeInBytes);
+    return Result::fail ("Preallocation isn't supported on this platform");
+   #else
+    FILE_ALLOCATION_INFO info;
+    info.AllocationSize.QuadPart = totalSizeInBytes;
+
+    return SetFileInformationByHandle ((HANDLE) fileHandle, FileAllocationInfo, &info, sizeof (info))
+             ? Result::ok() : WindowsFileHelpers::getResultForLastError();
+   #endif
+}
+
 //==============================================================================
 void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exclusive)
 {
@@ -424,6 +474,8 @@ void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exc
 
 MemoryMappedFile::~MemoryMappedFile()
 {
+    cancelTouchJobs();
+
     if (address != nullptr)
         UnmapViewOfFile (address);
 
@@ -431,6 +483,61 @@ MemoryMappedFile::~MemoryMappedFile()
         CloseHandle ((HANDLE) fileHandle);
 }
 
+static int64 getVirtualMemoryPageSize()
+{
+    SYSTEM_INFO systemInfo;
+    GetNativeSystemInfo (&systemInfo);
+    return (int64) systemInfo.dwPageSize;
+}
+
+bool MemoryMappedFile::setAccessPattern (AccessPattern)
+{
+    // Windows has no way to change this after the file has been opened
+    return false;
+}
+
+bool MemoryMappedFile::prefetch (Range<int64> fileRange)
+{
+    // PrefetchVirtualMemory is only available from Windows 8 onwards
+    struct MemoryRangeEntry  { void* address; SIZE_T numBytes; };
+    using PrefetchFn = BOOL (WINAPI*) (HANDLE, ULONG_PTR, MemoryRangeEntry*, ULONG);
+
+    static auto prefetchVirtualMemory = (PrefetchFn) GetProcAddress (GetModuleHandleA ("kernel32.dll"), "PrefetchVirtualMemory");
+
+    void* start;
+    size_t numBytes;
+
+    if (prefetchVirtualMemory == nullptr || ! getPageAlignedRegion (fileRange, getVirtualMemoryPageSize(), start, numBytes))
+        return false;
+
+    MemoryRangeEntry entry { start, (SIZE_T) numBytes };
+    return prefetchVirtualMemory (GetCurrentProcess(), 1, &entry, 0) != 0;
+}
+
+bool MemoryMappedFile::lockRange (Range<int64> fileRange)
+{
+    void* start;
+    size_t numBytes;
+
+    return getPageAlignedRegion (fileRange, getVirtualMemoryPageSize(), start, numBytes)
+             && VirtualLock (start, (SIZE_T) numBytes) != 0;
+}
+
+bool MemoryMappedFile::unlockRange (Range<int64> fileRange)
+{
+    void* start;
+    size_t numBytes;
+
+    return getPageAlignedRegion (fileRange, getVirtualMemoryPageSize(), start, numBytes)
+             && VirtualUnlock (start, (SIZE_T) numBytes) != 0;
+}
+
+bool MemoryMappedFile::requestHugePages()
+{
+    // large pages are only available for pagefile-backed sections, not for mapped files
+    return false;
+}
+
 //==============================================================================
 int64 File::getSize() const
 {
@@ -938,6 +1045,55 @@ bool DirectoryIterator::NativeIterator::next (String& filenameFound,
     return pimpl->next (filenameFound, isDir, isHidden, fileSize, modTime, creationTime, isReadOnly);
 }
 
+//==============================================================================
+void DirectoryScanner::readEntries (const String& directoryWithSeparator, bool,
+                                    const std::function<bool (Entry&, bool)>& callback)
+{
+    using namespace WindowsFileHelpers;
+
+    // (FindExInfoBasic and FIND_FIRST_EX_LARGE_FETCH need Windows 7, so fall back if they're refused)
+    const int findExInfoBasic = 1, findFirstExLargeFetch = 2;
+
+    auto searchPath = directoryWithSeparator + "*";
+    WIN32_FIND_DATAW findData;
+
+    auto handle = FindFirstFileExW (searchPath.toWideCharPointer(), (FINDEX_INFO_LEVELS) findExInfoBasic, &findData,
+                                    FindExSearchNameMatch, nullptr, findFirstExLargeFetch);
+
+    if (handle == INVALID_HANDLE_VALUE && GetLastError() == ERROR_INVALID_PARAMETER)
+        handle = FindFirstFileW (searchPath.toWideCharPointer(), &findData);
+
+    if (handle == INVALID_HANDLE_VALUE)
+        return;
+
+    Entry e;
+    e.directory = directoryWithSeparator;
+
+    do
+    {
+        e.filename = findData.cFileName;
+
+        if (e.filename == "." || e.filename == "..")
+            continue;
+
+        auto attributes = findData.dwFileAttributes;
+
+        // the find data always includes the file info, so there's no extra cost in filling it in
+        e.isDirectory      = (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        e.isHidden         = (attributes & FILE_ATTRIBUTE_HIDDEN) != 0;
+        e.isReadOnly       = (attributes & FILE_ATTRIBUTE_READONLY) != 0;
+        e.fileSize         = findData.nFileSizeLow + (((int64) findData.nFileSizeHigh) << 32);
+        e.modificationTime = Time (fileTimeToTime (&findData.ftLastWriteTime));
+        e.creationTime     = Time (fileTimeToTime (&findData.ftCreationTime));
+
+        if (! callback (e, (attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0))
+            break;
+    }
+    while (FindNextFileW (handle, &findData) != 0);
+
+    FindClose (handle);
+}
+
 
 //==============================================================================
 bool JUCE_CALLTYPE Process::openDocument (const String& fileName, const String& parameters)
@@ -158,6 +158,7 @@ void CPUInformation::initialise() noexcept
     hasAVX512PF        = (info[1] & (1u << 26)) != 0;
     hasAVX512ER        = (info[1] & (1u << 27)) != 0;
     hasAVX512CD        = (info[1] & (1u << 28)) != 0;
+    hasSHA             = (info[1] & (1u << 29)) != 0;
     hasAVX512BW        = (info[1] & (1u << 30)) != 0;
     hasAVX512VL        = (info[1] & (1u << 31)) != 0;
     hasAVX512VBMI      = (info[2] & (1u <<  1)) != 0;
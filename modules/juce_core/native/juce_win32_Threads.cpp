@@ -48,20 +48,6 @@ bool CriticalSection::tryEnter() const noexcept     { return TryEnterCriticalSec
 void CriticalSection::exit() const noexcept         { LeaveCriticalSection ((CRITICAL_SECTION*) lock); }
 
 
-//==============================================================================
-WaitableEvent::WaitableEvent (const bool manualReset) noexcept
-    : handle (CreateEvent (0, manualReset ? TRUE : FALSE, FALSE, 0)) {}
-
-WaitableEvent::~WaitableEvent() noexcept        { CloseHandle (handle); }
-
-void WaitableEvent::signal() const noexcept     { SetEvent (handle); }
-void WaitableEvent::reset() const noexcept      { ResetEvent (handle); }
-
-bool WaitableEvent::wait (const int timeOutMs) const noexcept
-{
-    return WaitForSingleObject (handle, (DWORD) timeOutMs) == WAIT_OBJECT_0;
-}
-
 //==============================================================================
 void JUCE_API juce_threadEntryPoint (void*);
 
@@ -152,6 +138,36 @@ bool Thread::setThreadPriority (void* handle, int priority)
     return SetThreadPriority (handle, pri) != FALSE;
 }
 
+bool Thread::setCurrentThreadRealtimeScheduling (const RealtimeOptions& options)
+{
+    // "Pro Audio" is the MMCSS task that the system's own audio engine threads and
+    // WASAPI/ASIO callbacks run in, so joining it puts this thread in the same class
+    DynamicLibrary dll ("avrt.dll");
+    JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadCharacteristicsW, avSetMmThreadCharacteristics, HANDLE, (LPCWSTR, LPDWORD))
+    JUCE_LOAD_WINAPI_FUNCTION (dll, AvSetMmThreadPriority, avSetMmThreadPriority, BOOL, (HANDLE, int))
+
+    if (avSetMmThreadCharacteristics != nullptr && avSetMmThreadPriority != nullptr)
+    {
+        DWORD taskIndex = 0;
+
+        if (auto h = avSetMmThreadCharacteristics (L"Pro Audio", &taskIndex))
+        {
+            // AVRT_PRIORITY_LOW = -1, AVRT_PRIORITY_NORMAL = 0, AVRT_PRIORITY_HIGH = 1, AVRT_PRIORITY_CRITICAL = 2
+            auto mmPriority = options.priority >= 10 ? 2 : (options.priority >= 7 ? 1 : (options.priority >= 4 ? 0 : -1));
+            return avSetMmThreadPriority (h, mmPriority) != FALSE;
+        }
+    }
+
+    setThreadPriority (nullptr, 10);
+    return false;
+}
+
+bool Thread::lockProcessMemory()
+{
+    // there's no process-wide equivalent of mlockall on Windows
+    return false;
+}
+
 void JUCE_CALLTYPE Thread::setCurrentThreadAffinityMask (const uint32 affinityMask)
 {
     SetThreadAffinityMask (GetCurrentThread(), affinityMask);
@@ -409,20 +425,24 @@ class ChildProcess::ActiveProcess
 {
 public:
     ActiveProcess (const String& command, int streamFlags)
-        : ok (false), readPipe (0), writePipe (0)
+        : ok (false), readPipe (0), writePipe (0), errorReadPipe (0), errorWritePipe (0)
     {
         SECURITY_ATTRIBUTES securityAtts = { 0 };
         securityAtts.nLength = sizeof (securityAtts);
         securityAtts.bInheritHandle = TRUE;
 
+        auto separateErrors = (streamFlags & (wantStdErr | separateStdErr)) == (wantStdErr | separateStdErr);
+
         if (CreatePipe (&readPipe, &writePipe, &securityAtts, 0)
-             && SetHandleInformation (readPipe, HANDLE_FLAG_INHERIT, 0))
+             && SetHandleInformation (readPipe, HANDLE_FLAG_INHERIT, 0)
+             && (! separateErrors || (CreatePipe (&errorReadPipe, &errorWritePipe, &securityAtts, 0)
+                                       && SetHandleInformation (errorReadPipe, HANDLE_FLAG_INHERIT, 0))))
         {
             STARTUPINFOW startupInfo = { 0 };
             startupInfo.cb = sizeof (startupInfo);
 
             startupInfo.hStdOutput = (streamFlags & wantStdOut) != 0 ? writePipe : 0;
-            startupInfo.hStdError  = (streamFlags & wantStdErr) != 0 ? writePipe : 0;
+            startupInfo.hStdError  = (streamFlags & wantStdErr) != 0 ? (separateErrors ? errorWritePipe : writePipe) : 0;
             startupInfo.dwFlags = STARTF_USESTDHANDLES;
 
             ok = CreateProcess (nullptr, const_cast<LPWSTR> (command.toWideCharPointer()),
@@ -433,17 +453,17 @@ public:
 
     ~ActiveProcess()
     {
+        readerThreads.clear();
+
         if (ok)
         {
             CloseHandle (processInfo.hThread);
             CloseHandle (processInfo.hProcess);
         }
 
-        if (readPipe != 0)
-            CloseHandle (readPipe);
-
-        if (writePipe != 0)
-            CloseHandle (writePipe);
+        for (auto pipe : { readPipe, writePipe, errorReadPipe, errorWritePipe })
+            if (pipe != 0)
+                CloseHandle (pipe);
     }
 
     bool isRunning() const noexcept
@@ -453,13 +473,117 @@ public:
 
     int read (void* dest, int numNeeded) const noexcept
     {
+        return readFromPipe (readPipe, dest, numNeeded);
+    }
+
+    int readError (void* dest, int numNeeded) const noexcept
+    {
+        return errorReadPipe != 0 ? readFromPipe (errorReadPipe, dest, numNeeded) : 0;
+    }
+
+    bool startReadingAsync (SocketReactor&, OutputCallback callbackToUse)
+    {
+        // anonymous pipes can't be waited on in a reactor, so each one gets a thread instead
+        if (! readerThreads.isEmpty())
+            return false;
+
+        callback = std::move (callbackToUse);
+        readerThreads.add (new ReaderThread (*this, readPipe, wantStdOut));
+
+        if (errorReadPipe != 0)
+            readerThreads.add (new ReaderThread (*this, errorReadPipe, wantStdErr));
+
+        for (auto* t : readerThreads)
+            t->startThread();
+
+        return true;
+    }
+
+    bool killProcess() const noexcept
+    {
+        return TerminateProcess (processInfo.hProcess, 0) != FALSE;
+    }
+
+    uint32 getExitCode() const noexcept
+    {
+        DWORD exitCode = 0;
+        GetExitCodeProcess (processInfo.hProcess, &exitCode);
+        return (uint32) exitCode;
+    }
+
+    bool ok;
+
+private:
+    //==============================================================================
+    struct ReaderThread  : public Thread
+    {
+        ReaderThread (ActiveProcess& p, HANDLE pipeToRead, StreamFlags streamType)
+            : Thread ("JUCE ChildProcess reader"), owner (p), pipe (pipeToRead), stream (streamType)
+        {}
+
+        ~ReaderThread()
+        {
+            stopThread (10000);
+        }
+
+        void run() override
+        {
+            char buffer[4096];
+
+            // (this polls rather than blocking in ReadFile, so that the thread can be stopped)
+            while (! threadShouldExit())
+            {
+                DWORD available = 0;
+
+                if (! PeekNamedPipe (pipe, nullptr, 0, nullptr, &available, nullptr))
+                    break;
+
+                if (available == 0)
+                {
+                    if (! owner.isRunning())
+                        break;
+
+                    wait (2);
+                    continue;
+                }
+
+                DWORD numRead = 0;
+
+                if (! ReadFile (pipe, buffer, jmin ((DWORD) sizeof (buffer), available), &numRead, nullptr))
+                    break;
+
+                owner.deliverOutput (stream, buffer, (int) numRead);
+            }
+
+            if (! threadShouldExit())
+                owner.deliverOutput (stream, nullptr, 0);
+        }
+
+        ActiveProcess& owner;
+        const HANDLE pipe;
+        const StreamFlags stream;
+
+        JUCE_DECLARE_NON_COPYABLE (ReaderThread)
+    };
+
+    HANDLE readPipe, writePipe, errorReadPipe, errorWritePipe;
+    PROCESS_INFORMATION processInfo;
+    OutputCallback callback;
+    CriticalSection callbackLock;
+    OwnedArray<ReaderThread> readerThreads;
+
+    int readFromPipe (HANDLE pipe, void* dest, int numNeeded) const noexcept
+    {
+        // once the output is being delivered to a callback, it can't also be read directly
+        jassert (readerThreads.isEmpty());
+
         int total = 0;
 
         while (ok && numNeeded > 0)
         {
             DWORD available = 0;
 
-            if (! PeekNamedPipe ((HANDLE) readPipe, nullptr, 0, nullptr, &available, nullptr))
+            if (! PeekNamedPipe (pipe, nullptr, 0, nullptr, &available, nullptr))
                 break;
 
             const int numToDo = jmin ((int) available, numNeeded);
@@ -474,7 +598,7 @@ public:
             else
             {
                 DWORD numRead = 0;
-                if (! ReadFile ((HANDLE) readPipe, dest, numToDo, &numRead, nullptr))
+                if (! ReadFile (pipe, dest, numToDo, &numRead, nullptr))
                     break;
 
                 total += numRead;
@@ -486,24 +610,12 @@ public:
         return total;
     }
 
-    bool killProcess() const noexcept
+    void deliverOutput (StreamFlags stream, const void* data, int numBytes)
     {
-        return TerminateProcess (processInfo.hProcess, 0) != FALSE;
+        const ScopedLock sl (callbackLock);
+        callback (stream, data, numBytes);
     }
 
-    uint32 getExitCode() const noexcept
-    {
-        DWORD exitCode = 0;
-        GetExitCodeProcess (processInfo.hProcess, &exitCode);
-        return (uint32) exitCode;
-    }
-
-    bool ok;
-
-private:
-    HANDLE readPipe, writePipe;
-    PROCESS_INFORMATION processInfo;
-
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ActiveProcess)
 };
 
@@ -536,56 +648,4 @@ bool ChildProcess::start (const StringArray& args, int streamFlags)
     return start (escaped.trim(), streamFlags);
 }
 
-//==============================================================================
-struct HighResolutionTimer::Pimpl
-{
-    Pimpl (HighResolutionTimer& t) noexcept  : owner (t)
-    {
-    }
-
-    ~Pimpl()
-    {
-        jassert (periodMs == 0);
-    }
-
-    void start (int newPeriod)
-    {
-        if (newPeriod != periodMs)
-        {
-            stop();
-            periodMs = newPeriod;
-
-            TIMECAPS tc;
-            if (timeGetDevCaps (&tc, sizeof (tc)) == TIMERR_NOERROR)
-            {
-                const int actualPeriod = jlimit ((int) tc.wPeriodMin, (int) tc.wPeriodMax, newPeriod);
-
-                timerID = timeSetEvent (actualPeriod, tc.wPeriodMin, callbackFunction, (DWORD_PTR) this,
-                                        TIME_PERIODIC | TIME_CALLBACK_FUNCTION | 0x100 /*TIME_KILL_SYNCHRONOUS*/);
-            }
-        }
-    }
-
-    void stop()
-    {
-        periodMs = 0;
-        timeKillEvent (timerID);
-    }
-
-    HighResolutionTimer& owner;
-    int periodMs = 0;
-
-private:
-    unsigned int timerID;
-
-    static void __stdcall callbackFunction (UINT, UINT, DWORD_PTR userInfo, DWORD_PTR, DWORD_PTR)
-    {
-        if (Pimpl* const timer = reinterpret_cast<Pimpl*> (userInfo))
-            if (timer->periodMs != 0)
-                timer->owner.hiResTimerCallback();
-    }
-
-    JUCE_DECLARE_NON_COPYABLE (Pimpl)
-};
-
 } // namespace juce
@@ -470,6 +470,75 @@ int StreamingSocket::write (const void* sourceBuffer, int numBytesToWrite)
     return (int) ::send (handle, (const char*) sourceBuffer, (juce_recvsend_size_t) numBytesToWrite, 0);
 }
 
+int StreamingSocket::writeGathered (const OutputStream::Buffer* buffers, int numBuffers)
+{
+    jassert (buffers != nullptr || numBuffers == 0);
+
+    if (isListener || ! connected)
+        return -1;
+
+    enum { maxBuffersPerCall = 64 };
+
+   #if JUCE_WINDOWS
+    WSABUF vectors[maxBuffersPerCall];
+   #else
+    iovec vectors[maxBuffersPerCall];
+   #endif
+
+    int numSent = 0;
+    size_t offset = 0;
+
+    for (;;)
+    {
+        // skip past whatever has been sent already, which may end part-way through a buffer
+        while (numBuffers > 0 && offset >= buffers->numBytes)
+        {
+            offset -= buffers->numBytes;
+            ++buffers;
+            --numBuffers;
+        }
+
+        if (numBuffers == 0)
+            return numSent;
+
+        auto numThisTime = jmin ((int) maxBuffersPerCall, numBuffers);
+
+        for (int i = 0; i < numThisTime; ++i)
+        {
+            auto start = i == 0 ? offset : 0;
+            auto* data = const_cast<char*> (static_cast<const char*> (buffers[i].data)) + start;
+            auto numBytes = buffers[i].numBytes - start;
+
+           #if JUCE_WINDOWS
+            vectors[i].buf = data;
+            vectors[i].len = (ULONG) numBytes;
+           #else
+            vectors[i].iov_base = data;
+            vectors[i].iov_len = numBytes;
+           #endif
+        }
+
+       #if JUCE_WINDOWS
+        DWORD bytesSent = 0;
+        auto num = ::WSASend ((SOCKET) handle, vectors, (DWORD) numThisTime, &bytesSent, 0, nullptr, nullptr) == 0
+                     ? (int) bytesSent : -1;
+       #else
+        msghdr header;
+        zerostruct (header);
+        header.msg_iov = vectors;
+        header.msg_iovlen = (decltype (header.msg_iovlen)) numThisTime;
+
+        auto num = (int) ::sendmsg (handle, &header, 0);
+       #endif
+
+        if (num <= 0)
+            return numSent > 0 ? numSent : -1;
+
+        numSent += num;
+        offset += (size_t) num;
+    }
+}
+
 //==============================================================================
 int StreamingSocket::waitUntilReady (bool readyForReading, int timeoutMsecs)
 {
@@ -700,6 +769,18 @@ int DatagramSocket::write (const String& remoteHostname, int remotePortNumber,
     if (handle < 0)
         return -1;
 
+    auto* info = static_cast<struct addrinfo*> (getServerAddress (remoteHostname, remotePortNumber));
+
+    if (info == nullptr)
+        return -1;
+
+    return (int) ::sendto (handle, (const char*) sourceBuffer,
+                           (juce_recvsend_size_t) numBytesToWrite, 0,
+                           info->ai_addr, (socklen_t) info->ai_addrlen);
+}
+
+void* DatagramSocket::getServerAddress (const String& remoteHostname, int remotePortNumber)
+{
     struct addrinfo*& info = reinterpret_cast<struct addrinfo*&> (lastServerAddress);
 
     // getaddrinfo can be quite slow so cache the result of the address lookup
@@ -709,15 +790,190 @@ int DatagramSocket::write (const String& remoteHostname, int remotePortNumber,
             freeaddrinfo (info);
 
         if ((info = SocketHelpers::getAddressInfo (true, remoteHostname, remotePortNumber)) == nullptr)
-            return -1;
+            return nullptr;
 
         lastServerHost = remoteHostname;
         lastServerPort = remotePortNumber;
     }
 
-    return (int) ::sendto (handle, (const char*) sourceBuffer,
-                           (juce_recvsend_size_t) numBytesToWrite, 0,
-                           info->ai_addr, (socklen_t) info->ai_addrlen);
+    return info;
+}
+
+//==============================================================================
+int DatagramSocket::readMultiple (Packet* packets, int numPackets, bool shouldBlock)
+{
+    jassert (packets != nullptr && numPackets >= 0);
+
+    if (handle < 0 || ! isBound)
+        return -1;
+
+    CriticalSection::ScopedTryLockType lock (readLock);
+
+    if (! lock.isLocked())
+        return shouldBlock ? -1 : 0;
+
+    SocketHelpers::setSocketBlockingState (handle, shouldBlock);
+
+   #if JUCE_LINUX
+    if (! timestampsEnabled)
+        timestampsEnabled = SocketHelpers::setOption (handle, SO_TIMESTAMP, (int) 1);
+
+    enum { maxPacketsPerCall = 64 };
+    mmsghdr headers[maxPacketsPerCall];
+    iovec buffers[maxPacketsPerCall];
+    sockaddr_in senders[maxPacketsPerCall];
+    char control[maxPacketsPerCall][CMSG_SPACE (sizeof (timeval))];
+
+    int numRead = 0;
+
+    while (numRead < numPackets)
+    {
+        auto numThisTime = jmin ((int) maxPacketsPerCall, numPackets - numRead);
+        zeromem (headers, sizeof (headers));
+
+        for (int i = 0; i < numThisTime; ++i)
+        {
+            auto& p = packets[numRead + i];
+            buffers[i] = { p.data, (size_t) p.size };
+
+            auto& h = headers[i].msg_hdr;
+            h.msg_name = senders + i;
+            h.msg_namelen = sizeof (sockaddr_in);
+            h.msg_iov = buffers + i;
+            h.msg_iovlen = 1;
+            h.msg_control = control[i];
+            h.msg_controllen = sizeof (control[i]);
+        }
+
+        // only the first call can block - after that, just collect whatever's already waiting
+        auto num = ::recvmmsg (handle, headers, (unsigned int) numThisTime,
+                               numRead == 0 && shouldBlock ? MSG_WAITFORONE : MSG_DONTWAIT, nullptr);
+
+        if (num <= 0)
+        {
+            if (numRead == 0 && (shouldBlock || (errno != EAGAIN && errno != EWOULDBLOCK)))
+                return -1;
+
+            break;
+        }
+
+        for (int i = 0; i < num; ++i)
+        {
+            auto& p = packets[numRead + i];
+            p.numBytes = (int) headers[i].msg_len;
+            p.senderAddress = IPAddress ((const uint8*) &senders[i].sin_addr.s_addr);
+            p.senderPort = ntohs (senders[i].sin_port);
+            p.timestamp = 0;
+
+            for (auto* c = CMSG_FIRSTHDR (&headers[i].msg_hdr); c != nullptr; c = CMSG_NXTHDR (&headers[i].msg_hdr, c))
+            {
+                if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SCM_TIMESTAMP)
+                {
+                    timeval t;
+                    memcpy (&t, CMSG_DATA (c), sizeof (t));
+                    p.timestamp = (int64) t.tv_sec * 1000000 + (int64) t.tv_usec;
+                }
+            }
+
+            if (p.timestamp == 0)
+                p.timestamp = Time::currentTimeMillis() * 1000;
+        }
+
+        numRead += num;
+
+        if (num < numThisTime)
+            break;
+    }
+
+    return numRead;
+   #else
+    int numRead = 0;
+
+    for (; numRead < numPackets; ++numRead)
+    {
+        // only the first read can block - after that, just collect whatever's already waiting
+        if (numRead > 0 && SocketHelpers::waitForReadiness (handle, readLock, true, 0) != 1)
+            break;
+
+        auto& p = packets[numRead];
+        sockaddr_in sender;
+        juce_socklen_t senderLen = sizeof (sender);
+
+        auto num = ::recvfrom (handle, (char*) p.data, (juce_recvsend_size_t) p.size, 0, (sockaddr*) &sender, &senderLen);
+
+        if (num < 0)
+        {
+            if (numRead == 0 && shouldBlock)
+                return -1;
+
+            break;
+        }
+
+        p.numBytes = (int) num;
+        p.senderAddress = IPAddress ((const uint8*) &sender.sin_addr.s_addr);
+        p.senderPort = ntohs (sender.sin_port);
+        p.timestamp = Time::currentTimeMillis() * 1000;
+    }
+
+    return numRead;
+   #endif
+}
+
+int DatagramSocket::writeMultiple (const String& remoteHostname, int remotePortNumber,
+                                   const Packet* packets, int numPackets)
+{
+    jassert (SocketHelpers::isValidPortNumber (remotePortNumber));
+    jassert (packets != nullptr && numPackets >= 0);
+
+    if (handle < 0)
+        return -1;
+
+    auto* info = static_cast<struct addrinfo*> (getServerAddress (remoteHostname, remotePortNumber));
+
+    if (info == nullptr)
+        return -1;
+
+   #if JUCE_LINUX
+    enum { maxPacketsPerCall = 64 };
+    mmsghdr headers[maxPacketsPerCall];
+    iovec buffers[maxPacketsPerCall];
+
+    int numSent = 0;
+
+    while (numSent < numPackets)
+    {
+        auto numThisTime = jmin ((int) maxPacketsPerCall, numPackets - numSent);
+        zeromem (headers, sizeof (headers));
+
+        for (int i = 0; i < numThisTime; ++i)
+        {
+            auto& p = packets[numSent + i];
+            buffers[i] = { p.data, (size_t) p.size };
+
+            auto& h = headers[i].msg_hdr;
+            h.msg_name = info->ai_addr;
+            h.msg_namelen = (socklen_t) info->ai_addrlen;
+            h.msg_iov = buffers + i;
+            h.msg_iovlen = 1;
+        }
+
+        auto num = ::sendmmsg (handle, headers, (unsigned int) numThisTime, 0);
+
+        if (num <= 0)
+            return numSent > 0 ? numSent : -1;
+
+        numSent += num;
+    }
+
+    return numSent;
+   #else
+    for (int i = 0; i < numPackets; ++i)
+        if (::sendto (handle, (const char*) packets[i].data, (juce_recvsend_size_t) packets[i].size, 0,
+                      info->ai_addr, (socklen_t) info->ai_addrlen) < 0)
+            return i > 0 ? i : -1;
+
+    return numPackets;
+   #endif
 }
 
 bool DatagramSocket::joinMulticast (const String& multicastIPAddress)
@@ -766,4 +1022,130 @@ bool DatagramSocket::setEnablePortReuse (bool enabled)
  #pragma warning (pop)
 #endif
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct DatagramSocketTests  : public UnitTest
+{
+    DatagramSocketTests()  : UnitTest ("DatagramSocket", "Networking") {}
+
+    void runTest() override
+    {
+        beginTest ("Batched reads and writes");
+        {
+            enum { numPackets = 100 };
+
+            DatagramSocket receiver, sender;
+            expect (receiver.bindToPort (0, "127.0.0.1"));
+            expect (sender.bindToPort (0, "127.0.0.1"));
+
+            int values[numPackets];
+            DatagramSocket::Packet outgoing[numPackets];
+
+            for (int i = 0; i < numPackets; ++i)
+            {
+                values[i] = i;
+                outgoing[i].data = values + i;
+                outgoing[i].size = i % 2 == 0 ? (int) sizeof (int) : 2;
+            }
+
+            auto startTime = Time::currentTimeMillis() * 1000;
+            expectEquals (sender.writeMultiple ("127.0.0.1", receiver.getBoundPort(), outgoing, numPackets), (int) numPackets);
+
+            int received[numPackets];
+            DatagramSocket::Packet incoming[numPackets];
+
+            for (int i = 0; i < numPackets; ++i)
+            {
+                received[i] = -1;
+                incoming[i].data = received + i;
+                incoming[i].size = (int) sizeof (int);
+            }
+
+            int numRead = 0;
+
+            while (numRead < numPackets && receiver.waitUntilReady (true, 1000) == 1)
+            {
+                auto num = receiver.readMultiple (incoming + numRead, numPackets - numRead, false);
+
+                if (num <= 0)
+                    break;
+
+                numRead += num;
+            }
+
+            expectEquals (numRead, (int) numPackets);
+
+            bool allCorrect = true;
+
+            for (int i = 0; i < numRead; ++i)
+            {
+                auto& p = incoming[i];
+
+                allCorrect = allCorrect
+                              && p.numBytes == outgoing[i].size
+                              && memcmp (received + i, values + i, (size_t) p.numBytes) == 0
+                              && p.senderAddress == IPAddress::local()
+                              && p.senderPort == sender.getBoundPort()
+                              && p.timestamp >= startTime - 1000000;
+            }
+
+            expect (allCorrect);
+            expectEquals (receiver.readMultiple (incoming, numPackets, false), 0);
+        }
+    }
+};
+
+static DatagramSocketTests datagramSocketTests;
+
+//==============================================================================
+struct StreamingSocketTests  : public UnitTest
+{
+    StreamingSocketTests()  : UnitTest ("StreamingSocket", "Networking") {}
+
+    void runTest() override
+    {
+        beginTest ("Gathered writes");
+        {
+            StreamingSocket listener, sender;
+            expect (listener.createListener (0, "127.0.0.1"));
+            expect (sender.connect ("127.0.0.1", listener.getBoundPort(), 1000));
+
+            std::unique_ptr<StreamingSocket> receiver (listener.waitForNextConnection());
+            expect (receiver != nullptr);
+
+            if (receiver == nullptr)
+                return;
+
+            // (this is small enough to fit in the socket's buffers, but uses more
+            // chunks than can be passed to a single system call)
+            ChunkedMemoryOutputStream data (100);
+            auto r = getRandom();
+
+            for (int i = 0; i < 20000; ++i)
+                data.writeByte ((char) r.nextInt (256));
+
+            const char* header = "header";
+            Array<OutputStream::Buffer> buffers;
+            buffers.add ({ header, strlen (header) });
+            buffers.add ({ nullptr, 0 });
+            buffers.addArray (data.getBuffers());
+
+            auto totalSize = (int) (data.getDataSize() + strlen (header));
+            expectEquals (sender.writeGathered (buffers.begin(), buffers.size()), totalSize);
+
+            MemoryBlock received ((size_t) totalSize);
+            expectEquals (receiver->read (received.getData(), totalSize, true), totalSize);
+
+            MemoryOutputStream expected;
+            expected << header << data.getMemoryBlock();
+            expect (received == expected.getMemoryBlock());
+        }
+    }
+};
+
+static StreamingSocketTests streamingSocketTests;
+
+#endif
+
 } // namespace juce
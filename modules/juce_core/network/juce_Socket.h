@@ -146,6 +146,20 @@ public:
     */
     int write (const void* sourceBuffer, int numBytesToWrite);
 
+    /** Writes a sequence of separate blocks of data to the socket, passing as many of
+        them as possible to each system call rather than sending them one at a time.
+
+        This lets you send something like a header followed by a payload, or the contents
+        of a ChunkedMemoryOutputStream, without first copying it all into one buffer.
+        Like write(), this will block unless the socket is ready for writing, and it
+        keeps going until all the data has been sent or an error occurs.
+
+        @returns the total number of bytes written, or -1 if there was an error before
+                 anything could be written.
+        @see ChunkedMemoryOutputStream::getBuffers
+    */
+    int writeGathered (const OutputStream::Buffer* buffers, int numBuffers);
+
     //==============================================================================
     /** Puts this socket into "listener" mode.
 
@@ -303,6 +317,59 @@ public:
     int write (const String& remoteHostname, int remotePortNumber,
                const void* sourceBuffer, int numBytesToWrite);
 
+    //==============================================================================
+    /** Describes one of the datagrams used by readMultiple() and writeMultiple(). */
+    struct Packet
+    {
+        /** The buffer to receive into, or the data to send. */
+        void* data = nullptr;
+
+        /** The size of the buffer when receiving, or the number of bytes to send. */
+        int size = 0;
+
+        /** On return from readMultiple(), the number of bytes that were received. */
+        int numBytes = 0;
+
+        /** On return from readMultiple(), the address and port that sent the datagram. */
+        IPAddress senderAddress;
+        int senderPort = 0;
+
+        /** On return from readMultiple(), the time at which the datagram arrived, in
+            microseconds since 1st January 1970.
+
+            Where the OS supports it this is the time the kernel received it, so it isn't
+            affected by how long it took the caller to get around to reading it.
+        */
+        int64 timestamp = 0;
+    };
+
+    /** Receives several datagrams in one go.
+
+        On Linux this uses a single recvmmsg() call, which avoids most of the per-packet
+        overhead of calling read() in a loop when the traffic is heavy.
+
+        If shouldBlock is true, this waits until at least one datagram has arrived; it
+        then returns as many of the ones already waiting as will fit in the array, without
+        blocking further. Each datagram goes into its own Packet, and if it's bigger than
+        that Packet's buffer, the end of it is lost.
+
+        @returns the number of packets that were filled in, or -1 if there was an error.
+        @see read, writeMultiple
+    */
+    int readMultiple (Packet* packets, int numPackets, bool shouldBlock);
+
+    /** Sends several datagrams to the same destination in one go.
+
+        On Linux this uses a single sendmmsg() call. Only the data and size fields of
+        each Packet are used. Like write(), this will block if the socket isn't ready
+        for writing.
+
+        @returns the number of packets sent, or -1 if there was an error.
+        @see write, readMultiple
+    */
+    int writeMultiple (const String& remoteHostname, int remotePortNumber,
+                       const Packet* packets, int numPackets);
+
     /** Closes the underlying socket object.
 
         Closes the underlying socket object and aborts any read or write operations.
@@ -351,8 +418,11 @@ private:
     String lastBindAddress, lastServerHost;
     int lastServerPort = -1;
     void* lastServerAddress = nullptr;
+    bool timestampsEnabled = false;
     mutable CriticalSection readLock;
 
+    void* getServerAddress (const String&, int);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DatagramSocket)
 };
 
@@ -0,0 +1,643 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct SocketReactor::Registration
+{
+    Registration (int h, int f, Callback cb)  : handle (h), flags (f), callback (std::move (cb)) {}
+
+    const int handle, flags;
+    Callback callback;
+    Thread::ThreadID callbackThread = nullptr;
+    WaitableEvent* removalFinished = nullptr;
+    int pendingFlags = 0;
+    bool removed = false;
+};
+
+struct SocketReactor::ReactorThread  : public Thread
+{
+    ReactorThread (SocketReactor& r)  : Thread ("JUCE SocketReactor"), reactor (r) {}
+    void run() override     { reactor.runThread (*this); }
+
+    SocketReactor& reactor;
+};
+
+//==============================================================================
+// Each poller watches the sockets with one-shot notifications, so a socket that has
+// fired stays quiet until rearm() is called after its callback has finished.
+#if JUCE_LINUX || JUCE_ANDROID
+
+struct SocketReactor::Poller
+{
+    Poller()
+    {
+        epoll_event e = {};
+        e.events = EPOLLIN;
+        e.data.u64 = 0;
+        epoll_ctl (epollFD, EPOLL_CTL_ADD, wakeFD, &e);
+    }
+
+    ~Poller()
+    {
+        ::close (wakeFD);
+        ::close (epollFD);
+    }
+
+    bool add (int handle, uint64 id, int flags)      { return control (EPOLL_CTL_ADD, handle, id, flags); }
+    void rearm (int handle, uint64 id, int flags)    { control (EPOLL_CTL_MOD, handle, id, flags); }
+
+    void remove (int handle, int)
+    {
+        epoll_event e = {};
+        epoll_ctl (epollFD, EPOLL_CTL_DEL, handle, &e);
+    }
+
+    // the event is never read back, so every thread's wait returns straight away from now on
+    void wakeAllThreads()
+    {
+        uint64 value = 1;
+        ignoreUnused (::write (wakeFD, &value, sizeof (value)));
+    }
+
+    template <typename HandlerFn>
+    void wait (int timeoutMs, HandlerFn&& handleEvent)
+    {
+        epoll_event events[32];
+        auto num = epoll_wait (epollFD, events, (int) numElementsInArray (events), timeoutMs);
+
+        for (int i = 0; i < num; ++i)
+        {
+            auto& e = events[i];
+
+            if (e.data.u64 != 0)
+                handleEvent (e.data.u64, ((e.events & EPOLLIN) != 0 ? readyForReading : 0)
+                                           | ((e.events & EPOLLOUT) != 0 ? readyForWriting : 0)
+                                           | ((e.events & (EPOLLERR | EPOLLHUP)) != 0 ? errorOccurred : 0));
+        }
+    }
+
+private:
+    int epollFD = epoll_create1 (EPOLL_CLOEXEC);
+    int wakeFD = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    bool control (int operation, int handle, uint64 id, int flags)
+    {
+        epoll_event e = {};
+        e.events = (uint32) EPOLLONESHOT
+                     | ((flags & readyForReading) != 0 ? (uint32) EPOLLIN : 0u)
+                     | ((flags & readyForWriting) != 0 ? (uint32) EPOLLOUT : 0u);
+        e.data.u64 = id;
+
+        return epoll_ctl (epollFD, operation, handle, &e) == 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Poller)
+};
+
+#elif JUCE_MAC || JUCE_IOS || JUCE_BSD
+
+struct SocketReactor::Poller
+{
+    Poller()
+    {
+        struct kevent e;
+        EV_SET (&e, 0, EVFILT_USER, EV_ADD, 0, 0, nullptr);
+        kevent (kq, &e, 1, nullptr, 0, nullptr);
+    }
+
+    ~Poller()
+    {
+        ::close (kq);
+    }
+
+    bool add (int handle, uint64 id, int flags)      { return change (handle, id, flags, EV_ADD | EV_DISPATCH); }
+    void rearm (int handle, uint64 id, int flags)    { change (handle, id, flags, EV_ADD | EV_DISPATCH); }
+    void remove (int handle, int flags)              { change (handle, 0, flags, EV_DELETE); }
+
+    // the user event isn't cleared, so every thread's wait returns straight away from now on
+    void wakeAllThreads()
+    {
+        struct kevent e;
+        EV_SET (&e, 0, EVFILT_USER, 0, NOTE_TRIGGER, 0, nullptr);
+        kevent (kq, &e, 1, nullptr, 0, nullptr);
+    }
+
+    template <typename HandlerFn>
+    void wait (int timeoutMs, HandlerFn&& handleEvent)
+    {
+        struct timespec timeout = { timeoutMs / 1000, (timeoutMs % 1000) * 1000000 };
+        struct kevent events[32];
+        auto num = kevent (kq, nullptr, 0, events, (int) numElementsInArray (events), &timeout);
+
+        for (int i = 0; i < num; ++i)
+        {
+            auto& e = events[i];
+
+            if (e.filter != EVFILT_USER)
+                handleEvent ((uint64) (pointer_sized_uint) e.udata,
+                             (e.filter == EVFILT_READ ? readyForReading : readyForWriting)
+                               | ((e.flags & (EV_EOF | EV_ERROR)) != 0 ? errorOccurred : 0));
+        }
+    }
+
+private:
+    int kq = kqueue();
+
+    bool change (int handle, uint64 id, int flags, int action)
+    {
+        struct kevent changes[2];
+        int numChanges = 0;
+
+        if ((flags & readyForReading) != 0)
+            EV_SET (&changes[numChanges++], handle, EVFILT_READ, action, 0, 0, (void*) (pointer_sized_uint) id);
+
+        if ((flags & readyForWriting) != 0)
+            EV_SET (&changes[numChanges++], handle, EVFILT_WRITE, action, 0, 0, (void*) (pointer_sized_uint) id);
+
+        return kevent (kq, changes, numChanges, nullptr, 0, nullptr) == 0;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Poller)
+};
+
+#else
+
+struct SocketReactor::Poller
+{
+    Poller()
+    {
+        wakeSocket.bindToPort (0, "127.0.0.1");
+
+        // (looked up at runtime, as some older SDKs only declare it when targeting Vista or later)
+        pollSockets = (PollFunction) GetProcAddress (GetModuleHandleA ("ws2_32.dll"), "WSAPoll");
+    }
+
+    bool add (int handle, uint64 id, int flags)
+    {
+        {
+            const ScopedLock sl (lock);
+            entries.add ({ handle, id, flags, true });
+        }
+
+        wakeOneThread();
+        return pollSockets != nullptr;
+    }
+
+    void rearm (int, uint64 id, int)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            for (auto& e : entries)
+                if (e.id == id)
+                    e.armed = true;
+        }
+
+        wakeOneThread();
+    }
+
+    void remove (int handle, int)
+    {
+        const ScopedLock sl (lock);
+
+        for (int i = entries.size(); --i >= 0;)
+            if (entries.getReference (i).handle == handle)
+                entries.remove (i);
+    }
+
+    void wakeAllThreads()
+    {
+        shuttingDown = true;
+        wakeOneThread();
+    }
+
+    template <typename HandlerFn>
+    void wait (int timeoutMs, HandlerFn&& handleEvent)
+    {
+        std::vector<PollFD> fds;
+        std::vector<uint64> ids;
+
+        {
+            const ScopedLock sl (lock);
+
+            fds.push_back ({ (SOCKET) wakeSocket.getRawSocketHandle(), pollIn, 0 });
+            ids.push_back (0);
+
+            for (auto& e : entries)
+            {
+                if (e.armed)
+                {
+                    fds.push_back ({ (SOCKET) e.handle, (SHORT) (((e.flags & readyForReading) != 0 ? pollIn : 0)
+                                                                   | ((e.flags & readyForWriting) != 0 ? pollOut : 0)), 0 });
+                    ids.push_back (e.id);
+                }
+            }
+        }
+
+        if (pollSockets == nullptr)
+        {
+            Thread::sleep (timeoutMs);
+            return;
+        }
+
+        // Adding or re-arming a socket wakes up one of the waiting threads so that it can
+        // start watching it, but the timeout is kept short in case a different thread
+        // was the one that got woken.
+        if (pollSockets (fds.data(), (ULONG) fds.size(), jmin (timeoutMs, 50)) <= 0)
+            return;
+
+        if (fds[0].revents != 0 && ! shuttingDown)
+        {
+            char buffer[64];
+
+            while (wakeSocket.waitUntilReady (true, 0) == 1 && wakeSocket.read (buffer, (int) sizeof (buffer), false) > 0)
+            {}
+        }
+
+        for (size_t i = 1; i < fds.size(); ++i)
+        {
+            auto revents = fds[i].revents;
+
+            if (revents == 0)
+                continue;
+
+            bool wasArmed = false;
+
+            {
+                const ScopedLock sl (lock);
+
+                for (auto& e : entries)
+                {
+                    if (e.id == ids[i] && e.armed)
+                    {
+                        e.armed = false;
+                        wasArmed = true;
+                    }
+                }
+            }
+
+            if (wasArmed)
+                handleEvent (ids[i], ((revents & pollIn) != 0 ? readyForReading : 0)
+                                       | ((revents & pollOut) != 0 ? readyForWriting : 0)
+                                       | ((revents & (pollErr | pollHup | pollInvalid)) != 0 ? errorOccurred : 0));
+        }
+    }
+
+private:
+    // (this matches the layout of WSAPOLLFD)
+    struct PollFD
+    {
+        SOCKET fd;
+        SHORT events, revents;
+    };
+
+    enum { pollIn = 0x0100, pollOut = 0x0010, pollErr = 0x0001, pollHup = 0x0002, pollInvalid = 0x0004 };
+
+    typedef int (WINAPI* PollFunction) (PollFD*, ULONG, INT);
+
+    struct Entry
+    {
+        int handle;
+        uint64 id;
+        int flags;
+        bool armed;
+    };
+
+    CriticalSection lock;
+    Array<Entry> entries;
+    DatagramSocket wakeSocket;
+    PollFunction pollSockets = nullptr;
+    std::atomic<bool> shuttingDown { false };
+
+    void wakeOneThread()
+    {
+        char c = 0;
+        wakeSocket.write ("127.0.0.1", wakeSocket.getBoundPort(), &c, 1);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Poller)
+};
+
+#endif
+
+//==============================================================================
+SocketReactor::SocketReactor (int numThreads)  : numThreadsToUse (jmax (1, numThreads))
+{
+}
+
+SocketReactor::~SocketReactor()
+{
+    shouldExit = true;
+
+    if (poller != nullptr)
+        poller->wakeAllThreads();
+
+    for (auto* t : threads)
+        t->stopThread (10000);
+
+    threads.clear();
+
+    for (auto& r : registrations)
+        delete r.second;
+}
+
+bool SocketReactor::addSocket (StreamingSocket& socket, int flagsToWatch, Callback callback)
+{
+    return addHandle (socket.getRawSocketHandle(), flagsToWatch, std::move (callback));
+}
+
+bool SocketReactor::addSocket (DatagramSocket& socket, int flagsToWatch, Callback callback)
+{
+    return addHandle (socket.getRawSocketHandle(), flagsToWatch, std::move (callback));
+}
+
+void SocketReactor::removeSocket (StreamingSocket& socket)    { removeHandle (socket.getRawSocketHandle()); }
+void SocketReactor::removeSocket (DatagramSocket& socket)     { removeHandle (socket.getRawSocketHandle()); }
+
+int SocketReactor::getNumSockets() const
+{
+    const ScopedLock sl (lock);
+    return (int) registrations.size();
+}
+
+bool SocketReactor::addHandle (int handle, int flagsToWatch, Callback callback)
+{
+    flagsToWatch &= (readyForReading | readyForWriting);
+
+    // you need to give it something to watch for, and something to call!
+    jassert (flagsToWatch != 0 && callback != nullptr);
+
+    if (handle < 0 || flagsToWatch == 0 || callback == nullptr)
+        return false;
+
+    const ScopedLock sl (lock);
+
+    if (poller == nullptr)
+    {
+        poller.reset (new Poller());
+
+        for (int i = 0; i < numThreadsToUse; ++i)
+        {
+            threads.add (new ReactorThread (*this));
+            threads.getLast()->startThread();
+        }
+    }
+
+    auto id = ++lastRegistrationID;
+    auto* reg = new Registration (handle, flagsToWatch, std::move (callback));
+    registrations[id] = reg;
+
+    if (poller->add (handle, id, flagsToWatch))
+        return true;
+
+    registrations.erase (id);
+    delete reg;
+    return false;
+}
+
+void SocketReactor::removeHandle (int handle)
+{
+    WaitableEvent removalFinished;
+
+    {
+        const ScopedLock sl (lock);
+
+        auto found = std::find_if (registrations.begin(), registrations.end(),
+                                   [handle] (const std::pair<const uint64, Registration*>& r) { return r.second->handle == handle; });
+
+        if (found == registrations.end())
+            return;
+
+        auto* reg = found->second;
+        poller->remove (handle, reg->flags);
+        registrations.erase (found);
+
+        if (reg->callbackThread == nullptr)
+        {
+            delete reg;
+            return;
+        }
+
+        // the callback is running, so the thread that's running it will delete it
+        reg->removed = true;
+
+        if (reg->callbackThread == Thread::getCurrentThreadId())
+            return;
+
+        reg->removalFinished = &removalFinished;
+    }
+
+    removalFinished.wait();
+}
+
+void SocketReactor::runThread (ReactorThread& thread)
+{
+    while (! (shouldExit || thread.threadShouldExit()))
+        poller->wait (500, [this] (uint64 id, int flags) { handleEvent (id, flags); });
+}
+
+void SocketReactor::handleEvent (uint64 registrationID, int readinessFlags)
+{
+    Registration* reg = nullptr;
+
+    {
+        const ScopedLock sl (lock);
+
+        auto found = registrations.find (registrationID);
+
+        if (found == registrations.end())
+            return;
+
+        reg = found->second;
+
+        // (kqueue reports reading and writing separately, so they may arrive on different threads)
+        if (reg->callbackThread != nullptr)
+        {
+            reg->pendingFlags |= readinessFlags;
+            return;
+        }
+
+        reg->callbackThread = Thread::getCurrentThreadId();
+    }
+
+    for (;;)
+    {
+        auto keepWatching = reg->callback (readinessFlags);
+
+        const ScopedLock sl (lock);
+
+        if (! (keepWatching || reg->removed))
+        {
+            poller->remove (reg->handle, reg->flags);
+            registrations.erase (registrationID);
+            reg->removed = true;
+        }
+
+        if (reg->removed)
+        {
+            if (reg->removalFinished != nullptr)
+                reg->removalFinished->signal();
+
+            delete reg;
+            return;
+        }
+
+        if (reg->pendingFlags == 0)
+        {
+            reg->callbackThread = nullptr;
+            poller->rearm (reg->handle, registrationID, reg->flags);
+            return;
+        }
+
+        readinessFlags = reg->pendingFlags;
+        reg->pendingFlags = 0;
+    }
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct SocketReactorTests  : public UnitTest
+{
+    SocketReactorTests()  : UnitTest ("SocketReactor", "Networking") {}
+
+    void runTest() override
+    {
+        beginTest ("Echo server");
+        {
+            enum { numClients = 20, numMessages = 10 };
+
+            SocketReactor reactor (2);
+            StreamingSocket listener;
+            expect (listener.createListener (0, "127.0.0.1"));
+
+            CriticalSection lock;
+            OwnedArray<StreamingSocket> accepted;
+            std::atomic<int> numBytesEchoed { 0 };
+
+            expect (reactor.addSocket (listener, SocketReactor::readyForReading, [&] (int)
+            {
+                if (auto* s = listener.waitForNextConnection())
+                {
+                    {
+                        const ScopedLock sl (lock);
+                        accepted.add (s);
+                    }
+
+                    reactor.addSocket (*s, SocketReactor::readyForReading, [s, &numBytesEchoed] (int)
+                    {
+                        char buffer[256];
+                        auto num = s->read (buffer, (int) sizeof (buffer), false);
+
+                        if (num <= 0)
+                            return false;
+
+                        numBytesEchoed += num;
+                        return s->write (buffer, num) == num;
+                    });
+                }
+
+                return true;
+            }));
+
+            OwnedArray<StreamingSocket> clients;
+
+            for (int i = 0; i < numClients; ++i)
+            {
+                clients.add (new StreamingSocket());
+                expect (clients.getLast()->connect ("127.0.0.1", listener.getBoundPort(), 1000));
+            }
+
+            bool allEchoed = true;
+
+            for (int m = 0; m < numMessages; ++m)
+            {
+                for (int i = 0; i < numClients; ++i)
+                {
+                    auto message = "message " + String (m) + " from " + String (i);
+                    clients[i]->write (message.toRawUTF8(), message.length());
+                }
+
+                for (int i = 0; i < numClients; ++i)
+                {
+                    auto message = "message " + String (m) + " from " + String (i);
+                    HeapBlock<char> reply ((size_t) message.length() + 1, true);
+
+                    allEchoed = allEchoed && clients[i]->waitUntilReady (true, 2000) == 1
+                                  && clients[i]->read (reply, message.length(), true) == message.length()
+                                  && message == String (reply.get());
+                }
+            }
+
+            expect (allEchoed);
+            expectEquals (reactor.getNumSockets(), numClients + 1);
+
+            // closing the clients makes the server's sockets readable with nothing to read,
+            // so their callbacks return false and they're removed
+            clients.clear();
+
+            for (int i = 0; i < 200 && reactor.getNumSockets() > 1; ++i)
+                Thread::sleep (5);
+
+            expectEquals (reactor.getNumSockets(), 1);
+
+            reactor.removeSocket (listener);
+            expectEquals (reactor.getNumSockets(), 0);
+        }
+
+        beginTest ("Removing from a callback");
+        {
+            SocketReactor reactor (1);
+            DatagramSocket receiver, sender;
+            expect (receiver.bindToPort (0, "127.0.0.1"));
+
+            WaitableEvent called;
+            std::atomic<int> numCalls { 0 };
+
+            reactor.addSocket (receiver, SocketReactor::readyForReading, [&] (int)
+            {
+                char buffer[16];
+                receiver.read (buffer, (int) sizeof (buffer), false);
+                ++numCalls;
+                reactor.removeSocket (receiver);
+                called.signal();
+                return true;
+            });
+
+            sender.write ("127.0.0.1", receiver.getBoundPort(), "x", 1);
+            expect (called.wait (2000));
+
+            sender.write ("127.0.0.1", receiver.getBoundPort(), "y", 1);
+            Thread::sleep (50);
+            expectEquals (numCalls.load(), 1);
+            expectEquals (reactor.getNumSockets(), 0);
+        }
+    }
+};
+
+static SocketReactorTests socketReactorTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Watches a large number of sockets, and calls back when any of them are ready.
+
+    Rather than needing a thread for each socket that's blocked in a read, a reactor
+    uses the OS's most efficient readiness mechanism (epoll on Linux and Android, kqueue
+    on Apple systems and BSD, and WSAPoll on Windows) to share a small number of threads
+    between all the sockets it's watching.
+
+    When a socket becomes ready, its callback is invoked on one of the reactor's threads.
+    A socket's callback is never called on more than one thread at a time, and the socket
+    isn't watched again until the callback has returned, so the callback can read whatever
+    is available without worrying about another thread doing the same. Callbacks should
+    avoid blocking, as that would hold up the other sockets sharing the thread.
+
+    @see StreamingSocket, DatagramSocket, InterprocessConnectionServer
+
+    @tags{Core}
+*/
+class JUCE_API  SocketReactor  final
+{
+public:
+    //==============================================================================
+    /** Creates a reactor which will use the given number of threads.
+        The threads aren't started until the first socket is added.
+    */
+    explicit SocketReactor (int numThreads = 2);
+
+    /** Destructor.
+        Any sockets that are still being watched are removed, but not closed.
+    */
+    ~SocketReactor();
+
+    //==============================================================================
+    /** Flags used to say which kinds of readiness to watch for, and which have happened. */
+    enum ReadinessFlags
+    {
+        readyForReading     = 1,    /**< Data can be read, a connection can be accepted, or the peer has closed. */
+        readyForWriting     = 2,    /**< There's room to write more data. */
+        errorOccurred       = 4     /**< The socket had an error or was hung up (only used in callbacks). */
+    };
+
+    /** The function that's called when a socket is ready.
+        It's given a combination of ReadinessFlags, and should return true to carry on
+        watching the socket, or false to stop.
+    */
+    using Callback = std::function<bool (int readinessFlags)>;
+
+    /** Starts watching a socket.
+
+        The socket must stay open until it has been removed (either with removeSocket(),
+        or by returning false from the callback).
+
+        @param socket           the socket to watch - this must not already be in the reactor
+        @param flagsToWatch     a combination of readyForReading and readyForWriting
+        @param callback         the function to call each time the socket becomes ready
+        @returns true if the socket was added
+    */
+    bool addSocket (StreamingSocket& socket, int flagsToWatch, Callback callback);
+
+    /** Starts watching a datagram socket.
+        @see addSocket
+    */
+    bool addSocket (DatagramSocket& socket, int flagsToWatch, Callback callback);
+
+    /** Stops watching a socket.
+
+        If the socket's callback is running on another thread, this waits for it to
+        finish, so once this returns, the callback won't be called again. It's fine to
+        call this from inside the socket's own callback.
+    */
+    void removeSocket (StreamingSocket& socket);
+
+    /** Stops watching a datagram socket.
+        @see removeSocket
+    */
+    void removeSocket (DatagramSocket& socket);
+
+    /** Returns the number of sockets that are currently being watched. */
+    int getNumSockets() const;
+
+private:
+    //==============================================================================
+    struct Registration;
+    struct Poller;
+    struct ReactorThread;
+
+    const int numThreadsToUse;
+    std::unique_ptr<Poller> poller;
+    OwnedArray<ReactorThread> threads;
+    CriticalSection lock;
+    std::map<uint64, Registration*> registrations;
+    uint64 lastRegistrationID = 0;
+    std::atomic<bool> shouldExit { false };
+
+    friend class ChildProcess;
+    bool addHandle (int handle, int flagsToWatch, Callback);
+    void removeHandle (int handle);
+    void runThread (ReactorThread&);
+    void handleEvent (uint64 registrationID, int readinessFlags);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SocketReactor)
+};
+
+} // namespace juce
@@ -37,6 +37,26 @@ static inline int calcBufferStreamBufferSize (int requestedSize, InputStream* so
     return requestedSize;
 }
 
+//==============================================================================
+struct BufferedInputStream::ReadAheadJob  : public ThreadPoolJob
+{
+    ReadAheadJob (BufferedInputStream& s)  : ThreadPoolJob ("BufferedInputStream read-ahead"), owner (s) {}
+
+    JobStatus runJob() override
+    {
+        owner.readAheadNumBytes = owner.source->setPosition (owner.readAheadStart)
+                                    ? jmax (0, owner.source->read (owner.readAheadBuffer, owner.bufferSize))
+                                    : 0;
+        hasRun = true;
+        return jobHasFinished;
+    }
+
+    BufferedInputStream& owner;
+    bool hasRun = false;
+
+    JUCE_DECLARE_NON_COPYABLE (ReadAheadJob)
+};
+
 //==============================================================================
 BufferedInputStream::BufferedInputStream (InputStream* sourceStream, int size, bool takeOwnership)
    : source (sourceStream, takeOwnership),
@@ -54,6 +74,43 @@ BufferedInputStream::BufferedInputStream (InputStream& sourceStream, int size)
 
 BufferedInputStream::~BufferedInputStream()
 {
+    if (readAheadPool != nullptr)
+        waitForReadAhead();
+}
+
+//==============================================================================
+void BufferedInputStream::enableReadAhead (ThreadPool& poolToUse)
+{
+    jassert (readAheadPool == nullptr); // this can only be enabled once
+
+    if (readAheadPool == nullptr)
+    {
+        readAheadBuffer.malloc (bufferSize);
+        readAheadJob.reset (new ReadAheadJob (*this));
+        readAheadPool = &poolToUse;
+    }
+}
+
+void BufferedInputStream::startReadAhead()
+{
+    readAheadStart = lastReadPos;
+    readAheadNumBytes = 0;
+    readAheadJob->hasRun = false;
+    readAheadPool->addJob (readAheadJob.get(), false);
+}
+
+void BufferedInputStream::waitForReadAhead()
+{
+    // if the job hasn't started yet, this just takes it out of the queue
+    readAheadPool->removeJob (readAheadJob.get(), false, -1);
+
+    if (! readAheadJob->hasRun)
+        readAheadStart = -1;
+}
+
+bool BufferedInputStream::isInReadAheadBuffer (int64 pos) const noexcept
+{
+    return readAheadStart >= 0 && pos >= readAheadStart && pos < readAheadStart + readAheadNumBytes;
 }
 
 //==============================================================================
@@ -67,6 +124,9 @@ char BufferedInputStream::peekByte()
 
 int64 BufferedInputStream::getTotalLength()
 {
+    if (readAheadPool != nullptr)
+        waitForReadAhead();
+
     return source->getTotalLength();
 }
 
@@ -83,11 +143,25 @@ bool BufferedInputStream::setPosition (int64 newPosition)
 
 bool BufferedInputStream::isExhausted()
 {
-    return position >= lastReadPos && source->isExhausted();
+    if (position < lastReadPos)
+        return false;
+
+    if (readAheadPool != nullptr)
+    {
+        waitForReadAhead();
+
+        if (isInReadAheadBuffer (position))
+            return false;
+    }
+
+    return source->isExhausted();
 }
 
 bool BufferedInputStream::ensureBuffered()
 {
+    if (readAheadPool != nullptr)
+        return ensureBufferedWithReadAhead();
+
     auto bufferEndOverlap = lastReadPos - bufferOverlap;
 
     if (position < bufferStart || position >= bufferEndOverlap)
@@ -133,6 +207,46 @@ bool BufferedInputStream::ensureBuffered()
     return true;
 }
 
+bool BufferedInputStream::ensureBufferedWithReadAhead()
+{
+    if (position >= bufferStart && position < lastReadPos)
+        return true;
+
+    waitForReadAhead();
+
+    int bytesRead;
+
+    if (isInReadAheadBuffer (position))
+    {
+        buffer.swapWith (readAheadBuffer);
+        bufferStart = readAheadStart;
+        bytesRead = readAheadNumBytes;
+    }
+    else
+    {
+        bufferStart = position;
+
+        if (! source->setPosition (bufferStart))
+            return false;
+
+        bytesRead = source->read (buffer, bufferSize);
+
+        if (bytesRead < 0)
+            return false;
+    }
+
+    lastReadPos = bufferStart + bytesRead;
+    readAheadStart = -1;
+
+    if (bytesRead > 0 && ! source->isExhausted())
+        startReadAhead();
+
+    while (bytesRead < bufferSize)
+        buffer[bytesRead++] = 0;
+
+    return true;
+}
+
 int BufferedInputStream::read (void* destBuffer, int maxBytesToRead)
 {
     jassert (destBuffer != nullptr && maxBytesToRead >= 0);
@@ -266,6 +380,48 @@ struct BufferedInputStreamTests   : public UnitTest
         expectEquals (stream.getPosition(), (int64) data.getSize());
         expectEquals (stream.getNumBytesRemaining(), (int64) 0);
         expect (stream.isExhausted());
+
+        beginTest ("Read-ahead");
+        {
+            MemoryBlock bigData (100000);
+            Random r (1);
+
+            for (size_t i = 0; i < bigData.getSize(); ++i)
+                bigData[i] = (char) r.nextInt (256);
+
+            MemoryInputStream bigSource (bigData, false);
+            ThreadPool pool (1);
+            BufferedInputStream aheadStream (bigSource, 1000);
+            aheadStream.enableReadAhead (pool);
+
+            MemoryBlock result (bigData.getSize());
+            int pos = 0;
+
+            while (! aheadStream.isExhausted())
+            {
+                auto numRead = aheadStream.read (static_cast<char*> (result.getData()) + pos,
+                                                 jmin (1 + r.nextInt (700), (int) bigData.getSize() - pos));
+                expect (numRead > 0);
+                pos += numRead;
+                expectEquals (aheadStream.getPosition(), (int64) pos);
+            }
+
+            expectEquals (pos, (int) bigData.getSize());
+            expect (result == bigData);
+
+            for (int i = 0; i < 50; ++i)
+            {
+                auto start = r.nextInt ((int) bigData.getSize() - 3000);
+                aheadStream.setPosition (start);
+                expectEquals (aheadStream.peekByte(), bigData[(size_t) start]);
+
+                char chunk[3000];
+                expectEquals (aheadStream.read (chunk, 3000), 3000);
+                expect (memcmp (chunk, bigData.begin() + start, 3000) == 0);
+            }
+
+            expectEquals (aheadStream.getTotalLength(), (int64) bigData.getSize());
+        }
     }
 };
 
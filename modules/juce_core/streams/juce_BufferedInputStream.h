@@ -23,6 +23,8 @@
 namespace juce
 {
 
+class ThreadPool;
+
 //==============================================================================
 /** Wraps another input stream, and reads from it using an intermediate buffer
 
@@ -63,6 +65,21 @@ public:
     */
     ~BufferedInputStream() override;
 
+    //==============================================================================
+    /** Makes the stream fill a second buffer on a background thread while the current
+        one is being read.
+
+        Once this is enabled, whenever the stream has to move on to a new section of the
+        source, it starts a job on the pool that reads the following section into a back
+        buffer, so that reading sequentially through a slow source doesn't have to wait
+        for each block. If the stream is moved somewhere else, the back buffer is just
+        discarded.
+
+        After calling this, the source stream mustn't be used directly by anything else,
+        as it may be in use on one of the pool's threads. The pool must also outlive
+        this object.
+    */
+    void enableReadAhead (ThreadPool& poolToUse);
 
     //==============================================================================
     /** Returns the next byte that would be read by a call to readByte() */
@@ -82,7 +99,19 @@ private:
     int bufferSize;
     int64 position, lastReadPos = 0, bufferStart, bufferOverlap = 128;
     HeapBlock<char> buffer;
+
+    struct ReadAheadJob;
+    std::unique_ptr<ReadAheadJob> readAheadJob;
+    ThreadPool* readAheadPool = nullptr;
+    HeapBlock<char> readAheadBuffer;
+    int64 readAheadStart = -1;
+    int readAheadNumBytes = 0;
+
     bool ensureBuffered();
+    bool ensureBufferedWithReadAhead();
+    void startReadAhead();
+    void waitForReadAhead();
+    bool isInReadAheadBuffer (int64) const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferedInputStream)
 };
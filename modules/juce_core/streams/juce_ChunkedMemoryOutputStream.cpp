@@ -0,0 +1,261 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+ChunkedMemoryOutputStream::ChunkedMemoryOutputStream (size_t sizeOfEachChunk)
+    : chunkSize (jmax ((size_t) 16, sizeOfEachChunk))
+{
+}
+
+ChunkedMemoryOutputStream::~ChunkedMemoryOutputStream() {}
+
+void ChunkedMemoryOutputStream::reset() noexcept
+{
+    position = 0;
+    size = 0;
+}
+
+char* ChunkedMemoryOutputStream::getChunk (size_t index)
+{
+    while ((size_t) chunks.size() <= index)
+        chunks.add (new MemoryBlock (chunkSize));
+
+    return static_cast<char*> (chunks.getUnchecked ((int) index)->getData());
+}
+
+template <typename CopyFunction>
+void ChunkedMemoryOutputStream::writeInChunks (size_t numBytes, CopyFunction&& copy)
+{
+    while (numBytes > 0)
+    {
+        auto offset = position % chunkSize;
+        auto numThisTime = jmin (numBytes, chunkSize - offset);
+
+        copy (getChunk (position / chunkSize) + offset, numThisTime);
+
+        position += numThisTime;
+        numBytes -= numThisTime;
+    }
+
+    size = jmax (size, position);
+}
+
+bool ChunkedMemoryOutputStream::write (const void* buffer, size_t howMany)
+{
+    jassert (buffer != nullptr || howMany == 0);
+    auto* source = static_cast<const char*> (buffer);
+
+    writeInChunks (howMany, [&] (char* dest, size_t num)
+    {
+        memcpy (dest, source, num);
+        source += num;
+    });
+
+    return true;
+}
+
+bool ChunkedMemoryOutputStream::writeRepeatedByte (uint8 byte, size_t howMany)
+{
+    writeInChunks (howMany, [=] (char* dest, size_t num) { memset (dest, byte, num); });
+    return true;
+}
+
+int64 ChunkedMemoryOutputStream::writeFromInputStream (InputStream& source, int64 maxNumBytesToWrite)
+{
+    if (maxNumBytesToWrite < 0)
+        maxNumBytesToWrite = std::numeric_limits<int64>::max();
+
+    int64 numWritten = 0;
+
+    // read straight into the chunks, rather than going via a temporary buffer
+    while (numWritten < maxNumBytesToWrite)
+    {
+        auto offset = position % chunkSize;
+        auto numToRead = (int) jmin ((int64) (chunkSize - offset), maxNumBytesToWrite - numWritten,
+                                     (int64) std::numeric_limits<int>::max());
+
+        auto numRead = source.read (getChunk (position / chunkSize) + offset, numToRead);
+
+        if (numRead <= 0)
+            break;
+
+        position += (size_t) numRead;
+        size = jmax (size, position);
+        numWritten += numRead;
+    }
+
+    return numWritten;
+}
+
+bool ChunkedMemoryOutputStream::setPosition (int64 newPosition)
+{
+    if (newPosition <= (int64) size)
+    {
+        // ok to seek backwards
+        position = jlimit ((size_t) 0, size, (size_t) newPosition);
+        return true;
+    }
+
+    // can't move beyond the end of the stream..
+    return false;
+}
+
+Array<OutputStream::Buffer> ChunkedMemoryOutputStream::getBuffers() const
+{
+    Array<Buffer> buffers;
+    buffers.ensureStorageAllocated ((int) ((size + chunkSize - 1) / chunkSize));
+
+    for (size_t start = 0; start < size; start += chunkSize)
+        buffers.add ({ chunks.getUnchecked ((int) (start / chunkSize))->getData(), jmin (chunkSize, size - start) });
+
+    return buffers;
+}
+
+bool ChunkedMemoryOutputStream::writeTo (OutputStream& destStream) const
+{
+    auto buffers = getBuffers();
+    return destStream.writeGathered (buffers.begin(), buffers.size());
+}
+
+MemoryBlock ChunkedMemoryOutputStream::getMemoryBlock() const
+{
+    MemoryBlock block (size);
+    auto* dest = static_cast<char*> (block.getData());
+
+    for (auto& b : getBuffers())
+    {
+        memcpy (dest, b.data, b.numBytes);
+        dest += b.numBytes;
+    }
+
+    return block;
+}
+
+String ChunkedMemoryOutputStream::toUTF8() const
+{
+    return getMemoryBlock().toString();
+}
+
+String ChunkedMemoryOutputStream::toString() const
+{
+    auto block = getMemoryBlock();
+    return String::createStringFromData (block.getData(), (int) block.getSize());
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ChunkedMemoryOutputStreamTests  : public UnitTest
+{
+public:
+    ChunkedMemoryOutputStreamTests()
+        : UnitTest ("ChunkedMemoryOutputStream", "Streams")
+    {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        MemoryBlock reference (10000);
+
+        for (size_t i = 0; i < reference.getSize(); ++i)
+            reference[i] = (char) r.nextInt (256);
+
+        beginTest ("Writing");
+        {
+            ChunkedMemoryOutputStream stream (100);
+            MemoryOutputStream expected;
+            auto* source = static_cast<const char*> (reference.getData());
+
+            for (size_t pos = 0; pos < reference.getSize();)
+            {
+                auto num = jmin ((size_t) r.nextInt (350), reference.getSize() - pos);
+                expect (stream.write (source + pos, num));
+                expected.write (source + pos, num);
+                pos += num;
+
+                if (r.nextInt (5) == 0)
+                {
+                    auto numRepeats = (size_t) r.nextInt (250);
+                    expect (stream.writeRepeatedByte (0x55, numRepeats));
+                    expected.writeRepeatedByte (0x55, numRepeats);
+                }
+            }
+
+            expectEquals ((int) stream.getDataSize(), (int) expected.getDataSize());
+            expect (stream.getMemoryBlock() == expected.getMemoryBlock());
+
+            auto buffers = stream.getBuffers();
+            expectEquals (buffers.size(), (int) ((stream.getDataSize() + 99) / 100));
+
+            for (int i = 0; i < buffers.size() - 1; ++i)
+                expectEquals ((int) buffers.getReference (i).numBytes, 100);
+
+            MemoryOutputStream copy;
+            expect (stream.writeTo (copy));
+            expect (copy.getMemoryBlock() == expected.getMemoryBlock());
+        }
+
+        beginTest ("Seeking");
+        {
+            ChunkedMemoryOutputStream stream (64);
+            stream.write (reference.getData(), 1000);
+
+            expect (! stream.setPosition (1001));
+            expect (stream.setPosition (50));
+            stream.write ("abcdefghijklmnopqrstuvwxyz", 26);
+            expectEquals (stream.getPosition(), (int64) 76);
+            expectEquals ((int) stream.getDataSize(), 1000);
+
+            MemoryBlock expected (reference.getData(), 1000);
+            expected.copyFrom ("abcdefghijklmnopqrstuvwxyz", 50, 26);
+            expect (stream.getMemoryBlock() == expected);
+
+            stream.reset();
+            expectEquals ((int) stream.getDataSize(), 0);
+            expectEquals (stream.getBuffers().size(), 0);
+        }
+
+        beginTest ("Writing from a stream");
+        {
+            ChunkedMemoryOutputStream stream (333);
+            stream << "header";
+
+            MemoryInputStream source (reference, false);
+            expectEquals (stream.writeFromInputStream (source, -1), (int64) reference.getSize());
+
+            MemoryOutputStream expected;
+            expected << "header" << reference;
+            expect (stream.getMemoryBlock() == expected.getMemoryBlock());
+            expectEquals (stream.toUTF8().substring (0, 6), String ("header"));
+        }
+    }
+};
+
+static ChunkedMemoryOutputStreamTests chunkedMemoryOutputStreamTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Writes data into a list of fixed-size blocks of memory.
+
+    Unlike a MemoryOutputStream, which keeps all of its data in one contiguous block
+    that has to be reallocated and copied each time it grows, this just adds another
+    chunk when it runs out of space, so the data that has already been written never
+    gets moved. That makes it a better choice for building up large amounts of data,
+    e.g. when serialising a big document or preparing a network payload, because the
+    memory used never gets much bigger than the data itself.
+
+    Once the data has been written, you can use getBuffers() to pass the chunks to
+    OutputStream::writeGathered() or StreamingSocket::writeGathered() without having
+    to join them together first.
+
+    @see MemoryOutputStream
+
+    @tags{Core}
+*/
+class JUCE_API  ChunkedMemoryOutputStream  : public OutputStream
+{
+public:
+    //==============================================================================
+    /** Creates an empty stream.
+        @param chunkSize    the size of each of the blocks of memory that the data is stored in
+    */
+    explicit ChunkedMemoryOutputStream (size_t chunkSize = 64 * 1024);
+
+    /** Destructor. */
+    ~ChunkedMemoryOutputStream() override;
+
+    //==============================================================================
+    /** Returns the number of bytes of data that have been written to the stream. */
+    size_t getDataSize() const noexcept                 { return size; }
+
+    /** Returns the size of each of the blocks that the data is stored in. */
+    size_t getChunkSize() const noexcept                { return chunkSize; }
+
+    /** Returns the blocks of memory that hold the stream's data, in order.
+
+        Each one is getChunkSize() bytes long, apart from the last one, which may be
+        shorter. The pointers remain valid until the stream is reset or deleted, but
+        writing more data may change the contents of the last block.
+    */
+    Array<Buffer> getBuffers() const;
+
+    /** Writes all the stream's data to another stream, using a single call to its
+        writeGathered() method.
+        @returns false if the write fails
+    */
+    bool writeTo (OutputStream& destStream) const;
+
+    /** Returns a contiguous copy of the stream's data as a memory block. */
+    MemoryBlock getMemoryBlock() const;
+
+    /** Returns a String created from the (UTF8) data that has been written to the stream. */
+    String toUTF8() const;
+
+    /** Attempts to detect the encoding of the data and convert it to a string.
+        @see String::createStringFromData
+    */
+    String toString() const;
+
+    /** Clears any data that has been written to the stream.
+        The chunks that were allocated are kept, so that they can be re-used.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    void flush() override {}
+    bool write (const void*, size_t) override;
+    int64 getPosition() override                        { return (int64) position; }
+    bool setPosition (int64) override;
+    int64 writeFromInputStream (InputStream&, int64 maxNumBytesToWrite) override;
+    bool writeRepeatedByte (uint8 byte, size_t numTimesToRepeat) override;
+
+private:
+    //==============================================================================
+    OwnedArray<MemoryBlock> chunks;
+    const size_t chunkSize;
+    size_t position = 0, size = 0;
+
+    char* getChunk (size_t index);
+
+    template <typename CopyFunction>
+    void writeInChunks (size_t numBytes, CopyFunction&&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChunkedMemoryOutputStream)
+};
+
+} // namespace juce
@@ -188,6 +188,37 @@ public:
         expectEquals (stream.getPosition(), (int64) data.getSize());
         expectEquals (stream.getNumBytesRemaining(), (int64) 0);
         expect (stream.isExhausted());
+
+        beginTest ("Gathered writes");
+
+        OutputStream::Buffer buffers[] = { { "abc", 3 }, { nullptr, 0 }, { "defghij", 7 } };
+        MemoryOutputStream gathered;
+        expect (gathered.writeGathered (buffers, numElementsInArray (buffers)));
+        expectEquals (gathered.toString(), String ("abcdefghij"));
+
+        char fixedBuffer[8];
+        MemoryOutputStream tooSmall (fixedBuffer, sizeof (fixedBuffer));
+        expect (! tooSmall.writeGathered (buffers, numElementsInArray (buffers)));
+
+        beginTest ("Releasing the memory block");
+
+        auto sizeBeforeRelease = mo.getDataSize();
+        auto released = mo.releaseMemoryBlock();
+
+        expectEquals ((int) released.getSize(), (int) sizeBeforeRelease);
+        expectEquals ((int) mo.getDataSize(), 0);
+
+        mo << "after";
+        expectEquals (mo.toString(), String ("after"));
+
+        MemoryBlock external;
+        {
+            MemoryOutputStream toExternal (external, false);
+            toExternal << "external";
+            expect (toExternal.releaseMemoryBlock().toString() == "external");
+            expectEquals ((int) toExternal.getDataSize(), 8);
+        }
+        expect (external.toString() == "external");
     }
 
     static String createRandomWideCharString (Random& r)
@@ -115,6 +115,35 @@ bool MemoryOutputStream::write (const void* const buffer, size_t howMany)
     return false;
 }
 
+bool MemoryOutputStream::writeGathered (const Buffer* buffers, int numBuffers)
+{
+    jassert (buffers != nullptr || numBuffers == 0);
+    size_t totalBytes = 0;
+
+    for (int i = 0; i < numBuffers; ++i)
+        totalBytes += buffers[i].numBytes;
+
+    if (totalBytes == 0)
+        return true;
+
+    // make room for all of it at once, so the block only needs to grow once
+    if (auto* dest = prepareToWrite (totalBytes))
+    {
+        for (int i = 0; i < numBuffers; ++i)
+        {
+            if (buffers[i].numBytes > 0)
+            {
+                memcpy (dest, buffers[i].data, buffers[i].numBytes);
+                dest += buffers[i].numBytes;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
 bool MemoryOutputStream::writeRepeatedByte (uint8 byte, size_t howMany)
 {
     if (howMany == 0)
@@ -145,6 +174,19 @@ MemoryBlock MemoryOutputStream::getMemoryBlock() const
     return MemoryBlock (getData(), getDataSize());
 }
 
+MemoryBlock MemoryOutputStream::releaseMemoryBlock()
+{
+    if (blockToUse != &internalBlock)
+        return getMemoryBlock();
+
+    internalBlock.setSize (size);
+    MemoryBlock result (std::move (internalBlock));
+
+    internalBlock.reset();
+    reset();
+    return result;
+}
+
 const void* MemoryOutputStream::getData() const noexcept
 {
     if (blockToUse == nullptr)
@@ -101,6 +101,17 @@ public:
     /** Returns a copy of the stream's data as a memory block. */
     MemoryBlock getMemoryBlock() const;
 
+    /** Moves the stream's data out into a MemoryBlock and resets the stream.
+
+        If the stream was created with its own internal storage, this hands over that
+        storage without copying it, which avoids needing space for two copies of a large
+        block. If it's writing into a MemoryBlock or buffer that you supplied, this just
+        returns a copy of the data, and leaves the stream unchanged.
+
+        @see getMemoryBlock
+    */
+    MemoryBlock releaseMemoryBlock();
+
     //==============================================================================
     /** If the stream is writing to a user-supplied MemoryBlock, this will trim any excess
         capacity off the block, so that its length matches the amount of actual data that
@@ -109,6 +120,7 @@ public:
     void flush() override;
 
     bool write (const void*, size_t) override;
+    bool writeGathered (const Buffer*, int) override;
     int64 getPosition() override                                 { return (int64) position; }
     bool setPosition (int64) override;
     int64 writeFromInputStream (InputStream&, int64 maxNumBytesToWrite) override;
@@ -74,6 +74,17 @@ bool OutputStream::writeByte (char byte)
     return write (&byte, 1);
 }
 
+bool OutputStream::writeGathered (const Buffer* buffers, int numBuffers)
+{
+    jassert (buffers != nullptr || numBuffers == 0);
+
+    for (int i = 0; i < numBuffers; ++i)
+        if (buffers[i].numBytes > 0 && ! write (buffers[i].data, buffers[i].numBytes))
+            return false;
+
+    return true;
+}
+
 bool OutputStream::writeRepeatedByte (uint8 byte, size_t numTimesToRepeat)
 {
     for (size_t i = 0; i < numTimesToRepeat; ++i)
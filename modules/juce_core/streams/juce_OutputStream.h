@@ -82,6 +82,24 @@ public:
     virtual bool write (const void* dataToWrite,
                         size_t numberOfBytes) = 0;
 
+    /** Describes one of the blocks of data passed to writeGathered(). */
+    struct Buffer
+    {
+        const void* data;
+        size_t numBytes;
+    };
+
+    /** Writes a sequence of separate blocks of data to the stream, one after the other.
+
+        The result is the same as calling write() for each block in turn, which is what
+        the default implementation does, but some streams can do this more efficiently,
+        e.g. by making sure they've got enough space for all of it before they start.
+
+        @returns false if any of the write operations fail
+        @see ChunkedMemoryOutputStream::getBuffers
+    */
+    virtual bool writeGathered (const Buffer* buffers, int numBuffers);
+
     //==============================================================================
     /** Writes a single byte to the stream.
         @returns false if the write operation fails for some reason
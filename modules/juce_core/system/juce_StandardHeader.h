@@ -45,6 +45,7 @@
 //==============================================================================
 #include <memory>
 #include <cmath>
+#include <cfloat>
 #include <vector>
 #include <iostream>
 #include <functional>
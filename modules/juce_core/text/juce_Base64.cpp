@@ -23,86 +23,305 @@
 namespace juce
 {
 
-bool Base64::convertToBase64 (OutputStream& base64Result, const void* sourceData, size_t sourceDataSize)
+struct Base64Helpers
 {
-    static const char lookup[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    auto* source = static_cast<const uint8*> (sourceData);
+    enum
+    {
+        invalidChar  = 0xff,
+        paddingChar  = 64,
+        encodeChunkSize = 3 * 1024,   // (a multiple of 3, so only the last chunk needs padding)
+        decodeChunkSize = 4 * 1024    // (a multiple of 4, so that the chunks don't split any groups)
+    };
 
-    while (sourceDataSize > 0)
+    static const char* getEncodingTable() noexcept
     {
-        char frame[4];
-        auto byte0 = *source++;
-        frame[0] = lookup [(byte0 & 0xfcu) >> 2];
-        uint32 bits = (byte0 & 0x03u) << 4;
+        return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    }
 
-        if (sourceDataSize > 1)
+    struct DecodingTable
+    {
+        DecodingTable() noexcept
         {
-            auto byte1 = *source++;
-            frame[1] = lookup[bits | ((byte1 & 0xf0u) >> 4)];
-            bits = (byte1 & 0x0fu) << 2;
+            for (auto& v : values)
+                v = invalidChar;
+
+            auto* encodingTable = getEncodingTable();
+
+            for (int i = 0; i < 64; ++i)
+                values[(uint8) encodingTable[i]] = (uint8) i;
+
+            values[(uint8) '='] = paddingChar;
+        }
+
+        uint8 values[256];
+    };
+
+    template <typename CharType>
+    static uint32 decodeChar (CharType c) noexcept
+    {
+        static const DecodingTable table;
+        auto code = (uint32) c;
+        return code < 256 ? table.values[code] : (uint32) invalidChar;
+    }
+
+   #if JUCE_USE_BASE64_INTRINSICS
+    /*  These are compiled for SSSE3 regardless of the compiler's target flags, and are
+        only used once SystemStats has confirmed that the CPU supports it.
+    */
+    #if JUCE_MSVC
+     #define JUCE_BASE64_TARGET
+    #else
+     #define JUCE_BASE64_TARGET __attribute__ ((target ("ssse3")))
+    #endif
+
+    static bool canUseSSSE3() noexcept
+    {
+        static const bool canUse = SystemStats::hasSSSE3();
+        return canUse;
+    }
+
+    // Encodes 12 bytes from the source as 16 characters, reading 16 bytes from the source.
+    static JUCE_BASE64_TARGET void encode12Bytes (const uint8* source, char* dest) noexcept
+    {
+        auto input = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) source),
+                                       _mm_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+        // split each group of 3 bytes into four 6-bit values, one per byte
+        auto indexes = _mm_or_si128 (_mm_mulhi_epu16 (_mm_and_si128 (input, _mm_set1_epi32 (0x0fc0fc00)), _mm_set1_epi32 (0x04000040)),
+                                     _mm_mullo_epi16 (_mm_and_si128 (input, _mm_set1_epi32 (0x003f03f0)), _mm_set1_epi32 (0x01000010)));
+
+        // then find the offset that turns each value into its character: 0-25 map to 13, 26-51
+        // to 0, 52-61 to 1-10, and 62 and 63 to 11 and 12, which selects an offset from the table
+        auto ranges = _mm_subs_epu8 (indexes, _mm_set1_epi8 (51));
+        ranges = _mm_or_si128 (ranges, _mm_and_si128 (_mm_cmpgt_epi8 (_mm_set1_epi8 (26), indexes), _mm_set1_epi8 (13)));
+
+        auto offsets = _mm_shuffle_epi8 (_mm_setr_epi8 ('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                                        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0),
+                                         ranges);
+
+        _mm_storeu_si128 ((__m128i*) dest, _mm_add_epi8 (indexes, offsets));
+    }
+
+    static JUCE_BASE64_TARGET __m128i isInRange (__m128i input, char low, char high) noexcept
+    {
+        return _mm_and_si128 (_mm_cmpgt_epi8 (input, _mm_set1_epi8 ((char) (low - 1))),
+                              _mm_cmpgt_epi8 (_mm_set1_epi8 ((char) (high + 1)), input));
+    }
+
+    // Decodes 16 characters into 12 bytes (writing 16 bytes to the destination), or returns
+    // false if the block contains anything other than the 64 encoding characters.
+    static JUCE_BASE64_TARGET bool decode16Chars (const char* source, uint8* dest) noexcept
+    {
+        auto input = _mm_loadu_si128 ((const __m128i*) source);
+
+        auto upper = isInRange (input, 'A', 'Z');
+        auto lower = isInRange (input, 'a', 'z');
+        auto digit = isInRange (input, '0', '9');
+        auto plus  = _mm_cmpeq_epi8 (input, _mm_set1_epi8 ('+'));
+        auto slash = _mm_cmpeq_epi8 (input, _mm_set1_epi8 ('/'));
+
+        auto valid = _mm_or_si128 (_mm_or_si128 (_mm_or_si128 (upper, lower), _mm_or_si128 (digit, plus)), slash);
+
+        if (_mm_movemask_epi8 (valid) != 0xffff)
+            return false;
+
+        auto offsets = _mm_or_si128 (_mm_or_si128 (_mm_and_si128 (upper, _mm_set1_epi8 (-'A')),
+                                                   _mm_and_si128 (lower, _mm_set1_epi8 (26 - 'a'))),
+                                     _mm_or_si128 (_mm_or_si128 (_mm_and_si128 (digit, _mm_set1_epi8 (52 - '0')),
+                                                                 _mm_and_si128 (plus,  _mm_set1_epi8 (62 - '+'))),
+                                                   _mm_and_si128 (slash, _mm_set1_epi8 (63 - '/'))));
+
+        auto values = _mm_add_epi8 (input, offsets);
+
+        // merge each group of four 6-bit values into 24 bits, then pack the bytes together
+        auto merged = _mm_madd_epi16 (_mm_maddubs_epi16 (values, _mm_set1_epi32 (0x01400140)), _mm_set1_epi32 (0x00011000));
+
+        _mm_storeu_si128 ((__m128i*) dest, _mm_shuffle_epi8 (merged, _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+        return true;
+    }
+   #endif
 
-            if (sourceDataSize > 2)
+    //==============================================================================
+    // Encodes some data, padding the end if its size isn't a multiple of 3, and returns the number of characters written.
+    static size_t encode (const uint8* source, size_t numBytes, char* dest) noexcept
+    {
+        auto* lookup = getEncodingTable();
+        auto* start = dest;
+
+       #if JUCE_USE_BASE64_INTRINSICS
+        if (canUseSSSE3())
+        {
+            for (; numBytes >= 16; numBytes -= 12, source += 12, dest += 16)
+                encode12Bytes (source, dest);
+        }
+       #endif
+
+        for (; numBytes >= 3; numBytes -= 3, source += 3, dest += 4)
+        {
+            auto bits = ((uint32) source[0] << 16) | ((uint32) source[1] << 8) | source[2];
+
+            dest[0] = lookup[bits >> 18];
+            dest[1] = lookup[(bits >> 12) & 0x3f];
+            dest[2] = lookup[(bits >> 6) & 0x3f];
+            dest[3] = lookup[bits & 0x3f];
+        }
+
+        if (numBytes > 0)
+        {
+            auto bits = ((uint32) source[0] << 16) | (numBytes > 1 ? ((uint32) source[1] << 8) : 0u);
+
+            dest[0] = lookup[bits >> 18];
+            dest[1] = lookup[(bits >> 12) & 0x3f];
+            dest[2] = numBytes > 1 ? lookup[(bits >> 6) & 0x3f] : '=';
+            dest[3] = '=';
+            dest += 4;
+        }
+
+        return (size_t) (dest - start);
+    }
+
+    // Decodes some text and writes it to a stream, returning false if it's not valid base-64.
+    template <typename CharType>
+    static bool decode (OutputStream& binaryOutput, const CharType* text, size_t numChars)
+    {
+        uint8 buffer[decodeChunkSize + 16];
+        size_t numBytes = 0;
+        bool ok = true;
+
+        while (ok && numChars > 0)
+        {
+            if (numBytes > decodeChunkSize)
             {
-                auto byte2 = *source++;
-                frame[2] = lookup[bits | ((byte2 & 0xc0u) >> 6)];
-                frame[3] = lookup[byte2 & 0x3fu];
-                sourceDataSize -= 3;
+                if (! binaryOutput.write (buffer, numBytes))
+                    return false;
+
+                numBytes = 0;
             }
-            else
+
+           #if JUCE_USE_BASE64_INTRINSICS
+            if (sizeof (CharType) == 1 && numChars >= 16 && canUseSSSE3()
+                 && decode16Chars (reinterpret_cast<const char*> (text), buffer + numBytes))
             {
-                frame[2] = lookup[bits];
-                frame[3] = '=';
-                sourceDataSize = 0;
+                text += 16;
+                numChars -= 16;
+                numBytes += 12;
+                continue;
             }
-        }
-        else
-        {
-            frame[1] = lookup[bits];
-            frame[2] = '=';
-            frame[3] = '=';
-            sourceDataSize = 0;
+           #endif
+
+            if (numChars < 4)
+            {
+                ok = false;
+                break;
+            }
+
+            auto c0 = decodeChar (text[0]);
+            auto c1 = decodeChar (text[1]);
+            auto c2 = decodeChar (text[2]);
+            auto c3 = decodeChar (text[3]);
+
+            if (c0 >= paddingChar || c1 >= paddingChar || c2 == invalidChar || c3 == invalidChar)
+            {
+                ok = false;
+                break;
+            }
+
+            buffer[numBytes++] = (uint8) ((c0 << 2) | (c1 >> 4));
+
+            if (c2 < paddingChar)
+            {
+                buffer[numBytes++] = (uint8) ((c1 << 4) | (c2 >> 2));
+
+                if (c3 < paddingChar)
+                    buffer[numBytes++] = (uint8) ((c2 << 6) | c3);
+            }
+
+            text += 4;
+            numChars -= 4;
         }
 
-        if (! base64Result.write (frame, 4))
+        return (numBytes == 0 || binaryOutput.write (buffer, numBytes)) && ok;
+    }
+};
+
+//==============================================================================
+bool Base64::convertToBase64 (OutputStream& base64Result, const void* sourceData, size_t sourceDataSize)
+{
+    auto* source = static_cast<const uint8*> (sourceData);
+    char buffer[(Base64Helpers::encodeChunkSize / 3) * 4];
+
+    while (sourceDataSize > 0)
+    {
+        auto numBytes = jmin (sourceDataSize, (size_t) Base64Helpers::encodeChunkSize);
+
+        if (! base64Result.write (buffer, Base64Helpers::encode (source, numBytes, buffer)))
             return false;
+
+        source += numBytes;
+        sourceDataSize -= numBytes;
     }
 
     return true;
 }
 
-bool Base64::convertFromBase64 (OutputStream& binaryOutput, StringRef base64TextInput)
+bool Base64::convertToBase64 (OutputStream& base64Result, InputStream& binarySource)
 {
-    for (auto s = base64TextInput.text; ! s.isEmpty();)
+    uint8 buffer[Base64Helpers::encodeChunkSize];
+
+    for (;;)
     {
-        uint8 data[4];
+        int numRead = 0;
 
-        for (int i = 0; i < 4; ++i)
+        // keep reading until the buffer is full, so that padding only appears at the end
+        while (numRead < (int) sizeof (buffer))
         {
-            auto c = (uint32) s.getAndAdvance();
+            auto num = binarySource.read (buffer + numRead, (int) sizeof (buffer) - numRead);
 
-            if (c >= 'A' && c <= 'Z')         c -= 'A';
-            else if (c >= 'a' && c <= 'z')    c -= 'a' - 26;
-            else if (c >= '0' && c <= '9')    c += 52 - '0';
-            else if (c == '+')                c = 62;
-            else if (c == '/')                c = 63;
-            else if (c == '=')                { c = 64; if (i <= 1) return false; }
-            else                              return false;
+            if (num <= 0)
+                break;
 
-            data[i] = (uint8) c;
+            numRead += num;
         }
 
-        binaryOutput.writeByte ((char) ((data[0] << 2) | (data[1] >> 4)));
-
-        if (data[2] < 64)
-        {
-            binaryOutput.writeByte ((char) ((data[1] << 4) | (data[2] >> 2)));
+        if (! convertToBase64 (base64Result, buffer, (size_t) numRead))
+            return false;
 
-            if (data[3] < 64)
-                binaryOutput.writeByte ((char) ((data[2] << 6) | data[3]));
-        }
+        if (numRead < (int) sizeof (buffer))
+            return true;
     }
+}
 
-    return true;
+bool Base64::convertFromBase64 (OutputStream& binaryOutput, StringRef base64TextInput)
+{
+    auto text = base64TextInput.text;
+    auto numChars = text.sizeInBytes() / sizeof (*text.getAddress()) - 1;
+
+    return Base64Helpers::decode (binaryOutput, text.getAddress(), numChars);
+}
+
+bool Base64::convertFromBase64 (OutputStream& binaryOutput, InputStream& base64Source)
+{
+    char buffer[Base64Helpers::decodeChunkSize];
+    int numInBuffer = 0;
+
+    for (;;)
+    {
+        auto numRead = base64Source.read (buffer + numInBuffer, (int) sizeof (buffer) - numInBuffer);
+
+        if (numRead <= 0)
+            return numInBuffer == 0;
+
+        numInBuffer += numRead;
+
+        // only decode complete groups of 4, and keep any others for the next time round
+        auto numToDecode = numInBuffer & ~3;
+
+        if (! Base64Helpers::decode (binaryOutput, buffer, (size_t) numToDecode))
+            return false;
+
+        numInBuffer -= numToDecode;
+        memmove (buffer, buffer + numToDecode, (size_t) numInBuffer);
+    }
 }
 
 String Base64::toBase64 (const void* sourceData, size_t sourceDataSize)
@@ -154,6 +373,100 @@ public:
             auto result = out.getMemoryBlock();
             expect (result == original);
         }
+
+        beginTest ("Known values");
+        {
+            const char* const values[][2] = { { "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+                                              { "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+                                              { "The quick brown fox jumps over the lazy dog!?",
+                                                "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZyE/" } };
+
+            for (auto& v : values)
+            {
+                expectEquals (Base64::toBase64 (String (v[0])), String (v[1]));
+
+                MemoryOutputStream out;
+                expect (Base64::convertFromBase64 (out, v[1]));
+                expectEquals (out.toString(), String (v[0]));
+            }
+
+            for (int i = 1000; --i >= 0;)
+            {
+                auto original = createRandomData (r);
+                expectEquals (Base64::toBase64 (original.getData(), original.getSize()), referenceEncode (original));
+            }
+        }
+
+        beginTest ("Invalid input");
+        {
+            for (auto* text : { "Zg=", "Z===", "Zm9v*m9v", "Zm9vYmFyZm9vYmFyZm9vYmFy Zm9vYmFy", "Zm9vYmFyZm9vYmFyZm9vYmF\xc3\xa9Zm9vYmFy" })
+            {
+                MemoryOutputStream out;
+                expect (! Base64::convertFromBase64 (out, String::fromUTF8 (text)));
+            }
+        }
+
+        beginTest ("Streams");
+        {
+            for (int i = 20; --i >= 0;)
+            {
+                MemoryOutputStream data;
+
+                for (int j = r.nextInt (20000); --j >= 0;)
+                    data.writeByte ((char) r.nextInt (256));
+
+                auto original = data.getMemoryBlock();
+                MemoryInputStream binarySource (original, false);
+                MemoryOutputStream asBase64;
+                expect (Base64::convertToBase64 (asBase64, binarySource));
+                expectEquals (asBase64.toString(), Base64::toBase64 (original.getData(), original.getSize()));
+
+                MemoryInputStream base64Source (asBase64.getData(), asBase64.getDataSize(), false);
+                MemoryOutputStream decoded;
+                expect (Base64::convertFromBase64 (decoded, base64Source));
+                expect (decoded.getMemoryBlock() == original);
+            }
+        }
+
+        beginTest ("MemoryBlock encoding");
+        {
+            for (int i = 1000; --i >= 0;)
+            {
+                auto original = createRandomData (r);
+                auto encoded = original.toBase64Encoding();
+
+                String expected (String ((int) original.getSize()) + ".");
+
+                for (size_t bit = 0; bit < original.getSize() * 8; bit += 6)
+                    expected << ".ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+"[original.getBitRange (bit, 6)];
+
+                expectEquals (encoded, expected);
+
+                MemoryBlock decoded;
+                expect (decoded.fromBase64Encoding (encoded));
+                expect (decoded == original);
+            }
+        }
+    }
+
+    static String referenceEncode (const MemoryBlock& data)
+    {
+        static const char lookup[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        String result;
+
+        for (size_t i = 0; i < data.getSize(); i += 3)
+        {
+            auto numBytes = jmin ((size_t) 3, data.getSize() - i);
+            uint32 bits = 0;
+
+            for (size_t j = 0; j < 3; ++j)
+                bits = (bits << 8) | (j < numBytes ? (uint8) data[i + j] : 0u);
+
+            for (size_t j = 0; j < 4; ++j)
+                result << (j <= numBytes ? lookup[(bits >> (18 - 6 * j)) & 0x3f] : '=');
+        }
+
+        return result;
     }
 };
 
@@ -37,12 +37,28 @@ struct JUCE_API Base64
     */
     static bool convertToBase64 (OutputStream& base64Result, const void* sourceData, size_t sourceDataSize);
 
+    /** Reads all the remaining data from a stream and writes it to another stream as base-64.
+        The data is converted in chunks as it's read, so this never needs to hold the whole
+        of it in memory. If a write error occurs with the stream, the method will terminate
+        and return false.
+    */
+    static bool convertToBase64 (OutputStream& base64Result, InputStream& binarySource);
+
     /** Converts a base-64 string back to its binary representation.
         This will write the decoded binary data to the given stream.
-        If the string is not valid base-64, the method will terminate and return false.
+        If the string is not valid base-64, or a write error occurs with the stream, the
+        method will terminate and return false.
     */
     static bool convertFromBase64 (OutputStream& binaryOutput, StringRef base64TextInput);
 
+    /** Reads all the remaining base-64 text from a stream, and writes its binary representation
+        to another stream.
+        The text is decoded in chunks as it's read, so this never needs to hold the whole of it
+        in memory. If the text is not valid base-64, or a write error occurs with the stream, the
+        method will terminate and return false.
+    */
+    static bool convertFromBase64 (OutputStream& binaryOutput, InputStream& base64Source);
+
     /** Converts a block of binary data to a base-64 string. */
     static String toBase64 (const void* sourceData, size_t sourceDataSize);
 
@@ -266,6 +266,34 @@ public:
         return count;
     }
 
+    /** Returns the number of bytes that would be needed to represent the given
+        UTF-8 string in this encoding format.
+        The value returned does NOT include the terminating null character.
+    */
+    static size_t getBytesRequiredFor (CharPointer_UTF8 text) noexcept
+    {
+        auto* s = text.getAddress();
+        auto* end = s + strlen (s);
+        size_t count = 0;
+
+        for (;;)
+        {
+            auto numASCIIBytes = CharPointer_UTF8::getNumASCIIBytes (s, (size_t) (end - s));
+            count += numASCIIBytes * sizeof (CharType);
+            text = CharPointer_UTF8 (s + numASCIIBytes);
+
+            auto n = text.getAndAdvance();
+
+            if (n == 0)
+                break;
+
+            count += getBytesRequiredFor (n);
+            s = text.getAddress();
+        }
+
+        return count;
+    }
+
     /** Returns a pointer to the null character that terminates this string. */
     CharPointer_UTF16 findTerminatingNull() const noexcept
     {
@@ -284,6 +312,36 @@ public:
         CharacterFunctions::copyAll (*this, src);
     }
 
+    /** Copies a source string to this pointer, advancing this pointer as it goes. */
+    void writeAll (CharPointer_UTF8 src) noexcept
+    {
+        auto* s = src.getAddress();
+        auto* end = s + strlen (s);
+
+        for (;;)
+        {
+            // runs of ASCII can be widened directly, without decoding each character
+            auto numASCIIBytes = CharPointer_UTF8::getNumASCIIBytes (s, (size_t) (end - s));
+            auto* d = data;
+
+            for (size_t i = 0; i < numASCIIBytes; ++i)
+                d[i] = (CharType) (uint8) s[i];
+
+            data = d + numASCIIBytes;
+            src = CharPointer_UTF8 (s + numASCIIBytes);
+
+            auto c = src.getAndAdvance();
+
+            if (c == 0)
+                break;
+
+            write (c);
+            s = src.getAddress();
+        }
+
+        writeNull();
+    }
+
     /** Copies a source string to this pointer, advancing this pointer as it goes. */
     void writeAll (CharPointer_UTF16 src) noexcept
     {
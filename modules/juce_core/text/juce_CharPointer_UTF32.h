@@ -214,6 +214,36 @@ public:
         CharacterFunctions::copyAll (*this, src);
     }
 
+    /** Copies a source string to this pointer, advancing this pointer as it goes. */
+    void writeAll (CharPointer_UTF8 src) noexcept
+    {
+        auto* s = src.getAddress();
+        auto* end = s + strlen (s);
+
+        for (;;)
+        {
+            // runs of ASCII can be widened directly, without decoding each character
+            auto numASCIIBytes = CharPointer_UTF8::getNumASCIIBytes (s, (size_t) (end - s));
+            auto* d = data;
+
+            for (size_t i = 0; i < numASCIIBytes; ++i)
+                d[i] = (CharType) (uint8) s[i];
+
+            data = d + numASCIIBytes;
+            src = CharPointer_UTF8 (s + numASCIIBytes);
+
+            auto c = src.getAndAdvance();
+
+            if (c == 0)
+                break;
+
+            write (c);
+            s = src.getAddress();
+        }
+
+        writeNull();
+    }
+
     /** Copies a source string to this pointer, advancing this pointer as it goes. */
     void writeAll (CharPointer_UTF32 src) noexcept
     {
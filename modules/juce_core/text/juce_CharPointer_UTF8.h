@@ -236,22 +236,41 @@ public:
     /** Returns the number of characters in this string. */
     size_t length() const noexcept
     {
-        auto* d = data;
-        size_t count = 0;
+        // Every byte begins a new character, except for continuation bytes (10xxxxxx) that
+        // follow a byte with its top bit set. This counts those 8 bytes at a time.
+        auto numBytes = strlen (data);
+        size_t count = 0, i = 0;
+        uint64 previousHighBit = 0;
 
-        for (;;)
+        for (; i + 8 <= numBytes; i += 8)
         {
-            auto n = (uint32) (uint8) *d++;
+            uint64 block;
+            memcpy (&block, data + i, sizeof (block));
+            block = ByteOrder::swapIfBigEndian (block);
 
-            if ((n & 0x80) != 0)
+            auto highBits = block & 0x8080808080808080ULL;
+
+            if (highBits == 0)
             {
-                while ((*d & 0xc0) == 0x80)
-                    ++d;
+                count += 8;
+                previousHighBit = 0;
+                continue;
             }
-            else if (n == 0)
-                break;
 
-            ++count;
+            auto continuationBytes = highBits & ~(block << 1);
+            auto followingHighBits = (highBits << 8) | previousHighBit;
+            count += 8 - (size_t) countNumberOfBits (continuationBytes & followingHighBits);
+            previousHighBit = highBits >> 56;
+        }
+
+        for (; i < numBytes; ++i)
+        {
+            auto n = (uint8) data[i];
+
+            if ((n & 0xc0) != 0x80 || previousHighBit == 0)
+                ++count;
+
+            previousHighBit = n & 0x80;
         }
 
         return count;
@@ -492,8 +511,18 @@ public:
     /** Returns true if this data contains a valid string in this encoding. */
     static bool isValidString (const CharType* dataToTest, int maxBytesToRead)
     {
-        while (--maxBytesToRead >= 0 && *dataToTest != 0)
+        for (;;)
         {
+            if (maxBytesToRead > 0)
+            {
+                auto numASCIIBytes = (int) getNumASCIIBytes (dataToTest, (size_t) maxBytesToRead);
+                dataToTest += numASCIIBytes;
+                maxBytesToRead -= numASCIIBytes;
+            }
+
+            if (--maxBytesToRead < 0 || *dataToTest == 0)
+                break;
+
             auto byte = (signed char) *dataToTest++;
 
             if (byte < 0)
@@ -530,6 +559,32 @@ public:
         return true;
     }
 
+    /** Returns the number of bytes at the start of a block of UTF-8 data that are non-null
+        7-bit ASCII characters, stopping after maxBytes.
+
+        This checks 8 bytes at a time, so is a fast way to skip over the runs of plain ASCII
+        that make up most real-world text.
+    */
+    static size_t getNumASCIIBytes (const CharType* text, size_t maxBytes) noexcept
+    {
+        size_t i = 0;
+
+        for (; i + 8 <= maxBytes; i += 8)
+        {
+            uint64 block;
+            memcpy (&block, text + i, sizeof (block));
+
+            // (the second term has a top bit set in any byte that's zero)
+            if (((block | ((block - 0x0101010101010101ULL) & ~block)) & 0x8080808080808080ULL) != 0)
+                break;
+        }
+
+        while (i < maxBytes && (signed char) text[i] > 0)
+            ++i;
+
+        return i;
+    }
+
     /** Atomically swaps this pointer for a new value, returning the previous value. */
     CharPointer_UTF8 atomicSwap (const CharPointer_UTF8 newValue)
     {
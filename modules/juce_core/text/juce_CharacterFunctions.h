@@ -297,11 +297,23 @@ public:
         bool decimalPointFound = false;
         int extraExponent = 0;
 
+        // Most numbers have few enough digits to be converted exactly without needing strtod
+        uint64 fastMantissa = 0;
+        int fastMantissaDigits = 0, fastExponent = 0;
+        bool anyDigitsFound = false;
+
         for (;;)
         {
             if (text.isDigit())
             {
                 auto digit = (int) text.getAndAdvance() - '0';
+                anyDigitsFound = true;
+
+                if ((fastMantissa != 0 || digit != 0) && ++fastMantissaDigits <= 15)
+                    fastMantissa = fastMantissa * 10 + (uint64) digit;
+
+                if (decimalPointFound)
+                    --fastExponent;
 
                 if (decimalPointFound)
                 {
@@ -373,6 +385,7 @@ public:
                     exponent = (exponent * 10) + digit;
             }
 
+            fastExponent += parsedExponentIsPositive ? exponent : -exponent;
             exponent = extraExponent + (parsedExponentIsPositive ? exponent : -exponent);
 
             if (exponent < 0)
@@ -391,6 +404,22 @@ public:
             writeExponentDigits (extraExponent, currentCharacter);
         }
 
+       #if defined (FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+        // Both the mantissa and the power of 10 are exact doubles here, so a single
+        // multiply or divide gives the correctly rounded result (Clinger's fast path)
+        if (anyDigitsFound && fastMantissaDigits <= 15 && std::abs (fastExponent) <= 22)
+        {
+            static const double exactPowersOf10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                      1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+            auto result = fastExponent < 0 ? (double) fastMantissa / exactPowersOf10[-fastExponent]
+                                           : (double) fastMantissa * exactPowersOf10[fastExponent];
+
+            return buffer[0] == '-' ? -result : result;
+        }
+       #endif
+
        #if JUCE_WINDOWS
         static _locale_t locale = _create_locale (LC_ALL, "C");
         return _strtod_l (&buffer[0], nullptr, locale);
@@ -56,6 +56,13 @@ Identifier::Identifier (const char* nm)
     jassert (nm != nullptr && nm[0] != 0);
 }
 
+Identifier::Identifier (const char* literal, uint32 precalculatedHash)
+    : name (StringPool::getGlobalPool().getPooledString (literal, precalculatedHash))
+{
+    // An Identifier cannot be created from an empty string!
+    jassert (literal != nullptr && literal[0] != 0);
+}
+
 Identifier::Identifier (String::CharPointerType start, String::CharPointerType end)
     : name (StringPool::getGlobalPool().getPooledString (start, end))
 {
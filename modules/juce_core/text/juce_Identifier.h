@@ -59,6 +59,12 @@ public:
     */
     Identifier (String::CharPointerType nameStart, String::CharPointerType nameEnd);
 
+    /** Creates an identifier from a string literal, using a hash that was calculated by
+        StringPool::getHashForLiteral(). It's easiest to do this with the JUCE_IDENTIFIER macro,
+        which makes sure that the hash is worked out at compile time.
+    */
+    Identifier (const char* literal, uint32 precalculatedHash);
+
     /** Creates a copy of another identifier. */
     Identifier (const Identifier& other) noexcept;
 
@@ -129,4 +135,17 @@ private:
     String name;
 };
 
+//==============================================================================
+/** Creates an Identifier from a string literal, hashing it at compile time so that only the
+    string pool lookup has to be done at runtime.
+
+    e.g. @code
+    tree.setProperty (JUCE_IDENTIFIER ("gain"), 0.5f, nullptr);
+    @endcode
+
+    The literal must only contain ascii characters.
+*/
+#define JUCE_IDENTIFIER(literal) \
+    juce::Identifier (literal, std::integral_constant<juce::uint32, juce::StringPool::getHashForLiteral (literal)>::value)
+
 } // namespace juce
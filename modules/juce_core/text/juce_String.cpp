@@ -67,9 +67,15 @@ public:
     using CharPointerType  = String::CharPointerType;
     using CharType         = String::CharPointerType::CharType;
 
+    enum { numInlineBytes = String::numInlineBytes };
+
     //==============================================================================
-    static CharPointerType createUninitialisedBytes (size_t numBytes)
+    // If inlineStorage is non-null and big enough, it'll be used instead of a heap allocation
+    static CharPointerType createUninitialisedBytes (CharType* inlineStorage, size_t numBytes)
     {
+        if (inlineStorage != nullptr && numBytes <= numInlineBytes)
+            return CharPointerType (inlineStorage);
+
         numBytes = (numBytes + 3) & ~(size_t) 3;
         auto s = reinterpret_cast<StringHolder*> (new char [sizeof (StringHolder) - sizeof (CharType) + numBytes]);
         s->refCount.value = 0;
@@ -78,19 +84,19 @@ public:
     }
 
     template <class CharPointer>
-    static CharPointerType createFromCharPointer (const CharPointer text)
+    static CharPointerType createFromCharPointer (CharType* inlineStorage, const CharPointer text)
     {
         if (text.getAddress() == nullptr || text.isEmpty())
             return CharPointerType (&(emptyString.text));
 
         auto bytesNeeded = sizeof (CharType) + CharPointerType::getBytesRequiredFor (text);
-        auto dest = createUninitialisedBytes (bytesNeeded);
+        auto dest = createUninitialisedBytes (inlineStorage, bytesNeeded);
         CharPointerType (dest).writeAll (text);
         return dest;
     }
 
     template <class CharPointer>
-    static CharPointerType createFromCharPointer (const CharPointer text, size_t maxChars)
+    static CharPointerType createFromCharPointer (CharType* inlineStorage, const CharPointer text, size_t maxChars)
     {
         if (text.getAddress() == nullptr || text.isEmpty() || maxChars == 0)
             return CharPointerType (&(emptyString.text));
@@ -105,13 +111,13 @@ public:
             ++numChars;
         }
 
-        auto dest = createUninitialisedBytes (bytesNeeded);
+        auto dest = createUninitialisedBytes (inlineStorage, bytesNeeded);
         CharPointerType (dest).writeWithCharLimit (text, (int) numChars + 1);
         return dest;
     }
 
     template <class CharPointer>
-    static CharPointerType createFromCharPointer (const CharPointer start, const CharPointer end)
+    static CharPointerType createFromCharPointer (CharType* inlineStorage, const CharPointer start, const CharPointer end)
     {
         if (start.getAddress() == nullptr || start.isEmpty())
             return CharPointerType (&(emptyString.text));
@@ -126,38 +132,67 @@ public:
             ++numChars;
         }
 
-        auto dest = createUninitialisedBytes (bytesNeeded);
+        auto dest = createUninitialisedBytes (inlineStorage, bytesNeeded);
         CharPointerType (dest).writeWithCharLimit (start, numChars + 1);
         return dest;
     }
 
-    static CharPointerType createFromCharPointer (const CharPointerType start, const CharPointerType end)
+    static CharPointerType createFromCharPointer (CharType* inlineStorage, const CharPointerType start, const CharPointerType end)
     {
         if (start.getAddress() == nullptr || start.isEmpty())
             return CharPointerType (&(emptyString.text));
 
         auto numBytes = (size_t) (reinterpret_cast<const char*> (end.getAddress())
                                    - reinterpret_cast<const char*> (start.getAddress()));
-        auto dest = createUninitialisedBytes (numBytes + sizeof (CharType));
+        auto dest = createUninitialisedBytes (inlineStorage, numBytes + sizeof (CharType));
         memcpy (dest.getAddress(), start, numBytes);
         dest.getAddress()[numBytes / sizeof (CharType)] = 0;
         return dest;
     }
 
-    static CharPointerType createFromFixedLength (const char* const src, const size_t numChars)
+    static CharPointerType createFromFixedLength (CharType* inlineStorage, const char* const src, const size_t numChars)
     {
-        auto dest = createUninitialisedBytes (numChars * sizeof (CharType) + sizeof (CharType));
+        auto dest = createUninitialisedBytes (inlineStorage, numChars * sizeof (CharType) + sizeof (CharType));
         CharPointerType (dest).writeWithCharLimit (CharPointer_UTF8 (src), (int) (numChars + 1));
         return dest;
     }
 
     //==============================================================================
-    static void retain (const CharPointerType text) noexcept
+    static bool isInline (const String& s) noexcept
+    {
+        return s.text.getAddress() == s.inlineText;
+    }
+
+    // Returns the text for a copy of the source string, whose inline buffer is given
+    static CharPointerType share (const String& source, CharType* destInlineStorage) noexcept
     {
-        auto* b = bufferFromText (text);
+        if (isInline (source))
+        {
+            memcpy (destInlineStorage, source.inlineText, numInlineBytes);
+            return CharPointerType (destInlineStorage);
+        }
+
+        auto* b = bufferFromText (source.text);
 
         if (b != (StringHolder*) &emptyString)
             ++(b->refCount);
+
+        return source.text;
+    }
+
+    // Like share(), but leaves the source string empty rather than adding a reference
+    static CharPointerType take (String& source, CharType* destInlineStorage) noexcept
+    {
+        auto result = source.text;
+
+        if (isInline (source))
+        {
+            memcpy (destInlineStorage, source.inlineText, numInlineBytes);
+            result = CharPointerType (destInlineStorage);
+        }
+
+        source.text = &(emptyString.text);
+        return result;
     }
 
     static inline void release (StringHolder* const b) noexcept
@@ -167,41 +202,52 @@ public:
                 delete[] reinterpret_cast<char*> (b);
     }
 
-    static void release (const CharPointerType text) noexcept
+    static void release (const String& s) noexcept
     {
-        release (bufferFromText (text));
+        if (! isInline (s))
+            release (bufferFromText (s.text));
     }
 
-    static inline int getReferenceCount (const CharPointerType text) noexcept
+    static inline int getReferenceCount (const String& s) noexcept
     {
-        return bufferFromText (text)->refCount.get() + 1;
+        return isInline (s) ? 1 : bufferFromText (s.text)->refCount.get() + 1;
     }
 
     //==============================================================================
-    static CharPointerType makeUniqueWithByteSize (const CharPointerType text, size_t numBytes)
+    static CharPointerType makeUniqueWithByteSize (String& s, size_t numBytes)
     {
-        auto* b = bufferFromText (text);
+        if (isInline (s))
+        {
+            if (numBytes <= numInlineBytes)
+                return s.text;
+
+            auto newText = createUninitialisedBytes (nullptr, numBytes);
+            memcpy (newText.getAddress(), s.inlineText, numInlineBytes);
+            return newText;
+        }
+
+        auto* b = bufferFromText (s.text);
 
         if (b == (StringHolder*) &emptyString)
         {
-            auto newText = createUninitialisedBytes (numBytes);
+            auto newText = createUninitialisedBytes (s.inlineText, numBytes);
             newText.writeNull();
             return newText;
         }
 
         if (b->allocatedNumBytes >= numBytes && b->refCount.get() <= 0)
-            return text;
+            return s.text;
 
-        auto newText = createUninitialisedBytes (jmax (b->allocatedNumBytes, numBytes));
-        memcpy (newText.getAddress(), text.getAddress(), b->allocatedNumBytes);
+        auto newText = createUninitialisedBytes (nullptr, jmax (b->allocatedNumBytes, numBytes));
+        memcpy (newText.getAddress(), s.text.getAddress(), b->allocatedNumBytes);
         release (b);
 
         return newText;
     }
 
-    static size_t getAllocatedNumBytes (const CharPointerType text) noexcept
+    static size_t getAllocatedNumBytes (const String& s) noexcept
     {
-        return bufferFromText (text)->allocatedNumBytes;
+        return isInline (s) ? (size_t) numInlineBytes : bufferFromText (s.text)->allocatedNumBytes;
     }
 
     //==============================================================================
@@ -244,63 +290,89 @@ String::String() noexcept  : text (&(emptyString.text))
 
 String::~String() noexcept
 {
-    StringHolder::release (text);
+    StringHolder::release (*this);
 }
 
-String::String (const String& other) noexcept   : text (other.text)
+String::String (const String& other) noexcept   : text (StringHolder::share (other, inlineText))
 {
-    StringHolder::retain (text);
 }
 
 void String::swapWith (String& other) noexcept
 {
-    std::swap (text, other.text);
+    if (StringHolder::isInline (*this) || StringHolder::isInline (other))
+    {
+        String temp (std::move (other));
+        other = std::move (*this);
+        *this = std::move (temp);
+    }
+    else
+    {
+        std::swap (text, other.text);
+    }
 }
 
 void String::clear() noexcept
 {
-    StringHolder::release (text);
+    StringHolder::release (*this);
     text = &(emptyString.text);
 }
 
 String& String::operator= (const String& other) noexcept
 {
-    StringHolder::retain (other.text);
-    StringHolder::release (text.atomicSwap (other.text));
+    if (this != &other)
+    {
+        StringHolder::release (*this);
+        text = StringHolder::share (other, inlineText);
+    }
+
     return *this;
 }
 
-String::String (String&& other) noexcept   : text (other.text)
+String::String (String&& other) noexcept   : text (StringHolder::take (other, inlineText))
 {
-    other.text = &(emptyString.text);
 }
 
 String& String::operator= (String&& other) noexcept
 {
-    std::swap (text, other.text);
+    if (this != &other)
+    {
+        StringHolder::release (*this);
+        text = StringHolder::take (other, inlineText);
+    }
+
     return *this;
 }
 
 inline String::PreallocationBytes::PreallocationBytes (const size_t num) noexcept : numBytes (num) {}
 
 String::String (const PreallocationBytes& preallocationSize)
-    : text (StringHolder::createUninitialisedBytes (preallocationSize.numBytes + sizeof (CharPointerType::CharType)))
+    : text (StringHolder::createUninitialisedBytes (inlineText, preallocationSize.numBytes + sizeof (CharPointerType::CharType)))
 {
 }
 
 void String::preallocateBytes (const size_t numBytesNeeded)
 {
-    text = StringHolder::makeUniqueWithByteSize (text, numBytesNeeded + sizeof (CharPointerType::CharType));
+    text = StringHolder::makeUniqueWithByteSize (*this, numBytesNeeded + sizeof (CharPointerType::CharType));
 }
 
 int String::getReferenceCount() const noexcept
 {
-    return StringHolder::getReferenceCount (text);
+    return StringHolder::getReferenceCount (*this);
+}
+
+void String::moveTextToHeap()
+{
+    if (StringHolder::isInline (*this))
+    {
+        auto newText = StringHolder::createUninitialisedBytes (nullptr, numInlineBytes);
+        memcpy (newText.getAddress(), inlineText, numInlineBytes);
+        text = newText;
+    }
 }
 
 //==============================================================================
 String::String (const char* const t)
-    : text (StringHolder::createFromCharPointer (CharPointer_ASCII (t)))
+    : text (StringHolder::createFromCharPointer (inlineText, CharPointer_ASCII (t)))
 {
     /*  If you get an assertion here, then you're trying to create a string from 8-bit data
         that contains values greater than 127. These can NOT be correctly converted to unicode
@@ -323,7 +395,7 @@ String::String (const char* const t)
 }
 
 String::String (const char* const t, const size_t maxChars)
-    : text (StringHolder::createFromCharPointer (CharPointer_ASCII (t), maxChars))
+    : text (StringHolder::createFromCharPointer (inlineText, CharPointer_ASCII (t), maxChars))
 {
     /*  If you get an assertion here, then you're trying to create a string from 8-bit data
         that contains values greater than 127. These can NOT be correctly converted to unicode
@@ -345,23 +417,23 @@ String::String (const char* const t, const size_t maxChars)
     jassert (t == nullptr || CharPointer_ASCII::isValidString (t, (int) maxChars));
 }
 
-String::String (const wchar_t* const t)      : text (StringHolder::createFromCharPointer (castToCharPointer_wchar_t (t))) {}
-String::String (const CharPointer_UTF8  t)   : text (StringHolder::createFromCharPointer (t)) {}
-String::String (const CharPointer_UTF16 t)   : text (StringHolder::createFromCharPointer (t)) {}
-String::String (const CharPointer_UTF32 t)   : text (StringHolder::createFromCharPointer (t)) {}
-String::String (const CharPointer_ASCII t)   : text (StringHolder::createFromCharPointer (t)) {}
+String::String (const wchar_t* const t)      : text (StringHolder::createFromCharPointer (inlineText, castToCharPointer_wchar_t (t))) {}
+String::String (const CharPointer_UTF8  t)   : text (StringHolder::createFromCharPointer (inlineText, t)) {}
+String::String (const CharPointer_UTF16 t)   : text (StringHolder::createFromCharPointer (inlineText, t)) {}
+String::String (const CharPointer_UTF32 t)   : text (StringHolder::createFromCharPointer (inlineText, t)) {}
+String::String (const CharPointer_ASCII t)   : text (StringHolder::createFromCharPointer (inlineText, t)) {}
 
-String::String (CharPointer_UTF8  t, size_t maxChars)   : text (StringHolder::createFromCharPointer (t, maxChars)) {}
-String::String (CharPointer_UTF16 t, size_t maxChars)   : text (StringHolder::createFromCharPointer (t, maxChars)) {}
-String::String (CharPointer_UTF32 t, size_t maxChars)   : text (StringHolder::createFromCharPointer (t, maxChars)) {}
-String::String (const wchar_t* t, size_t maxChars)      : text (StringHolder::createFromCharPointer (castToCharPointer_wchar_t (t), maxChars)) {}
+String::String (CharPointer_UTF8  t, size_t maxChars)   : text (StringHolder::createFromCharPointer (inlineText, t, maxChars)) {}
+String::String (CharPointer_UTF16 t, size_t maxChars)   : text (StringHolder::createFromCharPointer (inlineText, t, maxChars)) {}
+String::String (CharPointer_UTF32 t, size_t maxChars)   : text (StringHolder::createFromCharPointer (inlineText, t, maxChars)) {}
+String::String (const wchar_t* t, size_t maxChars)      : text (StringHolder::createFromCharPointer (inlineText, castToCharPointer_wchar_t (t), maxChars)) {}
 
-String::String (CharPointer_UTF8  start, CharPointer_UTF8  end)  : text (StringHolder::createFromCharPointer (start, end)) {}
-String::String (CharPointer_UTF16 start, CharPointer_UTF16 end)  : text (StringHolder::createFromCharPointer (start, end)) {}
-String::String (CharPointer_UTF32 start, CharPointer_UTF32 end)  : text (StringHolder::createFromCharPointer (start, end)) {}
+String::String (CharPointer_UTF8  start, CharPointer_UTF8  end)  : text (StringHolder::createFromCharPointer (inlineText, start, end)) {}
+String::String (CharPointer_UTF16 start, CharPointer_UTF16 end)  : text (StringHolder::createFromCharPointer (inlineText, start, end)) {}
+String::String (CharPointer_UTF32 start, CharPointer_UTF32 end)  : text (StringHolder::createFromCharPointer (inlineText, start, end)) {}
 
-String::String (const std::string& s) : text (StringHolder::createFromFixedLength (s.data(), s.size())) {}
-String::String (StringRef s)          : text (StringHolder::createFromCharPointer (s.text)) {}
+String::String (const std::string& s) : text (StringHolder::createFromFixedLength (inlineText, s.data(), s.size())) {}
+String::String (StringRef s)          : text (StringHolder::createFromCharPointer (inlineText, s.text)) {}
 
 String String::charToString (juce_wchar character)
 {
@@ -384,14 +456,30 @@ namespace NumberToStringConverters
     template <typename Type>
     static char* printDigits (char* t, Type v) noexcept
     {
+        // Doing two digits per division halves the number of (slow) divisions needed
+        static const char digitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
         *--t = 0;
 
-        do
+        while (v >= 100)
         {
-            *--t = '0' + (char) (v % 10);
-            v /= 10;
+            auto pair = (size_t) (v % 100) * 2;
+            v /= 100;
+            t -= 2;
+            t[0] = digitPairs[pair];
+            t[1] = digitPairs[pair + 1];
+        }
 
-        } while (v > 0);
+        if (v >= 10)
+        {
+            t -= 2;
+            t[0] = digitPairs[(size_t) v * 2];
+            t[1] = digitPairs[(size_t) v * 2 + 1];
+        }
+        else
+        {
+            *--t = (char) ('0' + v);
+        }
 
         return t;
     }
@@ -446,6 +534,577 @@ namespace NumberToStringConverters
         return printDigits (t, v);
     }
 
+    //==============================================================================
+    // A fixed-size unsigned integer that's big enough for the exact arithmetic needed
+    // to print the digits of any double
+    struct DecimalBignum
+    {
+        explicit DecimalBignum (uint64 value) noexcept
+        {
+            words[0] = (uint32) value;
+            words[1] = (uint32) (value >> 32);
+            numWords = words[1] != 0 ? 2 : (words[0] != 0 ? 1 : 0);
+        }
+
+        void multiplyBy (uint32 n) noexcept
+        {
+            uint64 carry = 0;
+
+            for (int i = 0; i < numWords; ++i)
+            {
+                carry += (uint64) words[i] * n;
+                words[i] = (uint32) carry;
+                carry >>= 32;
+            }
+
+            if (carry != 0)
+            {
+                jassert (numWords < maxWords);
+                words[numWords++] = (uint32) carry;
+            }
+        }
+
+        void multiplyByPowerOf10 (int power) noexcept
+        {
+            static const uint32 powersOf10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+
+            for (; power >= 9; power -= 9)
+                multiplyBy (1000000000);
+
+            if (power > 0)
+                multiplyBy (powersOf10[power]);
+        }
+
+        void shiftLeft (int numBits) noexcept
+        {
+            if (numWords == 0)
+                return;
+
+            auto wordShift = numBits / 32;
+            auto bitShift = numBits % 32;
+
+            if (bitShift != 0)
+            {
+                uint32 carry = 0;
+
+                for (int i = 0; i < numWords; ++i)
+                {
+                    auto w = words[i];
+                    words[i] = (w << bitShift) | carry;
+                    carry = w >> (32 - bitShift);
+                }
+
+                if (carry != 0)
+                    words[numWords++] = carry;
+            }
+
+            if (wordShift != 0)
+            {
+                jassert (numWords + wordShift <= maxWords);
+                memmove (words + wordShift, words, sizeof (uint32) * (size_t) numWords);
+                zeromem (words, sizeof (uint32) * (size_t) wordShift);
+                numWords += wordShift;
+            }
+        }
+
+        int compare (const DecimalBignum& other) const noexcept
+        {
+            if (numWords != other.numWords)
+                return numWords < other.numWords ? -1 : 1;
+
+            for (int i = numWords; --i >= 0;)
+                if (words[i] != other.words[i])
+                    return words[i] < other.words[i] ? -1 : 1;
+
+            return 0;
+        }
+
+        // Subtracts the divisor as many times as possible, returning the count (which must be less than 10)
+        int extractDigit (const DecimalBignum& divisor) noexcept
+        {
+            int digit = 0;
+
+            while (compare (divisor) >= 0)
+            {
+                int64 borrow = 0;
+
+                for (int i = 0; i < numWords; ++i)
+                {
+                    auto difference = (int64) words[i] - (i < divisor.numWords ? (int64) divisor.words[i] : 0) - borrow;
+                    borrow = difference < 0 ? 1 : 0;
+                    words[i] = (uint32) difference;
+                }
+
+                while (numWords > 0 && words[numWords - 1] == 0)
+                    --numWords;
+
+                ++digit;
+            }
+
+            jassert (digit < 10);
+            return digit;
+        }
+
+        enum { maxWords = 40 };
+        uint32 words[maxWords];
+        int numWords;
+    };
+
+    // Produces the correctly-rounded decimal digits of a positive, finite value, using
+    // exact arithmetic. Halfway cases are rounded to even, which is what printf does.
+    struct ExactDecimalDigits
+    {
+        explicit ExactDecimalDigits (double value) noexcept
+        {
+            int binaryExponent;
+            auto mantissa = (uint64) std::ldexp (std::frexp (value, &binaryExponent), 53);
+            binaryExponent -= 53;
+
+            numerator = DecimalBignum (mantissa);
+
+            if (binaryExponent > 0)
+                numerator.shiftLeft (binaryExponent);
+            else
+                denominator.shiftLeft (-binaryExponent);
+
+            decimalExponent = (int) std::floor (std::log10 (value));
+
+            if (decimalExponent > 0)
+                denominator.multiplyByPowerOf10 (decimalExponent);
+            else
+                numerator.multiplyByPowerOf10 (-decimalExponent);
+
+            // the estimate can be out by one, so correct it to make 1 <= numerator / denominator < 10
+            if (numerator.compare (denominator) < 0)
+            {
+                numerator.multiplyBy (10);
+                --decimalExponent;
+            }
+            else
+            {
+                auto tenTimesDenominator = denominator;
+                tenTimesDenominator.multiplyBy (10);
+
+                if (numerator.compare (tenTimesDenominator) >= 0)
+                {
+                    denominator = tenTimesDenominator;
+                    ++decimalExponent;
+                }
+            }
+        }
+
+        // Writes the first numDigits significant digits. If the rounding carries all the way
+        // into a new leading digit, this returns true, and the digits become "1000..".
+        bool generate (char* digits, int numDigits) noexcept
+        {
+            for (int i = 0; i < numDigits; ++i)
+            {
+                digits[i] = (char) ('0' + numerator.extractDigit (denominator));
+                numerator.multiplyBy (10);
+            }
+
+            auto halfUnit = denominator;
+            halfUnit.multiplyBy (5);
+            auto comparison = numerator.compare (halfUnit);
+            auto lastDigitIsOdd = numDigits > 0 && ((digits[numDigits - 1] - '0') & 1) != 0;
+
+            if (comparison < 0 || (comparison == 0 && ! lastDigitIsOdd))
+                return false;
+
+            for (int i = numDigits; --i >= 0;)
+            {
+                if (digits[i] != '9')
+                {
+                    ++digits[i];
+                    return false;
+                }
+
+                digits[i] = '0';
+            }
+
+            return true;
+        }
+
+        DecimalBignum numerator { 0 }, denominator { 1 };
+        int decimalExponent;
+    };
+
+    static char* writeExponent (char* t, int exponent) noexcept
+    {
+        *t++ = 'e';
+        *t++ = exponent < 0 ? '-' : '+';
+        exponent = std::abs (exponent);
+
+        if (exponent < 10)
+            *t++ = '0';
+
+        char buffer[8];
+        auto* end = buffer + numElementsInArray (buffer);
+
+        for (auto* d = printDigits (end, exponent); *d != 0;)
+            *t++ = *d++;
+
+        return t;
+    }
+
+    // Writes a string of digits that represents an integer, with the last numDecimals of them
+    // placed after a decimal point
+    static char* writeFixed (char* t, const char* digits, int numDigits, int numDecimals) noexcept
+    {
+        auto numIntegerDigits = numDigits - numDecimals;
+
+        if (numIntegerDigits <= 0)
+        {
+            *t++ = '0';
+            *t++ = '.';
+
+            for (int i = numIntegerDigits; i < 0; ++i)
+                *t++ = '0';
+
+            memcpy (t, digits, (size_t) numDigits);
+            return t + numDigits;
+        }
+
+        memcpy (t, digits, (size_t) numIntegerDigits);
+        t += numIntegerDigits;
+
+        if (numDecimals > 0)
+        {
+            *t++ = '.';
+            memcpy (t, digits + numIntegerDigits, (size_t) numDecimals);
+            t += numDecimals;
+        }
+
+        return t;
+    }
+
+    // Removes any zeros at the end of the decimal part of a number, and the decimal point if nothing's left
+    static char* removeTrailingZeros (char* start, char* end) noexcept
+    {
+        if (std::find (start, end, '.') == end)
+            return end;
+
+        while (end > start && end[-1] == '0')
+            --end;
+
+        if (end > start && end[-1] == '.')
+            --end;
+
+        return end;
+    }
+
+    // Formats a number in the same way as printf's %.Nf, %.Ne or %.Ng, but much faster and without
+    // needing a locale. Returns nullptr for infinities and NaNs, or if the result wouldn't fit in a
+    // buffer of charsNeededForDouble.
+    static char* formatDouble (char* t, double n, int precision, char format) noexcept
+    {
+        enum { maxDigits = 40 };
+
+        if (! std::isfinite (n) || precision >= maxDigits)
+            return nullptr;
+
+        if (std::signbit (n))
+        {
+            *t++ = '-';
+            n = -n;
+        }
+
+        ExactDecimalDigits exact (n != 0 ? n : 1.0);
+        auto exponent = n != 0 ? exact.decimalExponent : 0;
+        auto roundsToZero = (n == 0);
+        int numDigits;
+
+        if (format == 'f')
+        {
+            numDigits = exponent + 1 + precision;
+
+            if (numDigits < 0)
+            {
+                // too small to reach the last decimal place, even when rounded
+                numDigits = 0;
+                roundsToZero = true;
+            }
+
+            if (numDigits >= maxDigits || jmax (1, numDigits - precision) + precision + 3 > (int) charsNeededForDouble)
+                return nullptr;
+        }
+        else
+        {
+            numDigits = format == 'e' ? precision + 1 : jmax (1, precision);
+        }
+
+        char digits[maxDigits + 1];
+
+        if (roundsToZero)
+        {
+            memset (digits, '0', (size_t) numDigits);
+        }
+        else if (exact.generate (digits, numDigits))
+        {
+            // the value was rounded up to the next power of 10
+            if (format == 'f')
+                digits[numDigits++] = '0';
+
+            digits[0] = '1';
+            ++exponent;
+        }
+
+        if (format == 'f')
+            return writeFixed (t, digits, numDigits, precision);
+
+        if (format == 'e')
+            return writeExponent (writeFixed (t, digits, numDigits, numDigits - 1), exponent);
+
+        // %g picks a style based on the exponent, and then removes any trailing zeros
+        auto* start = t;
+
+        if (exponent < -4 || exponent >= numDigits)
+            return writeExponent (removeTrailingZeros (start, writeFixed (t, digits, numDigits, numDigits - 1)), exponent);
+
+        return removeTrailingZeros (start, writeFixed (t, digits, numDigits, numDigits - 1 - exponent));
+    }
+
+    //==============================================================================
+    // The Grisu2 algorithm, which finds a short string of digits that will be read back as
+    // exactly the same double. It's shortest for almost all values, and never more than 17 digits.
+    // See Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers".
+    namespace Grisu
+    {
+        // A floating-point number with a 64-bit mantissa: f * 2^e
+        struct DiyFp
+        {
+            uint64 f;
+            int e;
+        };
+
+        static DiyFp multiply (DiyFp x, DiyFp y) noexcept
+        {
+            auto xLo = x.f & 0xffffffffu, xHi = x.f >> 32;
+            auto yLo = y.f & 0xffffffffu, yHi = y.f >> 32;
+
+            auto p0 = xLo * yLo, p1 = xLo * yHi, p2 = xHi * yLo, p3 = xHi * yHi;
+            auto middle = (p0 >> 32) + (p1 & 0xffffffffu) + (p2 & 0xffffffffu) + (1u << 31); // (rounds the result)
+
+            return { p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32), x.e + y.e + 64 };
+        }
+
+        static DiyFp normalise (DiyFp x) noexcept
+        {
+            while ((x.f >> 63) == 0)
+            {
+                x.f <<= 1;
+                --x.e;
+            }
+
+            return x;
+        }
+
+        struct CachedPower
+        {
+            uint64 f;
+            int e, k;
+        };
+
+        // Returns a normalised power of 10 that brings a number with binary exponent e into the range [2^-60, 2^-32]
+        static CachedPower getCachedPower (int e) noexcept
+        {
+            // These are 10^k for k = -300, -292 .. 324, rounded to 64 bits
+            static const CachedPower powers[] =
+            {
+                { 0xab70fe17c79ac6caULL, -1060, -300 },
+                { 0xff77b1fcbebcdc4fULL, -1034, -292 },
+                { 0xbe5691ef416bd60cULL, -1007, -284 },
+                { 0x8dd01fad907ffc3cULL,  -980, -276 },
+                { 0xd3515c2831559a83ULL,  -954, -268 },
+                { 0x9d71ac8fada6c9b5ULL,  -927, -260 },
+                { 0xea9c227723ee8bcbULL,  -901, -252 },
+                { 0xaecc49914078536dULL,  -874, -244 },
+                { 0x823c12795db6ce57ULL,  -847, -236 },
+                { 0xc21094364dfb5637ULL,  -821, -228 },
+                { 0x9096ea6f3848984fULL,  -794, -220 },
+                { 0xd77485cb25823ac7ULL,  -768, -212 },
+                { 0xa086cfcd97bf97f4ULL,  -741, -204 },
+                { 0xef340a98172aace5ULL,  -715, -196 },
+                { 0xb23867fb2a35b28eULL,  -688, -188 },
+                { 0x84c8d4dfd2c63f3bULL,  -661, -180 },
+                { 0xc5dd44271ad3cdbaULL,  -635, -172 },
+                { 0x936b9fcebb25c996ULL,  -608, -164 },
+                { 0xdbac6c247d62a584ULL,  -582, -156 },
+                { 0xa3ab66580d5fdaf6ULL,  -555, -148 },
+                { 0xf3e2f893dec3f126ULL,  -529, -140 },
+                { 0xb5b5ada8aaff80b8ULL,  -502, -132 },
+                { 0x87625f056c7c4a8bULL,  -475, -124 },
+                { 0xc9bcff6034c13053ULL,  -449, -116 },
+                { 0x964e858c91ba2655ULL,  -422, -108 },
+                { 0xdff9772470297ebdULL,  -396, -100 },
+                { 0xa6dfbd9fb8e5b88fULL,  -369,  -92 },
+                { 0xf8a95fcf88747d94ULL,  -343,  -84 },
+                { 0xb94470938fa89bcfULL,  -316,  -76 },
+                { 0x8a08f0f8bf0f156bULL,  -289,  -68 },
+                { 0xcdb02555653131b6ULL,  -263,  -60 },
+                { 0x993fe2c6d07b7facULL,  -236,  -52 },
+                { 0xe45c10c42a2b3b06ULL,  -210,  -44 },
+                { 0xaa242499697392d3ULL,  -183,  -36 },
+                { 0xfd87b5f28300ca0eULL,  -157,  -28 },
+                { 0xbce5086492111aebULL,  -130,  -20 },
+                { 0x8cbccc096f5088ccULL,  -103,  -12 },
+                { 0xd1b71758e219652cULL,   -77,   -4 },
+                { 0x9c40000000000000ULL,   -50,    4 },
+                { 0xe8d4a51000000000ULL,   -24,   12 },
+                { 0xad78ebc5ac620000ULL,     3,   20 },
+                { 0x813f3978f8940984ULL,    30,   28 },
+                { 0xc097ce7bc90715b3ULL,    56,   36 },
+                { 0x8f7e32ce7bea5c70ULL,    83,   44 },
+                { 0xd5d238a4abe98068ULL,   109,   52 },
+                { 0x9f4f2726179a2245ULL,   136,   60 },
+                { 0xed63a231d4c4fb27ULL,   162,   68 },
+                { 0xb0de65388cc8ada8ULL,   189,   76 },
+                { 0x83c7088e1aab65dbULL,   216,   84 },
+                { 0xc45d1df942711d9aULL,   242,   92 },
+                { 0x924d692ca61be758ULL,   269,  100 },
+                { 0xda01ee641a708deaULL,   295,  108 },
+                { 0xa26da3999aef774aULL,   322,  116 },
+                { 0xf209787bb47d6b85ULL,   348,  124 },
+                { 0xb454e4a179dd1877ULL,   375,  132 },
+                { 0x865b86925b9bc5c2ULL,   402,  140 },
+                { 0xc83553c5c8965d3dULL,   428,  148 },
+                { 0x952ab45cfa97a0b3ULL,   455,  156 },
+                { 0xde469fbd99a05fe3ULL,   481,  164 },
+                { 0xa59bc234db398c25ULL,   508,  172 },
+                { 0xf6c69a72a3989f5cULL,   534,  180 },
+                { 0xb7dcbf5354e9beceULL,   561,  188 },
+                { 0x88fcf317f22241e2ULL,   588,  196 },
+                { 0xcc20ce9bd35c78a5ULL,   614,  204 },
+                { 0x98165af37b2153dfULL,   641,  212 },
+                { 0xe2a0b5dc971f303aULL,   667,  220 },
+                { 0xa8d9d1535ce3b396ULL,   694,  228 },
+                { 0xfb9b7cd9a4a7443cULL,   720,  236 },
+                { 0xbb764c4ca7a44410ULL,   747,  244 },
+                { 0x8bab8eefb6409c1aULL,   774,  252 },
+                { 0xd01fef10a657842cULL,   800,  260 },
+                { 0x9b10a4e5e9913129ULL,   827,  268 },
+                { 0xe7109bfba19c0c9dULL,   853,  276 },
+                { 0xac2820d9623bf429ULL,   880,  284 },
+                { 0x80444b5e7aa7cf85ULL,   907,  292 },
+                { 0xbf21e44003acdd2dULL,   933,  300 },
+                { 0x8e679c2f5e44ff8fULL,   960,  308 },
+                { 0xd433179d9c8cb841ULL,   986,  316 },
+                { 0x9e19db92b4e31ba9ULL,  1013,  324 }
+            };
+
+            auto f = -61 - e;
+            auto k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+            auto index = (300 + k + 7) / 8;
+            jassert (index >= 0 && index < (int) numElementsInArray (powers));
+
+            return powers[index];
+        }
+
+        static void roundWeed (char* digits, int numDigits, uint64 dist, uint64 delta, uint64 rest, uint64 tenK) noexcept
+        {
+            // Moves the last digit down while that takes the result closer to the real value,
+            // but without leaving the interval of numbers that would be read back as it
+            while (rest < dist && delta - rest >= tenK
+                    && (rest + tenK < dist || dist - rest > rest + tenK - dist))
+            {
+                --digits[numDigits - 1];
+                rest += tenK;
+            }
+        }
+
+        // Writes the digits of a positive, finite value, returning how many there are. The value
+        // will be the digits multiplied by 10^decimalExponent.
+        static int generateShortestDigits (double value, char* digits, int& decimalExponent) noexcept
+        {
+            // find the value's neighbours' midpoints, which bound the numbers that would be read back as it
+            uint64 bits;
+            memcpy (&bits, &value, sizeof (bits));
+
+            auto biasedExponent = (int) (bits >> 52);
+            auto fraction = bits & ((uint64 (1) << 52) - 1);
+
+            DiyFp v = biasedExponent == 0 ? DiyFp { fraction, -1074 }
+                                          : DiyFp { fraction + (uint64 (1) << 52), biasedExponent - 1075 };
+
+            auto lowerBoundaryIsCloser = fraction == 0 && biasedExponent > 1;
+
+            auto upper = normalise ({ 2 * v.f + 1, v.e - 1 });
+            DiyFp lower = lowerBoundaryIsCloser ? DiyFp { 4 * v.f - 1, v.e - 2 } : DiyFp { 2 * v.f - 1, v.e - 1 };
+            lower = { lower.f << (lower.e - upper.e), upper.e };
+            v = normalise (v);
+
+            // scale everything by a cached power of 10
+            auto cached = getCachedPower (upper.e);
+            DiyFp c { cached.f, cached.e };
+
+            auto w = multiply (v, c);
+            auto wLower = multiply (lower, c);
+            auto wUpper = multiply (upper, c);
+
+            // allow for the error in the multiplication
+            ++wLower.f;
+            --wUpper.f;
+
+            decimalExponent = -cached.k;
+
+            // generate digits from the upper boundary until they're within the interval
+            auto delta = wUpper.f - wLower.f;
+            auto dist = wUpper.f - w.f;
+
+            auto shift = -wUpper.e;
+            auto one = uint64 (1) << shift;
+            auto integral = (uint32) (wUpper.f >> shift);
+            auto fractional = wUpper.f & (one - 1);
+
+            uint32 powerOf10 = 1000000000;
+            int numIntegralDigits = 10;
+
+            while (numIntegralDigits > 1 && integral < powerOf10)
+            {
+                powerOf10 /= 10;
+                --numIntegralDigits;
+            }
+
+            int numDigits = 0;
+
+            while (numIntegralDigits > 0)
+            {
+                digits[numDigits++] = (char) ('0' + integral / powerOf10);
+                integral %= powerOf10;
+                --numIntegralDigits;
+
+                auto rest = ((uint64) integral << shift) + fractional;
+
+                if (rest <= delta)
+                {
+                    decimalExponent += numIntegralDigits;
+                    roundWeed (digits, numDigits, dist, delta, rest, (uint64) powerOf10 << shift);
+                    return numDigits;
+                }
+
+                powerOf10 /= 10;
+            }
+
+            for (;;)
+            {
+                fractional *= 10;
+                delta *= 10;
+                dist *= 10;
+
+                digits[numDigits++] = (char) ('0' + (fractional >> shift));
+                fractional &= one - 1;
+                --decimalExponent;
+
+                if (fractional <= delta)
+                {
+                    roundWeed (digits, numDigits, dist, delta, fractional, one);
+                    return numDigits;
+                }
+            }
+        }
+    }
+
+    //==============================================================================
     struct StackArrayStream  : public std::basic_streambuf<char, std::char_traits<char>>
     {
         explicit StackArrayStream (char* d)
@@ -475,6 +1134,18 @@ namespace NumberToStringConverters
 
     static char* doubleToString (char* buffer, double n, int numDecPlaces, bool useScientificNotation, size_t& len) noexcept
     {
+        // This produces the same output as the stream would, but the stream is only needed for
+        // the rare things that formatDouble can't handle
+        auto* end = numDecPlaces > 0 ? formatDouble (buffer, n, numDecPlaces, useScientificNotation ? 'e' : 'f')
+                                     : formatDouble (buffer, n, 6, 'g');
+
+        if (end != nullptr)
+        {
+            len = (size_t) (end - buffer);
+            jassert (len <= charsNeededForDouble);
+            return buffer;
+        }
+
         StackArrayStream strm (buffer);
         len = strm.writeDouble (n, numDecPlaces, useScientificNotation);
         jassert (len <= charsNeededForDouble);
@@ -482,37 +1153,38 @@ namespace NumberToStringConverters
     }
 
     template <typename IntegerType>
-    static String::CharPointerType createFromInteger (IntegerType number)
+    static String::CharPointerType createFromInteger (String::CharPointerType::CharType* inlineStorage, IntegerType number)
     {
         char buffer [charsNeededForInt];
         auto* end = buffer + numElementsInArray (buffer);
         auto* start = numberToString (end, number);
-        return StringHolder::createFromFixedLength (start, (size_t) (end - start - 1));
+        return StringHolder::createFromFixedLength (inlineStorage, start, (size_t) (end - start - 1));
     }
 
-    static String::CharPointerType createFromDouble (double number, int numberOfDecimalPlaces, bool useScientificNotation)
+    static String::CharPointerType createFromDouble (String::CharPointerType::CharType* inlineStorage, double number,
+                                                     int numberOfDecimalPlaces, bool useScientificNotation)
     {
         char buffer [charsNeededForDouble];
         size_t len;
         auto start = doubleToString (buffer, number, numberOfDecimalPlaces, useScientificNotation, len);
-        return StringHolder::createFromFixedLength (start, len);
+        return StringHolder::createFromFixedLength (inlineStorage, start, len);
     }
 }
 
 //==============================================================================
-String::String (int number)            : text (NumberToStringConverters::createFromInteger (number)) {}
-String::String (unsigned int number)   : text (NumberToStringConverters::createFromInteger (number)) {}
-String::String (short number)          : text (NumberToStringConverters::createFromInteger ((int) number)) {}
-String::String (unsigned short number) : text (NumberToStringConverters::createFromInteger ((unsigned int) number)) {}
-String::String (int64  number)         : text (NumberToStringConverters::createFromInteger (number)) {}
-String::String (uint64 number)         : text (NumberToStringConverters::createFromInteger (number)) {}
-String::String (long number)           : text (NumberToStringConverters::createFromInteger (number)) {}
-String::String (unsigned long number)  : text (NumberToStringConverters::createFromInteger (number)) {}
-
-String::String (float  number)         : text (NumberToStringConverters::createFromDouble ((double) number, 0, false)) {}
-String::String (double number)         : text (NumberToStringConverters::createFromDouble (         number, 0, false)) {}
-String::String (float  number, int numberOfDecimalPlaces, bool useScientificNotation)  : text (NumberToStringConverters::createFromDouble ((double) number, numberOfDecimalPlaces, useScientificNotation)) {}
-String::String (double number, int numberOfDecimalPlaces, bool useScientificNotation)  : text (NumberToStringConverters::createFromDouble (         number, numberOfDecimalPlaces, useScientificNotation)) {}
+String::String (int number)            : text (NumberToStringConverters::createFromInteger (inlineText, number)) {}
+String::String (unsigned int number)   : text (NumberToStringConverters::createFromInteger (inlineText, number)) {}
+String::String (short number)          : text (NumberToStringConverters::createFromInteger (inlineText, (int) number)) {}
+String::String (unsigned short number) : text (NumberToStringConverters::createFromInteger (inlineText, (unsigned int) number)) {}
+String::String (int64  number)         : text (NumberToStringConverters::createFromInteger (inlineText, number)) {}
+String::String (uint64 number)         : text (NumberToStringConverters::createFromInteger (inlineText, number)) {}
+String::String (long number)           : text (NumberToStringConverters::createFromInteger (inlineText, number)) {}
+String::String (unsigned long number)  : text (NumberToStringConverters::createFromInteger (inlineText, number)) {}
+
+String::String (float  number)         : text (NumberToStringConverters::createFromDouble (inlineText, (double) number, 0, false)) {}
+String::String (double number)         : text (NumberToStringConverters::createFromDouble (inlineText,          number, 0, false)) {}
+String::String (float  number, int numberOfDecimalPlaces, bool useScientificNotation)  : text (NumberToStringConverters::createFromDouble (inlineText, (double) number, numberOfDecimalPlaces, useScientificNotation)) {}
+String::String (double number, int numberOfDecimalPlaces, bool useScientificNotation)  : text (NumberToStringConverters::createFromDouble (inlineText,          number, numberOfDecimalPlaces, useScientificNotation)) {}
 
 //==============================================================================
 int String::length() const noexcept
@@ -847,10 +1519,10 @@ JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, const std::string& s2) {
 JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, uint8  number)         { return s1 += (int) number; }
 JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, short  number)         { return s1 += (int) number; }
 JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, int    number)         { return s1 += number; }
-JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, long   number)         { return s1 += String (number); }
-JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, unsigned long number)  { return s1 += String (number); }
-JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, int64  number)         { return s1 += String (number); }
-JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, uint64 number)         { return s1 += String (number); }
+JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, long   number)         { return s1 += (int64) number; }
+JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, unsigned long number)  { return s1 += (uint64) number; }
+JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, int64  number)         { return s1 += number; }
+JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, uint64 number)         { return s1 += number; }
 JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, float  number)         { return s1 += String (number); }
 JUCE_API String& JUCE_CALLTYPE operator<< (String& s1, double number)         { return s1 += String (number); }
 
@@ -1320,8 +1992,8 @@ struct StringCreationHelper
         dest = result.getCharPointer();
     }
 
-    StringCreationHelper (const String::CharPointerType s)
-        : source (s), allocatedBytes (StringHolder::getAllocatedNumBytes (s))
+    StringCreationHelper (const String& s)
+        : source (s.getCharPointer()), allocatedBytes (StringHolder::getAllocatedNumBytes (s))
     {
         result.preallocateBytes (allocatedBytes);
         dest = result.getCharPointer();
@@ -1352,7 +2024,7 @@ String String::replaceCharacter (const juce_wchar charToReplace, const juce_wcha
     if (! containsChar (charToReplace))
         return *this;
 
-    StringCreationHelper builder (text);
+    StringCreationHelper builder (*this);
 
     for (;;)
     {
@@ -1376,7 +2048,7 @@ String String::replaceCharacters (StringRef charactersToReplace, StringRef chara
     // second, so the two strings must be the same length.
     jassert (charactersToReplace.length() == charactersToInsertInstead.length());
 
-    StringCreationHelper builder (text);
+    StringCreationHelper builder (*this);
 
     for (;;)
     {
@@ -1461,7 +2133,7 @@ bool String::endsWithIgnoreCase (StringRef other) const noexcept
 //==============================================================================
 String String::toUpperCase() const
 {
-    StringCreationHelper builder (text);
+    StringCreationHelper builder (*this);
 
     for (;;)
     {
@@ -1479,7 +2151,7 @@ String String::toUpperCase() const
 
 String String::toLowerCase() const
 {
-    StringCreationHelper builder (text);
+    StringCreationHelper builder (*this);
 
     for (;;)
     {
@@ -1743,7 +2415,7 @@ String String::retainCharacters (StringRef charactersToRetain) const
     if (isEmpty())
         return {};
 
-    StringCreationHelper builder (text);
+    StringCreationHelper builder (*this);
 
     for (;;)
     {
@@ -1765,7 +2437,7 @@ String String::removeCharacters (StringRef charactersToRemove) const
     if (isEmpty())
         return {};
 
-    StringCreationHelper builder (text);
+    StringCreationHelper builder (*this);
 
     for (;;)
     {
@@ -2258,6 +2930,58 @@ static String minimiseLengthOfFloatString (const String& input)
     return input;
 }
 
+// Returns the shortest string that will be read back as exactly the same value, in the style
+// of minimiseLengthOfFloatString, or a rounded version if that would need too many digits.
+static String serialiseDouble (double value, int maxSignificantDigits)
+{
+    using namespace NumberToStringConverters;
+
+    if (value != 0 && std::isfinite (value))
+    {
+        char digits[24];
+        int exponent;
+        auto numDigits = Grisu::generateShortestDigits (std::abs (value), digits, exponent);
+
+        if (numDigits <= maxSignificantDigits)
+        {
+            char buffer[charsNeededForDouble];
+            auto* t = buffer;
+
+            if (value < 0)
+                *t++ = '-';
+
+            *t++ = digits[0];
+
+            if (numDigits > 1)
+            {
+                *t++ = '.';
+                memcpy (t, digits + 1, (size_t) numDigits - 1);
+                t += numDigits - 1;
+            }
+
+            exponent += numDigits - 1;
+
+            if (exponent != 0)
+            {
+                *t++ = 'e';
+
+                if (exponent < 0)
+                    *t++ = '-';
+
+                char exponentDigits[8];
+                auto* end = exponentDigits + numElementsInArray (exponentDigits);
+
+                for (auto* d = printDigits (end, std::abs (exponent)); *d != 0;)
+                    *t++ = *d++;
+            }
+
+            return String (buffer, (size_t) (t - buffer));
+        }
+    }
+
+    return minimiseLengthOfFloatString (String (value, maxSignificantDigits - 1, true));
+}
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -2295,6 +3019,69 @@ public:
         }
     };
 
+    // The original byte-by-byte versions of CharPointer_UTF8::length() and isValidString()
+    static size_t lengthByteByByte (const char* d)
+    {
+        size_t count = 0;
+
+        for (;;)
+        {
+            auto n = (uint32) (uint8) *d++;
+
+            if ((n & 0x80) != 0)
+            {
+                while ((*d & 0xc0) == 0x80)
+                    ++d;
+            }
+            else if (n == 0)
+                break;
+
+            ++count;
+        }
+
+        return count;
+    }
+
+    static bool isValidStringByteByByte (const char* dataToTest, int maxBytesToRead)
+    {
+        while (--maxBytesToRead >= 0 && *dataToTest != 0)
+        {
+            auto byte = (signed char) *dataToTest++;
+
+            if (byte < 0)
+            {
+                int bit = 0x40;
+                int numExtraValues = 0;
+
+                while ((byte & bit) != 0)
+                {
+                    if (bit < 8)
+                        return false;
+
+                    ++numExtraValues;
+                    bit >>= 1;
+
+                    if (bit == 8 && (numExtraValues > maxBytesToRead
+                                       || *CharPointer_UTF8 (dataToTest - 1) > 0x10ffff))
+                        return false;
+                }
+
+                if (numExtraValues == 0)
+                    return false;
+
+                maxBytesToRead -= numExtraValues;
+                if (maxBytesToRead < 0)
+                    return false;
+
+                while (--numExtraValues >= 0)
+                    if ((*dataToTest++ & 0xc0) != 0x80)
+                        return false;
+            }
+        }
+
+        return true;
+    }
+
     static String createRandomWideCharString (Random& r)
     {
         juce_wchar buffer[50] = { 0 };
@@ -2353,6 +3140,99 @@ public:
             expect (String ("abc foo bar").containsWholeWord ("abc") && String ("abc foo bar").containsWholeWord ("abc"));
         }
 
+        {
+            beginTest ("Short and long string storage");
+
+            String shortString ("short"), longString ("a string that's too long to be stored inline");
+            String shortCopy (shortString), longCopy (longString);
+
+            expectEquals (shortCopy.getReferenceCount(), 1);
+            expect (shortCopy.getCharPointer() != shortString.getCharPointer());
+            expectEquals (longCopy.getReferenceCount(), 2);
+            expect (longCopy.getCharPointer() == longString.getCharPointer());
+
+            shortCopy += "er";
+            expectEquals (shortString, String ("short"));
+            expectEquals (shortCopy, String ("shorter"));
+
+            // growing past the inline size
+            for (int i = 0; i < 20; ++i)
+                shortCopy << i;
+
+            expectEquals (shortCopy, String ("shorter012345678910111213141516171819"));
+            expectEquals (shortCopy.getReferenceCount(), 1);
+
+            shortCopy.swapWith (shortString);
+            expectEquals (shortString, String ("shorter012345678910111213141516171819"));
+            expectEquals (shortCopy, String ("short"));
+
+            String moved (std::move (shortCopy));
+            expect (shortCopy.isEmpty());
+            expectEquals (moved, String ("short"));
+
+            moved = std::move (longCopy);
+            expect (longCopy.isEmpty());
+            expectEquals (moved, longString);
+
+            moved = shortString.substring (0, 3);
+            expectEquals (moved, String ("sho"));
+
+            Identifier id1 ("id"), id2 (String ("i") + "d");
+            expect (id1 == id2);
+            expect (Identifier (id1) == id2);
+        }
+
+        {
+            beginTest ("StringPool");
+
+            StringPool pool;
+            auto s1 = pool.getPooledString ("abc");
+            auto s2 = pool.getPooledString (String ("abcd").substring (0, 3));
+            String text ("xabcx");
+            auto s3 = pool.getPooledString (text.getCharPointer() + 1, text.getCharPointer() + 4);
+            auto s4 = pool.getPooledString ("abc", StringPool::getHashForLiteral ("abc"));
+
+            expectEquals (s1, String ("abc"));
+            expect (s1.getCharPointer() == s2.getCharPointer());
+            expect (s1.getCharPointer() == s3.getCharPointer());
+            expect (s1.getCharPointer() == s4.getCharPointer());
+            expect (pool.getPooledString ("abd").getCharPointer() != s1.getCharPointer());
+
+            expect (JUCE_IDENTIFIER ("someName") == Identifier ("someName"));
+
+            // Identifiers created on different threads must all share the same pooled text
+            struct IdentifierCreatorThread  : public Thread
+            {
+                IdentifierCreatorThread (Array<Identifier>& a) : Thread ("pool test"), ids (a) {}
+
+                void run() override
+                {
+                    for (int j = 0; j < 500; ++j)
+                        ids.add (Identifier ("id" + String (j)));
+                }
+
+                Array<Identifier>& ids;
+            };
+
+            OwnedArray<Thread> threads;
+            Array<Identifier> ids[4];
+
+            for (auto& idsForThread : ids)
+                threads.add (new IdentifierCreatorThread (idsForThread));
+
+            for (auto* t : threads)
+                t->startThread();
+
+            for (auto* t : threads)
+                t->waitForThreadToExit (-1);
+
+            for (int i = 1; i < 4; ++i)
+                for (int j = 0; j < 500; ++j)
+                    expect (ids[i][j] == ids[0][j]);
+
+            expect (ids[0][123] == Identifier ("id123"));
+        }
+
         {
             beginTest ("Operations");
 
@@ -2556,6 +3436,77 @@ public:
             expectEquals (String (1e-34, 5,        true), String ("1.00000e-34"));
             expectEquals (String (1.39, 1,         true), String ("1.4e+00"));
 
+            beginTest ("Double formatting and parsing");
+
+            expectEquals (String (0.125, 2),  String ("0.12"));
+            expectEquals (String (0.375, 2),  String ("0.38"));
+            expectEquals (String (9.9996, 3), String ("10.000"));
+            expectEquals (String (0.0004, 3), String ("0.000"));
+            expectEquals (String (0.0006, 3), String ("0.001"));
+            expectEquals (String (-0.0),      String ("-0"));
+            expectEquals (String (100000.0),  String ("100000"));
+            expectEquals (String (999999.5),  String ("1e+06"));
+            expectEquals (String (0.0001),    String ("0.0001"));
+            expectEquals (String (0.00001),   String ("1e-05"));
+            expectEquals (serialiseDouble (0.1 + 0.2, 17), String ("3.0000000000000004e-1"));
+            expectEquals (serialiseDouble (5e-324, 17), String ("5e-324"));
+            expectEquals (serialiseDouble (-1.7976931348623157e308, 17), String ("-1.7976931348623157e308"));
+
+            {
+                Random random = getRandom();
+
+                auto createRandomDouble = [&random]
+                {
+                    switch (random.nextInt (3))
+                    {
+                        case 0:
+                        {
+                            for (;;)
+                            {
+                                auto bits = (uint64) random.nextInt64();
+                                double d;
+                                memcpy (&d, &bits, sizeof (d));
+
+                                // (the parser doesn't handle denormals)
+                                if (std::isnormal (d))
+                                    return d;
+                            }
+                        }
+
+                        case 1:     return (random.nextDouble() - 0.5) * std::pow (10.0, random.nextInt (40) - 20);
+                        default:    return (random.nextInt (2000000) - 1000000) / 1000.0;
+                    }
+                };
+
+                char expected[512];
+
+                for (int i = 0; i < 3000; ++i)
+                {
+                    auto d = createRandomDouble();
+                    auto precision = random.nextInt (20) + 1;
+
+                    snprintf (expected, sizeof (expected), "%.*e", precision, d);
+                    expectEquals (String (d, precision, true), String (expected));
+
+                    // the parser has a fast path for these shorter numbers
+                    snprintf (expected, sizeof (expected), "%.*e", precision % 15, d);
+                    expect (String (expected).getDoubleValue() == strtod (expected, nullptr));
+
+                    snprintf (expected, sizeof (expected), "%g", d);
+                    expectEquals (String (d), String (expected));
+
+                    if (std::abs (d) < 1.0e15)
+                    {
+                        snprintf (expected, sizeof (expected), "%.*f", precision, d);
+                        expectEquals (String (d, precision), String (expected));
+                    }
+
+                    auto shortest = serialiseDouble (d, 17);
+                    expect (shortest.getDoubleValue() == d);
+                    expect (shortest.length() <= 24);
+                }
+            }
+
             beginTest ("Subsections");
             String s3;
             s3 = "abcdeFGHIJ";
@@ -2694,6 +3645,58 @@ public:
             TestUTFConversion <CharPointer_UTF16>::test (*this, r);
         }
 
+        {
+            beginTest ("UTF-8 fast paths");
+
+            // These compare the block-at-a-time code with simple byte-by-byte versions,
+            // using text that mixes long runs of ASCII with valid and invalid sequences
+            for (int i = 0; i < 500; ++i)
+            {
+                char text[200] = { 0 };
+                auto numBytes = 1 + r.nextInt (numElementsInArray (text) - 2);
+
+                for (int j = 0; j < numBytes; ++j)
+                {
+                    auto kind = r.nextInt (10);
+                    text[j] = (char) (kind < 6 ? 1 + r.nextInt (0x7f)
+                                               : (kind < 9 ? 0x80 + r.nextInt (0x40)
+                                                           : 0xc0 + r.nextInt (0x40)));
+                }
+
+                if (i % 2 == 0)
+                {
+                    auto s = String (createRandomWideCharString (r)).toUTF8();
+                    auto start = r.nextInt (numBytes);
+                    auto numToCopy = jmin ((int) strlen (s), numBytes - start);
+                    memcpy (text + start, s.getAddress(), (size_t) numToCopy);
+                }
+
+                CharPointer_UTF8 utf8 (text);
+                expectEquals ((int) utf8.length(), (int) lengthByteByByte (text));
+
+                auto maxBytes = r.nextInt (numBytes + 2);
+                expect (CharPointer_UTF8::isValidString (text, maxBytes) == isValidStringByteByByte (text, maxBytes));
+
+                CharPointer_UTF16::CharType utf16[400], expected16[400];
+                CharPointer_UTF16 dest16 (utf16), expectedDest16 (expected16);
+                dest16.writeAll (utf8);
+                CharacterFunctions::copyAll (expectedDest16, utf8);
+                expect (memcmp (utf16, expected16, (size_t) getAddressDifference (expectedDest16.getAddress(), expected16) + 2) == 0);
+                size_t expectedBytes16 = 0;
+
+                for (auto p = utf8; auto c = p.getAndAdvance();)
+                    expectedBytes16 += CharPointer_UTF16::getBytesRequiredFor (c);
+
+                expectEquals ((int) CharPointer_UTF16::getBytesRequiredFor (utf8), (int) expectedBytes16);
+
+                CharPointer_UTF32::CharType utf32[200], expected32[200];
+                CharPointer_UTF32 dest32 (utf32), expectedDest32 (expected32);
+                dest32.writeAll (utf8);
+                CharacterFunctions::copyAll (expectedDest32, utf8);
+                expect (memcmp (utf32, expected32, (size_t) getAddressDifference (expectedDest32.getAddress(), expected32) + 4) == 0);
+            }
+        }
+
         {
             beginTest ("StringArray");
 
@@ -31,6 +31,12 @@ namespace juce
     and efficient, and there are methods to do just about any operation you'll ever
     dream of.
 
+    Short strings are stored inside the String object itself rather than being
+    allocated on the heap, so creating and copying them doesn't need any allocation
+    or atomic operations. The one thing to be aware of is that a pointer obtained from
+    getCharPointer(), toRawUTF8() etc. for a short string is only valid for as long as
+    that String object is, so it won't survive the string being moved or swapped.
+
     @see StringArray, StringPairArray
 
     @tags{Core}
@@ -1343,7 +1349,7 @@ public:
     void preallocateBytes (size_t numBytesNeeded);
 
     /** Swaps the contents of this string with another one.
-        This is a very fast operation, as no allocation or copying needs to be done.
+        This is a very fast operation, as no allocation needs to be done.
     */
     void swapWith (String& other) noexcept;
 
@@ -1381,7 +1387,14 @@ public:
 
 private:
     //==============================================================================
+    // Strings that fit into inlineText are kept there, with text pointing to it
+    enum { numInlineBytes = 16 };
+
     CharPointerType text;
+    CharPointerType::CharType inlineText[numInlineBytes / sizeof (CharPointerType::CharType)];
+
+    friend class StringHolder;
+    friend class StringPool;
 
     //==============================================================================
     struct PreallocationBytes
@@ -1392,6 +1405,7 @@ private:
 
     explicit String (const PreallocationBytes&); // This constructor preallocates a certain amount of memory
     size_t getByteOffsetOfEnd() const noexcept;
+    void moveTextToHeap();
     JUCE_DEPRECATED (String (const String&, size_t));
 
     // This private cast operator should prevent strings being accidentally cast
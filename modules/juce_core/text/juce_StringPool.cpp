@@ -23,79 +23,130 @@
 namespace juce
 {
 
-static const int minNumberOfStringsForGarbageCollection = 300;
+static const int numStringPoolShards = 16;
+static const int minNumberOfStringsForGarbageCollection = 300 / numStringPoolShards;
 static const uint32 garbageCollectionInterval = 30000;
 
+//==============================================================================
+struct StringPool::Shard
+{
+    // Keys for looking up text that's not yet in a String, along with its hash
+    template <typename CharPointer>
+    struct TextKey
+    {
+        CharPointer text;
+        uint32 hash;
 
-StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
-StringPool::~StringPool() {}
+        friend bool operator== (const String& s, const TextKey& key) noexcept   { return s.getCharPointer().compare (key.text) == 0; }
+        String toString() const                                                 { return String (text); }
+    };
 
-struct StartEndString
-{
-    StartEndString (String::CharPointerType s, String::CharPointerType e) noexcept : start (s), end (e) {}
-    operator String() const   { return String (start, end); }
+    struct RangeKey
+    {
+        String::CharPointerType start, end;
+        uint32 hash;
 
-    String::CharPointerType start, end;
-};
+        friend bool operator== (const String& s, const RangeKey& key) noexcept
+        {
+            auto s1 = key.start;
+            auto s2 = s.getCharPointer();
 
-static int compareStrings (const String& s1, const String& s2) noexcept     { return s1.compare (s2); }
-static int compareStrings (CharPointer_UTF8 s1, const String& s2) noexcept  { return s1.compare (s2.getCharPointer()); }
+            for (;;)
+            {
+                auto c1 = s1 < key.end ? s1.getAndAdvance() : 0;
+                auto c2 = s2.getAndAdvance();
 
-static int compareStrings (const StartEndString& string1, const String& string2) noexcept
-{
-    String::CharPointerType s1 (string1.start), s2 (string2.getCharPointer());
+                if (c1 != c2)   return false;
+                if (c1 == 0)    return true;
+            }
+        }
 
-    for (;;)
+        String toString() const                                 { return String (start, end); }
+    };
+
+    template <typename CharPointer>
+    static uint32 hashText (CharPointer text, CharPointer end) noexcept
     {
-        const int c1 = s1 < string1.end ? (int) s1.getAndAdvance() : 0;
-        const int c2 = (int) s2.getAndAdvance();
-        const int diff = c1 - c2;
+        auto hash = 2166136261u;
 
-        if (diff != 0)  return diff < 0 ? -1 : 1;
-        if (c1 == 0)    break;
-    }
+        while (! text.isEmpty() && (end.getAddress() == nullptr || text < end))
+            hash = (hash ^ (uint32) text.getAndAdvance()) * 16777619u;
 
-    return 0;
-}
+        return finaliseHash (hash);
+    }
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
-{
-    int start = 0;
-    int end = strings.size();
+    template <typename CharPointer>
+    static TextKey<CharPointer> createKey (CharPointer text) noexcept
+    {
+        return { text, hashText (text, CharPointer (nullptr)) };
+    }
 
-    while (start < end)
+    static RangeKey createKey (String::CharPointerType start, String::CharPointerType end) noexcept
     {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
+        return { start, end, hashText (start, end) };
+    }
 
-        if (startComp == 0)
-            return startString;
+    struct HashFunctions
+    {
+        template <typename KeyType>
+        static uint32 hash (const KeyType& key) noexcept        { return key.hash; }
 
-        const int halfway = (start + end) / 2;
+        static uint32 hash (const String& s) noexcept           { return hashText (s.getCharPointer(), String::CharPointerType (nullptr)); }
+    };
 
-        if (halfway == start)
-        {
-            if (startComp > 0)
-                ++start;
+    void garbageCollect()
+    {
+        StringArray unusedStrings;
 
-            break;
-        }
+        for (auto& s : strings)
+            if (s.getReferenceCount() == 1)
+                unusedStrings.add (s);
 
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
+        for (auto& s : unusedStrings)
+            strings.remove (s);
 
-        if (halfwayComp == 0)
-            return halfwayString;
+        lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    }
 
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
+    void garbageCollectIfNeeded()
+    {
+        if (strings.size() > minNumberOfStringsForGarbageCollection
+             && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
+            garbageCollect();
     }
 
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    FlatHashSet<String, HashFunctions> strings;
+    CriticalSection lock;
+    uint32 lastGarbageCollectionTime = 0;
+};
+
+//==============================================================================
+StringPool::StringPool()
+{
+    for (int i = 0; i < numStringPoolShards; ++i)
+        shards.add (new Shard());
+}
+
+StringPool::~StringPool() {}
+
+template <typename KeyType>
+String StringPool::addPooledString (const KeyType& key)
+{
+    auto& shard = *shards.getUnchecked ((int) (key.hash % (uint32) numStringPoolShards));
+    const ScopedLock sl (shard.lock);
+
+    if (auto* existing = shard.strings.find (key))
+        return *existing;
+
+    shard.garbageCollectIfNeeded();
+
+    // Pooled strings are compared by pointer, and garbage-collected by reference count, so
+    // they can't use the inline storage that String would normally use for short text
+    auto pooledString = key.toString();
+    pooledString.moveTextToHeap();
+
+    shard.strings.add (pooledString);
+    return pooledString;
 }
 
 String StringPool::getPooledString (const char* const newString)
@@ -103,9 +154,7 @@ String StringPool::getPooledString (const char* const newString)
     if (newString == nullptr || *newString == 0)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    return addPooledString (Shard::createKey (CharPointer_UTF8 (newString)));
 }
 
 String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -113,9 +162,7 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
     if (start.isEmpty() || start == end)
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return addPooledString (Shard::createKey (start, end));
 }
 
 String StringPool::getPooledString (StringRef newString)
@@ -123,9 +170,7 @@ String StringPool::getPooledString (StringRef newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    return addPooledString (Shard::createKey (newString.text));
 }
 
 String StringPool::getPooledString (const String& newString)
@@ -133,27 +178,28 @@ String StringPool::getPooledString (const String& newString)
     if (newString.isEmpty())
         return {};
 
-    const ScopedLock sl (lock);
-    garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
+    return addPooledString (Shard::createKey (newString.getCharPointer()));
 }
 
-void StringPool::garbageCollectIfNeeded()
+String StringPool::getPooledString (const char* const literal, uint32 precalculatedHash)
 {
-    if (strings.size() > minNumberOfStringsForGarbageCollection
-         && Time::getApproximateMillisecondCounter() > lastGarbageCollectionTime + garbageCollectionInterval)
-        garbageCollect();
+    if (literal == nullptr || *literal == 0)
+        return {};
+
+    // This hash doesn't match the text, so it probably wasn't calculated with getHashForLiteral(),
+    // or the text isn't plain ascii.
+    jassert (precalculatedHash == Shard::createKey (CharPointer_UTF8 (literal)).hash);
+
+    return addPooledString (Shard::TextKey<CharPointer_UTF8> { CharPointer_UTF8 (literal), precalculatedHash });
 }
 
 void StringPool::garbageCollect()
 {
-    const ScopedLock sl (lock);
-
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference(i).getReferenceCount() == 1)
-            strings.remove (i);
-
-    lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
+    for (auto* shard : shards)
+    {
+        const ScopedLock sl (shard->lock);
+        shard->garbageCollect();
+    }
 }
 
 StringPool& StringPool::getGlobalPool() noexcept
@@ -34,6 +34,10 @@ namespace juce
     compare two pooled strings for equality, as you can simply compare their pointers. It
     also cuts down on storage if you're using many copies of the same string.
 
+    The pool is thread-safe. It's split into a number of hash tables which each have their
+    own lock, so threads that are adding strings at the same time rarely have to wait for
+    each other.
+
     @tags{Core}
 */
 class JUCE_API  StringPool
@@ -41,7 +45,7 @@ class JUCE_API  StringPool
 public:
     //==============================================================================
     /** Creates an empty pool. */
-    StringPool() noexcept;
+    StringPool();
 
     /** Destructor */
     ~StringPool();
@@ -67,6 +71,20 @@ public:
     */
     String getPooledString (String::CharPointerType start, String::CharPointerType end);
 
+    /** Returns a pointer to a copy of a string literal, using a hash that was calculated by
+        getHashForLiteral(). This lets hot code paths have the hash worked out at compile time.
+        @see JUCE_IDENTIFIER
+    */
+    String getPooledString (const char* literal, uint32 precalculatedHash);
+
+    /** Returns the hash that the pool uses to look up a string of ascii characters.
+        This is constexpr, so it can be evaluated at compile time for a string literal.
+    */
+    static constexpr uint32 getHashForLiteral (const char* text) noexcept
+    {
+        return finaliseHash (hashAscii (text, 2166136261u));
+    }
+
     //==============================================================================
     /** Scans the pool, and removes any strings that are unreferenced.
         You don't generally need to call this - it'll be called automatically when the pool grows
@@ -78,11 +96,20 @@ public:
     static StringPool& getGlobalPool() noexcept;
 
 private:
-    Array<String> strings;
-    CriticalSection lock;
-    uint32 lastGarbageCollectionTime;
+    // The strings are spread over a set of independently-locked hash tables, so that
+    // threads creating Identifiers don't all have to wait for the same lock
+    struct Shard;
+    OwnedArray<Shard> shards;
+
+    template <typename KeyType>
+    String addPooledString (const KeyType&);
+
+    static constexpr uint32 hashAscii (const char* text, uint32 hash) noexcept
+    {
+        return *text == 0 ? hash : hashAscii (text + 1, (hash ^ (uint32) (uint8) *text) * 16777619u);
+    }
 
-    void garbageCollectIfNeeded();
+    static constexpr uint32 finaliseHash (uint32 hash) noexcept     { return hash ^ (hash >> 15); }
 
     JUCE_DECLARE_NON_COPYABLE (StringPool)
 };
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class StringBenchmarks  : public Benchmark
+{
+public:
+    StringBenchmarks()  : Benchmark ("String and var", "Text") {}
+
+    void runBenchmark() override
+    {
+        const String text ("The quick brown fox jumps over the lazy dog, again and again and again");
+
+        measure ("String copy",        [&] { String s (text); doNotOptimiseAway (s); });
+        measure ("String concatenate", [&] { doNotOptimiseAway (text + " and again"); });
+        measure ("String indexOf",     [&] { doNotOptimiseAway (text.indexOf ("lazy dog")); });
+        measure ("String toUpperCase", [&] { doNotOptimiseAway (text.toUpperCase()); });
+        measure ("String from int",    [&] { doNotOptimiseAway (String (123456789)); });
+        measure ("String getDoubleValue", [] { doNotOptimiseAway (String ("3.14159265").getDoubleValue()); });
+        measure ("String hashCode",    [&] { doNotOptimiseAway (text.hashCode64()); });
+
+        const double value = 0.1234567890123;
+        const var valueVar (value);
+
+        measure ("String from int64",       [] { doNotOptimiseAway (String ((int64) 1234567890123456789)); });
+        measure ("String from double",      [&] { doNotOptimiseAway (String (value)); });
+        measure ("String from double, 6 dp", [&] { doNotOptimiseAway (String (value, 6)); });
+        measure ("JSON double",             [&] { doNotOptimiseAway (JSON::toString (valueVar)); });
+        measure ("String getDoubleValue, long", [] { doNotOptimiseAway (String ("0.1234567890123456789").getDoubleValue()); });
+
+        String longText;
+
+        for (int i = 0; i < 20; ++i)
+            longText << text << (i % 5 == 0 ? String (CharPointer_UTF8 (" caf\xc3\xa9 ")) : String (" "));
+
+        auto longUTF8 = longText.toUTF8();
+        auto longLength = (int) strlen (longUTF8);
+
+        measure ("UTF-8 length",         [&] { doNotOptimiseAway (longUTF8.length()); });
+        measure ("UTF-8 isValidString",  [&] { doNotOptimiseAway (CharPointer_UTF8::isValidString (longUTF8, longLength)); });
+        measure ("UTF-8 to UTF-16",      [&] { doNotOptimiseAway (String (longText).toUTF16()); });
+        measure ("UTF-8 to UTF-32",      [&] { doNotOptimiseAway (String (longText).toUTF32()); });
+
+        measure ("StringArray addTokens", [&]
+        {
+            StringArray tokens;
+            tokens.addTokens (text, " ,", {});
+            doNotOptimiseAway (tokens.size());
+        });
+
+        const var number (1234.5), string (text);
+        DynamicObject::Ptr object (new DynamicObject());
+
+        for (int i = 0; i < 20; ++i)
+            object->setProperty ("property" + String (i), i);
+
+        const var objectVar (object.get());
+        const Identifier lastProperty ("property19");
+
+        measure ("var copy of string", [&] { var v (string); doNotOptimiseAway (v); });
+        measure ("var to double",      [&] { doNotOptimiseAway ((double) number); });
+        measure ("var to String",      [&] { doNotOptimiseAway (number.toString()); });
+        measure ("var property lookup", [&] { doNotOptimiseAway (objectVar[lastProperty]); });
+    }
+};
+
+static StringBenchmarks stringBenchmarks;
+
+} // namespace juce
@@ -25,185 +25,348 @@ namespace juce
 
 struct TextDiffHelpers
 {
-    enum { minLengthToMatch = 3,
-           maxComplexity = 16 * 1024 * 1024 };
+    enum { minCostBeforeGivingUp = 256 };
 
-    struct StringRegion
+    //==============================================================================
+    /*  The things that get compared: either each character of a string, or each of its
+        lines (which are given IDs so that identical lines can be compared as integers).
+    */
+    struct TokenisedString
     {
-        StringRegion (const String& s) noexcept
-            : text (s.getCharPointer()), start (0), length (s.length()) {}
+        TokenisedString (const String& s, TextDiff::Granularity granularity, HashMap<String, uint32>& lineIDs)
+        {
+            auto t = s.getCharPointer();
 
-        StringRegion (String::CharPointerType t, int s, int len) noexcept
-            : text (t), start (s), length (len) {}
+            if (granularity == TextDiff::Granularity::characters)
+            {
+                while (! t.isEmpty())
+                    tokens.push_back ((uint32) t.getAndAdvance());
 
-        void incrementStart() noexcept  { ++text; ++start; --length; }
+                numChars = (int) tokens.size();
+                return;
+            }
 
-        String::CharPointerType text;
-        int start, length;
-    };
+            while (! t.isEmpty())
+            {
+                auto lineStart = t;
+                offsets.push_back (numChars);
 
-    static void addInsertion (TextDiff& td, String::CharPointerType text, int index, int length)
-    {
-        TextDiff::Change c;
-        c.insertedText = String (text, (size_t) length);
-        c.start = index;
-        c.length = 0;
-        td.changes.add (c);
-    }
+                for (;;)
+                {
+                    auto c = t.getAndAdvance();
+                    ++numChars;
 
-    static void addDeletion (TextDiff& td, int index, int length)
-    {
-        TextDiff::Change c;
-        c.start = index;
-        c.length = length;
-        td.changes.add (c);
-    }
+                    if (c == '\n' || t.isEmpty() || (c == '\r' && *t != '\n'))
+                        break;
+                }
 
-    static void diffSkippingCommonStart (TextDiff& td, StringRegion a, StringRegion b)
-    {
-        for (;;)
-        {
-            auto ca = *a.text;
-            auto cb = *b.text;
+                String line (lineStart, t);
 
-            if (ca != cb || ca == 0)
-                break;
+                if (! lineIDs.contains (line))
+                    lineIDs.set (line, (uint32) lineIDs.size());
 
-            a.incrementStart();
-            b.incrementStart();
+                tokens.push_back (lineIDs[line]);
+            }
         }
 
-        diffRecursively (td, a, b);
-    }
+        int size() const noexcept    { return (int) tokens.size(); }
 
-    static void diffRecursively (TextDiff& td, StringRegion a, StringRegion b)
-    {
-        int indexA = 0, indexB = 0;
-        auto len = findLongestCommonSubstring (a.text, a.length, indexA,
-                                               b.text, b.length, indexB);
-
-        if (len >= minLengthToMatch)
+        int getCharIndex (int tokenIndex) const noexcept
         {
-            if (indexA > 0 && indexB > 0)
-                diffSkippingCommonStart (td, StringRegion (a.text, a.start, indexA),
-                                             StringRegion (b.text, b.start, indexB));
-            else if (indexA > 0)
-                addDeletion (td, b.start, indexA);
-            else if (indexB > 0)
-                addInsertion (td, b.text, b.start, indexB);
-
-            diffRecursively (td, StringRegion (a.text + (indexA + len), a.start + indexA + len, a.length - indexA - len),
-                                 StringRegion (b.text + (indexB + len), b.start + indexB + len, b.length - indexB - len));
+            if (tokenIndex >= size())
+                return numChars;
+
+            return offsets.empty() ? tokenIndex : offsets[(size_t) tokenIndex];
         }
-        else
+
+        std::vector<uint32> tokens;
+        std::vector<int> offsets;
+        int numChars = 0;
+    };
+
+    //==============================================================================
+    /*  Finds the regions that differ between two token sequences, using Myers' O(ND)
+        algorithm with the linear-space "middle snake" refinement. To stop very different
+        inputs taking O(N^2) time, once the search for a split point gets too expensive it
+        settles for the furthest point it's reached, which still gives a correct (although
+        possibly not minimal) set of changes.
+    */
+    struct Differ
+    {
+        Differ (const TokenisedString& ta, const TokenisedString& tb)
+            : a (ta.tokens.data()), b (tb.tokens.data())
         {
-            if (a.length > 0)   addDeletion (td, b.start, a.length);
-            if (b.length > 0)   addInsertion (td, b.text, b.start, b.length);
+            auto vLength = (size_t) (ta.size() + tb.size() + 4);
+            forward.resize (vLength);
+            backward.resize (vLength);
+
+            diff (0, ta.size(), 0, tb.size());
         }
-    }
 
-    static int findLongestCommonSubstring (String::CharPointerType a, const int lenA, int& indexInA,
-                                           String::CharPointerType b, const int lenB, int& indexInB) noexcept
-    {
-        if (lenA == 0 || lenB == 0)
-            return 0;
+        struct Hunk
+        {
+            int startA, lengthA, startB, lengthB;
+        };
 
-        if (lenA * lenB > maxComplexity)
-            return findCommonSuffix (a, lenA, indexInA,
-                                     b, lenB, indexInB);
+        Array<Hunk> hunks;
 
-        auto scratchSpace = sizeof (int) * (2 + 2 * (size_t) lenB);
+    private:
+        const uint32* a;
+        const uint32* b;
+        std::vector<int> forward, backward;
 
-        if (scratchSpace < 4096)
+        void diff (int startA, int endA, int startB, int endB)
         {
-            auto* scratch = (int*) alloca (scratchSpace);
-            return findLongestCommonSubstring (a, lenA, indexInA, b, lenB, indexInB, scratchSpace, scratch);
-        }
-
-        HeapBlock<int> scratch (scratchSpace);
-        return findLongestCommonSubstring (a, lenA, indexInA, b, lenB, indexInB, scratchSpace, scratch);
-    }
+            while (startA < endA && startB < endB && a[startA] == b[startB])
+            {
+                ++startA;
+                ++startB;
+            }
 
-    static int findLongestCommonSubstring (String::CharPointerType a, const int lenA, int& indexInA,
-                                           String::CharPointerType b, const int lenB, int& indexInB,
-                                           const size_t scratchSpace, int* const lines) noexcept
-    {
-        zeromem (lines, scratchSpace);
+            while (startA < endA && startB < endB && a[endA - 1] == b[endB - 1])
+            {
+                --endA;
+                --endB;
+            }
 
-        auto* l0 = lines;
-        auto* l1 = l0 + lenB + 1;
+            int splitA, splitB;
 
-        int loopsWithoutImprovement = 0;
-        int bestLength = 0;
+            if (startA < endA && startB < endB
+                 && findSplitPoint (startA, endA, startB, endB, splitA, splitB))
+            {
+                diff (startA, splitA, startB, splitB);
+                diff (splitA, endA, splitB, endB);
+            }
+            else
+            {
+                addHunk (startA, endA - startA, startB, endB - startB);
+            }
+        }
 
-        for (int i = 0; i < lenA; ++i)
+        bool findSplitPoint (int startA, int endA, int startB, int endB, int& splitA, int& splitB)
         {
-            auto ca = a.getAndAdvance();
-            auto b2 = b;
-
-            for (int j = 0; j < lenB; ++j)
+            auto n = endA - startA;
+            auto m = endB - startB;
+            auto maxD = (n + m + 1) / 2;
+            auto offset = maxD;
+            auto vLength = 2 * maxD;
+            auto delta = n - m;
+            auto deltaIsOdd = (delta & 1) != 0;
+            auto maxCost = jmax ((int) minCostBeforeGivingUp, (int) std::sqrt ((double) (n + m)));
+
+            auto* v1 = forward.data();
+            auto* v2 = backward.data();
+            std::fill (v1, v1 + vLength + 2, -1);
+            std::fill (v2, v2 + vLength + 2, -1);
+            v1[offset + 1] = 0;
+            v2[offset + 1] = 0;
+
+            int k1Start = 0, k1End = 0, k2Start = 0, k2End = 0;
+            int bestX = 0, bestY = 0;
+
+            for (int d = 0; d < maxD; ++d)
             {
-                if (ca != b2.getAndAdvance())
+                if (d > maxCost && bestX + bestY > 0)
                 {
-                    l1[j + 1] = 0;
+                    splitA = startA + bestX;
+                    splitB = startB + bestY;
+                    return true;
                 }
-                else
+
+                for (int k1 = -d + k1Start; k1 <= d - k1End; k1 += 2)
                 {
-                    auto len = l0[j] + 1;
-                    l1[j + 1] = len;
+                    auto k1Offset = offset + k1;
+                    auto x1 = (k1 == -d || (k1 != d && v1[k1Offset - 1] < v1[k1Offset + 1])) ? v1[k1Offset + 1]
+                                                                                             : v1[k1Offset - 1] + 1;
+                    auto y1 = x1 - k1;
+
+                    while (x1 < n && y1 < m && a[startA + x1] == b[startB + y1])
+                    {
+                        ++x1;
+                        ++y1;
+                    }
+
+                    v1[k1Offset] = x1;
 
-                    if (len > bestLength)
+                    if (x1 > n)
+                    {
+                        k1End += 2;
+                    }
+                    else if (y1 > m)
+                    {
+                        k1Start += 2;
+                    }
+                    else
                     {
-                        loopsWithoutImprovement = 0;
-                        bestLength = len;
-                        indexInA = i;
-                        indexInB = j;
+                        if (x1 + y1 > bestX + bestY && x1 + y1 < n + m)
+                        {
+                            bestX = x1;
+                            bestY = y1;
+                        }
+
+                        if (deltaIsOdd)
+                        {
+                            auto k2Offset = offset + delta - k1;
+
+                            if (k2Offset >= 0 && k2Offset < vLength && v2[k2Offset] != -1 && x1 >= n - v2[k2Offset])
+                            {
+                                splitA = startA + x1;
+                                splitB = startB + y1;
+                                return true;
+                            }
+                        }
                     }
                 }
-            }
 
-            if (++loopsWithoutImprovement > 100)
-                break;
+                for (int k2 = -d + k2Start; k2 <= d - k2End; k2 += 2)
+                {
+                    auto k2Offset = offset + k2;
+                    auto x2 = (k2 == -d || (k2 != d && v2[k2Offset - 1] < v2[k2Offset + 1])) ? v2[k2Offset + 1]
+                                                                                             : v2[k2Offset - 1] + 1;
+                    auto y2 = x2 - k2;
 
-            std::swap (l0, l1);
-        }
+                    while (x2 < n && y2 < m && a[endA - x2 - 1] == b[endB - y2 - 1])
+                    {
+                        ++x2;
+                        ++y2;
+                    }
 
-        indexInA -= bestLength - 1;
-        indexInB -= bestLength - 1;
-        return bestLength;
-    }
+                    v2[k2Offset] = x2;
 
-    static int findCommonSuffix (String::CharPointerType a, int lenA, int& indexInA,
-                                 String::CharPointerType b, int lenB, int& indexInB) noexcept
-    {
-        int length = 0;
-        a += lenA - 1;
-        b += lenB - 1;
+                    if (x2 > n)
+                    {
+                        k2End += 2;
+                    }
+                    else if (y2 > m)
+                    {
+                        k2Start += 2;
+                    }
+                    else if (! deltaIsOdd)
+                    {
+                        auto k1Offset = offset + delta - k2;
+
+                        if (k1Offset >= 0 && k1Offset < vLength && v1[k1Offset] != -1)
+                        {
+                            auto x1 = v1[k1Offset];
+
+                            if (x1 >= n - x2)
+                            {
+                                splitA = startA + x1;
+                                splitB = startB + x1 - (k1Offset - offset);
+                                return true;
+                            }
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
 
-        while (length < lenA && length < lenB && *a == *b)
+        void addHunk (int startA, int lengthA, int startB, int lengthB)
         {
-            --a;
-            --b;
-            ++length;
+            if (lengthA == 0 && lengthB == 0)
+                return;
+
+            if (! hunks.isEmpty())
+            {
+                auto& last = hunks.getReference (hunks.size() - 1);
+
+                if (last.startA + last.lengthA == startA && last.startB + last.lengthB == startB)
+                {
+                    last.lengthA += lengthA;
+                    last.lengthB += lengthB;
+                    return;
+                }
+            }
+
+            hunks.add ({ startA, lengthA, startB, lengthB });
         }
 
-        indexInA = lenA - length;
-        indexInB = lenB - length;
-        return length;
+        JUCE_DECLARE_NON_COPYABLE (Differ)
+    };
+
+    //==============================================================================
+    static void addInsertion (TextDiff& td, String::CharPointerType text, int index, int length)
+    {
+        TextDiff::Change c;
+        c.insertedText = String (text, (size_t) length);
+        c.start = index;
+        c.length = 0;
+        td.changes.add (c);
+    }
+
+    static void addDeletion (TextDiff& td, int index, int length)
+    {
+        TextDiff::Change c;
+        c.start = index;
+        c.length = length;
+        td.changes.add (c);
     }
 };
 
-TextDiff::TextDiff (const String& original, const String& target)
+TextDiff::TextDiff (const String& original, const String& target, Granularity granularity)
 {
-    TextDiffHelpers::diffSkippingCommonStart (*this, original, target);
+    HashMap<String, uint32> lineIDs;
+    TextDiffHelpers::TokenisedString a (original, granularity, lineIDs);
+    TextDiffHelpers::TokenisedString b (target, granularity, lineIDs);
+    TextDiffHelpers::Differ differ (a, b);
+
+    // each change is applied to the result of the previous ones, so everything before
+    // the current hunk already matches the target
+    auto insertionText = target.getCharPointer();
+    int insertionTextIndex = 0;
+
+    for (auto& hunk : differ.hunks)
+    {
+        auto start = b.getCharIndex (hunk.startB);
+
+        if (hunk.lengthA > 0)
+            TextDiffHelpers::addDeletion (*this, start, a.getCharIndex (hunk.startA + hunk.lengthA) - a.getCharIndex (hunk.startA));
+
+        if (hunk.lengthB > 0)
+        {
+            insertionText += start - insertionTextIndex;
+            insertionTextIndex = start;
+            TextDiffHelpers::addInsertion (*this, insertionText, start, b.getCharIndex (hunk.startB + hunk.lengthB) - start);
+        }
+    }
 }
 
 String TextDiff::appliedTo (String text) const
 {
-    for (auto& c : changes)
-        text = c.appliedTo (text);
+    // When the changes are in order, which they will be if they came from the constructor,
+    // the result can be built in one pass rather than by copying the whole string for each change.
+    String result;
+    result.preallocateBytes (text.getNumBytesAsUTF8());
+
+    auto source = text.getCharPointer();
+    auto numRemaining = text.length();
+    int resultLength = 0, i = 0;
+
+    for (; i < changes.size(); ++i)
+    {
+        auto& c = changes.getReference (i);
+        auto numToCopy = c.start - resultLength;
 
-    return text;
+        if (numToCopy < 0 || c.length < 0 || numToCopy + c.length > numRemaining)
+            break;
+
+        auto end = source + numToCopy;
+        result.appendCharPointer (source, end);
+        result += c.insertedText;
+
+        source = end + c.length;
+        numRemaining -= numToCopy + c.length;
+        resultLength = c.start + c.insertedText.length();
+    }
+
+    result.appendCharPointer (source);
+
+    for (; i < changes.size(); ++i)
+        result = changes.getReference (i).appliedTo (result);
+
+    return result;
 }
 
 bool TextDiff::Change::isDeletion() const noexcept
@@ -251,6 +414,32 @@ public:
         TextDiff diff (a, b);
         auto result = diff.appliedTo (a);
         expectEquals (result, b);
+
+        TextDiff lineDiff (a, b, TextDiff::Granularity::lines);
+        expectEquals (lineDiff.appliedTo (a), b);
+    }
+
+    static String createDocument (Random& r, int numLines)
+    {
+        String s;
+
+        for (int i = 0; i < numLines; ++i)
+            s << "line " << r.nextInt (numLines / 4 + 1) << (r.nextInt (10) == 0 ? "\r\n" : "\n");
+
+        return s;
+    }
+
+    static String withRandomEdits (Random& r, String s, int numEdits)
+    {
+        for (int i = 0; i < numEdits; ++i)
+        {
+            auto pos = r.nextInt (s.length() + 1);
+            auto length = jmin (r.nextInt (20), s.length() - pos);
+
+            s = s.replaceSection (pos, r.nextBool() ? length : 0, r.nextBool() ? createString (r).substring (0, 30) : String());
+        }
+
+        return s;
     }
 
     void runTest() override
@@ -273,6 +462,27 @@ public:
             testDiff (s, createString (r));
             testDiff (s + createString (r), s + createString (r));
         }
+
+        beginTest ("Minimal changes");
+        {
+            TextDiff diff ("the quick brown fox", "the slow brown fox");
+            expectEquals (diff.changes.size(), 2);
+            expect (diff.changes.getReference (0).isDeletion());
+            expectEquals (diff.changes.getReference (1).insertedText, String ("slow"));
+
+            TextDiff lineDiff ("one\ntwo\nthree\n", "one\n2\nthree\nfour", TextDiff::Granularity::lines);
+            expectEquals (lineDiff.changes.size(), 3);
+            expectEquals (lineDiff.changes.getReference (1).insertedText, String ("2\n"));
+            expectEquals (lineDiff.changes.getReference (2).insertedText, String ("four"));
+        }
+
+        beginTest ("Large documents");
+        {
+            auto original = createDocument (r, 20000);
+            testDiff (original, withRandomEdits (r, original, 50));
+            testDiff (original, createDocument (r, 20000));
+            testDiff (String::repeatedString (createString (r), 200), String::repeatedString (createString (r), 200));
+        }
     }
 };
 
@@ -31,14 +31,27 @@ namespace juce
     each change can be either an insertion or a deletion. When applied in order
     to the original string, these changes will convert it to the target string.
 
+    The changes are found with Myers' O(ND) difference algorithm, so the time taken
+    depends mainly on how different the two strings are, rather than how long they are.
+    For large documents, comparing them line-by-line is quicker still.
+
     @tags{Core}
 */
 class JUCE_API TextDiff
 {
 public:
+    /** Specifies the units in which a TextDiff compares its strings. */
+    enum class Granularity
+    {
+        characters,  /**< Finds the individual characters that need to be inserted or deleted. */
+        lines        /**< Compares whole lines, so each change will insert or delete complete lines.
+                          This is much faster and uses less memory for large documents. */
+    };
+
     /** Creates a set of diffs for converting the original string into the target. */
     TextDiff (const String& original,
-              const String& target);
+              const String& target,
+              Granularity granularity = Granularity::characters);
 
     /** Applies this sequence of changes to the original string, producing the
         target string that was specified when generating them.
@@ -36,6 +36,19 @@ int ChildProcess::readProcessOutput (void* dest, int numBytes)
     return activeProcess != nullptr ? activeProcess->read (dest, numBytes) : 0;
 }
 
+int ChildProcess::readProcessError (void* dest, int numBytes)
+{
+    return activeProcess != nullptr ? activeProcess->readError (dest, numBytes) : 0;
+}
+
+bool ChildProcess::readProcessOutputAsync (SocketReactor& reactor, OutputCallback callback)
+{
+    jassert (callback != nullptr);
+
+    return activeProcess != nullptr && callback != nullptr
+            && activeProcess->startReadingAsync (reactor, std::move (callback));
+}
+
 bool ChildProcess::kill()
 {
     return activeProcess == nullptr || activeProcess->killProcess();
@@ -104,6 +117,69 @@ public:
         //String output (p.readAllProcessOutput());
         //expect (output.isNotEmpty());
       #endif
+
+      #if JUCE_MAC || JUCE_LINUX
+        beginTest ("Separate error output");
+        {
+            ChildProcess process;
+            expect (process.start (StringArray ("sh", "-c", "echo output; echo error 1>&2"),
+                                   ChildProcess::wantStdOut | ChildProcess::wantStdErr | ChildProcess::separateStdErr));
+
+            expectEquals (process.readAllProcessOutput().trim(), String ("output"));
+
+            char buffer[64] = {};
+            expectEquals (process.readProcessError (buffer, (int) sizeof (buffer) - 1), 6);
+            expectEquals (String (buffer), String ("error\n"));
+        }
+
+        beginTest ("Asynchronous output");
+        {
+            enum { numProcesses = 4 };
+
+            SocketReactor reactor (1);
+            OwnedArray<ChildProcess> processes;
+            StringArray outputs, errors;
+            std::atomic<int> numStreamsOpen { 2 * numProcesses };
+            WaitableEvent finished;
+            CriticalSection lock;
+
+            for (int i = 0; i < numProcesses; ++i)
+            {
+                outputs.add ({});
+                errors.add ({});
+
+                auto* process = processes.add (new ChildProcess());
+                auto command = "echo out" + String (i) + "; echo err" + String (i) + " 1>&2";
+                expect (process->start (StringArray ("sh", "-c", command),
+                                        ChildProcess::wantStdOut | ChildProcess::wantStdErr | ChildProcess::separateStdErr));
+
+                expect (process->readProcessOutputAsync (reactor, [&, i] (ChildProcess::StreamFlags stream, const void* data, int numBytes)
+                {
+                    if (numBytes == 0)
+                    {
+                        if (--numStreamsOpen == 0)
+                            finished.signal();
+
+                        return;
+                    }
+
+                    const ScopedLock sl (lock);
+                    auto& dest = (stream == ChildProcess::wantStdErr ? errors : outputs).getReference (i);
+                    dest += String (static_cast<const char*> (data), (size_t) numBytes);
+                }));
+
+                expect (! process->readProcessOutputAsync (reactor, [] (ChildProcess::StreamFlags, const void*, int) {}));
+            }
+
+            expect (finished.wait (10000));
+
+            for (int i = 0; i < processes.size(); ++i)
+            {
+                expectEquals (outputs[i].trim(), "out" + String (i));
+                expectEquals (errors[i].trim(), "err" + String (i));
+            }
+        }
+      #endif
     }
 };
 
@@ -23,6 +23,8 @@
 namespace juce
 {
 
+class SocketReactor;
+
 //==============================================================================
 /**
     Launches and monitors a child process.
@@ -30,6 +32,10 @@ namespace juce
     This class lets you launch an executable, and read its output. You can also
     use it to check whether the child process has finished.
 
+    The output can either be read with readProcessOutput(), which blocks, or be
+    delivered to a callback as it arrives with readProcessOutputAsync(), which lets
+    a small number of threads look after a large number of processes.
+
     @tags{Core}
 */
 class JUCE_API  ChildProcess
@@ -50,7 +56,13 @@ public:
     enum StreamFlags
     {
         wantStdOut = 1,
-        wantStdErr = 2
+        wantStdErr = 2,
+
+        /** If this is used along with wantStdErr, the child's stderr is kept apart from its
+            stdout, and can be read with readProcessError(), rather than being mixed in with
+            the output that readProcessOutput() returns.
+        */
+        separateStdErr = 4
     };
 
     /** Attempts to launch a child process command.
@@ -84,11 +96,47 @@ public:
     */
     int readProcessOutput (void* destBuffer, int numBytesToRead);
 
+    /** Attempts to read some of the child process's error output.
+        This only returns anything if the process was started with both the wantStdErr
+        and separateStdErr flags - otherwise, its error output is either discarded or
+        mixed in with the output that readProcessOutput() returns.
+        @see readProcessOutput
+    */
+    int readProcessError (void* destBuffer, int numBytesToRead);
+
     /** Blocks until the process has finished, and then returns its complete output
         as a string.
     */
     String readAllProcessOutput();
 
+    //==============================================================================
+    /** The function that readProcessOutputAsync() calls with the process's output.
+
+        It's given the stream that the data came from (wantStdOut, or wantStdErr if the
+        process was started with separateStdErr), and the data itself. When a stream is
+        closed, which normally means that the process has finished, this is called once
+        more for that stream with a null pointer and a size of zero.
+    */
+    using OutputCallback = std::function<void (StreamFlags stream, const void* data, int numBytes)>;
+
+    /** Starts delivering the child process's output to a callback as it arrives, so that
+        there's no need for a thread to sit waiting in readProcessOutput().
+
+        On Linux and Apple systems, the process's pipes are watched by the SocketReactor
+        that you pass in, so any number of processes can share the reactor's threads, and
+        the callback is called on one of those threads. On Windows, anonymous pipes can't
+        be watched in that way, so each of the process's streams is read by a background
+        thread of its own instead, and the reactor isn't used.
+
+        The callback is never called on more than one thread at a time, but it shouldn't
+        block, as that would hold up the other processes sharing the reactor. The reactor
+        must outlive this object, or the next call to start(), and after calling this you
+        shouldn't call readProcessOutput() or readProcessError().
+
+        @returns false if there's no process, or its output is already being read
+    */
+    bool readProcessOutputAsync (SocketReactor& reactor, OutputCallback callback);
+
     /** Blocks until the process is no longer running. */
     bool waitForProcessToFinish (int timeoutMs) const;
 
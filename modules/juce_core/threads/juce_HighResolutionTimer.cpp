@@ -23,6 +23,406 @@
 namespace juce
 {
 
+//==============================================================================
+// Sleeps until an absolute deadline on the system's monotonic clock, unless it's woken first
+class HighResolutionTimerWaiter
+{
+public:
+    enum : int64 { noDeadline = std::numeric_limits<int64>::max() };
+
+   #if JUCE_WINDOWS
+    HighResolutionTimerWaiter()
+    {
+        // High-resolution waitable timers need Windows 10 1803 or later, so fall back to an
+        // ordinary one with a raised system timer resolution where they're not available
+        using CreateWaitableTimerExWFn = HANDLE (WINAPI*) (LPSECURITY_ATTRIBUTES, LPCWSTR, DWORD, DWORD);
+
+        if (auto createTimer = (CreateWaitableTimerExWFn) GetProcAddress (GetModuleHandleA ("kernel32.dll"), "CreateWaitableTimerExW"))
+            timer = createTimer (nullptr, nullptr, 0x00000002 /* CREATE_WAITABLE_TIMER_HIGH_RESOLUTION */, TIMER_ALL_ACCESS);
+
+        if (timer == nullptr)
+        {
+            timer = CreateWaitableTimer (nullptr, FALSE, nullptr);
+            raisedTimerResolution = (timeBeginPeriod (1) == TIMERR_NOERROR);
+        }
+
+        wakeEvent = CreateEvent (nullptr, FALSE, FALSE, nullptr);
+    }
+
+    ~HighResolutionTimerWaiter()
+    {
+        if (raisedTimerResolution)
+            timeEndPeriod (1);
+
+        CloseHandle (timer);
+        CloseHandle (wakeEvent);
+    }
+
+    static int64 getNanoseconds() noexcept
+    {
+        static const int64 frequency = []
+        {
+            LARGE_INTEGER f;
+            QueryPerformanceFrequency (&f);
+            return (int64) f.QuadPart;
+        }();
+
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter (&counter);
+
+        auto seconds = (int64) counter.QuadPart / frequency;
+        return seconds * 1000000000 + (((int64) counter.QuadPart - seconds * frequency) * 1000000000) / frequency;
+    }
+
+    void waitUntil (int64 deadline) noexcept
+    {
+        if (deadline == noDeadline)
+        {
+            WaitForSingleObject (wakeEvent, INFINITE);
+            return;
+        }
+
+        auto remaining = deadline - getNanoseconds();
+
+        if (remaining <= 0)
+            return;
+
+        // negative due times are relative, in 100ns units
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -jmax ((int64) 1, remaining / 100);
+
+        if (! SetWaitableTimer (timer, &dueTime, 0, nullptr, nullptr, FALSE))
+        {
+            WaitForSingleObject (wakeEvent, (DWORD) jmax ((int64) 1, remaining / 1000000));
+            return;
+        }
+
+        HANDLE handles[] = { wakeEvent, timer };
+
+        if (WaitForMultipleObjects (2, handles, FALSE, INFINITE) == WAIT_OBJECT_0)
+            CancelWaitableTimer (timer);
+    }
+
+    void wake() noexcept
+    {
+        SetEvent (wakeEvent);
+    }
+
+private:
+    HANDLE timer = nullptr, wakeEvent = nullptr;
+    bool raisedTimerResolution = false;
+
+   #else
+    HighResolutionTimerWaiter()
+    {
+        pthread_condattr_t attr;
+        pthread_condattr_init (&attr);
+
+       #if JUCE_LINUX || (JUCE_ANDROID && defined(__ANDROID_API__) && __ANDROID_API__ >= 21)
+        pthread_condattr_setclock (&attr, CLOCK_MONOTONIC);
+       #endif
+
+        pthread_cond_init (&condition, &attr);
+        pthread_condattr_destroy (&attr);
+        pthread_mutex_init (&mutex, nullptr);
+    }
+
+    ~HighResolutionTimerWaiter()
+    {
+        pthread_cond_destroy (&condition);
+        pthread_mutex_destroy (&mutex);
+    }
+
+    static int64 getNanoseconds() noexcept
+    {
+       #if JUCE_MAC || JUCE_IOS
+        static const mach_timebase_info_data_t timebase = []
+        {
+            mach_timebase_info_data_t t;
+            (void) mach_timebase_info (&t);
+            return t;
+        }();
+
+        auto ticks = mach_absolute_time();
+        return (int64) ((ticks / timebase.denom) * timebase.numer + ((ticks % timebase.denom) * timebase.numer) / timebase.denom);
+       #else
+        struct timespec t;
+        clock_gettime (CLOCK_MONOTONIC, &t);
+        return 1000000000 * (int64) t.tv_sec + (int64) t.tv_nsec;
+       #endif
+    }
+
+    void waitUntil (int64 deadline) noexcept
+    {
+        pthread_mutex_lock (&mutex);
+
+        if (! woken)
+        {
+            if (deadline == noDeadline)
+            {
+                pthread_cond_wait (&condition, &mutex);
+            }
+            else
+            {
+               #if JUCE_LINUX || (JUCE_ANDROID && defined(__ANDROID_API__) && __ANDROID_API__ >= 21)
+                // the condition uses the monotonic clock, so the deadline can be used directly
+                auto absoluteTime = toTimespec (deadline);
+                pthread_cond_timedwait (&condition, &mutex, &absoluteTime);
+               #else
+                auto remaining = deadline - getNanoseconds();
+
+                if (remaining > 0)
+                {
+                   #if JUCE_MAC || JUCE_IOS
+                    auto relativeTime = toTimespec (remaining);
+                    pthread_cond_timedwait_relative_np (&condition, &mutex, &relativeTime);
+                   #else
+                    struct timespec now;
+                    clock_gettime (CLOCK_REALTIME, &now);
+                    auto absoluteTime = toTimespec (1000000000 * (int64) now.tv_sec + (int64) now.tv_nsec + remaining);
+                    pthread_cond_timedwait (&condition, &mutex, &absoluteTime);
+                   #endif
+                }
+               #endif
+            }
+        }
+
+        woken = false;
+        pthread_mutex_unlock (&mutex);
+    }
+
+    void wake() noexcept
+    {
+        pthread_mutex_lock (&mutex);
+        woken = true;
+        pthread_cond_signal (&condition);
+        pthread_mutex_unlock (&mutex);
+    }
+
+private:
+    pthread_cond_t condition;
+    pthread_mutex_t mutex;
+    bool woken = false;
+
+    static struct timespec toTimespec (int64 nanoseconds) noexcept
+    {
+        struct timespec t;
+        t.tv_sec  = (time_t) (nanoseconds / 1000000000);
+        t.tv_nsec = (long)   (nanoseconds % 1000000000);
+        return t;
+    }
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (HighResolutionTimerWaiter)
+};
+
+//==============================================================================
+// A single thread that runs all the HighResolutionTimers, keeping them in a heap
+// ordered by their next deadlines
+class HighResolutionTimerThread  : private Thread
+{
+public:
+    using Pimpl = HighResolutionTimer::Pimpl;
+
+    HighResolutionTimerThread()  : Thread ("HighResolutionTimer")
+    {
+        startRealtimeThread (RealtimeOptions());
+    }
+
+    ~HighResolutionTimerThread()
+    {
+        signalThreadShouldExit();
+        waiter.wake();
+        stopThread (-1);
+    }
+
+    static int64 getNanoseconds() noexcept     { return HighResolutionTimerWaiter::getNanoseconds(); }
+
+    bool isTimerThread() const noexcept        { return getCurrentThreadId() == getThreadId(); }
+
+    void schedule (Pimpl& timer, int64 deadline);
+    void unschedule (Pimpl& timer);
+    void waitForCallbackToFinish (Pimpl& timer);
+
+    CriticalSection lock;
+
+private:
+    Array<Pimpl*> heap;
+    Pimpl* currentCallback = nullptr;
+    WaitableEvent callbackFinished;
+    HighResolutionTimerWaiter waiter;
+
+    void run() override;
+    static bool isLaterDeadline (const Pimpl*, const Pimpl*) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (HighResolutionTimerThread)
+};
+
+//==============================================================================
+struct HighResolutionTimer::Pimpl
+{
+    Pimpl (HighResolutionTimer& t)  : owner (t) {}
+
+    ~Pimpl()
+    {
+        jassert (periodMs == 0);
+    }
+
+    void start (int newPeriod)
+    {
+        {
+            const ScopedLock sl (timerThread->lock);
+
+            if (periodMs == newPeriod && isScheduled)
+                return;
+
+            timerThread->unschedule (*this);
+            periodMs = newPeriod;
+            lateness.reset();
+            timerThread->schedule (*this, HighResolutionTimerThread::getNanoseconds() + newPeriod * (int64) 1000000);
+        }
+    }
+
+    void stop()
+    {
+        {
+            const ScopedLock sl (timerThread->lock);
+            periodMs = 0;
+            timerThread->unschedule (*this);
+        }
+
+        if (! timerThread->isTimerThread())
+            timerThread->waitForCallbackToFinish (*this);
+    }
+
+    StatisticsAccumulator<double> getLatenessStatistics() const
+    {
+        const ScopedLock sl (timerThread->lock);
+        return lateness;
+    }
+
+    HighResolutionTimer& owner;
+    std::atomic<int> periodMs { 0 };
+
+    // these are all protected by the thread's lock
+    int64 nextDeadline = 0;
+    bool isScheduled = false;
+    StatisticsAccumulator<double> lateness;
+
+    SharedResourcePointer<HighResolutionTimerThread> timerThread;
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
+
+//==============================================================================
+bool HighResolutionTimerThread::isLaterDeadline (const Pimpl* a, const Pimpl* b) noexcept
+{
+    return a->nextDeadline > b->nextDeadline;
+}
+
+void HighResolutionTimerThread::schedule (Pimpl& timer, int64 deadline)
+{
+    const ScopedLock sl (lock);
+    jassert (! timer.isScheduled);
+
+    timer.nextDeadline = deadline;
+    timer.isScheduled = true;
+    heap.add (&timer);
+    std::push_heap (heap.begin(), heap.end(), isLaterDeadline);
+
+    if (heap.getFirst() == &timer)
+        waiter.wake();
+}
+
+void HighResolutionTimerThread::unschedule (Pimpl& timer)
+{
+    const ScopedLock sl (lock);
+
+    if (timer.isScheduled)
+    {
+        heap.removeFirstMatchingValue (&timer);
+        std::make_heap (heap.begin(), heap.end(), isLaterDeadline);
+        timer.isScheduled = false;
+    }
+}
+
+void HighResolutionTimerThread::waitForCallbackToFinish (Pimpl& timer)
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (currentCallback != &timer)
+                return;
+        }
+
+        callbackFinished.wait (1);
+    }
+}
+
+void HighResolutionTimerThread::run()
+{
+    while (! threadShouldExit())
+    {
+        Pimpl* timer = nullptr;
+        auto deadline = (int64) HighResolutionTimerWaiter::noDeadline;
+        auto now = getNanoseconds();
+
+        {
+            const ScopedLock sl (lock);
+
+            if (! heap.isEmpty())
+            {
+                deadline = heap.getFirst()->nextDeadline;
+
+                if (deadline <= now)
+                {
+                    std::pop_heap (heap.begin(), heap.end(), isLaterDeadline);
+                    timer = heap.removeAndReturn (heap.size() - 1);
+                    timer->isScheduled = false;
+                    timer->lateness.addValue ((double) (now - deadline) * 1.0e-6);
+                    currentCallback = timer;
+                }
+            }
+        }
+
+        if (timer == nullptr)
+        {
+            waiter.waitUntil (deadline);
+            continue;
+        }
+
+        timer->owner.hiResTimerCallback();
+
+        {
+            const ScopedLock sl (lock);
+            currentCallback = nullptr;
+
+            // If the callback restarted or stopped the timer, that takes precedence. Otherwise
+            // the next deadline is a whole period after the last one, rather than after now, so
+            // that the timer doesn't drift. If it's fallen behind, the missed callbacks are
+            // skipped rather than being made in a burst.
+            auto periodMs = timer->periodMs.load();
+
+            if (! timer->isScheduled && periodMs > 0)
+            {
+                auto period = periodMs * (int64) 1000000;
+                auto nextDeadline = deadline + period;
+                auto timeNow = getNanoseconds();
+
+                if (nextDeadline <= timeNow)
+                    nextDeadline += ((timeNow - nextDeadline) / period + 1) * period;
+
+                schedule (*timer, nextDeadline);
+            }
+        }
+
+        callbackFinished.signal();
+    }
+}
+
+//==============================================================================
 HighResolutionTimer::HighResolutionTimer()                    { pimpl.reset (new Pimpl (*this)); }
 HighResolutionTimer::~HighResolutionTimer()                   { stopTimer(); }
 
@@ -32,4 +432,115 @@ void HighResolutionTimer::stopTimer()                         { pimpl->stop(); }
 bool HighResolutionTimer::isTimerRunning() const noexcept     { return pimpl->periodMs != 0; }
 int HighResolutionTimer::getTimerInterval() const noexcept    { return pimpl->periodMs; }
 
+StatisticsAccumulator<double> HighResolutionTimer::getCallbackLatenessStatistics() const
+{
+    return pimpl->getLatenessStatistics();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class HighResolutionTimerTests  : public UnitTest
+{
+public:
+    HighResolutionTimerTests() : UnitTest ("HighResolutionTimer", "Threads") {}
+
+    struct TestTimer  : public HighResolutionTimer
+    {
+        TestTimer (std::function<void()> fn = {}) : onCallback (std::move (fn)) {}
+        ~TestTimer() override   { stopTimer(); }
+
+        void hiResTimerCallback() override
+        {
+            ++numCallbacks;
+
+            if (onCallback != nullptr)
+                onCallback();
+        }
+
+        std::function<void()> onCallback;
+        std::atomic<int> numCallbacks { 0 };
+    };
+
+    void runTest() override
+    {
+        beginTest ("Many timers");
+        {
+            OwnedArray<TestTimer> timers;
+
+            for (int i = 0; i < 20; ++i)
+                timers.add (new TestTimer())->startTimer (1 + i % 5);
+
+            Thread::sleep (300);
+
+            for (auto* t : timers)
+                t->stopTimer();
+
+            bool allCalled = true, allStopped = true;
+
+            for (int i = 0; i < timers.size(); ++i)
+            {
+                auto* t = timers.getUnchecked (i);
+                allCalled = allCalled && t->numCallbacks.load() > 300 / (2 * (1 + i % 5));
+                allStopped = allStopped && ! t->isTimerRunning();
+            }
+
+            expect (allCalled);
+            expect (allStopped);
+
+            // no more callbacks can happen once stopTimer() has returned
+            auto numCallbacks = timers[0]->numCallbacks.load();
+            Thread::sleep (20);
+            expectEquals (timers[0]->numCallbacks.load(), numCallbacks);
+        }
+
+        beginTest ("No drift");
+        {
+            TestTimer timer;
+            auto startTime = Time::getMillisecondCounterHiRes();
+            timer.startTimer (2);
+            Thread::sleep (400);
+            auto elapsed = Time::getMillisecondCounterHiRes() - startTime;
+            timer.stopTimer();
+
+            // a timer that drifted would lose a little time on every callback
+            expect (std::abs (timer.numCallbacks.load() - elapsed / 2.0) < 10.0 || timer.getCallbackLatenessStatistics().getMaxValue() > 2.0);
+            expect (timer.getCallbackLatenessStatistics().getCount() == (size_t) timer.numCallbacks.load());
+            expect (timer.getCallbackLatenessStatistics().getMinValue() >= 0.0);
+        }
+
+        beginTest ("Changing timers from a callback");
+        {
+            TestTimer other;
+            other.startTimer (1);
+
+            TestTimer* self = nullptr;
+            TestTimer timer ([&]
+            {
+                if (self->numCallbacks == 3)
+                {
+                    self->startTimer (5);
+                }
+                else if (self->numCallbacks == 5)
+                {
+                    other.stopTimer();
+                    self->stopTimer();
+                }
+            });
+
+            self = &timer;
+            timer.startTimer (1);
+            Thread::sleep (200);
+
+            expectEquals (timer.numCallbacks.load(), 5);
+            expect (! timer.isTimerRunning());
+            expect (! other.isTimerRunning());
+        }
+    }
+};
+
+static HighResolutionTimerTests highResolutionTimerTests;
+
+#endif
+
 } // namespace juce
@@ -30,10 +30,12 @@ namespace juce
     class, this one uses a dedicated thread, not the message thread, so is
     far more stable and precise.
 
-    You should only use this class in situations where you really need accuracy,
-    because unlike the normal Timer class, which is very lightweight and cheap
-    to start/stop, the HighResolutionTimer will use far more resources, and
-    starting/stopping it may involve launching and killing threads.
+    All HighResolutionTimers share a single realtime-priority thread, which
+    sleeps until the earliest pending deadline. Each timer's deadlines are kept
+    on a fixed grid of multiples of its interval, so small delays in making
+    callbacks don't accumulate into drift. Because the callbacks of all the
+    timers are made on the same thread, they should each return quickly,
+    otherwise they'll delay the others.
 
     @see Timer
 
@@ -92,8 +94,17 @@ public:
     */
     int getTimerInterval() const noexcept;
 
+    /** Returns statistics about how late the callbacks have been, in milliseconds.
+
+        Each value is the time between a callback's deadline and the moment it was actually
+        made, so this gives a measure of the timer's jitter. The statistics are reset whenever
+        the timer is started.
+    */
+    StatisticsAccumulator<double> getCallbackLatenessStatistics() const;
+
 private:
     struct Pimpl;
+    friend class HighResolutionTimerThread;
     std::unique_ptr<Pimpl> pimpl;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HighResolutionTimer)
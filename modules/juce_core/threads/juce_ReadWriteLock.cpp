@@ -23,47 +23,120 @@
 namespace juce
 {
 
+// Each thread remembers which ReadWriteLocks it's reading, so that recursive and
+// upgrading locks can be handled without searching a shared list
+struct ReadWriteLock::ThreadState
+{
+    ThreadState() noexcept
+    {
+        static std::atomic<int> nextSlot { 0 };
+        slot = (nextSlot++) % numReaderSlots;
+    }
+
+    int* findReadCount (const ReadWriteLock* lock) noexcept
+    {
+        for (auto& l : readLocks)
+            if (l.lock == lock)
+                return &l.count;
+
+        return nullptr;
+    }
+
+    void removeReadLock (const ReadWriteLock* lock) noexcept
+    {
+        for (int i = readLocks.size(); --i >= 0;)
+            if (readLocks.getReference (i).lock == lock)
+                readLocks.remove (i);
+    }
+
+    struct HeldReadLock
+    {
+        const ReadWriteLock* lock;
+        int count;
+    };
+
+    Array<HeldReadLock> readLocks;
+    int slot;
+};
+
+ReadWriteLock::ThreadState& ReadWriteLock::getThreadState() noexcept
+{
+    static thread_local ThreadState state;
+    return state;
+}
+
+//==============================================================================
 ReadWriteLock::ReadWriteLock() noexcept
 {
-    readerThreads.ensureStorageAllocated (16);
 }
 
 ReadWriteLock::~ReadWriteLock() noexcept
 {
-    jassert (readerThreads.size() == 0);
+    jassert (getNumReaders() == 0);
     jassert (numWriters == 0);
 }
 
+int ReadWriteLock::getNumReaders() const noexcept
+{
+    int total = 0;
+
+    for (auto& s : readerSlots)
+        total += s.numReaders.load();
+
+    return total;
+}
+
 //==============================================================================
 void ReadWriteLock::enterRead() const noexcept
 {
+    if (tryEnterRead())
+        return;
+
+    ++numWaitingReaders;
+
     while (! tryEnterRead())
-        waitEvent.wait (100);
+        readerEvent.wait (100);
+
+    --numWaitingReaders;
+
+    // pass the wake-up on to any other readers that were let in by the same writer
+    if (numWaitingReaders.load() > 0)
+        readerEvent.signal();
 }
 
 bool ReadWriteLock::tryEnterRead() const noexcept
 {
-    const Thread::ThreadID threadId = Thread::getCurrentThreadId();
+    auto& thread = getThreadState();
 
-    const SpinLock::ScopedLockType sl (accessLock);
+    if (auto* count = thread.findReadCount (this))
+    {
+        ++*count;
+        return true;
+    }
 
-    for (int i = 0; i < readerThreads.size(); ++i)
+    auto& slot = readerSlots[thread.slot].numReaders;
+
+    if (writerThreadId.load() == Thread::getCurrentThreadId())
+    {
+        ++slot;
+        thread.readLocks.add ({ this, 1 });
+        return true;
+    }
+
+    // Waiting writers take precedence over new readers
+    if (numWaitingWriters.load() == 0 && ! writerClaimed.load())
     {
-        ThreadRecursionCount& trc = readerThreads.getReference(i);
+        ++slot;
 
-        if (trc.threadID == threadId)
+        // a writer that claimed the lock in the meantime will be waiting for this count to drop
+        if (! writerClaimed.load())
         {
-            trc.count++;
+            thread.readLocks.add ({ this, 1 });
             return true;
         }
-    }
 
-    if (numWriters + numWaitingWriters == 0
-         || (threadId == writerThreadId && numWriters > 0))
-    {
-        ThreadRecursionCount trc = { threadId, 1 };
-        readerThreads.add (trc);
-        return true;
+        --slot;
+        drainEvent.signal();
     }
 
     return false;
@@ -71,76 +144,254 @@ bool ReadWriteLock::tryEnterRead() const noexcept
 
 void ReadWriteLock::exitRead() const noexcept
 {
-    const Thread::ThreadID threadId = Thread::getCurrentThreadId();
-    const SpinLock::ScopedLockType sl (accessLock);
+    auto& thread = getThreadState();
+    auto* count = thread.findReadCount (this);
 
-    for (int i = 0; i < readerThreads.size(); ++i)
+    if (count == nullptr)
     {
-        ThreadRecursionCount& trc = readerThreads.getReference(i);
+        jassertfalse; // unlocking a lock that wasn't locked..
+        return;
+    }
 
-        if (trc.threadID == threadId)
-        {
-            if (--(trc.count) == 0)
-            {
-                readerThreads.remove (i);
-                waitEvent.signal();
-            }
+    if (--*count == 0)
+    {
+        thread.removeReadLock (this);
+        --(readerSlots[thread.slot].numReaders);
 
-            return;
-        }
+        if (writerClaimed.load())
+            drainEvent.signal();
     }
-
-    jassertfalse; // unlocking a lock that wasn't locked..
 }
 
 //==============================================================================
 void ReadWriteLock::enterWrite() const noexcept
 {
-    const Thread::ThreadID threadId = Thread::getCurrentThreadId();
-    const SpinLock::ScopedLockType sl (accessLock);
+    if (writerThreadId.load() == Thread::getCurrentThreadId())
+    {
+        ++numWriters;
+        return;
+    }
+
+    ++numWaitingWriters;
 
-    while (! tryEnterWriteInternal (threadId))
+    for (;;)
     {
-        ++numWaitingWriters;
-        accessLock.exit();
-        waitEvent.wait (100);
-        accessLock.enter();
-        --numWaitingWriters;
+        bool expected = false;
+
+        if (writerClaimed.compare_exchange_strong (expected, true))
+            break;
+
+        writerEvent.wait (100);
     }
-}
 
-bool ReadWriteLock::tryEnterWrite() const noexcept
-{
-    const SpinLock::ScopedLockType sl (accessLock);
-    return tryEnterWriteInternal (Thread::getCurrentThreadId());
+    --numWaitingWriters;
+
+    // If this thread already has a read lock, it's only the other readers that need to exit
+    auto numOwnReaders = getThreadState().findReadCount (this) != nullptr ? 1 : 0;
+
+    while (getNumReaders() != numOwnReaders)
+        drainEvent.wait (100);
+
+    writerThreadId = Thread::getCurrentThreadId();
+    numWriters = 1;
 }
 
-bool ReadWriteLock::tryEnterWriteInternal (Thread::ThreadID threadId) const noexcept
+bool ReadWriteLock::tryEnterWrite() const noexcept
 {
-    if (readerThreads.size() + numWriters == 0
-         || threadId == writerThreadId
-         || (readerThreads.size() == 1 && readerThreads.getReference(0).threadID == threadId))
+    if (writerThreadId.load() == Thread::getCurrentThreadId())
     {
-        writerThreadId = threadId;
         ++numWriters;
         return true;
     }
 
-    return false;
+    bool expected = false;
+
+    if (! writerClaimed.compare_exchange_strong (expected, true))
+        return false;
+
+    auto numOwnReaders = getThreadState().findReadCount (this) != nullptr ? 1 : 0;
+
+    if (getNumReaders() != numOwnReaders)
+    {
+        releaseWriterClaim();
+        return false;
+    }
+
+    writerThreadId = Thread::getCurrentThreadId();
+    numWriters = 1;
+    return true;
 }
 
 void ReadWriteLock::exitWrite() const noexcept
 {
-    const SpinLock::ScopedLockType sl (accessLock);
-
     // check this thread actually had the lock..
-    jassert (numWriters > 0 && writerThreadId == Thread::getCurrentThreadId());
+    jassert (numWriters > 0 && writerThreadId.load() == Thread::getCurrentThreadId());
 
     if (--numWriters == 0)
     {
-        writerThreadId = {};
-        waitEvent.signal();
+        writerThreadId = nullptr;
+        releaseWriterClaim();
     }
 }
 
+void ReadWriteLock::releaseWriterClaim() const noexcept
+{
+    writerClaimed = false;
+
+    if (numWaitingWriters.load() > 0)
+        writerEvent.signal();
+
+    if (numWaitingReaders.load() > 0)
+        readerEvent.signal();
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ReadWriteLockTests  : public UnitTest
+{
+public:
+    ReadWriteLockTests() : UnitTest ("ReadWriteLock", "Threads") {}
+
+    struct TestThread  : public Thread
+    {
+        TestThread (std::function<void()> f) : Thread ("lock test"), fn (f) {}
+        void run() override    { fn(); }
+        std::function<void()> fn;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Recursion and upgrading");
+        {
+            ReadWriteLock lock;
+
+            lock.enterRead();
+            lock.enterRead();
+            expect (lock.tryEnterWrite());
+            lock.enterRead();
+            lock.exitRead();
+            lock.exitWrite();
+            lock.exitRead();
+            lock.exitRead();
+
+            lock.enterWrite();
+            lock.enterWrite();
+            expect (lock.tryEnterRead());
+            lock.exitRead();
+            lock.exitWrite();
+            lock.exitWrite();
+        }
+
+        beginTest ("Readers exclude writers");
+        {
+            ReadWriteLock lock;
+            std::atomic<int> result { -1 };
+
+            lock.enterRead();
+
+            TestThread other ([&]
+            {
+                result = lock.tryEnterWrite() ? 1 : 0;
+
+                if (result == 1)
+                    lock.exitWrite();
+
+                if (lock.tryEnterRead())
+                {
+                    result = result + 2;
+                    lock.exitRead();
+                }
+            });
+
+            other.startThread();
+            other.waitForThreadToExit (-1);
+            lock.exitRead();
+
+            expectEquals (result.load(), 2);
+        }
+
+        beginTest ("Waiting writers take precedence over new readers");
+        {
+            ReadWriteLock lock;
+            std::atomic<bool> writerHasLock { false };
+
+            lock.enterRead();
+
+            TestThread writer ([&]
+            {
+                lock.enterWrite();
+                writerHasLock = true;
+                Thread::sleep (20);
+                writerHasLock = false;
+                lock.exitWrite();
+            });
+
+            writer.startThread();
+            Thread::sleep (20);
+
+            std::atomic<bool> readerSawWriter { false };
+
+            TestThread reader ([&]
+            {
+                const ScopedReadLock sl (lock);
+                readerSawWriter = true;
+            });
+
+            reader.startThread();
+            Thread::sleep (20);
+            expect (! readerSawWriter.load());
+
+            lock.exitRead();
+            reader.waitForThreadToExit (-1);
+            writer.waitForThreadToExit (-1);
+            expect (readerSawWriter.load());
+        }
+
+        beginTest ("Concurrent readers and writers");
+        {
+            ReadWriteLock lock;
+            int values[2] = { 0, 0 };
+            std::atomic<bool> consistent { true };
+            OwnedArray<TestThread> threads;
+
+            for (int i = 0; i < 6; ++i)
+            {
+                threads.add (new TestThread ([&, i]
+                {
+                    for (int j = 0; j < 5000; ++j)
+                    {
+                        if (i < 2 && j % 8 == 0)
+                        {
+                            const ScopedWriteLock sl (lock);
+                            ++values[0];
+                            ++values[1];
+                        }
+                        else
+                        {
+                            const ScopedReadLock sl (lock);
+
+                            if (values[0] != values[1])
+                                consistent = false;
+                        }
+                    }
+                }));
+            }
+
+            for (auto* t : threads)
+                t->startThread();
+
+            for (auto* t : threads)
+                t->waitForThreadToExit (-1);
+
+            expect (consistent.load());
+            expectEquals (values[0], 2 * 5000 / 8);
+        }
+    }
+};
+
+static ReadWriteLockTests readWriteLockTests;
+
+#endif
+
 } // namespace juce
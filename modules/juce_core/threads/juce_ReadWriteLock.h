@@ -40,6 +40,11 @@ namespace juce
     - If a thread already has the write lock and tries to obtain a read lock, this will succeed.
     - Recursive locking is supported.
 
+    Readers register themselves in one of a set of counters that live on separate
+    cache lines, so threads that only read don't contend with each other. Taking
+    the write lock is correspondingly more expensive, because the writer has to
+    check all of the counters.
+
     @see ScopedReadLock, ScopedWriteLock, CriticalSection
 
     @tags{Core}
@@ -125,20 +130,26 @@ public:
 
 private:
     //==============================================================================
-    SpinLock accessLock;
-    WaitableEvent waitEvent;
-    mutable int numWaitingWriters = 0, numWriters = 0;
-    mutable Thread::ThreadID writerThreadId = {};
+    enum { numReaderSlots = 16 };
 
-    struct ThreadRecursionCount
+    struct ReaderSlot
     {
-        Thread::ThreadID threadID;
-        int count;
+        std::atomic<int> numReaders { 0 };
+        char padding[64 - sizeof (std::atomic<int>)];
     };
 
-    mutable Array <ThreadRecursionCount> readerThreads;
+    struct ThreadState;
+    static ThreadState& getThreadState() noexcept;
+
+    mutable ReaderSlot readerSlots[numReaderSlots];
+    mutable std::atomic<bool> writerClaimed { false };
+    mutable std::atomic<int> numWaitingWriters { 0 }, numWaitingReaders { 0 };
+    mutable std::atomic<Thread::ThreadID> writerThreadId { nullptr };
+    mutable int numWriters = 0;
+    WaitableEvent readerEvent, writerEvent, drainEvent;
 
-    bool tryEnterWriteInternal (Thread::ThreadID) const noexcept;
+    int getNumReaders() const noexcept;
+    void releaseWriterClaim() const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE (ReadWriteLock)
 };
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct TaskGroup::SharedState  : public TaskGroupScheduler,
+                                 public std::enable_shared_from_this<SharedState>
+{
+    using SubmitFunction = std::function<void (std::function<void()>)>;
+
+    SharedState (SubmitFunction submit) : submitToPool (std::move (submit)) {}
+
+    void run (std::function<void()> task) override
+    {
+        {
+            const ScopedLock sl (lock);
+            tasks.push_back (std::move (task));
+            ++numPendingTasks;
+        }
+
+        // The job doesn't know which task it'll end up running - if a waiting thread
+        // has already taken them all, it just has nothing to do
+        auto self = shared_from_this();
+        submitToPool ([self] { self->runNextTask(); });
+    }
+
+    bool runNextTask() override
+    {
+        std::function<void()> task;
+
+        {
+            const ScopedLock sl (lock);
+
+            if (tasks.empty())
+                return false;
+
+            task = std::move (tasks.front());
+            tasks.pop_front();
+        }
+
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            jassertfalse; // Your tasks mustn't throw any exceptions!
+        }
+
+        if (--numPendingTasks == 0)
+            allTasksFinished.signal();
+
+        return true;
+    }
+
+    SubmitFunction submitToPool;
+    CriticalSection lock;
+    std::deque<std::function<void()>> tasks;
+    std::atomic<int> numPendingTasks { 0 };
+    WaitableEvent allTasksFinished;
+};
+
+//==============================================================================
+TaskGroup::TaskGroup (ThreadPool& pool)
+    : scheduler (std::make_shared<SharedState> ([&pool] (std::function<void()> job) { pool.addJob (std::move (job)); })),
+      numThreads (pool.getNumThreads())
+{
+}
+
+TaskGroup::TaskGroup (WorkStealingThreadPool& pool)
+    : scheduler (std::make_shared<SharedState> ([&pool] (std::function<void()> job) { pool.addJob (std::move (job)); })),
+      numThreads (pool.getNumThreads())
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+TaskGroup::SharedState& TaskGroup::getState() const noexcept
+{
+    return static_cast<SharedState&> (*scheduler);
+}
+
+void TaskGroup::run (std::function<void()> task)
+{
+    scheduler->run (std::move (task));
+}
+
+void TaskGroup::parallelFor (Range<int> range, int grainSize, const std::function<void (Range<int>)>& function)
+{
+    if (range.isEmpty())
+        return;
+
+    if (grainSize <= 0)
+        grainSize = jmax (1, range.getLength() / (4 * numThreads));
+
+    // A group of its own means that this only waits for these chunks, rather than for
+    // anything else that's been added to this group
+    auto chunks = std::make_shared<SharedState> (getState().submitToPool);
+    auto* fn = &function;
+
+    for (auto start = range.getStart(); start < range.getEnd(); start += jmin (grainSize, range.getEnd() - start))
+    {
+        auto chunk = Range<int> (start, start + jmin (grainSize, range.getEnd() - start));
+        chunks->run ([fn, chunk] { (*fn) (chunk); });
+    }
+
+    while (chunks->numPendingTasks.load() > 0)
+        if (! chunks->runNextTask())
+            chunks->allTasksFinished.wait (1);
+}
+
+bool TaskGroup::wait (int timeOutMs)
+{
+    auto& s = getState();
+    auto start = Time::getMillisecondCounter();
+
+    while (s.numPendingTasks.load() > 0)
+    {
+        if (s.runNextTask())
+            continue;
+
+        if (timeOutMs >= 0 && Time::getMillisecondCounter() >= start + (uint32) timeOutMs)
+            return false;
+
+        s.allTasksFinished.wait (10);
+    }
+
+    return true;
+}
+
+int TaskGroup::getNumPendingTasks() const noexcept
+{
+    return getState().numPendingTasks.load();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TaskGroupTests  : public UnitTest
+{
+public:
+    TaskGroupTests() : UnitTest ("TaskGroup", "Threads") {}
+
+    void runTest() override
+    {
+        ThreadPool pool (4);
+        WorkStealingThreadPool stealingPool (4);
+
+        runTestsWith (pool);
+        runTestsWith (stealingPool);
+    }
+
+    template <typename PoolType>
+    void runTestsWith (PoolType& pool)
+    {
+        beginTest ("Waiting for tasks");
+        {
+            TaskGroup group (pool);
+            std::atomic<int> count { 0 };
+
+            for (int i = 0; i < 1000; ++i)
+                group.run ([&count] { ++count; });
+
+            expect (group.wait (10000));
+            expectEquals (count.load(), 1000);
+            expectEquals (group.getNumPendingTasks(), 0);
+        }
+
+        beginTest ("parallelFor");
+        {
+            TaskGroup group (pool);
+            Array<int> values;
+            values.insertMultiple (0, 0, 10007);
+
+            group.parallelFor ({ 0, values.size() }, 100, [&values] (Range<int> r)
+            {
+                for (auto i = r.getStart(); i < r.getEnd(); ++i)
+                    values.getReference (i) += i;
+            });
+
+            bool allCorrect = true;
+
+            for (int i = 0; i < values.size(); ++i)
+                allCorrect = allCorrect && values[i] == i;
+
+            expect (allCorrect);
+        }
+
+        beginTest ("Nested parallelFor");
+        {
+            TaskGroup group (pool);
+            std::atomic<int> count { 0 };
+
+            // more outer chunks than threads, each of which has to wait for its own inner loop
+            group.parallelFor ({ 0, 16 }, 1, [&] (Range<int>)
+            {
+                group.parallelFor ({ 0, 100 }, 10, [&count] (Range<int> r) { count += r.getLength(); });
+            });
+
+            expectEquals (count.load(), 1600);
+        }
+
+        beginTest ("Futures and continuations");
+        {
+            TaskGroup group (pool);
+            std::atomic<bool> continuationRan { false };
+
+            auto future = group.launch ([] { return 20; });
+            auto doubled = future.then ([] (const int& x) { return String (x * 2); });
+            auto done = doubled.then ([&continuationRan] (const String& s) { continuationRan = (s == "40"); });
+
+            expectEquals (future.get(), 20);
+            expectEquals (doubled.get(), String ("40"));
+            expect (done.wait (10000));
+            expect (continuationRan.load());
+
+            // a continuation added after the task has finished still runs
+            auto late = future.then ([] (const int& x) { return x + 1; });
+            expectEquals (late.get(), 21);
+
+            auto fromVoid = done.then ([] { return 7; });
+            expectEquals (fromVoid.get(), 7);
+        }
+    }
+};
+
+static TaskGroupTests taskGroupTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,365 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/** @internal
+    The part of a TaskGroup that outlives it, which the futures created by the group
+    use to schedule their continuations.
+*/
+struct JUCE_API  TaskGroupScheduler
+{
+    virtual ~TaskGroupScheduler() = default;
+
+    /** Adds a task to the group and hands a job to run it over to the pool. */
+    virtual void run (std::function<void()> task) = 0;
+
+    /** Runs one of the group's waiting tasks on the calling thread, if there are any. */
+    virtual bool runNextTask() = 0;
+};
+
+template <typename ResultType>
+class TaskFuture;
+
+#ifndef DOXYGEN
+namespace TaskFutureHelpers
+{
+    template <typename ResultType>
+    struct State
+    {
+        State (std::shared_ptr<TaskGroupScheduler> s) : scheduler (std::move (s)) {}
+
+        template <typename... Args>
+        void setResult (Args&&... args)
+        {
+            Array<std::function<void()>> continuationsToRun;
+
+            {
+                const ScopedLock sl (lock);
+                value.reset (new ResultType (std::forward<Args> (args)...));
+                ready = true;
+                continuationsToRun.swapWith (continuations);
+            }
+
+            readyEvent.signal();
+
+            for (auto& c : continuationsToRun)
+                scheduler->run (std::move (c));
+        }
+
+        void addContinuation (std::function<void()> continuation)
+        {
+            {
+                const ScopedLock sl (lock);
+
+                if (! ready)
+                {
+                    continuations.add (std::move (continuation));
+                    return;
+                }
+            }
+
+            scheduler->run (std::move (continuation));
+        }
+
+        bool isReady() const
+        {
+            const ScopedLock sl (lock);
+            return ready;
+        }
+
+        bool wait (int timeOutMs)
+        {
+            auto start = Time::getMillisecondCounter();
+
+            // Rather than just blocking, help to run the group's tasks, so that waiting on a
+            // future from inside one of the pool's jobs can't starve the pool of threads
+            while (! isReady())
+            {
+                if (scheduler->runNextTask())
+                    continue;
+
+                if (timeOutMs >= 0 && Time::getMillisecondCounter() >= start + (uint32) timeOutMs)
+                    return false;
+
+                readyEvent.wait (10);
+            }
+
+            return true;
+        }
+
+        std::shared_ptr<TaskGroupScheduler> scheduler;
+        CriticalSection lock;
+        WaitableEvent readyEvent { true };
+        std::unique_ptr<ResultType> value;
+        Array<std::function<void()>> continuations;
+        bool ready = false;
+    };
+
+    // A task that returns void still needs something to mark its future as ready
+    struct NoResult {};
+
+    template <typename ResultType> struct StoredType          { using Type = ResultType; };
+    template <>                    struct StoredType<void>    { using Type = NoResult; };
+
+    template <typename ResultType>
+    struct Invoker
+    {
+        template <typename Fn, typename... Args>
+        static void callAndSetResult (State<ResultType>& state, Fn& fn, Args&&... args)
+        {
+            state.setResult (fn (std::forward<Args> (args)...));
+        }
+    };
+
+    template <>
+    struct Invoker<void>
+    {
+        template <typename Fn, typename... Args>
+        static void callAndSetResult (State<NoResult>& state, Fn& fn, Args&&... args)
+        {
+            fn (std::forward<Args> (args)...);
+            state.setResult();
+        }
+    };
+
+    // Continuations of a void future are called with no arguments, others with the result
+    template <typename ResultType>
+    struct ContinuationCaller
+    {
+        template <typename Fn>
+        using Result = decltype (std::declval<Fn&>() (std::declval<const ResultType&>()));
+
+        template <typename Fn>
+        static void call (State<typename StoredType<Result<Fn>>::Type>& next, Fn& fn, const ResultType& value)
+        {
+            Invoker<Result<Fn>>::callAndSetResult (next, fn, value);
+        }
+    };
+
+    template <>
+    struct ContinuationCaller<void>
+    {
+        template <typename Fn>
+        using Result = decltype (std::declval<Fn&>() ());
+
+        template <typename Fn>
+        static void call (State<typename StoredType<Result<Fn>>::Type>& next, Fn& fn, const NoResult&)
+        {
+            Invoker<Result<Fn>>::callAndSetResult (next, fn);
+        }
+    };
+}
+#endif
+
+//==============================================================================
+/**
+    A handle to the result of a task that was started with TaskGroup::launch().
+
+    A TaskFuture is a lightweight, copyable object that refers to a shared result. Use
+    isReady() or wait() to find out when the task has finished, get() to retrieve what it
+    returned, and then() to start another task in the same group once it has finished.
+
+    @see TaskGroup
+
+    @tags{Core}
+*/
+template <typename ResultType>
+class TaskFuture
+{
+    using StoredType = typename TaskFutureHelpers::StoredType<ResultType>::Type;
+    using State = TaskFutureHelpers::State<StoredType>;
+
+public:
+    /** Creates an invalid future, which doesn't refer to any task. */
+    TaskFuture() = default;
+
+    /** Returns true if this future refers to a task. */
+    bool isValid() const noexcept                   { return state != nullptr; }
+
+    /** Returns true if the task has finished. */
+    bool isReady() const                            { return state != nullptr && state->isReady(); }
+
+    /** Waits for the task to finish.
+
+        While waiting, the calling thread will help to run any of the group's tasks that
+        haven't started yet, so it's safe to call this from inside a task.
+
+        @returns false if the timeout expired before the task finished
+    */
+    bool wait (int timeOutMilliseconds = -1) const
+    {
+        jassert (isValid());
+        return state == nullptr || state->wait (timeOutMilliseconds);
+    }
+
+    /** Waits for the task to finish, and returns its result.
+        For a task that returns void, this just waits.
+    */
+    const StoredType& get() const
+    {
+        jassert (isValid());
+        wait();
+        return *state->value;
+    }
+
+    /** Adds a task that will be run with the result of this one, once it's ready.
+
+        The continuation is called with a const reference to the result, or with no
+        arguments if this task returns void. It's run in the same TaskGroup, and if this
+        task has already finished, it's started straight away.
+
+        @returns a future for the result of the continuation
+    */
+    template <typename ContinuationFn>
+    TaskFuture<typename TaskFutureHelpers::ContinuationCaller<ResultType>::template Result<ContinuationFn>>
+        then (ContinuationFn continuation) const
+    {
+        using Caller = TaskFutureHelpers::ContinuationCaller<ResultType>;
+        using NextResultType = typename Caller::template Result<ContinuationFn>;
+
+        jassert (isValid());
+
+        TaskFuture<NextResultType> next (state->scheduler);
+        auto previous = state;
+        auto nextState = next.state;
+
+        state->addContinuation ([previous, nextState, continuation]() mutable
+        {
+            Caller::call (*nextState, continuation, *previous->value);
+        });
+
+        return next;
+    }
+
+private:
+    friend class TaskGroup;
+    template <typename> friend class TaskFuture;
+
+    explicit TaskFuture (std::shared_ptr<TaskGroupScheduler> scheduler)
+        : state (std::make_shared<State> (std::move (scheduler)))
+    {
+    }
+
+    std::shared_ptr<State> state;
+};
+
+//==============================================================================
+/**
+    Runs a set of tasks on a thread pool, and lets you wait for all of them to finish.
+
+    @code
+    TaskGroup group (pool);
+
+    for (auto* file : filesToDecode)
+        group.run ([file] { decode (*file); });
+
+    group.wait();
+    @endcode
+
+    A TaskGroup can also split a loop across the pool with parallelFor(), and start a task
+    that returns a value with launch(), which gives you a TaskFuture for the result.
+
+    The tasks are kept in the group's own queue, and each job that's added to the pool just
+    runs whichever task is next. A thread that calls wait() will run waiting tasks itself
+    instead of blocking, so groups can safely be nested, or waited on from inside another
+    pool job. Like ThreadPoolJob::runJob(), tasks mustn't throw exceptions.
+
+    @see ThreadPool, WorkStealingThreadPool, TaskFuture
+
+    @tags{Core}
+*/
+class JUCE_API  TaskGroup
+{
+public:
+    //==============================================================================
+    /** Creates a group that will run its tasks on a ThreadPool.
+        The pool must outlive the group, and any futures that it creates.
+    */
+    explicit TaskGroup (ThreadPool& poolToUse);
+
+    /** Creates a group that will run its tasks on a WorkStealingThreadPool.
+        The pool must outlive the group, and any futures that it creates.
+    */
+    explicit TaskGroup (WorkStealingThreadPool& poolToUse);
+
+    /** Destructor.
+        This waits for all the tasks that remain in the group to finish.
+    */
+    ~TaskGroup();
+
+    //==============================================================================
+    /** Adds a task to the group. */
+    void run (std::function<void()> task);
+
+    /** Adds a task to the group, and returns a future for its result. */
+    template <typename TaskFn>
+    TaskFuture<decltype (std::declval<TaskFn&>() ())> launch (TaskFn task)
+    {
+        using ResultType = decltype (std::declval<TaskFn&>() ());
+        using Invoker = TaskFutureHelpers::Invoker<ResultType>;
+
+        TaskFuture<ResultType> future (scheduler);
+        auto futureState = future.state;
+
+        run ([futureState, task]() mutable { Invoker::callAndSetResult (*futureState, task); });
+        return future;
+    }
+
+    /** Splits a range of indexes into chunks, and calls a function for each chunk in parallel.
+
+        This returns when every chunk has been processed. The calling thread also works through
+        the chunks while it's waiting.
+
+        @param range        the indexes to process
+        @param grainSize    the number of indexes in each chunk. If this is zero or less, a size
+                            is chosen to give each thread in the pool a few chunks
+        @param function     the function to call, with the range of indexes in each chunk
+    */
+    void parallelFor (Range<int> range, int grainSize, const std::function<void (Range<int>)>& function);
+
+    /** Waits for all the tasks in the group to finish, including any that get added while
+        this is waiting.
+
+        While waiting, the calling thread will help to run any tasks that haven't started yet.
+
+        @returns false if the timeout expired before all the tasks had finished
+    */
+    bool wait (int timeOutMilliseconds = -1);
+
+    /** Returns the number of tasks that have been added but haven't finished yet. */
+    int getNumPendingTasks() const noexcept;
+
+private:
+    //==============================================================================
+    struct SharedState;
+    std::shared_ptr<TaskGroupScheduler> scheduler;
+    int numThreads;
+
+    SharedState& getState() const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TaskGroup)
+};
+
+} // namespace juce
@@ -91,6 +91,9 @@ void Thread::threadEntryPoint()
         if (affinityMask != 0)
             setCurrentThreadAffinityMask (affinityMask);
 
+        if (realtimeOptions != nullptr)
+            realtimeOptionsApplied = setCurrentThreadRealtime (*realtimeOptions) ? 1 : 0;
+
         try
         {
             run();
@@ -139,6 +142,8 @@ void Thread::startThread (int priority)
 
     if (threadHandle.get() == nullptr)
     {
+        realtimeOptions.reset();
+
         auto isRealtime = (priority == realtimeAudioPriority);
 
        #if JUCE_ANDROID
@@ -157,6 +162,90 @@ void Thread::startThread (int priority)
     }
 }
 
+void Thread::startRealtimeThread (const RealtimeOptions& options)
+{
+    const ScopedLock sl (startStopLock);
+
+    if (threadHandle.get() == nullptr)
+    {
+        realtimeOptions.reset (new RealtimeOptions (options));
+        realtimeOptionsApplied = 0;
+
+       #if JUCE_ANDROID
+        isAndroidRealtimeThread = true;
+       #endif
+
+        // this is the priority the thread is left with if the real-time options can't be applied
+        threadPriority = 9;
+        startThread();
+    }
+}
+
+bool Thread::isRealtime() const noexcept
+{
+    return realtimeOptionsApplied.get() != 0;
+}
+
+//==============================================================================
+Thread::RealtimeOptions Thread::RealtimeOptions::withPriority (int newPriority) const
+{
+    auto o = *this;
+    o.priority = jlimit (0, 10, newPriority);
+    return o;
+}
+
+Thread::RealtimeOptions Thread::RealtimeOptions::withMemoryLocking (bool shouldLockMemory) const
+{
+    auto o = *this;
+    o.lockMemory = shouldLockMemory;
+    return o;
+}
+
+Thread::RealtimeOptions Thread::RealtimeOptions::withStackPrefaulting (size_t numBytes) const
+{
+    auto o = *this;
+    o.stackBytesToPrefault = numBytes;
+    return o;
+}
+
+Thread::RealtimeOptions Thread::RealtimeOptions::withPeriod (int samplesPerBlock, double sampleRate) const
+{
+    jassert (samplesPerBlock > 0 && sampleRate > 0);
+
+    auto o = *this;
+    o.periodMs = sampleRate > 0 ? (1000.0 * samplesPerBlock) / sampleRate : 0.0;
+    return o;
+}
+
+// Each level of recursion touches another page of the stack. The page is written again
+// after the recursive call returns, so that the compiler can't turn this into a loop.
+static void prefaultStackPages (size_t numBytesLeft)
+{
+    volatile char page[4096];
+    page[0] = 0;
+
+    if (numBytesLeft > sizeof (page))
+        prefaultStackPages (numBytesLeft - sizeof (page));
+
+    page[sizeof (page) - 1] = page[0];
+}
+
+bool Thread::setCurrentThreadRealtime (const RealtimeOptions& options)
+{
+    bool allApplied = true;
+
+    if (options.lockMemory && ! lockProcessMemory())
+        allApplied = false;
+
+    if (options.stackBytesToPrefault > 0)
+        prefaultStackPages (options.stackBytesToPrefault);
+
+    if (! setCurrentThreadRealtimeScheduling (options))
+        allApplied = false;
+
+    return allApplied;
+}
+
 bool Thread::isThreadRunning() const
 {
     return threadHandle.get() != nullptr;
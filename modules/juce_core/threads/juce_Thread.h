@@ -96,6 +96,68 @@ public:
     */
     void startThread (int priority);
 
+    //==============================================================================
+    /** Describes how a thread should be scheduled when it's started with startRealtimeThread().
+
+        @see startRealtimeThread, setCurrentThreadRealtime
+    */
+    struct RealtimeOptions
+    {
+        /** Returns a copy with a priority from 0 (lowest) to 10 (highest), which is mapped
+            onto the system's real-time range, i.e. SCHED_FIFO on Linux or the MMCSS
+            priorities on Windows.
+        */
+        RealtimeOptions withPriority (int newPriority) const;
+
+        /** Returns a copy that will lock all of the process's current and future pages into
+            RAM (using mlockall), so that the thread can't be stalled by paging. This isn't
+            available on Windows.
+        */
+        RealtimeOptions withMemoryLocking (bool shouldLockMemory) const;
+
+        /** Returns a copy that will touch this many bytes of the thread's stack before run()
+            is called, so that any page faults happen then rather than in the audio callback.
+            The thread's stack size must be bigger than this.
+        */
+        RealtimeOptions withStackPrefaulting (size_t numBytes) const;
+
+        /** Returns a copy that tells the scheduler how often the thread has to do its work.
+            On macOS and iOS this is used to give the thread a time-constraint policy,
+            which is what CoreAudio uses for its own I/O threads. Elsewhere it's ignored.
+        */
+        RealtimeOptions withPeriod (int samplesPerBlock, double sampleRate) const;
+
+        int priority = 8;
+        bool lockMemory = false;
+        size_t stackBytesToPrefault = 0;
+        double periodMs = 0;
+    };
+
+    /** Starts the thread with real-time scheduling.
+
+        The options are applied by the new thread itself, before its run() method is
+        called. If the system won't give it real-time scheduling (e.g. on Linux without
+        a suitable RLIMIT_RTPRIO), the thread still runs, but at priority 9, and
+        isRealtime() will return false.
+
+        If the thread is already running, this does nothing.
+
+        @see RealtimeOptions, isRealtime, startThread
+    */
+    void startRealtimeThread (const RealtimeOptions& options);
+
+    /** Returns true if the thread was launched with startRealtimeThread() and all of its
+        options could be applied.
+    */
+    bool isRealtime() const noexcept;
+
+    /** Applies a set of real-time options to the calling thread.
+
+        This is useful for threads that weren't created by a Thread object.
+        Returns true if all the options could be applied.
+    */
+    static bool setCurrentThreadRealtime (const RealtimeOptions& options);
+
     /** Attempts to stop the thread running.
 
         This method will cause the threadShouldExit() method to return true
@@ -392,6 +454,8 @@ private:
     uint32 affinityMask = 0;
     bool deleteOnThreadEnd = false;
     Atomic<int32> shouldExit { 0 };
+    std::unique_ptr<RealtimeOptions> realtimeOptions;
+    Atomic<int32> realtimeOptionsApplied { 0 };
     ListenerList<Listener, Array<Listener*, CriticalSection>> listeners;
 
    #if JUCE_ANDROID
@@ -407,6 +471,8 @@ private:
     void killThread();
     void threadEntryPoint();
     static bool setThreadPriority (void*, int);
+    static bool setCurrentThreadRealtimeScheduling (const RealtimeOptions&);
+    static bool lockProcessMemory();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Thread)
 };
@@ -86,7 +86,7 @@ ThreadPoolJob* ThreadPoolJob::getCurrentThreadPoolJob()
     if (auto* t = dynamic_cast<ThreadPool::ThreadPoolThread*> (Thread::getCurrentThread()))
         return t->currentJob.load();
 
-    return nullptr;
+    return WorkStealingThreadPool::getCurrentJobOnThisThread();
 }
 
 //==============================================================================
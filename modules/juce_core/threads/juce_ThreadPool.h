@@ -132,6 +132,7 @@ public:
     //==============================================================================
 private:
     friend class ThreadPool;
+    friend class WorkStealingThreadPool;
     String jobName;
     ThreadPool* pool = nullptr;
     std::atomic<bool> shouldStop { false }, isActive { false }, shouldBeDeleted { false };
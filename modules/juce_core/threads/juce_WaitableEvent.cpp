@@ -0,0 +1,327 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  Blocks a thread until a 32-bit word changes from an expected value.
+
+    This uses futexes on Linux and WaitOnAddress on Windows. Elsewhere, and on versions of
+    Windows that don't have WaitOnAddress, it falls back to a fixed table of condition
+    variables, hashed by address.
+
+    wait() can return spuriously, so callers must always re-check the word.
+*/
+struct AddressWaiter
+{
+    static void wait (const std::atomic<uint32>& word, uint32 expected, int timeOutMs) noexcept
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        struct timespec timeout;
+        timeout.tv_sec  = timeOutMs / 1000;
+        timeout.tv_nsec = (timeOutMs % 1000) * 1000000;
+
+        syscall (SYS_futex, (void*) &word, FUTEX_WAIT_PRIVATE, expected, timeOutMs < 0 ? nullptr : &timeout, nullptr, 0);
+       #else
+        #if JUCE_WINDOWS
+         auto& functions = WaitOnAddressFunctions::get();
+
+         if (functions.waitOnAddress != nullptr)
+         {
+             functions.waitOnAddress ((volatile void*) &word, &expected, sizeof (expected), timeOutMs < 0 ? INFINITE : (DWORD) timeOutMs);
+             return;
+         }
+        #endif
+
+        auto& bucket = getBucket (&word);
+        std::unique_lock<std::mutex> lock (bucket.mutex);
+
+        if (word.load() == expected)
+        {
+            if (timeOutMs < 0)
+                bucket.condition.wait (lock);
+            else
+                bucket.condition.wait_for (lock, std::chrono::milliseconds (timeOutMs));
+        }
+       #endif
+    }
+
+    static void wake (const std::atomic<uint32>& word, bool wakeAll) noexcept
+    {
+       #if JUCE_LINUX || JUCE_ANDROID
+        syscall (SYS_futex, (void*) &word, FUTEX_WAKE_PRIVATE, wakeAll ? std::numeric_limits<int>::max() : 1, nullptr, nullptr, 0);
+       #else
+        #if JUCE_WINDOWS
+         auto& functions = WaitOnAddressFunctions::get();
+
+         if (functions.waitOnAddress != nullptr)
+         {
+             (wakeAll ? functions.wakeByAddressAll : functions.wakeByAddressSingle) ((void*) &word);
+             return;
+         }
+        #endif
+
+        // Taking the lock orders this against a waiter that has checked the word but not
+        // started waiting yet. Different words can share a bucket, so everything is woken.
+        auto& bucket = getBucket (&word);
+        { std::lock_guard<std::mutex> lock (bucket.mutex); }
+        bucket.condition.notify_all();
+        ignoreUnused (wakeAll);
+       #endif
+    }
+
+private:
+   #if JUCE_WINDOWS
+    struct WaitOnAddressFunctions
+    {
+        WaitOnAddressFunctions()
+        {
+            if (auto dll = LoadLibraryA ("api-ms-win-core-synch-l1-2-0.dll"))
+            {
+                waitOnAddress       = (WaitOnAddressFn)   GetProcAddress (dll, "WaitOnAddress");
+                wakeByAddressSingle = (WakeByAddressFn)   GetProcAddress (dll, "WakeByAddressSingle");
+                wakeByAddressAll    = (WakeByAddressFn)   GetProcAddress (dll, "WakeByAddressAll");
+
+                if (wakeByAddressSingle == nullptr || wakeByAddressAll == nullptr)
+                    waitOnAddress = nullptr;
+            }
+        }
+
+        static WaitOnAddressFunctions& get()
+        {
+            static WaitOnAddressFunctions functions;
+            return functions;
+        }
+
+        using WaitOnAddressFn = BOOL (WINAPI*) (volatile void*, void*, SIZE_T, DWORD);
+        using WakeByAddressFn = void (WINAPI*) (void*);
+
+        WaitOnAddressFn waitOnAddress = nullptr;
+        WakeByAddressFn wakeByAddressSingle = nullptr, wakeByAddressAll = nullptr;
+    };
+   #endif
+
+   #if ! (JUCE_LINUX || JUCE_ANDROID)
+    struct Bucket
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+
+    static Bucket& getBucket (const void* address) noexcept
+    {
+        static Bucket buckets[64];
+        return buckets[(((pointer_sized_uint) address) >> 4) % numElementsInArray (buckets)];
+    }
+   #endif
+};
+
+//==============================================================================
+WaitableEvent::WaitableEvent (bool useManualReset) noexcept
+    : manualReset (useManualReset)
+{
+}
+
+WaitableEvent::~WaitableEvent() noexcept
+{
+    // Deleting an event that other threads are still waiting on is a bad idea!
+    jassert (numWaiters.load() == 0);
+}
+
+bool WaitableEvent::tryConsumeSignal() const noexcept
+{
+    if (manualReset)
+        return state.load() != 0;
+
+    uint32 expected = 1;
+    return state.compare_exchange_strong (expected, 0);
+}
+
+bool WaitableEvent::wait (int timeOutMilliseconds) const noexcept
+{
+    // The uncontended case never has to go near the OS
+    if (tryConsumeSignal())
+        return true;
+
+    if (timeOutMilliseconds == 0)
+        return false;
+
+    auto endTime = Time::getMillisecondCounter() + (uint32) timeOutMilliseconds;
+    ++numWaiters;
+
+    for (;;)
+    {
+        auto timeToWait = -1;
+
+        if (timeOutMilliseconds > 0)
+        {
+            timeToWait = (int) (endTime - Time::getMillisecondCounter());
+
+            if (timeToWait <= 0 || timeToWait > timeOutMilliseconds)
+                break;
+        }
+
+        AddressWaiter::wait (state, 0, timeToWait);
+
+        if (tryConsumeSignal())
+        {
+            --numWaiters;
+            return true;
+        }
+    }
+
+    --numWaiters;
+    return tryConsumeSignal();
+}
+
+void WaitableEvent::signal() const noexcept
+{
+    // Waiters increment numWaiters before they check the state, so this can't miss one
+    if (state.exchange (1) == 0 && numWaiters.load() > 0)
+        AddressWaiter::wake (state, manualReset);
+}
+
+void WaitableEvent::reset() const noexcept
+{
+    state = 0;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class WaitableEventTests  : public UnitTest
+{
+public:
+    WaitableEventTests() : UnitTest ("WaitableEvent", "Threads") {}
+
+    struct TestThread  : public Thread
+    {
+        TestThread (std::function<void()> f) : Thread ("event test"), fn (f) {}
+        void run() override    { fn(); }
+        std::function<void()> fn;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Signalling without waiters");
+        {
+            WaitableEvent event;
+            expect (! event.wait (0));
+            expect (! event.wait (10));
+
+            event.signal();
+            event.signal();
+            expect (event.wait (0));
+            expect (! event.wait (0));
+
+            event.signal();
+            event.reset();
+            expect (! event.wait (0));
+
+            WaitableEvent manualEvent (true);
+            manualEvent.signal();
+            expect (manualEvent.wait (0));
+            expect (manualEvent.wait (10));
+            manualEvent.reset();
+            expect (! manualEvent.wait (0));
+        }
+
+        beginTest ("Waking a waiting thread");
+        {
+            WaitableEvent event;
+            std::atomic<bool> woken { false };
+
+            TestThread thread ([&] { woken = event.wait (5000); });
+            thread.startThread();
+            Thread::sleep (20);
+            expect (! woken.load());
+
+            event.signal();
+            thread.waitForThreadToExit (-1);
+            expect (woken.load());
+            expect (! event.wait (0));
+        }
+
+        beginTest ("Manual reset wakes all waiters");
+        {
+            WaitableEvent event (true);
+            std::atomic<int> numWoken { 0 };
+            OwnedArray<TestThread> threads;
+
+            for (int i = 0; i < 4; ++i)
+                threads.add (new TestThread ([&] { if (event.wait (5000)) ++numWoken; }))->startThread();
+
+            Thread::sleep (20);
+            event.signal();
+
+            for (auto* t : threads)
+                t->waitForThreadToExit (-1);
+
+            expectEquals (numWoken.load(), 4);
+        }
+
+        beginTest ("Each automatic signal wakes one waiter");
+        {
+            enum { numSignals = 2000 };
+
+            WaitableEvent event, acknowledged;
+            std::atomic<int> numWoken { 0 };
+            std::atomic<bool> finished { false };
+            OwnedArray<TestThread> threads;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                threads.add (new TestThread ([&]
+                {
+                    while (! finished.load())
+                    {
+                        if (event.wait (10))
+                        {
+                            ++numWoken;
+                            acknowledged.signal();
+                        }
+                    }
+                }))->startThread();
+            }
+
+            for (int i = 0; i < numSignals; ++i)
+            {
+                event.signal();
+                acknowledged.wait (-1);
+            }
+
+            finished = true;
+
+            for (auto* t : threads)
+                t->waitForThreadToExit (-1);
+
+            expectEquals (numWoken.load(), (int) numSignals);
+        }
+    }
+};
+
+static WaitableEventTests waitableEventTests;
+
+#endif
+
+} // namespace juce
@@ -30,6 +30,10 @@ namespace juce
     A thread can call WaitableEvent::wait() to suspend the calling thread until
     another thread wakes it up by calling the WaitableEvent::signal() method.
 
+    The event's state is held in an atomic, so waiting on an event that has already
+    been signalled, or signalling one that nothing is waiting on, never needs to
+    call into the OS.
+
     @tags{Core}
 */
 class JUCE_API  WaitableEvent
@@ -97,13 +101,11 @@ public:
 
 private:
     //==============================================================================
-   #if JUCE_WINDOWS
-    void* handle;
-   #else
-    mutable pthread_cond_t condition;
-    mutable pthread_mutex_t mutex;
-    mutable bool triggered, manualReset;
-   #endif
+    mutable std::atomic<uint32> state { 0 };
+    mutable std::atomic<int> numWaiters { 0 };
+    const bool manualReset;
+
+    bool tryConsumeSignal() const noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaitableEvent)
 };
@@ -0,0 +1,571 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  A fixed-size Chase-Lev deque ("Dynamic Circular Work-Stealing Deque", Chase & Lev 2005,
+    using the C11 memory orderings from Lê et al. 2013).
+
+    Only the thread that owns it may call push() and pop(), which work on the bottom of the
+    deque and only need a compare-and-swap when there's a single job left. Any other thread
+    can call steal(), which takes from the top.
+*/
+class WorkStealingThreadPool::JobDeque
+{
+public:
+    JobDeque() noexcept
+    {
+        for (auto& s : slots)
+            s.store (nullptr, std::memory_order_relaxed);
+    }
+
+    bool push (ThreadPoolJob* job) noexcept
+    {
+        auto b = bottom.value.load (std::memory_order_relaxed);
+        auto t = top.value.load (std::memory_order_acquire);
+
+        if (b - t >= (int64) capacity)
+            return false;
+
+        slots[b & (capacity - 1)].store (job, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        bottom.value.store (b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    ThreadPoolJob* pop() noexcept
+    {
+        auto b = bottom.value.load (std::memory_order_relaxed) - 1;
+        bottom.value.store (b, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        auto t = top.value.load (std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.value.store (b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* job = slots[b & (capacity - 1)].load (std::memory_order_relaxed);
+
+        if (t == b)
+        {
+            // this was the last job, so race any thieves for it
+            if (! top.value.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                job = nullptr;
+
+            bottom.value.store (b + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    ThreadPoolJob* steal() noexcept
+    {
+        auto t = top.value.load (std::memory_order_acquire);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        auto b = bottom.value.load (std::memory_order_acquire);
+
+        if (t >= b)
+            return nullptr;
+
+        auto* job = slots[t & (capacity - 1)].load (std::memory_order_relaxed);
+
+        if (! top.value.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return job;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return bottom.value.load (std::memory_order_relaxed) <= top.value.load (std::memory_order_relaxed);
+    }
+
+private:
+    enum { capacity = 1024 }; // must be a power of two
+
+    // top and bottom are kept on separate cache lines, as they're written by different threads
+    LockFreeQueueHelpers::PaddedAtomic<int64> top, bottom;
+    std::atomic<ThreadPoolJob*> slots[capacity];
+
+    JUCE_DECLARE_NON_COPYABLE (JobDeque)
+};
+
+//==============================================================================
+struct WorkStealingThreadPool::WorkerThread  : public Thread
+{
+    WorkerThread (WorkStealingThreadPool& p, size_t stackSize)
+        : Thread ("Pool", stackSize), pool (p)
+    {
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (auto* job = pool.findJobFor (*this))
+            {
+                pool.runJob (*this, job);
+                continue;
+            }
+
+            // Announce that this thread is going to sleep before checking for work one
+            // last time, so that a job added in the meantime will either be found here,
+            // or its owner will see that there's a thread to wake up
+            isSleeping = true;
+            ++pool.numSleepingThreads;
+
+            if (auto* job = pool.findJobFor (*this))
+            {
+                isSleeping = false;
+                --pool.numSleepingThreads;
+                pool.runJob (*this, job);
+                continue;
+            }
+
+            wait (500);
+
+            isSleeping = false;
+            --pool.numSleepingThreads;
+        }
+    }
+
+    void signalCurrentJobShouldExit()
+    {
+        const SpinLock::ScopedLockType sl (currentJobLock);
+
+        if (auto* job = currentJob.load())
+            job->signalJobShouldExit();
+    }
+
+    WorkStealingThreadPool& pool;
+    JobDeque deque;
+    std::atomic<ThreadPoolJob*> currentJob { nullptr };
+    SpinLock currentJobLock;
+    std::atomic<bool> isSleeping { false };
+    Random random;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerThread)
+};
+
+//==============================================================================
+WorkStealingThreadPool::WorkStealingThreadPool (int numThreads, size_t threadStackSize)
+{
+    jassert (numThreads > 0); // not much point having a pool without any threads!
+
+    createThreads (numThreads, threadStackSize);
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool()
+{
+    createThreads (SystemStats::getNumCpus(), 0);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    removeAllJobs (true, 5000);
+
+    for (auto* t : threads)
+        t->signalThreadShouldExit();
+
+    for (auto* t : threads)
+    {
+        t->notify();
+        t->stopThread (500);
+    }
+
+    // anything left over was added while the pool was being shut down
+    for (auto* t : threads)
+        while (auto* job = t->deque.pop())
+            jobFinished (job);
+
+    for (auto* job : sharedQueue)
+        jobFinished (job);
+}
+
+void WorkStealingThreadPool::createThreads (int numThreads, size_t threadStackSize)
+{
+    for (int i = jmax (1, numThreads); --i >= 0;)
+        threads.add (new WorkerThread (*this, threadStackSize));
+
+    for (auto* t : threads)
+        t->startThread();
+}
+
+int WorkStealingThreadPool::getNumThreads() const noexcept
+{
+    return threads.size();
+}
+
+//==============================================================================
+void WorkStealingThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
+{
+    jassert (job != nullptr);
+    jassert (job->pool == nullptr && ! job->isActive); // this job is already in a pool!
+
+    job->shouldStop = false;
+    job->isActive = false;
+    job->shouldBeDeleted = deleteJobWhenFinished;
+
+    ++numUnfinishedJobs;
+    pushJob (job);
+}
+
+void WorkStealingThreadPool::addJob (std::function<ThreadPoolJob::JobStatus()> jobToRun)
+{
+    struct LambdaJobWrapper  : public ThreadPoolJob
+    {
+        LambdaJobWrapper (std::function<ThreadPoolJob::JobStatus()> j) : ThreadPoolJob ("lambda"), job (j) {}
+        JobStatus runJob() override      { return job(); }
+
+        std::function<ThreadPoolJob::JobStatus()> job;
+    };
+
+    addJob (new LambdaJobWrapper (jobToRun), true);
+}
+
+void WorkStealingThreadPool::addJob (std::function<void()> jobToRun)
+{
+    struct LambdaJobWrapper  : public ThreadPoolJob
+    {
+        LambdaJobWrapper (std::function<void()> j) : ThreadPoolJob ("lambda"), job (j) {}
+        JobStatus runJob() override      { job(); return ThreadPoolJob::jobHasFinished; }
+
+        std::function<void()> job;
+    };
+
+    addJob (new LambdaJobWrapper (jobToRun), true);
+}
+
+bool WorkStealingThreadPool::waitForAllJobs (int timeOutMs) const
+{
+    // a job can't wait for itself to finish!
+    jassert (getCurrentJobOnThisThread() == nullptr);
+
+    auto start = Time::getMillisecondCounter();
+
+    while (numUnfinishedJobs.load() > 0)
+    {
+        if (timeOutMs >= 0 && Time::getMillisecondCounter() >= start + (uint32) timeOutMs)
+            return false;
+
+        jobFinishedSignal.wait (20);
+    }
+
+    return true;
+}
+
+bool WorkStealingThreadPool::removeAllJobs (bool interruptRunningJobs, int timeOutMs)
+{
+    ++numRemovalRequests;
+
+    if (interruptRunningJobs)
+        for (auto* t : threads)
+            t->signalCurrentJobShouldExit();
+
+    // the waiting jobs are removed by the threads as they come across them
+    for (auto* t : threads)
+        t->notify();
+
+    auto result = waitForAllJobs (timeOutMs);
+    --numRemovalRequests;
+    return result;
+}
+
+//==============================================================================
+void WorkStealingThreadPool::pushJob (ThreadPoolJob* job)
+{
+    if (auto* worker = dynamic_cast<WorkerThread*> (Thread::getCurrentThread()))
+    {
+        if (&worker->pool == this && worker->deque.push (job))
+        {
+            wakeSleepingThread();
+            return;
+        }
+    }
+
+    pushSharedJob (job);
+}
+
+void WorkStealingThreadPool::pushSharedJob (ThreadPoolJob* job)
+{
+    {
+        const ScopedLock sl (sharedQueueLock);
+        sharedQueue.add (job);
+        ++numSharedJobs;
+    }
+
+    wakeSleepingThread();
+}
+
+void WorkStealingThreadPool::wakeSleepingThread()
+{
+    // this pairs with the fence in JobDeque::pop(), so that either a thread going to
+    // sleep finds the new job, or the job's owner sees that the thread is asleep
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    if (numSleepingThreads.load() > 0)
+    {
+        for (auto* t : threads)
+        {
+            if (t->isSleeping.exchange (false))
+            {
+                t->notify();
+                return;
+            }
+        }
+    }
+}
+
+ThreadPoolJob* WorkStealingThreadPool::findJobFor (WorkerThread& worker)
+{
+    if (auto* job = worker.deque.pop())
+        return job;
+
+    if (numSharedJobs.load() > 0)
+        if (auto* job = takeSharedJobs (worker))
+            return job;
+
+    auto numThreads = threads.size();
+
+    if (numThreads > 1)
+    {
+        auto start = worker.random.nextInt (numThreads);
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            auto* victim = threads.getUnchecked ((start + i) % numThreads);
+
+            if (victim != &worker)
+                if (auto* job = victim->deque.steal())
+                    return job;
+        }
+    }
+
+    return nullptr;
+}
+
+ThreadPoolJob* WorkStealingThreadPool::takeSharedJobs (WorkerThread& worker)
+{
+    const ScopedLock sl (sharedQueueLock);
+
+    auto numAvailable = sharedQueue.size();
+
+    if (numAvailable == 0)
+        return nullptr;
+
+    // Rather than coming back to the lock for every job, this thread takes its share
+    // of the queue into its own deque, where the other threads can steal them if needed
+    auto numToTake = jlimit (1, 32, numAvailable / threads.size());
+    int numTaken = 1;
+
+    while (numTaken < numToTake && worker.deque.push (sharedQueue.getUnchecked (numTaken)))
+        ++numTaken;
+
+    auto* job = sharedQueue.getUnchecked (0);
+    sharedQueue.removeRange (0, numTaken);
+    numSharedJobs -= numTaken;
+
+    if (numTaken > 1)
+        wakeSleepingThread();
+
+    return job;
+}
+
+void WorkStealingThreadPool::runJob (WorkerThread& worker, ThreadPoolJob* job)
+{
+    if (job->shouldStop || numRemovalRequests.load() > 0)
+    {
+        jobFinished (job);
+        return;
+    }
+
+    auto result = ThreadPoolJob::jobHasFinished;
+
+    {
+        const SpinLock::ScopedLockType sl (worker.currentJobLock);
+        job->isActive = true;
+        worker.currentJob = job;
+    }
+
+    try
+    {
+        result = job->runJob();
+    }
+    catch (...)
+    {
+        jassertfalse; // Your runJob() method mustn't throw any exceptions!
+    }
+
+    {
+        const SpinLock::ScopedLockType sl (worker.currentJobLock);
+        worker.currentJob = nullptr;
+        job->isActive = false;
+    }
+
+    // jobs that want another go are put at the back of the shared queue, so that they
+    // don't stop the jobs in this thread's deque from being run
+    if (result == ThreadPoolJob::jobNeedsRunningAgain && ! job->shouldStop && numRemovalRequests.load() == 0)
+        pushSharedJob (job);
+    else
+        jobFinished (job);
+}
+
+void WorkStealingThreadPool::jobFinished (ThreadPoolJob* job)
+{
+    job->shouldStop = true;
+
+    if (job->shouldBeDeleted)
+        delete job;
+
+    if (--numUnfinishedJobs == 0)
+        jobFinishedSignal.signal();
+}
+
+ThreadPoolJob* WorkStealingThreadPool::getCurrentJobOnThisThread()
+{
+    if (auto* t = dynamic_cast<WorkerThread*> (Thread::getCurrentThread()))
+        return t->currentJob.load();
+
+    return nullptr;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class WorkStealingThreadPoolTests  : public UnitTest
+{
+public:
+    WorkStealingThreadPoolTests() : UnitTest ("WorkStealingThreadPool", "Threads") {}
+
+    void runTest() override
+    {
+        beginTest ("Jobs added from outside the pool");
+        {
+            WorkStealingThreadPool pool (4);
+            std::atomic<int> count { 0 };
+
+            for (int i = 0; i < 10000; ++i)
+                pool.addJob ([&count] { ++count; });
+
+            expect (pool.waitForAllJobs (10000));
+            expectEquals (count.load(), 10000);
+            expectEquals (pool.getNumJobs(), 0);
+        }
+
+        beginTest ("Jobs added from inside the pool");
+        {
+            WorkStealingThreadPool pool (4);
+            std::atomic<int> count { 0 };
+
+            for (int i = 0; i < 100; ++i)
+            {
+                pool.addJob ([&pool, &count]
+                {
+                    // more than will fit in a thread's deque, so some have to overflow
+                    for (int j = 0; j < 1500; ++j)
+                        pool.addJob ([&count] { ++count; });
+                });
+            }
+
+            expect (pool.waitForAllJobs (10000));
+            expectEquals (count.load(), 150000);
+        }
+
+        beginTest ("Jobs that need running again");
+        {
+            WorkStealingThreadPool pool (2);
+            std::atomic<int> count { 0 };
+
+            std::function<ThreadPoolJob::JobStatus()> job = [&count]
+            {
+                return ++count < 10 ? ThreadPoolJob::jobNeedsRunningAgain
+                                    : ThreadPoolJob::jobHasFinished;
+            };
+
+            pool.addJob (job);
+
+            expect (pool.waitForAllJobs (10000));
+            expectEquals (count.load(), 10);
+        }
+
+        beginTest ("Current job");
+        {
+            WorkStealingThreadPool pool (2);
+            std::atomic<bool> isCorrect { false };
+
+            struct TestJob  : public ThreadPoolJob
+            {
+                TestJob (std::atomic<bool>& r) : ThreadPoolJob ("test"), result (r) {}
+                JobStatus runJob() override    { result = getCurrentThreadPoolJob() == this && isRunning(); return jobHasFinished; }
+                std::atomic<bool>& result;
+            };
+
+            pool.addJob (new TestJob (isCorrect), true);
+            expect (pool.waitForAllJobs (10000));
+            expect (isCorrect.load());
+            expect (ThreadPoolJob::getCurrentThreadPoolJob() == nullptr);
+        }
+
+        beginTest ("Removing jobs");
+        {
+            WorkStealingThreadPool pool (2);
+            std::atomic<int> numRun { 0 };
+            WaitableEvent started;
+
+            for (int i = 0; i < 2; ++i)
+            {
+                pool.addJob ([&]
+                {
+                    ++numRun;
+                    started.signal();
+
+                    while (! ThreadPoolJob::getCurrentThreadPoolJob()->shouldExit())
+                        Thread::sleep (1);
+                });
+            }
+
+            for (int i = 0; i < 1000; ++i)
+                pool.addJob ([&numRun] { ++numRun; });
+
+            started.wait (5000);
+
+            expect (pool.removeAllJobs (true, 10000));
+            expectEquals (pool.getNumJobs(), 0);
+            expect (numRun.load() < 1002);
+
+            numRun = 0;
+            pool.addJob ([&numRun] { ++numRun; });
+            expect (pool.waitForAllJobs (10000));
+            expectEquals (numRun.load(), 1);
+        }
+    }
+};
+
+static WorkStealingThreadPoolTests workStealingThreadPoolTests;
+
+#endif
+
+} // namespace juce
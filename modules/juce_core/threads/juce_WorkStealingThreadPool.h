@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pool of threads that runs ThreadPoolJobs using work-stealing.
+
+    Unlike ThreadPool, which keeps all of its jobs in one list guarded by a single lock,
+    each thread here has its own queue of jobs. A job that's added from inside a running
+    job goes onto that thread's queue without taking any locks, and the thread runs its
+    own newest jobs first, which tends to keep their data in its cache. A thread that runs
+    out of work steals the oldest job from a randomly chosen other thread. Jobs added from
+    threads outside the pool go into a shared queue, which the threads take from in batches.
+
+    This makes it much better suited than ThreadPool to large numbers of small jobs, but
+    because there is no central list, it can't look up, reorder or remove individual jobs
+    once they've been added. All of the jobs can still be removed with removeAllJobs(),
+    and jobs that return jobNeedsRunningAgain are put back into the shared queue.
+
+    @see ThreadPool, ThreadPoolJob
+
+    @tags{Core}
+*/
+class JUCE_API  WorkStealingThreadPool
+{
+public:
+    //==============================================================================
+    /** Creates a pool with the given number of threads.
+        The threads are started immediately.
+    */
+    WorkStealingThreadPool (int numberOfThreads, size_t threadStackSize = 0);
+
+    /** Creates a pool with one thread per CPU core. */
+    WorkStealingThreadPool();
+
+    /** Destructor.
+
+        Any jobs that are still waiting are deleted (if the pool was told to delete them),
+        and any that are running are interrupted.
+    */
+    ~WorkStealingThreadPool();
+
+    //==============================================================================
+    /** Adds a job to the pool.
+
+        Once a job has been added, it will be run by the next thread that becomes free.
+        If deleteJobWhenFinished is true, the pool deletes the job when its runJob() method
+        has returned jobHasFinished, or if it's never run because the pool is being deleted.
+    */
+    void addJob (ThreadPoolJob* job, bool deleteJobWhenFinished);
+
+    /** Adds a lambda function to be called as a job.
+        This will create an internal ThreadPoolJob object to encapsulate and call the lambda.
+    */
+    void addJob (std::function<ThreadPoolJob::JobStatus()> job);
+
+    /** Adds a lambda function to be called as a job.
+        This will create an internal ThreadPoolJob object to encapsulate and call the lambda.
+    */
+    void addJob (std::function<void()> job);
+
+    //==============================================================================
+    /** Returns the number of jobs that have been added but haven't finished yet. */
+    int getNumJobs() const noexcept                 { return numUnfinishedJobs.load(); }
+
+    /** Returns the number of threads in the pool. */
+    int getNumThreads() const noexcept;
+
+    /** Blocks until all the jobs that have been added have finished.
+        @returns false if the timeout expired before this happened
+    */
+    bool waitForAllJobs (int timeOutMilliseconds) const;
+
+    /** Removes all the jobs from the pool.
+
+        Jobs that are waiting are removed without being run, and jobs that are running can
+        optionally be interrupted with ThreadPoolJob::signalJobShouldExit(). This then waits
+        for the running jobs to finish. Any jobs that are added while this is happening will
+        be removed too.
+
+        @returns false if the timeout expired before all of the jobs had finished
+    */
+    bool removeAllJobs (bool interruptRunningJobs, int timeOutMilliseconds);
+
+private:
+    //==============================================================================
+    struct WorkerThread;
+    class JobDeque;
+    friend class ThreadPoolJob;
+
+    OwnedArray<WorkerThread> threads;
+    Array<ThreadPoolJob*> sharedQueue;
+    CriticalSection sharedQueueLock;
+    std::atomic<int> numUnfinishedJobs { 0 }, numSharedJobs { 0 }, numSleepingThreads { 0 }, numRemovalRequests { 0 };
+    WaitableEvent jobFinishedSignal;
+
+    void createThreads (int numThreads, size_t threadStackSize);
+    void pushJob (ThreadPoolJob*);
+    void pushSharedJob (ThreadPoolJob*);
+    ThreadPoolJob* findJobFor (WorkerThread&);
+    ThreadPoolJob* takeSharedJobs (WorkerThread&);
+    void runJob (WorkerThread&, ThreadPoolJob*);
+    void jobFinished (ThreadPoolJob*);
+    void wakeSleepingThread();
+
+    static ThreadPoolJob* getCurrentJobOnThisThread();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkStealingThreadPool)
+};
+
+} // namespace juce
@@ -0,0 +1,306 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+std::atomic<bool> TraceRecorder::recording { false };
+
+namespace TraceRecorderHelpers
+{
+    struct Event
+    {
+        const char* name; // (nullptr for the end of an event)
+        int64 ticks;
+    };
+
+    struct ThreadBuffer
+    {
+        ThreadBuffer (int index, const String& threadName)  : threadIndex (index), name (threadName) {}
+
+        LockFreeSPSCQueue<Event> events { 16384 };
+        const int threadIndex;
+        const String name;
+    };
+
+    struct Recorder  : private Thread
+    {
+        Recorder()  : Thread ("JUCE trace recorder") {}
+        ~Recorder() override     { stop(); }
+
+        bool start (const File& file)
+        {
+            stop();
+
+            const ScopedLock sl (lock);
+
+            file.deleteFile();
+            stream.reset (new FileOutputStream (file, 65536));
+
+            if (! stream->openedOk())
+            {
+                stream.reset();
+                return false;
+            }
+
+            // anything left over from an earlier recording would have the wrong timestamps
+            Event e;
+
+            for (auto* b : buffers)
+                while (b->events.pop (e)) {}
+
+            *stream << "{\"traceEvents\":[" << newLine;
+            numBuffersDescribed = 0;
+            isFirstEvent = true;
+            numDropped = 0;
+            startTicks = Time::getHighResolutionTicks();
+            TraceRecorder::recording = true;
+
+            startThread();
+            return true;
+        }
+
+        void stop()
+        {
+            if (! TraceRecorder::recording.exchange (false))
+                return;
+
+            stopThread (-1);
+
+            const ScopedLock sl (lock);
+            writePendingEvents();
+            *stream << newLine << "]}" << newLine;
+            stream.reset();
+        }
+
+        void push (const char* name) noexcept
+        {
+            auto*& buffer = currentBuffer.get();
+
+            if (buffer == nullptr)
+                buffer = createBufferForCurrentThread();
+
+            if (! buffer->events.push ({ name, Time::getHighResolutionTicks() }))
+                ++numDropped;
+        }
+
+        ThreadBuffer* createBufferForCurrentThread()
+        {
+            String currentThreadName;
+
+            if (auto* t = Thread::getCurrentThread())
+                currentThreadName = t->getThreadName();
+
+            const ScopedLock sl (lock);
+            auto index = buffers.size();
+            return buffers.add (new ThreadBuffer (index + 1, currentThreadName.isNotEmpty() ? currentThreadName
+                                                                                            : "Thread " + String (index + 1)));
+        }
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                wait (50);
+
+                const ScopedLock sl (lock);
+                writePendingEvents();
+            }
+        }
+
+        void writePendingEvents()
+        {
+            for (; numBuffersDescribed < buffers.size(); ++numBuffersDescribed)
+            {
+                auto* b = buffers.getUnchecked (numBuffersDescribed);
+                startEvent();
+                *stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->threadIndex
+                        << ",\"args\":{\"name\":\"" << JSON::escapeString (b->name) << "\"}}";
+            }
+
+            auto microsecondsPerTick = 1.0e6 / (double) Time::getHighResolutionTicksPerSecond();
+            Event e;
+
+            for (auto* b : buffers)
+            {
+                while (b->events.pop (e))
+                {
+                    startEvent();
+                    *stream << "{\"ph\":\"" << (e.name != nullptr ? "B" : "E") << "\",\"pid\":1,\"tid\":" << b->threadIndex
+                            << ",\"ts\":" << String ((double) (e.ticks - startTicks) * microsecondsPerTick, 3);
+
+                    if (e.name != nullptr)
+                        *stream << ",\"name\":\"" << getEscapedName (e.name) << "\"";
+
+                    *stream << "}";
+                }
+            }
+
+            stream->flush();
+        }
+
+        void startEvent()
+        {
+            if (! isFirstEvent)
+                *stream << "," << newLine;
+
+            isFirstEvent = false;
+        }
+
+        const String& getEscapedName (const char* name)
+        {
+            auto& escaped = escapedNames[name];
+
+            if (escaped.isEmpty())
+                escaped = JSON::escapeString (CharPointer_UTF8 (name));
+
+            return escaped;
+        }
+
+        CriticalSection lock;
+        OwnedArray<ThreadBuffer> buffers;
+        ThreadLocalValue<ThreadBuffer*> currentBuffer;
+        std::map<const char*, String> escapedNames;
+        std::unique_ptr<FileOutputStream> stream;
+        std::atomic<int64> numDropped { 0 };
+        int64 startTicks = 0;
+        int numBuffersDescribed = 0;
+        bool isFirstEvent = true;
+    };
+
+    static Recorder& getRecorder()
+    {
+        static Recorder recorder;
+        return recorder;
+    }
+}
+
+//==============================================================================
+bool TraceRecorder::startRecording (const File& outputFile)
+{
+    return TraceRecorderHelpers::getRecorder().start (outputFile);
+}
+
+void TraceRecorder::stopRecording()
+{
+    TraceRecorderHelpers::getRecorder().stop();
+}
+
+int64 TraceRecorder::getNumEventsDropped() noexcept
+{
+    return TraceRecorderHelpers::getRecorder().numDropped.load();
+}
+
+void TraceRecorder::beginEvent (const char* name) noexcept
+{
+    jassert (name != nullptr);
+
+    if (isRecording())
+        TraceRecorderHelpers::getRecorder().push (name);
+}
+
+void TraceRecorder::endEvent() noexcept
+{
+    if (isRecording())
+        TraceRecorderHelpers::getRecorder().push (nullptr);
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct TraceRecorderTests  : public UnitTest
+{
+    TraceRecorderTests()  : UnitTest ("TraceRecorder", "Time") {}
+
+    void runTest() override
+    {
+        beginTest ("Recording events");
+
+        auto file = File::createTempFile (".json");
+        expect (TraceRecorder::startRecording (file));
+        expect (TraceRecorder::isRecording());
+
+        {
+            const TraceRecorder::ScopedEvent outer ("outer");
+            const TraceRecorder::ScopedEvent inner ("inner \"quoted\"");
+        }
+
+        struct TracingThread  : public Thread
+        {
+            TracingThread()  : Thread ("tracing thread") {}
+
+            void run() override
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    const TraceRecorder::ScopedEvent e ("worker");
+                }
+            }
+        };
+
+        TracingThread thread;
+        thread.startThread();
+        thread.waitForThreadToExit (-1);
+
+        TraceRecorder::stopRecording();
+        expect (! TraceRecorder::isRecording());
+
+        // events outside a recording are ignored
+        TraceRecorder::beginEvent ("ignored");
+        TraceRecorder::endEvent();
+
+        auto parsed = JSON::parse (file);
+        auto* events = parsed["traceEvents"].getArray();
+        expect (events != nullptr);
+
+        if (events != nullptr)
+        {
+            int numBegins = 0, numEnds = 0, numWorkerEvents = 0;
+            bool foundThreadName = false, foundQuotedName = false, foundIgnored = false;
+
+            for (auto& e : *events)
+            {
+                auto phase = e["ph"].toString();
+                numBegins += phase == "B" ? 1 : 0;
+                numEnds   += phase == "E" ? 1 : 0;
+                numWorkerEvents += e["name"].toString() == "worker" ? 1 : 0;
+                foundQuotedName = foundQuotedName || e["name"].toString() == "inner \"quoted\"";
+                foundIgnored    = foundIgnored    || e["name"].toString() == "ignored";
+                foundThreadName = foundThreadName || (phase == "M" && e["args"]["name"].toString() == "tracing thread");
+            }
+
+            expectEquals (numBegins, 102);
+            expectEquals (numEnds, 102);
+            expectEquals (numWorkerEvents, 100);
+            expect (foundQuotedName && foundThreadName && ! foundIgnored);
+        }
+
+        expectEquals (TraceRecorder::getNumEventsDropped(), (int64) 0);
+        file.deleteFile();
+    }
+};
+
+static TraceRecorderTests traceRecorderTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#ifndef DOXYGEN
+ namespace TraceRecorderHelpers { struct Recorder; }
+#endif
+
+//==============================================================================
+/**
+    Records begin/end events from any number of threads, and writes them to a file in
+    the Chrome trace event format, which can be loaded into chrome://tracing or the
+    Perfetto UI (https://ui.perfetto.dev) to see a timeline of what every thread was doing.
+
+    You'll normally add events with the JUCE_TRACE_SCOPE macro, e.g.
+    @code
+    void MyProcessor::processBlock (AudioBuffer<float>& buffer, MidiBuffer&)
+    {
+        JUCE_TRACE_SCOPE ("MyProcessor::processBlock");
+        ...
+    }
+    @endcode
+
+    The macro compiles to nothing unless JUCE_ENABLE_TRACING is set, and when it is
+    enabled but nothing is being recorded, each event just checks a flag. While a
+    recording is running, each event is pushed into a lock-free queue belonging to the
+    calling thread, without locking or allocating, so it's safe to use on the audio thread.
+    The only exception is the very first event on each thread, which has to create that
+    thread's queue. A background thread collects the events from all the queues and
+    writes them to the file.
+
+    If a thread produces events faster than they can be collected, the excess ones are
+    dropped - see getNumEventsDropped().
+
+    @see PerformanceCounter
+
+    @tags{Core}
+*/
+class JUCE_API  TraceRecorder
+{
+public:
+    //==============================================================================
+    /** Starts recording events into the given file, replacing anything already in it.
+        If a recording is already running, it's stopped first.
+        @returns false if the file couldn't be opened
+    */
+    static bool startRecording (const File& outputFile);
+
+    /** Stops recording, writes any remaining events and closes the file. */
+    static void stopRecording();
+
+    /** Returns true if a recording is running. */
+    static bool isRecording() noexcept          { return recording.load (std::memory_order_relaxed); }
+
+    /** Returns the number of events that have been dropped since the recording started. */
+    static int64 getNumEventsDropped() noexcept;
+
+    //==============================================================================
+    /** Records the start of an event on the calling thread.
+
+        The name isn't copied, so it must be a string that will stay valid until the
+        recording is stopped - normally a string literal. Each call must be matched by
+        a call to endEvent() on the same thread.
+    */
+    static void beginEvent (const char* name) noexcept;
+
+    /** Records the end of the most recent event started on the calling thread. */
+    static void endEvent() noexcept;
+
+    //==============================================================================
+    /** Records an event lasting for the lifetime of this object.
+        @see JUCE_TRACE_SCOPE
+    */
+    struct ScopedEvent
+    {
+        explicit ScopedEvent (const char* name) noexcept   : active (isRecording())  { if (active) beginEvent (name); }
+        ~ScopedEvent() noexcept                                                       { if (active) endEvent(); }
+
+    private:
+        const bool active;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedEvent)
+    };
+
+private:
+    static std::atomic<bool> recording;
+    friend struct TraceRecorderHelpers::Recorder;
+
+    TraceRecorder() = delete;
+};
+
+//==============================================================================
+#if JUCE_ENABLE_TRACING || DOXYGEN
+ /** Records a trace event which lasts until the end of the enclosing scope.
+     The name must be a string literal. This compiles to nothing unless JUCE_ENABLE_TRACING
+     is enabled.
+     @see TraceRecorder
+ */
+ #define JUCE_TRACE_SCOPE(name)    const juce::TraceRecorder::ScopedEvent JUCE_JOIN_MACRO (juceTraceScope_, __LINE__) (name)
+#else
+ #define JUCE_TRACE_SCOPE(name)
+#endif
+
+} // namespace juce
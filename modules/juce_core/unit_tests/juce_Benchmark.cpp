@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+Benchmark::Benchmark (const String& nm, const String& ctg)
+   : name (nm), category (ctg)
+{
+    getAllBenchmarks().add (this);
+}
+
+Benchmark::~Benchmark()
+{
+    getAllBenchmarks().removeFirstMatchingValue (this);
+}
+
+Array<Benchmark*>& Benchmark::getAllBenchmarks()
+{
+    static Array<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+Array<Benchmark*> Benchmark::getBenchmarksInCategory (const String& category)
+{
+    if (category.isEmpty())
+        return getAllBenchmarks();
+
+    Array<Benchmark*> benchmarks;
+
+    for (auto* b : getAllBenchmarks())
+        if (b->getCategory() == category)
+            benchmarks.add (b);
+
+    return benchmarks;
+}
+
+StringArray Benchmark::getAllCategories()
+{
+    StringArray categories;
+
+    for (auto* b : getAllBenchmarks())
+        if (b->getCategory().isNotEmpty())
+            categories.addIfNotAlreadyThere (b->getCategory());
+
+    return categories;
+}
+
+void Benchmark::initialise()  {}
+void Benchmark::shutdown()    {}
+
+void Benchmark::performBenchmark (BenchmarkRunner* const newRunner)
+{
+    jassert (newRunner != nullptr);
+    runner = newRunner;
+
+    initialise();
+    runBenchmark();
+    shutdown();
+
+    runner = nullptr;
+}
+
+void Benchmark::logMessage (const String& message)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    runner->logMessage (message);
+}
+
+void Benchmark::measureBatches (const String& caseName, const std::function<void (int64)>& runBatch)
+{
+    // This method's only valid while the benchmark is being run!
+    jassert (runner != nullptr);
+
+    if (! runner->shouldAbortBenchmarks())
+        runner->measure (caseName, runBatch);
+}
+
+const volatile void*& Benchmark::getOptimisationSink() noexcept
+{
+    static const volatile void* sink = nullptr;
+    return sink;
+}
+
+//==============================================================================
+BenchmarkRunner::BenchmarkRunner() {}
+BenchmarkRunner::~BenchmarkRunner() {}
+
+void BenchmarkRunner::setWarmUpTime (int milliseconds) noexcept
+{
+    warmUpMilliseconds = jmax (0, milliseconds);
+}
+
+void BenchmarkRunner::setSampling (int numSamples, int minimumMillisecondsPerSample) noexcept
+{
+    numSamplesPerCase = jmax (1, numSamples);
+    minimumSampleMilliseconds = jmax (1, minimumMillisecondsPerSample);
+}
+
+int BenchmarkRunner::getNumResults() const noexcept
+{
+    return results.size();
+}
+
+const BenchmarkRunner::Result* BenchmarkRunner::getResult (int index) const noexcept
+{
+    return results[index];
+}
+
+void BenchmarkRunner::runBenchmarks (const Array<Benchmark*>& benchmarks)
+{
+    results.clear();
+
+    for (auto* b : benchmarks)
+    {
+        if (shouldAbortBenchmarks())
+            break;
+
+        logMessage ("-----------------------------------------------------------------");
+        logMessage ("Benchmark: " + b->getName());
+
+        currentBenchmark = b;
+        b->performBenchmark (this);
+        currentBenchmark = nullptr;
+    }
+
+    logMessage ("-----------------------------------------------------------------");
+    logMessage ("Benchmarks completed");
+}
+
+void BenchmarkRunner::runAllBenchmarks()
+{
+    runBenchmarks (Benchmark::getAllBenchmarks());
+}
+
+void BenchmarkRunner::runBenchmarksInCategory (const String& category)
+{
+    runBenchmarks (Benchmark::getBenchmarksInCategory (category));
+}
+
+void BenchmarkRunner::logMessage (const String& message)
+{
+    Logger::writeToLog (message);
+}
+
+bool BenchmarkRunner::shouldAbortBenchmarks()
+{
+    return false;
+}
+
+//==============================================================================
+void BenchmarkRunner::measure (const String& caseName, const std::function<void (int64)>& runBatch)
+{
+    auto timeBatch = [&runBatch] (int64 numIterations)
+    {
+        auto start = Time::getHighResolutionTicks();
+        runBatch (numIterations);
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+    };
+
+    // Keep doubling the batch size until a batch is long enough to time accurately,
+    // carrying on with that size until the warm-up time's been used up
+    auto minimumSampleSeconds = minimumSampleMilliseconds / 1000.0;
+    auto warmUpSeconds = warmUpMilliseconds / 1000.0;
+    int64 iterationsPerSample = 1;
+    double totalWarmUpTime = 0;
+
+    for (;;)
+    {
+        auto elapsed = timeBatch (iterationsPerSample);
+        totalWarmUpTime += elapsed;
+
+        if (elapsed < minimumSampleSeconds)
+            iterationsPerSample *= 2;
+        else if (totalWarmUpTime >= warmUpSeconds)
+            break;
+    }
+
+    Array<double> samples;
+
+    for (int i = 0; i < numSamplesPerCase; ++i)
+        samples.add (timeBatch (iterationsPerSample) / (double) iterationsPerSample);
+
+    samples.sort();
+
+    std::unique_ptr<Result> r (new Result());
+    r->benchmarkName = currentBenchmark != nullptr ? currentBenchmark->getName() : String();
+    r->category = currentBenchmark != nullptr ? currentBenchmark->getCategory() : String();
+    r->caseName = caseName;
+    r->numSamples = samples.size();
+    r->iterationsPerSample = iterationsPerSample;
+    r->minimumSeconds = samples.getFirst();
+    r->maximumSeconds = samples.getLast();
+
+    auto mid = samples.size() / 2;
+    r->medianSeconds = (samples.size() & 1) != 0 ? samples[mid] : (samples[mid - 1] + samples[mid]) * 0.5;
+
+    double total = 0;
+
+    for (auto s : samples)
+        total += s;
+
+    r->meanSeconds = total / samples.size();
+
+    double totalSquaredDifference = 0;
+
+    for (auto s : samples)
+        totalSquaredDifference += (s - r->meanSeconds) * (s - r->meanSeconds);
+
+    r->standardDeviationSeconds = samples.size() > 1 ? std::sqrt (totalSquaredDifference / (samples.size() - 1)) : 0.0;
+
+    logMessage ("  " + caseName + ": " + r->toString());
+    results.add (r.release());
+}
+
+//==============================================================================
+String BenchmarkRunner::formatDuration (double seconds)
+{
+    if (seconds < 1.0e-6)  return String (seconds * 1.0e9, 2) + " ns";
+    if (seconds < 1.0e-3)  return String (seconds * 1.0e6, 2) + " us";
+    if (seconds < 1.0)     return String (seconds * 1.0e3, 2) + " ms";
+
+    return String (seconds, 3) + " s";
+}
+
+String BenchmarkRunner::Result::toString() const
+{
+    return "median " + formatDuration (medianSeconds)
+             + ", mean " + formatDuration (meanSeconds) + " +/- " + formatDuration (standardDeviationSeconds)
+             + ", range " + formatDuration (minimumSeconds) + " - " + formatDuration (maximumSeconds)
+             + " (" + String (numSamples) + " x " + String (iterationsPerSample) + " calls)";
+}
+
+String BenchmarkRunner::toJSON() const
+{
+    Array<var> list;
+
+    for (auto* r : results)
+    {
+        DynamicObject::Ptr o (new DynamicObject());
+        o->setProperty ("benchmark",            r->benchmarkName);
+        o->setProperty ("category",             r->category);
+        o->setProperty ("case",                 r->caseName);
+        o->setProperty ("numSamples",           r->numSamples);
+        o->setProperty ("iterationsPerSample",  r->iterationsPerSample);
+        o->setProperty ("meanSeconds",          r->meanSeconds);
+        o->setProperty ("medianSeconds",        r->medianSeconds);
+        o->setProperty ("minimumSeconds",       r->minimumSeconds);
+        o->setProperty ("maximumSeconds",       r->maximumSeconds);
+        o->setProperty ("standardDeviationSeconds", r->standardDeviationSeconds);
+        list.add (var (o.get()));
+    }
+
+    return JSON::toString (list);
+}
+
+} // namespace juce
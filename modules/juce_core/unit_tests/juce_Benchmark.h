@@ -0,0 +1,272 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class BenchmarkRunner;
+
+//==============================================================================
+/**
+    This is a base class for classes that measure how long some code takes to run.
+
+    A benchmark looks much like a UnitTest: each call to measure() times a piece
+    of code, and is reported as a separate case.
+
+    @code
+    class StringBenchmarks  : public Benchmark
+    {
+    public:
+        StringBenchmarks()  : Benchmark ("String", "Text") {}
+
+        void runBenchmark() override
+        {
+            String s ("a long string to search through");
+
+            measure ("indexOf", [&] { doNotOptimiseAway (s.indexOf ("search")); });
+            measure ("toUpperCase", [&] { doNotOptimiseAway (s.toUpperCase()); });
+        }
+    };
+
+    // Creating a static instance will automatically add the instance to the array
+    // returned by Benchmark::getAllBenchmarks()
+    static StringBenchmarks stringBenchmarks;
+    @endcode
+
+    The function passed to measure() is first run repeatedly to warm up caches and
+    branch predictors, and to work out how many calls make up a sample that's long
+    enough to time accurately. A number of samples are then timed, and the
+    BenchmarkRunner records their statistics.
+
+    To run the benchmarks, use the BenchmarkRunner class.
+
+    @see BenchmarkRunner, UnitTest
+
+    @tags{Core}
+*/
+class JUCE_API  Benchmark
+{
+public:
+    //==============================================================================
+    /** Creates a benchmark with the given name and optionally places it in a category. */
+    explicit Benchmark (const String& name, const String& category = String());
+
+    /** Destructor. */
+    virtual ~Benchmark();
+
+    /** Returns the name of the benchmark. */
+    const String& getName() const noexcept       { return name; }
+
+    /** Returns the category of the benchmark. */
+    const String& getCategory() const noexcept   { return category; }
+
+    /** Runs the benchmark, using the specified BenchmarkRunner.
+        You shouldn't need to call this method directly - use
+        BenchmarkRunner::runBenchmarks() instead.
+    */
+    void performBenchmark (BenchmarkRunner* runner);
+
+    /** Returns the set of all Benchmark objects that currently exist. */
+    static Array<Benchmark*>& getAllBenchmarks();
+
+    /** Returns the set of Benchmarks in a specified category. */
+    static Array<Benchmark*> getBenchmarksInCategory (const String& category);
+
+    /** Returns a StringArray containing all of the categories of Benchmarks that have been registered. */
+    static StringArray getAllCategories();
+
+    //==============================================================================
+    /** You can optionally implement this method to set up any data that the benchmark needs.
+        This method will be called before runBenchmark(), and isn't included in the timings.
+    */
+    virtual void initialise();
+
+    /** You can optionally implement this method to clear up after the benchmark has been run.
+        This method will be called after runBenchmark() has returned.
+    */
+    virtual void shutdown();
+
+    /** Implement this method in your subclass, and call measure() for each of the cases
+        that you want to time.
+    */
+    virtual void runBenchmark() = 0;
+
+    //==============================================================================
+    /** Times a function, reporting the results under the given case name.
+        Only the function calls are timed, so anything done before calling this isn't
+        included in the result.
+    */
+    template <typename FunctionType>
+    void measure (const String& caseName, FunctionType&& functionToTime)
+    {
+        measureBatches (caseName, [&functionToTime] (int64 numIterations)
+        {
+            for (int64 i = 0; i < numIterations; ++i)
+                functionToTime();
+        });
+    }
+
+    /** Stops the compiler from optimising away the calculation of a value whose result
+        isn't otherwise used.
+    */
+    template <typename Type>
+    static void doNotOptimiseAway (const Type& value) noexcept
+    {
+       #if JUCE_GCC || JUCE_CLANG
+        asm volatile ("" : : "m" (value) : "memory");
+       #else
+        getOptimisationSink() = &value;
+       #endif
+    }
+
+    //==============================================================================
+    /** Writes a message to the benchmark log.
+        This can only be called from within your runBenchmark() method.
+    */
+    void logMessage (const String& message);
+
+private:
+    //==============================================================================
+    const String name, category;
+    BenchmarkRunner* runner = nullptr;
+
+    void measureBatches (const String& caseName, const std::function<void (int64)>& runBatch);
+    static const volatile void*& getOptimisationSink() noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE (Benchmark)
+};
+
+
+//==============================================================================
+/**
+    Runs a set of benchmarks, and collects the results.
+
+    As with UnitTestRunner, you can use a subclass to intercept the log messages.
+    The results can be written out as JSON using toJSON(), which makes it easy to keep
+    a record of them and compare them between versions.
+
+    @see Benchmark
+
+    @tags{Core}
+*/
+class JUCE_API  BenchmarkRunner
+{
+public:
+    //==============================================================================
+    /** */
+    BenchmarkRunner();
+
+    /** Destructor. */
+    virtual ~BenchmarkRunner();
+
+    /** Runs a set of benchmarks, in order. */
+    void runBenchmarks (const Array<Benchmark*>& benchmarks);
+
+    /** Runs all the Benchmark objects that currently exist. */
+    void runAllBenchmarks();
+
+    /** Runs all the Benchmark objects within a specified category. */
+    void runBenchmarksInCategory (const String& category);
+
+    //==============================================================================
+    /** Sets how long each case is run for before its timings start being recorded.
+        The default is 100 milliseconds.
+    */
+    void setWarmUpTime (int milliseconds) noexcept;
+
+    /** Sets the number of timed samples taken for each case, and the minimum length of each.
+        The function being measured is called as many times as needed to fill each sample,
+        so that very quick functions can still be timed accurately. The defaults are 20
+        samples of at least 10 milliseconds.
+    */
+    void setSampling (int numSamples, int minimumMillisecondsPerSample) noexcept;
+
+    //==============================================================================
+    /** Contains the results of one case in a benchmark.
+
+        One of these objects is created each time Benchmark::measure() is called. The
+        times are all for a single call of the function that was measured.
+    */
+    struct Result
+    {
+        /** The main name of this benchmark (i.e. the name of the Benchmark object being run). */
+        String benchmarkName;
+        /** The category of the benchmark. */
+        String category;
+        /** The name that was passed to Benchmark::measure(). */
+        String caseName;
+
+        /** The number of samples that were timed. */
+        int numSamples;
+        /** The number of calls that were made in each sample. */
+        int64 iterationsPerSample;
+
+        /** The statistics across the samples, in seconds per call. */
+        double meanSeconds, medianSeconds, minimumSeconds, maximumSeconds, standardDeviationSeconds;
+
+        /** Returns a description of the results, e.g. "median 12.3 ns, mean 12.5 ns +/- 0.2 ns, ...". */
+        String toString() const;
+    };
+
+    /** Returns the number of Result objects that are available.
+        @see getResult
+    */
+    int getNumResults() const noexcept;
+
+    /** Returns one of the Result objects that describes a case that has been run.
+        @see getNumResults
+    */
+    const Result* getResult (int index) const noexcept;
+
+    /** Returns all the results as a JSON string, containing an array of objects with
+        the same fields as the Result structure.
+    */
+    String toJSON() const;
+
+    /** Formats a time in seconds using the most readable unit, e.g. "12.3 ns" or "4.56 ms". */
+    static String formatDuration (double seconds);
+
+protected:
+    /** Logs a message about the benchmarks' progress.
+        By default this just writes the message to the Logger class, but you could override
+        this to do something else with the data.
+    */
+    virtual void logMessage (const String& message);
+
+    /** This can be overridden to let the runner know that it should abort the benchmarks
+        as soon as possible, e.g. because the thread needs to stop.
+    */
+    virtual bool shouldAbortBenchmarks();
+
+private:
+    //==============================================================================
+    friend class Benchmark;
+    OwnedArray<Result> results;
+    Benchmark* currentBenchmark = nullptr;
+    int warmUpMilliseconds = 100, numSamplesPerCase = 20, minimumSampleMilliseconds = 10;
+
+    void measure (const String& caseName, const std::function<void (int64)>& runBatch);
+
+    JUCE_DECLARE_NON_COPYABLE (BenchmarkRunner)
+};
+
+} // namespace juce
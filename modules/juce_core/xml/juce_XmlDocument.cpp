@@ -471,6 +471,19 @@ XmlElement* XmlDocument::readNextElement (const bool alsoParseSubElements)
     return node;
 }
 
+// Copies a run of plain text in one go when the string data is already UTF-8
+static void appendTextRun (MemoryOutputStream& out, CharPointer_UTF8 start, CharPointer_UTF8 end)
+{
+    out.write (start.getAddress(), (size_t) (end.getAddress() - start.getAddress()));
+}
+
+template <typename CharPointerType>
+static void appendTextRun (MemoryOutputStream& out, CharPointerType start, CharPointerType end)
+{
+    while (start != end)
+        out.appendUTF8Char (start.getAndAdvance());
+}
+
 void XmlDocument::readChildElements (XmlElement& parent)
 {
     LinkedListPointer<XmlElement>::Appender childAppender (parent.firstChildElement);
@@ -601,16 +614,21 @@ void XmlDocument::readChildElements (XmlElement& parent)
                 }
                 else
                 {
+                    auto runStart = input;
+
                     for (;; ++input)
                     {
                         auto nextChar = *input;
 
                         if (nextChar == '\r')
                         {
-                            nextChar = '\n';
+                            appendTextRun (textElementContent, runStart, input);
+                            runStart = input + 1;
+
+                            if (input[1] != '\n')
+                                textElementContent.writeByte ('\n');
 
-                            if (input[1] == '\n')
-                                continue;
+                            continue;
                         }
 
                         if (nextChar == '<' || nextChar == '&')
@@ -623,9 +641,10 @@ void XmlDocument::readChildElements (XmlElement& parent)
                             return;
                         }
 
-                        textElementContent.appendUTF8Char (nextChar);
                         contentShouldBeUsed = contentShouldBeUsed || ! CharacterFunctions::isWhitespace (nextChar);
                     }
+
+                    appendTextRun (textElementContent, runStart, input);
                 }
             }
 
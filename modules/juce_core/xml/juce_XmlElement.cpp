@@ -580,8 +580,7 @@ void XmlElement::setAttribute (const Identifier& attributeName, const int number
 
 void XmlElement::setAttribute (const Identifier& attributeName, const double number)
 {
-    String doubleString (number, 15, true);
-    setAttribute (attributeName, minimiseLengthOfFloatString (doubleString));
+    setAttribute (attributeName, serialiseDouble (number, 16));
 }
 
 void XmlElement::removeAttribute (const Identifier& attributeName) noexcept
@@ -0,0 +1,891 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace XmlPullParserHelpers
+{
+    enum { bufferSize = 32768, maxEntityLength = 16 };
+
+    static bool isWhitespace (char c) noexcept      { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+    static bool isNameChar (char c) noexcept        { return (uint8) c >= 0x80 || XmlIdentifierChars::isIdentifierChar ((juce_wchar) (uint8) c); }
+
+    static bool equalsIgnoreCase (const char* s, int length, const char* name) noexcept
+    {
+        for (int i = 0; i < length; ++i)
+            if (name[i] == 0 || CharacterFunctions::toLowerCase ((juce_wchar) s[i]) != (juce_wchar) name[i])
+                return false;
+
+        return name[length] == 0;
+    }
+}
+
+//==============================================================================
+XmlPullParser::XmlPullParser (InputStream& source)
+    : input (&source), buffer ((size_t) XmlPullParserHelpers::bufferSize)
+{
+}
+
+XmlPullParser::~XmlPullParser() {}
+
+//==============================================================================
+XmlPullParser::EventType XmlPullParser::next()
+{
+    if (! hasStarted)
+    {
+        hasStarted = true;
+        prepareInput();
+    }
+    else if (currentEvent == error || currentEvent == endOfDocument)
+    {
+        return currentEvent;
+    }
+
+    itemData.reset();
+    attributeOffsets.clearQuick();
+    depth = openElementOffsets.size();
+
+    if (isPendingEndOfEmptyElement)
+    {
+        isPendingEndOfEmptyElement = false;
+        auto offset = openElementOffsets.getLast();
+        itemData.write (openElementNames.begin() + offset, (size_t) (openElementNames.size() - offset));
+        return currentEvent = popElement();
+    }
+
+    return currentEvent = readNextItem();
+}
+
+XmlPullParser::EventType XmlPullParser::readNextItem()
+{
+    if (hasFinishedDocument)
+        return endOfDocument;
+
+    for (;;)
+    {
+        auto c = peek();
+
+        if (c < 0)
+            return fail (depth > 0 ? "unmatched tags" : "not enough input");
+
+        if (c == '<')
+        {
+            ensureAvailable (9);
+
+            if (matches ("<!--"))
+            {
+                position += 4;
+
+                if (! skipPast ("-->"))
+                    return fail ("unterminated comment");
+
+                continue;
+            }
+
+            if (matches ("<![CDATA["))
+            {
+                if (depth == 0)
+                    return fail ("CDATA section outside the document element");
+
+                position += 9;
+                return readCDATA();
+            }
+
+            if (matches ("<?"))
+            {
+                if (! skipPast ("?>"))
+                    return fail ("unterminated processing instruction");
+
+                continue;
+            }
+
+            if (matches ("<!"))
+            {
+                if (! skipDocType())
+                    return fail ("unterminated DOCTYPE");
+
+                continue;
+            }
+
+            if (matches ("</"))
+            {
+                position += 2;
+                return readEndTag();
+            }
+
+            ++position;
+            return readStartTag();
+        }
+
+        if (depth == 0)
+        {
+            if (! XmlPullParserHelpers::isWhitespace ((char) c))
+                return fail ("text found outside the document element");
+
+            ++position;
+            continue;
+        }
+
+        bool isEmpty = false;
+        auto e = readText (isEmpty);
+
+        if (! isEmpty)
+            return e;
+
+        itemData.reset();
+    }
+}
+
+XmlPullParser::EventType XmlPullParser::readStartTag()
+{
+    // allow for a gap after the '<', as XmlDocument does
+    skipWhitespace();
+
+    if (! readName())
+        return fail ("tag name missing");
+
+    for (;;)
+    {
+        skipWhitespace();
+        auto c = peek();
+
+        if (c == '>')
+        {
+            ++position;
+            break;
+        }
+
+        if (c == '/')
+        {
+            ++position;
+
+            if (peek() != '>')
+                return fail ("expected '>' after '/' in " + String (getItemText (0).text));
+
+            ++position;
+            isPendingEndOfEmptyElement = true;
+            break;
+        }
+
+        if (c < 0)
+            return fail ("unterminated element " + String (getItemText (0).text));
+
+        if (! XmlPullParserHelpers::isNameChar ((char) c))
+            return fail ("illegal character found in " + String (getItemText (0).text) + ": '" + String::charToString ((juce_wchar) c) + "'");
+
+        attributeOffsets.add ((int) itemData.getDataSize());
+        readName();
+        skipWhitespace();
+
+        if (peek() != '=')
+            return fail ("expected '=' after attribute '" + String (getItemText (attributeOffsets.getLast()).text) + "'");
+
+        ++position;
+        skipWhitespace();
+        attributeOffsets.add ((int) itemData.getDataSize());
+
+        if (! readQuotedValue())
+            return fail ("unmatched quotes");
+    }
+
+    auto nameLength = (int) strlen (static_cast<const char*> (itemData.getData())) + 1;
+    openElementOffsets.add (openElementNames.size());
+    openElementNames.addArray (static_cast<const char*> (itemData.getData()), nameLength);
+    depth = openElementOffsets.size();
+    return startElement;
+}
+
+XmlPullParser::EventType XmlPullParser::readEndTag()
+{
+    skipWhitespace();
+    readName();
+    skipWhitespace();
+
+    if (peek() != '>')
+        return fail ("unterminated closing tag");
+
+    ++position;
+
+    if (openElementOffsets.isEmpty()
+         || strcmp (openElementNames.begin() + openElementOffsets.getLast(),
+                    static_cast<const char*> (itemData.getData())) != 0)
+        return fail ("unmatched tags");
+
+    return popElement();
+}
+
+XmlPullParser::EventType XmlPullParser::popElement()
+{
+    depth = openElementOffsets.size();
+    openElementNames.resize (openElementOffsets.getLast());
+    openElementOffsets.removeLast();
+    hasFinishedDocument = openElementOffsets.isEmpty();
+    return endElement;
+}
+
+XmlPullParser::EventType XmlPullParser::readText (bool& isEmpty)
+{
+    bool containsNonWhitespace = ! ignoreEmptyText;
+
+    for (;;)
+    {
+        if (! ensureAvailable (1))
+            return fail ("unmatched tags");
+
+        auto* start = buffer + position;
+        auto* end = buffer + numInBuffer;
+        auto* p = start;
+
+        // copy everything up to the next character that needs special treatment in one go
+        for (; p < end; ++p)
+        {
+            auto c = *p;
+
+            if (c == '<' || c == '&' || c == '\r')
+                break;
+
+            containsNonWhitespace = containsNonWhitespace || ! XmlPullParserHelpers::isWhitespace (c);
+        }
+
+        itemData.write (start, (size_t) (p - start));
+        position += (int) (p - start);
+
+        if (p == end)
+            continue;
+
+        if (*p == '\r')
+        {
+            ++position;
+
+            // "\r\n" and a lone '\r' both become '\n', like XmlDocument
+            if (! (ensureAvailable (1) && buffer[position] == '\n'))
+                itemData.writeByte ('\n');
+        }
+        else if (*p == '&')
+        {
+            auto c = readEntity();
+            containsNonWhitespace = containsNonWhitespace || ! CharacterFunctions::isWhitespace (c);
+        }
+        else
+        {
+            ensureAvailable (4);
+
+            if (! matches ("<!--"))
+                break;
+
+            position += 4;
+
+            if (! skipPast ("-->"))
+                return fail ("unterminated comment");
+        }
+    }
+
+    isEmpty = ! containsNonWhitespace;
+    itemData.writeByte (0);
+    return text;
+}
+
+XmlPullParser::EventType XmlPullParser::readCDATA()
+{
+    for (;;)
+    {
+        if (! ensureAvailable (3))
+            return fail ("unterminated CDATA section");
+
+        auto* start = buffer + position;
+        auto* p = static_cast<const char*> (memchr (start, ']', (size_t) (numInBuffer - position)));
+
+        if (p == nullptr)
+        {
+            itemData.write (start, (size_t) (numInBuffer - position));
+            position = numInBuffer;
+            continue;
+        }
+
+        itemData.write (start, (size_t) (p - start));
+        position += (int) (p - start);
+
+        if (! ensureAvailable (3))
+            return fail ("unterminated CDATA section");
+
+        if (matches ("]]>"))
+        {
+            position += 3;
+            itemData.writeByte (0);
+            return text;
+        }
+
+        itemData.writeByte (']');
+        ++position;
+    }
+}
+
+XmlPullParser::EventType XmlPullParser::fail (const String& message)
+{
+    lastError = message;
+    itemData.reset();
+    attributeOffsets.clearQuick();
+    return error;
+}
+
+//==============================================================================
+bool XmlPullParser::readName()
+{
+    auto startSize = itemData.getDataSize();
+
+    while (ensureAvailable (1))
+    {
+        auto* start = buffer + position;
+        auto* end = buffer + numInBuffer;
+        auto* p = start;
+
+        while (p < end && XmlPullParserHelpers::isNameChar (*p))
+            ++p;
+
+        itemData.write (start, (size_t) (p - start));
+        position += (int) (p - start);
+
+        if (p < end)
+            break;
+    }
+
+    auto hasName = itemData.getDataSize() > startSize;
+    itemData.writeByte (0);
+    return hasName;
+}
+
+bool XmlPullParser::readQuotedValue()
+{
+    auto quote = peek();
+
+    if (quote != '"' && quote != '\'')
+        return false;
+
+    ++position;
+
+    for (;;)
+    {
+        if (! ensureAvailable (1))
+            return false;
+
+        auto* start = buffer + position;
+        auto* end = buffer + numInBuffer;
+        auto* p = start;
+
+        while (p < end && *p != quote && *p != '&')
+            ++p;
+
+        itemData.write (start, (size_t) (p - start));
+        position += (int) (p - start);
+
+        if (p == end)
+            continue;
+
+        if (*p == '&')
+        {
+            readEntity();
+            continue;
+        }
+
+        ++position;
+        itemData.writeByte (0);
+        return true;
+    }
+}
+
+juce_wchar XmlPullParser::readEntity()
+{
+    ensureAvailable (XmlPullParserHelpers::maxEntityLength);
+
+    auto* start = buffer + position + 1;
+    auto* end = buffer + jmin (numInBuffer, position + (int) XmlPullParserHelpers::maxEntityLength);
+    auto* semicolon = static_cast<const char*> (memchr (start, ';', (size_t) jmax (0, (int) (end - start))));
+    juce_wchar c = 0;
+
+    if (semicolon != nullptr)
+    {
+        auto length = (int) (semicolon - start);
+
+        if      (XmlPullParserHelpers::equalsIgnoreCase (start, length, "amp"))   c = '&';
+        else if (XmlPullParserHelpers::equalsIgnoreCase (start, length, "quot"))  c = '"';
+        else if (XmlPullParserHelpers::equalsIgnoreCase (start, length, "apos"))  c = '\'';
+        else if (XmlPullParserHelpers::equalsIgnoreCase (start, length, "lt"))    c = '<';
+        else if (XmlPullParserHelpers::equalsIgnoreCase (start, length, "gt"))    c = '>';
+        else if (length > 1 && start[0] == '#')
+        {
+            uint32 code = 0;
+            bool isValid = true;
+
+            if (start[1] == 'x' || start[1] == 'X')
+            {
+                isValid = length > 2 && length <= 10;
+
+                for (int i = 2; i < length && isValid; ++i)
+                {
+                    auto digit = CharacterFunctions::getHexDigitValue ((juce_wchar) (uint8) start[i]);
+                    isValid = digit >= 0;
+                    code = (code << 4) | (uint32) digit;
+                }
+            }
+            else
+            {
+                isValid = length <= 8;
+
+                for (int i = 1; i < length && isValid; ++i)
+                {
+                    isValid = start[i] >= '0' && start[i] <= '9';
+                    code = code * 10 + (uint32) (start[i] - '0');
+                }
+            }
+
+            if (isValid && code > 0 && code <= 0x10ffff)
+                c = (juce_wchar) code;
+        }
+    }
+
+    if (c == 0)
+    {
+        // entities that would need a DTD to expand are left as they are
+        itemData.writeByte ('&');
+        ++position;
+        return '&';
+    }
+
+    itemData.appendUTF8Char (c);
+    position = (int) (semicolon + 1 - buffer.get());
+    return c;
+}
+
+bool XmlPullParser::skipPast (const char* terminator)
+{
+    auto length = (int) strlen (terminator);
+
+    while (ensureAvailable (length))
+    {
+        auto* start = buffer + position;
+        auto* p = static_cast<const char*> (memchr (start, terminator[0], (size_t) (numInBuffer - position)));
+
+        if (p == nullptr)
+        {
+            // keep the last few bytes in case the terminator is split across two reads
+            position = numInBuffer - (length - 1);
+            continue;
+        }
+
+        position += (int) (p - start);
+
+        if (ensureAvailable (length) && matches (terminator))
+        {
+            position += length;
+            return true;
+        }
+
+        ++position;
+    }
+
+    return false;
+}
+
+bool XmlPullParser::skipDocType()
+{
+    int bracketDepth = 0;
+    position += 2;
+
+    for (;;)
+    {
+        auto c = peek();
+
+        if (c < 0)
+            return false;
+
+        ++position;
+
+        if (c == '[')       ++bracketDepth;
+        else if (c == ']')  --bracketDepth;
+        else if (c == '>' && bracketDepth <= 0)  return true;
+    }
+}
+
+void XmlPullParser::skipWhitespace()
+{
+    while (ensureAvailable (1) && XmlPullParserHelpers::isWhitespace (buffer[position]))
+        ++position;
+}
+
+void XmlPullParser::prepareInput()
+{
+    ensureAvailable (3);
+    auto* b = reinterpret_cast<const uint8*> (buffer.get());
+
+    if (numInBuffer >= 3 && b[0] == 0xef && b[1] == 0xbb && b[2] == 0xbf)
+    {
+        position = 3;
+    }
+    else if (numInBuffer >= 2 && ((b[0] == 0xff && b[1] == 0xfe) || (b[0] == 0xfe && b[1] == 0xff)))
+    {
+        // Only UTF-8 is parsed directly, so UTF-16 text has to be converted first
+        MemoryOutputStream mo;
+        mo.write (buffer, (size_t) numInBuffer);
+        mo << *input;
+
+        convertedText = mo.toString();
+        convertedInput.reset (new MemoryInputStream (convertedText.toRawUTF8(), convertedText.getNumBytesAsUTF8(), false));
+        input = convertedInput.get();
+        position = numInBuffer = 0;
+    }
+}
+
+bool XmlPullParser::ensureAvailable (int numNeeded)
+{
+    if (numInBuffer - position >= numNeeded)
+        return true;
+
+    if (position > 0)
+    {
+        numInBuffer -= position;
+        memmove (buffer, buffer + position, (size_t) numInBuffer);
+        position = 0;
+    }
+
+    while (numInBuffer < numNeeded)
+    {
+        auto numRead = input->read (buffer + numInBuffer, XmlPullParserHelpers::bufferSize - numInBuffer);
+
+        if (numRead <= 0)
+            return false;
+
+        numInBuffer += numRead;
+    }
+
+    return true;
+}
+
+bool XmlPullParser::matches (const char* s) const noexcept
+{
+    auto length = (int) strlen (s);
+    return numInBuffer - position >= length && memcmp (buffer + position, s, (size_t) length) == 0;
+}
+
+int XmlPullParser::peek()
+{
+    return ensureAvailable (1) ? (int) (uint8) buffer[position] : -1;
+}
+
+//==============================================================================
+StringRef XmlPullParser::getItemText (int offset) const noexcept
+{
+    if (offset >= (int) itemData.getDataSize())
+        return {};
+
+    return StringRef (String::CharPointerType (static_cast<const char*> (itemData.getData()) + offset));
+}
+
+StringRef XmlPullParser::getName() const noexcept
+{
+    return currentEvent == startElement || currentEvent == endElement ? getItemText (0) : StringRef();
+}
+
+StringRef XmlPullParser::getText() const noexcept
+{
+    return currentEvent == text ? getItemText (0) : StringRef();
+}
+
+int XmlPullParser::getNumAttributes() const noexcept
+{
+    return currentEvent == startElement ? attributeOffsets.size() / 2 : 0;
+}
+
+StringRef XmlPullParser::getAttributeName (int index) const noexcept
+{
+    return isPositiveAndBelow (index, getNumAttributes()) ? getItemText (attributeOffsets.getUnchecked (index * 2)) : StringRef();
+}
+
+StringRef XmlPullParser::getAttributeValue (int index) const noexcept
+{
+    return isPositiveAndBelow (index, getNumAttributes()) ? getItemText (attributeOffsets.getUnchecked (index * 2 + 1)) : StringRef();
+}
+
+StringRef XmlPullParser::getAttributeValue (StringRef attributeName) const noexcept
+{
+    for (int i = 0; i < getNumAttributes(); ++i)
+        if (getAttributeName (i) == attributeName)
+            return getAttributeValue (i);
+
+    return {};
+}
+
+//==============================================================================
+XmlElement* XmlPullParser::createElementForCurrentItem() const
+{
+    auto name = getName();
+    auto* e = new XmlElement (name.text, name.text.findTerminatingNull());
+    LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (e->attributes);
+
+    for (int i = 0; i < getNumAttributes(); ++i)
+    {
+        auto attName = getAttributeName (i);
+        auto* att = new XmlElement::XmlAttributeNode (attName.text, attName.text.findTerminatingNull());
+        att->value = String (getAttributeValue (i).text);
+        attributeAppender.append (att);
+    }
+
+    return e;
+}
+
+std::unique_ptr<XmlElement> XmlPullParser::readElement()
+{
+    if (currentEvent != startElement)
+        return {};
+
+    std::unique_ptr<XmlElement> result (createElementForCurrentItem());
+
+    // for each open element, this points at the place where its next child should go
+    Array<LinkedListPointer<XmlElement>*> nextChildSlots;
+    nextChildSlots.add (&(result->firstChildElement));
+
+    while (! nextChildSlots.isEmpty())
+    {
+        XmlElement* child = nullptr;
+
+        switch (next())
+        {
+            case startElement:  child = createElementForCurrentItem(); break;
+            case text:          child = XmlElement::createTextElement (String (getText().text)); break;
+            case endElement:    nextChildSlots.removeLast(); continue;
+            case endOfDocument:
+            case error:
+            default:            return {};
+        }
+
+        auto& slot = nextChildSlots.getReference (nextChildSlots.size() - 1);
+        *slot = child;
+        slot = &(child->nextListItem);
+
+        if (currentEvent == startElement)
+            nextChildSlots.add (&(child->firstChildElement));
+    }
+
+    return result;
+}
+
+void XmlPullParser::skipElement()
+{
+    if (currentEvent != startElement)
+        return;
+
+    auto targetDepth = depth;
+
+    while (next() != endElement || depth != targetDepth)
+        if (currentEvent == error || currentEvent == endOfDocument)
+            break;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class XmlPullParserTests  : public UnitTest
+{
+public:
+    XmlPullParserTests() : UnitTest ("XmlPullParser", "XML") {}
+
+    // Hands out the data a few bytes at a time, to test items that span several reads
+    struct TrickleInputStream  : public MemoryInputStream
+    {
+        TrickleInputStream (const String& s, int chunk)
+            : MemoryInputStream (s.toRawUTF8(), s.getNumBytesAsUTF8(), true), chunkSize (chunk) {}
+
+        int read (void* dest, int numBytes) override    { return MemoryInputStream::read (dest, jmin (numBytes, chunkSize)); }
+
+        int chunkSize;
+    };
+
+    static String getEvents (InputStream& in)
+    {
+        XmlPullParser parser (in);
+        StringArray events;
+
+        for (;;)
+        {
+            switch (parser.next())
+            {
+                case XmlPullParser::startElement:
+                {
+                    String s ("<" + String (parser.getName().text));
+
+                    for (int i = 0; i < parser.getNumAttributes(); ++i)
+                        s << " " << String (parser.getAttributeName (i).text) << "=" << String (parser.getAttributeValue (i).text);
+
+                    events.add (s + ">" + String (parser.getDepth()));
+                    break;
+                }
+
+                case XmlPullParser::endElement:  events.add ("</" + String (parser.getName().text) + ">" + String (parser.getDepth())); break;
+                case XmlPullParser::text:        events.add ("[" + String (parser.getText().text) + "]"); break;
+                case XmlPullParser::error:       return "error: " + parser.getLastError();
+                case XmlPullParser::endOfDocument:
+                default:                         return events.joinIntoString (" ");
+            }
+        }
+    }
+
+    static String getEvents (const String& xml)
+    {
+        MemoryInputStream in (xml.toRawUTF8(), xml.getNumBytesAsUTF8(), false);
+        return getEvents (in);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Events");
+        {
+            expectEquals (getEvents ("<a x=\"1\" y='two'><b/>hello</a>"),
+                          String ("<a x=1 y=two>1 <b>2 </b>2 [hello] </a>1"));
+
+            expectEquals (getEvents ("<?xml version=\"1.0\"?>\n<!DOCTYPE a [ <!ENTITY e \"x\"> ]>\n<!-- c --><a>\n  <b v=\"&lt;&amp;&#65;&#x42;\"/>\n</a>"),
+                          String ("<a>1 <b v=<&AB>2 </b>2 </a>1"));
+
+            expectEquals (getEvents ("<a>x &amp; y<!-- comment -->z\r\n<![CDATA[<not a tag> ]] ]]></a>"),
+                          String ("<a>1 [x & yz\n] [<not a tag> ]] ] </a>1"));
+
+            expectEquals (getEvents ("<a>&unknown; &#0; &#xZZ;</a>"), String ("<a>1 [&unknown; &#0; &#xZZ;] </a>1"));
+            expectEquals (getEvents (String (CharPointer_UTF8 ("<a \xc3\xa9=\"\xe2\x82\xac\">\xce\xa9</a>"))),
+                          String (CharPointer_UTF8 ("<a \xc3\xa9=\xe2\x82\xac>1 [\xce\xa9] </a>1")));
+        }
+
+        beginTest ("Errors");
+        {
+            expect (getEvents ("<a><b></a>").startsWith ("error"));
+            expect (getEvents ("<a><b>").startsWith ("error"));
+            expect (getEvents ("<a x=1/>").startsWith ("error"));
+            expect (getEvents ("<a x></a>").startsWith ("error"));
+            expect (getEvents ("<a><!-- </a>").startsWith ("error"));
+            expect (getEvents ("<a><![CDATA[ </a>").startsWith ("error"));
+            expect (getEvents ("hello").startsWith ("error"));
+            expect (getEvents ("").startsWith ("error"));
+        }
+
+        beginTest ("Attribute lookup and skipping");
+        {
+            String xml ("<root><skip><deep><deeper/></deep></skip><keep id=\"k\" n=\"3\"/></root>");
+            MemoryInputStream in (xml.toRawUTF8(), xml.getNumBytesAsUTF8(), false);
+            XmlPullParser parser (in);
+
+            expect (parser.next() == XmlPullParser::startElement);
+            expect (parser.next() == XmlPullParser::startElement);
+            parser.skipElement();
+            expect (parser.getEventType() == XmlPullParser::endElement);
+            expect (parser.getName() == StringRef ("skip"));
+
+            expect (parser.next() == XmlPullParser::startElement);
+            expect (parser.getAttributeValue ("n") == StringRef ("3"));
+            expect (parser.getAttributeValue ("id") == StringRef ("k"));
+            expect (parser.getAttributeValue ("missing").isEmpty());
+            expect (parser.next() == XmlPullParser::endElement);
+            expect (parser.next() == XmlPullParser::endElement);
+            expect (parser.next() == XmlPullParser::endOfDocument);
+            expect (parser.next() == XmlPullParser::endOfDocument);
+        }
+
+        beginTest ("Reading elements");
+        {
+            Random r = getRandom();
+
+            for (int i = 0; i < 20; ++i)
+            {
+                XmlElement original ("root");
+                addRandomChildren (r, original, 0);
+                auto xml = original.createDocument ({});
+
+                TrickleInputStream in (xml, r.nextInt ({ 1, 20 }));
+                XmlPullParser parser (in);
+                expect (parser.next() == XmlPullParser::startElement);
+
+                std::unique_ptr<XmlElement> parsed (parser.readElement());
+                std::unique_ptr<XmlElement> reference (XmlDocument::parse (xml));
+
+                expect (parsed != nullptr && reference != nullptr);
+
+                if (parsed != nullptr && reference != nullptr)
+                {
+                    expect (parsed->isEquivalentTo (reference.get(), false));
+                    expectEquals (parsed->createDocument ({}), reference->createDocument ({}));
+                }
+
+                expect (parser.next() == XmlPullParser::endOfDocument);
+            }
+        }
+
+        beginTest ("Encodings");
+        {
+            String xml (CharPointer_UTF8 ("<a t=\"\xe2\x82\xac\">z</a>"));
+
+            MemoryOutputStream withBOM;
+            withBOM.writeByte ((char) 0xef);
+            withBOM.writeByte ((char) 0xbb);
+            withBOM.writeByte ((char) 0xbf);
+            withBOM << xml;
+
+            auto expected = getEvents (xml);
+            MemoryInputStream utf8 (withBOM.getData(), withBOM.getDataSize(), false);
+            expectEquals (getEvents (utf8), expected);
+
+            MemoryOutputStream utf16;
+            utf16.writeByte ((char) 0xff);
+            utf16.writeByte ((char) 0xfe);
+
+            for (auto p = xml.getCharPointer(); ! p.isEmpty();)
+                utf16.writeShort ((short) p.getAndAdvance());
+
+            MemoryInputStream utf16In (utf16.getData(), utf16.getDataSize(), false);
+            expectEquals (getEvents (utf16In), expected);
+        }
+    }
+
+    static void addRandomChildren (Random& r, XmlElement& parent, int depth)
+    {
+        const char* const names[] = { "a", "long_element_name", "x:y", "b.c" };
+        const char* const values[] = { "", "plain", "<&>\"'", "\xe2\x82\xac with spaces", "line\nbreak" };
+
+        for (int i = r.nextInt (depth < 4 ? 5 : 1); --i >= 0;)
+        {
+            if (r.nextInt (3) == 0)
+            {
+                parent.addTextElement (String (CharPointer_UTF8 (values[r.nextInt (numElementsInArray (values))])) + "t");
+                continue;
+            }
+
+            auto* child = parent.createNewChildElement (names[r.nextInt (numElementsInArray (names))]);
+
+            for (int j = r.nextInt (4); --j >= 0;)
+                child->setAttribute ("att" + String (j), CharPointer_UTF8 (values[r.nextInt (numElementsInArray (values))]));
+
+            addRandomChildren (r, *child, depth + 1);
+        }
+    }
+};
+
+static XmlPullParserTests xmlPullParserTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads an XML document from a stream one item at a time, without building a tree
+    of XmlElement objects.
+
+    Each call to next() moves on to the next start tag, end tag or block of text, and
+    the details of the current item can then be read with getName(), getAttributeValue(),
+    getText() etc. The text is read from the stream in chunks, so this uses very little
+    memory however large the document is, and none of the names or values are copied
+    into Strings unless you do it yourself - the StringRefs returned point into an
+    internal buffer, and only remain valid until the next call to next().
+
+    @code
+    FileInputStream in (sessionFile);
+    XmlPullParser parser (in);
+
+    while (parser.next() == XmlPullParser::startElement)
+    {
+        if (parser.getName() == StringRef ("TRACK"))
+            addTrack (parser.getAttributeValue ("name"));
+    }
+
+    if (parser.getEventType() == XmlPullParser::error)
+        DBG (parser.getLastError());
+    @endcode
+
+    When you reach an element that you do want to keep, readElement() will turn it
+    and its children into an XmlElement, and skipElement() will jump past it.
+
+    Comments, processing instructions and any DOCTYPE are skipped. The standard and
+    numeric character entities are decoded, but entities that are defined by a DTD are
+    left as they are, so documents that rely on those should be read with XmlDocument.
+
+    @see XmlDocument
+
+    @tags{Core}
+*/
+class JUCE_API  XmlPullParser
+{
+public:
+    //==============================================================================
+    /** Creates a parser that will read from the given stream, which must remain valid
+        for the lifetime of the parser.
+    */
+    explicit XmlPullParser (InputStream& source);
+
+    /** Destructor. */
+    ~XmlPullParser();
+
+    //==============================================================================
+    /** The kinds of item that next() can find. */
+    enum EventType
+    {
+        startElement,   /**< An opening tag. Use getName() and the attribute methods to find out about it. */
+        endElement,     /**< A closing tag - this is also produced after the start of an empty "<tag/>" element. */
+        text,           /**< Some text or a CDATA section inside an element. Use getText() to read it. */
+        endOfDocument,  /**< There's nothing else to read. */
+        error           /**< The document was malformed - see getLastError(). */
+    };
+
+    /** Moves on to the next item in the document and returns its type.
+        Once endOfDocument or error have been returned, this will keep returning them.
+    */
+    EventType next();
+
+    /** Returns the type of the item that the last call to next() found. */
+    EventType getEventType() const noexcept             { return currentEvent; }
+
+    /** Returns the number of elements that enclose the current item.
+        The outer document element is at depth 1, while it's the current item.
+    */
+    int getDepth() const noexcept                       { return depth; }
+
+    //==============================================================================
+    /** Returns the tag name of the current startElement or endElement. */
+    StringRef getName() const noexcept;
+
+    /** Returns the number of attributes that the current startElement has. */
+    int getNumAttributes() const noexcept;
+
+    /** Returns the name of one of the current element's attributes. */
+    StringRef getAttributeName (int index) const noexcept;
+
+    /** Returns the value of one of the current element's attributes, with any entities decoded. */
+    StringRef getAttributeValue (int index) const noexcept;
+
+    /** Returns the value of the attribute with a given name, or an empty string if
+        the current element doesn't have one.
+    */
+    StringRef getAttributeValue (StringRef attributeName) const noexcept;
+
+    /** Returns the content of the current text item, with any entities decoded. */
+    StringRef getText() const noexcept;
+
+    //==============================================================================
+    /** When the current item is a startElement, this reads the whole of that element
+        and returns it as an XmlElement, leaving the parser at its endElement.
+        Returns nullptr if the current item isn't a startElement, or if there's an error.
+    */
+    std::unique_ptr<XmlElement> readElement();
+
+    /** When the current item is a startElement, this skips over its contents, leaving
+        the parser at its endElement.
+    */
+    void skipElement();
+
+    //==============================================================================
+    /** Returns a description of the problem, if next() has returned error. */
+    const String& getLastError() const noexcept        { return lastError; }
+
+    /** Sets whether text that only contains whitespace should be skipped, which it is by default. */
+    void setEmptyTextIgnored (bool shouldBeIgnored) noexcept   { ignoreEmptyText = shouldBeIgnored; }
+
+private:
+    //==============================================================================
+    InputStream* input;
+    std::unique_ptr<InputStream> convertedInput;
+    String convertedText;
+    HeapBlock<char> buffer;
+    int position = 0, numInBuffer = 0, depth = 0;
+
+    MemoryOutputStream itemData;
+    Array<int> attributeOffsets, openElementOffsets;
+    Array<char> openElementNames;
+
+    EventType currentEvent = endOfDocument;
+    bool hasStarted = false, hasFinishedDocument = false;
+    bool isPendingEndOfEmptyElement = false, ignoreEmptyText = true;
+    String lastError;
+
+    EventType readNextItem();
+    EventType readStartTag();
+    EventType readEndTag();
+    EventType readText (bool& isEmpty);
+    EventType readCDATA();
+    EventType popElement();
+    EventType fail (const String&);
+    bool readName();
+    bool readQuotedValue();
+    juce_wchar readEntity();
+    bool skipPast (const char*);
+    bool skipDocType();
+    void skipWhitespace();
+    void prepareInput();
+    bool ensureAvailable (int);
+    bool matches (const char*) const noexcept;
+    int peek();
+    StringRef getItemText (int offset) const noexcept;
+    XmlElement* createElementForCurrentItem() const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlPullParser)
+};
+
+} // namespace juce
@@ -112,6 +112,248 @@ private:
     JUCE_DECLARE_NON_COPYABLE (GZIPCompressorHelper)
 };
 
+//==============================================================================
+class GZIPCompressorOutputStream::ParallelCompressor
+{
+public:
+    ParallelCompressor (ThreadPool& threadPool, int compressionLevel, int windowBits, int blockSizeBytes)
+        : pool (threadPool),
+          compLevel ((compressionLevel < 0 || compressionLevel > 9) ? -1 : compressionLevel),
+          format (windowBits < 0 ? rawFormat : (windowBits > 15 ? gzipFormat : zlibFormat)),
+          windowBitsForBlocks (-(windowBits == 0 ? 15 : (std::abs (windowBits) & 15))),
+          // each block's dictionary is the tail of the previous block, so a block needs to fill the window
+          blockSize ((size_t) jmax (blockSizeBytes, 1 << -windowBitsForBlocks)),
+          maxBlocksInFlight (jmax (2, pool.getNumThreads() * 2))
+    {
+        currentBlock.setSize (blockSize);
+    }
+
+    ~ParallelCompressor()
+    {
+        for (auto* job : blocks)
+            pool.removeJob (job, false, -1);
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When you call flush() on a gzip stream, the stream is closed, and you can
+        // no longer continue to write data to it!
+        jassert (! finished);
+
+        while (dataSize > 0)
+        {
+            auto numToCopy = jmin (dataSize, blockSize - numInCurrentBlock);
+            memcpy (static_cast<uint8*> (currentBlock.getData()) + numInCurrentBlock, data, numToCopy);
+            numInCurrentBlock += numToCopy;
+            data += numToCopy;
+            dataSize -= numToCopy;
+
+            if (numInCurrentBlock == blockSize)
+            {
+                startBlock (false);
+
+                if (! writeFinishedBlocks (out, false))
+                    return false;
+            }
+        }
+
+        return ! failed;
+    }
+
+    void finish (OutputStream& out)
+    {
+        if (finished)
+            return;
+
+        finished = true;
+        startBlock (true);
+
+        if (writeFinishedBlocks (out, true))
+            writeTrailer (out);
+    }
+
+private:
+    enum Format { rawFormat, zlibFormat, gzipFormat };
+
+    struct BlockJob  : public ThreadPoolJob
+    {
+        BlockJob (const ParallelCompressor& o, bool last)
+            : ThreadPoolJob ("GZIP block"), owner (o), isLastBlock (last) {}
+
+        JobStatus runJob() override
+        {
+            using namespace zlibNamespace;
+
+            z_stream stream;
+            zerostruct (stream);
+
+            if (deflateInit2 (&stream, owner.compLevel, Z_DEFLATED, owner.windowBitsForBlocks, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                return jobHasFinished;
+
+            if (dictionary.getSize() > 0)
+                deflateSetDictionary (&stream, static_cast<Bytef*> (dictionary.getData()), (uInt) dictionary.getSize());
+
+            stream.next_in  = static_cast<Bytef*> (input.getData());
+            stream.avail_in = (uInt) inputSize;
+
+            // non-final blocks end with a sync flush, which leaves them byte-aligned and not
+            // marked as final, so that they can simply be appended to each other
+            auto flushMode = isLastBlock ? Z_FINISH : Z_SYNC_FLUSH;
+            Bytef buffer[32768];
+
+            for (;;)
+            {
+                stream.next_out  = buffer;
+                stream.avail_out = (uInt) sizeof (buffer);
+
+                auto result = deflate (&stream, flushMode);
+
+                if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+                    break;
+
+                output.write (buffer, sizeof (buffer) - stream.avail_out);
+
+                if (isLastBlock ? (result == Z_STREAM_END) : (stream.avail_out != 0))
+                {
+                    succeeded = true;
+                    break;
+                }
+            }
+
+            deflateEnd (&stream);
+
+            if (owner.format == gzipFormat)
+                checksum = crc32 (0, static_cast<Bytef*> (input.getData()), (uInt) inputSize);
+            else if (owner.format == zlibFormat)
+                checksum = adler32 (1, static_cast<Bytef*> (input.getData()), (uInt) inputSize);
+
+            return jobHasFinished;
+        }
+
+        const ParallelCompressor& owner;
+        const bool isLastBlock;
+        MemoryBlock input, dictionary;
+        size_t inputSize = 0;
+        MemoryOutputStream output;
+        unsigned long checksum = 0;
+        bool succeeded = false;
+    };
+
+    ThreadPool& pool;
+    const int compLevel;
+    const Format format;
+    const int windowBitsForBlocks;
+    const size_t blockSize;
+    const int maxBlocksInFlight;
+
+    MemoryBlock currentBlock, lastWindow;
+    size_t numInCurrentBlock = 0;
+    OwnedArray<BlockJob> blocks;
+    unsigned long checksum = 0;
+    int64 totalInputSize = 0;
+    bool hasWrittenHeader = false, finished = false, failed = false;
+
+    void startBlock (bool isLast)
+    {
+        auto* job = new BlockJob (*this, isLast);
+        job->inputSize = numInCurrentBlock;
+        job->dictionary = lastWindow;
+
+        auto windowSize = jmin (numInCurrentBlock, (size_t) 1 << -windowBitsForBlocks);
+        lastWindow.replaceWith (static_cast<const uint8*> (currentBlock.getData()) + numInCurrentBlock - windowSize, windowSize);
+
+        job->input.swapWith (currentBlock);
+        numInCurrentBlock = 0;
+
+        if (! isLast)
+            currentBlock.setSize (blockSize);
+
+        blocks.add (job);
+        pool.addJob (job, false);
+    }
+
+    bool writeFinishedBlocks (OutputStream& out, bool waitForAll)
+    {
+        while (! failed && ! blocks.isEmpty())
+        {
+            auto* job = blocks.getFirst();
+
+            // the oldest block has to be written before any later ones, so if it's not ready,
+            // only wait for it when there are too many blocks queued up behind it
+            if (! (waitForAll || blocks.size() > maxBlocksInFlight || pool.waitForJobToFinish (job, 0)))
+                break;
+
+            pool.waitForJobToFinish (job, -1);
+
+            if (! job->succeeded)
+            {
+                failed = true;
+                break;
+            }
+
+            if (! hasWrittenHeader)
+                writeHeader (out);
+
+            combineChecksum (job->checksum, job->inputSize);
+            totalInputSize += (int64) job->inputSize;
+
+            if (job->output.getDataSize() > 0 && ! out.write (job->output.getData(), job->output.getDataSize()))
+                failed = true;
+
+            blocks.remove (0);
+        }
+
+        return ! failed;
+    }
+
+    void combineChecksum (unsigned long blockChecksum, size_t numBytes)
+    {
+        using namespace zlibNamespace;
+
+        if (format == gzipFormat)
+            checksum = crc32_combine (checksum, blockChecksum, (z_off_t) numBytes);
+        else if (format == zlibFormat)
+            checksum = totalInputSize == 0 ? blockChecksum : adler32_combine (checksum, blockChecksum, (z_off_t) numBytes);
+    }
+
+    void writeHeader (OutputStream& out)
+    {
+        hasWrittenHeader = true;
+
+        if (format == gzipFormat)
+        {
+            const uint8 header[] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+            out.write (header, sizeof (header));
+        }
+        else if (format == zlibFormat)
+        {
+            // the same two bytes that deflate() would produce for this window size and level
+            auto level = compLevel < 0 ? 6 : compLevel;
+            auto levelFlags = level < 2 ? 0 : (level < 6 ? 1 : (level == 6 ? 2 : 3));
+            auto header = (((-windowBitsForBlocks - 8) << 4 | 8) << 8) | (levelFlags << 6);
+            header += 31 - (header % 31);
+
+            out.writeByte ((char) (header >> 8));
+            out.writeByte ((char) header);
+        }
+    }
+
+    void writeTrailer (OutputStream& out)
+    {
+        if (format == gzipFormat)
+        {
+            out.writeInt ((int) checksum);
+            out.writeInt ((int) (uint32) totalInputSize);
+        }
+        else if (format == zlibFormat)
+        {
+            out.writeIntBigEndian ((int) checksum);
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelCompressor)
+};
+
 //==============================================================================
 GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream& s, int compressionLevel, int windowBits)
    : GZIPCompressorOutputStream (&s, compressionLevel, false, windowBits)
@@ -120,7 +362,9 @@ GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream& s, int com
 
 GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream* out, int compressionLevel, bool deleteDestStream, int windowBits)
    : destStream (out, deleteDestStream),
-     helper (new GZIPCompressorHelper (compressionLevel, windowBits))
+     helper (new GZIPCompressorHelper (compressionLevel, windowBits)),
+     compressionLevelToUse (compressionLevel),
+     windowBitsToUse (windowBits)
 {
     jassert (out != nullptr);
 }
@@ -132,17 +376,34 @@ GZIPCompressorOutputStream::~GZIPCompressorOutputStream()
 
 void GZIPCompressorOutputStream::flush()
 {
-    helper->finish (*destStream);
+    if (parallelCompressor != nullptr)
+        parallelCompressor->finish (*destStream);
+    else
+        helper->finish (*destStream);
+
     destStream->flush();
 }
 
 bool GZIPCompressorOutputStream::write (const void* destBuffer, size_t howMany)
 {
     jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
+    hasWrittenData = true;
+
+    if (parallelCompressor != nullptr)
+        return parallelCompressor->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
 
     return helper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
 }
 
+void GZIPCompressorOutputStream::enableParallelCompression (ThreadPool& threadPool, int blockSizeBytes)
+{
+    // This has to be called before you start writing to the stream!
+    jassert (! hasWrittenData);
+
+    if (! hasWrittenData && parallelCompressor == nullptr)
+        parallelCompressor.reset (new ParallelCompressor (threadPool, compressionLevelToUse, windowBitsToUse, blockSizeBytes));
+}
+
 int64 GZIPCompressorOutputStream::getPosition()
 {
     return destStream->getPosition();
@@ -200,6 +461,71 @@ struct GZIPTests  : public UnitTest
                                 original.getData(),
                                 original.getDataSize()) == 0);
         }
+
+        beginTest ("Parallel compression");
+        ThreadPool pool (3);
+
+        const int windowBits[] = { 0, GZIPCompressorOutputStream::windowBitsGZIP, GZIPCompressorOutputStream::windowBitsRaw };
+        const GZIPDecompressorInputStream::Format formats[] = { GZIPDecompressorInputStream::zlibFormat,
+                                                                GZIPDecompressorInputStream::gzipFormat,
+                                                                GZIPDecompressorInputStream::deflateFormat };
+
+        for (int i = 30; --i >= 0;)
+        {
+            auto formatIndex = i % 3;
+            MemoryOutputStream original, compressed, uncompressed, serialCompressed;
+
+            // a mixture of text that repeats across block boundaries, and random noise
+            for (int j = rng.nextInt (400); --j >= 0;)
+            {
+                if (rng.nextBool())
+                    original << String::repeatedString ("block " + String (rng.nextInt (50)) + " ", rng.nextInt (200));
+                else
+                    for (int k = rng.nextInt (500); --k >= 0;)
+                        original.writeByte ((char) rng.nextInt (256));
+            }
+
+            auto level = rng.nextInt (10);
+
+            {
+                GZIPCompressorOutputStream zipper (compressed, level, windowBits[formatIndex]);
+                zipper.enableParallelCompression (pool, 32768);
+
+                for (size_t pos = 0; pos < original.getDataSize();)
+                {
+                    auto num = jmin ((size_t) rng.nextInt (100000), original.getDataSize() - pos);
+                    zipper.write (static_cast<const char*> (original.getData()) + pos, num);
+                    pos += num;
+                }
+            }
+
+            {
+                GZIPCompressorOutputStream zipper (serialCompressed, level, windowBits[formatIndex]);
+                zipper << original;
+            }
+
+            {
+                MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize(), false);
+                GZIPDecompressorInputStream unzipper (&compressedInput, false, formats[formatIndex]);
+
+                uncompressed << unzipper;
+            }
+
+            expect (uncompressed.getDataSize() == original.getDataSize()
+                     && memcmp (uncompressed.getData(), original.getData(), original.getDataSize()) == 0);
+
+            // the checksums are only verified after all the data has been inflated, so compare them directly
+            auto trailerSize = (size_t) (formatIndex == 0 ? 4 : (formatIndex == 1 ? 8 : 0));
+            expect (memcmp (static_cast<const char*> (compressed.getData()) + compressed.getDataSize() - trailerSize,
+                            static_cast<const char*> (serialCompressed.getData()) + serialCompressed.getDataSize() - trailerSize,
+                            trailerSize) == 0);
+
+            if (formatIndex == 0)
+                expect (memcmp (compressed.getData(), serialCompressed.getData(), 2) == 0);
+
+            // priming each block with the previous block's tail should keep the size close to a single stream's
+            expect (compressed.getDataSize() <= serialCompressed.getDataSize() + serialCompressed.getDataSize() / 20 + 64);
+        }
     }
 };
 
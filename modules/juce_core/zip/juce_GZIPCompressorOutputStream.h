@@ -86,6 +86,22 @@ public:
     bool setPosition (int64) override;
     bool write (const void*, size_t) override;
 
+    //==============================================================================
+    /** Makes the stream compress its data in parallel on a ThreadPool.
+
+        The incoming data is split into blocks of the given size, and each block is
+        compressed by a separate job, using the end of the previous block as its
+        dictionary so that very little compression is lost. The compressed blocks are
+        then joined into a single standard deflate stream (with the zlib or gzip
+        header and checksum that the windowBits setting asks for), so the output can
+        be read by GZIPDecompressorInputStream or any other zlib-based tool.
+
+        This must be called before any data has been written. Each block that's
+        in-flight needs its own buffers, so the memory used will be a few times the
+        block size for each of the pool's threads. The pool must outlive this stream.
+    */
+    void enableParallelCompression (ThreadPool& threadPool, int blockSizeBytes = 128 * 1024);
+
     /** These are preset values that can be used for the constructor's windowBits parameter.
         For more info about this, see the zlib documentation for its windowBits parameter.
     */
@@ -101,6 +117,10 @@ private:
 
     class GZIPCompressorHelper;
     std::unique_ptr<GZIPCompressorHelper> helper;
+    class ParallelCompressor;
+    std::unique_ptr<ParallelCompressor> parallelCompressor;
+    int compressionLevelToUse, windowBitsToUse;
+    bool hasWrittenData = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GZIPCompressorOutputStream)
 };
@@ -130,6 +130,23 @@ struct ZipFile::ZipInputStream  : public InputStream
           zipEntryHolder (zei),
           inputStream (zf.inputStream)
     {
+        if (zf.mappedFile != nullptr)
+        {
+            // reading straight from the mapped file needs no lock or extra file handle
+            inputStream = nullptr;
+            mappedData = static_cast<const char*> (zf.mappedFile->getData());
+            mappedSize = (int64) zf.mappedFile->getSize();
+
+            if (zei.streamOffset >= 0 && zei.streamOffset + 30 <= mappedSize
+                 && readUnalignedLittleEndianInt (mappedData + zei.streamOffset) == 0x04034b50)
+            {
+                headerSize = 30 + readUnalignedLittleEndianShort (mappedData + zei.streamOffset + 26)
+                                + readUnalignedLittleEndianShort (mappedData + zei.streamOffset + 28);
+            }
+
+            return;
+        }
+
         if (zf.inputSource != nullptr)
         {
             streamToDelete.reset (file.inputSource->createInputStream());
@@ -143,6 +160,7 @@ struct ZipFile::ZipInputStream  : public InputStream
         }
 
         char buffer[30];
+        const ScopedLock sl (zf.lock);  // (only needed when the source stream is shared)
 
         if (inputStream != nullptr
              && inputStream->setPosition (zei.streamOffset)
@@ -174,6 +192,15 @@ struct ZipFile::ZipInputStream  : public InputStream
 
         howMany = (int) jmin ((int64) howMany, zipEntryHolder.compressedSize - pos);
 
+        if (mappedData != nullptr)
+        {
+            auto start = pos + zipEntryHolder.streamOffset + headerSize;
+            auto num = (int) jlimit ((int64) 0, (int64) howMany, mappedSize - start);
+            memcpy (buffer, mappedData + start, (size_t) num);
+            pos += num;
+            return num;
+        }
+
         if (inputStream == nullptr)
             return 0;
 
@@ -218,6 +245,8 @@ private:
     int headerSize = 0;
     InputStream* inputStream;
     std::unique_ptr<InputStream> streamToDelete;
+    const char* mappedData = nullptr;
+    int64 mappedSize = 0;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipInputStream)
 };
@@ -238,8 +267,17 @@ ZipFile::ZipFile (InputStream& stream)  : inputStream (&stream)
     init();
 }
 
-ZipFile::ZipFile (const File& file)  : inputSource (new FileInputSource (file))
+ZipFile::ZipFile (const File& file)
+    : mappedFile (new MemoryMappedFile (file, MemoryMappedFile::readOnly))
 {
+    // if the file can't be mapped (e.g. it's empty or too big for the address space),
+    // each entry's stream will open the file for itself instead
+    if (mappedFile->getData() == nullptr)
+    {
+        mappedFile.reset();
+        inputSource.reset (new FileInputSource (file));
+    }
+
     init();
 }
 
@@ -341,7 +379,12 @@ void ZipFile::init()
     std::unique_ptr<InputStream> toDelete;
     InputStream* in = inputStream;
 
-    if (inputSource != nullptr)
+    if (mappedFile != nullptr)
+    {
+        in = new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false);
+        toDelete.reset (in);
+    }
+    else if (inputSource != nullptr)
     {
         in = inputSource->createInputStream();
         toDelete.reset (in);
@@ -356,35 +399,55 @@ void ZipFile::init()
         {
             auto size = (size_t) (in->getTotalLength() - centralDirectoryPos);
 
+            if (mappedFile != nullptr)
+            {
+                // the directory can be parsed in-place, without copying it
+                readCentralDirectory (static_cast<const char*> (mappedFile->getData()) + centralDirectoryPos, size, numEntries);
+                return;
+            }
+
             in->setPosition (centralDirectoryPos);
             MemoryBlock headerData;
 
             if (in->readIntoMemoryBlock (headerData, (ssize_t) size) == size)
-            {
-                size_t pos = 0;
+                readCentralDirectory (static_cast<const char*> (headerData.getData()), size, numEntries);
+        }
+    }
+}
 
-                for (int i = 0; i < numEntries; ++i)
-                {
-                    if (pos + 46 > size)
-                        break;
+void ZipFile::readCentralDirectory (const char* headerData, size_t size, int numEntries)
+{
+    entries.ensureStorageAllocated (numEntries);
+    size_t pos = 0;
 
-                    auto* buffer = static_cast<const char*> (headerData.getData()) + pos;
-                    auto fileNameLen = readUnalignedLittleEndianShort (buffer + 28);
+    for (int i = 0; i < numEntries; ++i)
+    {
+        if (pos + 46 > size)
+            break;
 
-                    if (pos + 46 + fileNameLen > size)
-                        break;
+        auto* buffer = headerData + pos;
+        auto fileNameLen = readUnalignedLittleEndianShort (buffer + 28);
 
-                    entries.add (new ZipEntryHolder (buffer, fileNameLen));
+        if (pos + 46 + fileNameLen > size)
+            break;
 
-                    pos += 46 + fileNameLen
-                            + readUnalignedLittleEndianShort (buffer + 30)
-                            + readUnalignedLittleEndianShort (buffer + 32);
-                }
-            }
-        }
+        entries.add (new ZipEntryHolder (buffer, fileNameLen));
+
+        pos += 46 + fileNameLen
+                + readUnalignedLittleEndianShort (buffer + 30)
+                + readUnalignedLittleEndianShort (buffer + 32);
     }
 }
 
+static String getEntryPath (const ZipFile::ZipEntry& entry)
+{
+   #if JUCE_WINDOWS
+    return entry.filename;
+   #else
+    return entry.filename.replaceCharacter ('\\', '/');
+   #endif
+}
+
 Result ZipFile::uncompressTo (const File& targetDirectory,
                               const bool shouldOverwriteFiles)
 {
@@ -399,15 +462,87 @@ Result ZipFile::uncompressTo (const File& targetDirectory,
     return Result::ok();
 }
 
+Result ZipFile::uncompressTo (const File& targetDirectory, bool shouldOverwriteFiles, ThreadPool& threadPool)
+{
+    // Create all the folders first, so that the jobs can't race each other to make the same ones
+    File lastFolderCreated;
+
+    for (auto* zei : entries)
+    {
+        auto entryPath = getEntryPath (zei->entry);
+
+        if (entryPath.isEmpty())
+            continue;
+
+        auto targetFile = targetDirectory.getChildFile (entryPath);
+        auto folder = (entryPath.endsWithChar ('/') || entryPath.endsWithChar ('\\')) ? targetFile
+                                                                                      : targetFile.getParentDirectory();
+        if (folder != lastFolderCreated)
+        {
+            auto result = folder.createDirectory();
+
+            if (result.failed())
+                return result;
+
+            lastFolderCreated = folder;
+        }
+    }
+
+    std::atomic<int> nextIndex { 0 };
+    std::atomic<bool> hasFailed { false };
+    CriticalSection errorLock;
+    auto firstError = Result::ok();
+
+    auto uncompressRemainingEntries = [&]
+    {
+        for (;;)
+        {
+            auto index = nextIndex++;
+
+            if (index >= entries.size() || hasFailed)
+                return;
+
+            auto result = uncompressEntry (index, targetDirectory, shouldOverwriteFiles);
+
+            if (result.failed())
+            {
+                const ScopedLock sl (errorLock);
+
+                if (! hasFailed.exchange (true))
+                    firstError = result;
+            }
+        }
+    };
+
+    struct UncompressJob  : public ThreadPoolJob
+    {
+        UncompressJob (std::function<void()> f)  : ThreadPoolJob ("ZipFile::uncompressTo"), work (f) {}
+        JobStatus runJob() override    { work(); return jobHasFinished; }
+
+        std::function<void()> work;
+    };
+
+    OwnedArray<UncompressJob> jobs;
+
+    for (int i = jmin (threadPool.getNumThreads(), entries.size() - 1); --i >= 0;)
+    {
+        jobs.add (new UncompressJob (uncompressRemainingEntries));
+        threadPool.addJob (jobs.getLast(), false);
+    }
+
+    uncompressRemainingEntries();
+
+    // any jobs that haven't started yet have nothing left to do, so can just be removed
+    for (auto* job : jobs)
+        threadPool.removeJob (job, false, -1);
+
+    return firstError;
+}
+
 Result ZipFile::uncompressEntry (int index, const File& targetDirectory, bool shouldOverwriteFiles)
 {
     auto* zei = entries.getUnchecked (index);
-
-   #if JUCE_WINDOWS
-    auto entryPath = zei->entry.filename;
-   #else
-    auto entryPath = zei->entry.filename.replaceCharacter ('\\', '/');
-   #endif
+    auto entryPath = getEntryPath (zei->entry);
 
     if (entryPath.isEmpty())
         return Result::ok();
@@ -469,9 +604,10 @@ struct ZipFile::Builder::Item
         symbolicLink = (file.exists() && file.isSymbolicLink());
     }
 
-    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    // This doesn't touch the target stream, so can be called on another thread before writeData()
+    bool compress()
     {
-        MemoryOutputStream compressedData ((size_t) file.getSize());
+        compressedData.reset (new MemoryOutputStream ((size_t) file.getSize()));
 
         if (symbolicLink)
         {
@@ -480,29 +616,38 @@ struct ZipFile::Builder::Item
             uncompressedSize = relativePath.length();
 
             checksum = zlibNamespace::crc32 (0, (uint8_t*) relativePath.toRawUTF8(), (unsigned int) uncompressedSize);
-            compressedData << relativePath;
+            *compressedData << relativePath;
         }
         else if (compressionLevel > 0)
         {
-            GZIPCompressorOutputStream compressor (compressedData, compressionLevel,
+            GZIPCompressorOutputStream compressor (*compressedData, compressionLevel,
                                                    GZIPCompressorOutputStream::windowBitsRaw);
             if (! writeSource (compressor))
                 return false;
         }
         else
         {
-            if (! writeSource (compressedData))
+            if (! writeSource (*compressedData))
                 return false;
         }
 
-        compressedSize = (int64) compressedData.getDataSize();
+        compressedSize = (int64) compressedData->getDataSize();
+        return true;
+    }
+
+    bool writeData (OutputStream& target, const int64 overallStartPosition)
+    {
+        if (compressedData == nullptr && ! compress())
+            return false;
+
         headerStart = target.getPosition() - overallStartPosition;
 
         target.writeInt (0x04034b50);
         writeFlagsAndSizes (target);
         target << storedPathname
-               << compressedData;
+               << *compressedData;
 
+        compressedData.reset();
         return true;
     }
 
@@ -524,6 +669,7 @@ struct ZipFile::Builder::Item
 private:
     const File file;
     std::unique_ptr<InputStream> stream;
+    std::unique_ptr<MemoryOutputStream> compressedData;
     String storedPathname;
     Time fileTime;
     int64 compressedSize = 0, uncompressedSize = 0, headerStart = 0;
@@ -615,6 +761,61 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
             return false;
     }
 
+    if (! writeCentralDirectory (target, fileStart))
+        return false;
+
+    if (progress != nullptr)
+        *progress = 1.0;
+
+    return true;
+}
+
+bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress, ThreadPool& threadPool) const
+{
+    struct CompressionJob  : public ThreadPoolJob
+    {
+        CompressionJob (Item& i)  : ThreadPoolJob ("ZipFile::Builder"), item (i) {}
+        JobStatus runJob() override    { succeeded = item.compress(); return jobHasFinished; }
+
+        Item& item;
+        bool succeeded = false;
+    };
+
+    auto fileStart = target.getPosition();
+    auto maxJobsInFlight = jmax (2, threadPool.getNumThreads() * 2);
+    OwnedArray<CompressionJob> jobs;
+    bool succeeded = true;
+
+    for (int i = 0; i < items.size() && succeeded; ++i)
+    {
+        // keep the pool busy with the entries that come after this one
+        while (jobs.size() < items.size() && jobs.size() < i + maxJobsInFlight)
+        {
+            jobs.add (new CompressionJob (*items.getUnchecked (jobs.size())));
+            threadPool.addJob (jobs.getLast(), false);
+        }
+
+        if (progress != nullptr)
+            *progress = (i + 0.5) / items.size();
+
+        threadPool.waitForJobToFinish (jobs.getUnchecked (i), -1);
+        succeeded = jobs.getUnchecked (i)->succeeded && items.getUnchecked (i)->writeData (target, fileStart);
+    }
+
+    for (auto* job : jobs)
+        threadPool.removeJob (job, false, -1);
+
+    if (! succeeded || ! writeCentralDirectory (target, fileStart))
+        return false;
+
+    if (progress != nullptr)
+        *progress = 1.0;
+
+    return true;
+}
+
+bool ZipFile::Builder::writeCentralDirectory (OutputStream& target, int64 fileStart) const
+{
     auto directoryStart = target.getPosition();
 
     for (auto* item : items)
@@ -632,9 +833,6 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
     target.writeInt ((int) (directoryStart - fileStart));
     target.writeShort (0);
 
-    if (progress != nullptr)
-        *progress = 1.0;
-
     return true;
 }
 
@@ -677,6 +875,92 @@ struct ZIPTests   : public UnitTest
             std::unique_ptr<InputStream> input (zip.createStreamForEntry (*entry));
             expectEquals (input->readEntireStreamAsString(), entryName);
         }
+
+        beginTest ("Reading a file");
+        {
+            TemporaryFile zipFile (".zip");
+            auto expected = writeTestArchive (zipFile.getFile(), 200);
+
+            ZipFile mappedZip (zipFile.getFile());
+            expectEquals (mappedZip.getNumEntries(), expected.size());
+
+            for (int i = 0; i < mappedZip.getNumEntries(); ++i)
+            {
+                std::unique_ptr<InputStream> input (mappedZip.createStreamForEntry (i));
+                expect (input != nullptr && input->readEntireStreamAsString() == expected[mappedZip.getEntry (i)->filename]);
+            }
+        }
+
+        beginTest ("Parallel uncompress");
+        {
+            TemporaryFile zipFile (".zip");
+            auto expected = writeTestArchive (zipFile.getFile(), 300);
+
+            auto targetFolder = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("ZipFileTests", {});
+            ThreadPool pool (4);
+
+            {
+                ZipFile mappedZip (zipFile.getFile());
+                expect (mappedZip.uncompressTo (targetFolder, true, pool).wasOk());
+            }
+
+            {
+                FileInputStream in (zipFile.getFile());
+                ZipFile streamZip (in);
+                expect (streamZip.uncompressTo (targetFolder.getChildFile ("fromStream"), true, pool).wasOk());
+            }
+
+            bool allMatch = true;
+
+            for (auto& entryPath : expected.getAllKeys())
+                allMatch = allMatch && targetFolder.getChildFile (entryPath).loadFileAsString() == expected[entryPath]
+                                    && targetFolder.getChildFile ("fromStream").getChildFile (entryPath).loadFileAsString() == expected[entryPath];
+
+            expect (allMatch);
+            targetFolder.deleteRecursively();
+        }
+
+        beginTest ("Parallel builder");
+        {
+            ThreadPool pool (3);
+            TemporaryFile parallelFile (".zip");
+            auto expected = writeTestArchive (parallelFile.getFile(), 100, &pool);
+
+            ZipFile parallelZip (parallelFile.getFile());
+            expectEquals (parallelZip.getNumEntries(), expected.size());
+
+            bool allMatch = true;
+
+            for (int i = 0; i < parallelZip.getNumEntries(); ++i)
+            {
+                std::unique_ptr<InputStream> input (parallelZip.createStreamForEntry (i));
+                allMatch = allMatch && input != nullptr && input->readEntireStreamAsString() == expected[parallelZip.getEntry (i)->filename];
+            }
+
+            expect (allMatch);
+        }
+    }
+
+    StringPairArray writeTestArchive (const File& file, int numEntries, ThreadPool* pool = nullptr)
+    {
+        ZipFile::Builder builder;
+        StringPairArray contents;
+        auto r = getRandom();
+
+        for (int i = 0; i < numEntries; ++i)
+        {
+            auto entryPath = "folder" + String (i % 7) + "/sub" + String (i % 3) + "/entry" + String (i) + ".txt";
+            auto text = String::repeatedString ("entry " + String (i) + " ", r.nextInt (2000));
+
+            contents.set (entryPath, text);
+            builder.addEntry (new MemoryInputStream (text.toRawUTF8(), text.getNumBytesAsUTF8(), true),
+                              i % 3 == 0 ? 0 : 9, entryPath, Time::getCurrentTime());
+        }
+
+        FileOutputStream out (file);
+        expect (pool != nullptr ? builder.writeToStream (out, nullptr, *pool)
+                                : builder.writeToStream (out, nullptr));
+        return contents;
     }
 };
 
@@ -35,7 +35,13 @@ namespace juce
 class JUCE_API  ZipFile
 {
 public:
-    /** Creates a ZipFile to read a specific file. */
+    /** Creates a ZipFile to read a specific file.
+
+        Where possible the file is memory-mapped, so that the streams for its entries
+        read directly from memory and can be used on different threads at the same time
+        without having to share a lock. The file mustn't be changed while this object
+        exists.
+    */
     explicit ZipFile (const File& file);
 
     //==============================================================================
@@ -124,9 +130,9 @@ public:
         has been deleted.
 
         Note that if the ZipFile was created with a user-supplied InputStream object,
-        then all the streams which are created by this method will by trying to share
-        the same source stream, so cannot be safely used on  multiple threads! (But if
-        you create the ZipFile from a File or InputSource, then it is safe to do this).
+        then all the streams which are created by this method will share the same source
+        stream, and each read will have to lock it. If you create the ZipFile from a File
+        or InputSource, the streams are independent and can be read in parallel.
     */
     InputStream* createStreamForEntry (int index);
 
@@ -139,9 +145,9 @@ public:
         has been deleted.
 
         Note that if the ZipFile was created with a user-supplied InputStream object,
-        then all the streams which are created by this method will by trying to share
-        the same source stream, so cannot be safely used on  multiple threads! (But if
-        you create the ZipFile from a File or InputSource, then it is safe to do this).
+        then all the streams which are created by this method will share the same source
+        stream, and each read will have to lock it. If you create the ZipFile from a File
+        or InputSource, the streams are independent and can be read in parallel.
     */
     InputStream* createStreamForEntry (const ZipEntry& entry);
 
@@ -158,6 +164,25 @@ public:
     Result uncompressTo (const File& targetDirectory,
                          bool shouldOverwriteFiles = true);
 
+    /** Uncompresses all of the files in the zip file, using a ThreadPool to expand
+        several entries at once.
+
+        This behaves like the other uncompressTo() method, but the entries are shared
+        out between the pool's threads and the calling thread, which blocks until they've
+        all been written. All the target folders are created before any of the jobs start.
+
+        This works best when the ZipFile was created from a File or an InputSource, because
+        the entries can then be read without sharing a source stream.
+
+        @param targetDirectory      the root folder to uncompress to
+        @param shouldOverwriteFiles whether to overwrite existing files with similarly-named ones
+        @param threadPool           the pool whose threads should do some of the work
+        @returns success if the file is successfully unzipped, or the first error that was hit
+    */
+    Result uncompressTo (const File& targetDirectory,
+                         bool shouldOverwriteFiles,
+                         ThreadPool& threadPool);
+
     /** Uncompresses one of the entries from the zip file.
 
         This will expand the entry and write it in a target directory. The entry's path is used to
@@ -221,11 +246,26 @@ public:
         */
         bool writeToStream (OutputStream& target, double* progress) const;
 
+        /** Generates the zip file, compressing several of its entries at once on a ThreadPool.
+
+            The entries are still written to the stream in order, by the calling thread, but
+            the compression happens in advance on the pool's threads. Each compressed entry is
+            held in memory until it has been written, and the number of entries being worked
+            on is limited to a few times the pool's thread count.
+
+            The streams passed to addEntry() will be read on the pool's threads, so they
+            mustn't depend on each other. If the progress parameter is non-null, it will be
+            updated with an approximate progress status between 0 and 1.0
+        */
+        bool writeToStream (OutputStream& target, double* progress, ThreadPool& threadPool) const;
+
         //==============================================================================
     private:
         struct Item;
         OwnedArray<Item> items;
 
+        bool writeCentralDirectory (OutputStream&, int64 fileStart) const;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
     };
 
@@ -239,6 +279,7 @@ private:
     InputStream* inputStream = nullptr;
     std::unique_ptr<InputStream> streamToDelete;
     std::unique_ptr<InputSource> inputSource;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
@@ -246,13 +287,14 @@ private:
         OpenStreamCounter() = default;
         ~OpenStreamCounter();
 
-        int numOpenStreams = 0;
+        std::atomic<int> numOpenStreams { 0 };
     };
 
     OpenStreamCounter streamCounter;
    #endif
 
     void init();
+    void readCentralDirectory (const char* data, size_t size, int numEntries);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZipFile)
 };
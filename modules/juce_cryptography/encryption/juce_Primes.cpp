@@ -47,6 +47,16 @@ namespace PrimesHelpers
         while (n <= (numBits >> 1));
     }
 
+    static uint32 remainderOf (const BigInteger& value, const uint32 divisor) noexcept
+    {
+        uint64 remainder = 0;
+
+        for (int bit = value.getHighestBit() & ~31; bit >= 0; bit -= 32)
+            remainder = ((remainder << 32) | value.getBitRangeAsInt (bit, 32)) % divisor;
+
+        return (uint32) remainder;
+    }
+
     static void bigSieve (const BigInteger& base, const int numBits, BigInteger& result,
                           const BigInteger& smallSieve, const int smallSieveSize)
     {
@@ -61,12 +71,9 @@ namespace PrimesHelpers
         {
             const unsigned int prime = ((unsigned int) index << 1) + 1;
 
-            BigInteger r (base), remainder;
-            r.divideBy (prime, remainder);
-
-            unsigned int i = prime - remainder.getBitRangeAsInt (0, 32);
+            unsigned int i = prime - remainderOf (base, prime);
 
-            if (r.isZero())
+            if (base.getHighestBit() < 32 && base.getBitRangeAsInt (0, 32) < prime)
                 i += prime;
 
             if ((i & 1) == 0)
@@ -85,26 +92,68 @@ namespace PrimesHelpers
         while (index < smallSieveSize);
     }
 
+    struct CandidateTestingThread  : public Thread
+    {
+        CandidateTestingThread (const std::function<void()>& f)  : Thread ("Prime candidate testing"), fn (f) {}
+        void run() override    { fn(); }
+
+        std::function<void()> fn;
+    };
+
     static bool findCandidate (const BigInteger& base, const BigInteger& sieve,
                                const int numBits, BigInteger& result, const int certainty)
     {
+        Array<int> candidates;
+
         for (int i = 0; i < numBits; ++i)
-        {
             if (! sieve[i])
+                candidates.add (i);
+
+        // The candidates are tested on several threads, but they're handed out in order and
+        // the lowest prime always wins, so the same seeds will still produce the same prime
+        std::atomic<int> nextCandidate { 0 }, lowestPrimeFound { candidates.size() };
+
+        auto testCandidates = [&]
+        {
+            for (;;)
             {
-                result = base + (unsigned int) ((i << 1) + 1);
+                auto index = nextCandidate++;
 
-                if (Primes::isProbablyPrime (result, certainty))
-                    return true;
+                if (index >= lowestPrimeFound.load())
+                    return;
+
+                if (Primes::isProbablyPrime (base + (unsigned int) ((candidates.getUnchecked (index) << 1) + 1), certainty))
+                {
+                    auto lowest = lowestPrimeFound.load();
+
+                    while (index < lowest && ! lowestPrimeFound.compare_exchange_weak (lowest, index))
+                    {}
+
+                    return; // any later candidates that this thread picked up would be higher
+                }
             }
-        }
+        };
 
-        return false;
+        OwnedArray<CandidateTestingThread> threads;
+
+        for (int i = jmin (SystemStats::getNumCpus(), 8); --i > 0;)
+            threads.add (new CandidateTestingThread (testCandidates))->startThread();
+
+        testCandidates();
+
+        for (auto* t : threads)
+            t->waitForThreadToExit (-1);
+
+        if (lowestPrimeFound.load() >= candidates.size())
+            return false;
+
+        result = base + (unsigned int) ((candidates.getUnchecked (lowestPrimeFound.load()) << 1) + 1);
+        return true;
     }
 
     static bool passesMillerRabin (const BigInteger& n, int iterations)
     {
-        const BigInteger one (1), two (2);
+        const BigInteger one (1);
         const BigInteger nMinusOne (n - one);
 
         BigInteger d (nMinusOne);
@@ -138,7 +187,8 @@ namespace PrimesHelpers
             {
                 for (int j = 0; j < s; ++j)
                 {
-                    r.exponentModulo (two, n);
+                    r *= r;
+                    r %= n;
 
                     if (r == nMinusOne)
                         break;
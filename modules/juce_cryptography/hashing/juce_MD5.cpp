@@ -249,6 +249,14 @@ MD5::MD5 (InputStream& input, int64 numBytesToRead)
 
 MD5::MD5 (const File& file)
 {
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+    {
+        processData (mappedFile.getData(), mappedFile.getSize());
+        return;
+    }
+
     FileInputStream fin (file);
 
     if (fin.getStatus().wasOk())
@@ -259,6 +267,33 @@ MD5::MD5 (const File& file)
 
 MD5::~MD5() noexcept {}
 
+Array<MD5> MD5::hashFiles (const Array<File>& files, ThreadPool& pool)
+{
+    Array<MD5> checksums;
+    checksums.insertMultiple (0, MD5(), files.size());
+
+    if (files.isEmpty())
+        return checksums;
+
+    // the event is shared so that the last job can still be signalling it after this returns
+    std::atomic<int> numRemaining { files.size() };
+    auto finished = std::make_shared<WaitableEvent>();
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        pool.addJob ([&checksums, &files, &numRemaining, finished, i]
+        {
+            checksums.getReference (i) = MD5 (files.getReference (i));
+
+            if (--numRemaining == 0)
+                finished->signal();
+        });
+    }
+
+    finished->wait();
+    return checksums;
+}
+
 void MD5::processData (const void* data, size_t numBytes) noexcept
 {
     MD5Generator generator;
@@ -273,16 +308,18 @@ void MD5::processStream (InputStream& input, int64 numBytesToRead)
     if (numBytesToRead < 0)
         numBytesToRead = std::numeric_limits<int64>::max();
 
+    const int bufferSize = 65536;
+    HeapBlock<uint8> buffer (bufferSize);
+
     while (numBytesToRead > 0)
     {
-        uint8 tempBuffer [512];
-        auto bytesRead = input.read (tempBuffer, (int) jmin (numBytesToRead, (int64) sizeof (tempBuffer)));
+        auto bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64) bufferSize));
 
         if (bytesRead <= 0)
             break;
 
         numBytesToRead -= bytesRead;
-        generator.processBlock (tempBuffer, (size_t) bytesRead);
+        generator.processBlock (buffer, (size_t) bytesRead);
     }
 
     generator.finish (result);
@@ -333,6 +370,38 @@ public:
         test ("", "d41d8cd98f00b204e9800998ecf8427e");
         test ("The quick brown fox jumps over the lazy dog",  "9e107d9d372bb6826bd81d3542a419d6");
         test ("The quick brown fox jumps over the lazy dog.", "e4d909c290d0fb1ca068ffaddf22cbd0");
+
+        beginTest ("Files");
+
+        MemoryBlock data;
+        data.setSize (1000000);
+        data.fillWith ((uint8) 'a');
+
+        expectEquals (MD5 (data).toHexString(), String ("7707d6ae4e027c70eea2a935c2296f21"));
+
+        auto random = getRandom();
+        Array<File> files;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            files.add (File::createTempFile (".md5"));
+            files.getReference (i).appendData (data.getData(), (size_t) random.nextInt (100000));
+        }
+
+        ThreadPool pool (3);
+        auto checksums = MD5::hashFiles (files, pool);
+
+        expectEquals (checksums.size(), files.size());
+
+        for (int i = 0; i < files.size(); ++i)
+        {
+            auto size = (size_t) files.getReference (i).getSize();
+            expect (checksums.getReference (i) == MD5 (data.getData(), size));
+
+            FileInputStream fin (files.getReference (i));
+            expect (checksums.getReference (i) == MD5 (fin));
+            files.getReference (i).deleteFile();
+        }
     }
 };
 
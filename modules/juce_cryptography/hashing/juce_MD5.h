@@ -67,7 +67,9 @@ public:
     */
     MD5 (InputStream& input, int64 numBytesToRead = -1);
 
-    /** Creates a checksum for the contents of a file. */
+    /** Creates a checksum for the contents of a file.
+        The file is memory-mapped where possible, otherwise it's read as a stream.
+    */
     explicit MD5 (const File&);
 
     /** Creates a checksum of the characters in a UTF-8 buffer.
@@ -99,6 +101,17 @@ public:
     */
     static MD5 fromUTF32 (StringRef);
 
+    /** Creates checksums for a set of files, using a ThreadPool to process several
+        of them at once.
+
+        This blocks until all the files have been processed, and returns the results
+        in the same order as the files.
+
+        Don't call this from one of the pool's own threads, as it would have to wait
+        for a job which might never be able to start.
+    */
+    static Array<MD5> hashFiles (const Array<File>& files, ThreadPool& pool);
+
     //==============================================================================
     bool operator== (const MD5&) const noexcept;
     bool operator!= (const MD5&) const noexcept;
@@ -43,45 +43,27 @@ public:
         state[7] = 0x5be0cd19;
     }
 
-    // expects 64 bytes of data
-    void processFullBlock (const void* const data) noexcept
+    // expects numBlocks * 64 bytes of data
+    void processFullBlocks (const void* const data, size_t numBlocks) noexcept
     {
-        const uint32 constants[] =
-        {
-            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-        };
-
-        uint32 block[16], s[8];
-        memcpy (s, state, sizeof (s));
+        length += 64 * (uint64) numBlocks;
 
-        for (int i = 0; i < 16; ++i)
-            block[i] = ByteOrder::bigEndianInt (addBytesToPointer (data, i * 4));
+       #if JUCE_USE_SHA_INTRINSICS
+        static const bool canUseSHAExtensions = SystemStats::hasSHA() && SystemStats::hasSSE41();
 
-        for (uint32 j = 0; j < 64; j += 16)
+        if (canUseSHAExtensions)
         {
-            #define JUCE_SHA256(i) \
-                s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j] \
-                                     + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15])) \
-                                               : block[i]); \
-                s[(3 - i) & 7] += s[(7 - i) & 7]; \
-                s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7])
-
-            JUCE_SHA256(0);  JUCE_SHA256(1);  JUCE_SHA256(2);  JUCE_SHA256(3);  JUCE_SHA256(4);  JUCE_SHA256(5);  JUCE_SHA256(6);  JUCE_SHA256(7);
-            JUCE_SHA256(8);  JUCE_SHA256(9);  JUCE_SHA256(10); JUCE_SHA256(11); JUCE_SHA256(12); JUCE_SHA256(13); JUCE_SHA256(14); JUCE_SHA256(15);
-            #undef JUCE_SHA256
+            processBlocksWithSHAExtensions (state, static_cast<const uint8*> (data), numBlocks);
+            return;
         }
-
-        for (int i = 0; i < 8; ++i)
-            state[i] += s[i];
-
-        length += 64;
+       #endif
+
+       #if JUCE_USE_ARM_SHA_INTRINSICS
+        processBlocksWithARMCryptoExtensions (state, static_cast<const uint8*> (data), numBlocks);
+       #else
+        for (size_t i = 0; i < numBlocks; ++i)
+            processBlock (addBytesToPointer (data, i * 64));
+       #endif
     }
 
     void processFinalBlock (const void* const data, unsigned int numBytes) noexcept
@@ -89,7 +71,7 @@ public:
         jassert (numBytes < 64);
 
         length += numBytes;
-        length *= 8; // (the length is stored as a count of bits, not bytes)
+        auto lengthInBits = length * 8;
 
         uint8 finalBlocks[128];
 
@@ -100,14 +82,11 @@ public:
             finalBlocks [numBytes++] = 0; // pad with zeros..
 
         for (int i = 8; --i >= 0;)
-            finalBlocks [numBytes++] = (uint8) (length >> (i * 8)); // append the length.
+            finalBlocks [numBytes++] = (uint8) (lengthInBits >> (i * 8)); // append the length.
 
         jassert (numBytes == 64 || numBytes == 128);
 
-        processFullBlock (finalBlocks);
-
-        if (numBytes > 64)
-            processFullBlock (finalBlocks + 64);
+        processFullBlocks (finalBlocks, numBytes / 64);
     }
 
     void copyResult (uint8* result) const noexcept
@@ -121,24 +100,41 @@ public:
         }
     }
 
+    void processData (const void* data, size_t numBytes, uint8* const result) noexcept
+    {
+        auto numBlocks = numBytes / 64;
+        processFullBlocks (data, numBlocks);
+        processFinalBlock (addBytesToPointer (data, numBlocks * 64), (unsigned int) (numBytes % 64));
+        copyResult (result);
+    }
+
     void processStream (InputStream& input, int64 numBytesToRead, uint8* const result)
     {
         if (numBytesToRead < 0)
             numBytesToRead = std::numeric_limits<int64>::max();
 
+        const int bufferSize = 65536;
+        HeapBlock<uint8> buffer (bufferSize);
+        int numBuffered = 0;
+
         for (;;)
         {
-            uint8 buffer [64];
-            const int bytesRead = input.read (buffer, (int) jmin (numBytesToRead, (int64) sizeof (buffer)));
+            auto numToRead = (int) jmin (numBytesToRead, (int64) (bufferSize - numBuffered));
+            auto bytesRead = jmax (0, input.read (buffer + numBuffered, numToRead));
+            numBytesToRead -= bytesRead;
+            numBuffered += bytesRead;
 
-            if (bytesRead < (int) sizeof (buffer))
+            auto numBlocks = numBuffered / 64;
+            processFullBlocks (buffer, (size_t) numBlocks);
+            numBuffered -= numBlocks * 64;
+
+            if (bytesRead < numToRead || numBytesToRead == 0)
             {
-                processFinalBlock (buffer, (unsigned int) bytesRead);
+                processFinalBlock (buffer + numBlocks * 64, (unsigned int) numBuffered);
                 break;
             }
 
-            numBytesToRead -= sizeof (buffer);
-            processFullBlock (buffer);
+            memmove (buffer, buffer + numBlocks * 64, (size_t) numBuffered);
         }
 
         copyResult (result);
@@ -148,6 +144,150 @@ private:
     uint32 state[8];
     uint64 length;
 
+    static const uint32* getRoundConstants() noexcept
+    {
+        static const uint32 constants[] =
+        {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+
+        return constants;
+    }
+
+    // expects 64 bytes of data
+    void processBlock (const void* const data) noexcept
+    {
+        auto constants = getRoundConstants();
+        uint32 block[16], s[8];
+        memcpy (s, state, sizeof (s));
+
+        for (int i = 0; i < 16; ++i)
+            block[i] = ByteOrder::bigEndianInt (addBytesToPointer (data, i * 4));
+
+        for (uint32 j = 0; j < 64; j += 16)
+        {
+            #define JUCE_SHA256(i) \
+                s[(7 - i) & 7] += S1 (s[(4 - i) & 7]) + ch (s[(4 - i) & 7], s[(5 - i) & 7], s[(6 - i) & 7]) + constants[i + j] \
+                                     + (j != 0 ? (block[i & 15] += s1 (block[(i - 2) & 15]) + block[(i - 7) & 15] + s0 (block[(i - 15) & 15])) \
+                                               : block[i]); \
+                s[(3 - i) & 7] += s[(7 - i) & 7]; \
+                s[(7 - i) & 7] += S0 (s[(0 - i) & 7]) + maj (s[(0 - i) & 7], s[(1 - i) & 7], s[(2 - i) & 7])
+
+            JUCE_SHA256(0);  JUCE_SHA256(1);  JUCE_SHA256(2);  JUCE_SHA256(3);  JUCE_SHA256(4);  JUCE_SHA256(5);  JUCE_SHA256(6);  JUCE_SHA256(7);
+            JUCE_SHA256(8);  JUCE_SHA256(9);  JUCE_SHA256(10); JUCE_SHA256(11); JUCE_SHA256(12); JUCE_SHA256(13); JUCE_SHA256(14); JUCE_SHA256(15);
+            #undef JUCE_SHA256
+        }
+
+        for (int i = 0; i < 8; ++i)
+            state[i] += s[i];
+    }
+
+   #if JUCE_USE_SHA_INTRINSICS
+    /*  This is compiled for the SHA extensions regardless of the compiler's target flags,
+        and is only called once SystemStats has confirmed that the CPU supports them.
+    */
+    #if JUCE_MSVC
+     #define JUCE_SHA_TARGET
+    #else
+     #define JUCE_SHA_TARGET __attribute__ ((target ("sha,sse4.1")))
+    #endif
+
+    static JUCE_SHA_TARGET void processBlocksWithSHAExtensions (uint32* hashState, const uint8* data, size_t numBlocks) noexcept
+    {
+        auto constants = getRoundConstants();
+        auto byteSwapMask = _mm_set_epi64x (0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        // the instructions want the state arranged as ABEF and CDGH
+        auto tmp    = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) hashState), 0xb1);
+        auto state1 = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i*) (hashState + 4)), 0x1b);
+        auto state0 = _mm_alignr_epi8 (tmp, state1, 8);
+        state1 = _mm_blend_epi16 (state1, tmp, 0xf0);
+
+        for (; numBlocks > 0; --numBlocks, data += 64)
+        {
+            auto oldState0 = state0, oldState1 = state1;
+            __m128i words[4], message;
+
+            for (int i = 0; i < 4; ++i)
+                words[i] = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i*) (data + 16 * i)), byteSwapMask);
+
+            // each of these does four rounds, and updates the message schedule as it goes
+            #define JUCE_SHA256_ROUNDS(i) \
+                message = _mm_add_epi32 (words[i & 3], _mm_loadu_si128 ((const __m128i*) (constants + 4 * i))); \
+                state1 = _mm_sha256rnds2_epu32 (state1, state0, message); \
+                if (i >= 3 && i < 15) \
+                    words[(i + 1) & 3] = _mm_sha256msg2_epu32 (_mm_add_epi32 (words[(i + 1) & 3], _mm_alignr_epi8 (words[i & 3], words[(i + 3) & 3], 4)), words[i & 3]); \
+                state0 = _mm_sha256rnds2_epu32 (state0, state1, _mm_shuffle_epi32 (message, 0x0e)); \
+                if (i >= 1 && i < 13) \
+                    words[(i + 3) & 3] = _mm_sha256msg1_epu32 (words[(i + 3) & 3], words[i & 3])
+
+            JUCE_SHA256_ROUNDS(0);  JUCE_SHA256_ROUNDS(1);  JUCE_SHA256_ROUNDS(2);  JUCE_SHA256_ROUNDS(3);
+            JUCE_SHA256_ROUNDS(4);  JUCE_SHA256_ROUNDS(5);  JUCE_SHA256_ROUNDS(6);  JUCE_SHA256_ROUNDS(7);
+            JUCE_SHA256_ROUNDS(8);  JUCE_SHA256_ROUNDS(9);  JUCE_SHA256_ROUNDS(10); JUCE_SHA256_ROUNDS(11);
+            JUCE_SHA256_ROUNDS(12); JUCE_SHA256_ROUNDS(13); JUCE_SHA256_ROUNDS(14); JUCE_SHA256_ROUNDS(15);
+            #undef JUCE_SHA256_ROUNDS
+
+            state0 = _mm_add_epi32 (state0, oldState0);
+            state1 = _mm_add_epi32 (state1, oldState1);
+        }
+
+        tmp    = _mm_shuffle_epi32 (state0, 0x1b);
+        state1 = _mm_shuffle_epi32 (state1, 0xb1);
+        _mm_storeu_si128 ((__m128i*) hashState,       _mm_blend_epi16 (tmp, state1, 0xf0));
+        _mm_storeu_si128 ((__m128i*) (hashState + 4), _mm_alignr_epi8 (state1, tmp, 8));
+    }
+
+    #undef JUCE_SHA_TARGET
+   #endif
+
+   #if JUCE_USE_ARM_SHA_INTRINSICS
+    static void processBlocksWithARMCryptoExtensions (uint32* hashState, const uint8* data, size_t numBlocks) noexcept
+    {
+        auto constants = getRoundConstants();
+        auto state0 = vld1q_u32 (hashState);
+        auto state1 = vld1q_u32 (hashState + 4);
+
+        for (; numBlocks > 0; --numBlocks, data += 64)
+        {
+            auto oldState0 = state0, oldState1 = state1;
+            uint32x4_t words[4], message, previousState0;
+
+            for (int i = 0; i < 4; ++i)
+                words[i] = vreinterpretq_u32_u8 (vrev32q_u8 (vld1q_u8 (data + 16 * i)));
+
+            // each of these does four rounds, and updates the message schedule as it goes
+            #define JUCE_SHA256_ROUNDS(i) \
+                message = vaddq_u32 (words[i & 3], vld1q_u32 (constants + 4 * i)); \
+                if (i < 12) \
+                    words[i & 3] = vsha256su0q_u32 (words[i & 3], words[(i + 1) & 3]); \
+                previousState0 = state0; \
+                state0 = vsha256hq_u32 (state0, state1, message); \
+                state1 = vsha256h2q_u32 (state1, previousState0, message); \
+                if (i < 12) \
+                    words[i & 3] = vsha256su1q_u32 (words[i & 3], words[(i + 2) & 3], words[(i + 3) & 3])
+
+            JUCE_SHA256_ROUNDS(0);  JUCE_SHA256_ROUNDS(1);  JUCE_SHA256_ROUNDS(2);  JUCE_SHA256_ROUNDS(3);
+            JUCE_SHA256_ROUNDS(4);  JUCE_SHA256_ROUNDS(5);  JUCE_SHA256_ROUNDS(6);  JUCE_SHA256_ROUNDS(7);
+            JUCE_SHA256_ROUNDS(8);  JUCE_SHA256_ROUNDS(9);  JUCE_SHA256_ROUNDS(10); JUCE_SHA256_ROUNDS(11);
+            JUCE_SHA256_ROUNDS(12); JUCE_SHA256_ROUNDS(13); JUCE_SHA256_ROUNDS(14); JUCE_SHA256_ROUNDS(15);
+            #undef JUCE_SHA256_ROUNDS
+
+            state0 = vaddq_u32 (state0, oldState0);
+            state1 = vaddq_u32 (state1, oldState1);
+        }
+
+        vst1q_u32 (hashState, state0);
+        vst1q_u32 (hashState + 4, state1);
+    }
+   #endif
+
     static inline uint32 rotate (const uint32 x, const uint32 y) noexcept                { return (x >> y) | (x << (32 - y)); }
     static inline uint32 ch  (const uint32 x, const uint32 y, const uint32 z) noexcept   { return z ^ ((y ^ z) & x); }
     static inline uint32 maj (const uint32 x, const uint32 y, const uint32 z) noexcept   { return y ^ ((y ^ z) & (x ^ y)); }
@@ -197,6 +337,14 @@ SHA256::SHA256 (InputStream& input, const int64 numBytesToRead)
 
 SHA256::SHA256 (const File& file)
 {
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+    {
+        process (mappedFile.getData(), mappedFile.getSize());
+        return;
+    }
+
     FileInputStream fin (file);
 
     if (fin.getStatus().wasOk())
@@ -216,11 +364,37 @@ SHA256::SHA256 (CharPointer_UTF8 utf8) noexcept
     process (utf8.getAddress(), utf8.sizeInBytes() - 1);
 }
 
+Array<SHA256> SHA256::hashFiles (const Array<File>& files, ThreadPool& pool)
+{
+    Array<SHA256> hashes;
+    hashes.insertMultiple (0, SHA256(), files.size());
+
+    if (files.isEmpty())
+        return hashes;
+
+    // the event is shared so that the last job can still be signalling it after this returns
+    std::atomic<int> numRemaining { files.size() };
+    auto finished = std::make_shared<WaitableEvent>();
+
+    for (int i = 0; i < files.size(); ++i)
+    {
+        pool.addJob ([&hashes, &files, &numRemaining, finished, i]
+        {
+            hashes.getReference (i) = SHA256 (files.getReference (i));
+
+            if (--numRemaining == 0)
+                finished->signal();
+        });
+    }
+
+    finished->wait();
+    return hashes;
+}
+
 void SHA256::process (const void* const data, size_t numBytes)
 {
-    MemoryInputStream m (data, numBytes, false);
     SHA256Processor processor;
-    processor.processStream (m, -1, result);
+    processor.processData (data, numBytes, result);
 }
 
 MemoryBlock SHA256::getRawData() const
@@ -272,6 +446,55 @@ public:
         test ("", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
         test ("The quick brown fox jumps over the lazy dog",  "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
         test ("The quick brown fox jumps over the lazy dog.", "ef537f25c895bfa782526529a9b63d97aa631564d5d789c2b765448c8635fb6c");
+
+        beginTest ("Long inputs");
+
+        MemoryBlock data;
+        data.setSize (1000000);
+        data.fillWith ((uint8) 'a');
+
+        expectEquals (SHA256 (data).toHexString(), String ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+
+        {
+            MemoryInputStream m (data, false);
+            expectEquals (SHA256 (m).toHexString(), String ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+        }
+
+        {
+            MemoryInputStream m (data, false);
+            expect (SHA256 (m, 200000) == SHA256 (data.getData(), 200000));
+        }
+
+        beginTest ("Files");
+
+        auto random = getRandom();
+        Array<File> files;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            files.add (File::createTempFile (".sha256"));
+            files.getReference (i).appendData (data.getData(), (size_t) random.nextInt (100000));
+        }
+
+        files.add (File::createTempFile (".sha256")); // (doesn't exist)
+
+        ThreadPool pool (3);
+        auto hashes = SHA256::hashFiles (files, pool);
+
+        expectEquals (hashes.size(), files.size());
+
+        for (int i = 0; i < files.size(); ++i)
+        {
+            auto size = (size_t) files.getReference (i).getSize();
+
+            if (i < 8)
+                expect (hashes.getReference (i) == SHA256 (data.getData(), size));
+
+            expect (hashes.getReference (i) == SHA256 (files.getReference (i)));
+            files.getReference (i).deleteFile();
+        }
+
+        expect (hashes.getLast() == SHA256());
     }
 };
 
@@ -74,6 +74,7 @@ public:
     SHA256 (InputStream& input, int64 maxBytesToRead = -1);
 
     /** Reads a file and generates the hash of its contents.
+        The file is memory-mapped where possible, otherwise it's read as a stream.
         If the file can't be opened, the hash will be left uninitialised (i.e. full
         of zeros).
     */
@@ -86,6 +87,19 @@ public:
     */
     explicit SHA256 (CharPointer_UTF8 utf8Text) noexcept;
 
+    //==============================================================================
+    /** Generates the hashes of a set of files, using a ThreadPool to hash several
+        of them at once.
+
+        This blocks until all the files have been hashed, and returns the results in
+        the same order as the files. Any files that couldn't be opened will produce
+        a hash full of zeros, as with the File constructor.
+
+        Don't call this from one of the pool's own threads, as it would have to wait
+        for a job which might never be able to start.
+    */
+    static Array<SHA256> hashFiles (const Array<File>& files, ThreadPool& pool);
+
     //==============================================================================
     /** Returns the hash as a 32-byte block of data. */
     MemoryBlock getRawData() const;
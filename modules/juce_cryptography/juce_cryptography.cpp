@@ -35,6 +35,32 @@
 
 #include "juce_cryptography.h"
 
+// the SHA extension version of SHA256 is selected at runtime
+#if JUCE_INTEL && (JUCE_MSVC || JUCE_CLANG || (JUCE_GCC && __GNUC__ >= 5))
+ #ifndef JUCE_USE_SHA_INTRINSICS
+  #define JUCE_USE_SHA_INTRINSICS 1
+ #endif
+#else
+ #undef JUCE_USE_SHA_INTRINSICS
+#endif
+
+#if JUCE_USE_SHA_INTRINSICS
+ #include <immintrin.h>
+#endif
+
+// the ARMv8 crypto extensions are only used when the compiler is targeting them
+#if JUCE_ARM && JUCE_64BIT && (defined (__ARM_FEATURE_SHA2) || defined (__ARM_FEATURE_CRYPTO))
+ #ifndef JUCE_USE_ARM_SHA_INTRINSICS
+  #define JUCE_USE_ARM_SHA_INTRINSICS 1
+ #endif
+#else
+ #undef JUCE_USE_ARM_SHA_INTRINSICS
+#endif
+
+#if JUCE_USE_ARM_SHA_INTRINSICS
+ #include <arm_neon.h>
+#endif
+
 #include "encryption/juce_BlowFish.cpp"
 #include "encryption/juce_Primes.cpp"
 #include "encryption/juce_RSAKey.cpp"
@@ -44,6 +44,7 @@ PropertiesFile::Options::Options()
       ignoreCaseOfKeyNames (false),
       doNotSave (false),
       millisecondsBeforeSaving (3000),
+      writeInBackground (false),
       storageFormat (PropertiesFile::storeAsXML),
       processLock (nullptr)
 {
@@ -112,6 +113,89 @@ File PropertiesFile::Options::getDefaultFile() const
 }
 
 
+//==============================================================================
+struct PropertiesFile::BackgroundWriter  : private TimeSliceClient
+{
+    struct WriterThread  : public TimeSliceThread
+    {
+        WriterThread() : TimeSliceThread ("PropertiesFile writer")   { startThread (3); }
+    };
+
+    BackgroundWriter (PropertiesFile& p)  : owner (p)
+    {
+        thread->addTimeSliceClient (this, idleInterval);
+    }
+
+    ~BackgroundWriter()
+    {
+        thread->removeTimeSliceClient (this);
+    }
+
+    void write (const StringPairArray& values)
+    {
+        {
+            const ScopedLock sl (pendingLock);
+
+            // any older copy that's still waiting gets replaced by this one
+            pending.reset (new StringPairArray (values));
+        }
+
+        thread->moveToFrontOfQueue (this);
+    }
+
+    // Writes anything that's still queued on the calling thread
+    void flush()
+    {
+        if (! writePending())
+            owner.setNeedsToBeSaved (true);
+    }
+
+    // Returns true if a copy that hadn't been written yet was dropped
+    bool cancel()
+    {
+        const ScopedLock wl (writeLock);
+        const ScopedLock sl (pendingLock);
+        auto hadPending = (pending != nullptr);
+        pending.reset();
+        return hadPending;
+    }
+
+private:
+    // A wake-up from write() can arrive just after useTimeSlice() has decided it's idle, so
+    // this also bounds how long a copy can sit in the queue
+    enum { idleInterval = 500 };
+
+    PropertiesFile& owner;
+    SharedResourcePointer<WriterThread> thread;
+    CriticalSection pendingLock, writeLock;
+    std::unique_ptr<StringPairArray> pending;
+
+    // Returns false if something failed to be written. The writeLock is held for the whole
+    // write, so that cancel() can't return while an older copy is still being written.
+    bool writePending()
+    {
+        const ScopedLock wl (writeLock);
+        std::unique_ptr<StringPairArray> values;
+
+        {
+            const ScopedLock sl (pendingLock);
+            std::swap (values, pending);
+        }
+
+        return values == nullptr || owner.writeValues (*values);
+    }
+
+    int useTimeSlice() override
+    {
+        flush();
+
+        const ScopedLock sl (pendingLock);
+        return pending != nullptr ? 0 : idleInterval;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (BackgroundWriter)
+};
+
 //==============================================================================
 PropertiesFile::PropertiesFile (const File& f, const Options& o)
     : PropertySet (o.ignoreCaseOfKeyNames),
@@ -140,6 +224,8 @@ bool PropertiesFile::reload()
 
 PropertiesFile::~PropertiesFile()
 {
+    waitForBackgroundSave();
+    backgroundWriter.reset();
     saveIfNeeded();
 }
 
@@ -172,16 +258,50 @@ bool PropertiesFile::save()
 
     stopTimer();
 
-    if (options.doNotSave
-         || file == File()
+    // the values being written now are newer than anything still queued for the background thread
+    if (backgroundWriter != nullptr)
+        backgroundWriter->cancel();
+
+    if (options.doNotSave || ! writeValues (getAllProperties()))
+        return false;
+
+    needsWriting = false;
+    return true;
+}
+
+void PropertiesFile::saveIfNeededInBackground()
+{
+    const ScopedLock sl (getLock());
+
+    stopTimer();
+
+    if (options.doNotSave || ! needsWriting)
+        return;
+
+    if (backgroundWriter == nullptr)
+        backgroundWriter.reset (new BackgroundWriter (*this));
+
+    needsWriting = false;
+    backgroundWriter->write (getAllProperties());
+}
+
+void PropertiesFile::waitForBackgroundSave()
+{
+    if (backgroundWriter != nullptr)
+        backgroundWriter->flush();
+}
+
+bool PropertiesFile::writeValues (const StringPairArray& values) const
+{
+    if (file == File()
          || file.isDirectory()
          || ! file.getParentDirectory().createDirectory())
         return false;
 
     if (options.storageFormat == storeAsXML)
-        return saveAsXml();
+        return saveAsXml (values);
 
-    return saveAsBinary();
+    return saveAsBinary (values);
 }
 
 bool PropertiesFile::loadAsXml()
@@ -218,10 +338,9 @@ bool PropertiesFile::loadAsXml()
     return false;
 }
 
-bool PropertiesFile::saveAsXml()
+bool PropertiesFile::saveAsXml (const StringPairArray& props) const
 {
     XmlElement doc (PropertyFileConstants::fileTag);
-    auto& props = getAllProperties();
 
     for (int i = 0; i < props.size(); ++i)
     {
@@ -240,13 +359,7 @@ bool PropertiesFile::saveAsXml()
     if (pl != nullptr && ! pl->isLocked())
         return false; // locking failure..
 
-    if (doc.writeToFile (file, {}))
-    {
-        needsWriting = false;
-        return true;
-    }
-
-    return false;
+    return doc.writeToFile (file, {});
 }
 
 bool PropertiesFile::loadAsBinary()
@@ -290,7 +403,7 @@ bool PropertiesFile::loadAsBinary (InputStream& input)
     return true;
 }
 
-bool PropertiesFile::saveAsBinary()
+bool PropertiesFile::saveAsBinary (const StringPairArray& props) const
 {
     ProcessScopedLock pl (createProcessLock());
 
@@ -312,7 +425,7 @@ bool PropertiesFile::saveAsBinary()
 
             GZIPCompressorOutputStream zipped (out, 9);
 
-            if (! writeToStream (zipped))
+            if (! writeToStream (zipped, props))
                 return false;
         }
         else
@@ -322,21 +435,16 @@ bool PropertiesFile::saveAsBinary()
 
             out.writeInt (PropertyFileConstants::magicNumber);
 
-            if (! writeToStream (out))
+            if (! writeToStream (out, props))
                 return false;
         }
     }
 
-    if (! tempFile.overwriteTargetFileWithTemporary())
-        return false;
-
-    needsWriting = false;
-    return true;
+    return tempFile.overwriteTargetFileWithTemporary();
 }
 
-bool PropertiesFile::writeToStream (OutputStream& out)
+bool PropertiesFile::writeToStream (OutputStream& out, const StringPairArray& props)
 {
-    auto& props  = getAllProperties();
     auto& keys   = props.getAllKeys();
     auto& values = props.getAllValues();
     auto numProperties = props.size();
@@ -355,7 +463,10 @@ bool PropertiesFile::writeToStream (OutputStream& out)
 
 void PropertiesFile::timerCallback()
 {
-    saveIfNeeded();
+    if (options.writeInBackground)
+        saveIfNeededInBackground();
+    else
+        saveIfNeeded();
 }
 
 void PropertiesFile::propertyChanged()
@@ -365,8 +476,70 @@ void PropertiesFile::propertyChanged()
 
     if (options.millisecondsBeforeSaving > 0)
         startTimer (options.millisecondsBeforeSaving);
+    else if (options.millisecondsBeforeSaving == 0 && options.writeInBackground)
+        saveIfNeededInBackground();
     else if (options.millisecondsBeforeSaving == 0)
         saveIfNeeded();
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PropertiesFileTests  : public UnitTest
+{
+public:
+    PropertiesFileTests() : UnitTest ("PropertiesFile", "Values") {}
+
+    void runTest() override
+    {
+        for (auto format : { PropertiesFile::storeAsXML, PropertiesFile::storeAsBinary, PropertiesFile::storeAsCompressedBinary })
+        {
+            beginTest ("Background saving, format " + String ((int) format));
+
+            TemporaryFile tempFile (".settings");
+            PropertiesFile::Options options;
+            options.millisecondsBeforeSaving = -1;
+            options.writeInBackground = true;
+            options.storageFormat = format;
+
+            {
+                PropertiesFile props (tempFile.getFile(), options);
+
+                for (int i = 0; i < 100; ++i)
+                {
+                    props.setValue ("value", i);
+                    props.saveIfNeededInBackground();
+                }
+
+                expect (! props.needsToBeSaved());
+                props.waitForBackgroundSave();
+                expect (tempFile.getFile().existsAsFile());
+
+                PropertiesFile reloaded (tempFile.getFile(), options);
+                expectEquals (reloaded.getIntValue ("value"), 99);
+
+                // a synchronous save after a background one must win
+                props.setValue ("value", "background");
+                props.saveIfNeededInBackground();
+                props.setValue ("value", "synchronous");
+                expect (props.save());
+                props.waitForBackgroundSave();
+
+                reloaded.reload();
+                expectEquals (reloaded.getValue ("value"), String ("synchronous"));
+
+                props.setValue ("value", "pending");
+                props.saveIfNeededInBackground();
+            }
+
+            PropertiesFile reloaded (tempFile.getFile(), options);
+            expectEquals (reloaded.getValue ("value"), String ("pending"));
+        }
+    }
+};
+
+static PropertiesFileTests propertiesFileTests;
+
+#endif
+
 } // namespace juce
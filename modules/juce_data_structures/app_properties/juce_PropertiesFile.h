@@ -128,6 +128,16 @@ public:
         */
         int millisecondsBeforeSaving;
 
+        /** If true, the saves that are triggered automatically after a value changes will
+            take a copy of the values on the message thread, and then format and write the
+            file on a shared background thread, so that large settings files don't stall
+            the UI. If several changes arrive before the writer gets round to them, only the
+            most recent copy gets written.
+            Explicit calls to save() and saveIfNeeded() are still synchronous.
+            The default constructor initialises this value to false.
+        */
+        bool writeInBackground;
+
         /** Specifies whether the file should be written as XML, binary, etc.
             The default constructor sets this to storeAsXML, so you only need to set it explicitly
             if you want to use a different format.
@@ -210,6 +220,23 @@ public:
     */
     bool save();
 
+    /** If the values have changed since the last save, this takes a copy of them and
+        writes it to disk on a background thread, returning immediately.
+
+        The file is written to a temporary file which then replaces the target, so a
+        reader never sees a partially-written file. If the background write fails, the
+        file is flagged as needing to be saved again.
+
+        @see saveIfNeeded, waitForBackgroundSave, Options::writeInBackground
+    */
+    void saveIfNeededInBackground();
+
+    /** Blocks until any write that was started by saveIfNeededInBackground() has
+        finished. Any copy that's still waiting for the background thread is written
+        on the calling thread.
+    */
+    void waitForBackgroundSave();
+
     /** Returns true if the properties have been altered since the last time they were saved.
         The file is flagged as needing to be saved when you change a value, but you can
         explicitly set this flag with setNeedsToBeSaved().
@@ -239,16 +266,20 @@ private:
     Options options;
     bool loadedOk = false, needsWriting = false;
 
+    struct BackgroundWriter;
+    std::unique_ptr<BackgroundWriter> backgroundWriter;
+
     using ProcessScopedLock = const std::unique_ptr<InterProcessLock::ScopedLockType>;
     InterProcessLock::ScopedLockType* createProcessLock() const;
 
     void timerCallback() override;
-    bool saveAsXml();
-    bool saveAsBinary();
+    bool writeValues (const StringPairArray&) const;
+    bool saveAsXml (const StringPairArray&) const;
+    bool saveAsBinary (const StringPairArray&) const;
     bool loadAsXml();
     bool loadAsBinary();
     bool loadAsBinary (InputStream&);
-    bool writeToStream (OutputStream&);
+    static bool writeToStream (OutputStream&, const StringPairArray&);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PropertiesFile)
 };
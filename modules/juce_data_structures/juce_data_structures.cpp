@@ -43,3 +43,7 @@
 #include "undomanager/juce_UndoManager.cpp"
 #include "app_properties/juce_ApplicationProperties.cpp"
 #include "app_properties/juce_PropertiesFile.cpp"
+
+#if JUCE_UNIT_TESTS
+ #include "values/juce_ValueTree_benchmark.cpp"
+#endif
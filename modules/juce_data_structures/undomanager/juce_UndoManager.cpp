@@ -50,19 +50,35 @@ struct UndoManager::ActionSet
         return true;
     }
 
-    int getTotalSize() const
+    // The size of each action is measured once when it's added, so that the totals stay
+    // consistent even if an action's getSizeInUnits() changes, and don't need recalculating.
+    int add (UndoableAction* action)
     {
-        int total = 0;
-
-        for (auto* a : actions)
-            total += a->getSizeInUnits();
+        auto size = action->getSizeInUnits();
+        actions.add (action);
+        sizes.add (size);
+        totalSize += size;
+        lastChangeTime = Time::getMillisecondCounter();
+        return size;
+    }
 
-        return total;
+    int removeLast()
+    {
+        auto size = sizes.getLast();
+        actions.removeLast();
+        sizes.removeLast();
+        totalSize -= size;
+        return size;
     }
 
+    int getTotalSize() const noexcept     { return totalSize; }
+
     OwnedArray<UndoableAction> actions;
+    Array<int> sizes;
+    int totalSize = 0;
     String name;
     Time time { Time::getCurrentTime() };
+    uint32 lastChangeTime = 0;
 };
 
 //==============================================================================
@@ -93,6 +109,20 @@ void UndoManager::setMaxNumberOfStoredUnits (int maxUnits, int minTransactions)
 {
     maxNumUnitsToKeep          = jmax (1, maxUnits);
     minimumTransactionsToKeep  = jmax (1, minTransactions);
+    dropOldTransactionsIfTooLarge();
+}
+
+void UndoManager::setTransactionCoalescingInterval (int maxMilliseconds)
+{
+    coalescingIntervalMs = jmax (0, maxMilliseconds);
+}
+
+bool UndoManager::canCoalesceWithPreviousTransaction (const ActionSet& previous) const
+{
+    return coalescingIntervalMs > 0
+            && nextIndex == transactions.size()
+            && (newTransactionName.isEmpty() || newTransactionName == previous.name)
+            && Time::getMillisecondCounter() - previous.lastChangeTime <= (uint32) coalescingIntervalMs;
 }
 
 //==============================================================================
@@ -126,27 +156,37 @@ bool UndoManager::perform (UndoableAction* newAction)
         {
             auto* actionSet = getCurrentSet();
 
-            if (actionSet != nullptr && ! newTransaction)
+            if (actionSet != nullptr && (! newTransaction || canCoalesceWithPreviousTransaction (*actionSet)))
             {
+                UndoableAction* coalescedAction = nullptr;
+
                 if (auto* lastAction = actionSet->actions.getLast())
+                    coalescedAction = lastAction->createCoalescedAction (action.get());
+
+                if (coalescedAction != nullptr)
                 {
-                    if (auto coalescedAction = lastAction->createCoalescedAction (action.get()))
-                    {
-                        action.reset (coalescedAction);
-                        totalUnitsStored -= lastAction->getSizeInUnits();
-                        actionSet->actions.removeLast();
-                    }
+                    action.reset (coalescedAction);
+                    totalUnitsStored -= actionSet->removeLast();
+                }
+                else if (newTransaction)
+                {
+                    // a new transaction is only merged into the previous one if its action can be coalesced
+                    actionSet = nullptr;
                 }
             }
             else
+            {
+                actionSet = nullptr;
+            }
+
+            if (actionSet == nullptr)
             {
                 actionSet = new ActionSet (newTransactionName);
                 transactions.insert (nextIndex, actionSet);
                 ++nextIndex;
             }
 
-            totalUnitsStored += action->getSizeInUnits();
-            actionSet->actions.add (action.release());
+            totalUnitsStored += actionSet->add (action.release());
             newTransaction = false;
 
             moveFutureTransactionsToStash();
@@ -367,4 +407,74 @@ int UndoManager::getNumActionsInCurrentTransaction() const
     return 0;
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class UndoManagerTests  : public UnitTest
+{
+public:
+    UndoManagerTests() : UnitTest ("UndoManager", "Values") {}
+
+    void runTest() override
+    {
+        const Identifier value ("value"), data ("data");
+
+        beginTest ("Coalescing transactions");
+        {
+            UndoManager undoManager;
+            ValueTree tree ("tree");
+            tree.setProperty (value, 0, nullptr);
+
+            for (int i = 1; i <= 10; ++i)
+            {
+                undoManager.beginNewTransaction();
+                tree.setProperty (value, i, &undoManager);
+            }
+
+            expectEquals (undoManager.getUndoDescriptions().size(), 10);
+            undoManager.clearUndoHistory();
+
+            undoManager.setTransactionCoalescingInterval (10000);
+
+            for (int i = 1; i <= 10; ++i)
+            {
+                undoManager.beginNewTransaction();
+                tree.setProperty (value, 10 + i, &undoManager);
+            }
+
+            undoManager.beginNewTransaction();
+            tree.setProperty (data, "x", &undoManager);
+
+            expectEquals (undoManager.getUndoDescriptions().size(), 2);
+            expect (undoManager.undo());
+            expect (undoManager.undo());
+            expectEquals ((int) tree[value], 10);
+            expect (! undoManager.canUndo());
+        }
+
+        beginTest ("Size accounting");
+        {
+            UndoManager undoManager (100000, 1);
+            ValueTree tree ("tree");
+
+            for (int i = 0; i < 100; ++i)
+            {
+                undoManager.beginNewTransaction();
+                tree.setProperty (data, String::repeatedString ("x", 10000) + String (i), &undoManager);
+            }
+
+            // each of these actions holds two 10KB strings, so only a few of them fit
+            expect (undoManager.getNumberOfUnitsTakenUpByStoredCommands() <= 100000 + 30000);
+            expect (undoManager.getUndoDescriptions().size() < 10);
+
+            undoManager.setMaxNumberOfStoredUnits (1, 1);
+            expectEquals (undoManager.getUndoDescriptions().size(), 1);
+        }
+    }
+};
+
+static UndoManagerTests undoManagerTests;
+
+#endif
+
 } // namespace juce
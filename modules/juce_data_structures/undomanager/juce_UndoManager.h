@@ -45,6 +45,11 @@ namespace juce
     The UndoManager is a ChangeBroadcaster, so listeners can register to be told
     when actions are performed or undone.
 
+    The total size of the history is limited by the sizes that the actions report
+    with UndoableAction::getSizeInUnits() - the actions created by ValueTree use an
+    estimate of the number of bytes they occupy, so for those, the limit is roughly
+    a memory budget. When the limit is exceeded, the oldest transactions are deleted.
+
     @see UndoableAction
 
     @tags{DataStructures}
@@ -98,6 +103,23 @@ public:
     void setMaxNumberOfStoredUnits (int maxNumberOfUnitsToKeep,
                                     int minimumTransactionsToKeep);
 
+    /** Makes the UndoManager merge rapid sequences of small transactions into one.
+
+        Normally, each call to beginNewTransaction() starts a separate entry in the undo
+        history. If you set an interval here, then when the first action of a new transaction
+        is performed within this many milliseconds of the last change to the previous
+        transaction, and the previous transaction's last action can merge with it (see
+        UndoableAction::createCoalescedAction()), the action is merged into the previous
+        transaction instead. This means that, for example, dragging a slider that's attached
+        to a ValueTree property leaves a single entry in the history, rather than one for
+        every mouse movement.
+
+        Transactions are only merged if the new one has no name, or the same name as the
+        previous one, and there's nothing waiting to be redone. Passing 0 turns this off,
+        which is the default.
+    */
+    void setTransactionCoalescingInterval (int maxMillisecondsBetweenTransactions);
+
     //==============================================================================
     /** Performs an action and adds it to the undo history list.
 
@@ -252,12 +274,14 @@ private:
     OwnedArray<ActionSet> transactions, stashedFutureTransactions;
     String newTransactionName;
     int totalUnitsStored = 0, maxNumUnitsToKeep = 0, minimumTransactionsToKeep = 0, nextIndex = 0;
+    int coalescingIntervalMs = 0;
     bool newTransaction = true, isInsideUndoRedoCall = false;
     ActionSet* getCurrentSet() const;
     ActionSet* getNextSet() const;
     void moveFutureTransactionsToStash();
     void restoreStashedFutureTransactions();
     void dropOldTransactionsIfTooLarge();
+    bool canCoalesceWithPreviousTransaction (const ActionSet&) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UndoManager)
 };
@@ -0,0 +1,366 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Lets a thread find out cheaply whether any of a set of AtomicCachedValues has changed.
+
+    Each AtomicCachedValue that has been given a group using AtomicCachedValue::setGroup()
+    bumps the group's version number whenever its value changes, so e.g. an audio thread
+    can check a single number at the start of each block to see whether it needs to read
+    the values again and recalculate anything that depends on them.
+
+    @see AtomicCachedValue
+
+    @tags{DataStructures}
+*/
+class AtomicCachedValueGroup
+{
+public:
+    AtomicCachedValueGroup() = default;
+
+    /** Returns a number that changes whenever one of the values in the group changes. */
+    uint32 getVersion() const noexcept      { return version.load (std::memory_order_acquire); }
+
+    /** Returns true if any of the values have changed since the version that is passed in,
+        and updates lastVersionSeen to the current version.
+
+        Each reader should keep its own lastVersionSeen variable. Any value changes that caused
+        this to return true will be visible to the calling thread when it returns.
+    */
+    bool haveValuesChanged (uint32& lastVersionSeen) const noexcept
+    {
+        auto current = getVersion();
+
+        if (current == lastVersionSeen)
+            return false;
+
+        lastVersionSeen = current;
+        return true;
+    }
+
+    /** Called by the AtomicCachedValues in the group after they change. */
+    void valueChanged() noexcept            { version.fetch_add (1, std::memory_order_release); }
+
+private:
+    std::atomic<uint32> version { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (AtomicCachedValueGroup)
+};
+
+//==============================================================================
+#ifndef DOXYGEN
+namespace AtomicCachedValueHelpers
+{
+    // Small types are stored in a std::atomic..
+    template <typename Type, bool fitsInAtomic>
+    struct Storage
+    {
+        void store (const Type& newValue) noexcept      { value.store (newValue, std::memory_order_release); }
+        Type load() const noexcept                      { return value.load (std::memory_order_acquire); }
+
+        std::atomic<Type> value;
+    };
+
+    // ..and bigger ones are protected by a sequence lock. The writer makes the sequence
+    // number odd while it changes the data, and readers retry if the number was odd or
+    // changed while they were copying it. Readers never block the writer or each other.
+    template <typename Type>
+    struct Storage<Type, false>
+    {
+        void store (const Type& newValue) noexcept
+        {
+            uint64 words[numWords] = {};
+            memcpy (words, &newValue, sizeof (Type));
+
+            auto seq = sequence.load (std::memory_order_relaxed);
+            sequence.store (seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_release);
+
+            for (int i = 0; i < numWords; ++i)
+                data[i].store (words[i], std::memory_order_relaxed);
+
+            sequence.store (seq + 2, std::memory_order_release);
+        }
+
+        Type load() const noexcept
+        {
+            uint64 words[numWords];
+
+            for (;;)
+            {
+                auto seq = sequence.load (std::memory_order_acquire);
+
+                if ((seq & 1) == 0)
+                {
+                    for (int i = 0; i < numWords; ++i)
+                        words[i] = data[i].load (std::memory_order_relaxed);
+
+                    std::atomic_thread_fence (std::memory_order_acquire);
+
+                    if (sequence.load (std::memory_order_relaxed) == seq)
+                        break;
+                }
+            }
+
+            Type result;
+            memcpy (&result, words, sizeof (Type));
+            return result;
+        }
+
+        enum { numWords = (int) ((sizeof (Type) + sizeof (uint64) - 1) / sizeof (uint64)) };
+
+        std::atomic<uint32> sequence { 0 };
+        std::atomic<uint64> data[numWords];
+    };
+}
+#endif
+
+//==============================================================================
+/**
+    A version of CachedValue whose value can be read safely from any thread.
+
+    This works like a CachedValue, and must be attached to its ValueTree, written and
+    updated on the message thread (or whichever thread is making changes to the tree).
+    But whenever its property changes, the new value is also published in a way that lets
+    other threads call get() at any time without a data race - small types are kept in a
+    std::atomic, and larger ones are protected by a sequence lock, so that reading never
+    blocks or allocates, which makes it suitable for use on an audio thread.
+
+    The Type must be trivially copyable (e.g. a number, bool, enum or a simple struct of
+    these). Types like String can't be copied safely while another thread changes them,
+    so for those you'll need to use a CachedValue on the message thread.
+
+    If you have many values that a thread needs to check, you can put them into an
+    AtomicCachedValueGroup, and check that once to find out whether any of them changed.
+
+    @see CachedValue, AtomicCachedValueGroup
+
+    @tags{DataStructures}
+*/
+template <typename Type>
+class AtomicCachedValue   : private ValueTree::Listener
+{
+public:
+    //==============================================================================
+    /** Default constructor.
+        Creates a default AtomicCachedValue not referring to any property. To initialise the
+        object, call one of the referTo() methods.
+    */
+    AtomicCachedValue()                                 { publish(); }
+
+    /** Constructor.
+
+        Creates an AtomicCachedValue referring to a Value property inside a ValueTree.
+        If you use this constructor, the fallback value will be a default-constructed
+        instance of Type.
+
+        @param tree          The ValueTree containing the property
+        @param propertyID    The identifier of the property
+        @param um            The UndoManager to use when writing to the property
+    */
+    AtomicCachedValue (ValueTree& tree, const Identifier& propertyID, UndoManager* um)
+        : AtomicCachedValue (tree, propertyID, um, Type())
+    {
+    }
+
+    /** Constructor.
+
+        Creates an AtomicCachedValue referring to a Value property inside a ValueTree,
+        and specifies a fallback value to use if the property does not exist.
+
+        @param tree          The ValueTree containing the property
+        @param propertyID    The identifier of the property
+        @param um            The UndoManager to use when writing to the property
+        @param defaultToUse  The fallback default value to use.
+    */
+    AtomicCachedValue (ValueTree& tree, const Identifier& propertyID,
+                       UndoManager* um, const Type& defaultToUse)
+    {
+        referTo (tree, propertyID, um, defaultToUse);
+    }
+
+    /** Destructor. */
+    ~AtomicCachedValue() override                       { targetTree.removeListener (this); }
+
+    //==============================================================================
+    /** Returns the current value of the property, or the fallback default value if it's missing.
+        This can be called from any thread.
+    */
+    Type get() const noexcept                           { return storage.load(); }
+
+    /** Returns the current value of the property, or the fallback default value if it's missing.
+        This can be called from any thread.
+    */
+    operator Type() const noexcept                      { return get(); }
+
+    //==============================================================================
+    /** Sets the property. This will actually modify the property in the referenced ValueTree,
+        so must only be called on the thread that makes changes to the tree.
+    */
+    AtomicCachedValue& operator= (const Type& newValue)
+    {
+        setValue (newValue, undoManager);
+        return *this;
+    }
+
+    /** Sets the property. This will actually modify the property in the referenced ValueTree,
+        so must only be called on the thread that makes changes to the tree.
+    */
+    void setValue (const Type& newValue, UndoManager* undoManagerToUse)
+    {
+        if (cachedValue != newValue || isUsingDefault())
+        {
+            setCachedValue (newValue);
+            targetTree.setProperty (targetProperty, VariantConverter<Type>::toVar (newValue), undoManagerToUse);
+        }
+    }
+
+    /** Removes the property from the referenced ValueTree and makes this return the
+        fallback default value instead.
+    */
+    void resetToDefault()                               { resetToDefault (undoManager); }
+
+    /** Removes the property from the referenced ValueTree and makes this return the
+        fallback default value instead.
+    */
+    void resetToDefault (UndoManager* undoManagerToUse)
+    {
+        targetTree.removeProperty (targetProperty, undoManagerToUse);
+        forceUpdateOfCachedValue();
+    }
+
+    /** Returns true if the current property does not exist and the fallback default value
+        is being used instead.
+    */
+    bool isUsingDefault() const                         { return ! targetTree.hasProperty (targetProperty); }
+
+    /** Returns the current fallback default value. */
+    Type getDefault() const                             { return defaultValue; }
+
+    /** Resets the fallback default value. */
+    void setDefault (const Type& value)
+    {
+        defaultValue = value;
+        forceUpdateOfCachedValue();
+    }
+
+    /** Returns the current property as a Value object. */
+    Value getPropertyAsValue()                          { return targetTree.getPropertyAsValue (targetProperty, undoManager); }
+
+    //==============================================================================
+    /** Makes this refer to the specified property inside the given ValueTree. */
+    void referTo (ValueTree& tree, const Identifier& property, UndoManager* um)
+    {
+        referTo (tree, property, um, Type());
+    }
+
+    /** Makes this refer to the specified property inside the given ValueTree,
+        and specifies a fallback value to use if the property does not exist.
+    */
+    void referTo (ValueTree& tree, const Identifier& property, UndoManager* um, const Type& defaultVal)
+    {
+        targetTree.removeListener (this);
+        targetTree = tree;
+        targetProperty = property;
+        undoManager = um;
+        defaultValue = defaultVal;
+        setCachedValue (getTypedValue());
+        targetTree.addListener (this);
+    }
+
+    /** Forces an update in case the referenced property has been changed from elsewhere. */
+    void forceUpdateOfCachedValue()                     { setCachedValue (getTypedValue()); }
+
+    /** Sets a group whose version number will be bumped whenever this value changes.
+        The group must stay alive for as long as it's being used by this object, and you
+        can pass nullptr to remove it.
+    */
+    void setGroup (AtomicCachedValueGroup* newGroup) noexcept   { group = newGroup; }
+
+    //==============================================================================
+    /** Returns a reference to the ValueTree containing the referenced property. */
+    ValueTree& getValueTree() noexcept                  { return targetTree; }
+
+    /** Returns the property ID of the referenced property. */
+    const Identifier& getPropertyID() const noexcept    { return targetProperty; }
+
+    /** Returns the UndoManager that is being used. */
+    UndoManager* getUndoManager() noexcept              { return undoManager; }
+
+private:
+    //==============================================================================
+    static_assert (std::is_trivially_copyable<Type>::value,
+                   "AtomicCachedValue can only hold types which can be copied with memcpy");
+
+    ValueTree targetTree;
+    Identifier targetProperty;
+    UndoManager* undoManager = nullptr;
+    Type defaultValue {}, cachedValue {};
+    AtomicCachedValueHelpers::Storage<Type, (sizeof (Type) <= sizeof (uint64))> storage;
+    AtomicCachedValueGroup* group = nullptr;
+
+    //==============================================================================
+    Type getTypedValue() const
+    {
+        if (auto* property = targetTree.getPropertyPointer (targetProperty))
+            return VariantConverter<Type>::fromVar (*property);
+
+        return defaultValue;
+    }
+
+    void setCachedValue (const Type& newValue)
+    {
+        cachedValue = newValue;
+        publish();
+    }
+
+    void publish()
+    {
+        storage.store (cachedValue);
+
+        if (group != nullptr)
+            group->valueChanged();
+    }
+
+    void valueTreePropertyChanged (ValueTree& changedTree, const Identifier& changedProperty) override
+    {
+        if (changedProperty == targetProperty && targetTree == changedTree)
+            forceUpdateOfCachedValue();
+    }
+
+    void valueTreeChildAdded (ValueTree&, ValueTree&) override {}
+    void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override {}
+    void valueTreeChildOrderChanged (ValueTree&, int, int) override {}
+    void valueTreeParentChanged (ValueTree&) override {}
+
+    JUCE_DECLARE_NON_COPYABLE (AtomicCachedValue)
+};
+
+} // namespace juce
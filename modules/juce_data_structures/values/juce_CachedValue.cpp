@@ -29,6 +29,20 @@ namespace juce
 
 #if JUCE_UNIT_TESTS
 
+struct CachedValueTestPair
+{
+    double first = 0, second = 0;
+
+    bool operator!= (const CachedValueTestPair& other) const noexcept   { return first != other.first || second != other.second; }
+};
+
+template <>
+struct VariantConverter<CachedValueTestPair>
+{
+    static CachedValueTestPair fromVar (const var& v)           { return { v[0], v[1] }; }
+    static var toVar (const CachedValueTestPair& p)             { return Array<var> { p.first, p.second }; }
+};
+
 class CachedValueTests  : public UnitTest
 {
 public:
@@ -144,6 +158,69 @@ public:
 
             expect (t["testkey"] == var());
         }
+
+        beginTest ("atomic cached values");
+        {
+            ValueTree t ("root");
+            t.setProperty ("gain", 0.5, nullptr);
+
+            AtomicCachedValueGroup group;
+            uint32 lastVersion = group.getVersion();
+
+            AtomicCachedValue<double> gain (t, "gain", nullptr, 1.0);
+            AtomicCachedValue<CachedValueTestPair> pair (t, "pair", nullptr);
+            gain.setGroup (&group);
+            pair.setGroup (&group);
+
+            expectEquals (gain.get(), 0.5);
+            expect (! group.haveValuesChanged (lastVersion));
+
+            t.setProperty ("gain", 0.25, nullptr);
+            expectEquals (gain.get(), 0.25);
+            expect (group.haveValuesChanged (lastVersion));
+            expect (! group.haveValuesChanged (lastVersion));
+
+            pair = { 1.0, 2.0 };
+            expectEquals (pair.get().second, 2.0);
+            expect (group.haveValuesChanged (lastVersion));
+
+            gain.resetToDefault();
+            expectEquals (gain.get(), 1.0);
+        }
+
+        beginTest ("atomic cached values between threads");
+        {
+            ValueTree t ("root");
+            AtomicCachedValue<CachedValueTestPair> pair (t, "pair", nullptr);
+            std::atomic<bool> finished { false }, consistent { true };
+
+            struct ReaderThread  : public Thread
+            {
+                ReaderThread (std::function<void()> f) : Thread ("reader"), fn (f) {}
+                void run() override    { fn(); }
+                std::function<void()> fn;
+            };
+
+            ReaderThread reader ([&]
+            {
+                while (! finished.load())
+                {
+                    auto p = pair.get();
+
+                    if (p.second != -p.first)
+                        consistent = false;
+                }
+            });
+
+            reader.startThread();
+
+            for (int i = 0; i < 10000; ++i)
+                t.setProperty ("pair", VariantConverter<CachedValueTestPair>::toVar ({ (double) i, (double) -i }), nullptr);
+
+            finished = true;
+            reader.stopThread (1000);
+            expect (consistent.load());
+        }
     }
 };
 
@@ -27,6 +27,20 @@
 namespace juce
 {
 
+struct ValueTree::Snapshot::Node  : public ReferenceCountedObject
+{
+    using Ptr = ReferenceCountedObjectPtr<Node>;
+
+    Node (const Identifier& t, const NamedValueSet& p)  : type (t), properties (p) {}
+
+    const Identifier type;
+    const NamedValueSet properties;
+    ReferenceCountedArray<Node> children;
+
+    JUCE_DECLARE_NON_COPYABLE (Node)
+};
+
+//==============================================================================
 class ValueTree::SharedObject  : public ReferenceCountedObject
 {
 public:
@@ -35,7 +49,8 @@ public:
     explicit SharedObject (const Identifier& t) noexcept  : type (t) {}
 
     SharedObject (const SharedObject& other)
-        : ReferenceCountedObject(), type (other.type), properties (other.properties)
+        : ReferenceCountedObject(), type (other.type), properties (other.properties),
+          cachedSnapshot (other.cachedSnapshot)
     {
         for (auto* c : other.children)
         {
@@ -51,6 +66,8 @@ public:
     {
         jassert (parent == nullptr); // this should never happen unless something isn't obeying the ref-counting!
 
+        lookupIndex.reset();
+
         for (auto i = children.size(); --i >= 0;)
         {
             const Ptr c (children.getObjectPointerUnchecked (i));
@@ -65,6 +82,79 @@ public:
         return parent == nullptr ? *this : parent->getRoot();
     }
 
+    // Gives a rough idea of how much memory this node and its children are using, so that
+    // the UndoManager can account for actions that hold on to them.
+    int getApproximateSizeInBytes() const
+    {
+        auto total = (int) sizeof (*this) + properties.size() * (int) sizeof (NamedValueSet::NamedValue);
+
+        for (auto& p : properties)
+            total += getApproximateSizeInBytes (p.value) - (int) sizeof (var);
+
+        for (auto* c : children)
+            total += c->getApproximateSizeInBytes();
+
+        return total;
+    }
+
+    static int getApproximateSizeInBytes (const var& v)
+    {
+        auto total = (int) sizeof (var);
+
+        if (v.isString())
+            total += (int) v.toString().getNumBytesAsUTF8();
+        else if (auto* data = v.getBinaryData())
+            total += (int) data->getSize();
+        else if (auto* array = v.getArray())
+            for (auto& element : *array)
+                total += getApproximateSizeInBytes (element);
+
+        // (objects are only counted as a pointer, as they're shared and can refer to each other)
+        return total;
+    }
+
+    //==============================================================================
+    // A node only keeps a cached snapshot if all of its children have one, so when something
+    // changes, clearing the caches can stop at the first parent that doesn't have one.
+    void invalidateSnapshot() noexcept
+    {
+        for (auto* t = this; t != nullptr && t->cachedSnapshot != nullptr; t = t->parent)
+            t->cachedSnapshot = nullptr;
+    }
+
+    Snapshot::Node::Ptr getSnapshot()
+    {
+        if (cachedSnapshot == nullptr)
+        {
+            Snapshot::Node::Ptr node (new Snapshot::Node (type, properties));
+            node->children.ensureStorageAllocated (children.size());
+
+            for (auto* c : children)
+                node->children.add (c->getSnapshot());
+
+            cachedSnapshot = node;
+        }
+
+        return cachedSnapshot;
+    }
+
+    static SharedObject* createFromSnapshot (Snapshot::Node& node)
+    {
+        auto* s = new SharedObject (node.type);
+        s->properties = node.properties;
+        s->children.ensureStorageAllocated (node.children.size());
+
+        for (auto* c : node.children)
+        {
+            auto* child = createFromSnapshot (*c);
+            child->parent = s;
+            s->children.add (child);
+        }
+
+        s->cachedSnapshot = &node;
+        return s;
+    }
+
     template <typename Function>
     void callListeners (ValueTree::Listener* listenerToExclude, Function fn) const
     {
@@ -135,8 +225,23 @@ public:
     {
         if (undoManager == nullptr)
         {
-            if (properties.set (name, newValue))
+            if (auto* index = getParentIndexFor (name))
+            {
+                auto* existingValue = properties.getVarPointer (name);
+                auto oldValue = existingValue != nullptr ? *existingValue : var();
+
+                if (properties.set (name, newValue))
+                {
+                    invalidateSnapshot();
+                    index->keyChanged (this, existingValue != nullptr ? &oldValue : nullptr, &newValue);
+                    sendPropertyChangeMessage (name, listenerToExclude);
+                }
+            }
+            else if (properties.set (name, newValue))
+            {
+                invalidateSnapshot();
                 sendPropertyChangeMessage (name, listenerToExclude);
+            }
         }
         else
         {
@@ -163,8 +268,22 @@ public:
     {
         if (undoManager == nullptr)
         {
-            if (properties.remove (name))
+            if (auto* index = getParentIndexFor (name))
+            {
+                auto oldValue = properties[name];
+
+                if (properties.remove (name))
+                {
+                    invalidateSnapshot();
+                    index->keyChanged (this, &oldValue, nullptr);
+                    sendPropertyChangeMessage (name);
+                }
+            }
+            else if (properties.remove (name))
+            {
+                invalidateSnapshot();
                 sendPropertyChangeMessage (name);
+            }
         }
         else
         {
@@ -180,7 +299,19 @@ public:
             while (properties.size() > 0)
             {
                 auto name = properties.getName (properties.size() - 1);
-                properties.remove (name);
+
+                if (auto* index = getParentIndexFor (name))
+                {
+                    auto oldValue = properties[name];
+                    properties.remove (name);
+                    index->keyChanged (this, &oldValue, nullptr);
+                }
+                else
+                {
+                    properties.remove (name);
+                }
+
+                invalidateSnapshot();
                 sendPropertyChangeMessage (name);
             }
         }
@@ -204,6 +335,14 @@ public:
 
     ValueTree getChildWithName (const Identifier& typeToMatch) const
     {
+        if (lookupIndex != nullptr)
+        {
+            if (auto* s = getValidChildIndex().findFirstOfType (typeToMatch))
+                return ValueTree (*s);
+
+            return {};
+        }
+
         for (auto* s : children)
             if (s->type == typeToMatch)
                 return ValueTree (*s);
@@ -213,9 +352,10 @@ public:
 
     ValueTree getOrCreateChildWithName (const Identifier& typeToMatch, UndoManager* undoManager)
     {
-        for (auto* s : children)
-            if (s->type == typeToMatch)
-                return ValueTree (*s);
+        auto existing = getChildWithName (typeToMatch);
+
+        if (existing.isValid())
+            return existing;
 
         auto newObject = new SharedObject (typeToMatch);
         addChild (newObject, -1, undoManager);
@@ -224,6 +364,14 @@ public:
 
     ValueTree getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const
     {
+        if (lookupIndex != nullptr && lookupIndex->keyProperty == propertyName && ! propertyValue.isVoid())
+        {
+            if (auto* s = getValidChildIndex().findFirstWithKey (propertyValue))
+                return ValueTree (*s);
+
+            return {};
+        }
+
         for (auto* s : children)
             if (s->properties[propertyName] == propertyValue)
                 return ValueTree (*s);
@@ -242,6 +390,15 @@ public:
 
     int indexOf (const ValueTree& child) const noexcept
     {
+        if (lookupIndex != nullptr)
+        {
+            if (child.object == nullptr || child.object->parent != this)
+                return -1;
+
+            getValidChildIndex();
+            return child.object->indexInParent;
+        }
+
         return children.indexOf (child.object);
     }
 
@@ -266,6 +423,11 @@ public:
                 {
                     children.insert (index, child);
                     child->parent = this;
+                    invalidateSnapshot();
+
+                    if (lookupIndex != nullptr)
+                        lookupIndex->childAdded (children, child);
+
                     sendChildAddedMessage (ValueTree (*child));
                     child->sendParentChangeMessage();
                 }
@@ -294,6 +456,11 @@ public:
             {
                 children.remove (childIndex);
                 child->parent = nullptr;
+                invalidateSnapshot();
+
+                if (lookupIndex != nullptr)
+                    lookupIndex->childRemoved (children, child.get(), childIndex);
+
                 sendChildRemovedMessage (ValueTree (child), childIndex);
                 child->sendParentChangeMessage();
             }
@@ -321,6 +488,11 @@ public:
             if (undoManager == nullptr)
             {
                 children.move (currentIndex, newIndex);
+                invalidateSnapshot();
+
+                if (lookupIndex != nullptr)
+                    lookupIndex->invalidate();
+
                 sendChildOrderChangedMessage (currentIndex, newIndex);
             }
             else
@@ -445,7 +617,7 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return (int) sizeof (*this) + getApproximateSizeInBytes (newValue) + getApproximateSizeInBytes (oldValue);
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
@@ -513,7 +685,8 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            // (the action keeps the child alive while it's not in the tree)
+            return (int) sizeof (*this) + (child != nullptr ? child->getApproximateSizeInBytes() : 0);
         }
 
     private:
@@ -546,7 +719,7 @@ public:
 
         int getSizeInUnits() override
         {
-            return (int) sizeof (*this); //xxx should be more accurate
+            return (int) sizeof (*this);
         }
 
         UndoableAction* createCoalescedAction (UndoableAction* nextAction) override
@@ -565,12 +738,203 @@ public:
         JUCE_DECLARE_NON_COPYABLE (MoveChildAction)
     };
 
+    //==============================================================================
+    // Keeps hash tables of the children by type, and optionally by the value of one of their
+    // properties, with each list of matches kept in child order. Appending or removing the last
+    // child updates the tables directly, but anything that shifts the other children around
+    // just marks them as stale, so that they get rebuilt the next time they're needed.
+    struct ChildLookupIndex
+    {
+        ChildLookupIndex (const Identifier& keyPropertyToUse)  : keyProperty (keyPropertyToUse) {}
+
+        using ChildList = Array<SharedObject*>;
+
+        void invalidate() noexcept      { isValid = false; }
+
+        void rebuild (const ReferenceCountedArray<SharedObject>& children)
+        {
+            byType.clear();
+            byKey.clear();
+
+            for (int i = 0; i < children.size(); ++i)
+            {
+                auto* c = children.getObjectPointerUnchecked (i);
+                c->indexInParent = i;
+                byType.getReference (getTypeKey (c->type)).add (c);
+
+                if (auto* value = getKeyValue (*c))
+                    byKey.getReference (getValueKey (*value)).add (c);
+            }
+
+            isValid = true;
+        }
+
+        void childAdded (const ReferenceCountedArray<SharedObject>& children, SharedObject* child)
+        {
+            if (isValid)
+            {
+                if (children.getLast().get() == child)
+                {
+                    child->indexInParent = children.size() - 1;
+                    byType.getReference (getTypeKey (child->type)).add (child);
+
+                    if (auto* value = getKeyValue (*child))
+                        byKey.getReference (getValueKey (*value)).add (child);
+                }
+                else
+                {
+                    invalidate();
+                }
+            }
+        }
+
+        void childRemoved (const ReferenceCountedArray<SharedObject>& children, SharedObject* child, int index)
+        {
+            if (isValid)
+            {
+                if (index == children.size())
+                {
+                    removeFromList (byType, getTypeKey (child->type), child);
+
+                    if (auto* value = getKeyValue (*child))
+                        removeFromList (byKey, getValueKey (*value), child);
+                }
+                else
+                {
+                    invalidate();
+                }
+            }
+        }
+
+        void keyChanged (SharedObject* child, const var* oldValue, const var* newValue)
+        {
+            if (isValid)
+            {
+                if (oldValue != nullptr)
+                    removeFromList (byKey, getValueKey (*oldValue), child);
+
+                if (newValue != nullptr)
+                {
+                    auto& list = byKey.getReference (getValueKey (*newValue));
+
+                    auto pos = std::upper_bound (list.begin(), list.end(), child,
+                                                 [] (const SharedObject* a, const SharedObject* b) { return a->indexInParent < b->indexInParent; });
+
+                    list.insert ((int) (pos - list.begin()), child);
+                }
+            }
+        }
+
+        SharedObject* findFirstOfType (const Identifier& typeToMatch)
+        {
+            auto key = getTypeKey (typeToMatch);
+            return byType.contains (key) ? byType.getReference (key).getFirst() : nullptr;
+        }
+
+        SharedObject* findFirstWithKey (const var& value)
+        {
+            auto key = getValueKey (value);
+
+            if (byKey.contains (key))
+                for (auto* c : byKey.getReference (key))
+                    if (c->properties[keyProperty] == value)
+                        return c;
+
+            return nullptr;
+        }
+
+        const Identifier keyProperty;
+        bool isValid = false;
+
+    private:
+        HashMap<uint64, ChildList> byType, byKey;
+
+        const var* getKeyValue (const SharedObject& child) const
+        {
+            return keyProperty.isNull() ? nullptr : child.properties.getVarPointer (keyProperty);
+        }
+
+        static uint64 getTypeKey (const Identifier& t) noexcept
+        {
+            return mixBits ((uint64) (pointer_sized_uint) t.getCharPointer().getAddress());
+        }
+
+        // HashMap just takes the key modulo its size, so the bits need spreading out first
+        // (e.g. doubles holding small integers have all their low bits clear)
+        static uint64 mixBits (uint64 x) noexcept
+        {
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+
+        // Numbers of different types can compare as equal, so they all share the same keys.
+        // Anything else is keyed by its string form, and matches are checked with var::operator==
+        static uint64 getValueKey (const var& v)
+        {
+            if (v.isInt() || v.isInt64() || v.isDouble() || v.isBool())
+            {
+                auto d = static_cast<double> (v);
+                uint64 bits = 0;
+
+                if (d != 0)
+                    memcpy (&bits, &d, sizeof (bits));
+
+                return mixBits (bits);
+            }
+
+            return (uint64) v.toString().hashCode64();
+        }
+
+        static void removeFromList (HashMap<uint64, ChildList>& map, uint64 key, SharedObject* child)
+        {
+            if (map.contains (key))
+            {
+                auto& list = map.getReference (key);
+
+                if (list.getLast() == child)
+                    list.removeLast();
+                else
+                    list.removeFirstMatchingValue (child);
+
+                if (list.isEmpty())
+                    map.remove (key);
+            }
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (ChildLookupIndex)
+    };
+
+    ChildLookupIndex& getValidChildIndex() const
+    {
+        if (! lookupIndex->isValid)
+            lookupIndex->rebuild (children);
+
+        return *lookupIndex;
+    }
+
+    ChildLookupIndex* getParentIndexFor (const Identifier& propertyName) const noexcept
+    {
+        if (parent != nullptr && parent->lookupIndex != nullptr && parent->lookupIndex->keyProperty == propertyName)
+            return parent->lookupIndex.get();
+
+        return nullptr;
+    }
+
+    void createChildLookupIndex (const Identifier& keyProperty)
+    {
+        lookupIndex.reset (new ChildLookupIndex (keyProperty));
+    }
+
     //==============================================================================
     const Identifier type;
     NamedValueSet properties;
     ReferenceCountedArray<SharedObject> children;
     SortedSet<ValueTree*> valueTreesWithListeners;
     SharedObject* parent = nullptr;
+    std::unique_ptr<ChildLookupIndex> lookupIndex;
+    int indexInParent = 0;
+    Snapshot::Node::Ptr cachedSnapshot;
 
     JUCE_LEAK_DETECTOR (SharedObject)
 };
@@ -885,6 +1249,128 @@ ValueTree ValueTree::Iterator::operator*() const
 ValueTree::Iterator ValueTree::begin() const noexcept   { return Iterator (*this, false); }
 ValueTree::Iterator ValueTree::end() const noexcept     { return Iterator (*this, true); }
 
+//==============================================================================
+ValueTree::Snapshot::Snapshot() noexcept {}
+ValueTree::Snapshot::Snapshot (ReferenceCountedObjectPtr<Node> n) noexcept  : node (std::move (n)) {}
+ValueTree::Snapshot::Snapshot (const Snapshot& other) noexcept  : node (other.node) {}
+ValueTree::Snapshot::Snapshot (Snapshot&& other) noexcept  : node (std::move (other.node)) {}
+ValueTree::Snapshot::~Snapshot() {}
+
+ValueTree::Snapshot& ValueTree::Snapshot::operator= (const Snapshot& other) noexcept
+{
+    node = other.node;
+    return *this;
+}
+
+ValueTree::Snapshot& ValueTree::Snapshot::operator= (Snapshot&& other) noexcept
+{
+    node = std::move (other.node);
+    return *this;
+}
+
+bool ValueTree::Snapshot::isValid() const noexcept                           { return node != nullptr; }
+bool ValueTree::Snapshot::operator== (const Snapshot& other) const noexcept  { return node == other.node; }
+bool ValueTree::Snapshot::operator!= (const Snapshot& other) const noexcept  { return node != other.node; }
+
+Identifier ValueTree::Snapshot::getType() const noexcept
+{
+    return node != nullptr ? node->type : Identifier();
+}
+
+const var& ValueTree::Snapshot::getProperty (const Identifier& name) const noexcept
+{
+    return node == nullptr ? getNullVarRef() : node->properties[name];
+}
+
+var ValueTree::Snapshot::getProperty (const Identifier& name, const var& defaultReturnValue) const
+{
+    return node == nullptr ? defaultReturnValue : node->properties.getWithDefault (name, defaultReturnValue);
+}
+
+const var& ValueTree::Snapshot::operator[] (const Identifier& name) const noexcept
+{
+    return getProperty (name);
+}
+
+bool ValueTree::Snapshot::hasProperty (const Identifier& name) const noexcept
+{
+    return node != nullptr && node->properties.contains (name);
+}
+
+int ValueTree::Snapshot::getNumProperties() const noexcept
+{
+    return node == nullptr ? 0 : node->properties.size();
+}
+
+Identifier ValueTree::Snapshot::getPropertyName (int index) const noexcept
+{
+    return node == nullptr ? Identifier() : node->properties.getName (index);
+}
+
+int ValueTree::Snapshot::getNumChildren() const noexcept
+{
+    return node == nullptr ? 0 : node->children.size();
+}
+
+ValueTree::Snapshot ValueTree::Snapshot::getChild (int index) const noexcept
+{
+    return Snapshot (node != nullptr ? node->children[index] : nullptr);
+}
+
+ValueTree::Snapshot ValueTree::Snapshot::getChildWithName (const Identifier& typeToMatch) const noexcept
+{
+    if (node != nullptr)
+        for (auto* c : node->children)
+            if (c->type == typeToMatch)
+                return Snapshot (c);
+
+    return {};
+}
+
+ValueTree::Snapshot ValueTree::Snapshot::getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const
+{
+    if (node != nullptr)
+        for (auto* c : node->children)
+            if (c->properties[propertyName] == propertyValue)
+                return Snapshot (c);
+
+    return {};
+}
+
+ValueTree ValueTree::Snapshot::createValueTree() const
+{
+    if (node != nullptr)
+        return ValueTree (*SharedObject::createFromSnapshot (*node));
+
+    return {};
+}
+
+ValueTree::Snapshot ValueTree::snapshot() const
+{
+    if (object != nullptr)
+        return Snapshot (object->getSnapshot());
+
+    return {};
+}
+
+//==============================================================================
+void ValueTree::createChildLookupIndex (const Identifier& keyProperty)
+{
+    if (object != nullptr)
+        object->createChildLookupIndex (keyProperty);
+}
+
+void ValueTree::removeChildLookupIndex()
+{
+    if (object != nullptr)
+        object->lookupIndex.reset();
+}
+
+bool ValueTree::hasChildLookupIndex() const noexcept
+{
+    return object != nullptr && object->lookupIndex != nullptr;
+}
+
 ValueTree ValueTree::getChildWithName (const Identifier& type) const
 {
     return object != nullptr ? object->getChildWithName (type) : ValueTree();
@@ -1188,6 +1674,199 @@ public:
             }
         }
 
+        {
+            beginTest ("Child lookup index");
+
+            auto r = getRandom();
+            const Identifier types[] = { "a", "b", "c" };
+            const Identifier key ("key");
+
+            ValueTree indexed ("root"), plain ("root");
+            indexed.createChildLookupIndex (key);
+            expect (indexed.hasChildLookupIndex() && ! plain.hasChildLookupIndex());
+
+            auto randomKey = [&] () -> var
+            {
+                switch (r.nextInt (3))
+                {
+                    case 0:  return r.nextInt (20);
+                    case 1:  return (double) r.nextInt (20);
+                    default: return String (r.nextInt (20));
+                }
+            };
+
+            for (int i = 0; i < 3000; ++i)
+            {
+                auto numChildren = plain.getNumChildren();
+                auto op = r.nextInt (10);
+
+                if (op < 5 || numChildren == 0)
+                {
+                    auto index = op == 0 ? r.nextInt (numChildren + 1) : -1;
+                    auto type = types[r.nextInt (3)];
+                    ValueTree a (type), b (type);
+
+                    if (r.nextBool())
+                    {
+                        auto value = randomKey();
+                        a.setProperty (key, value, nullptr);
+                        b.setProperty (key, value, nullptr);
+                    }
+
+                    indexed.addChild (a, index, nullptr);
+                    plain.addChild (b, index, nullptr);
+                }
+                else if (op < 7)
+                {
+                    auto index = r.nextBool() ? numChildren - 1 : r.nextInt (numChildren);
+                    indexed.removeChild (index, nullptr);
+                    plain.removeChild (index, nullptr);
+                }
+                else if (op == 7)
+                {
+                    auto from = r.nextInt (numChildren), to = r.nextInt (numChildren);
+                    indexed.moveChild (from, to, nullptr);
+                    plain.moveChild (from, to, nullptr);
+                }
+                else
+                {
+                    auto index = r.nextInt (numChildren);
+
+                    if (r.nextInt (4) == 0)
+                    {
+                        indexed.getChild (index).removeProperty (key, nullptr);
+                        plain.getChild (index).removeProperty (key, nullptr);
+                    }
+                    else
+                    {
+                        auto value = randomKey();
+                        indexed.getChild (index).setProperty (key, value, nullptr);
+                        plain.getChild (index).setProperty (key, value, nullptr);
+                    }
+                }
+
+                auto type = types[r.nextInt (3)];
+                expectEquals (indexed.indexOf (indexed.getChildWithName (type)),
+                              plain.indexOf (plain.getChildWithName (type)));
+
+                // numeric keys only match numbers when looked up through the index
+                auto value = r.nextBool() ? var (r.nextInt (20)) : var (String (r.nextInt (20)));
+                auto found = indexed.getChildWithProperty (key, value);
+                auto expected = -1;
+
+                for (int j = 0; j < plain.getNumChildren(); ++j)
+                {
+                    auto v = plain.getChild (j)[key];
+
+                    if (plain.getChild (j).hasProperty (key) && v.isString() == value.isString() && v == value)
+                    {
+                        expected = j;
+                        break;
+                    }
+                }
+
+                expectEquals (indexed.indexOf (found), expected);
+
+                auto childIndex = r.nextInt (indexed.getNumChildren() + 1);
+                expectEquals (indexed.indexOf (indexed.getChild (childIndex)), childIndex < indexed.getNumChildren() ? childIndex : -1);
+                expectEquals (indexed.indexOf (plain.getChild (childIndex)), -1);
+            }
+
+            expect (indexed.isEquivalentTo (plain));
+            indexed.removeChildLookupIndex();
+            expect (! indexed.hasChildLookupIndex());
+        }
+
+        {
+            beginTest ("Snapshots");
+
+            auto r = getRandom();
+            auto tree = createRandomTree (nullptr, 0, r);
+            ValueTree a ("a"), b ("b");
+            tree.appendChild (a, nullptr);
+            tree.appendChild (b, nullptr);
+            a.appendChild (ValueTree ("leaf"), nullptr);
+
+            auto copy = tree.createCopy();
+            auto first = tree.snapshot();
+            expect (first.createValueTree().isEquivalentTo (tree));
+            expect (tree.snapshot() == first);
+
+            a.getChild (0).setProperty ("value", 1, nullptr);
+            auto second = tree.snapshot();
+
+            expect (second != first);
+            expect (first.createValueTree().isEquivalentTo (copy));
+            expect (second.createValueTree().isEquivalentTo (tree));
+            expect (! first.getChildWithName ("a").getChild (0).hasProperty ("value"));
+            expectEquals ((int) second.getChildWithName ("a").getChild (0)["value"], 1);
+
+            // the branch that didn't change is shared between the two snapshots
+            expect (second.getChildWithName ("b") == first.getChildWithName ("b"));
+            expect (second.getChildWithName ("a") != first.getChildWithName ("a"));
+
+            tree.removeChild (b, nullptr);
+            expectEquals (tree.snapshot().getNumChildren(), second.getNumChildren() - 1);
+            expect (! ValueTree().snapshot().isValid());
+
+            beginTest ("Reading snapshots on another thread");
+
+            struct ReaderThread  : public Thread
+            {
+                ReaderThread() : Thread ("snapshot reader") {}
+
+                void run() override
+                {
+                    while (! threadShouldExit())
+                    {
+                        Snapshot s;
+
+                        {
+                            const SpinLock::ScopedLockType sl (lock);
+                            s = latest;
+                        }
+
+                        int total = 0;
+
+                        for (int i = 0; i < s.getNumChildren(); ++i)
+                            total += (int) s.getChild (i)["value"];
+
+                        if (total != (int) s["total"])
+                            consistent = false;
+                    }
+                }
+
+                using Snapshot = ValueTree::Snapshot;
+                SpinLock lock;
+                Snapshot latest;
+                std::atomic<bool> consistent { true };
+            };
+
+            ValueTree counters ("counters");
+            counters.setProperty ("total", 0, nullptr);
+
+            for (int i = 0; i < 20; ++i)
+                counters.appendChild (ValueTree ("counter", { { "value", 0 } }), nullptr);
+
+            ReaderThread reader;
+            reader.latest = counters.snapshot();
+            reader.startThread();
+
+            for (int i = 0; i < 5000; ++i)
+            {
+                auto child = counters.getChild (r.nextInt (20));
+                child.setProperty ("value", (int) child["value"] + 1, nullptr);
+                counters.setProperty ("total", (int) counters["total"] + 1, nullptr);
+
+                auto s = counters.snapshot();
+                const SpinLock::ScopedLockType sl (reader.lock);
+                reader.latest = s;
+            }
+
+            reader.stopThread (1000);
+            expect (reader.consistent);
+        }
+
         {
             beginTest ("Float formatting");
 
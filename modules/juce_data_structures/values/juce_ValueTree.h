@@ -294,7 +294,8 @@ public:
     /** Returns the first sub-tree with the specified type name.
         If no such child tree exists, it'll return an invalid tree. (You can use isValid() to
         check whether a tree is valid)
-        @see getOrCreateChildWithName
+        This has to scan the list of children, unless the tree has a lookup index.
+        @see getOrCreateChildWithName, createChildLookupIndex
     */
     ValueTree getChildWithName (const Identifier& type) const;
 
@@ -311,6 +312,8 @@ public:
         the specified value.
         If no such tree is found, it'll return an invalid object. (You can use isValid() to
         check whether a tree is valid)
+        If the tree has a lookup index whose key is this property, the index is used instead of
+        scanning the children - see createChildLookupIndex().
     */
     ValueTree getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const;
 
@@ -374,6 +377,33 @@ public:
     */
     int indexOf (const ValueTree& child) const noexcept;
 
+    /** Makes this tree keep an index of its children, to speed up lookups in large trees.
+
+        Once this has been called, getChildWithName() and indexOf() use a hash table instead of
+        scanning the children. If you provide a keyProperty, the index also tracks the value of
+        that property for each child, so that getChildWithProperty() can find matches for it
+        quickly. (When looking up a key with the index, numeric values only match numbers, and
+        other values only match values of the same kind, e.g strings with strings).
+
+        The index is kept up-to-date as children are added, removed and modified. Appending and
+        removing children at the end of the list is cheap, but inserting, removing or moving
+        children elsewhere means that it has to be rebuilt the next time a lookup is done, so
+        it's best to make batches of those changes before doing any more lookups.
+
+        The index belongs to the shared data of this tree, so it's used by all ValueTree objects
+        that refer to it, but it isn't copied by createCopy(), and it only covers the direct
+        children of this tree. Calling this again replaces any existing index.
+
+        @see removeChildLookupIndex, getChildWithName, getChildWithProperty
+    */
+    void createChildLookupIndex (const Identifier& keyProperty = {});
+
+    /** Deletes any index that was created by createChildLookupIndex(). */
+    void removeChildLookupIndex();
+
+    /** Returns true if createChildLookupIndex() has been used on this tree. */
+    bool hasChildLookupIndex() const noexcept;
+
     /** Returns the parent tree that contains this one.
         If the tree has no parent, this will return an invalid object. (You can use isValid() to
         check whether a tree is valid)
@@ -423,6 +453,111 @@ public:
     /** Returns an end iterator for the children in this tree. */
     Iterator end() const noexcept;
 
+    //==============================================================================
+    /**
+        An immutable copy of the state of a ValueTree at some moment.
+
+        A ValueTree can only be used safely on one thread, but a Snapshot never changes,
+        so once one has been made, it can be passed to and read by any number of other
+        threads while the original tree carries on being edited.
+
+        Snapshots are created with ValueTree::snapshot(). Each node of the tree keeps the
+        last snapshot that was taken of it until that node (or something below it) changes,
+        so successive snapshots share all the parts of the tree that haven't been modified,
+        and taking one only needs to copy the nodes that were changed and their parents.
+
+        Note that property values are copied as vars, so if a property holds a reference to
+        some other object (e.g. a DynamicObject or a MemoryBlock), the snapshot shares that
+        object with the tree, and it's up to you to make sure it isn't modified.
+
+        @see ValueTree::snapshot
+    */
+    class JUCE_API  Snapshot
+    {
+    public:
+        /** Creates an invalid snapshot. */
+        Snapshot() noexcept;
+
+        /** Creates another reference to the same snapshot. */
+        Snapshot (const Snapshot&) noexcept;
+
+        /** Makes this refer to the same snapshot as another one. */
+        Snapshot& operator= (const Snapshot&) noexcept;
+
+        /** Move constructor. */
+        Snapshot (Snapshot&&) noexcept;
+
+        /** Move assignment operator. */
+        Snapshot& operator= (Snapshot&&) noexcept;
+
+        /** Destructor. */
+        ~Snapshot();
+
+        /** Returns true if this snapshot was taken of a valid tree. */
+        bool isValid() const noexcept;
+
+        /** Returns true if both snapshots refer to the same underlying data.
+            Because unchanged parts of a tree are shared between snapshots, this is a cheap
+            way to find out whether a sub-tree has changed between two snapshots.
+        */
+        bool operator== (const Snapshot&) const noexcept;
+
+        /** Returns true if the snapshots refer to different underlying data. */
+        bool operator!= (const Snapshot&) const noexcept;
+
+        /** Returns the type of the tree at the time of the snapshot. */
+        Identifier getType() const noexcept;
+
+        /** Returns the value of a named property, or a void var if it doesn't exist. */
+        const var& getProperty (const Identifier& name) const noexcept;
+
+        /** Returns the value of a named property, or a default value if it doesn't exist. */
+        var getProperty (const Identifier& name, const var& defaultReturnValue) const;
+
+        /** Returns the value of a named property, or a void var if it doesn't exist. */
+        const var& operator[] (const Identifier& name) const noexcept;
+
+        /** Returns true if the tree had the given property. */
+        bool hasProperty (const Identifier& name) const noexcept;
+
+        /** Returns the number of properties. */
+        int getNumProperties() const noexcept;
+
+        /** Returns the name of one of the properties, or a null identifier if the index is out of range. */
+        Identifier getPropertyName (int index) const noexcept;
+
+        /** Returns the number of child trees. */
+        int getNumChildren() const noexcept;
+
+        /** Returns one of the child trees, or an invalid snapshot if the index is out of range. */
+        Snapshot getChild (int index) const noexcept;
+
+        /** Returns the first child tree with the given type, or an invalid snapshot if there isn't one. */
+        Snapshot getChildWithName (const Identifier& type) const noexcept;
+
+        /** Returns the first child tree with the given property value, or an invalid snapshot if there isn't one. */
+        Snapshot getChildWithProperty (const Identifier& propertyName, const var& propertyValue) const;
+
+        /** Creates a new, independent ValueTree with the same contents as this snapshot. */
+        ValueTree createValueTree() const;
+
+    private:
+        struct Node;
+        ReferenceCountedObjectPtr<Node> node;
+
+        friend class ValueTree;
+        explicit Snapshot (ReferenceCountedObjectPtr<Node>) noexcept;
+    };
+
+    /** Returns an immutable Snapshot of the current state of this tree and all its children.
+
+        This must be called on the thread that is making changes to the tree, but the snapshot
+        that it returns can be used on any thread.
+
+        @see Snapshot
+    */
+    Snapshot snapshot() const;
+
     //==============================================================================
     /** Creates an XmlElement that holds a complete image of this tree and all its children.
         If this tree is invalid, this may return nullptr. Otherwise, the XML that is produced can
@@ -36,7 +36,9 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        batch            = 7,
+        compressedBatch  = 8
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -91,8 +93,270 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    // Applies the part of a change that follows its header. In a batch, property names are
+    // indexes into the batch's table of identifiers, otherwise they're written out as strings.
+    static bool applyChangeToTree (ValueTree& v, ChangeType type, MemoryInputStream& input,
+                                   const Array<Identifier>* identifiers, UndoManager* undoManager)
+    {
+        auto readIdentifier = [&]() -> Identifier
+        {
+            if (identifiers == nullptr)
+                return input.readString();
+
+            return (*identifiers)[input.readCompressedInt()];
+        };
+
+        switch (type)
+        {
+            case propertyChanged:
+            {
+                auto property = readIdentifier();
+
+                if (property.isNull())
+                    return false;
+
+                v.setProperty (property, var::readFromStream (input), undoManager);
+                return true;
+            }
+
+            case propertyRemoved:
+            {
+                auto property = readIdentifier();
+
+                if (property.isNull())
+                    return false;
+
+                v.removeProperty (property, undoManager);
+                return true;
+            }
+
+            case childAdded:
+            {
+                const int index = input.readCompressedInt();
+                v.addChild (ValueTree::readFromStream (input), index, undoManager);
+                return true;
+            }
+
+            case childRemoved:
+            {
+                const int index = input.readCompressedInt();
+
+                if (isPositiveAndBelow (index, v.getNumChildren()))
+                {
+                    v.removeChild (index, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                break;
+            }
+
+            case childMoved:
+            {
+                const int oldIndex = input.readCompressedInt();
+                const int newIndex = input.readCompressedInt();
+
+                if (isPositiveAndBelow (oldIndex, v.getNumChildren())
+                     && isPositiveAndBelow (newIndex, v.getNumChildren()))
+                {
+                    v.moveChild (oldIndex, newIndex, undoManager);
+                    return true;
+                }
+
+                jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+                break;
+            }
+
+            case fullSync:
+            case batch:
+            case compressedBatch:
+            default:
+                jassertfalse; // Seem to have received some corrupt data?
+                break;
+        }
+
+        return false;
+    }
+
+    static bool applyBatch (ValueTree& root, MemoryInputStream& input, UndoManager* undoManager)
+    {
+        const int numIdentifiers = input.readCompressedInt();
+
+        if (! isPositiveAndBelow (numIdentifiers, 65536)) // sanity-check
+            return false;
+
+        Array<Identifier> identifiers;
+
+        for (int i = 0; i < numIdentifiers; ++i)
+        {
+            auto name = input.readString();
+
+            if (name.isEmpty())
+                return false;
+
+            identifiers.add (name);
+        }
+
+        const int numChanges = input.readCompressedInt();
+        Array<int> path;
+
+        for (int i = 0; i < numChanges; ++i)
+        {
+            auto type = (ChangeType) input.readByte();
+
+            // each path is sent as the number of levels it shares with the previous one, followed by the rest
+            auto numSharedLevels = input.readCompressedInt();
+            auto numNewLevels = input.readCompressedInt();
+
+            if (! (isPositiveAndNotGreaterThan (numSharedLevels, path.size()) && isPositiveAndBelow (numNewLevels, 65536)))
+                return false;
+
+            path.resize (numSharedLevels);
+
+            for (int j = 0; j < numNewLevels; ++j)
+                path.add (input.readCompressedInt());
+
+            auto v = root;
+
+            for (auto index : path)
+            {
+                if (! isPositiveAndBelow (index, v.getNumChildren()))
+                    return false;
+
+                v = v.getChild (index);
+            }
+
+            if (! applyChangeToTree (v, type, input, &identifiers, undoManager))
+                return false;
+        }
+
+        return true;
+    }
 }
 
+//==============================================================================
+struct ValueTreeSynchroniser::PendingChanges
+{
+    using ChangeType = ValueTreeSynchroniserHelpers::ChangeType;
+
+    struct Change
+    {
+        ChangeType type;
+        Array<int> path;
+        int propertyIndex;
+        MemoryBlock payload;
+        bool superseded;
+    };
+
+    void addPropertyChange (ChangeType type, const Array<int>& path, const Identifier& property, MemoryBlock payload)
+    {
+        auto propertyIndex = getIdentifierIndex (property);
+
+        // Setting a property again makes any earlier write to it redundant. Property changes don't
+        // affect each other, so the new value can be moved to the end, as long as nothing that could
+        // change the paths has happened in between.
+        String key;
+
+        for (auto index : path)
+            key << index << '/';
+
+        key << propertyIndex;
+
+        if (latestPropertyChanges.contains (key))
+            changes.getUnchecked (latestPropertyChanges[key])->superseded = true;
+
+        latestPropertyChanges.set (key, changes.size());
+        changes.add (new Change { type, path, propertyIndex, std::move (payload), false });
+    }
+
+    void addStructuralChange (ChangeType type, const Array<int>& path, MemoryBlock payload)
+    {
+        latestPropertyChanges.clear();
+        changes.add (new Change { type, path, -1, std::move (payload), false });
+    }
+
+    bool isEmpty() const noexcept          { return changes.isEmpty(); }
+
+    MemoryBlock createBatch (bool useCompression) const
+    {
+        MemoryOutputStream body;
+        body.writeCompressedInt (identifiers.size());
+
+        for (auto& name : identifiers)
+            body.writeString (name);
+
+        int numChanges = 0;
+
+        for (auto* c : changes)
+            if (! c->superseded)
+                ++numChanges;
+
+        body.writeCompressedInt (numChanges);
+
+        const Array<int>* previousPath = nullptr;
+
+        for (auto* c : changes)
+        {
+            if (c->superseded)
+                continue;
+
+            int numSharedLevels = 0;
+
+            if (previousPath != nullptr)
+                while (numSharedLevels < jmin (previousPath->size(), c->path.size())
+                        && previousPath->getUnchecked (numSharedLevels) == c->path.getUnchecked (numSharedLevels))
+                    ++numSharedLevels;
+
+            body.writeByte ((char) c->type);
+            body.writeCompressedInt (numSharedLevels);
+            body.writeCompressedInt (c->path.size() - numSharedLevels);
+
+            for (int i = numSharedLevels; i < c->path.size(); ++i)
+                body.writeCompressedInt (c->path.getUnchecked (i));
+
+            if (c->propertyIndex >= 0)
+                body.writeCompressedInt (c->propertyIndex);
+
+            body << c->payload;
+            previousPath = &(c->path);
+        }
+
+        MemoryOutputStream result;
+        ValueTreeSynchroniserHelpers::writeHeader (result, useCompression ? ValueTreeSynchroniserHelpers::compressedBatch
+                                                                          : ValueTreeSynchroniserHelpers::batch);
+
+        if (useCompression)
+        {
+            GZIPCompressorOutputStream compressor (result);
+            compressor.write (body.getData(), body.getDataSize());
+        }
+        else
+        {
+            result << body.getMemoryBlock();
+        }
+
+        return result.getMemoryBlock();
+    }
+
+private:
+    OwnedArray<Change> changes;
+    StringArray identifiers;
+    HashMap<String, int> identifierIndexes, latestPropertyChanges;
+
+    int getIdentifierIndex (const Identifier& property)
+    {
+        auto name = property.toString();
+
+        if (identifierIndexes.contains (name))
+            return identifierIndexes[name];
+
+        identifierIndexes.set (name, identifiers.size());
+        identifiers.add (name);
+        return identifiers.size() - 1;
+    }
+};
+
 ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
 {
     valueTree.addListener (this);
@@ -103,8 +367,64 @@ ValueTreeSynchroniser::~ValueTreeSynchroniser()
     valueTree.removeListener (this);
 }
 
+void ValueTreeSynchroniser::setBatching (int newFlushIntervalMs, bool shouldCompressBatches)
+{
+    flushPendingChanges();
+
+    flushIntervalMs = jmax (0, newFlushIntervalMs);
+    compressBatches = shouldCompressBatches;
+}
+
+void ValueTreeSynchroniser::flushPendingChanges()
+{
+    stopTimer();
+
+    if (pendingChanges != nullptr)
+    {
+        std::unique_ptr<PendingChanges> changes;
+        std::swap (changes, pendingChanges);
+
+        auto data = changes->createBatch (compressBatches);
+        stateChanged (data.getData(), data.getSize());
+    }
+}
+
+void ValueTreeSynchroniser::timerCallback()
+{
+    flushPendingChanges();
+}
+
+ValueTreeSynchroniser::PendingChanges* ValueTreeSynchroniser::getPendingChanges()
+{
+    if (flushIntervalMs <= 0)
+        return nullptr;
+
+    if (pendingChanges == nullptr)
+    {
+        pendingChanges.reset (new PendingChanges());
+        startTimer (flushIntervalMs);
+    }
+
+    return pendingChanges.get();
+}
+
+static Array<int> getPathFromRoot (const ValueTree& v, const ValueTree& root)
+{
+    Array<int> path;
+    ValueTreeSynchroniserHelpers::getValueTreePath (v, root, path);
+
+    for (int i = 0, j = path.size() - 1; i < j; ++i, --j)
+        path.swap (i, j);
+
+    return path;
+}
+
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    // a full sync makes anything that's still waiting to be sent redundant
+    stopTimer();
+    pendingChanges.reset();
+
     MemoryOutputStream m;
     writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
     valueTree.writeToStream (m);
@@ -113,6 +433,25 @@ void ValueTreeSynchroniser::sendFullSyncCallback()
 
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
+    if (auto* pending = getPendingChanges())
+    {
+        MemoryOutputStream payload;
+
+        if (auto* value = vt.getPropertyPointer (property))
+        {
+            value->writeToStream (payload);
+            pending->addPropertyChange (ValueTreeSynchroniserHelpers::propertyChanged, getPathFromRoot (vt, valueTree),
+                                        property, payload.getMemoryBlock());
+        }
+        else
+        {
+            pending->addPropertyChange (ValueTreeSynchroniserHelpers::propertyRemoved, getPathFromRoot (vt, valueTree),
+                                        property, {});
+        }
+
+        return;
+    }
+
     MemoryOutputStream m;
 
     if (auto* value = vt.getPropertyPointer (property))
@@ -135,6 +474,16 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     const int index = parentTree.indexOf (childTree);
     jassert (index >= 0);
 
+    if (auto* pending = getPendingChanges())
+    {
+        MemoryOutputStream payload;
+        payload.writeCompressedInt (index);
+        childTree.writeToStream (payload);
+        pending->addStructuralChange (ValueTreeSynchroniserHelpers::childAdded, getPathFromRoot (parentTree, valueTree),
+                                      payload.getMemoryBlock());
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
@@ -144,6 +493,15 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
 
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
 {
+    if (auto* pending = getPendingChanges())
+    {
+        MemoryOutputStream payload;
+        payload.writeCompressedInt (oldIndex);
+        pending->addStructuralChange (ValueTreeSynchroniserHelpers::childRemoved, getPathFromRoot (parentTree, valueTree),
+                                      payload.getMemoryBlock());
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
@@ -152,6 +510,16 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
 {
+    if (auto* pending = getPendingChanges())
+    {
+        MemoryOutputStream payload;
+        payload.writeCompressedInt (oldIndex);
+        payload.writeCompressedInt (newIndex);
+        pending->addStructuralChange (ValueTreeSynchroniserHelpers::childMoved, getPathFromRoot (parent, valueTree),
+                                      payload.getMemoryBlock());
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
@@ -173,70 +541,110 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         return true;
     }
 
+    if (type == ValueTreeSynchroniserHelpers::batch)
+        return ValueTreeSynchroniserHelpers::applyBatch (root, input, undoManager);
+
+    if (type == ValueTreeSynchroniserHelpers::compressedBatch)
+    {
+        MemoryBlock body;
+        GZIPDecompressorInputStream decompressor (input);
+        decompressor.readIntoMemoryBlock (body);
+
+        MemoryInputStream bodyInput (body, false);
+        return ValueTreeSynchroniserHelpers::applyBatch (root, bodyInput, undoManager);
+    }
+
     ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
 
     if (! v.isValid())
         return false;
 
-    switch (type)
+    return ValueTreeSynchroniserHelpers::applyChangeToTree (v, type, input, nullptr, undoManager);
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSynchroniserTests  : public UnitTest
+{
+public:
+    ValueTreeSynchroniserTests() : UnitTest ("ValueTreeSynchroniser", "Values") {}
+
+    struct TestSynchroniser  : public ValueTreeSynchroniser
     {
-        case ValueTreeSynchroniserHelpers::propertyChanged:
-        {
-            Identifier property (input.readString());
-            v.setProperty (property, var::readFromStream (input), undoManager);
-            return true;
-        }
+        TestSynchroniser (const ValueTree& source, ValueTree& dest)  : ValueTreeSynchroniser (source), target (dest) {}
 
-        case ValueTreeSynchroniserHelpers::propertyRemoved:
+        void stateChanged (const void* data, size_t size) override
         {
-            Identifier property (input.readString());
-            v.removeProperty (property, undoManager);
-            return true;
+            ++numMessages;
+            numBytes += size;
+            allApplied = applyChange (target, data, size, nullptr) && allApplied;
         }
 
-        case ValueTreeSynchroniserHelpers::childAdded:
-        {
-            const int index = input.readCompressedInt();
-            v.addChild (ValueTree::readFromStream (input), index, undoManager);
-            return true;
-        }
+        ValueTree& target;
+        int numMessages = 0;
+        size_t numBytes = 0;
+        bool allApplied = true;
+    };
 
-        case ValueTreeSynchroniserHelpers::childRemoved:
-        {
-            const int index = input.readCompressedInt();
+    void runTest() override
+    {
+        beginTest ("Batched changes");
 
-            if (isPositiveAndBelow (index, v.getNumChildren()))
-            {
-                v.removeChild (index, undoManager);
-                return true;
-            }
+        auto r = getRandom();
+        const Identifier names[] = { "position", "gain", "name", "colour" };
 
-            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
-            break;
-        }
+        ValueTree source ("root");
+        ValueTree plainTarget, batchedTarget, compressedTarget;
+
+        TestSynchroniser plain (source, plainTarget), batched (source, batchedTarget), compressed (source, compressedTarget);
+        batched.setBatching (1000);
+        compressed.setBatching (1000, true);
+
+        for (auto* s : { &plain, &batched, &compressed })
+            s->sendFullSyncCallback();
 
-        case ValueTreeSynchroniserHelpers::childMoved:
+        for (int i = 0; i < 2000; ++i)
         {
-            const int oldIndex = input.readCompressedInt();
-            const int newIndex = input.readCompressedInt();
+            auto v = source;
 
-            if (isPositiveAndBelow (oldIndex, v.getNumChildren())
-                 && isPositiveAndBelow (newIndex, v.getNumChildren()))
+            while (v.getNumChildren() > 0 && r.nextInt (3) != 0)
+                v = v.getChild (r.nextInt (v.getNumChildren()));
+
+            switch (r.nextInt (8))
             {
-                v.moveChild (oldIndex, newIndex, undoManager);
-                return true;
+                case 0:  v.appendChild (ValueTree (names[r.nextInt (4)]), nullptr); break;
+                case 1:  if (v.getNumChildren() > 0) v.removeChild (r.nextInt (v.getNumChildren()), nullptr); break;
+                case 2:  if (v.getNumChildren() > 1) v.moveChild (r.nextInt (v.getNumChildren()), r.nextInt (v.getNumChildren()), nullptr); break;
+                case 3:  v.removeProperty (names[r.nextInt (4)], nullptr); break;
+                default: v.setProperty (names[r.nextInt (4)], r.nextInt (100), nullptr); break;
             }
 
-            jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
-            break;
+            if (r.nextInt (200) == 0)
+            {
+                batched.flushPendingChanges();
+                compressed.flushPendingChanges();
+            }
         }
 
-        default:
-            jassertfalse; // Seem to have received some corrupt data?
-            break;
+        batched.flushPendingChanges();
+        compressed.flushPendingChanges();
+
+        for (auto* s : { &plain, &batched, &compressed })
+            expect (s->allApplied);
+
+        expect (plainTarget.isEquivalentTo (source));
+        expect (batchedTarget.isEquivalentTo (source));
+        expect (compressedTarget.isEquivalentTo (source));
+
+        expect (batched.numMessages < plain.numMessages);
+        expect (batched.numBytes < plain.numBytes);
+        expect (compressed.numBytes < batched.numBytes);
     }
+};
 
-    return false;
-}
+static ValueTreeSynchroniserTests valueTreeSynchroniserTests;
+
+#endif
 
 } // namespace juce
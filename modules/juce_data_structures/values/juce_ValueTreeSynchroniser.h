@@ -41,9 +41,14 @@ namespace juce
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
 
+    By default, every change is sent as soon as it happens. If the tree changes
+    rapidly, you can use setBatching() to collect the changes and send them in a
+    single, more compact message at regular intervals instead.
+
     @tags{DataStructures}
 */
-class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
+class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener,
+                                         private Timer
 {
 public:
     /** Creates a ValueTreeSynchroniser that watches the given tree.
@@ -71,6 +76,37 @@ public:
     */
     void sendFullSyncCallback();
 
+    /** Makes the synchroniser collect changes and send them in batches, rather than
+        calling stateChanged() for each one.
+
+        When a change happens, a timer is started, and after flushIntervalMs, all the
+        changes which have happened since then are sent as a single message. Within a
+        batch, repeated changes to the same property are collapsed into one, property
+        names are only written once, and the positions of the trees that changed are
+        delta-encoded. If compressBatches is true, the whole batch is also compressed,
+        which is worth doing if the data goes over a slow link.
+
+        The timer runs on the message thread, so if your tree changes on another thread,
+        you'll need to call flushPendingChanges() yourself. Passing 0 for the interval
+        switches batching off again. Any changes that are waiting to be sent when this
+        is called are sent first.
+
+        applyChange() can handle both batched and unbatched messages.
+
+        @see flushPendingChanges
+    */
+    void setBatching (int flushIntervalMs, bool compressBatches = false);
+
+    /** If batching is enabled and there are changes waiting to be sent, this sends
+        them now (by calling stateChanged()).
+
+        Note that any changes that are still pending when the synchroniser is deleted
+        are discarded, so you may want to call this from your subclass's destructor.
+
+        @see setBatching
+    */
+    void flushPendingChanges();
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
@@ -87,6 +123,14 @@ public:
 private:
     ValueTree valueTree;
 
+    struct PendingChanges;
+    std::unique_ptr<PendingChanges> pendingChanges;
+    int flushIntervalMs = 0;
+    bool compressBatches = false;
+
+    PendingChanges* getPendingChanges();
+    void timerCallback() override;
+
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
     void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class ValueTreeBenchmarks  : public Benchmark
+{
+public:
+    ValueTreeBenchmarks()  : Benchmark ("ValueTree", "Values") {}
+
+    void runBenchmark() override
+    {
+        ValueTree tree ("root");
+
+        for (int i = 0; i < 100; ++i)
+        {
+            ValueTree child ("child");
+            child.setProperty ("index", i, nullptr);
+            child.setProperty ("name", "child " + String (i), nullptr);
+            tree.appendChild (child, nullptr);
+        }
+
+        const Identifier indexID ("index"), nameID ("name");
+
+        measure ("getProperty", [&]
+        {
+            doNotOptimiseAway (tree.getChild (50).getProperty (indexID));
+        });
+
+        int counter = 0;
+
+        measure ("setProperty", [&]
+        {
+            tree.getChild (50).setProperty (indexID, ++counter, nullptr);
+        });
+
+        measure ("getChildWithProperty", [&]
+        {
+            doNotOptimiseAway (tree.getChildWithProperty (indexID, 99));
+        });
+
+        measure ("createCopy", [&]
+        {
+            doNotOptimiseAway (tree.createCopy());
+        });
+
+        measure ("appendChild and removeChild", [&]
+        {
+            tree.appendChild (ValueTree ("extra"), nullptr);
+            tree.removeChild (tree.getNumChildren() - 1, nullptr);
+        });
+
+        MemoryBlock data;
+
+        {
+            MemoryOutputStream out (data, false);
+            tree.writeToStream (out);
+        }
+
+        measure ("readFromData", [&]
+        {
+            doNotOptimiseAway (ValueTree::readFromData (data.getData(), data.getSize()));
+        });
+    }
+};
+
+static ValueTreeBenchmarks valueTreeBenchmarks;
+
+} // namespace juce
@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+namespace dsp
+{
+
+SIMDInstructionSet getBestSIMDInstructionSetForThisCPU() noexcept
+{
+   #if defined(__arm__) || defined(_M_ARM) || defined (__arm64__) || defined (__aarch64__)
+    return SIMDInstructionSet::neon;
+   #else
+    if (SystemStats::hasAVX512F() && SystemStats::hasAVX512BW())
+        return SIMDInstructionSet::avx512;
+
+    if (SystemStats::hasAVX2())
+        return SIMDInstructionSet::avx2;
+
+    return SIMDInstructionSet::sse2;
+   #endif
+}
+
+bool isSIMDInstructionSetAvailable (SIMDInstructionSet instructionSet) noexcept
+{
+    auto best = getBestSIMDInstructionSetForThisCPU();
+
+    if (best == SIMDInstructionSet::neon || instructionSet == SIMDInstructionSet::neon)
+        return best == instructionSet;
+
+    return static_cast<int> (instructionSet) <= static_cast<int> (best);
+}
+
+} // namespace dsp
+} // namespace juce
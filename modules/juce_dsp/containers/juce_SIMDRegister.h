@@ -29,6 +29,58 @@ namespace juce
 namespace dsp
 {
 
+//==============================================================================
+/** The instruction sets that SIMDRegister can be built for.
+
+    Which one a SIMDRegister uses is fixed when the code is compiled (see
+    SIMDRegister::instructionSet), but you can compile the same dsp code several
+    times with different compiler flags and pick the fastest version at runtime:
+
+    @code
+    // MyProcessing_avx512.cpp, compiled with -mavx512f -mavx512bw (or /arch:AVX512)
+    #include <juce_dsp/juce_dsp.h>
+    #include <juce_dsp/native/juce_SIMDNativeOps.cpp>   // exactly once per instruction set
+
+    void processAVX512 (float* data, int numSamples) { ... uses dsp::SIMDRegister<float> ... }
+
+    // MyProcessing.cpp, compiled with the default flags
+    void process (float* data, int numSamples)
+    {
+        static const bool useAVX512 = dsp::isSIMDInstructionSetAvailable (dsp::SIMDInstructionSet::avx512);
+
+        if (useAVX512)  processAVX512 (data, numSamples);
+        else            processDefault (data, numSamples);
+    }
+    @endcode
+
+    SIMDRegister and its native ops live in an inline namespace named after the
+    instruction set, so the different builds don't clash with each other at link time.
+    The rest of JUCE doesn't do this, so keep the code that is compiled with the extra
+    flags to SIMDRegister and your own functions: any other inline or template code it
+    instantiates (e.g. dsp::LadderFilter, FloatVectorOperations) may end up being shared
+    with TUs that are run on CPUs without the extra instructions.
+
+    @see getBestSIMDInstructionSetForThisCPU, isSIMDInstructionSetAvailable
+
+    @tags{DSP}
+*/
+enum class SIMDInstructionSet
+{
+    sse2,       /**< SSE2, 128-bit registers. */
+    avx2,       /**< AVX2, 256-bit registers. */
+    avx512,     /**< AVX-512 F and BW, 512-bit registers. */
+    neon        /**< ARM NEON, 128-bit registers. */
+};
+
+/** Returns the widest SIMDInstructionSet that the CPU running this code supports. */
+SIMDInstructionSet getBestSIMDInstructionSetForThisCPU() noexcept;
+
+/** Returns true if code built for the given SIMDInstructionSet can be run on this CPU. */
+bool isSIMDInstructionSetAvailable (SIMDInstructionSet) noexcept;
+
+inline namespace JUCE_DSP_SIMD_NAMESPACE
+{
+
 #ifndef DOXYGEN
  // This class is needed internally.
  template <typename Scalar>
@@ -106,6 +158,9 @@ struct SIMDRegister
     /** The number of elements that this vector can hold. */
     static constexpr size_t SIMDNumElements = SIMDRegisterSize / sizeof (ElementType);
 
+    /** The instruction set that this register was compiled for. */
+    static constexpr SIMDInstructionSet instructionSet = SIMDInstructionSet::JUCE_DSP_SIMD_NAMESPACE;
+
     vSIMDType value;
 
     /** Default constructor. */
@@ -190,6 +245,9 @@ struct SIMDRegister
     /** Multiplies another SIMDRegister to the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator*= (SIMDRegister v) noexcept      { value = CmplxOps::mul (value, v.value); return *this; }
 
+    /** Divides the receiver by another SIMDRegister. This is only available for float and double. */
+    inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator/= (SIMDRegister v) noexcept      { value = NativeOps::div (value, v.value); return *this; }
+
     //==============================================================================
     /** Broadcasts the scalar to all elements of the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator=  (ElementType s) noexcept       { value  = CmplxOps::expand (s); return *this; }
@@ -203,6 +261,9 @@ struct SIMDRegister
     /** Multiplies a scalar to the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator*= (ElementType s) noexcept       { value = CmplxOps::mul (value, CmplxOps::expand (s)); return *this; }
 
+    /** Divides the receiver by a scalar. This is only available for float and double. */
+    inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator/= (ElementType s) noexcept       { value = NativeOps::div (value, CmplxOps::expand (s)); return *this; }
+
     //==============================================================================
     /** Bit-and the reciver with SIMDRegister v and store the result in the receiver. */
     inline SIMDRegister& JUCE_VECTOR_CALLTYPE operator&= (vMaskType v) noexcept         { value = NativeOps::bit_and (value, toVecType (v.value)); return *this; }
@@ -233,6 +294,9 @@ struct SIMDRegister
     /** Returns the product of the receiver and v.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator* (SIMDRegister v) const noexcept  { return { CmplxOps::mul (value, v.value) }; }
 
+    /** Returns the quotient of the receiver and v. This is only available for float and double.*/
+    inline SIMDRegister JUCE_VECTOR_CALLTYPE operator/ (SIMDRegister v) const noexcept  { return { NativeOps::div (value, v.value) }; }
+
     //==============================================================================
     /** Returns a vector where each element is the sum of the corresponding element in the receiver and the scalar s.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator+ (ElementType s) const noexcept   { return { NativeOps::add (value, CmplxOps::expand (s)) }; }
@@ -243,6 +307,11 @@ struct SIMDRegister
     /** Returns a vector where each element is the product of the corresponding element in the receiver and the scalar s.*/
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator* (ElementType s) const noexcept   { return { CmplxOps::mul (value, CmplxOps::expand (s)) }; }
 
+    /** Returns a vector where each element is the quotient of the corresponding element in the receiver and the scalar s.
+        This is only available for float and double.
+    */
+    inline SIMDRegister JUCE_VECTOR_CALLTYPE operator/ (ElementType s) const noexcept   { return { NativeOps::div (value, CmplxOps::expand (s)) }; }
+
     //==============================================================================
     /** Returns the bit-and of the receiver and v. */
     inline SIMDRegister JUCE_VECTOR_CALLTYPE operator& (vMaskType v) const noexcept     { return { NativeOps::bit_and (value, toVecType (v.value)) }; }
@@ -391,6 +460,7 @@ private:
     }
 };
 
+} // namespace JUCE_DSP_SIMD_NAMESPACE
 } // namespace dsp
 } // namespace juce
 
@@ -28,6 +28,8 @@ namespace juce
 {
 namespace dsp
 {
+inline namespace JUCE_DSP_SIMD_NAMESPACE
+{
 
 
 //==============================================================================
@@ -160,6 +162,8 @@ struct CmplxSIMDOps<std::complex<Scalar>>
 };
 #endif
 
+} // namespace JUCE_DSP_SIMD_NAMESPACE
+
 //==============================================================================
  namespace util
  {
@@ -239,6 +239,21 @@ public:
         }
     };
 
+    struct Division
+    {
+        template <typename typeOne, typename typeTwo>
+        static void inplace (typeOne& a, const typeTwo& b)
+        {
+            a /= b;
+        }
+
+        template <typename typeOne, typename typeTwo>
+        static typeOne outofplace (const typeOne& a, const typeTwo& b)
+        {
+            return a / b;
+        }
+    };
+
     struct BitAND
     {
         template <typename typeOne, typename typeTwo>
@@ -813,6 +828,17 @@ public:
         TheTest::template run<uint64_t>(*this, random);
     }
 
+    template <class TheTest>
+    void runTestFloatingPoint (const char* unitTestName)
+    {
+        beginTest (unitTestName);
+
+        Random random = getRandom();
+
+        TheTest::template run<float>   (*this, random);
+        TheTest::template run<double>  (*this, random);
+    }
+
     void runTest()
     {
         runTestForAllTypes<InitializationTest> ("InitializationTest");
@@ -822,6 +848,7 @@ public:
         runTestForAllTypes<OperatorTests<Addition>> ("AdditionOperators");
         runTestForAllTypes<OperatorTests<Subtraction>> ("SubtractionOperators");
         runTestForAllTypes<OperatorTests<Multiplication>> ("MultiplicationOperators");
+        runTestFloatingPoint<OperatorTests<Division>> ("DivisionOperators");
 
         runTestForAllTypes<BitOperatorTests<BitAND>> ("BitANDOperators");
         runTestForAllTypes<BitOperatorTests<BitOR>>  ("BitOROperators");
@@ -833,6 +860,17 @@ public:
 
         runTestForAllTypes<CheckMultiplyAdd> ("CheckMultiplyAdd");
         runTestForAllTypes<CheckSum> ("CheckSum");
+
+        beginTest ("InstructionSet");
+        {
+            // if we've got this far, the CPU must be able to run the code that we were built for
+            const SIMDInstructionSet builtFor = SIMDRegister<float>::instructionSet;
+            expect (isSIMDInstructionSetAvailable (builtFor));
+            expect (isSIMDInstructionSetAvailable (getBestSIMDInstructionSetForThisCPU()));
+
+            size_t expectedSize = builtFor == SIMDInstructionSet::avx512 ? 64 : (builtFor == SIMDInstructionSet::avx2 ? 32 : 16);
+            expectEquals ((int) SIMDRegister<float>::SIMDRegisterSize, (int) expectedSize);
+        }
     }
 };
 
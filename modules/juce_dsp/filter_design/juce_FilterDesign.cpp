@@ -29,6 +29,168 @@ namespace juce
 namespace dsp
 {
 
+//==============================================================================
+/** The parameters of a call to one FilterDesign method, used to find its result
+    in a FilterDesignCache.
+*/
+struct FilterDesignCacheKey
+{
+    enum Method
+    {
+        windowMethod,
+        transitionMethod,
+        leastSquaresMethod,
+        halfBandEquirippleMethod,
+        generalIIRMethod,
+        butterworthLowpassMethod,
+        butterworthHighpassMethod,
+        polyphaseAllpassMethod
+    };
+
+    bool operator== (const FilterDesignCacheKey& other) const noexcept    { return method == other.method && parameters == other.parameters; }
+
+    Method method;
+    std::array<double, 6> parameters;
+};
+
+/** Remembers the results of the most recent FilterDesign calls, so that designing
+    the same filter again only has to copy the coefficients. The entries are kept by
+    value, and every lookup returns fresh coefficient objects, so the callers never
+    share any state.
+*/
+template <typename FloatType>
+struct FilterDesignCache
+{
+    using FIRCoefficientsPtr = typename FIR::Coefficients<FloatType>::Ptr;
+    using IIRCoefficients    = IIR::Coefficients<FloatType>;
+
+    static FIRCoefficientsPtr findFIR (const FilterDesignCacheKey& key)
+    {
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        for (auto& entry : cache.firEntries)
+            if (entry.key == key)
+                return new FIR::Coefficients<FloatType> (entry.value.begin(), (size_t) entry.value.size());
+
+        return nullptr;
+    }
+
+    static FIRCoefficientsPtr addFIR (const FilterDesignCacheKey& key, FIR::Coefficients<FloatType>& result)
+    {
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        addEntry (cache.firEntries, key, result.coefficients);
+        return result;
+    }
+
+    static bool findIIR (const FilterDesignCacheKey& key, ReferenceCountedArray<IIRCoefficients>& result)
+    {
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        for (auto& entry : cache.iirEntries)
+        {
+            if (entry.key == key)
+            {
+                for (auto& coefficients : entry.value)
+                    result.add (new IIRCoefficients (coefficients));
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static ReferenceCountedArray<IIRCoefficients> addIIR (const FilterDesignCacheKey& key,
+                                                          const ReferenceCountedArray<IIRCoefficients>& result)
+    {
+        Array<IIRCoefficients> copies;
+
+        for (auto* coefficients : result)
+            copies.add (*coefficients);
+
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        addEntry (cache.iirEntries, key, copies);
+        return result;
+    }
+
+    static bool findAlphas (const FilterDesignCacheKey& key, Array<double>& result)
+    {
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        for (auto& entry : cache.alphaEntries)
+        {
+            if (entry.key == key)
+            {
+                result = entry.value;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static void addAlphas (const FilterDesignCacheKey& key, const Array<double>& alphas)
+    {
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        addEntry (cache.alphaEntries, key, alphas);
+    }
+
+    static void clear()
+    {
+        auto& cache = getInstance();
+        const ScopedLock sl (cache.lock);
+
+        cache.firEntries.clear();
+        cache.iirEntries.clear();
+        cache.alphaEntries.clear();
+    }
+
+private:
+    template <typename ValueType>
+    struct Entry
+    {
+        FilterDesignCacheKey key;
+        ValueType value;
+    };
+
+    enum { maxNumEntries = 64 };
+
+    template <typename ValueType>
+    static void addEntry (Array<Entry<ValueType>>& entries, const FilterDesignCacheKey& key, const ValueType& value)
+    {
+        // Two threads may have designed the same filter at the same time
+        for (auto& entry : entries)
+            if (entry.key == key)
+                return;
+
+        if (entries.size() >= maxNumEntries)
+            entries.remove (0);
+
+        entries.add ({ key, value });
+    }
+
+    static FilterDesignCache& getInstance()
+    {
+        static FilterDesignCache cache;
+        return cache;
+    }
+
+    CriticalSection lock;
+    Array<Entry<Array<FloatType>>> firEntries;
+    Array<Entry<Array<IIRCoefficients>>> iirEntries;
+    Array<Entry<Array<double>>> alphaEntries;
+};
+
+//==============================================================================
 template <typename FloatType>
 typename FIR::Coefficients<FloatType>::Ptr
     FilterDesign<FloatType>::designFIRLowpassWindowMethod (FloatType frequency,
@@ -39,6 +201,11 @@ typename FIR::Coefficients<FloatType>::Ptr
     jassert (sampleRate > 0);
     jassert (frequency > 0 && frequency <= sampleRate * 0.5);
 
+    const FilterDesignCacheKey key { FilterDesignCacheKey::windowMethod, { (double) frequency, sampleRate, (double) order, (double) type, (double) beta } };
+
+    if (auto cached = FilterDesignCache<FloatType>::findFIR (key))
+        return cached;
+
     auto* result = new typename FIR::Coefficients<FloatType> (order + 1u);
 
     auto* c = result->getRawCoefficients();
@@ -60,7 +227,7 @@ typename FIR::Coefficients<FloatType>::Ptr
     WindowingFunction<FloatType> theWindow (order + 1, type, false, beta);
     theWindow.multiplyWithWindowingTable (c, order + 1);
 
-    return *result;
+    return FilterDesignCache<FloatType>::addFIR (key, *result);
 }
 
 template <typename FloatType>
@@ -101,6 +268,11 @@ typename FIR::Coefficients<FloatType>::Ptr
     jassert (normalisedTransitionWidth > 0 && normalisedTransitionWidth <= 0.5);
     jassert (spline >= 1.0 && spline <= 4.0);
 
+    const FilterDesignCacheKey key { FilterDesignCacheKey::transitionMethod, { (double) frequency, sampleRate, (double) order, (double) normalisedTransitionWidth, (double) spline } };
+
+    if (auto cached = FilterDesignCache<FloatType>::findFIR (key))
+        return cached;
+
     auto normalisedFrequency = frequency / static_cast<FloatType> (sampleRate);
 
     auto* result = new typename FIR::Coefficients<FloatType> (order + 1u);
@@ -121,7 +293,7 @@ typename FIR::Coefficients<FloatType>::Ptr
         }
     }
 
-    return *result;
+    return FilterDesignCache<FloatType>::addFIR (key, *result);
 }
 
 template <typename FloatType>
@@ -136,6 +308,11 @@ typename FIR::Coefficients<FloatType>::Ptr
     jassert (normalisedTransitionWidth > 0 && normalisedTransitionWidth <= 0.5);
     jassert (stopBandWeight >= 1.0 && stopBandWeight <= 100.0);
 
+    const FilterDesignCacheKey key { FilterDesignCacheKey::leastSquaresMethod, { (double) frequency, sampleRate, (double) order, (double) normalisedTransitionWidth, (double) stopBandWeight } };
+
+    if (auto cached = FilterDesignCache<FloatType>::findFIR (key))
+        return cached;
+
     auto normalisedFrequency = static_cast<double> (frequency) / sampleRate;
 
     auto wp = MathConstants<double>::twoPi * (static_cast<double> (normalisedFrequency - normalisedTransitionWidth / 2.0));
@@ -231,7 +408,7 @@ typename FIR::Coefficients<FloatType>::Ptr
         }
     }
 
-    return *result;
+    return FilterDesignCache<FloatType>::addFIR (key, *result);
 }
 
 template <typename FloatType>
@@ -242,6 +419,11 @@ typename FIR::Coefficients<FloatType>::Ptr
     jassert (normalisedTransitionWidth > 0 && normalisedTransitionWidth <= 0.5);
     jassert (amplitudedB >= -300 && amplitudedB <= -10);
 
+    const FilterDesignCacheKey key { FilterDesignCacheKey::halfBandEquirippleMethod, { (double) normalisedTransitionWidth, (double) amplitudedB } };
+
+    if (auto cached = FilterDesignCache<FloatType>::findFIR (key))
+        return cached;
+
     auto wpT = (0.5 - normalisedTransitionWidth) * MathConstants<double>::pi;
 
     auto n = roundToInt (std::ceil ((amplitudedB - 18.18840664 * wpT + 33.64775300) / (18.54155181 * wpT - 29.13196871)));
@@ -290,7 +472,7 @@ typename FIR::Coefficients<FloatType>::Ptr
 
     c[2 * n + 1] = static_cast<FloatType> (0.5);
 
-    return *result;
+    return FilterDesignCache<FloatType>::addFIR (key, *result);
 }
 
 template <typename FloatType>
@@ -393,6 +575,13 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
     jassert (passbandAmplitudedB > -20 && passbandAmplitudedB < 0);
     jassert (stopbandAmplitudedB > -300 && stopbandAmplitudedB < -20);
 
+    const FilterDesignCacheKey key { FilterDesignCacheKey::generalIIRMethod, { (double) type, (double) frequency, sampleRate, (double) normalisedTransitionWidth, (double) passbandAmplitudedB, (double) stopbandAmplitudedB } };
+
+    ReferenceCountedArray<IIR::Coefficients<FloatType>> cached;
+
+    if (FilterDesignCache<FloatType>::findIIR (key, cached))
+        return cached;
+
     auto normalisedFrequency = frequency / sampleRate;
 
     auto fp = normalisedFrequency - normalisedTransitionWidth / 2;
@@ -535,7 +724,7 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
         cascadedCoefficients.add (new IIR::Coefficients<FloatType> (b0, b1, b2, 1, a1, a2));
     }
 
-    return cascadedCoefficients;
+    return FilterDesignCache<FloatType>::addIIR (key, cascadedCoefficients);
 }
 
 template <typename FloatType>
@@ -547,6 +736,13 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
     jassert (frequency > 0 && frequency <= sampleRate * 0.5);
     jassert (order > 0);
 
+    const FilterDesignCacheKey key { FilterDesignCacheKey::butterworthLowpassMethod, { (double) frequency, sampleRate, (double) order } };
+
+    ReferenceCountedArray<IIR::Coefficients<FloatType>> cached;
+
+    if (FilterDesignCache<FloatType>::findIIR (key, cached))
+        return cached;
+
     ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
 
     if (order % 2 == 1)
@@ -570,7 +766,7 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
         }
     }
 
-    return arrayFilters;
+    return FilterDesignCache<FloatType>::addIIR (key, arrayFilters);
 }
 
 template <typename FloatType>
@@ -582,6 +778,13 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
     jassert (frequency > 0 && frequency <= sampleRate * 0.5);
     jassert (order > 0);
 
+    const FilterDesignCacheKey key { FilterDesignCacheKey::butterworthHighpassMethod, { (double) frequency, sampleRate, (double) order } };
+
+    ReferenceCountedArray<IIR::Coefficients<FloatType>> cached;
+
+    if (FilterDesignCache<FloatType>::findIIR (key, cached))
+        return cached;
+
     ReferenceCountedArray<IIR::Coefficients<FloatType>> arrayFilters;
 
     if (order % 2 == 1)
@@ -605,17 +808,13 @@ ReferenceCountedArray<IIR::Coefficients<FloatType>>
         }
     }
 
-    return arrayFilters;
+    return FilterDesignCache<FloatType>::addIIR (key, arrayFilters);
 }
 
 template <typename FloatType>
-typename FilterDesign<FloatType>::IIRPolyphaseAllpassStructure
-    FilterDesign<FloatType>::designIIRLowpassHalfBandPolyphaseAllpassMethod (FloatType normalisedTransitionWidth,
-                                                                             FloatType stopbandAmplitudedB)
+Array<double> FilterDesign<FloatType>::getHalfBandPolyphaseAllpassAlphas (FloatType normalisedTransitionWidth,
+                                                                          FloatType stopbandAmplitudedB)
 {
-    jassert (normalisedTransitionWidth > 0 && normalisedTransitionWidth <= 0.5);
-    jassert (stopbandAmplitudedB > -300 && stopbandAmplitudedB < -10);
-
     const double wt = MathConstants<double>::twoPi * normalisedTransitionWidth;
     const double ds = Decibels::decibelsToGain (stopbandAmplitudedB, static_cast<FloatType> (-300.0));
 
@@ -675,6 +874,28 @@ typename FilterDesign<FloatType>::IIRPolyphaseAllpassStructure
         ai.add ((1 - api) / (1 + api));
     }
 
+    return ai;
+}
+
+template <typename FloatType>
+typename FilterDesign<FloatType>::IIRPolyphaseAllpassStructure
+    FilterDesign<FloatType>::designIIRLowpassHalfBandPolyphaseAllpassMethod (FloatType normalisedTransitionWidth,
+                                                                             FloatType stopbandAmplitudedB)
+{
+    jassert (normalisedTransitionWidth > 0 && normalisedTransitionWidth <= 0.5);
+    jassert (stopbandAmplitudedB > -300 && stopbandAmplitudedB < -10);
+
+    const FilterDesignCacheKey key { FilterDesignCacheKey::polyphaseAllpassMethod, { (double) normalisedTransitionWidth, (double) stopbandAmplitudedB } };
+
+    Array<double> ai;
+
+    if (! FilterDesignCache<FloatType>::findAlphas (key, ai))
+    {
+        ai = getHalfBandPolyphaseAllpassAlphas (normalisedTransitionWidth, stopbandAmplitudedB);
+        FilterDesignCache<FloatType>::addAlphas (key, ai);
+    }
+
+    const int N = ai.size();
     IIRPolyphaseAllpassStructure structure;
 
     for (int i = 0; i < N; i += 2)
@@ -692,6 +913,13 @@ typename FilterDesign<FloatType>::IIRPolyphaseAllpassStructure
     return structure;
 }
 
+template <typename FloatType>
+void FilterDesign<FloatType>::clearDesignCache()
+{
+    FilterDesignCache<float>::clear();
+    FilterDesignCache<double>::clear();
+}
+
 
 template struct FilterDesign<float>;
 template struct FilterDesign<double>;
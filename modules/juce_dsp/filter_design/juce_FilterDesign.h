@@ -285,9 +285,24 @@ struct FilterDesign
     static IIRPolyphaseAllpassStructure designIIRLowpassHalfBandPolyphaseAllpassMethod (FloatType normalisedTransitionWidth,
                                                                                         FloatType stopbandAmplitudedB);
 
+    //==============================================================================
+    /** Empties the cache of previously computed designs.
+
+        The results of the most recent design calls are remembered in a cache shared by
+        the whole process, so that asking again for the same filter, e.g. when many
+        Oversampling objects are prepared with the same settings, only has to copy the
+        stored coefficients. Each call still returns new coefficient objects, which can
+        be modified freely.
+
+        This clears the cache for both FilterDesign<float> and FilterDesign<double>.
+    */
+    static void clearDesignCache();
+
 private:
     //==============================================================================
     static Array<double> getPartialImpulseResponseHn (int n, double kp);
+    static Array<double> getHalfBandPolyphaseAllpassAlphas (FloatType normalisedTransitionWidth,
+                                                            FloatType stopbandAmplitudedB);
 
     static ReferenceCountedArray<IIRCoefficients> designIIRLowpassHighOrderGeneralMethod (int type, FloatType frequency, double sampleRate,
                                                                                           FloatType normalisedTransitionWidth,
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct FilterDesignTest  : public UnitTest
+{
+    FilterDesignTest()  : UnitTest ("FilterDesign", "DSP") {}
+
+    template <typename FloatType>
+    void expectSameCoefficients (const Array<FloatType>& a, const Array<FloatType>& b)
+    {
+        expectEquals (a.size(), b.size());
+
+        for (int i = 0; i < jmin (a.size(), b.size()); ++i)
+            expect (a[i] == b[i]);
+    }
+
+    template <typename FloatType>
+    void expectSameCoefficients (const ReferenceCountedArray<IIR::Coefficients<FloatType>>& a,
+                                 const ReferenceCountedArray<IIR::Coefficients<FloatType>>& b)
+    {
+        expectEquals (a.size(), b.size());
+
+        for (int i = 0; i < jmin (a.size(), b.size()); ++i)
+        {
+            expect (a[i] != b[i]);
+            expectSameCoefficients (a[i]->coefficients, b[i]->coefficients);
+        }
+    }
+
+    template <typename FloatType>
+    void runCacheTests()
+    {
+        using Design = FilterDesign<FloatType>;
+
+        beginTest ("FIR designs");
+        {
+            Design::clearDesignCache();
+
+            auto first = Design::designFIRLowpassKaiserMethod ((FloatType) 0.24, 1.0, (FloatType) 0.05, (FloatType) -90.0);
+            auto firstCoefficients = first->coefficients;
+
+            // The returned coefficients must not be shared with later callers
+            first->coefficients.fill ((FloatType) 0);
+
+            auto second = Design::designFIRLowpassKaiserMethod ((FloatType) 0.24, 1.0, (FloatType) 0.05, (FloatType) -90.0);
+            expect (first != second);
+            expectSameCoefficients (firstCoefficients, second->coefficients);
+
+            Design::clearDesignCache();
+
+            auto third = Design::designFIRLowpassKaiserMethod ((FloatType) 0.24, 1.0, (FloatType) 0.05, (FloatType) -90.0);
+            expectSameCoefficients (firstCoefficients, third->coefficients);
+
+            auto halfBand = Design::designFIRLowpassHalfBandEquirippleMethod ((FloatType) 0.05, (FloatType) -90.0);
+            auto otherHalfBand = Design::designFIRLowpassHalfBandEquirippleMethod ((FloatType) 0.06, (FloatType) -90.0);
+            expect (halfBand->coefficients != otherHalfBand->coefficients);
+            expectSameCoefficients (halfBand->coefficients,
+                                    Design::designFIRLowpassHalfBandEquirippleMethod ((FloatType) 0.05, (FloatType) -90.0)->coefficients);
+        }
+
+        beginTest ("IIR designs");
+        {
+            Design::clearDesignCache();
+
+            auto elliptic = Design::designIIRLowpassHighOrderEllipticMethod ((FloatType) 1000, 48000.0, (FloatType) 0.01,
+                                                                             (FloatType) -0.1, (FloatType) -80.0);
+            expect (elliptic.size() > 0);
+            expectSameCoefficients (elliptic, Design::designIIRLowpassHighOrderEllipticMethod ((FloatType) 1000, 48000.0, (FloatType) 0.01,
+                                                                                              (FloatType) -0.1, (FloatType) -80.0));
+
+            // Same parameters, different method
+            auto chebyshev = Design::designIIRLowpassHighOrderChebyshev1Method ((FloatType) 1000, 48000.0, (FloatType) 0.01,
+                                                                                (FloatType) -0.1, (FloatType) -80.0);
+            expect (chebyshev.size() != elliptic.size());
+
+            auto lowpass  = Design::designIIRLowpassHighOrderButterworthMethod  ((FloatType) 1000, 48000.0, 5);
+            auto highpass = Design::designIIRHighpassHighOrderButterworthMethod ((FloatType) 1000, 48000.0, 5);
+            expect (lowpass[0]->coefficients != highpass[0]->coefficients);
+            expectSameCoefficients (highpass, Design::designIIRHighpassHighOrderButterworthMethod ((FloatType) 1000, 48000.0, 5));
+
+            auto structure = Design::designIIRLowpassHalfBandPolyphaseAllpassMethod ((FloatType) 0.05, (FloatType) -90.0);
+            auto cachedStructure = Design::designIIRLowpassHalfBandPolyphaseAllpassMethod ((FloatType) 0.05, (FloatType) -90.0);
+            expect (structure.alpha == cachedStructure.alpha);
+            expectSameCoefficients (structure.directPath, cachedStructure.directPath);
+            expectSameCoefficients (structure.delayedPath, cachedStructure.delayedPath);
+        }
+    }
+
+    void runTest() override
+    {
+        runCacheTests<float>();
+        runCacheTests<double>();
+    }
+};
+
+static FilterDesignTest filterDesignUnitTest;
+
+} // namespace dsp
+} // namespace juce
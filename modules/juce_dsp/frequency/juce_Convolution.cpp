@@ -29,13 +29,427 @@ namespace juce
 namespace dsp
 {
 
-/** This class is the convolution engine itself, processing only one channel at
-    a time of input signal.
+/** A few functions shared by the convolution engines, which work on frequency
+    domain samples laid out so that the complex multiplications can be done with
+    only 4 SIMD function calls.
+*/
+struct ConvolutionSpectrum
+{
+    /** After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls. */
+    static void prepareForConvolution (float* samples, size_t FFTSize) noexcept
+    {
+        auto FFTSizeDiv2 = FFTSize / 2;
+
+        for (size_t i = 0; i < FFTSizeDiv2; i++)
+            samples[i] = samples[2 * i];
+
+        samples[FFTSizeDiv2] = 0;
+
+        for (size_t i = 1; i < FFTSizeDiv2; i++)
+            samples[i + FFTSizeDiv2] = -samples[2 * (FFTSize - i) + 1];
+    }
+
+    /** Does the convolution operation itself only on half of the frequency domain samples. */
+    static void convolutionProcessingAndAccumulate (const float* input, const float* impulse, float* output, size_t FFTSize)
+    {
+        auto FFTSizeDiv2 = FFTSize / 2;
+
+        FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
+        FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+
+        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+
+        output[FFTSize] += input[FFTSize] * impulse[FFTSize];
+    }
+
+    /** Undo the re-organization of samples from the function prepareForConvolution.
+        Then, takes the conjugate of the frequency domain first half of samples, to fill the
+        second half, so that the inverse transform will return real samples in the time domain.
+    */
+    static void updateSymmetricFrequencyDomainData (float* samples, size_t FFTSize) noexcept
+    {
+        auto FFTSizeDiv2 = FFTSize / 2;
+
+        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        {
+            samples[2 * (FFTSize - i)] = samples[i];
+            samples[2 * (FFTSize - i) + 1] = -samples[FFTSizeDiv2 + i];
+        }
+
+        samples[1] = 0.f;
+
+        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        {
+            samples[2 * i] = samples[2 * (FFTSize - i)];
+            samples[2 * i + 1] = -samples[2 * (FFTSize - i) + 1];
+        }
+    }
+};
+
+//==============================================================================
+/** A route from one input channel to one output channel of a convolution
+    engine, through one channel of the impulse response.
+*/
+struct ConvolutionPath
+{
+    int inputChannel, outputChannel, impulseChannel;
+};
+
+//==============================================================================
+/** One uniformly partitioned section of the tail of an impulse response, used by
+    the non-uniform partitioned mode of the ConvolutionEngine.
+
+    The section starts at least two partitions after the beginning of the impulse
+    response, so each block of input can be convolved on a background thread while
+    the next one is being collected, without adding any latency. If the background
+    thread hasn't finished a block by the time its output is needed, the audio
+    thread does the remaining work itself.
+*/
+struct ConvolutionTailStage
+{
+    ConvolutionTailStage() = default;
+
+    /** Prepares the stage for the section of the impulse response starting at
+        impulseStart, whose output starts after the given offset.
+    */
+    void initialise (const AudioBuffer<float>& impulse, size_t impulseStart, size_t numImpulseSamples,
+                     const Array<ConvolutionPath>& newPaths, int newNumInputs, int newNumOutputs,
+                     size_t newPartitionSize, size_t newOffset)
+    {
+        jassert (isPowerOfTwo (newPartitionSize) && newOffset >= 2 * newPartitionSize);
+
+        paths = newPaths;
+        numInputs = newNumInputs;
+        numOutputs = newNumOutputs;
+
+        partitionSize = newPartitionSize;
+        FFTSize = 2 * partitionSize;
+        offset = newOffset;
+        numPartitions = jmax ((size_t) 1, (numImpulseSamples + partitionSize - 1) / partitionSize);
+
+        FFTobject.reset (new FFT (roundToInt (std::log2 (FFTSize))));
+
+        bufferInput.setSize      (numInputs,  static_cast<int> (4 * partitionSize));
+        bufferOutput.setSize     (numOutputs, nextPowerOfTwo (static_cast<int> (offset + 2 * partitionSize)));
+        bufferTemp.setSize       (1, static_cast<int> (FFTSize * 2));
+
+        buffersInputSegments.clear();
+        buffersImpulseSegments.clear();
+
+        for (auto i = 0; i < numInputs; ++i)
+            buffersInputSegments.add (AudioBuffer<float> (static_cast<int> (numPartitions), static_cast<int> (FFTSize + 1)));
+
+        auto* tempData = bufferTemp.getWritePointer (0);
+
+        for (auto& path : paths)
+        {
+            AudioBuffer<float> impulseSegments (static_cast<int> (numPartitions), static_cast<int> (FFTSize + 1));
+            auto* impulseData = impulse.getReadPointer (path.impulseChannel, static_cast<int> (impulseStart));
+
+            for (size_t n = 0; n < numPartitions; ++n)
+            {
+                FloatVectorOperations::clear (tempData, static_cast<int> (FFTSize * 2));
+
+                auto numSamplesToCopy = jmin (partitionSize, numImpulseSamples - n * partitionSize);
+                FloatVectorOperations::copy (tempData, impulseData + n * partitionSize, static_cast<int> (numSamplesToCopy));
+
+                FFTobject->performRealOnlyForwardTransform (tempData);
+                ConvolutionSpectrum::prepareForConvolution (tempData, FFTSize);
+
+                impulseSegments.copyFrom (static_cast<int> (n), 0, tempData, static_cast<int> (FFTSize + 1));
+            }
+
+            buffersImpulseSegments.add (std::move (impulseSegments));
+        }
+
+        reset();
+    }
+
+    /** Clears the state, waiting for any block still being processed on another thread. */
+    void reset()
+    {
+        while (isProcessing.exchange (true))
+            Thread::yield();
+
+        bufferInput.clear();
+        bufferOutput.clear();
+
+        for (auto& segments : buffersInputSegments)
+            segments.clear();
+
+        currentSegment = 0;
+        numSamplesPushed = 0;
+        numSamplesRead = 0;
+        numBlocksSubmitted = 0;
+        numBlocksCompleted = 0;
+
+        isProcessing = false;
+    }
+
+    /** Collects some input samples, returning true if a new block is ready to be processed. */
+    bool pushSamples (const AudioBlock<float>& input) noexcept
+    {
+        jassert ((int) input.getNumChannels() >= numInputs);
+
+        auto mask = bufferInput.getNumSamples() - 1;
+        auto numSamples = input.getNumSamples();
+        auto blockCompleted = false;
+
+        for (size_t numSamplesProcessed = 0; numSamplesProcessed < numSamples;)
+        {
+            auto positionInBlock = (size_t) (numSamplesPushed & (int64) (partitionSize - 1));
+            auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, partitionSize - positionInBlock);
+
+            for (auto channel = 0; channel < numInputs; ++channel)
+                FloatVectorOperations::copy (bufferInput.getWritePointer (channel) + (numSamplesPushed & mask),
+                                             input.getChannelPointer ((size_t) channel) + numSamplesProcessed,
+                                             static_cast<int> (numSamplesToProcess));
+
+            numSamplesPushed += (int64) numSamplesToProcess;
+            numSamplesProcessed += numSamplesToProcess;
+
+            if (positionInBlock + numSamplesToProcess == partitionSize)
+            {
+                numBlocksSubmitted = numSamplesPushed / (int64) partitionSize;
+                blockCompleted = true;
+            }
+        }
+
+        return blockCompleted;
+    }
+
+    /** Adds the output of the stage to the given samples, which must come straight
+        after the ones of the previous call. No more than one partition can be read
+        at a time.
+    */
+    void addSamplesToOutput (AudioBlock<float>& output) noexcept
+    {
+        jassert ((int) output.getNumChannels() >= numOutputs);
+
+        auto numSamples = (int) output.getNumSamples();
+        jassert (numSamples <= (int) partitionSize);
+
+        auto lastSample = numSamplesRead + numSamples - 1;
+
+        if (lastSample >= (int64) offset)
+            waitForBlock ((lastSample - (int64) offset) / (int64) partitionSize);
+
+        auto mask = bufferOutput.getNumSamples() - 1;
+        auto start = (int) (numSamplesRead & mask);
+        auto numBeforeWrap = jmin (numSamples, mask + 1 - start);
+
+        for (auto channel = 0; channel < numOutputs; ++channel)
+        {
+            auto* outputData = bufferOutput.getReadPointer (channel);
+            auto* destination = output.getChannelPointer ((size_t) channel);
+
+            FloatVectorOperations::add (destination, outputData + start, numBeforeWrap);
+            FloatVectorOperations::add (destination + numBeforeWrap, outputData, numSamples - numBeforeWrap);
+        }
+
+        numSamplesRead += numSamples;
+    }
+
+    /** Processes all the blocks submitted so far, unless another thread is already
+        doing so. Returns true if any work has been done.
+    */
+    bool processPendingBlocks() noexcept
+    {
+        if (isProcessing.exchange (true))
+            return false;
+
+        auto didProcess = false;
+
+        for (auto block = numBlocksCompleted.load(); block < numBlocksSubmitted.load(); ++block)
+        {
+            processBlock (block);
+            numBlocksCompleted = block + 1;
+            didProcess = true;
+        }
+
+        isProcessing = false;
+        return didProcess;
+    }
+
+private:
+    //==============================================================================
+    void waitForBlock (int64 blockIndex) noexcept
+    {
+        jassert (blockIndex < numBlocksSubmitted.load());
+
+        while (numBlocksCompleted.load() <= blockIndex)
+            if (! processPendingBlocks())
+                Thread::yield();
+    }
+
+    /** Uniform partitioned overlap-save convolution of one block of input. */
+    void processBlock (int64 blockIndex) noexcept
+    {
+        auto* tempData = bufferTemp.getWritePointer (0);
+
+        auto inputMask = (int64) bufferInput.getNumSamples() - 1;
+        auto inputStart = (blockIndex - 1) * (int64) partitionSize;
+
+        // Forward FFT of each input, shared by all the paths starting from it
+        for (auto channel = 0; channel < numInputs; ++channel)
+        {
+            auto* inputData = bufferInput.getReadPointer (channel);
+
+            for (size_t i = 0; i < FFTSize; ++i)
+                tempData[i] = inputData[(inputStart + (int64) i) & inputMask];
+
+            FFTobject->performRealOnlyForwardTransform (tempData);
+            ConvolutionSpectrum::prepareForConvolution (tempData, FFTSize);
+
+            buffersInputSegments.getReference (channel).copyFrom (static_cast<int> (currentSegment), 0, tempData, static_cast<int> (FFTSize + 1));
+        }
+
+        auto outputMask = (int64) bufferOutput.getNumSamples() - 1;
+        auto outputStart = blockIndex * (int64) partitionSize + (int64) offset;
+
+        for (auto channel = 0; channel < numOutputs; ++channel)
+        {
+            // Complex multiplication, accumulating all the paths ending on this output
+            FloatVectorOperations::clear (tempData, static_cast<int> (FFTSize + 2));
+
+            for (auto p = 0; p < paths.size(); ++p)
+            {
+                if (paths.getReference (p).outputChannel != channel)
+                    continue;
+
+                auto& inputSegments = buffersInputSegments.getReference (paths.getReference (p).inputChannel);
+                auto& impulseSegments = buffersImpulseSegments.getReference (p);
+                auto index = currentSegment;
+
+                for (size_t i = 0; i < numPartitions; ++i)
+                {
+                    ConvolutionSpectrum::convolutionProcessingAndAccumulate (inputSegments.getReadPointer (static_cast<int> (index)),
+                                                                             impulseSegments.getReadPointer (static_cast<int> (i)),
+                                                                             tempData, FFTSize);
+
+                    index = (index > 0) ? (index - 1) : (numPartitions - 1);
+                }
+            }
+
+            // Inverse FFT
+            ConvolutionSpectrum::updateSymmetricFrequencyDomainData (tempData, FFTSize);
+            FFTobject->performRealOnlyInverseTransform (tempData);
+
+            // The second half of the result is the output for this block
+            auto* outputData = bufferOutput.getWritePointer (channel);
+
+            for (size_t i = 0; i < partitionSize; ++i)
+                outputData[(outputStart + (int64) i) & outputMask] = tempData[partitionSize + i];
+        }
+
+        currentSegment = (currentSegment + 1 < numPartitions) ? (currentSegment + 1) : 0;
+    }
+
+    //==============================================================================
+    std::unique_ptr<FFT> FFTobject;
+
+    Array<ConvolutionPath> paths;
+    int numInputs = 0, numOutputs = 0;
+
+    size_t FFTSize = 0, partitionSize = 0, offset = 0, numPartitions = 0, currentSegment = 0;
+    int64 numSamplesPushed = 0, numSamplesRead = 0;
+
+    AudioBuffer<float> bufferInput, bufferOutput, bufferTemp;
+    Array<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
+
+    std::atomic<int64> numBlocksSubmitted { 0 }, numBlocksCompleted { 0 };
+    std::atomic<bool> isProcessing { false };
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionTailStage)
+};
+
+//==============================================================================
+struct FIR::PartitionedConvolutionTail::Pimpl
+{
+    Pimpl (const float* newCoefficients, size_t numCoefficients)
+        : coefficients (newCoefficients, (int) numCoefficients)
+    {
+        auto headSize = getHeadSize();
+        jassert (numCoefficients > headSize);
+
+        AudioBuffer<float> impulse (1, (int) numCoefficients);
+        impulse.copyFrom (0, 0, newCoefficients, (int) numCoefficients);
+
+        Array<ConvolutionPath> paths;
+        paths.add ({ 0, 0, 0 });
+
+        // the tail's output starts right after the head, which is exactly the two
+        // partitions of delay that the stage needs
+        stage.initialise (impulse, headSize, numCoefficients - headSize, paths, 1, 1, partitionSize, headSize);
+        scratch.setSize (1, partitionSize);
+    }
+
+    Array<float> coefficients;
+    ConvolutionTailStage stage;
+    AudioBuffer<float> scratch;
+};
+
+FIR::PartitionedConvolutionTail::PartitionedConvolutionTail (const float* coefficients, size_t numCoefficients)
+    : pimpl (new Pimpl (coefficients, numCoefficients))
+{
+}
+
+FIR::PartitionedConvolutionTail::~PartitionedConvolutionTail() {}
+
+bool FIR::PartitionedConvolutionTail::matches (const float* coefficients, size_t numCoefficients) const noexcept
+{
+    return (int) numCoefficients == pimpl->coefficients.size()
+            && memcmp (coefficients, pimpl->coefficients.begin(), sizeof (float) * numCoefficients) == 0;
+}
+
+void FIR::PartitionedConvolutionTail::reset() noexcept
+{
+    pimpl->stage.reset();
+}
+
+void FIR::PartitionedConvolutionTail::pushInput (const float* input, size_t numSamples) noexcept
+{
+    jassert (numSamples <= getMaximumBlockSize());
+
+    float* channels[] = { const_cast<float*> (input) };
+    pimpl->stage.pushSamples (AudioBlock<float> (channels, 1, numSamples));
+}
+
+void FIR::PartitionedConvolutionTail::addOutput (float* output, size_t numSamples) noexcept
+{
+    jassert (numSamples <= getMaximumBlockSize());
+
+    if (output == nullptr)
+    {
+        pimpl->scratch.clear();
+        output = pimpl->scratch.getWritePointer (0);
+    }
+
+    float* channels[] = { output };
+    AudioBlock<float> block (channels, 1, numSamples);
+    pimpl->stage.addSamplesToOutput (block);
+}
+
+//==============================================================================
+/** This class is the convolution engine itself, processing all the channels of
+    the input signal at once.
+
+    Each output channel is the sum of one or more paths, convolving an input channel
+    with one channel of the impulse response. The forward FFT of every input is
+    shared by all its paths, and the paths ending on the same output are accumulated
+    in the frequency domain, so that only one inverse FFT per output is needed.
 */
 struct ConvolutionEngine
 {
     ConvolutionEngine() = default;
 
+    ~ConvolutionEngine()
+    {
+        stopTailThread();
+    }
+
     //==============================================================================
     struct ProcessingInformation
     {
@@ -62,11 +476,16 @@ struct ConvolutionEngine
         bool wantsStereo = true;
         bool wantsTrimming = true;
         bool wantsNormalisation = true;
+        bool wantsNonUniformPartitioning = false;
         int64 wantedSize = 0;
         int finalSize = 0;
 
+        int numMatrixInputs = 0;            // the size of the impulse response matrix, or 0 for mono or stereo convolution
+        int numMatrixOutputs = 0;
+
         double sampleRate = 0;
         size_t maximumBufferSize = 0;
+        int numChannels = 0;
     };
 
     //==============================================================================
@@ -76,166 +495,222 @@ struct ConvolutionEngine
         bufferOverlap.clear();
         bufferTempOutput.clear();
 
-        for (auto i = 0; i < buffersInputSegments.size(); ++i)
-            buffersInputSegments.getReference (i).clear();
+        for (auto& segments : buffersInputSegments)
+            segments.clear();
+
+        for (auto* stage : tailStages)
+            stage->reset();
 
         currentSegment = 0;
         inputDataPos = 0;
     }
 
     /** Initalize all the states and objects to perform the convolution. */
-    void initializeConvolutionEngine (ProcessingInformation& info, int channel)
+    void initializeConvolutionEngine (ProcessingInformation& info)
     {
+        stopTailThread();
+        tailStages.clear();
+
+        createPaths (info);
+
         blockSize = (size_t) nextPowerOfTwo ((int) info.maximumBufferSize);
 
         FFTSize = blockSize > 128 ? 2 * blockSize
                                   : 4 * blockSize;
 
-        numSegments = ((size_t) info.finalSize) / (FFTSize - blockSize) + 1u;
+        auto headSize = info.wantsNonUniformPartitioning ? createTailStages (*info.buffer, (size_t) info.finalSize)
+                                                         : (size_t) info.finalSize;
+
+        numSegments = headSize / (FFTSize - blockSize) + 1u;
 
         numInputSegments = (blockSize > 128 ? numSegments : 3 * numSegments);
 
         FFTobject.reset (new FFT (roundToInt (std::log2 (FFTSize))));
 
-        bufferInput.setSize      (1, static_cast<int> (FFTSize));
-        bufferOutput.setSize     (1, static_cast<int> (FFTSize * 2));
-        bufferTempOutput.setSize (1, static_cast<int> (FFTSize * 2));
-        bufferOverlap.setSize    (1, static_cast<int> (FFTSize));
+        bufferInput.setSize      (numInputs,  static_cast<int> (FFTSize));
+        bufferOutput.setSize     (numOutputs, static_cast<int> (FFTSize * 2));
+        bufferTempOutput.setSize (numOutputs, static_cast<int> (FFTSize * 2));
+        bufferOverlap.setSize    (numOutputs, static_cast<int> (FFTSize));
 
         buffersInputSegments.clear();
         buffersImpulseSegments.clear();
         bufferOutput.clear();
 
-        for (size_t i = 0; i < numInputSegments; ++i)
-        {
-            AudioBuffer<float> newInputSegment;
-            newInputSegment.setSize (1, static_cast<int> (FFTSize * 2));
-            buffersInputSegments.add (newInputSegment);
-        }
-
-        for (auto i = 0u; i < numSegments; ++i)
-        {
-            AudioBuffer<float> newImpulseSegment;
-            newImpulseSegment.setSize (1, static_cast<int> (FFTSize * 2));
-            buffersImpulseSegments.add (newImpulseSegment);
-        }
+        for (auto i = 0; i < numInputs; ++i)
+            buffersInputSegments.add (AudioBuffer<float> (static_cast<int> (numInputSegments), static_cast<int> (FFTSize * 2)));
 
         std::unique_ptr<FFT> FFTTempObject (new FFT (roundToInt (std::log2 (FFTSize))));
 
-        auto* channelData = info.buffer->getWritePointer (channel);
-
-        for (size_t n = 0; n < numSegments; ++n)
+        for (auto& path : paths)
         {
-            buffersImpulseSegments.getReference (static_cast<int> (n)).clear();
+            AudioBuffer<float> impulseSegments (static_cast<int> (numSegments), static_cast<int> (FFTSize * 2));
+            impulseSegments.clear();
+
+            auto* channelData = info.buffer->getReadPointer (path.impulseChannel);
 
-            auto* impulseResponse = buffersImpulseSegments.getReference (static_cast<int> (n)).getWritePointer (0);
+            for (size_t n = 0; n < numSegments; ++n)
+            {
+                auto* impulseResponse = impulseSegments.getWritePointer (static_cast<int> (n));
 
-            if (n == 0)
-                impulseResponse[0] = 1.0f;
+                if (n == 0)
+                    impulseResponse[0] = 1.0f;
 
-            for (size_t i = 0; i < FFTSize - blockSize; ++i)
-                if (i + n * (FFTSize - blockSize) < (size_t) info.finalSize)
-                    impulseResponse[i] = channelData[i + n * (FFTSize - blockSize)];
+                for (size_t i = 0; i < FFTSize - blockSize; ++i)
+                    if (i + n * (FFTSize - blockSize) < headSize)
+                        impulseResponse[i] = channelData[i + n * (FFTSize - blockSize)];
 
-            FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-            prepareForConvolution (impulseResponse);
+                FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
+                prepareForConvolution (impulseResponse);
+            }
+
+            buffersImpulseSegments.add (std::move (impulseSegments));
         }
 
         reset();
 
+        if (! tailStages.isEmpty())
+        {
+            if (tailThread == nullptr)
+                tailThread.reset (new TailThread (*this));
+
+            tailThread->startThread (Thread::realtimeAudioPriority);
+        }
+
         isReady = true;
     }
 
-    /** Copy the states of another engine. */
-    void copyStateFromOtherEngine (const ConvolutionEngine& other)
+    /** Performs the convolution, using the zero-latency uniform partitioned head
+        and the optional tail stages of the non-uniform partitioned mode. The
+        output channels which are not fed by any path are either cleared, or
+        filled with the first output in mono mode.
+    */
+    void processSamples (const AudioBlock<float>& input, AudioBlock<float>& output)
     {
-        if (FFTSize != other.FFTSize)
+        if (! isReady)
+            return;
+
+        jassert ((int) input.getNumChannels() >= numInputs && (int) output.getNumChannels() >= numOutputs);
+
+        auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+
+        for (size_t numSamplesProcessed = 0; numSamplesProcessed < numSamples;)
         {
-            FFTobject.reset (new FFT (roundToInt (std::log2 (other.FFTSize))));
-            FFTSize = other.FFTSize;
-        }
+            // the tail stages can only handle up to one block at a time
+            auto numSamplesToProcess = tailStages.isEmpty() ? numSamples - numSamplesProcessed
+                                                            : jmin (numSamples - numSamplesProcessed, blockSize);
 
-        currentSegment      = other.currentSegment;
-        numInputSegments    = other.numInputSegments;
-        numSegments         = other.numSegments;
-        blockSize           = other.blockSize;
-        inputDataPos        = other.inputDataPos;
+            auto inputBlock  = input.getSubBlock (numSamplesProcessed, numSamplesToProcess);
+            auto outputBlock = output.getSubBlock (numSamplesProcessed, numSamplesToProcess);
 
-        bufferInput         = other.bufferInput;
-        bufferTempOutput    = other.bufferTempOutput;
-        bufferOutput        = other.bufferOutput;
+            auto blockSubmitted = false;
 
-        buffersInputSegments    = other.buffersInputSegments;
-        buffersImpulseSegments  = other.buffersImpulseSegments;
-        bufferOverlap           = other.bufferOverlap;
+            for (auto* stage : tailStages)
+                blockSubmitted = stage->pushSamples (inputBlock) || blockSubmitted;
 
-        isReady = true;
+            if (blockSubmitted)
+                tailThread->notify();
+
+            processHeadSamples (inputBlock, outputBlock);
+
+            for (auto* stage : tailStages)
+                stage->addSamplesToOutput (outputBlock);
+
+            numSamplesProcessed += numSamplesToProcess;
+        }
+
+        for (auto channel = (size_t) numOutputs; channel < output.getNumChannels(); ++channel)
+        {
+            auto&& block = output.getSingleChannelBlock (channel).getSubBlock (0, numSamples);
+
+            if (duplicatesFirstOutput)
+                block.copy (output.getSingleChannelBlock (0).getSubBlock (0, numSamples));
+            else
+                block.clear();
+        }
     }
 
     /** Performs the uniform partitioned convolution using FFT. */
-    void processSamples (const float* input, float* output, size_t numSamples)
+    void processHeadSamples (const AudioBlock<float>& input, AudioBlock<float>& output)
     {
-        if (! isReady)
-            return;
-
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
         size_t numSamplesProcessed = 0;
+        auto numSamples = input.getNumSamples();
 
         auto indexStep = numInputSegments / numSegments;
 
-        auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
-        auto* outputData     = bufferOutput.getWritePointer (0);
-        auto* overlapData    = bufferOverlap.getWritePointer (0);
-
         while (numSamplesProcessed < numSamples)
         {
             const bool inputDataWasEmpty = (inputDataPos == 0);
             auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
 
-            // copy the input samples
-            FloatVectorOperations::copy (inputData + inputDataPos, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
+            for (auto channel = 0; channel < numInputs; ++channel)
+            {
+                auto* inputData = bufferInput.getWritePointer (channel);
 
-            auto* inputSegmentData = buffersInputSegments.getReference (static_cast<int> (currentSegment)).getWritePointer (0);
-            FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (FFTSize));
+                // copy the input samples
+                FloatVectorOperations::copy (inputData + inputDataPos, input.getChannelPointer ((size_t) channel) + numSamplesProcessed,
+                                             static_cast<int> (numSamplesToProcess));
 
-            // Forward FFT
-            FFTobject->performRealOnlyForwardTransform (inputSegmentData);
-            prepareForConvolution (inputSegmentData);
+                auto* inputSegmentData = buffersInputSegments.getReference (channel).getWritePointer (static_cast<int> (currentSegment));
+                FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (FFTSize));
 
-            // Complex multiplication
-            if (inputDataWasEmpty)
-            {
-                FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (FFTSize + 1));
+                // Forward FFT
+                FFTobject->performRealOnlyForwardTransform (inputSegmentData);
+                prepareForConvolution (inputSegmentData);
+            }
 
-                auto index = currentSegment;
+            for (auto channel = 0; channel < numOutputs; ++channel)
+            {
+                auto* outputTempData = bufferTempOutput.getWritePointer (channel);
+                auto* outputData     = bufferOutput.getWritePointer (channel);
+                auto* overlapData    = bufferOverlap.getWritePointer (channel);
 
-                for (size_t i = 1; i < numSegments; ++i)
+                // Complex multiplication
+                if (inputDataWasEmpty)
                 {
-                    index += indexStep;
+                    FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (FFTSize + 1));
 
-                    if (index >= numInputSegments)
-                        index -= numInputSegments;
+                    for (auto p = 0; p < paths.size(); ++p)
+                    {
+                        if (paths.getReference (p).outputChannel != channel)
+                            continue;
 
-                    convolutionProcessingAndAccumulate (buffersInputSegments.getReference (static_cast<int> (index)).getWritePointer (0),
-                                                        buffersImpulseSegments.getReference (static_cast<int> (i)).getWritePointer (0),
-                                                        outputTempData);
+                        auto& inputSegments = buffersInputSegments.getReference (paths.getReference (p).inputChannel);
+                        auto& impulseSegments = buffersImpulseSegments.getReference (p);
+                        auto index = currentSegment;
+
+                        for (size_t i = 1; i < numSegments; ++i)
+                        {
+                            index += indexStep;
+
+                            if (index >= numInputSegments)
+                                index -= numInputSegments;
+
+                            convolutionProcessingAndAccumulate (inputSegments.getReadPointer (static_cast<int> (index)),
+                                                                impulseSegments.getReadPointer (static_cast<int> (i)),
+                                                                outputTempData);
+                        }
+                    }
                 }
-            }
 
-            FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (FFTSize + 1));
+                FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (FFTSize + 1));
 
-            convolutionProcessingAndAccumulate (buffersInputSegments.getReference (static_cast<int> (currentSegment)).getWritePointer (0),
-                                                buffersImpulseSegments.getReference (0).getWritePointer (0),
-                                                outputData);
+                for (auto p = 0; p < paths.size(); ++p)
+                    if (paths.getReference (p).outputChannel == channel)
+                        convolutionProcessingAndAccumulate (buffersInputSegments.getReference (paths.getReference (p).inputChannel).getReadPointer (static_cast<int> (currentSegment)),
+                                                            buffersImpulseSegments.getReference (p).getReadPointer (0),
+                                                            outputData);
 
-            // Inverse FFT
-            updateSymmetricFrequencyDomainData (outputData);
-            FFTobject->performRealOnlyInverseTransform (outputData);
+                // Inverse FFT
+                updateSymmetricFrequencyDomainData (outputData);
+                FFTobject->performRealOnlyInverseTransform (outputData);
 
-            // Add overlap
-            for (size_t i = 0; i < numSamplesToProcess; ++i)
-                output[i + numSamplesProcessed] = outputData[inputDataPos + i] + overlapData[inputDataPos + i];
+                // Add overlap
+                auto* destination = output.getChannelPointer ((size_t) channel) + numSamplesProcessed;
+
+                for (size_t i = 0; i < numSamplesToProcess; ++i)
+                    destination[i] = outputData[inputDataPos + i] + overlapData[inputDataPos + i];
+            }
 
             // Input buffer full => Next block
             inputDataPos += numSamplesToProcess;
@@ -243,15 +718,22 @@ struct ConvolutionEngine
             if (inputDataPos == blockSize)
             {
                 // Input buffer is empty again now
-                FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (FFTSize));
+                for (auto channel = 0; channel < numInputs; ++channel)
+                    FloatVectorOperations::fill (bufferInput.getWritePointer (channel), 0.0f, static_cast<int> (FFTSize));
 
                 inputDataPos = 0;
 
-                // Extra step for segSize > blockSize
-                FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (FFTSize - 2 * blockSize));
+                for (auto channel = 0; channel < numOutputs; ++channel)
+                {
+                    auto* outputData  = bufferOutput.getWritePointer (channel);
+                    auto* overlapData = bufferOverlap.getWritePointer (channel);
+
+                    // Extra step for segSize > blockSize
+                    FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (FFTSize - 2 * blockSize));
 
-                // Save the overlap
-                FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (FFTSize - blockSize));
+                    // Save the overlap
+                    FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (FFTSize - blockSize));
+                }
 
                 // Update current segment
                 currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
@@ -261,66 +743,133 @@ struct ConvolutionEngine
         }
     }
 
-    /** After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls. */
-    void prepareForConvolution (float *samples) noexcept
+    void prepareForConvolution (float* samples) noexcept
     {
-        auto FFTSizeDiv2 = FFTSize / 2;
-
-        for (size_t i = 0; i < FFTSizeDiv2; i++)
-            samples[i] = samples[2 * i];
+        ConvolutionSpectrum::prepareForConvolution (samples, FFTSize);
+    }
 
-        samples[FFTSizeDiv2] = 0;
+    void convolutionProcessingAndAccumulate (const float* input, const float* impulse, float* output)
+    {
+        ConvolutionSpectrum::convolutionProcessingAndAccumulate (input, impulse, output, FFTSize);
+    }
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
-            samples[i + FFTSizeDiv2] = -samples[2 * (FFTSize - i) + 1];
+    void updateSymmetricFrequencyDomainData (float* samples) noexcept
+    {
+        ConvolutionSpectrum::updateSymmetricFrequencyDomainData (samples, FFTSize);
     }
 
-    /** Does the convolution operation itself only on half of the frequency domain samples. */
-    void convolutionProcessingAndAccumulate (const float *input, const float *impulse, float *output)
+    //==============================================================================
+    /** Works out which channels of the impulse response connect the inputs to the
+        outputs, for the number of channels being processed.
+    */
+    void createPaths (const ProcessingInformation& info)
     {
-        auto FFTSizeDiv2 = FFTSize / 2;
+        paths.clearQuick();
 
-        FloatVectorOperations::addWithMultiply      (output, input, impulse, static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::subtractWithMultiply (output, &(input[FFTSizeDiv2]), &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
+        if (info.numMatrixInputs > 0)
+        {
+            for (auto input = 0; input < jmin (info.numMatrixInputs, info.numChannels); ++input)
+                for (auto channel = 0; channel < jmin (info.numMatrixOutputs, info.numChannels); ++channel)
+                    paths.add ({ input, channel, input * info.numMatrixOutputs + channel });
+        }
+        else
+        {
+            paths.add ({ 0, 0, 0 });
 
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), input, &(impulse[FFTSizeDiv2]), static_cast<int> (FFTSizeDiv2));
-        FloatVectorOperations::addWithMultiply      (&(output[FFTSizeDiv2]), &(input[FFTSizeDiv2]), impulse, static_cast<int> (FFTSizeDiv2));
+            if (info.wantsStereo && info.numChannels > 1)
+                paths.add ({ 1, 1, 1 });
+        }
 
-        output[FFTSize] += input[FFTSize] * impulse[FFTSize];
+        numInputs = 0;
+        numOutputs = 0;
+
+        for (auto& path : paths)
+        {
+            numInputs  = jmax (numInputs,  path.inputChannel + 1);
+            numOutputs = jmax (numOutputs, path.outputChannel + 1);
+        }
+
+        duplicatesFirstOutput = (info.numMatrixInputs == 0);
     }
 
-    /** Undo the re-organization of samples from the function prepareForConvolution.
-        Then, takes the conjugate of the frequency domain first half of samples, to fill the
-        second half, so that the inverse transform will return real samples in the time domain.
+    /** Splits the impulse response after its first few partitions into tail stages
+        with progressively larger partition sizes, and returns the number of samples
+        which are left for the zero-latency head.
     */
-    void updateSymmetricFrequencyDomainData (float* samples) noexcept
+    size_t createTailStages (const AudioBuffer<float>& impulse, size_t impulseSize)
     {
-        auto FFTSizeDiv2 = FFTSize / 2;
+        auto partitionSize = jmax (blockSize, jmin (4 * blockSize, maximumTailPartitionSize));
+        auto offset = 2 * partitionSize;
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
+        if (impulseSize <= offset)
+            return impulseSize;
+
+        auto headSize = offset;
+
+        while (offset < impulseSize)
         {
-            samples[2 * (FFTSize - i)] = samples[i];
-            samples[2 * (FFTSize - i) + 1] = -samples[FFTSizeDiv2 + i];
+            auto nextPartitionSize = jmax (partitionSize, jmin (4 * partitionSize, maximumTailPartitionSize));
+            auto end = (nextPartitionSize > partitionSize) ? jmin (2 * nextPartitionSize, impulseSize)
+                                                           : impulseSize;
+
+            auto* stage = tailStages.add (new ConvolutionTailStage());
+            stage->initialise (impulse, offset, end - offset, paths, numInputs, numOutputs, partitionSize, offset);
+
+            offset = end;
+            partitionSize = nextPartitionSize;
         }
 
-        samples[1] = 0.f;
+        return headSize;
+    }
 
-        for (size_t i = 1; i < FFTSizeDiv2; i++)
+    void stopTailThread()
+    {
+        if (tailThread != nullptr)
+            tailThread->stopThread (10000);
+    }
+
+    /** The background thread processing the tail stages, starting with the smallest
+        partitions since those have the closest deadlines.
+    */
+    struct TailThread  : public Thread
+    {
+        TailThread (ConvolutionEngine& e)  : Thread ("Convolution Tail"), owner (e) {}
+
+        void run() override
         {
-            samples[2 * i] = samples[2 * (FFTSize - i)];
-            samples[2 * i + 1] = -samples[2 * (FFTSize - i) + 1];
+            while (! threadShouldExit())
+            {
+                auto didProcess = false;
+
+                for (auto* stage : owner.tailStages)
+                    didProcess = stage->processPendingBlocks() || didProcess;
+
+                if (! didProcess)
+                    wait (-1);
+            }
         }
-    }
+
+        ConvolutionEngine& owner;
+    };
 
     //==============================================================================
+    static constexpr size_t maximumTailPartitionSize = 16384;
+
     std::unique_ptr<FFT> FFTobject;
 
     size_t FFTSize = 0;
     size_t currentSegment = 0, numInputSegments = 0, numSegments = 0, blockSize = 0, inputDataPos = 0;
 
+    Array<ConvolutionPath> paths;
+    int numInputs = 0, numOutputs = 0;
+    bool duplicatesFirstOutput = true;
+
     AudioBuffer<float> bufferInput, bufferOutput, bufferTempOutput, bufferOverlap;
     Array<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
 
+    OwnedArray<ConvolutionTailStage> tailStages;
+    std::unique_ptr<TailThread> tailThread;
+
     bool isReady = false;
 
     //==============================================================================
@@ -333,19 +882,23 @@ struct ConvolutionEngine
 /** Manages all the changes requested by the main convolution engine, to minimize
     the number of calls of the convolution engine initialization, and the potential
     consequences of multiple quick calls to the function Convolution::loadImpulseResponse.
+
+    The new impulse responses are prepared on a background thread, into a spare
+    engine which is then handed over to the audio thread through an atomic state,
+    so that switching between engines never allocates or takes any lock while
+    processing.
 */
 struct Convolution::Pimpl  : private Thread
 {
     enum class ChangeRequest
     {
         changeEngine = 0,
-        changeSampleRate,
-        changeMaximumBufferSize,
         changeSource,
         changeImpulseResponseSize,
         changeStereo,
         changeTrimming,
         changeNormalisation,
+        changePartitioning,
         changeIgnore,
         numChangeRequestTypes
     };
@@ -362,7 +915,7 @@ struct Convolution::Pimpl  : private Thread
         requestsType.resize (fifoSize);
         requestsParameter.resize (fifoSize);
 
-        for (auto i = 0; i < 4; ++i)
+        for (auto i = 0; i < 2; ++i)
             engines.add (new ConvolutionEngine());
 
         currentInfo.maximumBufferSize = 0;
@@ -379,13 +932,47 @@ struct Convolution::Pimpl  : private Thread
     }
 
     //==============================================================================
-    /** Inits the size of the interpolation buffer. */
-    void initProcessing (int maximumBufferSize)
+    /** Stops the background thread, and initialises the current engine with all
+        the changes requested so far, so that it can be used straight away.
+    */
+    void prepare (double newSampleRate, int maximumBufferSize, int numChannels)
     {
-        stopThread (1000);
+        stopThread (10000);
+
+        currentInfo.sampleRate = newSampleRate;
+        currentInfo.maximumBufferSize = (size_t) maximumBufferSize;
+        currentInfo.numChannels = numChannels;
+
+        processFifo();
+
+        // the default impulse response doesn't need any resampling
+        if (usesDefaultImpulseResponse)
+            currentInfo.originalSampleRate = newSampleRate;
+
+        if (mustLoadSource)
+        {
+            loadImpulseResponse();
+            mustLoadSource = false;
+        }
+
+        processImpulseResponse();
+        engines[0]->initializeConvolutionEngine (currentInfo);
+        mustUpdateEngine = false;
+
+        interpolationBuffer.setSize (numChannels, maximumBufferSize, false, false, true);
+        interpolationGains.setSize (2, maximumBufferSize, false, false, true);
 
-        interpolationBuffer.setSize (1, maximumBufferSize, false, false, true);
         mustInterpolate = false;
+        spareEngineState = SpareEngineState::free;
+
+        startThread();
+    }
+
+    /** Sets the length of the crossfade used when a new engine is ready. */
+    void setCrossfadeLength (double lengthInSeconds) noexcept
+    {
+        jassert (lengthInSeconds >= 0);
+        crossfadeLength = jmax (0.0, lengthInSeconds);
     }
 
     //==============================================================================
@@ -412,6 +999,7 @@ struct Convolution::Pimpl  : private Thread
         }
 
         abstractFifo.finishedWrite (size1 + size2);
+        notify();
     }
 
     /** Adds a new array of change requests. */
@@ -443,6 +1031,7 @@ struct Convolution::Pimpl  : private Thread
         }
 
         abstractFifo.finishedWrite (size1 + size2);
+        notify();
     }
 
     /** Reads requests from the fifo. */
@@ -476,14 +1065,12 @@ struct Convolution::Pimpl  : private Thread
     /** This function processes all the change requests to remove all the the
         redundant ones, and to tell what kind of initialization must be done.
 
-        Depending on the results, the convolution engines might be reset, or
-        simply updated, or they might not need any change at all.
+        Depending on the results, the impulse response might need to be loaded
+        again, or simply processed again, or the engine might not need any change
+        at all.
     */
     void processFifo()
     {
-        if (getNumRemainingEntries() == 0 || isThreadRunning() || mustInterpolate)
-            return;
-
         auto numRequests = 0;
 
         // retrieve the information from the FIFO for processing
@@ -524,39 +1111,28 @@ struct Convolution::Pimpl  : private Thread
             switch (requestsType[n])
             {
                 case ChangeRequest::changeEngine:
-                    changeLevel = 3;
+                    changeLevel = 2;
                     break;
 
-                case ChangeRequest::changeSampleRate:
-                {
-                    double newSampleRate = requestsParameter[n];
-
-                    if (currentInfo.sampleRate != newSampleRate)
-                        changeLevel = 3;
-
-                    currentInfo.sampleRate = newSampleRate;
-                }
-                break;
-
-                case ChangeRequest::changeMaximumBufferSize:
-                {
-                    int newMaximumBufferSize = requestsParameter[n];
-
-                    if (currentInfo.maximumBufferSize != (size_t) newMaximumBufferSize)
-                        changeLevel = 3;
-
-                    currentInfo.maximumBufferSize = (size_t) newMaximumBufferSize;
-                }
-                break;
-
                 case ChangeRequest::changeSource:
                 {
                     auto* arrayParameters = requestsParameter[n].getArray();
+                    usesDefaultImpulseResponse = false;
                     auto newSourceType = static_cast<SourceType> (static_cast<int> (arrayParameters->getUnchecked (0)));
 
                     if (currentInfo.sourceType != newSourceType)
                         changeLevel = jmax (2, changeLevel);
 
+                    auto isMatrix = (arrayParameters->size() > 3);
+                    auto newNumMatrixInputs  = isMatrix ? static_cast<int> (arrayParameters->getUnchecked (2)) : 0;
+                    auto newNumMatrixOutputs = isMatrix ? static_cast<int> (arrayParameters->getUnchecked (3)) : 0;
+
+                    if (currentInfo.numMatrixInputs != newNumMatrixInputs || currentInfo.numMatrixOutputs != newNumMatrixOutputs)
+                        changeLevel = jmax (2, changeLevel);
+
+                    currentInfo.numMatrixInputs = newNumMatrixInputs;
+                    currentInfo.numMatrixOutputs = newNumMatrixOutputs;
+
                     if (newSourceType == SourceType::sourceBinaryData)
                     {
                         auto& prm = arrayParameters->getRawDataPointer()[1];
@@ -615,7 +1191,7 @@ struct Convolution::Pimpl  : private Thread
                     bool newWantsStereo = requestsParameter[n];
 
                     if (currentInfo.wantsStereo != newWantsStereo)
-                        changeLevel = jmax (0, changeLevel);
+                        changeLevel = jmax (1, changeLevel);
 
                     currentInfo.wantsStereo = newWantsStereo;
                 }
@@ -643,6 +1219,17 @@ struct Convolution::Pimpl  : private Thread
                 }
                 break;
 
+                case ChangeRequest::changePartitioning:
+                {
+                    bool newWantsNonUniformPartitioning = requestsParameter[n];
+
+                    if (currentInfo.wantsNonUniformPartitioning != newWantsNonUniformPartitioning)
+                        changeLevel = jmax (1, changeLevel);
+
+                    currentInfo.wantsNonUniformPartitioning = newWantsNonUniformPartitioning;
+                }
+                break;
+
                 case ChangeRequest::changeIgnore:
                     break;
 
@@ -654,6 +1241,8 @@ struct Convolution::Pimpl  : private Thread
 
         if (currentInfo.sourceType == SourceType::sourceNone)
         {
+            changeLevel = 2;
+            usesDefaultImpulseResponse = true;
             currentInfo.sourceType = SourceType::sourceAudioBuffer;
 
             if (currentInfo.sampleRate == 0)
@@ -662,6 +1251,9 @@ struct Convolution::Pimpl  : private Thread
             if (currentInfo.maximumBufferSize == 0)
                 currentInfo.maximumBufferSize = 128;
 
+            if (currentInfo.numChannels == 0)
+                currentInfo.numChannels = 2;
+
             currentInfo.originalSampleRate = currentInfo.sampleRate;
             currentInfo.wantedSize = 1;
             currentInfo.fileImpulseResponse = File();
@@ -672,47 +1264,47 @@ struct Convolution::Pimpl  : private Thread
             newBuffer.setSize (1, 1);
             newBuffer.setSample (0, 0, 1.f);
 
-            copyBufferToTemporaryLocation (newBuffer);
+            copyBufferToTemporaryLocation (newBuffer, 1);
         }
 
-        // action depending on the change level
-        if (changeLevel == 3)
-        {
-            loadImpulseResponse();
-            processImpulseResponse();
-            initializeConvolutionEngines();
-        }
-        else if (changeLevel > 0)
-        {
-            startThread();
-        }
+        mustLoadSource   = mustLoadSource   || changeLevel >= 2;
+        mustUpdateEngine = mustUpdateEngine || changeLevel >= 1;
     }
 
     //==============================================================================
     /** This function copies a buffer to a temporary location, so that any external
         audio source can be processed then in the dedicated thread.
     */
-    void copyBufferToTemporaryLocation (dsp::AudioBlock<float> block)
+    void copyBufferToTemporaryLocation (dsp::AudioBlock<float> block, int numChannelsToCopy)
     {
         const SpinLock::ScopedLockType sl (processLock);
 
-        currentInfo.originalNumChannels = (block.getNumChannels() > 1 ? 2 : 1);
-        currentInfo.originalSize = (int) jmin ((size_t) maximumTimeInSamples, block.getNumSamples());
+        jassert (numChannelsToCopy <= (int) block.getNumChannels());
 
-        for (auto channel = 0; channel < currentInfo.originalNumChannels; ++channel)
-            temporaryBuffer.copyFrom (channel, 0, block.getChannelPointer ((size_t) channel), (int) currentInfo.originalSize);
+        if (temporaryBuffer.getNumChannels() < numChannelsToCopy)
+            temporaryBuffer.setSize (numChannelsToCopy, static_cast<int> (maximumTimeInSamples), false, false, true);
+
+        temporaryNumChannels = numChannelsToCopy;
+        temporarySize = (int) jmin ((size_t) maximumTimeInSamples, block.getNumSamples());
+
+        for (auto channel = 0; channel < temporaryNumChannels; ++channel)
+            temporaryBuffer.copyFrom (channel, 0, block.getChannelPointer ((size_t) channel), temporarySize);
     }
 
     //==============================================================================
-    /** Resets the convolution engines states. */
+    /** Resets the convolution engines states. Any interpolation in progress ends
+        straight away on the new engine.
+    */
     void reset()
     {
-        for (auto* e : engines)
-            e->reset();
-
-        mustInterpolate = false;
+        if (mustInterpolate)
+        {
+            mustInterpolate = false;
+            engines.swap (0, 1);
+            spareEngineState = SpareEngineState::free;
+        }
 
-        processFifo();
+        engines[0]->reset();
     }
 
     /** Convolution processing handling interpolation between previous and new states
@@ -720,55 +1312,51 @@ struct Convolution::Pimpl  : private Thread
     */
     void processSamples (const AudioBlock<float>& input, AudioBlock<float>& output)
     {
-        processFifo();
+        if (! mustInterpolate && spareEngineState == SpareEngineState::ready)
+            startInterpolation();
 
-        size_t numChannels = jmin (input.getNumChannels(), (size_t) (currentInfo.wantsStereo ? 2 : 1));
+        size_t numChannels = jmin (input.getNumChannels(), output.getNumChannels(), (size_t) interpolationBuffer.getNumChannels());
         size_t numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
 
+        auto inputBlock  = AudioBlock<float> (input).getSubsetChannelBlock (0, numChannels).getSubBlock (0, numSamples);
+        auto outputBlock = output.getSubsetChannelBlock (0, numChannels).getSubBlock (0, numSamples);
+
         if (mustInterpolate == false)
         {
-            for (size_t channel = 0; channel < numChannels; ++channel)
-                engines[(int) channel]->processSamples (input.getChannelPointer (channel), output.getChannelPointer (channel), numSamples);
+            engines[0]->processSamples (inputBlock, outputBlock);
         }
         else
         {
-            auto interpolated = dsp::AudioBlock<float> (interpolationBuffer).getSubBlock (0, numSamples);
-
-            for (size_t channel = 0; channel < numChannels; ++channel)
-            {
-                auto&& buffer = output.getSingleChannelBlock (channel);
+            auto interpolated = dsp::AudioBlock<float> (interpolationBuffer).getSubsetChannelBlock (0, numChannels)
+                                                                            .getSubBlock (0, numSamples);
+            interpolated.copy (inputBlock);
 
-                interpolationBuffer.copyFrom (0, 0, input.getChannelPointer (channel), (int) numSamples);
+            engines[0]->processSamples (inputBlock, outputBlock);
+            engines[1]->processSamples (interpolated, interpolated);
 
-                engines[(int) channel]->processSamples (input.getChannelPointer (channel), buffer.getChannelPointer (0), numSamples);
-                changeVolumes[channel].applyGain (buffer.getChannelPointer (0), (int) numSamples);
+            auto* gainsOut = interpolationGains.getWritePointer (0);
+            auto* gainsIn  = interpolationGains.getWritePointer (1);
 
-                auto* interPtr = interpolationBuffer.getWritePointer (0);
-                engines[(int) channel + 2]->processSamples (interPtr, interPtr, numSamples);
-                changeVolumes[channel + 2].applyGain (interPtr, (int) numSamples);
-
-                buffer += interpolated;
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                gainsOut[i] = changeVolumes[0].getNextValue();
+                gainsIn[i]  = changeVolumes[1].getNextValue();
             }
 
-            if (input.getNumChannels() > 1 && currentInfo.wantsStereo == false)
+            for (size_t channel = 0; channel < numChannels; ++channel)
             {
-                auto&& buffer = output.getSingleChannelBlock (1);
-
-                changeVolumes[1].applyGain (buffer.getChannelPointer (0), (int) numSamples);
-                changeVolumes[3].applyGain (buffer.getChannelPointer (0), (int) numSamples);
+                FloatVectorOperations::multiply (outputBlock.getChannelPointer (channel), gainsOut, (int) numSamples);
+                FloatVectorOperations::addWithMultiply (outputBlock.getChannelPointer (channel), interpolated.getChannelPointer (channel),
+                                                        gainsIn, (int) numSamples);
             }
 
             if (changeVolumes[0].isSmoothing() == false)
             {
                 mustInterpolate = false;
-
-                for (auto channel = 0; channel < 2; ++channel)
-                    engines[channel]->copyStateFromOtherEngine (*engines[channel + 2]);
+                engines.swap (0, 1);
+                spareEngineState = SpareEngineState::free;
             }
         }
-
-        if (input.getNumChannels() > 1 && currentInfo.wantsStereo == false)
-            output.getSingleChannelBlock (1).copy (output.getSingleChannelBlock (0));
     }
 
     //==============================================================================
@@ -776,25 +1364,79 @@ struct Convolution::Pimpl  : private Thread
 
 private:
     //==============================================================================
-    /** This the thread run function which does the preparation of data depending
-        on the requested change level.
+    /** This the thread run function, which prepares the spare engine every time
+        some changes are requested, and waits for the audio thread to be done with
+        it before preparing the next one.
     */
     void run() override
     {
-        if (changeLevel == 2)
+        while (! threadShouldExit())
         {
-            loadImpulseResponse();
+            if (spareEngineState != SpareEngineState::free)
+            {
+                // the audio thread doesn't signal anything, to stay lock free
+                wait (10);
+                continue;
+            }
+
+            processFifo();
 
-            if (isThreadRunning() && threadShouldExit())
+            if (! mustUpdateEngine)
+            {
+                wait (-1);
+                continue;
+            }
+
+            if (mustLoadSource)
+            {
+                loadImpulseResponse();
+                mustLoadSource = false;
+            }
+
+            if (threadShouldExit())
                 return;
+
+            processImpulseResponse();
+
+            // newer requests have arrived in the meantime, so skip this engine
+            if (threadShouldExit() || getNumRemainingEntries() > 0)
+                continue;
+
+            engines[1]->initializeConvolutionEngine (currentInfo);
+            engines[1]->reset();
+
+            if (threadShouldExit() || getNumRemainingEntries() > 0)
+                continue;
+
+            mustUpdateEngine = false;
+            spareEngineState = SpareEngineState::ready;
         }
+    }
 
-        processImpulseResponse();
+    /** Starts the interpolation between the current engine and the spare engine
+        which has just been prepared.
+    */
+    void startInterpolation() noexcept
+    {
+        auto numSteps = (int) std::floor (crossfadeLength.load() * currentInfo.sampleRate);
 
-        if (isThreadRunning() && threadShouldExit())
+        if (numSteps <= 0)
+        {
+            engines.swap (0, 1);
+            spareEngineState = SpareEngineState::free;
             return;
+        }
+
+        changeVolumes[0].setTargetValue (1.0f);
+        changeVolumes[0].reset (numSteps);
+        changeVolumes[0].setTargetValue (0.0f);
+
+        changeVolumes[1].setTargetValue (0.0f);
+        changeVolumes[1].reset (numSteps);
+        changeVolumes[1].setTargetValue (1.0f);
 
-        initializeConvolutionEngines();
+        spareEngineState = SpareEngineState::inUse;
+        mustInterpolate = true;
     }
 
     /** Loads the impulse response from the requested audio source. */
@@ -828,7 +1470,11 @@ private:
 
         if (currentInfo.wantsNormalisation)
         {
-            if (currentInfo.originalNumChannels > 1)
+            if (currentInfo.numMatrixInputs > 0)
+            {
+                normaliseImpulseResponseMatrix (*currentInfo.buffer, currentInfo.originalNumChannels, (int) currentInfo.finalSize);
+            }
+            else if (currentInfo.originalNumChannels > 1)
             {
                 normaliseImpulseResponse (currentInfo.buffer->getWritePointer (0), (int) currentInfo.finalSize, 1.0);
                 normaliseImpulseResponse (currentInfo.buffer->getWritePointer (1), (int) currentInfo.finalSize, 1.0);
@@ -874,6 +1520,12 @@ private:
     {
         const SpinLock::ScopedLockType sl (processLock);
 
+        currentInfo.originalNumChannels = temporaryNumChannels;
+        currentInfo.originalSize = temporarySize;
+
+        if (impulseResponseOriginal.getNumChannels() < currentInfo.originalNumChannels)
+            impulseResponseOriginal.setSize (currentInfo.originalNumChannels, static_cast<int> (maximumTimeInSamples), false, false, true);
+
         for (auto channel = 0; channel < currentInfo.originalNumChannels; ++channel)
             impulseResponseOriginal.copyFrom (channel, 0, temporaryBuffer, channel, 0, (int) currentInfo.originalSize);
     }
@@ -881,6 +1533,9 @@ private:
     /** Trim and resample the impulse response if needed. */
     void trimAndResampleImpulseResponse (int numChannels, double srcSampleRate, bool mustTrim)
     {
+        if (impulseResponse.getNumChannels() < numChannels)
+            impulseResponse.setSize (numChannels, static_cast<int> (maximumTimeInSamples), false, false, true);
+
         auto thresholdTrim = Decibels::decibelsToGain (-80.0f);
         auto indexStart = 0;
         auto indexEnd = currentInfo.originalSize - 1;
@@ -977,50 +1632,34 @@ private:
             samples[i] *= magnitudeInv;
     }
 
-    // ================================================================================================================
-    /** Initializes the convolution engines depending on the provided sizes
-        and performs the FFT on the impulse responses.
+    /** Normalisation of a matrix of impulse responses, using the same gain for all
+        of them, based on the energy of the loudest one, so that the balance between
+        the channels is kept.
     */
-    void initializeConvolutionEngines()
+    void normaliseImpulseResponseMatrix (AudioBuffer<float>& buffer, int numChannels, int numSamples) const
     {
-        if (currentInfo.maximumBufferSize == 0)
-            return;
+        auto magnitude = 0.0f;
 
-        if (changeLevel == 3)
+        for (auto channel = 0; channel < numChannels; ++channel)
         {
-            for (auto i = 0; i < 2; ++i)
-                engines[i]->initializeConvolutionEngine (currentInfo, i);
+            auto* samples = buffer.getReadPointer (channel);
+            auto channelMagnitude = 0.0f;
 
-            mustInterpolate = false;
-        }
-        else
-        {
-            for (auto i = 0; i < 2; ++i)
-            {
-                engines[i + 2]->initializeConvolutionEngine (currentInfo, i);
-                engines[i + 2]->reset();
+            for (auto i = 0; i < numSamples; ++i)
+                channelMagnitude += samples[i] * samples[i];
 
-                if (isThreadRunning() && threadShouldExit())
-                    return;
-            }
-
-            for (auto i = 0; i < 2; ++i)
-            {
-                changeVolumes[i].setTargetValue (1.0f);
-                changeVolumes[i].reset (currentInfo.sampleRate, 0.05);
-                changeVolumes[i].setTargetValue (0.0f);
-
-                changeVolumes[i + 2].setTargetValue (0.0f);
-                changeVolumes[i + 2].reset (currentInfo.sampleRate, 0.05);
-                changeVolumes[i + 2].setTargetValue (1.0f);
+            magnitude = jmax (magnitude, channelMagnitude);
+        }
 
-            }
+        if (magnitude > 0.0f)
+        {
+            auto magnitudeInv = 1.0f / (4.0f * std::sqrt (magnitude)) * 0.5f;
 
-            mustInterpolate = true;
+            for (auto channel = 0; channel < numChannels; ++channel)
+                buffer.applyGain (channel, 0, numSamples, magnitudeInv);
         }
     }
 
-
     //==============================================================================
     static constexpr int fifoSize = 1024;           // the size of the fifo which handles all the change requests
     AbstractFifo abstractFifo;                      // the abstract fifo
@@ -1032,21 +1671,36 @@ private:
     Array<juce::var> requestsParameter;             // an array of change parameters
 
     int changeLevel = 0;                            // the current level of requested change in the convolution engine
+    bool mustLoadSource = false;                    // tells if the impulse response must be loaded again from its source
+    bool mustUpdateEngine = false;                  // tells if a new convolution engine must be prepared
+    bool usesDefaultImpulseResponse = false;        // tells if no impulse response has been loaded yet
 
     //==============================================================================
     ConvolutionEngine::ProcessingInformation currentInfo;  // the information about the impulse response to load
 
     AudioBuffer<float> temporaryBuffer;             // a temporary buffer that is used when the function copyAndLoadImpulseResponse is called in the main API
+    int temporaryNumChannels = 0, temporarySize = 0; // the size of the data in the temporary buffer
     SpinLock processLock;                           // a necessary lock to use with this temporary buffer
 
     AudioBuffer<float> impulseResponseOriginal;     // a buffer with the original impulse response
     AudioBuffer<float> impulseResponse;             // a buffer with the impulse response trimmed, resampled, resized and normalised
 
     //==============================================================================
-    OwnedArray<ConvolutionEngine> engines;          // the 4 convolution engines being used
+    OwnedArray<ConvolutionEngine> engines;          // the current convolution engine, and the next one during interpolation
+
+    AudioBuffer<float> interpolationBuffer;         // a buffer to do the interpolation between the convolution engines
+    AudioBuffer<float> interpolationGains;          // the gains of both convolution engines for the current block
+    LogRampedValue<float> changeVolumes[2];         // the volumes for each convolution engine during interpolation
+    std::atomic<double> crossfadeLength { 0.05 };   // the length of the interpolation in seconds
 
-    AudioBuffer<float> interpolationBuffer;         // a buffer to do the interpolation between the convolution engines 0-1 and 2-3
-    LogRampedValue<float> changeVolumes[4];         // the volumes for each convolution engine during interpolation
+    enum class SpareEngineState
+    {
+        free,                                       // the spare engine can be prepared by the background thread
+        ready,                                      // the spare engine is ready to be used by the audio thread
+        inUse                                       // the spare engine is being interpolated with the current one
+    };
+
+    std::atomic<SpareEngineState> spareEngineState { SpareEngineState::free };
 
     bool mustInterpolate = false;                   // tells if the convolution engines outputs must be currently interpolated
 
@@ -1068,7 +1722,7 @@ Convolution::~Convolution()
 
 void Convolution::loadImpulseResponse (const void* sourceData, size_t sourceDataSize,
                                        bool wantsStereo, bool wantsTrimming, size_t size,
-                                       bool wantsNormalisation)
+                                       bool wantsNormalisation, bool wantsNonUniformPartitioning)
 {
     if (sourceData == nullptr)
         return;
@@ -1080,7 +1734,8 @@ void Convolution::loadImpulseResponse (const void* sourceData, size_t sourceData
                                      Pimpl::ChangeRequest::changeImpulseResponseSize,
                                      Pimpl::ChangeRequest::changeStereo,
                                      Pimpl::ChangeRequest::changeTrimming,
-                                     Pimpl::ChangeRequest::changeNormalisation };
+                                     Pimpl::ChangeRequest::changeNormalisation,
+                                     Pimpl::ChangeRequest::changePartitioning };
 
     Array<juce::var> sourceParameter;
 
@@ -1091,13 +1746,15 @@ void Convolution::loadImpulseResponse (const void* sourceData, size_t sourceData
                                juce::var (static_cast<int64> (wantedSize)),
                                juce::var (wantsStereo),
                                juce::var (wantsTrimming),
-                               juce::var (wantsNormalisation) };
+                               juce::var (wantsNormalisation),
+                               juce::var (wantsNonUniformPartitioning) };
 
-    pimpl->addToFifo (types, parameters, 5);
+    pimpl->addToFifo (types, parameters, 6);
 }
 
 void Convolution::loadImpulseResponse (const File& fileImpulseResponse, bool wantsStereo,
-                                       bool wantsTrimming, size_t size, bool wantsNormalisation)
+                                       bool wantsTrimming, size_t size, bool wantsNormalisation,
+                                       bool wantsNonUniformPartitioning)
 {
     if (! fileImpulseResponse.existsAsFile())
         return;
@@ -1109,7 +1766,8 @@ void Convolution::loadImpulseResponse (const File& fileImpulseResponse, bool wan
                                      Pimpl::ChangeRequest::changeImpulseResponseSize,
                                      Pimpl::ChangeRequest::changeStereo,
                                      Pimpl::ChangeRequest::changeTrimming,
-                                     Pimpl::ChangeRequest::changeNormalisation };
+                                     Pimpl::ChangeRequest::changeNormalisation,
+                                     Pimpl::ChangeRequest::changePartitioning };
 
     Array<juce::var> sourceParameter;
 
@@ -1120,20 +1778,23 @@ void Convolution::loadImpulseResponse (const File& fileImpulseResponse, bool wan
                                juce::var (static_cast<int64> (wantedSize)),
                                juce::var (wantsStereo),
                                juce::var (wantsTrimming),
-                               juce::var (wantsNormalisation) };
+                               juce::var (wantsNormalisation),
+                               juce::var (wantsNonUniformPartitioning) };
 
-    pimpl->addToFifo (types, parameters, 5);
+    pimpl->addToFifo (types, parameters, 6);
 }
 
 void Convolution::copyAndLoadImpulseResponseFromBuffer (AudioBuffer<float>& buffer,
-                                                        double bufferSampleRate, bool wantsStereo, bool wantsTrimming, bool wantsNormalisation, size_t size)
+                                                        double bufferSampleRate, bool wantsStereo, bool wantsTrimming, bool wantsNormalisation, size_t size,
+                                                        bool wantsNonUniformPartitioning)
 {
     copyAndLoadImpulseResponseFromBlock (AudioBlock<float> (buffer), bufferSampleRate,
-        wantsStereo, wantsTrimming, wantsNormalisation, size);
+        wantsStereo, wantsTrimming, wantsNormalisation, size, wantsNonUniformPartitioning);
 }
 
 void Convolution::copyAndLoadImpulseResponseFromBlock (AudioBlock<float> block, double bufferSampleRate,
-                                                       bool wantsStereo, bool wantsTrimming, bool wantsNormalisation, size_t size)
+                                                       bool wantsStereo, bool wantsTrimming, bool wantsNormalisation, size_t size,
+                                                       bool wantsNonUniformPartitioning)
 {
     jassert (bufferSampleRate > 0);
 
@@ -1143,13 +1804,14 @@ void Convolution::copyAndLoadImpulseResponseFromBlock (AudioBlock<float> block,
     auto maximumSamples = (size_t) pimpl->maximumTimeInSamples;
     auto wantedSize = (size == 0 ? maximumSamples : jmin (size, maximumSamples));
 
-    pimpl->copyBufferToTemporaryLocation (block);
+    pimpl->copyBufferToTemporaryLocation (block, block.getNumChannels() > 1 ? 2 : 1);
 
     Pimpl::ChangeRequest types[] = { Pimpl::ChangeRequest::changeSource,
                                      Pimpl::ChangeRequest::changeImpulseResponseSize,
                                      Pimpl::ChangeRequest::changeStereo,
                                      Pimpl::ChangeRequest::changeTrimming,
-                                     Pimpl::ChangeRequest::changeNormalisation };
+                                     Pimpl::ChangeRequest::changeNormalisation,
+                                     Pimpl::ChangeRequest::changePartitioning };
 
     Array<juce::var> sourceParameter;
     sourceParameter.add (juce::var ((int) ConvolutionEngine::ProcessingInformation::SourceType::sourceAudioBuffer));
@@ -1159,38 +1821,90 @@ void Convolution::copyAndLoadImpulseResponseFromBlock (AudioBlock<float> block,
                                juce::var (static_cast<int64> (wantedSize)),
                                juce::var (wantsStereo),
                                juce::var (wantsTrimming),
-                               juce::var (wantsNormalisation) };
+                               juce::var (wantsNormalisation),
+                               juce::var (wantsNonUniformPartitioning) };
 
-    pimpl->addToFifo (types, parameters, 5);
+    pimpl->addToFifo (types, parameters, 6);
 }
 
-void Convolution::prepare (const ProcessSpec& spec)
+void Convolution::copyAndLoadImpulseResponseMatrixFromBuffer (AudioBuffer<float>& buffer, double bufferSampleRate,
+                                                              int numInputChannels, int numOutputChannels,
+                                                              bool wantsTrimming, bool wantsNormalisation, size_t size,
+                                                              bool wantsNonUniformPartitioning)
 {
-    jassert (isPositiveAndBelow (spec.numChannels, static_cast<uint32> (3))); // only mono and stereo is supported
+    copyAndLoadImpulseResponseMatrixFromBlock (AudioBlock<float> (buffer), bufferSampleRate, numInputChannels, numOutputChannels,
+                                               wantsTrimming, wantsNormalisation, size, wantsNonUniformPartitioning);
+}
 
-    Pimpl::ChangeRequest types[] = { Pimpl::ChangeRequest::changeSampleRate,
-                                     Pimpl::ChangeRequest::changeMaximumBufferSize };
+void Convolution::copyAndLoadImpulseResponseMatrixFromBlock (AudioBlock<float> block, double bufferSampleRate,
+                                                             int numInputChannels, int numOutputChannels,
+                                                             bool wantsTrimming, bool wantsNormalisation, size_t size,
+                                                             bool wantsNonUniformPartitioning)
+{
+    jassert (bufferSampleRate > 0);
+
+    // the block must contain one impulse response for every pair of input and output channels
+    jassert (isPositiveAndNotGreaterThan (numInputChannels,  (int) maximumNumChannels)
+              && isPositiveAndNotGreaterThan (numOutputChannels, (int) maximumNumChannels)
+              && block.getNumChannels() >= (size_t) (numInputChannels * numOutputChannels));
+
+    if (block.getNumSamples() == 0 || numInputChannels <= 0 || numOutputChannels <= 0
+         || block.getNumChannels() < (size_t) (numInputChannels * numOutputChannels))
+        return;
+
+    auto maximumSamples = (size_t) pimpl->maximumTimeInSamples;
+    auto wantedSize = (size == 0 ? maximumSamples : jmin (size, maximumSamples));
+
+    pimpl->copyBufferToTemporaryLocation (block, numInputChannels * numOutputChannels);
+
+    Pimpl::ChangeRequest types[] = { Pimpl::ChangeRequest::changeSource,
+                                     Pimpl::ChangeRequest::changeImpulseResponseSize,
+                                     Pimpl::ChangeRequest::changeStereo,
+                                     Pimpl::ChangeRequest::changeTrimming,
+                                     Pimpl::ChangeRequest::changeNormalisation,
+                                     Pimpl::ChangeRequest::changePartitioning };
+
+    Array<juce::var> sourceParameter;
+    sourceParameter.add (juce::var ((int) ConvolutionEngine::ProcessingInformation::SourceType::sourceAudioBuffer));
+    sourceParameter.add (juce::var (bufferSampleRate));
+    sourceParameter.add (juce::var (numInputChannels));
+    sourceParameter.add (juce::var (numOutputChannels));
 
-    juce::var parameters[] = { juce::var (spec.sampleRate),
-                               juce::var (static_cast<int> (spec.maximumBlockSize)) };
+    juce::var parameters[] = { juce::var (sourceParameter),
+                               juce::var (static_cast<int64> (wantedSize)),
+                               juce::var (true),
+                               juce::var (wantsTrimming),
+                               juce::var (wantsNormalisation),
+                               juce::var (wantsNonUniformPartitioning) };
 
-    pimpl->addToFifo (types, parameters, 2);
-    pimpl->initProcessing (static_cast<int> (spec.maximumBlockSize));
+    pimpl->addToFifo (types, parameters, 6);
+}
 
-    for (size_t channel = 0; channel < spec.numChannels; ++channel)
+void Convolution::prepare (const ProcessSpec& spec)
+{
+    jassert (isPositiveAndNotGreaterThan (spec.numChannels, static_cast<uint32> (maximumNumChannels)));
+
+    auto numChannels = jmin (spec.numChannels, static_cast<uint32> (maximumNumChannels));
+
+    pimpl->prepare (spec.sampleRate, static_cast<int> (spec.maximumBlockSize), static_cast<int> (numChannels));
+
+    for (size_t channel = 0; channel < numChannels; ++channel)
     {
         volumeDry[channel].reset (spec.sampleRate, 0.05);
         volumeWet[channel].reset (spec.sampleRate, 0.05);
     }
 
     sampleRate = spec.sampleRate;
-    dryBuffer = AudioBlock<float> (dryBufferStorage,
-                                   jmin (spec.numChannels, 2u),
-                                   spec.maximumBlockSize);
+    dryBuffer = AudioBlock<float> (dryBufferStorage, numChannels, spec.maximumBlockSize);
 
     isActive = true;
 }
 
+void Convolution::setCrossfadeLength (double lengthInSeconds) noexcept
+{
+    pimpl->setCrossfadeLength (lengthInSeconds);
+}
+
 void Convolution::reset() noexcept
 {
     dryBuffer.clear();
@@ -1203,9 +1917,9 @@ void Convolution::processSamples (const AudioBlock<float>& input, AudioBlock<flo
         return;
 
     jassert (input.getNumChannels() == output.getNumChannels());
-    jassert (isPositiveAndBelow (input.getNumChannels(), static_cast<size_t> (3))); // only mono and stereo is supported
+    jassert (input.getNumChannels() <= dryBuffer.getNumChannels()); // more channels than requested in prepare()
 
-    auto numChannels = jmin (input.getNumChannels(), (size_t) 2);
+    auto numChannels = jmin (input.getNumChannels(), dryBuffer.getNumChannels());
     auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
 
     auto dry = dryBuffer.getSubsetChannelBlock (0, numChannels);
@@ -37,12 +37,28 @@ namespace dsp
     from audio files or memory on the fly without any noticeable artefacts,
     performing resampling and trimming if necessary.
 
+    An impulse response loaded before calling prepare() is used straight away.
+    Afterwards, new impulse responses are prepared on a background thread, and
+    the processing crossfades from the previous one to the new one when it is
+    ready, without any allocation or lock on the audio thread.
+
     The processing is equivalent to the time domain convolution done in the
     class FIRFilter, with a FIRFilter::Coefficients object having as
     coefficients the samples of the impulse response. However, it is more
     efficient in general to do frequency domain convolution when the size of
     the impulse response is higher than 64 samples.
 
+    Long impulse responses can optionally be processed with non-uniform
+    partitioning: the start of the impulse response is still convolved with
+    small partitions to keep a zero latency, while the rest is split into
+    progressively larger partitions which are convolved on a background thread.
+    This is much cheaper than the uniform mode for reverbs lasting several
+    seconds, especially with small block sizes.
+
+    Besides mono and stereo processing, a matrix of impulse responses can be
+    loaded to feed every output channel from every input channel, for true stereo
+    or surround reverbs. See copyAndLoadImpulseResponseMatrixFromBuffer().
+
     @see FIRFilter, FIRFilter::Coefficients, FFT
 
     @tags{DSP}
@@ -58,12 +74,20 @@ public:
     ~Convolution();
 
     //==============================================================================
-    /** Must be called before loading any impulse response, to provide to the
-        convolution the maximumBufferSize to handle, and the sample rate useful for
-        optional resampling.
+    /** Must be called before processing, to provide to the convolution the
+        maximumBufferSize to handle, and the sample rate useful for optional
+        resampling. Any impulse response loaded beforehand is fully prepared by
+        this call, whereas the ones loaded afterwards are prepared on a background
+        thread.
     */
     void prepare (const ProcessSpec&);
 
+    /** Sets the length of the crossfade between the previous and the new impulse
+        response, when a new one is loaded during processing. It is 50 ms by default,
+        and a length of 0 switches to the new impulse response without any crossfade.
+    */
+    void setCrossfadeLength (double lengthInSeconds) noexcept;
+
     /** Resets the processing pipeline, ready to start a new stream of data. */
     void reset() noexcept;
 
@@ -97,10 +121,13 @@ public:
         @param size                     the expected size for the impulse response after loading, can be
                                         set to 0 for requesting maximum original impulse response size
         @param wantsNormalisation       requests to normalise the impulse response amplitude
+        @param wantsNonUniformPartitioning  requests to convolve the tail of the impulse response
+                                        with larger partitions on a background thread
     */
     void loadImpulseResponse (const void* sourceData, size_t sourceDataSize,
                               bool wantsStereo, bool wantsTrimming, size_t size,
-                              bool wantsNormalisation = true);
+                              bool wantsNormalisation = true,
+                              bool wantsNonUniformPartitioning = false);
 
     /** This function loads an impulse response from an audio file on any drive. It
         can load any of the audio formats registered in JUCE, and performs some
@@ -112,10 +139,13 @@ public:
         @param size                     the expected size for the impulse response after loading, can be
                                         set to 0 for requesting maximum original impulse response size
         @param wantsNormalisation       requests to normalise the impulse response amplitude
+        @param wantsNonUniformPartitioning  requests to convolve the tail of the impulse response
+                                        with larger partitions on a background thread
     */
     void loadImpulseResponse (const File& fileImpulseResponse,
                               bool wantsStereo, bool wantsTrimming, size_t size,
-                              bool wantsNormalisation = true);
+                              bool wantsNormalisation = true,
+                              bool wantsNonUniformPartitioning = false);
 
     /** This function loads an impulse response from an audio buffer, which is
         copied before doing anything else. Performs some resampling and
@@ -128,10 +158,12 @@ public:
         @param wantsNormalisation       requests to normalise the impulse response amplitude
         @param size                     the expected size for the impulse response after loading, can be
                                         set to 0 for requesting maximum original impulse response size
+        @param wantsNonUniformPartitioning  requests to convolve the tail of the impulse response
+                                        with larger partitions on a background thread
     */
     void copyAndLoadImpulseResponseFromBuffer (AudioBuffer<float>& buffer, double bufferSampleRate,
                                                bool wantsStereo, bool wantsTrimming, bool wantsNormalisation,
-                                               size_t size);
+                                               size_t size, bool wantsNonUniformPartitioning = false);
 
     /** This function loads an impulse response from an audio block, which is
         copied before doing anything else. Performs some resampling and
@@ -144,10 +176,55 @@ public:
         @param wantsNormalisation       requests to normalise the impulse response amplitude
         @param size                     the expected size for the impulse response after loading,
                                         -1 for maximum length
+        @param wantsNonUniformPartitioning  requests to convolve the tail of the impulse response
+                                        with larger partitions on a background thread
     */
     void copyAndLoadImpulseResponseFromBlock (AudioBlock<float> block, double bufferSampleRate,
                                               bool wantsStereo, bool wantsTrimming, bool wantsNormalisation,
-                                              size_t size);
+                                              size_t size, bool wantsNonUniformPartitioning = false);
+
+    /** This function loads a matrix of impulse responses from an audio buffer, for
+        true stereo or multichannel convolution. The buffer is copied before doing
+        anything else, and it is pre-processed in the same way as with the other
+        loading functions.
+
+        The buffer must hold numInputChannels * numOutputChannels channels, the
+        impulse response going from input i to output o being in the channel
+        (i * numOutputChannels + o). For instance, a true stereo reverb uses 2 input
+        and 2 output channels, with the LL, LR, RL and RR impulse responses.
+
+        The forward FFT of each input channel is shared by all its impulse responses,
+        and the contributions to each output channel are summed in the frequency
+        domain, so only one inverse FFT per output channel is needed. When
+        normalisation is requested, the same gain is used for all the impulse
+        responses, so that the balance between them is kept.
+
+        The convolution must have been prepared with at least as many channels as
+        the largest of numInputChannels and numOutputChannels, up to 8 channels.
+
+        @param buffer                   the AudioBuffer to use
+        @param bufferSampleRate         the sampleRate of the data in the AudioBuffer
+        @param numInputChannels         the number of input channels of the matrix
+        @param numOutputChannels        the number of output channels of the matrix
+        @param wantsTrimming            requests to trim the start and the end of the impulse responses
+        @param wantsNormalisation       requests to normalise the impulse responses amplitude
+        @param size                     the expected size for the impulse responses after loading, can be
+                                        set to 0 for requesting maximum original impulse response size
+        @param wantsNonUniformPartitioning  requests to convolve the tail of the impulse responses
+                                        with larger partitions on a background thread
+    */
+    void copyAndLoadImpulseResponseMatrixFromBuffer (AudioBuffer<float>& buffer, double bufferSampleRate,
+                                                     int numInputChannels, int numOutputChannels,
+                                                     bool wantsTrimming, bool wantsNormalisation, size_t size,
+                                                     bool wantsNonUniformPartitioning = false);
+
+    /** This function loads a matrix of impulse responses from an audio block. See
+        copyAndLoadImpulseResponseMatrixFromBuffer() for the details.
+    */
+    void copyAndLoadImpulseResponseMatrixFromBlock (AudioBlock<float> block, double bufferSampleRate,
+                                                    int numInputChannels, int numOutputChannels,
+                                                    bool wantsTrimming, bool wantsNormalisation, size_t size,
+                                                    bool wantsNonUniformPartitioning = false);
 
 
 private:
@@ -159,10 +236,12 @@ private:
     void processSamples (const AudioBlock<float>&, AudioBlock<float>&, bool isBypassed) noexcept;
 
     //==============================================================================
+    static constexpr size_t maximumNumChannels = 8;
+
     double sampleRate;
     bool currentIsBypassed = false;
     bool isActive = false;
-    SmoothedValue<float> volumeDry[2], volumeWet[2];
+    SmoothedValue<float> volumeDry[maximumNumChannels], volumeWet[maximumNumChannels];
     AudioBlock<float> dryBuffer;
     HeapBlock<char> dryBufferStorage;
 
@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class ConvolutionBenchmarks  : public Benchmark
+{
+public:
+    ConvolutionBenchmarks()  : Benchmark ("Convolution", "DSP") {}
+
+    void runBenchmark() override
+    {
+        const double sampleRate = 48000.0;
+        const int blockSize = 256;
+
+        for (int impulseLength : { 1024, 16384, 65536 })
+        {
+            AudioBuffer<float> impulse (2, impulseLength);
+            fillWithNoise (impulse, impulseLength);
+
+            Convolution convolution;
+            convolution.copyAndLoadImpulseResponseFromBuffer (impulse, sampleRate, true, false, false, 0);
+            convolution.prepare ({ sampleRate, (uint32) blockSize, 2 });
+
+            AudioBuffer<float> buffer (2, blockSize);
+            fillWithNoise (buffer, blockSize);
+            AudioBlock<float> block (buffer);
+
+            // The impulse response is loaded on a background thread, so give it a chance to arrive
+            for (int i = 0; i < 100; ++i)
+            {
+                convolution.process (ProcessContextReplacing<float> (block));
+                Thread::sleep (1);
+            }
+
+            measure ("stereo, " + String (blockSize) + " sample blocks, " + String (impulseLength) + " sample impulse", [&]
+            {
+                convolution.process (ProcessContextReplacing<float> (block));
+                doNotOptimiseAway (buffer.getSample (0, 0));
+            });
+        }
+    }
+
+private:
+    static void fillWithNoise (AudioBuffer<float>& buffer, int numSamples)
+    {
+        Random r (numSamples);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, (r.nextFloat() * 2.0f - 1.0f) * 0.01f);
+    }
+};
+
+static ConvolutionBenchmarks convolutionBenchmarks;
+
+} // namespace dsp
+} // namespace juce
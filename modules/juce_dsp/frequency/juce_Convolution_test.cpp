@@ -0,0 +1,259 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct ConvolutionTest  : public UnitTest
+{
+    ConvolutionTest()  : UnitTest ("Convolution", "DSP") {}
+
+    static void fillRandom (Random& random, AudioBuffer<float>& buffer)
+    {
+        for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (auto i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, (2.0f * random.nextFloat()) - 1.0f);
+    }
+
+    /** Direct time domain convolution, adding the result to the output. */
+    static void addReferenceConvolution (const float* x, int numSamples, const float* h, int impulseSize, float* y)
+    {
+        for (auto n = 0; n < numSamples; ++n)
+        {
+            double sum = 0;
+
+            for (auto k = 0; k <= jmin (n, impulseSize - 1); ++k)
+                sum += (double) h[k] * (double) x[n - k];
+
+            y[n] += (float) sum;
+        }
+    }
+
+    /** Convolution of each input with the matching channel of the impulse response. */
+    static void referenceConvolution (const AudioBuffer<float>& input, const AudioBuffer<float>& impulse,
+                                      AudioBuffer<float>& output)
+    {
+        output.clear();
+
+        for (auto channel = 0; channel < input.getNumChannels(); ++channel)
+            addReferenceConvolution (input.getReadPointer (channel), input.getNumSamples(),
+                                     impulse.getReadPointer (jmin (channel, impulse.getNumChannels() - 1)), impulse.getNumSamples(),
+                                     output.getWritePointer (channel));
+    }
+
+    /** Convolution with a matrix of impulse responses, the one going from input i
+        to output o being in the channel (i * numOutputs + o).
+    */
+    static void referenceMatrixConvolution (const AudioBuffer<float>& input, const AudioBuffer<float>& impulse,
+                                            int numInputs, int numOutputs, AudioBuffer<float>& output)
+    {
+        output.clear();
+
+        for (auto i = 0; i < numInputs; ++i)
+            for (auto o = 0; o < numOutputs; ++o)
+                addReferenceConvolution (input.getReadPointer (i), input.getNumSamples(),
+                                         impulse.getReadPointer (i * numOutputs + o), impulse.getNumSamples(),
+                                         output.getWritePointer (o));
+    }
+
+    /** Runs the convolution with irregular block sizes that never exceed the prepared maximum. */
+    void renderConvolution (Convolution& convolution, const AudioBuffer<float>& input, AudioBuffer<float>& output,
+                            int maximumBlockSize, Random& random)
+    {
+        output.makeCopyOf (input);
+
+        AudioBlock<float> block (output);
+
+        for (size_t position = 0; position < block.getNumSamples();)
+        {
+            auto numSamples = jmin ((size_t) (1 + random.nextInt (maximumBlockSize)), block.getNumSamples() - position);
+            auto subBlock = block.getSubBlock (position, numSamples);
+
+            convolution.process (ProcessContextReplacing<float> (subBlock));
+            position += numSamples;
+        }
+    }
+
+    float getMaximumDifference (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        auto maximum = 0.0f;
+
+        for (auto channel = 0; channel < a.getNumChannels(); ++channel)
+            for (auto i = 0; i < a.getNumSamples(); ++i)
+                maximum = jmax (maximum, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return maximum;
+    }
+
+    void checkAgainstReference (int impulseSize, int maximumBlockSize, bool nonUniform)
+    {
+        auto random = getRandom();
+        const double sampleRate = 48000.0;
+        const int numSamples = 16384;
+
+        AudioBuffer<float> impulse (2, impulseSize), input (2, numSamples), output, expected (2, numSamples);
+
+        fillRandom (random, input);
+        fillRandom (random, impulse);
+        impulse.applyGain (0.05f);
+
+        referenceConvolution (input, impulse, expected);
+
+        Convolution convolution;
+        convolution.copyAndLoadImpulseResponseFromBuffer (impulse, sampleRate, true, false, false, 0, nonUniform);
+        convolution.prepare ({ sampleRate, (uint32) maximumBlockSize, 2 });
+
+        renderConvolution (convolution, input, output, maximumBlockSize, random);
+
+        expectLessThan (getMaximumDifference (output, expected), 1.0e-3f);
+    }
+
+    void checkMatrixAgainstReference (int numInputs, int numOutputs, int impulseSize, int maximumBlockSize, bool nonUniform)
+    {
+        auto random = getRandom();
+        const double sampleRate = 48000.0;
+        const int numSamples = 8192;
+        auto numChannels = jmax (numInputs, numOutputs);
+
+        AudioBuffer<float> impulse (numInputs * numOutputs, impulseSize), input (numChannels, numSamples),
+                           output, expected (numChannels, numSamples);
+
+        fillRandom (random, input);
+        fillRandom (random, impulse);
+        impulse.applyGain (0.05f);
+
+        referenceMatrixConvolution (input, impulse, numInputs, numOutputs, expected);
+
+        Convolution convolution;
+        convolution.copyAndLoadImpulseResponseMatrixFromBuffer (impulse, sampleRate, numInputs, numOutputs,
+                                                                false, false, 0, nonUniform);
+        convolution.prepare ({ sampleRate, (uint32) maximumBlockSize, (uint32) numChannels });
+
+        renderConvolution (convolution, input, output, maximumBlockSize, random);
+
+        expectLessThan (getMaximumDifference (output, expected), 1.0e-3f);
+    }
+
+    /** Loads a new impulse response while processing a constant signal, and checks
+        that the output moves smoothly to the new level once the background thread
+        has prepared it.
+    */
+    void checkImpulseResponseSwap (double crossfadeLength)
+    {
+        const double sampleRate = 48000.0;
+        const int blockSize = 256;
+
+        AudioBuffer<float> impulse (1, 100), buffer (2, blockSize);
+        impulse.clear();
+        impulse.setSample (0, 0, 1.0f);
+
+        Convolution convolution;
+        convolution.setCrossfadeLength (crossfadeLength);
+        convolution.copyAndLoadImpulseResponseFromBuffer (impulse, sampleRate, true, false, false, 0);
+        convolution.prepare ({ sampleRate, (uint32) blockSize, 2 });
+
+        impulse.setSample (0, 0, 0.0f);
+        impulse.setSample (0, 50, 0.5f);
+        convolution.copyAndLoadImpulseResponseFromBuffer (impulse, sampleRate, true, false, false, 0);
+
+        auto maximumStep = 0.0f;
+        auto previous = 1.0f;
+        auto hasSwapped = false;
+
+        for (auto timeout = Time::getMillisecondCounter() + 10000; Time::getMillisecondCounter() < timeout;)
+        {
+            for (auto channel = 0; channel < 2; ++channel)
+                FloatVectorOperations::fill (buffer.getWritePointer (channel), 1.0f, blockSize);
+
+            AudioBlock<float> block (buffer);
+            convolution.process (ProcessContextReplacing<float> (block));
+
+            for (auto i = 0; i < blockSize; ++i)
+            {
+                maximumStep = jmax (maximumStep, std::abs (buffer.getSample (0, i) - previous));
+                previous = buffer.getSample (0, i);
+            }
+
+            // wait for the crossfade to be over
+            if (std::abs (previous - 0.5f) < 1.0e-4f && std::abs (buffer.getSample (0, 0) - 0.5f) < 1.0e-4f)
+            {
+                hasSwapped = true;
+                break;
+            }
+
+            Thread::sleep (1);
+        }
+
+        expect (hasSwapped);
+        expectEquals ((float) buffer.getSample (1, blockSize - 1), previous);
+
+        if (crossfadeLength > 0)
+            expectLessThan (maximumStep, 0.01f);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Uniform partitioning");
+        {
+            checkAgainstReference (3000, 64, false);
+            checkAgainstReference (3000, 256, false);
+        }
+
+        beginTest ("Non-uniform partitioning");
+        {
+            checkAgainstReference (100, 64, true);
+            checkAgainstReference (10000, 64, true);
+            checkAgainstReference (10000, 200, true);
+            checkAgainstReference (12000, 1024, true);
+        }
+
+        beginTest ("True stereo");
+        {
+            checkMatrixAgainstReference (2, 2, 2000, 128, false);
+            checkMatrixAgainstReference (2, 2, 6000, 64, true);
+        }
+
+        beginTest ("Matrix");
+        {
+            checkMatrixAgainstReference (1, 4, 1000, 128, false);
+            checkMatrixAgainstReference (3, 2, 5000, 96, true);
+        }
+
+        beginTest ("Impulse response swap");
+        {
+            checkImpulseResponseSwap (0.05);
+            checkImpulseResponseSwap (0.2);
+            checkImpulseResponseSwap (0.0);
+        }
+    }
+};
+
+static ConvolutionTest convolutionUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -35,6 +35,21 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+    virtual void performCompactRealOnlyForwardTransform (float*) const noexcept = 0;
+    virtual void performCompactRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    // engines with a cheaper way of running many transforms can override these
+    virtual void performBatchedRealOnlyForwardTransform (float* d, int numTransforms, int distance) const noexcept
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            performCompactRealOnlyForwardTransform (d + (size_t) i * (size_t) distance);
+    }
+
+    virtual void performBatchedRealOnlyInverseTransform (float* d, int numTransforms, int distance) const noexcept
+    {
+        for (int i = 0; i < numTransforms; ++i)
+            performCompactRealOnlyInverseTransform (d + (size_t) i * (size_t) distance);
+    }
 };
 
 struct FFT::Engine
@@ -163,6 +178,67 @@ struct FFTFallback  : public FFT::Instance
         }
     }
 
+    void performCompactRealOnlyForwardTransform (float* d) const noexcept override
+    {
+        if (size == 1)
+        {
+            d[1] = 0.0f;
+            return;
+        }
+
+        // the compact layout has no room for the full spectrum, so it gets computed in the scratch space
+        callWithScratch ([this, d] (Complex<float>* scratch)
+        {
+            auto* spectrum = scratch + size;
+
+            for (int i = 0; i < size; ++i)
+                scratch[i] = { d[i], 0 };
+
+            perform (scratch, spectrum, false);
+            std::copy (spectrum, spectrum + (size >> 1) + 1, reinterpret_cast<Complex<float>*> (d));
+        });
+    }
+
+    void performCompactRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        if (size == 1)
+            return;
+
+        callWithScratch ([this, d] (Complex<float>* scratch)
+        {
+            auto* input = reinterpret_cast<const Complex<float>*> (d);
+            auto* output = scratch + size;
+
+            for (int i = 0; i <= (size >> 1); ++i)
+                scratch[i] = input[i];
+
+            for (auto i = (size >> 1) + 1; i < size; ++i)
+                scratch[i] = std::conj (input[size - i]);
+
+            perform (scratch, output, true);
+
+            for (int i = 0; i < size; ++i)
+                d[i] = output[i].real();
+        });
+    }
+
+    /** Calls the function with enough scratch space for two arrays of size complex numbers. */
+    template <typename FunctionType>
+    void callWithScratch (FunctionType&& function) const noexcept
+    {
+        const size_t scratchSize = 16 + 2 * sizeof (Complex<float>) * (size_t) size;
+
+        if (scratchSize < maxFFTScratchSpaceToAlloca)
+        {
+            function (static_cast<Complex<float>*> (alloca (scratchSize)));
+        }
+        else
+        {
+            HeapBlock<char> heapSpace (scratchSize);
+            function (reinterpret_cast<Complex<float>*> (heapSpace.getData()));
+        }
+    }
+
     void performRealOnlyForwardTransform (Complex<float>* scratch, float* d) const noexcept
     {
         for (int i = 0; i < size; ++i)
@@ -422,6 +498,455 @@ struct FFTFallback  : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+#if JUCE_USE_SIMD
+/*  A radix-4 Stockham FFT working on split real/imaginary arrays, so that each
+    butterfly can be computed on a whole SIMDRegister of consecutive points. The
+    real-only transforms run a complex FFT of half the size and untangle the
+    result afterwards.
+*/
+struct SIMDFFT  : public FFT::Instance
+{
+    // faster than the fallback, but slower than any of the vendor libraries
+    static constexpr int priority = 0;
+
+    using Vec = SIMDRegister<float>;
+    static constexpr int vectorSize = (int) Vec::SIMDNumElements;
+
+    static SIMDFFT* create (int order)
+    {
+        // the smallest transforms are left to the fallback engine
+        if (order < 4)
+            return nullptr;
+
+        return new SIMDFFT (order);
+    }
+
+    SIMDFFT (int order)
+        : size (1 << order),
+          complexPlan (size),
+          halfPlan (size / 2),
+          realTwiddles ((size_t) size / 2)
+    {
+        for (int i = 0; i < size / 2; ++i)
+        {
+            auto phase = -MathConstants<double>::twoPi * i / size;
+            realTwiddles[i] = { (float) std::cos (phase), (float) std::sin (phase) };
+        }
+
+        scratchStorage.calloc ((size_t) (4 * size + vectorSize));
+        auto* aligned = Vec::getNextSIMDAlignedPtr (scratchStorage.getData());
+
+        for (int i = 0; i < 4; ++i)
+            scratch[i] = aligned + i * size;
+    }
+
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        // an inverse transform is a forward one with the real and imaginary parts swapped
+        auto* re = scratch[inverse ? 1 : 0];
+        auto* im = scratch[inverse ? 0 : 1];
+
+        for (int i = 0; i < size; ++i)
+        {
+            re[i] = input[i].real();
+            im[i] = input[i].imag();
+        }
+
+        auto result = complexPlan.perform (scratch);
+        re = result[inverse ? 1 : 0];
+        im = result[inverse ? 0 : 1];
+
+        auto scale = inverse ? 1.0f / (float) size : 1.0f;
+
+        for (int i = 0; i < size; ++i)
+            output[i] = { re[i] * scale, im[i] * scale };
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        performRealTransform (d);
+
+        if (! ignoreNegativeFreqs)
+        {
+            auto* out = reinterpret_cast<Complex<float>*> (d);
+
+            for (int i = (size / 2) + 1; i < size; ++i)
+                out[i] = std::conj (out[size - i]);
+        }
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        performInverseRealTransform (d);
+        zeromem (d + size, sizeof (float) * (size_t) size);
+    }
+
+    void performCompactRealOnlyForwardTransform (float* d) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        performRealTransform (d);
+    }
+
+    void performCompactRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        performInverseRealTransform (d);
+    }
+
+    void performBatchedRealOnlyForwardTransform (float* d, int numTransforms, int distance) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        for (int i = 0; i < numTransforms; ++i)
+            performRealTransform (d + (size_t) i * (size_t) distance);
+    }
+
+    void performBatchedRealOnlyInverseTransform (float* d, int numTransforms, int distance) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        for (int i = 0; i < numTransforms; ++i)
+            performInverseRealTransform (d + (size_t) i * (size_t) distance);
+    }
+
+    /** Writes the (size / 2) + 1 non-negative frequencies of the real signal in d. */
+    void performRealTransform (float* d) const noexcept
+    {
+        auto half = size / 2;
+
+        // the even samples are used as the real part and the odd ones as the imaginary part
+        for (int i = 0; i < half; ++i)
+        {
+            scratch[0][i] = d[2 * i];
+            scratch[1][i] = d[2 * i + 1];
+        }
+
+        auto result = halfPlan.perform (scratch);
+        auto* re = result[0];
+        auto* im = result[1];
+        auto* out = reinterpret_cast<Complex<float>*> (d);
+
+        out[0]    = { re[0] + im[0], 0.0f };
+        out[half] = { re[0] - im[0], 0.0f };
+
+        for (int i = 1; i < half; ++i)
+        {
+            Complex<float> z (re[i], im[i]), zMirror (re[half - i], -im[half - i]);
+
+            auto even = 0.5f * (z + zMirror);
+            auto odd  = Complex<float> (0.0f, -0.5f) * (z - zMirror);
+
+            out[i] = even + realTwiddles[i] * odd;
+        }
+    }
+
+    /** Turns the (size / 2) + 1 non-negative frequencies in d back into size samples. */
+    void performInverseRealTransform (float* d) const noexcept
+    {
+        auto half = size / 2;
+        auto* in = reinterpret_cast<const Complex<float>*> (d);
+
+        // rebuilds the spectrum of the even/odd packed signal, already swapped for the inverse
+        for (int i = 0; i < half; ++i)
+        {
+            auto mirror = std::conj (in[half - i]);
+
+            auto even = 0.5f * (in[i] + mirror);
+            auto odd  = 0.5f * (in[i] - mirror) * std::conj (realTwiddles[i]);
+            auto z = even + Complex<float> (-odd.imag(), odd.real());
+
+            scratch[1][i] = z.real();
+            scratch[0][i] = z.imag();
+        }
+
+        auto result = halfPlan.perform (scratch);
+        auto* re = result[1];
+        auto* im = result[0];
+        auto scale = 1.0f / (float) half;
+
+        for (int i = 0; i < half; ++i)
+        {
+            d[2 * i]     = re[i] * scale;
+            d[2 * i + 1] = im[i] * scale;
+        }
+    }
+
+    //==============================================================================
+    template <typename Type>
+    struct SplitComplex
+    {
+        SplitComplex operator+ (SplitComplex other) const noexcept   { return { re + other.re, im + other.im }; }
+        SplitComplex operator- (SplitComplex other) const noexcept   { return { re - other.re, im - other.im }; }
+
+        SplitComplex operator* (SplitComplex other) const noexcept
+        {
+            return { re * other.re - im * other.im,
+                     re * other.im + im * other.re };
+        }
+
+        // multiplication by j
+        SplitComplex rotated() const noexcept                         { return { negate (im), re }; }
+
+        Type re, im;
+    };
+
+    static float negate (float value) noexcept                       { return -value; }
+    static Vec negate (Vec value) noexcept                           { return Vec::expand (0.0f) - value; }
+    static void fill (float& value, float source) noexcept           { value = source; }
+    static void fill (Vec& value, float source) noexcept             { value = Vec::expand (source); }
+    static void load (float& value, const float* source) noexcept    { value = *source; }
+    static void load (Vec& value, const float* source) noexcept      { value = Vec::fromRawArray (source); }
+    static void store (float value, float* dest) noexcept            { *dest = value; }
+    static void store (Vec value, float* dest) noexcept              { value.copyToRawArray (dest); }
+
+    template <typename Type>
+    static SplitComplex<Type> load (const float* re, const float* im, int index) noexcept
+    {
+        SplitComplex<Type> result;
+        load (result.re, re + index);
+        load (result.im, im + index);
+        return result;
+    }
+
+    template <typename Type>
+    static void store (SplitComplex<Type> value, float* re, float* im, int index) noexcept
+    {
+        store (value.re, re + index);
+        store (value.im, im + index);
+    }
+
+    //==============================================================================
+    struct Plan
+    {
+        Plan (int sizeToUse)  : fftSize (sizeToUse)
+        {
+            // each radix-4 stage needs the three twiddles of each of its butterflies,
+            // padded so that every table starts on a SIMD boundary
+            size_t twiddleSize = 0;
+
+            for (int length = fftSize, stride = 1; length > 1; stride *= 4)
+            {
+                if (length == 2)
+                {
+                    stages.add ({ length, stride, 0, nullptr });
+                    break;
+                }
+
+                auto paddedLength = (int) (((length / 4) + vectorSize - 1) & ~(vectorSize - 1));
+                stages.add ({ length, stride, paddedLength, nullptr });
+
+                twiddleSize += 6 * (size_t) paddedLength;
+                length /= 4;
+            }
+
+            twiddleStorage.calloc (twiddleSize + (size_t) vectorSize);
+            auto* twiddles = Vec::getNextSIMDAlignedPtr (twiddleStorage.getData());
+
+            for (auto& stage : stages)
+            {
+                if (stage.length == 2)
+                    continue;
+
+                stage.twiddles = twiddles;
+                twiddles += 6 * stage.paddedLength;
+
+                for (int p = 0; p < stage.length / 4; ++p)
+                {
+                    for (int k = 1; k < 4; ++k)
+                    {
+                        auto phase = -MathConstants<double>::twoPi * k * p / stage.length;
+
+                        stage.twiddles[(2 * k - 2) * stage.paddedLength + p] = (float) std::cos (phase);
+                        stage.twiddles[(2 * k - 1) * stage.paddedLength + p] = (float) std::sin (phase);
+                    }
+                }
+            }
+        }
+
+        /** Performs a forward transform of the split complex data in the first two
+            buffers, using the last two as working space. Returns the pair of buffers
+            holding the result.
+        */
+        float* const* perform (float* const* buffers) const noexcept
+        {
+            auto current = 0;
+
+            for (auto& stage : stages)
+            {
+                auto* xr = buffers[current];
+                auto* xi = buffers[current + 1];
+                auto* yr = buffers[2 - current];
+                auto* yi = buffers[3 - current];
+
+                if (stage.length == 2)
+                    performRadix2 (stage, xr, xi, yr, yi);
+                else
+                    performRadix4 (stage, xr, xi, yr, yi);
+
+                current = 2 - current;
+            }
+
+            return buffers + current;
+        }
+
+        struct Stage
+        {
+            int length, stride, paddedLength;
+            float* twiddles;
+        };
+
+        static void performRadix2 (const Stage& stage, const float* xr, const float* xi, float* yr, float* yi) noexcept
+        {
+            auto s = stage.stride;
+
+            if (s >= vectorSize)
+            {
+                for (int q = 0; q < s; q += vectorSize)
+                    butterfly2<Vec> (xr, xi, yr, yi, q, s);
+            }
+            else
+            {
+                for (int q = 0; q < s; ++q)
+                    butterfly2<float> (xr, xi, yr, yi, q, s);
+            }
+        }
+
+        static void performRadix4 (const Stage& stage, const float* xr, const float* xi, float* yr, float* yi) noexcept
+        {
+            auto s = stage.stride;
+            auto n1 = stage.length / 4;
+
+            if (s >= vectorSize)
+            {
+                for (int p = 0; p < n1; ++p)
+                {
+                    auto w1 = getTwiddle<Vec> (stage, 0, p);
+                    auto w2 = getTwiddle<Vec> (stage, 1, p);
+                    auto w3 = getTwiddle<Vec> (stage, 2, p);
+
+                    for (int q = 0; q < s; q += vectorSize)
+                        butterfly4<Vec> (xr, xi, yr, yi, q, s, n1, p, w1, w2, w3);
+                }
+            }
+            else if (s == 1 && n1 >= vectorSize)
+            {
+                // the first stage is vectorised across butterflies instead
+                for (int p = 0; p < n1; p += vectorSize)
+                    butterfly4Interleaved (stage, xr, xi, yr, yi, n1, p);
+            }
+            else
+            {
+                for (int p = 0; p < n1; ++p)
+                {
+                    auto w1 = getTwiddle<float> (stage, 0, p);
+                    auto w2 = getTwiddle<float> (stage, 1, p);
+                    auto w3 = getTwiddle<float> (stage, 2, p);
+
+                    for (int q = 0; q < s; ++q)
+                        butterfly4<float> (xr, xi, yr, yi, q, s, n1, p, w1, w2, w3);
+                }
+            }
+        }
+
+        template <typename Type>
+        static SplitComplex<Type> getTwiddle (const Stage& stage, int index, int p) noexcept
+        {
+            SplitComplex<Type> result;
+            fill (result.re, stage.twiddles[2 * index * stage.paddedLength + p]);
+            fill (result.im, stage.twiddles[(2 * index + 1) * stage.paddedLength + p]);
+            return result;
+        }
+
+        template <typename Type>
+        static void butterfly2 (const float* xr, const float* xi, float* yr, float* yi, int q, int s) noexcept
+        {
+            auto a = load<Type> (xr, xi, q);
+            auto b = load<Type> (xr, xi, q + s);
+
+            store (a + b, yr, yi, q);
+            store (a - b, yr, yi, q + s);
+        }
+
+        template <typename Type>
+        static void butterfly4 (const float* xr, const float* xi, float* yr, float* yi, int q, int s, int n1, int p,
+                                SplitComplex<Type> w1, SplitComplex<Type> w2, SplitComplex<Type> w3) noexcept
+        {
+            auto a = load<Type> (xr, xi, q + s * p);
+            auto b = load<Type> (xr, xi, q + s * (p + n1));
+            auto c = load<Type> (xr, xi, q + s * (p + 2 * n1));
+            auto d = load<Type> (xr, xi, q + s * (p + 3 * n1));
+
+            auto apc = a + c, amc = a - c, bpd = b + d;
+            auto jbmd = (b - d).rotated();
+
+            store (apc + bpd,         yr, yi, q + s * (4 * p));
+            store (w1 * (amc - jbmd), yr, yi, q + s * (4 * p + 1));
+            store (w2 * (apc - bpd),  yr, yi, q + s * (4 * p + 2));
+            store (w3 * (amc + jbmd), yr, yi, q + s * (4 * p + 3));
+        }
+
+        static void butterfly4Interleaved (const Stage& stage, const float* xr, const float* xi, float* yr, float* yi,
+                                           int n1, int p) noexcept
+        {
+            auto a = load<Vec> (xr, xi, p);
+            auto b = load<Vec> (xr, xi, p + n1);
+            auto c = load<Vec> (xr, xi, p + 2 * n1);
+            auto d = load<Vec> (xr, xi, p + 3 * n1);
+
+            auto w1 = load<Vec> (stage.twiddles,                           stage.twiddles + stage.paddedLength,     p);
+            auto w2 = load<Vec> (stage.twiddles + 2 * stage.paddedLength,  stage.twiddles + 3 * stage.paddedLength, p);
+            auto w3 = load<Vec> (stage.twiddles + 4 * stage.paddedLength,  stage.twiddles + 5 * stage.paddedLength, p);
+
+            auto apc = a + c, amc = a - c, bpd = b + d;
+            auto jbmd = (b - d).rotated();
+
+            SplitComplex<Vec> results[] = { apc + bpd, w1 * (amc - jbmd), w2 * (apc - bpd), w3 * (amc + jbmd) };
+
+            // the four outputs of each butterfly are adjacent, so they get transposed on the way out
+            alignas (Vec::SIMDRegisterSize) float re[4][vectorSize];
+            alignas (Vec::SIMDRegisterSize) float im[4][vectorSize];
+
+            for (int k = 0; k < 4; ++k)
+                store (results[k], re[k], im[k], 0);
+
+            for (int i = 0; i < vectorSize; ++i)
+            {
+                for (int k = 0; k < 4; ++k)
+                {
+                    yr[4 * (p + i) + k] = re[k][i];
+                    yi[4 * (p + i) + k] = im[k][i];
+                }
+            }
+        }
+
+        int fftSize;
+        Array<Stage> stages;
+        HeapBlock<float> twiddleStorage;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Plan)
+    };
+
+    //==============================================================================
+    int size;
+    Plan complexPlan, halfPlan;
+    HeapBlock<Complex<float>> realTwiddles;
+
+    SpinLock processLock;
+    HeapBlock<float> scratchStorage;
+    float* scratch[4];
+};
+
+FFT::EngineImpl<SIMDFFT> simdFFT;
+#endif
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -494,6 +1019,31 @@ struct AppleFFT  : public FFT::Instance
         vDSP_vclr (inoutData + size, 1, static_cast<size_t> (size));
     }
 
+    void performCompactRealOnlyForwardTransform (float* inoutData) const noexcept override
+    {
+        auto size = (1 << order);
+        auto* inout = reinterpret_cast<Complex<float>*> (inoutData);
+        auto splitInOut (toSplitComplex (inout));
+
+        vDSP_fft_zrip (fftSetup, &splitInOut, 2, order, kFFTDirection_Forward);
+        vDSP_vsmul (inoutData, 1, &forwardNormalisation, inoutData, 1, static_cast<size_t> (size));
+
+        mirrorResult (inout, true);
+    }
+
+    void performCompactRealOnlyInverseTransform (float* inoutData) const noexcept override
+    {
+        auto* inout = reinterpret_cast<Complex<float>*> (inoutData);
+        auto size = (1 << order);
+        auto splitInOut (toSplitComplex (inout));
+
+        if (size != 1)
+            inout[0] = Complex<float> (inout[0].real(), inout[size >> 1].real());
+
+        vDSP_fft_zrip (fftSetup, &splitInOut, 2, order, kFFTDirection_Inverse);
+        vDSP_vsmul (inoutData, 1, &inverseNormalisation, inoutData, 1, static_cast<size_t> (size));
+    }
+
 private:
     //==============================================================================
     void mirrorResult (Complex<float>* out, bool ignoreNegativeFreqs) const noexcept
@@ -701,6 +1251,20 @@ struct FFTWImpl  : public FFT::Instance
         FloatVectorOperations::multiply ((float*) inputOutputData, 1.0f / static_cast<float> (n), (int) n);
     }
 
+    // the in-place r2c and c2r plans only ever touch size + 2 floats
+    void performCompactRealOnlyForwardTransform (float* inputOutputData) const noexcept override
+    {
+        if (order == 0)
+            inputOutputData[1] = 0.0f;
+        else
+            fftw.execute_r2c_fftw (r2c, inputOutputData, reinterpret_cast<Complex<float>*> (inputOutputData));
+    }
+
+    void performCompactRealOnlyInverseTransform (float* inputOutputData) const noexcept override
+    {
+        performRealOnlyInverseTransform (inputOutputData);
+    }
+
     //==============================================================================
     // fftw's plan_* and destroy_* methods are NOT thread safe. So we need to share
     // a lock between all instances of FFTWImpl
@@ -797,6 +1361,19 @@ struct IntelFFT  : public FFT::Instance
         DftiComputeBackward (c2r, inputOutputData);
     }
 
+    void performCompactRealOnlyForwardTransform (float* inputOutputData) const noexcept override
+    {
+        if (order == 0)
+            inputOutputData[1] = 0.0f;
+        else
+            DftiComputeForward (c2r, inputOutputData);
+    }
+
+    void performCompactRealOnlyInverseTransform (float* inputOutputData) const noexcept override
+    {
+        DftiComputeBackward (c2r, inputOutputData);
+    }
+
     size_t order;
     DFTI_DESCRIPTOR_HANDLE c2c, c2r;
 };
@@ -832,6 +1409,36 @@ void FFT::performRealOnlyInverseTransform (float* inputOutputData) const noexcep
         engine->performRealOnlyInverseTransform (inputOutputData);
 }
 
+void FFT::performCompactRealOnlyForwardTransform (float* inputOutputData) const noexcept
+{
+    if (engine != nullptr)
+        engine->performCompactRealOnlyForwardTransform (inputOutputData);
+}
+
+void FFT::performCompactRealOnlyInverseTransform (float* inputOutputData) const noexcept
+{
+    if (engine != nullptr)
+        engine->performCompactRealOnlyInverseTransform (inputOutputData);
+}
+
+void FFT::performBatchedRealOnlyForwardTransform (float* inputOutputData, int numTransforms,
+                                                  int distanceBetweenTransforms) const noexcept
+{
+    jassert (numTransforms <= 1 || distanceBetweenTransforms >= size + 2);
+
+    if (engine != nullptr)
+        engine->performBatchedRealOnlyForwardTransform (inputOutputData, numTransforms, distanceBetweenTransforms);
+}
+
+void FFT::performBatchedRealOnlyInverseTransform (float* inputOutputData, int numTransforms,
+                                                  int distanceBetweenTransforms) const noexcept
+{
+    jassert (numTransforms <= 1 || distanceBetweenTransforms >= size + 2);
+
+    if (engine != nullptr)
+        engine->performBatchedRealOnlyInverseTransform (inputOutputData, numTransforms, distanceBetweenTransforms);
+}
+
 void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData) const noexcept
 {
     if (size == 1)
@@ -91,6 +91,43 @@ public:
     */
     void performRealOnlyInverseTransform (float* inputOutputData) const noexcept;
 
+    /** Performs an in-place forward transform on a block of real data, only storing
+        the non-negative frequencies.
+
+        Unlike performRealOnlyForwardTransform(), the array passed in only needs to hold
+        getSize() + 2 floats. The first getSize() should contain your raw input sample
+        data, and on return the array will contain the (size / 2) + 1 complex numbers
+        going from DC to the Nyquist frequency, as interleaved real + imaginary parts.
+
+        @see performCompactRealOnlyInverseTransform, performBatchedRealOnlyForwardTransform
+    */
+    void performCompactRealOnlyForwardTransform (float* inputOutputData) const noexcept;
+
+    /** Performs a reverse operation to data created in performCompactRealOnlyForwardTransform().
+
+        The array must hold getSize() + 2 floats, containing the (size / 2) + 1 complex
+        bins. On return, the first getSize() floats will contain the reconstituted samples.
+    */
+    void performCompactRealOnlyInverseTransform (float* inputOutputData) const noexcept;
+
+    /** Performs performCompactRealOnlyForwardTransform() on several frames at once.
+
+        The frames are stored one after the other in the array, the first sample of
+        each one being distanceBetweenTransforms floats after the first sample of the
+        previous one. This distance must be at least getSize() + 2.
+
+        This is cheaper than transforming each frame separately, as the engine only
+        needs to be set up once for the whole batch.
+    */
+    void performBatchedRealOnlyForwardTransform (float* inputOutputData, int numTransforms,
+                                                 int distanceBetweenTransforms) const noexcept;
+
+    /** Performs performCompactRealOnlyInverseTransform() on several frames at once,
+        stored in the same way as for performBatchedRealOnlyForwardTransform().
+    */
+    void performBatchedRealOnlyInverseTransform (float* inputOutputData, int numTransforms,
+                                                 int distanceBetweenTransforms) const noexcept;
+
     /** Takes an array and simply transforms it to the magnitude frequency response
         spectrum. This may be handy for things like frequency displays or analysis.
         The size of the array passed in must be 2 * getSize().
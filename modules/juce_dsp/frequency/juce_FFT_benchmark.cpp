@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class FFTBenchmarks  : public Benchmark
+{
+public:
+    FFTBenchmarks()  : Benchmark ("FFT", "DSP") {}
+
+    void runBenchmark() override
+    {
+        for (int order : { 8, 10, 12 })
+        {
+            FFT fft (order);
+            auto size = fft.getSize();
+            Random r (order);
+
+            HeapBlock<Complex<float>> input (size), output (size);
+            HeapBlock<float> realData (size * 2);
+
+            for (int i = 0; i < size; ++i)
+                input[i] = { r.nextFloat(), r.nextFloat() };
+
+            measure ("complex, size " + String (size), [&]
+            {
+                fft.perform (input, output, false);
+                doNotOptimiseAway (output[0]);
+            });
+
+            measure ("real-only forward, size " + String (size), [&]
+            {
+                for (int i = 0; i < size; ++i)
+                    realData[i] = input[i].real();
+
+                fft.performRealOnlyForwardTransform (realData, true);
+                doNotOptimiseAway (realData[0]);
+            });
+
+            measure ("frequency-only, size " + String (size), [&]
+            {
+                for (int i = 0; i < size; ++i)
+                    realData[i] = input[i].real();
+
+                fft.performFrequencyOnlyForwardTransform (realData);
+                doNotOptimiseAway (realData[0]);
+            });
+        }
+    }
+};
+
+static FFTBenchmarks fftBenchmarks;
+
+} // namespace dsp
+} // namespace juce
@@ -191,6 +191,124 @@ struct FFTUnitTest  : public UnitTest
         }
     };
 
+    struct CompactRealTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (size_t order = 0; order <= 8; ++order)
+            {
+                auto n = (1u << order);
+                auto numBins = (n >> 1) + 1;
+
+                FFT fft ((int) order);
+
+                HeapBlock<float> input (n);
+                HeapBlock<Complex<float>> reference (n);
+
+                fillRandom (random, input.getData(), n);
+                performReferenceFourier (input.getData(), reference.getData(), n, false);
+
+                // the array only needs room for the non-negative frequencies
+                HeapBlock<float> compact (n + 2);
+                memcpy (compact.getData(), input.getData(), n * sizeof (float));
+
+                fft.performCompactRealOnlyForwardTransform (compact.getData());
+                u.expect (checkArrayIsSimilar (reinterpret_cast<Complex<float>*> (compact.getData()), reference.getData(), numBins));
+
+                fft.performCompactRealOnlyInverseTransform (compact.getData());
+                u.expect (checkArrayIsSimilar (compact.getData(), input.getData(), n));
+
+                // a batch of different frames, with some padding between them that must be left alone
+                const int numFrames = 5;
+                const float padding = 1234.0f;
+                auto distance = n + 5;
+
+                HeapBlock<float> frames (distance * numFrames), originals (distance * numFrames);
+                std::fill (frames.getData(), frames.getData() + distance * numFrames, padding);
+
+                for (int frame = 0; frame < numFrames; ++frame)
+                    fillRandom (random, frames.getData() + frame * distance, n);
+
+                memcpy (originals.getData(), frames.getData(), distance * numFrames * sizeof (float));
+                fft.performBatchedRealOnlyForwardTransform (frames.getData(), numFrames, (int) distance);
+
+                for (int frame = 0; frame < numFrames; ++frame)
+                {
+                    auto* data = frames.getData() + frame * distance;
+
+                    performReferenceFourier (originals.getData() + frame * distance, reference.getData(), n, false);
+                    u.expect (checkArrayIsSimilar (reinterpret_cast<Complex<float>*> (data), reference.getData(), numBins));
+                    u.expect (data[n + 2] == padding && data[n + 4] == padding);
+                }
+
+                fft.performBatchedRealOnlyInverseTransform (frames.getData(), numFrames, (int) distance);
+
+                for (int frame = 0; frame < numFrames; ++frame)
+                    u.expect (checkArrayIsSimilar (frames.getData() + frame * distance,
+                                                   originals.getData() + frame * distance, n));
+            }
+        }
+    };
+
+   #if JUCE_USE_SIMD
+    struct SIMDEngineTest
+    {
+        template <typename Type>
+        static float getMaximumDifference (const Type* a, const Type* b, size_t n)
+        {
+            auto maximum = 0.0f;
+
+            for (size_t i = 0; i < n; ++i)
+                maximum = jmax (maximum, (float) std::abs (a[i] - b[i]));
+
+            return maximum;
+        }
+
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            // sizes for which the reference DFT would be too slow are checked against the fallback
+            for (int order = 4; order <= 14; ++order)
+            {
+                auto n = (size_t) 1 << order;
+                auto tolerance = 1.0e-5f * (float) n;
+
+                std::unique_ptr<SIMDFFT> simd (SIMDFFT::create (order));
+                FFTFallback fallback (order);
+
+                HeapBlock<Complex<float>> input (n), expected (n), output (n);
+                fillRandom (random, input.getData(), n);
+
+                for (auto inverse : { false, true })
+                {
+                    fallback.perform (input.getData(), expected.getData(), inverse);
+                    simd->perform (input.getData(), output.getData(), inverse);
+
+                    u.expectLessThan (getMaximumDifference (output.getData(), expected.getData(), n),
+                                      inverse ? tolerance / (float) n : tolerance);
+                }
+
+                HeapBlock<float> real (n * 2), realExpected (n * 2);
+                fillRandom (random, real.getData(), n);
+                std::copy (real.getData(), real.getData() + n, realExpected.getData());
+
+                fallback.performRealOnlyForwardTransform (realExpected.getData(), false);
+                simd->performRealOnlyForwardTransform (real.getData(), false);
+                u.expectLessThan (getMaximumDifference (real.getData(), realExpected.getData(), n * 2), tolerance);
+
+                std::copy (realExpected.getData(), realExpected.getData() + n * 2, real.getData());
+
+                fallback.performRealOnlyInverseTransform (realExpected.getData());
+                simd->performRealOnlyInverseTransform (real.getData());
+                u.expectLessThan (getMaximumDifference (real.getData(), realExpected.getData(), n), 1.0e-5f);
+            }
+        }
+    };
+   #endif
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -204,6 +322,11 @@ struct FFTUnitTest  : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<CompactRealTest> ("Compact and batched real input Test");
+
+       #if JUCE_USE_SIMD
+        runTestForAllTypes<SIMDEngineTest> ("SIMD engine Test");
+       #endif
     }
 };
 
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+STFT::STFT (int fftOrder, int hop, WindowingFunction<float>::WindowingMethod windowType)
+    : fft (fftOrder), fftSize (1 << fftOrder), hopSize (hop)
+{
+    // the reconstruction is only exact when the frames overlap a whole number of times
+    jassert (hopSize > 0 && hopSize <= fftSize && fftSize % hopSize == 0);
+
+    // a periodic window, i.e. a symmetric one of size + 1 without its last sample,
+    // which overlap-adds to a constant
+    HeapBlock<float> window ((size_t) fftSize + 1);
+    WindowingFunction<float>::fillWindowingTables (window.get(), (size_t) fftSize + 1, windowType, false);
+
+    analysisWindow.malloc ((size_t) fftSize);
+    synthesisWindow.malloc ((size_t) fftSize);
+    FloatVectorOperations::copy (analysisWindow.get(), window.get(), fftSize);
+
+    // dividing by the overlapped sum of the squared window makes the product of both
+    // windows add up to one at every sample
+    for (int i = 0; i < fftSize; ++i)
+    {
+        auto sum = 0.0f;
+
+        for (auto j = i % hopSize; j < fftSize; j += hopSize)
+            sum += analysisWindow[j] * analysisWindow[j];
+
+        synthesisWindow[i] = sum > 0.0f ? analysisWindow[i] / sum : 0.0f;
+    }
+}
+
+STFT::~STFT()
+{
+}
+
+void STFT::setSpectrumCallback (SpectrumCallback newCallback)
+{
+    callback = std::move (newCallback);
+}
+
+//==============================================================================
+void STFT::prepare (const ProcessSpec& spec)
+{
+    auto numChannels = static_cast<int> (spec.numChannels);
+
+    inputRing.setSize (numChannels, fftSize);
+    outputRing.setSize (numChannels, fftSize);
+
+    // the compact real transforms need room for the Nyquist bin
+    frameStride = fftSize + 2;
+    frames.malloc ((size_t) (frameStride * numChannels));
+
+    reset();
+}
+
+void STFT::reset() noexcept
+{
+    inputRing.clear();
+    outputRing.clear();
+
+    ringPosition = 0;
+    samplesUntilNextFrame = hopSize;
+}
+
+//==============================================================================
+void STFT::processSamples (const AudioBlock<float>& inputBlock, AudioBlock<float>& outputBlock, bool isBypassed) noexcept
+{
+    jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+    jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+    jassert (inputBlock.getNumChannels() <= (size_t) inputRing.getNumChannels());
+
+    auto numChannels = jmin ((int) inputBlock.getNumChannels(), (int) outputBlock.getNumChannels(), inputRing.getNumChannels());
+    auto numSamples  = (int) jmin (inputBlock.getNumSamples(), outputBlock.getNumSamples());
+
+    for (int position = 0; position < numSamples;)
+    {
+        auto numToDo = jmin (numSamples - position, samplesUntilNextFrame, fftSize - ringPosition);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* input  = inputBlock.getChannelPointer ((size_t) channel) + position;
+            auto* output = outputBlock.getChannelPointer ((size_t) channel) + position;
+            auto* delayed = outputRing.getWritePointer (channel, ringPosition);
+
+            // the input is saved first, as it may be the same buffer as the output
+            FloatVectorOperations::copy (inputRing.getWritePointer (channel, ringPosition), input, numToDo);
+            FloatVectorOperations::copy (output, delayed, numToDo);
+            FloatVectorOperations::clear (delayed, numToDo);
+        }
+
+        position += numToDo;
+        ringPosition = (ringPosition + numToDo) % fftSize;
+        samplesUntilNextFrame -= numToDo;
+
+        if (samplesUntilNextFrame == 0)
+        {
+            processFrame (isBypassed);
+            samplesUntilNextFrame = hopSize;
+        }
+    }
+
+    for (auto channel = (size_t) numChannels; channel < outputBlock.getNumChannels(); ++channel)
+        outputBlock.getSingleChannelBlock (channel).clear();
+}
+
+void STFT::processFrame (bool isBypassed) noexcept
+{
+    auto numChannels = inputRing.getNumChannels();
+
+    // the oldest sample of the frame is the one which the next input sample will replace
+    auto numBeforeWrap = fftSize - ringPosition;
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* frame = frames.get() + channel * frameStride;
+        auto* ring = inputRing.getReadPointer (channel);
+
+        FloatVectorOperations::multiply (frame, ring + ringPosition, analysisWindow.get(), numBeforeWrap);
+        FloatVectorOperations::multiply (frame + numBeforeWrap, ring, analysisWindow.get() + numBeforeWrap, ringPosition);
+    }
+
+    fft.performBatchedRealOnlyForwardTransform (frames.get(), numChannels, frameStride);
+
+    if (callback != nullptr && ! isBypassed)
+        for (int channel = 0; channel < numChannels; ++channel)
+            callback (reinterpret_cast<Complex<float>*> (frames.get() + channel * frameStride), getNumBins(), channel);
+
+    fft.performBatchedRealOnlyInverseTransform (frames.get(), numChannels, frameStride);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        auto* frame = frames.get() + channel * frameStride;
+        auto* ring = outputRing.getWritePointer (channel);
+
+        FloatVectorOperations::addWithMultiply (ring + ringPosition, frame, synthesisWindow.get(), numBeforeWrap);
+        FloatVectorOperations::addWithMultiply (ring, frame + numBeforeWrap, synthesisWindow.get() + numBeforeWrap, ringPosition);
+    }
+}
+
+} // namespace dsp
+} // namespace juce
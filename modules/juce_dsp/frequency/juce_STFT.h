@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Performs a streaming short-time Fourier transform analysis and resynthesis,
+    for writing effects which work on the spectrum of the signal.
+
+    The input is cut into overlapping frames of getFFTSize() samples, one every
+    getHopSize() samples. Each frame is windowed and transformed, the spectrum of
+    every channel is given to a callback which can modify it in place, and the
+    frames are transformed back and overlap-added to give the output.
+
+    The synthesis window is derived from the analysis window so that the overlap-add
+    reconstructs the input exactly when the callback leaves the spectra untouched,
+    for any hop size which divides the FFT size. The output is then the input delayed
+    by getLatencyInSamples().
+
+    The incoming samples are kept in a ring buffer, which is read directly when each
+    frame is windowed, and all the channels are transformed together by a single FFT
+    object, so nothing is allocated or copied around unnecessarily while processing.
+
+    @see FFT, WindowingFunction
+
+    @tags{DSP}
+*/
+class JUCE_API  STFT
+{
+public:
+    //==============================================================================
+    /** The type of function called with the spectrum of each frame.
+
+        It receives the getNumBins() complex bins of one channel, going from DC to
+        the Nyquist frequency, which it can change in place, and the index of that
+        channel. It is called on the audio thread, so mustn't block or allocate.
+    */
+    using SpectrumCallback = std::function<void (Complex<float>* bins, int numBins, int channel)>;
+
+    //==============================================================================
+    /** Creates an STFT processor.
+
+        @param fftOrder     the frames contain 2 ^ fftOrder samples
+        @param hopSize      the number of samples between the starts of two frames,
+                            which must divide the FFT size
+        @param windowType   the analysis window applied to each frame
+    */
+    STFT (int fftOrder, int hopSize,
+          WindowingFunction<float>::WindowingMethod windowType = WindowingFunction<float>::hann);
+
+    /** Destructor. */
+    ~STFT();
+
+    //==============================================================================
+    /** Sets the function called with the spectrum of each frame. This mustn't be
+        called while processing.
+    */
+    void setSpectrumCallback (SpectrumCallback newCallback);
+
+    /** Returns the number of samples in a frame. */
+    int getFFTSize() const noexcept                 { return fftSize; }
+
+    /** Returns the number of samples between the starts of two frames. */
+    int getHopSize() const noexcept                 { return hopSize; }
+
+    /** Returns the number of complex bins given to the callback. */
+    int getNumBins() const noexcept                 { return fftSize / 2 + 1; }
+
+    /** Returns the delay between the input and the output, in samples. */
+    int getLatencyInSamples() const noexcept        { return fftSize; }
+
+    //==============================================================================
+    /** Allocates the buffers needed for the given number of channels. */
+    void prepare (const ProcessSpec&);
+
+    /** Clears the frames being processed, ready to start a new stream of data. */
+    void reset() noexcept;
+
+    /** Processes the samples of the context.
+
+        When the context is bypassed the spectra aren't given to the callback, but
+        the frames are still processed, so the output is the delayed input and the
+        effect comes back without any gap.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same<typename ProcessContext::SampleType, float>::value,
+                       "STFT only supports single precision floating point data");
+
+        processSamples (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+    }
+
+private:
+    //==============================================================================
+    void processSamples (const AudioBlock<float>&, AudioBlock<float>&, bool isBypassed) noexcept;
+    void processFrame (bool isBypassed) noexcept;
+
+    //==============================================================================
+    FFT fft;
+    int fftSize, hopSize;
+    SpectrumCallback callback;
+
+    HeapBlock<float> analysisWindow, synthesisWindow;
+    AudioBuffer<float> inputRing, outputRing;
+    HeapBlock<float> frames;
+    int frameStride = 0, ringPosition = 0, samplesUntilNextFrame = 0;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (STFT)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct STFTTest  : public UnitTest
+{
+    STFTTest()  : UnitTest ("STFT", "DSP") {}
+
+    static void fillRandom (Random& random, AudioBuffer<float>& buffer)
+    {
+        for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (auto i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, 2.0f * random.nextFloat() - 1.0f);
+    }
+
+    /** Processes the whole buffer in place, in blocks of random sizes. */
+    static void render (STFT& stft, AudioBuffer<float>& buffer, int seed, bool isBypassed = false)
+    {
+        Random random (seed);
+        AudioBlock<float> block (buffer);
+
+        for (size_t position = 0; position < block.getNumSamples();)
+        {
+            auto numSamples = jmin ((size_t) (1 + random.nextInt (300)), block.getNumSamples() - position);
+            auto subBlock = block.getSubBlock (position, numSamples);
+
+            ProcessContextReplacing<float> context (subBlock);
+            context.isBypassed = isBypassed;
+            stft.process (context);
+            position += numSamples;
+        }
+    }
+
+    /** Checks that the output is the input delayed by the latency, scaled by gain. */
+    void expectDelayedInput (const AudioBuffer<float>& input, const AudioBuffer<float>& output,
+                             int latency, float gain)
+    {
+        auto maximumError = 0.0f;
+
+        for (auto channel = 0; channel < input.getNumChannels(); ++channel)
+        {
+            for (auto i = 0; i < output.getNumSamples(); ++i)
+            {
+                auto expected = i < latency ? 0.0f : gain * input.getSample (channel, i - latency);
+                maximumError = jmax (maximumError, std::abs (output.getSample (channel, i) - expected));
+            }
+        }
+
+        expectLessThan (maximumError, 1.0e-4f);
+    }
+
+    void checkReconstruction (int fftOrder, int hopSize, WindowingFunction<float>::WindowingMethod windowType)
+    {
+        Random random (fftOrder * 100 + hopSize);
+        AudioBuffer<float> input (2, 5000);
+        fillRandom (random, input);
+
+        STFT stft (fftOrder, hopSize, windowType);
+        stft.prepare ({ 44100.0, 512, 2 });
+
+        AudioBuffer<float> output (input);
+        render (stft, output, hopSize);
+        expectDelayedInput (input, output, stft.getLatencyInSamples(), 1.0f);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Perfect reconstruction");
+        {
+            checkReconstruction (9, 128, WindowingFunction<float>::hann);
+            checkReconstruction (10, 256, WindowingFunction<float>::hann);
+            checkReconstruction (8, 64, WindowingFunction<float>::blackmanHarris);
+            checkReconstruction (6, 64, WindowingFunction<float>::rectangular);
+        }
+
+        beginTest ("Spectrum callback");
+        {
+            Random random (12);
+            AudioBuffer<float> input (3, 4000);
+            fillRandom (random, input);
+
+            STFT stft (9, 128);
+            stft.prepare ({ 44100.0, 512, 3 });
+
+            int numCalls[3] = {};
+
+            stft.setSpectrumCallback ([&] (Complex<float>* bins, int numBins, int channel)
+            {
+                expectEquals (numBins, 257);
+                ++numCalls[channel];
+
+                // silences the first channel and halves the other ones
+                for (int i = 0; i < numBins; ++i)
+                    bins[i] *= channel == 0 ? 0.0f : 0.5f;
+            });
+
+            AudioBuffer<float> output (input);
+            render (stft, output, 3);
+
+            for (auto channel = 0; channel < 3; ++channel)
+                expectEquals (numCalls[channel], 4000 / 128);
+
+            expectEquals (output.getMagnitude (0, 0, output.getNumSamples()), 0.0f);
+
+            AudioBuffer<float> otherChannels (output.getArrayOfWritePointers() + 1, 2, output.getNumSamples());
+            AudioBuffer<float> otherInputs (input.getArrayOfWritePointers() + 1, 2, input.getNumSamples());
+            expectDelayedInput (otherInputs, otherChannels, stft.getLatencyInSamples(), 0.5f);
+
+            // when bypassed, the callback is skipped
+            stft.reset();
+            output.makeCopyOf (input);
+            render (stft, output, 4, true);
+            expectEquals (numCalls[0], 4000 / 128);
+            expectDelayedInput (input, output, stft.getLatencyInSamples(), 1.0f);
+        }
+    }
+};
+
+static STFTTest stftUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -36,6 +36,72 @@ static inline FloatType ncos (size_t order, size_t i, size_t size) noexcept
                       * MathConstants<FloatType>::pi / static_cast<FloatType> (size - 1));
 }
 
+//==============================================================================
+/** Keeps track of the window tables in use, so that objects created with the same
+    settings can share them. A table is released once the cache holds its only
+    reference.
+*/
+template <typename FloatType>
+struct WindowingFunction<FloatType>::TableCache
+{
+    static typename Table::Ptr getTable (size_t size, WindowingMethod type, bool normalise, FloatType beta)
+    {
+        // beta has no effect on the other methods
+        if (type != kaiser)
+            beta = 0;
+
+        auto& cache = getInstance();
+
+        {
+            const ScopedLock sl (cache.lock);
+
+            if (auto* table = cache.find (size, type, normalise, beta))
+                return table;
+        }
+
+        typename Table::Ptr newTable (new Table());
+        newTable->type = type;
+        newTable->normalise = normalise;
+        newTable->beta = beta;
+        newTable->samples.resize (static_cast<int> (size));
+        fillWindowingTables (newTable->samples.getRawDataPointer(), size, type, normalise, beta);
+
+        const ScopedLock sl (cache.lock);
+
+        // another thread may have created the same table in the meantime
+        if (auto* table = cache.find (size, type, normalise, beta))
+            return table;
+
+        for (int i = cache.tables.size(); --i >= 0;)
+            if (cache.tables.getObjectPointerUnchecked (i)->getReferenceCount() == 1)
+                cache.tables.remove (i);
+
+        cache.tables.add (newTable);
+        return newTable;
+    }
+
+private:
+    Table* find (size_t size, WindowingMethod type, bool normalise, FloatType beta) const noexcept
+    {
+        for (auto* table : tables)
+            if (static_cast<size_t> (table->samples.size()) == size && table->type == type
+                 && table->normalise == normalise && table->beta == beta)
+                return table;
+
+        return nullptr;
+    }
+
+    static TableCache& getInstance()
+    {
+        static TableCache cache;
+        return cache;
+    }
+
+    CriticalSection lock;
+    ReferenceCountedArray<Table> tables;
+};
+
+//==============================================================================
 template <typename FloatType>
 WindowingFunction<FloatType>::WindowingFunction (size_t size, WindowingMethod type, bool normalise, FloatType beta)
 {
@@ -46,8 +112,7 @@ template <typename FloatType>
 void WindowingFunction<FloatType>::fillWindowingTables (size_t size, WindowingMethod type,
                                                         bool normalise, FloatType beta) noexcept
 {
-    windowTable.resize (static_cast<int> (size));
-    fillWindowingTables (windowTable.getRawDataPointer(), size, type, normalise, beta);
+    windowTable = TableCache::getTable (size, type, normalise, beta);
 }
 
 template <typename FloatType>
@@ -167,7 +232,8 @@ void WindowingFunction<FloatType>::fillWindowingTables (FloatType* samples, size
 template <typename FloatType>
 void WindowingFunction<FloatType>::multiplyWithWindowingTable (FloatType* samples, size_t size) noexcept
 {
-    FloatVectorOperations::multiply (samples, windowTable.getRawDataPointer(), jmin (static_cast<int> (size), windowTable.size()));
+    auto& table = windowTable->samples;
+    FloatVectorOperations::multiply (samples, table.getRawDataPointer(), jmin (static_cast<int> (size), table.size()));
 }
 
 template <typename FloatType>
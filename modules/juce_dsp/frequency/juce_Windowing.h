@@ -103,7 +103,22 @@ public:
 
 private:
     //==============================================================================
-    Array<FloatType> windowTable;
+    /** The window samples, which are shared by all the WindowingFunction objects
+        created with the same settings.
+    */
+    struct Table  : public ReferenceCountedObject
+    {
+        using Ptr = ReferenceCountedObjectPtr<Table>;
+
+        Array<FloatType> samples;
+        WindowingMethod type;
+        bool normalise;
+        FloatType beta;
+    };
+
+    struct TableCache;
+
+    typename Table::Ptr windowTable;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WindowingFunction)
 };
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct WindowingFunctionTest  : public UnitTest
+{
+    WindowingFunctionTest()  : UnitTest ("WindowingFunction", "DSP") {}
+
+    /** Checks that the shared table of a window gives the same results as filling
+        a buffer directly.
+    */
+    void checkWindow (WindowingFunction<float>& window, size_t size,
+                      WindowingFunction<float>::WindowingMethod type, bool normalise, float beta)
+    {
+        HeapBlock<float> expected (size), actual (size);
+        WindowingFunction<float>::fillWindowingTables (expected.get(), size, type, normalise, beta);
+
+        for (size_t i = 0; i < size; ++i)
+            actual[i] = 1.0f;
+
+        window.multiplyWithWindowingTable (actual.get(), size);
+
+        for (size_t i = 0; i < size; ++i)
+            expectEquals (actual[i], expected[i]);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Shared tables");
+        {
+            OwnedArray<WindowingFunction<float>> windows;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                windows.add (new WindowingFunction<float> (512, WindowingFunction<float>::hann));
+                windows.add (new WindowingFunction<float> (512, WindowingFunction<float>::hann, false));
+                windows.add (new WindowingFunction<float> (256, WindowingFunction<float>::hann));
+                windows.add (new WindowingFunction<float> (512, WindowingFunction<float>::kaiser, true, 4.0f));
+                windows.add (new WindowingFunction<float> (512, WindowingFunction<float>::kaiser, true, 8.0f));
+            }
+
+            for (int i = 0; i < windows.size(); i += 5)
+            {
+                checkWindow (*windows[i],     512, WindowingFunction<float>::hann, true, 0.0f);
+                checkWindow (*windows[i + 1], 512, WindowingFunction<float>::hann, false, 0.0f);
+                checkWindow (*windows[i + 2], 256, WindowingFunction<float>::hann, true, 0.0f);
+                checkWindow (*windows[i + 3], 512, WindowingFunction<float>::kaiser, true, 4.0f);
+                checkWindow (*windows[i + 4], 512, WindowingFunction<float>::kaiser, true, 8.0f);
+            }
+        }
+
+        beginTest ("Refilling a window");
+        {
+            WindowingFunction<float> window (128, WindowingFunction<float>::blackman);
+            WindowingFunction<float> other (128, WindowingFunction<float>::blackman);
+
+            window.fillWindowingTables (64, WindowingFunction<float>::triangular);
+            checkWindow (window, 64, WindowingFunction<float>::triangular, true, 0.0f);
+            checkWindow (other, 128, WindowingFunction<float>::blackman, true, 0.0f);
+        }
+    }
+};
+
+static WindowingFunctionTest windowingFunctionUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -59,35 +59,44 @@
 #include "processors/juce_IIRFilter.cpp"
 #include "processors/juce_LadderFilter.cpp"
 #include "processors/juce_Oversampling.cpp"
+#include "processors/juce_AntiderivativeWaveShaper.cpp"
+#include "processors/juce_WavetableOscillator.cpp"
 #include "maths/juce_SpecialFunctions.cpp"
 #include "maths/juce_Matrix.cpp"
 #include "maths/juce_LookupTable.cpp"
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
 #include "frequency/juce_Windowing.cpp"
+#include "frequency/juce_STFT.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 
 #if JUCE_USE_SIMD
-#if defined(__i386__) || defined(__amd64__) || defined(_M_X64) || defined(_X86_) || defined(_M_IX86)
- #ifdef __AVX2__
-  #include "native/juce_avx_SIMDNativeOps.cpp"
- #else
-  #include "native/juce_sse_SIMDNativeOps.cpp"
- #endif
-#elif defined(__arm__) || defined(_M_ARM) || defined (__arm64__) || defined (__aarch64__)
-  #include "native/juce_neon_SIMDNativeOps.cpp"
-#else
-  #error "SIMD register support not implemented for this platform"
-#endif
+ #include "native/juce_SIMDNativeOps.cpp"
+ #include "containers/juce_SIMDRegister.cpp"
 #endif
 
 #if JUCE_UNIT_TESTS
+#include "maths/juce_FastMathApproximations_test.cpp"
 #include "maths/juce_Matrix_test.cpp"
 #include "maths/juce_LogRampedValue_test.cpp"
+#include "maths/juce_LookupTable_test.cpp"
 #if JUCE_USE_SIMD
 #include "containers/juce_SIMDRegister_test.cpp"
 #endif
+#include "frequency/juce_Convolution_test.cpp"
 #include "frequency/juce_FFT_test.cpp"
+#include "frequency/juce_Windowing_test.cpp"
+#include "frequency/juce_STFT_test.cpp"
+#include "filter_design/juce_FilterDesign_test.cpp"
+#include "processors/juce_AntiderivativeWaveShaper_test.cpp"
 #include "processors/juce_FIRFilter_test.cpp"
+#include "processors/juce_LadderFilter_test.cpp"
+#include "processors/juce_Oscillator_test.cpp"
+#include "processors/juce_Oversampling_test.cpp"
+#include "processors/juce_ProcessorDuplicator_test.cpp"
+#include "processors/juce_ProcessorChain_test.cpp"
+#include "processors/juce_StateVariableFilter_test.cpp"
+#include "frequency/juce_FFT_benchmark.cpp"
+#include "frequency/juce_Convolution_benchmark.cpp"
 #endif
 #endif
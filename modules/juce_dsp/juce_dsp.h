@@ -227,16 +227,26 @@ namespace juce
 
 //==============================================================================
 #if JUCE_USE_SIMD
- #include "native/juce_fallback_SIMDNativeOps.h"
-
- // include the correct native file for this build target CPU
+ // include the correct native file for this build target CPU. The SIMD classes live in an
+ // inline namespace named after the instruction set, so that the same code can be compiled
+ // for several instruction sets in one binary (see SIMDInstructionSet)
  #if defined(__i386__) || defined(__amd64__) || defined(_M_X64) || defined(_X86_) || defined(_M_IX86)
-  #ifdef __AVX2__
+  #if defined (__AVX512F__) && defined (__AVX512BW__)
+   #define JUCE_DSP_SIMD_NAMESPACE avx512
+   #include "native/juce_fallback_SIMDNativeOps.h"
+   #include "native/juce_avx512_SIMDNativeOps.h"
+  #elif defined (__AVX2__)
+   #define JUCE_DSP_SIMD_NAMESPACE avx2
+   #include "native/juce_fallback_SIMDNativeOps.h"
    #include "native/juce_avx_SIMDNativeOps.h"
   #else
+   #define JUCE_DSP_SIMD_NAMESPACE sse2
+   #include "native/juce_fallback_SIMDNativeOps.h"
    #include "native/juce_sse_SIMDNativeOps.h"
   #endif
  #elif defined(__arm__) || defined(_M_ARM) || defined (__arm64__) || defined (__aarch64__)
+  #define JUCE_DSP_SIMD_NAMESPACE neon
+  #include "native/juce_fallback_SIMDNativeOps.h"
   #include "native/juce_neon_SIMDNativeOps.h"
  #else
   #error "SIMD register support not implemented for this platform"
@@ -260,9 +270,11 @@ namespace juce
 #include "processors/juce_Bias.h"
 #include "processors/juce_Gain.h"
 #include "processors/juce_WaveShaper.h"
+#include "processors/juce_AntiderivativeWaveShaper.h"
 #include "processors/juce_IIRFilter.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_Oscillator.h"
+#include "processors/juce_WavetableOscillator.h"
 #include "processors/juce_LadderFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_Oversampling.h"
@@ -270,6 +282,7 @@ namespace juce
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
+#include "frequency/juce_STFT.h"
 #include "filter_design/juce_FilterDesign.h"
 
 #endif
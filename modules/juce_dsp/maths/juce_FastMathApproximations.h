@@ -60,10 +60,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void cosh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cosh (values[i]);
+        applyToBuffer<FloatType> (values, numValues, cosh, cosh);
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function cosh(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister at once.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> cosh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = ((x2 * 14615 + 1075032) * x2 + 18471600) * x2 + 39251520;
+        auto denominator = ((x2 * -127 + 16632) * x2 - 1154160) * x2 + 39251520;
+        return numerator / denominator;
+    }
+   #endif
+
     /** Provides a fast approximation of the function sinh(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
@@ -88,10 +104,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void sinh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sinh (values[i]);
+        applyToBuffer<FloatType> (values, numValues, sinh, sinh);
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function sinh(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister at once.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> sinh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (((x2 * (FloatType) 479249 + (FloatType) 52785432) * x2 + (FloatType) 1640635920) * x2 + (FloatType) 11511339840);
+        auto denominator = ((x2 * (FloatType) -18361 + (FloatType) 3177720) * x2 - (FloatType) 277920720) * x2 + (FloatType) 11511339840;
+        return numerator / denominator;
+    }
+   #endif
+
     /** Provides a fast approximation of the function tanh(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
@@ -116,9 +148,25 @@ struct FastMathApproximations
     template <typename FloatType>
     static void tanh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tanh (values[i]);
+        applyToBuffer<FloatType> (values, numValues, tanh, tanh);
+    }
+
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function tanh(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister at once.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -5 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> tanh (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (((x2 + 378) * x2 + 17325) * x2 + 135135);
+        auto denominator = ((x2 * 28 + 3150) * x2 + 62370) * x2 + 135135;
+        return numerator / denominator;
     }
+   #endif
 
     //==============================================================================
     /** Provides a fast approximation of the function cos(x) using a Pade approximant
@@ -145,10 +193,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void cos (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cos (values[i]);
+        applyToBuffer<FloatType> (values, numValues, cos, cos);
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function cos(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister at once.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi and +pi for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> cos (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = ((x2 * -14615 + 1075032) * x2 - 18471600) * x2 + 39251520;
+        auto denominator = ((x2 * 127 + 16632) * x2 + 1154160) * x2 + 39251520;
+        return numerator / denominator;
+    }
+   #endif
+
     /** Provides a fast approximation of the function sin(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
@@ -173,10 +237,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void sin (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sin (values[i]);
+        applyToBuffer<FloatType> (values, numValues, sin, sin);
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function sin(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister at once.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi and +pi for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> sin (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (((x2 * (FloatType) -479249 + (FloatType) 52785432) * x2 - (FloatType) 1640635920) * x2 + (FloatType) 11511339840);
+        auto denominator = ((x2 * (FloatType) 18361 + (FloatType) 3177720) * x2 + (FloatType) 277920720) * x2 + (FloatType) 11511339840;
+        return numerator / denominator;
+    }
+   #endif
+
     /** Provides a fast approximation of the function tan(x) using a Pade approximant
         continued fraction, calculated sample by sample.
 
@@ -201,10 +281,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void tan (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tan (values[i]);
+        applyToBuffer<FloatType> (values, numValues, tan, tan);
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function tan(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister at once.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -pi/2 and +pi/2 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> tan (SIMDRegister<FloatType> x) noexcept
+    {
+        auto x2 = x * x;
+        auto numerator = x * (((x2 - 378) * x2 + 17325) * x2 - 135135);
+        auto denominator = ((x2 * 28 - 3150) * x2 + 62370) * x2 - 135135;
+        return numerator / denominator;
+    }
+   #endif
+
     //==============================================================================
     /** Provides a fast approximation of the function exp(x) using a Pade approximant
         continued fraction, calculated sample by sample.
@@ -229,10 +325,25 @@ struct FastMathApproximations
     template <typename FloatType>
     static void exp (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::exp (values[i]);
+        applyToBuffer<FloatType> (values, numValues, exp, exp);
     }
 
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function exp(x) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister at once.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -6 and +4 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> exp (SIMDRegister<FloatType> x) noexcept
+    {
+        auto numerator = (((x + 20) * x + 180) * x + 840) * x + 1680;
+        auto denominator = (((x - 20) * x + 180) * x - 840) * x + 1680;
+        return numerator / denominator;
+    }
+   #endif
+
     /** Provides a fast approximation of the function log(x+1) using a Pade approximant
         continued fraction, calculated sample by sample.
 
@@ -256,8 +367,60 @@ struct FastMathApproximations
     template <typename FloatType>
     static void logNPlusOne (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::logNPlusOne (values[i]);
+        applyToBuffer<FloatType> (values, numValues, logNPlusOne, logNPlusOne);
+    }
+
+   #if JUCE_USE_SIMD
+    /** Provides a fast approximation of the function log(x+1) using a Pade approximant
+        continued fraction, calculated on all the elements of a SIMDRegister at once.
+
+        Note: This is an approximation which works on a limited range. You are
+        advised to use input values only between -0.8 and +5 for limiting the error.
+    */
+    template <typename FloatType>
+    static SIMDRegister<FloatType> logNPlusOne (SIMDRegister<FloatType> x) noexcept
+    {
+        auto numerator = x * ((((x * 137 + 2310) * x + 9870) * x + 15120) * x + 7560);
+        auto denominator = ((((x * 30 + 900) * x + 6300) * x + 16800) * x + 18900) * x + 7560;
+        return numerator / denominator;
+    }
+   #endif
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    template <typename FloatType>
+    using VectorFunction = SIMDRegister<FloatType> (*) (SIMDRegister<FloatType>);
+   #else
+    template <typename FloatType>
+    using VectorFunction = FloatType (*) (FloatType);
+   #endif
+
+    /** Applies a function in place to a buffer, using the SIMDRegister version on
+        the aligned part of the buffer when SIMD is available.
+    */
+    template <typename FloatType>
+    static void applyToBuffer (FloatType* values, size_t numValues,
+                               FloatType (*scalarFunction) (FloatType),
+                               VectorFunction<FloatType> vectorFunction) noexcept
+    {
+        auto* end = values + numValues;
+
+       #if JUCE_USE_SIMD
+        using Vec = SIMDRegister<FloatType>;
+        auto* alignedStart = jmin (Vec::getNextSIMDAlignedPtr (values), end);
+
+        for (; values < alignedStart; ++values)
+            *values = scalarFunction (*values);
+
+        for (; values + Vec::SIMDNumElements <= end; values += Vec::SIMDNumElements)
+            vectorFunction (Vec::fromRawArray (values)).copyToRawArray (values);
+       #else
+        ignoreUnused (vectorFunction);
+       #endif
+
+        for (; values < end; ++values)
+            *values = scalarFunction (*values);
     }
 };
 
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct FastMathApproximationsTest  : public UnitTest
+{
+    FastMathApproximationsTest()  : UnitTest ("FastMathApproximations", "DSP") {}
+
+    template <typename FloatType>
+    static void fillRandom (Random& random, FloatType* values, size_t numValues, FloatType minimum, FloatType maximum)
+    {
+        for (size_t i = 0; i < numValues; ++i)
+            values[i] = minimum + (maximum - minimum) * (FloatType) random.nextDouble();
+    }
+
+    template <typename FloatType, typename ReferenceFunction>
+    void checkFunction (FloatType (*approximation) (FloatType), void (*bufferApproximation) (FloatType*, size_t),
+                        ReferenceFunction reference, FloatType minimum, FloatType maximum)
+    {
+        auto random = getRandom();
+
+        // the error grows quickly towards the ends of the advised range, so only
+        // the middle half of it gets compared with the reference function
+        for (int i = 0; i <= 1000; ++i)
+        {
+            auto x = (minimum + (maximum - minimum) * (FloatType) i / (FloatType) 1000) / 2;
+            auto expected = reference (x);
+
+            expectWithinAbsoluteError (approximation (x), expected, (FloatType) 1.0e-4 * jmax ((FloatType) 1, std::abs (expected)));
+        }
+
+        // the buffer version gives the same results as the scalar one, whatever the alignment and size
+        HeapBlock<FloatType> values (128), expected (128);
+
+        for (size_t offset = 0; offset < 8; ++offset)
+        {
+            for (size_t numValues : { (size_t) 0, (size_t) 1, (size_t) 7, (size_t) 64, (size_t) 119 })
+            {
+                fillRandom (random, values.get() + offset, numValues, minimum, maximum);
+
+                for (size_t i = 0; i < numValues; ++i)
+                    expected[i] = approximation (values[offset + i]);
+
+                bufferApproximation (values + offset, numValues);
+
+                for (size_t i = 0; i < numValues; ++i)
+                    expectWithinAbsoluteError (values[offset + i], expected[i], getPrecision<FloatType>() * jmax ((FloatType) 1, std::abs (expected[i])));
+            }
+        }
+    }
+
+   #if JUCE_USE_SIMD
+    template <typename FloatType>
+    void checkSIMDFunction (FloatType (*approximation) (FloatType),
+                            SIMDRegister<FloatType> (*vectorApproximation) (SIMDRegister<FloatType>),
+                            FloatType minimum, FloatType maximum)
+    {
+        using Vec = SIMDRegister<FloatType>;
+        auto random = getRandom();
+
+        for (int n = 0; n < 100; ++n)
+        {
+            auto values = Vec::expand (0);
+
+            for (size_t lane = 0; lane < Vec::SIMDNumElements; ++lane)
+                values.set (lane, minimum + (maximum - minimum) * (FloatType) random.nextDouble());
+
+            auto results = vectorApproximation (values);
+
+            for (size_t lane = 0; lane < Vec::SIMDNumElements; ++lane)
+            {
+                auto expected = approximation (values.get (lane));
+                expectWithinAbsoluteError (results.get (lane), expected, getPrecision<FloatType>() * jmax ((FloatType) 1, std::abs (expected)));
+            }
+        }
+    }
+   #endif
+
+    /** The vectorised versions may round a little differently from the scalar ones. */
+    template <typename FloatType>
+    static FloatType getPrecision() noexcept    { return (FloatType) 8 * std::numeric_limits<FloatType>::epsilon(); }
+
+    template <typename FloatType>
+    void checkAllFunctions()
+    {
+        using FMA = FastMathApproximations;
+        const auto pi = MathConstants<FloatType>::pi;
+
+        checkFunction<FloatType> (FMA::cosh, FMA::cosh, [] (FloatType x) { return std::cosh (x); }, -5, 5);
+        checkFunction<FloatType> (FMA::sinh, FMA::sinh, [] (FloatType x) { return std::sinh (x); }, -5, 5);
+        checkFunction<FloatType> (FMA::tanh, FMA::tanh, [] (FloatType x) { return std::tanh (x); }, -5, 5);
+        checkFunction<FloatType> (FMA::cos, FMA::cos, [] (FloatType x) { return std::cos (x); }, -pi, pi);
+        checkFunction<FloatType> (FMA::sin, FMA::sin, [] (FloatType x) { return std::sin (x); }, -pi, pi);
+        checkFunction<FloatType> (FMA::tan, FMA::tan, [] (FloatType x) { return std::tan (x); }, -pi / 2, pi / 2);
+        checkFunction<FloatType> (FMA::exp, FMA::exp, [] (FloatType x) { return std::exp (x); }, -6, 4);
+        checkFunction<FloatType> (FMA::logNPlusOne, FMA::logNPlusOne, [] (FloatType x) { return std::log1p (x); }, (FloatType) -0.8, 5);
+    }
+
+   #if JUCE_USE_SIMD
+    template <typename FloatType>
+    void checkAllSIMDFunctions()
+    {
+        using FMA = FastMathApproximations;
+        const auto pi = MathConstants<FloatType>::pi;
+
+        checkSIMDFunction<FloatType> (FMA::cosh, FMA::cosh, -5, 5);
+        checkSIMDFunction<FloatType> (FMA::sinh, FMA::sinh, -5, 5);
+        checkSIMDFunction<FloatType> (FMA::tanh, FMA::tanh, -5, 5);
+        checkSIMDFunction<FloatType> (FMA::cos, FMA::cos, -pi, pi);
+        checkSIMDFunction<FloatType> (FMA::sin, FMA::sin, -pi, pi);
+        checkSIMDFunction<FloatType> (FMA::tan, FMA::tan, -pi / 2, pi / 2);
+        checkSIMDFunction<FloatType> (FMA::exp, FMA::exp, -6, 4);
+        checkSIMDFunction<FloatType> (FMA::logNPlusOne, FMA::logNPlusOne, (FloatType) -0.8, 5);
+    }
+   #endif
+
+    void runTest() override
+    {
+        beginTest ("Scalar and buffer functions");
+        {
+            checkAllFunctions<float>();
+            checkAllFunctions<double>();
+        }
+
+       #if JUCE_USE_SIMD
+        beginTest ("SIMDRegister functions");
+        {
+            checkAllSIMDFunctions<float>();
+            checkAllSIMDFunctions<double>();
+        }
+       #endif
+    }
+};
+
+static FastMathApproximationsTest fastMathApproximationsUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -64,6 +64,43 @@ void LookupTable<FloatType>::initialise (const std::function<FloatType (size_t)>
     prepare();
 }
 
+template <typename FloatType>
+void LookupTable<FloatType>::getUnchecked (const FloatType* indices, FloatType* results, size_t numValues) const noexcept
+{
+    jassert (isInitialised());  // Use the non-default constructor or call initialise() before first use
+
+    constexpr size_t chunkSize = 64;
+    auto* table = data.begin();
+
+    int positions[chunkSize];
+    FloatType fractions[chunkSize], x0[chunkSize], x1[chunkSize];
+
+    for (size_t start = 0; start < numValues; start += chunkSize)
+    {
+        auto num = jmin (chunkSize, numValues - start);
+        auto* in = indices + start;
+        auto* out = results + start;
+
+        for (size_t i = 0; i < num; ++i)
+        {
+            jassert (isPositiveAndBelow (in[i], FloatType (getNumPoints())));
+
+            auto position = static_cast<int> (in[i]);
+            positions[i] = position;
+            fractions[i] = in[i] - FloatType (position);
+        }
+
+        for (size_t i = 0; i < num; ++i)
+        {
+            x0[i] = table[positions[i]];
+            x1[i] = table[positions[i] + 1];
+        }
+
+        for (size_t i = 0; i < num; ++i)
+            out[i] = x0[i] + fractions[i] * (x1[i] - x0[i]);
+    }
+}
+
 template <typename FloatType>
 void LookupTable<FloatType>::prepare() noexcept
 {
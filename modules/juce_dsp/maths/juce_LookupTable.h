@@ -108,6 +108,51 @@ public:
         return jmap (f, x0, x1);
     }
 
+    /** Calculates the approximated values for an array of indices without range checking.
+
+        This gives the same results as calling getUnchecked() for each index, but it
+        works on chunks of values, computing all their integer positions and fractions
+        first and interpolating them afterwards, which lets the compiler vectorise
+        everything but the table reads. The indices and the results can be the same
+        array.
+
+        @see getUnchecked
+    */
+    void getUnchecked (const FloatType* indices, FloatType* results, size_t numValues) const noexcept;
+
+   #if JUCE_USE_SIMD || DOXYGEN
+    /** Calculates the approximated values for a SIMDRegister of indices, without range
+        checking. Only the table reads are done one lane at a time.
+
+        @see getUnchecked
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE getUnchecked (SIMDRegister<FloatType> index) const noexcept
+    {
+        using Vec = SIMDRegister<FloatType>;
+
+        jassert (isInitialised());  // Use the non-default constructor or call initialise() before first use
+
+        alignas (Vec::SIMDRegisterSize) FloatType values[Vec::SIMDNumElements],
+                                                  truncated[Vec::SIMDNumElements],
+                                                  x0[Vec::SIMDNumElements],
+                                                  x1[Vec::SIMDNumElements];
+        index.copyToRawArray (values);
+
+        for (size_t lane = 0; lane < Vec::SIMDNumElements; ++lane)
+        {
+            jassert (isPositiveAndBelow (values[lane], FloatType (getNumPoints())));
+
+            auto i = static_cast<int> (values[lane]);
+            truncated[lane] = FloatType (i);
+            x0[lane] = data.getUnchecked (i);
+            x1[lane] = data.getUnchecked (i + 1);
+        }
+
+        auto a = Vec::fromRawArray (x0);
+        return a + (index - Vec::fromRawArray (truncated)) * (Vec::fromRawArray (x1) - a);
+    }
+   #endif
+
     //==============================================================================
     /** Calculates the approximated value for the given index with range checking.
 
@@ -266,24 +311,72 @@ public:
     /** @see processSample */
     FloatType operator() (FloatType index) const noexcept       { return processSample (index); }
 
+   #if JUCE_USE_SIMD || DOXYGEN
+    /** Calculates the approximated values for a SIMDRegister of input values without
+        range checking.
+
+        @see processSampleUnchecked
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE processSampleUnchecked (SIMDRegister<FloatType> value) const noexcept
+    {
+        return lookupTable.getUnchecked (value * scaler + offset);
+    }
+
+    /** Calculates the approximated values for a SIMDRegister of input values with range
+        checking. Out-of-range input values will be clipped to the specified input range.
+
+        This allows a LookupTableTransform to be used with AudioBlocks of SIMDRegisters,
+        in a WaveShaper for example.
+
+        @see processSample
+    */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE processSample (SIMDRegister<FloatType> value) const noexcept
+    {
+        using Vec = SIMDRegister<FloatType>;
+        auto clipped = Vec::min (Vec::max (value, Vec::expand (minInputValue)), Vec::expand (maxInputValue));
+
+        return lookupTable.getUnchecked (clipped * scaler + offset);
+    }
+
+    /** @see processSampleUnchecked */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE operator[] (SIMDRegister<FloatType> value) const noexcept  { return processSampleUnchecked (value); }
+
+    /** @see processSample */
+    SIMDRegister<FloatType> JUCE_VECTOR_CALLTYPE operator() (SIMDRegister<FloatType> value) const noexcept  { return processSample (value); }
+   #endif
+
     //==============================================================================
-    /** Processes an array of input values without range checking
+    /** Processes an array of input values without range checking.
+
+        The indices are computed with FloatVectorOperations, and the interpolation is
+        done by LookupTable::getUnchecked() for the whole array at once.
+
         @see process
     */
     void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
     {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSampleUnchecked (input[i]);
+        auto num = static_cast<int> (numSamples);
+
+        // the output holds the table indices until they get replaced by the results
+        FloatVectorOperations::multiply (output, input, scaler, num);
+        FloatVectorOperations::add (output, offset, num);
+
+        lookupTable.getUnchecked (output, output, numSamples);
     }
 
     //==============================================================================
-    /** Processes an array of input values with range checking
+    /** Processes an array of input values with range checking.
         @see processUnchecked
     */
     void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
     {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSample (input[i]);
+        auto num = static_cast<int> (numSamples);
+
+        FloatVectorOperations::clip (output, input, minInputValue, maxInputValue, num);
+        FloatVectorOperations::multiply (output, scaler, num);
+        FloatVectorOperations::add (output, offset, num);
+
+        lookupTable.getUnchecked (output, output, numSamples);
     }
 
     //==============================================================================
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct LookupTableTest  : public UnitTest
+{
+    LookupTableTest()  : UnitTest ("LookupTable", "DSP") {}
+
+    template <typename FloatType>
+    void checkBlockProcessing()
+    {
+        auto random = getRandom();
+
+        LookupTableTransform<FloatType> transform ([] (FloatType x) { return std::tanh (x); },
+                                                   (FloatType) -5, (FloatType) 5, 64);
+
+        const size_t numSamples = 1000;
+        HeapBlock<FloatType> input (numSamples), output (numSamples);
+
+        // values outside the range must be clipped by process()
+        for (size_t i = 0; i < numSamples; ++i)
+            input[i] = (FloatType) (12.0f * random.nextFloat() - 6.0f);
+
+        transform.process (input, output, numSamples);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            expectEquals (output[i], transform.processSample (input[i]));
+
+        for (size_t i = 0; i < numSamples; ++i)
+            input[i] = jlimit ((FloatType) -5, (FloatType) 5, input[i]);
+
+        // the results can overwrite the input
+        HeapBlock<FloatType> inPlace (numSamples);
+        FloatVectorOperations::copy (inPlace.get(), input.get(), (int) numSamples);
+        transform.processUnchecked (inPlace, inPlace, numSamples);
+
+        for (size_t i = 0; i < numSamples; ++i)
+            expectEquals (inPlace[i], transform.processSampleUnchecked (input[i]));
+    }
+
+   #if JUCE_USE_SIMD
+    template <typename FloatType>
+    void checkSIMDProcessing()
+    {
+        using Vec = SIMDRegister<FloatType>;
+        auto random = getRandom();
+
+        LookupTableTransform<FloatType> transform ([] (FloatType x) { return std::sin (x); },
+                                                   (FloatType) -4, (FloatType) 4, 128);
+
+        for (int n = 0; n < 100; ++n)
+        {
+            auto values = Vec::expand (0);
+
+            for (size_t lane = 0; lane < Vec::SIMDNumElements; ++lane)
+                values.set (lane, (FloatType) (10.0f * random.nextFloat() - 5.0f));
+
+            auto results = transform (values);
+
+            for (size_t lane = 0; lane < Vec::SIMDNumElements; ++lane)
+                expectEquals (results.get (lane), transform (values.get (lane)));
+        }
+    }
+   #endif
+
+    void runTest() override
+    {
+        beginTest ("Block processing");
+        {
+            checkBlockProcessing<float>();
+            checkBlockProcessing<double>();
+        }
+
+       #if JUCE_USE_SIMD
+        beginTest ("SIMDRegister processing");
+        {
+            checkSIMDProcessing<float>();
+            checkSIMDProcessing<double>();
+        }
+       #endif
+    }
+};
+
+static LookupTableTest lookupTableUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -113,35 +113,80 @@ Matrix<ElementType>& Matrix<ElementType>::swapRows (size_t rowOne, size_t rowTwo
 template <typename ElementType>
 Matrix<ElementType> Matrix<ElementType>::operator* (const Matrix<ElementType>& other) const
 {
-    auto n = getNumRows(), m = other.getNumColumns(), p = getNumColumns();
-    Matrix result (n, m);
+    Matrix result (getNumRows(), other.getNumColumns());
+    multiply (*this, other, result);
+    return result;
+}
 
-    jassert (p == other.getNumRows());
+template <typename ElementType>
+void Matrix<ElementType>::multiply (const Matrix& a, const Matrix& b, Matrix& result) noexcept
+{
+    auto n = a.getNumRows(), m = b.getNumColumns(), p = a.getNumColumns();
 
-    size_t offsetMat = 0, offsetlhs = 0;
+    jassert (p == b.getNumRows());
+    jassert (result.getNumRows() == n && result.getNumColumns() == m);
+    jassert (&result != &a && &result != &b);
 
     auto* dst = result.getRawDataPointer();
-    auto* a = getRawDataPointer();
-    auto* b = other.getRawDataPointer();
+    auto* lhs = a.getRawDataPointer();
+    auto* rhs = b.getRawDataPointer();
 
-    for (size_t i = 0; i < n; ++i)
+    if (m == 1)
     {
-        size_t offsetrhs = 0;
-
-        for (size_t k = 0; k < p; ++k)
+        // matrix-vector product: each result is the dot product of a row with the vector
+        for (size_t i = 0; i < n; ++i)
         {
-            auto ak = a[offsetlhs++];
+            auto* row = lhs + i * p;
+            ElementType sums[4] = {};
+            size_t k = 0;
+
+            for (; k + 4 <= p; k += 4)
+            {
+                sums[0] += row[k]     * rhs[k];
+                sums[1] += row[k + 1] * rhs[k + 1];
+                sums[2] += row[k + 2] * rhs[k + 2];
+                sums[3] += row[k + 3] * rhs[k + 3];
+            }
 
-            for (size_t j = 0; j < m; ++j)
-                dst[offsetMat + j] += ak * b[offsetrhs + j];
+            for (; k < p; ++k)
+                sums[0] += row[k] * rhs[k];
 
-            offsetrhs += m;
+            dst[i] = (sums[0] + sums[1]) + (sums[2] + sums[3]);
         }
 
-        offsetMat += m;
+        return;
     }
 
-    return result;
+    result.clear();
+
+    // Each row of the result is accumulated from scaled rows of b. The rows and columns
+    // of b are visited in tiles, so that the part which is being read stays in the cache
+    // while it's used for all the rows of a.
+    const size_t tileRows = 32, tileColumns = 256;
+
+    for (size_t firstColumn = 0; firstColumn < m; firstColumn += tileColumns)
+    {
+        auto numColumns = jmin (tileColumns, m - firstColumn);
+
+        for (size_t firstRow = 0; firstRow < p; firstRow += tileRows)
+        {
+            auto lastRow = jmin (firstRow + tileRows, p);
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                auto* dstRow = dst + i * m + firstColumn;
+
+                for (size_t k = firstRow; k < lastRow; ++k)
+                {
+                    auto* rhsRow = rhs + k * m + firstColumn;
+                    auto aik = lhs[i * p + k];
+
+                    for (size_t j = 0; j < numColumns; ++j)
+                        dstRow[j] += aik * rhsRow[j];
+                }
+            }
+        }
+    }
 }
 
 //==============================================================================
@@ -229,45 +274,53 @@ bool Matrix<ElementType>::solve (Matrix& b) const noexcept
         default:
         {
             Matrix<ElementType> M (A);
+            auto* m = M.getRawDataPointer();
 
+            // Only the columns from j onwards are updated, as the ones on the left of
+            // the diagonal are never read again once they have been eliminated.
             for (size_t j = 0; j < n; ++j)
             {
-                if (M (j, j) == 0)
+                auto* rowJ = m + j * n;
+                auto numColumns = (int) (n - j);
+
+                if (rowJ[j] == 0)
                 {
                     auto i = j;
-                    while (i < n && M (i, j) == 0)
+                    while (i < n && m[i * n + j] == 0)
                         ++i;
 
                     if (i == n)
                         return false;
 
-                    for (size_t k = 0; k < n; ++k)
-                        M (j, k) += M (i, k);
+                    FloatVectorOperations::add (rowJ + j, m + i * n + j, numColumns);
 
                     x[j] += x[i];
                 }
 
-                auto t = 1 / M (j, j);
+                auto t = 1 / rowJ[j];
 
-                for (size_t k = 0; k < n; ++k)
-                    M (j, k) *= t;
+                FloatVectorOperations::multiply (rowJ + j, t, numColumns);
 
                 x[j] *= t;
 
                 for (size_t k = j + 1; k < n; ++k)
                 {
-                    auto u = -M (k, j);
+                    auto* rowK = m + k * n;
+                    auto u = -rowK[j];
 
-                    for (size_t l = 0; l < n; ++l)
-                        M (k, l) += u * M (j, l);
+                    FloatVectorOperations::addWithMultiply (rowK + j, rowJ + j, u, numColumns);
 
                     x[k] += u * x[j];
                 }
             }
 
             for (int k = static_cast<int> (n) - 2; k >= 0; --k)
+            {
+                auto* rowK = m + static_cast<size_t> (k) * n;
+
                 for (size_t i = static_cast<size_t> (k) + 1; i < n; ++i)
-                    x[k] -= M (static_cast<size_t> (k), i) * x[i];
+                    x[k] -= rowK[i] * x[i];
+            }
         }
     }
 
@@ -137,15 +137,25 @@ public:
 
     //==============================================================================
     /** Addition of two matrices */
-    inline Matrix& operator+= (const Matrix& other) noexcept            { return apply (other, [] (ElementType a, ElementType b) { return a + b; } ); }
+    inline Matrix& operator+= (const Matrix& other) noexcept
+    {
+        jassert (rows == other.rows && columns == other.columns);
+        FloatVectorOperations::add (begin(), other.begin(), data.size());
+        return *this;
+    }
 
     /** Subtraction of two matrices */
-    inline Matrix& operator-= (const Matrix& other) noexcept            { return apply (other, [] (ElementType a, ElementType b) { return a - b; } ); }
+    inline Matrix& operator-= (const Matrix& other) noexcept
+    {
+        jassert (rows == other.rows && columns == other.columns);
+        FloatVectorOperations::subtract (begin(), other.begin(), data.size());
+        return *this;
+    }
 
     /** Scalar multiplication */
     inline Matrix& operator*= (ElementType scalar) noexcept
     {
-        std::for_each (begin(), end(), [scalar] (ElementType& x) { x *= scalar; });
+        FloatVectorOperations::multiply (begin(), scalar, data.size());
         return *this;
     }
 
@@ -161,8 +171,21 @@ public:
     /** Matrix multiplication */
     Matrix operator* (const Matrix& other) const;
 
+    /** Multiplies a by b and stores the result into an existing matrix, without
+        allocating any memory.
+
+        The result matrix must already have a.getNumRows() rows and b.getNumColumns()
+        columns, and must not be the same object as a or b.
+    */
+    static void multiply (const Matrix& a, const Matrix& b, Matrix& result) noexcept;
+
     /** Does a hadarmard product with the receiver and other and stores the result in the receiver */
-    inline Matrix& hadarmard (const Matrix& other) noexcept             { return apply (other, [] (ElementType a, ElementType b) { return a * b; } ); }
+    inline Matrix& hadarmard (const Matrix& other) noexcept
+    {
+        jassert (rows == other.rows && columns == other.columns);
+        FloatVectorOperations::multiply (begin(), other.begin(), data.size());
+        return *this;
+    }
 
     /** Does a hadarmard product with a and b returns the result. */
     static inline Matrix hadarmard (const Matrix& a, const Matrix& b)   { Matrix result (a); result.hadarmard (b); return result; }
@@ -225,30 +248,193 @@ private:
             dataAcceleration.setUnchecked (static_cast<int> (i), i * columns);
     }
 
-    template <typename BinaryOperation>
-    Matrix& apply (const Matrix& other, BinaryOperation binaryOp)
+    //==============================================================================
+    Array<ElementType> data;
+    Array<size_t> dataAcceleration;
+
+    size_t rows, columns;
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR (Matrix)
+};
+
+//==============================================================================
+/**
+    A matrix whose size is known at compile time, for the small matrices (such as
+    4x4 or 16x16 ones) which get used in the inner loops of ambisonic decoders or
+    feedback delay networks.
+
+    The elements are stored in row-major order inside the object itself, so creating
+    one doesn't allocate any memory, and the compiler can unroll and vectorise all
+    the loops over its elements.
+
+    @see Matrix
+
+    @tags{DSP}
+*/
+template <typename ElementType, size_t numRows, size_t numColumns>
+class FixedSizeMatrix
+{
+public:
+    //==============================================================================
+    /** Creates a matrix filled with zeroes. */
+    FixedSizeMatrix() noexcept                                       { clear(); }
+
+    /** Creates a matrix with initial data coming from an array, stored in row-major order. */
+    explicit FixedSizeMatrix (const ElementType* dataPointer) noexcept
     {
-        jassert (rows == other.rows && columns == other.columns);
+        std::copy (dataPointer, dataPointer + numRows * numColumns, data.begin());
+    }
 
-        auto* dst = getRawDataPointer();
+    /** Creates a copy of a Matrix, which must have the same size as this one. */
+    explicit FixedSizeMatrix (const Matrix<ElementType>& other) noexcept
+    {
+        jassert (other.getNumRows() == numRows && other.getNumColumns() == numColumns);
+        std::copy (other.begin(), other.end(), data.begin());
+    }
+
+    /** Creates the identity matrix. */
+    static FixedSizeMatrix identity() noexcept
+    {
+        static_assert (numRows == numColumns, "The identity matrix must be a square matrix");
+
+        FixedSizeMatrix result;
+
+        for (size_t i = 0; i < numRows; ++i)
+            result (i, i) = 1;
+
+        return result;
+    }
+
+    /** Returns a Matrix with the same contents as this one. */
+    Matrix<ElementType> toMatrix() const                             { return { numRows, numColumns, data.data() }; }
+
+    //==============================================================================
+    /** Returns the number of rows in the matrix. */
+    static constexpr size_t getNumRows() noexcept                    { return numRows; }
+
+    /** Returns the number of columns in the matrix. */
+    static constexpr size_t getNumColumns() noexcept                 { return numColumns; }
+
+    /** Fills the contents of the matrix with zeroes. */
+    void clear() noexcept                                            { data.fill (0); }
+
+    //==============================================================================
+    /** Returns the value of the matrix at a given row and column (for reading). */
+    inline ElementType operator() (size_t row, size_t column) const noexcept
+    {
+        jassert (row < numRows && column < numColumns);
+        return data[row * numColumns + column];
+    }
 
-        for (auto src : other)
+    /** Returns the value of the matrix at a given row and column (for modifying). */
+    inline ElementType& operator() (size_t row, size_t column) noexcept
+    {
+        jassert (row < numRows && column < numColumns);
+        return data[row * numColumns + column];
+    }
+
+    /** Returns a pointer to the raw data of the matrix, in row-major order (for modifying). */
+    inline ElementType* getRawDataPointer() noexcept                 { return data.data(); }
+
+    /** Returns a pointer to the raw data of the matrix, in row-major order (for reading). */
+    inline const ElementType* getRawDataPointer() const noexcept     { return data.data(); }
+
+    //==============================================================================
+    /** Addition of two matrices */
+    FixedSizeMatrix& operator+= (const FixedSizeMatrix& other) noexcept
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] += other.data[i];
+
+        return *this;
+    }
+
+    /** Subtraction of two matrices */
+    FixedSizeMatrix& operator-= (const FixedSizeMatrix& other) noexcept
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] -= other.data[i];
+
+        return *this;
+    }
+
+    /** Scalar multiplication */
+    FixedSizeMatrix& operator*= (ElementType scalar) noexcept
+    {
+        for (auto& x : data)
+            x *= scalar;
+
+        return *this;
+    }
+
+    /** Does a hadarmard product with the receiver and other and stores the result in the receiver */
+    FixedSizeMatrix& hadarmard (const FixedSizeMatrix& other) noexcept
+    {
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] *= other.data[i];
+
+        return *this;
+    }
+
+    /** Addition of two matrices */
+    FixedSizeMatrix operator+ (const FixedSizeMatrix& other) const noexcept     { auto result (*this); result += other;  return result; }
+
+    /** Subtraction of two matrices */
+    FixedSizeMatrix operator- (const FixedSizeMatrix& other) const noexcept     { auto result (*this); result -= other;  return result; }
+
+    /** Scalar multiplication */
+    FixedSizeMatrix operator* (ElementType scalar) const noexcept               { auto result (*this); result *= scalar; return result; }
+
+    /** Matrix multiplication */
+    template <size_t otherNumColumns>
+    FixedSizeMatrix<ElementType, numRows, otherNumColumns> operator* (const FixedSizeMatrix<ElementType, numColumns, otherNumColumns>& other) const noexcept
+    {
+        FixedSizeMatrix<ElementType, numRows, otherNumColumns> result;
+
+        // with sizes known at compile time, compilers vectorise this loop order best
+        for (size_t i = 0; i < numRows; ++i)
         {
-            *dst = binaryOp (*dst, src);
-            ++dst;
+            for (size_t j = 0; j < otherNumColumns; ++j)
+            {
+                ElementType sum = 0;
+
+                for (size_t k = 0; k < numColumns; ++k)
+                    sum += data[i * numColumns + k] * other (k, j);
+
+                result (i, j) = sum;
+            }
         }
 
-        return *this;
+        return result;
     }
 
     //==============================================================================
-    Array<ElementType> data;
-    Array<size_t> dataAcceleration;
+    /** Compare to matrices with a given tolerance */
+    static bool compare (const FixedSizeMatrix& a, const FixedSizeMatrix& b, ElementType tolerance = 0) noexcept
+    {
+        tolerance = std::abs (tolerance);
 
-    size_t rows, columns;
+        for (size_t i = 0; i < a.data.size(); ++i)
+            if (std::abs (a.data[i] - b.data[i]) > tolerance)
+                return false;
+
+        return true;
+    }
+
+    /* Comparison operator */
+    inline bool operator== (const FixedSizeMatrix& other) const noexcept        { return compare (*this, other); }
 
     //==============================================================================
-    JUCE_LEAK_DETECTOR (Matrix)
+    ElementType* begin() noexcept                   { return data.data(); }
+    ElementType* end() noexcept                     { return data.data() + data.size(); }
+
+    const ElementType* begin() const noexcept       { return data.data(); }
+    const ElementType* end()   const noexcept       { return data.data() + data.size(); }
+
+private:
+    //==============================================================================
+    std::array<ElementType, numRows * numColumns> data;
 };
 
 } // namespace dsp
@@ -145,6 +145,131 @@ struct LinearAlgebraUnitTest  : public UnitTest
         }
     };
 
+    template <typename ElementType>
+    static Matrix<ElementType> makeRandomMatrix (Random& random, size_t numRows, size_t numColumns)
+    {
+        Matrix<ElementType> result (numRows, numColumns);
+
+        for (auto& x : result)
+            x = (ElementType) (2.0f * random.nextFloat() - 1.0f);
+
+        return result;
+    }
+
+    template <typename ElementType>
+    static Matrix<ElementType> referenceProduct (const Matrix<ElementType>& a, const Matrix<ElementType>& b)
+    {
+        Matrix<ElementType> result (a.getNumRows(), b.getNumColumns());
+
+        for (size_t i = 0; i < a.getNumRows(); ++i)
+        {
+            for (size_t j = 0; j < b.getNumColumns(); ++j)
+            {
+                double sum = 0;
+
+                for (size_t k = 0; k < a.getNumColumns(); ++k)
+                    sum += (double) a (i, k) * (double) b (k, j);
+
+                result (i, j) = (ElementType) sum;
+            }
+        }
+
+        return result;
+    }
+
+    struct LargeMultiplicationTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            auto random = u.getRandom();
+
+            // sizes which aren't multiples of the tiles, plus a matrix-vector product
+            for (auto size : { Array<size_t> { 3, 5, 7 }, Array<size_t> { 70, 300, 51 },
+                               Array<size_t> { 40, 33, 600 }, Array<size_t> { 129, 257, 1 } })
+            {
+                auto a = makeRandomMatrix<ElementType> (random, size[0], size[1]);
+                auto b = makeRandomMatrix<ElementType> (random, size[1], size[2]);
+                auto expected = referenceProduct (a, b);
+
+                u.expect (Matrix<ElementType>::compare (a * b, expected, (ElementType) 1e-3));
+
+                // multiplying into an existing matrix must overwrite its contents
+                auto result = makeRandomMatrix<ElementType> (random, size[0], size[2]);
+                Matrix<ElementType>::multiply (a, b, result);
+                u.expect (Matrix<ElementType>::compare (result, expected, (ElementType) 1e-3));
+            }
+        }
+    };
+
+    struct LargeSolvingTest
+    {
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            auto random = u.getRandom();
+            const size_t n = 40;
+
+            auto A = makeRandomMatrix<ElementType> (random, n, n);
+            auto X = makeRandomMatrix<ElementType> (random, n, 1);
+
+            // keep the system well conditioned, with a zero at the top of the diagonal
+            // so that the pivoting gets used
+            for (size_t i = 0; i < n; ++i)
+                A (i, i) += (ElementType) n;
+
+            A (0, 0) = 0;
+            A (1, 0) = (ElementType) n;
+
+            auto B = referenceProduct (A, X);
+
+            u.expect (A.solve (B));
+            u.expect (Matrix<ElementType>::compare (X, B, (ElementType) 1e-4));
+        }
+    };
+
+    struct FixedSizeMatrixTest
+    {
+        template <typename ElementType, size_t size>
+        static void checkProducts (LinearAlgebraUnitTest& u, Random& random)
+        {
+            using Fixed = FixedSizeMatrix<ElementType, size, size>;
+            using Vector = FixedSizeMatrix<ElementType, size, 1>;
+
+            auto a = makeRandomMatrix<ElementType> (random, size, size);
+            auto b = makeRandomMatrix<ElementType> (random, size, size);
+            auto v = makeRandomMatrix<ElementType> (random, size, 1);
+
+            Fixed fixedA (a), fixedB (b);
+            Vector fixedV (v);
+
+            u.expect (Matrix<ElementType>::compare ((fixedA * fixedB).toMatrix(), a * b, (ElementType) 1e-5));
+            u.expect (Matrix<ElementType>::compare ((fixedA * fixedV).toMatrix(), a * v, (ElementType) 1e-5));
+            u.expect ((fixedA + fixedB).toMatrix() == a + b);
+            u.expect ((fixedA - fixedB).toMatrix() == a - b);
+            u.expect ((fixedA * (ElementType) 3).toMatrix() == a * (ElementType) 3);
+            u.expect (Fixed (fixedA).hadarmard (fixedB).toMatrix() == Matrix<ElementType>::hadarmard (a, b));
+            u.expect (fixedA * Fixed::identity() == fixedA);
+            u.expect (Fixed::identity().toMatrix() == Matrix<ElementType>::identity (size));
+        }
+
+        template <typename ElementType>
+        static void run (LinearAlgebraUnitTest& u)
+        {
+            auto random = u.getRandom();
+
+            checkProducts<ElementType, 4> (u, random);
+            checkProducts<ElementType, 16> (u, random);
+
+            const ElementType data1[] = { 1,  2, 3,  4,  5,  6,  7,  8 };
+            const ElementType data2[] = { 1, -1, 3, -1,  5, -1,  7, -1 };
+            const ElementType data3[] = { 50, -10, 114, -26 };
+
+            u.expect (FixedSizeMatrix<ElementType, 2, 4> (data1) * FixedSizeMatrix<ElementType, 4, 2> (data2)
+                        == FixedSizeMatrix<ElementType, 2, 2> (data3));
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -163,6 +288,9 @@ struct LinearAlgebraUnitTest  : public UnitTest
         runTestForAllTypes<MultiplicationTest> ("MultiplicationTest");
         runTestForAllTypes<IdentityMatrixTest> ("IdentityMatrixTest");
         runTestForAllTypes<SolvingTest> ("SolvingTest");
+        runTestForAllTypes<LargeMultiplicationTest> ("LargeMultiplicationTest");
+        runTestForAllTypes<LargeSolvingTest> ("LargeSolvingTest");
+        runTestForAllTypes<FixedSizeMatrixTest> ("FixedSizeMatrixTest");
     }
 };
 
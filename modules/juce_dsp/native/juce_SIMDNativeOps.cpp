@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+/*  This defines the constant tables used by the native SIMD ops for the instruction set
+    that the current translation unit is being compiled for.
+
+    The juce_dsp module already includes it for its own instruction set, so you only need
+    to include it yourself if you compile some of your dsp code with different compiler
+    flags (see SIMDInstructionSet). In that case, include it in exactly one of the
+    translation units built for each extra instruction set.
+*/
+#if JUCE_USE_SIMD
+ #if defined(__i386__) || defined(__amd64__) || defined(_M_X64) || defined(_X86_) || defined(_M_IX86)
+  #if defined (__AVX512F__) && defined (__AVX512BW__)
+   // the AVX-512 ops build their constants in registers, so there's nothing to define
+  #elif defined (__AVX2__)
+   #include "juce_avx_SIMDNativeOps.cpp"
+  #else
+   #include "juce_sse_SIMDNativeOps.cpp"
+  #endif
+ #elif defined(__arm__) || defined(_M_ARM) || defined (__arm64__) || defined (__aarch64__)
+  #include "juce_neon_SIMDNativeOps.cpp"
+ #else
+  #error "SIMD register support not implemented for this platform"
+ #endif
+#endif
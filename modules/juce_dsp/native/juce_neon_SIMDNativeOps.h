@@ -28,6 +28,8 @@ namespace juce
 {
 namespace dsp
 {
+inline namespace JUCE_DSP_SIMD_NAMESPACE
+{
 
 #ifndef DOXYGEN
 
@@ -439,6 +441,19 @@ struct SIMDNativeOps<float>
         return add (rr_ir, bit_xor (ii_ri, vld1q_f32 ((float*) kEvenHighBit)));
     }
 
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept
+    {
+       #if defined (__arm64__) || defined (__aarch64__)
+        return vdivq_f32 (a, b);
+       #else
+        // 32-bit NEON has no division, so refine the reciprocal estimate with two Newton-Raphson steps
+        auto r = vrecpeq_f32 (b);
+        r = vmulq_f32 (vrecpsq_f32 (b, r), r);
+        r = vmulq_f32 (vrecpsq_f32 (b, r), r);
+        return vmulq_f32 (a, r);
+       #endif
+    }
+
     static forcedinline float sum (vSIMDType a) noexcept
     {
         auto rr = vadd_f32 (vget_high_f32 (a), vget_low_f32 (a));
@@ -467,6 +482,7 @@ struct SIMDNativeOps<double>
     static forcedinline vSIMDType add (vSIMDType a, vSIMDType b) noexcept                      { return {{a.v[0] + b.v[0], a.v[1] + b.v[1]}}; }
     static forcedinline vSIMDType sub (vSIMDType a, vSIMDType b) noexcept                      { return {{a.v[0] - b.v[0], a.v[1] - b.v[1]}}; }
     static forcedinline vSIMDType mul (vSIMDType a, vSIMDType b) noexcept                      { return {{a.v[0] * b.v[0], a.v[1] * b.v[1]}}; }
+    static forcedinline vSIMDType div (vSIMDType a, vSIMDType b) noexcept                      { return {{a.v[0] / b.v[0], a.v[1] / b.v[1]}}; }
     static forcedinline vSIMDType bit_and (vSIMDType a, vSIMDType b) noexcept                  { return fb::bit_and (a, b); }
     static forcedinline vSIMDType bit_or  (vSIMDType a, vSIMDType b) noexcept                  { return fb::bit_or  (a, b); }
     static forcedinline vSIMDType bit_xor (vSIMDType a, vSIMDType b) noexcept                  { return fb::bit_xor (a, b); }
@@ -491,5 +507,6 @@ struct SIMDNativeOps<double>
  #pragma GCC diagnostic pop
 #endif
 
+} // namespace JUCE_DSP_SIMD_NAMESPACE
 } // namespace dsp
 } // namespace juce
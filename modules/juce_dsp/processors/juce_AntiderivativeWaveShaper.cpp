@@ -0,0 +1,295 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/** Below this distance between input samples, the divided differences are
+    replaced by the value of the function or antiderivative in the middle.
+*/
+static constexpr double antiderivativeWaveShaperTolerance = 1.0e-5;
+
+//==============================================================================
+template <typename SampleType>
+AntiderivativeWaveShaper<SampleType>::AntiderivativeWaveShaper()  : state (2)
+{
+}
+
+template <typename SampleType>
+AntiderivativeWaveShaper<SampleType>::AntiderivativeWaveShaper (const std::function<SampleType (SampleType)>& function,
+                                                                SampleType minInputValue, SampleType maxInputValue,
+                                                                size_t numPoints, Order newOrder)
+    : state (2)
+{
+    initialise (function, minInputValue, maxInputValue, numPoints, newOrder);
+}
+
+template <typename SampleType>
+void AntiderivativeWaveShaper<SampleType>::initialise (const std::function<SampleType (SampleType)>& function,
+                                                       SampleType minInputValue, SampleType maxInputValue,
+                                                       size_t numPoints, Order newOrder)
+{
+    jassert (maxInputValue > minInputValue);
+    jassert (numPoints > 1);
+
+    auto numValues = static_cast<int> (numPoints);
+
+    minInput = static_cast<double> (minInputValue);
+    step = (static_cast<double> (maxInputValue) - minInput) / (numValues - 1);
+    inverseStep = 1.0 / step;
+
+    values.resize (numValues);
+    firstIntegrals.resize (numValues);
+    secondIntegrals.resize (numValues);
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        auto value = static_cast<double> (function (static_cast<SampleType> (minInput + i * step)));
+
+        jassert (! std::isnan (value));
+        jassert (! std::isinf (value));
+
+        values.setUnchecked (i, value);
+    }
+
+    // The integrals start from the point nearest to zero, to keep their values,
+    // and therefore their rounding errors, as small as possible
+    auto start = jlimit (0, numValues - 1, roundToInt (-minInput * inverseStep));
+    firstIntegrals.setUnchecked (start, 0.0);
+    secondIntegrals.setUnchecked (start, 0.0);
+
+    auto* f  = values.getRawDataPointer();
+    auto* F1 = firstIntegrals.getRawDataPointer();
+    auto* F2 = secondIntegrals.getRawDataPointer();
+    auto h = step;
+
+    for (int i = start; i < numValues - 1; ++i)
+    {
+        F1[i + 1] = F1[i] + h * (f[i] + f[i + 1]) * 0.5;
+        F2[i + 1] = F2[i] + h * F1[i] + h * h * (f[i] / 3.0 + f[i + 1] / 6.0);
+    }
+
+    for (int i = start; --i >= 0;)
+    {
+        F1[i] = F1[i + 1] - h * (f[i] + f[i + 1]) * 0.5;
+        F2[i] = F2[i + 1] - h * F1[i + 1] + h * h * (f[i] / 6.0 + f[i + 1] / 3.0);
+    }
+
+    order = newOrder;
+    reset();
+}
+
+template <typename SampleType>
+void AntiderivativeWaveShaper<SampleType>::setOrder (Order newOrder) noexcept
+{
+    order = newOrder;
+    reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void AntiderivativeWaveShaper<SampleType>::prepare (const ProcessSpec& spec)
+{
+    state.resize (spec.numChannels);
+    reset();
+}
+
+template <typename SampleType>
+void AntiderivativeWaveShaper<SampleType>::reset() noexcept
+{
+    if (values.isEmpty())
+        return;
+
+    for (auto& s : state)
+    {
+        s.x1 = s.x2 = 0;
+        s.integral1 = order == Order::second ? getSecondIntegral (0) : getFirstIntegral (0);
+        s.difference1 = getFirstIntegral (0);
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+SampleType AntiderivativeWaveShaper<SampleType>::processSample (SampleType inputSample, size_t channel) noexcept
+{
+    jassert (! values.isEmpty());   // call initialise() before first use
+    jassert (channel < state.size());
+
+    auto x = static_cast<double> (inputSample);
+
+    switch (order)
+    {
+        case Order::first:   return static_cast<SampleType> (processFirstOrder  (x, state[channel]));
+        case Order::second:  return static_cast<SampleType> (processSecondOrder (x, state[channel]));
+        case Order::none:
+        default:             return static_cast<SampleType> (getValue (x));
+    }
+}
+
+template <typename SampleType>
+void AntiderivativeWaveShaper<SampleType>::processChannel (const SampleType* input, SampleType* output,
+                                                           size_t numSamples, size_t channel) noexcept
+{
+    jassert (! values.isEmpty());   // call initialise() before first use
+
+    auto& s = state[channel];
+
+    switch (order)
+    {
+        case Order::first:
+            for (size_t i = 0; i < numSamples; ++i)
+                output[i] = static_cast<SampleType> (processFirstOrder (static_cast<double> (input[i]), s));
+            break;
+
+        case Order::second:
+            for (size_t i = 0; i < numSamples; ++i)
+                output[i] = static_cast<SampleType> (processSecondOrder (static_cast<double> (input[i]), s));
+            break;
+
+        case Order::none:
+        default:
+            for (size_t i = 0; i < numSamples; ++i)
+                output[i] = static_cast<SampleType> (getValue (static_cast<double> (input[i])));
+            break;
+    }
+}
+
+template <typename SampleType>
+double AntiderivativeWaveShaper<SampleType>::processFirstOrder (double x, ChannelState& s) const noexcept
+{
+    auto integral = getFirstIntegral (x);
+    auto delta = x - s.x1;
+
+    auto result = std::abs (delta) < antiderivativeWaveShaperTolerance
+                    ? getValue ((x + s.x1) * 0.5)
+                    : (integral - s.integral1) / delta;
+
+    s.x1 = x;
+    s.integral1 = integral;
+
+    return result;
+}
+
+template <typename SampleType>
+double AntiderivativeWaveShaper<SampleType>::processSecondOrder (double x, ChannelState& s) const noexcept
+{
+    auto integral = getSecondIntegral (x);
+    auto delta = x - s.x1;
+
+    auto difference = std::abs (delta) < antiderivativeWaveShaperTolerance
+                        ? getFirstIntegral ((x + s.x1) * 0.5)
+                        : (integral - s.integral1) / delta;
+
+    auto width = x - s.x2;
+    double result;
+
+    if (std::abs (width) < antiderivativeWaveShaperTolerance)
+    {
+        // The first and last samples are too close: the average is taken around
+        // the middle sample instead
+        auto middle = (x + s.x2) * 0.5;
+        auto distance = middle - s.x1;
+
+        result = std::abs (distance) < antiderivativeWaveShaperTolerance
+                   ? getValue ((middle + s.x1) * 0.5)
+                   : (2.0 / distance) * (getFirstIntegral (middle) + (s.integral1 - getSecondIntegral (middle)) / distance);
+    }
+    else
+    {
+        result = 2.0 * (difference - s.difference1) / width;
+    }
+
+    s.x2 = s.x1;
+    s.x1 = x;
+    s.integral1 = integral;
+    s.difference1 = difference;
+
+    return result;
+}
+
+//==============================================================================
+template <typename SampleType>
+void AntiderivativeWaveShaper<SampleType>::locate (double x, int& node, double& offset, double& slope) const noexcept
+{
+    auto index = (x - minInput) * inverseStep;
+    auto lastNode = values.size() - 1;
+
+    if (index < 0)
+    {
+        node = 0;
+        offset = x - minInput;
+        slope = 0;
+    }
+    else if (index >= lastNode)
+    {
+        node = lastNode;
+        offset = x - (minInput + lastNode * step);
+        slope = 0;
+    }
+    else
+    {
+        node = static_cast<int> (index);
+        offset = (index - node) * step;
+        slope = (values.getUnchecked (node + 1) - values.getUnchecked (node)) * inverseStep;
+    }
+}
+
+template <typename SampleType>
+double AntiderivativeWaveShaper<SampleType>::getValue (double x) const noexcept
+{
+    int node; double u, slope;
+    locate (x, node, u, slope);
+
+    return values.getUnchecked (node) + slope * u;
+}
+
+template <typename SampleType>
+double AntiderivativeWaveShaper<SampleType>::getFirstIntegral (double x) const noexcept
+{
+    int node; double u, slope;
+    locate (x, node, u, slope);
+
+    return firstIntegrals.getUnchecked (node) + u * (values.getUnchecked (node) + slope * u * 0.5);
+}
+
+template <typename SampleType>
+double AntiderivativeWaveShaper<SampleType>::getSecondIntegral (double x) const noexcept
+{
+    int node; double u, slope;
+    locate (x, node, u, slope);
+
+    return secondIntegrals.getUnchecked (node)
+             + u * (firstIntegrals.getUnchecked (node) + u * (values.getUnchecked (node) * 0.5 + slope * u / 6.0));
+}
+
+//==============================================================================
+template class AntiderivativeWaveShaper<float>;
+template class AntiderivativeWaveShaper<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A waveshaper which reduces aliasing with antiderivative anti-aliasing (ADAA).
+
+    Rather than applying the function to each sample, the first order mode returns
+    the average of the function over the straight line joining two successive input
+    samples, computed from its first antiderivative, and the second order mode does
+    the same with second antiderivatives over three samples. This filters out most
+    of the aliased harmonics the function would create, so a saturation which would
+    otherwise need 8 or 16 times oversampling sounds as clean with only 2 times, at
+    a much lower cost. Put the waveshaper between Oversampling::processSamplesUp()
+    and Oversampling::processSamplesDown(), preparing it for the oversampled rate.
+
+    The function is tabulated when the object is initialised, along with its first
+    and second antiderivatives. Between the table points the function is linearly
+    interpolated, and the antiderivatives are the exact integrals of that line, so
+    they stay consistent with each other however close two input samples are.
+    Outside the given input range the function is assumed to carry on with its
+    value at the end of the range, which suits saturation curves.
+
+    The processing is done in double precision whatever the sample type, as the
+    divided differences of the antiderivatives are very sensitive to rounding. The
+    first order mode delays the signal by half a sample, the second order mode by
+    one sample.
+
+    @see WaveShaper, Oversampling
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class JUCE_API  AntiderivativeWaveShaper
+{
+public:
+    /** The amount of anti-aliasing applied. */
+    enum class Order
+    {
+        none = 0,   // the tabulated function is applied directly
+        first,
+        second
+    };
+
+    //==============================================================================
+    /** Creates an uninitialised waveshaper. Call initialise() before first use. */
+    AntiderivativeWaveShaper();
+
+    /** Creates and initialises a waveshaper.
+        @see initialise
+    */
+    AntiderivativeWaveShaper (const std::function<SampleType (SampleType)>& function,
+                              SampleType minInputValue, SampleType maxInputValue,
+                              size_t numPoints, Order order = Order::first);
+
+    /** Tabulates a new function and its antiderivatives.
+
+        This allocates, so mustn't be called while processing.
+
+        @param function         the waveshaping function
+        @param minInputValue    the lowest input value of the table
+        @param maxInputValue    the highest input value of the table, beyond which the
+                                function is held at its last value
+        @param numPoints        the number of points where the function is evaluated
+        @param order            the amount of anti-aliasing applied
+    */
+    void initialise (const std::function<SampleType (SampleType)>& function,
+                     SampleType minInputValue, SampleType maxInputValue,
+                     size_t numPoints, Order order = Order::first);
+
+    /** Changes the amount of anti-aliasing applied. This resets the waveshaper. */
+    void setOrder (Order newOrder) noexcept;
+
+    /** Returns the amount of anti-aliasing applied. */
+    Order getOrder() const noexcept                 { return order; }
+
+    /** Returns the delay added by the anti-aliasing, in samples. */
+    SampleType getLatencyInSamples() const noexcept { return static_cast<SampleType> (static_cast<int> (order)) / 2; }
+
+    //==============================================================================
+    /** Allocates the state of each channel. */
+    void prepare (const ProcessSpec&);
+
+    /** Forgets the previous input samples. */
+    void reset() noexcept;
+
+    /** Returns the result of processing a single sample of the given channel. */
+    SampleType processSample (SampleType inputSample, size_t channel) noexcept;
+
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples = outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() <= state.size());
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumSamples()  == numSamples);
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copy (inputBlock);
+
+            return;
+        }
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            processChannel (inputBlock.getChannelPointer (channel), outputBlock.getChannelPointer (channel),
+                            numSamples, channel);
+    }
+
+private:
+    //==============================================================================
+    struct ChannelState
+    {
+        double x1, x2;      // the previous input samples
+        double integral1;   // the first antiderivative at x1 in first order mode,
+                            // the second antiderivative at x1 in second order mode
+        double difference1; // the divided difference of the second antiderivative between x1 and x2
+    };
+
+    void processChannel (const SampleType* input, SampleType* output, size_t numSamples, size_t channel) noexcept;
+
+    double processFirstOrder (double x, ChannelState&) const noexcept;
+    double processSecondOrder (double x, ChannelState&) const noexcept;
+
+    void locate (double x, int& node, double& offset, double& slope) const noexcept;
+    double getValue (double x) const noexcept;
+    double getFirstIntegral (double x) const noexcept;
+    double getSecondIntegral (double x) const noexcept;
+
+    //==============================================================================
+    Array<double> values, firstIntegrals, secondIntegrals;
+    double minInput = 0, step = 1, inverseStep = 1;
+
+    Order order = Order::first;
+    std::vector<ChannelState> state;
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR (AntiderivativeWaveShaper)
+};
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct AntiderivativeWaveShaperTest  : public UnitTest
+{
+    AntiderivativeWaveShaperTest()  : UnitTest ("AntiderivativeWaveShaper", "DSP") {}
+
+    using Shaper = AntiderivativeWaveShaper<float>;
+
+    static float saturate (float x)     { return std::tanh (4.0f * x); }
+
+    /** Drives a sine through the shaper, and returns the ratio in dB between the
+        energy of the aliased components and the energy of the harmonics.
+    */
+    static double getAliasingdB (Shaper::Order order)
+    {
+        constexpr int fftOrder = 14;
+        constexpr int size = 1 << fftOrder;
+
+        // not a divisor of the FFT size, so that no aliased component falls on a harmonic
+        const auto frequencyBin = 1487.3;
+
+        Shaper shaper (saturate, -2.0f, 2.0f, 4096, order);
+        shaper.prepare ({ 44100.0, (uint32) size, 1 });
+
+        HeapBlock<float> data (2 * size, true);
+        WindowingFunction<float> window ((size_t) size, WindowingFunction<float>::blackmanHarris);
+
+        for (int i = 0; i < size; ++i)
+            data[i] = shaper.processSample (std::sin (MathConstants<float>::twoPi * (float) (frequencyBin * i / size)), 0);
+
+        window.multiplyWithWindowingTable (data.get(), (size_t) size);
+
+        FFT fft (fftOrder);
+        fft.performFrequencyOnlyForwardTransform (data.get());
+
+        double harmonics = 0, aliasing = 0;
+
+        for (int bin = 1; bin < size / 2; ++bin)
+        {
+            auto harmonicNumber = bin / frequencyBin;
+            auto nearHarmonic = std::abs (harmonicNumber - std::round (harmonicNumber)) * frequencyBin < 8.0;
+            auto energy = (double) data[bin] * data[bin];
+
+            (nearHarmonic ? harmonics : aliasing) += energy;
+        }
+
+        return 10.0 * std::log10 (aliasing / harmonics);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Tabulation");
+        {
+            Shaper shaper (saturate, -2.0f, 2.0f, 4096, Shaper::Order::none);
+            shaper.prepare ({ 44100.0, 64, 1 });
+
+            for (auto x = -3.0f; x <= 3.0f; x += 0.01f)
+                expectWithinAbsoluteError (shaper.processSample (x, 0), saturate (jlimit (-2.0f, 2.0f, x)), 1.0e-4f);
+        }
+
+        beginTest ("First order");
+        {
+            // for a linear function, the result is the average of the function at two samples
+            Shaper shaper ([] (float x) { return 0.5f * x; }, -1.0f, 1.0f, 64);
+            shaper.prepare ({ 44100.0, 64, 2 });
+            expectEquals (shaper.getLatencyInSamples(), 0.5f);
+
+            Random random (21);
+            auto previous = 0.0f;
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                auto x = 2.0f * random.nextFloat() - 1.0f;
+                expectWithinAbsoluteError (shaper.processSample (x, 1), 0.25f * (x + previous), 1.0e-5f);
+                previous = x;
+            }
+
+            // a constant input gives the function of that input, even outside the table
+            for (auto x : { -4.0f, -0.3f, 0.8f, 1.5f })
+            {
+                shaper.reset();
+
+                for (int i = 0; i < 4; ++i)
+                    shaper.processSample (x, 0);
+
+                expectWithinAbsoluteError (shaper.processSample (x, 0), 0.5f * jlimit (-1.0f, 1.0f, x), 1.0e-5f);
+            }
+        }
+
+        beginTest ("Second order");
+        {
+            Shaper shaper (saturate, -2.0f, 2.0f, 4096, Shaper::Order::second);
+            shaper.prepare ({ 44100.0, 64, 1 });
+            expectEquals (shaper.getLatencyInSamples(), 1.0f);
+
+            // once started, a slowly moving input gives the function of the input one sample earlier
+            auto previous = 0.0f;
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto x = 1.5f * std::sin ((float) i * 0.002f);
+                auto y = shaper.processSample (x, 0);
+
+                if (i > 2)
+                    expectWithinAbsoluteError (y, saturate (previous), 1.0e-3f);
+
+                previous = x;
+            }
+
+            // blocks give the same results as single samples
+            AudioBuffer<float> buffer (1, 512);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (0, i, std::sin ((float) i * 0.3f));
+
+            AudioBuffer<float> expected (buffer);
+            shaper.reset();
+
+            for (int i = 0; i < expected.getNumSamples(); ++i)
+                expected.setSample (0, i, shaper.processSample (expected.getSample (0, i), 0));
+
+            shaper.reset();
+            AudioBlock<float> block (buffer);
+            shaper.process (ProcessContextReplacing<float> (block));
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                expectEquals (buffer.getSample (0, i), expected.getSample (0, i));
+        }
+
+        beginTest ("Aliasing");
+        {
+            auto none   = getAliasingdB (Shaper::Order::none);
+            auto first  = getAliasingdB (Shaper::Order::first);
+            auto second = getAliasingdB (Shaper::Order::second);
+
+            logMessage ("Aliasing: " + String (none, 1) + " dB, " + String (first, 1) + " dB, " + String (second, 1) + " dB");
+            expectLessThan (first, none - 6.0);
+            expectLessThan (second, first - 3.0);
+        }
+    }
+};
+
+static AntiderivativeWaveShaperTest antiderivativeWaveShaperUnitTest;
+
+} // namespace dsp
+} // namespace juce
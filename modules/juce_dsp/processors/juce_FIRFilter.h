@@ -37,17 +37,76 @@ namespace FIR
     template <typename NumericType>
     struct Coefficients;
 
+    //==============================================================================
+    /**
+        Convolves a mono signal with all but the first few coefficients of a long FIR
+        filter in the frequency domain, using the same uniformly partitioned overlap-save
+        engine as the Convolution class. This is used internally by Filter<float>.
+
+        The output for the coefficients after getHeadSize() is added to the output that
+        the caller has worked out for the head, so the result has no extra latency.
+
+        @tags{DSP}
+    */
+    class JUCE_API  PartitionedConvolutionTail
+    {
+    public:
+        /** Prepares the tail of the given coefficients. */
+        PartitionedConvolutionTail (const float* coefficients, size_t numCoefficients);
+
+        /** Destructor. */
+        ~PartitionedConvolutionTail();
+
+        /** Returns the number of coefficients at the start which the tail doesn't process. */
+        static size_t getHeadSize() noexcept                        { return 2 * partitionSize; }
+
+        /** Returns the largest number of samples that can be passed to pushInput() and
+            addOutput() at once.
+        */
+        static size_t getMaximumBlockSize() noexcept                { return partitionSize; }
+
+        /** Returns true if the tail was prepared with this set of coefficients. */
+        bool matches (const float* coefficients, size_t numCoefficients) const noexcept;
+
+        /** Clears the state. */
+        void reset() noexcept;
+
+        /** Collects some input samples. This must be called before addOutput() for the
+            same samples.
+        */
+        void pushInput (const float* input, size_t numSamples) noexcept;
+
+        /** Adds the output for the samples that were last pushed to the given buffer,
+            or throws it away if the buffer is null.
+        */
+        void addOutput (float* output, size_t numSamples) noexcept;
+
+    private:
+        enum { partitionSize = 64 };
+
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PartitionedConvolutionTail)
+    };
+
     //==============================================================================
     /**
         A processing class that can perform FIR filtering on an audio signal, in the
         time domain.
 
-        Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
-        samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        The filter works in the time domain for short sets of coefficients. When the
+        samples are floats and the number of coefficients is above the threshold set with
+        setFFTThreshold(), the first few coefficients are still processed in the time
+        domain, but the rest are convolved in the frequency domain by a
+        PartitionedConvolutionTail, so the cost no longer grows linearly with the length
+        of the filter, and no latency is added. Changes to the coefficients are picked
+        up on the next call to process().
+
+        For very long impulse responses or multichannel convolution, the Convolution
+        class may still be a better fit.
 
-        @see FIRFilter::Coefficients, Convolution, FFT
+        @see FIRFilter::Coefficients, PartitionedConvolutionTail, Convolution, FFT
 
         @tags{DSP}
     */
@@ -95,7 +154,10 @@ namespace FIR
         {
             if (coefficients != nullptr)
             {
-                auto newSize = coefficients->getFilterOrder() + 1;
+                numCoefficients = coefficients->getFilterOrder() + 1;
+                updateTail (UsesFFT());
+
+                auto newSize = tail != nullptr ? PartitionedConvolutionTail::getHeadSize() : numCoefficients;
 
                 if (newSize != size)
                 {
@@ -110,6 +172,23 @@ namespace FIR
             }
         }
 
+        //==============================================================================
+        /** Sets the number of coefficients above which part of the filter is processed in
+            the frequency domain. This only has an effect when the samples are floats.
+            The default is 256, and a value of 0 turns the frequency domain processing off.
+        */
+        void setFFTThreshold (size_t numCoefficientsThreshold)
+        {
+            fftThreshold = numCoefficientsThreshold;
+            reset();
+        }
+
+        /** Returns the threshold set by setFFTThreshold(). */
+        size_t getFFTThreshold() const noexcept         { return fftThreshold; }
+
+        /** Returns true if part of the filter is currently being processed in the frequency domain. */
+        bool isUsingFFT() const noexcept                { return tail != nullptr; }
+
         //==============================================================================
         /** The coefficients of the FIR filter. It's up to the caller to ensure that
             these coefficients are modified in a thread-safe way.
@@ -141,23 +220,23 @@ namespace FIR
             auto* dst = outputBlock.getChannelPointer (0);
 
             auto* fir = coefficients->getRawCoefficients();
-            size_t p = pos;
 
-            if (context.isBypassed)
+            if (tail != nullptr)
             {
-                for (size_t i = 0; i < numSamples; ++i)
+                // the tail's input has to be collected before it can be overwritten by the head's output
+                for (size_t start = 0; start < numSamples; start += PartitionedConvolutionTail::getMaximumBlockSize())
                 {
-                    fifo[p] = dst[i] = src[i];
-                    p = (p == 0 ? size - 1 : p - 1);
+                    auto num = jmin (PartitionedConvolutionTail::getMaximumBlockSize(), numSamples - start);
+
+                    pushToTail (src + start, num, UsesFFT());
+                    processHead (src + start, dst + start, num, fir, context.isBypassed);
+                    addTailOutput (context.isBypassed ? nullptr : dst + start, num, UsesFFT());
                 }
             }
             else
             {
-                for (size_t i = 0; i < numSamples; ++i)
-                    dst[i] = processSingleSample (src[i], fifo, fir, size, p);
+                processHead (src, dst, numSamples, fir, context.isBypassed);
             }
-
-            pos = p;
         }
 
 
@@ -167,24 +246,92 @@ namespace FIR
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             check();
-            return processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
+
+            if (tail != nullptr)
+                pushToTail (&sample, 1, UsesFFT());
+
+            auto out = processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
+
+            if (tail != nullptr)
+                addTailOutput (&out, 1, UsesFFT());
+
+            return out;
         }
 
     private:
         //==============================================================================
+        using UsesFFT = std::integral_constant<bool, std::is_same<SampleType, float>::value>;
+
         HeapBlock<SampleType> memory;
         SampleType* fifo = nullptr;
-        size_t pos = 0, size = 0;
+        size_t pos = 0, size = 0, numCoefficients = 0, fftThreshold = 256;
+        std::unique_ptr<PartitionedConvolutionTail> tail;
 
         //==============================================================================
         void check()
         {
             jassert (coefficients != nullptr);
 
-            if (size != (coefficients->getFilterOrder() + 1))
+            if (numCoefficients != (coefficients->getFilterOrder() + 1)
+                 || ! tailMatchesCoefficients (UsesFFT()))
                 reset();
         }
 
+        void updateTail (std::false_type)   {}
+
+        void updateTail (std::true_type)
+        {
+            if (fftThreshold == 0 || numCoefficients <= jmax (fftThreshold, PartitionedConvolutionTail::getHeadSize()))
+                tail.reset();
+            else if (tail != nullptr && tail->matches (coefficients->getRawCoefficients(), numCoefficients))
+                tail->reset();
+            else
+                tail.reset (new PartitionedConvolutionTail (coefficients->getRawCoefficients(), numCoefficients));
+        }
+
+        void pushToTail (const SampleType*, size_t, std::false_type) noexcept {}
+
+        void pushToTail (const SampleType* input, size_t num, std::true_type) noexcept
+        {
+            tail->pushInput (input, num);
+        }
+
+        void addTailOutput (SampleType*, size_t, std::false_type) noexcept {}
+
+        void addTailOutput (SampleType* output, size_t num, std::true_type) noexcept
+        {
+            tail->addOutput (output, num);
+        }
+
+        bool tailMatchesCoefficients (std::false_type) const noexcept  { return true; }
+
+        bool tailMatchesCoefficients (std::true_type) const noexcept
+        {
+            return tail == nullptr || tail->matches (coefficients->getRawCoefficients(), numCoefficients);
+        }
+
+        void processHead (const SampleType* src, SampleType* dst, size_t numSamples,
+                          const NumericType* fir, bool isBypassed) noexcept
+        {
+            size_t p = pos;
+
+            if (isBypassed)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    fifo[p] = dst[i] = src[i];
+                    p = (p == 0 ? size - 1 : p - 1);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    dst[i] = processSingleSample (src[i], fifo, fir, size, p);
+            }
+
+            pos = p;
+        }
+
         static SampleType JUCE_VECTOR_CALLTYPE processSingleSample (SampleType sample, SampleType* buf,
                                                                     const NumericType* fir, size_t m, size_t& p) noexcept
         {
@@ -204,6 +204,46 @@ class FIRFilterTest : public UnitTest
     }
 
 
+    //==============================================================================
+    /** Checks that the hybrid time and frequency domain mode gives the same results as
+        the reference, with irregular block sizes and in-place processing.
+    */
+    void runLongFilterTest (size_t numCoefficients, size_t fftThreshold, bool shouldUseFFT)
+    {
+        Random random (2694715);
+        const size_t n = 5000;
+
+        HeapBlock<float> input (n), output (n), ref (n), fir (numCoefficients);
+        fillRandom (random, input.get(), n);
+        fillRandom (random, fir.get(), numCoefficients);
+
+        FIR::Filter<float> filter (*new FIR::Coefficients<float> (fir.get(), numCoefficients));
+        filter.setFFTThreshold (fftThreshold);
+        filter.prepare ({ 44100.0, 512, 1 });
+        expect (filter.isUsingFFT() == shouldUseFFT);
+
+        reference<float, float> (fir.get(), numCoefficients, input.get(), ref.get(), n);
+
+        FloatVectorOperations::copy (output.get(), input.get(), (int) n);
+
+        for (size_t pos = 0; pos < n;)
+        {
+            auto len = jmin (n - pos, (size_t) (1 + random.nextInt (700)));
+            auto* data = output.get() + pos;
+
+            AudioBlock<float> block (&data, 1, len);
+            filter.process (ProcessContextReplacing<float> (block));
+            pos += len;
+        }
+
+        auto maxError = 0.0f;
+
+        for (size_t i = 0; i < n; ++i)
+            maxError = jmax (maxError, std::abs (output[i] - ref[i]));
+
+        expectLessThan (maxError, 1.0e-3f);
+    }
+
 public:
     FIRFilterTest() : UnitTest ("FIR Filter", "DSP") {}
 
@@ -212,6 +252,44 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+
+        beginTest ("Long filters in the frequency domain");
+        {
+            runLongFilterTest (300, 512, false);
+            runLongFilterTest (300, 200, true);
+            runLongFilterTest (129, 1, true);
+            runLongFilterTest (2048, 512, true);
+            runLongFilterTest (5000, 512, true);
+            runLongFilterTest (2048, 0, false);
+        }
+
+        beginTest ("Changing the coefficients of a long filter");
+        {
+            Random random (98142);
+            const size_t numCoefficients = 1000, n = 2048;
+
+            FIR::Filter<float> filter (*new FIR::Coefficients<float> (numCoefficients));
+            filter.prepare ({ 44100.0, 512, 1 });
+            expect (filter.isUsingFFT());
+
+            HeapBlock<float> input (n), output (n), ref (n);
+            fillRandom (random, input.get(), n);
+
+            // a delay of 600 samples, which is in the tail
+            filter.coefficients->coefficients.set (600, 1.0f);
+
+            float* src = input.get();
+            float* dst = output.get();
+            AudioBlock<float> inBlock (&src, 1, n), outBlock (&dst, 1, n);
+            filter.process (ProcessContextNonReplacing<float> (inBlock, outBlock));
+
+            auto maxError = 0.0f;
+
+            for (size_t i = 0; i < n; ++i)
+                maxError = jmax (maxError, std::abs (output[i] - (i >= 600 ? input[i - 600] : 0.0f)));
+
+            expectLessThan (maxError, 1.0e-5f);
+        }
     }
 };
 
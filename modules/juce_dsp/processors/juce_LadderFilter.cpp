@@ -80,6 +80,7 @@ void LadderFilter<Type>::reset() noexcept
 
     cutoffTransformSmoother.setCurrentAndTargetValue (cutoffTransformSmoother.getTargetValue());
     scaledResonanceSmoother.setCurrentAndTargetValue (scaledResonanceSmoother.getTargetValue());
+    samplesUntilUpdate = 0;
 }
 
 //==============================================================================
@@ -114,22 +115,47 @@ void LadderFilter<Type>::setDrive (Type newValue) noexcept
 
 //==============================================================================
 template <typename Type>
-Type LadderFilter<Type>::processSample (Type inputValue, size_t channelToUse) noexcept
+void LadderFilter<Type>::setCoefficientUpdateInterval (int numSamples) noexcept
 {
-    auto& s = state[channelToUse];
+    jassert (numSamples > 0);
+    updateInterval = jmax (1, numSamples);
+    samplesUntilUpdate = 0;
+}
 
+//==============================================================================
+template <typename Type>
+Type LadderFilter<Type>::processSample (Type inputValue, size_t channelToUse) noexcept
+{
     const auto a1 = cutoffTransformValue;
     const auto g =  a1 * Type (-1) + Type (1);
-    const auto b0 = g * Type (0.76923076923);
-    const auto b1 = g * Type (0.23076923076);
 
-    const auto dx = gain * saturationLUT (drive * inputValue);
-    const auto a = dx + scaledResonanceValue * Type (-4) * (gain2 * saturationLUT (drive2 * s[4]) - dx * comp);
+    return processLadder (inputValue, state[channelToUse].data(), a1,
+                          g * Type (0.76923076923), g * Type (0.23076923076), scaledResonanceValue * Type (-4));
+}
+
+//==============================================================================
+template <typename Type>
+template <typename ValueType>
+ValueType LadderFilter<Type>::processLadder (ValueType inputValue, ValueType* s, ValueType a1,
+                                             ValueType b0, ValueType b1, ValueType k) const noexcept
+{
+    // ValueType is either Type or a SIMDRegister of it, so the registers stay on the left
+    const auto dx = saturationLUT (inputValue * drive) * gain;
+    const auto a = dx + k * (saturationLUT (s[4] * drive2) * gain2 - dx * comp);
+
+    const auto pb = b1 * s[0] + a1 * s[1];
+    const auto pc = b1 * s[1] + a1 * s[2];
+    const auto pd = b1 * s[2] + a1 * s[3];
+    const auto pe = b1 * s[3] + a1 * s[4];
 
-    const auto b = b1 * s[0] + a1 * s[1] + b0 * a;
-    const auto c = b1 * s[1] + a1 * s[2] + b0 * b;
-    const auto d = b1 * s[2] + a1 * s[3] + b0 * c;
-    const auto e = b1 * s[3] + a1 * s[4] + b0 * d;
+    const auto b = pb + b0 * a;
+    const auto c = pc + b0 * b;
+    const auto d = pd + b0 * c;
+
+    // The last stage feeds back into the next sample, so rather than waiting for the
+    // three stages before it, it's expanded to depend on the input of the ladder only.
+    const auto b02 = b0 * b0;
+    const auto e = pe + b0 * pd + b02 * pc + b02 * b0 * pb + b02 * b02 * a;
 
     s[0] = a;
     s[1] = b;
@@ -146,7 +172,138 @@ void LadderFilter<Type>::updateSmoothers() noexcept
 {
     cutoffTransformValue = cutoffTransformSmoother.getNextValue();
     scaledResonanceValue = scaledResonanceSmoother.getNextValue();
+
+    if (updateInterval > 1)
+    {
+        cutoffTransformSmoother.skip (updateInterval - 1);
+        scaledResonanceSmoother.skip (updateInterval - 1);
+    }
+}
+
+//==============================================================================
+template <typename Type>
+void LadderFilter<Type>::fillCoefficientBuffers (size_t numSamples) noexcept
+{
+    jassert (numSamples <= maxChunkSize);
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        if (samplesUntilUpdate == 0)
+        {
+            updateSmoothers();
+            samplesUntilUpdate = updateInterval;
+        }
+
+        --samplesUntilUpdate;
+
+        const auto a1 = cutoffTransformValue;
+        const auto g =  a1 * Type (-1) + Type (1);
+
+        a1Buffer[i] = a1;
+        b0Buffer[i] = g * Type (0.76923076923);
+        b1Buffer[i] = g * Type (0.23076923076);
+        kBuffer[i]  = scaledResonanceValue * Type (-4);
+    }
+}
+
+//==============================================================================
+template <typename Type>
+void LadderFilter<Type>::processChunk (const AudioBlock<Type>& input, AudioBlock<Type> output) noexcept
+{
+    const auto numChannels = output.getNumChannels();
+    const auto numSamples  = output.getNumSamples();
+    size_t ch = 0;
+
+   #if JUCE_USE_SIMD
+    while (numChannels - ch >= SIMDRegister<Type>::size())
+    {
+        const Type* inputs[maxChannelsPerGroup];
+        Type* outputs[maxChannelsPerGroup];
+        auto numChannelsInGroup = jmin (maxChannelsPerGroup, numChannels - ch);
+
+        for (size_t i = 0; i < numChannelsInGroup; ++i)
+        {
+            inputs[i]  = input .getChannelPointer (ch + i);
+            outputs[i] = output.getChannelPointer (ch + i);
+        }
+
+        processChannelGroup (inputs, outputs, ch, numChannelsInGroup, numSamples);
+        ch += numChannelsInGroup;
+    }
+   #endif
+
+    // the channels that are left over go through the scalar version, all of them at
+    // each sample so that their ladders can overlap
+    if (ch < numChannels)
+    {
+        for (size_t n = 0; n < numSamples; ++n)
+            for (auto c = ch; c < numChannels; ++c)
+                output.getChannelPointer (c)[n] = processLadder (input.getChannelPointer (c)[n], state[c].data(),
+                                                                 a1Buffer[n], b0Buffer[n], b1Buffer[n], kBuffer[n]);
+    }
+}
+
+#if JUCE_USE_SIMD
+template <typename Type>
+void LadderFilter<Type>::processChannelGroup (const Type* const* inputs, Type* const* outputs, size_t firstChannel,
+                                              size_t numChannelsInGroup, size_t numSamples) noexcept
+{
+    jassert (numChannelsInGroup <= maxChannelsPerGroup);
+
+    if (numChannelsInGroup > SIMDRegister<Type>::size())
+        processRegisters<2> (inputs, outputs, firstChannel, numChannelsInGroup, numSamples);
+    else
+        processRegisters<1> (inputs, outputs, firstChannel, numChannelsInGroup, numSamples);
+}
+
+template <typename Type>
+template <size_t numRegisters>
+void LadderFilter<Type>::processRegisters (const Type* const* inputs, Type* const* outputs, size_t firstChannel,
+                                           size_t numChannelsInGroup, size_t numSamples) noexcept
+{
+    using Vec = SIMDRegister<Type>;
+    static constexpr auto numLanes = numRegisters * Vec::SIMDNumElements;
+
+    // the lanes of the unused channels are left at zero
+    alignas (Vec::SIMDRegisterSize) Type lanes[numLanes] = {};
+    alignas (Vec::SIMDRegisterSize) Type results[numLanes];
+    Vec s[numRegisters][numStates];
+
+    for (size_t j = 0; j < numStates; ++j)
+    {
+        for (size_t i = 0; i < numChannelsInGroup; ++i)
+            lanes[i] = state[firstChannel + i][j];
+
+        for (size_t r = 0; r < numRegisters; ++r)
+            s[r][j] = Vec::fromRawArray (lanes + r * Vec::SIMDNumElements);
+    }
+
+    for (size_t n = 0; n < numSamples; ++n)
+    {
+        for (size_t i = 0; i < numChannelsInGroup; ++i)
+            lanes[i] = inputs[i][n];
+
+        const auto a1 = Vec::expand (a1Buffer[n]), b0 = Vec::expand (b0Buffer[n]),
+                   b1 = Vec::expand (b1Buffer[n]), k  = Vec::expand (kBuffer[n]);
+
+        for (size_t r = 0; r < numRegisters; ++r)
+            processLadder (Vec::fromRawArray (lanes + r * Vec::SIMDNumElements), s[r], a1, b0, b1, k)
+                .copyToRawArray (results + r * Vec::SIMDNumElements);
+
+        for (size_t i = 0; i < numChannelsInGroup; ++i)
+            outputs[i][n] = results[i];
+    }
+
+    for (size_t j = 0; j < numStates; ++j)
+    {
+        for (size_t r = 0; r < numRegisters; ++r)
+            s[r][j].copyToRawArray (results + r * Vec::SIMDNumElements);
+
+        for (size_t i = 0; i < numChannelsInGroup; ++i)
+            state[firstChannel + i][j] = results[i];
+    }
 }
+#endif
 
 //==============================================================================
 template <typename Type>
@@ -77,6 +77,23 @@ public:
         @param newValue saturation amount; it can be any number greater than or equal to one. Higher values result in more distortion.*/
     void setDrive (Type newValue) noexcept;
 
+    /** Sets how often the smoothed cutoff frequency and resonance are updated while processing.
+
+        By default the coefficients follow the smoothers on every sample. With a longer
+        interval they only move every numSamples samples and are held in between, which
+        makes a heavily modulated filter cheaper to run, at the cost of a stepped rather
+        than continuous change. The updates don't depend on the size of the blocks being
+        processed.
+
+        @param numSamples the number of samples between two updates, which must be at least one
+    */
+    void setCoefficientUpdateInterval (int numSamples) noexcept;
+
+    /** Returns the number of samples between two updates of the coefficients.
+        @see setCoefficientUpdateInterval
+    */
+    int getCoefficientUpdateInterval() const noexcept   { return updateInterval; }
+
     //==============================================================================
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
@@ -96,12 +113,15 @@ public:
             return;
         }
 
-        for (size_t n = 0; n < numSamples; ++n)
+        // The coefficients are worked out for a chunk of samples at a time, and then
+        // all the channels are run through the chunk, several at once when possible.
+        for (size_t pos = 0; pos < numSamples;)
         {
-            updateSmoothers();
+            auto numThisTime = jmin (maxChunkSize, numSamples - pos);
 
-            for (size_t ch = 0; ch < numChannels; ++ch)
-                outputBlock.getChannelPointer (ch)[n] = processSample (inputBlock.getChannelPointer (ch)[n], ch);
+            fillCoefficientBuffers (numThisTime);
+            processChunk (inputBlock.getSubBlock (pos, numThisTime), outputBlock.getSubBlock (pos, numThisTime));
+            pos += numThisTime;
         }
     }
 
@@ -110,6 +130,10 @@ protected:
     Type processSample (Type inputValue, size_t channelToUse) noexcept;
     void updateSmoothers() noexcept;
 
+    template <typename ValueType>
+    ValueType JUCE_VECTOR_CALLTYPE processLadder (ValueType inputValue, ValueType* s, ValueType a1,
+                                                  ValueType b0, ValueType b1, ValueType k) const noexcept;
+
 private:
     //==============================================================================
     Type drive, drive2, gain, gain2, comp;
@@ -121,6 +145,11 @@ private:
     SmoothedValue<Type> cutoffTransformSmoother, scaledResonanceSmoother;
     Type cutoffTransformValue, scaledResonanceValue;
 
+    // the coefficients for each sample of the chunk being processed
+    static constexpr size_t maxChunkSize = 64;
+    std::array<Type, maxChunkSize> a1Buffer, b0Buffer, b1Buffer, kBuffer;
+    int updateInterval = 1, samplesUntilUpdate = 0;
+
     LookupTableTransform<Type> saturationLUT { [] (Type x) { return std::tanh (x); }, Type (-5), Type (5), 128 };
 
     Type cutoffFreqHz { Type (200) };
@@ -134,6 +163,23 @@ private:
     //==============================================================================
     void setSampleRate (Type newValue) noexcept;
     void setNumChannels (size_t newValue)   { state.resize (newValue); }
+    void fillCoefficientBuffers (size_t numSamples) noexcept;
+    void processChunk (const AudioBlock<Type>& input, AudioBlock<Type> output) noexcept;
+
+   #if JUCE_USE_SIMD
+    // Each lane of a SIMDRegister runs the ladder of one channel. The feedback makes every
+    // sample wait for the previous one, so two registers are processed side by side to
+    // hide some of that latency.
+    static constexpr size_t maxRegistersPerGroup = 2;
+    static constexpr size_t maxChannelsPerGroup = maxRegistersPerGroup * SIMDRegister<Type>::SIMDNumElements;
+
+    void processChannelGroup (const Type* const* inputs, Type* const* outputs, size_t firstChannel,
+                              size_t numChannelsInGroup, size_t numSamples) noexcept;
+
+    template <size_t numRegisters>
+    void processRegisters (const Type* const* inputs, Type* const* outputs, size_t firstChannel,
+                           size_t numChannelsInGroup, size_t numSamples) noexcept;
+   #endif
     void updateCutoffFreq() noexcept        { cutoffTransformSmoother.setTargetValue (std::exp (cutoffFreqHz * cutoffFreqScaler)); }
     void updateResonance() noexcept         { scaledResonanceSmoother.setTargetValue (jmap (resonance, Type (0.1), Type (1.0))); }
 };
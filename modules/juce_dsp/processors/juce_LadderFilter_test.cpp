@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct LadderFilterTest  : public UnitTest
+{
+    LadderFilterTest()  : UnitTest ("LadderFilter", "DSP") {}
+
+    static void fillRandom (Random& random, AudioBuffer<float>& buffer)
+    {
+        for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (auto i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, 2.0f * random.nextFloat() - 1.0f);
+    }
+
+    static void prepareFilter (LadderFilter<float>& filter, uint32 numChannels, int updateInterval)
+    {
+        filter.setMode (LadderFilter<float>::Mode::LPF24);
+        filter.setResonance (0.7f);
+        filter.setDrive (2.0f);
+        filter.setCoefficientUpdateInterval (updateInterval);
+        filter.prepare ({ 48000.0, 1024, numChannels });
+    }
+
+    /** Runs a filter through blocks of random sizes, moving its cutoff at the start of each one. */
+    static void render (LadderFilter<float>& filter, AudioBlock<float> block, int seed)
+    {
+        Random random (seed);
+
+        for (size_t position = 0; position < block.getNumSamples();)
+        {
+            auto numSamples = jmin ((size_t) (1 + random.nextInt (300)), block.getNumSamples() - position);
+            auto subBlock = block.getSubBlock (position, numSamples);
+
+            filter.setCutoffFrequencyHz (200.0f + 5000.0f * random.nextFloat());
+            filter.process (ProcessContextReplacing<float> (subBlock));
+            position += numSamples;
+        }
+    }
+
+    static float getMaximumDifference (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        auto maximum = 0.0f;
+
+        for (auto channel = 0; channel < a.getNumChannels(); ++channel)
+            for (auto i = 0; i < a.getNumSamples(); ++i)
+                maximum = jmax (maximum, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return maximum;
+    }
+
+    /** Checks that filtering several channels at once gives the same results as
+        running a separate mono filter on each of them.
+    */
+    void checkChannelsAreIndependent (int numChannels, int updateInterval)
+    {
+        const int numSamples = 4096;
+        AudioBuffer<float> input (numChannels, numSamples), output, expected;
+        auto random = getRandom();
+        fillRandom (random, input);
+        output.makeCopyOf (input);
+        expected.makeCopyOf (input);
+
+        auto seed = random.nextInt();
+
+        LadderFilter<float> filter;
+        prepareFilter (filter, (uint32) numChannels, updateInterval);
+        render (filter, AudioBlock<float> (output), seed);
+
+        AudioBlock<float> expectedBlock (expected);
+
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            LadderFilter<float> monoFilter;
+            prepareFilter (monoFilter, 1, updateInterval);
+            render (monoFilter, expectedBlock.getSingleChannelBlock ((size_t) channel), seed);
+        }
+
+        expectLessThan (getMaximumDifference (output, expected), 1.0e-6f);
+    }
+
+    /** Checks that the output doesn't depend on the sizes of the blocks, even when
+        they don't line up with the coefficient updates.
+    */
+    void checkUpdatesAreIndependentOfBlockSize (int updateInterval)
+    {
+        const int numChannels = 2, numSamples = 4096;
+
+        AudioBuffer<float> input (numChannels, numSamples), output, expected;
+        auto random = getRandom();
+        fillRandom (random, input);
+        output.makeCopyOf (input);
+        expected.makeCopyOf (input);
+
+        LadderFilter<float> filter, reference;
+        prepareFilter (filter, numChannels, updateInterval);
+        prepareFilter (reference, numChannels, updateInterval);
+        filter.setCutoffFrequencyHz (3000.0f);
+        reference.setCutoffFrequencyHz (3000.0f);
+
+        AudioBlock<float> expectedBlock (expected);
+        reference.process (ProcessContextReplacing<float> (expectedBlock));
+
+        AudioBlock<float> block (output);
+
+        for (size_t position = 0; position < block.getNumSamples();)
+        {
+            auto numThisTime = jmin ((size_t) (1 + random.nextInt (100)), block.getNumSamples() - position);
+            auto subBlock = block.getSubBlock (position, numThisTime);
+            filter.process (ProcessContextReplacing<float> (subBlock));
+            position += numThisTime;
+        }
+
+        expectEquals (getMaximumDifference (output, expected), 0.0f);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Multichannel processing");
+        {
+            for (auto numChannels : { 1, 2, 3, 4, 5, 8, 11 })
+            {
+                checkChannelsAreIndependent (numChannels, 1);
+                checkChannelsAreIndependent (numChannels, 32);
+            }
+        }
+
+        beginTest ("Coefficient update interval");
+        {
+            expectEquals (LadderFilter<float>().getCoefficientUpdateInterval(), 1);
+
+            for (auto updateInterval : { 1, 7, 64, 100 })
+                checkUpdatesAreIndependentOfBlockSize (updateInterval);
+        }
+    }
+};
+
+static LadderFilterTest ladderFilterUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -30,12 +30,18 @@ namespace dsp
 {
 
 /**
-    Generates a signal based on a user-supplied function.
+    The frequency and phase handling shared by the Oscillator and FunctorOscillator
+    classes, which only differ in the way they call their waveform function.
+
+    The waveform is evaluated once per sample, whatever the number of channels, and
+    the result is then added to each channel of the input.
+
+    @see Oscillator, FunctorOscillator
 
     @tags{DSP}
 */
 template <typename SampleType>
-class Oscillator
+class OscillatorBase
 {
 public:
     /** The NumericType is the underlying primitive type used by the SampleType (which
@@ -43,43 +49,6 @@ public:
     */
     using NumericType = typename SampleTypeHelpers::ElementType<SampleType>::Type;
 
-    /** Creates an uninitialised oscillator. Call initialise before first use. */
-    Oscillator() = default;
-
-    /** Creates an oscillator with a periodic input function (-pi..pi).
-
-        If lookup table is not zero, then the function will be approximated
-        with a lookup table.
-    */
-    Oscillator (const std::function<NumericType (NumericType)>& function,
-                size_t lookupTableNumPoints = 0)
-    {
-        initialise (function, lookupTableNumPoints);
-    }
-
-    /** Returns true if the Oscillator has been initialised. */
-    bool isInitialised() const noexcept     { return static_cast<bool> (generator); }
-
-    /** Initialises the oscillator with a waveform. */
-    void initialise (const std::function<NumericType (NumericType)>& function,
-                     size_t lookupTableNumPoints = 0)
-    {
-        if (lookupTableNumPoints != 0)
-        {
-            auto* table = new LookupTableTransform<NumericType> (function,
-                                                                 -MathConstants<NumericType>::pi,
-                                                                 MathConstants<NumericType>::pi,
-                                                                 lookupTableNumPoints);
-
-            lookupTable.reset (table);
-            generator = [table] (NumericType x) { return (*table) (x); };
-        }
-        else
-        {
-            generator = function;
-        }
-    }
-
     //==============================================================================
     /** Sets the frequency of the oscillator. */
     void setFrequency (NumericType newFrequency, bool force = false) noexcept
@@ -115,20 +84,20 @@ public:
             frequency.reset (sampleRate, 0.05);
     }
 
+protected:
     //==============================================================================
-    /** Returns the result of processing a single sample. */
-    SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType input) noexcept
+    OscillatorBase() = default;
+
+    template <typename Generator>
+    SampleType JUCE_VECTOR_CALLTYPE processSampleWith (SampleType input, Generator& generator) noexcept
     {
-        jassert (isInitialised());
         auto increment = MathConstants<NumericType>::twoPi * frequency.getNextValue() / sampleRate;
         return input + generator (phase.advance (increment) - MathConstants<NumericType>::pi);
     }
 
-    /** Processes the input and output buffers supplied in the processing context. */
-    template <typename ProcessContext>
-    void process (const ProcessContext& context) noexcept
+    template <typename ProcessContext, typename Generator>
+    void processWith (const ProcessContext& context, Generator& generator) noexcept
     {
-        jassert (isInitialised());
         auto&& outBlock = context.getOutputBlock();
         auto&& inBlock  = context.getInputBlock();
 
@@ -141,112 +110,228 @@ public:
         auto baseIncrement = MathConstants<NumericType>::twoPi / sampleRate;
 
         if (context.isBypassed)
+        {
             context.getOutputBlock().clear();
 
+            if (frequency.isSmoothing())
+            {
+                for (size_t i = 0; i < len; ++i)
+                    phase.advance (baseIncrement * frequency.getNextValue());
+            }
+            else
+            {
+                auto freq = baseIncrement * frequency.getNextValue();
+                frequency.skip (static_cast<int> (len));
+                phase.advance (freq * static_cast<NumericType> (len));
+            }
+
+            return;
+        }
+
+        auto* buffer = rampBuffer.getRawDataPointer();
+
         if (frequency.isSmoothing())
         {
-            auto* buffer = rampBuffer.getRawDataPointer();
-
             for (size_t i = 0; i < len; ++i)
-                buffer[i] = phase.advance (baseIncrement * frequency.getNextValue())
-                              - MathConstants<NumericType>::pi;
-
-            if (! context.isBypassed)
-            {
-                size_t ch;
-
-                if (context.usesSeparateInputAndOutputBlocks())
-                {
-                    for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
-                    {
-                        auto* dst = outBlock.getChannelPointer (ch);
-                        auto* src = inBlock.getChannelPointer (ch);
-
-                        for (size_t i = 0; i < len; ++i)
-                            dst[i] = src[i] + generator (buffer[i]);
-                    }
-                }
-                else
-                {
-                    for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
-                    {
-                        auto* dst = outBlock.getChannelPointer (ch);
-
-                        for (size_t i = 0; i < len; ++i)
-                            dst[i] += generator (buffer[i]);
-                    }
-                }
-
-                for (; ch < numChannels; ++ch)
-                {
-                    auto* dst = outBlock.getChannelPointer (ch);
-
-                    for (size_t i = 0; i < len; ++i)
-                        dst[i] = generator (buffer[i]);
-                }
-            }
+                buffer[i] = generator (phase.advance (baseIncrement * frequency.getNextValue())
+                                         - MathConstants<NumericType>::pi);
         }
         else
         {
             auto freq = baseIncrement * frequency.getNextValue();
             auto p = phase;
 
-            if (context.isBypassed)
+            for (size_t i = 0; i < len; ++i)
+                buffer[i] = generator (p.advance (freq) - MathConstants<NumericType>::pi);
+
+            phase = p;
+        }
+
+        size_t ch;
+
+        if (context.usesSeparateInputAndOutputBlocks())
+        {
+            for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
             {
-                frequency.skip (static_cast<int> (len));
-                p.advance (freq * static_cast<NumericType> (len));
+                auto* dst = outBlock.getChannelPointer (ch);
+                auto* src = inBlock.getChannelPointer (ch);
+
+                for (size_t i = 0; i < len; ++i)
+                    dst[i] = src[i] + buffer[i];
             }
-            else
+        }
+        else
+        {
+            for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
             {
-                size_t ch;
-
-                if (context.usesSeparateInputAndOutputBlocks())
-                {
-                    for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
-                    {
-                        p = phase;
-                        auto* dst = outBlock.getChannelPointer (ch);
-                        auto* src = inBlock.getChannelPointer (ch);
-
-                        for (size_t i = 0; i < len; ++i)
-                            dst[i] = src[i] + generator (p.advance (freq) - MathConstants<NumericType>::pi);
-                    }
-                }
-                else
-                {
-                    for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
-                    {
-                        p = phase;
-                        auto* dst = outBlock.getChannelPointer (ch);
-
-                        for (size_t i = 0; i < len; ++i)
-                            dst[i] += generator (p.advance (freq) - MathConstants<NumericType>::pi);
-                    }
-                }
-
-                for (; ch < numChannels; ++ch)
-                {
-                    p = phase;
-                    auto* dst = outBlock.getChannelPointer (ch);
-
-                    for (size_t i = 0; i < len; ++i)
-                        dst[i] = generator (p.advance (freq) - MathConstants<NumericType>::pi);
-                }
+                auto* dst = outBlock.getChannelPointer (ch);
+
+                for (size_t i = 0; i < len; ++i)
+                    dst[i] += buffer[i];
             }
+        }
 
-            phase = p;
+        for (; ch < numChannels; ++ch)
+        {
+            auto* dst = outBlock.getChannelPointer (ch);
+
+            for (size_t i = 0; i < len; ++i)
+                dst[i] = buffer[i];
         }
     }
 
 private:
     //==============================================================================
-    std::function<NumericType (NumericType)> generator;
-    std::unique_ptr<LookupTableTransform<NumericType>> lookupTable;
     Array<NumericType> rampBuffer;
     SmoothedValue<NumericType> frequency { static_cast<NumericType> (440.0) };
     NumericType sampleRate = 48000.0;
     Phase<NumericType> phase;
 };
 
+//==============================================================================
+/**
+    Generates a signal based on a user-supplied function.
+
+    The function is called through a std::function, so it can be changed at runtime.
+    If it's known at compile time, a FunctorOscillator will be faster, as the calls
+    to the function can then be inlined.
+
+    @see FunctorOscillator, WavetableOscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class Oscillator  : public OscillatorBase<SampleType>
+{
+public:
+    using NumericType = typename OscillatorBase<SampleType>::NumericType;
+
+    /** Creates an uninitialised oscillator. Call initialise before first use. */
+    Oscillator() = default;
+
+    /** Creates an oscillator with a periodic input function (-pi..pi).
+
+        If lookup table is not zero, then the function will be approximated
+        with a lookup table.
+    */
+    Oscillator (const std::function<NumericType (NumericType)>& function,
+                size_t lookupTableNumPoints = 0)
+    {
+        initialise (function, lookupTableNumPoints);
+    }
+
+    /** Returns true if the Oscillator has been initialised. */
+    bool isInitialised() const noexcept     { return static_cast<bool> (generator); }
+
+    /** Initialises the oscillator with a waveform. */
+    void initialise (const std::function<NumericType (NumericType)>& function,
+                     size_t lookupTableNumPoints = 0)
+    {
+        if (lookupTableNumPoints != 0)
+        {
+            auto* table = new LookupTableTransform<NumericType> (function,
+                                                                 -MathConstants<NumericType>::pi,
+                                                                 MathConstants<NumericType>::pi,
+                                                                 lookupTableNumPoints);
+
+            lookupTable.reset (table);
+            generator = [table] (NumericType x) { return (*table) (x); };
+        }
+        else
+        {
+            lookupTable.reset();
+            generator = function;
+        }
+    }
+
+    //==============================================================================
+    /** Returns the result of processing a single sample. */
+    SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType input) noexcept
+    {
+        jassert (isInitialised());
+
+        if (lookupTable != nullptr)
+            return this->processSampleWith (input, *lookupTable);
+
+        return this->processSampleWith (input, generator);
+    }
+
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        jassert (isInitialised());
+
+        // the lookup table is read directly, to avoid going through the std::function
+        if (lookupTable != nullptr)
+            this->processWith (context, *lookupTable);
+        else
+            this->processWith (context, generator);
+    }
+
+private:
+    //==============================================================================
+    std::function<NumericType (NumericType)> generator;
+    std::unique_ptr<LookupTableTransform<NumericType>> lookupTable;
+};
+
+//==============================================================================
+/**
+    Generates a signal based on a function which is known at compile time.
+
+    This works like the Oscillator class, but as the type of the function is a
+    template parameter, the compiler can inline it, and vectorise the processing
+    loops when the function allows it. It can be a lambda, a function object or a
+    function pointer, which must take a phase value between -pi and pi.
+
+    Use createFunctorOscillator() to create one from a lambda, e.g.
+    @code
+    auto osc = dsp::createFunctorOscillator<float> ([] (float x) { return dsp::FastMathApproximations::sin (x); });
+    @endcode
+
+    @see Oscillator, createFunctorOscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType, typename Function>
+class FunctorOscillator  : public OscillatorBase<SampleType>
+{
+public:
+    /** Creates an oscillator which will use the given function. */
+    explicit FunctorOscillator (Function function)  : generator (std::move (function)) {}
+
+    /** Returns the function used by the oscillator. */
+    Function& getFunction() noexcept                    { return generator; }
+
+    //==============================================================================
+    /** Returns the result of processing a single sample. */
+    SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType input) noexcept
+    {
+        return this->processSampleWith (input, generator);
+    }
+
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        this->processWith (context, generator);
+    }
+
+private:
+    //==============================================================================
+    Function generator;
+};
+
+/** Creates a FunctorOscillator which uses the given function, avoiding the need
+    to spell out the type of a lambda.
+
+    @see FunctorOscillator
+*/
+template <typename SampleType, typename Function>
+FunctorOscillator<SampleType, Function> createFunctorOscillator (Function function)
+{
+    return FunctorOscillator<SampleType, Function> (std::move (function));
+}
+
 } // namespace dsp
 } // namespace juce
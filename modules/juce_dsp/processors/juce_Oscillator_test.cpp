@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct OscillatorTest  : public UnitTest
+{
+    OscillatorTest()  : UnitTest ("Oscillator", "DSP") {}
+
+    template <typename OscillatorType>
+    static void renderBlocks (OscillatorType& oscillator, AudioBuffer<float>& buffer, int blockSize)
+    {
+        buffer.clear();
+        AudioBlock<float> block (buffer);
+
+        for (size_t position = 0; position < block.getNumSamples(); position += (size_t) blockSize)
+        {
+            auto subBlock = block.getSubBlock (position, jmin ((size_t) blockSize, block.getNumSamples() - position));
+            oscillator.process (ProcessContextReplacing<float> (subBlock));
+        }
+    }
+
+    static float getMaximumDifference (const AudioBuffer<float>& buffer, int channel, const std::function<double (int)>& expected)
+    {
+        auto maximum = 0.0;
+
+        for (auto i = 0; i < buffer.getNumSamples(); ++i)
+            maximum = jmax (maximum, std::abs (buffer.getSample (channel, i) - expected (i)));
+
+        return (float) maximum;
+    }
+
+    void checkFunctorOscillator()
+    {
+        const ProcessSpec spec { 44100.0, 256, 2 };
+        auto sine = [] (float x) { return std::sin (x); };
+
+        Oscillator<float> reference (sine);
+        auto oscillator = createFunctorOscillator<float> (sine);
+
+        AudioBuffer<float> expected (2, 4000), output (2, 4000);
+
+        for (auto* osc : { static_cast<OscillatorBase<float>*> (&reference), static_cast<OscillatorBase<float>*> (&oscillator) })
+        {
+            osc->prepare (spec);
+            osc->setFrequency (440.0f, true);
+            osc->setFrequency (1000.0f);
+        }
+
+        renderBlocks (reference, expected, 256);
+        renderBlocks (oscillator, output, 256);
+
+        for (auto channel = 0; channel < 2; ++channel)
+            expectEquals (getMaximumDifference (output, channel, [&] (int i) { return (double) expected.getSample (channel, i); }), 0.0f);
+
+        for (auto i = 0; i < 1000; ++i)
+            expectEquals (oscillator.processSample (0.5f), reference.processSample (0.5f));
+    }
+
+    void checkWavetableSine()
+    {
+        const double sampleRate = 48000.0, frequency = 1234.5;
+        const float amplitude = 0.8f;
+
+        WavetableOscillator<float> oscillator;
+        oscillator.initialise (&amplitude, nullptr, 1);
+        expectEquals ((int) oscillator.getNumTables(), 1);
+
+        oscillator.prepare ({ sampleRate, 512, 3 });
+        oscillator.setFrequency ((float) frequency, true);
+
+        AudioBuffer<float> output (3, 24000);
+        renderBlocks (oscillator, output, 500);
+
+        for (auto channel = 0; channel < 3; ++channel)
+            expectLessThan (getMaximumDifference (output, channel, [&] (int i)
+                                                  {
+                                                      return amplitude * std::sin (MathConstants<double>::twoPi * frequency * i / sampleRate);
+                                                  }), 1.0e-3f);
+
+        // single samples must follow the same waveform
+        oscillator.reset();
+        auto maximumDifference = 0.0;
+
+        for (auto i = 0; i < 1000; ++i)
+            maximumDifference = jmax (maximumDifference, std::abs (oscillator.processSample (0.0f) - (double) output.getSample (0, i)));
+
+        expectLessThan (maximumDifference, 1.0e-4);
+    }
+
+    void checkWavetableBandLimiting()
+    {
+        const double sampleRate = 48000.0;
+
+        WavetableOscillator<float> oscillator;
+        oscillator.initialise ([] (float x) { return x / MathConstants<float>::pi; }, 2048);
+        oscillator.prepare ({ sampleRate, 512, 1 });
+
+        expectEquals ((int) oscillator.getTableSize(), 2048);
+        expectEquals ((int) oscillator.getNumHarmonics (0), 1023);
+
+        for (auto frequency = 20.0f; frequency < 20000.0f; frequency *= 1.1f)
+        {
+            auto index = oscillator.getTableIndexForFrequency (frequency);
+            expect (oscillator.getNumHarmonics (index) * frequency < sampleRate * 0.5);
+
+            // the table is the richest one that doesn't alias
+            if (index > 0)
+                expect (oscillator.getNumHarmonics (index - 1) * frequency >= sampleRate * 0.5);
+        }
+
+        // at 5 kHz, only the first 3 harmonics of the sawtooth can be played
+        const double frequency = 5000.0;
+        oscillator.setFrequency ((float) frequency, true);
+
+        AudioBuffer<float> output (1, 4800);
+        renderBlocks (oscillator, output, 512);
+
+        expectLessThan (getMaximumDifference (output, 0, [&] (int i)
+                                              {
+                                                  auto sum = 0.0;
+
+                                                  for (auto h = 1; h <= 3; ++h)
+                                                      sum += std::sin (h * MathConstants<double>::twoPi * frequency * i / sampleRate) / h;
+
+                                                  return -2.0 * sum / MathConstants<double>::pi;
+                                              }), 1.0e-2f);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Functor oscillator");
+        checkFunctorOscillator();
+
+        beginTest ("Wavetable oscillator");
+        checkWavetableSine();
+
+        beginTest ("Wavetable band-limiting");
+        checkWavetableBandLimiting();
+    }
+};
+
+static OscillatorTest oscillatorUnitTest;
+
+} // namespace dsp
+} // namespace juce
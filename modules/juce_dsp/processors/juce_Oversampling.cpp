@@ -104,16 +104,114 @@ struct OversamplingDummy   : public Oversampling<SampleType>::OversamplingStage
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingDummy)
 };
 
+//===============================================================================
+/** Helper functions used by the oversampling stages to process several channels
+    at once, by interleaving groups of channels into SIMD registers. Each lane of
+    a register holds one channel, so the filters need nothing but plain vector
+    additions and multiplications, and the lanes which aren't used by a group
+    just process zeros.
+*/
+template <typename SampleType>
+struct OversamplingChannelGroups
+{
+   #if JUCE_USE_SIMD
+    using Vec = SIMDRegister<SampleType>;
+   #else
+    using Vec = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Vec) / sizeof (SampleType);
+
+    static size_t getNumGroups (size_t numChannels) noexcept
+    {
+        return (numChannels + numLanes - 1) / numLanes;
+    }
+
+    static size_t getNumChannelsInGroup (size_t numChannels, size_t firstChannel) noexcept
+    {
+        auto numLeft = numChannels - firstChannel;
+        return numLeft < numLanes ? numLeft : numLanes;
+    }
+
+    /** Interleaves the samples of the channels at firstChannel and above into dest,
+        setting the lanes for which there's no channel to zero.
+    */
+    static void pack (const dsp::AudioBlock<SampleType>& block, size_t firstChannel,
+                      size_t numSamples, Vec* dest) noexcept
+    {
+        auto numChannelsInGroup = getNumChannelsInGroup (block.getNumChannels(), firstChannel);
+        auto* d = reinterpret_cast<SampleType*> (dest);
+
+        if (numChannelsInGroup < numLanes)
+            zeromem (dest, sizeof (Vec) * numSamples);
+
+        for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+        {
+            auto* src = block.getChannelPointer (firstChannel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                d[i * numLanes + lane] = src[i];
+        }
+    }
+
+    /** Copies the lanes of src back into the channels at firstChannel and above. */
+    static void unpack (const Vec* src, size_t numSamples,
+                        dsp::AudioBlock<SampleType>& block, size_t firstChannel) noexcept
+    {
+        auto numChannelsInGroup = getNumChannelsInGroup (block.getNumChannels(), firstChannel);
+        auto* s = reinterpret_cast<const SampleType*> (src);
+
+        for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+        {
+            auto* dest = block.getChannelPointer (firstChannel + lane);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dest[i] = s[i * numLanes + lane];
+        }
+    }
+
+    /** An array of registers which is suitably aligned for SIMD instructions. */
+    struct Buffer
+    {
+        void allocate (size_t newSize)
+        {
+            memory.calloc (sizeof (Vec) * (newSize + 1));
+            data = snapPointerToAlignment (reinterpret_cast<Vec*> (memory.get()), sizeof (Vec));
+            size = newSize;
+        }
+
+        void clear() noexcept                       { zeromem (data, sizeof (Vec) * size); }
+
+        void snapToZero() noexcept
+        {
+            auto* samples = reinterpret_cast<SampleType*> (data);
+
+            for (size_t i = 0; i < size * numLanes; ++i)
+                util::snapToZero (samples[i]);
+        }
+
+        Vec* data = nullptr;
+        size_t size = 0;
+        HeapBlock<char> memory;
+    };
+};
+
 //===============================================================================
 /** Oversampling stage class performing 2 times oversampling using the Filter
     Design FIR Equiripple method. The resulting filter is linear phase,
     symmetric, and has every two samples but the middle one equal to zero,
     leading to specific processing optimizations.
+
+    The even taps are applied to a history of the even samples which is written
+    twice in a circular buffer, so that it can always be read in one go without
+    shifting the whole state for every sample.
 */
 template <typename SampleType>
 struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::OversamplingStage
 {
     using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups = OversamplingChannelGroups<SampleType>;
+    using Vec = typename Groups::Vec;
 
     Oversampling2TimesEquirippleFIR (size_t numChans,
                                      SampleType normalisedTransitionWidthUp,
@@ -125,17 +223,23 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         coefficientsUp   = *dsp::FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
         coefficientsDown = *dsp::FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
 
+        auto numGroups = Groups::getNumGroups (this->numChannels);
+
         auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (this->numChannels), static_cast<int> (N));
+        historySizeUp = (N + 1) / 2;
+        prepareTaps (coefficientsUp, tapsUp);
+        stateUp.allocate (numGroups * historySizeUp * 2);
 
         N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
-
-        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (N));
-        stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
-
-        position.resize (static_cast<int> (this->numChannels));
+        auto Ndiv4 = (N / 2) / 2;
+        historySizeDown = (N + 1) / 2;
+        prepareTaps (coefficientsDown, tapsDown);
+        stateDown.allocate (numGroups * historySizeDown * 2);
+        stateDown2.allocate (numGroups * (Ndiv4 + 1));
+
+        positionUp.resize (static_cast<int> (numGroups));
+        positionDown.resize (static_cast<int> (numGroups));
+        positionDown2.resize (static_cast<int> (numGroups));
     }
 
     //===============================================================================
@@ -144,6 +248,12 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
     }
 
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+        scratch.allocate (maximumNumberOfSamplesBeforeOversampling * (ParentType::factor + 1));
+    }
+
     void reset() override
     {
         ParentType::reset();
@@ -152,7 +262,9 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         stateDown.clear();
         stateDown2.clear();
 
-        position.fill (0);
+        positionUp.fill (0);
+        positionDown.fill (0);
+        positionDown2.fill (0);
     }
 
     void processSamplesUp (dsp::AudioBlock<SampleType>& inputBlock) override
@@ -161,37 +273,48 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
         // Initialization
-        auto fir = coefficientsUp.getRawCoefficients();
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
+        auto taps = tapsUp.data;
+        auto H = historySizeUp;
+        auto numTaps = tapsUp.size - 1;
+        auto middle = H / 2;
         auto numSamples = inputBlock.getNumSamples();
+        auto numBlockChannels = inputBlock.getNumChannels();
+
+        auto* samples = scratch.data;
+        auto* bufferSamples = scratch.data + numSamples;
+        auto outputBlock = dsp::AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numBlockChannels);
 
         // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group * Groups::numLanes < numBlockChannels; ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            Groups::pack (inputBlock, group * Groups::numLanes, numSamples, samples);
+
+            auto buf = stateUp.data + group * H * 2;
+            auto pos = positionUp.getUnchecked (static_cast<int> (group));
+            const Vec two (static_cast<SampleType> (2));
 
             for (size_t i = 0; i < numSamples; ++i)
             {
                 // Input
-                buf[N - 1] = 2 * samples[i];
+                buf[pos] = buf[pos + H] = samples[i] * two;
 
                 // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                auto* history = buf + pos + 1;
+                Vec out {};
 
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                for (size_t k = 0; k < numTaps; ++k)
+                    out += (history[k] + history[H - k - 1]) * taps[k];
 
                 // Outputs
                 bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
+                bufferSamples[(i << 1) + 1] = history[middle] * taps[numTaps];
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+                // Circular buffer
+                pos = (pos == H - 1 ? 0 : pos + 1);
             }
+
+            positionUp.setUnchecked (static_cast<int> (group), pos);
+            Groups::unpack (bufferSamples, numSamples * 2, outputBlock, group * Groups::numLanes);
         }
     }
 
@@ -201,56 +324,81 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
 
         // Initialization
-        auto fir = coefficientsDown.getRawCoefficients();
+        auto taps = tapsDown.data;
+        auto H = historySizeDown;
+        auto numTaps = tapsDown.size - 1;
         auto N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
+        auto Ndiv4 = (N / 2) / 2;
         auto numSamples = outputBlock.getNumSamples();
+        auto numBlockChannels = outputBlock.getNumChannels();
+
+        auto* bufferSamples = scratch.data;
+        auto* samples = scratch.data + numSamples * 2;
+        auto inputBlock = dsp::AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numBlockChannels);
 
         // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group * Groups::numLanes < numBlockChannels; ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
-            auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto pos = position.getUnchecked (static_cast<int> (channel));
+            Groups::pack (inputBlock, group * Groups::numLanes, numSamples * 2, bufferSamples);
+
+            auto buf = stateDown.data + group * H * 2;
+            auto buf2 = stateDown2.data + group * (Ndiv4 + 1);
+            auto pos = positionDown.getUnchecked (static_cast<int> (group));
+            auto pos2 = positionDown2.getUnchecked (static_cast<int> (group));
 
             for (size_t i = 0; i < numSamples; ++i)
             {
                 // Input
-                buf[N - 1] = bufferSamples[i << 1];
+                buf[pos] = buf[pos + H] = bufferSamples[i << 1];
 
                 // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                auto* history = buf + pos + 1;
+                Vec out {};
 
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                for (size_t k = 0; k < numTaps; ++k)
+                    out += (history[k] + history[H - k - 1]) * taps[k];
 
                 // Output
-                out += buf2[pos] * fir[Ndiv2];
-                buf2[pos] = bufferSamples[(i << 1) + 1];
+                out += buf2[pos2] * taps[numTaps];
+                buf2[pos2] = bufferSamples[(i << 1) + 1];
 
                 samples[i] = out;
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; ++k)
-                    buf[k] = buf[k + 2];
-
-                // Circular buffer
-                pos = (pos == 0 ? Ndiv4 : pos - 1);
+                // Circular buffers
+                pos = (pos == H - 1 ? 0 : pos + 1);
+                pos2 = (pos2 == 0 ? Ndiv4 : pos2 - 1);
             }
 
-            position.setUnchecked (static_cast<int> (channel), pos);
+            positionDown.setUnchecked (static_cast<int> (group), pos);
+            positionDown2.setUnchecked (static_cast<int> (group), pos2);
+            Groups::unpack (samples, numSamples, outputBlock, group * Groups::numLanes);
         }
-
     }
 
 private:
+    //===============================================================================
+    /** Copies the non-zero taps of the first half of the filter into registers, the
+        last register holding the middle tap.
+    */
+    static void prepareTaps (dsp::FIR::Coefficients<SampleType>& coefficients, typename Groups::Buffer& taps)
+    {
+        auto fir = coefficients.getRawCoefficients();
+        auto Ndiv2 = (coefficients.getFilterOrder() + 1) / 2;
+        auto numTaps = (Ndiv2 + 1) / 2;
+
+        taps.allocate (numTaps + 1);
+
+        for (size_t k = 0; k < numTaps; ++k)
+            taps.data[k] = fir[k * 2];
+
+        taps.data[numTaps] = fir[Ndiv2];
+    }
+
     //===============================================================================
     dsp::FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
-    AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
-    Array<size_t> position;
+    typename Groups::Buffer tapsUp, tapsDown, stateUp, stateDown, stateDown2, scratch;
+    size_t historySizeUp = 0, historySizeDown = 0;
+    Array<size_t> positionUp, positionDown, positionDown2;
 
     //===============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
@@ -266,6 +414,8 @@ template <typename SampleType>
 struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::OversamplingStage
 {
     using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups = OversamplingChannelGroups<SampleType>;
+    using Vec = typename Groups::Vec;
 
     Oversampling2TimesPolyphaseIIR (size_t numChans,
                                     SampleType normalisedTransitionWidthUp,
@@ -294,9 +444,11 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         for (auto i = 1; i < structureDown.delayedPath.size(); ++i)
             coefficientsDown.add (structureDown.delayedPath.getObjectPointer (i)->coefficients[0]);
 
-        v1Up.setSize   (static_cast<int> (this->numChannels), coefficientsUp.size());
-        v1Down.setSize (static_cast<int> (this->numChannels), coefficientsDown.size());
-        delayDown.resize (static_cast<int> (this->numChannels));
+        auto numGroups = Groups::getNumGroups (this->numChannels);
+
+        v1Up.allocate   (numGroups * static_cast<size_t> (coefficientsUp.size()));
+        v1Down.allocate (numGroups * static_cast<size_t> (coefficientsDown.size()));
+        delayDown.allocate (numGroups);
     }
 
     //===============================================================================
@@ -305,12 +457,18 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         return latency;
     }
 
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+        scratch.allocate (maximumNumberOfSamplesBeforeOversampling * (ParentType::factor + 1));
+    }
+
     void reset() override
     {
         ParentType::reset();
         v1Up.clear();
         v1Down.clear();
-        delayDown.fill (0);
+        delayDown.clear();
     }
 
     void processSamplesUp (dsp::AudioBlock<SampleType>& inputBlock) override
@@ -324,13 +482,18 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         auto delayedStages = numStages / 2;
         auto directStages = numStages - delayedStages;
         auto numSamples = inputBlock.getNumSamples();
+        auto numBlockChannels = inputBlock.getNumChannels();
+
+        auto* samples = scratch.data;
+        auto* bufferSamples = scratch.data + numSamples;
+        auto outputBlock = dsp::AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numBlockChannels);
 
         // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group * Groups::numLanes < numBlockChannels; ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Up.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            Groups::pack (inputBlock, group * Groups::numLanes, numSamples, samples);
+
+            auto lv1 = v1Up.data + group * static_cast<size_t> (numStages);
 
             for (size_t i = 0; i < numSamples; ++i)
             {
@@ -339,7 +502,7 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
 
                 for (auto n = 0; n < directStages; ++n)
                 {
-                    auto alpha = coeffs[n];
+                    const Vec alpha (coeffs[n]);
                     auto output = alpha * input + lv1[n];
                     lv1[n] = input - alpha * output;
                     input = output;
@@ -353,7 +516,7 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
 
                 for (auto n = directStages; n < numStages; ++n)
                 {
-                    auto alpha = coeffs[n];
+                    const Vec alpha (coeffs[n]);
                     auto output = alpha * input + lv1[n];
                     lv1[n] = input - alpha * output;
                     input = output;
@@ -362,10 +525,12 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
                 // Output
                 bufferSamples[(i << 1) + 1] = input;
             }
+
+            Groups::unpack (bufferSamples, numSamples * 2, outputBlock, group * Groups::numLanes);
         }
 
         // Snap To Zero
-        snapToZero (true);
+        v1Up.snapToZero();
     }
 
     void processSamplesDown (dsp::AudioBlock<SampleType>& outputBlock) override
@@ -379,14 +544,20 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         auto delayedStages = numStages / 2;
         auto directStages = numStages - delayedStages;
         auto numSamples = outputBlock.getNumSamples();
+        auto numBlockChannels = outputBlock.getNumChannels();
+
+        auto* bufferSamples = scratch.data;
+        auto* samples = scratch.data + numSamples * 2;
+        auto inputBlock = dsp::AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numBlockChannels);
+        const Vec half (static_cast<SampleType> (0.5));
 
         // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group * Groups::numLanes < numBlockChannels; ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Down.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto delay = delayDown.getUnchecked (static_cast<int> (channel));
+            Groups::pack (inputBlock, group * Groups::numLanes, numSamples * 2, bufferSamples);
+
+            auto lv1 = v1Down.data + group * static_cast<size_t> (numStages);
+            auto delay = delayDown.data[group];
 
             for (size_t i = 0; i < numSamples; ++i)
             {
@@ -395,7 +566,7 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
 
                 for (auto n = 0; n < directStages; ++n)
                 {
-                    auto alpha = coeffs[n];
+                    const Vec alpha (coeffs[n]);
                     auto output = alpha * input + lv1[n];
                     lv1[n] = input - alpha * output;
                     input = output;
@@ -408,48 +579,23 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
 
                 for (auto n = directStages; n < numStages; ++n)
                 {
-                    auto alpha = coeffs[n];
+                    const Vec alpha (coeffs[n]);
                     auto output = alpha * input + lv1[n];
                     lv1[n] = input - alpha * output;
                     input = output;
                 }
 
                 // Output
-                samples[i] = (delay + directOut) * static_cast<SampleType> (0.5);
+                samples[i] = (delay + directOut) * half;
                 delay = input;
             }
 
-            delayDown.setUnchecked (static_cast<int> (channel), delay);
+            delayDown.data[group] = delay;
+            Groups::unpack (samples, numSamples, outputBlock, group * Groups::numLanes);
         }
 
         // Snap To Zero
-        snapToZero (false);
-    }
-
-    void snapToZero (bool snapUpProcessing)
-    {
-        if (snapUpProcessing)
-        {
-            for (auto channel = 0; channel < ParentType::buffer.getNumChannels(); ++channel)
-            {
-                auto lv1 = v1Up.getWritePointer (channel);
-                auto numStages = coefficientsUp.size();
-
-                for (auto n = 0; n < numStages; ++n)
-                    util::snapToZero (lv1[n]);
-            }
-        }
-        else
-        {
-            for (auto channel = 0; channel < ParentType::buffer.getNumChannels(); ++channel)
-            {
-                auto lv1 = v1Down.getWritePointer (channel);
-                auto numStages = coefficientsDown.size();
-
-                for (auto n = 0; n < numStages; ++n)
-                    util::snapToZero (lv1[n]);
-            }
-        }
+        v1Down.snapToZero();
     }
 
 private:
@@ -519,13 +665,212 @@ private:
     Array<SampleType> coefficientsUp, coefficientsDown;
     SampleType latency;
 
-    AudioBuffer<SampleType> v1Up, v1Down;
-    Array<SampleType> delayDown;
+    typename Groups::Buffer v1Up, v1Down, delayDown, scratch;
 
     //===============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesPolyphaseIIR)
 };
 
+//===============================================================================
+/** Oversampling stage class performing a power of two times oversampling in one
+    go, using a linear phase FIR filter designed with the Kaiser window method.
+
+    The upsampling filter is split into one polyphase component per output sample,
+    so that the zeros of the upsampled signal are never multiplied, and the
+    downsampling filter is only evaluated for the output samples that are kept.
+*/
+template <typename SampleType>
+struct OversamplingPolyphaseFIR  : public Oversampling<SampleType>::OversamplingStage
+{
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups = OversamplingChannelGroups<SampleType>;
+    using Vec = typename Groups::Vec;
+
+    OversamplingPolyphaseFIR (size_t numChans, size_t newFactor,
+                              SampleType normalisedTransitionWidthUp,
+                              SampleType stopbandAmplitudedBUp,
+                              SampleType normalisedTransitionWidthDown,
+                              SampleType stopbandAmplitudedBDown)
+        : ParentType (numChans, newFactor)
+    {
+        jassert (isPowerOfTwo (newFactor) && newFactor >= 2);
+
+        auto cutoff = static_cast<SampleType> (0.5 / static_cast<double> (newFactor));
+
+        coefficientsUp   = *dsp::FilterDesign<SampleType>::designFIRLowpassKaiserMethod (cutoff, 1.0, normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
+        coefficientsDown = *dsp::FilterDesign<SampleType>::designFIRLowpassKaiserMethod (cutoff, 1.0, normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+
+        auto numGroups = Groups::getNumGroups (this->numChannels);
+        auto fir = coefficientsUp.getRawCoefficients();
+        auto N = coefficientsUp.getFilterOrder() + 1;
+
+        // Each row holds the taps of one output phase in reverse order, scaled to
+        // make up for the energy lost by the zeros inserted between the samples
+        historySizeUp = (N + newFactor - 1) / newFactor;
+        tapsUp.allocate (historySizeUp * newFactor);
+        stateUp.allocate (numGroups * historySizeUp * 2);
+
+        for (size_t phase = 0; phase < newFactor; ++phase)
+        {
+            for (size_t k = 0; k < historySizeUp; ++k)
+            {
+                auto index = (historySizeUp - 1 - k) * newFactor + phase;
+
+                tapsUp.data[phase * historySizeUp + k] = index < N ? fir[index] * static_cast<SampleType> (newFactor)
+                                                                   : static_cast<SampleType> (0);
+            }
+        }
+
+        fir = coefficientsDown.getRawCoefficients();
+        historySizeDown = coefficientsDown.getFilterOrder() + 1;
+        tapsDown.allocate (historySizeDown);
+        stateDown.allocate (numGroups * historySizeDown * 2);
+
+        for (size_t k = 0; k < historySizeDown; ++k)
+            tapsDown.data[k] = fir[historySizeDown - 1 - k];
+
+        positionUp.resize (static_cast<int> (numGroups));
+        positionDown.resize (static_cast<int> (numGroups));
+    }
+
+    //===============================================================================
+    SampleType getLatencyInSamples() override
+    {
+        return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
+    }
+
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+        scratch.allocate (maximumNumberOfSamplesBeforeOversampling * (ParentType::factor + 1));
+    }
+
+    void reset() override
+    {
+        ParentType::reset();
+
+        stateUp.clear();
+        stateDown.clear();
+
+        positionUp.fill (0);
+        positionDown.fill (0);
+    }
+
+    void processSamplesUp (dsp::AudioBlock<SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        // Initialization
+        auto L = ParentType::factor;
+        auto H = historySizeUp;
+        auto numSamples = inputBlock.getNumSamples();
+        auto numBlockChannels = inputBlock.getNumChannels();
+
+        auto* samples = scratch.data;
+        auto* bufferSamples = scratch.data + numSamples;
+        auto outputBlock = dsp::AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numBlockChannels);
+
+        // Processing
+        for (size_t group = 0; group * Groups::numLanes < numBlockChannels; ++group)
+        {
+            Groups::pack (inputBlock, group * Groups::numLanes, numSamples, samples);
+
+            auto buf = stateUp.data + group * H * 2;
+            auto pos = positionUp.getUnchecked (static_cast<int> (group));
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                // Input
+                buf[pos] = buf[pos + H] = samples[i];
+
+                // Convolution, one phase per output sample
+                auto* history = buf + pos + 1;
+                auto* out = bufferSamples + i * L;
+
+                for (size_t phase = 0; phase < L; ++phase)
+                {
+                    auto* taps = tapsUp.data + phase * H;
+                    Vec sum {};
+
+                    for (size_t k = 0; k < H; ++k)
+                        sum += history[k] * taps[k];
+
+                    out[phase] = sum;
+                }
+
+                // Circular buffer
+                pos = (pos == H - 1 ? 0 : pos + 1);
+            }
+
+            positionUp.setUnchecked (static_cast<int> (group), pos);
+            Groups::unpack (bufferSamples, numSamples * L, outputBlock, group * Groups::numLanes);
+        }
+    }
+
+    void processSamplesDown (dsp::AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        // Initialization
+        auto L = ParentType::factor;
+        auto N = historySizeDown;
+        auto taps = tapsDown.data;
+        auto numSamples = outputBlock.getNumSamples();
+        auto numBlockChannels = outputBlock.getNumChannels();
+
+        auto* bufferSamples = scratch.data;
+        auto* samples = scratch.data + numSamples * L;
+        auto inputBlock = dsp::AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numBlockChannels);
+
+        // Processing
+        for (size_t group = 0; group * Groups::numLanes < numBlockChannels; ++group)
+        {
+            Groups::pack (inputBlock, group * Groups::numLanes, numSamples * L, bufferSamples);
+
+            auto buf = stateDown.data + group * N * 2;
+            auto pos = positionDown.getUnchecked (static_cast<int> (group));
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                auto* in = bufferSamples + i * L;
+
+                // Only the first sample of each group of L is kept
+                buf[pos] = buf[pos + N] = in[0];
+
+                auto* history = buf + pos + 1;
+                Vec sum {};
+
+                for (size_t k = 0; k < N; ++k)
+                    sum += history[k] * taps[k];
+
+                samples[i] = sum;
+                pos = (pos == N - 1 ? 0 : pos + 1);
+
+                for (size_t j = 1; j < L; ++j)
+                {
+                    buf[pos] = buf[pos + N] = in[j];
+                    pos = (pos == N - 1 ? 0 : pos + 1);
+                }
+            }
+
+            positionDown.setUnchecked (static_cast<int> (group), pos);
+            Groups::unpack (samples, numSamples, outputBlock, group * Groups::numLanes);
+        }
+    }
+
+private:
+    //===============================================================================
+    dsp::FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
+    typename Groups::Buffer tapsUp, tapsDown, stateUp, stateDown, scratch;
+    size_t historySizeUp = 0, historySizeDown = 0;
+    Array<size_t> positionUp, positionDown;
+
+    //===============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingPolyphaseFIR)
+};
+
 
 //===============================================================================
 template <typename SampleType>
@@ -539,7 +884,8 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels)
 
 template <typename SampleType>
 Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
-                                        FilterType newType, bool isMaximumQuality)
+                                        FilterType newType, bool isMaximumQuality,
+                                        bool useHighRatioStage)
     : numChannels (newNumChannels)
 {
     jassert (isPositiveAndBelow (newFactor, 5) && numChannels > 0);
@@ -548,6 +894,21 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
     {
         addDummyOversamplingStage();
     }
+    else if (useHighRatioStage && newFactor > 1)
+    {
+        // The first stage removes everything above the original Nyquist frequency,
+        // so the images that the second one has to filter out are far away from the
+        // passband, allowing a very wide transition band
+        addOversamplingStage (newType,
+                              isMaximumQuality ? 0.05f : 0.06f,  isMaximumQuality ? -90.0f : -70.0f,
+                              isMaximumQuality ? 0.06f : 0.075f, isMaximumQuality ? -75.0f : -60.0f);
+
+        auto remainingFactor = static_cast<size_t> (1) << (newFactor - 1);
+
+        addPolyphaseFIROversamplingStage (remainingFactor,
+                                          0.5f / static_cast<float> (remainingFactor), isMaximumQuality ? -90.0f : -70.0f,
+                                          0.4f / static_cast<float> (remainingFactor), isMaximumQuality ? -75.0f : -60.0f);
+    }
     else if (newType == FilterType::filterHalfBandPolyphaseIIR)
     {
         for (size_t n = 0; n < newFactor; ++n)
@@ -620,6 +981,22 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
     factorOversampling *= 2;
 }
 
+template <typename SampleType>
+void Oversampling<SampleType>::addPolyphaseFIROversamplingStage (size_t factor,
+                                                                 float normalisedTransitionWidthUp,
+                                                                 float stopbandAmplitudedBUp,
+                                                                 float normalisedTransitionWidthDown,
+                                                                 float stopbandAmplitudedBDown)
+{
+    jassert (isPowerOfTwo (factor) && factor >= 2);
+
+    stages.add (new OversamplingPolyphaseFIR<SampleType> (numChannels, factor,
+                                                          normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                          normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+
+    factorOversampling *= factor;
+}
+
 template <typename SampleType>
 void Oversampling<SampleType>::clearOversamplingStages()
 {
@@ -38,6 +38,12 @@ namespace dsp
     filters for the filtering, and reports successfully the latency added by the
     filter stages.
 
+    Each stage filters several channels at once, packing them into the lanes of
+    a SIMDRegister, so processing several channels costs little more than a single
+    one. The higher oversampling factors can also be made cheaper by replacing the
+    cascade of 2 times stages after the first one with a single polyphase FIR
+    stage.
+
     The principle of oversampling is to increase the sample rate of a given
     non-linear process, to prevent it from creating aliasing. Oversampling works
     by upsampling N times the input signal, processing the upsampled signal
@@ -77,11 +83,20 @@ public:
         @param isMaxQuality     if the oversampling is done using the maximum quality,
                                 the filters will be more efficient, but the CPU load will
                                 increase as well
+        @param useHighRatioStage if true and the factor is greater than 1, the first 2 times
+                                stage is followed by a single polyphase FIR stage which does
+                                the rest of the oversampling, rather than by a cascade of
+                                2 times stages. This needs less CPU for 8 and 16 times
+                                oversampling, and the filtering of the second stage is
+                                linear phase whatever type has been chosen
+
+        @see addPolyphaseFIROversamplingStage
     */
     Oversampling (size_t numChannels,
                   size_t factor,
                   FilterType type,
-                  bool isMaxQuality = true);
+                  bool isMaxQuality = true,
+                  bool useHighRatioStage = false);
 
     /** The default constructor of the oversampling class, which can be used to create an
         empty object and then add the appropriate stages.
@@ -163,6 +178,37 @@ public:
                                float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
                                float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
 
+    /** Adds a new oversampling stage to the Oversampling class, multiplying the
+        current oversampling factor by the given power of two in a single step.
+
+        The stage uses linear phase FIR filters designed with the Kaiser window method,
+        in a polyphase structure which only computes the samples that are needed. Going
+        through one stage rather than several 2 times ones avoids processing the
+        intermediate sample rates, and when it follows a 2 times stage which has already
+        removed everything above the original Nyquist frequency, its filters can have a
+        very wide transition band.
+
+        @param factor                          the oversampling factor of the stage, which
+                                               must be a power of two
+        @param normalisedTransitionWidthUp     a value between 0 and 0.5 which specifies the width
+                                               of the transition band for upsampling filtering,
+                                               relative to the oversampled sample rate. The
+                                               transition band is centred on the Nyquist frequency
+                                               of the sample rate before this stage
+        @param stopbandAmplitudedBUp           the amplitude in dB in the stopband for upsampling
+                                               filtering, between -100 and 0
+        @param normalisedTransitionWidthDown   a value between 0 and 0.5 which specifies the width
+                                               of the transition band for downsampling filtering,
+                                               relative to the oversampled sample rate
+        @param stopbandAmplitudedBDown         the amplitude in dB in the stopband for downsampling
+                                               filtering, between -100 and 0
+
+        @see addOversamplingStage, clearOversamplingStages
+    */
+    void addPolyphaseFIROversamplingStage (size_t factor,
+                                           float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
+                                           float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
+
     /** Adds a new "dummy" oversampling stage, which does nothing to the signal. Using
         one can be useful if your application features a customisable oversampling factor
         and if you want to select the current one from an OwnedArray without changing
@@ -0,0 +1,297 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct OversamplingTest  : public UnitTest
+{
+    OversamplingTest()  : UnitTest ("Oversampling", "DSP") {}
+
+    template <typename SampleType>
+    static void fillRandom (Random& random, AudioBuffer<SampleType>& buffer)
+    {
+        for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (auto i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, static_cast<SampleType> ((2.0f * random.nextFloat()) - 1.0f));
+    }
+
+    /** Inserts (factor - 1) zeros between the samples, and filters the result. */
+    template <typename SampleType>
+    static void referenceUpsampling (const SampleType* x, int numSamples, const FIR::Coefficients<SampleType>& h,
+                                     int factor, SampleType* y)
+    {
+        auto* fir = h.getRawCoefficients();
+        auto N = static_cast<int> (h.getFilterOrder()) + 1;
+
+        for (auto n = 0; n < numSamples * factor; ++n)
+        {
+            double sum = 0;
+
+            for (auto k = n % factor; k < N && k <= n; k += factor)
+                sum += (double) fir[k] * (double) x[(n - k) / factor];
+
+            y[n] = static_cast<SampleType> (sum * factor);
+        }
+    }
+
+    /** Filters the signal, and keeps one sample out of factor. */
+    template <typename SampleType>
+    static void referenceDownsampling (const SampleType* x, int numOutputSamples, const FIR::Coefficients<SampleType>& h,
+                                       int factor, SampleType* y)
+    {
+        auto* fir = h.getRawCoefficients();
+        auto N = static_cast<int> (h.getFilterOrder()) + 1;
+
+        for (auto i = 0; i < numOutputSamples; ++i)
+        {
+            double sum = 0;
+
+            for (auto k = 0; k < N && k <= i * factor; ++k)
+                sum += (double) fir[k] * (double) x[i * factor - k];
+
+            y[i] = static_cast<SampleType> (sum);
+        }
+    }
+
+    template <typename SampleType>
+    static double getMaximumDifference (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b)
+    {
+        double maximum = 0;
+
+        for (auto channel = 0; channel < a.getNumChannels(); ++channel)
+            for (auto i = 0; i < a.getNumSamples(); ++i)
+                maximum = jmax (maximum, (double) std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return maximum;
+    }
+
+    /** Runs both directions of an oversampling object with irregular block sizes. If
+        processed isn't null, it replaces the oversampled signal before downsampling.
+    */
+    template <typename SampleType>
+    static void render (Oversampling<SampleType>& oversampling, const AudioBuffer<SampleType>& input,
+                        AudioBuffer<SampleType>& upsampled, AudioBuffer<SampleType>& output,
+                        int maximumBlockSize, Random& random, const AudioBuffer<SampleType>* processed = nullptr)
+    {
+        auto factor = static_cast<int> (oversampling.getOversamplingFactor());
+        auto numChannels = input.getNumChannels();
+
+        upsampled.setSize (numChannels, input.getNumSamples() * factor);
+        output.setSize (numChannels, input.getNumSamples());
+
+        oversampling.initProcessing (static_cast<size_t> (maximumBlockSize));
+
+        for (auto position = 0; position < input.getNumSamples();)
+        {
+            auto numSamples = jmin (1 + random.nextInt (maximumBlockSize), input.getNumSamples() - position);
+
+            AudioBlock<SampleType> inputBlock (const_cast<SampleType* const*> (input.getArrayOfReadPointers()),
+                                               (size_t) numChannels, (size_t) position, (size_t) numSamples);
+            auto block = oversampling.processSamplesUp (inputBlock);
+
+            for (auto channel = 0; channel < numChannels; ++channel)
+            {
+                upsampled.copyFrom (channel, position * factor, block.getChannelPointer ((size_t) channel), numSamples * factor);
+
+                if (processed != nullptr)
+                    FloatVectorOperations::copy (block.getChannelPointer ((size_t) channel),
+                                                 processed->getReadPointer (channel, position * factor), numSamples * factor);
+            }
+
+            auto outputBlock = AudioBlock<SampleType> (output).getSubBlock ((size_t) position, (size_t) numSamples);
+            oversampling.processSamplesDown (outputBlock);
+
+            position += numSamples;
+        }
+    }
+
+    /** Checks a single FIR stage against the direct form of its filters. */
+    template <typename SampleType>
+    void checkFIRStage (Oversampling<SampleType>& oversampling, const FIR::Coefficients<SampleType>& coefficientsUp,
+                        const FIR::Coefficients<SampleType>& coefficientsDown, int numChannels, double tolerance)
+    {
+        auto random = getRandom();
+        auto factor = static_cast<int> (oversampling.getOversamplingFactor());
+        const int numSamples = 1000;
+
+        AudioBuffer<SampleType> input (numChannels, numSamples), processed (numChannels, numSamples * factor),
+                                upsampled, output, expectedUp (numChannels, numSamples * factor),
+                                expectedDown (numChannels, numSamples);
+
+        fillRandom (random, input);
+        fillRandom (random, processed);
+
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            referenceUpsampling (input.getReadPointer (channel), numSamples, coefficientsUp, factor,
+                                 expectedUp.getWritePointer (channel));
+
+            referenceDownsampling (processed.getReadPointer (channel), numSamples, coefficientsDown, factor,
+                                   expectedDown.getWritePointer (channel));
+        }
+
+        render (oversampling, input, upsampled, output, 128, random, &processed);
+
+        expectLessThan (getMaximumDifference (upsampled, expectedUp), tolerance);
+        expectLessThan (getMaximumDifference (output, expectedDown), tolerance);
+    }
+
+    template <typename SampleType>
+    void checkHalfBandFIRStage (int numChannels, double tolerance)
+    {
+        Oversampling<SampleType> oversampling ((size_t) numChannels);
+        oversampling.clearOversamplingStages();
+        oversampling.addOversamplingStage (Oversampling<SampleType>::filterHalfBandFIREquiripple, 0.05f, -90.0f, 0.06f, -75.0f);
+
+        auto up   = FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod ((SampleType) 0.05, (SampleType) -90.0);
+        auto down = FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod ((SampleType) 0.06, (SampleType) -75.0);
+
+        checkFIRStage (oversampling, *up, *down, numChannels, tolerance);
+    }
+
+    template <typename SampleType>
+    void checkPolyphaseFIRStage (int numChannels, int factor, double tolerance)
+    {
+        auto twUp = 0.4f / (float) factor, twDown = 0.3f / (float) factor;
+
+        Oversampling<SampleType> oversampling ((size_t) numChannels);
+        oversampling.clearOversamplingStages();
+        oversampling.addPolyphaseFIROversamplingStage ((size_t) factor, twUp, -90.0f, twDown, -70.0f);
+
+        auto cutoff = (SampleType) (0.5 / factor);
+        auto up   = FilterDesign<SampleType>::designFIRLowpassKaiserMethod (cutoff, 1.0, (SampleType) twUp,   (SampleType) -90.0);
+        auto down = FilterDesign<SampleType>::designFIRLowpassKaiserMethod (cutoff, 1.0, (SampleType) twDown, (SampleType) -70.0);
+
+        checkFIRStage (oversampling, *up, *down, numChannels, tolerance);
+    }
+
+    /** Processing several channels together must give the same result as processing
+        them one by one.
+    */
+    void checkChannelsAreIndependent (Oversampling<float>::FilterType type, size_t factor, bool useHighRatioStage)
+    {
+        auto random = getRandom();
+        const int numChannels = 7, numSamples = 1000;
+
+        AudioBuffer<float> input (numChannels, numSamples), upsampled, output;
+        fillRandom (random, input);
+
+        Oversampling<float> oversampling (numChannels, factor, type, true, useHighRatioStage);
+        render (oversampling, input, upsampled, output, 256, random);
+
+        auto maximumDifference = 0.0;
+
+        for (auto channel = 0; channel < numChannels; ++channel)
+        {
+            AudioBuffer<float> singleInput (1, numSamples), singleUpsampled, singleOutput;
+            singleInput.copyFrom (0, 0, input, channel, 0, numSamples);
+
+            Oversampling<float> single (1, factor, type, true, useHighRatioStage);
+            render (single, singleInput, singleUpsampled, singleOutput, 256, random);
+
+            for (auto i = 0; i < numSamples; ++i)
+                maximumDifference = jmax (maximumDifference, (double) std::abs (output.getSample (channel, i) - singleOutput.getSample (0, i)));
+        }
+
+        expectEquals (maximumDifference, 0.0);
+    }
+
+    /** A low frequency sine wave must come out of the linear phase oversampling
+        chains unchanged, apart from the reported latency and the passband ripple.
+    */
+    void checkLatency (size_t factor, bool useHighRatioStage, double tolerance)
+    {
+        auto random = getRandom();
+        const int numSamples = 4000;
+        const double frequency = 0.02;
+
+        Oversampling<float> oversampling (2, factor, Oversampling<float>::filterHalfBandFIREquiripple, true, useHighRatioStage);
+        expectEquals ((int) oversampling.getOversamplingFactor(), 1 << factor);
+
+        auto latency = (double) oversampling.getLatencyInSamples();
+        AudioBuffer<float> input (2, numSamples), upsampled, output;
+
+        for (auto i = 0; i < numSamples; ++i)
+        {
+            auto value = (float) std::sin (MathConstants<double>::twoPi * frequency * i);
+            input.setSample (0, i, value);
+            input.setSample (1, i, -value);
+        }
+
+        render (oversampling, input, upsampled, output, 256, random);
+
+        auto maximumError = 0.0;
+
+        for (auto i = (int) latency * 2 + 10; i < numSamples; ++i)
+        {
+            auto expected = std::sin (MathConstants<double>::twoPi * frequency * (i - latency));
+            maximumError = jmax (maximumError, std::abs (output.getSample (0, i) - expected));
+            maximumError = jmax (maximumError, std::abs (output.getSample (1, i) + expected));
+        }
+
+        expectLessThan (maximumError, tolerance);
+    }
+
+    void runTest() override
+    {
+        beginTest ("Half band FIR stage");
+        {
+            checkHalfBandFIRStage<float> (1, 1.0e-4);
+            checkHalfBandFIRStage<float> (6, 1.0e-4);
+            checkHalfBandFIRStage<double> (3, 1.0e-6);
+        }
+
+        beginTest ("Polyphase FIR stage");
+        {
+            checkPolyphaseFIRStage<float> (2, 2, 1.0e-4);
+            checkPolyphaseFIRStage<float> (5, 8, 1.0e-4);
+            checkPolyphaseFIRStage<double> (3, 16, 1.0e-6);
+        }
+
+        beginTest ("Channels are independent");
+        {
+            checkChannelsAreIndependent (Oversampling<float>::filterHalfBandFIREquiripple, 2, false);
+            checkChannelsAreIndependent (Oversampling<float>::filterHalfBandPolyphaseIIR, 3, false);
+            checkChannelsAreIndependent (Oversampling<float>::filterHalfBandPolyphaseIIR, 4, true);
+        }
+
+        beginTest ("Latency");
+        {
+            checkLatency (1, false, 1.0e-3);
+            checkLatency (4, false, 1.0e-2);
+            checkLatency (3, true, 1.0e-3);
+            checkLatency (4, true, 1.0e-3);
+        }
+    }
+};
+
+static OversamplingTest oversamplingUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -103,6 +103,24 @@ namespace ProcessorHelpers  // Internal helper classes used in building the Proc
         template <int arg> auto& get() noexcept                      { return AccessHelper<arg>::get (getThis()); }
         template <int arg> const auto& get() const noexcept          { return AccessHelper<arg>::get (getThis()); }
         template <int arg> void setBypassed (bool bypassed) noexcept { AccessHelper<arg>::setBypassed (getThis(), bypassed); }
+
+        /** Makes the chain split the blocks it is given into tiles of this many samples,
+            and pass each tile through all of its processors before moving on to the next
+            one, so that the samples are still in the cache when the next processor reads
+            them. A size of 0 (the default) processes whole blocks.
+
+            This only has an effect on the first element of a chain (i.e. the ProcessorChain
+            object itself), and the processors must be able to cope with being given shorter
+            blocks than the maximum size which was passed to prepare().
+        */
+        void setTileSize (size_t numSamplesPerTile) noexcept    { tileSize = numSamplesPerTile; }
+
+        /** Returns the tile size that was set with setTileSize(), or 0 if the blocks are
+            processed in one go.
+        */
+        size_t getTileSize() const noexcept                      { return tileSize; }
+
+        size_t tileSize = 0;
     };
 
     //==============================================================================
@@ -112,11 +130,63 @@ namespace ProcessorHelpers  // Internal helper classes used in building the Proc
         using Base = ChainElement<isFirst, FirstProcessor, ChainBase<isFirst, FirstProcessor, SubsequentProcessors...>>;
 
         template <typename ProcessContext>
-        void process (const ProcessContext& context) noexcept  { Base::process (context); processors.process (context); }
+        void process (const ProcessContext& context) noexcept
+        {
+            if (isFirst && Base::tileSize > 0 && context.getOutputBlock().getNumSamples() > Base::tileSize)
+                processInTiles (context);
+            else
+                processWholeBlock (context);
+        }
+
         void prepare (const ProcessSpec& spec)                 { Base::prepare (spec); processors.prepare (spec); }
         void reset()                                           { Base::reset(); processors.reset(); }
 
         ChainBase<false, SubsequentProcessors...> processors;
+
+    private:
+        template <typename ProcessContext>
+        void processWholeBlock (const ProcessContext& context) noexcept  { Base::process (context); processors.process (context); }
+
+        template <typename SampleType>
+        void processInTiles (const ProcessContextReplacing<SampleType>& context) noexcept
+        {
+            auto& block = context.getOutputBlock();
+            auto numSamples = block.getNumSamples();
+
+            for (size_t start = 0; start < numSamples; start += Base::tileSize)
+            {
+                auto tile = block.getSubBlock (start, jmin (Base::tileSize, numSamples - start));
+
+                ProcessContextReplacing<SampleType> tileContext (tile);
+                tileContext.isBypassed = context.isBypassed;
+                processWholeBlock (tileContext);
+            }
+        }
+
+        template <typename SampleType>
+        void processInTiles (const ProcessContextNonReplacing<SampleType>& context) noexcept
+        {
+            auto& inputBlock = context.getInputBlock();
+            auto& outputBlock = context.getOutputBlock();
+            auto numSamples = outputBlock.getNumSamples();
+
+            jassert (inputBlock.getNumSamples() == numSamples);
+
+            for (size_t start = 0; start < numSamples; start += Base::tileSize)
+            {
+                auto numTileSamples = jmin (Base::tileSize, numSamples - start);
+                auto inputTile  = inputBlock.getSubBlock (start, numTileSamples);
+                auto outputTile = outputBlock.getSubBlock (start, numTileSamples);
+
+                ProcessContextNonReplacing<SampleType> tileContext (inputTile, outputTile);
+                tileContext.isBypassed = context.isBypassed;
+                processWholeBlock (tileContext);
+            }
+        }
+
+        // other kinds of context don't know how to make sub-blocks of themselves
+        template <typename ProcessContext>
+        void processInTiles (const ProcessContext& context) noexcept    { processWholeBlock (context); }
     };
 
     template <bool isFirst, typename ProcessorType>
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct ProcessorChainTest  : public UnitTest
+{
+    ProcessorChainTest()  : UnitTest ("ProcessorChain", "DSP") {}
+
+    using Filter = ProcessorDuplicator<IIR::Filter<float>, IIR::Coefficients<float>>;
+    using Chain = ProcessorChain<Filter, Gain<float>, Bias<float>, Filter>;
+
+    static void prepareChain (Chain& chain, size_t tileSize, const ProcessSpec& spec)
+    {
+        chain.setTileSize (tileSize);
+        *chain.get<0>().state = *IIR::Coefficients<float>::makeLowPass (spec.sampleRate, 2000.0f);
+        *chain.get<3>().state = *IIR::Coefficients<float>::makeHighPass (spec.sampleRate, 100.0f);
+        chain.get<1>().setGainLinear (0.5f);
+        chain.get<2>().setBias (0.25f);
+        chain.prepare (spec);
+    }
+
+    /** Processes the same signal with and without tiles, in blocks of various sizes,
+        and checks that the results are identical.
+    */
+    void checkTiledProcessing (size_t tileSize, bool replacing, bool bypassSecondFilter)
+    {
+        auto random = getRandom();
+        const int numChannels = 3, numSamples = 4096, maximumBlockSize = 1024;
+        const ProcessSpec spec { 48000.0, (uint32) maximumBlockSize, (uint32) numChannels };
+
+        Chain wholeBlocks, tiled;
+        prepareChain (wholeBlocks, 0, spec);
+        prepareChain (tiled, tileSize, spec);
+        wholeBlocks.setBypassed<3> (bypassSecondFilter);
+        tiled.setBypassed<3> (bypassSecondFilter);
+
+        AudioBuffer<float> input (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (channel, i, 2.0f * random.nextFloat() - 1.0f);
+
+        AudioBuffer<float> expected, output (numChannels, numSamples);
+        expected.makeCopyOf (input);
+        output.clear();
+
+        AudioBlock<float> inputBlock (input), expectedBlock (expected), outputBlock (output);
+
+        for (size_t start = 0; start < (size_t) numSamples;)
+        {
+            auto blockSize = jmin ((size_t) (1 + random.nextInt (maximumBlockSize)), (size_t) numSamples - start);
+            auto expectedSubBlock = expectedBlock.getSubBlock (start, blockSize);
+            auto outputSubBlock = outputBlock.getSubBlock (start, blockSize);
+
+            wholeBlocks.process (ProcessContextReplacing<float> (expectedSubBlock));
+
+            if (replacing)
+            {
+                outputSubBlock.copy (inputBlock.getSubBlock (start, blockSize));
+                tiled.process (ProcessContextReplacing<float> (outputSubBlock));
+            }
+            else
+            {
+                auto inputSubBlock = inputBlock.getSubBlock (start, blockSize);
+                tiled.process (ProcessContextNonReplacing<float> (inputSubBlock, outputSubBlock));
+            }
+
+            start += blockSize;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                expectEquals (output.getSample (channel, i), expected.getSample (channel, i));
+    }
+
+    void runTest() override
+    {
+        beginTest ("Tiled processing with a replacing context");
+        {
+            checkTiledProcessing (64, true, false);
+            checkTiledProcessing (100, true, true);
+        }
+
+        beginTest ("Tiled processing with a non-replacing context");
+        {
+            checkTiledProcessing (64, false, false);
+            checkTiledProcessing (37, false, true);
+        }
+    }
+};
+
+static ProcessorChainTest processorChainUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct ProcessorDuplicatorTest  : public UnitTest
+{
+    ProcessorDuplicatorTest()  : UnitTest ("ProcessorDuplicator", "DSP") {}
+
+   #if JUCE_USE_SIMD
+    /** Runs both duplicators over the same random signal with irregular block sizes,
+        and checks that packing the channels into SIMD lanes doesn't change the results.
+    */
+    template <typename ScalarDuplicator, typename SIMDDuplicator>
+    void checkAgainstScalarVersion (ScalarDuplicator& scalar, SIMDDuplicator& simd, int numChannels, bool replacing)
+    {
+        using NumericType = typename SIMDDuplicator::NumericType;
+
+        auto random = getRandom();
+        const int numSamples = 2000, maximumBlockSize = 128;
+        const ProcessSpec spec { 48000.0, (uint32) maximumBlockSize, (uint32) numChannels };
+
+        scalar.prepare (spec);
+        simd.prepare (spec);
+
+        AudioBuffer<NumericType> input (numChannels, numSamples), expected, output (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                input.setSample (channel, i, (NumericType) (2.0f * random.nextFloat() - 1.0f));
+
+        expected.makeCopyOf (input);
+        output.makeCopyOf (input);
+
+        AudioBlock<NumericType> inputBlock (input), expectedBlock (expected), outputBlock (output);
+
+        for (size_t position = 0; position < (size_t) numSamples;)
+        {
+            auto blockSize = jmin ((size_t) (1 + random.nextInt (maximumBlockSize)), (size_t) numSamples - position);
+            auto expectedSubBlock = expectedBlock.getSubBlock (position, blockSize);
+            auto outputSubBlock = outputBlock.getSubBlock (position, blockSize);
+
+            scalar.process (ProcessContextReplacing<NumericType> (expectedSubBlock));
+
+            if (replacing)
+            {
+                simd.process (ProcessContextReplacing<NumericType> (outputSubBlock));
+            }
+            else
+            {
+                auto inputSubBlock = inputBlock.getSubBlock (position, blockSize);
+                simd.process (ProcessContextNonReplacing<NumericType> (inputSubBlock, outputSubBlock));
+            }
+
+            position += blockSize;
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (output.getSample (channel, i), expected.getSample (channel, i), (NumericType) 1.0e-5);
+    }
+
+    template <typename NumericType>
+    void checkIIRFilter()
+    {
+        auto coefficients = IIR::Coefficients<NumericType>::makeLowPass (48000.0, (NumericType) 1000);
+
+        for (auto numChannels : { 1, 2, 5, 8 })
+        {
+            ProcessorDuplicator<IIR::Filter<NumericType>, IIR::Coefficients<NumericType>> scalar (coefficients);
+            SIMDProcessorDuplicator<IIR::Filter<SIMDRegister<NumericType>>, IIR::Coefficients<NumericType>> simd (coefficients);
+
+            checkAgainstScalarVersion (scalar, simd, numChannels, true);
+            simd.reset();
+            scalar.reset();
+            checkAgainstScalarVersion (scalar, simd, numChannels, false);
+        }
+    }
+
+    template <typename NumericType>
+    void checkStateVariableFilter()
+    {
+        using Parameters = StateVariableFilter::Parameters<NumericType>;
+        typename Parameters::Ptr parameters (new Parameters());
+        parameters->type = Parameters::Type::bandPass;
+        parameters->setCutOffFrequency (48000.0, (NumericType) 2000);
+
+        ProcessorDuplicator<StateVariableFilter::Filter<NumericType>, Parameters> scalar (parameters);
+        SIMDProcessorDuplicator<StateVariableFilter::Filter<SIMDRegister<NumericType>>, Parameters> simd (parameters);
+
+        checkAgainstScalarVersion (scalar, simd, 3, true);
+    }
+   #endif
+
+    void runTest() override
+    {
+       #if JUCE_USE_SIMD
+        beginTest ("SIMD lane packing with IIR filters");
+        {
+            checkIIRFilter<float>();
+            checkIIRFilter<double>();
+        }
+
+        beginTest ("SIMD lane packing with state variable filters");
+        {
+            checkStateVariableFilter<float>();
+            checkStateVariableFilter<double>();
+        }
+       #endif
+    }
+};
+
+static ProcessorDuplicatorTest processorDuplicatorUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -48,6 +48,11 @@ namespace StateVariableFilter
         higher than 0 dB. For the classic 0 dB bandpass, we need to multiply the
         result with R2
 
+        When the parameters have a rampLength, the filter glides to any new cutoff
+        and resonance over that many samples, so a modulated filter only needs its
+        parameters to be set once per block. Like the other filters, it can be used
+        with SIMDRegister samples to process several channels at once.
+
         @tags{DSP}
     */
     template <typename SampleType>
@@ -79,8 +84,14 @@ namespace StateVariableFilter
         /** Initialization of the filter */
         void prepare (const ProcessSpec&) noexcept     { reset(); }
 
-        /** Resets the filter's processing pipeline. */
-        void reset() noexcept                          { s1 = s2 = SampleType {0}; }
+        /** Resets the filter's processing pipeline, and makes it jump to the current
+            parameters if it was ramping towards them. */
+        void reset() noexcept
+        {
+            s1 = s2 = SampleType {0};
+            current = rampTarget = *parameters;
+            rampSamplesRemaining = 0;
+        }
 
         /** Ensure that the state variables are rounded to zero if the state
             variables are denormals. This is only needed if you are doing
@@ -110,11 +121,16 @@ namespace StateVariableFilter
             Use this if you need processing of a single value. */
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
+            updateRamp();
+
+            if (rampSamplesRemaining > 0)
+                advanceRamp();
+
             switch (parameters->type)
             {
-                case Parameters<NumericType>::Type::lowPass:  return processLoop<false, Parameters<NumericType>::Type::lowPass>  (sample, *parameters); break;
-                case Parameters<NumericType>::Type::bandPass: return processLoop<false, Parameters<NumericType>::Type::bandPass> (sample, *parameters); break;
-                case Parameters<NumericType>::Type::highPass: return processLoop<false, Parameters<NumericType>::Type::highPass> (sample, *parameters); break;
+                case Parameters<NumericType>::Type::lowPass:  return processLoop<false, Parameters<NumericType>::Type::lowPass>  (sample, current); break;
+                case Parameters<NumericType>::Type::bandPass: return processLoop<false, Parameters<NumericType>::Type::bandPass> (sample, current); break;
+                case Parameters<NumericType>::Type::highPass: return processLoop<false, Parameters<NumericType>::Type::highPass> (sample, current); break;
                 default: jassertfalse;
             }
 
@@ -140,13 +156,53 @@ namespace StateVariableFilter
         template <bool isBypassed, typename Parameters<NumericType>::Type type>
         void processBlock (const SampleType* input, SampleType* output, size_t n) noexcept
         {
-            auto state = *parameters;
+            updateRamp();
+
+            size_t i = 0;
+
+            for (; i < n && rampSamplesRemaining > 0; ++i)
+            {
+                advanceRamp();
+                output[i] = processLoop<isBypassed, type> (input[i], current);
+            }
 
-            for (size_t i = 0 ; i < n; ++i)
-                output[i] = processLoop<isBypassed, type> (input[i], state);
+            for (; i < n; ++i)
+                output[i] = processLoop<isBypassed, type> (input[i], current);
 
             snapToZero();
-            *parameters = state;
+        }
+
+        /** Starts a new ramp if the parameters have changed since the last one. */
+        void updateRamp() noexcept
+        {
+            if (parameters->g == rampTarget.g && parameters->R2 == rampTarget.R2)
+                return;
+
+            rampTarget = *parameters;
+            rampSamplesRemaining = jmax (0, parameters->rampLength);
+
+            if (rampSamplesRemaining == 0)
+            {
+                current = rampTarget;
+            }
+            else
+            {
+                gStep  = (rampTarget.g  - current.g)  / static_cast<NumericType> (rampSamplesRemaining);
+                R2Step = (rampTarget.R2 - current.R2) / static_cast<NumericType> (rampSamplesRemaining);
+            }
+        }
+
+        void advanceRamp() noexcept
+        {
+            if (--rampSamplesRemaining == 0)
+            {
+                current = rampTarget;
+                return;
+            }
+
+            current.g  += gStep;
+            current.R2 += R2Step;
+            current.h = static_cast<NumericType> (1.0) / (static_cast<NumericType> (1.0) + current.R2 * current.g + current.g * current.g);
         }
 
         template <bool isBypassed, typename ProcessContext>
@@ -177,6 +233,11 @@ namespace StateVariableFilter
         std::array<SampleType, 3> y;
         SampleType s1, s2;
 
+        // the coefficients in use, which may be on their way to the ones in parameters
+        Parameters<NumericType> current, rampTarget;
+        NumericType gStep = 0, R2Step = 0;
+        int rampSamplesRemaining = 0;
+
         //==============================================================================
         JUCE_LEAK_DETECTOR (Filter)
     };
@@ -202,6 +263,12 @@ namespace StateVariableFilter
         /** The type of the IIR filter */
         Type type = Type::lowPass;
 
+        /** The number of samples over which the filters glide to new coefficients when
+            the cutoff or resonance changes. With the default of zero, they jump to them
+            straight away.
+        */
+        int rampLength = 0;
+
         /** Sets the cutoff frequency and resonance of the IIR filter.
 
             Note: The bandwidth of the resonance increases with the value of the
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+struct StateVariableFilterTest  : public UnitTest
+{
+    StateVariableFilterTest()  : UnitTest ("StateVariableFilter", "DSP") {}
+
+    using Filter = StateVariableFilter::Filter<float>;
+
+    static void fillRandom (Random& random, float* data, int numSamples)
+    {
+        for (auto i = 0; i < numSamples; ++i)
+            data[i] = 2.0f * random.nextFloat() - 1.0f;
+    }
+
+    static void render (Filter& filter, float* data, int numSamples, int maximumBlockSize, Random& random)
+    {
+        for (auto position = 0; position < numSamples;)
+        {
+            auto numThisTime = jmin (1 + random.nextInt (maximumBlockSize), numSamples - position);
+            AudioBlock<float> block (&data, 1, (size_t) position, (size_t) numThisTime);
+
+            filter.process (ProcessContextReplacing<float> (block));
+            position += numThisTime;
+        }
+    }
+
+    void runTest() override
+    {
+        const double sampleRate = 48000.0;
+        const int numSamples = 8192, rampLength = 1000;
+        auto random = getRandom();
+
+        HeapBlock<float> input (numSamples), ramped (numSamples), jumped (numSamples), sampleBySample (numSamples);
+        fillRandom (random, input, numSamples);
+
+        Filter rampedFilter, jumpingFilter, sampleBySampleFilter;
+        rampedFilter.parameters->rampLength = rampLength;
+        sampleBySampleFilter.parameters->rampLength = rampLength;
+
+        // the ramps only start from the parameters the filters were reset with
+        for (auto* f : { &rampedFilter, &jumpingFilter, &sampleBySampleFilter })
+        {
+            f->parameters->setCutOffFrequency (sampleRate, 500.0f);
+            f->reset();
+            f->parameters->setCutOffFrequency (sampleRate, 4000.0f, 2.0f);
+        }
+
+        for (auto* d : { &ramped, &jumped, &sampleBySample })
+            FloatVectorOperations::copy (d->get(), input, numSamples);
+
+        render (rampedFilter, ramped, numSamples, 300, random);
+        render (jumpingFilter, jumped, numSamples, 300, random);
+
+        for (auto i = 0; i < numSamples; ++i)
+            sampleBySample[i] = sampleBySampleFilter.processSample (sampleBySample[i]);
+
+        beginTest ("Ramping the coefficients");
+        {
+            auto maximumDifference = 0.0f;
+
+            for (auto i = 0; i < rampLength; ++i)
+                maximumDifference = jmax (maximumDifference, std::abs (ramped[i] - jumped[i]));
+
+            expectGreaterThan (maximumDifference, 0.01f);
+
+            // once the ramp is over, the two filters should converge
+            for (auto i = numSamples - 1000; i < numSamples; ++i)
+                expectWithinAbsoluteError (ramped[i], jumped[i], 1.0e-5f);
+        }
+
+        beginTest ("Ramping sample by sample");
+        {
+            for (auto i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (sampleBySample[i], ramped[i], 1.0e-6f);
+        }
+    }
+};
+
+static StateVariableFilterTest stateVariableFilterUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+template <typename FloatType>
+void WavetableOscillator<FloatType>::initialise (const std::function<FloatType (FloatType)>& function, size_t newTableSize)
+{
+    jassert (isPowerOfTwo (newTableSize) && newTableSize >= 4);
+
+    auto size = static_cast<int> (newTableSize);
+    auto mask = size - 1;
+    auto numHarmonicsToUse = static_cast<size_t> (size / 2 - 1);
+
+    HeapBlock<double> samples ((size_t) size), sine ((size_t) size);
+    auto mean = 0.0;
+
+    for (int i = 0; i < size; ++i)
+    {
+        auto angle = MathConstants<double>::twoPi * i / size;
+        sine[i] = std::sin (angle);
+        samples[i] = (double) function (static_cast<FloatType> (angle - MathConstants<double>::pi));
+        mean += samples[i];
+    }
+
+    // a discrete Fourier transform gives the amplitude and phase of each harmonic
+    HeapBlock<FloatType> amplitudes (numHarmonicsToUse), phases (numHarmonicsToUse);
+
+    for (size_t h = 1; h <= numHarmonicsToUse; ++h)
+    {
+        auto re = 0.0, im = 0.0;
+
+        for (int i = 0; i < size; ++i)
+        {
+            auto index = (int) h * i;
+            re += samples[i] * sine[(index + size / 4) & mask];
+            im += samples[i] * sine[index & mask];
+        }
+
+        // re * cos (x) + im * sin (x) == amplitude * sin (x + phase)
+        amplitudes[h - 1] = static_cast<FloatType> (2.0 * std::sqrt (re * re + im * im) / size);
+        phases[h - 1]     = static_cast<FloatType> (std::atan2 (re, im));
+    }
+
+    tableSize = newTableSize;
+    numHarmonics = numHarmonicsToUse;
+    buildTables (amplitudes, phases, static_cast<FloatType> (mean / size));
+}
+
+template <typename FloatType>
+void WavetableOscillator<FloatType>::initialise (const FloatType* amplitudes, const FloatType* phases,
+                                                 size_t numHarmonicsToUse, size_t newTableSize)
+{
+    jassert (amplitudes != nullptr && numHarmonicsToUse > 0);
+
+    if (newTableSize == 0)
+        newTableSize = jmax ((size_t) 2048, (size_t) nextPowerOfTwo ((int) numHarmonicsToUse * 2 + 1));
+
+    // the table must be large enough to hold all the harmonics
+    jassert (isPowerOfTwo (newTableSize) && newTableSize > numHarmonicsToUse * 2);
+
+    tableSize = newTableSize;
+    numHarmonics = numHarmonicsToUse;
+    buildTables (amplitudes, phases, 0);
+}
+
+template <typename FloatType>
+void WavetableOscillator<FloatType>::buildTables (const FloatType* amplitudes, const FloatType* phases, FloatType offset)
+{
+    auto size = static_cast<int> (tableSize);
+    auto mask = size - 1;
+
+    numTables = 0;
+
+    while ((numHarmonics >> numTables) > 0)
+        ++numTables;
+
+    HeapBlock<double> sine ((size_t) size), sum ((size_t) size);
+
+    for (int i = 0; i < size; ++i)
+    {
+        sine[i] = std::sin (MathConstants<double>::twoPi * i / size);
+        sum[i] = (double) offset;
+    }
+
+    tables.malloc (numTables * (tableSize + 1));
+
+    // starting with the poorest table, each one adds its extra harmonics to the previous one
+    size_t numHarmonicsDone = 0;
+
+    for (auto t = (int) numTables; --t >= 0;)
+    {
+        for (auto h = numHarmonicsDone + 1; h <= (numHarmonics >> t); ++h)
+        {
+            auto harmonicPhase = phases != nullptr ? (double) phases[h - 1] : 0.0;
+            auto sinGain = (double) amplitudes[h - 1] * std::cos (harmonicPhase);
+            auto cosGain = (double) amplitudes[h - 1] * std::sin (harmonicPhase);
+
+            for (int i = 0; i < size; ++i)
+            {
+                auto index = (int) h * i;
+                sum[i] += sinGain * sine[index & mask] + cosGain * sine[(index + size / 4) & mask];
+            }
+        }
+
+        numHarmonicsDone = numHarmonics >> t;
+
+        auto* table = tables.get() + (size_t) t * (tableSize + 1);
+
+        for (int i = 0; i < size; ++i)
+            table[i] = static_cast<FloatType> (sum[i]);
+
+        table[size] = table[0];
+    }
+}
+
+//==============================================================================
+template <typename FloatType>
+void WavetableOscillator<FloatType>::render (FloatType* dest, size_t numSamples) noexcept
+{
+    while (numSamples > 0)
+    {
+        auto numThisTime = jmin (numSamples, (size_t) chunkSize);
+        FloatType increment;
+
+        if (frequency.isSmoothing())
+        {
+            // the frequency only changes once per chunk, but using the average of its
+            // values keeps the phase where it would have been with a per-sample ramp
+            auto start = frequency.getNextValue();
+            frequency.skip (static_cast<int> (numThisTime) - 1);
+            increment = (start + frequency.getCurrentValue()) * static_cast<FloatType> (0.5) / sampleRate;
+        }
+        else
+        {
+            increment = frequency.getNextValue() / sampleRate;
+        }
+
+        if (dest != nullptr)
+        {
+            renderChunk (dest, getTable (getTableIndex (increment)), increment, numThisTime);
+            dest += numThisTime;
+        }
+
+        phase += increment * static_cast<FloatType> (numThisTime);
+        phase -= std::floor (phase);
+        numSamples -= numThisTime;
+    }
+}
+
+template <typename FloatType>
+void WavetableOscillator<FloatType>::renderChunk (FloatType* dest, const FloatType* table,
+                                                  FloatType increment, size_t numSamples) noexcept
+{
+    auto size = static_cast<FloatType> (tableSize);
+    auto mask = static_cast<int> (tableSize) - 1;
+
+    int indices[chunkSize];
+    FloatType fractions[chunkSize];
+
+    // the positions are computed from the start of the chunk rather than accumulated,
+    // so that this loop has no dependency between iterations and can be vectorised
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto position = (phase + increment * static_cast<FloatType> (i)) * size;
+        auto index = static_cast<int> (position);
+
+        fractions[i] = position - static_cast<FloatType> (index);
+        indices[i] = index & mask;
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto* samples = table + indices[i];
+        dest[i] = samples[0] + fractions[i] * (samples[1] - samples[0]);
+    }
+}
+
+//==============================================================================
+template class WavetableOscillator<float>;
+template class WavetableOscillator<double>;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,243 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A band-limited oscillator which reads its waveform from a set of tables.
+
+    The waveform gets stored as a mip-map: the first table holds all its harmonics,
+    and each of the following ones holds half as many as the one before. While
+    playing, the oscillator picks the richest table whose harmonics all stay below
+    the Nyquist frequency, so the output never aliases. As the waveform can have as
+    many harmonics as half the table size, this is also a cheap way of playing
+    thousands of partials of an additive synthesiser at once, as long as they're
+    harmonic.
+
+    The tables are filled by calling one of the initialise() methods, which allocate
+    memory and are quite slow, so you shouldn't call them from the audio thread.
+
+    Like the Oscillator class, the output is added to the input of the processing
+    context, and the channels without an input get a copy of the waveform.
+
+    @see Oscillator
+
+    @tags{DSP}
+*/
+template <typename FloatType>
+class WavetableOscillator
+{
+public:
+    /** Creates an uninitialised oscillator. Call initialise before first use. */
+    WavetableOscillator() = default;
+
+    /** Returns true if the oscillator has been initialised with a waveform. */
+    bool isInitialised() const noexcept                 { return numTables > 0; }
+
+    /** Fills the tables with one period of a periodic function of the range (-pi..pi),
+        in the same way as the Oscillator class. The harmonics which can't be stored
+        in a table of the given size are removed.
+
+        @param function     the waveform to play
+        @param tableSize    the number of samples in each table, which must be a power of
+                            two. The waveform keeps (tableSize / 2 - 1) harmonics
+    */
+    void initialise (const std::function<FloatType (FloatType)>& function, size_t tableSize = 2048);
+
+    /** Fills the tables with a sum of harmonics, i.e. the waveform
+        sum (amplitude[h - 1] * sin (h * phase + phases[h - 1])) for h = 1 .. numHarmonics.
+
+        @param amplitudes   the amplitudes of the harmonics, starting with the fundamental
+        @param phases       the phases of the harmonics in radians, or nullptr to start
+                            them all at 0
+        @param numHarmonics the number of harmonics to use
+        @param tableSize    the number of samples in each table, which must be a power of
+                            two greater than twice the number of harmonics. If this is 0,
+                            the smallest of those is used, with a minimum of 2048
+    */
+    void initialise (const FloatType* amplitudes, const FloatType* phases,
+                     size_t numHarmonics, size_t tableSize = 0);
+
+    /** Returns the number of samples in each table. */
+    size_t getTableSize() const noexcept                { return tableSize; }
+
+    /** Returns the number of band-limited tables in the mip-map. */
+    size_t getNumTables() const noexcept                { return numTables; }
+
+    /** Returns the number of harmonics stored in the given table. */
+    size_t getNumHarmonics (size_t tableIndex) const noexcept
+    {
+        jassert (tableIndex < numTables);
+        return numHarmonics >> tableIndex;
+    }
+
+    /** Returns the index of the table that is used for the given frequency at the
+        current sample rate.
+    */
+    size_t getTableIndexForFrequency (FloatType frequencyHz) const noexcept
+    {
+        return getTableIndex (frequencyHz / sampleRate);
+    }
+
+    //==============================================================================
+    /** Sets the frequency of the oscillator. */
+    void setFrequency (FloatType newFrequency, bool force = false) noexcept
+    {
+        if (force)
+        {
+            frequency.setCurrentAndTargetValue (newFrequency);
+            return;
+        }
+
+        frequency.setTargetValue (newFrequency);
+    }
+
+    /** Returns the current frequency of the oscillator. */
+    FloatType getFrequency() const noexcept             { return frequency.getTargetValue(); }
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec)
+    {
+        sampleRate = static_cast<FloatType> (spec.sampleRate);
+        renderBuffer.resize ((int) spec.maximumBlockSize);
+
+        reset();
+    }
+
+    /** Resets the internal state of the oscillator. */
+    void reset() noexcept
+    {
+        phase = 0;
+
+        if (sampleRate > 0)
+            frequency.reset (sampleRate, 0.05);
+    }
+
+    //==============================================================================
+    /** Returns the result of processing a single sample. */
+    FloatType JUCE_VECTOR_CALLTYPE processSample (FloatType input) noexcept
+    {
+        jassert (isInitialised());
+
+        auto increment = frequency.getNextValue() / sampleRate;
+        auto* table = getTable (getTableIndex (increment));
+
+        auto position = phase * static_cast<FloatType> (tableSize);
+        auto index = static_cast<int> (position);
+        auto fraction = position - static_cast<FloatType> (index);
+        auto* samples = table + (index & (static_cast<int> (tableSize) - 1));
+
+        phase += increment;
+        phase -= std::floor (phase);
+
+        return input + samples[0] + fraction * (samples[1] - samples[0]);
+    }
+
+    /** Processes the input and output buffers supplied in the processing context. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        jassert (isInitialised());
+
+        auto&& outBlock = context.getOutputBlock();
+        auto&& inBlock  = context.getInputBlock();
+
+        // this is an output-only processor
+        jassert (outBlock.getNumSamples() <= static_cast<size_t> (renderBuffer.size()));
+
+        auto len           = outBlock.getNumSamples();
+        auto numChannels   = outBlock.getNumChannels();
+        auto inputChannels = inBlock.getNumChannels();
+
+        if (context.isBypassed)
+        {
+            outBlock.clear();
+            render (nullptr, len);
+            return;
+        }
+
+        auto* buffer = renderBuffer.getRawDataPointer();
+        render (buffer, len);
+
+        size_t ch;
+
+        for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                FloatVectorOperations::add (outBlock.getChannelPointer (ch), inBlock.getChannelPointer (ch),
+                                            buffer, static_cast<int> (len));
+            else
+                FloatVectorOperations::add (outBlock.getChannelPointer (ch), buffer, static_cast<int> (len));
+        }
+
+        for (; ch < numChannels; ++ch)
+            FloatVectorOperations::copy (outBlock.getChannelPointer (ch), buffer, static_cast<int> (len));
+    }
+
+private:
+    //==============================================================================
+    /** Writes the next samples of the waveform into dest, or only advances the
+        phase if dest is nullptr.
+    */
+    void render (FloatType* dest, size_t numSamples) noexcept;
+
+    void renderChunk (FloatType* dest, const FloatType* table, FloatType increment, size_t numSamples) noexcept;
+
+    void buildTables (const FloatType* amplitudes, const FloatType* phases, FloatType offset);
+
+    const FloatType* getTable (size_t tableIndex) const noexcept
+    {
+        return tables.get() + tableIndex * (tableSize + 1);
+    }
+
+    size_t getTableIndex (FloatType increment) const noexcept
+    {
+        // the highest harmonic must be below the Nyquist frequency
+        size_t index = 0;
+
+        while (index < numTables - 1 && static_cast<FloatType> (numHarmonics >> index) * increment >= static_cast<FloatType> (0.5))
+            ++index;
+
+        return index;
+    }
+
+    //==============================================================================
+    enum { chunkSize = 32 };
+
+    HeapBlock<FloatType> tables;
+    size_t tableSize = 0, numTables = 0, numHarmonics = 0;
+
+    Array<FloatType> renderBuffer;
+    SmoothedValue<FloatType> frequency { static_cast<FloatType> (440.0) };
+    FloatType sampleRate = 48000.0, phase = 0;
+};
+
+} // namespace dsp
+} // namespace juce
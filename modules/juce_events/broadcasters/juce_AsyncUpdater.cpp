@@ -23,21 +23,153 @@
 namespace juce
 {
 
-class AsyncUpdater::AsyncUpdaterMessage  : public CallbackMessage
+class AsyncUpdater::AsyncUpdaterMessage  : public ReferenceCountedObject
 {
 public:
     AsyncUpdaterMessage (AsyncUpdater& au)  : owner (au) {}
 
-    void messageCallback() override
+    AsyncUpdater& owner;
+    Atomic<int> shouldDeliver, isQueued;
+    AsyncUpdaterMessage* nextInQueue = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (AsyncUpdaterMessage)
+};
+
+//==============================================================================
+/*  Rather than each AsyncUpdater posting its own message, triggered updaters are pushed
+    onto a shared lock-free stack, and a single message delivers everything that's pending
+    at once, in the order the updates were triggered. So a burst of updates from hundreds
+    of objects only adds one message to the system queue, and other events can still get
+    through in between. If the callbacks in a batch take too long, the rest of it is left
+    for another message.
+*/
+struct AsyncUpdateDispatcher
+{
+    ~AsyncUpdateDispatcher()
     {
-        if (shouldDeliver.compareAndSetBool (0, 1))
-            owner.handleAsyncUpdate();
+        release (pending.exchange (nullptr));
+        release (deferred);
     }
 
-    AsyncUpdater& owner;
-    Atomic<int> shouldDeliver;
+    static AsyncUpdateDispatcher& getInstance()
+    {
+        static AsyncUpdateDispatcher dispatcher;
+        return dispatcher;
+    }
 
-    JUCE_DECLARE_NON_COPYABLE (AsyncUpdaterMessage)
+    bool add (AsyncUpdater::AsyncUpdaterMessage* message)
+    {
+        // an updater only goes on the stack once, even if it gets cancelled and re-triggered
+        if (message->isQueued.exchange (1) == 0)
+        {
+            message->incReferenceCount();
+            auto* head = pending.load (std::memory_order_relaxed);
+
+            do
+            {
+                message->nextInQueue = head;
+            }
+            while (! pending.compare_exchange_weak (head, message, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        return postIfNeeded();
+    }
+
+private:
+    struct DispatchMessage  : public MessageManager::MessageBase
+    {
+        ~DispatchMessage() override
+        {
+            // if the message got lost, the next update that's triggered will need to post another one
+            if (! delivered)
+                getInstance().messageInFlight = false;
+        }
+
+        void messageCallback() override
+        {
+            delivered = true;
+            getInstance().dispatch();
+        }
+
+        bool delivered = false;
+    };
+
+    std::atomic<AsyncUpdater::AsyncUpdaterMessage*> pending { nullptr };
+    AsyncUpdater::AsyncUpdaterMessage* deferred = nullptr; // only used by the message thread
+    std::atomic<bool> messageInFlight { false };
+
+    enum { maxBatchTimeMs = 20 };
+
+    bool postIfNeeded()
+    {
+        if (messageInFlight.exchange (true))
+            return true;
+
+        return (new DispatchMessage())->post();
+    }
+
+    void dispatch()
+    {
+        messageInFlight = false;
+
+        // the deferred updaters are older than anything still on the stack, so they go first
+        auto** tail = &deferred;
+
+        while (*tail != nullptr)
+            tail = &((*tail)->nextInQueue);
+
+        AsyncUpdater::AsyncUpdaterMessage* newestFirst = pending.exchange (nullptr, std::memory_order_acquire);
+        AsyncUpdater::AsyncUpdaterMessage* inOrder = nullptr;
+
+        while (newestFirst != nullptr)
+        {
+            auto* next = newestFirst->nextInQueue;
+            newestFirst->nextInQueue = inOrder;
+            inOrder = newestFirst;
+            newestFirst = next;
+        }
+
+        *tail = inOrder;
+
+        auto endTime = Time::getMillisecondCounterHiRes() + (double) maxBatchTimeMs;
+
+        while (deferred != nullptr)
+        {
+            // Each one's unlinked before its callback, because the callback may re-enter the
+            // message loop. And it must be marked as unqueued before checking whether to deliver
+            // it, so that an update triggered on another thread in the meantime isn't lost.
+            const ReferenceCountedObjectPtr<AsyncUpdater::AsyncUpdaterMessage> message (deferred);
+            deferred = message->nextInQueue;
+            message->nextInQueue = nullptr;
+            message->isQueued = 0;
+            message->decReferenceCount();
+
+            if (message->shouldDeliver.compareAndSetBool (0, 1))
+            {
+                JUCE_TRY
+                {
+                    message->owner.handleAsyncUpdate();
+                }
+                JUCE_CATCH_EXCEPTION
+            }
+
+            if (deferred != nullptr && Time::getMillisecondCounterHiRes() > endTime)
+            {
+                postIfNeeded();
+                break;
+            }
+        }
+    }
+
+    static void release (AsyncUpdater::AsyncUpdaterMessage* message) noexcept
+    {
+        while (message != nullptr)
+        {
+            auto* next = message->nextInQueue;
+            message->decReferenceCount();
+            message = next;
+        }
+    }
 };
 
 //==============================================================================
@@ -66,7 +198,7 @@ void AsyncUpdater::triggerAsyncUpdate()
     JUCE_ASSERT_MESSAGE_MANAGER_EXISTS
 
     if (activeMessage->shouldDeliver.compareAndSetBool (1, 0))
-        if (! activeMessage->post())
+        if (! AsyncUpdateDispatcher::getInstance().add (activeMessage.get()))
             cancelPendingUpdate(); // if the message queue fails, this avoids getting
                                    // trapped waiting for the message to arrive
 }
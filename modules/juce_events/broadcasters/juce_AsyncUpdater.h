@@ -57,6 +57,10 @@ public:
         If an update callback is already pending but hasn't happened yet, calling
         this method will have no effect.
 
+        Updates that are pending for different AsyncUpdaters are delivered together,
+        in the order they were triggered, by a single message, so triggering lots of
+        them at once doesn't flood the message queue.
+
         It's thread-safe to call this method from any thread, BUT beware of calling
         it from a real-time (e.g. audio) thread, because it involves posting a message
         to the system queue, which means it may block (and in general will do on
@@ -102,6 +106,7 @@ private:
     //==============================================================================
     class AsyncUpdaterMessage;
     friend class ReferenceCountedObjectPtr<AsyncUpdaterMessage>;
+    friend struct AsyncUpdateDispatcher;
     ReferenceCountedObjectPtr<AsyncUpdaterMessage> activeMessage;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncUpdater)
@@ -85,12 +85,13 @@ private:
 struct ChildProcessMaster::Connection  : public InterprocessConnection,
                                          private ChildProcessPingThread
 {
-    Connection (ChildProcessMaster& m, const String& pipeName, int timeout)
+    Connection (ChildProcessMaster& m, const String& pipeName, int timeout, int sharedMemoryBytes)
         : InterprocessConnection (false, magicMastSlaveConnectionHeader),
           ChildProcessPingThread (timeout),
           owner (m)
     {
-        if (createPipe (pipeName, timeoutMs))
+        if (sharedMemoryBytes > 0 ? createSharedMemoryChannel (pipeName, sharedMemoryBytes, timeoutMs)
+                                  : createPipe (pipeName, timeoutMs))
             startThread (4);
     }
 
@@ -139,11 +140,12 @@ bool ChildProcessMaster::sendMessageToSlave (const MemoryBlock& mb)
 }
 
 bool ChildProcessMaster::launchSlaveProcess (const File& executable, const String& commandLineUniqueID,
-                                             int timeoutMs, int streamFlags)
+                                             int timeoutMs, int streamFlags, int sharedMemoryBytes)
 {
     killSlaveProcess();
 
-    auto pipeName = "p" + String::toHexString (Random().nextInt64());
+    // the first character of the name tells the slave which kind of channel to connect to
+    auto pipeName = (sharedMemoryBytes > 0 ? "m" : "p") + String::toHexString (Random().nextInt64());
 
     StringArray args;
     args.add (executable.getFullPathName());
@@ -153,7 +155,7 @@ bool ChildProcessMaster::launchSlaveProcess (const File& executable, const Strin
 
     if (childProcess->start (args, streamFlags))
     {
-        connection.reset (new Connection (*this, pipeName, timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs));
+        connection.reset (new Connection (*this, pipeName, timeoutMs <= 0 ? defaultTimeoutMs : timeoutMs, sharedMemoryBytes));
 
         if (connection->isConnected())
         {
@@ -188,7 +190,11 @@ struct ChildProcessSlave::Connection  : public InterprocessConnection,
           ChildProcessPingThread (timeout),
           owner (p)
     {
-        connectToPipe (pipeName, timeoutMs);
+        if (pipeName.startsWithChar ('m'))
+            connectToSharedMemoryChannel (pipeName, timeoutMs, timeoutMs);
+        else
+            connectToPipe (pipeName, timeoutMs);
+
         startThread (4);
     }
 
@@ -155,6 +155,12 @@ public:
         handleConnectionLost() will be called. Passing <= 0 for this timeout makes
         it use a default value.
 
+        If sharedMemoryBytes is greater than zero, the two processes will talk through a
+        shared-memory channel with buffers of (at least) this size, instead of a named pipe.
+        That avoids a couple of copies and system calls per message, which helps when
+        you're sending lots of data, but each message must be smaller than half the buffer
+        size. See InterprocessConnection::createSharedMemoryChannel() for more details.
+
         If this all works, the method returns true, and you can begin sending and
         receiving messages with the slave process.
 
@@ -164,7 +170,8 @@ public:
     bool launchSlaveProcess (const File& executableToLaunch,
                              const String& commandLineUniqueID,
                              int timeoutMs = 0,
-                             int streamFlags = ChildProcess::wantStdOut | ChildProcess::wantStdErr);
+                             int streamFlags = ChildProcess::wantStdOut | ChildProcess::wantStdErr,
+                             int sharedMemoryBytes = 0);
 
     /** Sends a kill message to the slave, and disconnects from it.
         Note that this won't wait for it to terminate.
@@ -32,6 +32,321 @@ struct InterprocessConnection::ConnectionThread  : public Thread
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConnectionThread)
 };
 
+//==============================================================================
+/*  Two single-producer, single-consumer rings of bytes in a memory-mapped file, one for
+    each direction. Every message is stored in one contiguous piece (if it won't fit before
+    the end of the ring, a marker tells the reader to skip to the start), so that the reader
+    can be given a pointer straight into the shared memory.
+*/
+struct InterprocessConnection::SharedMemoryChannel
+{
+    // Wakes up a thread in the other process. The count changes every time it's signalled,
+    // and a waiter sleeps on it (with a futex on Linux, or by polling elsewhere).
+    struct Signal
+    {
+        std::atomic<uint32> count, numWaiters;
+
+        void signal() noexcept
+        {
+            count.fetch_add (1);
+
+           #if JUCE_LINUX
+            if (numWaiters.load() != 0)
+                syscall (SYS_futex, &count, FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+           #endif
+        }
+
+        template <typename Predicate>
+        bool waitFor (Predicate isReady, int timeoutMs) noexcept
+        {
+            if (isReady())
+                return true;
+
+            auto endTime = Time::getMillisecondCounterHiRes() + timeoutMs;
+
+            for (;;)
+            {
+                auto currentCount = count.load();
+                ++numWaiters;
+
+                if (! isReady())
+                {
+                    auto msLeft = timeoutMs < 0 ? 100.0 : jmin (100.0, endTime - Time::getMillisecondCounterHiRes());
+
+                    if (msLeft > 0)
+                    {
+                       #if JUCE_LINUX
+                        struct timespec timeout;
+                        timeout.tv_sec = (time_t) (msLeft / 1000.0);
+                        timeout.tv_nsec = (long) ((msLeft - (double) timeout.tv_sec * 1000.0) * 1.0e6);
+                        syscall (SYS_futex, &count, FUTEX_WAIT, currentCount, &timeout, nullptr, 0);
+                       #else
+                        ignoreUnused (currentCount);
+                        Thread::sleep (1);
+                       #endif
+                    }
+                }
+
+                --numWaiters;
+
+                if (isReady())
+                    return true;
+
+                if (timeoutMs >= 0 && Time::getMillisecondCounterHiRes() >= endTime)
+                    return false;
+            }
+        }
+    };
+
+    struct Ring
+    {
+        // each of these is written by a different process, so they're kept on separate cache lines
+        alignas (64) std::atomic<uint64> writePosition;
+        Signal dataWritten;
+        alignas (64) std::atomic<uint64> readPosition;
+        Signal dataRead;
+    };
+
+    enum EndState : uint32 { notConnectedYet = 0, connected, closed };
+
+    struct Header
+    {
+        std::atomic<uint32> magic;
+        uint32 ringSize;
+        std::atomic<uint32> endStates[2];
+        Ring rings[2];
+    };
+
+    enum
+    {
+        channelMagic = 0x4a534d31,
+        messageHeaderSize = 8,
+        skipMarker = 0xffffffff
+    };
+
+    //==============================================================================
+    static File getFile (const String& channelName)
+    {
+       #if JUCE_LINUX
+        File sharedMemoryFolder ("/dev/shm");
+
+        if (sharedMemoryFolder.isDirectory())
+            return sharedMemoryFolder.getChildFile ("juce_ipc_" + File::createLegalFileName (channelName));
+       #endif
+
+        return File::getSpecialLocation (File::tempDirectory).getChildFile ("juce_ipc_" + File::createLegalFileName (channelName));
+    }
+
+    static size_t getDataOffset() noexcept      { return (sizeof (Header) + 63) & ~(size_t) 63; }
+
+    static SharedMemoryChannel* create (const String& channelName, int bufferSizeBytes)
+    {
+        auto ringSize = (uint32) nextPowerOfTwo (jmax (4096, bufferSizeBytes));
+        auto totalSize = getDataOffset() + 2 * (size_t) ringSize;
+        auto file = getFile (channelName);
+
+        {
+            const MemoryBlock zeros (totalSize, true);
+
+            if (! file.replaceWithData (zeros.getData(), zeros.getSize()))
+                return nullptr;
+        }
+
+        std::unique_ptr<SharedMemoryChannel> channel (new SharedMemoryChannel (file, 0));
+
+        if (channel->header == nullptr)
+            return nullptr;
+
+        auto* header = new (channel->mappedFile->getData()) Header();
+        header->ringSize = ringSize;
+        header->endStates[0] = connected;
+        header->magic.store ((uint32) channelMagic, std::memory_order_release);
+        channel->initialiseRings();
+        return channel.release();
+    }
+
+    static SharedMemoryChannel* connect (const String& channelName, int timeoutMs)
+    {
+        auto file = getFile (channelName);
+        auto endTime = Time::getMillisecondCounter() + (uint32) timeoutMs;
+
+        for (;;)
+        {
+            if (file.getSize() > (int64) getDataOffset())
+            {
+                std::unique_ptr<SharedMemoryChannel> channel (new SharedMemoryChannel (file, 1));
+
+                if (channel->header != nullptr
+                     && channel->header->magic.load (std::memory_order_acquire) == (uint32) channelMagic
+                     && channel->mappedFile->getSize() >= getDataOffset() + 2 * (size_t) channel->header->ringSize
+                     && channel->header->endStates[0] == connected
+                     && channel->header->endStates[1] == notConnectedYet)
+                {
+                    channel->header->endStates[1] = connected;
+                    channel->initialiseRings();
+                    return channel.release();
+                }
+            }
+
+            if (timeoutMs >= 0 && Time::getMillisecondCounter() >= endTime)
+                return nullptr;
+
+            Thread::sleep (2);
+        }
+    }
+
+    ~SharedMemoryChannel()
+    {
+        close();
+        mappedFile.reset();
+
+        if (endIndex == 0)
+            file.deleteFile();
+    }
+
+    //==============================================================================
+    bool isOpen() const noexcept
+    {
+        return header->endStates[endIndex] == connected
+                && header->endStates[1 - endIndex] != closed;
+    }
+
+    void close() noexcept
+    {
+        if (header != nullptr && header->endStates[endIndex].exchange (closed) != closed)
+        {
+            // wake up anything that's waiting on either end
+            for (auto& ring : header->rings)
+            {
+                ring.dataWritten.signal();
+                ring.dataRead.signal();
+            }
+        }
+    }
+
+    bool write (const void* data, size_t numBytes, int timeoutMs)
+    {
+        auto ringSize = (uint64) header->ringSize;
+        auto numNeeded = getSpaceNeeded (numBytes);
+
+        // Messages have to be less than half the size of the buffer - if you need to send bigger ones,
+        // create the channel with a bigger buffer!
+        if (numNeeded > ringSize / 2)
+        {
+            jassertfalse;
+            return false;
+        }
+
+        auto& ring = *sendRing;
+        auto writePos = ring.writePosition.load (std::memory_order_relaxed);
+        auto spaceBeforeEnd = ringSize - (writePos & (ringSize - 1));
+        auto numToSkip = numNeeded > spaceBeforeEnd ? spaceBeforeEnd : 0;
+
+        auto hasSpace = [&]
+        {
+            return writePos + numToSkip + numNeeded - ring.readPosition.load (std::memory_order_acquire) <= ringSize;
+        };
+
+        if (! ring.dataRead.waitFor ([&] { return hasSpace() || ! isOpen(); }, timeoutMs) || ! isOpen())
+            return false;
+
+        if (numToSkip != 0)
+        {
+            writeMessageHeader (sendData + (writePos & (ringSize - 1)), (uint32) skipMarker);
+            writePos += numToSkip;
+        }
+
+        auto* dest = sendData + (writePos & (ringSize - 1));
+        writeMessageHeader (dest, (uint32) numBytes);
+        memcpy (dest + messageHeaderSize, data, numBytes);
+
+        ring.writePosition.store (writePos + numNeeded, std::memory_order_release);
+        ring.dataWritten.signal();
+        return true;
+    }
+
+    // Waits for up to timeoutMs for some messages, and passes each of them to the callback.
+    // Returns false if the other end has disconnected.
+    template <typename Callback>
+    bool read (int timeoutMs, Callback&& callback)
+    {
+        auto& ring = *receiveRing;
+        auto ringSize = (uint64) header->ringSize;
+        auto readPos = ring.readPosition.load (std::memory_order_relaxed);
+
+        auto hasData = [&] { return ring.writePosition.load (std::memory_order_acquire) != readPos; };
+
+        if (! ring.dataWritten.waitFor ([&] { return hasData() || ! isOpen(); }, timeoutMs))
+            return isOpen();
+
+        while (hasData())
+        {
+            auto* source = receiveData + (readPos & (ringSize - 1));
+            auto size = *reinterpret_cast<const uint32*> (source);
+
+            if (size == (uint32) skipMarker)
+            {
+                readPos += ringSize - (readPos & (ringSize - 1));
+            }
+            else
+            {
+                callback (static_cast<const void*> (source + messageHeaderSize), (size_t) size);
+                readPos += getSpaceNeeded (size);
+            }
+
+            ring.readPosition.store (readPos, std::memory_order_release);
+            ring.dataRead.signal();
+        }
+
+        return isOpen();
+    }
+
+private:
+    SharedMemoryChannel (const File& f, int index)  : file (f), endIndex (index)
+    {
+        mappedFile.reset (new MemoryMappedFile (file, MemoryMappedFile::readWrite));
+
+        if (mappedFile->getData() != nullptr && mappedFile->getSize() >= getDataOffset())
+            header = static_cast<Header*> (mappedFile->getData());
+    }
+
+    void initialiseRings() noexcept
+    {
+        auto* ringData = static_cast<uint8*> (mappedFile->getData()) + getDataOffset();
+        auto* otherRingData = ringData + header->ringSize;
+
+        // the creator sends on ring 0, and the other end sends on ring 1
+        sendRing    = header->rings + endIndex;
+        receiveRing = header->rings + (1 - endIndex);
+        sendData    = endIndex == 0 ? ringData : otherRingData;
+        receiveData = endIndex == 0 ? otherRingData : ringData;
+    }
+
+    static uint64 getSpaceNeeded (size_t numBytes) noexcept
+    {
+        return ((uint64) numBytes + messageHeaderSize + 7) & ~(uint64) 7;
+    }
+
+    // (both ends are on the same machine, so the header can just be a native-endian size)
+    static void writeMessageHeader (uint8* dest, uint32 size) noexcept
+    {
+        auto* words = reinterpret_cast<uint32*> (dest);
+        words[0] = size;
+        words[1] = 0;
+    }
+
+    File file;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    Header* header = nullptr;
+    const int endIndex;
+    Ring* sendRing = nullptr;
+    Ring* receiveRing = nullptr;
+    uint8* sendData = nullptr;
+    uint8* receiveData = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (SharedMemoryChannel)
+};
+
 //==============================================================================
 InterprocessConnection::InterprocessConnection (bool callbacksOnMessageThread, uint32 magicMessageHeaderNumber)
     : useMessageThread (callbacksOnMessageThread),
@@ -103,14 +418,46 @@ bool InterprocessConnection::createPipe (const String& pipeName, int timeoutMs,
     return false;
 }
 
+bool InterprocessConnection::createSharedMemoryChannel (const String& channelName, int bufferSizeBytes, int sendTimeoutMs)
+{
+    disconnect();
+
+    if (auto* channel = SharedMemoryChannel::create (channelName, bufferSizeBytes))
+    {
+        const ScopedLock sl (pipeAndSocketLock);
+        initialiseWithSharedMemory (channel, sendTimeoutMs);
+        return true;
+    }
+
+    return false;
+}
+
+bool InterprocessConnection::connectToSharedMemoryChannel (const String& channelName, int connectionTimeoutMs, int sendTimeoutMs)
+{
+    disconnect();
+
+    if (auto* channel = SharedMemoryChannel::connect (channelName, connectionTimeoutMs))
+    {
+        const ScopedLock sl (pipeAndSocketLock);
+        initialiseWithSharedMemory (channel, sendTimeoutMs);
+        return true;
+    }
+
+    return false;
+}
+
 void InterprocessConnection::disconnect()
 {
     thread->signalThreadShouldExit();
 
+    if (reactor != nullptr && socket != nullptr)
+        (*reactor)->removeSocket (*socket);
+
     {
         const ScopedLock sl (pipeAndSocketLock);
-        if (socket != nullptr)  socket->close();
-        if (pipe != nullptr)    pipe->close();
+        if (socket != nullptr)          socket->close();
+        if (pipe != nullptr)            pipe->close();
+        if (sharedMemory != nullptr)    sharedMemory->close();
     }
 
     thread->stopThread (4000);
@@ -123,6 +470,7 @@ void InterprocessConnection::deletePipeAndSocket()
     const ScopedLock sl (pipeAndSocketLock);
     socket.reset();
     pipe.reset();
+    sharedMemory.reset();
 }
 
 bool InterprocessConnection::isConnected() const
@@ -130,7 +478,8 @@ bool InterprocessConnection::isConnected() const
     const ScopedLock sl (pipeAndSocketLock);
 
     return ((socket != nullptr && socket->isConnected())
-              || (pipe != nullptr && pipe->isOpen()))
+              || (pipe != nullptr && pipe->isOpen())
+              || (sharedMemory != nullptr && sharedMemory->isOpen()))
             && threadIsRunning;
 }
 
@@ -139,7 +488,7 @@ String InterprocessConnection::getConnectedHostName() const
     {
         const ScopedLock sl (pipeAndSocketLock);
 
-        if (pipe == nullptr && socket == nullptr)
+        if (pipe == nullptr && socket == nullptr && sharedMemory == nullptr)
             return {};
 
         if (socket != nullptr && ! socket->isLocal())
@@ -152,12 +501,24 @@ String InterprocessConnection::getConnectedHostName() const
 //==============================================================================
 bool InterprocessConnection::sendMessage (const MemoryBlock& message)
 {
+    return sendMessage (message.getData(), message.getSize());
+}
+
+bool InterprocessConnection::sendMessage (const void* data, size_t numBytes)
+{
+    {
+        const ScopedLock sl (pipeAndSocketLock);
+
+        if (sharedMemory != nullptr)
+            return sharedMemory->write (data, numBytes, pipeReceiveMessageTimeout);
+    }
+
     uint32 messageHeader[2] = { ByteOrder::swapIfBigEndian (magicMessageHeader),
-                                ByteOrder::swapIfBigEndian ((uint32) message.getSize()) };
+                                ByteOrder::swapIfBigEndian ((uint32) numBytes) };
 
-    MemoryBlock messageData (sizeof (messageHeader) + message.getSize());
+    MemoryBlock messageData (sizeof (messageHeader) + numBytes);
     messageData.copyFrom (messageHeader, 0, sizeof (messageHeader));
-    messageData.copyFrom (message.getData(), sizeof (messageHeader), message.getSize());
+    messageData.copyFrom (data, sizeof (messageHeader), numBytes);
 
     return writeData (messageData.getData(), (int) messageData.getSize()) == (int) messageData.getSize();
 }
@@ -183,6 +544,21 @@ void InterprocessConnection::initialiseWithSocket (StreamingSocket* newSocket)
 
     threadIsRunning = true;
     connectionMadeInt();
+
+    // Connections that post their callbacks to the message thread can share the reactor's
+    // threads, rather than each needing a thread of their own to wait for incoming data.
+    if (useMessageThread)
+    {
+        if (reactor == nullptr)
+            reactor.reset (new SharedResourcePointer<SocketReactor>());
+
+        numIncomingBytes = 0;
+
+        if ((*reactor)->addSocket (*socket, SocketReactor::readyForReading,
+                                   [this] (int) { return readFromReactor(); }))
+            return;
+    }
+
     thread->startThread();
 }
 
@@ -196,6 +572,17 @@ void InterprocessConnection::initialiseWithPipe (NamedPipe* newPipe)
     thread->startThread();
 }
 
+void InterprocessConnection::initialiseWithSharedMemory (SharedMemoryChannel* newChannel, int sendTimeoutMs)
+{
+    jassert (socket == nullptr && pipe == nullptr && sharedMemory == nullptr);
+    sharedMemory.reset (newChannel);
+    pipeReceiveMessageTimeout = sendTimeoutMs;
+
+    threadIsRunning = true;
+    connectionMadeInt();
+    thread->startThread();
+}
+
 //==============================================================================
 struct ConnectionStateMessage  : public MessageManager::MessageBase
 {
@@ -262,6 +649,11 @@ struct DataDeliveryMessage  : public Message
     MemoryBlock data;
 };
 
+void InterprocessConnection::messageDataReceived (const void* data, size_t numBytes)
+{
+    messageReceived (MemoryBlock (data, numBytes));
+}
+
 void InterprocessConnection::deliverDataInt (const MemoryBlock& data)
 {
     jassert (callbackConnectionState);
@@ -333,10 +725,86 @@ bool InterprocessConnection::readNextMessage()
     return false;
 }
 
+// Called by the reactor each time the socket has some data, so this reads whatever is
+// available and picks up where it left off next time.
+bool InterprocessConnection::readFromReactor()
+{
+    const int headerSize = (int) sizeof (incomingHeader);
+    const bool readingHeader = numIncomingBytes < headerSize;
+
+    auto bytesIn = socket->read (readingHeader ? addBytesToPointer (incomingHeader, numIncomingBytes)
+                                               : addBytesToPointer (incomingMessage.getData(), numIncomingBytes - headerSize),
+                                 readingHeader ? headerSize - numIncomingBytes
+                                               : jmin (65536, headerSize + (int) incomingMessage.getSize() - numIncomingBytes),
+                                 false);
+
+    if (bytesIn <= 0)
+    {
+        // the socket is only closed here, as disconnect() may be using it from another thread
+        (*reactor)->removeSocket (*socket);
+        socket->close();
+        threadIsRunning = false;
+        connectionLostInt();
+        return false;
+    }
+
+    numIncomingBytes += bytesIn;
+
+    if (numIncomingBytes == headerSize)
+    {
+        if (ByteOrder::swapIfBigEndian (incomingHeader[0]) != magicMessageHeader)
+        {
+            threadIsRunning = false;
+            return false;
+        }
+
+        auto bytesInMessage = (int) ByteOrder::swapIfBigEndian (incomingHeader[1]);
+
+        if (bytesInMessage > 0)
+            incomingMessage.setSize ((size_t) bytesInMessage);
+        else
+            numIncomingBytes = 0;
+    }
+    else if (numIncomingBytes == headerSize + (int) incomingMessage.getSize())
+    {
+        deliverDataInt (incomingMessage);
+        numIncomingBytes = 0;
+    }
+
+    return true;
+}
+
+// Called repeatedly by the connection's thread, to wait for and deliver any messages that
+// arrive through a shared-memory channel.
+bool InterprocessConnection::readFromSharedMemory()
+{
+    return sharedMemory->read (100, [this] (const void* data, size_t numBytes)
+    {
+        jassert (callbackConnectionState);
+
+        if (useMessageThread)
+            (new DataDeliveryMessage (this, MemoryBlock (data, numBytes)))->post();
+        else
+            messageDataReceived (data, numBytes);
+    });
+}
+
 void InterprocessConnection::runThread()
 {
     while (! thread->threadShouldExit())
     {
+        if (sharedMemory != nullptr)
+        {
+            if (! readFromSharedMemory())
+            {
+                deletePipeAndSocket();
+                connectionLostInt();
+                break;
+            }
+
+            continue;
+        }
+
         if (socket != nullptr)
         {
             auto ready = socket->waitUntilReady (true, 100);
@@ -30,7 +30,7 @@ class MemoryBlock;
 //==============================================================================
 /**
     Manages a simple two-way messaging connection to another process, using either
-    a socket or a named pipe as the transport medium.
+    a socket, a named pipe or a block of shared memory as the transport medium.
 
     To connect to a waiting socket or an open pipe, use the connectToSocket() or
     connectToPipe() methods. If this succeeds, messages can be sent to the other end,
@@ -40,6 +40,11 @@ class MemoryBlock;
     To open a pipe and wait for another client to connect to it, use the createPipe()
     method.
 
+    For two processes on the same machine that need to move a lot of data, the
+    createSharedMemoryChannel() and connectToSharedMemoryChannel() methods set up a
+    connection that passes messages through a pair of ring buffers in shared memory,
+    so that the data never has to go through the kernel.
+
     To act as a socket server and create connections for one or more client, see the
     InterprocessConnectionServer class.
 
@@ -117,10 +122,40 @@ public:
     */
     bool createPipe (const String& pipeName, int pipeReceiveMessageTimeoutMs, bool mustNotExist = false);
 
-    /** Disconnects and closes any currently-open sockets or pipes. */
+    /** Creates a shared-memory channel for another process on this machine to connect to.
+
+        The other process must call connectToSharedMemoryChannel() with the same name. Messages
+        sent before it connects will wait in the buffer until it does.
+
+        Each direction has a ring buffer of bufferSizeBytes (rounded up to a power of two), and
+        a single message can't be bigger than half of this. When the buffer is full, sendMessage()
+        waits for up to sendTimeoutMs for space (or indefinitely if this is -1).
+
+        Incoming messages are always read by the connection's own thread. If callbacks aren't made on
+        the message thread, they're delivered with messageDataReceived(), which can read the data
+        directly from the shared memory without copying it.
+
+        On Linux, the two ends wake each other using futexes. Other platforms poll for new data at
+        short intervals, so their latency is higher.
+
+        @see connectToSharedMemoryChannel, messageDataReceived
+    */
+    bool createSharedMemoryChannel (const String& channelName, int bufferSizeBytes, int sendTimeoutMs = -1);
+
+    /** Connects to a shared-memory channel that another process has created with
+        createSharedMemoryChannel().
+
+        If the channel doesn't exist yet, this waits for up to connectionTimeoutMs for it to appear.
+        The sendTimeoutMs parameter has the same meaning as for createSharedMemoryChannel().
+
+        @see createSharedMemoryChannel
+    */
+    bool connectToSharedMemoryChannel (const String& channelName, int connectionTimeoutMs, int sendTimeoutMs = -1);
+
+    /** Disconnects and closes any currently-open sockets, pipes or shared-memory channels. */
     void disconnect();
 
-    /** True if a socket or pipe is currently active. */
+    /** True if a socket, pipe or shared-memory channel is currently active. */
     bool isConnected() const;
 
     /** Returns the socket that this connection is using (or nullptr if it uses a pipe). */
@@ -145,6 +180,12 @@ public:
     */
     bool sendMessage (const MemoryBlock& message);
 
+    /** Tries to send a block of data as a message to the other end of this connection.
+        This is the same as the other version of sendMessage(), but saves you from having to
+        copy your data into a MemoryBlock first.
+    */
+    bool sendMessage (const void* messageData, size_t numBytes);
+
     //==============================================================================
     /** Called when the connection is first connected.
 
@@ -175,26 +216,47 @@ public:
     */
     virtual void messageReceived (const MemoryBlock& message) = 0;
 
+    /** Called instead of messageReceived() for messages that arrive through a shared-memory
+        channel, if callbacks aren't being made on the message thread.
+
+        The data points directly into the shared memory, and is only valid until this method
+        returns. The default implementation copies it into a MemoryBlock and passes that to
+        messageReceived(), so you only need to override this if you want to avoid the copy.
+
+        @see createSharedMemoryChannel
+    */
+    virtual void messageDataReceived (const void* messageData, size_t numBytes);
+
 
 private:
     //==============================================================================
     CriticalSection pipeAndSocketLock;
     std::unique_ptr<StreamingSocket> socket;
     std::unique_ptr<NamedPipe> pipe;
+    struct SharedMemoryChannel;
+    std::unique_ptr<SharedMemoryChannel> sharedMemory;
     bool callbackConnectionState = false;
     const bool useMessageThread;
     const uint32 magicMessageHeader;
     int pipeReceiveMessageTimeout = -1;
 
+    std::unique_ptr<SharedResourcePointer<SocketReactor>> reactor;
+    uint32 incomingHeader[2];
+    MemoryBlock incomingMessage;
+    int numIncomingBytes = 0;
+
     friend class InterprocessConnectionServer;
     void initialiseWithSocket (StreamingSocket*);
     void initialiseWithPipe (NamedPipe*);
+    void initialiseWithSharedMemory (SharedMemoryChannel*, int sendTimeoutMs);
+    bool readFromSharedMemory();
     void deletePipeAndSocket();
     void connectionMadeInt();
     void connectionLostInt();
     void deliverDataInt (const MemoryBlock&);
     bool readNextMessage();
     int readData (void*, int);
+    bool readFromReactor();
 
     struct ConnectionThread;
     std::unique_ptr<ConnectionThread> thread;
@@ -32,7 +32,11 @@ namespace juce
     method, so that it creates suitable connection objects for each client that tries
     to connect.
 
-    @see InterprocessConnection
+    Connections that were created with callbacksOnMessageThread set to true don't get a
+    thread each: instead, they all share the threads of a SocketReactor, which waits for
+    data to arrive on any of them.
+
+    @see InterprocessConnection, SocketReactor
 
     @tags{Events}
 */
@@ -51,6 +51,8 @@
 
 #elif JUCE_LINUX
  #include <unistd.h>
+ #include <sys/syscall.h>
+ #include <linux/futex.h>
 #endif
 
 //==============================================================================
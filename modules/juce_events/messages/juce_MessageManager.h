@@ -194,6 +194,11 @@ public:
 
         using Ptr = ReferenceCountedObjectPtr<MessageBase>;
 
+    private:
+        // lets a native message queue link its pending messages together without allocating
+        MessageBase* nextQueuedMessage = nullptr;
+        friend class InternalMessageQueue;
+
         JUCE_DECLARE_NON_COPYABLE (MessageBase)
     };
 
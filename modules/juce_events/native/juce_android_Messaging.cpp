@@ -101,6 +101,7 @@ private:
             if (message == nullptr)
                 break;
 
+            JUCE_TRACE_SCOPE ("MessageManager::dispatch");
             message->messageCallback();
         }
     }
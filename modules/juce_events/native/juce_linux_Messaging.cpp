@@ -33,37 +33,33 @@ namespace juce
 {
 
 //==============================================================================
+/*  Messages can be posted from any thread, so they're pushed onto a lock-free stack, and
+    the message thread takes the whole stack at once and reverses it to get them in order.
+    The eventfd that wakes up the loop only needs to be signalled when the stack goes from
+    empty to non-empty, so a burst of posted messages costs just one system call.
+*/
 class InternalMessageQueue
 {
 public:
     InternalMessageQueue()
     {
-        auto ret = ::socketpair (AF_LOCAL, SOCK_STREAM, 0, fd);
-        ignoreUnused (ret); jassert (ret == 0);
+        jassert (wakeFd >= 0);
 
-        auto internalQueueCb = [this] (int _fd)
+        auto internalQueueCb = [this] (int)
         {
-            if (const MessageManager::MessageBase::Ptr msg = this->popNextMessage (_fd))
-            {
-                JUCE_TRY
-                {
-                    msg->messageCallback();
-                    return true;
-                }
-                JUCE_CATCH_EXCEPTION
-            }
-            return false;
+            return this->dispatchPendingMessages();
         };
 
-        pfds[INTERNAL_QUEUE_FD].fd = getReadHandle();
+        pfds[INTERNAL_QUEUE_FD].fd = wakeFd;
         pfds[INTERNAL_QUEUE_FD].events = POLLIN;
         readCallback[INTERNAL_QUEUE_FD].reset (new LinuxEventLoop::CallbackFunction<decltype(internalQueueCb)> (internalQueueCb));
     }
 
     ~InternalMessageQueue()
     {
-        close (getReadHandle());
-        close (getWriteHandle());
+        releaseMessages (pendingMessages.exchange (nullptr));
+        releaseMessages (messagesToDispatch);
+        close (wakeFd);
 
         clearSingletonInstance();
     }
@@ -71,18 +67,20 @@ public:
     //==============================================================================
     void postMessage (MessageManager::MessageBase* const msg) noexcept
     {
-        ScopedLock sl (lock);
-        queue.add (msg);
+        msg->incReferenceCount();
 
-        const int maxBytesInSocketQueue = 128;
+        auto* head = pendingMessages.load (std::memory_order_relaxed);
 
-        if (bytesInSocket < maxBytesInSocketQueue)
+        do
         {
-            bytesInSocket++;
+            msg->nextQueuedMessage = head;
+        }
+        while (! pendingMessages.compare_exchange_weak (head, msg, std::memory_order_release, std::memory_order_relaxed));
 
-            ScopedUnlock ul (lock);
-            const unsigned char x = 0xff;
-            ssize_t bytesWritten = write (getWriteHandle(), &x, 1);
+        if (head == nullptr)
+        {
+            const uint64 one = 1;
+            ssize_t bytesWritten = write (wakeFd, &one, sizeof (one));
             ignoreUnused (bytesWritten);
         }
     }
@@ -136,32 +134,71 @@ public:
 
 private:
     CriticalSection lock;
-    ReferenceCountedArray <MessageManager::MessageBase> queue;
-    int fd[2];
+    std::atomic<MessageManager::MessageBase*> pendingMessages { nullptr };
+    MessageManager::MessageBase* messagesToDispatch = nullptr; // only used by the message thread
+    int wakeFd = eventfd (0, EFD_NONBLOCK | EFD_CLOEXEC);
     pollfd pfds[FD_COUNT];
     std::unique_ptr<LinuxEventLoop::CallbackFunctionBase> readCallback[FD_COUNT];
     int fdCount = 1;
     int loopCount = 0;
-    int bytesInSocket = 0;
 
-    int getWriteHandle() const noexcept     { return fd[0]; }
-    int getReadHandle() const noexcept      { return fd[1]; }
+    static void releaseMessages (MessageManager::MessageBase* msg) noexcept
+    {
+        while (msg != nullptr)
+        {
+            auto* next = msg->nextQueuedMessage;
+            msg->decReferenceCount();
+            msg = next;
+        }
+    }
+
+    void takePendingMessages() noexcept
+    {
+        // the eventfd has to be cleared first, so that anything posted after the messages
+        // have been taken will signal it again
+        uint64 numSignals;
+        ssize_t numBytes = read (wakeFd, &numSignals, sizeof (numSignals));
+        ignoreUnused (numBytes);
+
+        auto* msg = pendingMessages.exchange (nullptr, std::memory_order_acquire);
+
+        while (msg != nullptr)
+        {
+            auto* next = msg->nextQueuedMessage;
+            msg->nextQueuedMessage = messagesToDispatch;
+            messagesToDispatch = msg;
+            msg = next;
+        }
+    }
 
-    MessageManager::MessageBase::Ptr popNextMessage (int _fd) noexcept
+    bool dispatchPendingMessages()
     {
-        const ScopedLock sl (lock);
+        if (messagesToDispatch == nullptr)
+            takePendingMessages();
+
+        if (messagesToDispatch == nullptr)
+            return false;
 
-        if (bytesInSocket > 0)
+        // Dispatches the whole batch, unless the loop's being stopped, in which case this goes back
+        // to delivering one message per call so the loop can exit as soon as it's told to quit.
+        // Each message is unlinked before its callback, because it may re-enter the loop.
+        do
         {
-            --bytesInSocket;
+            const MessageManager::MessageBase::Ptr msg (messagesToDispatch);
+            messagesToDispatch = msg->nextQueuedMessage;
+            msg->nextQueuedMessage = nullptr;
+            msg->decReferenceCount();
 
-            const ScopedUnlock ul (lock);
-            unsigned char x;
-            ssize_t numBytes = read (_fd, &x, 1);
-            ignoreUnused (numBytes);
+            JUCE_TRY
+            {
+                JUCE_TRACE_SCOPE ("MessageManager::dispatch");
+                msg->messageCallback();
+            }
+            JUCE_CATCH_EXCEPTION
         }
+        while (messagesToDispatch != nullptr && ! MessageManager::getInstance()->hasStopMessageBeenSent());
 
-        return queue.removeAndReturn (0);
+        return true;
     }
 };
 
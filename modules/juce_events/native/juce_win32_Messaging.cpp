@@ -50,6 +50,7 @@ namespace WindowsMessageHelpers
         {
             JUCE_TRY
             {
+                JUCE_TRACE_SCOPE ("MessageManager::dispatch");
                 message->messageCallback();
             }
             JUCE_CATCH_EXCEPTION
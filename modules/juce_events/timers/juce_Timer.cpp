@@ -49,17 +49,11 @@ public:
 
     void run() override
     {
-        auto lastTime = Time::getMillisecondCounter();
         ReferenceCountedObjectPtr<CallTimersMessage> messageToSend (new CallTimersMessage());
 
         while (! threadShouldExit())
         {
-            auto now = Time::getMillisecondCounter();
-            auto elapsed = (int) (now >= lastTime ? (now - lastTime)
-                                                  : (std::numeric_limits<uint32>::max() - (lastTime - now)));
-            lastTime = now;
-
-            auto timeUntilFirstTimer = getTimeUntilFirstTimer (elapsed);
+            auto timeUntilFirstTimer = getTimeUntilFirstTimer();
 
             if (timeUntilFirstTimer <= 0)
             {
@@ -95,16 +89,17 @@ public:
 
         const LockType::ScopedLockType sl (lock);
 
+        auto now = updateCurrentTime();
+
         while (! timers.empty())
         {
             auto& first = timers.front();
 
-            if (first.countdownMs > 0)
+            if (first.deadlineMs > now)
                 break;
 
             auto* timer = first.timer;
-            first.countdownMs = timer->timerPeriodMs;
-            shuffleTimerBackInQueue (0);
+            reschedule (0, now + timer->timerPeriodMs);
             notify();
 
             const LockType::ScopedUnlockType ul (lock);
@@ -160,13 +155,20 @@ public:
     static LockType lock;
 
 private:
-    struct TimerCountdown
+    // The timers are kept in a binary heap ordered by their deadlines, so adding, removing
+    // or restarting one is O(log n), and finding the next one to fire is O(1). Timers with
+    // the same deadline fire in the order they were scheduled.
+    struct TimerDeadline
     {
         Timer* timer;
-        int countdownMs;
+        int64 deadlineMs;
+        uint64 order;
     };
 
-    std::vector<TimerCountdown> timers;
+    std::vector<TimerDeadline> timers;
+    int64 currentTimeMs = 0;
+    uint32 lastCounterValue = Time::getMillisecondCounter();
+    uint64 nextOrder = 0;
 
     WaitableEvent callbackArrived;
 
@@ -182,18 +184,34 @@ private:
     };
 
     //==============================================================================
+    // (the lock must be held when calling any of these)
+    int64 updateCurrentTime() noexcept
+    {
+        // calling this regularly also helps keep Time::getApproximateMillisecondCounter() up-to-date
+        auto counter = Time::getMillisecondCounter();
+        auto elapsed = counter - lastCounterValue;
+
+        if (elapsed < 0x80000000u)
+        {
+            currentTimeMs += elapsed;
+            lastCounterValue = counter;
+        }
+
+        return currentTimeMs;
+    }
+
     void addTimer (Timer* t)
     {
         // Trying to add a timer that's already here - shouldn't get to this point,
         // so if you get this assertion, let me know!
         jassert (std::find_if (timers.begin(), timers.end(),
-                               [t](TimerCountdown i) { return i.timer == t; }) == timers.end());
+                               [t](const TimerDeadline& i) { return i.timer == t; }) == timers.end());
 
         auto pos = timers.size();
 
-        timers.push_back ({ t, t->timerPeriodMs });
+        timers.push_back ({ t, updateCurrentTime() + t->timerPeriodMs, nextOrder++ });
         t->positionInQueue = pos;
-        shuffleTimerForwardInQueue (pos);
+        siftUp (pos);
         notify();
     }
 
@@ -205,13 +223,20 @@ private:
         jassert (pos <= lastIndex);
         jassert (timers[pos].timer == t);
 
-        for (auto i = pos; i < lastIndex; ++i)
+        if (pos != lastIndex)
         {
-            timers[i] = timers[i + 1];
-            timers[i].timer->positionInQueue = i;
-        }
+            placeTimer (pos, timers[lastIndex]);
+            timers.pop_back();
 
-        timers.pop_back();
+            if (pos > 0 && isEarlier (timers[pos], timers[(pos - 1) / 2]))
+                siftUp (pos);
+            else
+                siftDown (pos);
+        }
+        else
+        {
+            timers.pop_back();
+        }
     }
 
     void resetTimerCounter (Timer* t) noexcept
@@ -221,83 +246,88 @@ private:
         jassert (pos < timers.size());
         jassert (timers[pos].timer == t);
 
-        auto lastCountdown = timers[pos].countdownMs;
-        auto newCountdown = t->timerPeriodMs;
+        reschedule (pos, updateCurrentTime() + t->timerPeriodMs);
+        notify();
+    }
 
-        if (newCountdown != lastCountdown)
-        {
-            timers[pos].countdownMs = newCountdown;
+    static bool isEarlier (const TimerDeadline& a, const TimerDeadline& b) noexcept
+    {
+        return a.deadlineMs != b.deadlineMs ? a.deadlineMs < b.deadlineMs
+                                            : a.order < b.order;
+    }
 
-            if (newCountdown > lastCountdown)
-                shuffleTimerBackInQueue (pos);
-            else
-                shuffleTimerForwardInQueue (pos);
+    void placeTimer (size_t pos, const TimerDeadline& t) noexcept
+    {
+        timers[pos] = t;
+        t.timer->positionInQueue = pos;
+    }
 
-            notify();
-        }
+    void reschedule (size_t pos, int64 newDeadlineMs) noexcept
+    {
+        auto& t = timers[pos];
+        auto movedEarlier = newDeadlineMs < t.deadlineMs;
+        t.deadlineMs = newDeadlineMs;
+        t.order = nextOrder++;
+
+        if (movedEarlier)
+            siftUp (pos);
+        else
+            siftDown (pos);
     }
 
-    void shuffleTimerBackInQueue (size_t pos)
+    void siftUp (size_t pos) noexcept
     {
-        auto numTimers = timers.size();
+        auto t = timers[pos];
 
-        if (pos < numTimers - 1)
+        while (pos > 0)
         {
-            auto t = timers[pos];
-
-            for (;;)
-            {
-                auto next = pos + 1;
+            auto parent = (pos - 1) / 2;
 
-                if (next == numTimers || timers[next].countdownMs >= t.countdownMs)
-                    break;
-
-                timers[pos] = timers[next];
-                timers[pos].timer->positionInQueue = pos;
-
-                ++pos;
-            }
+            if (! isEarlier (t, timers[parent]))
+                break;
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+            placeTimer (pos, timers[parent]);
+            pos = parent;
         }
+
+        placeTimer (pos, t);
     }
 
-    void shuffleTimerForwardInQueue (size_t pos)
+    void siftDown (size_t pos) noexcept
     {
-        if (pos > 0)
-        {
-            auto t = timers[pos];
+        auto t = timers[pos];
+        auto numTimers = timers.size();
 
-            while (pos > 0)
-            {
-                auto& prev = timers[(size_t) pos - 1];
+        for (;;)
+        {
+            auto child = pos * 2 + 1;
 
-                if (prev.countdownMs <= t.countdownMs)
-                    break;
+            if (child >= numTimers)
+                break;
 
-                timers[pos] = prev;
-                timers[pos].timer->positionInQueue = pos;
+            if (child + 1 < numTimers && isEarlier (timers[child + 1], timers[child]))
+                ++child;
 
-                --pos;
-            }
+            if (! isEarlier (timers[child], t))
+                break;
 
-            timers[pos] = t;
-            t.timer->positionInQueue = pos;
+            placeTimer (pos, timers[child]);
+            pos = child;
         }
+
+        placeTimer (pos, t);
     }
 
-    int getTimeUntilFirstTimer (int numMillisecsElapsed)
+    int getTimeUntilFirstTimer()
     {
         const LockType::ScopedLockType sl (lock);
 
+        auto now = updateCurrentTime();
+
         if (timers.empty())
             return 1000;
 
-        for (auto& t : timers)
-            t.countdownMs -= numMillisecsElapsed;
-
-        return timers.front().countdownMs;
+        return (int) jlimit ((int64) -1, (int64) 1000, timers.front().deadlineMs - now);
     }
 
     void handleAsyncUpdate() override
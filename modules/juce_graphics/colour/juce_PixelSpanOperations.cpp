@@ -0,0 +1,373 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+namespace PixelSpanHelpers
+{
+    struct Scalar
+    {
+        static void blendColour (PixelARGB* dest, PixelARGB colour, int num) noexcept
+        {
+            for (int i = 0; i < num; ++i)
+                dest[i].blend (colour);
+        }
+
+        static void blendPixels (PixelARGB* dest, const PixelARGB* src, int num) noexcept
+        {
+            for (int i = 0; i < num; ++i)
+                dest[i].blend (src[i]);
+        }
+
+        static void blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept
+        {
+            for (int i = 0; i < num; ++i)
+                dest[i].blend (src[i], extraAlpha);
+        }
+
+        static void premultiply (PixelARGB* pixels, int num) noexcept
+        {
+            for (int i = 0; i < num; ++i)
+                pixels[i].premultiply();
+        }
+    };
+
+    /*  All the vector versions widen the components to 16 bits and then calculate
+        ((dest * (256 - srcAlpha)) >> 8) + src, which can't overflow, and saturate back
+        to 8 bits. That's exactly what the mask-and-clamp arithmetic in PixelARGB::blend()
+        does two components at a time.
+    */
+
+    //==============================================================================
+   #if JUCE_USE_SSE_INTRINSICS
+    struct SSE2
+    {
+        enum { alphaShuffle = _MM_SHUFFLE (PixelARGB::indexA, PixelARGB::indexA, PixelARGB::indexA, PixelARGB::indexA) };
+
+        static forcedinline __m128i inverseAlpha (__m128i s) noexcept
+        {
+            return _mm_sub_epi16 (_mm_set1_epi16 (0x100), _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (s, alphaShuffle), alphaShuffle));
+        }
+
+        static forcedinline __m128i blend (__m128i d, __m128i s, __m128i invAlpha) noexcept
+        {
+            return _mm_add_epi16 (_mm_srli_epi16 (_mm_mullo_epi16 (d, invAlpha), 8), s);
+        }
+
+        static void blendColour (PixelARGB* dest, PixelARGB colour, int num) noexcept
+        {
+            const auto zero = _mm_setzero_si128();
+            const auto s = _mm_unpacklo_epi8 (_mm_set1_epi32 ((int) colour.getNativeARGB()), zero);
+            const auto invAlpha = inverseAlpha (s);
+
+            for (; num >= 4; num -= 4, dest += 4)
+            {
+                auto d = _mm_loadu_si128 ((const __m128i*) dest);
+                auto lo = blend (_mm_unpacklo_epi8 (d, zero), s, invAlpha);
+                auto hi = blend (_mm_unpackhi_epi8 (d, zero), s, invAlpha);
+                _mm_storeu_si128 ((__m128i*) dest, _mm_packus_epi16 (lo, hi));
+            }
+
+            Scalar::blendColour (dest, colour, num);
+        }
+
+        template <bool scaleSource>
+        static void blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept
+        {
+            const auto zero = _mm_setzero_si128();
+            const auto extra = _mm_set1_epi16 ((short) extraAlpha);
+
+            for (; num >= 4; num -= 4, dest += 4, src += 4)
+            {
+                auto s = _mm_loadu_si128 ((const __m128i*) src);
+                auto d = _mm_loadu_si128 ((const __m128i*) dest);
+                auto sLo = _mm_unpacklo_epi8 (s, zero);
+                auto sHi = _mm_unpackhi_epi8 (s, zero);
+
+                if (scaleSource)
+                {
+                    sLo = _mm_srli_epi16 (_mm_mullo_epi16 (sLo, extra), 8);
+                    sHi = _mm_srli_epi16 (_mm_mullo_epi16 (sHi, extra), 8);
+                }
+
+                auto lo = blend (_mm_unpacklo_epi8 (d, zero), sLo, inverseAlpha (sLo));
+                auto hi = blend (_mm_unpackhi_epi8 (d, zero), sHi, inverseAlpha (sHi));
+                _mm_storeu_si128 ((__m128i*) dest, _mm_packus_epi16 (lo, hi));
+            }
+
+            if (scaleSource)
+                Scalar::blendPixels (dest, src, num, extraAlpha);
+            else
+                Scalar::blendPixels (dest, src, num);
+        }
+
+        static void blendPixels (PixelARGB* dest, const PixelARGB* src, int num) noexcept                     { blendPixels<false> (dest, src, num, 256); }
+        static void blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept { blendPixels<true>  (dest, src, num, extraAlpha); }
+
+        // Opaque pixels and the alpha components themselves are left as they are
+        static forcedinline __m128i premultiply (__m128i p, __m128i alphaLanes) noexcept
+        {
+            auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (p, alphaShuffle), alphaShuffle);
+            auto scaled = _mm_srli_epi16 (_mm_add_epi16 (_mm_mullo_epi16 (p, alpha), _mm_set1_epi16 (0x7f)), 8);
+            auto keep = _mm_or_si128 (_mm_cmpeq_epi16 (alpha, _mm_set1_epi16 (0xff)), alphaLanes);
+            return _mm_or_si128 (_mm_and_si128 (keep, p), _mm_andnot_si128 (keep, scaled));
+        }
+
+        static void premultiply (PixelARGB* pixels, int num) noexcept
+        {
+            const auto zero = _mm_setzero_si128();
+            const auto alphaLanes = _mm_unpacklo_epi8 (_mm_set1_epi32 ((int) (0xffu << (8 * PixelARGB::indexA))), zero);
+            const auto alphaMask = _mm_or_si128 (alphaLanes, _mm_slli_epi16 (alphaLanes, 8));
+
+            for (; num >= 4; num -= 4, pixels += 4)
+            {
+                auto p = _mm_loadu_si128 ((const __m128i*) pixels);
+                auto lo = premultiply (_mm_unpacklo_epi8 (p, zero), alphaMask);
+                auto hi = premultiply (_mm_unpackhi_epi8 (p, zero), alphaMask);
+                _mm_storeu_si128 ((__m128i*) pixels, _mm_packus_epi16 (lo, hi));
+            }
+
+            Scalar::premultiply (pixels, num);
+        }
+    };
+
+    using VectorOps = SSE2;
+
+    //==============================================================================
+   #elif JUCE_USE_ARM_NEON
+    struct NEON
+    {
+        // The de-interleaving loads give each component of 8 pixels its own register
+        static forcedinline uint8x8_t blend (uint8x8_t d, uint16x8_t s, uint16x8_t invAlpha) noexcept
+        {
+            return vqmovn_u16 (vaddq_u16 (vshrq_n_u16 (vmulq_u16 (vmovl_u8 (d), invAlpha), 8), s));
+        }
+
+        static void blendColour (PixelARGB* dest, PixelARGB colour, int num) noexcept
+        {
+            auto* c = reinterpret_cast<const uint8*> (&colour);
+            const uint16x8_t s[] = { vdupq_n_u16 (c[0]), vdupq_n_u16 (c[1]), vdupq_n_u16 (c[2]), vdupq_n_u16 (c[3]) };
+            const auto invAlpha = vsubq_u16 (vdupq_n_u16 (0x100), s[PixelARGB::indexA]);
+
+            for (; num >= 8; num -= 8, dest += 8)
+            {
+                auto d = vld4_u8 (reinterpret_cast<const uint8*> (dest));
+
+                for (int i = 0; i < 4; ++i)
+                    d.val[i] = blend (d.val[i], s[i], invAlpha);
+
+                vst4_u8 (reinterpret_cast<uint8*> (dest), d);
+            }
+
+            Scalar::blendColour (dest, colour, num);
+        }
+
+        template <bool scaleSource>
+        static void blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept
+        {
+            const auto extra = vdupq_n_u16 ((uint16) extraAlpha);
+
+            for (; num >= 8; num -= 8, dest += 8, src += 8)
+            {
+                auto sp = vld4_u8 (reinterpret_cast<const uint8*> (src));
+                auto d  = vld4_u8 (reinterpret_cast<const uint8*> (dest));
+                uint16x8_t s[4];
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    s[i] = vmovl_u8 (sp.val[i]);
+
+                    if (scaleSource)
+                        s[i] = vshrq_n_u16 (vmulq_u16 (s[i], extra), 8);
+                }
+
+                const auto invAlpha = vsubq_u16 (vdupq_n_u16 (0x100), s[PixelARGB::indexA]);
+
+                for (int i = 0; i < 4; ++i)
+                    d.val[i] = blend (d.val[i], s[i], invAlpha);
+
+                vst4_u8 (reinterpret_cast<uint8*> (dest), d);
+            }
+
+            if (scaleSource)
+                Scalar::blendPixels (dest, src, num, extraAlpha);
+            else
+                Scalar::blendPixels (dest, src, num);
+        }
+
+        static void blendPixels (PixelARGB* dest, const PixelARGB* src, int num) noexcept                     { blendPixels<false> (dest, src, num, 256); }
+        static void blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept { blendPixels<true>  (dest, src, num, extraAlpha); }
+
+        static void premultiply (PixelARGB* pixels, int num) noexcept
+        {
+            for (; num >= 8; num -= 8, pixels += 8)
+            {
+                auto p = vld4_u8 (reinterpret_cast<const uint8*> (pixels));
+                const auto alpha = vmovl_u8 (p.val[PixelARGB::indexA]);
+                const auto opaque = vceq_u8 (p.val[PixelARGB::indexA], vdup_n_u8 (0xff));
+
+                for (int i = 0; i < 4; ++i)
+                {
+                    if (i != PixelARGB::indexA)
+                    {
+                        auto scaled = vmovn_u16 (vshrq_n_u16 (vaddq_u16 (vmulq_u16 (vmovl_u8 (p.val[i]), alpha), vdupq_n_u16 (0x7f)), 8));
+                        p.val[i] = vbsl_u8 (opaque, p.val[i], scaled);
+                    }
+                }
+
+                vst4_u8 (reinterpret_cast<uint8*> (pixels), p);
+            }
+
+            Scalar::premultiply (pixels, num);
+        }
+    };
+
+    using VectorOps = NEON;
+
+   #else
+    using VectorOps = Scalar;
+   #endif
+
+    //==============================================================================
+   #if JUCE_USE_AVX_INTRINSICS
+    /*  Like the AVX2 FloatVectorOperations, these are compiled for AVX2 whatever the
+        compiler's target flags are, and are only called once the CPU has been checked.
+    */
+    #if JUCE_MSVC
+     #define JUCE_PIXEL_AVX_TARGET
+    #else
+     #define JUCE_PIXEL_AVX_TARGET __attribute__ ((target ("avx2")))
+    #endif
+
+    struct AVX2
+    {
+        enum { alphaShuffle = SSE2::alphaShuffle };
+
+        static forcedinline JUCE_PIXEL_AVX_TARGET __m256i inverseAlpha (__m256i s) noexcept
+        {
+            return _mm256_sub_epi16 (_mm256_set1_epi16 (0x100), _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (s, alphaShuffle), alphaShuffle));
+        }
+
+        static forcedinline JUCE_PIXEL_AVX_TARGET __m256i blend (__m256i d, __m256i s, __m256i invAlpha) noexcept
+        {
+            return _mm256_add_epi16 (_mm256_srli_epi16 (_mm256_mullo_epi16 (d, invAlpha), 8), s);
+        }
+
+        static JUCE_PIXEL_AVX_TARGET void blendColour (PixelARGB* dest, PixelARGB colour, int num) noexcept
+        {
+            const auto zero = _mm256_setzero_si256();
+            const auto s = _mm256_unpacklo_epi8 (_mm256_set1_epi32 ((int) colour.getNativeARGB()), zero);
+            const auto invAlpha = inverseAlpha (s);
+
+            for (; num >= 8; num -= 8, dest += 8)
+            {
+                auto d = _mm256_loadu_si256 ((const __m256i*) dest);
+                auto lo = blend (_mm256_unpacklo_epi8 (d, zero), s, invAlpha);
+                auto hi = blend (_mm256_unpackhi_epi8 (d, zero), s, invAlpha);
+                _mm256_storeu_si256 ((__m256i*) dest, _mm256_packus_epi16 (lo, hi));
+            }
+
+            _mm256_zeroupper();
+            SSE2::blendColour (dest, colour, num);
+        }
+
+        template <bool scaleSource>
+        static JUCE_PIXEL_AVX_TARGET void blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept
+        {
+            const auto zero = _mm256_setzero_si256();
+            const auto extra = _mm256_set1_epi16 ((short) extraAlpha);
+
+            for (; num >= 8; num -= 8, dest += 8, src += 8)
+            {
+                auto s = _mm256_loadu_si256 ((const __m256i*) src);
+                auto d = _mm256_loadu_si256 ((const __m256i*) dest);
+                auto sLo = _mm256_unpacklo_epi8 (s, zero);
+                auto sHi = _mm256_unpackhi_epi8 (s, zero);
+
+                if (scaleSource)
+                {
+                    sLo = _mm256_srli_epi16 (_mm256_mullo_epi16 (sLo, extra), 8);
+                    sHi = _mm256_srli_epi16 (_mm256_mullo_epi16 (sHi, extra), 8);
+                }
+
+                auto lo = blend (_mm256_unpacklo_epi8 (d, zero), sLo, inverseAlpha (sLo));
+                auto hi = blend (_mm256_unpackhi_epi8 (d, zero), sHi, inverseAlpha (sHi));
+                _mm256_storeu_si256 ((__m256i*) dest, _mm256_packus_epi16 (lo, hi));
+            }
+
+            _mm256_zeroupper();
+            SSE2::blendPixels<scaleSource> (dest, src, num, extraAlpha);
+        }
+    };
+
+    #undef JUCE_PIXEL_AVX_TARGET
+
+    // anything called before this has been initialised will simply use the SSE2 code
+    static const bool isAVXAvailable = SystemStats::hasAVX2();
+   #endif
+}
+
+//==============================================================================
+void JUCE_CALLTYPE PixelSpanOperations::blendColour (PixelARGB* dest, PixelARGB colour, int num) noexcept
+{
+   #if JUCE_USE_AVX_INTRINSICS
+    if (PixelSpanHelpers::isAVXAvailable)
+        return PixelSpanHelpers::AVX2::blendColour (dest, colour, num);
+   #endif
+
+    PixelSpanHelpers::VectorOps::blendColour (dest, colour, num);
+}
+
+void JUCE_CALLTYPE PixelSpanOperations::blendPixels (PixelARGB* dest, const PixelARGB* src, int num) noexcept
+{
+   #if JUCE_USE_AVX_INTRINSICS
+    if (PixelSpanHelpers::isAVXAvailable)
+        return PixelSpanHelpers::AVX2::blendPixels<false> (dest, src, num, 256);
+   #endif
+
+    PixelSpanHelpers::VectorOps::blendPixels (dest, src, num);
+}
+
+void JUCE_CALLTYPE PixelSpanOperations::blendPixels (PixelARGB* dest, const PixelARGB* src, int num, uint32 extraAlpha) noexcept
+{
+    jassert (extraAlpha <= 256);
+
+   #if JUCE_USE_AVX_INTRINSICS
+    if (PixelSpanHelpers::isAVXAvailable)
+        return PixelSpanHelpers::AVX2::blendPixels<true> (dest, src, num, extraAlpha);
+   #endif
+
+    PixelSpanHelpers::VectorOps::blendPixels (dest, src, num, extraAlpha);
+}
+
+void JUCE_CALLTYPE PixelSpanOperations::premultiply (PixelARGB* pixels, int num) noexcept
+{
+    PixelSpanHelpers::VectorOps::premultiply (pixels, num);
+}
+
+} // namespace juce
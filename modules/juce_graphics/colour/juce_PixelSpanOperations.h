@@ -0,0 +1,60 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A set of optimised functions for blending runs of premultiplied PixelARGB values,
+    as used by the software renderer's edge-table fillers and the image decoders.
+
+    Each function gives exactly the same result as calling the equivalent PixelARGB
+    method on every pixel in turn. SSE2 or NEON is used where it's available, and on x86 the AVX2
+    versions are chosen at runtime if the CPU supports them.
+
+    @tags{Graphics}
+*/
+class JUCE_API  PixelSpanOperations
+{
+public:
+    /** Blends a colour onto each of a run of pixels, i.e. dest[i].blend (colour). */
+    static void JUCE_CALLTYPE blendColour (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept;
+
+    /** Blends one run of pixels onto another, i.e. dest[i].blend (src[i]). */
+    static void JUCE_CALLTYPE blendPixels (PixelARGB* dest, const PixelARGB* src, int numPixels) noexcept;
+
+    /** Blends one run of pixels onto another, scaling the source by an extra opacity,
+        i.e. dest[i].blend (src[i], extraAlpha). The extraAlpha value can be from 0 to 256.
+    */
+    static void JUCE_CALLTYPE blendPixels (PixelARGB* dest, const PixelARGB* src, int numPixels, uint32 extraAlpha) noexcept;
+
+    /** Converts a run of non-premultiplied pixels to premultiplied ones, i.e. pixels[i].premultiply(). */
+    static void JUCE_CALLTYPE premultiply (PixelARGB* pixels, int numPixels) noexcept;
+};
+
+} // namespace juce
@@ -253,22 +253,20 @@ void Graphics::drawSingleLineText (const String& text, const int startX, const i
         if (flags == Justification::left && startX > context.getClipBounds().getRight())
             return;
 
-        GlyphArrangement arr;
-        arr.addLineOfText (context.getFont(), text, (float) startX, (float) baselineY);
+        auto arr = TextLayoutCache::getLineOfText (context.getFont(), text);
+        auto x = (float) startX;
 
         if (flags != Justification::left)
         {
-            auto w = arr.getBoundingBox (0, -1, true).getWidth();
+            auto w = arr->getBoundingBox (0, -1, true).getWidth();
 
             if ((flags & (Justification::horizontallyCentred | Justification::horizontallyJustified)) != 0)
                 w /= 2.0f;
 
-            arr.draw (*this, AffineTransform::translation (-w, 0));
-        }
-        else
-        {
-            arr.draw (*this);
+            x -= w;
         }
+
+        arr->draw (*this, AffineTransform::translation (x, (float) baselineY));
     }
 }
 
@@ -279,11 +277,8 @@ void Graphics::drawMultiLineText (const String& text, const int startX,
     if (text.isNotEmpty()
          && startX < context.getClipBounds().getRight())
     {
-        GlyphArrangement arr;
-        arr.addJustifiedText (context.getFont(), text,
-                              (float) startX, (float) baselineY, (float) maximumLineWidth,
-                              justification);
-        arr.draw (*this);
+        TextLayoutCache::getJustifiedText (context.getFont(), text, (float) maximumLineWidth, justification)
+            ->draw (*this, AffineTransform::translation ((float) startX, (float) baselineY));
     }
 }
 
@@ -292,14 +287,9 @@ void Graphics::drawText (const String& text, Rectangle<float> area,
 {
     if (text.isNotEmpty() && context.clipRegionIntersects (area.getSmallestIntegerContainer()))
     {
-        GlyphArrangement arr;
-        arr.addCurtailedLineOfText (context.getFont(), text, 0.0f, 0.0f,
-                                    area.getWidth(), useEllipsesIfTooBig);
-
-        arr.justifyGlyphs (0, arr.getNumGlyphs(),
-                           area.getX(), area.getY(), area.getWidth(), area.getHeight(),
-                           justificationType);
-        arr.draw (*this);
+        TextLayoutCache::getCurtailedText (context.getFont(), text, area.getWidth(), area.getHeight(),
+                                           justificationType, useEllipsesIfTooBig)
+            ->draw (*this, AffineTransform::translation (area.getX(), area.getY()));
     }
 }
 
@@ -322,15 +312,10 @@ void Graphics::drawFittedText (const String& text, Rectangle<int> area,
 {
     if (text.isNotEmpty() && (! area.isEmpty()) && context.clipRegionIntersects (area))
     {
-        GlyphArrangement arr;
-        arr.addFittedText (context.getFont(), text,
-                           (float) area.getX(), (float) area.getY(),
-                           (float) area.getWidth(), (float) area.getHeight(),
-                           justification,
-                           maximumNumberOfLines,
-                           minimumHorizontalScale);
-
-        arr.draw (*this);
+        TextLayoutCache::getFittedText (context.getFont(), text,
+                                        (float) area.getWidth(), (float) area.getHeight(),
+                                        justification, maximumNumberOfLines, minimumHorizontalScale)
+            ->draw (*this, AffineTransform::translation ((float) area.getX(), (float) area.getY()));
     }
 }
 
@@ -412,7 +397,7 @@ void Graphics::strokePath (const Path& path,
                            const AffineTransform& transform) const
 {
     Path stroke;
-    strokeType.createStrokedPath (stroke, path, transform, context.getPhysicalPixelScaleFactor());
+    PathCache::createStrokedPath (stroke, path, strokeType, transform, context.getPhysicalPixelScaleFactor());
     fillPath (stroke);
 }
 
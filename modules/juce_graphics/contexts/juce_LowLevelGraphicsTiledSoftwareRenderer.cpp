@@ -0,0 +1,369 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+struct TiledRendererThreadPool  : public ThreadPool,
+                                  private DeletedAtShutdown
+{
+    TiledRendererThreadPool()  : ThreadPool (jmax (1, SystemStats::getNumCpus() - 1)) {}
+    ~TiledRendererThreadPool() override  { clearSingletonInstance(); }
+
+    JUCE_DECLARE_SINGLETON (TiledRendererThreadPool, false)
+};
+
+JUCE_IMPLEMENT_SINGLETON (TiledRendererThreadPool)
+
+//==============================================================================
+// Everything the tiles need, shared with the pool so that a job which only starts
+// after the last tile has been claimed can still look at it safely
+struct LowLevelGraphicsTiledSoftwareRenderer::Frame
+{
+    Frame (const Image& im, Point<int> o, const RectangleList<int>& c, std::vector<Command>&& cmds)
+        : image (im), origin (o), clip (c), commands (std::move (cmds))
+    {
+    }
+
+    void renderTiles()
+    {
+        for (;;)
+        {
+            auto index = nextTile++;
+
+            if (index >= tiles.size())
+                return;
+
+            renderTile (tiles.getReference (index));
+
+            if (++numTilesDone == tiles.size())
+                finished.signal();
+        }
+    }
+
+    void renderTile (Rectangle<int> tile) const
+    {
+        RectangleList<int> tileClip (clip);
+        tileClip.clipTo (tile);
+
+        LowLevelGraphicsSoftwareRenderer g (image, origin, tileClip);
+
+        for (auto& c : commands)
+            if (c.type != Command::drawing || c.deviceBounds.intersects (tile))
+                c.apply (g);
+    }
+
+    const Image image;
+    const Point<int> origin;
+    const RectangleList<int> clip;
+    std::vector<Command> commands;
+    Array<Rectangle<int>> tiles;
+    std::atomic<int> nextTile { 0 }, numTilesDone { 0 };
+    WaitableEvent finished;
+
+    JUCE_DECLARE_NON_COPYABLE (Frame)
+};
+
+//==============================================================================
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& im)
+    : LowLevelGraphicsTiledSoftwareRenderer (im, {}, im.getBounds())
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& im, Point<int> o,
+                                                                              const RectangleList<int>& clip)
+    : RenderingHelpers::StackBasedLowLevelGraphicsContext<RenderingHelpers::SoftwareRendererSavedState>
+        (new RenderingHelpers::SoftwareRendererSavedState (im, clip, o)),
+      image (im), origin (o), initialClip (clip)
+{
+    initialClip.clipTo (im.getBounds());
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    // a transparency layer was left open, so it'll be lost when the state is discarded
+    jassert (layerDepth == 0);
+
+    while (layerDepth > 0)
+        endTransparencyLayer();
+
+    flush();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setTileSize (int newTileSize)
+{
+    jassert (newTileSize > 0);
+    tileSize = jmax (16, newTileSize);
+}
+
+int LowLevelGraphicsTiledSoftwareRenderer::getNumPendingDrawingOperations() const noexcept
+{
+    return numDrawingOperations;
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::flush()
+{
+    // The tiles render each layer into a temporary image of their own, so there's no way
+    // to carry on with one that's been half-drawn
+    jassert (layerDepth == 0);
+
+    if (numDrawingOperations == 0 || layerDepth > 0)
+        return;
+
+    auto frame = std::make_shared<Frame> (image, origin, initialClip, std::move (commands));
+    auto bounds = initialClip.getBounds();
+
+    for (int y = bounds.getY(); y < bounds.getBottom(); y += tileSize)
+        for (int x = bounds.getX(); x < bounds.getRight(); x += tileSize)
+            if (initialClip.intersectsRectangle ({ x, y, tileSize, tileSize }))
+                frame->tiles.add (Rectangle<int> (x, y, tileSize, tileSize).getIntersection (bounds));
+
+    auto numHelpers = jmin (frame->tiles.size() - 1, SystemStats::getNumCpus() - 1);
+
+    if (numHelpers > 0)
+    {
+        auto* pool = TiledRendererThreadPool::getInstance();
+
+        for (int i = 0; i < numHelpers; ++i)
+            pool->addJob ([frame] { frame->renderTiles(); });
+    }
+
+    frame->renderTiles();
+
+    if (frame->numTilesDone < frame->tiles.size())
+        frame->finished.wait();
+
+    // The drawing's done with, but later commands still need the state that the
+    // earlier ones set up. The layers that were used are all closed by now, so they
+    // can be replaced by plain saves and restores.
+    for (auto& c : frame->commands)
+    {
+        if (c.type == Command::beginLayer)
+            commands.push_back ({ Command::stateChange, {}, [] (LowLevelGraphicsContext& g) { g.saveState(); } });
+        else if (c.type == Command::endLayer)
+            commands.push_back ({ Command::stateChange, {}, [] (LowLevelGraphicsContext& g) { g.restoreState(); } });
+        else if (c.type == Command::stateChange)
+            commands.push_back (std::move (c));
+    }
+
+    numDrawingOperations = 0;
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::recordStateChange (std::function<void (LowLevelGraphicsContext&)> fn)
+{
+    commands.push_back ({ Command::stateChange, {}, std::move (fn) });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::recordDrawing (Rectangle<float> area, std::function<void (LowLevelGraphicsContext&)> fn)
+{
+    // anything the current clip hides would be hidden for every tile too
+    if (stack->clip == nullptr)
+        return;
+
+    auto deviceBounds = stack->clip->getClipBounds().getIntersection (area.getSmallestIntegerContainer().expanded (1));
+
+    if (! deviceBounds.isEmpty())
+    {
+        commands.push_back ({ Command::drawing, deviceBounds, std::move (fn) });
+        ++numDrawingOperations;
+    }
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::setOrigin (Point<int> o)
+{
+    stack->transform.setOrigin (o);
+    recordStateChange ([o] (LowLevelGraphicsContext& g) { g.setOrigin (o); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    stack->transform.addTransform (t);
+    recordStateChange ([t] (LowLevelGraphicsContext& g) { g.addTransform (t); });
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    recordStateChange ([r] (LowLevelGraphicsContext& g) { g.clipToRectangle (r); });
+    return stack->clipToRectangle (r);
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangleList (const RectangleList<int>& r)
+{
+    recordStateChange ([r] (LowLevelGraphicsContext& g) { g.clipToRectangleList (r); });
+    return stack->clipToRectangleList (r);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    stack->excludeClipRectangle (r);
+    recordStateChange ([r] (LowLevelGraphicsContext& g) { g.excludeClipRectangle (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    stack->clipToPath (path, t);
+    recordStateChange ([path, t] (LowLevelGraphicsContext& g) { g.clipToPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToImageAlpha (const Image& im, const AffineTransform& t)
+{
+    stack->clipToImageAlpha (im, t);
+    recordStateChange ([im, t] (LowLevelGraphicsContext& g) { g.clipToImageAlpha (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::saveState()
+{
+    stack.save();
+    recordStateChange ([] (LowLevelGraphicsContext& g) { g.saveState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::restoreState()
+{
+    stack.restore();
+    recordStateChange ([] (LowLevelGraphicsContext& g) { g.restoreState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    // The layer only changes where things are drawn, not what the clip looks like
+    // to the caller, so there's no need to allocate one for the recorded state
+    stack.save();
+    ++layerDepth;
+    commands.push_back ({ Command::beginLayer, {}, [opacity] (LowLevelGraphicsContext& g) { g.beginTransparencyLayer (opacity); } });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::endTransparencyLayer()
+{
+    jassert (layerDepth > 0);
+
+    stack.restore();
+    --layerDepth;
+    commands.push_back ({ Command::endLayer, {}, [] (LowLevelGraphicsContext& g) { g.endTransparencyLayer(); } });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFill (const FillType& fillType)
+{
+    stack->setFillType (fillType);
+    recordStateChange ([fillType] (LowLevelGraphicsContext& g) { g.setFill (fillType); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOpacity (float newOpacity)
+{
+    stack->fillType.setOpacity (newOpacity);
+    recordStateChange ([newOpacity] (LowLevelGraphicsContext& g) { g.setOpacity (newOpacity); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    stack->interpolationQuality = quality;
+    recordStateChange ([quality] (LowLevelGraphicsContext& g) { g.setInterpolationQuality (quality); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFont (const Font& newFont)
+{
+    // The typeface gets looked up lazily, and the tiles will all share this font's
+    // internals, so it's resolved here rather than racing to do it on several threads
+    newFont.getTypeface();
+
+    stack->font = newFont;
+    recordStateChange ([newFont] (LowLevelGraphicsContext& g) { g.setFont (newFont); });
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replace)
+{
+    recordDrawing (r.toFloat().transformedBy (stack->transform.getTransform()),
+                   [r, replace] (LowLevelGraphicsContext& g) { g.fillRect (r, replace); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    recordDrawing (r.transformedBy (stack->transform.getTransform()),
+                   [r] (LowLevelGraphicsContext& g) { g.fillRect (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    recordDrawing (list.getBounds().transformedBy (stack->transform.getTransform()),
+                   [list] (LowLevelGraphicsContext& g) { g.fillRectList (list); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    recordDrawing (path.getBoundsTransformed (stack->transform.getTransformWith (t)),
+                   [path, t] (LowLevelGraphicsContext& g) { g.fillPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawImage (const Image& im, const AffineTransform& t)
+{
+    recordDrawing (im.getBounds().toFloat().transformedBy (stack->transform.getTransformWith (t)),
+                   [im, t] (LowLevelGraphicsContext& g) { g.drawImage (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    recordDrawing (Rectangle<float> (line.getStart(), line.getEnd()).transformedBy (stack->transform.getTransform()),
+                   [line] (LowLevelGraphicsContext& g) { g.drawLine (line); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    if (stack->clip == nullptr)
+        return;
+
+    if (t.isOnlyTranslation() && ! stack->transform.isRotated)
+    {
+        // These get drawn from the shared glyph cache, which does its own locking. Looking the
+        // glyph up now gives a much tighter area than the clip, and means that the tiles will
+        // usually find it waiting in the cache.
+        Point<float> pos (t.getTranslationX(), t.getTranslationY());
+        auto font = stack->getFontForCachedGlyph (pos);
+        auto glyph = RenderingHelpers::SoftwareRendererSavedState::GlyphCacheType::getInstance().findOrCreateGlyph (font, glyphNumber);
+
+        if (glyph != nullptr && glyph->edgeTable != nullptr)
+            recordDrawing (glyph->edgeTable->getMaximumBounds().toFloat() + pos,
+                           [glyphNumber, t] (LowLevelGraphicsContext& g) { g.drawGlyph (glyphNumber, t); });
+    }
+    else
+    {
+        // Otherwise the glyph would be built from the typeface on each tile's thread, so
+        // its outline is fetched here and drawn as a path instead
+        auto& font = stack->font;
+        Path outline;
+
+        if (font.getTypeface()->getOutlineForGlyph (glyphNumber, outline))
+        {
+            auto fontHeight = font.getHeight();
+            fillPath (outline, AffineTransform::scale (fontHeight * font.getHorizontalScale(), fontHeight).followedBy (t));
+        }
+    }
+}
+
+} // namespace juce
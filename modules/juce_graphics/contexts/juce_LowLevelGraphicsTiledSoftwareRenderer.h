@@ -0,0 +1,154 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A software renderer that records everything drawn into it, and then rasterises
+    the target image in parallel, as a grid of tiles, when it's deleted.
+
+    Each tile replays the recorded commands through its own LowLevelGraphicsSoftwareRenderer
+    that's clipped to the tile, so the results are the same as drawing with a
+    LowLevelGraphicsSoftwareRenderer directly. The tiles are shared between the
+    calling thread and a pool of background threads.
+
+    Clip queries such as getClipBounds() and clipRegionIntersects() are answered
+    straight away, so components can skip work they don't need to do in the usual way.
+
+    Nothing is drawn into the image until the context is deleted (or flush() is called),
+    so any images or paths that get drawn must stay unchanged until then - the Image
+    and Path objects themselves are copied, but the pixel data of an image is shared.
+
+    To have your UI painted like this, you can return one of these from
+    LookAndFeel::createGraphicsContext().
+
+    @tags{Graphics}
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer    : public RenderingHelpers::StackBasedLowLevelGraphicsContext<RenderingHelpers::SoftwareRendererSavedState>
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into an image. */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto);
+
+    /** Creates a context to render into a clipped subsection of an image. */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                           const RectangleList<int>& initialClip);
+
+    /** Destructor. This renders anything that hasn't been flushed yet. */
+    ~LowLevelGraphicsTiledSoftwareRenderer() override;
+
+    //==============================================================================
+    /** Sets the width and height, in pixels, of the tiles that the image is split into.
+        Smaller tiles spread the work more evenly between threads, but each tile has to
+        step through every recorded command, so very small tiles add overhead.
+        The default is 128.
+    */
+    void setTileSize (int newTileSize);
+
+    /** Renders all the commands that have been recorded so far into the image.
+        This can't be called while a transparency layer is active.
+    */
+    void flush();
+
+    /** Returns the number of drawing operations that are waiting to be rendered. */
+    int getNumPendingDrawingOperations() const noexcept;
+
+    //==============================================================================
+    /** @internal */
+    void setOrigin (Point<int>) override;
+    /** @internal */
+    void addTransform (const AffineTransform&) override;
+    /** @internal */
+    bool clipToRectangle (const Rectangle<int>&) override;
+    /** @internal */
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    /** @internal */
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    /** @internal */
+    void clipToPath (const Path&, const AffineTransform&) override;
+    /** @internal */
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    /** @internal */
+    void saveState() override;
+    /** @internal */
+    void restoreState() override;
+    /** @internal */
+    void beginTransparencyLayer (float opacity) override;
+    /** @internal */
+    void endTransparencyLayer() override;
+    /** @internal */
+    void setFill (const FillType&) override;
+    /** @internal */
+    void setOpacity (float) override;
+    /** @internal */
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    /** @internal */
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    /** @internal */
+    void fillRect (const Rectangle<float>&) override;
+    /** @internal */
+    void fillRectList (const RectangleList<float>&) override;
+    /** @internal */
+    void fillPath (const Path&, const AffineTransform&) override;
+    /** @internal */
+    void drawImage (const Image&, const AffineTransform&) override;
+    /** @internal */
+    void drawLine (const Line<float>&) override;
+    /** @internal */
+    void setFont (const Font&) override;
+    /** @internal */
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+private:
+    //==============================================================================
+    struct Command
+    {
+        enum Type { stateChange, beginLayer, endLayer, drawing };
+
+        Type type;
+        Rectangle<int> deviceBounds; // only used for drawing operations, which tiles outside it can skip
+        std::function<void (LowLevelGraphicsContext&)> apply;
+    };
+
+    struct Frame;
+
+    Image image;
+    Point<int> origin;
+    RectangleList<int> initialClip;
+    std::vector<Command> commands;
+    int tileSize = 128, numDrawingOperations = 0, layerDepth = 0;
+
+    void recordStateChange (std::function<void (LowLevelGraphicsContext&)>);
+    void recordDrawing (Rectangle<float> deviceSpaceArea, std::function<void (LowLevelGraphicsContext&)>);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+} // namespace juce
@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class SoftwareRendererBenchmarks  : public Benchmark
+{
+public:
+    SoftwareRendererBenchmarks()  : Benchmark ("Software renderer", "Graphics") {}
+
+    void runBenchmark() override
+    {
+        Image target (Image::ARGB, 512, 512, true, SoftwareImageType());
+        Image source (Image::ARGB, 128, 128, true, SoftwareImageType());
+
+        {
+            Graphics g (source);
+            g.setGradientFill (ColourGradient (Colours::red, 0, 0, Colours::blue.withAlpha (0.5f), 128, 128, false));
+            g.fillAll();
+        }
+
+        Path star;
+        star.addStar ({ 256.0f, 256.0f }, 12, 80.0f, 240.0f, 0.3f);
+
+        const ColourGradient gradient (Colours::white, 0, 0, Colours::black, 512, 512, true);
+        const ColourGradient linearGradient (Colours::yellow.withAlpha (0.8f), 0, 0, Colours::purple.withAlpha (0.3f), 512, 0, false);
+
+        measure ("fillRect, opaque", [&]
+        {
+            Graphics g (target);
+            g.setColour (Colours::darkgrey);
+            g.fillRect (0, 0, 512, 512);
+        });
+
+        measure ("fillRect, translucent", [&]
+        {
+            Graphics g (target);
+            g.setColour (Colours::orange.withAlpha (0.5f));
+            g.fillRect (10.5f, 10.5f, 490.0f, 490.0f);
+        });
+
+        measure ("fillRect, radial gradient", [&]
+        {
+            Graphics g (target);
+            g.setGradientFill (gradient);
+            g.fillRect (0, 0, 512, 512);
+        });
+
+        measure ("fillRect, translucent linear gradient", [&]
+        {
+            Graphics g (target);
+            g.setGradientFill (linearGradient);
+            g.fillRect (0, 0, 512, 512);
+        });
+
+        measure ("fillPath, star", [&]
+        {
+            Graphics g (target);
+            g.setColour (Colours::green);
+            g.fillPath (star);
+        });
+
+        measure ("strokePath, star", [&]
+        {
+            Graphics g (target);
+            g.setColour (Colours::black);
+            g.strokePath (star, PathStrokeType (3.0f));
+        });
+
+        measure ("drawImageAt", [&]
+        {
+            Graphics g (target);
+            g.drawImageAt (source, 100, 100);
+        });
+
+        measure ("drawImageAt, translucent", [&]
+        {
+            Graphics g (target);
+            g.setOpacity (0.5f);
+            g.drawImageAt (source, 100, 100);
+        });
+
+        measure ("drawImageTransformed, rotated", [&]
+        {
+            Graphics g (target);
+            g.drawImageTransformed (source, AffineTransform::rotation (0.3f, 64.0f, 64.0f).translated (200.0f, 200.0f));
+        });
+
+        measure ("tiled renderer, radial gradient and star", [&]
+        {
+            LowLevelGraphicsTiledSoftwareRenderer renderer (target);
+
+            {
+                Graphics g (renderer);
+                g.setGradientFill (gradient);
+                g.fillRect (0, 0, 512, 512);
+                g.setColour (Colours::green);
+                g.fillPath (star);
+            }
+        });
+    }
+};
+
+static SoftwareRendererBenchmarks softwareRendererBenchmarks;
+
+} // namespace juce
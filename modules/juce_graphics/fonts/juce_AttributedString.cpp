@@ -282,9 +282,7 @@ void AttributedString::draw (Graphics& g, const Rectangle<float>& area) const
 
         if (! g.getInternalContext().drawTextLayout (*this, area))
         {
-            TextLayout layout;
-            layout.createLayout (*this, area.getWidth());
-            layout.draw (g, area);
+            TextLayoutCache::getTextLayout (*this, area.getWidth())->draw (g, area);
         }
     }
 }
@@ -164,16 +164,14 @@ void Typeface::setTypefaceCacheSize (int numFontsToCache)
     TypefaceCache::getInstance()->setSize (numFontsToCache);
 }
 
-void (*clearOpenGLGlyphCache)() = nullptr;
-
 void Typeface::clearTypefaceCache()
 {
     TypefaceCache::getInstance()->clear();
 
+    // the OpenGL renderer shares this glyph cache too
     RenderingHelpers::SoftwareRendererSavedState::clearGlyphCache();
 
-    if (clearOpenGLGlyphCache != nullptr)
-        clearOpenGLGlyphCache();
+    TextLayoutCache::clear();
 }
 
 //==============================================================================
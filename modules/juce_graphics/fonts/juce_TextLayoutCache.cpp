@@ -0,0 +1,399 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct TextLayoutCache::Pimpl  : private DeletedAtShutdown
+{
+    Pimpl() {}
+    ~Pimpl() override   { clearSingletonInstance(); }
+
+    JUCE_DECLARE_SINGLETON (TextLayoutCache::Pimpl, false)
+
+    //==============================================================================
+    enum ArrangementType
+    {
+        lineOfText,
+        justifiedText,
+        curtailedText,
+        fittedText
+    };
+
+    struct ArrangementKey
+    {
+        ArrangementType type = lineOfText;
+        Font font;
+        String text;
+        float width = 0, height = 0, minimumHorizontalScale = 0;
+        int justification = 0, maximumLines = 0;
+        bool useEllipses = false;
+
+        bool operator== (const ArrangementKey& other) const noexcept
+        {
+            return type == other.type && width == other.width && height == other.height
+                && justification == other.justification && maximumLines == other.maximumLines
+                && minimumHorizontalScale == other.minimumHorizontalScale
+                && useEllipses == other.useEllipses && font == other.font && text == other.text;
+        }
+
+        int64 getHashCode() const noexcept
+        {
+            auto hash = hashFont (hashValue (14695981039346656037ull, (uint32) type), font);
+
+            for (auto v : { width, height, minimumHorizontalScale })
+                hash = hashValue (hash, v);
+
+            hash = hashValue (hash, (uint32) justification);
+            hash = hashValue (hash, (uint32) (maximumLines * 2 + (useEllipses ? 1 : 0)));
+            return (int64) hashValue (hash, (uint64) text.hashCode64());
+        }
+
+        std::shared_ptr<const GlyphArrangement> createArrangement() const
+        {
+            auto arr = std::make_shared<GlyphArrangement>();
+
+            switch (type)
+            {
+                case lineOfText:
+                    arr->addLineOfText (font, text, 0.0f, 0.0f);
+                    break;
+
+                case justifiedText:
+                    arr->addJustifiedText (font, text, 0.0f, 0.0f, width, Justification (justification));
+                    break;
+
+                case curtailedText:
+                    arr->addCurtailedLineOfText (font, text, 0.0f, 0.0f, width, useEllipses);
+                    arr->justifyGlyphs (0, arr->getNumGlyphs(), 0.0f, 0.0f, width, height,
+                                        Justification (justification));
+                    break;
+
+                case fittedText:
+                    arr->addFittedText (font, text, 0.0f, 0.0f, width, height, Justification (justification),
+                                        maximumLines, minimumHorizontalScale);
+                    break;
+
+                default:
+                    jassertfalse;
+                    break;
+            }
+
+            return arr;
+        }
+    };
+
+    struct LayoutKey
+    {
+        AttributedString text;
+        float maxWidth = 0;
+
+        bool operator== (const LayoutKey& other) const noexcept
+        {
+            if (maxWidth != other.maxWidth
+                 || text.getJustification() != other.text.getJustification()
+                 || text.getWordWrap() != other.text.getWordWrap()
+                 || text.getReadingDirection() != other.text.getReadingDirection()
+                 || text.getLineSpacing() != other.text.getLineSpacing()
+                 || text.getNumAttributes() != other.text.getNumAttributes()
+                 || text.getText() != other.text.getText())
+                return false;
+
+            for (int i = 0; i < text.getNumAttributes(); ++i)
+            {
+                auto& a = text.getAttribute (i);
+                auto& b = other.text.getAttribute (i);
+
+                if (a.range != b.range || a.colour != b.colour || a.font != b.font)
+                    return false;
+            }
+
+            return true;
+        }
+
+        int64 getHashCode() const noexcept
+        {
+            auto hash = hashValue (14695981039346656037ull, maxWidth);
+            hash = hashValue (hash, (uint32) text.getJustification().getFlags());
+            hash = hashValue (hash, (uint32) (text.getWordWrap() * 8 + text.getReadingDirection()));
+            hash = hashValue (hash, text.getLineSpacing());
+
+            for (int i = 0; i < text.getNumAttributes(); ++i)
+            {
+                auto& a = text.getAttribute (i);
+                hash = hashValue (hash, (uint32) a.range.getStart());
+                hash = hashValue (hash, (uint32) a.range.getEnd());
+                hash = hashValue (hash, a.colour.getARGB());
+                hash = hashFont (hash, a.font);
+            }
+
+            return (int64) hashValue (hash, (uint64) text.getText().hashCode64());
+        }
+
+        std::shared_ptr<const TextLayout> createLayout() const
+        {
+            auto layout = std::make_shared<TextLayout>();
+            layout->createLayout (text, maxWidth);
+            return layout;
+        }
+    };
+
+    //==============================================================================
+    std::shared_ptr<const GlyphArrangement> getArrangement (const ArrangementKey& key)
+    {
+        return getOrCreate (arrangements, key, [&] { return key.createArrangement(); });
+    }
+
+    std::shared_ptr<const TextLayout> getLayout (const LayoutKey& key)
+    {
+        return getOrCreate (layouts, key, [&] { return key.createLayout(); });
+    }
+
+    void setMaximumNumberOfEntries (int newMaxEntries)
+    {
+        const ScopedLock sl (lock);
+        maxEntries = jmax (0, newMaxEntries);
+        trimToSize();
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+        arrangements.clear();
+        layouts.clear();
+    }
+
+private:
+    //==============================================================================
+    template <typename KeyType, typename ObjectType>
+    struct Item
+    {
+        KeyType key;
+        std::shared_ptr<const ObjectType> object;
+        uint64 lastUse = 0;
+    };
+
+    using ArrangementItem = Item<ArrangementKey, GlyphArrangement>;
+    using LayoutItem      = Item<LayoutKey, TextLayout>;
+
+    HashMap<int64, ArrangementItem> arrangements;
+    HashMap<int64, LayoutItem> layouts;
+    CriticalSection lock;
+    int maxEntries = 256;
+    uint64 useCounter = 0;
+
+    //==============================================================================
+    static uint64 hashValue (uint64 hash, uint64 value) noexcept
+    {
+        return (hash ^ value) * 1099511628211ull;
+    }
+
+    static uint64 hashValue (uint64 hash, uint32 value) noexcept
+    {
+        return hashValue (hash, (uint64) value);
+    }
+
+    static uint64 hashValue (uint64 hash, float value) noexcept
+    {
+        uint32 bits;
+        memcpy (&bits, &value, sizeof (bits));
+        return hashValue (hash, bits);
+    }
+
+    static uint64 hashFont (uint64 hash, const Font& font) noexcept
+    {
+        hash = hashValue (hash, font.getHeight());
+        hash = hashValue (hash, font.getHorizontalScale());
+        hash = hashValue (hash, font.getExtraKerningFactor());
+        hash = hashValue (hash, (uint32) (font.isUnderlined() ? 1 : 0));
+        hash = hashValue (hash, (uint64) font.getTypefaceName().hashCode64());
+        return hashValue (hash, (uint64) font.getTypefaceStyle().hashCode64());
+    }
+
+    //==============================================================================
+    template <typename ItemType, typename KeyType, typename CreateFn>
+    auto getOrCreate (HashMap<int64, ItemType>& items, const KeyType& key, CreateFn&& create) -> decltype (create())
+    {
+        auto hashCode = key.getHashCode();
+
+        {
+            const ScopedLock sl (lock);
+
+            if (items.contains (hashCode))
+            {
+                auto& item = items.getReference (hashCode);
+
+                if (item.key == key)
+                {
+                    item.lastUse = ++useCounter;
+                    return item.object;
+                }
+            }
+        }
+
+        // (the layout is built without holding the lock, so that other threads
+        // aren't held up while it's being measured)
+        auto object = create();
+
+        const ScopedLock sl (lock);
+
+        if (maxEntries > 0)
+        {
+            items.set (hashCode, { key, object, ++useCounter });
+            trimToSize();
+        }
+
+        return object;
+    }
+
+    template <typename ItemType>
+    static bool findOldest (HashMap<int64, ItemType>& items, uint64& oldestUse, int64& oldestHashCode)
+    {
+        bool found = false;
+
+        for (typename HashMap<int64, ItemType>::Iterator i (items); i.next();)
+        {
+            auto& item = items.getReference (i.getKey());
+
+            if (! found || item.lastUse < oldestUse)
+            {
+                oldestUse = item.lastUse;
+                oldestHashCode = i.getKey();
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+    void trimToSize()
+    {
+        while (arrangements.size() + layouts.size() > maxEntries)
+        {
+            uint64 oldestArrangementUse = 0, oldestLayoutUse = 0;
+            int64 oldestArrangement = 0, oldestLayout = 0;
+
+            auto foundArrangement = findOldest (arrangements, oldestArrangementUse, oldestArrangement);
+            auto foundLayout      = findOldest (layouts, oldestLayoutUse, oldestLayout);
+
+            if (foundLayout && (! foundArrangement || oldestLayoutUse < oldestArrangementUse))
+                layouts.remove (oldestLayout);
+            else if (foundArrangement)
+                arrangements.remove (oldestArrangement);
+            else
+                break;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
+
+JUCE_IMPLEMENT_SINGLETON (TextLayoutCache::Pimpl)
+
+//==============================================================================
+std::shared_ptr<const GlyphArrangement> TextLayoutCache::getLineOfText (const Font& font, const String& text)
+{
+    Pimpl::ArrangementKey key;
+    key.type = Pimpl::lineOfText;
+    key.font = font;
+    key.text = text;
+
+    return Pimpl::getInstance()->getArrangement (key);
+}
+
+std::shared_ptr<const GlyphArrangement> TextLayoutCache::getJustifiedText (const Font& font, const String& text,
+                                                                          float maxLineWidth, Justification justification)
+{
+    Pimpl::ArrangementKey key;
+    key.type = Pimpl::justifiedText;
+    key.font = font;
+    key.text = text;
+    key.width = maxLineWidth;
+    key.justification = justification.getFlags();
+
+    return Pimpl::getInstance()->getArrangement (key);
+}
+
+std::shared_ptr<const GlyphArrangement> TextLayoutCache::getCurtailedText (const Font& font, const String& text,
+                                                                          float width, float height,
+                                                                          Justification justification,
+                                                                          bool useEllipsesIfTooBig)
+{
+    Pimpl::ArrangementKey key;
+    key.type = Pimpl::curtailedText;
+    key.font = font;
+    key.text = text;
+    key.width = width;
+    key.height = height;
+    key.justification = justification.getFlags();
+    key.useEllipses = useEllipsesIfTooBig;
+
+    return Pimpl::getInstance()->getArrangement (key);
+}
+
+std::shared_ptr<const GlyphArrangement> TextLayoutCache::getFittedText (const Font& font, const String& text,
+                                                                       float width, float height,
+                                                                       Justification justification,
+                                                                       int maximumLinesToUse,
+                                                                       float minimumHorizontalScale)
+{
+    Pimpl::ArrangementKey key;
+    key.type = Pimpl::fittedText;
+    key.font = font;
+    key.text = text;
+    key.width = width;
+    key.height = height;
+    key.justification = justification.getFlags();
+    key.maximumLines = maximumLinesToUse;
+
+    // (resolved here, so that changing the default doesn't leave stale entries behind)
+    key.minimumHorizontalScale = minimumHorizontalScale != 0.0f ? minimumHorizontalScale
+                                                                : Font::getDefaultMinimumHorizontalScaleFactor();
+
+    return Pimpl::getInstance()->getArrangement (key);
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::getTextLayout (const AttributedString& text, float maxWidth)
+{
+    Pimpl::LayoutKey key;
+    key.text = text;
+    key.maxWidth = maxWidth;
+
+    return Pimpl::getInstance()->getLayout (key);
+}
+
+void TextLayoutCache::setMaximumNumberOfEntries (int maxEntries)
+{
+    Pimpl::getInstance()->setMaximumNumberOfEntries (maxEntries);
+}
+
+void TextLayoutCache::clear()
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        instance->clear();
+}
+
+} // namespace juce
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A cache of the glyph arrangements and text layouts that the Graphics text methods
+    create.
+
+    Laying out a string means looking up every glyph, measuring it, and (for the fitted
+    and multi-line methods) working out where to break lines and how much to squash them.
+    A UI that redraws the same labels over and over again spends a lot of its time doing
+    this, so Graphics::drawText(), Graphics::drawFittedText(), Graphics::drawSingleLineText(),
+    Graphics::drawMultiLineText() and AttributedString::draw() all fetch their layouts
+    from here rather than building a new one each time.
+
+    Layouts are created at the origin and matched on the text, the font and the size of
+    the area, but not its position, so a row of text that's scrolled around in a list
+    will keep using the same entry. When the cache is full, the least recently used
+    entries are thrown away.
+
+    The objects that are returned are shared and mustn't be modified - if you need to
+    change one, make a copy of it.
+
+    @see GlyphArrangement, TextLayout
+
+    @tags{Graphics}
+*/
+class JUCE_API  TextLayoutCache
+{
+public:
+    //==============================================================================
+    /** Returns the arrangement that GlyphArrangement::addLineOfText() creates for a
+        string whose baseline starts at the origin.
+    */
+    static std::shared_ptr<const GlyphArrangement> getLineOfText (const Font& font, const String& text);
+
+    /** Returns the arrangement that GlyphArrangement::addJustifiedText() creates for a
+        string whose first baseline starts at the origin.
+    */
+    static std::shared_ptr<const GlyphArrangement> getJustifiedText (const Font& font, const String& text,
+                                                                     float maxLineWidth, Justification justification);
+
+    /** Returns the single, curtailed line of text that Graphics::drawText() draws into a
+        rectangle of the given size, whose top-left is at the origin.
+    */
+    static std::shared_ptr<const GlyphArrangement> getCurtailedText (const Font& font, const String& text,
+                                                                     float width, float height,
+                                                                     Justification justification,
+                                                                     bool useEllipsesIfTooBig);
+
+    /** Returns the arrangement that GlyphArrangement::addFittedText() creates for a
+        rectangle of the given size, whose top-left is at the origin.
+    */
+    static std::shared_ptr<const GlyphArrangement> getFittedText (const Font& font, const String& text,
+                                                                  float width, float height,
+                                                                  Justification justification,
+                                                                  int maximumLinesToUse,
+                                                                  float minimumHorizontalScale);
+
+    /** Returns the TextLayout that TextLayout::createLayout() creates for an
+        AttributedString and a maximum width.
+    */
+    static std::shared_ptr<const TextLayout> getTextLayout (const AttributedString& text, float maxWidth);
+
+    //==============================================================================
+    /** Sets the number of layouts that the cache may keep, or disables it if this is 0.
+
+        The default is 256. Making it smaller will release the least recently used
+        entries until it fits.
+    */
+    static void setMaximumNumberOfEntries (int maxEntries);
+
+    /** Releases everything that the cache is holding.
+
+        This is called by Typeface::clearTypefaceCache(), because the cached layouts
+        refer to the glyphs of the old typefaces.
+    */
+    static void clear();
+
+private:
+    //==============================================================================
+    struct Pimpl;
+    friend struct Pimpl;
+
+    TextLayoutCache();
+    ~TextLayoutCache();
+
+    JUCE_DECLARE_NON_COPYABLE (TextLayoutCache)
+};
+
+} // namespace juce
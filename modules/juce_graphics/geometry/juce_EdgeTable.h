@@ -201,6 +201,8 @@ private:
         bool operator< (const LineItem& other) const noexcept   { return x < other.x; }
     };
 
+    friend class PathCache;
+
     HeapBlock<int> table;
     Rectangle<int> bounds;
     int maxEdgesPerLine, lineStrideElements;
@@ -804,6 +804,7 @@ private:
     friend class PathFlatteningIterator;
     friend class Path::Iterator;
     friend class EdgeTable;
+    friend class PathCache;
 
     Array<float> data;
 
@@ -0,0 +1,321 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct PathCache::Pimpl  : private DeletedAtShutdown
+{
+    Pimpl() {}
+    ~Pimpl() override   { clearSingletonInstance(); }
+
+    JUCE_DECLARE_SINGLETON (PathCache::Pimpl, false)
+
+    bool isEnabled() const noexcept     { return maxBytes.load() > 0; }
+
+    void setMaximumCacheSize (size_t newMaxBytes)
+    {
+        const ScopedLock sl (lock);
+        maxBytes = newMaxBytes;
+        trimToBudget();
+    }
+
+    size_t getCacheSizeInBytes() const
+    {
+        const ScopedLock sl (lock);
+        return totalBytes;
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+        strokes.clear();
+        edgeTables.clear();
+        totalBytes = 0;
+    }
+
+    //==============================================================================
+    void createStrokedPath (Path& destPath, const Path& sourcePath, const PathStrokeType& strokeType,
+                            const AffineTransform& transform, float extraAccuracy)
+    {
+        auto hashCode = (int64) hashStroke (sourcePath, strokeType, transform, extraAccuracy);
+
+        {
+            const ScopedLock sl (lock);
+
+            if (strokes.contains (hashCode))
+            {
+                auto& item = strokes.getReference (hashCode);
+
+                if (item.source == sourcePath && item.transform == transform
+                     && item.strokeType == strokeType && item.extraAccuracy == extraAccuracy)
+                {
+                    item.lastUse = ++useCounter;
+                    destPath = item.stroke;
+                    return;
+                }
+            }
+        }
+
+        strokeType.createStrokedPath (destPath, sourcePath, transform, extraAccuracy);
+
+        StrokeItem item { sourcePath, transform, strokeType, extraAccuracy, destPath,
+                          getMemoryUsage (sourcePath) + getMemoryUsage (destPath), 0 };
+
+        const ScopedLock sl (lock);
+        addItem (strokes, hashCode, std::move (item));
+    }
+
+    std::shared_ptr<const EdgeTable> getEdgeTable (const Path& path, const AffineTransform& transform)
+    {
+        auto hashCode = (int64) hashPath (path, hashTransform (transform, 14695981039346656037ull));
+
+        {
+            const ScopedLock sl (lock);
+
+            if (edgeTables.contains (hashCode))
+            {
+                auto& item = edgeTables.getReference (hashCode);
+
+                if (item.source == path && item.transform == transform)
+                {
+                    item.lastUse = ++useCounter;
+                    return item.edgeTable;
+                }
+            }
+        }
+
+        // The table is built for the whole path, with a pixel to spare on each side so that
+        // none of its edges get clamped. Very big paths (e.g. something that's been zoomed
+        // in on) are left to the caller, which only needs to build the visible part.
+        auto bounds = path.getBoundsTransformed (transform).getSmallestIntegerContainer().expanded (1);
+
+        if (bounds.getWidth() > maxEdgeTableSize || bounds.getHeight() > maxEdgeTableSize)
+            return {};
+
+        auto edgeTable = std::make_shared<EdgeTable> (bounds, path, transform);
+        edgeTable->optimiseTable();   // (it'll be kept for a while, so don't hang on to any spare space)
+        auto numBytes = getMemoryUsage (path) + getMemoryUsage (*edgeTable);
+
+        const ScopedLock sl (lock);
+
+        if (numBytes <= maxBytes.load() / 4)
+            addItem (edgeTables, hashCode, EdgeTableItem { path, transform, edgeTable, numBytes, 0 });
+
+        return edgeTable;
+    }
+
+private:
+    //==============================================================================
+    struct StrokeItem
+    {
+        Path source;
+        AffineTransform transform;
+        PathStrokeType strokeType { 0.0f };
+        float extraAccuracy = 1.0f;
+        Path stroke;
+        size_t numBytes = 0;
+        uint64 lastUse = 0;
+    };
+
+    struct EdgeTableItem
+    {
+        Path source;
+        AffineTransform transform;
+        std::shared_ptr<const EdgeTable> edgeTable;
+        size_t numBytes = 0;
+        uint64 lastUse = 0;
+    };
+
+    enum { maxEdgeTableSize = 4096 };
+
+    HashMap<int64, StrokeItem> strokes;
+    HashMap<int64, EdgeTableItem> edgeTables;
+    CriticalSection lock;
+    std::atomic<size_t> maxBytes { 0 };
+    size_t totalBytes = 0;
+    uint64 useCounter = 0;
+
+    //==============================================================================
+    static uint64 hashValue (uint64 hash, float value) noexcept
+    {
+        uint32 bits;
+        memcpy (&bits, &value, sizeof (bits));
+        return (hash ^ bits) * 1099511628211ull;
+    }
+
+    static uint64 hashTransform (const AffineTransform& t, uint64 hash) noexcept
+    {
+        for (auto v : { t.mat00, t.mat01, t.mat02, t.mat10, t.mat11, t.mat12 })
+            hash = hashValue (hash, v);
+
+        return hash;
+    }
+
+    static uint64 hashPath (const Path& path, uint64 hash) noexcept
+    {
+        hash = (hash ^ (path.useNonZeroWinding ? 1u : 2u)) * 1099511628211ull;
+
+        for (auto v : path.data)
+            hash = hashValue (hash, v);
+
+        return hash;
+    }
+
+    static uint64 hashStroke (const Path& path, const PathStrokeType& strokeType,
+                              const AffineTransform& transform, float extraAccuracy) noexcept
+    {
+        auto hash = hashTransform (transform, 14695981039346656037ull);
+        hash = hashValue (hash, strokeType.getStrokeThickness());
+        hash = hashValue (hash, extraAccuracy);
+        hash = (hash ^ (uint64) (strokeType.getJointStyle() * 4 + strokeType.getEndStyle())) * 1099511628211ull;
+        return hashPath (path, hash);
+    }
+
+    static size_t getMemoryUsage (const Path& path) noexcept
+    {
+        return sizeof (Path) + (size_t) path.data.size() * sizeof (float);
+    }
+
+    static size_t getMemoryUsage (const EdgeTable& edgeTable) noexcept
+    {
+        return sizeof (EdgeTable) + (size_t) (edgeTable.bounds.getHeight() + 2)
+                                      * (size_t) edgeTable.lineStrideElements * sizeof (int);
+    }
+
+    //==============================================================================
+    template <typename ItemType>
+    void addItem (HashMap<int64, ItemType>& items, int64 hashCode, ItemType&& item)
+    {
+        if (! isEnabled())
+            return;
+
+        if (items.contains (hashCode))
+            totalBytes -= items.getReference (hashCode).numBytes;
+
+        item.lastUse = ++useCounter;
+        totalBytes += item.numBytes;
+        items.set (hashCode, std::move (item));
+
+        trimToBudget();
+    }
+
+    template <typename ItemType>
+    static bool findOldest (HashMap<int64, ItemType>& items, uint64& oldestUse, int64& oldestHashCode)
+    {
+        bool found = false;
+
+        for (typename HashMap<int64, ItemType>::Iterator i (items); i.next();)
+        {
+            auto& item = items.getReference (i.getKey());
+
+            if (! found || item.lastUse < oldestUse)
+            {
+                oldestUse = item.lastUse;
+                oldestHashCode = i.getKey();
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+    template <typename ItemType>
+    void removeItem (HashMap<int64, ItemType>& items, int64 hashCode)
+    {
+        totalBytes -= items.getReference (hashCode).numBytes;
+        items.remove (hashCode);
+    }
+
+    void trimToBudget()
+    {
+        while (totalBytes > maxBytes.load())
+        {
+            uint64 oldestStrokeUse = 0, oldestEdgeTableUse = 0;
+            int64 oldestStroke = 0, oldestEdgeTable = 0;
+
+            auto foundStroke    = findOldest (strokes, oldestStrokeUse, oldestStroke);
+            auto foundEdgeTable = findOldest (edgeTables, oldestEdgeTableUse, oldestEdgeTable);
+
+            if (foundEdgeTable && (! foundStroke || oldestEdgeTableUse < oldestStrokeUse))
+                removeItem (edgeTables, oldestEdgeTable);
+            else if (foundStroke)
+                removeItem (strokes, oldestStroke);
+            else
+                break;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
+
+JUCE_IMPLEMENT_SINGLETON (PathCache::Pimpl)
+
+//==============================================================================
+void PathCache::setMaximumCacheSize (size_t maxBytes)
+{
+    if (maxBytes > 0)
+        Pimpl::getInstance()->setMaximumCacheSize (maxBytes);
+    else if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        instance->setMaximumCacheSize (0);
+}
+
+size_t PathCache::getCacheSizeInBytes()
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        return instance->getCacheSizeInBytes();
+
+    return 0;
+}
+
+void PathCache::clear()
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        instance->clear();
+}
+
+void PathCache::createStrokedPath (Path& destPath, const Path& sourcePath, const PathStrokeType& strokeType,
+                                   const AffineTransform& transform, float extraAccuracy)
+{
+    auto* instance = Pimpl::getInstanceWithoutCreating();
+
+    if (instance != nullptr && instance->isEnabled())
+        instance->createStrokedPath (destPath, sourcePath, strokeType, transform, extraAccuracy);
+    else
+        strokeType.createStrokedPath (destPath, sourcePath, transform, extraAccuracy);
+}
+
+std::shared_ptr<const EdgeTable> PathCache::getEdgeTable (const Path& path, const AffineTransform& transform)
+{
+    auto* instance = Pimpl::getInstanceWithoutCreating();
+
+    if (instance != nullptr && instance->isEnabled())
+        return instance->getEdgeTable (path, transform);
+
+    return {};
+}
+
+} // namespace juce
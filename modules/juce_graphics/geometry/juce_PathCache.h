@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    An optional cache of the work that's done when paths are stroked and filled.
+
+    Stroking a path means flattening its curves and building an outline for it, and
+    filling one with the software renderer means flattening it again into an EdgeTable.
+    If the same path gets drawn with the same transform over and over again (e.g. a
+    vector-drawn control that repaints at the frame rate), all of that work is repeated
+    on every frame. When this cache is enabled, Graphics::strokePath() keeps the stroked
+    outlines that it creates, and the software renderer keeps the edge tables that it
+    builds, so that identical requests can re-use them.
+
+    Entries are matched on the path's contents, the transform and (for strokes) the
+    stroke parameters, so it doesn't matter whether the same Path object is used each
+    time. When the cache goes over its size limit, the least recently used entries are
+    thrown away.
+
+    The cache is disabled by default. Call setMaximumCacheSize() to turn it on.
+
+    @see Graphics::strokePath, Graphics::fillPath
+
+    @tags{Graphics}
+*/
+class JUCE_API  PathCache
+{
+public:
+    //==============================================================================
+    /** Sets the number of bytes that the cache may use, or disables it if this is 0.
+
+        It's disabled by default. Making it smaller will release the least recently used
+        entries until it fits.
+    */
+    static void setMaximumCacheSize (size_t maxBytes);
+
+    /** Returns the number of bytes that the cache is currently using. */
+    static size_t getCacheSizeInBytes();
+
+    /** Releases everything that the cache is holding. */
+    static void clear();
+
+    //==============================================================================
+    /** Creates a stroked version of a path, or copies it from the cache if an identical
+        one has already been made.
+
+        The arguments are the same as for PathStrokeType::createStrokedPath(). If the
+        cache is disabled, this just calls that method.
+    */
+    static void createStrokedPath (Path& destPath, const Path& sourcePath,
+                                   const PathStrokeType& strokeType,
+                                   const AffineTransform& transform, float extraAccuracy);
+
+    /** Returns an EdgeTable for the whole of a path drawn with the given transform.
+
+        This returns nullptr if the cache is disabled, or if the path is too large to be
+        worth caching, in which case the caller should build its own EdgeTable. The table
+        that's returned covers everything that the path touches, so it'll usually need
+        to be copied and clipped before being used.
+    */
+    static std::shared_ptr<const EdgeTable> getEdgeTable (const Path& path, const AffineTransform& transform);
+
+private:
+    //==============================================================================
+    struct Pimpl;
+    friend struct Pimpl;
+
+    PathCache();
+    ~PathCache();
+
+    JUCE_DECLARE_NON_COPYABLE (PathCache)
+};
+
+} // namespace juce
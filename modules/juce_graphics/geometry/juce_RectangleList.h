@@ -586,6 +586,52 @@ public:
         }
     }
 
+    /** Replaces rectangles that are close together with the rectangle that encloses them.
+
+        Two rectangles get merged when the rectangle enclosing them is no more than
+        (1 + maxExtraAreaProportion) times as big as the area that it replaces, and doesn't
+        cut through any of the other rectangles. Afterwards the list may cover a bit more
+        area than it did before. This is useful
+        for lists of regions that need repainting, where each separate rectangle has an
+        overhead, so painting a few extra pixels is cheaper than painting lots of small
+        pieces separately.
+    */
+    void mergeNearbyRectangles (double maxExtraAreaProportion = 0.25)
+    {
+        for (int i = 0; i < rects.size() - 1; ++i)
+        {
+            for (int j = rects.size(); --j > i;)
+            {
+                auto enclosing = rects.getReference (i).getUnion (rects.getReference (j));
+                auto areaReplaced = getArea (rects.getReference (i)) + getArea (rects.getReference (j));
+                bool canMerge = true;
+
+                // any other rectangles that it overlaps must fit inside it, and will be absorbed
+                for (int k = 0; k < rects.size() && canMerge; ++k)
+                {
+                    if (k != i && k != j && enclosing.intersects (rects.getReference (k)))
+                    {
+                        if (enclosing.contains (rects.getReference (k)))
+                            areaReplaced += getArea (rects.getReference (k));
+                        else
+                            canMerge = false;
+                    }
+                }
+
+                if (canMerge && getArea (enclosing) <= areaReplaced * (1.0 + maxExtraAreaProportion))
+                {
+                    for (int k = rects.size(); --k >= 0;)
+                        if (enclosing.contains (rects.getReference (k)))
+                            rects.remove (k);
+
+                    rects.add (enclosing);
+                    i = -1;
+                    break;
+                }
+            }
+        }
+    }
+
     /** Adds an x and y value to all the coordinates. */
     void offsetAll (Point<ValueType> offset) noexcept
     {
@@ -649,6 +695,8 @@ public:
 private:
     //==============================================================================
     Array<RectangleType> rects;
+
+    static double getArea (RectangleType r) noexcept     { return (double) r.getWidth() * (double) r.getHeight(); }
 };
 
 } // namespace juce
@@ -129,6 +129,257 @@ namespace jpeglibNamespace
     #include "jpglib/jutils.c"
     #include "jpglib/transupp.c"
 
+    #if JUCE_USE_SSE_INTRINSICS
+    /*  SSE2 versions of the two hottest parts of libjpeg's decoder, which are installed
+        over the originals once decompression has started.
+
+        The IDCT does exactly the same integer arithmetic as jpeg_idct_islow(), with
+        each of its multiplications rearranged so that pairs of them can be done with
+        _mm_madd_epi16, and the colour conversion uses the same fixed-point constants
+        as ycc_rgb_convert(), so the decoded pixels are identical.
+    */
+    namespace SSE2Decoding
+    {
+        static inline __m128i pairConstant (short a, short b) noexcept
+        {
+            return _mm_set_epi16 (b, a, b, a, b, a, b, a);
+        }
+
+        // Calculates (x * cx + y * cy) for the two halves of a pair of vectors
+        struct MultiplyPairs
+        {
+            MultiplyPairs (__m128i x, __m128i y) noexcept
+                : lo (_mm_unpacklo_epi16 (x, y)), hi (_mm_unpackhi_epi16 (x, y)) {}
+
+            void multiply (__m128i constants, __m128i& resultLo, __m128i& resultHi) const noexcept
+            {
+                resultLo = _mm_madd_epi16 (lo, constants);
+                resultHi = _mm_madd_epi16 (hi, constants);
+            }
+
+            __m128i lo, hi;
+        };
+
+        template <int shift>
+        static inline __m128i shiftAndPack (__m128i lo, __m128i hi) noexcept
+        {
+            return _mm_packs_epi32 (_mm_srai_epi32 (lo, shift), _mm_srai_epi32 (hi, shift));
+        }
+
+        template <int shift>
+        static inline __m128i descaleAndPack (__m128i lo, __m128i hi) noexcept
+        {
+            const auto rounding = _mm_set1_epi32 (1 << (shift - 1));
+            return shiftAndPack<shift> (_mm_add_epi32 (lo, rounding), _mm_add_epi32 (hi, rounding));
+        }
+
+        // One 1-D pass of the 8x8 IDCT, done on 8 columns at once. N.B. jidctfst.c gets included
+        // before jidctint.c, and its truncating version of DESCALE is the one that jpeg_idct_islow()
+        // ends up using, so no rounding is done here either
+        template <int shift>
+        static void idctPass (__m128i* v) noexcept
+        {
+            // Even part
+            MultiplyPairs p26 (v[2], v[6]), p04 (v[0], v[4]);
+            __m128i tmp0l, tmp0h, tmp1l, tmp1h, tmp2l, tmp2h, tmp3l, tmp3h;
+
+            p26.multiply (pairConstant (4433, -10704), tmp2l, tmp2h);      // FIX_0_541196100, - FIX_1_847759065
+            p26.multiply (pairConstant (10703, 4433),  tmp3l, tmp3h);      // + FIX_0_765366865
+            p04.multiply (pairConstant (8192, 8192),   tmp0l, tmp0h);      // << CONST_BITS
+            p04.multiply (pairConstant (8192, -8192),  tmp1l, tmp1h);
+
+            auto tmp10l = _mm_add_epi32 (tmp0l, tmp3l), tmp10h = _mm_add_epi32 (tmp0h, tmp3h);
+            auto tmp13l = _mm_sub_epi32 (tmp0l, tmp3l), tmp13h = _mm_sub_epi32 (tmp0h, tmp3h);
+            auto tmp11l = _mm_add_epi32 (tmp1l, tmp2l), tmp11h = _mm_add_epi32 (tmp1h, tmp2h);
+            auto tmp12l = _mm_sub_epi32 (tmp1l, tmp2l), tmp12h = _mm_sub_epi32 (tmp1h, tmp2h);
+
+            // Odd part: each output is jpeg_idct_islow's sum of products, expanded out
+            // in terms of the four inputs so that nothing needs to be added in 16 bits
+            MultiplyPairs p73 (v[7], v[1]), p35 (v[3], v[5]);
+            __m128i al, ah, bl, bh;
+
+            p73.multiply (pairConstant (-11363, 2260), al, ah);
+            p35.multiply (pairConstant (-6436, 9633),  bl, bh);
+            tmp0l = _mm_add_epi32 (al, bl);  tmp0h = _mm_add_epi32 (ah, bh);
+
+            p73.multiply (pairConstant (9633, 6437),   al, ah);
+            p35.multiply (pairConstant (-11362, 2261), bl, bh);
+            tmp1l = _mm_add_epi32 (al, bl);  tmp1h = _mm_add_epi32 (ah, bh);
+
+            p73.multiply (pairConstant (-6436, 9633),  al, ah);
+            p35.multiply (pairConstant (-2259, -11362), bl, bh);
+            tmp2l = _mm_add_epi32 (al, bl);  tmp2h = _mm_add_epi32 (ah, bh);
+
+            p73.multiply (pairConstant (2260, 11363),  al, ah);
+            p35.multiply (pairConstant (9633, 6437),   bl, bh);
+            tmp3l = _mm_add_epi32 (al, bl);  tmp3h = _mm_add_epi32 (ah, bh);
+
+            v[0] = shiftAndPack<shift> (_mm_add_epi32 (tmp10l, tmp3l), _mm_add_epi32 (tmp10h, tmp3h));
+            v[7] = shiftAndPack<shift> (_mm_sub_epi32 (tmp10l, tmp3l), _mm_sub_epi32 (tmp10h, tmp3h));
+            v[1] = shiftAndPack<shift> (_mm_add_epi32 (tmp11l, tmp2l), _mm_add_epi32 (tmp11h, tmp2h));
+            v[6] = shiftAndPack<shift> (_mm_sub_epi32 (tmp11l, tmp2l), _mm_sub_epi32 (tmp11h, tmp2h));
+            v[2] = shiftAndPack<shift> (_mm_add_epi32 (tmp12l, tmp1l), _mm_add_epi32 (tmp12h, tmp1h));
+            v[5] = shiftAndPack<shift> (_mm_sub_epi32 (tmp12l, tmp1l), _mm_sub_epi32 (tmp12h, tmp1h));
+            v[3] = shiftAndPack<shift> (_mm_add_epi32 (tmp13l, tmp0l), _mm_add_epi32 (tmp13h, tmp0h));
+            v[4] = shiftAndPack<shift> (_mm_sub_epi32 (tmp13l, tmp0l), _mm_sub_epi32 (tmp13h, tmp0h));
+        }
+
+        static void transpose (__m128i* v) noexcept
+        {
+            auto a0 = _mm_unpacklo_epi16 (v[0], v[1]), a1 = _mm_unpackhi_epi16 (v[0], v[1]);
+            auto a2 = _mm_unpacklo_epi16 (v[2], v[3]), a3 = _mm_unpackhi_epi16 (v[2], v[3]);
+            auto a4 = _mm_unpacklo_epi16 (v[4], v[5]), a5 = _mm_unpackhi_epi16 (v[4], v[5]);
+            auto a6 = _mm_unpacklo_epi16 (v[6], v[7]), a7 = _mm_unpackhi_epi16 (v[6], v[7]);
+
+            auto b0 = _mm_unpacklo_epi32 (a0, a2), b1 = _mm_unpackhi_epi32 (a0, a2);
+            auto b2 = _mm_unpacklo_epi32 (a1, a3), b3 = _mm_unpackhi_epi32 (a1, a3);
+            auto b4 = _mm_unpacklo_epi32 (a4, a6), b5 = _mm_unpackhi_epi32 (a4, a6);
+            auto b6 = _mm_unpacklo_epi32 (a5, a7), b7 = _mm_unpackhi_epi32 (a5, a7);
+
+            v[0] = _mm_unpacklo_epi64 (b0, b4);  v[1] = _mm_unpackhi_epi64 (b0, b4);
+            v[2] = _mm_unpacklo_epi64 (b1, b5);  v[3] = _mm_unpackhi_epi64 (b1, b5);
+            v[4] = _mm_unpacklo_epi64 (b2, b6);  v[5] = _mm_unpackhi_epi64 (b2, b6);
+            v[6] = _mm_unpacklo_epi64 (b3, b7);  v[7] = _mm_unpackhi_epi64 (b3, b7);
+        }
+
+        static void idctIslow (j_decompress_ptr, jpeg_component_info* compptr, JCOEFPTR coefBlock,
+                               JSAMPARRAY outputBuf, JDIMENSION outputCol)
+        {
+            auto* quantTable = (const ISLOW_MULT_TYPE*) compptr->dct_table;
+            __m128i v[DCTSIZE];
+
+            for (int i = 0; i < DCTSIZE; ++i)
+            {
+                auto coefs = _mm_loadu_si128 ((const __m128i*) (coefBlock + i * DCTSIZE));
+                auto quant = _mm_packs_epi32 (_mm_loadu_si128 ((const __m128i*) (quantTable + i * DCTSIZE)),
+                                              _mm_loadu_si128 ((const __m128i*) (quantTable + i * DCTSIZE + 4)));
+                v[i] = _mm_mullo_epi16 (coefs, quant);
+            }
+
+            enum { constBits = 13, pass1Bits = 2 };    // as in jidctint.c
+
+            idctPass<constBits - pass1Bits> (v);        // columns
+            transpose (v);
+            idctPass<constBits + pass1Bits + 3> (v);    // rows
+            transpose (v);
+
+            const auto centre = _mm_set1_epi16 (CENTERJSAMPLE);
+
+            for (int i = 0; i < DCTSIZE; ++i)
+                _mm_storel_epi64 ((__m128i*) (outputBuf[i] + outputCol),
+                                  _mm_packus_epi16 (_mm_adds_epi16 (v[i], centre), _mm_setzero_si128()));
+        }
+
+        //==============================================================================
+        // The fixed-point multipliers from jdcolor.c, i.e. FIX(1.40200), FIX(0.34414), etc.
+        enum
+        {
+            scaleBits = 16,
+            rounding = 1 << (scaleBits - 1),
+            redFromRed = 91881,
+            greenFromBlue = 22554,
+            greenFromRed = 46802,
+            blueFromBlue = 116130,
+            redFraction = redFromRed - (1 << scaleBits),
+            greenFromRedFraction = (1 << scaleBits) - greenFromRed,
+            blueFraction = (2 << scaleBits) - blueFromBlue
+        };
+
+        template <int redIndex, int blueIndex>
+        static void storePixel (JSAMPROW dest, int r, int g, int b) noexcept
+        {
+            dest[redIndex]  = (JSAMPLE) jlimit (0, MAXJSAMPLE, r);
+            dest[1]         = (JSAMPLE) jlimit (0, MAXJSAMPLE, g);
+            dest[blueIndex] = (JSAMPLE) jlimit (0, MAXJSAMPLE, b);
+        }
+
+        // Writes the YCbCr -> RGB conversion straight out in the byte order that's needed
+        template <int redIndex, int blueIndex>
+        static void yccToRGB (j_decompress_ptr cinfo, JSAMPIMAGE inputBuf, JDIMENSION inputRow,
+                              JSAMPARRAY outputBuf, int numRows)
+        {
+            const auto numCols = (int) cinfo->output_width;
+            const auto zero = _mm_setzero_si128();
+            const auto centre = _mm_set1_epi16 (CENTERJSAMPLE);
+
+            while (--numRows >= 0)
+            {
+                auto* y  = inputBuf[0][inputRow];
+                auto* cb = inputBuf[1][inputRow];
+                auto* cr = inputBuf[2][inputRow];
+                auto* dest = *outputBuf++;
+                ++inputRow;
+
+                int col = 0;
+
+                for (; col + 8 <= numCols; col += 8, dest += 8 * 3)
+                {
+                    auto y16  = _mm_unpacklo_epi8 (_mm_loadl_epi64 ((const __m128i*) (y + col)), zero);
+                    auto cb16 = _mm_sub_epi16 (_mm_unpacklo_epi8 (_mm_loadl_epi64 ((const __m128i*) (cb + col)), zero), centre);
+                    auto cr16 = _mm_sub_epi16 (_mm_unpacklo_epi8 (_mm_loadl_epi64 ((const __m128i*) (cr + col)), zero), centre);
+                    __m128i lo, hi;
+
+                    // The multipliers that don't fit into 16 bits are split into a whole part and a fraction:
+                    // r = y + 1.40200 * cr = y + cr + 0.40200 * cr
+                    MultiplyPairs (cr16, zero).multiply (pairConstant (redFraction, 0), lo, hi);
+                    auto r = _mm_add_epi16 (_mm_add_epi16 (y16, cr16), descaleAndPack<scaleBits> (lo, hi));
+
+                    // g = y - 0.34414 * cb - 0.71414 * cr = y - cr - 0.34414 * cb + 0.28586 * cr
+                    MultiplyPairs (cb16, cr16).multiply (pairConstant (-greenFromBlue, greenFromRedFraction), lo, hi);
+                    auto g = _mm_add_epi16 (_mm_sub_epi16 (y16, cr16), descaleAndPack<scaleBits> (lo, hi));
+
+                    // b = y + 1.77200 * cb = y + 2 * cb - 0.22800 * cb
+                    MultiplyPairs (cb16, zero).multiply (pairConstant (-blueFraction, 0), lo, hi);
+                    auto b = _mm_add_epi16 (_mm_add_epi16 (y16, _mm_add_epi16 (cb16, cb16)), descaleAndPack<scaleBits> (lo, hi));
+
+                    auto first  = _mm_packus_epi16 (redIndex == 0 ? r : b, zero);
+                    auto second = _mm_packus_epi16 (g, zero);
+                    auto third  = _mm_packus_epi16 (redIndex == 0 ? b : r, zero);
+
+                    auto firstSecond = _mm_unpacklo_epi8 (first, second);
+                    auto thirdZero = _mm_unpacklo_epi8 (third, zero);
+                    __m128i pixels[] = { _mm_unpacklo_epi16 (firstSecond, thirdZero),
+                                         _mm_unpackhi_epi16 (firstSecond, thirdZero) };
+
+                    // The pixels are stored 4 bytes at a time, each overwriting the spare byte of the one
+                    // before, apart from the last one, which mustn't go past the end of the row
+                    uint32 packed[8];
+                    _mm_storeu_si128 ((__m128i*) packed, pixels[0]);
+                    _mm_storeu_si128 ((__m128i*) (packed + 4), pixels[1]);
+
+                    for (int i = 0; i < 7; ++i)
+                        memcpy (dest + i * 3, packed + i, 4);
+
+                    memcpy (dest + 7 * 3, packed + 7, 3);
+                }
+
+                for (; col < numCols; ++col, dest += 3)
+                {
+                    const int yy = y[col], cbb = cb[col] - CENTERJSAMPLE, crr = cr[col] - CENTERJSAMPLE;
+
+                    storePixel<redIndex, blueIndex> (dest,
+                                                     yy + (int) RIGHT_SHIFT (redFromRed * crr + rounding, scaleBits),
+                                                     yy + (int) RIGHT_SHIFT (-greenFromBlue * cbb - greenFromRed * crr + rounding, scaleBits),
+                                                     yy + (int) RIGHT_SHIFT (blueFromBlue * cbb + rounding, scaleBits));
+                }
+            }
+        }
+
+        // Call this after jpeg_start_decompress() to replace the default IDCT and
+        // colour conversion. The RGB components will be written in the order given.
+        template <int redIndex, int blueIndex>
+        static void install (j_decompress_ptr cinfo)
+        {
+            for (int i = 0; i < cinfo->num_components; ++i)
+                if (cinfo->idct->inverse_DCT[i] == jpeg_idct_islow)
+                    cinfo->idct->inverse_DCT[i] = idctIslow;
+
+            if (cinfo->cconvert->color_convert == ycc_rgb_convert && cinfo->out_color_space == JCS_RGB)
+                cinfo->cconvert->color_convert = yccToRGB<redIndex, blueIndex>;
+        }
+    }
+    #endif
+
     #if JUCE_CLANG
      #pragma clang diagnostic pop
     #endif
@@ -330,7 +581,37 @@ Image JPEGImageFormat::decodeImage (InputStream& in)
 
                     const Image::BitmapData destData (image, Image::BitmapData::writeOnly);
 
-                    for (int y = 0; y < height; ++y)
+                    // If the image is laid out as packed 3-byte pixels in the order that the colour
+                    // conversion produces, libjpeg can write its scanlines straight into it, rather
+                    // than going via the temporary buffer
+                   #if JUCE_USE_SSE_INTRINSICS
+                    const bool canDecodeDirectly = ! hasAlphaChan && destData.pixelStride == 3;
+
+                    if (canDecodeDirectly)
+                        SSE2Decoding::install<PixelRGB::indexR, PixelRGB::indexB> (&jpegDecompStruct);
+                    else
+                        SSE2Decoding::install<0, 2> (&jpegDecompStruct);
+                   #else
+                    const bool canDecodeDirectly = ! hasAlphaChan && destData.pixelStride == 3 && PixelRGB::indexR == 0;
+                   #endif
+
+                    for (int y = 0; canDecodeDirectly && y < height;)
+                    {
+                        JSAMPROW rows[16];
+                        auto numRows = jmin (height - y, (int) numElementsInArray (rows));
+
+                        for (int i = 0; i < numRows; ++i)
+                            rows[i] = destData.getLinePointer (y + i);
+
+                        auto numRead = (int) jpeg_read_scanlines (&jpegDecompStruct, rows, (JDIMENSION) numRows);
+
+                        if (hasFailed || numRead <= 0)
+                            break;
+
+                        y += numRead;
+                    }
+
+                    for (int y = 0; ! canDecodeDirectly && y < height; ++y)
                     {
                         jpeg_read_scanlines (&jpegDecompStruct, buffer, 1);
 
@@ -44,6 +44,11 @@ void ImagePixelData::sendDataChangeMessage()
     listeners.call ([this] (Listener& l) { l.imageDataChanged (this); });
 }
 
+void ImagePixelData::sendDataChangeMessage (Rectangle<int> changedArea)
+{
+    listeners.call ([this, changedArea] (Listener& l) { l.imageAreaChanged (this, changedArea); });
+}
+
 int ImagePixelData::getSharedCount() const noexcept
 {
     return getReferenceCount();
@@ -104,7 +109,7 @@ public:
         bitmap.pixelStride = pixelStride;
 
         if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
+            sendDataChangeMessage ({ x, y, bitmap.width, bitmap.height });
     }
 
     ImagePixelData::Ptr clone() override
@@ -175,7 +180,7 @@ public:
         sourceImage->initialiseBitmapData (bitmap, x + area.getX(), y + area.getY(), mode);
 
         if (mode != Image::BitmapData::readOnly)
-            sendDataChangeMessage();
+            sendDataChangeMessage ({ x, y, bitmap.width, bitmap.height });
     }
 
     ImagePixelData::Ptr clone() override
@@ -302,6 +307,11 @@ Image Image::rescaled (int newWidth, int newHeight, Graphics::ResamplingQuality
     if (image == nullptr || (image->width == newWidth && image->height == newHeight))
         return *this;
 
+    if (quality != Graphics::lowResamplingQuality)
+        return ImageResampler::resample (*this, newWidth, newHeight,
+                                         quality == Graphics::highResamplingQuality ? ImageResampler::lanczos3
+                                                                                    : ImageResampler::bicubic);
+
     const std::unique_ptr<ImageType> type (image->createType());
     Image newImage (type->create (image->pixelFormat, newWidth, newHeight, hasAlphaChannel()));
 
@@ -194,6 +194,10 @@ public:
 
         A new image is returned which is a copy of this one, rescaled to the given size.
 
+        For the medium and high qualities, this uses an ImageResampler, which area-averages
+        when shrinking and uses a bicubic or Lanczos filter respectively when enlarging. The
+        low quality setting just draws the image with nearest-neighbour sampling.
+
         Note that if the new size is identical to the existing image, this will just return
         a reference to the original image, and won't actually create a duplicate.
     */
@@ -479,12 +483,22 @@ public:
 
         virtual void imageDataChanged (ImagePixelData*) = 0;
         virtual void imageDataBeingDeleted (ImagePixelData*) = 0;
+
+        /** Called instead of imageDataChanged() when only part of the image is about to be
+            modified, e.g. by a writable Image::BitmapData. By default this just treats the
+            whole image as having changed.
+        */
+        virtual void imageAreaChanged (ImagePixelData* data, Rectangle<int> /*area*/)   { imageDataChanged (data); }
     };
 
     ListenerList<Listener> listeners;
 
+    /** Tells the listeners that the whole image is about to change. */
     void sendDataChangeMessage();
 
+    /** Tells the listeners that the given area of the image is about to change. */
+    void sendDataChangeMessage (Rectangle<int> changedArea);
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImagePixelData)
 };
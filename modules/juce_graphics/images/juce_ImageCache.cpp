@@ -31,25 +31,28 @@ struct ImageCache::Pimpl     : private Timer,
                                private DeletedAtShutdown
 {
     Pimpl() {}
-    ~Pimpl() override { clearSingletonInstance(); }
 
-    JUCE_DECLARE_SINGLETON_SINGLETHREADED_MINIMAL (ImageCache::Pimpl)
+    ~Pimpl() override
+    {
+        decodeThreads.reset();
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON (ImageCache::Pimpl, false)
 
     Image getFromHashCode (const int64 hashCode) noexcept
     {
         const ScopedLock sl (lock);
 
-        for (auto& item : images)
+        if (images.contains (hashCode))
         {
-            if (item.hashCode == hashCode)
-            {
-                item.lastUseTime = Time::getApproximateMillisecondCounter();
-                return item.image;
-            }
+            auto& item = images.getReference (hashCode);
+            item.lastUseTime = Time::getApproximateMillisecondCounter();
+            return item.image;
         }
 
         return {};
-     }
+    }
 
     void addImageToCache (const Image& image, const int64 hashCode)
     {
@@ -59,7 +62,15 @@ struct ImageCache::Pimpl     : private Timer,
                 startTimer (2000);
 
             const ScopedLock sl (lock);
-            images.add ({ image, hashCode, Time::getApproximateMillisecondCounter() });
+
+            if (images.contains (hashCode))
+                totalBytes -= images.getReference (hashCode).numBytes;
+
+            auto numBytes = getImageSizeInBytes (image);
+            images.set (hashCode, { image, numBytes, Time::getApproximateMillisecondCounter() });
+            totalBytes += numBytes;
+
+            trimToBudget();
         }
     }
 
@@ -68,15 +79,16 @@ struct ImageCache::Pimpl     : private Timer,
         auto now = Time::getApproximateMillisecondCounter();
 
         const ScopedLock sl (lock);
+        Array<int64> expired;
 
-        for (int i = images.size(); --i >= 0;)
+        for (HashMap<int64, Item>::Iterator i (images); i.next();)
         {
-            auto& item = images.getReference(i);
+            auto& item = images.getReference (i.getKey());
 
             if (item.image.getReferenceCount() <= 1)
             {
                 if (now > item.lastUseTime + cacheTimeout || now < item.lastUseTime - 1000)
-                    images.remove (i);
+                    expired.add (i.getKey());
             }
             else
             {
@@ -84,29 +96,150 @@ struct ImageCache::Pimpl     : private Timer,
             }
         }
 
-        if (images.isEmpty())
+        for (auto hashCode : expired)
+            removeItem (hashCode);
+
+        if (images.size() == 0)
             stopTimer();
     }
 
     void releaseUnusedImages()
+    {
+        const ScopedLock sl (lock);
+        Array<int64> unused;
+
+        for (HashMap<int64, Item>::Iterator i (images); i.next();)
+            if (images.getReference (i.getKey()).image.getReferenceCount() <= 1)
+                unused.add (i.getKey());
+
+        for (auto hashCode : unused)
+            removeItem (hashCode);
+    }
+
+    void setMaximumCacheSize (size_t newMaxBytes)
+    {
+        const ScopedLock sl (lock);
+        maxBytes = newMaxBytes;
+        trimToBudget();
+    }
+
+    size_t getCacheSizeInBytes() const
+    {
+        const ScopedLock sl (lock);
+        return totalBytes;
+    }
+
+    //==============================================================================
+    void decodeAsync (const File& file, int64 scaledHashCode, float scaleFactor,
+                      std::function<void (const Image&)> callback)
     {
         const ScopedLock sl (lock);
 
-        for (int i = images.size(); --i >= 0;)
-            if (images.getReference(i).image.getReferenceCount() <= 1)
-                images.remove (i);
+        // if this image is already being decoded, just wait for that job to finish
+        for (auto* pending : pendingDecodes)
+        {
+            if (pending->hashCode == scaledHashCode)
+            {
+                pending->callbacks.push_back (std::move (callback));
+                return;
+            }
+        }
+
+        pendingDecodes.add (new PendingDecode { scaledHashCode, { std::move (callback) } });
+
+        if (decodeThreads == nullptr)
+            decodeThreads.reset (new ThreadPool (jlimit (1, 4, SystemStats::getNumCpus() / 2)));
+
+        decodeThreads->addJob ([this, file, scaledHashCode, scaleFactor]
+        {
+            auto image = ImageCache::getFromFile (file, scaleFactor);
+            std::vector<std::function<void (const Image&)>> callbacks;
+
+            {
+                const ScopedLock pendingLock (lock);
+
+                for (int i = pendingDecodes.size(); --i >= 0;)
+                {
+                    if (pendingDecodes.getUnchecked (i)->hashCode == scaledHashCode)
+                    {
+                        std::swap (callbacks, pendingDecodes.getUnchecked (i)->callbacks);
+                        pendingDecodes.remove (i);
+                        break;
+                    }
+                }
+            }
+
+            MessageManager::callAsync ([image, callbacks]
+            {
+                for (auto& cb : callbacks)
+                    cb (image);
+            });
+        });
     }
 
+    unsigned int cacheTimeout = 5000;
+
+private:
     struct Item
     {
         Image image;
-        int64 hashCode;
+        size_t numBytes;
         uint32 lastUseTime;
     };
 
-    Array<Item> images;
+    struct PendingDecode
+    {
+        int64 hashCode;
+        std::vector<std::function<void (const Image&)>> callbacks;
+    };
+
+    static size_t getImageSizeInBytes (const Image& image) noexcept
+    {
+        auto bytesPerPixel = image.isARGB() ? 4 : (image.isRGB() ? 3 : 1);
+        return (size_t) image.getWidth() * (size_t) image.getHeight() * (size_t) bytesPerPixel;
+    }
+
+    void removeItem (int64 hashCode)
+    {
+        totalBytes -= images.getReference (hashCode).numBytes;
+        images.remove (hashCode);
+    }
+
+    // Drops the least recently used images that nobody else is holding on to,
+    // until the cache fits inside its budget again.
+    void trimToBudget()
+    {
+        while (totalBytes > maxBytes)
+        {
+            int64 oldestHashCode = 0;
+            uint32 oldestTime = 0;
+            bool found = false;
+
+            for (HashMap<int64, Item>::Iterator i (images); i.next();)
+            {
+                auto& item = images.getReference (i.getKey());
+
+                if (item.image.getReferenceCount() <= 1
+                     && (! found || item.lastUseTime < oldestTime))
+                {
+                    oldestHashCode = i.getKey();
+                    oldestTime = item.lastUseTime;
+                    found = true;
+                }
+            }
+
+            if (! found)
+                break;
+
+            removeItem (oldestHashCode);
+        }
+    }
+
+    HashMap<int64, Item> images;
+    OwnedArray<PendingDecode> pendingDecodes;
     CriticalSection lock;
-    unsigned int cacheTimeout = 5000;
+    size_t totalBytes = 0, maxBytes = 64 * 1024 * 1024;
+    std::unique_ptr<ThreadPool> decodeThreads;
 
     JUCE_DECLARE_NON_COPYABLE (Pimpl)
 };
@@ -115,10 +248,39 @@ JUCE_IMPLEMENT_SINGLETON (ImageCache::Pimpl)
 
 
 //==============================================================================
+static int64 getHashCodeForScale (int64 hashCode, float scaleFactor) noexcept
+{
+    if (scaleFactor == 1.0f)
+        return hashCode;
+
+    return (int64) ((uint64) hashCode * 1000003u + (uint64) roundToInt (scaleFactor * 1000.0f));
+}
+
+static Image getRescaledVersion (const Image& original, int64 hashCode, float scaleFactor)
+{
+    jassert (scaleFactor > 0.0f);
+
+    if (original.isNull() || scaleFactor == 1.0f)
+        return original;
+
+    auto scaledHashCode = getHashCodeForScale (hashCode, scaleFactor);
+    auto image = ImageCache::getFromHashCode (scaledHashCode);
+
+    if (image.isNull())
+    {
+        image = original.rescaled (jmax (1, roundToInt ((float) original.getWidth()  * scaleFactor)),
+                                   jmax (1, roundToInt ((float) original.getHeight() * scaleFactor)),
+                                   Graphics::highResamplingQuality);
+        ImageCache::addImageToCache (image, scaledHashCode);
+    }
+
+    return image;
+}
+
 Image ImageCache::getFromHashCode (const int64 hashCode)
 {
-    if (Pimpl::getInstanceWithoutCreating() != nullptr)
-        return Pimpl::getInstanceWithoutCreating()->getFromHashCode (hashCode);
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        return instance->getFromHashCode (hashCode);
 
     return {};
 }
@@ -128,40 +290,80 @@ void ImageCache::addImageToCache (const Image& image, const int64 hashCode)
     Pimpl::getInstance()->addImageToCache (image, hashCode);
 }
 
-Image ImageCache::getFromFile (const File& file)
+Image ImageCache::getFromFile (const File& file, float scaleFactor)
 {
     auto hashCode = file.hashCode64();
-    auto image = getFromHashCode (hashCode);
+    auto image = getFromHashCode (getHashCodeForScale (hashCode, scaleFactor));
 
     if (image.isNull())
     {
-        image = ImageFileFormat::loadFrom (file);
-        addImageToCache (image, hashCode);
+        image = getFromHashCode (hashCode);
+
+        if (image.isNull())
+        {
+            image = ImageFileFormat::loadFrom (file);
+            addImageToCache (image, hashCode);
+        }
+
+        image = getRescaledVersion (image, hashCode, scaleFactor);
     }
 
     return image;
 }
 
-Image ImageCache::getFromMemory (const void* imageData, const int dataSize)
+Image ImageCache::getFromMemory (const void* imageData, const int dataSize, float scaleFactor)
 {
     auto hashCode = (int64) (pointer_sized_int) imageData;
-    auto image = getFromHashCode (hashCode);
+    auto image = getFromHashCode (getHashCodeForScale (hashCode, scaleFactor));
 
     if (image.isNull())
     {
-        image = ImageFileFormat::loadFrom (imageData, (size_t) dataSize);
-        addImageToCache (image, hashCode);
+        image = getFromHashCode (hashCode);
+
+        if (image.isNull())
+        {
+            image = ImageFileFormat::loadFrom (imageData, (size_t) dataSize);
+            addImageToCache (image, hashCode);
+        }
+
+        image = getRescaledVersion (image, hashCode, scaleFactor);
     }
 
     return image;
 }
 
+void ImageCache::getFromFileAsync (const File& file, std::function<void (const Image&)> callback, float scaleFactor)
+{
+    jassert (callback != nullptr);
+
+    auto scaledHashCode = getHashCodeForScale (file.hashCode64(), scaleFactor);
+    auto image = getFromHashCode (scaledHashCode);
+
+    if (image.isValid())
+        callback (image);
+    else
+        Pimpl::getInstance()->decodeAsync (file, scaledHashCode, scaleFactor, std::move (callback));
+}
+
 void ImageCache::setCacheTimeout (const int millisecs)
 {
     jassert (millisecs >= 0);
     Pimpl::getInstance()->cacheTimeout = (unsigned int) millisecs;
 }
 
+void ImageCache::setMaximumCacheSize (size_t maxBytes)
+{
+    Pimpl::getInstance()->setMaximumCacheSize (maxBytes);
+}
+
+size_t ImageCache::getCacheSizeInBytes()
+{
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        return instance->getCacheSizeInBytes();
+
+    return 0;
+}
+
 void ImageCache::releaseUnusedImages()
 {
     Pimpl::getInstance()->releaseUnusedImages();
@@ -40,6 +40,10 @@ namespace juce
     loading/deleting the same image, it'll reduce the chances of having to reload it
     each time.
 
+    The cache also has a memory budget (see setMaximumCacheSize()). When the images
+    it holds add up to more than this, the least recently used ones that aren't
+    referenced anywhere else are released straight away.
+
     @see Image, ImageFileFormat
 
     @tags{Graphics}
@@ -58,11 +62,33 @@ public:
         affect other things that are using it! If you want to draw on it, first
         call Image::duplicateIfShared()
 
-        @param file     the file to try to load
-        @returns        the image, or null if it there was an error loading it
-        @see getFromMemory, getFromCache, ImageFileFormat::loadFrom
+        If scaleFactor isn't 1.0, the image is returned rescaled by that amount,
+        and the rescaled version is cached alongside the original, so that e.g.
+        HiDPI variants don't have to be resampled every time they're needed.
+
+        @param file         the file to try to load
+        @param scaleFactor  a scale to apply to the image's size
+        @returns            the image, or null if it there was an error loading it
+        @see getFromMemory, getFromCache, getFromFileAsync, ImageFileFormat::loadFrom
     */
-    static Image getFromFile (const File& file);
+    static Image getFromFile (const File& file, float scaleFactor = 1.0f);
+
+    /** Loads an image from a file on a background thread.
+
+        If the image is already in the cache, the callback is invoked synchronously
+        before this method returns. Otherwise the file is decoded by one of the
+        cache's worker threads, and the callback is invoked on the message thread once
+        it's ready (with an invalid image if the file couldn't be loaded). Several
+        requests for the same file while it's being decoded will share the same job.
+
+        @param file         the file to try to load
+        @param callback     the function to call with the loaded image
+        @param scaleFactor  a scale to apply to the image's size, as for getFromFile()
+        @see getFromFile
+    */
+    static void getFromFileAsync (const File& file,
+                                  std::function<void (const Image&)> callback,
+                                  float scaleFactor = 1.0f);
 
     /** Loads an image from an in-memory image file, (or just returns the image if it's already cached).
 
@@ -76,10 +102,11 @@ public:
 
         @param imageData    the block of memory containing the image data
         @param dataSize     the data size in bytes
+        @param scaleFactor  a scale to apply to the image's size, as for getFromFile()
         @returns            the image, or an invalid image if it there was an error loading it
         @see getFromMemory, getFromCache, ImageFileFormat::loadFrom
     */
-    static Image getFromMemory (const void* imageData, int dataSize);
+    static Image getFromMemory (const void* imageData, int dataSize, float scaleFactor = 1.0f);
 
     //==============================================================================
     /** Checks the cache for an image with a particular hashcode.
@@ -109,6 +136,18 @@ public:
     */
     static void setCacheTimeout (int millisecs);
 
+    /** Sets the number of bytes of image data that the cache may hold.
+
+        Once this is exceeded, the least recently used images that aren't referenced
+        by anything else are released, regardless of the cache timeout. Images that are
+        still in use are never released, so the total may stay above this limit.
+        By default this is 64MB.
+    */
+    static void setMaximumCacheSize (size_t maxBytes);
+
+    /** Returns the approximate number of bytes of image data currently in the cache. */
+    static size_t getCacheSizeInBytes();
+
     /** Releases any images in the cache that aren't being referenced by active
         Image objects.
     */
@@ -109,4 +109,51 @@ Image ImageFileFormat::loadFrom (const void* rawData, const size_t numBytes)
     return Image();
 }
 
+Array<Image> ImageFileFormat::loadFrom (const Array<File>& files, int maxNumThreads)
+{
+    Array<Image> images;
+    images.resize (files.size());
+
+    std::atomic<int> nextIndex { 0 };
+
+    auto loadRemainingFiles = [&]
+    {
+        for (;;)
+        {
+            auto index = nextIndex++;
+
+            if (index >= files.size())
+                break;
+
+            images.setUnchecked (index, loadFrom (files.getReference (index)));
+        }
+    };
+
+    struct LoaderThread  : public Thread
+    {
+        LoaderThread (std::function<void()> f)  : Thread ("Image loader"), work (std::move (f)) {}
+        void run() override     { work(); }
+
+        std::function<void()> work;
+    };
+
+    if (maxNumThreads <= 0)
+        maxNumThreads = SystemStats::getNumCpus();
+
+    OwnedArray<LoaderThread> threads;
+
+    for (int i = jmin (maxNumThreads, files.size()) - 1; --i >= 0;)
+    {
+        threads.add (new LoaderThread (loadRemainingFiles));
+        threads.getLast()->startThread();
+    }
+
+    loadRemainingFiles();
+
+    for (auto* t : threads)
+        t->waitForThreadToExit (-1);
+
+    return images;
+}
+
 } // namespace juce
@@ -138,6 +138,19 @@ public:
     */
     static Image loadFrom (const void* rawData,
                            size_t numBytesOfData);
+
+    /** Loads a set of image files, decoding several of them at once on different threads.
+
+        This does the same as calling loadFrom (const File&) for each file, and returns
+        the images in the same order as the files, with an invalid image in place of any
+        that couldn't be loaded. The calling thread does some of the decoding too, and the
+        method won't return until all of the files have been dealt with.
+
+        @param files            the files to load
+        @param maxNumThreads    the maximum number of threads to use, including the calling
+                                one. If this is 0 or less, it'll use one per CPU core.
+    */
+    static Array<Image> loadFrom (const Array<File>& files, int maxNumThreads = 0);
 };
 
 //==============================================================================
@@ -0,0 +1,470 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace ResamplingHelpers
+{
+    enum
+    {
+        weightBits = 14,            // the weights for each output pixel add up to 1 << weightBits
+        intermediateBits = 6,       // the extra precision that's kept between the two passes
+        horizontalShift = weightBits - intermediateBits,
+        verticalShift = weightBits + intermediateBits,
+        rowsPerJob = 16
+    };
+
+    static double getFilterValue (ImageResampler::UpscalingFilter filter, double x) noexcept
+    {
+        x = std::abs (x);
+
+        if (filter == ImageResampler::lanczos3)
+        {
+            if (x < 1.0e-9)  return 1.0;
+            if (x >= 3.0)    return 0.0;
+
+            auto px = MathConstants<double>::pi * x;
+            return 3.0 * std::sin (px) * std::sin (px / 3.0) / (px * px);
+        }
+
+        if (x < 1.0)  return (1.5 * x - 2.5) * x * x + 1.0;
+        if (x < 2.0)  return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+        return 0.0;
+    }
+
+    //==============================================================================
+    /*  For each pixel along one axis of the destination, this holds the run of source
+        pixels that contribute to it, and their fixed-point weights. Each run is padded
+        to an even length with a zero weight, so that the SIMD code can take the taps
+        in pairs.
+    */
+    struct Weights
+    {
+        Weights (int sourceSize, int destSize, ImageResampler::UpscalingFilter filter)
+        {
+            entries.reserve ((size_t) destSize);
+
+            const auto scale = sourceSize / (double) destSize;
+            std::vector<double> taps;
+
+            for (int i = 0; i < destSize; ++i)
+            {
+                int first;
+                taps.clear();
+
+                if (destSize < sourceSize)
+                {
+                    // Each source pixel counts by how much of it lies under the destination one
+                    auto left = i * scale, right = (i + 1) * scale;
+                    first = (int) left;
+                    auto end = jmin (sourceSize, (int) std::ceil (right));
+
+                    for (int s = first; s < end; ++s)
+                        taps.push_back (jmin (s + 1.0, right) - jmax ((double) s, left));
+                }
+                else
+                {
+                    auto radius = filter == ImageResampler::lanczos3 ? 3 : 2;
+                    auto centre = (i + 0.5) * scale - 0.5;
+                    auto nearest = (int) std::floor (centre);
+                    first = jmax (0, nearest - radius + 1);
+                    auto last = jmin (sourceSize - 1, nearest + radius);
+                    taps.resize ((size_t) (last - first + 1), 0.0);
+
+                    // The taps that fall outside the image are given to the pixels at its edges
+                    for (int s = nearest - radius + 1; s <= nearest + radius; ++s)
+                        taps[(size_t) (jlimit (first, last, s) - first)] += getFilterValue (filter, s - centre);
+                }
+
+                addEntry (first, taps);
+            }
+        }
+
+        struct Entry
+        {
+            int start, numTaps, offset;
+        };
+
+        std::vector<Entry> entries;
+        std::vector<int16> weights;
+
+    private:
+        void addEntry (int first, const std::vector<double>& taps)
+        {
+            double total = 0;
+
+            for (auto t : taps)
+                total += t;
+
+            // Rounding the running total rather than each weight means that the
+            // quantised weights always add up to exactly 1 << weightBits
+            std::vector<int> quantised;
+            double runningTotal = 0;
+            int previous = 0;
+
+            for (auto t : taps)
+            {
+                runningTotal += t;
+                auto next = roundToInt (runningTotal * (1 << weightBits) / total);
+                quantised.push_back (next - previous);
+                previous = next;
+            }
+
+            size_t begin = 0, end = quantised.size();
+
+            while (end > begin + 1 && quantised[end - 1] == 0)    --end;
+            while (end > begin + 1 && quantised[begin] == 0)      ++begin;
+
+            Entry e { first + (int) begin, (int) (end - begin), (int) weights.size() };
+
+            for (auto i = begin; i < end; ++i)
+                weights.push_back ((int16) quantised[i]);
+
+            if ((e.numTaps & 1) != 0)
+            {
+                weights.push_back (0);
+                ++e.numTaps;
+            }
+
+            entries.push_back (e);
+        }
+    };
+
+    //==============================================================================
+    // Copies a line of the source into 4-byte pixels, with a blank one on the end
+    // for the zero-weighted padding taps to read
+    static void expandLine (const Image::BitmapData& data, int y, uint32* dest) noexcept
+    {
+        auto* src = data.getLinePointer (y);
+        auto* d = reinterpret_cast<uint8*> (dest);
+
+        switch (data.pixelFormat)
+        {
+            case Image::ARGB:
+                if (data.pixelStride == 4)
+                    memcpy (dest, src, (size_t) data.width * 4);
+                else
+                    for (int x = 0; x < data.width; ++x)
+                        memcpy (d + x * 4, src + x * data.pixelStride, 4);
+                break;
+
+            case Image::RGB:
+                for (int x = 0; x < data.width; ++x, d += 4, src += data.pixelStride)
+                {
+                    d[0] = src[0];
+                    d[1] = src[1];
+                    d[2] = src[2];
+                    d[3] = 0xff;
+                }
+                break;
+
+            case Image::SingleChannel:
+                for (int x = 0; x < data.width; ++x, src += data.pixelStride)
+                    dest[x] = *src * 0x01010101u;
+                break;
+
+            case Image::UnknownFormat:
+            default:
+                jassertfalse;
+                break;
+        }
+
+        dest[data.width] = 0;
+    }
+
+    static void storeLine (const Image::BitmapData& data, int y, const uint8* src) noexcept
+    {
+        auto* dest = data.getLinePointer (y);
+
+        for (int x = 0; x < data.width; ++x, src += 4, dest += data.pixelStride)
+        {
+            switch (data.pixelFormat)
+            {
+                case Image::ARGB:           memcpy (dest, src, 4); break;
+                case Image::RGB:            memcpy (dest, src, 3); break;
+                case Image::SingleChannel:  *dest = *src; break;
+                case Image::UnknownFormat:
+                default:                    jassertfalse; break;
+            }
+        }
+    }
+
+    static inline int16 saturateToInt16 (int value) noexcept
+    {
+        return (int16) jlimit (-32768, 32767, value);
+    }
+
+    //==============================================================================
+    // Filters a line of 4-byte pixels into 4 x int16 per destination pixel
+    static void filterHorizontally (const uint32* src, int16* dest, const Weights& weights) noexcept
+    {
+        const auto rounding = 1 << (horizontalShift - 1);
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto zero = _mm_setzero_si128();
+        const auto roundingVector = _mm_set1_epi32 (rounding);
+       #endif
+
+        for (auto& e : weights.entries)
+        {
+            auto* w = weights.weights.data() + e.offset;
+
+           #if JUCE_USE_SSE_INTRINSICS
+            auto total = _mm_setzero_si128();
+
+            for (int i = 0; i < e.numTaps; i += 2)
+            {
+                // Interleaves the two pixels' components, so that each multiply-add handles one of them
+                auto pair = _mm_loadl_epi64 ((const __m128i*) (src + e.start + i));
+                auto interleaved = _mm_unpacklo_epi8 (_mm_unpacklo_epi8 (pair, _mm_srli_si128 (pair, 4)), zero);
+                auto pairWeights = _mm_set1_epi32 ((int) (((uint32) (uint16) w[i + 1] << 16) | (uint16) w[i]));
+
+                total = _mm_add_epi32 (total, _mm_madd_epi16 (interleaved, pairWeights));
+            }
+
+            total = _mm_srai_epi32 (_mm_add_epi32 (total, roundingVector), horizontalShift);
+            _mm_storel_epi64 ((__m128i*) dest, _mm_packs_epi32 (total, total));
+           #else
+            auto* s = reinterpret_cast<const uint8*> (src + e.start);
+            int total[4] = {};
+
+            for (int i = 0; i < e.numTaps; ++i, s += 4)
+                for (int c = 0; c < 4; ++c)
+                    total[c] += w[i] * s[c];
+
+            for (int c = 0; c < 4; ++c)
+                dest[c] = saturateToInt16 ((total[c] + rounding) >> horizontalShift);
+           #endif
+
+            dest += 4;
+        }
+    }
+
+    // Combines some of the horizontally-filtered lines into a line of 4-byte pixels
+    template <bool clampToAlpha>
+    static void filterVertically (const int16* const* lines, const Weights::Entry& e, const int16* w,
+                                  uint8* dest, int width) noexcept
+    {
+        const auto rounding = 1 << (verticalShift - 1);
+
+       #if JUCE_USE_SSE_INTRINSICS
+        const auto roundingVector = _mm_set1_epi32 (rounding);
+
+        // Two pixels at a time: the lines are padded so that there's always a second one to read
+        for (int x = 0; x < width; x += 2, dest += 8)
+        {
+            auto total0 = _mm_setzero_si128(), total1 = total0;
+
+            for (int i = 0; i < e.numTaps; i += 2)
+            {
+                auto a = _mm_loadu_si128 ((const __m128i*) (lines[i]     + x * 4));
+                auto b = _mm_loadu_si128 ((const __m128i*) (lines[i + 1] + x * 4));
+                auto pairWeights = _mm_set1_epi32 ((int) (((uint32) (uint16) w[i + 1] << 16) | (uint16) w[i]));
+
+                total0 = _mm_add_epi32 (total0, _mm_madd_epi16 (_mm_unpacklo_epi16 (a, b), pairWeights));
+                total1 = _mm_add_epi32 (total1, _mm_madd_epi16 (_mm_unpackhi_epi16 (a, b), pairWeights));
+            }
+
+            auto result = _mm_packs_epi32 (_mm_srai_epi32 (_mm_add_epi32 (total0, roundingVector), verticalShift),
+                                           _mm_srai_epi32 (_mm_add_epi32 (total1, roundingVector), verticalShift));
+
+            if (clampToAlpha)
+            {
+                enum { i = PixelARGB::indexA, alphaShuffle = (i << 6) | (i << 4) | (i << 2) | i };
+                result = _mm_min_epi16 (result, _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (result, alphaShuffle), alphaShuffle));
+            }
+
+            result = _mm_packus_epi16 (result, result);
+
+            if (x + 1 < width)
+                _mm_storel_epi64 ((__m128i*) dest, result);
+            else
+                *(uint32*) dest = (uint32) _mm_cvtsi128_si32 (result);
+        }
+       #else
+        for (int x = 0; x < width; ++x, dest += 4)
+        {
+            int16 result[4];
+
+            for (int c = 0; c < 4; ++c)
+            {
+                int total = 0;
+
+                for (int i = 0; i < e.numTaps; ++i)
+                    total += w[i] * lines[i][x * 4 + c];
+
+                result[c] = saturateToInt16 ((total + rounding) >> verticalShift);
+            }
+
+            for (int c = 0; c < 4; ++c)
+                dest[c] = (uint8) jlimit (0, 255, clampToAlpha ? jmin (result[c], result[PixelARGB::indexA]) : (int) result[c]);
+        }
+       #endif
+    }
+
+    //==============================================================================
+    struct ImageResamplerThreadPool  : public ThreadPool,
+                                       private DeletedAtShutdown
+    {
+        ImageResamplerThreadPool()  : ThreadPool (jmax (1, SystemStats::getNumCpus() - 1)) {}
+        ~ImageResamplerThreadPool() override  { clearSingletonInstance(); }
+
+        JUCE_DECLARE_SINGLETON (ImageResamplerThreadPool, false)
+    };
+
+    // Shared with the pool, so that a job which only starts after the last item has
+    // been claimed can still look at it safely
+    struct ParallelJob
+    {
+        ParallelJob (int num, std::function<void (int)> fn)  : numItems (num), function (std::move (fn)) {}
+
+        void run()
+        {
+            for (;;)
+            {
+                auto item = nextItem++;
+
+                if (item >= numItems)
+                    break;
+
+                function (item);
+
+                if (++numItemsDone == numItems)
+                    finished.signal();
+            }
+        }
+
+        const int numItems;
+        std::function<void (int)> function;
+        std::atomic<int> nextItem { 0 }, numItemsDone { 0 };
+        WaitableEvent finished;
+    };
+
+    static void runInParallel (int numItems, bool useOtherThreads, std::function<void (int)> function)
+    {
+        auto job = std::make_shared<ParallelJob> (numItems, std::move (function));
+        auto numHelpers = useOtherThreads ? jmin (numItems - 1, SystemStats::getNumCpus() - 1) : 0;
+
+        if (numHelpers > 0)
+        {
+            auto* pool = ImageResamplerThreadPool::getInstance();
+
+            for (int i = 0; i < numHelpers; ++i)
+                pool->addJob ([job] { job->run(); });
+        }
+
+        job->run();
+
+        if (job->numItemsDone < numItems)
+            job->finished.wait();
+    }
+}
+
+JUCE_IMPLEMENT_SINGLETON (ResamplingHelpers::ImageResamplerThreadPool)
+
+//==============================================================================
+void ImageResampler::resample (const Image::BitmapData& source, const Image::BitmapData& destination,
+                               UpscalingFilter upscalingFilter)
+{
+    using namespace ResamplingHelpers;
+
+    // The source and destination need to be in the same format!
+    jassert (source.pixelFormat == destination.pixelFormat);
+
+    if (source.width <= 0 || source.height <= 0 || destination.width <= 0 || destination.height <= 0
+         || source.pixelFormat != destination.pixelFormat)
+        return;
+
+    const Weights horizontal (source.width, destination.width, upscalingFilter);
+    const Weights vertical (source.height, destination.height, upscalingFilter);
+
+    // The horizontally-filtered lines, which are padded to an even number of pixels
+    const auto intermediateStride = (size_t) ((destination.width + 1) & ~1) * 4;
+    HeapBlock<int16> intermediate (intermediateStride * (size_t) source.height, true);
+
+    auto useOtherThreads = (int64) destination.width * (source.height + destination.height) >= 256 * 256;
+    auto numSourceJobs = (source.height + rowsPerJob - 1) / rowsPerJob;
+    auto numDestJobs = (destination.height + rowsPerJob - 1) / rowsPerJob;
+
+    runInParallel (numSourceJobs, useOtherThreads, [&] (int job)
+    {
+        HeapBlock<uint32> line ((size_t) source.width + 1);
+
+        for (int y = job * rowsPerJob; y < jmin (source.height, (job + 1) * rowsPerJob); ++y)
+        {
+            expandLine (source, y, line);
+            filterHorizontally (line, intermediate + intermediateStride * (size_t) y, horizontal);
+        }
+    });
+
+    runInParallel (numDestJobs, useOtherThreads, [&] (int job)
+    {
+        const bool writeDirectly = destination.pixelFormat == Image::ARGB && destination.pixelStride == 4;
+        HeapBlock<uint8> line (writeDirectly ? 0 : (size_t) ((destination.width + 1) & ~1) * 4);
+        std::vector<const int16*> lines;
+
+        for (int y = job * rowsPerJob; y < jmin (destination.height, (job + 1) * rowsPerJob); ++y)
+        {
+            auto& e = vertical.entries[(size_t) y];
+            lines.clear();
+
+            // the padding tap has no weight, so it can read any of the lines
+            for (int i = 0; i < e.numTaps; ++i)
+                lines.push_back (intermediate + intermediateStride * (size_t) jmin (e.start + i, source.height - 1));
+
+            auto* dest = writeDirectly ? destination.getLinePointer (y) : line.get();
+            auto* w = vertical.weights.data() + e.offset;
+
+            if (destination.pixelFormat == Image::ARGB)
+                filterVertically<true> (lines.data(), e, w, dest, destination.width);
+            else
+                filterVertically<false> (lines.data(), e, w, dest, destination.width);
+
+            if (! writeDirectly)
+                storeLine (destination, y, line);
+        }
+    });
+}
+
+Image ImageResampler::resample (const Image& source, int newWidth, int newHeight, UpscalingFilter upscalingFilter)
+{
+    jassert (newWidth > 0 && newHeight > 0);
+
+    if (source.isNull() || (source.getWidth() == newWidth && source.getHeight() == newHeight))
+        return source;
+
+    const std::unique_ptr<ImageType> type (source.getPixelData()->createType());
+    Image newImage (source.getFormat(), jmax (1, newWidth), jmax (1, newHeight), false, *type);
+
+    const Image::BitmapData srcData (source, Image::BitmapData::readOnly);
+    const Image::BitmapData destData (newImage, Image::BitmapData::writeOnly);
+    resample (srcData, destData, upscalingFilter);
+
+    return newImage;
+}
+
+} // namespace juce
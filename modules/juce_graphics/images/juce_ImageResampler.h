@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Resamples images to a new size using separable filters, without going via
+    a Graphics context.
+
+    Each axis is resampled independently. Any axis that gets smaller is area-averaged,
+    so that every source pixel contributes to the result however big the reduction is,
+    and any axis that gets bigger is interpolated with the upscaling filter that you choose.
+
+    The arithmetic is all done in fixed-point, using SSE2 where it's available, and big
+    images are split across several threads.
+
+    @see Image::rescaled
+
+    @tags{Graphics}
+*/
+class JUCE_API  ImageResampler
+{
+public:
+    //==============================================================================
+    /** The filters that can be used when an image is being enlarged. */
+    enum UpscalingFilter
+    {
+        bicubic,    /**< A Catmull-Rom bicubic filter, which is quick and reasonably sharp. */
+        lanczos3    /**< A 3-lobed Lanczos filter, which is slower but keeps more detail. */
+    };
+
+    /** Resamples the whole of one bitmap to fill another one.
+
+        The two bitmaps must have the same pixel format, and mustn't overlap. If they're
+        ARGB, their pixels are treated as premultiplied, and the results are kept valid by
+        clamping each colour component to the pixel's alpha.
+    */
+    static void resample (const Image::BitmapData& source,
+                          const Image::BitmapData& destination,
+                          UpscalingFilter upscalingFilter = lanczos3);
+
+    /** Returns a resampled copy of an image.
+
+        If the new size is the same as the original, this just returns the original image.
+    */
+    static Image resample (const Image& source, int newWidth, int newHeight,
+                           UpscalingFilter upscalingFilter = lanczos3);
+};
+
+} // namespace juce
@@ -119,6 +119,7 @@ namespace juce
 #include "geometry/juce_Path.h"
 #include "geometry/juce_RectangleList.h"
 #include "colour/juce_PixelFormats.h"
+#include "colour/juce_PixelSpanOperations.h"
 #include "colour/juce_Colour.h"
 #include "colour/juce_ColourGradient.h"
 #include "colour/juce_Colours.h"
@@ -126,6 +127,7 @@ namespace juce
 #include "geometry/juce_EdgeTable.h"
 #include "geometry/juce_PathIterator.h"
 #include "geometry/juce_PathStrokeType.h"
+#include "geometry/juce_PathCache.h"
 #include "placement/juce_RectanglePlacement.h"
 #include "images/juce_ImageCache.h"
 #include "images/juce_ImageConvolutionKernel.h"
@@ -135,13 +137,16 @@ namespace juce
 #include "fonts/juce_AttributedString.h"
 #include "fonts/juce_GlyphArrangement.h"
 #include "fonts/juce_TextLayout.h"
+#include "fonts/juce_TextLayoutCache.h"
 #include "fonts/juce_CustomTypeface.h"
 #include "contexts/juce_GraphicsContext.h"
 #include "contexts/juce_LowLevelGraphicsContext.h"
 #include "images/juce_Image.h"
+#include "images/juce_ImageResampler.h"
 #include "colour/juce_FillType.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.h"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
@@ -139,19 +139,235 @@ public:
 };
 
 //==============================================================================
-/** Holds a cache of recently-used glyph objects of some type.
+/** Packs rendered glyphs into a single shared alpha image, so that a renderer which
+    draws text as textured quads can keep all of it in one texture.
+
+    Each glyph can be stored at a few different horizontal subpixel offsets. When the
+    image runs out of space it's cleared and a new generation begins, which makes all
+    the slots from the old generation out of date, so they'll be rendered again the
+    next time they're needed.
+
+    All the methods apart from reset() expect the caller to be holding getLock().
 
     @tags{Graphics}
 */
-template <class CachedGlyphType, class RenderTargetType>
-class GlyphCache  : private DeletedAtShutdown
+class GlyphAtlas
 {
 public:
-    GlyphCache()
+    enum
+    {
+        atlasSize = 1024,
+        numSubpixelPositions = 4,
+        maxGlyphSize = 128
+    };
+
+    /** Describes where one rendering of a glyph has been put in the atlas. */
+    struct Slot
+    {
+        Rectangle<int> area;    // the glyph's pixels within the atlas image
+        Point<int> origin;      // the top-left of the area, relative to the glyph's origin
+        uint32 generation = 0;
+    };
+
+    GlyphAtlas() = default;
+
+    /** Clears the atlas, invalidating all the slots that have been handed out. */
+    void reset()
+    {
+        const ScopedLock sl (lock);
+        clear();
+    }
+
+    /** Makes sure that a slot holds the given glyph shape, shifted right by
+        (subpixelPosition / numSubpixelPositions) of a pixel.
+
+        Returns false if the glyph is too big to be stored in the atlas.
+    */
+    bool prepare (Slot& slot, const EdgeTable& glyphShape, int subpixelPosition)
+    {
+        jassert (isPositiveAndBelow (subpixelPosition, (int) numSubpixelPositions));
+
+        if (slot.generation == generation)
+            return true;
+
+        EdgeTable shape (glyphShape);
+        shape.translate ((float) subpixelPosition / (float) numSubpixelPositions, 0);
+
+        // the shifted shape can spill a pixel past the right of its original bounds
+        auto bounds = shape.getMaximumBounds().withTrimmedRight (-1);
+
+        if (bounds.getWidth() > maxGlyphSize || bounds.getHeight() > maxGlyphSize)
+            return false;
+
+        if (bounds.isEmpty())
+        {
+            slot = { {}, {}, generation };
+            return true;
+        }
+
+        auto* shelf = findShelfFor (bounds.getWidth(), bounds.getHeight());
+
+        if (shelf == nullptr)
+        {
+            clear();
+            shelf = findShelfFor (bounds.getWidth(), bounds.getHeight());
+            jassert (shelf != nullptr);
+        }
+
+        slot.area = { shelf->nextX, shelf->y, bounds.getWidth(), bounds.getHeight() };
+        slot.origin = bounds.getPosition();
+        slot.generation = generation;
+
+        shelf->nextX += bounds.getWidth() + padding;
+        shelf->revision = ++revision;
+
+        if (image.isNull())
+            image = Image (Image::SingleChannel, atlasSize, atlasSize, true, SoftwareImageType());
+
+        const Image::BitmapData data (image, Image::BitmapData::writeOnly);
+        AlphaMapWriter writer (data, slot.area.getPosition() - bounds.getPosition());
+        shape.iterate (writer);
+        return true;
+    }
+
+    /** Returns the atlas image, which will be null until something has been added to it. */
+    const Image& getImage() const noexcept          { return image; }
+
+    /** Returns a number that changes each time the atlas is cleared. */
+    uint32 getGeneration() const noexcept           { return generation; }
+
+    /** Returns a number that changes each time a glyph is added. */
+    uint32 getRevision() const noexcept             { return revision; }
+
+    /** Returns the range of rows in which glyphs have been added since the given revision. */
+    Range<int> getRowsChangedSince (uint32 lastRevision) const noexcept
+    {
+        Range<int> rows;
+
+        for (auto& shelf : shelves)
+        {
+            if (shelf.revision - lastRevision - 1 < revision - lastRevision)
+            {
+                Range<int> shelfRows (shelf.y, shelf.y + shelf.height);
+                rows = rows.isEmpty() ? shelfRows : rows.getUnionWith (shelfRows);
+            }
+        }
+
+        return rows;
+    }
+
+    const CriticalSection& getLock() const noexcept { return lock; }
+
+private:
+    struct Shelf
+    {
+        int y, height, nextX;
+        uint32 revision;
+    };
+
+    struct AlphaMapWriter
+    {
+        AlphaMapWriter (const Image::BitmapData& d, Point<int> offsetToApply) noexcept
+            : data (d), offset (offsetToApply)
+        {}
+
+        forcedinline void setEdgeTableYPos (int y) noexcept              { line = data.getLinePointer (y + offset.y) + offset.x; }
+        forcedinline void handleEdgeTablePixel (int x, int alpha) const noexcept   { line[x] = (uint8) alpha; }
+        forcedinline void handleEdgeTablePixelFull (int x) const noexcept          { line[x] = 0xff; }
+        forcedinline void handleEdgeTableLine (int x, int width, int alpha) const noexcept { memset (line + x, alpha, (size_t) width); }
+        forcedinline void handleEdgeTableLineFull (int x, int width) const noexcept        { memset (line + x, 0xff, (size_t) width); }
+
+        const Image::BitmapData& data;
+        const Point<int> offset;
+        uint8* line = nullptr;
+
+        JUCE_DECLARE_NON_COPYABLE (AlphaMapWriter)
+    };
+
+    enum { padding = 1 };
+
+    Image image;
+    Array<Shelf> shelves;
+    CriticalSection lock;
+    int nextShelfY = 0;
+    uint32 generation = 1, revision = 0;
+
+    void clear()
+    {
+        shelves.clearQuick();
+        nextShelfY = 0;
+        ++generation;
+
+        if (image.isValid())
+            image.clear (image.getBounds());
+    }
+
+    Shelf* findShelfFor (int width, int height)
     {
-        reset();
+        Shelf* best = nullptr;
+
+        for (auto& shelf : shelves)
+            if (shelf.height >= height && shelf.nextX + width <= (int) atlasSize
+                 && (best == nullptr || shelf.height < best->height))
+                best = &shelf;
+
+        // If the best existing shelf would waste a lot of space, it's better to start a new one
+        auto shelfHeight = (height + 3) & ~3;
+
+        if ((best == nullptr || best->height > shelfHeight + shelfHeight / 2)
+              && nextShelfY + shelfHeight <= (int) atlasSize)
+        {
+            shelves.add ({ nextShelfY, shelfHeight, 0, revision });
+            nextShelfY += shelfHeight + padding;
+            return &shelves.getReference (shelves.size() - 1);
+        }
+
+        return best;
     }
 
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphAtlas)
+};
+
+//==============================================================================
+/** Identifies a glyph in a GlyphCache. */
+struct GlyphCacheKey
+{
+    Font font;
+    int glyph;
+
+    bool operator== (const GlyphCacheKey& other) const noexcept   { return glyph == other.glyph && font == other.font; }
+
+    struct Hash
+    {
+        static int generateHash (const GlyphCacheKey& key, int upperLimit) noexcept
+        {
+            auto h = (uint32) key.glyph;
+            h = h * 31 + (uint32) key.font.getTypefaceName().hashCode();
+            h = h * 31 + (uint32) key.font.getTypefaceStyle().hashCode();
+            h = h * 31 + (uint32) roundToInt (key.font.getHeight() * 64.0f);
+            h = h * 31 + (uint32) roundToInt (key.font.getHorizontalScale() * 256.0f);
+            return (int) (h % (uint32) upperLimit);
+        }
+    };
+};
+
+//==============================================================================
+/** Holds a cache of recently-used glyph objects of some type.
+
+    The glyphs are looked up by font and glyph number in a hash table, and once the
+    cache holds its maximum number, the least recently used ones are recycled.
+
+    There's a single instance for each glyph type, so any renderers that use the same
+    type of glyph share their cache.
+
+    @tags{Graphics}
+*/
+template <class CachedGlyphType>
+class GlyphCache  : private DeletedAtShutdown
+{
+public:
+    GlyphCache() = default;
+
     ~GlyphCache() override
     {
         getSingletonPointer() = nullptr;
@@ -172,75 +388,63 @@ public:
     {
         const ScopedLock sl (lock);
         glyphs.clear();
-        addNewGlyphSlots (120);
-        hits = 0;
-        misses = 0;
+        atlas.reset();
     }
 
+    /** Sets the maximum number of glyphs that will be kept. */
+    void setMaximumNumGlyphs (int newMaximum)
+    {
+        const ScopedLock sl (lock);
+        maxNumGlyphs = jmax (1, newMaximum);
+    }
+
+    template <class RenderTargetType>
     void drawGlyph (RenderTargetType& target, const Font& font, const int glyphNumber, Point<float> pos)
     {
         if (auto glyph = findOrCreateGlyph (font, glyphNumber))
-        {
-            glyph->lastAccessCount = ++accessCounter;
             glyph->draw (target, pos);
-        }
     }
 
     ReferenceCountedObjectPtr<CachedGlyphType> findOrCreateGlyph (const Font& font, int glyphNumber)
     {
         const ScopedLock sl (lock);
+        const GlyphCacheKey key { font, glyphNumber };
 
-        if (auto g = findExistingGlyph (font, glyphNumber))
+        if (auto g = glyphs[key])
         {
-            ++hits;
+            g->lastAccessCount = ++accessCounter;
             return g;
         }
 
-        ++misses;
         auto g = getGlyphForReuse();
-        jassert (g != nullptr);
         g->generate (font, glyphNumber);
+        g->lastAccessCount = ++accessCounter;
+        glyphs.set (key, g);
         return g;
     }
 
+    /** Returns the atlas into which renderers can pack the alpha maps of these glyphs. */
+    GlyphAtlas& getAtlas() noexcept     { return atlas; }
+
 private:
-    ReferenceCountedArray<CachedGlyphType> glyphs;
-    Atomic<int> accessCounter, hits, misses;
+    HashMap<GlyphCacheKey, ReferenceCountedObjectPtr<CachedGlyphType>, GlyphCacheKey::Hash> glyphs { 509 };
+    GlyphAtlas atlas;
     CriticalSection lock;
-
-    ReferenceCountedObjectPtr<CachedGlyphType> findExistingGlyph (const Font& font, int glyphNumber) const noexcept
-    {
-        for (auto g : glyphs)
-            if (g->glyph == glyphNumber && g->font == font)
-                return *g;
-
-        return {};
-    }
+    int accessCounter = 0, maxNumGlyphs = 1024;
 
     ReferenceCountedObjectPtr<CachedGlyphType> getGlyphForReuse()
     {
-        if (hits.get() + misses.get() > glyphs.size() * 16)
+        if (glyphs.size() >= maxNumGlyphs)
         {
-            if (misses.get() * 2 > hits.get())
-                addNewGlyphSlots (32);
-
-            hits = 0;
-            misses = 0;
+            if (auto* oldest = findLeastRecentlyUsedGlyph())
+            {
+                ReferenceCountedObjectPtr<CachedGlyphType> g (oldest);
+                glyphs.remove ({ g->font, g->glyph });
+                return g;
+            }
         }
 
-        if (auto g = findLeastRecentlyUsedGlyph())
-            return *g;
-
-        addNewGlyphSlots (32);
-        return glyphs.getLast();
-    }
-
-    void addNewGlyphSlots (int num)
-    {
-        glyphs.ensureStorageAllocated (glyphs.size() + num);
-
-        while (--num >= 0)
-            glyphs.add (new CachedGlyphType());
+        return new CachedGlyphType();
     }
 
     CachedGlyphType* findLeastRecentlyUsedGlyph() const noexcept
@@ -248,10 +452,12 @@ private:
         CachedGlyphType* oldest = nullptr;
         auto oldestCounter = std::numeric_limits<int>::max();
 
-        for (auto* g : glyphs)
+        for (typename decltype (glyphs)::Iterator i (glyphs); i.next();)
         {
-            if (g->lastAccessCount <= oldestCounter
-                 && g->getReferenceCount() == 1)
+            auto* g = i.getValue().get();
+
+            // glyphs that are still being drawn by another thread can't be recycled
+            if (g->lastAccessCount <= oldestCounter && g->getReferenceCount() == 1)
             {
                 oldestCounter = g->lastAccessCount;
                 oldest = g;
@@ -275,12 +481,12 @@ private:
 
     @tags{Graphics}
 */
-template <class RendererType>
 class CachedGlyphEdgeTable  : public ReferenceCountedObject
 {
 public:
     CachedGlyphEdgeTable() = default;
 
+    template <class RendererType>
     void draw (RendererType& state, Point<float> pos) const
     {
         if (snapToIntegerCoordinate)
@@ -301,6 +507,9 @@ public:
         edgeTable.reset (typeface->getEdgeTableForGlyph (glyphNumber,
                                                          AffineTransform::scale (fontHeight * font.getHorizontalScale(),
                                                                                  fontHeight), fontHeight));
+
+        for (auto& slot : atlasSlots)
+            slot = {};
     }
 
     Font font;
@@ -308,6 +517,9 @@ public:
     int glyph = 0, lastAccessCount = 0;
     bool snapToIntegerCoordinate = false;
 
+    // Where this glyph has been rendered into the cache's GlyphAtlas, if it has
+    GlyphAtlas::Slot atlasSlots[GlyphAtlas::numSubpixelPositions];
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedGlyphEdgeTable)
 };
 
@@ -678,11 +890,20 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
-        inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
+        template <class DestPixelType>
+        inline void blendLine (DestPixelType* dest, PixelARGB colour, int width) const noexcept
         {
             JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
+        inline void blendLine (PixelARGB* dest, PixelARGB colour, int width) const noexcept
+        {
+            if ((size_t) destData.pixelStride == sizeof (*dest))
+                PixelSpanOperations::blendColour (dest, colour, width);
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
+        }
+
         forcedinline void replaceLine (PixelRGB* dest, PixelARGB colour, int width) const noexcept
         {
             if ((size_t) destData.pixelStride == sizeof (*dest))
@@ -774,18 +995,12 @@ namespace EdgeTableFillers
 
         void handleEdgeTableLine (int x, int width, int alphaLevel) const noexcept
         {
-            auto* dest = getPixel (x);
-
-            if (alphaLevel < 0xff)
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
-            else
-                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+            blendLine (getPixel (x), x, width, alphaLevel);
         }
 
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
-            auto* dest = getPixel (x);
-            JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+            blendLine (getPixel (x), x, width, 0xff);
         }
 
         void handleEdgeTableRectangle (int x, int y, int width, int height, int alphaLevel) noexcept
@@ -815,6 +1030,40 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        template <class DestPixelType>
+        void blendLine (DestPixelType* dest, int x, int width, int alphaLevel) const noexcept
+        {
+            if (alphaLevel < 0xff)
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
+            else
+                JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
+        }
+
+        void blendLine (PixelARGB* dest, int x, int width, int alphaLevel) const noexcept
+        {
+            if ((size_t) destData.pixelStride != sizeof (*dest))
+                return blendLine<PixelARGB> (dest, x, width, alphaLevel);
+
+            // the gradient is generated a chunk at a time so it can be blended in one go
+            PixelARGB colours[64];
+
+            while (width > 0)
+            {
+                auto num = jmin (width, numElementsInArray (colours));
+
+                for (int i = 0; i < num; ++i)
+                    colours[i] = GradientType::getPixel (x++);
+
+                if (alphaLevel < 0xff)
+                    PixelSpanOperations::blendPixels (dest, colours, num, (uint32) alphaLevel);
+                else
+                    PixelSpanOperations::blendPixels (dest, colours, num);
+
+                dest += num;
+                width -= num;
+            }
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -876,7 +1125,7 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (alphaLevel < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) alphaLevel))
+                    blendRow (dest, getSrcPixel (x), width, (uint32) alphaLevel);
                 else
                     copyRow (dest, getSrcPixel (x), width);
             }
@@ -899,7 +1148,7 @@ namespace EdgeTableFillers
                 jassert (x >= 0 && x + width <= srcData.width);
 
                 if (extraAlpha < 0xfe)
-                    JUCE_PERFORM_PIXEL_OP_LOOP (blend (*getSrcPixel (x++), (uint32) extraAlpha))
+                    blendRow (dest, getSrcPixel (x), width, (uint32) extraAlpha);
                 else
                     copyRow (dest, getSrcPixel (x), width);
             }
@@ -952,6 +1201,34 @@ namespace EdgeTableFillers
             return addBytesToPointer (sourceLineStart, x * srcData.pixelStride);
         }
 
+        template <class DestType, class SrcType>
+        forcedinline void blendRow (DestType* dest, SrcType const* src, int width, uint32 alpha) const noexcept
+        {
+            auto destStride = destData.pixelStride;
+            auto srcStride  = srcData.pixelStride;
+
+            do
+            {
+                dest->blend (*src, alpha);
+                dest = addBytesToPointer (dest, destStride);
+                src  = addBytesToPointer (src, srcStride);
+            } while (--width > 0);
+        }
+
+        forcedinline void blendRow (PixelARGB* dest, PixelARGB const* src, int width, uint32 alpha) const noexcept
+        {
+            if (isPackedARGBRow())
+                PixelSpanOperations::blendPixels (dest, src, width, alpha);
+            else
+                blendRow<PixelARGB, PixelARGB> (dest, src, width, alpha);
+        }
+
+        forcedinline bool isPackedARGBRow() const noexcept
+        {
+            return (size_t) destData.pixelStride == sizeof (PixelARGB)
+                && (size_t) srcData.pixelStride  == sizeof (PixelARGB);
+        }
+
         forcedinline void copyRow (DestPixelType* dest, SrcPixelType const* src, int width) const noexcept
         {
             auto destStride = destData.pixelStride;
@@ -963,6 +1240,11 @@ namespace EdgeTableFillers
             {
                 memcpy ((void*) dest, src, (size_t) (width * srcStride));
             }
+            else if (sizeof (DestPixelType) == sizeof (PixelARGB) && sizeof (SrcPixelType) == sizeof (PixelARGB)
+                      && isPackedARGBRow())
+            {
+                PixelSpanOperations::blendPixels ((PixelARGB*) dest, (const PixelARGB*) src, width);
+            }
             else
             {
                 do
@@ -2360,7 +2642,18 @@ public:
             auto clipRect = clip->getClipBounds();
 
             if (path.getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clipRect))
-                fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
+            {
+                if (auto cachedEdgeTable = PathCache::getEdgeTable (path, trans))
+                {
+                    auto* shape = new EdgeTableRegionType (*cachedEdgeTable);
+                    shape->edgeTable.clipToRectangle (clipRect);
+                    fillShape (*shape, false);
+                }
+                else
+                {
+                    fillShape (*new EdgeTableRegionType (clipRect, path, trans), false);
+                }
+            }
         }
     }
 
@@ -2383,6 +2676,32 @@ public:
         }
     }
 
+    /** For a glyph that can be drawn from the cache (i.e. an unrotated glyph whose own
+        transform is just a translation), this returns the font that the glyph is cached
+        with, and converts its position to device space.
+    */
+    Font getFontForCachedGlyph (Point<float>& pos)
+    {
+        if (transform.isOnlyTranslated)
+        {
+            pos += transform.offset.toFloat();
+            return getThis().font;
+        }
+
+        pos = transform.transformed (pos);
+
+        auto& font = getThis().font;
+        Font f (font);
+        f.setHeight (font.getHeight() * transform.complexTransform.mat11);
+
+        auto xScale = transform.complexTransform.mat00 / transform.complexTransform.mat11;
+
+        if (std::abs (xScale - 1.0f) > 0.01f)
+            f.setHorizontalScale (xScale);
+
+        return f;
+    }
+
     void drawLine (Line<float> line)
     {
         Path p;
@@ -2556,7 +2875,7 @@ public:
         }
     }
 
-    using GlyphCacheType = GlyphCache<CachedGlyphEdgeTable<SoftwareRendererSavedState>, SoftwareRendererSavedState>;
+    using GlyphCacheType = GlyphCache<CachedGlyphEdgeTable>;
 
     static void clearGlyphCache()
     {
@@ -2570,27 +2889,10 @@ public:
         {
             if (trans.isOnlyTranslation() && ! transform.isRotated)
             {
-                auto& cache = GlyphCacheType::getInstance();
                 Point<float> pos (trans.getTranslationX(), trans.getTranslationY());
+                auto f = getFontForCachedGlyph (pos);
 
-                if (transform.isOnlyTranslated)
-                {
-                    cache.drawGlyph (*this, font, glyphNumber, pos + transform.offset.toFloat());
-                }
-                else
-                {
-                    pos = transform.transformed (pos);
-
-                    Font f (font);
-                    f.setHeight (font.getHeight() * transform.complexTransform.mat11);
-
-                    auto xScale = transform.complexTransform.mat00 / transform.complexTransform.mat11;
-
-                    if (std::abs (xScale - 1.0f) > 0.01f)
-                        f.setHorizontalScale (xScale);
-
-                    cache.drawGlyph (*this, f, glyphNumber, pos);
-                }
+                GlyphCacheType::getInstance().drawGlyph (*this, f, glyphNumber, pos);
             }
             else
             {
@@ -2613,6 +2915,7 @@ public:
     template <typename IteratorType>
     void renderImageTransformed (IteratorType& iter, const Image& src, int alpha, const AffineTransform& trans, Graphics::ResamplingQuality quality, bool tiledFill) const
     {
+        JUCE_TRACE_SCOPE ("SoftwareRenderer::renderImageTransformed");
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
         const Image::BitmapData srcData (src, Image::BitmapData::readOnly);
         EdgeTableFillers::renderImageTransformed (iter, destData, srcData, alpha, trans, quality, tiledFill);
@@ -2621,6 +2924,7 @@ public:
     template <typename IteratorType>
     void renderImageUntransformed (IteratorType& iter, const Image& src, int alpha, int x, int y, bool tiledFill) const
     {
+        JUCE_TRACE_SCOPE ("SoftwareRenderer::renderImageUntransformed");
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
         const Image::BitmapData srcData (src, Image::BitmapData::readOnly);
         EdgeTableFillers::renderImageUntransformed (iter, destData, srcData, alpha, x, y, tiledFill);
@@ -2629,6 +2933,7 @@ public:
     template <typename IteratorType>
     void fillWithSolidColour (IteratorType& iter, PixelARGB colour, bool replaceContents) const
     {
+        JUCE_TRACE_SCOPE ("SoftwareRenderer::fillWithSolidColour");
         Image::BitmapData destData (image, Image::BitmapData::readWrite);
 
         switch (destData.pixelFormat)
@@ -2642,6 +2947,7 @@ public:
     template <typename IteratorType>
     void fillWithGradient (IteratorType& iter, ColourGradient& gradient, const AffineTransform& trans, bool isIdentity) const
     {
+        JUCE_TRACE_SCOPE ("SoftwareRenderer::fillWithGradient");
         HeapBlock<PixelARGB> lookupTable;
         auto numLookupEntries = gradient.createLookupTable (trans, lookupTable);
         jassert (numLookupEntries > 0);
@@ -80,7 +80,7 @@ public:
         if (mode != Image::BitmapData::readOnly)
         {
             freeCachedImageRef();
-            sendDataChangeMessage();
+            sendDataChangeMessage ({ x, y, bitmap.width, bitmap.height });
         }
     }
 
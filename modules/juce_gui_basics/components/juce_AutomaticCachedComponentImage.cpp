@@ -0,0 +1,271 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// All the buffers that are currently allocated. This is only used on the message thread.
+struct AutomaticCachedComponentImage::Budget
+{
+    static Budget& getInstance()
+    {
+        static Budget budget;
+        return budget;
+    }
+
+    // Releases buffers that save less time per byte than the one that's asking, until
+    // the new one fits.
+    bool makeRoom (size_t numBytes, const AutomaticCachedComponentImage* requester)
+    {
+        if (numBytes > maxBytes)
+            return false;
+
+        auto saving = requester->getSavingPerByte (numBytes);
+
+        while (bytesUsed + numBytes > maxBytes)
+        {
+            auto* leastUseful = findLeastUseful (requester);
+
+            if (leastUseful == nullptr || leastUseful->getSavingPerByte (leastUseful->bufferSize) >= saving)
+                return false;
+
+            leastUseful->stopBuffering();
+        }
+
+        return true;
+    }
+
+    void trimToBudget()
+    {
+        while (bytesUsed > maxBytes)
+        {
+            auto* leastUseful = findLeastUseful (nullptr);
+
+            if (leastUseful == nullptr)
+                break;
+
+            leastUseful->stopBuffering();
+        }
+    }
+
+    AutomaticCachedComponentImage* findLeastUseful (const AutomaticCachedComponentImage* exclude) const
+    {
+        AutomaticCachedComponentImage* leastUseful = nullptr;
+
+        for (auto* b : buffered)
+            if (b != exclude && (leastUseful == nullptr
+                                  || b->getSavingPerByte (b->bufferSize) < leastUseful->getSavingPerByte (leastUseful->bufferSize)))
+                leastUseful = b;
+
+        return leastUseful;
+    }
+
+    Array<AutomaticCachedComponentImage*> buffered;
+    size_t maxBytes = 32 * 1024 * 1024, bytesUsed = 0;
+
+    // A component has to have been painted this many times since its policy last changed
+    // before it's changed again.
+    enum { minimumPaintsMeasured = 8 };
+
+    // The number of milliseconds that a buffer has to save on each paint to be worth having.
+    static constexpr double minimumSaving = 0.1;
+};
+
+//==============================================================================
+AutomaticCachedComponentImage::AutomaticCachedComponentImage (Component& c)  : owner (c)
+{
+}
+
+AutomaticCachedComponentImage::~AutomaticCachedComponentImage()
+{
+    stopBuffering();
+}
+
+//==============================================================================
+void AutomaticCachedComponentImage::paint (Graphics& g)
+{
+    auto clip = g.getClipBounds().getIntersection (owner.getLocalBounds());
+    auto clipPixels = (double) clip.getWidth() * (double) clip.getHeight();
+
+    dirtyArea.clipTo (clip);
+    double dirtyPixels = 0;
+
+    for (auto& r : dirtyArea)
+        dirtyPixels += (double) r.getWidth() * (double) r.getHeight();
+
+    dirtyArea.clear();
+
+    auto startTime = Time::getHighResolutionTicks();
+
+    if (buffer != nullptr)
+        buffer->paint (g);
+    else
+        owner.paintEntireComponent (g, false);
+
+    auto milliseconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTime) * 1000.0;
+
+    if (clipPixels > 0 && ! skipNextMeasurement)
+    {
+        double saving;
+
+        if (buffer == nullptr)
+        {
+            paintTime = numPaints == 0 ? milliseconds : paintTime * 0.75 + milliseconds * 0.25;
+
+            // the time that a buffer would have saved, if the parts that hadn't been
+            // invalidated could have been copied from it
+            saving = milliseconds * (1.0 - dirtyPixels / clipPixels);
+        }
+        else
+        {
+            saving = paintTime - milliseconds;
+        }
+
+        savingPerPaint = numPaints == 0 ? saving : savingPerPaint * 0.875 + saving * 0.125;
+        ++numPaints;
+    }
+
+    skipNextMeasurement = false;
+    updatePolicy (g.getInternalContext().getPhysicalPixelScaleFactor());
+}
+
+bool AutomaticCachedComponentImage::invalidateAll()
+{
+    dirtyArea = owner.getLocalBounds();
+
+    if (buffer != nullptr)
+        buffer->invalidateAll();
+
+    return true;
+}
+
+bool AutomaticCachedComponentImage::invalidate (const Rectangle<int>& area)
+{
+    dirtyArea.add (area);
+
+    if (buffer != nullptr)
+        buffer->invalidate (area);
+
+    return true;
+}
+
+void AutomaticCachedComponentImage::releaseResources()
+{
+    stopBuffering();
+}
+
+//==============================================================================
+void AutomaticCachedComponentImage::updatePolicy (float scale)
+{
+    if (numPaints < Budget::minimumPaintsMeasured)
+        return;
+
+    auto requiredSize = (size_t) roundToInt ((float) owner.getWidth()  * scale)
+                          * (size_t) roundToInt ((float) owner.getHeight() * scale) * 4;
+
+    if (buffer == nullptr)
+    {
+        if (savingPerPaint >= Budget::minimumSaving)
+            startBuffering (requiredSize);
+    }
+    else if (savingPerPaint < Budget::minimumSaving * 0.5)
+    {
+        stopBuffering();
+    }
+    else if (requiredSize != bufferSize)
+    {
+        // the component's been resized, so its buffer needs to be re-budgeted
+        auto& budget = Budget::getInstance();
+        budget.bytesUsed -= bufferSize;
+        bufferSize = 0;
+
+        if (budget.makeRoom (requiredSize, this))
+        {
+            bufferSize = requiredSize;
+            budget.bytesUsed += bufferSize;
+        }
+        else
+        {
+            stopBuffering();
+        }
+    }
+}
+
+void AutomaticCachedComponentImage::startBuffering (size_t numBytes)
+{
+    auto& budget = Budget::getInstance();
+
+    if (budget.makeRoom (numBytes, this))
+    {
+        buffer.reset (new StandardCachedComponentImage (owner));
+        bufferSize = numBytes;
+        budget.bytesUsed += numBytes;
+        budget.buffered.add (this);
+
+        skipNextMeasurement = true;  // (the first paint has to fill the whole buffer)
+    }
+
+    numPaints = 0;
+}
+
+void AutomaticCachedComponentImage::stopBuffering()
+{
+    if (buffer != nullptr)
+    {
+        auto& budget = Budget::getInstance();
+        budget.bytesUsed -= bufferSize;
+        budget.buffered.removeFirstMatchingValue (this);
+
+        buffer.reset();
+        bufferSize = 0;
+        numPaints = 0;
+    }
+}
+
+double AutomaticCachedComponentImage::getSavingPerByte (size_t numBytes) const noexcept
+{
+    return savingPerPaint / (double) jmax ((size_t) 1, numBytes);
+}
+
+//==============================================================================
+void AutomaticCachedComponentImage::setMemoryBudget (size_t maxBytes)
+{
+    auto& budget = Budget::getInstance();
+    budget.maxBytes = maxBytes;
+    budget.trimToBudget();
+}
+
+size_t AutomaticCachedComponentImage::getMemoryBudget()
+{
+    return Budget::getInstance().maxBytes;
+}
+
+size_t AutomaticCachedComponentImage::getMemoryUsed()
+{
+    return Budget::getInstance().bytesUsed;
+}
+
+} // namespace juce
@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A CachedComponentImage that decides for itself whether buffering its component
+    to an image is worthwhile.
+
+    Component::setBufferedToImage() always buffers, which only pays off when the
+    component is expensive to draw and doesn't change very often. If you don't know
+    whether that's the case, give the component one of these instead:
+
+    @code
+    myPanel.setCachedComponentImage (new AutomaticCachedComponentImage (myPanel));
+    @endcode
+
+    It measures how long the component and its children take to paint, and how much
+    of the component has been invalidated each time it gets painted. When painting is
+    expensive and most of each repaint could have been drawn from a buffer (e.g. because
+    it was caused by something else that overlaps the component), it starts buffering.
+    If the component then keeps invalidating most of itself, it stops again.
+
+    All the buffers share a memory budget (see setMemoryBudget()). When a new buffer
+    won't fit, it's only allocated if it saves more time per byte than some of the
+    existing ones, which are then released.
+
+    These objects must only be used on the message thread.
+
+    @see Component::setCachedComponentImage, Component::setBufferedToImage
+
+    @tags{GUI}
+*/
+class JUCE_API  AutomaticCachedComponentImage  : public CachedComponentImage
+{
+public:
+    /** Creates an AutomaticCachedComponentImage for a component.
+        You'll need to pass this to the component's setCachedComponentImage() method
+        for it to take effect.
+    */
+    explicit AutomaticCachedComponentImage (Component& owner);
+
+    /** Destructor. */
+    ~AutomaticCachedComponentImage() override;
+
+    //==============================================================================
+    /** Returns true if the component is currently being drawn from a buffer. */
+    bool isBuffered() const noexcept                { return buffer != nullptr; }
+
+    /** Returns the average time, in milliseconds, that the component took to paint
+        when it wasn't being buffered.
+    */
+    double getAveragePaintTime() const noexcept     { return paintTime; }
+
+    //==============================================================================
+    /** Sets the number of bytes that all the AutomaticCachedComponentImage buffers
+        may use between them. The default is 32MB.
+    */
+    static void setMemoryBudget (size_t maxBytes);
+
+    /** Returns the memory budget that was set by setMemoryBudget(). */
+    static size_t getMemoryBudget();
+
+    /** Returns the number of bytes that are currently being used by buffers. */
+    static size_t getMemoryUsed();
+
+    //==============================================================================
+    /** @internal */
+    void paint (Graphics&) override;
+    /** @internal */
+    bool invalidateAll() override;
+    /** @internal */
+    bool invalidate (const Rectangle<int>&) override;
+    /** @internal */
+    void releaseResources() override;
+
+private:
+    //==============================================================================
+    struct Budget;
+
+    Component& owner;
+    std::unique_ptr<CachedComponentImage> buffer;
+    RectangleList<int> dirtyArea;
+    size_t bufferSize = 0;
+    double paintTime = 0, savingPerPaint = 0;
+    int numPaints = 0;
+    bool skipNextMeasurement = false;
+
+    void updatePolicy (float scale);
+    void startBuffering (size_t numBytes);
+    void stopBuffering();
+    double getSavingPerByte (size_t numBytes) const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutomaticCachedComponentImage)
+};
+
+} // namespace juce
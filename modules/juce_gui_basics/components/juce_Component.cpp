@@ -432,6 +432,23 @@ struct Component::ComponentHelpers
         return wasClipped;
     }
 
+    // Returns true if an opaque sibling that's in front of the given child completely
+    // covers the part of it that needs painting, so the child can be skipped.
+    static bool isHiddenBehindOpaqueSiblings (const Component& parent, int childIndex, Rectangle<int> area)
+    {
+        for (int i = childIndex + 1; i < parent.childComponentList.size(); ++i)
+        {
+            auto& sibling = *parent.childComponentList.getUnchecked (i);
+
+            if (sibling.flags.opaqueFlag && sibling.componentTransparency == 0
+                 && sibling.isVisible() && sibling.affineTransform == nullptr
+                 && sibling.getBounds().contains (area))
+                return true;
+        }
+
+        return false;
+    }
+
     static Rectangle<int> getParentOrMainMonitorBounds (const Component& comp)
     {
         if (auto* p = comp.getParentComponent())
@@ -1878,8 +1895,15 @@ void Component::paintComponentAndChildren (Graphics& g)
 {
     auto clipBounds = g.getClipBounds();
 
+    auto* stats = ComponentPeer::currentPaintStatistics;
+
     if (flags.dontClipGraphicsFlag)
     {
+        JUCE_TRACE_SCOPE ("Component::paint");
+
+        if (stats != nullptr)
+            stats->addComponent (clipBounds);
+
         paint (g);
     }
     else
@@ -1887,7 +1911,14 @@ void Component::paintComponentAndChildren (Graphics& g)
         g.saveState();
 
         if (! (ComponentHelpers::clipObscuredRegions (*this, g, clipBounds, {}) && g.isClipEmpty()))
+        {
+            JUCE_TRACE_SCOPE ("Component::paint");
+
+            if (stats != nullptr)
+                stats->addComponent (g.getClipBounds());
+
             paint (g);
+        }
 
         g.restoreState();
     }
@@ -1910,6 +1941,17 @@ void Component::paintComponentAndChildren (Graphics& g)
             }
             else if (clipBounds.intersects (child.getBounds()))
             {
+                auto visibleArea = clipBounds.getIntersection (child.getBounds());
+
+                if (! child.flags.dontClipGraphicsFlag
+                     && ComponentHelpers::isHiddenBehindOpaqueSiblings (*this, i, visibleArea))
+                {
+                    if (stats != nullptr)
+                        ++stats->numComponentsCulled;
+
+                    continue;
+                }
+
                 g.saveState();
 
                 if (child.flags.dontClipGraphicsFlag)
@@ -1924,7 +1966,8 @@ void Component::paintComponentAndChildren (Graphics& g)
                     {
                         auto& sibling = *childComponentList.getUnchecked (j);
 
-                        if (sibling.flags.opaqueFlag && sibling.isVisible() && sibling.affineTransform == nullptr)
+                        if (sibling.flags.opaqueFlag && sibling.isVisible() && sibling.affineTransform == nullptr
+                             && sibling.getBounds().intersects (visibleArea))
                         {
                             nothingClipped = false;
                             g.excludeClipRegion (sibling.getBounds());
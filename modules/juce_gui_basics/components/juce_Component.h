@@ -1003,7 +1003,10 @@ public:
         Parts of the buffer are invalidated when repaint() is called on this component
         or its children. The buffer is then repainted at the next paint() callback.
 
-        @see repaint, paint, createComponentSnapshot
+        If you're not sure whether buffering will help, an AutomaticCachedComponentImage
+        can make that decision instead.
+
+        @see repaint, paint, createComponentSnapshot, AutomaticCachedComponentImage
     */
     void setBufferedToImage (bool shouldBeBuffered);
 
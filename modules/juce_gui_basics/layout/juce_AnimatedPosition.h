@@ -36,8 +36,9 @@ namespace juce
     thrown around with the mouse/touch, and by writing your own behaviour class, you can
     customise the trajectory that it follows when released.
 
-    The class uses its own Timer to continuously change its value when a drag ends, and
-    Listener objects can be registered to receive callbacks whenever the value changes.
+    The class uses the shared AnimationClock to continuously change its value when a drag
+    ends, and Listener objects can be registered to receive callbacks whenever the value
+    changes.
 
     The value is stored as a double, and can be used to represent whatever units you need.
 
@@ -51,7 +52,7 @@ namespace juce
     @tags{GUI}
 */
 template <typename Behaviour>
-class AnimatedPosition  : private Timer
+class AnimatedPosition  : private AnimationClock::Listener
 {
 public:
     AnimatedPosition()
@@ -60,6 +61,12 @@ public:
     {
     }
 
+    /** Destructor. */
+    ~AnimatedPosition() override
+    {
+        stopAnimating();
+    }
+
     /** Sets a range within which the value will be constrained. */
     void setLimits (Range<double> newRange) noexcept
     {
@@ -79,7 +86,7 @@ public:
     {
         grabbedPos = position;
         releaseVelocity = 0;
-        stopTimer();
+        stopAnimating();
     }
 
     /** Called during a mouse-drag operation, to indicate that the mouse has moved.
@@ -96,7 +103,7 @@ public:
     */
     void endDrag()
     {
-        startTimerHz (60);
+        startAnimating (0);
     }
 
     /** Called outside of a drag operation to cause a nudge in the specified direction.
@@ -104,7 +111,7 @@ public:
     */
     void nudge (double deltaFromCurrentPosition)
     {
-        startTimerHz (10);
+        startAnimating (100);
         moveTo (position + deltaFromCurrentPosition);
     }
 
@@ -121,7 +128,7 @@ public:
     */
     void setPosition (double newPosition)
     {
-        stopTimer();
+        stopAnimating();
         setPositionAndSendChange (newPosition);
     }
 
@@ -154,9 +161,11 @@ public:
 private:
     //==============================================================================
     double position = 0.0, grabbedPos = 0.0, releaseVelocity = 0.0;
+    double lastUpdate = 0.0, resumeTime = 0.0;
     Range<double> range;
-    Time lastUpdate, lastDrag;
+    Time lastDrag;
     ListenerList<Listener> listeners;
+    bool isAnimating = false;
 
     static double getSpeed (const Time last, double lastPos,
                             const Time now, double newPos)
@@ -187,17 +196,38 @@ private:
         }
     }
 
-    void timerCallback() override
+    // Starts moving on the animation clock, after the given delay
+    void startAnimating (int millisecondsDelay)
     {
-        auto now = Time::getCurrentTime();
-        auto elapsed = jlimit (0.001, 0.020, (now - lastUpdate).inSeconds());
-        lastUpdate = now;
+        resumeTime = Time::getMillisecondCounterHiRes() + millisecondsDelay;
+
+        if (! isAnimating)
+        {
+            isAnimating = true;
+            AnimationClock::addListener (this);
+        }
+    }
+
+    void stopAnimating()
+    {
+        if (isAnimating)
+        {
+            isAnimating = false;
+            AnimationClock::removeListener (this);
+        }
+    }
+
+    void animationFrame (double frameTime) override
+    {
+        if (frameTime < resumeTime)
+            return;
+
+        auto elapsed = jlimit (0.001, 0.020, (frameTime - lastUpdate) / 1000.0);
+        lastUpdate = frameTime;
         auto newPos = behaviour.getNextPosition (position, elapsed);
 
         if (behaviour.isStopped (newPos))
-            stopTimer();
-        else
-            startTimerHz (60);
+            stopAnimating();
 
         setPositionAndSendChange (newPos);
     }
@@ -0,0 +1,137 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AnimationClock::Pimpl  : private Timer,
+                                private DeletedAtShutdown
+{
+    Pimpl() {}
+
+    ~Pimpl() override
+    {
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON (AnimationClock::Pimpl, false)
+
+    void addListener (Listener* listener)
+    {
+        listeners.add (listener);
+
+        if (! isTimerRunning())
+        {
+            nextFrameTime = Time::getMillisecondCounterHiRes() + getFrameInterval();
+            scheduleNextFrame();
+        }
+    }
+
+    void removeListener (Listener* listener)
+    {
+        listeners.remove (listener);
+
+        if (listeners.isEmpty())
+            stopTimer();
+    }
+
+    double getFrameInterval() const noexcept    { return 1000.0 / frameRate; }
+
+    double frameRate = 60.0, currentFrameTime = 0;
+
+private:
+    ListenerList<Listener> listeners;
+    double nextFrameTime = 0;
+
+    void scheduleNextFrame()
+    {
+        startTimer (jmax (1, roundToInt (nextFrameTime - Time::getMillisecondCounterHiRes())));
+    }
+
+    void timerCallback() override
+    {
+        auto now = Time::getMillisecondCounterHiRes();
+
+        // if we've fallen more than a frame behind, skip the frames we've missed
+        // rather than trying to catch up with them
+        if (now - nextFrameTime > getFrameInterval())
+            nextFrameTime = now;
+
+        currentFrameTime = nextFrameTime;
+        nextFrameTime += getFrameInterval();
+
+        listeners.call ([this] (Listener& l) { l.animationFrame (currentFrameTime); });
+
+        // get everything that this frame has changed onto the screen together
+        for (int i = ComponentPeer::getNumPeers(); --i >= 0;)
+            if (auto* peer = ComponentPeer::getPeer (i))
+                peer->performAnyPendingRepaintsNow();
+
+        if (listeners.isEmpty())
+            stopTimer();
+        else
+            scheduleNextFrame();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (Pimpl)
+};
+
+JUCE_IMPLEMENT_SINGLETON (AnimationClock::Pimpl)
+
+//==============================================================================
+void AnimationClock::addListener (Listener* listener)
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+    jassert (listener != nullptr);
+
+    Pimpl::getInstance()->addListener (listener);
+}
+
+void AnimationClock::removeListener (Listener* listener)
+{
+    JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
+
+    if (auto* instance = Pimpl::getInstanceWithoutCreating())
+        instance->removeListener (listener);
+}
+
+void AnimationClock::setFrameRate (double framesPerSecond)
+{
+    jassert (framesPerSecond > 0);
+    Pimpl::getInstance()->frameRate = jmax (1.0, framesPerSecond);
+}
+
+double AnimationClock::getFrameRate()
+{
+    return Pimpl::getInstance()->frameRate;
+}
+
+double AnimationClock::getCurrentFrameTime()
+{
+    return Pimpl::getInstance()->currentFrameTime;
+}
+
+} // namespace juce
@@ -0,0 +1,118 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2017 - ROLI Ltd.
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 5 End-User License
+   Agreement and JUCE 5 Privacy Policy (both updated and effective as of the
+   27th April 2017).
+
+   End User License Agreement: www.juce.com/juce-5-licence
+   Privacy Policy: www.juce.com/juce-5-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A shared clock that drives all the animations in the app from a single
+    series of evenly-spaced frames.
+
+    Rather than each animated object running its own Timer, which leaves their
+    updates and repaints out of step with each other, objects register an
+    AnimationClock::Listener and are all called back together, once per frame,
+    with the same frame time. Any repaints that they cause are then flushed to
+    the screen in one go at the end of the frame.
+
+    ComponentAnimator and AnimatedPosition both use this clock, and you can use it
+    for your own animations too, e.g. for meters that would otherwise use a Timer:
+
+    @code
+    struct LevelMeter  : public Component,
+                         private AnimationClock::Listener
+    {
+        LevelMeter()            { AnimationClock::addListener (this); }
+        ~LevelMeter() override  { AnimationClock::removeListener (this); }
+
+        void animationFrame (double) override
+        {
+            level = source.getLevel();
+            repaint();
+        }
+
+        ...
+    };
+    @endcode
+
+    The clock only runs while it has listeners, and must only be used from the
+    message thread.
+
+    @see ComponentAnimator, AnimatedPosition
+
+    @tags{GUI}
+*/
+class JUCE_API  AnimationClock
+{
+public:
+    //==============================================================================
+    /** Receives a callback for each frame of an AnimationClock. */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() = default;
+
+        /** Called on the message thread for each new frame.
+
+            All the clock's listeners are called with the same frameTime, which is in
+            milliseconds on the same scale as Time::getMillisecondCounterHiRes(). The
+            frame times are evenly spaced, so you should use them to work out how far
+            your animation has progressed, rather than reading the time yourself.
+        */
+        virtual void animationFrame (double frameTime) = 0;
+    };
+
+    /** Registers a listener to receive a callback for each frame.
+        The clock starts running as soon as it has a listener.
+    */
+    static void addListener (Listener*);
+
+    /** Removes a previously-registered listener.
+        When the last listener is removed, the clock stops.
+    */
+    static void removeListener (Listener*);
+
+    //==============================================================================
+    /** Changes the number of frames per second. The default is 60. */
+    static void setFrameRate (double framesPerSecond);
+
+    /** Returns the number of frames per second. */
+    static double getFrameRate();
+
+    /** Returns the time of the frame that is currently being delivered, or of the
+        previous frame if this isn't called from inside a listener callback.
+    */
+    static double getCurrentFrameTime();
+
+private:
+    //==============================================================================
+    struct Pimpl;
+
+    AnimationClock() = delete;
+};
+
+} // namespace juce
@@ -66,7 +66,7 @@ public:
         component->setVisible (! useProxyComponent);
     }
 
-    bool useTimeslice (const int elapsed)
+    bool useTimeslice (const double elapsed)
     {
         if (auto* c = proxy != nullptr ? proxy.get()
                                        : component.get())
@@ -186,7 +186,8 @@ public:
     Rectangle<int> destination;
     double destAlpha;
 
-    int msElapsed, msTotal;
+    double msElapsed;
+    int msTotal;
     double startSpeed, midSpeed, endSpeed, lastProgress;
     double left, top, right, bottom, alpha;
     bool isMoving, isChangingAlpha;
@@ -204,8 +205,12 @@ private:
 };
 
 //==============================================================================
-ComponentAnimator::ComponentAnimator()  : lastTime (0) {}
-ComponentAnimator::~ComponentAnimator() {}
+ComponentAnimator::ComponentAnimator() {}
+
+ComponentAnimator::~ComponentAnimator()
+{
+    stopRunning();
+}
 
 //==============================================================================
 ComponentAnimator::AnimationTask* ComponentAnimator::findTaskFor (Component* const component) const noexcept
@@ -242,10 +247,11 @@ void ComponentAnimator::animateComponent (Component* const component,
         at->reset (finalBounds, finalAlpha, millisecondsToSpendMoving,
                    useProxyComponent, startSpeed, endSpeed);
 
-        if (! isTimerRunning())
+        if (! isRunning)
         {
-            lastTime = Time::getMillisecondCounter();
-            startTimerHz (50);
+            isRunning = true;
+            lastTime = 0;
+            AnimationClock::addListener (this);
         }
     }
 }
@@ -317,14 +323,22 @@ bool ComponentAnimator::isAnimating() const noexcept
     return tasks.size() != 0;
 }
 
-void ComponentAnimator::timerCallback()
+void ComponentAnimator::stopRunning()
 {
-    auto timeNow = Time::getMillisecondCounter();
+    if (isRunning)
+    {
+        isRunning = false;
+        AnimationClock::removeListener (this);
+    }
+}
 
+void ComponentAnimator::animationFrame (double timeNow)
+{
+    // the first frame after starting is a whole frame into the animation
     if (lastTime == 0)
-        lastTime = timeNow;
+        lastTime = timeNow - 1000.0 / AnimationClock::getFrameRate();
 
-    auto elapsed = (int) (timeNow - lastTime);
+    auto elapsed = timeNow - lastTime;
 
     for (auto* task : Array<AnimationTask*> (tasks.begin(), tasks.size()))
     {
@@ -338,7 +352,7 @@ void ComponentAnimator::timerCallback()
     lastTime = timeNow;
 
     if (tasks.size() == 0)
-        stopTimer();
+        stopRunning();
 }
 
 } // namespace juce
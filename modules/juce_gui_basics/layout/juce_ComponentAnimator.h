@@ -46,12 +46,14 @@ namespace juce
     The class is a ChangeBroadcaster and sends a notification when any components
     start or finish being animated.
 
-    @see Desktop::getAnimator
+    The components are moved in step with the frames of the shared AnimationClock.
+
+    @see Desktop::getAnimator, AnimationClock
 
     @tags{GUI}
 */
 class JUCE_API  ComponentAnimator  : public ChangeBroadcaster,
-                                     private Timer
+                                     private AnimationClock::Listener
 {
 public:
     //==============================================================================
@@ -152,10 +154,12 @@ private:
     //==============================================================================
     class AnimationTask;
     OwnedArray<AnimationTask> tasks;
-    uint32 lastTime;
+    double lastTime = 0;
+    bool isRunning = false;
 
     AnimationTask* findTaskFor (Component*) const noexcept;
-    void timerCallback() override;
+    void animationFrame (double) override;
+    void stopRunning();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentAnimator)
 };
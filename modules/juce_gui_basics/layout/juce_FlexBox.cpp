@@ -37,7 +37,7 @@ struct FlexBoxLayoutCalculation
                       || fb.flexDirection == FlexBox::Direction::rowReverse),
          containerLineLength (isRowDirection ? parentWidth : parentHeight)
     {
-        lineItems.calloc (numItems * numItems);
+        lineItems.calloc (numItems);
         lineInfo.calloc (numItems);
     }
 
@@ -80,7 +80,7 @@ struct FlexBoxLayoutCalculation
 
     struct RowInfo
     {
-        int numItems;
+        int firstItem, numItems;
         Coord crossSize, lineY, totalLength;
     };
 
@@ -93,11 +93,12 @@ struct FlexBoxLayoutCalculation
     int numberOfRows = 1;
     Coord containerCrossLength = 0;
 
+    // the items of each line are stored one after the other, starting at the line's firstItem
     HeapBlock<ItemWithState*> lineItems;
     HeapBlock<RowInfo> lineInfo;
     Array<ItemWithState> itemStates;
 
-    ItemWithState& getItem (int x, int y) const noexcept     { return *lineItems[y * numItems + x]; }
+    ItemWithState& getItem (int x, int y) const noexcept     { return *lineItems[lineInfo[y].firstItem + x]; }
 
     static bool isAuto (Coord value) noexcept                { return value == FlexItem::autoValue; }
     static bool isAssigned (Coord value) noexcept            { return value != FlexItem::notAssigned; }
@@ -137,7 +138,7 @@ struct FlexBoxLayoutCalculation
         else // if multi-line, group the flexbox items into multiple lines
         {
             auto currentLength = containerLineLength;
-            int column = 0, row = 0;
+            int column = 0, row = 0, index = 0;
             bool firstRow = true;
 
             for (auto& item : itemStates)
@@ -157,10 +158,11 @@ struct FlexBoxLayoutCalculation
                     column = 0;
                     currentLength = containerLineLength;
                     numberOfRows = jmax (numberOfRows, row + 1);
+                    lineInfo[row].firstItem = index;
                 }
 
                 currentLength -= flexitemLength;
-                lineItems[row * numItems + column] = &item;
+                lineItems[index++] = &item;
                 ++column;
                 lineInfo[row].numItems = jmax (lineInfo[row].numItems, column);
                 firstRow = false;
@@ -771,9 +773,53 @@ FlexBox::FlexBox (Direction d, Wrap w, AlignContent ac, AlignItems ai, JustifyCo
 {
 }
 
+static bool haveSameLayoutProperties (const FlexItem& a, const FlexItem& b) noexcept
+{
+    return a.associatedComponent == b.associatedComponent
+        && a.associatedFlexBox   == b.associatedFlexBox
+        && a.order      == b.order
+        && a.flexGrow   == b.flexGrow
+        && a.flexShrink == b.flexShrink
+        && a.flexBasis  == b.flexBasis
+        && a.alignSelf  == b.alignSelf
+        && a.width      == b.width
+        && a.minWidth   == b.minWidth
+        && a.maxWidth   == b.maxWidth
+        && a.height     == b.height
+        && a.minHeight  == b.minHeight
+        && a.maxHeight  == b.maxHeight
+        && a.margin.left   == b.margin.left
+        && a.margin.right  == b.margin.right
+        && a.margin.top    == b.margin.top
+        && a.margin.bottom == b.margin.bottom;
+}
+
+bool FlexBox::LayoutCache::matches (const FlexBox& box, Rectangle<float> targetArea) const noexcept
+{
+    if (width != targetArea.getWidth() || height != targetArea.getHeight()
+         || flexDirection != box.flexDirection || flexWrap != box.flexWrap
+         || alignContent != box.alignContent || alignItems != box.alignItems
+         || justifyContent != box.justifyContent || items.size() != box.items.size())
+        return false;
+
+    for (int i = 0; i < items.size(); ++i)
+        if (! haveSameLayoutProperties (items.getReference (i), box.items.getReference (i)))
+            return false;
+
+    return true;
+}
+
 void FlexBox::performLayout (Rectangle<float> targetArea)
 {
-    if (! items.isEmpty())
+    if (items.isEmpty())
+        return;
+
+    if (layoutCache.matches (*this, targetArea))
+    {
+        for (int i = 0; i < items.size(); ++i)
+            items.getReference (i).currentBounds = layoutCache.items.getReference (i).currentBounds;
+    }
+    else
     {
         FlexBoxLayoutCalculation layout (*this, targetArea.getWidth(), targetArea.getHeight());
 
@@ -790,19 +836,31 @@ void FlexBox::performLayout (Rectangle<float> targetArea)
         layout.alignItemsByJustifyContent();
         layout.layoutAllItems();
 
-        for (auto& item : items)
-        {
-            item.currentBounds += targetArea.getPosition();
+        layoutCache.width          = targetArea.getWidth();
+        layoutCache.height         = targetArea.getHeight();
+        layoutCache.flexDirection  = flexDirection;
+        layoutCache.flexWrap       = flexWrap;
+        layoutCache.alignContent   = alignContent;
+        layoutCache.alignItems     = alignItems;
+        layoutCache.justifyContent = justifyContent;
+
+        // (re-using the cache's storage, so that a layout doesn't have to allocate)
+        layoutCache.items.clearQuick();
+        layoutCache.items.addArray (items);
+    }
+
+    for (auto& item : items)
+    {
+        item.currentBounds += targetArea.getPosition();
 
-            if (auto* comp = item.associatedComponent)
-                comp->setBounds (Rectangle<int>::leftTopRightBottom ((int) item.currentBounds.getX(),
-                                                                     (int) item.currentBounds.getY(),
-                                                                     (int) item.currentBounds.getRight(),
-                                                                     (int) item.currentBounds.getBottom()));
+        if (auto* comp = item.associatedComponent)
+            comp->setBounds (Rectangle<int>::leftTopRightBottom ((int) item.currentBounds.getX(),
+                                                                 (int) item.currentBounds.getY(),
+                                                                 (int) item.currentBounds.getRight(),
+                                                                 (int) item.currentBounds.getBottom()));
 
-            if (auto* box = item.associatedFlexBox)
-                box->performLayout (item.currentBounds);
-        }
+        if (auto* box = item.associatedFlexBox)
+            box->performLayout (item.currentBounds);
     }
 }
 
@@ -104,7 +104,12 @@ public:
     ~FlexBox() noexcept;
 
     //==============================================================================
-    /** Lays-out the box's items within the given rectangle. */
+    /** Lays-out the box's items within the given rectangle.
+
+        The result of the last layout is kept, so if this is called again with the same
+        size and identical box and item properties (e.g. when only the box's position has
+        changed), the items are simply moved rather than being laid-out again.
+    */
     void performLayout (Rectangle<float> targetArea);
 
     /** Lays-out the box's items within the given rectangle. */
@@ -141,6 +146,21 @@ public:
     Array<FlexItem> items;
 
 private:
+    struct LayoutCache
+    {
+        bool matches (const FlexBox&, Rectangle<float> targetArea) const noexcept;
+
+        float width = -1.0f, height = -1.0f;
+        Direction flexDirection = Direction::row;
+        Wrap flexWrap = Wrap::noWrap;
+        AlignContent alignContent = AlignContent::stretch;
+        AlignItems alignItems = AlignItems::stretch;
+        JustifyContent justifyContent = JustifyContent::flexStart;
+        Array<FlexItem> items;
+    };
+
+    LayoutCache layoutCache;
+
     JUCE_LEAK_DETECTOR (FlexBox)
 };
 
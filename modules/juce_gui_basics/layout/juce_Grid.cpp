@@ -389,27 +389,71 @@ struct Grid::PlacementHelpers
     }
 
     //==============================================================================
-    static float getCoord (int trackNumber, float relativeUnit, Px gap, const juce::Array<Grid::TrackInfo>& tracks)
+    //==============================================================================
+    static bool isSameProperty (const GridItem::Property& a, const GridItem::Property& b) noexcept
     {
-        float c = 0;
+        return a.name == b.name && a.number == b.number && a.isSpan == b.isSpan && a.isAuto == b.isAuto;
+    }
+
+    static bool isSameTrack (const Grid::TrackInfo& a, const Grid::TrackInfo& b) noexcept
+    {
+        return a.size == b.size && a.isFraction == b.isFraction && a.hasKeyword == b.hasKeyword
+            && a.startLineName == b.startLineName && a.endLineName == b.endLineName;
+    }
+
+    static bool areSameTracks (const juce::Array<Grid::TrackInfo>& a, const juce::Array<Grid::TrackInfo>& b) noexcept
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (int i = 0; i < a.size(); ++i)
+            if (! isSameTrack (a.getReference (i), b.getReference (i)))
+                return false;
+
+        return true;
+    }
+
+    // Compares only the item properties that can affect which tracks the item is placed in,
+    // or the size of any auto-sized tracks.
+    static bool haveSamePlacementProperties (const GridItem& a, const GridItem& b) noexcept
+    {
+        return a.order == b.order
+            && isSameProperty (a.column.start, b.column.start) && isSameProperty (a.column.end, b.column.end)
+            && isSameProperty (a.row.start, b.row.start) && isSameProperty (a.row.end, b.row.end)
+            && a.area == b.area
+            && a.width == b.width && a.height == b.height
+            && a.margin.left == b.margin.left && a.margin.right == b.margin.right
+            && a.margin.top == b.margin.top && a.margin.bottom == b.margin.bottom;
+    }
 
-        for (const auto* it = tracks.begin(); it != tracks.begin() + trackNumber - 1; ++it)
-            c += (it->isFraction ? it->size * relativeUnit : it->size) + static_cast<float> (gap.pixels);
+    //==============================================================================
+    // Fills the array with the start coordinate of each track, so that finding
+    // where an item goes doesn't involve adding up all the tracks before it.
+    static void getTrackPositions (juce::Array<float>& positions, float relativeUnit, Px gap,
+                                   const juce::Array<Grid::TrackInfo>& tracks)
+    {
+        positions.clearQuick();
+        float c = 0;
 
-        return c;
+        for (const auto& track : tracks)
+        {
+            positions.add (c);
+            c += (track.isFraction ? track.size * relativeUnit : track.size) + static_cast<float> (gap.pixels);
+        }
     }
 
     static juce::Rectangle<float> getCellBounds (int columnNumber, int rowNumber,
                                                  const juce::Array<Grid::TrackInfo>& columnTracks,
                                                  const juce::Array<Grid::TrackInfo>& rowTracks,
-                                                 Grid::SizeCalculation calculation,
-                                                 Px columnGap, Px rowGap)
+                                                 const juce::Array<float>& columnPositions,
+                                                 const juce::Array<float>& rowPositions,
+                                                 Grid::SizeCalculation calculation)
     {
         jassert (columnNumber >= 1 && columnNumber <= columnTracks.size());
         jassert (rowNumber >= 1 && rowNumber <= rowTracks.size());
 
-        const auto x = getCoord (columnNumber, calculation.relativeWidthUnit, columnGap, columnTracks);
-        const auto y = getCoord (rowNumber, calculation.relativeHeightUnit, rowGap, rowTracks);
+        const auto x = columnPositions.getUnchecked (columnNumber - 1);
+        const auto y = rowPositions.getUnchecked (rowNumber - 1);
 
         const auto& columnTrackInfo = columnTracks.getReference (columnNumber - 1);
         const float width = columnTrackInfo.isFraction ? columnTrackInfo.size * calculation.relativeWidthUnit
@@ -490,20 +534,21 @@ struct Grid::PlacementHelpers
                                                  int rowLineNumberStart, int rowLineNumberEnd,
                                                  const juce::Array<Grid::TrackInfo>& columnTracks,
                                                  const juce::Array<Grid::TrackInfo>& rowTracks,
+                                                 const juce::Array<float>& columnPositions,
+                                                 const juce::Array<float>& rowPositions,
                                                  Grid::SizeCalculation calculation,
                                                  Grid::AlignContent alignContent,
-                                                 Grid::JustifyContent justifyContent,
-                                                 Px columnGap, Px rowGap)
+                                                 Grid::JustifyContent justifyContent)
     {
         auto startCell = getCellBounds (columnLineNumberStart, rowLineNumberStart,
                                         columnTracks, rowTracks,
-                                        calculation,
-                                        columnGap, rowGap);
+                                        columnPositions, rowPositions,
+                                        calculation);
 
         auto endCell = getCellBounds (columnLineNumberEnd - 1, rowLineNumberEnd - 1,
                                       columnTracks, rowTracks,
-                                      calculation,
-                                      columnGap, rowGap);
+                                      columnPositions, rowPositions,
+                                      calculation);
 
         startCell = alignCell (startCell,
                                columnLineNumberStart, rowLineNumberStart,
@@ -856,34 +901,33 @@ struct Grid::AutoPlacement
     {
         auto isSpan = [](Grid::PlacementHelpers::LineRange r) -> bool { return std::abs (r.end - r.start) > 1; };
 
-        auto getHighestItemOnRow = [isSpan](int rowNumber, const ItemPlacementArray& itemPlacementArrayToUse) -> float
-        {
-            float highestRowSize = 0.0f;
-
-            for (const auto& i : itemPlacementArrayToUse)
-                if (! isSpan (i.second.row) && i.second.row.start == rowNumber)
-                    highestRowSize = std::max (highestRowSize, i.first->height + i.first->margin.top + i.first->margin.bottom);
-
-            return highestRowSize;
-        };
+        // find the largest item in each row and column in a single pass over the items
+        juce::Array<float> highestOnRow, highestOnColumn;
+        highestOnRow.insertMultiple (0, 0.0f, rows.size());
+        highestOnColumn.insertMultiple (0, 0.0f, columns.size());
 
-        auto getHighestItemOnColumn = [isSpan](int rowNumber, const ItemPlacementArray& itemPlacementArrayToUse) -> float
+        for (const auto& i : itemPlacementArray)
         {
-            float highestColumnSize = 0.0f;
-            for (const auto& i : itemPlacementArrayToUse)
-                if (! isSpan (i.second.column) && i.second.column.start == rowNumber)
-                    highestColumnSize = std::max (highestColumnSize, i.first->width + i.first->margin.left + i.first->margin.right);
+            if (! isSpan (i.second.row) && juce::isPositiveAndBelow (i.second.row.start - 1, rows.size()))
+            {
+                auto& highest = highestOnRow.getReference (i.second.row.start - 1);
+                highest = std::max (highest, i.first->height + i.first->margin.top + i.first->margin.bottom);
+            }
 
-            return highestColumnSize;
-        };
+            if (! isSpan (i.second.column) && juce::isPositiveAndBelow (i.second.column.start - 1, columns.size()))
+            {
+                auto& highest = highestOnColumn.getReference (i.second.column.start - 1);
+                highest = std::max (highest, i.first->width + i.first->margin.left + i.first->margin.right);
+            }
+        }
 
         for (int i = 0; i < rows.size(); i++)
             if (rows.getReference (i).hasKeyword)
-                rows.getReference (i).size = getHighestItemOnRow (i + 1, itemPlacementArray);
+                rows.getReference (i).size = highestOnRow.getUnchecked (i);
 
         for (int i = 0; i < columns.size(); i++)
             if (columns.getReference (i).hasKeyword)
-                columns.getReference (i).size = getHighestItemOnColumn (i + 1, itemPlacementArray);
+                columns.getReference (i).size = highestOnColumn.getUnchecked (i);
     }
 };
 
@@ -984,18 +1028,69 @@ Grid::Grid() noexcept {}
 Grid::~Grid() noexcept {}
 
 //==============================================================================
-void Grid::performLayout (juce::Rectangle<int> targetArea)
+bool Grid::PlacementCache::matches (const Grid& grid) const
+{
+    using Helpers = Grid::PlacementHelpers;
+
+    if (! isValid
+         || autoFlow != grid.autoFlow
+         || ! Helpers::isSameTrack (autoRows, grid.autoRows)
+         || ! Helpers::isSameTrack (autoColumns, grid.autoColumns)
+         || ! Helpers::areSameTracks (templateColumns, grid.templateColumns)
+         || ! Helpers::areSameTracks (templateRows, grid.templateRows)
+         || templateAreas != grid.templateAreas
+         || items.size() != grid.items.size())
+        return false;
+
+    for (int i = 0; i < items.size(); ++i)
+        if (! Helpers::haveSamePlacementProperties (items.getReference (i), grid.items.getReference (i)))
+            return false;
+
+    return true;
+}
+
+void Grid::PlacementCache::update (Grid& grid)
 {
-    const auto itemsAndAreas = Grid::AutoPlacement().deduceAllItems (*this);
+    const auto itemsAndAreas = Grid::AutoPlacement().deduceAllItems (grid);
 
-    const auto implicitTracks = Grid::AutoPlacement::createImplicitTracks (*this, itemsAndAreas);
-    auto columnTracks = templateColumns;
-    auto rowTracks = templateRows;
+    const auto implicitTracks = Grid::AutoPlacement::createImplicitTracks (grid, itemsAndAreas);
+    columnTracks = grid.templateColumns;
+    rowTracks = grid.templateRows;
     columnTracks.addArray (implicitTracks.first);
     rowTracks.addArray (implicitTracks.second);
 
     Grid::AutoPlacement::applySizeForAutoTracks (columnTracks, rowTracks, itemsAndAreas);
 
+    placedItems.clearQuick();
+
+    for (auto& itemAndArea : itemsAndAreas)
+    {
+        const auto a = itemAndArea.second;
+        placedItems.add ({ (int) (itemAndArea.first - grid.items.begin()),
+                           a.column.start, a.column.end, a.row.start, a.row.end });
+    }
+
+    templateColumns = grid.templateColumns;
+    templateRows    = grid.templateRows;
+    templateAreas   = grid.templateAreas;
+    autoRows        = grid.autoRows;
+    autoColumns     = grid.autoColumns;
+    autoFlow        = grid.autoFlow;
+
+    items.clearQuick();
+    items.addArray (grid.items);
+    isValid = true;
+}
+
+//==============================================================================
+void Grid::performLayout (juce::Rectangle<int> targetArea)
+{
+    if (! placementCache.matches (*this))
+        placementCache.update (*this);
+
+    const auto& columnTracks = placementCache.columnTracks;
+    const auto& rowTracks    = placementCache.rowTracks;
+
     Grid::SizeCalculation calculation;
     calculation.computeSizes (targetArea.toFloat().getWidth(),
                               targetArea.toFloat().getHeight(),
@@ -1004,25 +1099,27 @@ void Grid::performLayout (juce::Rectangle<int> targetArea)
                               columnTracks,
                               rowTracks);
 
-    for (auto& itemAndArea : itemsAndAreas)
+    Grid::PlacementHelpers::getTrackPositions (placementCache.columnPositions, calculation.relativeWidthUnit, columnGap, columnTracks);
+    Grid::PlacementHelpers::getTrackPositions (placementCache.rowPositions, calculation.relativeHeightUnit, rowGap, rowTracks);
+
+    for (auto& placed : placementCache.placedItems)
     {
-        const auto a = itemAndArea.second;
-        const auto areaBounds = Grid::PlacementHelpers::getAreaBounds (a.column.start, a.column.end,
-                                                                       a.row.start, a.row.end,
+        const auto areaBounds = Grid::PlacementHelpers::getAreaBounds (placed.columnStart, placed.columnEnd,
+                                                                       placed.rowStart, placed.rowEnd,
                                                                        columnTracks,
                                                                        rowTracks,
+                                                                       placementCache.columnPositions,
+                                                                       placementCache.rowPositions,
                                                                        calculation,
                                                                        alignContent,
-                                                                       justifyContent,
-                                                                       columnGap,
-                                                                       rowGap);
+                                                                       justifyContent);
 
-        auto* item = itemAndArea.first;
-        item->currentBounds = Grid::BoxAlignment::alignItem (*item, *this, areaBounds)
-                                + targetArea.toFloat().getPosition();
+        auto& item = items.getReference (placed.itemIndex);
+        item.currentBounds = Grid::BoxAlignment::alignItem (item, *this, areaBounds)
+                               + targetArea.toFloat().getPosition();
 
-        if (auto* c = item->associatedComponent)
-            c->setBounds (item->currentBounds.toNearestIntEdges());
+        if (auto* c = item.associatedComponent)
+            c->setBounds (item.currentBounds.toNearestIntEdges());
     }
 }
 
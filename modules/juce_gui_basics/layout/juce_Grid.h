@@ -204,7 +204,12 @@ public:
     juce::Array<GridItem> items;
 
     //==============================================================================
-    /** Lays-out the grid's items within the given rectangle. */
+    /** Lays-out the grid's items within the given rectangle.
+
+        The placement of the items on the grid's tracks is kept between calls, and is only
+        worked out again when the tracks, areas or any of the items' placement properties
+        have changed, so repeatedly laying out the same grid at different sizes is cheap.
+    */
     void performLayout (juce::Rectangle<int>);
 
     //==============================================================================
@@ -219,6 +224,29 @@ private:
     struct PlacementHelpers;
     struct AutoPlacement;
     struct BoxAlignment;
+
+    struct PlacementCache
+    {
+        struct PlacedItem { int itemIndex, columnStart, columnEnd, rowStart, rowEnd; };
+
+        bool matches (const Grid&) const;
+        void update (Grid&);
+
+        // the properties that the placement was deduced from..
+        juce::Array<TrackInfo> templateColumns, templateRows;
+        juce::StringArray templateAreas;
+        TrackInfo autoRows, autoColumns;
+        AutoFlow autoFlow = AutoFlow::row;
+        juce::Array<GridItem> items;
+        bool isValid = false;
+
+        // ..and the results
+        juce::Array<TrackInfo> columnTracks, rowTracks;
+        juce::Array<PlacedItem> placedItems;
+        juce::Array<float> columnPositions, rowPositions;
+    };
+
+    PlacementCache placementCache;
 };
 
 constexpr Grid::Px operator"" _px (long double px)          { return Grid::Px { px }; }
@@ -253,6 +253,31 @@ struct GridTests  : public UnitTest
             expect (grid.items[4].currentBounds == Rect (250.f, 150.f, 100.f, 100.f));
         }
 
+        {
+            beginTest ("Grid relayout: placement is updated when items or tracks change");
+
+            Grid grid;
+
+            grid.templateColumns = { Tr (1_fr), Tr (1_fr) };
+            grid.templateRows    = { Tr (1_fr), Tr (1_fr) };
+
+            grid.items.addArray ({ GridItem(), GridItem() });
+
+            grid.performLayout ({ 200, 100 });
+            expect (grid.items[1].currentBounds == Rect (100.0f, 0.0f, 100.0f, 50.0f));
+
+            grid.performLayout ({ 10, 20, 400, 200 });
+            expect (grid.items[1].currentBounds == Rect (210.0f, 20.0f, 200.0f, 100.0f));
+
+            grid.items.getReference (1).row = { 2, 3 };
+            grid.performLayout ({ 400, 200 });
+            expect (grid.items[1].currentBounds == Rect (0.0f, 100.0f, 200.0f, 100.0f));
+
+            grid.templateColumns.set (0, Tr (50_px));
+            grid.performLayout ({ 400, 200 });
+            expect (grid.items[0].currentBounds == Rect (0.0f, 0.0f, 50.0f, 100.0f));
+            expect (grid.items[1].currentBounds == Rect (0.0f, 100.0f, 50.0f, 100.0f));
+        }
     }
 };
 
@@ -2277,6 +2277,10 @@ private:
 
             auto originalRepaintRegion = regionsNeedingRepaint;
             regionsNeedingRepaint.clear();
+
+            // each rectangle costs a separate clear and blit, so it's worth painting a few
+            // extra pixels to avoid lots of them
+            originalRepaintRegion.mergeNearbyRectangles();
             auto totalArea = originalRepaintRegion.getBounds();
 
             if (! totalArea.isEmpty())
@@ -47,6 +47,12 @@ public:
             row = newRow;
             selected = nowSelected;
         }
+        else if (updatedContentVersion == owner.contentVersion)
+        {
+            return; // nothing has changed since the model last refreshed this row
+        }
+
+        updatedContentVersion = owner.contentVersion;
 
         if (auto* m = owner.getModel())
         {
@@ -153,7 +159,7 @@ public:
 
     ListBox& owner;
     std::unique_ptr<Component> customComponent;
-    int row = -1;
+    int row = -1, updatedContentVersion = -1;
     bool selected = false, isDragging = false, isDraggingToScroll = false, selectRowOnMouseUp = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RowComponent)
@@ -258,6 +264,17 @@ public:
                     rowComp->update (row, owner.isRowSelected (row));
                 }
             }
+
+            auto newVisibleRows = Range<int>::withStartAndLength (firstIndex, numNeeded)
+                                    .getIntersectionWith ({ 0, owner.totalItems });
+
+            if (newVisibleRows != visibleRows)
+            {
+                visibleRows = newVisibleRows;
+
+                if (auto* m = owner.getModel())
+                    m->visibleRowsChanged (visibleRows);
+            }
         }
 
         if (owner.headerComponent != nullptr)
@@ -339,6 +356,7 @@ private:
     ListBox& owner;
     OwnedArray<RowComponent> rows;
     int firstIndex = 0, firstWholeIndex = 0, lastWholeIndex = 0;
+    Range<int> visibleRows;
     bool hasUpdated = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ListViewport)
@@ -459,6 +477,7 @@ Viewport* ListBox::getViewport() const noexcept
 void ListBox::updateContent()
 {
     hasDoneInitialUpdate = true;
+    ++contentVersion;
     totalItems = (model != nullptr) ? model->getNumRows() : 0;
 
     bool selectionChanged = false;
@@ -950,6 +969,7 @@ void ListBoxModel::selectedRowsChanged (int) {}
 void ListBoxModel::deleteKeyPressed (int) {}
 void ListBoxModel::returnKeyPressed (int) {}
 void ListBoxModel::listWasScrolled() {}
+void ListBoxModel::visibleRowsChanged (Range<int>) {}
 var ListBoxModel::getDragSourceDescription (const SparseSet<int>&)      { return {}; }
 String ListBoxModel::getTooltipForRow (int)                             { return {}; }
 MouseCursor ListBoxModel::getMouseCursorForRow (int)                    { return MouseCursor::NormalCursor; }
@@ -63,7 +63,9 @@ public:
         and handle mouse clicks with listBoxItemClicked().
 
         This method will be called whenever a custom component might need to be updated - e.g.
-        when the list is changed, or ListBox::updateContent() is called.
+        when the list is changed, or ListBox::updateContent() is called. Row components are
+        recycled as the list scrolls, and a row whose number and selection state haven't
+        changed won't be asked to refresh again until the next call to updateContent().
 
         If you don't need a custom component for the specified row, then return nullptr.
         (Bear in mind that even if you're not creating a new component, you may still need to
@@ -140,6 +142,17 @@ public:
     */
     virtual void listWasScrolled();
 
+    /** Override this to be told which rows the list currently has components for.
+
+        This is called whenever scrolling, resizing or a change in the number of rows
+        alters the range of rows that are on (or just about to come on) screen. Only
+        these rows ever get painted or have their components refreshed, so a model
+        for a very large data set can use this to fetch or prepare just the rows that
+        are needed, e.g. on a background thread, and then call ListBox::repaintRow()
+        or ListBox::updateContent() once the data arrives.
+    */
+    virtual void visibleRowsChanged (Range<int> newVisibleRows);
+
     /** To allow rows from your list to be dragged-and-dropped, implement this method.
 
         If this returns a non-null variant then when the user drags a row, the listbox will
@@ -586,7 +599,7 @@ private:
     SparseSet<int> selected;
     int totalItems = 0, rowHeight = 22, minimumRowWidth = 0;
     int outlineThickness = 0;
-    int lastRowSelected = -1;
+    int lastRowSelected = -1, contentVersion = 0;
     bool multipleSelection = false, alwaysFlipSelection = false, hasDoneInitialUpdate = false, selectOnMouseDown = true;
 
     void selectRowInternal (int rowNumber, bool dontScrollToShowThisRow,
@@ -86,15 +86,26 @@ public:
             const Identifier columnProperty ("_tableColumnId");
             auto numColumns = owner.getHeader().getNumColumns (true);
 
+            // Take the old components out so that each one can be handed back to the
+            // column it was made for, even if the columns have been moved around.
+            OwnedArray<Component> oldComponents;
+            oldComponents.swapWith (columnComponents);
+
             for (int i = 0; i < numColumns; ++i)
             {
                 auto columnId = owner.getHeader().getColumnIdOfIndex (i, true);
-                auto* comp = columnComponents[i];
+                Component* comp = nullptr;
 
-                if (comp != nullptr && columnId != static_cast<int> (comp->getProperties() [columnProperty]))
+                for (int j = 0; j < oldComponents.size(); ++j)
                 {
-                    columnComponents.set (i, nullptr);
-                    comp = nullptr;
+                    if (auto* c = oldComponents.getUnchecked (j))
+                    {
+                        if (columnId == static_cast<int> (c->getProperties() [columnProperty]))
+                        {
+                            comp = oldComponents.removeAndReturn (j);
+                            break;
+                        }
+                    }
                 }
 
                 comp = tableModel->refreshComponentForCell (row, columnId, isSelected, comp);
@@ -108,8 +119,6 @@ public:
                     resizeCustomComp (i);
                 }
             }
-
-            columnComponents.removeRange (numColumns, columnComponents.size());
         }
         else
         {
@@ -420,11 +429,24 @@ void TableListBox::listWasScrolled()
         model->listWasScrolled();
 }
 
+void TableListBox::visibleRowsChanged (Range<int> newVisibleRows)
+{
+    if (model != nullptr)
+        model->visibleRowsChanged (newVisibleRows);
+}
+
 void TableListBox::tableColumnsChanged (TableHeaderComponent*)
 {
     setMinimumContentWidth (header->getTotalWidth());
     repaint();
-    updateColumnComponents();
+
+    // the rows won't refresh their cells by themselves unless their content changes,
+    // so any newly added, removed or moved columns need to be pushed to them here
+    auto firstRow = jmax (0, getRowContainingPosition (0, 0));
+
+    for (int i = firstRow + getNumRowsOnScreen() + 2; --i >= firstRow;)
+        if (auto* rowComp = dynamic_cast<RowComp*> (getComponentForRowNumber (i)))
+            rowComp->update (i, isRowSelected (i));
 }
 
 void TableListBox::tableColumnsResized (TableHeaderComponent*)
@@ -474,6 +496,7 @@ void TableListBoxModel::selectedRowsChanged (int)                       {}
 void TableListBoxModel::deleteKeyPressed (int)                          {}
 void TableListBoxModel::returnKeyPressed (int)                          {}
 void TableListBoxModel::listWasScrolled()                               {}
+void TableListBoxModel::visibleRowsChanged (Range<int>)                 {}
 
 String TableListBoxModel::getCellTooltip (int /*rowNumber*/, int /*columnId*/)    { return {}; }
 var TableListBoxModel::getDragSourceDescription (const SparseSet<int>&)           { return {}; }
@@ -177,6 +177,12 @@ public:
     */
     virtual void listWasScrolled();
 
+    /** Override this to be told which rows the table currently has components for.
+
+        @see ListBoxModel::visibleRowsChanged
+    */
+    virtual void visibleRowsChanged (Range<int> newVisibleRows);
+
     /** To allow rows from your table to be dragged-and-dropped, implement this method.
 
         If this returns a non-null variant then when the user drags a row, the table will try to
@@ -324,6 +330,8 @@ public:
     /** @internal */
     void listWasScrolled() override;
     /** @internal */
+    void visibleRowsChanged (Range<int>) override;
+    /** @internal */
     void tableColumnsChanged (TableHeaderComponent*) override;
     /** @internal */
     void tableColumnsResized (TableHeaderComponent*) override;
@@ -185,6 +185,16 @@ public:
             auto* item = owner.rootItem;
             int y = (item != nullptr && ! owner.rootItemVisible) ? -item->itemHeight : 0;
 
+            // skip straight to the first visible item, rather than walking through all the ones above it
+            if (item != nullptr && visibleTop > 0 && ! owner.needsRecalculating)
+            {
+                if (auto* first = item->findItemRecursively (visibleTop - 1 - y))
+                {
+                    item = first;
+                    y = first->y;
+                }
+            }
+
             while (item != nullptr && y < visibleBottom)
             {
                 y += item->itemHeight;
@@ -851,7 +861,7 @@ void TreeView::recalculateIfNeeded()
         const ScopedLock sl (nodeAlterationLock);
 
         if (rootItem != nullptr)
-            rootItem->updatePositions (rootItemVisible ? 0 : -rootItem->itemHeight);
+            rootItem->updatePositions (rootItemVisible ? 0 : -rootItem->itemHeight, 0);
 
         viewport->updateComponents (false);
 
@@ -1434,9 +1444,11 @@ bool TreeViewItem::areAllParentsOpen() const noexcept
             || (parentItem->isOpen() && parentItem->areAllParentsOpen());
 }
 
-void TreeViewItem::updatePositions (int newY)
+void TreeViewItem::updatePositions (int newY, int newRow)
 {
     y = newY;
+    row = newRow;
+    numRows = 1;
     itemHeight = getItemHeight();
     totalHeight = itemHeight;
     itemWidth = getItemWidth();
@@ -1445,17 +1457,40 @@ void TreeViewItem::updatePositions (int newY)
     if (isOpen())
     {
         newY += totalHeight;
+        ++newRow;
 
-        for (auto* i : subItems)
+        for (int index = 0; index < subItems.size(); ++index)
         {
-            i->updatePositions (newY);
+            auto* i = subItems.getUnchecked (index);
+            i->indexInParent = index;
+            i->updatePositions (newY, newRow);
             newY += i->totalHeight;
+            newRow += i->numRows;
             totalHeight += i->totalHeight;
+            numRows += i->numRows;
             totalWidth = jmax (totalWidth, i->totalWidth);
         }
     }
 }
 
+// The positions and row numbers that updatePositions() stores can only be trusted if the
+// tree hasn't changed since, and if this item was actually visible when it was called.
+bool TreeViewItem::hasValidLayout() const noexcept
+{
+    return ownerView != nullptr && ! ownerView->needsRecalculating && areAllParentsOpen();
+}
+
+// Returns the index of the sub-item whose area contains a position relative to this item,
+// or the one before it. The sub-items are sorted by position, so this is a binary search.
+int TreeViewItem::findSubItemIndexAtY (int targetY) const noexcept
+{
+    auto absoluteY = y + targetY;
+    auto next = std::upper_bound (subItems.begin(), subItems.end(), absoluteY,
+                                  [] (int value, const TreeViewItem* item) { return value < item->y; });
+
+    return jmax (0, (int) (next - subItems.begin()) - 1);
+}
+
 TreeViewItem* TreeViewItem::getDeepestOpenParentItem() noexcept
 {
     TreeViewItem* result = this;
@@ -1598,8 +1633,9 @@ void TreeViewItem::paintRecursively (Graphics& g, int width)
     {
         auto clip = g.getClipBounds();
 
-        for (auto* ti : subItems)
+        for (int i = (subItems.isEmpty() ? 0 : findSubItemIndexAtY (clip.getY())); i < subItems.size(); ++i)
         {
+            auto* ti = subItems.getUnchecked (i);
             auto relY = ti->y - y;
 
             if (relY >= clip.getBottom())
@@ -1626,8 +1662,15 @@ bool TreeViewItem::isLastOfSiblings() const noexcept
 
 int TreeViewItem::getIndexInParent() const noexcept
 {
-    return parentItem == nullptr ? 0
-                                 : parentItem->subItems.indexOf (this);
+    if (parentItem == nullptr)
+        return 0;
+
+    // (the index that was stored by updatePositions() is usually still right)
+    if (isPositiveAndBelow (indexInParent, parentItem->subItems.size())
+         && parentItem->subItems.getUnchecked (indexInParent) == this)
+        return indexInParent;
+
+    return parentItem->subItems.indexOf (this);
 }
 
 TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
@@ -1638,6 +1681,9 @@ TreeViewItem* TreeViewItem::getTopLevelItem() noexcept
 
 int TreeViewItem::getNumRows() const noexcept
 {
+    if (hasValidLayout())
+        return numRows;
+
     int num = 1;
 
     if (isOpen())
@@ -1654,6 +1700,20 @@ TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
 
     if (index > 0 && isOpen())
     {
+        if (hasValidLayout())
+        {
+            if (index >= numRows)
+                return nullptr;
+
+            auto targetRow = row + index;
+            auto next = std::upper_bound (subItems.begin(), subItems.end(), targetRow,
+                                          [] (int value, const TreeViewItem* item) { return value < item->row; });
+
+            jassert (next != subItems.begin());
+            auto* i = *(next - 1);
+            return i->getItemOnRow (targetRow - i->row);
+        }
+
         --index;
 
         for (auto* i : subItems)
@@ -1661,12 +1721,12 @@ TreeViewItem* TreeViewItem::getItemOnRow (int index) noexcept
             if (index == 0)
                 return i;
 
-            auto numRows = i->getNumRows();
+            auto numRowsInItem = i->getNumRows();
 
-            if (numRows > index)
+            if (numRowsInItem > index)
                 return i->getItemOnRow (index);
 
-            index -= numRows;
+            index -= numRowsInItem;
         }
     }
 
@@ -1682,17 +1742,10 @@ TreeViewItem* TreeViewItem::findItemRecursively (int targetY) noexcept
         if (targetY < h)
             return this;
 
-        if (isOpen())
+        if (isOpen() && ! subItems.isEmpty())
         {
-            targetY -= h;
-
-            for (auto* i : subItems)
-            {
-                if (targetY < i->totalHeight)
-                    return i->findItemRecursively (targetY);
-
-                targetY -= i->totalHeight;
-            }
+            auto* i = subItems.getUnchecked (findSubItemIndexAtY (targetY));
+            return i->findItemRecursively (targetY - (i->y - y));
         }
     }
 
@@ -1741,9 +1794,12 @@ int TreeViewItem::getRowNumberInTree() const noexcept
         if (! parentItem->isOpen())
             return parentItem->getRowNumberInTree();
 
+        if (hasValidLayout())
+            return ownerView->rootItemVisible ? row : row - 1;
+
         int n = 1 + parentItem->getRowNumberInTree();
 
-        int ourIndex = parentItem->subItems.indexOf (this);
+        int ourIndex = getIndexInParent();
         jassert (ourIndex >= 0);
 
         while (--ourIndex >= 0)
@@ -1772,7 +1828,7 @@ TreeViewItem* TreeViewItem::getNextVisibleItem (const bool recurse) const noexce
 
     if (parentItem != nullptr)
     {
-        const int nextIndex = parentItem->subItems.indexOf (this) + 1;
+        const int nextIndex = getIndexInParent() + 1;
 
         if (nextIndex >= parentItem->subItems.size())
             return parentItem->getNextVisibleItem (false);
@@ -585,6 +585,7 @@ private:
     TreeViewItem* parentItem = nullptr;
     OwnedArray<TreeViewItem> subItems;
     int y = 0, itemHeight = 0, totalHeight = 0, itemWidth = 0, totalWidth = 0;
+    int row = 0, numRows = 1, indexInParent = 0;
     int uid = 0;
     bool selected           : 1;
     bool redrawNeeded       : 1;
@@ -596,7 +597,7 @@ private:
 
     friend class TreeView;
 
-    void updatePositions (int newY);
+    void updatePositions (int newY, int newRow);
     int getIndentX() const noexcept;
     void setOwnerView (TreeView*) noexcept;
     void paintRecursively (Graphics&, int width);
@@ -609,6 +610,8 @@ private:
     int countSelectedItemsRecursively (int depth) const noexcept;
     TreeViewItem* getSelectedItemWithIndex (int index) noexcept;
     TreeViewItem* getNextVisibleItem (bool recurse) const noexcept;
+    bool hasValidLayout() const noexcept;
+    int findSubItemIndexAtY (int targetY) const noexcept;
     TreeViewItem* findItemFromIdentifierString (const String&);
     void restoreToDefaultOpenness();
     bool isFullyOpen() const noexcept;
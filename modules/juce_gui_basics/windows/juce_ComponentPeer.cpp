@@ -29,6 +29,8 @@ namespace juce
 
 static uint32 lastUniquePeerID = 1;
 
+ComponentPeer::PaintStatistics* ComponentPeer::currentPaintStatistics = nullptr;
+
 //==============================================================================
 ComponentPeer::ComponentPeer (Component& comp, int flags)
     : component (comp),
@@ -128,12 +130,22 @@ void ComponentPeer::handlePaint (LowLevelGraphicsContext& contextToPaintTo)
     }
   #endif
 
+    PaintStatistics stats;
+    auto invalidArea = g.getClipBounds();
+    stats.areaInvalidated = (int64) invalidArea.getWidth() * invalidArea.getHeight();
+
+    auto* previousStats = currentPaintStatistics;
+    currentPaintStatistics = &stats;
+
     JUCE_TRY
     {
         component.paintEntireComponent (g, true);
     }
     JUCE_CATCH_EXCEPTION
 
+    currentPaintStatistics = previousStats;
+    lastPaintStatistics = stats;
+
   #if JUCE_ENABLE_REPAINT_DEBUGGING
    #ifdef JUCE_IS_REPAINT_DEBUGGING_ACTIVE
     if (JUCE_IS_REPAINT_DEBUGGING_ACTIVE)
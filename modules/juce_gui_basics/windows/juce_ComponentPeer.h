@@ -235,6 +235,46 @@ public:
     /** This is called to repaint the component into the given context. */
     void handlePaint (LowLevelGraphicsContext& contextToPaintTo);
 
+    //==============================================================================
+    /** Some statistics about what happened during the last call to handlePaint().
+
+        These can help to find out how much overdraw a UI is causing, i.e. how many times
+        each pixel gets painted over by components that are stacked on top of each other.
+        The areas are measured using the bounds of each component's clip region.
+
+        @see getLastPaintStatistics
+    */
+    struct JUCE_API  PaintStatistics
+    {
+        /** The number of components whose paint() method was called. */
+        int numComponentsPainted = 0;
+
+        /** The number of components that weren't painted because opaque siblings covered them. */
+        int numComponentsCulled = 0;
+
+        /** The total area that the components were asked to paint. */
+        int64 areaPainted = 0;
+
+        /** The area of the region that was being repainted. */
+        int64 areaInvalidated = 0;
+
+        /** Returns the average number of times that each pixel was painted. */
+        double getOverdraw() const noexcept
+        {
+            return areaInvalidated > 0 ? (double) areaPainted / (double) areaInvalidated : 0.0;
+        }
+
+        /** @internal */
+        void addComponent (Rectangle<int> clipBounds) noexcept
+        {
+            ++numComponentsPainted;
+            areaPainted += (int64) clipBounds.getWidth() * clipBounds.getHeight();
+        }
+    };
+
+    /** Returns the statistics that were gathered during the last call to handlePaint(). */
+    const PaintStatistics& getLastPaintStatistics() const noexcept      { return lastPaintStatistics; }
+
     //==============================================================================
     /** Sets this window to either be always-on-top or normal.
         Some kinds of window might not be able to do this, so should return false.
@@ -422,8 +462,12 @@ private:
     Component* lastDragAndDropCompUnderMouse = nullptr;
     const uint32 uniqueID;
     bool isWindowMinimised = false;
+    PaintStatistics lastPaintStatistics;
+    static PaintStatistics* currentPaintStatistics;
     Component* getTargetForKeyPress();
 
+    friend class Component;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentPeer)
 };
 
@@ -72,6 +72,10 @@ enum MissingOpenGLDefinitions
     GL_FRAMEBUFFER_BINDING          = 0x8CA6,
    #endif
 
+   #ifndef GL_PIXEL_UNPACK_BUFFER
+    GL_PIXEL_UNPACK_BUFFER          = 0x88EC,
+   #endif
+
    #ifndef GL_FRAMEBUFFER_COMPLETE
     GL_FRAMEBUFFER_COMPLETE         = 0x8CD5,
    #endif
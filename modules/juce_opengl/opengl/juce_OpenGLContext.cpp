@@ -66,9 +66,121 @@ private:
 
 #endif
 
+//==============================================================================
+// The thread used by all the contexts that have called setUsesSharedRenderThread().
+// Each of their CachedImages is a job on it which renders at most one frame before
+// handing the thread over to the next one.
+struct SharedRenderThread  : public ReferenceCountedObject
+{
+    struct Client
+    {
+        virtual ~Client() {}
+
+        // Returns 0 if the client has something to render now, otherwise the number of
+        // milliseconds until it will, or -1 if it's waiting for a repaint to be triggered.
+        virtual int getMillisecondsUntilNextFrame (uint32 now) = 0;
+
+        // Returns the native context that others can share objects with, if it exists yet.
+        virtual void* getRawContextForSharing() = 0;
+    };
+
+    using Ptr = ReferenceCountedObjectPtr<SharedRenderThread>;
+
+    ~SharedRenderThread() override
+    {
+        jassert (clients.isEmpty());
+        getInstancePointer() = nullptr;
+    }
+
+    // (the shared thread is only ever acquired and released by the message thread)
+    static Ptr getInstance()
+    {
+        auto& instance = getInstancePointer();
+
+        if (instance == nullptr)
+            instance = new SharedRenderThread();
+
+        return instance;
+    }
+
+    void addClient (Client& c)
+    {
+        const ScopedLock sl (lock);
+        clients.addIfNotAlreadyThere (&c);
+    }
+
+    void removeClient (Client& c)
+    {
+        const ScopedLock sl (lock);
+        clients.removeFirstMatchingValue (&c);
+    }
+
+    void* findContextToShareWith()
+    {
+        const ScopedLock sl (lock);
+
+        for (auto* c : clients)
+            if (auto* raw = c->getRawContextForSharing())
+                return raw;
+
+        return nullptr;
+    }
+
+    void wakeUp() noexcept
+    {
+        wakeEvent.signal();
+    }
+
+    // Called by a client that had nothing to render, so that the thread can sleep until
+    // one of the clients has. A trigger that arrives after the check leaves the event
+    // signalled, so it can't be missed.
+    void waitUntilAnyClientNeedsRendering()
+    {
+        auto now = Time::getMillisecondCounter();
+        int timeoutMs = maxIdleWaitMs;
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto* c : clients)
+            {
+                auto ms = c->getMillisecondsUntilNextFrame (now);
+
+                if (ms == 0)
+                    return;
+
+                if (ms > 0)
+                    timeoutMs = jmin (timeoutMs, ms);
+            }
+        }
+
+        wakeEvent.wait (timeoutMs);
+    }
+
+    ThreadPool pool { 1 };
+
+private:
+    enum { maxIdleWaitMs = 500 };
+
+    Array<Client*> clients;
+    CriticalSection lock;
+    WaitableEvent wakeEvent;
+
+    SharedRenderThread() = default;
+
+    static SharedRenderThread*& getInstancePointer() noexcept
+    {
+        static SharedRenderThread* instance = nullptr;
+        return instance;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (SharedRenderThread)
+};
+
 //==============================================================================
 class OpenGLContext::CachedImage  : public CachedComponentImage,
-                                    private ThreadPoolJob
+                                    private ThreadPoolJob,
+                                    private SharedRenderThread::Client
 {
 public:
     CachedImage (OpenGLContext& c, Component& comp,
@@ -76,6 +188,14 @@ public:
         : ThreadPoolJob ("OpenGL Rendering"),
           context (c), component (comp)
     {
+        if (c.useSharedRenderThread)
+        {
+            sharedThread = SharedRenderThread::getInstance();
+
+            if (contextToShare == nullptr)
+                contextToShare = sharedThread->findContextToShareWith();
+        }
+
         nativeContext.reset (new NativeContext (component, pixFormat, contextToShare,
                                                 c.useMultisampling, c.versionRequired));
 
@@ -95,21 +215,32 @@ public:
     {
         if (nativeContext != nullptr)
         {
-            renderThread.reset (new ThreadPool (1));
+            if (sharedThread != nullptr)
+            {
+                initialisationFailed = false;
+                sharedThread->addClient (*this);
+                activeRenderThread = &(sharedThread->pool);
+            }
+            else
+            {
+                renderThread.reset (new ThreadPool (1));
+                activeRenderThread = renderThread.get();
+            }
+
             resume();
         }
     }
 
     void stop()
     {
-        if (renderThread != nullptr)
+        if (activeRenderThread != nullptr)
         {
             // make sure everything has finished executing
             destroying.set (1);
 
             if (workQueue.size() > 0)
             {
-                if (! renderThread->contains (this))
+                if (! activeRenderThread->contains (this))
                     resume();
 
                 while (workQueue.size() != 0)
@@ -117,6 +248,18 @@ public:
             }
 
             pause();
+
+            if (sharedThread != nullptr)
+            {
+                sharedThread->removeClient (*this);
+
+                // If the job was taken off the shared thread while it was waiting for its
+                // next turn, it never got the chance to shut itself down
+                if (hasInitialised)
+                    shutdown();
+            }
+
+            activeRenderThread = nullptr;
             renderThread.reset();
         }
 
@@ -129,17 +272,21 @@ public:
         signalJobShouldExit();
         messageManagerLock.abort();
 
-        if (renderThread != nullptr)
+        if (activeRenderThread != nullptr)
         {
             repaintEvent.signal();
-            renderThread->removeJob (this, true, -1);
+
+            if (sharedThread != nullptr)
+                sharedThread->wakeUp();
+
+            activeRenderThread->removeJob (this, true, -1);
         }
     }
 
     void resume()
     {
-        if (renderThread != nullptr)
-            renderThread->addJob (this, false);
+        if (activeRenderThread != nullptr)
+            activeRenderThread->addJob (this, false);
     }
 
     //==============================================================================
@@ -171,6 +318,9 @@ public:
     {
         needsUpdate = 1;
         repaintEvent.signal();
+
+        if (sharedThread != nullptr)
+            sharedThread->wakeUp();
     }
 
     //==============================================================================
@@ -428,26 +578,11 @@ public:
     //==============================================================================
     JobStatus runJob() override
     {
-        {
-            // Allow the message thread to finish setting-up the context before using it..
-            MessageManager::Lock::ScopedTryLockType mmLock (messageManagerLock, false);
-
-            do
-            {
-                if (shouldExit())
-                    return ThreadPoolJob::jobHasFinished;
-
-            } while (! mmLock.retryLock());
-        }
-
-        if (! initialiseOnThread())
-        {
-            hasInitialised = false;
+        if (sharedThread != nullptr)
+            return runSharedJob();
 
+        if (! initialise())
             return ThreadPoolJob::jobHasFinished;
-        }
-
-        hasInitialised = true;
 
         while (! shouldExit())
         {
@@ -468,12 +603,100 @@ public:
                 repaintEvent.wait (-1);
         }
 
+        shutdown();
+        return ThreadPoolJob::jobHasFinished;
+    }
+
+    // On the shared thread, each call renders no more than one frame, and then
+    // returns so that the other contexts can have their turn
+    JobStatus runSharedJob()
+    {
+        if (! hasInitialised)
+        {
+            if (! initialise())
+            {
+                initialisationFailed = ! shouldExit();
+                return ThreadPoolJob::jobHasFinished;
+            }
+
+            OpenGLContext::deactivateCurrentContext();
+        }
+
+       #if JUCE_IOS
+        if (backgroundProcessCheck.isBackgroundProcess())
+            repaintEvent.wait (300);
+        else
+       #endif
+        if (! shouldExit())
+        {
+            auto now = Time::getMillisecondCounter();
+
+            if (getMillisecondsUntilNextFrame (now) == 0)
+            {
+                lastFrameTime = now;
+                renderFrame();
+            }
+            else
+            {
+                sharedThread->waitUntilAnyClientNeedsRendering();
+            }
+        }
+
+        if (shouldExit())
+        {
+            shutdown();
+            return ThreadPoolJob::jobHasFinished;
+        }
+
+        return ThreadPoolJob::jobNeedsRunningAgain;
+    }
+
+    int getMillisecondsUntilNextFrame (uint32 now) override
+    {
+        if (initialisationFailed)
+            return -1;
+
+        if (! hasInitialised || needsUpdate.get() != 0 || workQueue.size() > 0)
+            return 0;
+
+        if (context.continuousRepaint)
+        {
+            auto nextFrameTime = lastFrameTime + (uint32) sharedThreadFrameIntervalMs;
+            return nextFrameTime > now ? (int) (nextFrameTime - now) : 0;
+        }
+
+        return -1;
+    }
+
+    void* getRawContextForSharing() override
+    {
+        return hasInitialised && nativeContext != nullptr ? nativeContext->getRawContext() : nullptr;
+    }
+
+    bool initialise()
+    {
+        {
+            // Allow the message thread to finish setting-up the context before using it..
+            MessageManager::Lock::ScopedTryLockType mmLock (messageManagerLock, false);
+
+            do
+            {
+                if (shouldExit())
+                    return false;
+
+            } while (! mmLock.retryLock());
+        }
+
+        hasInitialised = initialiseOnThread();
+        return hasInitialised;
+    }
+
+    void shutdown()
+    {
         hasInitialised = false;
         context.makeActive();
         shutdownOnThread();
         OpenGLContext::deactivateCurrentContext();
-
-        return ThreadPoolJob::jobHasFinished;
     }
 
     bool initialiseOnThread()
@@ -506,7 +729,8 @@ public:
 
         glViewport (0, 0, component.getWidth(), component.getHeight());
 
-        nativeContext->setSwapInterval (1);
+        // On the shared thread, a context that waits for the vertical sync would hold up all the others
+        nativeContext->setSwapInterval (sharedThread != nullptr ? 0 : 1);
 
        #if ! JUCE_OPENGL_ES
         JUCE_CHECK_OPENGL_ERROR
@@ -649,6 +873,11 @@ public:
     uint32 lastMMLockReleaseTime = 0;
 
     std::unique_ptr<ThreadPool> renderThread;
+    ThreadPool* activeRenderThread = nullptr;
+    SharedRenderThread::Ptr sharedThread;
+    uint32 lastFrameTime = 0;
+    bool initialisationFailed = false;
+    enum { sharedThreadFrameIntervalMs = 16 };
     ReferenceCountedArray<OpenGLContext::AsyncWorker, CriticalSection> workQueue;
     MessageManager::Lock messageManagerLock;
 
@@ -873,6 +1102,15 @@ void OpenGLContext::setNativeSharedContext (void* nativeContextToShareWith) noex
     contextToShareWith = nativeContextToShareWith;
 }
 
+void OpenGLContext::setUsesSharedRenderThread (bool shouldUseSharedThread) noexcept
+{
+    // This method must not be called when the context has already been attached!
+    // Call it before attaching your context, or use detach() first, before calling this!
+    jassert (nativeContext == nullptr);
+
+    useSharedRenderThread = shouldUseSharedThread;
+}
+
 void OpenGLContext::setMultisamplingEnabled (bool b) noexcept
 {
     // This method must not be called when the context has already been attached!
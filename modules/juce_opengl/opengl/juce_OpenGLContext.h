@@ -123,6 +123,33 @@ public:
     */
     void setNativeSharedContext (void* nativeContextToShareWith) noexcept;
 
+    /** Makes this context render on a single thread that it shares with all the other
+        contexts that have this option enabled, instead of creating a render thread of
+        its own.
+
+        This is useful when an app (or a plugin host) has many GL-accelerated windows
+        open at once: rather than dozens of threads all contending for the message
+        manager lock, the contexts are rendered one after another in a round-robin.
+
+        Unless you've also called setNativeSharedContext(), a context that uses the
+        shared thread will also share its GL objects (textures, buffers, shader
+        programs, etc.) with the other contexts that are already running on it.
+
+        Because one context waiting for a vertical sync would hold up all the others,
+        contexts on the shared thread start off with a swap interval of 0, and their
+        continuous repainting is limited to about 60 frames per second instead.
+
+        If the context gets detached while it's waiting for its turn on the shared
+        thread, OpenGLRenderer::openGLContextClosing() will be called (with the context
+        active) on the thread that detached it, rather than on the render thread.
+
+        Note: This must be called BEFORE attaching your context to a target component!
+    */
+    void setUsesSharedRenderThread (bool shouldUseSharedThread) noexcept;
+
+    /** Returns true if setUsesSharedRenderThread() has been enabled. */
+    bool usesSharedRenderThread() const noexcept                { return useSharedRenderThread; }
+
     /** Enables multisampling on platforms where this is implemented.
         If enabling this, you must call this method before attachTo().
     */
@@ -329,6 +356,7 @@ private:
     OpenGLVersion versionRequired = defaultGLVersion;
     size_t imageCacheMaxSize = 8 * 1024 * 1024;
     bool renderComponents = true, useMultisampling = false, continuousRepaint = false, overrideCanAttach = false;
+    bool useSharedRenderThread = false;
     TextureMagnificationFilter texMagFilter = linear;
 
     //==============================================================================
@@ -27,8 +27,6 @@
 namespace juce
 {
 
-extern void (*clearOpenGLGlyphCache)(); // declared in juce_graphics
-
 namespace OpenGLRendering
 {
 
@@ -114,7 +112,15 @@ struct CachedImageList  : public ReferenceCountedObject,
             if (textureNeedsReloading && pixelData != nullptr)
             {
                 textureNeedsReloading = false;
-                texture.loadImage (Image (*pixelData));
+
+                // if only part of the image has been modified since the texture was
+                // created, there's no need to send all of it again
+                if (texture.getTextureID() != 0 && ! changedArea.isEmpty())
+                    texture.loadImageSubsection (Image (*pixelData), changedArea);
+                else
+                    texture.loadImage (Image (*pixelData));
+
+                changedArea = {};
             }
 
             t.textureID = texture.getTextureID();
@@ -132,6 +138,7 @@ struct CachedImageList  : public ReferenceCountedObject,
         OpenGLTexture texture;
         Time lastUsed;
         const size_t imageSize;
+        Rectangle<int> changedArea;
         bool textureNeedsReloading = true;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedImage)
@@ -153,7 +160,23 @@ private:
     void imageDataChanged (ImagePixelData* im) override
     {
         if (auto* c = findCachedImage (im))
+        {
+            c->textureNeedsReloading = true;
+            c->changedArea = {};
+        }
+    }
+
+    void imageAreaChanged (ImagePixelData* im, Rectangle<int> area) override
+    {
+        if (auto* c = findCachedImage (im))
+        {
+            // once the whole image needs reloading, a partial change can't make that any smaller
+            if (c->textureNeedsReloading && c->changedArea.isEmpty())
+                return;
+
+            c->changedArea = c->textureNeedsReloading ? c->changedArea.getUnion (area) : area;
             c->textureNeedsReloading = true;
+        }
     }
 
     void imageDataBeingDeleted (ImagePixelData* im) override
@@ -362,7 +385,8 @@ struct ShaderPrograms  : public ReferenceCountedObject
           tiledImage (context),
           tiledImageMasked (context),
           copyTexture (context),
-          maskTexture (context)
+          maskTexture (context),
+          glyphAtlas (context)
     {}
 
     using Ptr = ReferenceCountedObjectPtr<ShaderPrograms>;
@@ -415,12 +439,14 @@ struct ShaderPrograms  : public ReferenceCountedObject
               screenBounds (program, "screenBounds")
         {}
 
+        virtual ~ShaderBase() = default;
+
         void set2DBounds (Rectangle<float> bounds)
         {
             screenBounds.set (bounds.getX(), bounds.getY(), 0.5f * bounds.getWidth(), 0.5f * bounds.getHeight());
         }
 
-        void bindAttributes (OpenGLContext& context)
+        virtual void bindAttributes (OpenGLContext& context)
         {
             context.extensions.glVertexAttribPointer ((GLuint) positionAttribute.attributeID, 2, GL_SHORT, GL_FALSE, 8, nullptr);
             context.extensions.glVertexAttribPointer ((GLuint) colourAttribute.attributeID, 4, GL_UNSIGNED_BYTE, GL_TRUE, 8, (void*) 4);
@@ -428,7 +454,7 @@ struct ShaderPrograms  : public ReferenceCountedObject
             context.extensions.glEnableVertexAttribArray ((GLuint) colourAttribute.attributeID);
         }
 
-        void unbindAttributes (OpenGLContext& context)
+        virtual void unbindAttributes (OpenGLContext& context)
         {
             context.extensions.glDisableVertexAttribArray ((GLuint) positionAttribute.attributeID);
             context.extensions.glDisableVertexAttribArray ((GLuint) colourAttribute.attributeID);
@@ -799,6 +825,86 @@ struct ShaderPrograms  : public ReferenceCountedObject
         ImageParams imageParams;
     };
 
+    //==============================================================================
+    // Draws glyphs from the glyph atlas. Its quads carry atlas positions where the
+    // others have a colour, and the colour is set for the whole batch instead.
+    struct GlyphAtlasProgram  : public ShaderBase
+    {
+        GlyphAtlasProgram (OpenGLContext& context)
+            : ShaderBase (context,
+                          "uniform sampler2D atlasTexture;"
+                          "uniform " JUCE_MEDIUMP " vec4 glyphColour;"
+                          "uniform " JUCE_MEDIUMP " float levelScale;"
+                          "varying " JUCE_HIGHP " vec2 texturePos;"
+                          "void main()"
+                          "{"
+                            "gl_FragColor = glyphColour * min (1.0, levelScale * texture2D (atlasTexture, texturePos).a);"
+                          "}",
+                          "attribute vec2 position;"
+                          "attribute vec2 atlasPosition;"
+                          "uniform vec4 screenBounds;"
+                          "uniform " JUCE_HIGHP " float atlasScale;"
+                          "varying " JUCE_HIGHP " vec2 texturePos;"
+                          "void main()"
+                          "{"
+                            "texturePos = atlasPosition * atlasScale;"
+                            "vec2 scaledPos = (position - screenBounds.xy) / screenBounds.zw;"
+                            "gl_Position = vec4 (scaledPos.x - 1.0, 1.0 - scaledPos.y, 0, 1.0);"
+                          "}"),
+              atlasPositionAttribute (program, "atlasPosition"),
+              atlasTexture (program, "atlasTexture"),
+              glyphColour (program, "glyphColour"),
+              levelScale (program, "levelScale"),
+              atlasScale (program, "atlasScale")
+        {
+            onShaderActivated = [this] (OpenGLShaderProgram&)
+            {
+                atlasTexture.set ((GLint) 0);
+                atlasScale.set (1.0f / (float) RenderingHelpers::GlyphAtlas::atlasSize);
+            };
+        }
+
+        void bindAttributes (OpenGLContext& context) override
+        {
+            context.extensions.glVertexAttribPointer ((GLuint) positionAttribute.attributeID, 2, GL_SHORT, GL_FALSE, 8, nullptr);
+            context.extensions.glVertexAttribPointer ((GLuint) atlasPositionAttribute.attributeID, 2, GL_UNSIGNED_SHORT, GL_FALSE, 8, (void*) 4);
+            context.extensions.glEnableVertexAttribArray ((GLuint) positionAttribute.attributeID);
+            context.extensions.glEnableVertexAttribArray ((GLuint) atlasPositionAttribute.attributeID);
+        }
+
+        void unbindAttributes (OpenGLContext& context) override
+        {
+            context.extensions.glDisableVertexAttribArray ((GLuint) positionAttribute.attributeID);
+            context.extensions.glDisableVertexAttribArray ((GLuint) atlasPositionAttribute.attributeID);
+        }
+
+        // This must be called while the program's active, so that it can flush any
+        // glyphs that were queued with the old colour
+        template <typename QuadQueueType>
+        void setColour (QuadQueueType& quadQueue, PixelARGB colour, float newLevelScale)
+        {
+            if (hasColour && colour.getNativeARGB() == currentColour.getNativeARGB() && newLevelScale == currentLevelScale)
+                return;
+
+            quadQueue.flush();
+            hasColour = true;
+            currentColour = colour;
+            currentLevelScale = newLevelScale;
+
+            glyphColour.set (colour.getRed()   / 255.0f, colour.getGreen() / 255.0f,
+                             colour.getBlue()  / 255.0f, colour.getAlpha() / 255.0f);
+            levelScale.set (newLevelScale);
+        }
+
+        OpenGLShaderProgram::Attribute atlasPositionAttribute;
+        OpenGLShaderProgram::Uniform atlasTexture, glyphColour, levelScale, atlasScale;
+
+    private:
+        PixelARGB currentColour;
+        float currentLevelScale = 1.0f;
+        bool hasColour = false;
+    };
+
     SolidColourProgram solidColourProgram;
     SolidColourMaskedProgram solidColourMasked;
     RadialGradientProgram radialGradient;
@@ -813,6 +919,7 @@ struct ShaderPrograms  : public ReferenceCountedObject
     TiledImageMaskedProgram tiledImageMasked;
     CopyTextureProgram copyTexture;
     MaskTextureProgram maskTexture;
+    GlyphAtlasProgram glyphAtlas;
 };
 
 //==============================================================================
@@ -1140,49 +1247,143 @@ struct StateHelpers
         bool gradientNeedsRefresh = true;
     };
 
+    //==============================================================================
+    // The index and vertex buffers used by the quad queues are shared by all the
+    // graphics contexts that render into the same OpenGLContext, so that the index
+    // data only gets uploaded once, and the vertex buffer is used as a ring: each
+    // batch is appended after the previous one, and the storage is only orphaned
+    // when it wraps around, so the driver never has to wait for the GPU to finish
+    // with a region before it can be overwritten.
+    struct QuadStreamBuffers  : public ReferenceCountedObject
+    {
+        QuadStreamBuffers (OpenGLContext& c) noexcept  : context (c)
+        {
+            HeapBlock<GLushort> indexData ((size_t) maxStreamQuads * 6);
+
+            for (int i = 0, v = 0; i < maxStreamQuads * 6; i += 6, v += 4)
+            {
+                indexData[i] = (GLushort) v;
+                indexData[i + 1] = indexData[i + 3] = (GLushort) (v + 1);
+                indexData[i + 2] = indexData[i + 4] = (GLushort) (v + 2);
+                indexData[i + 5] = (GLushort) (v + 3);
+            }
+
+            context.extensions.glGenBuffers (2, buffers);
+            context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers[0]);
+            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr) ((size_t) maxStreamQuads * 6 * sizeof (GLushort)),
+                                             indexData, GL_STATIC_DRAW);
+            context.extensions.glBindBuffer (GL_ARRAY_BUFFER, buffers[1]);
+            orphanVertexStorage();
+            JUCE_CHECK_OPENGL_ERROR
+        }
+
+        ~QuadStreamBuffers() noexcept
+        {
+            context.extensions.glDeleteBuffers (2, buffers);
+        }
+
+        using Ptr = ReferenceCountedObjectPtr<QuadStreamBuffers>;
+
+        static QuadStreamBuffers* get (OpenGLContext& c)
+        {
+            auto buffers = findFor (c);
+
+            if (buffers == nullptr)
+            {
+                buffers = new QuadStreamBuffers (c);
+                c.setAssociatedObject (getValueID(), buffers);
+            }
+
+            return buffers;
+        }
+
+        static QuadStreamBuffers* findFor (OpenGLContext& c)
+        {
+            return static_cast<QuadStreamBuffers*> (c.getAssociatedObject (getValueID()));
+        }
+
+        void bind() const noexcept
+        {
+            context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers[0]);
+            context.extensions.glBindBuffer (GL_ARRAY_BUFFER, buffers[1]);
+        }
+
+        // Uploads a batch of vertices and returns the index of the first one, which
+        // will always be the first vertex of a quad.
+        template <typename VertexType>
+        int append (const VertexType* vertices, int numVertices) noexcept
+        {
+            jassert (numVertices > 0 && numVertices <= maxStreamQuads * 4);
+
+            if (writePosition + numVertices > maxStreamQuads * 4)
+                orphanVertexStorage();
+
+            auto start = writePosition;
+            auto numBytes = (size_t) numVertices * sizeof (VertexType);
+
+            context.extensions.glBufferSubData (GL_ARRAY_BUFFER, (GLintptr) ((size_t) start * sizeof (VertexType)),
+                                                (GLsizeiptr) numBytes, vertices);
+            writePosition += numVertices;
+            statistics.numBytesUploaded += numBytes;
+            return start;
+        }
+
+        // All 16-bit indices must be able to address the whole ring
+        enum { maxStreamQuads = 16384, vertexSize = 8 };
+
+        OpenGLGraphicsContextStatistics statistics;
+
+    private:
+        static const char* getValueID() noexcept    { return "GraphicsContextQuadBuffers"; }
+
+        OpenGLContext& context;
+        GLuint buffers[2];
+        int writePosition = 0;
+
+        void orphanVertexStorage() noexcept
+        {
+            context.extensions.glBufferData (GL_ARRAY_BUFFER, (GLsizeiptr) ((size_t) maxStreamQuads * 4 * vertexSize),
+                                             nullptr, GL_STREAM_DRAW);
+            writePosition = 0;
+            ++statistics.numBufferOrphans;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE (QuadStreamBuffers)
+    };
+
     //==============================================================================
     struct ShaderQuadQueue
     {
-        ShaderQuadQueue (const OpenGLContext& c) noexcept  : context (c)
+        ShaderQuadQueue (OpenGLContext& c) noexcept  : context (c)
         {}
 
         ~ShaderQuadQueue() noexcept
         {
-            static_assert (sizeof (VertexInfo) == 8, "Sanity check VertexInfo size");
+            static_assert (sizeof (VertexInfo) == QuadStreamBuffers::vertexSize, "Sanity check VertexInfo size");
             context.extensions.glBindBuffer (GL_ARRAY_BUFFER, 0);
             context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, 0);
-            context.extensions.glDeleteBuffers (2, buffers);
         }
 
         void initialise() noexcept
         {
             JUCE_CHECK_OPENGL_ERROR
 
-           #if JUCE_ANDROID || JUCE_IOS
-            int numQuads = maxNumQuads;
-           #else
+           #if ! (JUCE_ANDROID || JUCE_IOS)
             GLint maxIndices = 0;
             glGetIntegerv (GL_MAX_ELEMENTS_INDICES, &maxIndices);
-            auto numQuads = jmin ((int) maxNumQuads, (int) maxIndices / 6);
-            maxVertices = numQuads * 4 - 4;
+            maxVertices = jmin ((int) maxNumQuads, (int) maxIndices / 6) * 4 - 4;
            #endif
 
-            for (int i = 0, v = 0; i < numQuads * 6; i += 6, v += 4)
-            {
-                indexData[i] = (GLushort) v;
-                indexData[i + 1] = indexData[i + 3] = (GLushort) (v + 1);
-                indexData[i + 2] = indexData[i + 4] = (GLushort) (v + 2);
-                indexData[i + 5] = (GLushort) (v + 3);
-            }
-
-            context.extensions.glGenBuffers (2, buffers);
-            context.extensions.glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, buffers[0]);
-            context.extensions.glBufferData (GL_ELEMENT_ARRAY_BUFFER, sizeof (indexData), indexData, GL_STATIC_DRAW);
-            context.extensions.glBindBuffer (GL_ARRAY_BUFFER, buffers[1]);
-            context.extensions.glBufferData (GL_ARRAY_BUFFER, sizeof (vertexData), vertexData, GL_STREAM_DRAW);
+            streamBuffers = QuadStreamBuffers::get (context);
+            streamBuffers->bind();
             JUCE_CHECK_OPENGL_ERROR
         }
 
+        void shaderChanged() noexcept
+        {
+            ++streamBuffers->statistics.numShaderChanges;
+        }
+
         void add (int x, int y, int w, int h, PixelARGB colour) noexcept
         {
             jassert (w > 0 && h > 0);
@@ -1247,6 +1448,32 @@ struct StateHelpers
             et.iterate (etr);
         }
 
+        // For shaders like the GlyphAtlasProgram, which read a pair of 16-bit texture
+        // positions where the vertices would normally have their colour
+        void addTextured (Rectangle<int> r, Point<int> texturePos) noexcept
+        {
+            jassert (! r.isEmpty());
+
+            auto* v = vertexData + numVertices;
+            v[0].x = v[2].x = (GLshort) r.getX();
+            v[0].y = v[1].y = (GLshort) r.getY();
+            v[1].x = v[3].x = (GLshort) r.getRight();
+            v[2].y = v[3].y = (GLshort) r.getBottom();
+
+            auto left = texturePos.x, right = left + r.getWidth();
+            auto top  = texturePos.y, bottom = top + r.getHeight();
+
+            v[0].colour = packTexturePosition (left,  top);
+            v[1].colour = packTexturePosition (right, top);
+            v[2].colour = packTexturePosition (left,  bottom);
+            v[3].colour = packTexturePosition (right, bottom);
+
+            numVertices += 4;
+
+            if (numVertices > maxVertices)
+                draw();
+        }
+
         void flush() noexcept
         {
             if (numVertices > 0)
@@ -1260,12 +1487,21 @@ struct StateHelpers
             GLuint colour;
         };
 
-        enum { maxNumQuads = 256 };
+        // The largest batch that gets queued before it's sent to the GPU
+        enum { maxNumQuads = 2048 };
+
+        static GLuint packTexturePosition (int x, int y) noexcept
+        {
+           #if JUCE_BIG_ENDIAN
+            return (GLuint) ((x << 16) | y);
+           #else
+            return (GLuint) ((y << 16) | x);
+           #endif
+        }
 
-        GLuint buffers[2];
         VertexInfo vertexData[maxNumQuads * 4];
-        GLushort indexData[maxNumQuads * 6];
-        const OpenGLContext& context;
+        OpenGLContext& context;
+        QuadStreamBuffers::Ptr streamBuffers;
         int numVertices = 0;
 
        #if JUCE_ANDROID || JUCE_IOS
@@ -1276,11 +1512,18 @@ struct StateHelpers
 
         void draw() noexcept
         {
-            context.extensions.glBufferSubData (GL_ARRAY_BUFFER, 0, (GLsizeiptr) ((size_t) numVertices * sizeof (VertexInfo)), vertexData);
+            auto firstVertex = streamBuffers->append (vertexData, numVertices);
+            auto firstIndex = (size_t) (firstVertex / 4) * 6;
+
             // NB: If you get a random crash in here and are running in a Parallels VM, it seems to be a bug in
             // their driver.. Can't find a workaround unfortunately.
-            glDrawElements (GL_TRIANGLES, (numVertices * 3) / 2, GL_UNSIGNED_SHORT, nullptr);
+            glDrawElements (GL_TRIANGLES, (numVertices * 3) / 2, GL_UNSIGNED_SHORT,
+                            reinterpret_cast<const void*> (firstIndex * sizeof (GLushort)));
             JUCE_CHECK_OPENGL_ERROR
+
+            auto& stats = streamBuffers->statistics;
+            ++stats.numDrawCalls;
+            stats.numQuads += numVertices / 4;
             numVertices = 0;
         }
 
@@ -1311,9 +1554,16 @@ struct StateHelpers
         {
             if (activeShader != &shader)
             {
-                clearShader (quadQueue);
+                // Switch straight from one program to the next, rather than going
+                // through glUseProgram (0) in between
+                if (activeShader != nullptr)
+                {
+                    quadQueue.flush();
+                    activeShader->unbindAttributes (context);
+                }
 
                 activeShader = &shader;
+                quadQueue.shaderChanged();
                 shader.program.use();
                 shader.bindAttributes (context);
 
@@ -1327,6 +1577,8 @@ struct StateHelpers
             }
             else if (bounds != currentBounds)
             {
+                // the quads that are already queued were positioned for the old bounds
+                quadQueue.flush();
                 currentBounds = bounds;
                 shader.set2DBounds (bounds.toFloat());
             }
@@ -1357,6 +1609,213 @@ struct StateHelpers
 
         CurrentShader& operator= (const CurrentShader&);
     };
+
+    //==============================================================================
+    // This persists in the OpenGLContext, and keeps a texture in step with the
+    // shared glyph atlas.
+    struct GlyphAtlasTexture  : public ReferenceCountedObject
+    {
+        using Ptr = ReferenceCountedObjectPtr<GlyphAtlasTexture>;
+
+        static GlyphAtlasTexture* get (OpenGLContext& c)
+        {
+            const char textureValueID[] = "GlyphAtlasTexture";
+            auto t = static_cast<GlyphAtlasTexture*> (c.getAssociatedObject (textureValueID));
+
+            if (t == nullptr)
+            {
+                t = new GlyphAtlasTexture();
+                c.setAssociatedObject (textureValueID, t);
+            }
+
+            return t;
+        }
+
+        // The atlas must be locked while this is called. Glyphs that are already queued
+        // could be using any part of the texture, so they're drawn before it changes.
+        void update (const RenderingHelpers::GlyphAtlas& atlas, ActiveTextures& activeTextures, ShaderQuadQueue& quadQueue)
+        {
+            auto image = atlas.getImage();
+
+            if (image.isNull())
+                return;
+
+            if (generation != atlas.getGeneration())
+            {
+                quadQueue.flush();
+                activeTextures.setSingleTextureMode (quadQueue);
+
+                const Image::BitmapData data (image, Image::BitmapData::readOnly);
+                jassert (data.lineStride == data.width);
+
+                texture.loadAlpha (data.data, data.width, data.height);
+                activeTextures.bindTexture (texture.getTextureID());
+            }
+            else if (revision != atlas.getRevision())
+            {
+                auto rows = atlas.getRowsChangedSince (revision);
+
+                if (! rows.isEmpty())
+                {
+                    quadQueue.flush();
+                    activeTextures.setSingleTextureMode (quadQueue);
+                    activeTextures.bindTexture (texture.getTextureID());
+
+                    const Image::BitmapData data (image, 0, rows.getStart(), image.getWidth(), rows.getLength(),
+                                                  Image::BitmapData::readOnly);
+
+                    glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+                    glTexSubImage2D (GL_TEXTURE_2D, 0, 0, rows.getStart(), data.width, data.height,
+                                     GL_ALPHA, GL_UNSIGNED_BYTE, data.data);
+                    JUCE_CHECK_OPENGL_ERROR
+                }
+            }
+
+            generation = atlas.getGeneration();
+            revision = atlas.getRevision();
+        }
+
+        GLuint getTextureID() const noexcept    { return texture.getTextureID(); }
+
+    private:
+        OpenGLTexture texture;
+        uint32 generation = 0, revision = 0;
+    };
+
+    //==============================================================================
+    // Keeps the coverage of paths whose edge tables are held by the PathCache in alpha
+    // textures, so that filling one again is just a few masked quads, rather than a
+    // quad for every span of every scanline. A mask is only made the second time a
+    // table is seen, so that paths which are only drawn once don't waste an upload.
+    struct PathMaskCache  : public ReferenceCountedObject
+    {
+        using Ptr = ReferenceCountedObjectPtr<PathMaskCache>;
+
+        static PathMaskCache* get (OpenGLContext& c)
+        {
+            const char cacheValueID[] = "PathMaskCache";
+            auto cache = static_cast<PathMaskCache*> (c.getAssociatedObject (cacheValueID));
+
+            if (cache == nullptr)
+            {
+                cache = new PathMaskCache();
+                c.setAssociatedObject (cacheValueID, cache);
+            }
+
+            return cache;
+        }
+
+        struct Mask
+        {
+            std::weak_ptr<const EdgeTable> source;
+            OpenGLTexture texture;
+            Rectangle<int> area, bounds;
+            size_t numBytes = 0;
+            uint32 lastUse = 0;
+            bool hasTexture = false;
+        };
+
+        static bool isWorthMasking (const EdgeTable& et) noexcept
+        {
+            auto b = et.getMaximumBounds();
+            return b.getWidth() * b.getHeight() >= minimumMaskArea && b.getHeight() >= 16
+                    && b.getWidth() <= maximumMaskSize && b.getHeight() <= maximumMaskSize;
+        }
+
+        // Returns the mask to use for this edge table, or nullptr if it hasn't got one (yet).
+        // The context must be active, and any quads queued for the current texture flushed.
+        const Mask* getMaskFor (const std::shared_ptr<const EdgeTable>& edgeTable)
+        {
+            auto* key = edgeTable.get();
+            auto found = masks.find (key);
+
+            // (an address can be re-used once the PathCache has thrown a table away)
+            if (found != masks.end() && found->second->source.lock() != edgeTable)
+            {
+                removeMask (found);
+                found = masks.end();
+            }
+
+            if (found == masks.end())
+            {
+                if (masks.size() >= maxNumMasks)
+                    removeExpiredAndOldest (maxNumMasks - 1);
+
+                auto* mask = new Mask();
+                mask->source = edgeTable;
+                mask->lastUse = ++useCounter;
+                masks[key].reset (mask);
+                return nullptr;
+            }
+
+            auto& mask = *found->second;
+            mask.lastUse = ++useCounter;
+
+            if (! mask.hasTexture)
+            {
+                PositionedTexture pt (mask.texture, *edgeTable, edgeTable->getMaximumBounds());
+                mask.area = pt.area;
+                mask.bounds = pt.clip;
+                mask.numBytes = (size_t) pt.area.getWidth() * (size_t) pt.area.getHeight();
+                mask.hasTexture = true;
+                totalBytes += mask.numBytes;
+
+                while (totalBytes > maxTotalBytes && masks.size() > 1)
+                    if (! removeExpiredAndOldest (masks.size() - 1))
+                        break;
+
+                if (masks.find (key) == masks.end())
+                    return nullptr;
+            }
+
+            return &mask;
+        }
+
+    private:
+        enum { minimumMaskArea = 64 * 64, maximumMaskSize = 2048, maxNumMasks = 256 };
+        static constexpr size_t maxTotalBytes = 8 * 1024 * 1024;
+
+        std::map<const EdgeTable*, std::unique_ptr<Mask>> masks;
+        size_t totalBytes = 0;
+        uint32 useCounter = 0;
+
+        template <typename Iterator>
+        void removeMask (Iterator item)
+        {
+            totalBytes -= item->second->numBytes;
+            masks.erase (item);
+        }
+
+        // Drops the masks whose tables have gone from the PathCache, then the least
+        // recently used ones until no more than the given number are left
+        bool removeExpiredAndOldest (size_t numToKeep)
+        {
+            auto numBefore = masks.size();
+
+            for (auto i = masks.begin(); i != masks.end();)
+            {
+                auto next = std::next (i);
+
+                if (i->second->source.expired())
+                    removeMask (i);
+
+                i = next;
+            }
+
+            while (masks.size() > numToKeep)
+            {
+                auto oldest = masks.begin();
+
+                for (auto i = masks.begin(); i != masks.end(); ++i)
+                    if (i->second->lastUse < oldest->second->lastUse)
+                        oldest = i;
+
+                removeMask (oldest);
+            }
+
+            return masks.size() < numBefore;
+        }
+    };
 };
 
 //==============================================================================
@@ -1552,6 +2011,33 @@ struct GLState
             maskParams->setBounds (*maskArea, target, 1);
     }
 
+    void setShaderForGlyphs (PixelARGB colour, float levelScale)
+    {
+        blendMode.setPremultipliedBlendingMode (shaderQuadQueue);
+        activeTextures.setSingleTextureMode (shaderQuadQueue);
+
+        auto& program = currentShader.programs->glyphAtlas;
+        setShader (program);
+        activeTextures.bindTexture (getGlyphAtlasTexture().getTextureID());
+        program.setColour (shaderQuadQueue, colour, levelScale);
+    }
+
+    StateHelpers::GlyphAtlasTexture& getGlyphAtlasTexture()
+    {
+        if (glyphAtlasTexture == nullptr)
+            glyphAtlasTexture = StateHelpers::GlyphAtlasTexture::get (target.context);
+
+        return *glyphAtlasTexture;
+    }
+
+    StateHelpers::PathMaskCache& getPathMaskCache()
+    {
+        if (pathMaskCache == nullptr)
+            pathMaskCache = StateHelpers::PathMaskCache::get (target.context);
+
+        return *pathMaskCache;
+    }
+
     Target target;
 
     StateHelpers::BlendingMode blendMode;
@@ -1561,6 +2047,8 @@ struct GLState
     StateHelpers::ShaderQuadQueue shaderQuadQueue;
 
     CachedImageList::Ptr cachedImageList;
+    StateHelpers::GlyphAtlasTexture::Ptr glyphAtlasTexture;
+    StateHelpers::PathMaskCache::Ptr pathMaskCache;
 
 private:
     GLuint previousFrameBufferTarget;
@@ -1620,36 +2108,65 @@ struct SavedState  : public RenderingHelpers::SavedStateBase<SavedState>
         }
     }
 
-    using GlyphCacheType = RenderingHelpers::GlyphCache<RenderingHelpers::CachedGlyphEdgeTable<SavedState>, SavedState>;
-
-    void drawGlyph (int glyphNumber, const AffineTransform& trans)
+    // Solid fills of paths that the PathCache is keeping can be drawn from a mask
+    // texture on the GPU. Anything else goes through the usual edge table spans.
+    void fillPath (const Path& path, const AffineTransform& t)
     {
-        if (clip != nullptr)
+        if (clip != nullptr && fillType.isColour() && ! isUsingCustomShader)
         {
-            if (trans.isOnlyTranslation() && ! transform.isRotated)
+            if (auto* rectangleClip = dynamic_cast<RectangleListRegionType*> (clip.get()))
             {
-                auto& cache = GlyphCacheType::getInstance();
-                Point<float> pos (trans.getTranslationX(), trans.getTranslationY());
+                auto trans = transform.getTransformWith (t);
 
-                if (transform.isOnlyTranslated)
-                {
-                    cache.drawGlyph (*this, font, glyphNumber, pos + transform.offset.toFloat());
-                }
-                else
+                if (! path.getBoundsTransformed (trans).getSmallestIntegerContainer().intersects (clip->getClipBounds()))
+                    return;
+
+                if (auto edgeTable = PathCache::getEdgeTable (path, trans))
                 {
-                    pos = transform.transformed (pos);
+                    if (StateHelpers::PathMaskCache::isWorthMasking (*edgeTable))
+                    {
+                        auto& quadQueue = state->shaderQuadQueue;
 
-                    Font f (font);
-                    f.setHeight (font.getHeight() * transform.complexTransform.mat11);
+                        // the mask's texture and uniforms are about to change underneath any queued quads
+                        quadQueue.flush();
+                        state->activeTextures.setSingleTextureMode (quadQueue);
 
-                    auto xScale = transform.complexTransform.mat00 / transform.complexTransform.mat11;
+                        if (auto* mask = state->getPathMaskCache().getMaskFor (edgeTable))
+                        {
+                            auto& program = state->currentShader.programs->solidColourMasked;
 
-                    if (std::abs (xScale - 1.0f) > 0.01f)
-                        f.setHorizontalScale (xScale);
+                            state->activeTextures.bindTexture (mask->texture.getTextureID());
+                            state->blendMode.setPremultipliedBlendingMode (quadQueue);
+                            state->setShader (program);
+                            program.maskParams.setBounds (mask->area, state->target, 0);
 
-                    cache.drawGlyph (*this, f, glyphNumber, pos);
+                            quadQueue.add (rectangleClip->clip, mask->bounds, fillType.colour.getPixelARGB());
+                            return;
+                        }
+                    }
                 }
             }
+        }
+
+        BaseClass::fillPath (path, t);
+    }
+
+    // This is the same cache that the software renderer uses
+    using GlyphCacheType = RenderingHelpers::GlyphCache<RenderingHelpers::CachedGlyphEdgeTable>;
+
+    void drawGlyph (int glyphNumber, const AffineTransform& trans)
+    {
+        if (clip != nullptr)
+        {
+            if (trans.isOnlyTranslation() && ! transform.isRotated)
+            {
+                Point<float> pos (trans.getTranslationX(), trans.getTranslationY());
+                auto f = getFontForCachedGlyph (pos);
+
+                if (auto glyph = GlyphCacheType::getInstance().findOrCreateGlyph (f, glyphNumber))
+                    if (! drawGlyphFromAtlas (*glyph, pos))
+                        glyph->draw (*this, pos);
+            }
             else
             {
                 auto fontHeight = font.getHeight();
@@ -1665,6 +2182,66 @@ struct SavedState  : public RenderingHelpers::SavedStateBase<SavedState>
         }
     }
 
+    /*  Solid-coloured glyphs inside a rectangular clip region are drawn as textured quads
+        from the shared glyph atlas, which keeps a line of text down to a few quads rather
+        than a quad for every run of pixels in its edge-tables. Returns false if the
+        glyph has to be drawn some other way.
+    */
+    bool drawGlyphFromAtlas (RenderingHelpers::CachedGlyphEdgeTable& glyph, Point<float> pos)
+    {
+        if (glyph.edgeTable == nullptr)
+            return true;
+
+        auto* rectangleClip = dynamic_cast<RectangleListRegionType*> (clip.get());
+
+        if (rectangleClip == nullptr || ! fillType.isColour() || isUsingCustomShader)
+            return false;
+
+        using Atlas = RenderingHelpers::GlyphAtlas;
+
+        auto x = glyph.snapToIntegerCoordinate ? std::floor (pos.x + 0.5f) : pos.x;
+        auto originX = (int) std::floor (x);
+        auto subpixelPosition = roundToInt ((x - (float) originX) * (float) Atlas::numSubpixelPositions);
+
+        if (subpixelPosition >= (int) Atlas::numSubpixelPositions)
+        {
+            ++originX;
+            subpixelPosition = 0;
+        }
+
+        auto& atlas = GlyphCacheType::getInstance().getAtlas();
+        Atlas::Slot slot;
+
+        {
+            const ScopedLock sl (atlas.getLock());
+
+            if (! atlas.prepare (glyph.atlasSlots[subpixelPosition], *glyph.edgeTable, subpixelPosition))
+                return false;
+
+            slot = glyph.atlasSlots[subpixelPosition];
+            state->getGlyphAtlasTexture().update (atlas, state->activeTextures, state->shaderQuadQueue);
+        }
+
+        auto area = slot.area.withPosition (slot.origin + Point<int> (originX, roundToInt (pos.y)));
+
+        if (area.isEmpty() || ! rectangleClip->clip.intersectsRectangle (area))
+            return true;
+
+        // this matches the adjustment that fillEdgeTable() makes for light-coloured text
+        auto brightness = fillType.colour.getBrightness() - 0.5f;
+        state->setShaderForGlyphs (fillType.colour.getPixelARGB(), brightness > 0.0f ? 1.0f + 1.6f * brightness : 1.0f);
+
+        for (auto& r : rectangleClip->clip)
+        {
+            auto clipped = r.getIntersection (area);
+
+            if (! clipped.isEmpty())
+                state->shaderQuadQueue.addTextured (clipped, slot.area.getPosition() + (clipped.getPosition() - area.getPosition()));
+        }
+
+        return true;
+    }
+
     Rectangle<int> getMaximumBounds() const     { return state->target.bounds; }
 
     void setFillType (const FillType& newFill)
@@ -1799,15 +2376,8 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NonShaderContext)
 };
 
-static void clearOpenGLGlyphCacheCallback()
-{
-    SavedState::GlyphCacheType::getInstance().reset();
-}
-
 static LowLevelGraphicsContext* createOpenGLContext (const Target& target)
 {
-    clearOpenGLGlyphCache = clearOpenGLGlyphCacheCallback;
-
     if (target.context.areShadersAvailable())
         return new ShaderContext (target);
 
@@ -1833,6 +2403,16 @@ LowLevelGraphicsContext* createOpenGLGraphicsContext (OpenGLContext& context, un
     return OpenGLRendering::createOpenGLContext (OpenGLRendering::Target (context, frameBufferID, width, height));
 }
 
+OpenGLGraphicsContextStatistics getOpenGLGraphicsContextStatistics (OpenGLContext& context)
+{
+    OpenGLGraphicsContextStatistics stats;
+
+    if (auto* buffers = OpenGLRendering::StateHelpers::QuadStreamBuffers::findFor (context))
+        std::swap (stats, buffers->statistics);
+
+    return stats;
+}
+
 //==============================================================================
 struct CustomProgram  : public ReferenceCountedObject,
                         public OpenGLRendering::ShaderPrograms::ShaderBase
@@ -45,6 +45,34 @@ LowLevelGraphicsContext* createOpenGLGraphicsContext (OpenGLContext&,
                                                       unsigned int frameBufferID,
                                                       int width, int height);
 
+//==============================================================================
+/**
+    Counts the work that the OpenGL graphics contexts created for an OpenGLContext
+    have sent to the GPU.
+
+    @see getOpenGLGraphicsContextStatistics
+
+    @tags{OpenGL}
+*/
+struct JUCE_API  OpenGLGraphicsContextStatistics
+{
+    int numDrawCalls = 0;           /**< The number of glDrawElements calls that were made. */
+    int numQuads = 0;               /**< The total number of quads that those calls rendered. */
+    int numShaderChanges = 0;       /**< The number of times a different shader program was selected. */
+    int numBufferOrphans = 0;       /**< The number of times the vertex stream had to be re-allocated. */
+    size_t numBytesUploaded = 0;    /**< The amount of vertex data that was streamed to the GPU. */
+};
+
+/** Returns the statistics gathered by all the graphics contexts that have finished
+    rendering into the given OpenGLContext since this function was last called, and
+    resets them.
+
+    Calling this once per frame, e.g. from OpenGLRenderer::renderOpenGL(), gives you
+    per-frame figures. Like OpenGLContext::getAssociatedObject(), this must only be
+    called from an OpenGL rendering callback.
+*/
+OpenGLGraphicsContextStatistics getOpenGLGraphicsContextStatistics (OpenGLContext&);
+
 
 //==============================================================================
 /**
@@ -37,7 +37,7 @@ static int getAllowedTextureSize (int x)
 }
 
 OpenGLTexture::OpenGLTexture()
-    : textureID (0), width (0), height (0), ownerContext (nullptr)
+    : textureID (0), pixelBufferID (0), width (0), height (0), ownerContext (nullptr)
 {
 }
 
@@ -91,8 +91,7 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
         glTexImage2D (GL_TEXTURE_2D, 0, internalformat,
                       width, height, 0, type, GL_UNSIGNED_BYTE, nullptr);
 
-        glTexSubImage2D (GL_TEXTURE_2D, 0, 0, topLeft ? (height - h) : 0, w, h,
-                         type, GL_UNSIGNED_BYTE, pixels);
+        upload (0, topLeft ? (height - h) : 0, w, h, pixels, type);
     }
     else
     {
@@ -103,6 +102,48 @@ void OpenGLTexture::create (const int w, const int h, const void* pixels, GLenum
     JUCE_CHECK_OPENGL_ERROR
 }
 
+#if ! JUCE_OPENGL_ES
+static bool canUsePixelBufferObjects()
+{
+    // pixel buffer objects became part of the core API in GL 2.1
+    auto version = String::fromUTF8 ((const char*) glGetString (GL_VERSION));
+    auto major = version.getIntValue();
+    auto minor = version.fromFirstOccurrenceOf (".", false, false).getIntValue();
+
+    return major > 2 || (major == 2 && minor >= 1);
+}
+#endif
+
+// Expects the texture to be bound already
+void OpenGLTexture::upload (int x, int y, int w, int h, const void* pixels, GLenum type)
+{
+   #if ! JUCE_OPENGL_ES
+    auto numBytes = (size_t) w * (size_t) h * (type == GL_ALPHA ? 1u : 4u);
+
+    // Small uploads aren't worth the extra buffer
+    if (numBytes >= 64 * 1024 && canUsePixelBufferObjects())
+    {
+        auto& ext = ownerContext->extensions;
+
+        if (pixelBufferID == 0)
+            ext.glGenBuffers (1, &pixelBufferID);
+
+        // Re-specifying the buffer's storage each time means that the driver never has to wait
+        // for a previous transfer to finish, and returning from glTexSubImage2D doesn't have to
+        // wait for this one
+        ext.glBindBuffer (GL_PIXEL_UNPACK_BUFFER, pixelBufferID);
+        ext.glBufferData (GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr) numBytes, pixels, GL_STREAM_DRAW);
+        glTexSubImage2D (GL_TEXTURE_2D, 0, x, y, w, h, type, GL_UNSIGNED_BYTE, nullptr);
+        ext.glBindBuffer (GL_PIXEL_UNPACK_BUFFER, 0);
+        JUCE_CHECK_OPENGL_ERROR
+        return;
+    }
+   #endif
+
+    glTexSubImage2D (GL_TEXTURE_2D, 0, x, y, w, h, type, GL_UNSIGNED_BYTE, pixels);
+    JUCE_CHECK_OPENGL_ERROR
+}
+
 template <class PixelType>
 struct Flipper
 {
@@ -143,6 +184,38 @@ void OpenGLTexture::loadImage (const Image& image)
     create (imageW, imageH, dataCopy, JUCE_RGBA_FORMAT, true);
 }
 
+void OpenGLTexture::loadImageSubsection (const Image& image, Rectangle<int> area)
+{
+    area = area.getIntersection (image.getBounds());
+
+    // The texture must already have been created from an image of this size
+    jassert (textureID != 0 && image.getWidth() <= width && image.getHeight() <= height);
+    jassert (ownerContext == OpenGLContext::getCurrentContext());
+
+    if (area.isEmpty() || textureID == 0)
+        return;
+
+    const int w = area.getWidth();
+    const int h = area.getHeight();
+
+    HeapBlock<PixelARGB> dataCopy;
+    Image::BitmapData srcData (image, area.getX(), area.getY(), w, h);
+
+    switch (srcData.pixelFormat)
+    {
+        case Image::ARGB:           Flipper<PixelARGB> ::flip (dataCopy, srcData.data, srcData.lineStride, w, h); break;
+        case Image::RGB:            Flipper<PixelRGB>  ::flip (dataCopy, srcData.data, srcData.lineStride, w, h); break;
+        case Image::SingleChannel:  Flipper<PixelAlpha>::flip (dataCopy, srcData.data, srcData.lineStride, w, h); break;
+        default: break;
+    }
+
+    glBindTexture (GL_TEXTURE_2D, textureID);
+    glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+
+    // loadImage() places the image's top row at the top of the texture, flipped vertically
+    upload (area.getX(), height - area.getBottom(), w, h, dataCopy, JUCE_RGBA_FORMAT);
+}
+
 void OpenGLTexture::loadARGB (const PixelARGB* pixels, const int w, const int h)
 {
     create (w, h, pixels, JUCE_RGBA_FORMAT, false);
@@ -174,6 +247,11 @@ void OpenGLTexture::release()
         {
             glDeleteTextures (1, &textureID);
 
+            if (pixelBufferID != 0)
+                ownerContext->extensions.glDeleteBuffers (1, &pixelBufferID);
+
+            pixelBufferID = 0;
+
             textureID = 0;
             width = 0;
             height = 0;
@@ -49,6 +49,18 @@ public:
     */
     void loadImage (const Image& image);
 
+    /** Re-uploads part of a texture that was created by loadImage().
+
+        The image must have the same size as the one that the texture was created
+        from. Only the pixels inside the given area (in image coordinates) get sent
+        to the GPU, which is much quicker than reloading the whole image when only
+        a small part of it has changed.
+
+        Large updates are staged through a pixel buffer object where the GL version
+        supports it, so that the transfer into the texture can happen asynchronously.
+    */
+    void loadImageSubsection (const Image& image, Rectangle<int> area);
+
     /** Creates a texture from a raw array of pixels.
         If width and height are not powers-of-two, the texture will be created with a
         larger size, and only the subsection (0, 0, width, height) will be initialised.
@@ -93,11 +105,12 @@ public:
     static bool isValidSize (int width, int height);
 
 private:
-    GLuint textureID;
+    GLuint textureID, pixelBufferID;
     int width, height;
     OpenGLContext* ownerContext;
 
     void create (int w, int h, const void*, GLenum, bool topLeft);
+    void upload (int x, int y, int w, int h, const void*, GLenum);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OpenGLTexture)
 };
@@ -310,8 +310,434 @@ namespace
         }
     };
 
+    //==============================================================================
+    /** Helpers for checking and stepping through raw OSC data in place, used by
+        OSCReceiver::MessageView. Each of the skip functions returns a pointer to the
+        data following the item, or nullptr if the item is malformed.
+    */
+    struct OSCRawData
+    {
+        static const char* skipPaddedString (const char* s, const char* end) noexcept
+        {
+            if (s >= end)
+                return nullptr;
+
+            auto* terminator = static_cast<const char*> (std::memchr (s, 0, (size_t) (end - s)));
+
+            if (terminator == nullptr)
+                return nullptr;
+
+            auto* next = s + (((size_t) (terminator - s) + 4) & ~(size_t) 3);
+
+            if (next > end)
+                return nullptr;
+
+            for (auto* p = terminator; p < next; ++p)
+                if (*p != 0)
+                    return nullptr;
+
+            return next;
+        }
+
+        static const char* skipArgument (OSCType type, const char* arg, const char* end) noexcept
+        {
+            if (type == OSCTypes::string)
+                return skipPaddedString (arg, end);
+
+            if (end - arg < 4)
+                return nullptr;
+
+            if (type != OSCTypes::blob)
+                return arg + 4;
+
+            auto blobSize = (size_t) ByteOrder::bigEndianInt (arg);
+
+            if (blobSize > (size_t) std::numeric_limits<int32>::max()
+                 || blobSize + 4 > (size_t) (end - arg))
+                return nullptr;
+
+            auto* next = arg + 4 + ((blobSize + 3) & ~(size_t) 3);
+
+            if (next > end)
+                return nullptr;
+
+            for (auto* p = arg + 4 + blobSize; p < next; ++p)
+                if (*p != 0)
+                    return nullptr;
+
+            return next;
+        }
+
+        // The argument data has already been validated, so this doesn't need any checks.
+        static size_t getArgumentSize (OSCType type, const char* arg) noexcept
+        {
+            if (type == OSCTypes::string)
+                return (std::strlen (arg) + 4) & ~(size_t) 3;
+
+            if (type == OSCTypes::blob)
+                return 4 + (((size_t) ByteOrder::bigEndianInt (arg) + 3) & ~(size_t) 3);
+
+            return 4;
+        }
+
+        static bool isValidAddressPattern (const char* pattern) noexcept
+        {
+            if (*pattern != '/')
+                return false;
+
+            for (auto* p = pattern; *p != 0; ++p)
+                if (*p <= ' ' || *p > '~' || *p == '#')
+                    return false;
+
+            return true;
+        }
+
+        //==============================================================================
+        /** Calls the visitor with a MessageView for each message inside an OSC element,
+            recursing into any bundles. Returns false if the element is malformed, in which
+            case some of its messages may already have been visited.
+        */
+        template <typename Visitor>
+        static bool visitElement (const char* data, size_t size, Visitor&& visitor)
+        {
+            if (size < 4)
+                return false;
+
+            if (data[0] == '/')
+            {
+                OSCReceiver::MessageView message (data, size);
+
+                if (! message.isValid())
+                    return false;
+
+                visitor (message);
+                return true;
+            }
+
+            if (data[0] != '#' || size < 16 || std::memcmp (data, "#bundle", 8) != 0)
+                return false;
+
+            for (size_t pos = 16; pos < size;)  // skip "#bundle" and the time tag
+            {
+                if (size - pos < 4)
+                    return false;
+
+                auto elementSize = (size_t) ByteOrder::bigEndianInt (data + pos);
+                pos += 4;
+
+                if (elementSize < 4 || elementSize > size - pos
+                     || ! visitElement (data + pos, elementSize, visitor))
+                    return false;
+
+                pos += elementSize;
+            }
+
+            return true;
+        }
+    };
+
 } // namespace
 
+//==============================================================================
+/** Maps OSC addresses to the listeners that were registered with them.
+
+    Each level of the trie holds one address component, with the children kept
+    sorted, so a message with a literal address pattern is dispatched by walking
+    its components rather than by matching against every registered address.
+    Patterns containing wildcards are matched against the children of each level
+    in turn.
+*/
+template <typename ListenerType>
+class OSCAddressTrie
+{
+public:
+    void add (const OSCAddress& address, ListenerType* listener)
+    {
+        StringArray components;
+        components.addTokens (address.toString(), "/", StringRef());
+        components.removeEmptyStrings (false);
+
+        auto* node = &root;
+
+        for (auto& component : components)
+            node = &node->getOrCreateChild (component);
+
+        if (node->listeners.addIfNotAlreadyThere (listener))
+            ++numEntries;
+    }
+
+    void remove (ListenerType* listener)
+    {
+        numEntries -= root.removeListener (listener);
+    }
+
+    bool isEmpty() const noexcept   { return numEntries == 0; }
+
+    /** Calls the callback for each listener whose address matches the given
+        null-terminated address pattern.
+    */
+    template <typename Callback>
+    void forEachMatch (const char* pattern, bool patternContainsWildcards, Callback&& callback) const
+    {
+        if (numEntries > 0)
+            visit (root, pattern, patternContainsWildcards, callback);
+    }
+
+private:
+    struct Node
+    {
+        Node() = default;
+        Node (const String& n)  : name (n), nameLength (n.getNumBytesAsUTF8()) {}
+
+        int compareName (const char* s, size_t length) const noexcept
+        {
+            auto result = std::memcmp (name.toRawUTF8(), s, jmin (length, nameLength));
+
+            if (result != 0)
+                return result;
+
+            return nameLength < length ? -1 : (nameLength > length ? 1 : 0);
+        }
+
+        int findInsertIndex (const char* s, size_t length) const noexcept
+        {
+            int start = 0, end = children.size();
+
+            while (start < end)
+            {
+                auto mid = (start + end) / 2;
+
+                if (children.getUnchecked (mid)->compareName (s, length) < 0)
+                    start = mid + 1;
+                else
+                    end = mid;
+            }
+
+            return start;
+        }
+
+        const Node* findChild (const char* s, size_t length) const noexcept
+        {
+            auto index = findInsertIndex (s, length);
+
+            if (auto* child = children[index])
+                if (child->compareName (s, length) == 0)
+                    return child;
+
+            return nullptr;
+        }
+
+        Node& getOrCreateChild (const String& childName)
+        {
+            auto* s = childName.toRawUTF8();
+            auto length = childName.getNumBytesAsUTF8();
+            auto index = findInsertIndex (s, length);
+
+            if (auto* child = children[index])
+                if (child->compareName (s, length) == 0)
+                    return *child;
+
+            return *children.insert (index, new Node (childName));
+        }
+
+        int removeListener (ListenerType* listener)
+        {
+            auto numRemoved = listeners.removeAllInstancesOf (listener);
+
+            for (int i = children.size(); --i >= 0;)
+            {
+                auto* child = children.getUnchecked (i);
+                numRemoved += child->removeListener (listener);
+
+                if (child->listeners.isEmpty() && child->children.isEmpty())
+                    children.remove (i);
+            }
+
+            return numRemoved;
+        }
+
+        String name;
+        size_t nameLength = 0;
+        Array<ListenerType*> listeners;
+        OwnedArray<Node> children;
+    };
+
+    template <typename Callback>
+    static void visit (const Node& node, const char* pattern, bool patternContainsWildcards, Callback& callback)
+    {
+        while (*pattern == '/')
+            ++pattern;
+
+        if (*pattern == 0)
+        {
+            for (auto* listener : node.listeners)
+                callback (*listener);
+
+            return;
+        }
+
+        auto* componentEnd = pattern;
+
+        while (*componentEnd != 0 && *componentEnd != '/')
+            ++componentEnd;
+
+        if (! patternContainsWildcards)
+        {
+            if (auto* child = node.findChild (pattern, (size_t) (componentEnd - pattern)))
+                visit (*child, componentEnd, false, callback);
+
+            return;
+        }
+
+        for (auto* child : node.children)
+        {
+            auto childName = child->name.getCharPointer();
+
+            if (OSCPatternMatcherImpl<CharPointer_UTF8>::match (CharPointer_UTF8 (pattern), CharPointer_UTF8 (componentEnd),
+                                                                childName, childName + (int) child->nameLength))
+                visit (*child, componentEnd, true, callback);
+        }
+    }
+
+    Node root;
+    int numEntries = 0;
+};
+
+//==============================================================================
+OSCReceiver::MessageView::MessageView (const void* messageData, size_t messageSize) noexcept
+{
+    auto* start = static_cast<const char*> (messageData);
+    auto* end = start + messageSize;
+
+    auto* tags = OSCRawData::skipPaddedString (start, end);
+
+    if (tags == nullptr || tags == end || *tags != ',' || ! OSCRawData::isValidAddressPattern (start))
+        return;
+
+    auto* argumentData = OSCRawData::skipPaddedString (tags, end);
+
+    if (argumentData == nullptr)
+        return;
+
+    auto* next = argumentData;
+    int numArgs = 0;
+
+    for (auto* t = tags + 1; *t != 0; ++t, ++numArgs)
+    {
+        if (! OSCTypes::isSupportedType (*t))
+            return;
+
+        next = OSCRawData::skipArgument (*t, next, end);
+
+        if (next == nullptr)
+            return;
+    }
+
+    if (next != end)
+        return;
+
+    addressPattern = static_cast<const char*> (messageData);
+    typeTags = tags + 1;
+    arguments = argumentData;
+    numArguments = numArgs;
+    hasWildcards = std::strpbrk (addressPattern, "*?{}[]") != nullptr;
+}
+
+const char* OSCReceiver::MessageView::getArgument (int index, OSCType expectedType) const noexcept
+{
+    if (! isPositiveAndBelow (index, numArguments) || typeTags[index] != expectedType)
+    {
+        // this argument doesn't exist, or has a different type!
+        jassertfalse;
+        return nullptr;
+    }
+
+    auto* arg = arguments;
+
+    for (int i = 0; i < index; ++i)
+        arg += OSCRawData::getArgumentSize (typeTags[i], arg);
+
+    return arg;
+}
+
+OSCType OSCReceiver::MessageView::getType (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numArguments));
+    return isPositiveAndBelow (index, numArguments) ? typeTags[index] : 0;
+}
+
+int32 OSCReceiver::MessageView::getInt32 (int index) const noexcept
+{
+    if (auto* arg = getArgument (index, OSCTypes::int32))
+        return (int32) ByteOrder::bigEndianInt (arg);
+
+    return 0;
+}
+
+float OSCReceiver::MessageView::getFloat32 (int index) const noexcept
+{
+    if (auto* arg = getArgument (index, OSCTypes::float32))
+    {
+        union { uint32 asInt; float asFloat; } n;
+        n.asInt = ByteOrder::bigEndianInt (arg);
+        return n.asFloat;
+    }
+
+    return 0.0f;
+}
+
+const char* OSCReceiver::MessageView::getString (int index) const noexcept
+{
+    return getArgument (index, OSCTypes::string);
+}
+
+const void* OSCReceiver::MessageView::getBlobData (int index) const noexcept
+{
+    if (auto* arg = getArgument (index, OSCTypes::blob))
+        return arg + 4;
+
+    return nullptr;
+}
+
+size_t OSCReceiver::MessageView::getBlobSize (int index) const noexcept
+{
+    if (auto* arg = getArgument (index, OSCTypes::blob))
+        return (size_t) ByteOrder::bigEndianInt (arg);
+
+    return 0;
+}
+
+OSCColour OSCReceiver::MessageView::getColour (int index) const noexcept
+{
+    if (auto* arg = getArgument (index, OSCTypes::colour))
+        return OSCColour::fromInt32 (ByteOrder::bigEndianInt (arg));
+
+    return {};
+}
+
+OSCMessage OSCReceiver::MessageView::toMessage() const
+{
+    jassert (isValid());
+
+    OSCAddressPattern pattern (addressPattern);
+    OSCMessage message (pattern);
+
+    for (int i = 0; i < numArguments; ++i)
+    {
+        switch (typeTags[i])
+        {
+            case OSCTypes::int32:       message.addInt32 (getInt32 (i)); break;
+            case OSCTypes::float32:     message.addFloat32 (getFloat32 (i)); break;
+            case OSCTypes::string:      message.addString (String::fromUTF8 (getString (i))); break;
+            case OSCTypes::blob:        message.addBlob (MemoryBlock (getBlobData (i), getBlobSize (i))); break;
+            case OSCTypes::colour:      message.addColour (getColour (i)); break;
+            default:                    jassertfalse; break;
+        }
+    }
+
+    return message;
+}
+
 
 //==============================================================================
 struct OSCReceiver::Pimpl   : private Thread,
@@ -381,12 +807,22 @@ struct OSCReceiver::Pimpl   : private Thread,
     void addListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToAdd,
                       OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, listenersWithAddress);
+        listenersWithAddress.add (addressToMatch, listenerToAdd);
     }
 
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd, OSCAddress addressToMatch)
     {
-        addListenerWithAddress (listenerToAdd, addressToMatch, realtimeListenersWithAddress);
+        realtimeListenersWithAddress.add (addressToMatch, listenerToAdd);
+    }
+
+    void addListener (MessageViewListener* listenerToAdd)
+    {
+        viewListeners.add (listenerToAdd);
+    }
+
+    void addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch)
+    {
+        viewListenersWithAddress.add (addressToMatch, listenerToAdd);
     }
 
     void removeListener (OSCReceiver::Listener<MessageLoopCallback>* listenerToRemove)
@@ -401,12 +837,18 @@ struct OSCReceiver::Pimpl   : private Thread,
 
     void removeListener (ListenerWithOSCAddress<MessageLoopCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, listenersWithAddress);
+        listenersWithAddress.remove (listenerToRemove);
     }
 
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove)
     {
-        removeListenerWithAddress (listenerToRemove, realtimeListenersWithAddress);
+        realtimeListenersWithAddress.remove (listenerToRemove);
+    }
+
+    void removeListener (MessageViewListener* listenerToRemove)
+    {
+        viewListeners.remove (listenerToRemove);
+        viewListenersWithAddress.remove (listenerToRemove);
     }
 
     //==============================================================================
@@ -421,6 +863,26 @@ struct OSCReceiver::Pimpl   : private Thread,
     //==============================================================================
     void handleBuffer (const char* data, size_t dataSize)
     {
+        if (viewListeners.size() > 0 || ! viewListenersWithAddress.isEmpty())
+        {
+            // the packet is checked in full before anyone sees any of its messages,
+            // the same as when it's parsed into OSCMessage and OSCBundle objects
+            if (! OSCRawData::visitElement (data, dataSize, [] (const MessageView&) {}))
+            {
+                if (formatErrorHandler != nullptr)
+                    formatErrorHandler (data, (int) dataSize);
+
+                return;
+            }
+
+            OSCRawData::visitElement (data, dataSize, [this] (const MessageView& message) { callViewListeners (message); });
+
+            // if nobody needs the allocated objects, there's no need to build them
+            if (listeners.size() == 0 && realtimeListeners.size() == 0
+                 && listenersWithAddress.isEmpty() && realtimeListenersWithAddress.isEmpty())
+                return;
+        }
+
         OSCInputStream inStream (data, dataSize);
 
         try
@@ -436,7 +898,7 @@ struct OSCReceiver::Pimpl   : private Thread,
 
             // now post the message that will trigger the handleMessage callback
             // dealing with the non-realtime listeners.
-            if (listeners.size() > 0 || listenersWithAddress.size() > 0)
+            if (listeners.size() > 0 || ! listenersWithAddress.isEmpty())
                 postMessage (new CallbackMessage (content));
         }
         catch (const OSCFormatError&)
@@ -456,8 +918,16 @@ private:
     //==============================================================================
     void run() override
     {
-        int bufferSize = 65535;
-        HeapBlock<char> oscBuffer (bufferSize);
+        // when the traffic is heavy, fetching several packets per call saves a lot of syscalls
+        enum { bufferSize = 65535, numPackets = 8 };
+        HeapBlock<char> oscBuffer (bufferSize * numPackets);
+        DatagramSocket::Packet packets[numPackets];
+
+        for (int i = 0; i < numPackets; ++i)
+        {
+            packets[i].data = oscBuffer + i * bufferSize;
+            packets[i].size = bufferSize;
+        }
 
         while (! threadShouldExit())
         {
@@ -470,42 +940,11 @@ private:
             if (ready == 0)
                 continue;
 
-            auto bytesRead = (size_t) socket->read (oscBuffer.getData(), bufferSize, false);
-
-            if (bytesRead >= 4)
-                handleBuffer (oscBuffer.getData(), bytesRead);
-        }
-    }
-
-    //==============================================================================
-    template <typename ListenerType>
-    void addListenerWithAddress (ListenerType* listenerToAdd,
-                                 OSCAddress address,
-                                 Array<std::pair<OSCAddress, ListenerType*>>& array)
-    {
-        for (auto& i : array)
-            if (address == i.first && listenerToAdd == i.second)
-                return;
-
-        array.add (std::make_pair (address, listenerToAdd));
-    }
+            auto numRead = socket->readMultiple (packets, numPackets, false);
 
-    //==============================================================================
-    template <typename ListenerType>
-    void removeListenerWithAddress (ListenerType* listenerToRemove,
-                                    Array<std::pair<OSCAddress, ListenerType*>>& array)
-    {
-        for (int i = 0; i < array.size(); ++i)
-        {
-            if (listenerToRemove == array.getReference (i).second)
-            {
-                // aarrgh... can't simply call array.remove (i) because this
-                // requires a default c'tor to be present for OSCAddress...
-                // luckily, we don't care about methods preserving element order:
-                array.swap (i, array.size() - 1);
-                array.removeLast();
-                break;
-            }
+            for (int i = 0; i < numRead; ++i)
+                if (packets[i].numBytes >= 4)
+                    handleBuffer (static_cast<const char*> (packets[i].data), (size_t) packets[i].numBytes);
         }
     }
 
@@ -559,26 +998,36 @@ private:
     //==============================================================================
     void callListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : listenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        auto pattern = message.getAddressPattern();
+
+        listenersWithAddress.forEachMatch (pattern.toString().toRawUTF8(), pattern.containsWildcards(),
+                                           [&] (ListenerWithOSCAddress<MessageLoopCallback>& l) { l.oscMessageReceived (message); });
     }
 
     void callRealtimeListenersWithAddress (const OSCMessage& message)
     {
-        for (auto& entry : realtimeListenersWithAddress)
-            if (auto* listener = entry.second)
-                if (message.getAddressPattern().matches (entry.first))
-                    listener->oscMessageReceived (message);
+        auto pattern = message.getAddressPattern();
+
+        realtimeListenersWithAddress.forEachMatch (pattern.toString().toRawUTF8(), pattern.containsWildcards(),
+                                                   [&] (ListenerWithOSCAddress<RealtimeCallback>& l) { l.oscMessageReceived (message); });
+    }
+
+    void callViewListeners (const MessageView& message)
+    {
+        viewListeners.call ([&] (MessageViewListener& l) { l.oscMessageReceived (message); });
+
+        viewListenersWithAddress.forEachMatch (message.getAddressPattern(), message.containsWildcards(),
+                                               [&] (MessageViewListener& l) { l.oscMessageReceived (message); });
     }
 
     //==============================================================================
     ListenerList<OSCReceiver::Listener<OSCReceiver::MessageLoopCallback>> listeners;
     ListenerList<OSCReceiver::Listener<OSCReceiver::RealtimeCallback>>    realtimeListeners;
+    ListenerList<OSCReceiver::MessageViewListener>                          viewListeners;
 
-    Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>*>> listenersWithAddress;
-    Array<std::pair<OSCAddress, OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>*>>    realtimeListenersWithAddress;
+    OSCAddressTrie<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::MessageLoopCallback>> listenersWithAddress;
+    OSCAddressTrie<OSCReceiver::ListenerWithOSCAddress<OSCReceiver::RealtimeCallback>>    realtimeListenersWithAddress;
+    OSCAddressTrie<OSCReceiver::MessageViewListener>                                      viewListenersWithAddress;
 
     OptionalScopedPointer<DatagramSocket> socket;
     OSCReceiver::FormatErrorHandler formatErrorHandler { nullptr };
@@ -635,6 +1084,16 @@ void OSCReceiver::addListener (ListenerWithOSCAddress<RealtimeCallback>* listene
     pimpl->addListener (listenerToAdd, addressToMatch);
 }
 
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd)
+{
+    pimpl->addListener (listenerToAdd);
+}
+
+void OSCReceiver::addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch)
+{
+    pimpl->addListener (listenerToAdd, addressToMatch);
+}
+
 void OSCReceiver::removeListener (Listener<MessageLoopCallback>* listenerToRemove)
 {
     pimpl->removeListener (listenerToRemove);
@@ -655,6 +1114,11 @@ void OSCReceiver::removeListener (ListenerWithOSCAddress<RealtimeCallback>* list
     pimpl->removeListener (listenerToRemove);
 }
 
+void OSCReceiver::removeListener (MessageViewListener* listenerToRemove)
+{
+    pimpl->removeListener (listenerToRemove);
+}
+
 void OSCReceiver::registerFormatErrorHandler (FormatErrorHandler handler)
 {
     pimpl->registerFormatErrorHandler (handler);
@@ -1188,6 +1652,140 @@ public:
 
 static OSCInputStreamTests OSCInputStreamUnitTests;
 
+//==============================================================================
+class OSCMessageViewTests  : public UnitTest
+{
+public:
+    OSCMessageViewTests() : UnitTest ("OSCReceiver::MessageView class", "OSC") {}
+
+    void runTest()
+    {
+        beginTest ("reading OSC messages in place");
+        {
+            uint8 data[] = {
+                '/', 't', 'e', 's', 't', '\0', '\0', '\0',
+                ',', 'i', 'f', 's', 'b', '\0', '\0', '\0',
+                0xFF, 0xFF, 0xF8, 0x21,
+                0x43, 0xAC, 0xCE, 0x66,
+                'H', 'e', 'l', 'l', 'o', ',', ' ', 'W', 'o', 'r', 'l', 'd', '!', '\0', '\0', '\0',
+                0x00, 0x00, 0x00, 0x05, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x00, 0x00, 0x00
+            };
+
+            OSCReceiver::MessageView view (data, sizeof (data));
+
+            expect (view.isValid());
+            expect (! view.containsWildcards());
+            expectEquals (String (view.getAddressPattern()), String ("/test"));
+            expectEquals (view.size(), 4);
+
+            expectEquals (view.getType (3), OSCTypes::blob);
+            expectEquals (view.getInt32 (0), (int32) -2015);
+            expectEquals (view.getFloat32 (1), 345.6125f);
+            expectEquals (String (view.getString (2)), String ("Hello, World!"));
+            expectEquals ((int) view.getBlobSize (3), 5);
+            expect (view.getBlobData (3) == data + 44);
+
+            auto message = view.toMessage();
+            OSCInputStream inStream (data, sizeof (data));
+            auto parsed = inStream.readMessage();
+
+            expectEquals (message.getAddressPattern().toString(), parsed.getAddressPattern().toString());
+            expectEquals (message.size(), parsed.size());
+            expectEquals (message[2].getString(), parsed[2].getString());
+            expect (message[3].getBlob() == parsed[3].getBlob());
+        }
+
+        beginTest ("rejecting corrupted OSC messages");
+        {
+            const uint8 noTypeTags[]    = { '/', 't', 'e', 's', 't', '\0', '\0', '\0' };
+            const uint8 badPadding[]    = { '/', 't', 'e', 's', 't', '\0', '\0', 'x', ',', '\0', '\0', '\0' };
+            const uint8 badType[]       = { '/', 't', 'e', 's', 't', '\0', '\0', '\0', ',', 'x', '\0', '\0', 0, 0, 0, 0 };
+            const uint8 truncated[]     = { '/', 't', 'e', 's', 't', '\0', '\0', '\0', ',', 'i', 'f', '\0', 0, 0, 0, 1 };
+            const uint8 trailingData[]  = { '/', 't', 'e', 's', 't', '\0', '\0', '\0', ',', '\0', '\0', '\0', 0, 0, 0, 0 };
+            const uint8 blobTooLarge[]  = { '/', 't', '\0', '\0', ',', 'b', '\0', '\0', 0x7F, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0 };
+            const uint8 badAddress[]    = { '/', 't', ' ', 't', '\0', '\0', '\0', '\0', ',', '\0', '\0', '\0' };
+
+            expect (! OSCReceiver::MessageView (noTypeTags, sizeof (noTypeTags)).isValid());
+            expect (! OSCReceiver::MessageView (badPadding, sizeof (badPadding)).isValid());
+            expect (! OSCReceiver::MessageView (badType, sizeof (badType)).isValid());
+            expect (! OSCReceiver::MessageView (truncated, sizeof (truncated)).isValid());
+            expect (! OSCReceiver::MessageView (trailingData, sizeof (trailingData)).isValid());
+            expect (! OSCReceiver::MessageView (blobTooLarge, sizeof (blobTooLarge)).isValid());
+            expect (! OSCReceiver::MessageView (badAddress, sizeof (badAddress)).isValid());
+            expect (! OSCReceiver::MessageView (nullptr, 0).isValid());
+        }
+
+        beginTest ("visiting the messages in nested bundles");
+        {
+            uint8 data[] = {
+                '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0',
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+                0x00, 0x00, 0x00, 0x0C,
+                '/', 'a', '\0', '\0', ',', 'i', '\0', '\0', 0x00, 0x00, 0x00, 0x01,
+                0x00, 0x00, 0x00, 0x20,
+                '#', 'b', 'u', 'n', 'd', 'l', 'e', '\0',
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+                0x00, 0x00, 0x00, 0x0C,
+                '/', 'b', '\0', '\0', ',', 'i', '\0', '\0', 0x00, 0x00, 0x00, 0x02
+            };
+
+            String addresses;
+            int total = 0;
+
+            expect (OSCRawData::visitElement ((const char*) data, sizeof (data), [&] (const OSCReceiver::MessageView& m)
+            {
+                addresses << m.getAddressPattern();
+                total += m.getInt32 (0);
+            }));
+
+            expectEquals (addresses, String ("/a/b"));
+            expectEquals (total, 3);
+
+            data[35] = 0x24; // the inner bundle's size no longer fits in the outer one
+            expect (! OSCRawData::visitElement ((const char*) data, sizeof (data), [] (const OSCReceiver::MessageView&) {}));
+        }
+
+        beginTest ("dispatching OSC addresses");
+        {
+            struct Target { String name; };
+            Target fader1 { "fader1" }, fader2 { "fader2" }, knob { "knob" };
+
+            OSCAddressTrie<Target> trie;
+            trie.add ("/juce/fader1", &fader1);
+            trie.add ("/juce/fader2", &fader2);
+            trie.add ("/juce/knob", &knob);
+            trie.add ("/juce/knob", &knob);
+
+            auto getMatches = [&] (const char* pattern)
+            {
+                StringArray matches;
+                trie.forEachMatch (pattern, OSCAddressPattern (pattern).containsWildcards(),
+                                   [&] (Target& t) { matches.add (t.name); });
+                matches.sort (false);
+                return matches.joinIntoString (" ");
+            };
+
+            expectEquals (getMatches ("/juce/fader1"), String ("fader1"));
+            expectEquals (getMatches ("/juce/knob/"), String ("knob"));
+            expectEquals (getMatches ("/juce"), String());
+            expectEquals (getMatches ("/juce/fader1/x"), String());
+            expectEquals (getMatches ("/juce/fader[0-9]"), String ("fader1 fader2"));
+            expectEquals (getMatches ("/*/*"), String ("fader1 fader2 knob"));
+            expectEquals (getMatches ("/juce/{knob,fader2}"), String ("fader2 knob"));
+
+            trie.remove (&fader2);
+            expectEquals (getMatches ("/juce/*"), String ("fader1 knob"));
+
+            trie.remove (&fader1);
+            trie.remove (&knob);
+            expect (trie.isEmpty());
+            expectEquals (getMatches ("/*/*"), String());
+        }
+    }
+};
+
+static OSCMessageViewTests OSCMessageViewUnitTests;
+
 #endif // JUCE_UNIT_TESTS
 
 } // namespace juce
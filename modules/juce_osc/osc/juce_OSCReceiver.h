@@ -158,6 +158,104 @@ public:
         virtual void oscMessageReceived (const OSCMessage& message) = 0;
     };
 
+    //==============================================================================
+    /** A read-only view of an OSC message inside a block of raw OSC data.
+
+        Unlike an OSCMessage, a MessageView doesn't copy or allocate anything: its
+        address pattern, strings and blobs all point directly into the data it was
+        created from, so it mustn't be used once that data has gone away.
+
+        This makes it suitable for realtime-critical code which has to look at every
+        incoming message without touching the heap.
+
+        @see OSCReceiver::MessageViewListener
+    */
+    class JUCE_API  MessageView
+    {
+    public:
+        /** Creates a view of a raw OSC message.
+            If the data isn't a well-formed OSC message, isValid() will return false
+            and the view will contain no arguments.
+        */
+        MessageView (const void* messageData, size_t messageSize) noexcept;
+
+        /** Returns true if the data that this view was created from is a valid OSC message. */
+        bool isValid() const noexcept                       { return addressPattern != nullptr; }
+
+        /** Returns the message's address pattern as a null-terminated string. */
+        const char* getAddressPattern() const noexcept      { return addressPattern; }
+
+        /** Returns true if the address pattern contains any OSC wildcards: ?, *, [], {} */
+        bool containsWildcards() const noexcept             { return hasWildcards; }
+
+        /** Returns the number of arguments in the message. */
+        int size() const noexcept                           { return numArguments; }
+
+        /** Returns the type of one of the message's arguments. */
+        OSCType getType (int index) const noexcept;
+
+        /** Returns the value of an int32 argument, or 0 if the argument has a different type. */
+        int32 getInt32 (int index) const noexcept;
+
+        /** Returns the value of a float32 argument, or 0 if the argument has a different type. */
+        float getFloat32 (int index) const noexcept;
+
+        /** Returns the null-terminated contents of a string argument, or nullptr if the
+            argument has a different type.
+        */
+        const char* getString (int index) const noexcept;
+
+        /** Returns the contents of a blob argument, or nullptr if the argument has a different type. */
+        const void* getBlobData (int index) const noexcept;
+
+        /** Returns the number of bytes in a blob argument, or 0 if the argument has a different type. */
+        size_t getBlobSize (int index) const noexcept;
+
+        /** Returns the value of a colour argument, or a transparent black if the argument
+            has a different type.
+        */
+        OSCColour getColour (int index) const noexcept;
+
+        /** Creates an OSCMessage containing a copy of this message's contents. */
+        OSCMessage toMessage() const;
+
+    private:
+        const char* addressPattern = nullptr;
+        const char* typeTags = nullptr;
+        const char* arguments = nullptr;
+        int numArguments = 0;
+        bool hasWildcards = false;
+
+        const char* getArgument (int index, OSCType expectedType) const noexcept;
+    };
+
+    //==============================================================================
+    /** A class for receiving OSC messages from an OSCReceiver without any allocation.
+
+        The messages are parsed in place inside the received packet, and the listener
+        is called directly on the network thread, so this is the cheapest way to react
+        to high-rate OSC traffic, for example setting real-time audio parameters.
+
+        Unlike the other listener types, a MessageViewListener is also called for each
+        of the messages inside a bundle.
+
+        Note that dispatching a message whose address pattern contains wildcards may
+        allocate when the pattern uses a character or string set ([] or {}).
+
+        @see OSCReceiver::addListener, OSCReceiver::MessageView
+    */
+    class JUCE_API  MessageViewListener
+    {
+    public:
+        /** Destructor. */
+        virtual ~MessageViewListener() = default;
+
+        /** Called on the network thread when the OSCReceiver receives a new OSC message.
+            The view is only valid for the duration of this call.
+        */
+        virtual void oscMessageReceived (const MessageView& message) = 0;
+    };
+
     //==============================================================================
     /** Adds a listener that listens to OSC messages and bundles.
         This listener will be called on the application's message loop.
@@ -184,6 +282,17 @@ public:
     void addListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToAdd,
                       OSCAddress addressToMatch);
 
+    /** Adds a listener that gets a view of every OSC message that is received.
+        The listener will be called in real-time directly on the network thread.
+    */
+    void addListener (MessageViewListener* listenerToAdd);
+
+    /** Adds a listener that gets a view of the OSC messages matching the address
+        used to register the listener here.
+        The listener will be called in real-time directly on the network thread.
+    */
+    void addListener (MessageViewListener* listenerToAdd, OSCAddress addressToMatch);
+
     /** Removes a previously-registered listener. */
     void removeListener (Listener<MessageLoopCallback>* listenerToRemove);
 
@@ -196,6 +305,9 @@ public:
     /** Removes a previously-registered listener. */
     void removeListener (ListenerWithOSCAddress<RealtimeCallback>* listenerToRemove);
 
+    /** Removes a previously-registered listener, along with all the addresses it was added with. */
+    void removeListener (MessageViewListener* listenerToRemove);
+
     //==============================================================================
     /** An error handler function for OSC format errors that can be called by the
         OSCReceiver.
@@ -27,193 +27,197 @@
 namespace juce
 {
 
-namespace
+//==============================================================================
+/** Writes OSC data to an internal memory buffer, which grows as required.
+
+    The data that was written into the stream can then be accessed later as
+    a contiguous block of memory.
+
+    This class implements the Open Sound Control 1.0 Specification for
+    the format in which the OSC data will be written into the buffer.
+*/
+struct OSCOutputStream
 {
-    //==============================================================================
-    /** Writes OSC data to an internal memory buffer, which grows as required.
+    OSCOutputStream() noexcept {}
 
-        The data that was written into the stream can then be accessed later as
-        a contiguous block of memory.
+    /** Returns a pointer to the data that has been written to the stream. */
+    const void* getData() const noexcept    { return output.getData(); }
 
-        This class implements the Open Sound Control 1.0 Specification for
-        the format in which the OSC data will be written into the buffer.
-    */
-    struct OSCOutputStream
-    {
-        OSCOutputStream() noexcept {}
+    /** Returns the number of bytes of data that have been written to the stream. */
+    size_t getDataSize() const noexcept     { return output.getDataSize(); }
 
-        /** Returns a pointer to the data that has been written to the stream. */
-        const void* getData() const noexcept    { return output.getData(); }
+    /** Discards the stream's contents, keeping its buffer for reuse. */
+    void reset() noexcept                   { output.reset(); }
 
-        /** Returns the number of bytes of data that have been written to the stream. */
-        size_t getDataSize() const noexcept     { return output.getDataSize(); }
+    //==============================================================================
+    bool writeInt32 (int32 value)
+    {
+        return output.writeIntBigEndian (value);
+    }
 
-        //==============================================================================
-        bool writeInt32 (int32 value)
-        {
-            return output.writeIntBigEndian (value);
-        }
+    bool writeUint64 (uint64 value)
+    {
+        return output.writeInt64BigEndian (int64 (value));
+    }
 
-        bool writeUint64 (uint64 value)
-        {
-            return output.writeInt64BigEndian (int64 (value));
-        }
+    bool writeFloat32 (float value)
+    {
+        return output.writeFloatBigEndian (value);
+    }
 
-        bool writeFloat32 (float value)
-        {
-            return output.writeFloatBigEndian (value);
-        }
+    bool writeString (const String& value)
+    {
+        if (! output.writeString (value))
+            return false;
 
-        bool writeString (const String& value)
-        {
-            if (! output.writeString (value))
-                return false;
+        const size_t numPaddingZeros = ~value.length() & 3;
 
-            const size_t numPaddingZeros = ~value.length() & 3;
+        return output.writeRepeatedByte ('\0', numPaddingZeros);
+    }
 
-            return output.writeRepeatedByte ('\0', numPaddingZeros);
-        }
+    bool writeBlob (const MemoryBlock& blob)
+    {
+        if (! (output.writeIntBigEndian ((int) blob.getSize())
+                && output.write (blob.getData(), blob.getSize())))
+            return false;
 
-        bool writeBlob (const MemoryBlock& blob)
-        {
-            if (! (output.writeIntBigEndian ((int) blob.getSize())
-                    && output.write (blob.getData(), blob.getSize())))
-                return false;
+        const size_t numPaddingZeros = ~(blob.getSize() - 1) & 3;
 
-            const size_t numPaddingZeros = ~(blob.getSize() - 1) & 3;
+        return output.writeRepeatedByte (0, numPaddingZeros);
+    }
 
-            return output.writeRepeatedByte (0, numPaddingZeros);
-        }
+    bool writeRawData (const void* data, size_t numBytes)
+    {
+        return output.write (data, numBytes);
+    }
 
-        bool writeColour (OSCColour colour)
-        {
-            return output.writeIntBigEndian ((int32) colour.toInt32());
-        }
+    bool writeColour (OSCColour colour)
+    {
+        return output.writeIntBigEndian ((int32) colour.toInt32());
+    }
 
-        bool writeTimeTag (OSCTimeTag timeTag)
-        {
-            return output.writeInt64BigEndian (int64 (timeTag.getRawTimeTag()));
-        }
+    bool writeTimeTag (OSCTimeTag timeTag)
+    {
+        return output.writeInt64BigEndian (int64 (timeTag.getRawTimeTag()));
+    }
 
-        bool writeAddress (const OSCAddress& address)
-        {
-            return writeString (address.toString());
-        }
+    bool writeAddress (const OSCAddress& address)
+    {
+        return writeString (address.toString());
+    }
 
-        bool writeAddressPattern (const OSCAddressPattern& ap)
-        {
-            return writeString (ap.toString());
-        }
+    bool writeAddressPattern (const OSCAddressPattern& ap)
+    {
+        return writeString (ap.toString());
+    }
 
-        bool writeTypeTagString (const OSCTypeList& typeList)
-        {
-            output.writeByte (',');
+    bool writeTypeTagString (const OSCTypeList& typeList)
+    {
+        output.writeByte (',');
 
-            if (typeList.size() > 0)
-                output.write (typeList.begin(), (size_t) typeList.size());
+        if (typeList.size() > 0)
+            output.write (typeList.begin(), (size_t) typeList.size());
 
-            output.writeByte ('\0');
+        output.writeByte ('\0');
 
-            size_t bytesWritten = (size_t) typeList.size() + 1;
-            size_t numPaddingZeros = ~bytesWritten & 0x03;
+        size_t bytesWritten = (size_t) typeList.size() + 1;
+        size_t numPaddingZeros = ~bytesWritten & 0x03;
 
-            return output.writeRepeatedByte ('\0', numPaddingZeros);
-        }
+        return output.writeRepeatedByte ('\0', numPaddingZeros);
+    }
 
-        bool writeArgument (const OSCArgument& arg)
+    bool writeArgument (const OSCArgument& arg)
+    {
+        switch (arg.getType())
         {
-            switch (arg.getType())
-            {
-                case OSCTypes::int32:       return writeInt32 (arg.getInt32());
-                case OSCTypes::float32:     return writeFloat32 (arg.getFloat32());
-                case OSCTypes::string:      return writeString (arg.getString());
-                case OSCTypes::blob:        return writeBlob (arg.getBlob());
-                case OSCTypes::colour:      return writeColour (arg.getColour());
-
-                default:
-                    // In this very unlikely case you supplied an invalid OSCType!
-                    jassertfalse;
-                    return false;
-            }
+            case OSCTypes::int32:       return writeInt32 (arg.getInt32());
+            case OSCTypes::float32:     return writeFloat32 (arg.getFloat32());
+            case OSCTypes::string:      return writeString (arg.getString());
+            case OSCTypes::blob:        return writeBlob (arg.getBlob());
+            case OSCTypes::colour:      return writeColour (arg.getColour());
+
+            default:
+                // In this very unlikely case you supplied an invalid OSCType!
+                jassertfalse;
+                return false;
         }
+    }
 
-        //==============================================================================
-        bool writeMessage (const OSCMessage& msg)
-        {
-            if (! writeAddressPattern (msg.getAddressPattern()))
-                return false;
+    //==============================================================================
+    bool writeMessage (const OSCMessage& msg)
+    {
+        if (! writeAddressPattern (msg.getAddressPattern()))
+            return false;
+
+        OSCTypeList typeList;
 
-            OSCTypeList typeList;
+        for (auto& arg : msg)
+            typeList.add (arg.getType());
 
-            for (auto& arg : msg)
-                typeList.add (arg.getType());
+        if (! writeTypeTagString (typeList))
+            return false;
 
-            if (! writeTypeTagString (typeList))
+        for (auto& arg : msg)
+            if (! writeArgument (arg))
                 return false;
 
-            for (auto& arg : msg)
-                if (! writeArgument (arg))
-                    return false;
+        return true;
+    }
 
-            return true;
-        }
+    bool writeBundle (const OSCBundle& bundle)
+    {
+        if (! writeString ("#bundle"))
+            return false;
 
-        bool writeBundle (const OSCBundle& bundle)
-        {
-            if (! writeString ("#bundle"))
-                return false;
+        if (! writeTimeTag (bundle.getTimeTag()))
+            return false;
 
-            if (! writeTimeTag (bundle.getTimeTag()))
+        for (auto& element : bundle)
+            if (! writeBundleElement (element))
                 return false;
 
-            for (auto& element : bundle)
-                if (! writeBundleElement (element))
-                    return false;
+        return true;
+    }
 
-            return true;
-        }
+    //==============================================================================
+    bool writeBundleElement (const OSCBundle::Element& element)
+    {
+        const int64 startPos = output.getPosition();
 
-        //==============================================================================
-        bool writeBundleElement (const OSCBundle::Element& element)
-        {
-            const int64 startPos = output.getPosition();
+        if (! writeInt32 (0))   // writing dummy value for element size
+            return false;
 
-            if (! writeInt32 (0))   // writing dummy value for element size
+        if (element.isBundle())
+        {
+            if (! writeBundle (element.getBundle()))
+                return false;
+        }
+        else
+        {
+            if (! writeMessage (element.getMessage()))
                 return false;
-
-            if (element.isBundle())
-            {
-                if (! writeBundle (element.getBundle()))
-                    return false;
-            }
-            else
-            {
-                if (! writeMessage (element.getMessage()))
-                    return false;
-            }
-
-            const int64 endPos = output.getPosition();
-            const int64 elementSize = endPos - (startPos + 4);
-
-            return output.setPosition (startPos)
-                     && writeInt32 ((int32) elementSize)
-                     && output.setPosition (endPos);
         }
 
-    private:
-        MemoryOutputStream output;
+        const int64 endPos = output.getPosition();
+        const int64 elementSize = endPos - (startPos + 4);
 
-        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCOutputStream)
-    };
+        return output.setPosition (startPos)
+                 && writeInt32 ((int32) elementSize)
+                 && output.setPosition (endPos);
+    }
 
-} // namespace
+private:
+    MemoryOutputStream output;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OSCOutputStream)
+};
 
 
 //==============================================================================
-struct OSCSender::Pimpl
+struct OSCSender::Pimpl   : private Thread
 {
-    Pimpl() noexcept  {}
-    ~Pimpl() noexcept { disconnect(); }
+    Pimpl()  : Thread ("JUCE OSC sender") {}
+    ~Pimpl() { disconnect(); }
 
     //==============================================================================
     bool connect (const String& newTargetHost, int newTargetPort)
@@ -226,7 +230,12 @@ struct OSCSender::Pimpl
         targetPortNumber = newTargetPort;
 
         if (socket->bindToPort (0)) // 0 = use any local port assigned by the OS.
+        {
+            if (queueing)
+                startThread();
+
             return true;
+        }
 
         socket.reset();
         return false;
@@ -240,11 +249,21 @@ struct OSCSender::Pimpl
         socket.setNonOwned (&newSocket);
         targetHostName = newTargetHost;
         targetPortNumber = newTargetPort;
+
+        if (queueing)
+            startThread();
+
         return true;
     }
 
     bool disconnect()
     {
+        if (socket != nullptr && queueing)
+        {
+            stopThread (4000);
+            flushQueue();
+        }
+
         socket.reset();
         return true;
     }
@@ -266,10 +285,206 @@ struct OSCSender::Pimpl
             && sendOutputStream (outStream, hostName, portNumber);
     }
 
-    bool send (const OSCMessage& message)   { return send (message, targetHostName, targetPortNumber); }
-    bool send (const OSCBundle& bundle)     { return send (bundle,  targetHostName, targetPortNumber); }
+    bool send (const Array<OSCMessage>& messages, const String& hostName, int portNumber)
+    {
+        OwnedArray<OSCOutputStream> streams;
+        Array<DatagramSocket::Packet> packets;
+
+        for (auto& message : messages)
+        {
+            auto* outStream = streams.add (new OSCOutputStream());
+
+            if (! outStream->writeMessage (message))
+                return false;
+
+            DatagramSocket::Packet packet;
+            packet.data = const_cast<void*> (outStream->getData());
+            packet.size = (int) outStream->getDataSize();
+            packets.add (packet);
+        }
+
+        if (socket != nullptr)
+            return socket->writeMultiple (hostName, portNumber, packets.begin(), packets.size()) == packets.size();
+
+        // if you hit this, you tried to send some OSC data without being
+        // connected to a port! You should call OSCSender::connect() first.
+        jassertfalse;
+
+        return false;
+    }
+
+    bool send (const OSCMessage& message)           { return queueing ? enqueue (message) : send (message, targetHostName, targetPortNumber); }
+    bool send (const OSCBundle& bundle)             { return queueing ? enqueue (bundle)  : send (bundle,  targetHostName, targetPortNumber); }
+
+    bool send (const Array<OSCMessage>& messages)
+    {
+        if (! queueing)
+            return send (messages, targetHostName, targetPortNumber);
+
+        for (auto& message : messages)
+            if (! enqueue (message))
+                return false;
+
+        return true;
+    }
+
+    //==============================================================================
+    void startQueueing (int newMaxPacketSize, int newMaxDelayMs)
+    {
+        // a bundle needs at least 16 bytes for its header, plus the elements themselves
+        jassert (newMaxPacketSize > 20 && newMaxDelayMs >= 0);
+
+        {
+            const ScopedLock sl (queueLock);
+            maxPacketSize = (size_t) jmax (24, newMaxPacketSize);
+            maxDelayMs = jmax (0, newMaxDelayMs);
+            queueing = true;
+        }
+
+        if (socket != nullptr)
+            startThread();
+    }
+
+    void stopQueueing()
+    {
+        queueing = false;
+        stopThread (4000);
+        flushQueue();
+    }
+
+    bool isQueueing() const noexcept    { return queueing; }
+
+    bool flushQueue()
+    {
+        const ScopedLock sendLocker (sendLock);
+
+        {
+            const ScopedLock sl (queueLock);
+            finishCurrentBundle();
+            sendingStreams.swapWith (queuedStreams);
+        }
+
+        if (sendingStreams.isEmpty())
+            return true;
+
+        queuedPackets.clearQuick();
+
+        for (auto* stream : sendingStreams)
+        {
+            DatagramSocket::Packet packet;
+            packet.data = const_cast<void*> (stream->getData());
+            packet.size = (int) stream->getDataSize();
+            queuedPackets.add (packet);
+        }
+
+        auto allSent = sendPackets (targetHostName, targetPortNumber);
+
+        const ScopedLock sl (queueLock);
+
+        while (! sendingStreams.isEmpty())
+            spareStreams.add (sendingStreams.removeAndReturn (sendingStreams.size() - 1));
+
+        return allSent;
+    }
 
 private:
+    //==============================================================================
+    static bool writeContent (OSCOutputStream& stream, const OSCMessage& message)    { return stream.writeMessage (message); }
+    static bool writeContent (OSCOutputStream& stream, const OSCBundle& bundle)      { return stream.writeBundle (bundle); }
+
+    template <typename ContentType>
+    bool enqueue (const ContentType& content)
+    {
+        const ScopedLock sl (queueLock);
+
+        elementStream.reset();
+
+        if (! writeContent (elementStream, content))
+            return false;
+
+        auto elementSize = elementStream.getDataSize() + 4;
+
+        if (currentBundle != nullptr && currentBundle->getDataSize() + elementSize > maxPacketSize)
+        {
+            finishCurrentBundle();
+            notify();
+        }
+
+        if (elementSize + 16 > maxPacketSize)
+        {
+            // too big to be bundled with anything else, so this goes out on its own
+            auto* stream = getSpareStream();
+            stream->writeRawData (elementStream.getData(), elementStream.getDataSize());
+            queuedStreams.add (stream);
+            notify();
+            return true;
+        }
+
+        if (currentBundle == nullptr)
+        {
+            currentBundle = getSpareStream();
+            currentBundle->writeString ("#bundle");
+            currentBundle->writeTimeTag (OSCTimeTag::immediately);
+            notify(); // starts the clock for flushing this bundle
+        }
+
+        return currentBundle->writeInt32 ((int32) elementStream.getDataSize())
+            && currentBundle->writeRawData (elementStream.getData(), elementStream.getDataSize());
+    }
+
+    void finishCurrentBundle()
+    {
+        if (currentBundle != nullptr)
+        {
+            queuedStreams.add (currentBundle);
+            currentBundle = nullptr;
+        }
+    }
+
+    OSCOutputStream* getSpareStream()
+    {
+        if (auto* stream = spareStreams.removeAndReturn (spareStreams.size() - 1))
+        {
+            stream->reset();
+            return stream;
+        }
+
+        return new OSCOutputStream();
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (-1);
+
+            // unless a bundle has already filled up, let more messages join the current one
+            if (! threadShouldExit() && ! hasQueuedStreams())
+                wait (maxDelayMs);
+
+            if (! threadShouldExit())
+                flushQueue();
+        }
+    }
+
+    bool hasQueuedStreams() const
+    {
+        const ScopedLock sl (queueLock);
+        return ! queuedStreams.isEmpty();
+    }
+
+    bool sendPackets (const String& hostName, int portNumber)
+    {
+        if (socket != nullptr)
+            return socket->writeMultiple (hostName, portNumber, queuedPackets.begin(), queuedPackets.size()) == queuedPackets.size();
+
+        // if you hit this, you tried to send some OSC data without being
+        // connected to a port! You should call OSCSender::connect() first.
+        jassertfalse;
+
+        return false;
+    }
+
     //==============================================================================
     bool sendOutputStream (OSCOutputStream& outStream, const String& hostName, int portNumber)
     {
@@ -294,6 +509,17 @@ private:
     String targetHostName;
     int targetPortNumber = 0;
 
+    // the queue's streams are recycled, so once it has warmed up, queueing
+    // messages doesn't need to allocate anything
+    CriticalSection queueLock, sendLock;
+    OSCOutputStream elementStream;
+    OSCOutputStream* currentBundle = nullptr;
+    OwnedArray<OSCOutputStream> queuedStreams, sendingStreams, spareStreams;
+    Array<DatagramSocket::Packet> queuedPackets;
+    size_t maxPacketSize = 1472;
+    int maxDelayMs = 2;
+    std::atomic<bool> queueing { false };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
 
@@ -328,9 +554,16 @@ bool OSCSender::disconnect()
 //==============================================================================
 bool OSCSender::send (const OSCMessage& message)    { return pimpl->send (message); }
 bool OSCSender::send (const OSCBundle& bundle)      { return pimpl->send (bundle); }
+bool OSCSender::send (const Array<OSCMessage>& messages)  { return pimpl->send (messages); }
 
 bool OSCSender::sendToIPAddress (const String& host, int port, const OSCMessage& message) { return pimpl->send (message, host, port); }
 bool OSCSender::sendToIPAddress (const String& host, int port, const OSCBundle& bundle)   { return pimpl->send (bundle,  host, port); }
+bool OSCSender::sendToIPAddress (const String& host, int port, const Array<OSCMessage>& messages)  { return pimpl->send (messages, host, port); }
+
+void OSCSender::startQueueing (int maxPacketSizeBytes, int maxDelayMilliseconds)  { pimpl->startQueueing (maxPacketSizeBytes, maxDelayMilliseconds); }
+void OSCSender::stopQueueing()              { pimpl->stopQueueing(); }
+bool OSCSender::isQueueing() const noexcept { return pimpl->isQueueing(); }
+bool OSCSender::flushQueue()                { return pimpl->flushQueue(); }
 
 //==============================================================================
 //==============================================================================
@@ -862,6 +1095,62 @@ public:
                 expectEquals (msg[0].getInt32(), 42);
             }
         }
+
+        beginTest ("Queued OSC messages");
+        {
+            DatagramSocket receiver;
+            expect (receiver.bindToPort (0, "127.0.0.1"));
+
+            OSCSender sender;
+            expect (sender.connect ("127.0.0.1", receiver.getBoundPort()));
+
+            sender.startQueueing (256, 10000);
+            expect (sender.isQueueing());
+
+            for (int i = 0; i < 40; ++i)
+                expect (sender.send ("/test/queued", i));
+
+            expect (sender.send (OSCMessage ("/test/large", String::repeatedString ("x", 300))));
+            expect (sender.send ("/test/queued", 40));
+            expect (sender.flushQueue());
+
+            int numPackets = 0, nextValue = 0;
+            bool largeMessageArrived = false;
+            char buffer[1024];
+
+            while (receiver.waitUntilReady (true, 500) == 1)
+            {
+                auto numBytes = receiver.read (buffer, (int) sizeof (buffer), false);
+                expect (numBytes > 0 && (numBytes <= 256 || ! largeMessageArrived));
+                ++numPackets;
+
+                OSCInputStream input (buffer, (size_t) numBytes);
+                auto element = input.readElementWithKnownSize ((size_t) numBytes);
+
+                if (element.isMessage())
+                {
+                    expectEquals (element.getMessage().getAddressPattern().toString(), String ("/test/large"));
+                    expectEquals (nextValue, 40);
+                    largeMessageArrived = true;
+                    continue;
+                }
+
+                for (auto& e : element.getBundle())
+                    expectEquals (e.getMessage()[0].getInt32(), nextValue++);
+            }
+
+            expect (largeMessageArrived);
+            expectEquals (nextValue, 41);
+            expect (numPackets > 2 && numPackets < 41);
+
+            // with a short delay, the background thread should send the bundle by itself
+            sender.startQueueing (256, 5);
+            expect (sender.send ("/test/queued", 41));
+            expectEquals (receiver.waitUntilReady (true, 2000), 1);
+
+            sender.stopQueueing();
+            expect (! sender.isQueueing());
+        }
     }
 };
 
@@ -95,6 +95,16 @@ public:
     */
     bool send (const OSCBundle& bundle);
 
+    /** Sends several OSC messages to the target, each in its own packet.
+
+        This is quicker than calling send() for each one, as the packets can be handed
+        to the OS in a single call where it supports that.
+
+        @param  messages  The OSC messages to send.
+        @returns true if all of the messages were sent.
+    */
+    bool send (const Array<OSCMessage>& messages);
+
     /** Sends an OSC message to a specific IP address and port.
         This overrides the address and port that was originally set for this sender.
         @param  targetIPAddress   The IP address to send to
@@ -115,6 +125,16 @@ public:
     bool sendToIPAddress (const String& targetIPAddress, int targetPortNumber,
                           const OSCBundle& bundle);
 
+    /** Sends several OSC messages to a specific IP address and port, each in its own packet.
+        This overrides the address and port that was originally set for this sender.
+        @param  targetIPAddress   The IP address to send to
+        @param  targetPortNumber  The target port number
+        @param  messages          The OSC messages to send.
+        @returns true if all of the messages were sent.
+    */
+    bool sendToIPAddress (const String& targetIPAddress, int targetPortNumber,
+                          const Array<OSCMessage>& messages);
+
     /** Creates a new OSC message with the specified address pattern and list
         of arguments, and sends it to the target.
 
@@ -138,6 +158,43 @@ public:
     bool sendToIPAddress (const String& targetIPAddress, int targetPortNumber,
                           const OSCAddressPattern& address, Args&&... args);
 
+    //==============================================================================
+    /** Makes the sender queue up the messages and bundles sent to its target,
+        rather than sending each of them in a packet of its own.
+
+        While queueing, the send() methods only serialise the message or bundle and
+        return straight away. The queued data is packed into OSC bundles no bigger
+        than maxPacketSizeBytes, which a background thread sends as soon as they are
+        full, or when the oldest queued message has waited for maxDelayMilliseconds.
+        Sending many small messages this way costs a fraction of the packets and
+        system calls that sending them one by one would.
+
+        Anything too big to fit into a bundle of that size is sent in a packet of its
+        own, as is everything sent with sendToIPAddress(), which is never queued. The
+        order in which the queued data arrives at the target is always preserved.
+
+        The default packet size is the largest UDP payload that fits into a single
+        Ethernet frame, so that the bundles won't be fragmented on most networks.
+
+        @see stopQueueing, flushQueue
+    */
+    void startQueueing (int maxPacketSizeBytes = 1472, int maxDelayMilliseconds = 2);
+
+    /** Sends anything that is still queued and goes back to sending each message
+        and bundle immediately.
+        @see startQueueing
+    */
+    void stopQueueing();
+
+    /** Returns true if startQueueing() has been called. */
+    bool isQueueing() const noexcept;
+
+    /** Immediately sends everything that has been queued so far.
+        @returns true if all of the queued data was sent.
+        @see startQueueing
+    */
+    bool flushQueue();
+
 private:
     //==============================================================================
     struct Pimpl;
@@ -152,7 +152,7 @@ struct KeyFileUtils
         String licensee, email, appID;
         StringArray machineNumbers;
 
-        bool keyFileExpires;
+        bool keyFileExpires = false;
         Time expiryTime;
     };
 
@@ -188,6 +188,89 @@ static const char* stateTagName = "REG";
 static const char* userNameProp = "user";
 static const char* keyfileDataProp = "key";
 
+//==============================================================================
+/*  Decrypting a key file is slow, and every instance of a plugin in a session will
+    do it with the same data, so the decrypted key files and the local machine IDs
+    are kept here until shutdown.
+*/
+struct KeyFileCache  : private DeletedAtShutdown
+{
+    KeyFileCache() {}
+
+    ~KeyFileCache() override
+    {
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON (KeyFileCache, false)
+
+    XmlElement getXmlFromKeyFile (const String& keyFileText, const RSAKey& publicKey)
+    {
+        auto hash = SHA256 ((publicKey.toString() + "/" + keyFileText).toUTF8()).toHexString();
+
+        {
+            const ScopedLock sl (lock);
+
+            for (auto* entry : keyFiles)
+                if (entry->hash == hash)
+                    return entry->xml;
+        }
+
+        auto xml = KeyFileUtils::getXmlFromKeyFile (keyFileText, publicKey);
+
+        const ScopedLock sl (lock);
+
+        if (keyFiles.size() >= maxNumKeyFiles)
+            keyFiles.remove (0);
+
+        keyFiles.add (new KeyFile { hash, xml });
+        return xml;
+    }
+
+    StringArray getLocalMachineIDs()
+    {
+        const ScopedLock sl (lock);
+
+        if (! hasFoundMachineIDs)
+        {
+            machineIDs = OnlineUnlockStatus::MachineIDUtilities::findLocalMachineIDs();
+            hasFoundMachineIDs = true;
+        }
+
+        return machineIDs;
+    }
+
+private:
+    struct KeyFile
+    {
+        String hash;
+        XmlElement xml;
+    };
+
+    enum { maxNumKeyFiles = 8 };
+
+    OwnedArray<KeyFile> keyFiles;
+    StringArray machineIDs;
+    bool hasFoundMachineIDs = false;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE (KeyFileCache)
+};
+
+JUCE_IMPLEMENT_SINGLETON (KeyFileCache)
+
+static ValueTree readStatusFromState (const String& state)
+{
+    MemoryBlock mb;
+    mb.fromBase64Encoding (state);
+
+    if (mb.getSize() > 0)
+        return ValueTree::readFromGZIPData (mb.getData(), mb.getSize());
+
+    return ValueTree (stateTagName);
+}
+
+//==============================================================================
 static var machineNumberAllowed (StringArray numbersFromKeyFile,
                                  StringArray localMachineNumbers)
 {
@@ -227,21 +310,61 @@ OnlineUnlockStatus::~OnlineUnlockStatus()
 
 void OnlineUnlockStatus::load()
 {
-    MemoryBlock mb;
-    mb.fromBase64Encoding (getState());
+    ++numLoadsStarted; // (this supersedes any loadAsync() calls that haven't finished)
 
-    if (mb.getSize() > 0)
-        status = ValueTree::readFromGZIPData (mb.getData(), mb.getSize());
-    else
-        status = ValueTree (stateTagName);
+    auto newStatus = readStatusFromState (getState());
+    auto localMachineNums = getLocalMachineIDs();
+
+    applyLoadedStatus (newStatus,
+                       KeyFileCache::getInstance()->getXmlFromKeyFile (newStatus[keyfileDataProp], getPublicKey()),
+                       localMachineNums);
+}
+
+void OnlineUnlockStatus::loadAsync (std::function<void()> onLoaded)
+{
+    auto newStatus = readStatusFromState (getState());
+    auto keyFileText = newStatus[keyfileDataProp].toString();
+    auto publicKey = getPublicKey();
+    auto localMachineNums = getLocalMachineIDs();
+    auto loadNumber = ++numLoadsStarted;
+
+    // nothing is unlocked until the key file has been checked
+    status = newStatus.createCopy();
+    status.removeProperty (unlockedProp, nullptr);
+    status.removeProperty (expiryTimeProp, nullptr);
+
+    WeakReference<OnlineUnlockStatus> weakThis (this);
+
+    Thread::launch ([=]
+    {
+        auto keyFileXml = KeyFileCache::getInstance()->getXmlFromKeyFile (keyFileText, publicKey);
+
+        MessageManager::callAsync ([=]
+        {
+            if (auto* s = weakThis.get())
+            {
+                if (s->numLoadsStarted == loadNumber)
+                {
+                    s->applyLoadedStatus (newStatus, keyFileXml, localMachineNums);
 
-    StringArray localMachineNums (getLocalMachineIDs());
+                    if (onLoaded != nullptr)
+                        onLoaded();
+                }
+            }
+        });
+    });
+}
+
+void OnlineUnlockStatus::applyLoadedStatus (ValueTree newStatus, const XmlElement& keyFileXml,
+                                            const StringArray& localMachineNums)
+{
+    status = newStatus;
 
     if (machineNumberAllowed (StringArray ("1234"), localMachineNums))
         status.removeProperty (unlockedProp, nullptr);
 
     KeyFileUtils::KeyFileData data;
-    data = KeyFileUtils::getDataFromKeyFile (KeyFileUtils::getXmlFromKeyFile (status[keyfileDataProp], getPublicKey()));
+    data = KeyFileUtils::getDataFromKeyFile (keyFileXml);
 
     if (data.keyFileExpires)
     {
@@ -314,6 +437,11 @@ void OnlineUnlockStatus::MachineIDUtilities::addMACAddressesToList (StringArray&
 }
 
 StringArray OnlineUnlockStatus::MachineIDUtilities::getLocalMachineIDs()
+{
+    return KeyFileCache::getInstance()->getLocalMachineIDs();
+}
+
+StringArray OnlineUnlockStatus::MachineIDUtilities::findLocalMachineIDs()
 {
     auto identifiers = SystemStats::getDeviceIdentifiers();
 
@@ -345,18 +473,21 @@ String OnlineUnlockStatus::getUserEmail() const
 bool OnlineUnlockStatus::applyKeyFile (String keyFileContent)
 {
     KeyFileUtils::KeyFileData data;
-    data = KeyFileUtils::getDataFromKeyFile (KeyFileUtils::getXmlFromKeyFile (keyFileContent, getPublicKey()));
+    data = KeyFileUtils::getDataFromKeyFile (KeyFileCache::getInstance()->getXmlFromKeyFile (keyFileContent, getPublicKey()));
 
     if (data.licensee.isNotEmpty() && data.email.isNotEmpty() && doesProductIDMatch (data.appID))
     {
+        ++numLoadsStarted; // (so that an unfinished loadAsync() can't overwrite this)
+
         setUserEmail (data.email);
         status.setProperty (keyfileDataProp, keyFileContent, nullptr);
         status.removeProperty (data.keyFileExpires ? expiryTimeProp : unlockedProp, nullptr);
 
         var actualResult (0), dummyResult (1.0);
-        var v (machineNumberAllowed (data.machineNumbers, getLocalMachineIDs()));
+        auto localMachineNums = getLocalMachineIDs();
+        var v (machineNumberAllowed (data.machineNumbers, localMachineNums));
         actualResult.swapWith (v);
-        v = machineNumberAllowed (StringArray ("01"), getLocalMachineIDs());
+        v = machineNumberAllowed (StringArray ("01"), localMachineNums);
         dummyResult.swapWith (v);
         jassert (! dummyResult);
 
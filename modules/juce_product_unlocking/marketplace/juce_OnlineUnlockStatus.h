@@ -216,6 +216,19 @@ public:
      */
     void load();
 
+    /** Like load(), but checks the key file on a background thread so that it won't
+        hold up the thread that calls it (e.g. while a plugin is being constructed).
+
+        Until the check has finished, isUnlocked() will return false and the expiry time
+        will be zero. When it's done, the status is updated on the message thread and the
+        optional callback is invoked. Calling load() or applyKeyFile() before then will
+        cancel the pending update.
+
+        Decrypted key files are cached for the lifetime of the process, so when several
+        instances check the same key file, only the first one has any real work to do.
+    */
+    void loadAsync (std::function<void()> onLoaded = nullptr);
+
     /** Triggers a call to saveState which you can use to store the current unlock status
         in your app's settings.
      */
@@ -259,19 +272,28 @@ public:
             just used as fallback to avoid false negatives when checking for
             registration on machines which have had hardware added/removed
             since the product was first registered.
+
+            Finding these IDs can be slow, so this returns a copy of the list that
+            findLocalMachineIDs() returned the first time it was called.
         */
         static StringArray getLocalMachineIDs();
+
+        /** Calculates the list that getLocalMachineIDs() returns, without any caching. */
+        static StringArray findLocalMachineIDs();
     };
 
 private:
     ValueTree status;
+    std::atomic<uint32> numLoadsStarted { 0 };
 
+    void applyLoadedStatus (ValueTree, const XmlElement& keyFileXml, const StringArray& localMachineIDs);
     UnlockResult handleXmlReply (XmlElement);
     UnlockResult handleFailedConnection();
 
     static const char* unlockedProp;
     static const char* expiryTimeProp;
 
+    JUCE_DECLARE_WEAK_REFERENCEABLE (OnlineUnlockStatus)
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OnlineUnlockStatus)
 };
 
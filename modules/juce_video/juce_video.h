@@ -43,8 +43,8 @@
   license:          GPL/Commercial
 
   dependencies:     juce_gui_extra
-  OSXFrameworks:    AVKit AVFoundation CoreMedia
-  iOSFrameworks:    AVKit AVFoundation CoreMedia
+  OSXFrameworks:    AVKit AVFoundation CoreMedia CoreVideo QuartzCore
+  iOSFrameworks:    AVKit AVFoundation CoreMedia CoreVideo QuartzCore
 
  END_JUCE_MODULE_DECLARATION
 
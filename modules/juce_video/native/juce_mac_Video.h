@@ -28,7 +28,8 @@ using Base = NSViewComponent;
 using Base = UIViewComponent;
 #endif
 
-struct VideoComponent::Pimpl   : public Base
+struct VideoComponent::Pimpl   : public Base,
+                                 private Timer
 {
     Pimpl (VideoComponent& ownerToUse, bool useNativeControlsIfAvailable)
         : owner (ownerToUse),
@@ -76,7 +77,9 @@ struct VideoComponent::Pimpl   : public Base
         if (url != nil)
         {
             close();
-            return playerController.load (url);
+            auto r = playerController.load (url);
+            updateVideoOutput();
+            return r;
         }
 
         return Result::fail ("Couldn't open movie");
@@ -103,6 +106,7 @@ struct VideoComponent::Pimpl   : public Base
     {
         stop();
         playerController.close();
+        updateVideoOutput();
         currentFile = File();
         currentURL = {};
     }
@@ -183,6 +187,13 @@ struct VideoComponent::Pimpl   : public Base
         return 0.0f;
     }
 
+    void setFrameCallback (std::function<void (const Frame&)> callback, bool preferNativeSurfaces)
+    {
+        frameCallback = std::move (callback);
+        useNativeSurfaces = preferNativeSurfaces;
+        updateVideoOutput();
+    }
+
     File currentFile;
     URL currentURL;
 
@@ -778,6 +789,12 @@ private:
 
     double playSpeedMult = 1.0;
 
+    std::function<void (const Frame&)> frameCallback;
+    bool useNativeSurfaces = true;
+    std::unique_ptr<AVPlayerItemVideoOutput, NSObjectDeleter> videoOutput;
+    AVPlayerItem* videoOutputItem = nil;
+    VideoFrameImagePool framePool;
+
     static double toSeconds (const CMTime& t) noexcept
     {
         return t.timescale != 0 ? (t.value / (double) t.timescale) : 0.0;
@@ -785,6 +802,7 @@ private:
 
     void playerPreparationFinished (const URL& url, Result r)
     {
+        updateVideoOutput();
         owner.resized();
 
         loadFinishedCallback (url, r);
@@ -815,5 +833,88 @@ private:
         setPosition (0.0);
     }
 
+    //==============================================================================
+    // While there's a frame callback, an AVPlayerItemVideoOutput is attached to the current
+    // item, which hands over the decoded frames without them having to be read back from
+    // the player's layer.
+    void updateVideoOutput()
+    {
+        auto* item = frameCallback != nullptr ? [playerController.getPlayer() currentItem] : nil;
+
+        if (item == videoOutputItem)
+            return;
+
+        if (videoOutputItem != nil)
+        {
+            [videoOutputItem removeOutput: videoOutput.get()];
+            [videoOutputItem release];
+            videoOutputItem = nil;
+        }
+
+        if (item != nil)
+        {
+            if (videoOutput == nullptr)
+            {
+                // (asking for IOSurface-backed buffers means they can be shared with the GPU)
+                NSDictionary* attributes = @{ (NSString*) kCVPixelBufferPixelFormatTypeKey:     @(kCVPixelFormatType_32BGRA),
+                                              (NSString*) kCVPixelBufferIOSurfacePropertiesKey: @{} };
+
+                videoOutput.reset ([[AVPlayerItemVideoOutput alloc] initWithPixelBufferAttributes: attributes]);
+            }
+
+            videoOutputItem = [item retain];
+            [videoOutputItem addOutput: videoOutput.get()];
+            startTimerHz (120);
+        }
+        else
+        {
+            stopTimer();
+            framePool.clear();
+        }
+    }
+
+    void timerCallback() override
+    {
+        auto itemTime = [videoOutput.get() itemTimeForHostTime: CACurrentMediaTime()];
+
+        if (! [videoOutput.get() hasNewPixelBufferForItemTime: itemTime])
+            return;
+
+        auto displayTime = kCMTimeInvalid;
+
+        if (auto pixelBuffer = [videoOutput.get() copyPixelBufferForItemTime: itemTime
+                                                          itemTimeForDisplay: &displayTime])
+        {
+            deliverFrame (pixelBuffer, toSeconds (displayTime));
+            CVBufferRelease (pixelBuffer);
+        }
+    }
+
+    void deliverFrame (CVPixelBufferRef pixelBuffer, double presentationTime)
+    {
+        Frame frame;
+        frame.presentationTime = presentationTime;
+        frame.width  = (int) CVPixelBufferGetWidth (pixelBuffer);
+        frame.height = (int) CVPixelBufferGetHeight (pixelBuffer);
+
+        if (useNativeSurfaces)
+            frame.nativeSurface = CVPixelBufferGetIOSurface (pixelBuffer);
+
+        if (frame.nativeSurface == nullptr)
+        {
+            if (CVPixelBufferLockBaseAddress (pixelBuffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess)
+                return;
+
+            frame.image = framePool.getImage (frame.width, frame.height);
+
+            VideoFrameImagePool::copyPixels (frame.image, static_cast<const uint8*> (CVPixelBufferGetBaseAddress (pixelBuffer)),
+                                             (int) CVPixelBufferGetBytesPerRow (pixelBuffer), 4, false);
+
+            CVPixelBufferUnlockBaseAddress (pixelBuffer, kCVPixelBufferLock_ReadOnly);
+        }
+
+        frameCallback (frame);
+    }
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pimpl)
 };
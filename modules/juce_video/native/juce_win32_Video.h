@@ -36,6 +36,30 @@ namespace VideoRenderers
         virtual void repaintVideo (HWND, HDC) = 0;
         virtual void displayModeChanged() = 0;
         virtual HRESULT getVideoSize (long& videoWidth, long& videoHeight) = 0;
+
+        // Copies the frame that's currently being shown, along with its timestamp in 100ns
+        // units (or -1 if the renderer can't provide one)
+        virtual bool getCurrentImage (VideoFrameImagePool&, Image& result, LONGLONG& timestamp) = 0;
+
+        static bool copyBitmap (VideoFrameImagePool& pool, Image& result,
+                                const BITMAPINFOHEADER& header, const BYTE* pixels)
+        {
+            auto bytesPerPixel = (int) header.biBitCount / 8;
+
+            if ((header.biCompression != BI_RGB && header.biCompression != BI_BITFIELDS)
+                 || (bytesPerPixel != 3 && bytesPerPixel != 4))
+                return false;
+
+            auto width  = (int) header.biWidth;
+            auto height = (int) std::abs (header.biHeight);
+
+            result = pool.getImage (width, height);
+
+            // (DIB lines are padded to a multiple of 4 bytes, and are stored bottom-up if the height is positive)
+            VideoFrameImagePool::copyPixels (result, pixels, (width * bytesPerPixel + 3) & ~3,
+                                             bytesPerPixel, header.biHeight > 0);
+            return true;
+        }
     };
 
     //======================================================================
@@ -92,6 +116,24 @@ namespace VideoRenderers
             return windowlessControl->GetNativeVideoSize (&videoWidth, &videoHeight, nullptr, nullptr);
         }
 
+        bool getCurrentImage (VideoFrameImagePool& pool, Image& result, LONGLONG& timestamp) override
+        {
+            BYTE* dib = nullptr;
+
+            if (FAILED (windowlessControl->GetCurrentImage (&dib)) || dib == nullptr)
+                return false;
+
+            // VMR-7 returns a packed DIB, with the pixels following the header and any colour masks
+            auto& header = *reinterpret_cast<BITMAPINFOHEADER*> (dib);
+            auto* pixels = dib + header.biSize + (header.biCompression == BI_BITFIELDS ? 3 * sizeof (DWORD) : 0);
+
+            auto ok = copyBitmap (pool, result, header, pixels);
+            CoTaskMemFree (dib);
+
+            timestamp = -1;
+            return ok;
+        }
+
         ComSmartPtr<IVMRWindowlessControl> windowlessControl;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VMR7)
@@ -151,6 +193,22 @@ namespace VideoRenderers
             return hr;
         }
 
+        bool getCurrentImage (VideoFrameImagePool& pool, Image& result, LONGLONG& timestamp) override
+        {
+            BITMAPINFOHEADER header = {};
+            header.biSize = sizeof (header);
+
+            BYTE* pixels = nullptr;
+            DWORD numBytes = 0;
+
+            if (FAILED (videoDisplayControl->GetCurrentImage (&header, &pixels, &numBytes, &timestamp)) || pixels == nullptr)
+                return false;
+
+            auto ok = copyBitmap (pool, result, header, pixels);
+            CoTaskMemFree (pixels);
+            return ok;
+        }
+
         ComSmartPtr<IMFVideoDisplayControl> videoDisplayControl;
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EVR)
@@ -158,7 +216,8 @@ namespace VideoRenderers
 };
 
 //==============================================================================
-struct VideoComponent::Pimpl  : public Component
+struct VideoComponent::Pimpl  : public Component,
+                               private Timer
                              #if JUCE_WIN_PER_MONITOR_DPI_AWARE
                               , public ComponentPeer::ScaleFactorListener
                              #endif
@@ -193,6 +252,7 @@ struct VideoComponent::Pimpl  : public Component
         if (r.wasOk())
         {
             videoLoaded = true;
+            frameNeeded = true;
             context->updateVideoPosition();
         }
 
@@ -254,7 +314,10 @@ struct VideoComponent::Pimpl  : public Component
     void setPosition (double newPosition)
     {
         if (videoLoaded)
+        {
             context->setPosition (newPosition);
+            frameNeeded = true;
+        }
     }
 
     double getPosition() const
@@ -295,6 +358,25 @@ struct VideoComponent::Pimpl  : public Component
         return videoLoaded ? context->getVolume() : 0.0f;
     }
 
+    void setFrameCallback (std::function<void (const Frame&)> callback, bool)
+    {
+        // DirectShow's renderers can only hand over a copy of the frame they're showing, so
+        // frames are always delivered as images here
+        frameCallback = std::move (callback);
+        lastFrameTime = -1.0;
+        frameNeeded = true;
+
+        if (frameCallback != nullptr)
+        {
+            startTimerHz (60);
+        }
+        else
+        {
+            stopTimer();
+            framePool.clear();
+        }
+    }
+
     void paint (Graphics& g) override
     {
         if (videoLoaded)
@@ -357,6 +439,32 @@ private:
 
     bool videoLoaded;
 
+    std::function<void (const Frame&)> frameCallback;
+    VideoFrameImagePool framePool;
+    double lastFrameTime = -1.0;
+    bool frameNeeded = false;
+
+    void timerCallback() override
+    {
+        // (copying the frame is quite slow, so this only happens while something might have changed)
+        if (! (videoLoaded && (isPlaying() || frameNeeded)))
+            return;
+
+        Frame frame;
+
+        if (context->getCurrentFrame (framePool, frame.image, frame.presentationTime)
+             && frame.presentationTime != lastFrameTime)
+        {
+            lastFrameTime = frame.presentationTime;
+            frameNeeded = false;
+
+            frame.width  = frame.image.getWidth();
+            frame.height = frame.image.getHeight();
+
+            frameCallback (frame);
+        }
+    }
+
     //==============================================================================
     struct ComponentWatcher   : public ComponentMovementWatcher
     {
@@ -719,6 +827,20 @@ private:
             return seconds;
         }
 
+        bool getCurrentFrame (VideoFrameImagePool& pool, Image& result, double& presentationTime)
+        {
+            if (! hasVideo || videoRenderer == nullptr)
+                return false;
+
+            LONGLONG timestamp = -1;
+
+            if (! videoRenderer->getCurrentImage (pool, result, timestamp))
+                return false;
+
+            presentationTime = timestamp >= 0 ? timestamp / 10000000.0 : getPosition();
+            return true;
+        }
+
         void setSpeed (double newSpeed)     { mediaPosition->put_Rate (newSpeed); }
         void setPosition (double seconds)   { mediaPosition->put_CurrentPosition (seconds); }
         void setVolume (float newVolume)    { basicAudio->put_Volume (convertToDShowVolume (newVolume)); }
@@ -27,6 +27,66 @@ namespace juce
 
 #if ! (JUCE_LINUX || JUCE_PROJUCER_LIVE_BUILD)
 
+//==============================================================================
+/*  Keeps a few images for video frames to be decoded into, so that a new one doesn't have to
+    be allocated for every frame. An image is only reused once nothing else is referring to it.
+*/
+struct VideoFrameImagePool
+{
+    Image getImage (int width, int height)
+    {
+        for (auto& image : images)
+            if (image.getReferenceCount() == 1 && image.getWidth() == width && image.getHeight() == height)
+                return image;
+
+        Image newImage (Image::ARGB, width, height, false, SoftwareImageType());
+
+        if (images.size() < maxNumImages)
+            images.add (newImage);
+        else if (images.getReference (0).getWidth() != width || images.getReference (0).getHeight() != height)
+            images.clear();
+
+        return newImage;
+    }
+
+    void clear()
+    {
+        images.clear();
+    }
+
+    /*  Copies some opaque 24 or 32-bit BGR(X) pixels into an image, which must be the same size. */
+    static void copyPixels (Image& dest, const uint8* source, int sourceLineStride,
+                            int sourcePixelStride, bool isBottomUp)
+    {
+        jassert (sourcePixelStride == 3 || sourcePixelStride == 4);
+
+        const Image::BitmapData data (dest, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < data.height; ++y)
+        {
+            auto* src = source + sourceLineStride * (isBottomUp ? data.height - 1 - y : y);
+            auto* dst = data.getLinePointer (y);
+
+            if (sourcePixelStride == 4 && data.pixelStride == 4)
+            {
+                memcpy (dst, src, (size_t) data.width * 4);
+
+                for (int x = 0; x < data.width; ++x)
+                    reinterpret_cast<PixelARGB*> (dst)[x].setAlpha (0xff);
+            }
+            else
+            {
+                for (int x = 0; x < data.width; ++x)
+                    reinterpret_cast<PixelARGB*> (dst + x * data.pixelStride)
+                        ->setARGB (0xff, src[x * sourcePixelStride + 2], src[x * sourcePixelStride + 1], src[x * sourcePixelStride]);
+            }
+        }
+    }
+
+    Array<Image> images;
+    enum { maxNumImages = 4 };
+};
+
 #if JUCE_MAC || JUCE_IOS
  #include "../native/juce_mac_Video.h"
 #elif JUCE_WINDOWS
@@ -122,6 +182,17 @@ double VideoComponent::getPlaySpeed() const                 { return pimpl->getS
 void VideoComponent::setAudioVolume (float newVolume)       { pimpl->setVolume (newVolume); }
 float VideoComponent::getAudioVolume() const                { return pimpl->getVolume(); }
 
+void VideoComponent::setFrameCallback (std::function<void (const Frame&)> callback, bool preferNativeSurfaces)
+{
+   #if JUCE_MAC || JUCE_IOS || JUCE_WINDOWS
+    pimpl->setFrameCallback (std::move (callback), preferNativeSurfaces);
+   #else
+    // Frame callbacks aren't supported on this platform yet!
+    jassert (callback == nullptr);
+    ignoreUnused (callback, preferNativeSurfaces);
+   #endif
+}
+
 void VideoComponent::resized()
 {
     auto r = getLocalBounds();
@@ -152,6 +152,59 @@ public:
     */
     float getAudioVolume() const;
 
+    //==============================================================================
+    /** Describes a decoded frame of video that is passed to a frame callback.
+
+        @see setFrameCallback
+    */
+    struct Frame
+    {
+        /** The time at which the frame should be shown, in seconds from the start of the video. */
+        double presentationTime = 0;
+
+        /** The size of the frame, in pixels. */
+        int width = 0, height = 0;
+
+        /** A handle to a GPU surface containing the frame, if one is available.
+
+            On macOS and iOS this is an IOSurfaceRef, which can be bound to an OpenGL
+            texture (e.g. with CGLTexImageIOSurface2D) or shared with another process
+            without copying the pixels. It's only guaranteed to stay valid until the
+            callback returns, so you'll need to CFRetain it if you want to keep it.
+
+            This will be nullptr if the frame was delivered as an image instead.
+        */
+        void* nativeSurface = nullptr;
+
+        /** The frame as an ARGB image, if it wasn't delivered as a native surface.
+
+            These images are taken from a small pool and reused for later frames, so
+            if you keep a copy of the Image object, the pool won't be able to reuse it
+            and will have to allocate a new one.
+        */
+        Image image;
+    };
+
+    /** Sets a function to be called on the message thread with each new frame of the
+        video as it's decoded.
+
+        A frame is delivered once for each frame that's shown while the video plays
+        (and after seeking). The component carries on drawing the video itself, so if
+        you're rendering the frames yourself you may want to hide it.
+
+        @param callback                 the function to call, or nullptr to stop receiving
+                                        frames
+        @param preferNativeSurfaces     if this is true and the platform can supply the
+                                        hardware-decoded frames as GPU surfaces (currently
+                                        macOS and iOS), Frame::nativeSurface will be set
+                                        instead of the pixels being copied into an image.
+                                        Otherwise, or on other platforms, each frame is
+                                        copied into Frame::image.
+
+        Frames are currently supported on macOS, iOS and Windows.
+    */
+    void setFrameCallback (std::function<void (const Frame&)> callback, bool preferNativeSurfaces = true);
+
    #if JUCE_SYNC_VIDEO_VOLUME_WITH_OS_MEDIA_VOLUME
     /** Set this callback to be notified whenever OS global media volume changes.
         Currently used on Android only.